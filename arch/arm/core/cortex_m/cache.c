@@ -67,6 +67,51 @@ int arch_dcache_flush_and_invd_range(void *start_addr, size_t size)
 	return 0;
 }
 
+#ifdef CONFIG_DCACHE
+/*
+ * Same line loops as the CMSIS functions, without their DSB/ISB, which
+ * arch_dcache_sync() issues once for a batch of ranges.
+ */
+#define DCACHE_LINES_FOREACH(addr, start_addr, size)					\
+	for (uintptr_t addr = ROUND_DOWN((uintptr_t)(start_addr),			\
+					 sys_cache_data_line_size_get());		\
+	     addr < (uintptr_t)(start_addr) + (size);					\
+	     addr += sys_cache_data_line_size_get())
+
+int arch_dcache_flush_range_nosync(void *start_addr, size_t size)
+{
+	DCACHE_LINES_FOREACH(addr, start_addr, size) {
+		SCB->DCCMVAC = addr;
+	}
+
+	return 0;
+}
+
+int arch_dcache_invd_range_nosync(void *start_addr, size_t size)
+{
+	DCACHE_LINES_FOREACH(addr, start_addr, size) {
+		SCB->DCIMVAC = addr;
+	}
+
+	return 0;
+}
+
+int arch_dcache_flush_and_invd_range_nosync(void *start_addr, size_t size)
+{
+	DCACHE_LINES_FOREACH(addr, start_addr, size) {
+		SCB->DCCIMVAC = addr;
+	}
+
+	return 0;
+}
+
+void arch_dcache_sync(void)
+{
+	__DSB();
+	__ISB();
+}
+#endif /* CONFIG_DCACHE */
+
 void arch_icache_enable(void)
 {
 	SCB_EnableICache();
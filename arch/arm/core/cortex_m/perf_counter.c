@@ -0,0 +1,42 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ARM Cortex-M performance counters based on DWT
+ *
+ * The DWT only has a 32 bit cycle counter. Its other profiling counters
+ * are 8 bits wide and count stall cycles rather than events such as cache
+ * misses, so they are not exposed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/perf_counter.h>
+#include <cortex_m/dwt.h>
+#include <cmsis_core.h>
+
+unsigned int arch_perf_counter_num_get(void)
+{
+	return ((DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) == 0) ? 1 : 0;
+}
+
+int arch_perf_counter_config(unsigned int idx, enum perf_counter_event event)
+{
+	if (event != PERF_COUNTER_CYCLES) {
+		return -ENOTSUP;
+	}
+
+	/* The timing functions may use the counter as well, leave its value */
+	z_arm_dwt_init();
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	return 0;
+}
+
+uint32_t arch_perf_counter_read(unsigned int idx)
+{
+	return z_arm_dwt_get_cycles();
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ARM Cortex-M sampling profiler support
+ */
+
+#include <zephyr/kernel.h>
+#include <cmsis_core.h>
+
+size_t arch_profiler_pc_get(uintptr_t *pc, size_t max)
+{
+	const uint32_t *frame;
+
+	/* Nested interrupt, the thread state is further down the stack */
+	if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0U) {
+		return 0;
+	}
+
+	/* Threads run on the PSP, the basic exception frame is at its top:
+	 * r0-r3, r12, lr, pc and xpsr.
+	 */
+	frame = (const uint32_t *)__get_PSP();
+
+	pc[0] = frame[6];
+	if (max > 1) {
+		/* The caller, unless the function was interrupted after it
+		 * saved or reused lr
+		 */
+		pc[1] = frame[5] & ~1U;
+		return 2;
+	}
+
+	return 1;
+}
@@ -1039,11 +1039,14 @@ int arch_page_phys_get(void *virt, uintptr_t *phys)
 size_t arch_virt_region_align(uintptr_t phys, size_t size)
 {
 	size_t alignment = CONFIG_MMU_PAGE_SIZE;
-	size_t level_size;
+	uint64_t level_size;
 	int level;
 
-	for (level = XLAT_LAST_LEVEL; level >= BASE_XLAT_LEVEL; level--) {
-		level_size = 1 << LEVEL_TO_VA_SIZE_SHIFT(level);
+	/* Level 0 can't hold block descriptors with a 4KB granule, so the
+	 * largest block is 1GB at level 1.
+	 */
+	for (level = XLAT_LAST_LEVEL; level >= MAX(BASE_XLAT_LEVEL, 1); level--) {
+		level_size = 1ULL << LEVEL_TO_VA_SIZE_SHIFT(level);
 
 		if (size < level_size) {
 			break;
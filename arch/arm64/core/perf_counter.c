@@ -0,0 +1,83 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ARM64 performance counters, using the PMUv3 event counters
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/arm64/lib_helpers.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/timing/perf_counter.h>
+
+#define ID_AA64DFR0_PMUVER_SHIFT 8
+#define ID_AA64DFR0_PMUVER_MASK  0xf
+#define ID_AA64DFR0_PMUVER_IMPDEF 0xf
+
+#define PMCR_EL0_E       BIT(0)
+#define PMCR_EL0_N_SHIFT 11
+#define PMCR_EL0_N_MASK  0x1f
+
+/* Common event numbers, all reported in PMCEID0_EL0 */
+static const uint8_t common_events[] = {
+	[PERF_COUNTER_CYCLES] = 0x11,		/* CPU_CYCLES */
+	[PERF_COUNTER_INSTRUCTIONS] = 0x08,	/* INST_RETIRED */
+	[PERF_COUNTER_CACHE_MISSES] = 0x03,	/* L1D_CACHE_REFILL */
+	[PERF_COUNTER_BRANCH_MISSES] = 0x10,	/* BR_MIS_PRED */
+};
+
+unsigned int arch_perf_counter_num_get(void)
+{
+	uint64_t pmuver = (read_sysreg(id_aa64dfr0_el1) >> ID_AA64DFR0_PMUVER_SHIFT) &
+			  ID_AA64DFR0_PMUVER_MASK;
+
+	if ((pmuver == 0) || (pmuver == ID_AA64DFR0_PMUVER_IMPDEF)) {
+		return 0;
+	}
+
+	return (read_sysreg(pmcr_el0) >> PMCR_EL0_N_SHIFT) & PMCR_EL0_N_MASK;
+}
+
+int arch_perf_counter_config(unsigned int idx, enum perf_counter_event event)
+{
+	unsigned int key;
+
+	if ((event >= ARRAY_SIZE(common_events)) ||
+	    ((read_sysreg(pmceid0_el0) & BIT64(common_events[event])) == 0)) {
+		return -ENOTSUP;
+	}
+
+	key = arch_irq_lock();
+
+	write_sysreg(BIT64(idx), pmcntenclr_el0);
+	write_sysreg(idx, pmselr_el0);
+	barrier_isync_fence_full();
+	/* No filter bits, so EL0 and EL1 are counted */
+	write_sysreg(common_events[event], pmxevtyper_el0);
+	write_sysreg(0, pmxevcntr_el0);
+	write_sysreg(BIT64(idx), pmcntenset_el0);
+	write_sysreg(read_sysreg(pmcr_el0) | PMCR_EL0_E, pmcr_el0);
+	barrier_isync_fence_full();
+
+	arch_irq_unlock(key);
+
+	return 0;
+}
+
+uint32_t arch_perf_counter_read(unsigned int idx)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t value;
+
+	write_sysreg(idx, pmselr_el0);
+	barrier_isync_fence_full();
+	value = (uint32_t)read_sysreg(pmxevcntr_el0);
+
+	arch_irq_unlock(key);
+
+	return value;
+}
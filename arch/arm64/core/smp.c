@@ -180,12 +180,12 @@ void arch_secondary_cpu_init(int cpu_num)
 
 #ifdef CONFIG_SMP
 
-static void broadcast_ipi(unsigned int ipi)
+static void send_ipi(unsigned int ipi, uint32_t cpu_bitmap)
 {
 	uint64_t mpidr = MPIDR_TO_CORE(GET_MPIDR());
 
 	/*
-	 * Send SGI to all cores except itself
+	 * Send SGI to the cores of the mask except itself
 	 */
 	unsigned int num_cpus = arch_num_cpus();
 
@@ -193,7 +193,8 @@ static void broadcast_ipi(unsigned int ipi)
 		uint64_t target_mpidr = cpu_map[i];
 		uint8_t aff0;
 
-		if (mpidr == target_mpidr || target_mpidr == INV_MPID) {
+		if ((cpu_bitmap & BIT(i)) == 0 ||
+		    mpidr == target_mpidr || target_mpidr == INV_MPID) {
 			continue;
 		}
 
@@ -212,7 +213,12 @@ void sched_ipi_handler(const void *unused)
 /* arch implementation of sched_ipi */
 void arch_sched_ipi(void)
 {
-	broadcast_ipi(SGI_SCHED_IPI);
+	send_ipi(SGI_SCHED_IPI, IPI_ALL_CPUS_MASK);
+}
+
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	send_ipi(SGI_SCHED_IPI, cpu_bitmap);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -232,7 +238,7 @@ void mem_cfg_ipi_handler(const void *unused)
 
 void z_arm64_mem_cfg_ipi(void)
 {
-	broadcast_ipi(SGI_MMCFG_IPI);
+	send_ipi(SGI_MMCFG_IPI, IPI_ALL_CPUS_MASK);
 }
 #endif
 
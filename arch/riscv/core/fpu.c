@@ -14,6 +14,25 @@
 extern void z_riscv_fpu_save(struct z_riscv_fp_context *saved_fp_context);
 extern void z_riscv_fpu_restore(struct z_riscv_fp_context *saved_fp_context);
 
+#ifdef CONFIG_RISCV_ISA_EXT_V
+extern void z_riscv_vec_save(struct z_riscv_vec_context *saved_vec_context);
+extern void z_riscv_vec_restore(struct z_riscv_vec_context *saved_vec_context);
+
+/*
+ * The vector unit is handled as part of the FPU: access to both is granted
+ * and denied together, and both are owned by the same thread. Their
+ * clean/dirty states are tracked separately though so that only the
+ * modified part gets saved.
+ */
+#define FPU_ACCESS	(MSTATUS_FS | MSTATUS_VS)
+#define FPU_INIT	(MSTATUS_FS_INIT | MSTATUS_VS_INIT)
+#define FPU_CLEAN	(MSTATUS_FS_CLEAN | MSTATUS_VS_CLEAN)
+#else
+#define FPU_ACCESS	MSTATUS_FS
+#define FPU_INIT	MSTATUS_FS_INIT
+#define FPU_CLEAN	MSTATUS_FS_CLEAN
+#endif
+
 #define FPU_DEBUG 0
 
 #if FPU_DEBUG
@@ -66,11 +85,11 @@ static void z_riscv_fpu_disable(void)
 
 	__ASSERT((status & MSTATUS_IEN) == 0, "must be called with IRQs disabled");
 
-	if ((status & MSTATUS_FS) != 0) {
-		csr_clear(mstatus, MSTATUS_FS);
+	if ((status & FPU_ACCESS) != 0) {
+		csr_clear(mstatus, FPU_ACCESS);
 
 		/* remember its clean/dirty state */
-		_current_cpu->arch.fpu_state = (status & MSTATUS_FS);
+		_current_cpu->arch.fpu_state = (status & FPU_ACCESS);
 	}
 }
 
@@ -78,15 +97,18 @@ static void z_riscv_fpu_load(void)
 {
 	__ASSERT((csr_read(mstatus) & MSTATUS_IEN) == 0,
 		 "must be called with IRQs disabled");
-	__ASSERT((csr_read(mstatus) & MSTATUS_FS) == 0,
+	__ASSERT((csr_read(mstatus) & FPU_ACCESS) == 0,
 		 "must be called with FPU access disabled");
 
 	/* become new owner */
 	atomic_ptr_set(&_current_cpu->arch.fpu_owner, _current);
 
 	/* restore our content */
-	csr_set(mstatus, MSTATUS_FS_INIT);
+	csr_set(mstatus, FPU_INIT);
 	z_riscv_fpu_restore(&_current->arch.saved_fp_context);
+#ifdef CONFIG_RISCV_ISA_EXT_V
+	z_riscv_vec_restore(&_current->arch.saved_vec_context);
+#endif
 	DBG("restore", _current);
 }
 
@@ -102,13 +124,14 @@ void arch_flush_local_fpu(void)
 {
 	__ASSERT((csr_read(mstatus) & MSTATUS_IEN) == 0,
 		 "must be called with IRQs disabled");
-	__ASSERT((csr_read(mstatus) & MSTATUS_FS) == 0,
+	__ASSERT((csr_read(mstatus) & FPU_ACCESS) == 0,
 		 "must be called with FPU access disabled");
 
 	struct k_thread *owner = atomic_ptr_get(&_current_cpu->arch.fpu_owner);
 
 	if (owner != NULL) {
-		bool dirty = (_current_cpu->arch.fpu_state == MSTATUS_FS_DIRTY);
+		unsigned long state = _current_cpu->arch.fpu_state;
+		bool dirty = ((state & MSTATUS_FS) == MSTATUS_FS_DIRTY);
 
 		if (dirty) {
 			/* turn on FPU access */
@@ -117,11 +140,20 @@ void arch_flush_local_fpu(void)
 			z_riscv_fpu_save(&owner->arch.saved_fp_context);
 		}
 
+#ifdef CONFIG_RISCV_ISA_EXT_V
+		if ((state & MSTATUS_VS) == MSTATUS_VS_DIRTY) {
+			/* same for the vector unit */
+			csr_set(mstatus, MSTATUS_VS_CLEAN);
+			z_riscv_vec_save(&owner->arch.saved_vec_context);
+			dirty = true;
+		}
+#endif
+
 		/* dirty means active use */
 		owner->arch.fpu_recently_used = dirty;
 
 		/* disable FPU access */
-		csr_clear(mstatus, MSTATUS_FS);
+		csr_clear(mstatus, FPU_ACCESS);
 
 		/* release ownership */
 		atomic_ptr_clear(&_current_cpu->arch.fpu_owner);
@@ -206,8 +238,8 @@ void z_riscv_fpu_enter_exc(void)
  */
 void z_riscv_fpu_trap(z_arch_esf_t *esf)
 {
-	__ASSERT((esf->mstatus & MSTATUS_FS) == 0 &&
-		 (csr_read(mstatus) & MSTATUS_FS) == 0,
+	__ASSERT((esf->mstatus & FPU_ACCESS) == 0 &&
+		 (csr_read(mstatus) & FPU_ACCESS) == 0,
 		 "called despite FPU being accessible");
 
 	/* save current owner's content  if any */
@@ -223,7 +255,7 @@ void z_riscv_fpu_trap(z_arch_esf_t *esf)
 		esf->mstatus &= ~MSTATUS_MPIE_EN;
 
 		/* make it accessible to the returning context */
-		esf->mstatus |= MSTATUS_FS_INIT;
+		esf->mstatus |= FPU_INIT;
 
 		return;
 	}
@@ -237,7 +269,7 @@ void z_riscv_fpu_trap(z_arch_esf_t *esf)
 #endif
 
 	/* make it accessible and clean to the returning context */
-	esf->mstatus |= MSTATUS_FS_CLEAN;
+	esf->mstatus |= FPU_CLEAN;
 
 	/* and load it with corresponding content */
 	z_riscv_fpu_load();
@@ -276,7 +308,7 @@ static bool fpu_access_allowed(unsigned int exc_update_level)
 			flush_owned_fpu(_current);
 #endif
 			z_riscv_fpu_load();
-			_current_cpu->arch.fpu_state = MSTATUS_FS_CLEAN;
+			_current_cpu->arch.fpu_state = FPU_CLEAN;
 			return true;
 		}
 		return false;
@@ -296,10 +328,10 @@ static bool fpu_access_allowed(unsigned int exc_update_level)
 void z_riscv_fpu_exit_exc(z_arch_esf_t *esf)
 {
 	if (fpu_access_allowed(1)) {
-		esf->mstatus &= ~MSTATUS_FS;
+		esf->mstatus &= ~FPU_ACCESS;
 		esf->mstatus |= _current_cpu->arch.fpu_state;
 	} else {
-		esf->mstatus &= ~MSTATUS_FS;
+		esf->mstatus &= ~FPU_ACCESS;
 	}
 }
 
@@ -312,7 +344,7 @@ void z_riscv_fpu_exit_exc(z_arch_esf_t *esf)
 void z_riscv_fpu_thread_context_switch(void)
 {
 	if (fpu_access_allowed(0)) {
-		csr_clear(mstatus, MSTATUS_FS);
+		csr_clear(mstatus, FPU_ACCESS);
 		csr_set(mstatus, _current_cpu->arch.fpu_state);
 	} else {
 		z_riscv_fpu_disable();
@@ -83,6 +83,14 @@ GEN_OFFSET_SYM(z_riscv_fp_context_t, fs11);
 
 GEN_OFFSET_SYM(z_riscv_fp_context_t, fcsr);
 
+#ifdef CONFIG_RISCV_ISA_EXT_V
+GEN_OFFSET_SYM(z_riscv_vec_context_t, vstart);
+GEN_OFFSET_SYM(z_riscv_vec_context_t, vl);
+GEN_OFFSET_SYM(z_riscv_vec_context_t, vtype);
+GEN_OFFSET_SYM(z_riscv_vec_context_t, vcsr);
+GEN_OFFSET_SYM(z_riscv_vec_context_t, v);
+#endif
+
 GEN_OFFSET_SYM(_thread_arch_t, exception_depth);
 
 #endif /* CONFIG_FPU_SHARING */
@@ -0,0 +1,48 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RISC-V performance counters
+ *
+ * Only the cycle and instructions retired counters have standard events,
+ * the events of the mhpmcounter registers are implementation defined.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/riscv/csr.h>
+#include <zephyr/timing/perf_counter.h>
+
+static enum perf_counter_event counter_event[2] = {
+	PERF_COUNTER_CYCLES,
+	PERF_COUNTER_INSTRUCTIONS,
+};
+
+unsigned int arch_perf_counter_num_get(void)
+{
+	return ARRAY_SIZE(counter_event);
+}
+
+int arch_perf_counter_config(unsigned int idx, enum perf_counter_event event)
+{
+	if ((event != PERF_COUNTER_CYCLES) && (event != PERF_COUNTER_INSTRUCTIONS)) {
+		return -ENOTSUP;
+	}
+
+	/* mcycle and minstret always count */
+	counter_event[idx] = event;
+
+	return 0;
+}
+
+uint32_t arch_perf_counter_read(unsigned int idx)
+{
+	if (counter_event[idx] == PERF_COUNTER_CYCLES) {
+		return csr_read(mcycle);
+	}
+
+	return csr_read(minstret);
+}
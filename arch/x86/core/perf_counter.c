@@ -0,0 +1,96 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief x86 performance counters, using the architectural performance
+ * monitoring general purpose counters
+ */
+
+#include <cpuid.h> /* Header provided by the toolchain. */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/x86/cpuid.h>
+#include <zephyr/arch/x86/msr.h>
+#include <zephyr/timing/perf_counter.h>
+
+/* Architectural events: event select, unit mask and the CPUID.0AH:EBX bit
+ * telling the event is not available.
+ */
+static const struct {
+	uint8_t event;
+	uint8_t umask;
+	uint8_t unavailable_bit;
+} arch_events[] = {
+	[PERF_COUNTER_CYCLES] = { 0x3c, 0x00, 0 },
+	[PERF_COUNTER_INSTRUCTIONS] = { 0xc0, 0x00, 1 },
+	[PERF_COUNTER_CACHE_MISSES] = { 0x2e, 0x41, 4 },
+	[PERF_COUNTER_BRANCH_MISSES] = { 0xc5, 0x00, 6 },
+};
+
+static uint32_t pmu_eax, pmu_ebx;
+static bool pmu_probed;
+
+static void pmu_probe(void)
+{
+	uint32_t ecx, edx;
+
+	if (pmu_probed) {
+		return;
+	}
+
+	if (__get_cpuid(CPUID_PERF_MONITORING, &pmu_eax, &pmu_ebx, &ecx, &edx) == 0) {
+		pmu_eax = 0;
+	}
+
+	pmu_probed = true;
+}
+
+unsigned int arch_perf_counter_num_get(void)
+{
+	pmu_probe();
+
+	/* EAX: version in bits 7:0, number of counters in bits 15:8 */
+	return ((pmu_eax & 0xff) == 0) ? 0 : ((pmu_eax >> 8) & 0xff);
+}
+
+int arch_perf_counter_config(unsigned int idx, enum perf_counter_event event)
+{
+	uint32_t ebx_len;
+
+	pmu_probe();
+
+	/* EAX bits 31:24 give the number of valid bits in EBX */
+	ebx_len = pmu_eax >> 24;
+	if ((event >= ARRAY_SIZE(arch_events)) ||
+	    (arch_events[event].unavailable_bit >= ebx_len) ||
+	    ((pmu_ebx & BIT(arch_events[event].unavailable_bit)) != 0)) {
+		return -ENOTSUP;
+	}
+
+	z_x86_msr_write(X86_PERFEVTSEL0_MSR + idx, 0);
+	z_x86_msr_write(X86_PMC0_MSR + idx, 0);
+	z_x86_msr_write(X86_PERFEVTSEL0_MSR + idx,
+			arch_events[event].event | (arch_events[event].umask << 8) |
+			X86_PERFEVTSEL_USR | X86_PERFEVTSEL_OS | X86_PERFEVTSEL_EN);
+
+	/* Version 2 adds a global enable bit for each counter */
+	if ((pmu_eax & 0xff) >= 2) {
+		z_x86_msr_write(X86_PERF_GLOBAL_CTRL_MSR,
+				z_x86_msr_read(X86_PERF_GLOBAL_CTRL_MSR) | BIT(idx));
+	}
+
+	return 0;
+}
+
+uint32_t arch_perf_counter_read(unsigned int idx)
+{
+	uint32_t lo, hi;
+
+	__asm__ volatile("rdpmc" : "=a"(lo), "=d"(hi) : "c"(idx));
+
+	return lo;
+}
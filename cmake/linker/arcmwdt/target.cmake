@@ -220,6 +220,7 @@ macro(toolchain_ld_relocation)
     -b ${MEM_RELOCATION_SRAM_BSS_LD}
     -c ${MEM_RELOCATION_CODE}
     DEPENDS app kernel ${ZEPHYR_LIBS_PROPERTY}
+    $<TARGET_PROPERTY:code_data_relocation_target,CODE_RELOCATION_PROFILES>
     )
 
   add_library(code_relocation_source_lib  STATIC ${MEM_RELOCATION_CODE})
@@ -33,6 +33,7 @@ macro(toolchain_ld_relocation)
     -c ${MEM_RELOCATION_CODE}
     --default_ram_region ${MEM_REGION_DEFAULT_RAM}
     DEPENDS app kernel ${ZEPHYR_LIBS_PROPERTY} ${DICT_FILE}
+    $<TARGET_PROPERTY:code_data_relocation_target,CODE_RELOCATION_PROFILES>
     )
 
   add_library(code_relocation_source_lib  STATIC ${MEM_RELOCATION_CODE})
@@ -22,6 +22,7 @@ if(CONFIG_PM_DEVICE)
 endif()
 
 zephyr_iterable_section(NAME log_dynamic GROUP DATA_REGION ${XIP_ALIGN_WITH_INPUT} SUBALIGN 4)
+zephyr_iterable_section(NAME log_call_site GROUP DATA_REGION ${XIP_ALIGN_WITH_INPUT} SUBALIGN 4)
 
 if(CONFIG_USERSPACE)
   # All kernel objects within are assumed to be either completely
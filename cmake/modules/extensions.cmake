@@ -685,6 +685,38 @@ function(generate_inc_file_for_target
   generate_inc_file_for_gen_target(${target} ${source_file} ${generated_file} ${generated_target_name} ${ARGN})
 endfunction()
 
+# Builds an image of the read-only image file system (FS_IMGFS) from the
+# files of a directory, and converts it to a list of hex characters to be
+# included into the application, like generate_inc_file_for_target().
+#
+# Usage:
+#   generate_imgfs_inc_file_for_target(app assets ${gen_dir}/assets.inc
+#                                      --compress lz4 --no-compress "*.bin")
+#
+# Any additional arguments are passed on to gen_imgfs.py.
+function(generate_imgfs_inc_file_for_target
+    target          # The cmake target that depends on the generated file
+    source_dir      # The directory to build the image from
+    generated_file  # The generated file
+    )
+  get_filename_component(source_dir ${source_dir} ABSOLUTE)
+  file(GLOB_RECURSE source_files CONFIGURE_DEPENDS ${source_dir}/*)
+
+  add_custom_command(
+    OUTPUT ${generated_file}.img
+    COMMAND
+    ${PYTHON_EXECUTABLE}
+    ${ZEPHYR_BASE}/scripts/build/gen_imgfs.py
+    ${ARGN} # Extra arguments are passed to gen_imgfs.py
+    --input ${source_dir}
+    --output ${generated_file}.img
+    DEPENDS ${source_files} ${ZEPHYR_BASE}/scripts/build/gen_imgfs.py
+    WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
+    )
+
+  generate_inc_file_for_target(${target} ${generated_file}.img ${generated_file})
+endfunction()
+
 # 1.4. board_*
 #
 # This section is for extensions related to Zephyr board handling.
@@ -1363,6 +1395,12 @@ endmacro()
 # This directive will relocate the target my_lib to SRAM:
 # zephyr_code_relocate(LIBRARY my_lib SRAM)
 #
+# The PROFILE directive will relocate the hottest functions of the build
+# listed in a profile, as many as fit in BUDGET bytes. Each line of the profile
+# is a hit count followed by a function name, as printed by `uniq -c`. This
+# directive will relocate the hottest functions of hot.txt to ITCM, up to 16kB:
+# zephyr_code_relocate(PROFILE hot.txt BUDGET 16384 LOCATION ITCM_TEXT)
+#
 # The following optional arguments are supported:
 # - NOCOPY: this flag indicates that the file data does not need to be copied
 #   at boot time (For example, for flash XIP).
@@ -1371,7 +1409,7 @@ endmacro()
 # - PHDR [program_header]: add program header. Used on Xtensa platforms.
 function(zephyr_code_relocate)
   set(options NOCOPY NOKEEP)
-  set(single_args LIBRARY LOCATION PHDR)
+  set(single_args LIBRARY LOCATION PHDR PROFILE BUDGET)
   set(multi_args FILES)
   cmake_parse_arguments(CODE_REL "${options}" "${single_args}"
     "${multi_args}" ${ARGN})
@@ -1380,18 +1418,31 @@ function(zephyr_code_relocate)
     message(FATAL_ERROR "zephyr_code_relocate(${ARGV0} ...) "
       "given unknown arguments: ${CODE_REL_UNPARSED_ARGUMENTS}")
   endif()
-  if((NOT CODE_REL_FILES) AND (NOT CODE_REL_LIBRARY))
+  if((NOT CODE_REL_FILES) AND (NOT CODE_REL_LIBRARY) AND (NOT CODE_REL_PROFILE))
     message(FATAL_ERROR
-      "zephyr_code_relocate() requires either FILES or LIBRARY be provided")
+      "zephyr_code_relocate() requires either FILES, LIBRARY or PROFILE be provided")
   endif()
-  if(CODE_REL_FILES AND CODE_REL_LIBRARY)
+  if((CODE_REL_FILES AND CODE_REL_LIBRARY) OR
+     (CODE_REL_PROFILE AND (CODE_REL_FILES OR CODE_REL_LIBRARY)))
     message(FATAL_ERROR "zephyr_code_relocate() only accepts "
-      "one argument between FILES and LIBRARY")
+      "one argument between FILES, LIBRARY and PROFILE")
   endif()
   if(NOT CODE_REL_LOCATION)
     message(FATAL_ERROR "zephyr_code_relocate() requires a LOCATION argument")
   endif()
-  if(CODE_REL_LIBRARY)
+  if(CODE_REL_PROFILE AND NOT CODE_REL_BUDGET MATCHES "^[0-9]+$")
+    message(FATAL_ERROR "zephyr_code_relocate(PROFILE ...) requires a BUDGET "
+      "argument, in bytes")
+  endif()
+  if(CODE_REL_PROFILE)
+    if(NOT IS_ABSOLUTE ${CODE_REL_PROFILE})
+      set(CODE_REL_PROFILE ${CMAKE_CURRENT_SOURCE_DIR}/${CODE_REL_PROFILE})
+    endif()
+    set(file_list ${CODE_REL_PROFILE})
+    # Regenerate the relocation when the profile changes
+    set_property(TARGET code_data_relocation_target APPEND
+      PROPERTY CODE_RELOCATION_PROFILES ${CODE_REL_PROFILE})
+  elseif(CODE_REL_LIBRARY)
     # Use cmake generator expression to convert library to file list,
     # supporting relative and absolute paths
     set(genex_src_dir "$<TARGET_PROPERTY:${CODE_REL_LIBRARY},SOURCE_DIR>")
@@ -1437,6 +1488,9 @@ function(zephyr_code_relocate)
   if(CODE_REL_NOKEEP)
     list(APPEND flag_list NOKEEP)
   endif()
+  if(CODE_REL_PROFILE)
+    list(APPEND flag_list PROFILE BUDGET=${CODE_REL_BUDGET})
+  endif()
   if(CODE_REL_PHDR)
     set(CODE_REL_LOCATION "${CODE_REL_LOCATION}\ :${CODE_REL_PHDR}")
   endif()
@@ -270,9 +270,44 @@ static int check_buffer_size(const struct adc_sequence *sequence,
 	return 0;
 }
 
+/* Compare value of the SAADC internal timer, which runs at 16 MHz */
+#define SAADC_HW_TIMER_FREQ_MHZ 16
+#define SAADC_HW_TIMER_CC_MIN   80
+#define SAADC_HW_TIMER_CC_MAX   2047
+
+/*
+ * A sequence of samplings of a single channel, that does not need to be
+ * handled between the samplings, is paced by the SAADC internal timer and
+ * written to the buffer by EasyDMA, with a single END event at its end.
+ */
+static bool hw_timer_usable(const struct adc_sequence *sequence,
+			    uint8_t active_channels, uint16_t *cc)
+{
+	const struct adc_sequence_options *options = sequence->options;
+	uint32_t ticks;
+
+	if ((options == NULL) || (options->callback != NULL) ||
+	    (options->extra_samplings == 0U) || (active_channels != 1U) ||
+	    (sequence->oversampling != 0U) || sequence->calibrate ||
+	    (options->interval_us > SAADC_HW_TIMER_CC_MAX / SAADC_HW_TIMER_FREQ_MHZ)) {
+		return false;
+	}
+
+	ticks = options->interval_us * SAADC_HW_TIMER_FREQ_MHZ;
+	if (ticks < SAADC_HW_TIMER_CC_MIN) {
+		return false;
+	}
+
+	*cc = ticks;
+
+	return true;
+}
+
 static int start_read(const struct device *dev,
 		      const struct adc_sequence *sequence)
 {
+	struct adc_sequence hw_timed;
+	uint16_t cc;
 	int error;
 	uint32_t selected_channels = sequence->channels;
 	uint8_t active_channels;
@@ -344,9 +379,22 @@ static int start_read(const struct device *dev,
 		return error;
 	}
 
-	nrf_saadc_buffer_init(NRF_SAADC,
-			      (nrf_saadc_value_t *)sequence->buffer,
-			      active_channels);
+	if (hw_timer_usable(sequence, active_channels, &cc)) {
+		nrf_saadc_continuous_mode_enable(NRF_SAADC, cc);
+		nrf_saadc_buffer_init(NRF_SAADC,
+				      (nrf_saadc_value_t *)sequence->buffer,
+				      1 + sequence->options->extra_samplings);
+
+		/* The whole sequence is a single sampling for the context */
+		hw_timed = *sequence;
+		hw_timed.options = NULL;
+		sequence = &hw_timed;
+	} else {
+		nrf_saadc_continuous_mode_disable(NRF_SAADC);
+		nrf_saadc_buffer_init(NRF_SAADC,
+				      (nrf_saadc_value_t *)sequence->buffer,
+				      active_channels);
+	}
 
 	adc_context_start_read(&m_data.ctx, sequence);
 
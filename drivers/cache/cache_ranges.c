@@ -0,0 +1,139 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Batched d-cache range operations, for the buffers of scatter-gather DMA
+ * transfers.
+ */
+
+#include <zephyr/cache.h>
+#include <zephyr/sys/util.h>
+
+enum range_op {
+	RANGE_FLUSH,
+	RANGE_INVD,
+	RANGE_FLUSH_AND_INVD,
+};
+
+#if defined(CONFIG_ARCH_CACHE) && defined(CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC)
+#define RANGE_NOSYNC 1
+#endif
+
+static int range_op_one(enum range_op op, uintptr_t start, uintptr_t end)
+{
+	void *addr = (void *)start;
+	size_t size = end - start;
+
+	switch (op) {
+#ifdef RANGE_NOSYNC
+	case RANGE_FLUSH:
+		return arch_dcache_flush_range_nosync(addr, size);
+	case RANGE_INVD:
+		return arch_dcache_invd_range_nosync(addr, size);
+	default:
+		return arch_dcache_flush_and_invd_range_nosync(addr, size);
+#else
+	case RANGE_FLUSH:
+		return cache_data_flush_range(addr, size);
+	case RANGE_INVD:
+		return cache_data_invd_range(addr, size);
+	default:
+		return cache_data_flush_and_invd_range(addr, size);
+#endif
+	}
+}
+
+/*
+ * Whether two ranges can be operated on as one. A flush may also write back
+ * the bytes between two ranges sharing or touching a line, an invalidation
+ * must not drop them.
+ */
+static bool range_merge(enum range_op op, size_t line, uintptr_t start, uintptr_t end,
+			uintptr_t next_start, uintptr_t next_end)
+{
+	if (op == RANGE_INVD) {
+		return next_start <= end && next_end >= start;
+	}
+
+	return ROUND_DOWN(next_start, line) <= ROUND_UP(end, line) &&
+	       ROUND_UP(next_end, line) >= ROUND_DOWN(start, line);
+}
+
+static int range_op_all(enum range_op op, const struct sys_cache_range *ranges, size_t count)
+{
+	size_t line = MAX(sys_cache_data_line_size_get(), 1);
+	uintptr_t start, end;
+	int ret = 0;
+
+	if (count == 0) {
+		return 0;
+	}
+
+	if (CONFIG_DCACHE_RANGES_ALL_THRESHOLD != 0 && op != RANGE_INVD) {
+		size_t total = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			total += ranges[i].size;
+		}
+
+		if (total >= CONFIG_DCACHE_RANGES_ALL_THRESHOLD) {
+			return op == RANGE_FLUSH ? sys_cache_data_flush_all() :
+						   sys_cache_data_flush_and_invd_all();
+		}
+	}
+
+#ifdef RANGE_NOSYNC
+	/* Stores to the buffers complete before their lines are cleaned */
+	arch_dcache_sync();
+#endif
+
+	start = (uintptr_t)ranges[0].addr;
+	end = start + ranges[0].size;
+
+	for (size_t i = 1; i <= count; i++) {
+		uintptr_t next_start = 0, next_end = 0;
+
+		if (i < count) {
+			next_start = (uintptr_t)ranges[i].addr;
+			next_end = next_start + ranges[i].size;
+
+			if (range_merge(op, line, start, end, next_start, next_end)) {
+				start = MIN(start, next_start);
+				end = MAX(end, next_end);
+				continue;
+			}
+		}
+
+		ret = range_op_one(op, start, end);
+		if (ret != 0) {
+			break;
+		}
+
+		start = next_start;
+		end = next_end;
+	}
+
+#ifdef RANGE_NOSYNC
+	arch_dcache_sync();
+#endif
+
+	return ret;
+}
+
+int sys_cache_data_flush_ranges(const struct sys_cache_range *ranges, size_t count)
+{
+	return range_op_all(RANGE_FLUSH, ranges, count);
+}
+
+int sys_cache_data_invd_ranges(const struct sys_cache_range *ranges, size_t count)
+{
+	return range_op_all(RANGE_INVD, ranges, count);
+}
+
+int sys_cache_data_flush_and_invd_ranges(const struct sys_cache_range *ranges, size_t count)
+{
+	return range_op_all(RANGE_FLUSH_AND_INVD, ranges, count);
+}
@@ -55,6 +55,24 @@ int z_impl_can_send(const struct device *dev, const struct can_frame *frame,
 	return api->send(dev, frame, timeout, callback, user_data);
 }
 
+int can_send_batch(const struct device *dev, const struct can_frame *frames, size_t count,
+		   k_timeout_t timeout, can_tx_callback_t callback, void *user_data)
+{
+	size_t i;
+	int err;
+
+	__ASSERT_NO_MSG(callback != NULL);
+
+	for (i = 0U; i < count; i++) {
+		err = can_send(dev, &frames[i], timeout, callback, user_data);
+		if (err != 0) {
+			return (i > 0U) ? (int)i : err;
+		}
+	}
+
+	return (int)i;
+}
+
 static void can_msgq_put(const struct device *dev, struct can_frame *frame, void *user_data)
 {
 	struct k_msgq *msgq = (struct k_msgq *)user_data;
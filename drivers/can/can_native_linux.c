@@ -18,19 +18,16 @@
 #include <zephyr/net/socketcan_utils.h>
 
 #include "can_native_linux_adapt.h"
+#include "can_sw_filter.h"
 #include "nsi_host_trampolines.h"
 
 LOG_MODULE_REGISTER(can_native_linux, CONFIG_CAN_LOG_LEVEL);
 
-struct can_filter_context {
-	can_rx_callback_t rx_cb;
-	void *cb_arg;
-	struct can_filter filter;
-};
-
 struct can_native_linux_data {
 	struct can_driver_data common;
-	struct can_filter_context filters[CONFIG_CAN_MAX_FILTER];
+	struct can_sw_filter filters[CONFIG_CAN_MAX_FILTER];
+	int16_t filter_buckets[CAN_SW_FILTER_BUCKETS(CONFIG_CAN_MAX_FILTER)];
+	struct can_sw_filter_table filter_table;
 	struct k_mutex filter_mutex;
 	struct k_sem tx_idle;
 	can_tx_callback_t tx_callback;
@@ -49,27 +46,9 @@ struct can_native_linux_config {
 static void dispatch_frame(const struct device *dev, struct can_frame *frame)
 {
 	struct can_native_linux_data *data = dev->data;
-	can_rx_callback_t callback;
-	struct can_frame tmp_frame;
 
 	k_mutex_lock(&data->filter_mutex, K_FOREVER);
-
-	for (int filter_id = 0; filter_id < ARRAY_SIZE(data->filters); filter_id++) {
-		if (data->filters[filter_id].rx_cb == NULL) {
-			continue;
-		}
-
-		if (!can_frame_matches_filter(frame, &data->filters[filter_id].filter)) {
-			continue;
-		}
-
-		/* Make a temporary copy in case the user modifies the message */
-		tmp_frame = *frame;
-
-		callback = data->filters[filter_id].rx_cb;
-		callback(dev, &tmp_frame, data->filters[filter_id].cb_arg);
-	}
-
+	can_sw_filter_dispatch(dev, &data->filter_table, frame);
 	k_mutex_unlock(&data->filter_mutex);
 }
 
@@ -197,8 +176,7 @@ static int can_native_linux_add_rx_filter(const struct device *dev, can_rx_callb
 					  void *cb_arg, const struct can_filter *filter)
 {
 	struct can_native_linux_data *data = dev->data;
-	struct can_filter_context *filter_ctx;
-	int filter_id = -ENOSPC;
+	int filter_id;
 
 	LOG_DBG("Setting filter ID: 0x%x, mask: 0x%x", filter->id,
 		filter->mask);
@@ -209,27 +187,14 @@ static int can_native_linux_add_rx_filter(const struct device *dev, can_rx_callb
 	}
 
 	k_mutex_lock(&data->filter_mutex, K_FOREVER);
-
-	for (int i = 0; i < ARRAY_SIZE(data->filters); i++) {
-		if (data->filters[i].rx_cb == NULL) {
-			filter_id = i;
-			break;
-		}
-	}
+	filter_id = can_sw_filter_add(&data->filter_table, cb, cb_arg, filter);
+	k_mutex_unlock(&data->filter_mutex);
 
 	if (filter_id < 0) {
 		LOG_ERR("No free filter left");
-		k_mutex_unlock(&data->filter_mutex);
 		return filter_id;
 	}
 
-	filter_ctx = &data->filters[filter_id];
-	filter_ctx->rx_cb = cb;
-	filter_ctx->cb_arg = cb_arg;
-	filter_ctx->filter = *filter;
-
-	k_mutex_unlock(&data->filter_mutex);
-
 	LOG_DBG("Filter added. ID: %d", filter_id);
 
 	return filter_id;
@@ -245,7 +210,7 @@ static void can_native_linux_remove_rx_filter(const struct device *dev, int filt
 	}
 
 	k_mutex_lock(&data->filter_mutex, K_FOREVER);
-	data->filters[filter_id].rx_cb = NULL;
+	(void)can_sw_filter_remove(&data->filter_table, filter_id);
 	k_mutex_unlock(&data->filter_mutex);
 
 	LOG_DBG("Filter removed. ID: %d", filter_id);
@@ -450,6 +415,8 @@ static int can_native_linux_init(const struct device *dev)
 
 	k_mutex_init(&data->filter_mutex);
 	k_sem_init(&data->tx_idle, 1, 1);
+	can_sw_filter_init(&data->filter_table, data->filters, ARRAY_SIZE(data->filters),
+			   data->filter_buckets);
 
 	data->dev_fd = linux_socketcan_iface_open(cfg->if_name);
 	if (data->dev_fd < 0) {
@@ -0,0 +1,168 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include "can_sw_filter.h"
+
+static bool filter_is_exact(const struct can_filter *filter)
+{
+	uint32_t id_mask = (filter->flags & CAN_FILTER_IDE) != 0U ? CAN_EXT_ID_MASK :
+								     CAN_STD_ID_MASK;
+
+	return (filter->mask & id_mask) == id_mask;
+}
+
+static uint16_t id_hash(const struct can_sw_filter_table *table, uint32_t id, bool ide)
+{
+	uint32_t hash = id ^ (id >> 11) ^ (id >> 22) ^ (ide ? 0x5a5U : 0U);
+
+	return hash & table->bucket_mask;
+}
+
+static int16_t *filter_list(struct can_sw_filter_table *table, const struct can_filter *filter)
+{
+	bool ide = (filter->flags & CAN_FILTER_IDE) != 0U;
+
+	if (!filter_is_exact(filter)) {
+		return &table->masked;
+	}
+
+	return &table->buckets[id_hash(table, filter->id & filter->mask, ide)];
+}
+
+void can_sw_filter_init(struct can_sw_filter_table *table, struct can_sw_filter *filters,
+			uint16_t filter_count, int16_t *buckets)
+{
+	table->filters = filters;
+	table->buckets = buckets;
+	table->filter_count = filter_count;
+	table->bucket_mask = CAN_SW_FILTER_BUCKETS(filter_count) - 1U;
+	table->masked = -1;
+	table->dispatching = 0U;
+	table->unlink_pending = false;
+
+	for (int i = 0; i < filter_count; i++) {
+		filters[i].rx_cb = NULL;
+		filters[i].next = -1;
+		filters[i].unlink_pending = false;
+	}
+
+	for (int i = 0; i <= table->bucket_mask; i++) {
+		buckets[i] = -1;
+	}
+}
+
+int can_sw_filter_add(struct can_sw_filter_table *table, can_rx_callback_t cb, void *cb_arg,
+		      const struct can_filter *filter)
+{
+	struct can_sw_filter *sw_filter;
+	int16_t *list;
+
+	for (int i = 0; i < table->filter_count; i++) {
+		sw_filter = &table->filters[i];
+		if (sw_filter->rx_cb != NULL || sw_filter->unlink_pending) {
+			continue;
+		}
+
+		sw_filter->rx_cb = cb;
+		sw_filter->cb_arg = cb_arg;
+		sw_filter->filter = *filter;
+
+		list = filter_list(table, filter);
+		sw_filter->next = *list;
+		*list = i;
+
+		return i;
+	}
+
+	return -ENOSPC;
+}
+
+static void filter_unlink(struct can_sw_filter_table *table, int filter_id)
+{
+	struct can_sw_filter *sw_filter = &table->filters[filter_id];
+	int16_t *list;
+
+	list = filter_list(table, &sw_filter->filter);
+	while (*list != filter_id) {
+		list = &table->filters[*list].next;
+	}
+
+	*list = sw_filter->next;
+	sw_filter->next = -1;
+	sw_filter->unlink_pending = false;
+}
+
+int can_sw_filter_remove(struct can_sw_filter_table *table, int filter_id)
+{
+	if (filter_id < 0 || filter_id >= table->filter_count ||
+	    table->filters[filter_id].rx_cb == NULL) {
+		return -EINVAL;
+	}
+
+	table->filters[filter_id].rx_cb = NULL;
+
+	if (table->dispatching > 0U) {
+		/* A callback removes it, the list may be walked right now */
+		table->filters[filter_id].unlink_pending = true;
+		table->unlink_pending = true;
+		return 0;
+	}
+
+	filter_unlink(table, filter_id);
+
+	return 0;
+}
+
+static void dispatch_list(const struct device *dev, struct can_sw_filter_table *table,
+			  int16_t index, const struct can_frame *frame)
+{
+	struct can_sw_filter *sw_filter;
+	struct can_frame tmp_frame;
+
+	/*
+	 * Filters removed by the callbacks stay linked until the dispatch is
+	 * done, and filters added by them go to the head of their list, so
+	 * the next index is still valid after a callback.
+	 */
+	for (; index >= 0; index = sw_filter->next) {
+		sw_filter = &table->filters[index];
+
+		if (sw_filter->rx_cb == NULL ||
+		    !can_frame_matches_filter(frame, &sw_filter->filter)) {
+			continue;
+		}
+
+		/* Make a temporary copy in case the user modifies the message */
+		tmp_frame = *frame;
+		sw_filter->rx_cb(dev, &tmp_frame, sw_filter->cb_arg);
+	}
+}
+
+void can_sw_filter_dispatch(const struct device *dev, struct can_sw_filter_table *table,
+			    const struct can_frame *frame)
+{
+	bool ide = (frame->flags & CAN_FRAME_IDE) != 0U;
+
+	table->dispatching++;
+	dispatch_list(dev, table, table->buckets[id_hash(table, frame->id, ide)], frame);
+	dispatch_list(dev, table, table->masked, frame);
+	table->dispatching--;
+
+	if (table->dispatching > 0U || !table->unlink_pending) {
+		return;
+	}
+
+	for (int i = 0; i < table->filter_count; i++) {
+		if (table->filters[i].unlink_pending) {
+			filter_unlink(table, i);
+		}
+	}
+
+	table->unlink_pending = false;
+}
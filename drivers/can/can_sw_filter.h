@@ -0,0 +1,90 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_CAN_CAN_SW_FILTER_H_
+#define ZEPHYR_DRIVERS_CAN_CAN_SW_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Software RX filters of the CAN drivers without hardware filters.
+ *
+ * The filters matching a single CAN ID are kept in hash buckets, so a
+ * received frame is only matched against the filters that can match its ID
+ * and against the filters with a mask. Locking is left to the driver.
+ *
+ * The callbacks may add and remove filters. A filter removed while frames
+ * are dispatched is no longer called, but stays linked until the dispatch
+ * is done, so that the lists being walked are left intact.
+ */
+
+/* Number of hash buckets for a table of n filters */
+#define CAN_SW_FILTER_BUCKETS(n) ((size_t)NHPOT(n))
+
+struct can_sw_filter {
+	can_rx_callback_t rx_cb;
+	void *cb_arg;
+	struct can_filter filter;
+	/* Next filter of the bucket or of the masked list, -1 for none */
+	int16_t next;
+	/* Removed during a dispatch, still linked */
+	bool unlink_pending;
+};
+
+struct can_sw_filter_table {
+	struct can_sw_filter *filters;
+	int16_t *buckets;
+	uint16_t filter_count;
+	uint16_t bucket_mask;
+	/* First filter with a mask, -1 for none */
+	int16_t masked;
+	/* Nesting of can_sw_filter_dispatch() calls */
+	uint8_t dispatching;
+	/* Some filters are to be unlinked once the dispatch is done */
+	bool unlink_pending;
+};
+
+/**
+ * @brief Initialize a table of software filters, with no filter in use
+ *
+ * @param table Table to initialize.
+ * @param filters Storage for the filters.
+ * @param filter_count Number of filters.
+ * @param buckets Storage for the hash buckets, of
+ *                CAN_SW_FILTER_BUCKETS(filter_count) entries.
+ */
+void can_sw_filter_init(struct can_sw_filter_table *table, struct can_sw_filter *filters,
+			uint16_t filter_count, int16_t *buckets);
+
+/**
+ * @brief Add a filter to a table of software filters
+ *
+ * @return Filter ID on success, -ENOSPC if all the filters are in use.
+ */
+int can_sw_filter_add(struct can_sw_filter_table *table, can_rx_callback_t cb, void *cb_arg,
+		      const struct can_filter *filter);
+
+/**
+ * @brief Remove a filter from a table of software filters
+ *
+ * @return 0 on success, -EINVAL if the filter ID is not in use.
+ */
+int can_sw_filter_remove(struct can_sw_filter_table *table, int filter_id);
+
+/**
+ * @brief Call the callbacks of the filters matching a frame
+ *
+ * Each callback is given its own copy of the frame.
+ */
+void can_sw_filter_dispatch(const struct device *dev, struct can_sw_filter_table *table,
+			    const struct can_frame *frame);
+
+#endif /* ZEPHYR_DRIVERS_CAN_CAN_SW_FILTER_H_ */
@@ -31,6 +31,7 @@
 #include <zephyr/linker/sections.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/ring_buffer.h>
 #include <zephyr/pm/device_runtime.h>
 #ifdef CONFIG_UART_CONSOLE_MCUMGR
 #include <zephyr/mgmt/mcumgr/transport/serial.h>
@@ -63,7 +64,111 @@ void uart_console_out_debug_hook_install(uart_console_out_debug_hook_t *hook)
 #endif /* CONFIG_UART_CONSOLE_DEBUG_SERVER_HOOKS */
 
 
-#if defined(CONFIG_PRINTK) || defined(CONFIG_STDOUT_CONSOLE)
+#ifdef CONFIG_UART_CONSOLE_ASYNC
+
+RING_BUF_DECLARE(console_tx_ring, CONFIG_UART_CONSOLE_ASYNC_BUF_SIZE);
+static struct k_spinlock console_tx_lock;
+static bool console_tx_busy;
+
+/* Sends the longest contiguous part of the queued output, lock held */
+static void console_tx_start(void)
+{
+	uint8_t *data;
+	uint32_t len;
+
+	if (console_tx_busy) {
+		return;
+	}
+
+	len = ring_buf_get_claim(&console_tx_ring, &data,
+				 CONFIG_UART_CONSOLE_ASYNC_BUF_SIZE);
+	if (len == 0) {
+		return;
+	}
+
+	if (pm_device_runtime_get(uart_console_dev) < 0 ||
+	    uart_tx(uart_console_dev, data, len, SYS_FOREVER_US) < 0) {
+		/* Nothing else to do with output the UART does not take */
+		(void)ring_buf_get_finish(&console_tx_ring, len);
+		(void)pm_device_runtime_put_async(uart_console_dev, K_MSEC(1));
+		return;
+	}
+
+	console_tx_busy = true;
+}
+
+static void console_tx_callback(const struct device *dev,
+				struct uart_event *evt, void *user_data)
+{
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	if (evt->type != UART_TX_DONE && evt->type != UART_TX_ABORTED) {
+		return;
+	}
+
+	key = k_spin_lock(&console_tx_lock);
+
+	/* What an aborted transfer did not send is sent again */
+	(void)ring_buf_get_finish(&console_tx_ring, evt->data.tx.len);
+	(void)pm_device_runtime_put_async(uart_console_dev, K_MSEC(1));
+	console_tx_busy = false;
+	console_tx_start();
+
+	k_spin_unlock(&console_tx_lock, key);
+}
+
+/**
+ *
+ * @brief Queue a string for output to UART
+ *
+ * Outputs both line feed and carriage return in the case of a '\n'.
+ *
+ * @param s Characters to output
+ * @param n Number of characters
+ */
+static void console_str_out(const char *s, size_t n)
+{
+	k_spinlock_key_t key = k_spin_lock(&console_tx_lock);
+	size_t i;
+
+	while (n > 0) {
+		for (i = 0; i < n && s[i] != '\n'; i++) {
+		}
+
+		if (ring_buf_put(&console_tx_ring, (const uint8_t *)s, i) != i) {
+			break;
+		}
+
+		if (i < n) {
+			if (ring_buf_space_get(&console_tx_ring) < 2) {
+				break;
+			}
+			(void)ring_buf_put(&console_tx_ring, (const uint8_t *)"\r\n", 2);
+			i++;
+		}
+
+		s += i;
+		n -= i;
+	}
+
+	console_tx_start();
+
+	k_spin_unlock(&console_tx_lock, key);
+}
+
+static int console_out(int c)
+{
+	char ch = c;
+
+	console_str_out(&ch, 1);
+
+	return c;
+}
+
+#elif defined(CONFIG_PRINTK) || defined(CONFIG_STDOUT_CONSOLE)
 /**
  *
  * @brief Output one character to UART
@@ -116,6 +221,7 @@ extern void __stdout_hook_install(int (*hook)(int c));
 
 #if defined(CONFIG_PRINTK)
 extern void __printk_hook_install(int (*fn)(int c));
+extern void __printk_str_hook_install(void (*fn)(const char *s, size_t n));
 #endif
 
 #if defined(CONFIG_CONSOLE_HANDLER)
@@ -601,6 +707,9 @@ static void uart_console_hook_install(void)
 #endif
 #if defined(CONFIG_PRINTK)
 	__printk_hook_install(console_out);
+#if defined(CONFIG_UART_CONSOLE_ASYNC)
+	__printk_str_hook_install(console_str_out);
+#endif
 #endif
 }
 
@@ -615,6 +724,14 @@ static int uart_console_init(void)
 		return -ENODEV;
 	}
 
+#ifdef CONFIG_UART_CONSOLE_ASYNC
+	int ret = uart_callback_set(uart_console_dev, console_tx_callback, NULL);
+
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+
 	uart_console_hook_install();
 
 	return 0;
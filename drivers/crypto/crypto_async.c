@@ -0,0 +1,104 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/crypto/crypto.h>
+
+/* Requests waiting for the work queue, in submission order */
+static sys_slist_t async_queue = SYS_SLIST_STATIC_INIT(&async_queue);
+static struct k_spinlock async_lock;
+static struct k_work_q async_work_q;
+static K_KERNEL_STACK_DEFINE(async_stack, CONFIG_CRYPTO_ASYNC_STACK_SIZE);
+
+static struct crypto_async_req *async_queue_get(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&async_lock);
+	sys_snode_t *node = sys_slist_get(&async_queue);
+
+	k_spin_unlock(&async_lock, key);
+
+	return (node != NULL) ? CONTAINER_OF(node, struct crypto_async_req, node) : NULL;
+}
+
+static int async_cipher(struct crypto_async_req *req)
+{
+	struct cipher_ctx *ctx = req->cipher_ctx;
+
+	switch (ctx->ops.cipher_mode) {
+	case CRYPTO_CIPHER_MODE_ECB:
+		return cipher_block_op(ctx, req->cipher_pkt);
+	case CRYPTO_CIPHER_MODE_CBC:
+		return cipher_cbc_op(ctx, req->cipher_pkt, req->iv);
+	case CRYPTO_CIPHER_MODE_CTR:
+		return cipher_ctr_op(ctx, req->cipher_pkt, req->iv);
+	case CRYPTO_CIPHER_MODE_CCM:
+		return cipher_ccm_op(ctx, req->aead_pkt, req->iv);
+	case CRYPTO_CIPHER_MODE_GCM:
+		return cipher_gcm_op(ctx, req->aead_pkt, req->iv);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static void async_work_handler(struct k_work *work)
+{
+	struct crypto_async_req *req;
+	int rc;
+
+	ARG_UNUSED(work);
+
+	while ((req = async_queue_get()) != NULL) {
+		if (req->op == CRYPTO_ASYNC_CIPHER) {
+			rc = async_cipher(req);
+		} else if (req->op == CRYPTO_ASYNC_HASH_UPDATE) {
+			rc = hash_update(req->hash_ctx, req->hash_pkt);
+		} else {
+			rc = hash_compute(req->hash_ctx, req->hash_pkt);
+		}
+
+		/* The callback can submit the request again */
+		req->cb(req, rc);
+	}
+}
+
+static K_WORK_DEFINE(async_work, async_work_handler);
+
+int crypto_async_submit(struct crypto_async_req *req)
+{
+	k_spinlock_key_t key;
+	uint16_t flags;
+
+	if ((req == NULL) || (req->cb == NULL) || (req->op > CRYPTO_ASYNC_HASH_COMPUTE) ||
+	    (req->cipher_ctx == NULL) || (req->cipher_pkt == NULL)) {
+		return -EINVAL;
+	}
+
+	flags = (req->op == CRYPTO_ASYNC_CIPHER) ? req->cipher_ctx->flags : req->hash_ctx->flags;
+	if ((flags & CAP_SYNC_OPS) == 0U) {
+		return -ENOTSUP;
+	}
+
+	key = k_spin_lock(&async_lock);
+	sys_slist_append(&async_queue, &req->node);
+	k_spin_unlock(&async_lock, key);
+
+	(void)k_work_submit_to_queue(&async_work_q, &async_work);
+
+	return 0;
+}
+
+static int crypto_async_init(void)
+{
+	k_work_queue_start(&async_work_q, async_stack, K_KERNEL_STACK_SIZEOF(async_stack),
+			   CONFIG_CRYPTO_ASYNC_PRIORITY, NULL);
+	k_thread_name_set(&async_work_q.thread, "crypto_async");
+
+	return 0;
+}
+
+SYS_INIT(crypto_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
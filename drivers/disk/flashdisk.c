@@ -28,6 +28,9 @@ struct flashdisk_data {
 	const size_t cache_size;
 	const size_t size;
 	const size_t sector_size;
+	/* Address of the flash device, if it is memory-mapped */
+	const uintptr_t map_base;
+	const bool mapped;
 	size_t page_size;
 	off_t cached_addr;
 	bool cache_valid;
@@ -400,6 +403,31 @@ static int disk_flash_access_ioctl(struct disk_info *disk, uint8_t cmd, void *bu
 	case DISK_IOCTL_GET_SECTOR_SIZE:
 		*(uint32_t *)buff = ctx->sector_size;
 		return 0;
+	case DISK_IOCTL_GET_SECTOR_MAP: {
+		struct disk_sector_map *map = buff;
+		uint32_t count = ctx->size / ctx->sector_size;
+
+		if (!ctx->mapped) {
+			return -ENOTSUP;
+		}
+
+		if (map->sector >= count) {
+			return -EINVAL;
+		}
+
+		/* The flash has to hold the cached data */
+		k_mutex_lock(&ctx->lock, K_FOREVER);
+		rc = flashdisk_cache_commit(ctx);
+		k_mutex_unlock(&ctx->lock);
+		if (rc) {
+			return rc;
+		}
+
+		map->addr = (const void *)(ctx->map_base + ctx->offset +
+					   map->sector * ctx->sector_size);
+		map->num_sector = count - map->sector;
+		return 0;
+	}
 	case DISK_IOCTL_GET_ERASE_BLOCK_SZ: /* in sectors */
 		k_mutex_lock(&ctx->lock, K_FOREVER);
 		*(uint32_t *)buff = ctx->page_size / ctx->sector_size;
@@ -426,6 +454,10 @@ static const struct disk_operations flash_disk_ops = {
 /* Force cache size to 0 if partition is read-only */
 #define CACHE_SIZE(n) (DT_INST_PROP(n, cache_size) * !DT_PROP(PARTITION_PHANDLE(n), read_only))
 
+/* Flash of the partition, memory-mapped if it is the SoC flash */
+#define PARTITION_FLASH(n) DT_GPARENT(PARTITION_PHANDLE(n))
+#define PARTITION_FLASH_MAPPED(n) DT_NODE_HAS_COMPAT(PARTITION_FLASH(n), soc_nv_flash)
+
 #define DEFINE_FLASHDISKS_CACHE(n) \
 	static uint8_t __aligned(4) flashdisk##n##_cache[CACHE_SIZE(n)];
 DT_INST_FOREACH_STATUS_OKAY(DEFINE_FLASHDISKS_CACHE)
@@ -442,6 +474,9 @@ DT_INST_FOREACH_STATUS_OKAY(DEFINE_FLASHDISKS_CACHE)
 	.cache_size = sizeof(flashdisk##n##_cache),				\
 	.size = DT_REG_SIZE(PARTITION_PHANDLE(n)),				\
 	.sector_size = DT_INST_PROP(n, sector_size),				\
+	.mapped = PARTITION_FLASH_MAPPED(n),					\
+	.map_base = COND_CODE_1(PARTITION_FLASH_MAPPED(n),			\
+				(DT_REG_ADDR(PARTITION_FLASH(n))), (0)),	\
 },
 
 static struct flashdisk_data flash_disks[] = {
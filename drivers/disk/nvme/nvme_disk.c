@@ -119,6 +119,62 @@ out:
 	return ret;
 }
 
+#ifdef CONFIG_DISK_ACCESS_ASYNC
+static void nvme_disk_submit_cb(void *arg, const struct nvme_completion *cpl)
+{
+	struct disk_access_req *req = arg;
+
+	/* No completion on timeout */
+	if ((cpl == NULL) || nvme_completion_is_error(cpl)) {
+		LOG_WRN("Request at sector %u (count %d) on disk %s failed",
+			req->start_sector, req->num_sector, req->disk->name);
+		req->cb(req, -EIO);
+		return;
+	}
+
+	req->cb(req, 0);
+}
+
+static int nvme_disk_submit(struct disk_info *disk, struct disk_access_req *req)
+{
+	struct nvme_namespace *ns = CONTAINER_OF(disk->name,
+						 struct nvme_namespace, name[0]);
+	struct nvme_request *request;
+	uint32_t payload_size;
+	int ret;
+
+	if (!NVME_IS_BUFFER_DWORD_ALIGNED(req->buf)) {
+		LOG_WRN("Data buffer pointer needs to be 4-bytes aligned");
+		return -EINVAL;
+	}
+
+	nvme_lock(disk->dev);
+
+	payload_size = req->num_sector * nvme_namespace_get_sector_size(ns);
+
+	request = nvme_allocate_request_vaddr((void *)req->buf, payload_size,
+					      nvme_disk_submit_cb, req);
+	if (request == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	if (req->op == DISK_ACCESS_REQ_READ) {
+		nvme_namespace_read_cmd(&request->cmd, ns->id,
+					req->start_sector, req->num_sector);
+	} else {
+		nvme_namespace_write_cmd(&request->cmd, ns->id,
+					 req->start_sector, req->num_sector);
+	}
+
+	/* Completes from the interrupt, the queue keeps several in flight */
+	ret = nvme_cmd_qpair_submit_request(ns->ctrlr->ioq, request);
+out:
+	nvme_unlock(disk->dev);
+	return ret;
+}
+#endif /* CONFIG_DISK_ACCESS_ASYNC */
+
 static int nvme_disk_flush(struct nvme_namespace *ns)
 {
 	struct nvme_completion_poll_status status =
@@ -200,6 +256,9 @@ static const struct disk_operations nvme_disk_ops = {
 	.read = nvme_disk_read,
 	.write = nvme_disk_write,
 	.ioctl = nvme_disk_ioctl,
+#ifdef CONFIG_DISK_ACCESS_ASYNC
+	.submit = nvme_disk_submit,
+#endif
 };
 
 int nvme_namespace_disk_setup(struct nvme_namespace *ns,
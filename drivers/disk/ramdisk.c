@@ -98,6 +98,17 @@ static int disk_ram_access_ioctl(struct disk_info *disk, uint8_t cmd, void *buff
 	case DISK_IOCTL_GET_ERASE_BLOCK_SZ:
 		*(uint32_t *)buff  = 1U;
 		break;
+	case DISK_IOCTL_GET_SECTOR_MAP: {
+		struct disk_sector_map *map = buff;
+
+		if (map->sector >= config->sector_count) {
+			return -EINVAL;
+		}
+
+		map->addr = lba_to_address(disk->dev, map->sector);
+		map->num_sector = config->sector_count - map->sector;
+		break;
+	}
 	default:
 		return -EINVAL;
 	}
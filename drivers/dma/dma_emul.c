@@ -267,6 +267,18 @@ static void dma_emul_work_handler(struct k_work *work)
 				memcpy((void *)(uintptr_t)block.dest_address,
 				       (void *)(uintptr_t)block.source_address, bytes);
 			}
+
+			if (xfer_config.cyclic && xfer_config.complete_callback_en) {
+				xfer_config.dma_callback(dev, xfer_config.user_data, channel,
+							 DMA_STATUS_BLOCK);
+			}
+		}
+
+		if (xfer_config.cyclic) {
+			/* start again from the head block until stopped */
+			LOG_DBG("restarting cyclic list");
+			k_yield();
+			continue;
 		}
 
 		key = k_spin_lock(&data->lock);
@@ -494,9 +506,31 @@ static int dma_emul_get_status(const struct device *dev, uint32_t channel,
 
 static int dma_emul_get_attribute(const struct device *dev, uint32_t type, uint32_t *value)
 {
+	const struct dma_emul_config *config = dev->config;
+
 	LOG_DBG("%s()", __func__);
 
-	return -ENOSYS;
+	switch (type) {
+	case DMA_ATTR_BUFFER_ADDRESS_ALIGNMENT:
+		*value = config->addr_align;
+		break;
+	case DMA_ATTR_BUFFER_SIZE_ALIGNMENT:
+		*value = config->size_align;
+		break;
+	case DMA_ATTR_COPY_ALIGNMENT:
+		*value = config->copy_align;
+		break;
+	case DMA_ATTR_MAX_BLOCK_COUNT:
+		*value = config->num_requests;
+		break;
+	case DMA_ATTR_CYCLIC:
+		*value = 1;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
 }
 
 static bool dma_emul_chan_filter(const struct device *dev, int channel, void *filter_param)
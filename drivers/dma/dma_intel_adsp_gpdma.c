@@ -416,6 +416,10 @@ int intel_adsp_gpdma_get_attribute(const struct device *dev, uint32_t type, uint
 	case DMA_ATTR_MAX_BLOCK_COUNT:
 		*value = CONFIG_DMA_DW_LLI_POOL_SIZE;
 		break;
+	case DMA_ATTR_CYCLIC:
+		/* The tail LLI links back to the head one */
+		*value = 1;
+		break;
 	default:
 		return -EINVAL;
 	}
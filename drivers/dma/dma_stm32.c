@@ -365,7 +365,7 @@ DMA_STM32_EXPORT_API int dma_stm32_configure(const struct device *dev,
 	stream->user_data       = config->user_data;
 	stream->src_size	= config->source_data_size;
 	stream->dst_size	= config->dest_data_size;
-	stream->cyclic		= config->head_block->source_reload_en;
+	stream->cyclic		= config->cyclic || config->head_block->source_reload_en;
 
 	/* Check dest or source memory address, warn if 0 */
 	if (config->head_block->source_address == 0) {
@@ -685,12 +685,31 @@ DMA_STM32_EXPORT_API int dma_stm32_get_status(const struct device *dev,
 	return 0;
 }
 
+static int dma_stm32_get_attribute(const struct device *dev, uint32_t type, uint32_t *value)
+{
+	switch (type) {
+	case DMA_ATTR_MAX_BLOCK_COUNT:
+		/* Only the head block is programmed in the stream */
+		*value = 1;
+		break;
+	case DMA_ATTR_CYCLIC:
+		/* Circular mode */
+		*value = 1;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 static const struct dma_driver_api dma_funcs = {
 	.reload		 = dma_stm32_reload,
 	.config		 = dma_stm32_configure,
 	.start		 = dma_stm32_start,
 	.stop		 = dma_stm32_stop,
 	.get_status	 = dma_stm32_get_status,
+	.get_attribute	 = dma_stm32_get_attribute,
 };
 
 #define DMA_STM32_INIT_DEV(index)					\
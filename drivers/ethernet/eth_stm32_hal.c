@@ -800,11 +800,32 @@ out:
 	return pkt;
 }
 
+static void rx_flush(struct net_if *iface, sys_slist_t *batch)
+{
+	struct net_pkt *pkt;
+	int res;
+
+	if (sys_slist_is_empty(batch)) {
+		return;
+	}
+
+	res = net_recv_data_list(iface, batch);
+	if (res < 0) {
+		LOG_ERR("Failed to enqueue frame into RX queue: %d", res);
+		while ((pkt = (struct net_pkt *)sys_slist_get(batch)) != NULL) {
+			eth_stats_update_errors_rx(net_pkt_iface(pkt));
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
 static void rx_thread(void *arg1, void *unused1, void *unused2)
 {
 	const struct device *dev;
 	struct eth_stm32_hal_dev_data *dev_data;
 	struct net_if *iface;
+	struct net_if *batch_iface;
+	sys_slist_t batch;
 	struct net_pkt *pkt;
 	int res;
 	uint32_t status;
@@ -819,6 +840,8 @@ static void rx_thread(void *arg1, void *unused1, void *unused2)
 
 	__ASSERT_NO_MSG(dev_data != NULL);
 
+	sys_slist_init(&batch);
+
 	while (1) {
 		res = k_sem_take(&dev_data->rx_int_sem,
 			K_MSEC(CONFIG_ETH_STM32_CARRIER_CHECK_RX_IDLE_TIMEOUT_MS));
@@ -828,20 +851,22 @@ static void rx_thread(void *arg1, void *unused1, void *unused2)
 				dev_data->link_up = true;
 				net_eth_carrier_on(get_iface(dev_data));
 			}
+			/* Hand the frames drained in this round to the stack
+			 * as one batch per interface.
+			 */
+			batch_iface = NULL;
 			while ((pkt = eth_rx(dev)) != NULL) {
 				iface = net_pkt_iface(pkt);
 #if defined(CONFIG_NET_DSA)
 				iface = dsa_net_recv(iface, &pkt);
 #endif
-				res = net_recv_data(iface, pkt);
-				if (res < 0) {
-					eth_stats_update_errors_rx(
-							net_pkt_iface(pkt));
-					LOG_ERR("Failed to enqueue frame "
-						"into RX queue: %d", res);
-					net_pkt_unref(pkt);
+				if (iface != batch_iface) {
+					rx_flush(batch_iface, &batch);
+					batch_iface = iface;
 				}
+				sys_slist_append(&batch, (sys_snode_t *)pkt);
 			}
+			rx_flush(batch_iface, &batch);
 		} else if (res == -EAGAIN) {
 			/* semaphore timeout period expired, check link status */
 			hal_ret = read_eth_phy_register(&dev_data->heth,
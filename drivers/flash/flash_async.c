@@ -0,0 +1,154 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/flash.h>
+
+/* Requests waiting for the work queue, in submission order */
+static sys_slist_t async_queue = SYS_SLIST_STATIC_INIT(&async_queue);
+static struct k_spinlock async_lock;
+static struct k_work_q async_work_q;
+static K_KERNEL_STACK_DEFINE(async_stack, CONFIG_FLASH_ASYNC_STACK_SIZE);
+
+static struct flash_async_req *async_queue_get(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&async_lock);
+	sys_snode_t *node = sys_slist_get(&async_queue);
+
+	k_spin_unlock(&async_lock, key);
+
+	return (node != NULL) ? CONTAINER_OF(node, struct flash_async_req, node) : NULL;
+}
+
+static int async_do(struct flash_async_req *req)
+{
+	if (req->op == FLASH_ASYNC_READ) {
+		return flash_read(req->dev, req->offset, req->data, req->len);
+	}
+
+	return flash_write(req->dev, req->offset, req->data, req->len);
+}
+
+#if defined(CONFIG_FLASH_PAGE_LAYOUT)
+/*
+ * Take the read at the head of the queue if it does not read the part of the
+ * flash from offset to end, which an erase has still to erase.
+ */
+static struct flash_async_req *async_queue_get_read(const struct device *dev,
+						    off_t offset, off_t end)
+{
+	struct flash_async_req *next;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&async_lock);
+	next = SYS_SLIST_PEEK_HEAD_CONTAINER(&async_queue, next, node);
+	if ((next != NULL) &&
+	    ((next->op != FLASH_ASYNC_READ) ||
+	     ((next->dev == dev) && (next->offset < end) &&
+	      (next->offset + (off_t)next->len > offset)))) {
+		next = NULL;
+	}
+	if (next != NULL) {
+		(void)sys_slist_get(&async_queue);
+	}
+	k_spin_unlock(&async_lock, key);
+
+	return next;
+}
+
+static int async_erase(struct flash_async_req *req)
+{
+	struct flash_async_req *read;
+	struct flash_pages_info info;
+	off_t end = req->offset + req->len;
+	off_t offset = req->offset;
+	size_t size;
+	int rc;
+
+	while (offset < end) {
+		rc = flash_get_page_info_by_offs(req->dev, offset, &info);
+		if (rc != 0) {
+			return rc;
+		}
+
+		/* An erase that does not start on a page boundary is refused */
+		size = MIN(info.start_offset + info.size - offset, end - offset);
+		rc = flash_erase(req->dev, offset, size);
+		if (rc != 0) {
+			return rc;
+		}
+		offset += size;
+
+		/* Let the reads that follow the erase in, if it is not done */
+		while ((offset < end) &&
+		       ((read = async_queue_get_read(req->dev, offset, end)) != NULL)) {
+			read->cb(read, async_do(read));
+		}
+	}
+
+	return 0;
+}
+#else
+static int async_erase(struct flash_async_req *req)
+{
+	return flash_erase(req->dev, req->offset, req->len);
+}
+#endif /* CONFIG_FLASH_PAGE_LAYOUT */
+
+static void async_work_handler(struct k_work *work)
+{
+	struct flash_async_req *req;
+	int rc;
+
+	ARG_UNUSED(work);
+
+	while ((req = async_queue_get()) != NULL) {
+		if (req->op == FLASH_ASYNC_ERASE) {
+			rc = async_erase(req);
+		} else {
+			rc = async_do(req);
+		}
+
+		/* The callback can submit the request again */
+		req->cb(req, rc);
+	}
+}
+
+static K_WORK_DEFINE(async_work, async_work_handler);
+
+int flash_async_submit(const struct device *dev, struct flash_async_req *req)
+{
+	k_spinlock_key_t key;
+
+	if ((dev == NULL) || (req == NULL) || (req->cb == NULL) ||
+	    (req->op > FLASH_ASYNC_ERASE) ||
+	    ((req->op != FLASH_ASYNC_ERASE) && (req->data == NULL) && (req->len > 0))) {
+		return -EINVAL;
+	}
+
+	req->dev = dev;
+
+	key = k_spin_lock(&async_lock);
+	sys_slist_append(&async_queue, &req->node);
+	k_spin_unlock(&async_lock, key);
+
+	(void)k_work_submit_to_queue(&async_work_q, &async_work);
+
+	return 0;
+}
+
+static int flash_async_init(void)
+{
+	k_work_queue_start(&async_work_q, async_stack, K_KERNEL_STACK_SIZEOF(async_stack),
+			   CONFIG_FLASH_ASYNC_PRIORITY, NULL);
+	k_thread_name_set(&async_work_q.thread, "flash_async");
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
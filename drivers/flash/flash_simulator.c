@@ -241,10 +241,10 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	bool data_part_ignored = false;
 
 	if (flash_sim_thresholds.max_write_calls != 0) {
-		if (flash_sim_stats.flash_write_calls >
+		if (STATS_GET(flash_sim_stats, flash_write_calls) >
 			flash_sim_thresholds.max_write_calls) {
 			return 0;
-		} else if (flash_sim_stats.flash_write_calls ==
+		} else if (STATS_GET(flash_sim_stats, flash_write_calls) ==
 				flash_sim_thresholds.max_write_calls) {
 			if (flash_sim_thresholds.max_len == 0) {
 				return 0;
@@ -313,7 +313,7 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 
 #ifdef CONFIG_FLASH_SIMULATOR_STATS
 	if ((flash_sim_thresholds.max_erase_calls != 0) &&
-	    (flash_sim_stats.flash_erase_calls >=
+	    (STATS_GET(flash_sim_stats, flash_erase_calls) >=
 		flash_sim_thresholds.max_erase_calls)){
 		return 0;
 	}
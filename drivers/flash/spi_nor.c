@@ -168,6 +168,14 @@ struct spi_nor_config {
  */
 struct spi_nor_data {
 	struct k_sem sem;
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	/* Held by everything but reads, for their whole duration, so that
+	 * only reads wait for sem while an erase is suspended.
+	 */
+	struct k_sem excl_sem;
+	/* Number of reads waiting for sem */
+	atomic_t readers;
+#endif
 #if ANY_INST_HAS_DPD
 	/* Low 32-bits of uptime counter at which device last entered
 	 * deep power-down.
@@ -473,6 +481,61 @@ static int spi_nor_wait_until_ready(const struct device *dev, k_timeout_t poll_d
 	return ret;
 }
 
+/**
+ * @brief Wait until a sector or block erase completes
+ *
+ * With CONFIG_SPI_NOR_ERASE_SUSPEND, the erase is suspended when reads are
+ * waiting for the device, and resumed once they are done.
+ *
+ * @note The device must be externally acquired before invoking this
+ * function.
+ *
+ * @param dev The device structure
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_wait_until_erased(const struct device *dev)
+{
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	struct spi_nor_data *const driver_data = dev->data;
+	int ret;
+	uint8_t reg;
+
+	while (true) {
+		ret = spi_nor_cmd_read(dev, SPI_NOR_CMD_RDSR, &reg, sizeof(reg));
+		if (ret || !(reg & SPI_NOR_WIP_BIT)) {
+			break;
+		}
+
+		if (atomic_get(&driver_data->readers) > 0) {
+			/* WIP clears once the erase is suspended */
+			ret = spi_nor_cmd_write(dev, CONFIG_SPI_NOR_ERASE_SUSPEND_CMD);
+			if (ret == 0) {
+				ret = spi_nor_wait_until_ready(dev, WAIT_READY_REGISTER);
+			}
+			if (ret) {
+				break;
+			}
+
+			/* Only reads wait for the semaphore, they get it first */
+			k_sem_give(&driver_data->sem);
+			k_sem_take(&driver_data->sem, K_FOREVER);
+
+			/* Ignored by the device if the erase had completed */
+			ret = spi_nor_cmd_write(dev, CONFIG_SPI_NOR_ERASE_RESUME_CMD);
+			if (ret) {
+				break;
+			}
+		}
+
+		/* Give the erase time to progress before it is suspended again */
+		k_sleep(WAIT_READY_ERASE);
+	}
+	return ret;
+#else
+	return spi_nor_wait_until_ready(dev, WAIT_READY_ERASE);
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
+}
+
 #if defined(CONFIG_SPI_NOR_SFDP_RUNTIME) || defined(CONFIG_FLASH_JESD216_API)
 /*
  * @brief Read content from the SFDP hierarchy
@@ -562,6 +625,9 @@ static void acquire_device(const struct device *dev)
 	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct spi_nor_data *const driver_data = dev->data;
 
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+		k_sem_take(&driver_data->excl_sem, K_FOREVER);
+#endif
 		k_sem_take(&driver_data->sem, K_FOREVER);
 	}
 
@@ -585,9 +651,39 @@ static void release_device(const struct device *dev)
 		struct spi_nor_data *const driver_data = dev->data;
 
 		k_sem_give(&driver_data->sem);
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+		k_sem_give(&driver_data->excl_sem);
+#endif
 	}
 }
 
+/* Access to the device for reads, which can be done while an erase is
+ * suspended.
+ */
+static void acquire_device_read(const struct device *dev)
+{
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	struct spi_nor_data *const driver_data = dev->data;
+
+	atomic_inc(&driver_data->readers);
+	k_sem_take(&driver_data->sem, K_FOREVER);
+	atomic_dec(&driver_data->readers);
+#else
+	acquire_device(dev);
+#endif
+}
+
+static void release_device_read(const struct device *dev)
+{
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	struct spi_nor_data *const driver_data = dev->data;
+
+	k_sem_give(&driver_data->sem);
+#else
+	release_device(dev);
+#endif
+}
+
 /**
  * @brief Read the status register.
  *
@@ -776,11 +872,11 @@ static int spi_nor_read(const struct device *dev, off_t addr, void *dest,
 		return -EINVAL;
 	}
 
-	acquire_device(dev);
+	acquire_device_read(dev);
 
 	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, size);
 
-	release_device(dev);
+	release_device_read(dev);
 	return ret;
 }
 
@@ -891,9 +987,11 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 	ret = spi_nor_write_protection_set(dev, false);
 
 	while ((size > 0) && (ret == 0)) {
+		bool chip_erase = (size == flash_size);
+
 		spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
 
-		if (size == flash_size) {
+		if (chip_erase) {
 			/* chip erase */
 			spi_nor_cmd_write(dev, SPI_NOR_CMD_CE);
 			size -= flash_size;
@@ -935,7 +1033,9 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 		 */
 		volatile int xcc_ret =
 #endif
-		spi_nor_wait_until_ready(dev, WAIT_READY_ERASE);
+		/* Chip erases can not be suspended */
+		chip_erase ? spi_nor_wait_until_ready(dev, WAIT_READY_ERASE)
+			   : spi_nor_wait_until_erased(dev);
 	}
 
 	int ret2 = spi_nor_write_protection_set(dev, true);
@@ -1482,6 +1582,9 @@ static int spi_nor_init(const struct device *dev)
 		struct spi_nor_data *const driver_data = dev->data;
 
 		k_sem_init(&driver_data->sem, 1, K_SEM_MAX_LIMIT);
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+		k_sem_init(&driver_data->excl_sem, 1, K_SEM_MAX_LIMIT);
+#endif
 	}
 
 #if ANY_INST_HAS_WP_GPIOS
@@ -0,0 +1,86 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/drivers/gpio/gpio_capture.h>
+
+static void gpio_capture_handler(const struct device *port, struct gpio_callback *cb,
+				 gpio_port_pins_t pins)
+{
+	struct gpio_capture *capture = CONTAINER_OF(cb, struct gpio_capture, cb);
+	uint32_t timestamp = k_cycle_get_32();
+	struct gpio_capture_event *event;
+	gpio_port_value_t value = 0;
+	k_spinlock_key_t key;
+
+	(void)gpio_port_get_raw(port, &value);
+
+	key = k_spin_lock(&capture->lock);
+	if (capture->head - capture->tail == capture->size) {
+		capture->overruns++;
+	} else {
+		event = &capture->events[capture->head & (capture->size - 1U)];
+		event->timestamp = timestamp;
+		event->pins = pins;
+		event->value = value & cb->pin_mask;
+		capture->head++;
+	}
+	k_spin_unlock(&capture->lock, key);
+
+	k_sem_give(&capture->sem);
+}
+
+int gpio_capture_start(const struct device *port, struct gpio_capture *capture,
+		       gpio_port_pins_t pins)
+{
+	gpio_init_callback(&capture->cb, gpio_capture_handler, pins);
+
+	return gpio_add_callback(port, &capture->cb);
+}
+
+int gpio_capture_stop(const struct device *port, struct gpio_capture *capture)
+{
+	return gpio_remove_callback(port, &capture->cb);
+}
+
+int gpio_capture_read(struct gpio_capture *capture, struct gpio_capture_event *events,
+		      size_t max_events, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	size_t count = 0;
+
+	if (max_events == 0) {
+		return 0;
+	}
+
+	while (count == 0) {
+		key = k_spin_lock(&capture->lock);
+		while ((count < max_events) && (capture->tail != capture->head)) {
+			events[count++] =
+				capture->events[capture->tail & (capture->size - 1U)];
+			capture->tail++;
+		}
+		k_spin_unlock(&capture->lock, key);
+
+		if ((count == 0) && (k_sem_take(&capture->sem, timeout) != 0)) {
+			return -EAGAIN;
+		}
+	}
+
+	return count;
+}
+
+uint32_t gpio_capture_overruns_get(struct gpio_capture *capture)
+{
+	k_spinlock_key_t key = k_spin_lock(&capture->lock);
+	uint32_t overruns = capture->overruns;
+
+	capture->overruns = 0;
+	k_spin_unlock(&capture->lock, key);
+
+	return overruns;
+}
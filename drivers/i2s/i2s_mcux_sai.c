@@ -676,14 +676,10 @@ static int i2s_mcux_config(const struct device *dev, enum i2s_dir dir,
 
 	if (dir == I2S_DIR_TX) {
 		memcpy(&dev_data->tx.cfg, i2s_cfg, sizeof(struct i2s_config));
-		LOG_DBG("tx slab free_list = 0x%x",
-			(uint32_t)i2s_cfg->mem_slab->free_list);
-		LOG_DBG("tx slab num_blocks = %d",
-			(uint32_t)i2s_cfg->mem_slab->info.num_blocks);
-		LOG_DBG("tx slab block_size = %d",
-			(uint32_t)i2s_cfg->mem_slab->info.block_size);
-		LOG_DBG("tx slab buffer = 0x%x",
-			(uint32_t)i2s_cfg->mem_slab->buffer);
+		LOG_DBG("tx slab num_free = %u",
+			k_mem_slab_num_free_get(i2s_cfg->mem_slab));
+		LOG_DBG("tx slab num_used = %u",
+			k_mem_slab_num_used_get(i2s_cfg->mem_slab));
 
 		/* set bit clock divider */
 		SAI_TxSetConfig(base, &config);
@@ -709,14 +705,10 @@ static int i2s_mcux_config(const struct device *dev, enum i2s_dir dir,
 		config.fifo.fifoWatermark = 0;
 
 		memcpy(&dev_data->rx.cfg, i2s_cfg, sizeof(struct i2s_config));
-		LOG_DBG("rx slab free_list = 0x%x",
-			(uint32_t)i2s_cfg->mem_slab->free_list);
-		LOG_DBG("rx slab num_blocks = %d",
-			(uint32_t)i2s_cfg->mem_slab->info.num_blocks);
-		LOG_DBG("rx slab block_size = %d",
-			(uint32_t)i2s_cfg->mem_slab->info.block_size);
-		LOG_DBG("rx slab buffer = 0x%x",
-			(uint32_t)i2s_cfg->mem_slab->buffer);
+		LOG_DBG("rx slab num_free = %u",
+			k_mem_slab_num_free_get(i2s_cfg->mem_slab));
+		LOG_DBG("rx slab num_used = %u",
+			k_mem_slab_num_used_get(i2s_cfg->mem_slab));
 
 		/* set bit clock divider */
 		SAI_RxSetConfig(base, &config);
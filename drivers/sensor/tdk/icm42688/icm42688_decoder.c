@@ -231,13 +231,10 @@ static inline q31_t icm42688_read_temperature_from_packet(const uint8_t *pkt)
 	return FIELD_PREP(GENMASK(31, 22), whole) | (fraction * GENMASK64(21, 0) / 1000000);
 }
 
-static int icm42688_read_imu_from_packet(const uint8_t *pkt, bool is_accel, int fs,
-					 uint8_t axis_offset, q31_t *out)
+/* Scale of a 16 bit FIFO sample, precomputed once per decoded buffer */
+static int64_t icm42688_fifo_scale(bool is_accel, int fs)
 {
-	int32_t value;
 	int64_t scale = 0;
-	int32_t max = BIT(15);
-	int offset = 1 + (axis_offset * 2);
 
 	if (is_accel) {
 		switch (fs) {
@@ -283,32 +280,53 @@ static int icm42688_read_imu_from_packet(const uint8_t *pkt, bool is_accel, int
 		}
 	}
 
+	return scale;
+}
+
+/* Decode the three axes of the accel or the gyro from a FIFO packet */
+static int icm42688_read_imu_from_packet(const uint8_t *pkt, bool is_accel, int64_t scale,
+					 q31_t out[3])
+{
+	const bool is_20b = FIELD_GET(FIFO_HEADER_20, pkt[0]) == 1;
+	const uint32_t mask = is_accel ? GENMASK(7, 4) : GENMASK(3, 0);
+	int32_t values[3];
+	int32_t max = BIT(15);
+	int offset = 1;
+
 	if (!is_accel && FIELD_GET(FIFO_HEADER_ACCEL, pkt[0]) == 1) {
-		offset += 7;
+		offset += 6;
 	}
 
-	value = (int16_t)sys_le16_to_cpu((pkt[offset] << 8) | pkt[offset + 1]);
+	for (int i = 0; i < 3; i++) {
+		int pos = offset + i * 2;
 
-	if (FIELD_GET(FIFO_HEADER_20, pkt[0]) == 1) {
-		uint32_t mask = is_accel ? GENMASK(7, 4) : GENMASK(3, 0);
+		values[i] = (int16_t)sys_le16_to_cpu((pkt[pos] << 8) | pkt[pos + 1]);
+	}
 
-		offset = 0x11 + axis_offset;
-		value = (value << 4) | FIELD_GET(mask, pkt[offset]);
+	if (is_20b) {
 		/* In 20 bit mode, FS can only be +/-16g and +/-2000dps */
 		scale = is_accel ? (INT64_C(16) * BIT(8) * 9.80665) : 131;
 		max = is_accel ? BIT(18) : BIT(19);
-		if (value == -524288) {
-			/* Invalid 20 bit value */
-			return -ENODATA;
+		for (int i = 0; i < 3; i++) {
+			values[i] = (values[i] << 4) | FIELD_GET(mask, pkt[0x11 + i]);
+			if (values[i] == -524288) {
+				/* Invalid 20 bit value */
+				return -ENODATA;
+			}
 		}
 	} else {
-		if (value <= -32767) {
-			/* Invalid 16 bit value */
-			return -ENODATA;
+		for (int i = 0; i < 3; i++) {
+			if (values[i] <= -32767) {
+				/* Invalid 16 bit value */
+				return -ENODATA;
+			}
 		}
 	}
 
-	*out = (q31_t)(value * scale / max);
+	for (int i = 0; i < 3; i++) {
+		out[i] = (q31_t)(values[i] * scale / max);
+	}
+
 	return 0;
 }
 
@@ -353,6 +371,8 @@ static int icm42688_fifo_decode(const uint8_t *buffer, enum sensor_channel chann
 	const uint8_t *buffer_end = buffer + sizeof(struct icm42688_fifo_data) + edata->fifo_count;
 	int accel_frame_count = 0;
 	int gyro_frame_count = 0;
+	uint64_t period_ns = 0;
+	int64_t scale = 0;
 	int count = 0;
 	int rc;
 
@@ -362,6 +382,21 @@ static int icm42688_fifo_decode(const uint8_t *buffer, enum sensor_channel chann
 
 	((struct sensor_data_header *)data_out)->base_timestamp_ns = edata->header.timestamp;
 
+	/* Everything that does not change from a frame to the next is computed once */
+	if (IS_ACCEL(channel)) {
+		icm42688_get_shift(SENSOR_CHAN_ACCEL_XYZ, edata->header.accel_fs,
+				   edata->header.gyro_fs,
+				   &((struct sensor_three_axis_data *)data_out)->shift);
+		scale = icm42688_fifo_scale(true, edata->header.accel_fs);
+		period_ns = accel_period_ns[edata->accel_odr];
+	} else if (IS_GYRO(channel)) {
+		icm42688_get_shift(SENSOR_CHAN_GYRO_XYZ, edata->header.accel_fs,
+				   edata->header.gyro_fs,
+				   &((struct sensor_three_axis_data *)data_out)->shift);
+		scale = icm42688_fifo_scale(false, edata->header.gyro_fs);
+		period_ns = gyro_period_ns[edata->gyro_odr];
+	}
+
 	buffer += sizeof(struct icm42688_fifo_data);
 	while (count < max_count && buffer < buffer_end) {
 		const bool is_20b = FIELD_GET(FIFO_HEADER_20, buffer[0]) == 1;
@@ -405,18 +440,10 @@ static int icm42688_fifo_decode(const uint8_t *buffer, enum sensor_channel chann
 			/* Decode accel */
 			struct sensor_three_axis_data *data =
 				(struct sensor_three_axis_data *)data_out;
-			uint64_t period_ns = accel_period_ns[edata->accel_odr];
-
-			icm42688_get_shift(SENSOR_CHAN_ACCEL_XYZ, edata->header.accel_fs,
-					   edata->header.gyro_fs, &data->shift);
 
 			data->readings[count].timestamp_delta = (accel_frame_count - 1) * period_ns;
-			rc = icm42688_read_imu_from_packet(buffer, true, edata->header.accel_fs, 0,
-							   &data->readings[count].x);
-			rc |= icm42688_read_imu_from_packet(buffer, true, edata->header.accel_fs, 1,
-							    &data->readings[count].y);
-			rc |= icm42688_read_imu_from_packet(buffer, true, edata->header.accel_fs, 2,
-							    &data->readings[count].z);
+			rc = icm42688_read_imu_from_packet(buffer, true, scale,
+							   data->readings[count].values);
 			if (rc != 0) {
 				accel_frame_count--;
 				buffer = frame_end;
@@ -426,18 +453,10 @@ static int icm42688_fifo_decode(const uint8_t *buffer, enum sensor_channel chann
 			/* Decode gyro */
 			struct sensor_three_axis_data *data =
 				(struct sensor_three_axis_data *)data_out;
-			uint64_t period_ns = accel_period_ns[edata->gyro_odr];
-
-			icm42688_get_shift(SENSOR_CHAN_GYRO_XYZ, edata->header.accel_fs,
-					   edata->header.gyro_fs, &data->shift);
 
 			data->readings[count].timestamp_delta = (gyro_frame_count - 1) * period_ns;
-			rc = icm42688_read_imu_from_packet(buffer, false, edata->header.gyro_fs, 0,
-							   &data->readings[count].x);
-			rc |= icm42688_read_imu_from_packet(buffer, false, edata->header.gyro_fs, 1,
-							    &data->readings[count].y);
-			rc |= icm42688_read_imu_from_packet(buffer, false, edata->header.gyro_fs, 2,
-							    &data->readings[count].z);
+			rc = icm42688_read_imu_from_packet(buffer, false, scale,
+							   data->readings[count].values);
 			if (rc != 0) {
 				gyro_frame_count--;
 				buffer = frame_end;
@@ -16,6 +16,10 @@
 #endif
 #include <nrfx_spim.h>
 #include <string.h>
+#ifdef CONFIG_SPI_RTIO
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/spinlock.h>
+#endif
 #include <zephyr/linker/devicetree_regions.h>
 
 #include <zephyr/logging/log.h>
@@ -44,6 +48,18 @@ struct spi_nrfx_data {
 #ifdef SPI_BUFFER_IN_RAM
 	uint8_t *tx_buffer;
 	uint8_t *rx_buffer;
+	/* Buffer the current chunk is copied to from rx_buffer, if any */
+	uint8_t *rx_copy;
+#endif
+#ifdef CONFIG_SPI_RTIO
+	struct rtio *r; /* context for thread calls */
+	struct rtio_iodev iodev;
+	struct rtio_iodev_sqe *txn_head;
+	struct rtio_iodev_sqe *txn_curr;
+	/* Bytes of the current submission already transferred */
+	size_t txn_offset;
+	struct spi_dt_spec dt_spec;
+	struct k_spinlock lock;
 #endif
 #ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
 	bool    anomaly_58_workaround_active;
@@ -300,81 +316,108 @@ static void finish_transaction(const struct device *dev, int error)
 	dev_data->busy = false;
 }
 
-static void transfer_next_chunk(const struct device *dev)
+/*
+ * Start the transfer of up to chunk_len bytes, no data is sent (overrun
+ * characters are) if tx_buf is NULL and none is received if rx_buf is NULL.
+ * The length actually transferred is left in dev_data->chunk_len.
+ */
+static int transfer_chunk(const struct device *dev, const uint8_t *tx_buf,
+			  uint8_t *rx_buf, size_t chunk_len)
 {
 	struct spi_nrfx_data *dev_data = dev->data;
 	const struct spi_nrfx_config *dev_config = dev->config;
-	struct spi_context *ctx = &dev_data->ctx;
+	nrfx_spim_xfer_desc_t xfer;
+	nrfx_err_t result;
 	int error = 0;
 
-	size_t chunk_len = spi_context_max_continuous_chunk(ctx);
-
-	if (chunk_len > 0) {
-		nrfx_spim_xfer_desc_t xfer;
-		nrfx_err_t result;
-		const uint8_t *tx_buf = ctx->tx_buf;
-		uint8_t *rx_buf = ctx->rx_buf;
-
-		if (chunk_len > dev_config->max_chunk_len) {
-			chunk_len = dev_config->max_chunk_len;
-		}
+	if (chunk_len > dev_config->max_chunk_len) {
+		chunk_len = dev_config->max_chunk_len;
+	}
 
 #ifdef SPI_BUFFER_IN_RAM
-		if (spi_context_tx_buf_on(ctx) &&
-		    !nrf_dma_accessible_check(&dev_config->spim.p_reg, tx_buf)) {
+	dev_data->rx_copy = NULL;
 
-			if (chunk_len > CONFIG_SPI_NRFX_RAM_BUFFER_SIZE) {
-				chunk_len = CONFIG_SPI_NRFX_RAM_BUFFER_SIZE;
-			}
+	if (tx_buf != NULL &&
+	    !nrf_dma_accessible_check(&dev_config->spim.p_reg, tx_buf)) {
 
-			memcpy(dev_data->tx_buffer, tx_buf, chunk_len);
-			tx_buf = dev_data->tx_buffer;
+		if (chunk_len > CONFIG_SPI_NRFX_RAM_BUFFER_SIZE) {
+			chunk_len = CONFIG_SPI_NRFX_RAM_BUFFER_SIZE;
 		}
 
-		if (spi_context_rx_buf_on(ctx) &&
-		    !nrf_dma_accessible_check(&dev_config->spim.p_reg, rx_buf)) {
+		memcpy(dev_data->tx_buffer, tx_buf, chunk_len);
+		tx_buf = dev_data->tx_buffer;
+	}
 
-			if (chunk_len > CONFIG_SPI_NRFX_RAM_BUFFER_SIZE) {
-				chunk_len = CONFIG_SPI_NRFX_RAM_BUFFER_SIZE;
-			}
+	if (rx_buf != NULL &&
+	    !nrf_dma_accessible_check(&dev_config->spim.p_reg, rx_buf)) {
 
-			rx_buf = dev_data->rx_buffer;
+		if (chunk_len > CONFIG_SPI_NRFX_RAM_BUFFER_SIZE) {
+			chunk_len = CONFIG_SPI_NRFX_RAM_BUFFER_SIZE;
 		}
+
+		dev_data->rx_copy = rx_buf;
+		rx_buf = dev_data->rx_buffer;
+	}
+
 #endif
 
-		dev_data->chunk_len = chunk_len;
+	dev_data->chunk_len = chunk_len;
 
-		xfer.p_tx_buffer = tx_buf;
-		xfer.tx_length   = spi_context_tx_buf_on(ctx) ? chunk_len : 0;
-		xfer.p_rx_buffer = rx_buf;
-		xfer.rx_length   = spi_context_rx_buf_on(ctx) ? chunk_len : 0;
+	xfer.p_tx_buffer = tx_buf;
+	xfer.tx_length   = (tx_buf != NULL) ? chunk_len : 0;
+	xfer.p_rx_buffer = rx_buf;
+	xfer.rx_length   = (rx_buf != NULL) ? chunk_len : 0;
 
 #ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
-		if (xfer.rx_length == 1 && xfer.tx_length <= 1) {
-			if (dev_config->anomaly_58_workaround) {
-				anomaly_58_workaround_setup(dev);
-			} else {
-				LOG_WRN("Transaction aborted since it would trigger "
-					"nRF52832 PAN 58");
-				error = -EIO;
-			}
+	if (xfer.rx_length == 1 && xfer.tx_length <= 1) {
+		if (dev_config->anomaly_58_workaround) {
+			anomaly_58_workaround_setup(dev);
+		} else {
+			LOG_WRN("Transaction aborted since it would trigger "
+				"nRF52832 PAN 58");
+			error = -EIO;
 		}
+	}
 #endif
-		if (error == 0) {
-			result = nrfx_spim_xfer(&dev_config->spim, &xfer, 0);
-			if (result == NRFX_SUCCESS) {
-				return;
-			}
-			error = -EIO;
+	if (error == 0) {
+		result = nrfx_spim_xfer(&dev_config->spim, &xfer, 0);
+		if (result == NRFX_SUCCESS) {
+			return 0;
+		}
+		error = -EIO;
 #ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
-			anomaly_58_workaround_clear(dev_data);
+		anomaly_58_workaround_clear(dev_data);
 #endif
+	}
+
+	return error;
+}
+
+static void transfer_next_chunk(const struct device *dev)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	struct spi_context *ctx = &dev_data->ctx;
+	int error = 0;
+
+	size_t chunk_len = spi_context_max_continuous_chunk(ctx);
+
+	if (chunk_len > 0) {
+		error = transfer_chunk(dev,
+				       spi_context_tx_buf_on(ctx) ? ctx->tx_buf : NULL,
+				       spi_context_rx_buf_on(ctx) ? ctx->rx_buf : NULL,
+				       chunk_len);
+		if (error == 0) {
+			return;
 		}
 	}
 
 	finish_transaction(dev, error);
 }
 
+#ifdef CONFIG_SPI_RTIO
+static void spi_nrfx_iodev_chunk_done(const struct device *dev);
+#endif
+
 static void event_handler(const nrfx_spim_evt_t *p_event, void *p_context)
 {
 	struct spi_nrfx_data *dev_data = p_context;
@@ -392,13 +435,17 @@ static void event_handler(const nrfx_spim_evt_t *p_event, void *p_context)
 		anomaly_58_workaround_clear(dev_data);
 #endif
 #ifdef SPI_BUFFER_IN_RAM
-		if (spi_context_rx_buf_on(&dev_data->ctx) &&
-		    p_event->xfer_desc.p_rx_buffer != NULL &&
-		    p_event->xfer_desc.p_rx_buffer != dev_data->ctx.rx_buf) {
-			(void)memcpy(dev_data->ctx.rx_buf,
+		if (dev_data->rx_copy != NULL) {
+			(void)memcpy(dev_data->rx_copy,
 				     dev_data->rx_buffer,
 				     dev_data->chunk_len);
 		}
+#endif
+#ifdef CONFIG_SPI_RTIO
+		if (dev_data->txn_head != NULL) {
+			spi_nrfx_iodev_chunk_done(dev_data->dev);
+			return;
+		}
 #endif
 		spi_context_update_tx(&dev_data->ctx, 1, dev_data->chunk_len);
 		spi_context_update_rx(&dev_data->ctx, 1, dev_data->chunk_len);
@@ -407,6 +454,7 @@ static void event_handler(const nrfx_spim_evt_t *p_event, void *p_context)
 	}
 }
 
+#ifndef CONFIG_SPI_RTIO
 static int transceive(const struct device *dev,
 		      const struct spi_config *spi_cfg,
 		      const struct spi_buf_set *tx_bufs,
@@ -476,13 +524,205 @@ static int transceive(const struct device *dev,
 
 	return error;
 }
+#else
+static void spi_nrfx_iodev_next(const struct device *dev, bool completion);
+
+static void spi_nrfx_iodev_complete(const struct device *dev, int status);
+
+static void spi_nrfx_iodev_start(const struct device *dev)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	struct rtio_sqe *sqe = &dev_data->txn_curr->sqe;
+	size_t offset = dev_data->txn_offset;
+	const uint8_t *tx_buf = NULL;
+	uint8_t *rx_buf = NULL;
+	size_t len;
+	int error;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		rx_buf = sqe->buf;
+		len = sqe->buf_len;
+		break;
+	case RTIO_OP_TX:
+		tx_buf = sqe->buf;
+		len = sqe->buf_len;
+		break;
+	case RTIO_OP_TINY_TX:
+		tx_buf = sqe->tiny_buf;
+		len = sqe->tiny_buf_len;
+		break;
+	case RTIO_OP_TXRX:
+		tx_buf = sqe->tx_buf;
+		rx_buf = sqe->rx_buf;
+		len = sqe->txrx_buf_len;
+		break;
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		spi_nrfx_iodev_complete(dev, -EINVAL);
+		return;
+	}
+
+	if (offset == len) {
+		/* Nothing (left) to transfer */
+		spi_nrfx_iodev_complete(dev, 0);
+		return;
+	}
+
+	error = transfer_chunk(dev, (tx_buf != NULL) ? &tx_buf[offset] : NULL,
+			       (rx_buf != NULL) ? &rx_buf[offset] : NULL, len - offset);
+	if (error != 0) {
+		spi_nrfx_iodev_complete(dev, error);
+	}
+}
+
+static void spi_nrfx_iodev_chunk_done(const struct device *dev)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+
+	dev_data->txn_offset += dev_data->chunk_len;
+	spi_nrfx_iodev_start(dev);
+}
+
+/*
+ * Called, from the SPIM interrupt unless the transfer could not start, when a
+ * submission is done. The next one of the transaction or the next transaction
+ * is started right away.
+ */
+static void spi_nrfx_iodev_complete(const struct device *dev, int status)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	struct rtio_iodev_sqe *txn_head = dev_data->txn_head;
+
+	dev_data->txn_offset = 0;
+
+	if (status == 0 && (dev_data->txn_curr->sqe.flags & RTIO_SQE_TRANSACTION)) {
+		dev_data->txn_curr = rtio_txn_next(dev_data->txn_curr);
+		spi_nrfx_iodev_start(dev);
+		return;
+	}
+
+	spi_context_cs_control(&dev_data->ctx, false);
+	spi_nrfx_iodev_next(dev, true);
+
+	if (status < 0) {
+		rtio_iodev_sqe_err(txn_head, status);
+	} else {
+		rtio_iodev_sqe_ok(txn_head, status);
+	}
+}
+
+static void spi_nrfx_iodev_next(const struct device *dev, bool completion)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	const struct spi_nrfx_config *dev_config = dev->config;
+	struct rtio_mpsc_node *next;
+	k_spinlock_key_t key;
+	int error;
+
+	key = k_spin_lock(&dev_data->lock);
+
+	if (!completion && dev_data->txn_curr != NULL) {
+		k_spin_unlock(&dev_data->lock, key);
+		return;
+	}
+
+	next = rtio_mpsc_pop(&dev_data->iodev.iodev_sq);
+	if (next != NULL) {
+		struct rtio_iodev_sqe *next_sqe = CONTAINER_OF(next, struct rtio_iodev_sqe, q);
+
+		dev_data->txn_head = next_sqe;
+		dev_data->txn_curr = next_sqe;
+	} else {
+		dev_data->txn_head = NULL;
+		dev_data->txn_curr = NULL;
+	}
+	dev_data->busy = (next != NULL);
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	if (dev_data->txn_curr == NULL) {
+		return;
+	}
+
+	struct spi_dt_spec *spi_dt_spec = dev_data->txn_curr->sqe.iodev->data;
+
+	error = configure(dev, &spi_dt_spec->config);
+	if (error != 0) {
+		spi_nrfx_iodev_complete(dev, error);
+		return;
+	}
+
+	if (dev_config->wake_pin != WAKE_PIN_NOT_USED &&
+	    spi_nrfx_wake_request(&dev_config->wake_gpiote, dev_config->wake_pin) == -ETIMEDOUT) {
+		LOG_WRN("Waiting for WAKE acknowledgment timed out");
+	}
+
+	spi_context_cs_control(&dev_data->ctx, true);
+	spi_nrfx_iodev_start(dev);
+}
+
+static void spi_nrfx_iodev_submit(const struct device *dev,
+				  struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+
+	rtio_mpsc_push(&dev_data->iodev.iodev_sq, &iodev_sqe->q);
+	spi_nrfx_iodev_next(dev, false);
+}
+
+static int spi_nrfx_rtio_transceive(const struct device *dev,
+				    const struct spi_config *spi_cfg,
+				    const struct spi_buf_set *tx_bufs,
+				    const struct spi_buf_set *rx_bufs)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	struct spi_dt_spec *dt_spec = &dev_data->dt_spec;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int error = 0;
+	int ret;
+
+	spi_context_lock(&dev_data->ctx, false, NULL, NULL, spi_cfg);
+
+	dt_spec->config = *spi_cfg;
+
+	ret = spi_rtio_copy(dev_data->r, &dev_data->iodev, tx_bufs, rx_bufs, &sqe);
+	if (ret < 0) {
+		spi_context_release(&dev_data->ctx, ret);
+		return ret;
+	}
+
+	/* Submit request and wait */
+	rtio_submit(dev_data->r, ret);
+
+	while (ret > 0) {
+		cqe = rtio_cqe_consume(dev_data->r);
+		if (cqe->result < 0) {
+			error = cqe->result;
+		}
+
+		rtio_cqe_release(dev_data->r, cqe);
+		ret--;
+	}
+
+	spi_context_release(&dev_data->ctx, error);
+
+	return error;
+}
+#endif /* CONFIG_SPI_RTIO */
 
 static int spi_nrfx_transceive(const struct device *dev,
 			       const struct spi_config *spi_cfg,
 			       const struct spi_buf_set *tx_bufs,
 			       const struct spi_buf_set *rx_bufs)
 {
+#ifdef CONFIG_SPI_RTIO
+	/* Blocking calls are queued along with the RTIO submissions */
+	return spi_nrfx_rtio_transceive(dev, spi_cfg, tx_bufs, rx_bufs);
+#else
 	return transceive(dev, spi_cfg, tx_bufs, rx_bufs, false, NULL, NULL);
+#endif
 }
 
 #ifdef CONFIG_SPI_ASYNC
@@ -493,7 +733,12 @@ static int spi_nrfx_transceive_async(const struct device *dev,
 				     spi_callback_t cb,
 				     void *userdata)
 {
+#ifdef CONFIG_SPI_RTIO
+	/* Asynchronous requests are to be submitted through RTIO */
+	return -ENOTSUP;
+#else
 	return transceive(dev, spi_cfg, tx_bufs, rx_bufs, true, cb, userdata);
+#endif
 }
 #endif /* CONFIG_SPI_ASYNC */
 
@@ -519,6 +764,9 @@ static const struct spi_driver_api spi_nrfx_driver_api = {
 	.transceive = spi_nrfx_transceive,
 #ifdef CONFIG_SPI_ASYNC
 	.transceive_async = spi_nrfx_transceive_async,
+#endif
+#ifdef CONFIG_SPI_RTIO
+	.iodev_submit = spi_nrfx_iodev_submit,
 #endif
 	.release = spi_nrfx_release,
 };
@@ -597,6 +845,13 @@ static int spi_nrfx_init(const struct device *dev)
 
 	spi_context_unlock_unconditionally(&dev_data->ctx);
 
+#ifdef CONFIG_SPI_RTIO
+	dev_data->dt_spec.bus = dev;
+	dev_data->iodev.api = &spi_iodev_api;
+	dev_data->iodev.data = &dev_data->dt_spec;
+	rtio_mpsc_init(&dev_data->iodev.iodev_sq);
+#endif
+
 #ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
 	return anomaly_58_workaround_init(dev);
 #else
@@ -635,6 +890,10 @@ static int spi_nrfx_init(const struct device *dev)
 		 static uint8_t spim_##idx##_rx_buffer			       \
 			[CONFIG_SPI_NRFX_RAM_BUFFER_SIZE]		       \
 			SPIM_MEMORY_SECTION(idx);))			       \
+	IF_ENABLED(CONFIG_SPI_RTIO,					       \
+		(RTIO_DEFINE(spim_##idx##_rtio,				       \
+			     CONFIG_SPI_NRFX_RTIO_SQ_SIZE,		       \
+			     CONFIG_SPI_NRFX_RTIO_SQ_SIZE);))		       \
 	static struct spi_nrfx_data spi_##idx##_data = {		       \
 		SPI_CONTEXT_INIT_LOCK(spi_##idx##_data, ctx),		       \
 		SPI_CONTEXT_INIT_SYNC(spi_##idx##_data, ctx),		       \
@@ -642,6 +901,7 @@ static int spi_nrfx_init(const struct device *dev)
 		IF_ENABLED(SPI_BUFFER_IN_RAM,				       \
 			(.tx_buffer = spim_##idx##_tx_buffer,		       \
 			 .rx_buffer = spim_##idx##_rx_buffer,))		       \
+		IF_ENABLED(CONFIG_SPI_RTIO, (.r = &spim_##idx##_rtio,))	       \
 		.dev  = DEVICE_DT_GET(SPIM(idx)),			       \
 		.busy = false,						       \
 	};								       \
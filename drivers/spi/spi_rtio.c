@@ -4,8 +4,98 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
+
 #include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/work.h>
 
 const struct rtio_iodev_api spi_iodev_api = {
 	.submit = spi_iodev_submit,
 };
+
+#ifdef CONFIG_RTIO_WORKQ
+
+/* Perform one submission of a transaction with a blocking transfer */
+static int spi_rtio_transceive_sqe(const struct spi_dt_spec *dt_spec,
+				   const struct spi_config *config,
+				   struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	struct spi_buf tx_buf = {0};
+	struct spi_buf rx_buf = {0};
+	const struct spi_buf_set tx_bufs = {.buffers = &tx_buf, .count = 1};
+	const struct spi_buf_set rx_bufs = {.buffers = &rx_buf, .count = 1};
+	uint8_t *buf;
+	uint32_t buf_len;
+	int rc;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		rc = rtio_sqe_rx_buf(iodev_sqe, sqe->buf_len, sqe->buf_len, &buf, &buf_len);
+		if (rc != 0) {
+			return rc;
+		}
+		rx_buf.buf = buf;
+		rx_buf.len = buf_len;
+		return spi_transceive(dt_spec->bus, config, NULL, &rx_bufs);
+	case RTIO_OP_TX:
+		tx_buf.buf = sqe->buf;
+		tx_buf.len = sqe->buf_len;
+		return spi_transceive(dt_spec->bus, config, &tx_bufs, NULL);
+	case RTIO_OP_TINY_TX:
+		tx_buf.buf = sqe->tiny_buf;
+		tx_buf.len = sqe->tiny_buf_len;
+		return spi_transceive(dt_spec->bus, config, &tx_bufs, NULL);
+	case RTIO_OP_TXRX:
+		tx_buf.buf = sqe->tx_buf;
+		tx_buf.len = sqe->txrx_buf_len;
+		rx_buf.buf = sqe->rx_buf;
+		rx_buf.len = sqe->txrx_buf_len;
+		return spi_transceive(dt_spec->bus, config, &tx_bufs, &rx_bufs);
+	default:
+		return -EINVAL;
+	}
+}
+
+static void spi_rtio_iodev_default_handler(struct rtio_iodev_sqe *txn_first)
+{
+	const struct spi_dt_spec *dt_spec = txn_first->sqe.iodev->data;
+	struct spi_config config = dt_spec->config;
+	struct rtio_iodev_sqe *txn_curr = txn_first;
+	int rc = 0;
+
+	/* Keep the bus and the chip select for the whole transaction */
+	config.operation |= SPI_HOLD_ON_CS | SPI_LOCK_ON;
+
+	while (txn_curr != NULL) {
+		rc = spi_rtio_transceive_sqe(dt_spec, &config, txn_curr);
+		if (rc < 0) {
+			break;
+		}
+		txn_curr = rtio_txn_next(txn_curr);
+	}
+
+	(void)spi_release(dt_spec->bus, &config);
+
+	if (rc < 0) {
+		rtio_iodev_sqe_err(txn_first, rc);
+	} else {
+		rtio_iodev_sqe_ok(txn_first, 0);
+	}
+}
+
+void spi_rtio_iodev_default_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	ARG_UNUSED(dev);
+
+	if (req == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, spi_rtio_iodev_default_handler);
+}
+
+#endif /* CONFIG_RTIO_WORKQ */
@@ -40,6 +40,21 @@ static uint32_t last_elapsed;
 const int32_t z_sys_timer_irq_for_test = ARM_ARCH_TIMER_IRQ;
 #endif
 
+#if defined(CONFIG_SMP) && defined(CONFIG_TICKLESS_KERNEL)
+/*
+ * Each CPU has its own comparator, and only the one of the CPU that last
+ * programmed the next timeout is up to date. The others are masked when
+ * they fire instead of announcing, so that a single CPU takes the timer
+ * interrupt for each timeout. Accessed with the lock held.
+ */
+static unsigned int timeout_cpu;
+
+static inline bool is_timeout_cpu(void)
+{
+	return timeout_cpu == arch_curr_cpu()->id;
+}
+#endif
+
 static void arm_arch_timer_compare_isr(const void *arg)
 {
 	ARG_UNUSED(arg);
@@ -64,6 +79,19 @@ static void arm_arch_timer_compare_isr(const void *arg)
 	}
 #endif /* CONFIG_ARM_ARCH_TIMER_ERRATUM_740657 */
 
+#if defined(CONFIG_SMP) && defined(CONFIG_TICKLESS_KERNEL)
+	if (!is_timeout_cpu()) {
+		/* stale comparator, the next timeout is up to another CPU */
+		arm_arch_timer_set_irq_mask(true);
+#ifdef CONFIG_ARM_ARCH_TIMER_ERRATUM_740657
+		arm_arch_timer_set_compare(~0ULL);
+		arm_arch_timer_clear_int_status();
+#endif
+		k_spin_unlock(&lock, key);
+		return;
+	}
+#endif
+
 	uint64_t curr_cycle = arm_arch_timer_count();
 	uint64_t delta_cycles = curr_cycle - last_cycle;
 	uint32_t delta_ticks = TO_CYCLE_DIFF(delta_cycles) / CYC_PER_TICK;
@@ -136,6 +164,9 @@ void sys_clock_set_timeout(int32_t ticks, bool idle)
 
 	arm_arch_timer_set_compare(next_cycle);
 	arm_arch_timer_set_irq_mask(false);
+#ifdef CONFIG_SMP
+	timeout_cpu = arch_curr_cpu()->id;
+#endif
 	k_spin_unlock(&lock, key);
 
 #else  /* CONFIG_TICKLESS_KERNEL */
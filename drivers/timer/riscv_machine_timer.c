@@ -88,6 +88,21 @@ static uint32_t last_elapsed;
 const int32_t z_sys_timer_irq_for_test = TIMER_IRQN;
 #endif
 
+#if defined(CONFIG_SMP) && defined(CONFIG_TICKLESS_KERNEL)
+/*
+ * Each hart has its own mtimecmp, and only the one of the CPU that last
+ * programmed the next timeout is up to date. The others are disarmed when
+ * they fire instead of announcing, so that a single CPU takes the timer
+ * interrupt for each timeout. Accessed with the lock held.
+ */
+static unsigned int timeout_cpu;
+
+static inline bool is_timeout_cpu(void)
+{
+	return timeout_cpu == arch_curr_cpu()->id;
+}
+#endif
+
 static uintptr_t get_hart_mtimecmp(void)
 {
 	return MTIMECMP_REG + (arch_proc_id() * 8);
@@ -144,6 +159,15 @@ static void timer_isr(const void *arg)
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
+#if defined(CONFIG_SMP) && defined(CONFIG_TICKLESS_KERNEL)
+	if (!is_timeout_cpu()) {
+		/* stale comparator, the next timeout is up to another CPU */
+		set_mtimecmp(UINT64_MAX);
+		k_spin_unlock(&lock, key);
+		return;
+	}
+#endif
+
 	uint64_t now = mtime();
 	uint64_t dcycles = now - last_count;
 	uint32_t dticks = (cycle_diff_t)dcycles / CYC_PER_TICK;
@@ -191,6 +215,9 @@ void sys_clock_set_timeout(int32_t ticks, bool idle)
 	uint64_t cyc = (last_ticks + last_elapsed + ticks) * CYC_PER_TICK;
 
 	set_mtimecmp(cyc);
+#ifdef CONFIG_SMP
+	timeout_cpu = arch_curr_cpu()->id;
+#endif
 	k_spin_unlock(&lock, key);
 }
 
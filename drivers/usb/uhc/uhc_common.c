@@ -75,7 +75,17 @@ int uhc_xfer_append(const struct device *dev,
 {
 	struct uhc_data *data = dev->data;
 
-	sys_dlist_append(&data->ctrl_xfers, &xfer->node);
+	/*
+	 * Transfers of the other endpoints wait in their own queue, so that
+	 * several of them, e.g. the stages of a bulk-only mass storage
+	 * command, can be queued behind each other and started by the
+	 * controller one after the other without the host stack in between.
+	 */
+	if (USB_EP_GET_IDX(xfer->ep) == 0) {
+		sys_dlist_append(&data->ctrl_xfers, &xfer->node);
+	} else {
+		sys_dlist_append(&data->bulk_xfers, &xfer->node);
+	}
 
 	return 0;
 }
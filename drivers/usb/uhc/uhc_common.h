@@ -85,6 +85,10 @@ struct uhc_transfer *uhc_xfer_get_next(const struct device *dev);
 /**
  * @brief Helper to append a transfer to internal list.
  *
+ * Control transfers are appended to the control list, all others to the
+ * bulk list. Transfers of a list are processed in the order they were
+ * appended, control transfers first.
+ *
  * @param[in] dev    Pointer to device struct of the driver instance
  * @param[in] xfer   Pointer to UHC transfer
  *
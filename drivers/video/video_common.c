@@ -4,13 +4,44 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <zephyr/kernel.h>
+#include <zephyr/init.h>
 
 #include <zephyr/drivers/video.h>
 
+#if defined(CONFIG_VIDEO_BUFFER_USE_MEM_ATTR_HEAP)
+#include <zephyr/dt-bindings/memory-attr/memory-attr-sw.h>
+#include <zephyr/mem_mgmt/mem_attr_heap.h>
+
+#if defined(CONFIG_VIDEO_BUFFER_MEM_ATTR_CACHE)
+#define VIDEO_BUFFER_MEM_ATTR DT_MEM_SW_ALLOC_CACHE
+#elif defined(CONFIG_VIDEO_BUFFER_MEM_ATTR_NON_CACHE)
+#define VIDEO_BUFFER_MEM_ATTR DT_MEM_SW_ALLOC_NON_CACHE
+#else
+#define VIDEO_BUFFER_MEM_ATTR DT_MEM_SW_ALLOC_DMA
+#endif
+
+#define VIDEO_COMMON_HEAP_ALLOC(align, size) \
+	mem_attr_heap_aligned_alloc(VIDEO_BUFFER_MEM_ATTR, align, size)
+#define VIDEO_COMMON_FREE(block) mem_attr_heap_free(block)
+
+static int video_buffer_pool_init(void)
+{
+	int ret = mem_attr_heap_pool_init();
+
+	return (ret == -EALREADY) ? 0 : ret;
+}
+
+SYS_INIT(video_buffer_pool_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#else
 K_HEAP_DEFINE(video_buffer_pool,
 	      CONFIG_VIDEO_BUFFER_POOL_SZ_MAX *
 	      CONFIG_VIDEO_BUFFER_POOL_NUM_MAX);
 
+#define VIDEO_COMMON_HEAP_ALLOC(align, size) \
+	k_heap_aligned_alloc(&video_buffer_pool, align, size, K_FOREVER)
+#define VIDEO_COMMON_FREE(block) k_heap_free(&video_buffer_pool, block)
+#endif /* CONFIG_VIDEO_BUFFER_USE_MEM_ATTR_HEAP */
+
 static struct video_buffer video_buf[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
 
 struct mem_block {
@@ -19,7 +50,7 @@ struct mem_block {
 
 static struct mem_block video_block[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
 
-struct video_buffer *video_buffer_alloc(size_t size)
+struct video_buffer *video_buffer_aligned_alloc(size_t size, size_t align)
 {
 	struct video_buffer *vbuf = NULL;
 	struct mem_block *block;
@@ -39,7 +70,7 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	}
 
 	/* Alloc buffer memory */
-	block->data = k_heap_alloc(&video_buffer_pool, size, K_FOREVER);
+	block->data = VIDEO_COMMON_HEAP_ALLOC(align, size);
 	if (block->data == NULL) {
 		return NULL;
 	}
@@ -51,6 +82,11 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	return vbuf;
 }
 
+struct video_buffer *video_buffer_alloc(size_t size)
+{
+	return video_buffer_aligned_alloc(size, CONFIG_VIDEO_BUFFER_POOL_ALIGN);
+}
+
 void video_buffer_release(struct video_buffer *vbuf)
 {
 	struct mem_block *block = NULL;
@@ -66,6 +102,6 @@ void video_buffer_release(struct video_buffer *vbuf)
 
 	vbuf->buffer = NULL;
 	if (block) {
-		k_heap_free(&video_buffer_pool, block->data);
+		VIDEO_COMMON_FREE(block->data);
 	}
 }
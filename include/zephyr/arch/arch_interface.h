@@ -495,6 +495,21 @@ static inline uint32_t arch_proc_id(void);
  */
 void arch_sched_ipi(void);
 
+/** Mask of all the CPUs, for arch_sched_directed_ipi() */
+#define IPI_ALL_CPUS_MASK ((1 << CONFIG_MP_MAX_NUM_CPUS) - 1)
+
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+/**
+ * Send an interrupt to the given CPUs
+ *
+ * This will invoke z_sched_ipi() on the CPUs of @p cpu_bitmap. The bit of
+ * the current CPU is ignored.
+ *
+ * @param cpu_bitmap Mask of the CPUs to interrupt, bit n being CPU n
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+#endif /* CONFIG_ARCH_HAS_DIRECTED_IPIS */
+
 
 int arch_smp_init(void);
 
@@ -1056,6 +1071,60 @@ int arch_gdb_remove_breakpoint(struct gdb_ctx *ctx, uint8_t type,
 #endif
 /** @} */
 
+#ifdef CONFIG_PERF_COUNTERS
+#include <zephyr/timing/types.h>
+
+/**
+ * @brief Arch specific performance counter APIs
+ * @defgroup perf_counter_api_arch Arch specific performance counter APIs
+ * @ingroup perf_counter_api
+ *
+ * Counters are numbered from 0 and belong to the CPU that accesses them.
+ *
+ * @{
+ */
+
+/**
+ * @brief Get the number of performance counters
+ *
+ * @see perf_counter_num_get()
+ */
+unsigned int arch_perf_counter_num_get(void);
+
+/**
+ * @brief Select the event a performance counter counts, and start it
+ *
+ * @see perf_counter_config()
+ */
+int arch_perf_counter_config(unsigned int idx, enum perf_counter_event event);
+
+/**
+ * @brief Read a performance counter
+ *
+ * @see perf_counter_read()
+ */
+uint32_t arch_perf_counter_read(unsigned int idx);
+
+/** @} */
+#endif /* CONFIG_PERF_COUNTERS */
+
+#ifdef CONFIG_ARCH_HAS_PROFILER
+/**
+ * @brief Get the interrupted code addresses for the sampling profiler
+ *
+ * Called from the profiler timer interrupt. Stores the program counter the
+ * current thread was interrupted at, followed by as many return addresses
+ * as the architecture can cheaply recover.
+ *
+ * @param pc Array to fill, innermost address first.
+ * @param max Number of entries in @p pc.
+ *
+ * @return Number of addresses stored, 0 if the interrupt did not preempt
+ *	   a thread.
+ */
+size_t arch_profiler_pc_get(uintptr_t *pc, size_t max);
+#endif /* CONFIG_ARCH_HAS_PROFILER */
+
 #ifdef CONFIG_TIMING_FUNCTIONS
 #include <zephyr/timing/types.h>
 
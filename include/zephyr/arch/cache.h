@@ -157,6 +157,60 @@ int arch_dcache_flush_and_invd_range(void *addr, size_t size);
 #define cache_data_flush_and_invd_range(addr, size) \
 	arch_dcache_flush_and_invd_range(addr, size)
 
+#if defined(CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC) || defined(__DOXYGEN__)
+
+/**
+ * @brief Flush an address range in the d-cache without synchronization
+ *
+ * Same as arch_dcache_flush_range() but without the memory barriers, so
+ * several ranges can be flushed in a row. The operations are only complete
+ * after arch_dcache_sync().
+ *
+ * @param addr Starting address to flush.
+ * @param size Range size.
+ *
+ * @retval 0 If succeeded.
+ * @retval -errno Negative errno for other failures.
+ */
+int arch_dcache_flush_range_nosync(void *addr, size_t size);
+
+/**
+ * @brief Invalidate an address range in the d-cache without synchronization
+ *
+ * Same as arch_dcache_invd_range() but without the memory barriers.
+ *
+ * @param addr Starting address to invalidate.
+ * @param size Range size.
+ *
+ * @retval 0 If succeeded.
+ * @retval -errno Negative errno for other failures.
+ */
+int arch_dcache_invd_range_nosync(void *addr, size_t size);
+
+/**
+ * @brief Flush and Invalidate an address range in the d-cache without
+ *        synchronization
+ *
+ * Same as arch_dcache_flush_and_invd_range() but without the memory barriers.
+ *
+ * @param addr Starting address to flush and invalidate.
+ * @param size Range size.
+ *
+ * @retval 0 If succeeded.
+ * @retval -errno Negative errno for other failures.
+ */
+int arch_dcache_flush_and_invd_range_nosync(void *addr, size_t size);
+
+/**
+ * @brief Synchronize the d-cache operations
+ *
+ * Wait for the completion of the memory accesses and of the d-cache range
+ * operations issued before.
+ */
+void arch_dcache_sync(void);
+
+#endif /* CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC || __DOXYGEN__ */
+
 #if defined(CONFIG_DCACHE_LINE_SIZE_DETECT) || defined(__DOXYGEN__)
 
 /**
@@ -63,11 +63,23 @@ struct z_riscv_fp_context {
 };
 typedef struct z_riscv_fp_context z_riscv_fp_context_t;
 
+#ifdef CONFIG_RISCV_ISA_EXT_V
+struct z_riscv_vec_context {
+	unsigned long vstart, vl, vtype, vcsr;
+	/* v0 to v31, as stored by whole register store instructions */
+	uint8_t v[32 * (CONFIG_RISCV_ISA_EXT_V_VLEN / 8)] __aligned(16);
+};
+typedef struct z_riscv_vec_context z_riscv_vec_context_t;
+#endif
+
 #define PMP_M_MODE_SLOTS 8	/* 8 is plenty enough for m-mode */
 
 struct _thread_arch {
 #ifdef CONFIG_FPU_SHARING
 	struct z_riscv_fp_context saved_fp_context;
+#ifdef CONFIG_RISCV_ISA_EXT_V
+	struct z_riscv_vec_context saved_vec_context;
+#endif
 	bool fpu_recently_used;
 	uint8_t exception_depth;
 #endif
@@ -16,6 +16,14 @@
 #define X86_SPEC_CTRL_MSR_IBRS		BIT(0)
 #define X86_SPEC_CTRL_MSR_SSBD		BIT(2)
 
+#define X86_PMC0_MSR			0x000000c1 /* .. one per counter */
+#define X86_PERFEVTSEL0_MSR		0x00000186 /* .. one per counter */
+#define X86_PERFEVTSEL_USR		BIT(16)
+#define X86_PERFEVTSEL_OS		BIT(17)
+#define X86_PERFEVTSEL_EN		BIT(22)
+
+#define X86_PERF_GLOBAL_CTRL_MSR	0x0000038f
+
 #define X86_APIC_BASE_MSR		0x0000001b
 #define X86_APIC_BASE_MSR_X2APIC	BIT(10)
 
@@ -800,6 +800,50 @@ int bt_bap_stream_send(struct bt_bap_stream *stream, struct net_buf *buf, uint16
 int bt_bap_stream_send_ts(struct bt_bap_stream *stream, struct net_buf *buf, uint16_t seq_num,
 			  uint32_t ts);
 
+/** @brief SDU of a batch sent with bt_bap_stream_send_batch() */
+struct bt_bap_stream_sdu {
+	/** Stream to send the SDU on. */
+	struct bt_bap_stream *stream;
+	/** Buffer containing the SDU. */
+	struct net_buf *buf;
+	/** Packet Sequence number, as for bt_bap_stream_send(). */
+	uint16_t seq_num;
+};
+
+/**
+ * @brief Send the SDUs of an SDU interval to several Audio streams
+ *
+ * Send the SDUs of the same SDU interval of several streams, e.g. the output of the encoder for
+ * each channel of a group. All the SDUs are queued before any is handed to the HCI driver, so that
+ * they are sent to the controller together. The SDUs are queued in order, until one of them can
+ * not be sent.
+ *
+ * @note Support for sending must be supported, determined by @kconfig{CONFIG_BT_AUDIO_TX}.
+ *
+ * @param sdus   SDUs to send.
+ * @param count  Number of SDUs in @p sdus.
+ *
+ * @return Number of SDUs queued, from the first one, in case of success or negative value in case
+ *         of error.
+ */
+int bt_bap_stream_send_batch(const struct bt_bap_stream_sdu *sdus, size_t count);
+
+/**
+ * @brief Send the SDUs of an SDU interval to several Audio streams with timestamp
+ *
+ * Same as bt_bap_stream_send_batch(), with the same timestamp for all the SDUs.
+ *
+ * @note Support for sending must be supported, determined by @kconfig{CONFIG_BT_AUDIO_TX}.
+ *
+ * @param sdus   SDUs to send.
+ * @param count  Number of SDUs in @p sdus.
+ * @param ts     Timestamp of the SDUs in microseconds (us).
+ *
+ * @return Number of SDUs queued, from the first one, in case of success or negative value in case
+ *         of error.
+ */
+int bt_bap_stream_send_batch_ts(const struct bt_bap_stream_sdu *sdus, size_t count, uint32_t ts);
+
 /**
  * @brief Get ISO transmission timing info for a Basic Audio Profile stream
  *
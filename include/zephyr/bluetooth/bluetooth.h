@@ -2071,6 +2071,32 @@ struct bt_le_scan_recv_info {
 	uint8_t secondary_phy;
 };
 
+#if defined(CONFIG_BT_SCAN_BATCH) || defined(__DOXYGEN__)
+/** Compact advertising report, delivered in batches. */
+struct bt_le_scan_report {
+	/** Advertiser LE address and type, as in @ref bt_le_scan_recv_info. */
+	bt_addr_le_t addr;
+
+	/** Strength of advertiser signal. */
+	int8_t rssi;
+
+	/** Advertising packet type. */
+	uint8_t adv_type;
+
+	/** Advertising packet properties bitfield, BT_GAP_ADV_PROP_*. */
+	uint16_t adv_props;
+
+	/** Advertising Set Identifier. */
+	uint8_t sid;
+
+	/** Length of the advertising data kept in @ref data. */
+	uint8_t data_len;
+
+	/** Advertising data, truncated to @kconfig{CONFIG_BT_SCAN_BATCH_DATA_LEN}. */
+	uint8_t data[CONFIG_BT_SCAN_BATCH_DATA_LEN];
+};
+#endif /* CONFIG_BT_SCAN_BATCH || __DOXYGEN__ */
+
 /** Listener context for (LE) scanning. */
 struct bt_le_scan_cb {
 
@@ -2083,6 +2109,21 @@ struct bt_le_scan_cb {
 	void (*recv)(const struct bt_le_scan_recv_info *info,
 		     struct net_buf_simple *buf);
 
+#if defined(CONFIG_BT_SCAN_BATCH) || defined(__DOXYGEN__)
+	/**
+	 * @brief Batch of advertising reports received callback.
+	 *
+	 * Called from the system work queue when
+	 * @kconfig{CONFIG_BT_SCAN_BATCH_SIZE} reports have been received, or
+	 * @kconfig{CONFIG_BT_SCAN_BATCH_TIMEOUT} milliseconds after the first
+	 * report of the batch.
+	 *
+	 * @param reports Reports, in the order they were received.
+	 * @param count   Number of reports.
+	 */
+	void (*recv_batch)(const struct bt_le_scan_report *reports, size_t count);
+#endif /* CONFIG_BT_SCAN_BATCH || __DOXYGEN__ */
+
 	/** @brief The scanner has stopped scanning after scan timeout. */
 	void (*timeout)(void);
 
@@ -2246,6 +2287,50 @@ void bt_le_scan_cb_register(struct bt_le_scan_cb *cb);
  */
 void bt_le_scan_cb_unregister(struct bt_le_scan_cb *cb);
 
+#if defined(CONFIG_BT_SCAN_FILTER) || defined(__DOXYGEN__)
+/**
+ * @brief Add an advertiser address to the scan filter.
+ *
+ * When the scan filter is not empty, the scan listeners only get the reports
+ * of the advertisers in it, or whose advertising data match a pattern of it.
+ * The address is compared with the address of the report as received, or as
+ * resolved by the controller. The filter does not apply to the reports used
+ * to establish connections.
+ *
+ * @param addr Advertiser address.
+ *
+ * @return Zero on success or (negative) error code otherwise.
+ * @return -ENOMEM if @kconfig{CONFIG_BT_SCAN_FILTER_ADDR_COUNT} addresses
+ *         are already in the filter.
+ */
+int bt_le_scan_filter_add_addr(const bt_addr_le_t *addr);
+
+/**
+ * @brief Add an advertising data pattern to the scan filter.
+ *
+ * A report matches the pattern if its advertising data has an AD structure
+ * of type @p type whose data start with @p data. For the UUID lists, the
+ * pattern may also match any UUID of the list, when @p len is the size of
+ * the UUIDs of the list. See @ref bt_le_scan_filter_add_addr.
+ *
+ * @param type AD type, BT_DATA_*.
+ * @param data Start of the data of the AD structure, for instance the
+ *             company identifier of @ref BT_DATA_MANUFACTURER_DATA.
+ * @param len  Length of @p data, at most
+ *             @kconfig{CONFIG_BT_SCAN_FILTER_DATA_LEN}.
+ *
+ * @return Zero on success or (negative) error code otherwise.
+ * @return -ENOMEM if @kconfig{CONFIG_BT_SCAN_FILTER_DATA_COUNT} patterns
+ *         are already in the filter.
+ */
+int bt_le_scan_filter_add_data(uint8_t type, const uint8_t *data, uint8_t len);
+
+/**
+ * @brief Remove all the addresses and patterns of the scan filter.
+ */
+void bt_le_scan_filter_clear(void);
+#endif /* CONFIG_BT_SCAN_FILTER || __DOXYGEN__ */
+
 /**
  * @brief Add device (LE) to filter accept list.
  *
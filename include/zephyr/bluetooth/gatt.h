@@ -1558,6 +1558,91 @@ struct bt_gatt_discover_params {
 int bt_gatt_discover(struct bt_conn *conn,
 		     struct bt_gatt_discover_params *params);
 
+#if defined(CONFIG_BT_GATT_DISCOVER_PIPELINE) || defined(__DOXYGEN__)
+struct bt_gatt_discover_all_params;
+
+/** @typedef bt_gatt_discover_all_done_t
+ *  @brief Pipelined discovery completion callback
+ *
+ *  @param conn Connection object.
+ *  @param err 0 if the whole database was discovered, negative error code
+ *             if the discovery failed or was stopped.
+ *  @param params Discovery parameters used.
+ */
+typedef void (*bt_gatt_discover_all_done_t)(struct bt_conn *conn, int err,
+					    struct bt_gatt_discover_all_params *params);
+
+/** @cond INTERNAL_HIDDEN
+ *  One discovery request of a pipelined discovery.
+ */
+struct bt_gatt_discover_all_req {
+	struct bt_gatt_discover_params params;
+	struct bt_gatt_discover_all_params *all;
+	/* End handle of the service of a characteristic discovery */
+	uint16_t svc_end;
+	/* Start of the descriptors of the last characteristic found */
+	uint16_t desc_start;
+	bool busy;
+};
+
+/* Range still to discover */
+struct bt_gatt_discover_all_range {
+	uint16_t start_handle;
+	uint16_t end_handle;
+	uint16_t svc_end;
+	uint16_t desc_start;
+	uint8_t type;
+};
+/** @endcond */
+
+/** @brief GATT pipelined discovery parameters */
+struct bt_gatt_discover_all_params {
+	/** @brief Attribute callback
+	 *
+	 *  Called for the primary services, characteristics and descriptors
+	 *  found, with the parameters of the discovery that found them: the
+	 *  type of the attribute is in @p params->type. The callback is never
+	 *  called with a NULL attribute, and the attributes do not come in
+	 *  handle order. Returning @ref BT_GATT_ITER_STOP stops the discovery.
+	 */
+	bt_gatt_discover_func_t func;
+	/** Completion callback */
+	bt_gatt_discover_all_done_t done;
+
+	/** @cond INTERNAL_HIDDEN */
+	struct bt_gatt_discover_all_req _reqs[CONFIG_BT_GATT_DISCOVER_PIPELINE_DEPTH];
+	struct bt_gatt_discover_all_range _ranges[CONFIG_BT_GATT_DISCOVER_PIPELINE_RANGES];
+	uint8_t _range_count;
+	int _err;
+	/** @endcond */
+};
+
+/** @brief Pipelined discovery of the whole database
+ *
+ *  Discover the primary services, characteristics and descriptors of the
+ *  server with up to @kconfig{CONFIG_BT_GATT_DISCOVER_PIPELINE_DEPTH}
+ *  requests in flight: the characteristics of the services found are
+ *  discovered while the discovery of the primary services goes on, and so
+ *  are the descriptors of the characteristics found. The ATT layer sends
+ *  the requests on all the EATT bearers of the connection.
+ *
+ *  With @kconfig{CONFIG_BT_GATT_CLIENT_CACHE}, the database of a bonded
+ *  server is cached. When the Database Hash of the server has not changed
+ *  since, the attributes are given from the cache without discovery.
+ *
+ *  The callbacks are run from the BT RX thread. @p params must remain valid
+ *  until @p params->done is called.
+ *
+ *  @param conn Connection object.
+ *  @param params Discovery parameters.
+ *
+ *  @retval 0 Successfully started the discovery, @p params->done will be
+ *  called when it ends.
+ *  @return negative error code otherwise.
+ */
+int bt_gatt_discover_all(struct bt_conn *conn, struct bt_gatt_discover_all_params *params);
+#endif /* CONFIG_BT_GATT_DISCOVER_PIPELINE || __DOXYGEN__ */
+
 struct bt_gatt_read_params;
 
 /** @typedef bt_gatt_read_func_t
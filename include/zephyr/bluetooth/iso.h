@@ -879,6 +879,49 @@ int bt_iso_chan_send(struct bt_iso_chan *chan, struct net_buf *buf, uint16_t seq
 int bt_iso_chan_send_ts(struct bt_iso_chan *chan, struct net_buf *buf, uint16_t seq_num,
 			uint32_t ts);
 
+/** @brief SDU of a batch sent with bt_iso_chan_send_batch() */
+struct bt_iso_tx_sdu {
+	/** Channel to send the SDU on. */
+	struct bt_iso_chan *chan;
+	/** Buffer containing the SDU. */
+	struct net_buf *buf;
+	/** Packet Sequence number, as for bt_iso_chan_send(). */
+	uint16_t seq_num;
+};
+
+/** @brief Send the SDUs of an SDU interval to several ISO channels
+ *
+ *  Send the SDUs of the same SDU interval of several channels, e.g. the
+ *  channels of a CIG or a BIG. All the SDUs are queued before any is handed
+ *  to the HCI driver, so that they are sent to the controller together.
+ *
+ *  None of the SDUs is sent if any of them is not valid for
+ *  bt_iso_chan_send().
+ *
+ *  @note The ownership of the buffers of the SDUs that are queued is
+ *  transferred to the stack, the caller retains the ownership of the others.
+ *
+ *  @param sdus   SDUs to send.
+ *  @param count  Number of SDUs in @p sdus.
+ *
+ *  @return Number of SDUs queued, from the first one, in case of success or
+ *          negative value in case of error.
+ */
+int bt_iso_chan_send_batch(const struct bt_iso_tx_sdu *sdus, size_t count);
+
+/** @brief Send the SDUs of an SDU interval to several ISO channels with timestamp
+ *
+ *  Same as bt_iso_chan_send_batch(), with the same timestamp for all the SDUs.
+ *
+ *  @param sdus   SDUs to send.
+ *  @param count  Number of SDUs in @p sdus.
+ *  @param ts     Timestamp of the SDUs in microseconds (us).
+ *
+ *  @return Number of SDUs queued, from the first one, in case of success or
+ *          negative value in case of error.
+ */
+int bt_iso_chan_send_batch_ts(const struct bt_iso_tx_sdu *sdus, size_t count, uint32_t ts);
+
 /** @brief ISO Unicast TX Info Structure */
 struct bt_iso_unicast_tx_info {
 	/** The transport latency in us */
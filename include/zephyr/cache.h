@@ -388,6 +388,101 @@ static ALWAYS_INLINE int sys_cache_instr_flush_and_invd_range(void *addr, size_t
 	return -ENOTSUP;
 }
 
+/** @brief Address range of a batched d-cache operation */
+struct sys_cache_range {
+	/** Starting address */
+	void *addr;
+	/** Range size */
+	size_t size;
+};
+
+#if (defined(CONFIG_CACHE_MANAGEMENT) && defined(CONFIG_DCACHE)) || defined(__DOXYGEN__)
+
+/**
+ * @brief Flush several address ranges in the d-cache
+ *
+ * Same as calling sys_cache_data_flush_range() for each range, typically for
+ * the buffers of a scatter-gather DMA transfer, but ranges sharing or
+ * touching a cache line are flushed together and, if the architecture
+ * allows it, the memory barriers are only issued once for the whole batch.
+ * From @kconfig{CONFIG_DCACHE_RANGES_ALL_THRESHOLD} bytes the whole d-cache
+ * is flushed instead.
+ *
+ * Coalescing is done between consecutive ranges only, sorting them by
+ * address gives the most of it.
+ *
+ * @param ranges Address ranges.
+ * @param count Number of ranges.
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+int sys_cache_data_flush_ranges(const struct sys_cache_range *ranges, size_t count);
+
+/**
+ * @brief Invalidate several address ranges in the d-cache
+ *
+ * Same as calling sys_cache_data_invd_range() for each range, with the
+ * batching of sys_cache_data_flush_ranges(). Only overlapping or contiguous
+ * ranges are merged, so data between two ranges is never invalidated, and
+ * the whole d-cache is never invalidated.
+ *
+ * @param ranges Address ranges.
+ * @param count Number of ranges.
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+int sys_cache_data_invd_ranges(const struct sys_cache_range *ranges, size_t count);
+
+/**
+ * @brief Flush and Invalidate several address ranges in the d-cache
+ *
+ * Same as calling sys_cache_data_flush_and_invd_range() for each range, with
+ * the batching of sys_cache_data_flush_ranges().
+ *
+ * @param ranges Address ranges.
+ * @param count Number of ranges.
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+int sys_cache_data_flush_and_invd_ranges(const struct sys_cache_range *ranges, size_t count);
+
+#else
+
+static ALWAYS_INLINE int sys_cache_data_flush_ranges(const struct sys_cache_range *ranges,
+						     size_t count)
+{
+	ARG_UNUSED(ranges);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+
+static ALWAYS_INLINE int sys_cache_data_invd_ranges(const struct sys_cache_range *ranges,
+						    size_t count)
+{
+	ARG_UNUSED(ranges);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+
+static ALWAYS_INLINE int sys_cache_data_flush_and_invd_ranges(const struct sys_cache_range *ranges,
+							      size_t count)
+{
+	ARG_UNUSED(ranges);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_CACHE_MANAGEMENT && CONFIG_DCACHE */
+
 /**
  *
  * @brief Get the the d-cache line size.
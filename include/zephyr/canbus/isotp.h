@@ -301,6 +301,28 @@ int isotp_recv(struct isotp_recv_ctx *rctx, uint8_t *data, size_t len, k_timeout
  */
 int isotp_recv_net(struct isotp_recv_ctx *rctx, struct net_buf **buffer, k_timeout_t timeout);
 
+/**
+ * @brief Give a buffer to receive the next message into
+ *
+ * The next multi-frame message received on the context is written directly
+ * into this buffer, in one piece and regardless of BS, if it fits.
+ * Otherwise, and for single frames, the buffer is not used and the data is
+ * received into net-buffers as usual. The buffer is used for one message
+ * only and must be given again for the next one.
+ * Calling isotp_recv() with the same buffer and size then returns the whole
+ * message without copying it, and isotp_recv_net() returns a net_buf
+ * pointing to the buffer.
+ *
+ * @note @kconfig{CONFIG_ISOTP_RX_USER_BUF} must be selected for this function
+ * to be available.
+ *
+ * @param rctx Context that is already bound.
+ * @param buf  Buffer valid until the message is read out, or NULL to not
+ *             use a buffer.
+ * @param size Size of the buffer.
+ */
+void isotp_recv_set_buf(struct isotp_recv_ctx *rctx, uint8_t *buf, size_t size);
+
 /**
  * @brief Send data
  *
@@ -436,7 +458,7 @@ struct isotp_send_ctx {
 	};
 	struct isotp_fc_opts opts;
 	uint8_t state;
-	uint8_t tx_backlog;
+	atomic_t tx_backlog;
 	struct k_sem tx_sem;
 	struct isotp_msg_id rx_addr;
 	struct isotp_msg_id tx_addr;
@@ -468,6 +490,10 @@ struct isotp_recv_ctx {
 	uint8_t bs;
 	uint8_t wft;
 	uint8_t sn_expected : 4;
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+	uint8_t *user_buf;
+	size_t user_buf_size;
+#endif
 };
 
 /** @endcond */
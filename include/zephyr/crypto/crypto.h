@@ -21,6 +21,7 @@
 #include <errno.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/slist.h>
 #include <zephyr/crypto/hash.h>
 #include "cipher.h"
 
@@ -489,6 +490,89 @@ static inline int hash_update(struct hash_ctx *ctx, struct hash_pkt *pkt)
 	return ctx->hash_hndlr(ctx, pkt, false);
 }
 
+/**
+ * @}
+ */
+
+/**
+ * @brief Crypto asynchronous request APIs
+ * @defgroup crypto_async Asynchronous requests
+ * @ingroup crypto
+ * @{
+ */
+
+struct crypto_async_req;
+
+/** Cipher request of crypto_async_submit() */
+#define CRYPTO_ASYNC_CIPHER	0
+/** Hash update request of crypto_async_submit() */
+#define CRYPTO_ASYNC_HASH_UPDATE	1
+/** Hash compute request of crypto_async_submit() */
+#define CRYPTO_ASYNC_HASH_COMPUTE	2
+
+/**
+ * @brief Completion callback of an asynchronous crypto request
+ *
+ * @param req Completed request, which can be submitted again.
+ * @param result 0 on success, negative errno code on fail.
+ */
+typedef void (*crypto_async_cb_t)(struct crypto_async_req *req, int result);
+
+/**
+ * @brief Asynchronous crypto request
+ *
+ * Owned by the crypto async layer from its submission until its callback is
+ * called.
+ */
+struct crypto_async_req {
+	/** Internally used list node */
+	sys_snode_t node;
+	/** CRYPTO_ASYNC_CIPHER, CRYPTO_ASYNC_HASH_UPDATE or CRYPTO_ASYNC_HASH_COMPUTE */
+	uint8_t op;
+	union {
+		/** Cipher session of a cipher request */
+		struct cipher_ctx *cipher_ctx;
+		/** Hash session of a hash request */
+		struct hash_ctx *hash_ctx;
+	};
+	union {
+		/** Packet of an ECB, CBC or CTR cipher request */
+		struct cipher_pkt *cipher_pkt;
+		/** Packet of a CCM or GCM cipher request */
+		struct cipher_aead_pkt *aead_pkt;
+		/** Packet of a hash request */
+		struct hash_pkt *hash_pkt;
+	};
+	/** IV or nonce of a cipher request, unused in ECB mode */
+	uint8_t *iv;
+	/** Completion callback */
+	crypto_async_cb_t cb;
+	/** Free for the submitter's use */
+	void *user_data;
+};
+
+/**
+ * @brief Run a cipher or hash operation without waiting for it
+ *
+ * Requests are queued and run in submission order from a work queue thread,
+ * with the synchronous operations of the session's driver, which calls their
+ * callback. The submitter can prepare the next requests while the driver
+ * runs the queued ones.
+ *
+ * The session must have been set up with CAP_SYNC_OPS, and its requests must
+ * not be mixed with operations done directly while they are queued.
+ *
+ * Requires CONFIG_CRYPTO_ASYNC.
+ *
+ * @param req Request, which must stay valid until its callback is called.
+ *            @a op, the context and the packet of the operation, @a cb and
+ *            @a iv for the cipher modes other than ECB must be set.
+ *
+ * @return 0 if the request was submitted, negative errno code on fail, in
+ *         which case the callback is not called.
+ */
+int crypto_async_submit(struct crypto_async_req *req);
+
 /**
  * @}
  */
@@ -689,6 +689,199 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+/**
+ * @brief Event reported by a streaming JSON parser
+ *
+ * One event is reported for every scalar value, and two for every object
+ * or array: one when it starts and one when it ends.
+ */
+struct json_stream_event {
+	/** JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END, JSON_TOK_ARRAY_START,
+	 * JSON_TOK_ARRAY_END, JSON_TOK_STRING, JSON_TOK_NUMBER,
+	 * JSON_TOK_TRUE, JSON_TOK_FALSE or JSON_TOK_NULL.
+	 */
+	enum json_tokens type;
+	/** Name of the member, or NULL for array elements, the top level
+	 * value and the end of objects and arrays. Not NUL terminated.
+	 */
+	const char *key;
+	size_t key_len;
+	/** NUL terminated text of a scalar value, without the quotes of a
+	 * string. Escapes are not processed.
+	 */
+	const char *value;
+	size_t value_len;
+	/** Number of objects and arrays enclosing the value */
+	uint8_t depth;
+};
+
+/**
+ * @brief Function pointer type to receive the events of a streaming parser
+ *
+ * The key and value of the event are only valid during the call.
+ *
+ * @param event Parsed event
+ * @param user_data User-provided pointer
+ *
+ * @return 0 to continue parsing, or a negative number to stop it, which is
+ * returned by json_stream_feed().
+ */
+typedef int (*json_stream_cb_t)(const struct json_stream_event *event,
+				void *user_data);
+
+/**
+ * @brief Streaming parser state
+ *
+ * Fields are internal, use json_stream_init().
+ */
+struct json_stream {
+	json_stream_cb_t cb;
+	void *user_data;
+	/* Holds the member name and the token being parsed, which may
+	 * straddle chunks.
+	 */
+	char *buf;
+	size_t buf_size;
+	size_t key_len;
+	size_t tok_len;
+	/* Bit n is set when the container at depth n is an object */
+	uint32_t nesting;
+	uint8_t depth;
+	uint8_t state;
+	uint8_t lex;
+	uint8_t lex_count;
+	enum json_tokens tok_type;
+};
+
+/** Deepest nesting of objects and arrays decoded by a json_obj_stream */
+#define JSON_OBJ_STREAM_MAX_DEPTH 4
+
+/** @cond INTERNAL_HIDDEN */
+struct json_obj_stream_frame {
+	const struct json_obj_descr *descr;
+	size_t descr_len;
+	/* Object being decoded, or next element of an array */
+	void *val;
+	/* Element count of an array, NULL for objects */
+	size_t *elements;
+	int64_t decoded;
+	/* Descriptor index of the object or array in its parent */
+	int8_t index;
+	int8_t hint;
+};
+/** @endcond */
+
+/**
+ * @brief Streaming descriptor decoder state
+ *
+ * Fields are internal, use json_obj_stream_init().
+ */
+struct json_obj_stream {
+	struct json_stream stream;
+	struct json_obj_stream_frame frames[JSON_OBJ_STREAM_MAX_DEPTH];
+	/* Depth of the unknown value being skipped, or 0 */
+	uint8_t skip;
+};
+
+/**
+ * @brief Initialize a streaming JSON parser
+ *
+ * The parser accepts a JSON document in chunks of any size with
+ * json_stream_feed(), such as the data returned by successive socket reads,
+ * and reports its values to @a cb as soon as they are complete. The document
+ * is processed in a single pass and is never buffered: only the member name
+ * and the token being parsed are kept in @a buf, so @a buf must be larger
+ * than the longest member name plus the longest scalar value.
+ *
+ * The same liberties as json_obj_parse() are taken, and nesting is limited
+ * to 32 levels.
+ *
+ * @param js Parser state
+ * @param buf Buffer for the tokens being parsed
+ * @param buf_size Size of @a buf
+ * @param cb Function receiving the events
+ * @param user_data Pointer passed to @a cb
+ */
+void json_stream_init(struct json_stream *js, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data);
+
+/**
+ * @brief Parse the next chunk of a JSON document
+ *
+ * @param js Parser state
+ * @param data Chunk of the JSON document
+ * @param len Length of the chunk
+ *
+ * @return 0 if the chunk has been parsed, -EINVAL if the document is
+ * malformed, -ENOMEM if a token does not fit in the buffer, or the error
+ * returned by the callback. The parser cannot be used after an error until
+ * it is initialized again.
+ */
+int json_stream_feed(struct json_stream *js, const char *data, size_t len);
+
+/**
+ * @brief Finish parsing a JSON document
+ *
+ * Reports the number that ends a document made of a single number.
+ *
+ * @param js Parser state
+ *
+ * @return 0 if a whole document has been parsed, or a negative value
+ * otherwise (as defined on errno.h).
+ */
+int json_stream_finish(struct json_stream *js);
+
+/**
+ * @brief Initialize a streaming descriptor decoder
+ *
+ * The decoder parses a JSON object fed in chunks with json_obj_stream_feed()
+ * according to the descriptor pointed to by @a descr, in the same way as
+ * json_obj_parse(). Each field is stored in @a val as soon as its value is
+ * complete. Values are matched to descriptors in a single pass, and fields
+ * that come in the order of the descriptors are found without a search.
+ *
+ * Since the document is not kept in memory, the strings and tokens decoded
+ * into fields of type JSON_TOK_STRING, JSON_TOK_FLOAT and JSON_TOK_OPAQUE
+ * are copied to the end of @a buf, which must be large enough for them too.
+ * They stay valid until the decoder is initialized again. Arrays of arrays,
+ * JSON_TOK_OBJ_ARRAY fields, and objects nested more than
+ * JSON_OBJ_STREAM_MAX_DEPTH deep are not supported.
+ *
+ * @param os Decoder state
+ * @param buf Buffer for the tokens being parsed and the decoded strings
+ * @param buf_size Size of @a buf
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array. Must be less
+ * than 63.
+ * @param val Pointer to the struct to hold the decoded values
+ */
+void json_obj_stream_init(struct json_obj_stream *os, char *buf,
+			  size_t buf_size, const struct json_obj_descr *descr,
+			  size_t descr_len, void *val);
+
+/**
+ * @brief Decode the next chunk of a JSON object
+ *
+ * @param os Decoder state
+ * @param data Chunk of the JSON document
+ * @param len Length of the chunk
+ *
+ * @return 0 if the chunk has been decoded, or a negative value otherwise
+ * (as defined on errno.h).
+ */
+int json_obj_stream_feed(struct json_obj_stream *os, const char *data,
+			 size_t len);
+
+/**
+ * @brief Finish decoding a JSON object
+ *
+ * @param os Decoder state
+ *
+ * @return < 0 if error, bitmap of decoded fields on success (bit 0
+ * is set if first field in the descriptor has been properly decoded, etc).
+ */
+int64_t json_obj_stream_finish(struct json_obj_stream *os);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -801,6 +994,195 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+/**
+ * @brief Output of an encoder defined with JSON_ENCODER_DEFINE()
+ *
+ * Fields are internal. Bytes that do not fit in the buffer are counted and
+ * dropped.
+ */
+struct json_enc {
+	char *buf;
+	size_t size;
+	size_t len;
+};
+
+/** @cond INTERNAL_HIDDEN */
+void json_enc_raw(struct json_enc *enc, const char *bytes, size_t len);
+void json_enc_str(struct json_enc *enc, const char *str);
+void json_enc_num(struct json_enc *enc, int32_t num);
+void json_enc_bool(struct json_enc *enc, bool value);
+void json_enc_float(struct json_enc *enc, const struct json_obj_token *num);
+void json_enc_opaque(struct json_enc *enc, const struct json_obj_token *opaque);
+ssize_t json_enc_finish(struct json_enc *enc);
+
+#define Z_JSON_ENC_LITERAL(enc, str) json_enc_raw(enc, str, sizeof(str) - 1)
+
+/* The key of a field, with the punctuation in front of it */
+#define Z_JSON_ENC_KEY(enc, idx, name) \
+	Z_JSON_ENC_LITERAL(enc, COND_CODE_0(idx, ("{"), (",")) "\"" name "\":")
+
+#define Z_JSON_ENC_VALUE(enc, idx, val, field, name, fn) \
+	Z_JSON_ENC_KEY(enc, idx, name);                  \
+	fn(enc, (val)->field)
+
+#define Z_JSON_ENC_TOKEN(enc, idx, val, field, name, fn) \
+	Z_JSON_ENC_KEY(enc, idx, name);                  \
+	fn(enc, &(val)->field)
+
+#define Z_JSON_ENC_ARRAY(enc, idx, val, field, name, len_field, fn, ref) \
+	Z_JSON_ENC_KEY(enc, idx, name);                                  \
+	for (size_t i = 0; i < (val)->len_field; i++) {                  \
+		json_enc_raw(enc, i == 0 ? "[" : ",", 1);                \
+		fn(enc, ref (val)->field[i]);                            \
+	}                                                                \
+	json_enc_raw(enc, (val)->len_field == 0 ? "[]" : "]",            \
+		     (val)->len_field == 0 ? 2 : 1)
+
+#define Z_JSON_ENC_CALL(idx, val, kind, ...) kind(enc, idx, val, __VA_ARGS__)
+#define Z_JSON_ENC_APPLY(m, args) m args
+#define Z_JSON_ENC_FIELD(idx, field, val) \
+	Z_JSON_ENC_APPLY(Z_JSON_ENC_CALL, (idx, val, __DEBRACKET field))
+/** @endcond */
+
+/**
+ * @brief Define an encoder specialized for a struct at build time
+ *
+ * This defines the functions
+ *
+ * @code
+ * ssize_t name(const struct_ *val, char *buf, size_t buf_size);
+ * void name_fields(struct json_enc *enc, const struct_ *val);
+ * @endcode
+ *
+ * The first one encodes @a val as a JSON object in a single pass over the
+ * fields given with the JSON_ENC_* macros, writing straight into @a buf,
+ * and returns the length of the whole encoded object. Like snprintf(), it
+ * never writes more than @a buf_size bytes, the output has been truncated
+ * when the returned length is not smaller than @a buf_size, and passing a
+ * NULL buffer of size 0 only measures the object. The output and the length
+ * are the same as json_obj_encode_buf() and json_calc_encoded_len() give
+ * for a descriptor with the same fields in the same order, but the keys and
+ * punctuation are assembled by the preprocessor, and no descriptor is
+ * walked.
+ *
+ * The second one is used to encode nested objects with JSON_ENC_OBJECT()
+ * and JSON_ENC_OBJ_ARRAY().
+ *
+ * @code
+ * struct telemetry { int32_t id; const char *name; bool ok; };
+ *
+ * JSON_ENCODER_DEFINE(telemetry_encode, struct telemetry,
+ *                     JSON_ENC_NUMBER(id), JSON_ENC_STRING(name),
+ *                     JSON_ENC_BOOL(ok));
+ * @endcode
+ *
+ * @param name Name of the encoder function
+ * @param struct_ Type of the encoded struct
+ * @param ... Fields to encode, at least one
+ */
+#define JSON_ENCODER_DEFINE(name, struct_, ...)                              \
+	void name##_fields(struct json_enc *enc, const struct_ *val)         \
+	{                                                                    \
+		FOR_EACH_IDX_FIXED_ARG(Z_JSON_ENC_FIELD, (;), val,           \
+				       __VA_ARGS__);                         \
+		json_enc_raw(enc, "}", 1);                                   \
+	}                                                                    \
+	ssize_t name(const struct_ *val, char *buf, size_t buf_size)         \
+	{                                                                    \
+		struct json_enc enc = { .buf = buf, .size = buf_size };      \
+									     \
+		name##_fields(&enc, val);                                    \
+		return json_enc_finish(&enc);                                \
+	}
+
+/**
+ * @brief Encode an int32_t field, like JSON_TOK_NUMBER
+ *
+ * The JSON key of the field is its name. The _NAMED variants of the JSON_ENC_*
+ * macros take the key as a string literal, which is emitted as is.
+ *
+ * @param field_ Field name in the struct
+ */
+#define JSON_ENC_NUMBER(field_) JSON_ENC_NUMBER_NAMED(field_, #field_)
+#define JSON_ENC_NUMBER_NAMED(field_, name_) \
+	(Z_JSON_ENC_VALUE, field_, name_, json_enc_num)
+
+/**
+ * @brief Encode a bool field, like JSON_TOK_TRUE
+ *
+ * @param field_ Field name in the struct
+ */
+#define JSON_ENC_BOOL(field_) JSON_ENC_BOOL_NAMED(field_, #field_)
+#define JSON_ENC_BOOL_NAMED(field_, name_) \
+	(Z_JSON_ENC_VALUE, field_, name_, json_enc_bool)
+
+/**
+ * @brief Encode a NUL terminated string field, like JSON_TOK_STRING
+ *
+ * @param field_ Field name in the struct
+ */
+#define JSON_ENC_STRING(field_) JSON_ENC_STRING_NAMED(field_, #field_)
+#define JSON_ENC_STRING_NAMED(field_, name_) \
+	(Z_JSON_ENC_VALUE, field_, name_, json_enc_str)
+
+/**
+ * @brief Encode a struct json_obj_token field, like JSON_TOK_FLOAT
+ *
+ * @param field_ Field name in the struct
+ */
+#define JSON_ENC_FLOAT(field_) JSON_ENC_FLOAT_NAMED(field_, #field_)
+#define JSON_ENC_FLOAT_NAMED(field_, name_) \
+	(Z_JSON_ENC_TOKEN, field_, name_, json_enc_float)
+
+/**
+ * @brief Encode a struct json_obj_token field, like JSON_TOK_OPAQUE
+ *
+ * @param field_ Field name in the struct
+ */
+#define JSON_ENC_OPAQUE(field_) JSON_ENC_OPAQUE_NAMED(field_, #field_)
+#define JSON_ENC_OPAQUE_NAMED(field_, name_) \
+	(Z_JSON_ENC_TOKEN, field_, name_, json_enc_opaque)
+
+/**
+ * @brief Encode a struct field with an encoder of its own
+ *
+ * @param field_ Field name in the struct
+ * @param encoder_ Name of the encoder defined for the type of the field
+ */
+#define JSON_ENC_OBJECT(field_, encoder_) \
+	JSON_ENC_OBJECT_NAMED(field_, #field_, encoder_)
+#define JSON_ENC_OBJECT_NAMED(field_, name_, encoder_) \
+	(Z_JSON_ENC_TOKEN, field_, name_, encoder_##_fields)
+
+/**
+ * @brief Encode an array field of primitive values
+ *
+ * @param field_ Field name in the struct
+ * @param len_field_ Field holding the number of elements
+ * @param elem_ One of JSON_ENC_ELEM_NUMBER, JSON_ENC_ELEM_BOOL and
+ *              JSON_ENC_ELEM_STRING
+ */
+#define JSON_ENC_ARRAY(field_, len_field_, elem_) \
+	JSON_ENC_ARRAY_NAMED(field_, #field_, len_field_, elem_)
+#define JSON_ENC_ARRAY_NAMED(field_, name_, len_field_, elem_) \
+	(Z_JSON_ENC_ARRAY, field_, name_, len_field_, elem_, /* by value */)
+
+#define JSON_ENC_ELEM_NUMBER json_enc_num
+#define JSON_ENC_ELEM_BOOL json_enc_bool
+#define JSON_ENC_ELEM_STRING json_enc_str
+
+/**
+ * @brief Encode an array field of structs with an encoder of their own
+ *
+ * @param field_ Field name in the struct
+ * @param len_field_ Field holding the number of elements
+ * @param encoder_ Name of the encoder defined for the type of the elements
+ */
+#define JSON_ENC_OBJ_ARRAY(field_, len_field_, encoder_) \
+	JSON_ENC_OBJ_ARRAY_NAMED(field_, #field_, len_field_, encoder_)
+#define JSON_ENC_OBJ_ARRAY_NAMED(field_, name_, len_field_, encoder_) \
+	(Z_JSON_ENC_ARRAY, field_, name_, len_field_, encoder_##_fields, &)
+
 #ifdef __cplusplus
 }
 #endif
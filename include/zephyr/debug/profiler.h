@@ -0,0 +1,108 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel/thread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup profiler Sampling profiler
+ * @ingroup os_services
+ * @brief Periodic sampling of what the CPUs run.
+ *
+ * A timer takes samples of the thread that runs on each CPU and, where the
+ * architecture supports it, of the program counter it was interrupted at.
+ * Samples are exported as folded stacks, the input of flame graph tools.
+ *
+ * Samples refer to threads by address, so a thread object must not be
+ * reused for another thread before the samples are exported.
+ * @{
+ */
+
+/** @brief Profiler sample */
+struct profiler_sample {
+	/** Thread that was running */
+	const struct k_thread *thread;
+	/** Interrupted program counter, then return addresses */
+	uintptr_t pc[CONFIG_PROFILER_STACK_DEPTH];
+	/** Number of valid entries in @a pc */
+	uint8_t depth;
+	/** CPU the thread was running on */
+	uint8_t cpu;
+};
+
+/** @brief Folded stack callback
+ *
+ *  @param sample Stack of the samples.
+ *  @param count Number of samples with this stack.
+ *  @param user_data User data.
+ */
+typedef void (*profiler_folded_cb_t)(const struct profiler_sample *sample,
+				     uint32_t count, void *user_data);
+
+/** @brief Start sampling, or change the sampling frequency
+ *
+ *  Samples already taken are kept, call profiler_reset() to drop them.
+ *
+ *  @param frequency Samples per second, at most the system tick rate.
+ *
+ *  @retval 0 on success.
+ *  @retval -EINVAL if the frequency is not supported.
+ */
+int profiler_start(uint32_t frequency);
+
+/** @brief Stop sampling */
+void profiler_stop(void);
+
+/** @brief Check if the profiler is sampling
+ *
+ *  @return true if sampling, false otherwise.
+ */
+bool profiler_is_running(void);
+
+/** @brief Drop the samples
+ *
+ *  @retval 0 on success.
+ *  @retval -EBUSY if the profiler is running.
+ */
+int profiler_reset(void);
+
+/** @brief Get the number of samples that did not fit in the buffer
+ *
+ *  @return Number of dropped samples.
+ */
+uint32_t profiler_dropped_get(void);
+
+/** @brief Go through the samples as folded stacks
+ *
+ *  Identical samples are merged, so that each stack is given once with the
+ *  number of samples taken in it. The samples are reordered.
+ *
+ *  @param cb Callback.
+ *  @param user_data User data passed to the callback.
+ *
+ *  @retval Number of samples on success.
+ *  @retval -EBUSY if the profiler is running.
+ */
+int profiler_folded_foreach(profiler_folded_cb_t cb, void *user_data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PROFILER_H_ */
@@ -371,6 +371,11 @@ struct device_state {
 	 * invoked.
 	 */
 	bool initialized : 1;
+
+#if defined(CONFIG_DEVICE_INIT_PARALLEL) || defined(__DOXYGEN__)
+	/** Indicates a thread started the device initialization function. */
+	bool init_started : 1;
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
 };
 
 struct pm_device_base;
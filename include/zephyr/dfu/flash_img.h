@@ -17,6 +17,14 @@
 
 #include <zephyr/storage/stream_flash.h>
 
+#if defined(CONFIG_IMG_STREAM_HASH)
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+#include <tinycrypt/sha256.h>
+#else
+#include <mbedtls/sha256.h>
+#endif
+#endif
+
 /**
  * @brief Abstraction layer to write firmware images to flash
  *
@@ -31,8 +39,20 @@ extern "C" {
 
 struct flash_img_context {
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	uint8_t buf2[CONFIG_IMG_BLOCK_BUF_SIZE];
+#endif
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
+#if defined(CONFIG_IMG_STREAM_HASH)
+	/* SHA-256 of the data handed to the flash so far */
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	struct tc_sha256_state_struct sha;
+#else
+	mbedtls_sha256_context sha;
+#endif
+	size_t sha_len; /* Bytes hashed, SIZE_MAX if the hash is not usable */
+#endif
 };
 
 /**
@@ -111,6 +131,68 @@ int flash_img_check(struct flash_img_context *ctx,
 		    const struct flash_img_check *fic,
 		    uint8_t area_id);
 
+/**
+ * @brief  Verify the data written through a context, without reading it back
+ * from the flash.
+ *
+ * The data is hashed while it is written, so that the hash is ready as soon
+ * as the last block is flushed. The function is enabled via
+ * CONFIG_IMG_STREAM_HASH Kconfig option.
+ *
+ * @param[in] ctx context the image was written with, and flushed.
+ * @param[in] fic flash img check data, where clen is the size of the image.
+ *
+ * @return  0 on success, -EILSEQ if the hash does not match, -ENODATA if the
+ * data hashed is not the clen bytes of the image, negative errno code on other
+ * failures. flash_img_check() can still verify the image when -ENODATA is
+ * returned, e.g. after a write was resumed without its hash.
+ */
+int flash_img_check_written(struct flash_img_context *ctx,
+			    const struct flash_img_check *fic);
+
+/**
+ * @brief  Load the progress of a previous write, so that it can be resumed.
+ *
+ * The progress functions are enabled via CONFIG_STREAM_FLASH_PROGRESS Kconfig
+ * option. Call after flash_img_init_id(). Wraps stream_flash_progress_load();
+ * with CONFIG_IMG_STREAM_HASH, the hash of the data written before is restored
+ * as well, so that flash_img_check_written() still works once the write is
+ * done.
+ *
+ * @param ctx context
+ * @param settings_key key the progress was saved under
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_progress_load(struct flash_img_context *ctx,
+			    const char *settings_key);
+
+/**
+ * @brief  Save the progress of the write.
+ *
+ * Wraps stream_flash_progress_save(). With CONFIG_IMG_STREAM_HASH, the hash
+ * of the data written so far is saved under the "sha" subkey of
+ * settings_key.
+ *
+ * @param ctx context
+ * @param settings_key key to save the progress under
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_progress_save(struct flash_img_context *ctx,
+			    const char *settings_key);
+
+/**
+ * @brief  Clear the saved progress of the write.
+ *
+ * @param ctx context
+ * @param settings_key key the progress was saved under
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_progress_clear(struct flash_img_context *ctx,
+			     const char *settings_key);
+
 #ifdef __cplusplus
 }
 #endif
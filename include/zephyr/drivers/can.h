@@ -1308,6 +1308,31 @@ __syscall int can_send(const struct device *dev, const struct can_frame *frame,
 		       k_timeout_t timeout, can_tx_callback_t callback,
 		       void *user_data);
 
+/**
+ * @brief Queue a batch of CAN frames for transmission
+ *
+ * Queue the frames in order with @a can_send(), so all the free TX mailboxes
+ * of the CAN controller are filled in one call. The callback is called once
+ * for each frame queued.
+ *
+ * @note The same rules as for @a can_send() apply to the transmission order of
+ * the frames.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param frames    CAN frames to transmit.
+ * @param count     Number of CAN frames to transmit.
+ * @param timeout   Timeout waiting for a empty TX mailbox for each frame or
+ *                  ``K_FOREVER``.
+ * @param callback  Callback for when a frame was sent or a transmission error
+ *                  occurred.
+ * @param user_data User data to pass to callback function.
+ *
+ * @return Number of frames queued if at least one frame was queued, otherwise
+ *         the error returned by @a can_send() for the first frame.
+ */
+int can_send_batch(const struct device *dev, const struct can_frame *frames, size_t count,
+		   k_timeout_t timeout, can_tx_callback_t callback, void *user_data);
+
 /** @} */
 
 /**
@@ -1364,6 +1389,48 @@ static inline int can_add_rx_filter(const struct device *dev, can_rx_callback_t
 #define CAN_MSGQ_DEFINE(name, max_frames) \
 	K_MSGQ_DEFINE(name, sizeof(struct can_frame), max_frames, 4)
 
+/**
+ * @brief Get a batch of CAN frames from a CAN RX message queue
+ *
+ * Wait for a frame in the message queue, then take the frames already queued
+ * after it up to @a count, so a consumer woken by a burst of frames handles
+ * them in one go.
+ *
+ * @see can_add_rx_filter_msgq()
+ *
+ * @param msgq    Pointer to the CAN RX message queue.
+ * @param frames  Buffer for the received CAN frames.
+ * @param count   Maximum number of CAN frames to get.
+ * @param timeout Timeout waiting for the first frame or ``K_FOREVER``.
+ *
+ * @return Number of frames received on success.
+ * @retval -ENOMSG if returned without waiting.
+ * @retval -EAGAIN on timeout.
+ */
+static inline int can_msgq_get_batch(struct k_msgq *msgq, struct can_frame *frames,
+				     size_t count, k_timeout_t timeout)
+{
+	size_t i;
+	int err;
+
+	if (count == 0U) {
+		return 0;
+	}
+
+	err = k_msgq_get(msgq, &frames[0], timeout);
+	if (err != 0) {
+		return err;
+	}
+
+	for (i = 1U; i < count; i++) {
+		if (k_msgq_get(msgq, &frames[i], K_NO_WAIT) != 0) {
+			break;
+		}
+	}
+
+	return (int)i;
+}
+
 /**
  * @brief Simple wrapper function for adding a message queue for a given filter
  *
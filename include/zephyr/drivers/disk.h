@@ -49,6 +49,22 @@ extern "C" {
 #define DISK_IOCTL_GET_ERASE_BLOCK_SZ		4
 /** Commit any cached read/writes to disk */
 #define DISK_IOCTL_CTRL_SYNC			5
+/** Get the address of a sector in memory-mapped storage */
+#define DISK_IOCTL_GET_SECTOR_MAP		6
+
+/**
+ * @brief Buffer of DISK_IOCTL_GET_SECTOR_MAP
+ *
+ * The mapping is valid until the disk is written to.
+ */
+struct disk_sector_map {
+	/** Sector to map, set by the caller */
+	uint32_t sector;
+	/** Number of sectors readable from @a addr, set by the driver */
+	uint32_t num_sector;
+	/** Address of the sector, set by the driver */
+	const void *addr;
+};
 
 /**
  * @brief Possible return bitmasks for disk_status()
@@ -64,6 +80,20 @@ extern "C" {
 #define DISK_STATUS_WR_PROTECT		0x04
 
 struct disk_operations;
+struct disk_access_req;
+
+/** Read request of disk_access_submit() */
+#define DISK_ACCESS_REQ_READ			0
+/** Write request of disk_access_submit() */
+#define DISK_ACCESS_REQ_WRITE			1
+
+/**
+ * @brief Completion callback of a disk access request
+ *
+ * @param req Completed request, which can be submitted again.
+ * @param result 0 on success, negative errno code on fail.
+ */
+typedef void (*disk_access_cb_t)(struct disk_access_req *req, int result);
 
 /**
  * @brief Disk info
@@ -77,6 +107,41 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+	/** Internally used lock serializing the accesses to the disk */
+	struct k_mutex lock;
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+	/** Internally used number of sectors, 0 if the disk is not cached */
+	uint32_t cache_sector_count;
+	/** Internally used sector following the last read */
+	uint32_t cache_next_sector;
+#endif
+};
+
+/**
+ * @brief Asynchronous disk access request
+ *
+ * Owned by the disk access layer from its submission until its callback is
+ * called.
+ */
+struct disk_access_req {
+	/** Internally used list node */
+	sys_dnode_t node;
+	/** DISK_ACCESS_REQ_READ or DISK_ACCESS_REQ_WRITE */
+	uint8_t op;
+	/** Data to write or buffer to read into */
+	uint8_t *buf;
+	/** First sector */
+	uint32_t start_sector;
+	/** Number of sectors */
+	uint32_t num_sector;
+	/** Completion callback */
+	disk_access_cb_t cb;
+	/** Free for the submitter's use */
+	void *user_data;
+	/** Internally used disk of the request */
+	struct disk_info *disk;
+	/** Internally used next request merged with this one */
+	struct disk_access_req *next_merged;
 };
 
 /**
@@ -90,6 +155,12 @@ struct disk_operations {
 	int (*write)(struct disk_info *disk, const uint8_t *data_buf,
 		     uint32_t start_sector, uint32_t num_sector);
 	int (*ioctl)(struct disk_info *disk, uint8_t cmd, void *buff);
+	/**
+	 * Optional. Start a request without waiting for it, and call its
+	 * callback when it completes, possibly from an ISR. The callback is
+	 * not called when an error is returned.
+	 */
+	int (*submit)(struct disk_info *disk, struct disk_access_req *req);
 };
 
 /**
@@ -94,6 +94,8 @@ enum dma_attribute_type {
 	DMA_ATTR_BUFFER_SIZE_ALIGNMENT,
 	DMA_ATTR_COPY_ALIGNMENT,
 	DMA_ATTR_MAX_BLOCK_COUNT,
+	/** Non-zero if the controller can run a cyclic transfer list */
+	DMA_ATTR_CYCLIC,
 };
 
 /**
@@ -247,7 +249,15 @@ struct dma_config {
 	uint32_t  dest_chaining_en :     1;
 	/** Linked channel, HW specific */
 	uint32_t  linked_channel   :     7;
-	/** Cyclic transfer list, HW specific */
+	/**
+	 * Cyclic transfer list
+	 *
+	 * When set, the controller goes back to the head block once the last
+	 * block is transferred, until the channel is stopped. With
+	 * complete_callback_en set the callback is invoked with
+	 * DMA_STATUS_BLOCK at the completion of each block. Support is
+	 * reported by the DMA_ATTR_CYCLIC attribute.
+	 */
 	uint32_t  cyclic :				 1;
 
 	uint32_t  _reserved :             3;
@@ -26,6 +26,7 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <zephyr/device.h>
+#include <zephyr/sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -505,6 +506,69 @@ static inline int z_impl_flash_ex_op(const struct device *dev, uint16_t code,
 #endif /* CONFIG_FLASH_EX_OP_ENABLED */
 }
 
+struct flash_async_req;
+
+/** Read request of flash_async_submit() */
+#define FLASH_ASYNC_READ	0
+/** Write request of flash_async_submit() */
+#define FLASH_ASYNC_WRITE	1
+/** Erase request of flash_async_submit() */
+#define FLASH_ASYNC_ERASE	2
+
+/**
+ * @brief Completion callback of an asynchronous flash request
+ *
+ * @param req Completed request, which can be submitted again.
+ * @param result 0 on success, negative errno code on fail.
+ */
+typedef void (*flash_async_cb_t)(struct flash_async_req *req, int result);
+
+/**
+ * @brief Asynchronous flash request
+ *
+ * Owned by the flash async layer from its submission until its callback is
+ * called.
+ */
+struct flash_async_req {
+	/** Internally used list node */
+	sys_snode_t node;
+	/** FLASH_ASYNC_READ, FLASH_ASYNC_WRITE or FLASH_ASYNC_ERASE */
+	uint8_t op;
+	/** Offset in the flash */
+	off_t offset;
+	/** Buffer to read into or data to write, unused by erases */
+	void *data;
+	/** Number of bytes */
+	size_t len;
+	/** Completion callback */
+	flash_async_cb_t cb;
+	/** Free for the submitter's use */
+	void *user_data;
+	/** Internally used device of the request */
+	const struct device *dev;
+};
+
+/**
+ *  @brief  Read, write or erase flash without waiting for it
+ *
+ *  Requests are queued and done in submission order from a work queue
+ *  thread, which calls their callback. Erases are done page by page, and
+ *  the reads queued right after an erase are done between its pages when
+ *  they do not read what remains to be erased, so that they do not wait for
+ *  the whole erase.
+ *
+ *  Requires CONFIG_FLASH_ASYNC.
+ *
+ *  @param  dev             Flash device
+ *  @param  req             Request, which must stay valid until its callback
+ *                          is called. @a op, @a offset, @a len and @a cb must
+ *                          be set, and @a data for reads and writes.
+ *
+ *  @return 0 if the request was submitted, negative errno code on fail, in
+ *          which case the callback is not called.
+ */
+int flash_async_submit(const struct device *dev, struct flash_async_req *req);
+
 #ifdef __cplusplus
 }
 #endif
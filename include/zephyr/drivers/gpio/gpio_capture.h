@@ -0,0 +1,138 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Capture of GPIO edge events
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_GPIO_GPIO_CAPTURE_H_
+#define ZEPHYR_INCLUDE_DRIVERS_GPIO_GPIO_CAPTURE_H_
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief GPIO edge event capture
+ * @defgroup gpio_capture GPIO edge event capture
+ * @ingroup gpio_interface
+ * @{
+ */
+
+/** @brief Edge event recorded by a GPIO capture */
+struct gpio_capture_event {
+	/** Cycle count (k_cycle_get_32()) when the interrupt was handled */
+	uint32_t timestamp;
+	/** Pins which triggered the interrupt */
+	gpio_port_pins_t pins;
+	/** Raw value of the captured pins when the interrupt was handled */
+	gpio_port_value_t value;
+};
+
+/**
+ * @brief Ring of captured GPIO edge events
+ *
+ * Records the interrupts of a set of pins of a port from the port's
+ * interrupt handler, so that a thread can handle them in batches.
+ *
+ * @see GPIO_CAPTURE_DEFINE()
+ */
+struct gpio_capture {
+	/** @cond INTERNAL_HIDDEN */
+	struct gpio_callback cb;
+	struct gpio_capture_event *events;
+	uint32_t size;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t overruns;
+	struct k_spinlock lock;
+	struct k_sem sem;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically define a GPIO capture
+ *
+ * @param name Name of the capture.
+ * @param num_events Number of events of the ring, a power of two.
+ */
+#define GPIO_CAPTURE_DEFINE(name, num_events)						\
+	BUILD_ASSERT(IS_POWER_OF_TWO(num_events), "number of events is not a power of two"); \
+	static struct gpio_capture_event _gpio_capture_events_##name[num_events];	\
+	static struct gpio_capture name = {						\
+		.events = _gpio_capture_events_##name,					\
+		.size = (num_events),							\
+		.sem = Z_SEM_INITIALIZER(name.sem, 0, 1),				\
+	}
+
+/**
+ * @brief Start capturing the interrupts of pins of a port
+ *
+ * The interrupts of the pins must be configured with
+ * gpio_pin_interrupt_configure().
+ *
+ * @param port GPIO port.
+ * @param capture Capture, defined with GPIO_CAPTURE_DEFINE().
+ * @param pins Pins to capture.
+ *
+ * @return 0 on success, negative errno code from gpio_add_callback() on fail.
+ */
+int gpio_capture_start(const struct device *port, struct gpio_capture *capture,
+		       gpio_port_pins_t pins);
+
+/**
+ * @brief Stop capturing the interrupts of a port
+ *
+ * Events already captured can still be read.
+ *
+ * @param port GPIO port.
+ * @param capture Capture.
+ *
+ * @return 0 on success, negative errno code from gpio_remove_callback() on fail.
+ */
+int gpio_capture_stop(const struct device *port, struct gpio_capture *capture);
+
+/**
+ * @brief Read captured events
+ *
+ * Wait for at least one event, then read the events captured up to
+ * @p max_events, oldest first.
+ *
+ * @param capture Capture.
+ * @param events Buffer for the events.
+ * @param max_events Maximum number of events to read.
+ * @param timeout Time to wait for the first event.
+ *
+ * @return Number of events read, -EAGAIN if none was captured in time.
+ */
+int gpio_capture_read(struct gpio_capture *capture, struct gpio_capture_event *events,
+		      size_t max_events, k_timeout_t timeout);
+
+/**
+ * @brief Get and reset the number of events lost since the last call
+ *
+ * Events are lost when the ring is full.
+ *
+ * @param capture Capture.
+ *
+ * @return Number of events lost.
+ */
+uint32_t gpio_capture_overruns_get(struct gpio_capture *capture);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_GPIO_GPIO_CAPTURE_H_ */
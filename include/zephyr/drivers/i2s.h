@@ -392,6 +392,10 @@ static inline const struct i2s_config *i2s_config_get(const struct device *dev,
  * i2s_configure). Ownership of the RX memory block is passed on to the user
  * application which has to release it.
  *
+ * The memory block can be handed on by reference, e.g. sent with
+ * usbd_uac2_send() and released from its buffer release callback, without
+ * copying the audio data.
+ *
  * The data is read in chunks equal to the size of the memory block. If the
  * interface is in READY state the number of bytes read can be smaller.
  *
@@ -458,6 +462,10 @@ __syscall int i2s_buf_read(const struct device *dev, void *buf, size_t *size);
  * (as defined by i2s_configure). This function takes ownership of the memory
  * block and will release it when all data are transmitted.
  *
+ * The memory block is queued by reference, so a block filled by another
+ * driver, e.g. a receive buffer of the USB Audio Class 2 device allocated from
+ * tx_mem_slab, can be written as is, without copying the audio data.
+ *
  * If there are no free slots in the TX queue the function will block waiting
  * for the next TX memory block to be send and removed from the queue. This
  * operation can timeout as defined by i2s_configure. If the timeout value is
@@ -18,19 +18,22 @@ extern "C" {
 
 #include <zephyr/kernel.h>
 
-/* @brief RX buffer structure which holds the buffer and its state. */
+/* @brief RX buffer structure which holds the buffer and its state.
+ *
+ * Structure is packed as buffers are not aligned within the provided space.
+ */
 struct uart_async_rx_buf {
 	/* Write index which is incremented whenever new data is reported to be
 	 * received to that buffer.
 	 */
-	uint8_t wr_idx:7;
+	uint16_t wr_idx:15;
 
 	/* Set to one if buffer is released by the driver. */
-	uint8_t completed:1;
+	uint16_t completed:1;
 
 	/* Location which is passed to the UART driver. */
 	uint8_t buffer[];
-};
+} __packed;
 
 /** @brief UART asynchronous RX helper structure. */
 struct uart_async_rx {
@@ -44,7 +47,7 @@ struct uart_async_rx {
 	atomic_t free_buf_cnt;
 
 	/* Single buffer size. */
-	uint8_t buf_len;
+	uint16_t buf_len;
 
 	/* Index of the next buffer to be provided to the driver. */
 	uint8_t drv_buf_idx;
@@ -55,7 +58,7 @@ struct uart_async_rx {
 	/* Current read index in the buffer from which data is being consumed.
 	 * Read index which is incremented whenever data is consumed from the buffer.
 	 */
-	uint8_t rd_idx;
+	uint16_t rd_idx;
 };
 
 /** @brief UART asynchronous RX helper configuration structure. */
@@ -66,7 +69,10 @@ struct uart_async_rx_config {
 	/* Buffer length. */
 	size_t length;
 
-	/* Number of buffers into provided space shall be split. */
+	/* Number of buffers into provided space shall be split. Buffers can
+	 * hold up to 32767 bytes each, large buffers let continuous reception
+	 * at high baudrates be handled with few driver events.
+	 */
 	uint8_t buf_cnt;
 };
 
@@ -76,7 +82,7 @@ struct uart_async_rx_config {
  *
  * @return Buffer length.
  */
-static inline uint8_t uart_async_rx_get_buf_len(struct uart_async_rx *async_rx)
+static inline uint16_t uart_async_rx_get_buf_len(struct uart_async_rx *async_rx)
 {
 	return async_rx->buf_len;
 }
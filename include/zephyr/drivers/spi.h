@@ -1066,9 +1066,24 @@ __deprecated static inline int spi_write_async(const struct device *dev,
 
 #if defined(CONFIG_SPI_RTIO) || defined(__DOXYGEN__)
 
+/**
+ * @brief Execute the submissions to a SPI device without native RTIO support
+ *
+ * The transaction is handed to the RTIO work pool, which performs it with
+ * blocking calls to spi_transceive().
+ *
+ * @param dev SPI device
+ * @param iodev_sqe Prepared submissions queue entry
+ */
+void spi_rtio_iodev_default_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+
 /**
  * @brief Submit a SPI device with a request
  *
+ * If the driver does not support RTIO the request is executed by the RTIO
+ * work pool when CONFIG_RTIO_WORKQ is enabled, and completes with -ENOSYS
+ * otherwise.
+ *
  * @param iodev_sqe Prepared submissions queue entry connected to an iodev
  *                  defined by SPI_IODEV_DEFINE.
  *                  Must live as long as the request is in flight.
@@ -1079,6 +1094,15 @@ static inline void spi_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 	const struct device *dev = dt_spec->bus;
 	const struct spi_driver_api *api = (const struct spi_driver_api *)dev->api;
 
+	if (api->iodev_submit == NULL) {
+#ifdef CONFIG_RTIO_WORKQ
+		spi_rtio_iodev_default_submit(dev, iodev_sqe);
+#else
+		rtio_iodev_sqe_err(iodev_sqe, -ENOSYS);
+#endif /* CONFIG_RTIO_WORKQ */
+		return;
+	}
+
 	api->iodev_submit(dt_spec->bus, iodev_sqe);
 }
 
@@ -435,7 +435,9 @@ void uhc_xfer_buf_free(const struct device *dev, struct net_buf *const buf);
  * @brief Queue USB host controller transfer
  *
  * Add transfer to the queue. If the queue is empty, the transfer
- * can be claimed by the controller immediately.
+ * can be claimed by the controller immediately. Several transfers
+ * can be queued, the controller starts them in the order they were
+ * queued, control transfers before the others.
  *
  * @param[in] dev    Pointer to device struct of the driver instance
  * @param[in] xfer   Pointer to UHC transfer
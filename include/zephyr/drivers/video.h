@@ -560,9 +560,21 @@ static inline int video_set_signal(const struct device *dev,
 	return api->set_signal(dev, ep, signal);
 }
 
+/**
+ * @brief Allocate aligned video buffer.
+ *
+ * @param size Size of the video buffer.
+ * @param align Alignment of the requested video buffer, a power of two.
+ *
+ * @retval pointer to allocated video buffer
+ */
+struct video_buffer *video_buffer_aligned_alloc(size_t size, size_t align);
+
 /**
  * @brief Allocate video buffer.
  *
+ * The buffer is aligned on @kconfig{CONFIG_VIDEO_BUFFER_POOL_ALIGN}.
+ *
  * @param size Size of the video buffer.
  *
  * @retval pointer to allocated video buffer
@@ -79,6 +79,45 @@ struct fcb_entry_ctx {
 	/**< Flash area where the entry is placed */
 };
 
+struct fcb;
+
+#if defined(CONFIG_FCB_SECTOR_SUMMARY) || defined(__DOXYGEN__)
+/**
+ * @brief Summary of the elements of an FCB sector, kept in RAM.
+ *
+ * Built by @ref fcb_init and kept up to date on append and rotate, so that
+ * walks skip the sectors without elements, do not read past the last
+ * element, and @ref fcb_getnext_key skips the sectors without a given key.
+ */
+struct fcb_sector_summary {
+	uint16_t fs_count; /**< Number of valid elements */
+
+	uint32_t fs_first_off;
+	/**< Offset of the first valid element, if any */
+
+	uint32_t fs_end_off;
+	/**< Offset past the last element, where the next one is written */
+
+	uint32_t fs_bloom[CONFIG_FCB_SECTOR_SUMMARY_BLOOM_WORDS];
+	/**< Bloom filter of the key hashes of the elements */
+};
+#endif /* CONFIG_FCB_SECTOR_SUMMARY */
+
+/**
+ * @brief Key hash callback.
+ *
+ * Gives the hash of the key of an element, for the Bloom filter of the
+ * sector summaries.
+ *
+ * @param[in] fcb FCB instance structure.
+ * @param[in] loc Location of the element.
+ * @param[out] hash Hash of the key of the element.
+ *
+ * @return 0 on success, negative errno code if the element has no key.
+ */
+typedef int (*fcb_key_hash_cb)(struct fcb *fcb, const struct fcb_entry *loc,
+			       uint32_t *hash);
+
 /**
  * @brief Flag to disable CRC for the fcb_entries in flash.
  */
@@ -112,6 +151,14 @@ struct fcb {
 	struct flash_sector *f_sectors;
 	/**< Array of sectors, must be contiguous */
 
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	struct fcb_sector_summary *f_summary;
+	/**< Array of f_sector_cnt summaries of the sectors, or NULL */
+
+	fcb_key_hash_cb f_key_hash;
+	/**< Key hash of elements, for @ref fcb_getnext_key, or NULL */
+#endif
+
 	/* Flash circular buffer internal state */
 	struct k_mutex f_mtx;
 	/**< Locking for accessing the FCB data, internal state */
@@ -244,6 +291,24 @@ int fcb_walk(struct fcb *fcb, struct flash_sector *sector, fcb_walk_cb cb,
  */
 int fcb_getnext(struct fcb *fcb, struct fcb_entry *loc);
 
+/**
+ * Get next fcb entry location that can have the given key.
+ *
+ * Same as @ref fcb_getnext, but sectors whose summary shows that none of
+ * their elements has the key are skipped without being read. The key of the
+ * entry has still to be checked, as the summaries can give false positives.
+ *
+ * Without CONFIG_FCB_SECTOR_SUMMARY, or if the FCB has no summaries or no key
+ * hash callback, no sector is skipped.
+ *
+ * @param[in] fcb FCB instance structure.
+ * @param[in,out] loc entry location information
+ * @param[in] key_hash hash of the key, as given by the key hash callback
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int fcb_getnext_key(struct fcb *fcb, struct fcb_entry *loc, uint32_t key_hash);
+
 /**
  * Rotate fcb sectors
  *
@@ -61,6 +61,9 @@ enum {
 	/** Identifier for in-tree Ext2 file system. */
 	FS_EXT2,
 
+	/** Identifier for in-tree read-only image file system. */
+	FS_IMGFS,
+
 	/** Base identifier for external file systems. */
 	FS_TYPE_EXTERNAL_BASE,
 };
@@ -236,6 +239,9 @@ static inline void fs_file_t_init(struct fs_file_t *zfp)
 	zfp->filep = NULL;
 	zfp->mp = NULL;
 	zfp->flags = 0;
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	zfp->buffer = (struct fs_file_buffer){ 0 };
+#endif
 }
 
 /**
@@ -459,6 +465,60 @@ int fs_truncate(struct fs_file_t *zfp, off_t length);
  */
 int fs_sync(struct fs_file_t *zfp);
 
+/**
+ * @brief Read file data in place when possible
+ *
+ * Reads up to @p size bytes at the file position, like fs_read(), but when the
+ * file system and the storage allow it, @p ptr is set to the data in the
+ * memory-mapped storage, and nothing is copied. Otherwise, the data is read
+ * into @p buf, and @p ptr is set to @p buf. Fewer bytes than asked can be
+ * read in place, when the rest of the data is not contiguous in storage.
+ *
+ * Data read in place is only valid until the file or the file system is
+ * written to. Requires CONFIG_FILE_SYSTEM_READ_DIRECT.
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Set to the data read
+ * @param buf Buffer to read into when the data can not be read in place, or
+ *	      NULL to only read in place
+ * @param size Maximum number of bytes to read
+ *
+ * @retval >=0 a number of bytes read, on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -ENOTSUP when @p buf is NULL and the data can not be read in place;
+ * @retval <0 an other negative errno code on error.
+ */
+ssize_t fs_read_direct(struct fs_file_t *zfp, const void **ptr, void *buf, size_t size);
+
+/**
+ * @brief Set the buffer of an open file
+ *
+ * Once a file has a buffer, small reads are served from data read ahead into
+ * the buffer, which grows from the size of the read up to the size of the
+ * buffer as long as the reads are sequential, and small writes are gathered
+ * into writes of the size of the buffer. Written data reaches the file system
+ * when the buffer is full, or on fs_seek(), fs_truncate(), fs_read(),
+ * fs_sync() or fs_close(). An error writing it is returned by that call.
+ * Reads and writes of at least the size of the buffer go to the file system
+ * directly.
+ *
+ * The buffer is used until the file is closed, or until the function is
+ * called again. Requires CONFIG_FILE_SYSTEM_BUFFERED, and a file system that
+ * implements seek and tell.
+ *
+ * @param zfp Pointer to the file object
+ * @param buf Buffer, or NULL to stop buffering the file
+ * @param size Size of the buffer, 0 if @p buf is NULL
+ *
+ * @retval 0 on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -EINVAL when only one of @p buf and @p size is 0;
+ * @retval -ENOTSUP when seek or tell is not implemented by the file system;
+ * @retval <0 an other negative errno code, returned by writing the data of
+ *	   the previous buffer.
+ */
+int fs_setbuf(struct fs_file_t *zfp, void *buf, size_t size);
+
 /**
  * @brief Directory create
  *
@@ -7,6 +7,8 @@
 #ifndef ZEPHYR_INCLUDE_FS_FS_INTERFACE_H_
 #define ZEPHYR_INCLUDE_FS_FS_INTERFACE_H_
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -37,6 +39,10 @@ extern "C" {
 #define MAX_FILE_NAME 256
 #endif
 
+#if !defined(MAX_FILE_NAME) && defined(CONFIG_FILE_SYSTEM_IMGFS)
+#define MAX_FILE_NAME 255
+#endif
+
 #if !defined(MAX_FILE_NAME) /* filesystem selection */
 /* Use standard 8.3 when no filesystem is explicitly selected */
 #define MAX_FILE_NAME 12
@@ -55,6 +61,29 @@ struct fs_mount_t;
  * @{
  */
 
+#if defined(CONFIG_FILE_SYSTEM_BUFFERED) || defined(__DOXYGEN__)
+/**
+ * @brief Buffer of an open file, set with fs_setbuf()
+ *
+ * The buffer holds either data read ahead of the file position, or data
+ * written and not yet passed to the file system.
+ */
+struct fs_file_buffer {
+	/** Buffer, NULL if the file is not buffered */
+	uint8_t *data;
+	/** Size of the buffer */
+	size_t size;
+	/** Number of bytes in the buffer */
+	size_t len;
+	/** Number of bytes read from the buffer */
+	size_t pos;
+	/** Number of bytes to read ahead next time */
+	size_t ahead;
+	/** Whether the bytes in the buffer are written data */
+	bool dirty;
+};
+#endif
+
 /**
  * @brief File object representing an open file
  *
@@ -67,6 +96,10 @@ struct fs_file_t {
 	const struct fs_mount_t *mp;
 	/** Open/create flags */
 	fs_mode_t flags;
+#if defined(CONFIG_FILE_SYSTEM_BUFFERED) || defined(__DOXYGEN__)
+	/** Buffer of the file */
+	struct fs_file_buffer buffer;
+#endif
 };
 
 /**
@@ -0,0 +1,99 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_FS_FS_RTIO_H_
+#define ZEPHYR_INCLUDE_FS_FS_RTIO_H_
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup file_system_api
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+struct fs_rtio_iodev_data {
+	struct fs_file_t *file;
+	struct k_mutex lock;
+};
+
+extern const struct rtio_iodev_api fs_rtio_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Define an RTIO iodev performing I/O on a file
+ *
+ * RTIO_OP_RX submissions to the iodev read data with fs_read(), and
+ * RTIO_OP_TX and RTIO_OP_TINY_TX submissions write data with fs_write(), at
+ * the file position. The result of a completion is the number of bytes read
+ * or written. The submissions of a transaction are performed without any
+ * other submission to the file in between, and a submission prepared with
+ * fs_rtio_prep_seek() sets the position for the ones following it.
+ *
+ * A read from the memory pool of the RTIO context reads up to one block. A
+ * read marked RTIO_SQE_MULTISHOT keeps reading until canceled. It completes
+ * once with an error and is not submitted again when reading fails, with
+ * -ENODATA at the end of the file.
+ *
+ * The operations are performed by the RTIO work pool. The file is set with
+ * fs_rtio_iodev_set().
+ *
+ * @param name Symbolic name of the iodev
+ */
+#define FS_RTIO_IODEV_DEFINE(name)                                                                 \
+	static struct fs_rtio_iodev_data _fs_rtio_data_##name = {                                  \
+		.lock = Z_MUTEX_INITIALIZER(_fs_rtio_data_##name.lock),                            \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &fs_rtio_iodev_api, &_fs_rtio_data_##name)
+
+/**
+ * @brief Set the file of an iodev defined with FS_RTIO_IODEV_DEFINE()
+ *
+ * Must not be called while submissions to the iodev are in flight.
+ *
+ * @param iodev File iodev
+ * @param zfp Open file, or NULL to have the submissions fail with -EBADF
+ */
+static inline void fs_rtio_iodev_set(struct rtio_iodev *iodev, struct fs_file_t *zfp)
+{
+	struct fs_rtio_iodev_data *data = iodev->data;
+
+	data->file = zfp;
+}
+
+/**
+ * @brief Prepare a submission setting the position of the file of an iodev
+ *
+ * @param sqe Submission to prepare
+ * @param iodev File iodev
+ * @param offset Offset from the start of the file
+ * @param userdata Data returned with the completion
+ */
+static inline void fs_rtio_prep_seek(struct rtio_sqe *sqe, const struct rtio_iodev *iodev,
+				     uint32_t offset, void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_FS_SEEK;
+	sqe->iodev = iodev;
+	sqe->fs_offset = offset;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_FS_FS_RTIO_H_ */
@@ -91,6 +91,20 @@ struct fs_file_system_t {
 	 * @return 0 on success, negative errno code on fail.
 	 */
 	int (*close)(struct fs_file_t *filp);
+#if defined(CONFIG_FILE_SYSTEM_READ_DIRECT) || defined(__DOXYGEN__)
+	/**
+	 * Reads data in place, from memory-mapped storage.
+	 * Available only if @kconfig{CONFIG_FILE_SYSTEM_READ_DIRECT} is enabled.
+	 *
+	 * @param filp File to read from.
+	 * @param ptr Set to the data at the position of the file.
+	 * @param nbytes Maximum number of bytes to read.
+	 * @return Number of bytes read, which can be less than nbytes when the
+	 *	   data is not contiguous, -EAGAIN if the data at the position can
+	 *	   not be read in place, or other negative errno code on fail.
+	 */
+	ssize_t (*read_direct)(struct fs_file_t *filp, const void **ptr, size_t nbytes);
+#endif
 	/** @} */
 
 	/**
@@ -62,6 +62,22 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if defined(CONFIG_NVS_LOOKUP_INDEX) || defined(__DOXYGEN__)
+	/** Ids of the lookup index slots, 0xFFFF for an unused slot */
+	uint16_t lookup_index_id[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+	/** Address of the most recent allocation table entry of each id */
+	uint32_t lookup_index_addr[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+	/** The lookup index was too small to hold all ids */
+	bool lookup_index_incomplete;
+#endif
+#if defined(CONFIG_NVS_GC_INCREMENTAL) || defined(__DOXYGEN__)
+	/** Next allocation table entry to move out of the oldest sector */
+	uint32_t gc_addr;
+	/** Oldest sector, that the incremental garbage collection works on */
+	uint16_t gc_sector;
+	/** Incremental garbage collection state of the oldest sector */
+	uint8_t gc_state;
+#endif
 };
 
 /**
@@ -164,6 +180,25 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+#if defined(CONFIG_NVS_GC_INCREMENTAL) || defined(__DOXYGEN__)
+/**
+ * @brief Run a step of garbage collection ahead of time.
+ *
+ * Moves up to @p max_entries entries out of the oldest sector, or erases it once it holds no
+ * valid data, so that the garbage collection done when the write sector gets full has little
+ * or nothing left to do. Meant to be called when the system is idle, e.g. from a work item,
+ * while CONFIG_NVS_GC_INCREMENTAL_WRITE_STEP does the same at the end of each write.
+ * The oldest sector is only erased ahead of time when there are more than 3 sectors.
+ * @param fs Pointer to file system
+ * @param max_entries Maximum number of allocation table entries to look at
+ * @retval 0 Nothing left to do until the write sector gets full
+ * @retval 1 More steps are needed
+ * @retval -ENOTSUP if the file system has only 2 sectors
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs, size_t max_entries);
+#endif
+
 /**
  * @}
  */
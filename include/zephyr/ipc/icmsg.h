@@ -54,6 +54,24 @@ struct icmsg_data_t {
 	struct k_work_delayable notify_work;
 	struct k_work mbox_work;
 	atomic_t state;
+
+	/* Nocopy */
+	atomic_t tx_claimed;
+	atomic_t rx_held;
+	const void *rx_buffer;
+	const void *rx_held_buffer;
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_SIGNAL_COALESCE
+	/* Delayed signal to the remote */
+	struct k_work_delayable signal_work;
+	atomic_t signal_pending;
+#endif
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+	/* Polled receive */
+	struct k_work_delayable poll_work;
+	bool rx_polling;
+	uint16_t rx_poll_idle;
+#endif
 };
 
 /** @brief Open an icmsg instance
@@ -123,6 +141,103 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	       struct icmsg_data_t *dev_data,
 	       const void *msg, size_t len);
 
+/** @brief Get a TX buffer in shared memory to send a message without copy.
+ *
+ *  The buffer is the room in the shared memory where the next message goes,
+ *  up to its end. While the buffer is claimed, the other sends wait for it
+ *  or fail. The buffer is sent with @ref icmsg_send_nocopy or dropped with
+ *  @ref icmsg_drop_tx_buffer, from the same thread when
+ *  CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC is enabled.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[out] data Pointer to the TX buffer.
+ *  @param[inout] len Size required, set to the size of the buffer.
+ *
+ *  @retval 0 on success.
+ *  @retval -EBUSY when the instance has not finished handshake with the remote
+ *                 instance.
+ *  @retval -EALREADY when a buffer is already claimed.
+ *  @retval -ENOBUFS when the shared memory could not be accessed.
+ *  @retval -ENOMEM when the required size is bigger than the room, @p len
+ *                  holds the size available. The rest of the shared memory
+ *                  is only reachable by @ref icmsg_send, which wraps the
+ *                  message around its end.
+ */
+int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
+			struct icmsg_data_t *dev_data,
+			void **data, uint32_t *len);
+
+/** @brief Drop the TX buffer got with @ref icmsg_get_tx_buffer.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY when no buffer is claimed.
+ */
+int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data);
+
+/** @brief Send the message written in the TX buffer got with
+ *         @ref icmsg_get_tx_buffer.
+ *
+ *  The buffer is given back, also on failure.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] len Size of the message.
+ *
+ *  @retval bytes number of bytes sent.
+ *  @retval -EINVAL when no buffer is claimed.
+ *  @retval -ENODATA when the message is empty.
+ *  @retval -EBADMSG when the message is bigger than the buffer.
+ *  @retval other errno codes from dependent modules.
+ */
+int icmsg_send_nocopy(const struct icmsg_config_t *conf,
+		      struct icmsg_data_t *dev_data, size_t len);
+
+/** @brief Hold the message given to the received callback.
+ *
+ *  The message stays in shared memory, unavailable to the remote, and the
+ *  next messages are not processed until it is released with
+ *  @ref icmsg_release_rx_buffer. A message wrapping around the end of the
+ *  shared memory is given from a copy and can not be held.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] data Message data given to the received callback.
+ *
+ *  @retval 0 on success.
+ *  @retval -EINVAL when @p data is not a message received in shared memory,
+ *                  or the call is not made from the received callback.
+ *  @retval -EALREADY when the message is already held.
+ */
+int icmsg_hold_rx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data, const void *data);
+
+/** @brief Release the message held with @ref icmsg_hold_rx_buffer.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] data Message data held.
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY when @p data is not held.
+ */
+int icmsg_release_rx_buffer(const struct icmsg_config_t *conf,
+			    struct icmsg_data_t *dev_data, const void *data);
+
 /**
  * @}
  */
@@ -201,6 +201,78 @@ int pbuf_write(struct pbuf *pb, const char *buf, uint16_t len);
  */
 int pbuf_read(struct pbuf *pb, char *buf, uint16_t len);
 
+/**
+ * @brief Get room in the packet buffer to write a packet in place.
+ *
+ * The room is contiguous, so it ends at the end of the shared memory even
+ * if more space is free from its beginning. Write the data to @p buf and
+ * call @ref pbuf_write_commit to make the packet visible to the reader.
+ * Nothing is reserved, so there must be no other write in between.
+ *
+ * @param pb	A buffer to which to write.
+ * @param buf	Set to the location where to write the packet data.
+ * @param len	Number of bytes required. Set to the number of bytes
+ *		available, also when the call fails with -ENOMEM.
+ * @retval 0	on success.
+ * @retval -EINVAL, if any of input parameter is incorrect.
+ * @retval -ENOMEM, if len is bigger than the room.
+ */
+int pbuf_write_alloc(struct pbuf *pb, char **buf, uint16_t *len);
+
+/**
+ * @brief Write a packet got from @ref pbuf_write_alloc.
+ *
+ * @param pb	A buffer to which to write.
+ * @param len	Number of bytes written in place. Must be positive.
+ * @retval int	Number of bytes written, negative error code on fail.
+ *		-EINVAL, if any of input parameter is incorrect.
+ *		-ENOMEM, if len is bigger than the room.
+ */
+int pbuf_write_commit(struct pbuf *pb, uint16_t len);
+
+/**
+ * @brief Get the next packet without copying it.
+ *
+ * The packet stays in the buffer, and the writer does not overwrite it,
+ * until @ref pbuf_read_release is called.
+ *
+ * @param pb	A buffer from which data will be read.
+ * @param buf	Set to the packet data, or to NULL if the packet wraps around
+ *		the end of the shared memory. Such a packet must be read with
+ *		@ref pbuf_read.
+ * @retval int	Length of the packet, 0 if there is none, negative error
+ *		code on fail.
+ *		-EINVAL, if any of input parameter is incorrect.
+ *		-EAGAIN, if not whole message is ready yet.
+ */
+int pbuf_read_peek(struct pbuf *pb, const char **buf);
+
+/**
+ * @brief Drop the packet got from @ref pbuf_read_peek.
+ *
+ * @param pb	A buffer from which data was read.
+ * @retval int	Length of the packet, negative error code on fail.
+ *		-EINVAL, if any of input parameter is incorrect.
+ *		-ENODATA, if the buffer is empty.
+ *		-EAGAIN, if not whole message is ready yet.
+ */
+int pbuf_read_release(struct pbuf *pb);
+
+/**
+ * @brief Check the position of the reader of the packet buffer.
+ *
+ * Tells the writer whether the reader has read all the packets written before
+ * the write index @p idx, and no more. Called after a write with the write
+ * index from before it, it tells whether the buffer was empty. As both the
+ * indexes are updated before they are checked, either the writer sees the
+ * buffer empty or the reader sees the new packet.
+ *
+ * @param pb	A buffer to which data was written.
+ * @param idx	Write index, pb->data.wr_idx at some point.
+ * @retval true if the read index is @p idx.
+ */
+bool pbuf_reader_at(struct pbuf *pb, uint32_t idx);
+
 /**
  * @}
  */
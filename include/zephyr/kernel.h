@@ -22,6 +22,7 @@
 #include <zephyr/tracing/tracing_macros.h>
 #include <zephyr/sys/mem_stats.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/time_page.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -1056,6 +1057,34 @@ void k_sched_time_slice_set(int32_t slice, int prio);
 void k_thread_time_slice_set(struct k_thread *th, int32_t slice_ticks,
 			     k_thread_timeslice_fn_t expired, void *data);
 
+/**
+ * @brief Set the sporadic server CPU budget of a thread
+ *
+ * When CONFIG_SCHED_SPORADIC=y, this gives @a th a budget of CPU time per
+ * replenishment period. The CPU time used by the thread from the moment it
+ * runs with its budget replenished, its activation, is replenished one period
+ * after the activation. A thread using up its budget is throttled: it runs at
+ * @a low_prio until the replenishment, then gets its priority back. Its CPU
+ * bandwidth at its own priority is thus bounded by budget / period, whatever
+ * that priority.
+ *
+ * A priority set with k_thread_priority_set() while the thread is throttled
+ * is the one restored at the replenishment.
+ *
+ * @note The budget is accounted in ticks, on context switches and timer
+ * interrupts.
+ *
+ * @param th A valid, initialized thread
+ * @param budget_ticks CPU budget per period, in ticks, or 0 for no budget
+ * @param period_ticks Replenishment period, in ticks
+ * @param low_prio Priority of the thread once its budget is exhausted
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the budget exceeds the period, or @a low_prio is invalid
+ */
+int k_thread_sporadic_set(struct k_thread *th, int32_t budget_ticks,
+			  int32_t period_ticks, int low_prio);
+
 /** @} */
 
 /**
@@ -1713,6 +1742,35 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
 	return timer->user_data;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+
+/**
+ * @brief Set the slack of a timer.
+ *
+ * The expirations of the timer may be delayed by up to @a slack, so that
+ * they coincide with the expirations of other timeouts and are processed
+ * on a single system timer interrupt. The period of a periodic timer is
+ * kept regardless: each expiration is delayed from its nominal time, not
+ * from the previous delayed expiration.
+ *
+ * The slack applies from the next start of the timer. It is reset by
+ * k_timer_init().
+ *
+ * @kconfig_dep{CONFIG_TIMEOUT_SLACK}
+ *
+ * @param timer Address of timer.
+ * @param slack Relative slack, or K_NO_WAIT for none.
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+
+static inline void z_impl_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	timer->timeout.slack = (uint32_t)CLAMP(slack.ticks, 0, INT32_MAX);
+}
+
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 /** @} */
 
 /**
@@ -1721,6 +1779,17 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
  * @{
  */
 
+/**
+ * @brief Query system uptime, in system ticks.
+ *
+ * This unconditionally queries the kernel via a system call.
+ *
+ * @note Use k_uptime_ticks() unless absolutely sure this is necessary.
+ *
+ * @return Current uptime in ticks.
+ */
+__syscall int64_t k_uptime_ticks_query(void);
+
 /**
  * @brief Get system uptime, in system ticks.
  *
@@ -1728,9 +1797,20 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
  * ticks (c.f. @kconfig{CONFIG_SYS_CLOCK_TICKS_PER_SEC}), which is the
  * fundamental unit of resolution of kernel timekeeping.
  *
+ * With @kconfig{CONFIG_USERSPACE_TIME_PAGE}, user threads read the uptime
+ * from a page shared with the kernel, without a system call.
+ *
  * @return Current uptime in ticks.
  */
-__syscall int64_t k_uptime_ticks(void);
+static inline int64_t k_uptime_ticks(void)
+{
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+	if (k_is_user_context()) {
+		return z_time_page_read(NULL, NULL);
+	}
+#endif
+	return k_uptime_ticks_query();
+}
 
 /**
  * @brief Get system uptime.
@@ -2882,6 +2962,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -3508,6 +3589,39 @@ int k_work_queue_drain(struct k_work_q *queue, bool plug);
  */
 int k_work_queue_unplug(struct k_work_q *queue);
 
+/** @brief Add a thread to a started work queue.
+ *
+ * Work items submitted to the queue are processed by whichever of its threads
+ * is idle, so that a handler that runs for a long time does not delay the
+ * other items.  A work item is never run by two threads at the same time, and
+ * flush, cancel and drain operations keep their semantics.
+ *
+ * @note Handlers of different work items can run concurrently, so only
+ * items that do not depend on being serialized with each other should be
+ * submitted to a queue with additional threads.
+ *
+ * Requires CONFIG_WORKQUEUE_POOL.
+ *
+ * @param queue pointer to the queue structure, started by
+ *        k_work_queue_start().
+ *
+ * @param worker pointer to the worker structure, which must persist as long
+ *        as the queue.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the the worker thread stack area, in bytes.
+ *
+ * @param prio initial thread priority
+ *
+ * @param cpu CPU the worker thread is pinned to when CONFIG_SCHED_CPU_MASK
+ *        is enabled, or -1 to let it run on any CPU.
+ */
+void k_work_queue_add_worker(struct k_work_q *queue,
+			     struct k_work_q_worker *worker,
+			     k_thread_stack_t *stack, size_t stack_size,
+			     int prio, int cpu);
+
 /** @brief Initialize a delayable work structure.
  *
  * This must be invoked before scheduling a delayable work structure for the
@@ -3524,6 +3638,26 @@ int k_work_queue_unplug(struct k_work_q *queue);
 void k_work_init_delayable(struct k_work_delayable *dwork,
 			   k_work_handler_t handler);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/** @brief Set the slack of a delayable work item.
+ *
+ * The submission of the work item to its queue may be delayed by up to
+ * @a slack after the delay given when scheduling it, so that it coincides
+ * with the expiration of other timeouts and is processed on a single system
+ * timer interrupt. The slack applies from the next time the work item is
+ * scheduled. It is reset by k_work_init_delayable().
+ *
+ * @kconfig_dep{CONFIG_TIMEOUT_SLACK}
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork pointer to the delayable work item.
+ * @param slack relative slack, or K_NO_WAIT for none.
+ */
+static inline void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+					      k_timeout_t slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 /**
  * @brief Get the parent delayable work structure from a work pointer.
  *
@@ -3940,6 +4074,12 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* The work item being flushed, which other threads of the queue must
+	 * not overtake.
+	 */
+	struct k_work *flushed;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4026,6 +4166,26 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* List of k_work_q_worker threads that also animate the work. */
+	sys_slist_t workers;
+
+	/* Number of work items being processed. */
+	uint32_t running;
+#endif
+};
+
+/** @brief An additional thread animating a work queue.
+ *
+ * See k_work_queue_add_worker().
+ */
+struct k_work_q_worker {
+	/* The thread that animates the work. */
+	struct k_thread thread;
+
+	/* Node in the worker list of the queue. */
+	sys_snode_t node;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4059,6 +4219,14 @@ static inline k_ticks_t k_work_delayable_remaining_get(
 	return z_timeout_remaining(&dwork->timeout);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static inline void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+					      k_timeout_t slack)
+{
+	dwork->timeout.slack = (uint32_t)CLAMP(slack.ticks, 0, INT32_MAX);
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue)
 {
 	return &queue->thread;
@@ -4456,6 +4624,8 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_PUT_CLAIMED	BIT(1)
+#define K_MSGQ_FLAG_GET_CLAIMED	BIT(2)
 
 /**
  * @brief Message Queue Attributes
@@ -4566,6 +4736,7 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A slot is claimed by k_msgq_put_claim().
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
@@ -4588,6 +4759,7 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A message is claimed by k_msgq_get_claim().
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
@@ -4625,6 +4797,112 @@ __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
  */
 __syscall int k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx);
 
+/**
+ * @brief Claim the next free slot of a message queue.
+ *
+ * This routine reserves the slot that the next message is stored in, so that
+ * the message can be written in place instead of being copied in by
+ * k_msgq_put(). The message is added to the queue by k_msgq_put_finish().
+ *
+ * Only one slot can be claimed at a time. Until it is finished, k_msgq_put()
+ * and k_msgq_put_n() fail with -EBUSY.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param slot Address of the claimed slot is returned here.
+ *
+ * @retval 0 Slot claimed.
+ * @retval -ENOMSG Returned when the queue is full.
+ * @retval -EBUSY Returned when a slot is already claimed.
+ */
+int k_msgq_put_claim(struct k_msgq *msgq, void **slot);
+
+/**
+ * @brief Finish a slot claimed by k_msgq_put_claim().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param commit True to add the message to the queue, false to discard it.
+ *
+ * @retval 0 Slot finished.
+ * @retval -EINVAL Returned when no slot is claimed.
+ */
+int k_msgq_put_finish(struct k_msgq *msgq, bool commit);
+
+/**
+ * @brief Claim the first message of a message queue.
+ *
+ * This routine gives access to the first message in place instead of copying
+ * it out like k_msgq_get(). The message stays in the queue until it is
+ * released by k_msgq_get_finish().
+ *
+ * Only one message can be claimed at a time. Until it is finished,
+ * k_msgq_get() and k_msgq_get_n() fail with -EBUSY.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param slot Address of the claimed message is returned here.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned when the queue has no message.
+ * @retval -EBUSY Returned when a message is already claimed.
+ */
+int k_msgq_get_claim(struct k_msgq *msgq, void **slot);
+
+/**
+ * @brief Finish a message claimed by k_msgq_get_claim().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param consume True to remove the message from the queue, false to leave
+ *                it as the first message.
+ *
+ * @retval 0 Message finished.
+ * @retval -EINVAL Returned when no message is claimed.
+ */
+int k_msgq_get_finish(struct k_msgq *msgq, bool consume);
+
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data to
+ * message queue @a q, taking the queue lock once. It returns without waiting
+ * when the queue gets full.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the array of messages.
+ * @param num_msgs Number of messages in @a data.
+ *
+ * @return Number of messages sent, or -EBUSY if a slot is claimed by
+ *	   k_msgq_put_claim().
+ */
+__syscall int k_msgq_put_n(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue @a q
+ * into consecutive slots of @a data, taking the queue lock once. It returns
+ * without waiting when the queue gets empty.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the received messages.
+ * @param num_msgs Number of messages that fit in @a data.
+ *
+ * @return Number of messages received, or -EBUSY if a message is claimed by
+ *	   k_msgq_get_claim().
+ */
+__syscall int k_msgq_get_n(struct k_msgq *msgq, void *data, uint32_t num_msgs);
+
 /**
  * @brief Purge a message queue.
  *
@@ -4874,6 +5152,8 @@ struct k_pipe {
  * @cond INTERNAL_HIDDEN
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
+#define K_PIPE_FLAG_PUT_CLAIMED	BIT(1)	/** Free space is being written in place */
+#define K_PIPE_FLAG_GET_CLAIMED	BIT(2)	/** Data is being read in place */
 
 #define Z_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)     \
 	{                                                           \
@@ -4973,7 +5253,7 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  * @retval 0 At least @a min_xfer bytes of data were written.
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
- *                 minus one data bytes were written.
+ *                 minus one data bytes were written. * @retval -EBUSY Free space is claimed by k_pipe_put_claim().
  */
 __syscall int k_pipe_put(struct k_pipe *pipe, const void *data,
 			 size_t bytes_to_write, size_t *bytes_written,
@@ -4996,7 +5276,7 @@ __syscall int k_pipe_put(struct k_pipe *pipe, const void *data,
  * @retval -EINVAL invalid parameters supplied
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
- *                 minus one data bytes were read.
+ *                 minus one data bytes were read. * @retval -EBUSY Data is claimed by k_pipe_get_claim().
  */
 __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
@@ -5047,6 +5327,88 @@ __syscall void k_pipe_flush(struct k_pipe *pipe);
  */
 __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
 
+/**
+ * @brief Claim free space of a pipe's buffer to write data in place.
+ *
+ * This routine returns the contiguous free space that follows the data in
+ * the buffer of @a pipe, so that the caller can produce the data there
+ * instead of copying it with k_pipe_put(). The data is added to the pipe by
+ * k_pipe_put_finish(). The region ends at the end of the buffer, a claim
+ * made there returns less than k_pipe_write_avail().
+ *
+ * Only one region can be claimed at a time. Until it is finished,
+ * k_pipe_put() fails with -EBUSY and waiting writers do not refill the
+ * buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of the claimed region is returned here.
+ * @param size Size of the claimed region (in bytes) is returned here.
+ *
+ * @retval 0 Region claimed.
+ * @retval -ENOMSG Returned when the buffer is full or the pipe has none.
+ * @retval -EBUSY Returned when a region is already claimed.
+ */
+int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size);
+
+/**
+ * @brief Finish a region claimed by k_pipe_put_claim().
+ *
+ * The first @a bytes bytes of the region are added to the pipe and handed to
+ * waiting readers, if any.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes Number of bytes written to the region, or zero to discard it.
+ *
+ * @retval 0 Region finished.
+ * @retval -EINVAL Returned when no region is claimed or @a bytes exceeds it.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t bytes);
+
+/**
+ * @brief Claim data in a pipe's buffer to read it in place.
+ *
+ * This routine returns the contiguous data at the start of the buffer of
+ * @a pipe, so that the caller can consume it there instead of copying it
+ * with k_pipe_get(). The data is removed from the pipe by
+ * k_pipe_get_finish(). Data held by waiting writers is not returned until
+ * it is moved to the buffer.
+ *
+ * Only one region can be claimed at a time. Until it is finished,
+ * k_pipe_get() fails with -EBUSY. Flushing the pipe drops the claim.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of the claimed region is returned here.
+ * @param size Size of the claimed region (in bytes) is returned here.
+ *
+ * @retval 0 Region claimed.
+ * @retval -ENOMSG Returned when the buffer is empty or the pipe has none.
+ * @retval -EBUSY Returned when a region is already claimed.
+ */
+int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size);
+
+/**
+ * @brief Finish a region claimed by k_pipe_get_claim().
+ *
+ * The first @a bytes bytes of the region are removed from the pipe, and the
+ * freed space is refilled from waiting writers, if any.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes Number of bytes consumed, or zero to leave the data in the
+ *              pipe.
+ *
+ * @retval 0 Region finished.
+ * @retval -EINVAL Returned when no region is claimed or @a bytes exceeds it.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t bytes);
+
 /** @} */
 
 /**
@@ -5056,17 +5418,32 @@ __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
 struct k_mem_slab_info {
 	uint32_t num_blocks;
 	size_t   block_size;
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	atomic_t num_used;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_t max_used;
+#endif
+#else
 	uint32_t num_used;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 };
 
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	union {
+		char *free_list;
+		/* ABA tag and index of first free block, see mem_slab.c */
+		atomic_t free_head;
+	};
+#else
 	char *free_list;
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 	struct k_mem_slab_info info;
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
@@ -5222,7 +5599,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	return (uint32_t)atomic_get(&slab->info.num_used);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5237,7 +5618,9 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
 {
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && defined(CONFIG_MEM_SLAB_LOCK_FREE)
+	return (uint32_t)atomic_get(&slab->info.max_used);
+#elif defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
 	return slab->info.max_used;
 #else
 	ARG_UNUSED(slab);
@@ -5257,7 +5640,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5294,12 +5677,27 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
  * @{
  */
 
+#ifdef CONFIG_K_HEAP_MAGAZINE
+/* per-CPU cache of free k_heap blocks, see CONFIG_K_HEAP_MAGAZINE */
+struct k_heap_magazine {
+	void *blocks[CONFIG_K_HEAP_MAGAZINE_CLASSES][CONFIG_K_HEAP_MAGAZINE_DEPTH];
+	uint8_t count[CONFIG_K_HEAP_MAGAZINE_CLASSES];
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	uint32_t hits;
+	uint32_t misses;
+#endif
+};
+#endif
+
 /* kernel synchronized heap struct */
 
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_K_HEAP_MAGAZINE
+	struct k_heap_magazine magazines[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 /**
@@ -5376,10 +5774,43 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 
+#if defined(CONFIG_K_HEAP_MAGAZINE) && defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+/**
+ * @brief k_heap magazine cache statistics
+ */
+struct k_heap_magazine_stats {
+	/** Allocations served from a magazine */
+	uint32_t hits;
+	/** Magazine eligible allocations that had to go to the heap */
+	uint32_t misses;
+	/** Free bytes currently held in magazines by all CPUs */
+	size_t cached_bytes;
+};
+
+/**
+ * @brief Get the magazine cache statistics of a k_heap
+ *
+ * Sums up the per-CPU magazine counters. The values are sampled
+ * without synchronizing with other CPUs and are thus approximate
+ * while the heap is in use.
+ *
+ * @param h Heap to examine
+ * @param stats Statistics to fill in
+ * @return -EINVAL if null pointer was passed, otherwise 0
+ */
+int k_heap_magazine_stats_get(struct k_heap *h,
+			      struct k_heap_magazine_stats *stats);
+#endif /* CONFIG_K_HEAP_MAGAZINE && CONFIG_SYS_HEAP_RUNTIME_STATS */
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+/* Plus the state of the size classes and a word of run bitmap */
+#define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 112 : 92)
+#else
 #define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 56 : 44)
+#endif
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -5826,6 +6257,80 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Persistent set of poll events
+ *
+ * The events of a set stay registered with their objects between the waits
+ * of k_poll_set_wait(), instead of being registered and unregistered by every
+ * call like with k_poll().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct k_poll_event *events;
+
+	/** PRIVATE - DO NOT TOUCH */
+	int num_events;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set and register its events
+ *
+ * The events must have been initialized with k_poll_event_init() and must
+ * not be part of another set or passed to k_poll() until the set is
+ * released with k_poll_set_release().
+ *
+ * @param set The poll set to initialize.
+ * @param events An array of events, which must stay valid while the set is
+ *               in use.
+ * @param num_events The number of events in the array.
+ */
+void k_poll_set_init(struct k_poll_set *set, struct k_poll_event *events,
+		     int num_events);
+
+/**
+ * @brief Wait for events of a poll set to occur
+ *
+ * This routine waits until at least one event of @p set is ready, and
+ * returns pointers to the ready events only, so that the caller does not
+ * have to walk the whole set. The same object availability rules as with
+ * k_poll() apply.
+ *
+ * As with k_poll(), the state field of a returned event stays set, and the
+ * caller has to reset it to K_POLL_STATE_NOT_READY once it has handled the
+ * event. An event whose condition is still met, like a semaphore that still
+ * has a count, is returned again by the next wait.
+ *
+ * Only one thread may wait on a given set at a time.
+ *
+ * @param set The poll set to wait on.
+ * @param ready Filled with pointers to the ready events.
+ * @param max_ready The number of entries in @p ready.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return The number of ready events stored in @p ready, which is more than
+ *         zero.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, k_timeout_t timeout);
+
+/**
+ * @brief Unregister the events of a poll set
+ *
+ * After this call the events can be reused, e.g. in another set or with
+ * k_poll(). No thread may be waiting on the set.
+ *
+ * @param set The poll set to release.
+ */
+void k_poll_set_release(struct k_poll_set *set);
+
 /** @} */
 
 /**
@@ -6068,6 +6573,38 @@ int k_thread_runtime_stats_enable(k_tid_t thread);
  */
 int k_thread_runtime_stats_disable(k_tid_t thread);
 
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(__DOXYGEN__)
+/**
+ * @brief Get the scheduling histograms of a thread
+ *
+ * This routine copies the histograms of the scheduling latency and run
+ * length of the specified thread. They are only gathered while its runtime
+ * statistics are enabled.
+ *
+ * @param thread ID of thread
+ * @param hist Pointer to struct to copy the histograms into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_sched_histogram_get(k_tid_t thread,
+				 struct k_sched_histogram *hist);
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the performance counter events of a thread
+ *
+ * This routine copies the number of events each performance counter
+ * counted while the specified thread ran, see perf_counter_config(). They
+ * are only gathered while its runtime statistics are enabled.
+ *
+ * @param thread ID of thread
+ * @param counts Array to copy the counts into
+ * @param n Number of entries in @p counts
+ * @return -EINVAL if null pointers, otherwise the number of counts copied
+ */
+int k_thread_perf_counters_get(k_tid_t thread, uint64_t *counts, size_t n);
+#endif /* CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS */
+
 /**
  * @brief Enable gathering of system runtime statistics
  *
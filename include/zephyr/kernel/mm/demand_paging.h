@@ -48,6 +48,12 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif /* !CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+		/**
+		 * Number of page faults on pages that were among the last
+		 * CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW ones evicted
+		 */
+		unsigned long			refault;
 	} pagefaults;
 
 	struct {
@@ -10,6 +10,27 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(__DOXYGEN__)
+/**
+ * Histograms of the scheduling of a thread, in cycles.
+ *
+ * Bin 0 counts durations shorter than
+ * 2^CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_SHIFT cycles, and each following
+ * bin counts durations up to twice as long as the previous one. The last
+ * bin also counts all the longer durations.
+ */
+struct k_sched_histogram {
+	/** Time from being made ready to running */
+	uint32_t  wakeup[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BINS];
+
+	/** Time from being preempted, or yielding, to running again */
+	uint32_t  preempt[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BINS];
+
+	/** Time running on a CPU before switching out */
+	uint32_t  run[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BINS];
+};
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 /**
  * Structure used to track internal statistics about both thread
  * and CPU usage.
@@ -27,6 +48,25 @@ struct k_cycle_stats {
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_THREAD_USAGE_HISTOGRAM is selected.
+	 * @{
+	 */
+	struct k_sched_histogram  hist;  /**< Scheduling histograms */
+	uint32_t  ready_stamp;  /**< Cycle the thread became ready */
+	uint32_t  run_stamp;    /**< Cycle the thread was switched in */
+	bool      waiting;      /**< true if ready_stamp is set and not running */
+	bool      running;      /**< true if run_stamp is set */
+	bool      preempted;    /**< true if it became ready by being preempted */
+	/** @} */
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+#if defined(CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS) || defined(__DOXYGEN__)
+	/** Performance counter events, when CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS
+	 * is selected
+	 */
+	uint64_t  perf[CONFIG_PERF_COUNTERS_MAX];
+#endif /* CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS */
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
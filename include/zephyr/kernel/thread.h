@@ -142,6 +142,19 @@ struct _thread_base {
 	void *slice_data;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_SCHED_SPORADIC
+	/* Sporadic server budget and period in ticks, no budget if 0 */
+	int32_t ss_budget;
+	int32_t ss_period;
+	/* Budget left until the replenishment */
+	int32_t ss_budget_left;
+	/* Priority beyond the budget, and the one to restore */
+	int8_t ss_low_prio;
+	int8_t ss_prio;
+	bool ss_throttled;
+	struct _timeout ss_replenish;
+#endif /* CONFIG_SCHED_SPORADIC */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
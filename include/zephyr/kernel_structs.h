@@ -164,7 +164,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -194,6 +194,11 @@ struct _cpu {
 
 	uint32_t usage0;
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS
+	/* Performance counter values at [usage0] */
+	uint32_t perf0[CONFIG_PERF_COUNTERS_MAX];
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	struct k_cycle_stats *usage;
 #endif
@@ -220,7 +225,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -250,8 +255,8 @@ struct z_kernel {
 #endif
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	/* Need to signal an IPI at the next scheduling point */
-	bool pending_ipi;
+	/* Mask of the CPUs that need an IPI at the next scheduling point */
+	atomic_t pending_ipi;
 #endif
 };
 
@@ -312,6 +317,11 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks the expiry may be delayed by, and was delayed by */
+	uint32_t slack;
+	uint32_t slack_delay;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
@@ -217,6 +217,41 @@ static inline char z_log_minimal_level_to_char(int level)
 /*****************************************************************************/
 /****************** Macros for standard logging ******************************/
 /*****************************************************************************/
+/** @internal
+ * @brief Runtime enable flag of a module logging call.
+ *
+ * Flags are updated when the aggregated runtime level of the module changes,
+ * so that a call that is disabled at runtime costs a single load and branch.
+ */
+struct log_call_site {
+	struct log_source_dynamic_data **source;
+	uint8_t level;
+	bool enabled;
+};
+
+#ifdef CONFIG_LOG_CALL_SITES
+/* Unlike STRUCT_SECTION_ITERABLE(), the site is not marked as used. It is
+ * only referenced by the runtime check, so the site of a call that is
+ * compiled out by its constant level check is dropped with the call and
+ * takes no RAM.
+ */
+#define Z_LOG_CALL_SITE_DEFINE(_level, _inst) \
+	COND_CODE_0(_inst, \
+		(static Z_DECL_ALIGN(struct log_call_site) _log_call_site \
+		 __in_section(_log_call_site, static, _log_call_site_) __noasan = { \
+			&__log_current_dynamic_data, _level, false \
+		};), ())
+
+#define Z_LOG_RUNTIME_LEVEL_CHECK(_level, _inst, _filters) \
+	COND_CODE_0(_inst, (_log_call_site.enabled), \
+		    ((_level) <= Z_LOG_RUNTIME_FILTER(_filters)))
+#else
+#define Z_LOG_CALL_SITE_DEFINE(_level, _inst)
+
+#define Z_LOG_RUNTIME_LEVEL_CHECK(_level, _inst, _filters) \
+	((_level) <= Z_LOG_RUNTIME_FILTER(_filters))
+#endif
+
 /** @internal
  * @brief Generic logging macro.
  *
@@ -250,9 +285,11 @@ static inline char z_log_minimal_level_to_char(int level)
 		} \
 	} \
 	\
+	Z_LOG_CALL_SITE_DEFINE(_level, _inst) \
 	bool is_user_context = k_is_user_context(); \
 	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER((_dsource)->filters)) { \
+	    !is_user_context && \
+	    !Z_LOG_RUNTIME_LEVEL_CHECK(_level, _inst, (_dsource)->filters)) { \
 		break; \
 	} \
 	int _mode; \
@@ -325,9 +362,8 @@ static inline char z_log_minimal_level_to_char(int level)
 			break; \
 		} \
 	} \
+	Z_LOG_CALL_SITE_DEFINE(_level, _inst) \
 	bool is_user_context = k_is_user_context(); \
-	uint32_t filters = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
-						(_dsource)->filters : 0;\
 	\
 	if (IS_ENABLED(CONFIG_LOG_MODE_MINIMAL)) { \
 		Z_LOG_TO_PRINTK(_level, "%s", _str); \
@@ -336,7 +372,8 @@ static inline char z_log_minimal_level_to_char(int level)
 		break; \
 	} \
 	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER(filters)) { \
+	    !is_user_context && \
+	    !Z_LOG_RUNTIME_LEVEL_CHECK(_level, _inst, (_dsource)->filters)) { \
 		break; \
 	} \
 	int mode; \
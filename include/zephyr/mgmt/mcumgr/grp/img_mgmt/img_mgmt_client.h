@@ -144,6 +144,11 @@ int img_mgmt_client_upload_init(struct img_mgmt_client *client, size_t image_siz
 /**
  * @brief Upload part of image.
  *
+ * The data is the part of the image from the offset the upload has reached. When the
+ * server reports an offset before it, e.g. because it restarted the upload, the upload
+ * goes back to that offset, which is returned in @p res_buf, and the data from there has
+ * to be given again.
+ *
  * @param client	IMG mgmt client object
  * @param data		Pointer to data.
  * @param length	Length of data
@@ -199,6 +199,61 @@ int modbus_read_input_regs(const int iface,
 			   uint16_t *const reg_buf,
 			   const uint16_t num_regs);
 
+/**
+ * @brief Register read of a batch, see modbus_read_regs_batch()
+ */
+struct modbus_reg_read {
+	/** Modbus unit ID of the server */
+	uint8_t unit_id;
+	/** Read input registers (FC04) if true, holding registers (FC03) otherwise */
+	bool input;
+	/** Register starting address */
+	uint16_t start_addr;
+	/** Quantity of registers to read */
+	uint16_t num_regs;
+	/** Array of at least 'num_regs' entries receiving the register values */
+	uint16_t *reg_buf;
+	/**
+	 * Result of the read, set by modbus_read_regs_batch(): 0 on success,
+	 * a Modbus exception code or a negative error code otherwise.
+	 */
+	int err;
+};
+
+/**
+ * @brief Read a batch of holding or input registers (FC03, FC04)
+ *
+ * Reads of the same kind of registers of the same server that follow each
+ * other in the array and cover contiguous addresses are merged into a single
+ * request, up to the maximum quantity of registers of a response.
+ * Requires CONFIG_MODBUS_CLIENT_BATCH.
+ *
+ * On an interface in raw ADU mode, e.g. Modbus TCP, up to
+ * CONFIG_MODBUS_CLIENT_BATCH_DEPTH requests are sent without waiting for
+ * the response of the previous ones. Each request gets its own transaction
+ * identifier and the responses, which the backend must submit with the
+ * transaction identifier of their request, can come in any order. On a
+ * serial line interface the requests are sent one after the other.
+ *
+ * The function returns when all the reads are complete or have timed out,
+ * the response timeout of the interface applying to each response.
+ *
+ * @note Floating-point registers are not read by this function. With
+ *       CONFIG_MODBUS_FP_EXTENSIONS, a read of holding registers
+ *       at or above the floating-point address fails with -EINVAL.
+ *
+ * @param iface      Modbus interface index
+ * @param reqs       Array of register reads, the result of each one is
+ *                   stored in its 'err' field
+ * @param num_reqs   Number of register reads in the array
+ *
+ * @retval           0 If all the reads were successful
+ * @retval           The result of the first failed read otherwise
+ */
+int modbus_read_regs_batch(const int iface,
+			   struct modbus_reg_read *reqs,
+			   const size_t num_reqs);
+
 /**
  * @brief Write single coil (FC05)
  *
@@ -8,6 +8,7 @@
 #include <zephyr/types.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/serial/uart_async_rx.h>
 #include <zephyr/sys/ring_buffer.h>
 #include <zephyr/sys/atomic.h>
 
@@ -29,10 +30,8 @@ struct modem_backend_uart_isr {
 };
 
 struct modem_backend_uart_async {
-	uint8_t *receive_bufs[2];
-	uint32_t receive_buf_size;
-	struct ring_buf receive_rb;
-	struct k_spinlock receive_rb_lock;
+	struct uart_async_rx rx;
+	struct uart_async_rx_config rx_config;
 	uint8_t *transmit_buf;
 	uint32_t transmit_buf_size;
 	struct k_work rx_disabled_work;
@@ -32,6 +32,7 @@ extern "C" {
 struct net_if;
 struct net_pkt;
 struct device;
+struct npf_rule_list;
 
 struct net_capture_interface_api {
 	/** Cleanup the setup. This will also disable capturing. After this
@@ -177,6 +178,58 @@ static inline int net_capture_disable(const struct device *dev)
 #endif
 }
 
+/**
+ * @brief Set the packet filter of a network packet capture device.
+ *
+ * @details The rules are evaluated on each packet of the captured network
+ *          interface before it is copied. The packet is captured if the
+ *          verdict of the rules is NET_OK and skipped if it is NET_DROP.
+ *          The rules see the packet as it is received from or given to
+ *          the link layer, so the Ethernet and the basic conditions of the
+ *          packet filter are the useful ones.
+ *
+ * @param dev Network capture device
+ * @param rules Rule list, which must stay valid while it is set, or NULL
+ *        to capture all the packets again.
+ *
+ * @return 0 if ok, <0 if the filter could not be set
+ */
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+int net_capture_set_filter(const struct device *dev, struct npf_rule_list *rules);
+#else
+static inline int net_capture_set_filter(const struct device *dev,
+					 struct npf_rule_list *rules)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(rules);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Set the snapshot length of a network packet capture device.
+ *
+ * @details Only the first @p snaplen bytes of each packet are copied and
+ *          sent. The default length is CONFIG_NET_CAPTURE_SNAPLEN.
+ *
+ * @param dev Network capture device
+ * @param snaplen Number of bytes to capture, 0 to capture whole packets.
+ *
+ * @return 0 if ok, <0 if the length could not be set
+ */
+#if defined(CONFIG_NET_CAPTURE)
+int net_capture_set_snaplen(const struct device *dev, size_t snaplen);
+#else
+static inline int net_capture_set_snaplen(const struct device *dev, size_t snaplen)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(snaplen);
+
+	return -ENOTSUP;
+}
+#endif
+
 /** @cond INTERNAL_HIDDEN */
 
 /**
@@ -337,6 +390,9 @@ struct net_capture_info {
 	struct net_if *tunnel_iface;
 	struct sockaddr *peer;
 	struct sockaddr *local;
+	uint32_t captured;
+	uint32_t filtered;
+	uint32_t dropped;
 	bool is_enabled;
 };
 
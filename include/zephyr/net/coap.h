@@ -256,6 +256,10 @@ struct coap_resource {
 	void *user_data;
 	sys_slist_t observers;
 	int age;
+#if defined(CONFIG_COAP_RESOURCE_PATH_HASH) || defined(__DOXYGEN__)
+	/** Hash of the path, computed by the first request lookup */
+	uint32_t path_hash;
+#endif
 };
 
 /**
@@ -90,8 +90,13 @@ struct coap_client_internal_request {
 	struct coap_client_request coap_request;
 	struct coap_packet request;
 	uint8_t request_tag[COAP_TOKEN_MAX_LEN];
+	/* Next request in the token index bucket, -1 for none */
+	int16_t token_next;
+	bool token_indexed;
 };
 
+#define COAP_CLIENT_TOKEN_INDEX_SIZE NHPOT(CONFIG_COAP_CLIENT_MAX_REQUESTS)
+
 struct coap_client {
 	int fd;
 	struct sockaddr address;
@@ -101,6 +106,8 @@ struct coap_client {
 	uint8_t send_buf[MAX_COAP_MSG_LEN];
 	uint8_t recv_buf[MAX_COAP_MSG_LEN];
 	struct coap_client_internal_request requests[CONFIG_COAP_CLIENT_MAX_REQUESTS];
+	/* Requests by the hash of their token */
+	int16_t token_index[COAP_CLIENT_TOKEN_INDEX_SIZE];
 	struct coap_option echo_option;
 	bool send_echo;
 };
@@ -126,6 +133,11 @@ int coap_client_init(struct coap_client *client, const char *info);
  * Once the callback is called with last block set as true, socket can be closed or
  * used for another query.
  *
+ * A GET request with a Block2 option among its extra options asks for that single block:
+ * the callback is called once, with the offset of the block in the resource and
+ * last_block telling if it is the last block of the resource. Up to
+ * CONFIG_COAP_CLIENT_MAX_REQUESTS of these can be in flight to fetch a resource in parallel.
+ *
  * @param client Client instance.
  * @param sock Open socket file descriptor.
  * @param addr the destination address of the request, NULL if socket is already connected.
@@ -196,6 +196,12 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported. The device splits a TCP
+	 * packet with a non-zero net_pkt_gso_size() into segments of that
+	 * payload size, adjusting their IP and TCP headers and checksums.
+	 */
+	ETHERNET_HW_TX_TSO		= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
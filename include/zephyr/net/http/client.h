@@ -324,6 +324,92 @@ struct http_request {
 int http_client_req(int sock, struct http_request *req,
 		    int32_t timeout, void *user_data);
 
+/**
+ * @typedef http_client_connect_cb_t
+ * @brief Callback used when a session needs a connection to the server.
+ *
+ * The callback creates the socket, plain TCP or TLS, and connects it.
+ *
+ * @param user_data User data given to http_client_session_init()
+ *
+ * @return Connected socket id, or <0 if error.
+ */
+typedef int (*http_client_connect_cb_t)(void *user_data);
+
+/**
+ * HTTP client session, reusing a connection to a server for consecutive
+ * requests as long as the server keeps it alive.
+ */
+struct http_client_session {
+	/** Callback used to connect to the server */
+	http_client_connect_cb_t connect;
+
+	/** User data given to the connect callback */
+	void *user_data;
+
+	/** Socket of the connection, -1 if not connected */
+	int sock;
+};
+
+/**
+ * @brief Initialize an HTTP client session. No connection is made until the
+ * first request.
+ *
+ * @param session Session to initialize.
+ * @param connect Callback used to connect to the server.
+ * @param user_data User data given to the connect callback.
+ */
+void http_client_session_init(struct http_client_session *session,
+			      http_client_connect_cb_t connect, void *user_data);
+
+/**
+ * @brief Do a HTTP request in a session, like http_client_req().
+ *
+ * The connection of the previous request is used if it is still open, else
+ * the session connects to the server. An idempotent request that cannot be
+ * sent on a reused connection, because the server closed it meanwhile, is
+ * sent again on a new connection. The connection is closed after an error,
+ * or if the response does not keep it alive.
+ *
+ * @param session Session of the request.
+ * @param req HTTP request information
+ * @param timeout Max timeout to wait for the response in milliseconds.
+ * @param user_data User specified data that is passed to the callback.
+ *
+ * @return <0 if error, >=0 amount of data sent to the server
+ */
+int http_client_session_req(struct http_client_session *session,
+			    struct http_request *req, int32_t timeout,
+			    void *user_data);
+
+/**
+ * @brief Do pipelined HTTP requests in a session.
+ *
+ * All the requests are sent before the responses are waited for, the
+ * responses are then given to the callbacks of the requests in order. Only
+ * idempotent requests should be pipelined. The data received past a response
+ * is moved to the receive buffer of the next request, so the requests should
+ * share their receive buffer.
+ *
+ * @param session Session of the requests.
+ * @param reqs Requests to send, in order.
+ * @param count Number of requests.
+ * @param timeout Max timeout to wait for each response in milliseconds.
+ * @param user_data User specified data that is passed to the callbacks.
+ *
+ * @return <0 if error, >=0 amount of data sent to the server
+ */
+int http_client_session_pipeline(struct http_client_session *session,
+				 struct http_request **reqs, size_t count,
+				 int32_t timeout, void *user_data);
+
+/**
+ * @brief Close the connection of an HTTP client session, if any.
+ *
+ * @param session Session to close.
+ */
+void http_client_session_close(struct http_client_session *session);
+
 #ifdef __cplusplus
 }
 #endif
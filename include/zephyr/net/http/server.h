@@ -0,0 +1,170 @@
+/** @file
+ * @brief HTTP server API
+ *
+ * An API for applications to serve HTTP/1.1 resources
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+#define ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+
+/**
+ * @brief HTTP server API
+ * @defgroup http_server HTTP server API
+ * @ingroup networking
+ * @{
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/net/http/method.h>
+#include <zephyr/net/http/service.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Type of an HTTP resource */
+enum http_resource_type {
+	/** Constant data, normally placed in flash at build time */
+	HTTP_RESOURCE_TYPE_STATIC,
+	/** Data produced at runtime by a callback */
+	HTTP_RESOURCE_TYPE_DYNAMIC,
+};
+
+/**
+ * @brief Common part of the detail of an HTTP resource
+ *
+ * The detail of a resource defined with @ref HTTP_RESOURCE_DEFINE must begin
+ * with this structure.
+ */
+struct http_resource_detail {
+	/** Bitmask of the methods allowed on the resource, e.g. BIT(HTTP_GET) */
+	uint32_t bitmask_of_supported_http_methods;
+	/** Type of the resource */
+	enum http_resource_type type;
+	/** Value of the Content-Encoding header, e.g. "gzip", or NULL */
+	const char *content_encoding;
+	/** Value of the Content-Type header, e.g. "text/html", or NULL */
+	const char *content_type;
+};
+
+/**
+ * @brief Detail of a static HTTP resource
+ *
+ * The data is sent straight from where it is stored, without copying it to a
+ * buffer first. A precompressed resource can be generated at build time with
+ * @code{.cmake}
+ * generate_inc_file_for_target(app src/index.html ${gen_dir}/index.html.gz.inc --gzip)
+ * @endcode
+ * and included in a const array, with @a content_encoding set to "gzip".
+ * The server does not check that the client accepts the encoding.
+ */
+struct http_resource_detail_static {
+	/** Common part, of type @ref HTTP_RESOURCE_TYPE_STATIC */
+	struct http_resource_detail common;
+	/** Content of the resource */
+	const void *static_data;
+	/** Length of the content */
+	size_t static_data_len;
+};
+
+/** Status of the request data given to a dynamic resource */
+enum http_data_status {
+	/** The connection was closed before the end of the request */
+	HTTP_SERVER_DATA_ABORTED = -1,
+	/** More request data follows */
+	HTTP_SERVER_DATA_MORE = 0,
+	/** End of the request */
+	HTTP_SERVER_DATA_FINAL = 1,
+};
+
+/** Client connection of the HTTP server, opaque to the applications */
+struct http_client_ctx;
+
+/**
+ * @brief Callback of a dynamic HTTP resource
+ *
+ * The callback is given the body of the request as it is received, decoded
+ * from the chunked transfer coding if needed. The response is sent with the
+ * chunked transfer coding: the callback writes the next response data to the
+ * @a data_buffer of the resource and returns its length.
+ *
+ * At the end of the request the callback is called with
+ * @ref HTTP_SERVER_DATA_FINAL and no request data, again and again as long as
+ * it returns a positive length. Returning 0 then ends the response. A negative
+ * return value drops the connection.
+ *
+ * All the callbacks run on the thread of the HTTP server, so the buffer of a
+ * resource is never used for two requests at once.
+ *
+ * @param client Client connection, identifies the request.
+ * @param status Status of the request data.
+ * @param data Request body data, NULL if none.
+ * @param len Length of the request body data.
+ * @param user_data User data of the resource.
+ *
+ * @return Length of the response data written to the buffer of the resource,
+ *         or a negative error code.
+ */
+typedef int (*http_resource_dynamic_cb_t)(struct http_client_ctx *client,
+					  enum http_data_status status,
+					  const uint8_t *data, size_t len,
+					  void *user_data);
+
+/** Detail of a dynamic HTTP resource */
+struct http_resource_detail_dynamic {
+	/** Common part, of type @ref HTTP_RESOURCE_TYPE_DYNAMIC */
+	struct http_resource_detail common;
+	/** Callback handling the requests */
+	http_resource_dynamic_cb_t cb;
+	/** Buffer for the response data */
+	uint8_t *data_buffer;
+	/** Length of the buffer */
+	size_t data_buffer_len;
+	/** User data given to the callback */
+	void *user_data;
+};
+
+/**
+ * @brief Start the HTTP server
+ *
+ * Listen on the ports of all the services defined with
+ * @ref HTTP_SERVICE_DEFINE or @ref HTTP_SERVICE_DEFINE_EMPTY. The resources
+ * of the services must have a detail of type
+ * @ref http_resource_detail_static or @ref http_resource_detail_dynamic.
+ *
+ * Connections are kept alive between requests, pipelined requests are
+ * answered in order, and a connection idle for
+ * CONFIG_HTTP_SERVER_CLIENT_INACTIVITY_TIMEOUT seconds is closed.
+ *
+ * @return 0 on success, -EALREADY if the server is running, or a negative
+ *         error code.
+ */
+int http_server_start(void);
+
+/**
+ * @brief Stop the HTTP server
+ *
+ * Close the listening sockets and all the client connections.
+ *
+ * @return 0 on success, -EALREADY if the server is not running.
+ */
+int http_server_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_ */
@@ -170,6 +170,8 @@ struct lwm2m_ctx {
 	sys_slist_t queued_messages;
 #endif
 	sys_slist_t observer;
+	/* Observers with a notification scheduled, in the order of their deadline */
+	sys_slist_t observer_sched;
 	/** @endcond */
 
 	/** A pointer to currently processed request, for internal LwM2M engine
@@ -83,7 +83,8 @@ enum mqtt_evt_type {
 /** @brief MQTT version protocol level. */
 enum mqtt_version {
 	MQTT_VERSION_3_1_0 = 3, /**< Protocol level for 3.1.0. */
-	MQTT_VERSION_3_1_1 = 4  /**< Protocol level for 3.1.1. */
+	MQTT_VERSION_3_1_1 = 4, /**< Protocol level for 3.1.1. */
+	MQTT_VERSION_5_0 = 5    /**< Protocol level for 5.0. */
 };
 
 /** @brief MQTT Quality of Service types. */
@@ -202,6 +203,18 @@ struct mqtt_connack_param {
 	 *  is unable to process a connection request for some reason.
 	 */
 	enum mqtt_conn_return_code return_code;
+
+#if defined(CONFIG_MQTT_VERSION_5_0) || defined(__DOXYGEN__)
+	/** MQTT 5.0 only. Maximum number of QoS 1 and 2 publications the
+	 *  broker processes concurrently.
+	 */
+	uint16_t receive_maximum;
+
+	/** MQTT 5.0 only. Highest topic alias the broker accepts, 0 if it
+	 *  does not accept topic aliases.
+	 */
+	uint16_t topic_alias_maximum;
+#endif
 };
 
 /** @brief Parameters for MQTT publish acknowledgment (PUBACK). */
@@ -483,6 +496,32 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_PUBLISH_INFLIGHT_MAX) && (CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0)
+	/** Internal. Message IDs of the QoS 1 and 2 publications waiting for
+	 *  their PUBACK or PUBCOMP, 0 for a free entry.
+	 */
+	uint16_t inflight[CONFIG_MQTT_PUBLISH_INFLIGHT_MAX];
+#endif
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	/** Internal. Receive Maximum of the broker. */
+	uint16_t receive_maximum;
+
+	/** Internal. Number of topic aliases usable on the connection. */
+	uint16_t topic_alias_maximum;
+
+#if CONFIG_MQTT_TOPIC_ALIAS_MAX > 0
+	/** Internal. Number of topic aliases set up with the broker. */
+	uint16_t topic_alias_count;
+
+	/** Internal. Topics of the aliases, alias N is at index N - 1. */
+	struct {
+		uint16_t size;
+		uint8_t topic[CONFIG_MQTT_TOPIC_ALIAS_TOPIC_SIZE];
+	} topic_aliases[CONFIG_MQTT_TOPIC_ALIAS_MAX];
+#endif
+#endif /* CONFIG_MQTT_VERSION_5_0 */
 };
 
 /**
@@ -602,7 +641,9 @@ int mqtt_client_set_proxy(struct mqtt_client *client,
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  *
  * @note Default protocol revision used for connection request is 3.1.1. Please
- *       set client.protocol_version = MQTT_VERSION_3_1_0 to use protocol 3.1.0.
+ *       set client.protocol_version = MQTT_VERSION_3_1_0 to use protocol 3.1.0,
+ *       or MQTT_VERSION_5_0 with @kconfig{CONFIG_MQTT_VERSION_5_0} set to use
+ *       protocol 5.0.
  * @note
  *       Please modify @kconfig{CONFIG_MQTT_KEEPALIVE} time to override default
  *       of 1 minute.
@@ -617,6 +658,13 @@ int mqtt_connect(struct mqtt_client *client);
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
+ * @note The payload is sent from the buffer of @p param, only the fixed and
+ *       variable headers are encoded in the transmit buffer of the client.
+ * @note With @kconfig{CONFIG_MQTT_PUBLISH_INFLIGHT_MAX} set, a QoS 1 or 2
+ *       publication fails with -EBUSY if its message ID is already in flight
+ *       and it is not a retransmission (dup_flag set), and with -EAGAIN if
+ *       the maximum number of publications is in flight.
+ *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
 int mqtt_publish(struct mqtt_client *client,
@@ -348,9 +348,20 @@ __net_socket struct net_context {
 #if defined(CONFIG_NET_CONTEXT_RECV_PKTINFO)
 		/** Receive network packet information in recvmsg() call */
 		bool recv_pktinfo;
+#endif
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+		/** Maximum number of RX buffers queued to the context,
+		 * 0 if not limited.
+		 */
+		uint16_t rx_quota;
 #endif
 	} options;
 
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+	/** Number of RX buffers held by the packets queued to the context */
+	atomic_t rx_quota_used;
+#endif
+
 	/** Protocol (UDP, TCP or IEEE 802.3 protocol value) */
 	uint16_t proto;
 
@@ -1268,6 +1279,7 @@ enum net_context_option {
 	NET_OPT_MCAST_HOP_LIMIT   = 14,
 	NET_OPT_UNICAST_HOP_LIMIT = 15,
 	NET_OPT_TTL               = 16,
+	NET_OPT_RX_QUOTA          = 17,
 };
 
 /**
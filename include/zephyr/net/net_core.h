@@ -120,6 +120,24 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by a network device driver when a burst of network packets
+ * has been received. Works like net_recv_data() but hands each traffic
+ * class queue all of its packets in one operation.
+ *
+ * @details The packets are linked through their fifo field, i.e. added to
+ * the list with sys_slist_append(pkts, (sys_snode_t *)pkt). On return the
+ * list holds only the packets that could not be accepted; the caller owns
+ * them and needs to unref them.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts List of network packets.
+ *
+ * @return 0 if ok, <0 if error. The error is that of the last rejected
+ * packet.
+ */
+int net_recv_data_list(struct net_if *iface, sys_slist_t *pkts);
+
 /**
  * @brief Send data to network.
  *
@@ -889,6 +889,18 @@ static inline const struct device *net_if_get_device(struct net_if *iface)
  */
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Queue a list of packets to the net interface TX queues
+ *
+ * Packets going to the same traffic class are queued in one operation.
+ * The packets are linked through their fifo field, see
+ * net_recv_data_list(). The list is empty on return.
+ *
+ * @param iface Pointer to a network interface structure
+ * @param pkts List of net packets to queue
+ */
+void net_if_queue_tx_list(struct net_if *iface, sys_slist_t *pkts);
+
 /**
  * @brief Return the IP offload status
  *
@@ -272,6 +272,25 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Payload size of each segment when an outgoing TCP packet is larger
+	 * than the MTU and is to be segmented by L2 or the device, 0 otherwise.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_RX_RSS)
+	/* Flow hash of a received packet, selects the RX queue. Set by
+	 * devices with hardware RSS, 0 if not known yet.
+	 */
+	uint32_t rx_hash;
+#endif /* CONFIG_NET_RX_RSS */
+
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+	/* Number of buffers charged to the RX quota of the context */
+	uint16_t rx_quota_bufs;
+#endif /* CONFIG_NET_CONTEXT_RX_QUOTA */
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 	/* TODO: Evolve this into a union of orthogonal
 	 *       control block declarations if further L2
@@ -922,6 +941,59 @@ static inline void net_pkt_set_cooked_mode(struct net_pkt *pkt, bool value)
 }
 #endif /* CONFIG_NET_CAPTURE_COOKED_MODE */
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_RX_RSS)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+/* Drivers of devices with hardware receive side scaling report the flow
+ * hash computed by the device here, before calling net_recv_data().
+ */
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif /* CONFIG_NET_RX_RSS */
+
 #if defined(CONFIG_NET_VLAN)
 static inline uint16_t net_pkt_vlan_tag(struct net_pkt *pkt)
 {
@@ -107,6 +107,19 @@ bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule);
  */
 bool npf_remove_all_rules(struct npf_rule_list *rules);
 
+/**
+ * @brief Evaluate a rule list on a packet.
+ *
+ * This lets other modules, like the network packet capture, use their
+ * own rule list to sort packets.
+ *
+ * @param rules the affected rule list
+ * @param pkt the packet to evaluate
+ * @return true if the verdict of the rule list is NET_OK, false otherwise.
+ *         An empty rule list gives NET_OK.
+ */
+bool npf_rules_ok(struct npf_rule_list *rules, struct net_pkt *pkt);
+
 /* convenience shortcuts */
 #define npf_insert_send_rule(rule) npf_insert_rule(&npf_send_rules, rule)
 #define npf_insert_recv_rule(rule) npf_insert_rule(&npf_recv_rules, rule)
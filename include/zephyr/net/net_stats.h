@@ -302,6 +302,13 @@ struct net_stats {
 	/** IP layer errors */
 	struct net_stats_ip_errors ip_errors;
 
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+	/** Number of packets dropped because the receiving context had
+	 * used its RX buffer quota.
+	 */
+	net_stats_t rx_quota_drop;
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_IPV6)
 	/** IPv6 statistics */
 	struct net_stats_ip ipv6;
@@ -0,0 +1,105 @@
+/** @file
+ * @brief Time-aware scheduling of the TX traffic classes
+ *
+ * An API to open and close the gates of the TX traffic classes of a network
+ * interface on a cyclic schedule, in the style of IEEE 802.1Qbv scheduled
+ * traffic.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_NET_TX_SCHED_H_
+#define ZEPHYR_INCLUDE_NET_NET_TX_SCHED_H_
+
+/**
+ * @brief Time-aware TX scheduling
+ * @defgroup net_tx_sched Time-aware TX scheduling
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/net/net_if.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** One entry of a gate control list */
+struct net_tx_sched_entry {
+	/** Bit n is set when the gate of TX traffic class n is open */
+	uint8_t gate_mask;
+	/** Duration of the entry in nanoseconds */
+	uint32_t interval;
+};
+
+/**
+ * @brief Gate schedule of a network interface
+ *
+ * The entries of the gate control list follow each other from the base
+ * time, and the list starts over every cycle time. The last entry lasts
+ * until the end of the cycle. All the gates are open before the base time.
+ *
+ * The times are in nanoseconds of the PTP clock of the interface, or of
+ * the system uptime if the interface has no PTP clock, see
+ * net_tx_sched_time().
+ */
+struct net_tx_sched {
+	/** Start of the first cycle */
+	uint64_t base_time;
+	/** Duration of a cycle */
+	uint32_t cycle_time;
+	/** A frame is not started less than this before its gate closes */
+	uint32_t guard_band;
+	/** Number of entries in the gate control list */
+	uint16_t num_entries;
+	/** Gate control list */
+	struct net_tx_sched_entry entries[CONFIG_NET_TX_SCHED_MAX_ENTRIES];
+};
+
+/**
+ * @brief Set or remove the gate schedule of a network interface
+ *
+ * When the device of the interface supports IEEE 802.1Qbv, the schedule is
+ * given to the device. Otherwise the TX thread of each traffic class holds
+ * the packets of the interface until the gate of the class opens.
+ *
+ * With software scheduling, the traffic class queues are shared by all the
+ * interfaces, so a closed gate also holds the packets of other interfaces
+ * queued behind.
+ *
+ * @param iface Network interface
+ * @param sched Schedule, copied, or NULL to open all the gates again.
+ *
+ * @retval 0 The schedule is set.
+ * @retval -EINVAL The schedule has no entry, too many entries, or a zero
+ *                 cycle time.
+ * @retval -ENOMEM No room left for the schedule of another interface, see
+ *                 CONFIG_NET_TX_SCHED_MAX_IFACES.
+ * @retval -EIO The device refused the schedule.
+ */
+int net_tx_sched_set(struct net_if *iface, const struct net_tx_sched *sched);
+
+/**
+ * @brief Get the current time of the clock the schedules of an interface
+ * and the TX times of its packets are expressed in
+ *
+ * @param iface Network interface
+ *
+ * @return Time in nanoseconds, of the PTP clock of the interface if it has
+ *         one, of the system uptime otherwise.
+ */
+uint64_t net_tx_sched_time(struct net_if *iface);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_NET_TX_SCHED_H_ */
@@ -27,6 +27,7 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/net/socket_select.h>
+#include <zephyr/net/socket_epoll.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/fdtable.h>
 #include <stdlib.h>
@@ -240,6 +241,22 @@ struct zsock_pollfd {
  *  will take place in consecutive send()/recv() call.
  */
 #define TLS_DTLS_HANDSHAKE_ON_CONNECT 18
+/** Socket option to control issuing of RFC 5077 session tickets on a TLS
+ *  server socket, so that clients can resume a session without the server
+ *  keeping its state. Requires CONFIG_MBEDTLS_SSL_TICKET_C.
+ *  Effective when set before the handshake. Accepted values:
+ *  - 0 - Disabled.
+ *  - 1 - Enabled.
+ */
+#define TLS_SESSION_TICKET 19
+/** Write-only socket option to rotate the key protecting the session tickets.
+ *  The key is shared by all the TLS server sockets. Tickets issued with the
+ *  previous key are still accepted until it expires. The option accepts
+ *  either no value, to generate a random key, or a byte array holding a
+ *  4 byte key name followed by a 32 byte key, e.g. to share the key between
+ *  servers.
+ */
+#define TLS_SESSION_TICKET_KEY 20
 
 /* Valid values for @ref TLS_PEER_VERIFY option */
 #define TLS_PEER_VERIFY_NONE 0     /**< Peer verification disabled. */
@@ -258,6 +275,10 @@ struct zsock_pollfd {
 #define TLS_SESSION_CACHE_DISABLED 0 /**< Disable TLS session caching. */
 #define TLS_SESSION_CACHE_ENABLED 1 /**< Enable TLS session caching. */
 
+/* Valid values for @ref TLS_SESSION_TICKET option */
+#define TLS_SESSION_TICKET_DISABLED 0 /**< Disable TLS session tickets. */
+#define TLS_SESSION_TICKET_ENABLED 1 /**< Enable TLS session tickets. */
+
 /* Valid values for @ref TLS_DTLS_CID (Connection ID) option */
 #define TLS_DTLS_CID_DISABLED		0 /**< CID is disabled  */
 #define TLS_DTLS_CID_SUPPORTED		1 /**< CID is supported */
@@ -529,6 +550,98 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/** Received data handed out by zsock_recv_zc() */
+struct zsock_zc_buf {
+	/** Network buffer fragment holding the first byte of data */
+	struct net_buf *frag;
+	/** Offset of the first byte of data in @a frag */
+	size_t offset;
+	/** Number of bytes of data, continuing in the fragments after @a frag */
+	size_t len;
+	/** Packet owning the fragments, for zsock_recv_zc_release() */
+	struct net_pkt *pkt;
+};
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * @rst
+ * Dequeue the next received packet of a native TCP or UDP socket and
+ * hand its data to the caller in ``zc``, without copying it. For a
+ * stream socket the data is the not yet read part of the packet, for a
+ * datagram socket it is the whole datagram, whose source address is
+ * stored in ``src_addr`` if it is not NULL. The fragments must not be
+ * modified and are valid until zsock_recv_zc_release() is called.
+ *
+ * The only supported flag is ``ZSOCK_MSG_DONTWAIT``, the receive timeout
+ * of the socket is honored otherwise. Returns the number of bytes in
+ * ``zc``, 0 with ``zc->pkt`` set to NULL on end of stream, or -1 with
+ * errno set on error. Available if
+ * :kconfig:option:`CONFIG_NET_SOCKETS_ZERO_COPY_RECV` is enabled, from
+ * supervisor threads only.
+ * @endrst
+ */
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_buf *zc, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Release data received with zsock_recv_zc()
+ *
+ * @details
+ * Frees the network buffers of @p zc and, for a stream socket, reopens
+ * the receive window by the amount of data that was handed out. Each
+ * successful zsock_recv_zc() must be followed by one release. If the
+ * socket was closed in between, the buffers are still freed and -1 is
+ * returned with errno set to EBADF.
+ *
+ * @param sock Socket the data was received from
+ * @param zc Data returned by zsock_recv_zc(), cleared on return
+ *
+ * @return 0 on success, -1 with errno set on error
+ */
+int zsock_recv_zc_release(int sock, struct zsock_zc_buf *zc);
+
+struct fs_file_t;
+struct flash_area;
+
+/**
+ * @brief Send data from a file
+ *
+ * @details
+ * @rst
+ * Send up to ``count`` bytes of ``file`` on a connected native stream
+ * socket, reading them straight into the socket send buffers. If
+ * ``offset`` is not NULL, the data is read from ``*offset``, which is then
+ * advanced by the number of bytes sent, and the file position is left
+ * unchanged. Otherwise the data is read from, and advances, the file
+ * position. As with zsock_send(), fewer bytes than requested may be
+ * sent. See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/sendfile.2.html>`__ for the
+ * description of the original call. Available if
+ * :kconfig:option:`CONFIG_NET_SOCKETS_SENDFILE` is enabled, from
+ * supervisor threads only.
+ * @endrst
+ */
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count);
+
+/**
+ * @brief Send data from a flash area
+ *
+ * @details
+ * @rst
+ * Send up to ``count`` bytes of the flash area ``fa``, starting at
+ * ``offset``, on a connected native stream socket, reading them straight
+ * into the socket send buffers. ``flags`` and the return value are as
+ * for zsock_send(). Available if
+ * :kconfig:option:`CONFIG_NET_SOCKETS_SENDFILE` is enabled, from
+ * supervisor threads only.
+ * @endrst
+ */
+ssize_t zsock_send_flash(int sock, const struct flash_area *fa, off_t offset,
+			 size_t count, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -955,6 +1068,30 @@ static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 	return zsock_poll(fds, nfds, timeout);
 }
 
+/** POSIX wrapper for @ref zsock_epoll_event */
+#define epoll_event zsock_epoll_event
+/** POSIX wrapper for @ref zsock_epoll_data_t */
+#define epoll_data_t zsock_epoll_data_t
+
+/** POSIX wrapper for @ref zsock_epoll_create */
+static inline int epoll_create(int size)
+{
+	return zsock_epoll_create(size);
+}
+
+/** POSIX wrapper for @ref zsock_epoll_ctl */
+static inline int epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+/** POSIX wrapper for @ref zsock_epoll_wait */
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
 /** POSIX wrapper for @ref zsock_getsockopt */
 static inline int getsockopt(int sock, int level, int optname,
 			     void *optval, socklen_t *optlen)
@@ -1045,6 +1182,25 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 /** POSIX wrapper for @ref ZSOCK_POLLNVAL */
 #define POLLNVAL ZSOCK_POLLNVAL
 
+/** POSIX wrapper for @ref ZSOCK_EPOLL_CTL_ADD */
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+/** POSIX wrapper for @ref ZSOCK_EPOLL_CTL_DEL */
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+/** POSIX wrapper for @ref ZSOCK_EPOLL_CTL_MOD */
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+/** POSIX wrapper for @ref ZSOCK_EPOLLIN */
+#define EPOLLIN ZSOCK_EPOLLIN
+/** POSIX wrapper for @ref ZSOCK_EPOLLPRI */
+#define EPOLLPRI ZSOCK_EPOLLPRI
+/** POSIX wrapper for @ref ZSOCK_EPOLLOUT */
+#define EPOLLOUT ZSOCK_EPOLLOUT
+/** POSIX wrapper for @ref ZSOCK_EPOLLERR */
+#define EPOLLERR ZSOCK_EPOLLERR
+/** POSIX wrapper for @ref ZSOCK_EPOLLHUP */
+#define EPOLLHUP ZSOCK_EPOLLHUP
+/** POSIX wrapper for @ref ZSOCK_EPOLLONESHOT */
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+
 /** POSIX wrapper for @ref ZSOCK_MSG_PEEK */
 #define MSG_PEEK ZSOCK_MSG_PEEK
 /** POSIX wrapper for @ref ZSOCK_MSG_CTRUNC */
@@ -1191,6 +1347,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm name (string, e.g. "cubic") */
+#define TCP_CONGESTION 13
 
 /** @} */
 
@@ -1293,6 +1451,69 @@ struct in6_pktinfo {
 #define IPV6_TCLASS 67
 /** @} */
 
+/**
+ * @name Packet socket level options (SOL_PACKET)
+ * @{
+ */
+/** Protocol level for packet sockets. */
+#define SOL_PACKET 263
+
+/**
+ * Receive the frames of a packet socket in a ring of frame slots, see
+ * @ref tpacket_req. Only available to kernel mode threads.
+ */
+#define PACKET_RX_RING 5
+
+/** The frame slot belongs to the network stack. */
+#define TP_STATUS_KERNEL 0
+/** The frame slot holds a received frame and belongs to the application. */
+#define TP_STATUS_USER BIT(0)
+/** The frame was truncated to the size of the slot. */
+#define TP_STATUS_COPY BIT(1)
+/** Frames were dropped because the ring was full before this one. */
+#define TP_STATUS_LOSING BIT(2)
+
+/**
+ * @brief Header at the start of each frame slot of a packet ring.
+ *
+ * The header is followed by a struct sockaddr_ll describing the source
+ * of the frame, and by the frame data at offset @a tp_mac of the slot.
+ */
+struct tpacket_hdr {
+	/** TP_STATUS_* flags, written last by the stack */
+	uint32_t tp_status;
+	/** Length of the frame */
+	uint32_t tp_len;
+	/** Length of the frame data stored in the slot */
+	uint32_t tp_snaplen;
+	/** Offset of the frame data from the start of the slot */
+	uint16_t tp_mac;
+};
+
+/**
+ * @brief Ring of frame slots for the PACKET_RX_RING option.
+ *
+ * The stack writes each received frame to the next slot, in order, and
+ * sets its status to @ref TP_STATUS_USER. The application reads the slots
+ * in the same order and gives each one back by setting its status to
+ * @ref TP_STATUS_KERNEL. poll() reports POLLIN while the last written
+ * slot has not been given back. When the next slot is still owned by the
+ * application, frames are dropped.
+ *
+ * There is no mmap(), so the application provides the memory of the ring
+ * and must not reuse it until the ring is removed by setting the option
+ * again with @a tp_frame_nr set to 0, or the socket is closed.
+ */
+struct tpacket_req {
+	/** Memory of the ring, @a tp_frame_size times @a tp_frame_nr bytes */
+	void *tp_ring;
+	/** Size of a slot, a multiple of 4 bytes */
+	uint32_t tp_frame_size;
+	/** Number of slots */
+	uint32_t tp_frame_nr;
+};
+/** @} */
+
 /**
  * @name Backlog size for listen()
  * @{
@@ -0,0 +1,117 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** zsock_epoll_ctl: Register a file descriptor */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** zsock_epoll_ctl: Unregister a file descriptor */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** zsock_epoll_ctl: Change the events of a registered file descriptor */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/* ZSOCK_EPOLL* event values are compatible with Linux */
+/** zsock_epoll: Wait for readability */
+#define ZSOCK_EPOLLIN 0x001
+/** zsock_epoll: Wait for exceptional condition */
+#define ZSOCK_EPOLLPRI 0x002
+/** zsock_epoll: Wait for writability */
+#define ZSOCK_EPOLLOUT 0x004
+/** zsock_epoll: Error condition (always reported) */
+#define ZSOCK_EPOLLERR 0x008
+/** zsock_epoll: Closed connection (always reported) */
+#define ZSOCK_EPOLLHUP 0x010
+/** zsock_epoll: Disable the registration after one event is reported */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+
+/** Data returned with a zsock_epoll_event */
+typedef union zsock_epoll_data {
+	void *ptr;    /**< Pointer value */
+	int fd;       /**< File descriptor */
+	uint32_t u32; /**< 32-bit value */
+	uint64_t u64; /**< 64-bit value */
+} zsock_epoll_data_t;
+
+/** Event registration and result for zsock_epoll_ctl() and zsock_epoll_wait() */
+struct zsock_epoll_event {
+	uint32_t events;         /**< ZSOCK_EPOLL* event mask */
+	zsock_epoll_data_t data; /**< User data returned with the event */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/epoll_create.2.html>`__
+ * for normative description. The returned descriptor is closed with
+ * zsock_close(). In Zephyr the instance can only watch sockets, and the
+ * number of registrations is limited by
+ * :kconfig:option:`CONFIG_NET_SOCKETS_EPOLL_MAX_FDS`.
+ * This function is also exposed as ``epoll_create()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_create(int size);
+
+/**
+ * @brief Add, modify or remove a socket in an epoll interest set
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for normative description. Edge-triggered mode is not supported.
+ * A socket that is closed while registered is dropped from the set
+ * the next time it is reported as invalid.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for normative description. Only the sockets that signaled an event
+ * since they were last found idle are checked, in the order they became
+ * ready. When more sockets are ready than ``maxevents``, the reported ones
+ * are queued behind the others, so no socket is starved.
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
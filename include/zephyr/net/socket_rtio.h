@@ -0,0 +1,75 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+struct zsock_rtio_iodev_data {
+	int sock;
+};
+
+extern const struct rtio_iodev_api zsock_rtio_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Define an RTIO iodev performing I/O on a socket
+ *
+ * RTIO_OP_RX submissions to the iodev receive data with zsock_recv(), and
+ * RTIO_OP_TX and RTIO_OP_TINY_TX submissions send data with zsock_send().
+ * The result of a completion is the number of bytes received or sent. A
+ * receive marked RTIO_SQE_MULTISHOT keeps receiving into buffers of the
+ * memory pool of the RTIO context until canceled. It completes once with an
+ * error and is not submitted again when receiving fails, with -ENOTCONN
+ * once the peer has closed a stream connection.
+ *
+ * The operations are performed by the RTIO work pool, so a blocking receive
+ * holds one of its threads until data arrives. The socket is set with
+ * zsock_rtio_iodev_set().
+ *
+ * @param name Symbolic name of the iodev
+ */
+#define ZSOCK_RTIO_IODEV_DEFINE(name)                                                              \
+	static struct zsock_rtio_iodev_data _zsock_rtio_data_##name = {.sock = -1};               \
+	RTIO_IODEV_DEFINE(name, &zsock_rtio_iodev_api, &_zsock_rtio_data_##name)
+
+/**
+ * @brief Set the socket of an iodev defined with ZSOCK_RTIO_IODEV_DEFINE()
+ *
+ * Must not be called while submissions to the iodev are in flight.
+ *
+ * @param iodev Socket iodev
+ * @param sock Socket, or -1 to have the submissions fail with -EBADF
+ */
+static inline void zsock_rtio_iodev_set(struct rtio_iodev *iodev, int sock)
+{
+	struct zsock_rtio_iodev_data *data = iodev->data;
+
+	data->sock = sock;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_ */
@@ -24,6 +24,13 @@
 extern "C" {
 #endif
 
+/**
+ * Number of buckets of the zperf histograms. Bucket 0 counts the values
+ * below 1 us, bucket n the values from 2^(n-1) up to 2^n us, and the last
+ * bucket all the larger values.
+ */
+#define ZPERF_HIST_BUCKETS 16
+
 enum zperf_status {
 	ZPERF_SESSION_STARTED,
 	ZPERF_SESSION_FINISHED,
@@ -35,6 +42,10 @@ struct zperf_upload_params {
 	uint32_t duration_ms;
 	uint32_t rate_kbps;
 	uint16_t packet_size;
+	/** Number of parallel streams, 0 or 1 for a single stream. Each stream
+	 *  has its own socket and sends at @a rate_kbps.
+	 */
+	uint8_t num_streams;
 	char if_name[IFNAMSIZ];
 	struct {
 		uint8_t tos;
@@ -60,6 +71,12 @@ struct zperf_results {
 	uint64_t client_time_in_us;
 	uint32_t packet_size;
 	uint32_t nb_packets_errors;
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM) || defined(__DOXYGEN__)
+	/** Histogram of the time taken by the send calls of an upload */
+	uint32_t send_hist[ZPERF_HIST_BUCKETS];
+	/** Histogram of the per packet jitter seen by the UDP server */
+	uint32_t jitter_hist[ZPERF_HIST_BUCKETS];
+#endif
 };
 
 /**
@@ -116,6 +116,26 @@ int pm_notifier_unregister(struct pm_notifier *notifier);
  */
 const struct pm_state_info *pm_state_next_get(uint8_t cpu);
 
+/**
+ * @brief Hibernate the system, keeping its state in retained RAM.
+ *
+ * The devices are suspended, as they are before entering a system power state,
+ * the CPU context is saved and the system is powered off by the SoC, with the
+ * RAM retained. On wakeup, the reset path restores the CPU context, the
+ * devices are resumed and this function returns, so that the system carries
+ * on without booting again. The device suspend and resume actions are the
+ * consistency boundary: drivers must restore their hardware when resumed.
+ *
+ * Wakeup sources must be enabled before calling this function.
+ *
+ * @kconfig{CONFIG_PM_HIBERNATE} needs to be enabled to use this API.
+ *
+ * @retval 0 The system was hibernated and resumed.
+ * @retval -EBUSY The system could not be powered off at this time.
+ * @retval -errno Other negative errno code, e.g. a device failed to suspend.
+ */
+int pm_system_hibernate(void);
+
 /**
  * @}
  */
@@ -151,6 +171,20 @@ void pm_state_set(enum pm_state state, uint8_t substate_id);
  */
 void pm_state_exit_post_ops(enum pm_state state, uint8_t substate_id);
 
+/**
+ * @brief Power the system off with the RAM retained.
+ *
+ * This function implements the SoC specific details of
+ * pm_system_hibernate(). It is called by arch_pm_s2ram_suspend() once the CPU
+ * context is saved, and must keep the RAM, including the S2RAM context,
+ * retained while the system is off. After wakeup, the SoC is responsible for
+ * restoring its clocks and the system timer before the context is resumed.
+ *
+ * @retval none The system is powered off.
+ * @retval -EBUSY The system cannot be powered off at this time.
+ */
+int pm_hibernate_system_off(void);
+
 /**
  * @}
  */
@@ -87,6 +87,17 @@ struct pm_policy_event {
  */
 const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks);
 
+/**
+ * @brief Function to record the time spent in the last PM state
+ *
+ * This function is called by the power subsystem on wakeup from a state
+ * selected by the policy, when CONFIG_PM_POLICY_PREDICTIVE is enabled.
+ *
+ * @param cpu CPU index.
+ * @param residency_cyc Time spent in the state, in cycles.
+ */
+void pm_policy_residency_update(uint8_t cpu, uint32_t residency_cyc);
+
 /** @endcond */
 
 /** Special value for 'all substates'. */
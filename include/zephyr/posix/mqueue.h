@@ -43,6 +43,50 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 		 unsigned int msg_prio, const struct timespec *abstime);
 int mq_notify(mqd_t mqdes, const struct sigevent *notification);
 
+/**
+ * @brief Claim a free message slot of a message queue, to be filled in place.
+ *
+ * Non-portable extension, available with CONFIG_POSIX_MQUEUE_ZERO_COPY. The
+ * slot holds up to mq_msgsize bytes and is queued by mq_send_commit_np().
+ *
+ * @param mqdes Message queue descriptor.
+ * @param msg_ptr Set to the message slot.
+ * @param abstime Absolute timeout, or NULL to wait forever.
+ *
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int mq_send_claim_np(mqd_t mqdes, void **msg_ptr, const struct timespec *abstime);
+
+/**
+ * @brief Queue a message slot claimed with mq_send_claim_np().
+ *
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int mq_send_commit_np(mqd_t mqdes, void *msg_ptr, size_t msg_len, unsigned int msg_prio);
+
+/**
+ * @brief Receive a message in place, without copying it.
+ *
+ * Non-portable extension, available with CONFIG_POSIX_MQUEUE_ZERO_COPY. The
+ * slot must be given back with mq_receive_release_np() once consumed.
+ *
+ * @param mqdes Message queue descriptor.
+ * @param msg_ptr Set to the message.
+ * @param msg_prio Set to the priority of the message, if not NULL.
+ * @param abstime Absolute timeout, or NULL to wait forever.
+ *
+ * @return Length of the message, -1 with errno set otherwise.
+ */
+int mq_receive_claim_np(mqd_t mqdes, void **msg_ptr, unsigned int *msg_prio,
+			const struct timespec *abstime);
+
+/**
+ * @brief Release a message received with mq_receive_claim_np().
+ *
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int mq_receive_release_np(mqd_t mqdes, void *msg_ptr);
+
 #ifdef __cplusplus
 }
 #endif
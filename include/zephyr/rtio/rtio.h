@@ -280,6 +280,9 @@ struct rtio_sqe {
 
 		/** OP_I2C_CONFIGURE */
 		uint32_t i2c_config;
+
+		/** OP_FS_SEEK */
+		uint32_t fs_offset;
 	};
 };
 
@@ -480,6 +483,9 @@ struct rtio_iodev {
 /** An operation to configure I2C buses */
 #define RTIO_OP_I2C_CONFIGURE (RTIO_OP_I2C_RECOVER+1)
 
+/** An operation to set the position of a file */
+#define RTIO_OP_FS_SEEK (RTIO_OP_I2C_CONFIGURE+1)
+
 /**
  * @brief Prepare a nop (no op) submission
  */
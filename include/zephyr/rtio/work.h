@@ -0,0 +1,88 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_RTIO_WORK_H_
+#define ZEPHYR_INCLUDE_RTIO_WORK_H_
+
+#include <stdint.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RTIO Work Pool
+ * @defgroup rtio_work RTIO Work Pool
+ * @ingroup rtio
+ *
+ * A pool of preallocated worker threads for iodevs that can only perform
+ * their operations by blocking. An iodev hands its submission to the pool
+ * from its submit function, one of the workers then runs the blocking
+ * handler and the handler completes the submission with
+ * rtio_iodev_sqe_ok() or rtio_iodev_sqe_err(). Submissions to several
+ * iodevs of one RTIO context are thereby executed in parallel, and the
+ * submitting thread is never blocked.
+ *
+ * @{
+ */
+
+/**
+ * @brief Blocking handler of a submission, called from a worker thread
+ *
+ * @param iodev_sqe Submission to execute and complete
+ */
+typedef void (*rtio_work_submit_t)(struct rtio_iodev_sqe *iodev_sqe);
+
+/**
+ * @brief Request to execute a submission in the work pool
+ */
+struct rtio_work_req {
+	/** @cond INTERNAL_HIDDEN */
+	void *fifo_reserved;
+	struct rtio_iodev_sqe *iodev_sqe;
+	rtio_work_submit_t handler;
+	/** @endcond */
+};
+
+/**
+ * @brief Allocate a work request from the pool
+ *
+ * Does not block, so it may be called from the submit function of an iodev
+ * in any context.
+ *
+ * @return Work request, NULL if all the requests of the pool are in use.
+ */
+struct rtio_work_req *rtio_work_req_alloc(void);
+
+/**
+ * @brief Submit a work request to the work pool
+ *
+ * The request is released to the pool once @p handler returns.
+ *
+ * @param req Work request allocated with rtio_work_req_alloc().
+ * @param iodev_sqe Submission given to @p handler.
+ * @param handler Blocking handler, which must complete @p iodev_sqe.
+ */
+void rtio_work_req_submit(struct rtio_work_req *req, struct rtio_iodev_sqe *iodev_sqe,
+			  rtio_work_submit_t handler);
+
+/**
+ * @brief Get the number of work requests in use
+ *
+ * @return Number of requests allocated and not yet released.
+ */
+uint32_t rtio_work_req_used_count_get(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_RTIO_WORK_H_ */
@@ -120,6 +120,24 @@ typedef void (*sensing_data_event_t)(
 		const void *buf,
 		void *context);
 
+/**
+ * @brief Sensor data batch receive callback.
+ *
+ * @param handle The sensor instance handle.
+ *
+ * @param buf The data buffer with @p count consecutive samples of the sensor,
+ *            the same as delivered one by one to @ref sensing_data_event_t.
+ *
+ * @param count Number of samples in the buffer.
+ *
+ * @param context User provided context pointer.
+ */
+typedef void (*sensing_data_batch_event_t)(
+		sensing_sensor_handle_t handle,
+		const void *buf,
+		uint16_t count,
+		void *context);
+
 /**
  * @struct sensing_sensor_info
  * @brief Sensor basic constant information
@@ -152,6 +170,11 @@ struct sensing_sensor_info {
  */
 struct sensing_callback_list {
 	sensing_data_event_t on_data_event;
+	/**
+	 * Optional, receives the samples in batches when the client set a
+	 * latency, see @ref SENSING_SENSOR_ATTRIBUTE_LATENCY.
+	 */
+	sensing_data_batch_event_t on_batch_event;
 	void *context;
 };
 /**
@@ -168,6 +191,14 @@ struct sensing_sensor_config {
 	union {
 		uint32_t interval;
 		uint32_t sensitivity;
+		/**
+		 * Maximum delay in micro seconds of the delivery of a sample.
+		 * Samples are buffered up to it, or up to
+		 * CONFIG_SENSING_MAX_BATCH_COUNT samples, and delivered together
+		 * to the on_batch_event callback. 0 delivers each sample on its
+		 * own. The batched samples are also delivered, by the calling
+		 * thread, when the interval is changed or the sensor is closed.
+		 */
 		uint64_t latency;
 	};
 };
@@ -59,6 +59,7 @@ struct sensing_sensor_register_info {
 
 enum {
 	EVENT_CONFIG_READY,
+	EVENT_BATCH_TIMEOUT,
 };
 
 enum {
@@ -79,6 +80,13 @@ struct sensing_connection {
 	void *data;
 	/* client(sink) next consume time */
 	uint64_t next_consume_time;
+	/* client(sink) latency budget, samples are batched up to it */
+	uint64_t latency;
+	/* samples batched for the client(sink), and number of them */
+	void *batch;
+	uint16_t batch_count;
+	/* time of the first batched sample, the latency budget starts then */
+	uint64_t batch_start;
 	/* post data to application */
 	struct sensing_callback_list *callback_list;
 };
@@ -299,6 +299,11 @@ int settings_load_subtree_direct(
  * Save currently running serialized items. All serialized items which are
  * different from currently persisted values will be saved.
  *
+ * The back-end is told of the start and end of the save, as in a transaction,
+ * but settings_lock is only held by each save unless
+ * CONFIG_SETTINGS_SAVE_TRANSACTION is enabled, see
+ * settings_transaction_begin().
+ *
  * @return 0 on success, non-zero on failure.
  */
 int settings_save(void);
@@ -316,6 +321,29 @@ int settings_save(void);
  */
 int settings_save_one(const char *name, const void *value, size_t val_len);
 
+/**
+ * Start a transaction of saves.
+ *
+ * The saves done until the matching settings_transaction_end() may be kept
+ * by the storage back-end, and written together when the transaction ends,
+ * e.g. with a single append and sync of the settings file. The settings lock
+ * is held for the whole transaction, so saves from other threads wait for its
+ * end. Transactions can be nested, only the outermost one is passed to the
+ * back-end.
+ *
+ * @return 0 on success, -ENOENT if there is no storage back-end to save to,
+ * or the error of the back-end.
+ */
+int settings_transaction_begin(void);
+
+/**
+ * End a transaction started by settings_transaction_begin().
+ *
+ * @return 0 on success, non-zero if the saves of the transaction could not
+ * be written.
+ */
+int settings_transaction_end(void);
+
 /**
  * Delete a single serialized in persisted storage.
  *
@@ -421,7 +449,8 @@ struct settings_store_itf {
 	 */
 
 	int (*csi_save_start)(struct settings_store *cs);
-	/**< Handler called before an export operation.
+	/**< Handler called before an export operation, or at the start of a
+	 * transaction.
 	 *
 	 * Parameters:
 	 *  - cs - Corresponding backend handler node
@@ -439,7 +468,9 @@ struct settings_store_itf {
 	 */
 
 	int (*csi_save_end)(struct settings_store *cs);
-	/**< Handler called after an export operation.
+	/**< Handler called after an export operation, or at the end of a
+	 * transaction. The saves done since csi_save_start must be in storage
+	 * when it returns.
 	 *
 	 * Parameters:
 	 *  - cs - Corresponding backend handler node
@@ -127,6 +127,63 @@ struct smf_state {
 #endif
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+/**
+ * @brief Transition table of a state machine
+ *
+ * Holds the depth of each state and the number of ancestors shared by each
+ * pair of states, so the exit and entry actions of a transition are found
+ * without walking and comparing the ancestor chains. All the states of the
+ * state machine, parents included, must be in the same array.
+ *
+ * Define it with @ref SMF_TABLE_DEFINE and fill it once with
+ * @ref smf_table_init.
+ */
+struct smf_table {
+	/** States of the state machine */
+	const struct smf_state *states;
+	/** Number of states */
+	uint16_t num_states;
+	/** Number of ancestors of each state */
+	uint8_t *depth;
+	/** Number of ancestors shared by each pair of states */
+	uint8_t *common;
+#ifdef CONFIG_SMF_INITIAL_TRANSITION
+	/** Leaf state reached by the initial transitions of each state */
+	uint16_t *leaf;
+#endif
+};
+
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_SMF_INITIAL_TRANSITION
+#define Z_SMF_TABLE_LEAF(_name, _states) \
+	static uint16_t _name##_leaf[ARRAY_SIZE(_states)];
+#define Z_SMF_TABLE_LEAF_INIT(_name) .leaf = _name##_leaf,
+#else
+#define Z_SMF_TABLE_LEAF(_name, _states)
+#define Z_SMF_TABLE_LEAF_INIT(_name)
+#endif
+/** @endcond */
+
+/**
+ * @brief Define the transition table of a state machine
+ *
+ * @param _name   Name of the table
+ * @param _states Array of all the states of the state machine
+ */
+#define SMF_TABLE_DEFINE(_name, _states) \
+	static uint8_t _name##_depth[ARRAY_SIZE(_states)]; \
+	static uint8_t _name##_common[ARRAY_SIZE(_states) * ARRAY_SIZE(_states)]; \
+	Z_SMF_TABLE_LEAF(_name, _states) \
+	static struct smf_table _name = { \
+		.states = _states, \
+		.num_states = ARRAY_SIZE(_states), \
+		.depth = _name##_depth, \
+		.common = _name##_common, \
+		Z_SMF_TABLE_LEAF_INIT(_name) \
+	}
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 /** Defines the current context of the state machine. */
 struct smf_ctx {
 	/** Current state the state machine is executing. */
@@ -145,8 +202,39 @@ struct smf_ctx {
 	 * used to track state machine context
 	 */
 	uint32_t internal;
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	/** Transition table of the state machine, or NULL */
+	const struct smf_table *table;
+#endif
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+/**
+ * @brief Fill the transition table of a state machine.
+ *
+ * @param table Table defined with @ref SMF_TABLE_DEFINE
+ *
+ * @retval 0 on success
+ * @retval -EINVAL a parent or initial state is not in the table, or a state
+ *         has more than CONFIG_SMF_TABLE_MAX_DEPTH ancestors.
+ */
+int smf_table_init(struct smf_table *table);
+
+/**
+ * @brief Use a transition table for the transitions of a state machine.
+ *
+ * Transitions to or from a state outside of the table fall back to walking
+ * the ancestor chains.
+ *
+ * @param ctx   State machine context
+ * @param table Table filled by @ref smf_table_init, or NULL
+ */
+static inline void smf_set_table(struct smf_ctx *ctx, const struct smf_table *table)
+{
+	ctx->table = table;
+}
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 /**
  * @brief Initializes the state machine and sets its initial state.
  *
@@ -76,6 +76,12 @@ struct k_spinlock {
 	 */
 	uint32_t lock_time;
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
+#ifdef CONFIG_SPIN_LOCK_STATS
+	/* Contention counters, only written with the lock held */
+	uint32_t acquired;
+	uint32_t contended;
+	uint32_t spins;
+#endif /* CONFIG_SPIN_LOCK_STATS */
 #endif /* CONFIG_SPIN_VALIDATE */
 
 #if defined(CONFIG_CPP) && !defined(CONFIG_SMP) && \
@@ -114,6 +120,37 @@ BUILD_ASSERT(CONFIG_MP_MAX_NUM_CPUS <= 4, "Too many CPUs for mask");
 bool z_spin_lock_mem_coherent(struct k_spinlock *l);
 # endif /* CONFIG_KERNEL_COHERENCE */
 
+#ifdef CONFIG_SPIN_LOCK_STATS
+/**
+ * @brief Spinlock contention statistics
+ *
+ * @see k_spin_stats_get()
+ */
+struct k_spinlock_stats {
+	/** Number of times the lock was taken */
+	uint32_t acquired;
+	/** Number of times the lock was found held by another CPU */
+	uint32_t contended;
+	/** Total number of busy loop iterations spent waiting for the lock */
+	uint32_t spins;
+};
+
+/**
+ * @brief Get the contention statistics of a spinlock
+ *
+ * @param l A pointer to the spinlock
+ * @param stats Filled with the counters of @p l
+ */
+void k_spin_stats_get(struct k_spinlock *l, struct k_spinlock_stats *stats);
+
+/**
+ * @brief Reset the contention statistics of a spinlock
+ *
+ * @param l A pointer to the spinlock
+ */
+void k_spin_stats_reset(struct k_spinlock *l);
+#endif /* CONFIG_SPIN_LOCK_STATS */
+
 #endif /* CONFIG_SPIN_VALIDATE */
 
 /**
@@ -140,14 +177,23 @@ static ALWAYS_INLINE void z_spinlock_validate_pre(struct k_spinlock *l)
 #endif
 }
 
-static ALWAYS_INLINE void z_spinlock_validate_post(struct k_spinlock *l)
+static ALWAYS_INLINE void z_spinlock_validate_post(struct k_spinlock *l,
+						   uint32_t spins)
 {
 	ARG_UNUSED(l);
+	ARG_UNUSED(spins);
 #ifdef CONFIG_SPIN_VALIDATE
 	z_spin_lock_set_owner(l);
 #if defined(CONFIG_SPIN_LOCK_TIME_LIMIT) && (CONFIG_SPIN_LOCK_TIME_LIMIT != 0)
 	l->lock_time = sys_clock_cycle_get_32();
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
+#ifdef CONFIG_SPIN_LOCK_STATS
+	l->acquired++;
+	if (spins != 0U) {
+		l->contended++;
+		l->spins += spins;
+	}
+#endif /* CONFIG_SPIN_LOCK_STATS */
 #endif /* CONFIG_SPIN_VALIDATE */
 }
 
@@ -183,6 +229,7 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 {
 	ARG_UNUSED(l);
 	k_spinlock_key_t k;
+	uint32_t spins = 0U;
 
 	/* Note that we need to use the underlying arch-specific lock
 	 * implementation.  The "irq_lock()" API in SMP context is
@@ -201,14 +248,22 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	/* Spin until our ticket is served */
 	while (atomic_get(&l->owner) != ticket) {
 		arch_spin_relax();
+		spins++;
 	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
-		arch_spin_relax();
+		/* Wait with plain loads so that the waiters share the cache
+		 * line instead of bouncing it with failed exchanges until
+		 * the owner releases the lock.
+		 */
+		do {
+			arch_spin_relax();
+			spins++;
+		} while (atomic_get(&l->locked) != 0);
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
-	z_spinlock_validate_post(l);
+	z_spinlock_validate_post(l, spins);
 
 	return k;
 }
@@ -263,7 +318,7 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
-	z_spinlock_validate_post(l);
+	z_spinlock_validate_post(l, 0U);
 
 	k->key = key;
 
@@ -46,6 +46,14 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * When CONFIG_STATS_PER_CPU is enabled, each CPU increases its own copy of the
+ * entries of a group, so that CPUs counting the same events do not fight over
+ * the cache line of the group.  The value of an entry is then only known by
+ * summing the copies, with stats_get().  The entries of the group structure
+ * itself keep the values set with STATS_SET() and direct assignments.
+ * STATS_INC() and STATS_INCN() then lock interrupts for the time of the
+ * increase, and can only be used from supervisor mode.
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_STATS_H_
@@ -53,11 +61,29 @@
 
 #include <stddef.h>
 #include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+#ifdef CONFIG_STATS_PER_CPU
+#include <zephyr/kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Places hot counters in a section of their own.
+ *
+ * With CONFIG_STATS_HOT_SECTION enabled, the variables tagged with this are
+ * gathered in a section aligned and padded to the data cache line, so that
+ * they share no cache line with the rest of the data.
+ */
+#ifdef CONFIG_STATS_HOT_SECTION
+#define __stats_hot Z_GENERIC_SECTION(.stats_hot)
+#else
+#define __stats_hot
+#endif
+
 struct stats_name_map {
 	uint16_t snm_off;
 	const char *snm_name;
@@ -71,6 +97,10 @@ struct stats_hdr {
 #ifdef CONFIG_STATS_NAMES
 	const struct stats_name_map *s_map;
 	int s_map_cnt;
+#endif
+#ifdef CONFIG_STATS_PER_CPU
+	uint8_t *s_cpu;
+	uint16_t s_cpu_stride;
 #endif
 	struct stats_hdr *s_next;
 };
@@ -130,6 +160,25 @@ struct stats_hdr {
  */
 #define STATS_SECT_ENTRY64(var__) uint64_t var__;
 
+#ifdef CONFIG_STATS_PER_CPU
+/* The copy of an entry for the current CPU, the entry itself when the group
+ * got no per-CPU copies.  Only valid while the caller cannot be moved to
+ * another CPU, i.e. with interrupts locked.
+ */
+static inline void *z_stats_cpu_entry(struct stats_hdr *hdr, uint16_t off)
+{
+	if (hdr->s_cpu == NULL) {
+		return (uint8_t *)hdr + off;
+	}
+
+	return hdr->s_cpu + arch_curr_cpu()->id * hdr->s_cpu_stride + off - sizeof(*hdr);
+}
+
+#define Z_STATS_CPU_ENTRY(group__, var__)					\
+	((__typeof__((group__).var__) *)z_stats_cpu_entry(			\
+		&(group__).s_hdr, offsetof(__typeof__(group__), var__)))
+#endif /* CONFIG_STATS_PER_CPU */
+
 /**
  * @brief Increases a statistic entry by the specified amount.
  *
@@ -140,8 +189,21 @@ struct stats_hdr {
  * @param var__                 The statistic entry to increase.
  * @param n__                   The amount to increase the statistic entry by.
  */
+#ifdef CONFIG_STATS_PER_CPU
+/* Interrupts are locked so that the thread stays on the CPU whose copy it
+ * increases: another CPU could otherwise be increasing that copy as well.
+ */
+#define STATS_INCN(group__, var__, n__)					\
+	do {								\
+		unsigned int key__ = arch_irq_lock();			\
+									\
+		*Z_STATS_CPU_ENTRY(group__, var__) += (n__);		\
+		arch_irq_unlock(key__);					\
+	} while (false)
+#else
 #define STATS_INCN(group__, var__, n__)	\
 	((group__).var__ += (n__))
+#endif
 
 /**
  * @brief Increments a statistic entry.
@@ -165,8 +227,13 @@ struct stats_hdr {
  * @param var__                 The statistic entry to increase.
  * @param n__                   The amount to set the statistic entry to.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_SET(group__, var__, n__)					   \
+	stats_set(&(group__).s_hdr, offsetof(__typeof__(group__), var__), (n__))
+#else
 #define STATS_SET(group__, var__, n__)	\
 	((group__).var__ = (n__))
+#endif
 
 /**
  * @brief Sets a statistic entry to zero.
@@ -178,7 +245,25 @@ struct stats_hdr {
  * @param var__                 The statistic entry to clear.
  */
 #define STATS_CLEAR(group__, var__) \
-	((group__).var__ = 0)
+	STATS_SET(group__, var__, 0)
+
+/**
+ * @brief Retrieves the value of a statistic entry.
+ *
+ * Retrieves the value of a statistic entry, summed over the CPUs with
+ * CONFIG_STATS_PER_CPU.  Evaluates to 0 if CONFIG_STATS is not defined.
+ *
+ * @param group__               The group containing the entry to retrieve.
+ * @param var__                 The statistic entry to retrieve.
+ */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_GET(group__, var__)						\
+	((__typeof__((group__).var__))stats_get(&(group__).s_hdr,		\
+		offsetof(__typeof__(group__), var__)))
+#else
+#define STATS_GET(group__, var__) \
+	((group__).var__)
+#endif
 
 #define STATS_SIZE_16 (sizeof(uint16_t))
 #define STATS_SIZE_32 (sizeof(uint32_t))
@@ -279,6 +364,33 @@ int stats_init_and_reg(struct stats_hdr *hdr, uint8_t size, uint16_t cnt,
  */
 void stats_reset(struct stats_hdr *shdr);
 
+/**
+ * @brief Retrieves the value of a stat entry.
+ *
+ * With CONFIG_STATS_PER_CPU, this sums the copies of the entry of all the
+ * CPUs, without stopping them from counting meanwhile.
+ *
+ * @param hdr                   The group containing the stat entry.
+ * @param off                   The offset of the entry, from `hdr`, as given
+ *                                  to a stats_walk_fn.
+ *
+ * @return                      The value of the entry, wrapped around to its
+ *                              size.
+ */
+uint64_t stats_get(const struct stats_hdr *hdr, uint16_t off);
+
+/**
+ * @brief Sets a stat entry to the specified value.
+ *
+ * With CONFIG_STATS_PER_CPU, this also zeroes the copies of the entry of the
+ * CPUs.  Prefer the STATS_SET() macro.
+ *
+ * @param hdr                   The group containing the stat entry.
+ * @param off                   The offset of the entry, from `hdr`.
+ * @param val                   The value to set the entry to.
+ */
+void stats_set(struct stats_hdr *hdr, uint16_t off, uint64_t val);
+
 /** @typedef stats_walk_fn
  * @brief Function that gets applied to every stat entry during a walk.
  *
@@ -364,6 +476,7 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_INC(group__, var__)
 #define STATS_SET(group__, var__)
 #define STATS_CLEAR(group__, var__)
+#define STATS_GET(group__, var__) (0)
 #define STATS_INIT_AND_REG(group__, size__, name__) (0)
 
 #endif /* !CONFIG_STATS */
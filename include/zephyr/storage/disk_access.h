@@ -107,6 +107,28 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+/**
+ * @brief Read or write data without waiting for it
+ *
+ * Drivers that implement the submit operation get the request directly, and
+ * can have several in flight. For the others, the request is queued and done
+ * from a work queue thread, where requests that follow each other on the disk
+ * and in memory are done with a single read or write of the driver. In that
+ * case, the callback is called from that thread, and requests are done in
+ * submission order.
+ *
+ * Requires CONFIG_DISK_ACCESS_ASYNC.
+ *
+ * @param[in] pdrv          Disk name
+ * @param[in] req           Request, which must stay valid until its callback
+ *                          is called. @a op, @a buf, @a start_sector,
+ *                          @a num_sector and @a cb must be set.
+ *
+ * @return 0 if the request was submitted, negative errno code on fail, in
+ *         which case the callback is not called.
+ */
+int disk_access_submit(const char *pdrv, struct disk_access_req *req);
+
 #ifdef __cplusplus
 }
 #endif
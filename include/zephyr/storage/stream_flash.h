@@ -24,6 +24,7 @@
  */
 
 #include <stdbool.h>
+#include <zephyr/kernel.h>
 #include <zephyr/drivers/flash.h>
 
 #ifdef __cplusplus
@@ -65,6 +66,14 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	uint8_t *bg_buf; /* Buffer written in the background, NULL if disabled */
+	size_t bg_bytes; /* Number of bytes of bg_buf not yet accounted for */
+	size_t bg_addr; /* Offset bg_buf is written to */
+	int bg_rc; /* Result of the last background write */
+	struct k_work bg_work; /* Background write */
+	struct k_sem bg_idle; /* Given when no background write is ongoing */
+#endif
 };
 
 /**
@@ -119,6 +128,31 @@ size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx);
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush);
 
+/**
+ * @brief Write to flash in the background, with a second write buffer.
+ *
+ * Once a write buffer is full, it is erased and written to flash by a
+ * dedicated thread, while stream_flash_buffered_write() fills the other one.
+ * Then the page in which the next buffer starts is erased, so that the erase
+ * of each page also happens while data is received. A full buffer only
+ * waits for the write of the previous one to complete.
+ *
+ * Errors of background writes are returned by the next call to
+ * stream_flash_buffered_write(), and stream_flash_bytes_written() only
+ * counts the bytes of completed writes. The callback is invoked from the
+ * background thread, with either buffer. A write with flush set to true
+ * returns once all the data is written.
+ *
+ * Call after stream_flash_init() and stream_flash_progress_load().
+ * Requires CONFIG_STREAM_FLASH_DOUBLE_BUFFER.
+ *
+ * @param ctx context
+ * @param buf Second write buffer, of the length given to stream_flash_init()
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_double_buffer_enable(struct stream_flash_ctx *ctx, uint8_t *buf);
+
 /**
  * @brief Erase the flash page to which a given offset belongs.
  *
@@ -39,9 +39,19 @@ struct sys_bitarray {
 	/* Bundle of bits */
 	uint32_t *bundles;
 
+	/* One bit per bundle, set when all bits of the bundle are set */
+	uint32_t *summary;
+
+	/* All bits below this one are known to be set */
+	uint32_t first_free;
+
 	/* Spinlock guarding access to this bit array */
 	struct k_spinlock lock;
 };
+
+#define _SYS_BITARRAY_NUM_BUNDLES(total_bits)				\
+	DIV_ROUND_UP(DIV_ROUND_UP(total_bits, 8), sizeof(uint32_t))
+
 /** @endcond */
 
 /** Bitarray structure */
@@ -56,13 +66,15 @@ typedef struct sys_bitarray sys_bitarray_t;
  */
 #define _SYS_BITARRAY_DEFINE(name, total_bits, sba_mod)			\
 	sba_mod uint32_t _sys_bitarray_bundles_##name			\
-		[DIV_ROUND_UP(DIV_ROUND_UP(total_bits, 8),		\
-			       sizeof(uint32_t))] = {0};		\
+		[_SYS_BITARRAY_NUM_BUNDLES(total_bits)] = {0};		\
+	sba_mod uint32_t _sys_bitarray_summary_##name			\
+		[DIV_ROUND_UP(_SYS_BITARRAY_NUM_BUNDLES(total_bits),	\
+			      32)] = {0};				\
 	sba_mod sys_bitarray_t name = {					\
 		.num_bits = total_bits,					\
-		.num_bundles = DIV_ROUND_UP(				\
-			DIV_ROUND_UP(total_bits, 8), sizeof(uint32_t)),	\
+		.num_bundles = _SYS_BITARRAY_NUM_BUNDLES(total_bits),	\
 		.bundles = _sys_bitarray_bundles_##name,		\
+		.summary = _sys_bitarray_summary_##name,		\
 	}
 
 /**
@@ -152,7 +164,7 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
  * This finds a number of bits (@p num_bits) in a contiguous of
  * previously unallocated region. If such a region exists, the bits are
  * marked as allocated and the offset to the start of this region is
- * returned via @p offset.
+ * returned via @p offset. The lowest such region is always picked.
  *
  * @param[in]  bitarray Bitarray struct
  * @param[in]  num_bits Number of bits to allocate
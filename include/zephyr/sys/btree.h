@@ -0,0 +1,301 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_BTREE_H_
+#define ZEPHYR_INCLUDE_SYS_BTREE_H_
+
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @defgroup btree_apis B-tree
+ * @ingroup datastructure_apis
+ *
+ * @brief Ordered map of integer keys in cache line sized nodes.
+ *
+ * A B+ tree mapping unique @c uintptr_t keys to @c uintptr_t values, in key
+ * order. Unlike the red/black tree, it is not intrusive: each node holds
+ * several keys and values side by side in CONFIG_BTREE_NODE_SIZE bytes, so a
+ * lookup touches a few cache lines instead of one scattered node per level,
+ * and compares keys directly instead of calling a comparison callback.
+ *
+ * The nodes come from a pool given when the tree is defined. All the values
+ * are in the leaves, which are linked together, so iterating over a range of
+ * keys is a walk along the leaves.
+ *
+ * Like the other data structures, the tree is not synchronized.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_BTREE_MAX_KEYS                                                         \
+	((CONFIG_BTREE_NODE_SIZE / sizeof(uintptr_t) - 2) / 2)
+#define Z_BTREE_MIN_KEYS (Z_BTREE_MAX_KEYS / 2)
+
+/* Deepest tree that can be built, far more than the nodes of any pool */
+#define Z_BTREE_MAX_DEPTH 16
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_BTREE_NODE_SIZE) && Z_BTREE_MAX_KEYS >= 3,
+	     "CONFIG_BTREE_NODE_SIZE must be a power of two of at least 8 words");
+/** @endcond */
+
+/**
+ * @brief B-tree node
+ *
+ * Nodes are only accessed by the tree code, they are declared here so that
+ * pools can be defined.
+ */
+struct sys_btree_node {
+	/** @cond INTERNAL_HIDDEN */
+	uint16_t nkeys;
+	bool leaf;
+	uintptr_t keys[Z_BTREE_MAX_KEYS];
+	union {
+		/* Leaves */
+		struct {
+			uintptr_t values[Z_BTREE_MAX_KEYS];
+			struct sys_btree_node *next;
+		};
+		/* Internal nodes, and free nodes in children[0] */
+		struct sys_btree_node *children[Z_BTREE_MAX_KEYS + 1];
+	};
+	/** @endcond */
+};
+
+/**
+ * @brief B-tree
+ */
+struct sys_btree {
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_btree_node *root;
+	struct sys_btree_node *pool;
+	struct sys_btree_node *free_list;
+	uint32_t pool_size;
+	uint32_t pool_used;
+	size_t size;
+	/** @endcond */
+};
+
+/**
+ * @brief Iterator over the entries of a B-tree
+ *
+ * An iterator is invalidated by any change to the tree.
+ */
+struct sys_btree_iter {
+	/** @cond INTERNAL_HIDDEN */
+	const struct sys_btree_node *node;
+	uint16_t idx;
+	/** @endcond */
+};
+
+/**
+ * @brief Number of nodes enough for a tree of @p n entries
+ *
+ * @param n Number of entries.
+ */
+#define SYS_BTREE_NODES(n)                                                      \
+	(DIV_ROUND_UP(n, Z_BTREE_MIN_KEYS) +                                     \
+	 DIV_ROUND_UP(DIV_ROUND_UP(n, Z_BTREE_MIN_KEYS), Z_BTREE_MIN_KEYS) +     \
+	 Z_BTREE_MAX_DEPTH)
+
+/**
+ * @brief Statically define and initialize an empty tree
+ *
+ * @param name Name of the tree.
+ * @param num_nodes Number of nodes in the pool of the tree, see
+ *                  @ref SYS_BTREE_NODES.
+ */
+#define SYS_BTREE_DEFINE(name, num_nodes)                                        \
+	static struct sys_btree_node __aligned(CONFIG_BTREE_NODE_SIZE)           \
+		_sys_btree_nodes_##name[num_nodes];                              \
+	struct sys_btree name = {                                                \
+		.pool = _sys_btree_nodes_##name,                                 \
+		.pool_size = num_nodes,                                          \
+	}
+
+/**
+ * @brief Initialize an empty tree
+ *
+ * @param tree Tree to initialize.
+ * @param nodes Pool of nodes of the tree, preferably aligned to
+ *              CONFIG_BTREE_NODE_SIZE.
+ * @param num_nodes Number of nodes in the pool, see @ref SYS_BTREE_NODES.
+ */
+void sys_btree_init(struct sys_btree *tree, struct sys_btree_node *nodes, size_t num_nodes);
+
+/**
+ * @brief Insert an entry, or replace the value of an existing key
+ *
+ * @param tree Tree to insert into.
+ * @param key Key of the entry.
+ * @param value Value of the entry.
+ * @param old_value Set to the replaced value, if any, when not NULL.
+ *
+ * @retval 0 The entry was inserted.
+ * @retval 1 The value of an existing entry was replaced.
+ * @retval -ENOMEM No node left in the pool. The entry is not inserted,
+ *                 although some nodes may have been split.
+ */
+int sys_btree_insert(struct sys_btree *tree, uintptr_t key, uintptr_t value,
+		     uintptr_t *old_value);
+
+/**
+ * @brief Look up the value of a key
+ *
+ * @param tree Tree to look into.
+ * @param key Key to look up.
+ * @param value Set to the value of the key when found and not NULL.
+ *
+ * @return true if the key is in the tree, false otherwise.
+ */
+bool sys_btree_get(const struct sys_btree *tree, uintptr_t key, uintptr_t *value);
+
+/**
+ * @brief Remove an entry
+ *
+ * @param tree Tree to remove from.
+ * @param key Key of the entry.
+ * @param value Set to the value of the entry when found and not NULL.
+ *
+ * @return true if the entry was removed, false if the key is not in the tree.
+ */
+bool sys_btree_remove(struct sys_btree *tree, uintptr_t key, uintptr_t *value);
+
+/**
+ * @brief Fill an empty tree from sorted entries
+ *
+ * Builds the tree bottom up with full nodes, which is much faster than
+ * inserting the entries one by one and uses fewer nodes.
+ *
+ * @param tree Empty tree to fill.
+ * @param keys Keys of the entries, in strictly increasing order.
+ * @param values Values of the entries, or NULL to have the values be 0.
+ * @param n Number of entries.
+ *
+ * @retval 0 The entries were loaded.
+ * @retval -EINVAL The tree is not empty, or the keys are not sorted and the
+ *                 tree is left empty.
+ * @retval -ENOMEM No node left in the pool. The tree is left empty.
+ */
+int sys_btree_load(struct sys_btree *tree, const uintptr_t *keys, const uintptr_t *values,
+		   size_t n);
+
+/**
+ * @brief Remove all the entries
+ *
+ * All the nodes go back to the pool.
+ *
+ * @param tree Tree to clear.
+ */
+void sys_btree_clear(struct sys_btree *tree);
+
+/**
+ * @brief Number of entries in a tree
+ *
+ * @param tree Tree to count the entries of.
+ *
+ * @return The number of entries.
+ */
+static inline size_t sys_btree_size(const struct sys_btree *tree)
+{
+	return tree->size;
+}
+
+/**
+ * @brief Get the entry with the greatest key
+ *
+ * @param tree Tree to look into.
+ * @param key Set to the greatest key.
+ * @param value Set to its value when not NULL.
+ *
+ * @return true if found, false if the tree is empty.
+ */
+bool sys_btree_get_max(const struct sys_btree *tree, uintptr_t *key, uintptr_t *value);
+
+/**
+ * @brief Start iterating from a key
+ *
+ * @param tree Tree to iterate over.
+ * @param iter Iterator to initialize.
+ * @param from Smallest key to return.
+ */
+void sys_btree_iter_init(const struct sys_btree *tree, struct sys_btree_iter *iter,
+			 uintptr_t from);
+
+/**
+ * @brief Get the next entry, in key order
+ *
+ * @param iter Iterator.
+ * @param key Set to the key of the entry.
+ * @param value Set to its value when not NULL.
+ *
+ * @return true if there was an entry, false at the end of the tree.
+ */
+static inline bool sys_btree_iter_next(struct sys_btree_iter *iter, uintptr_t *key,
+				       uintptr_t *value)
+{
+	while (iter->node != NULL && iter->idx >= iter->node->nkeys) {
+		iter->node = iter->node->next;
+		iter->idx = 0;
+	}
+
+	if (iter->node == NULL) {
+		return false;
+	}
+
+	*key = iter->node->keys[iter->idx];
+	if (value != NULL) {
+		*value = iter->node->values[iter->idx];
+	}
+	iter->idx++;
+
+	return true;
+}
+
+/**
+ * @brief Walk all the entries of a tree, in key order
+ *
+ * @param tree Tree to walk.
+ * @param iter A struct sys_btree_iter.
+ * @param key A uintptr_t set to the key of each entry.
+ * @param value A uintptr_t set to the value of each entry.
+ */
+#define SYS_BTREE_FOR_EACH(tree, iter, key, value)                               \
+	for (sys_btree_iter_init(tree, &(iter), 0);                              \
+	     sys_btree_iter_next(&(iter), &(key), &(value));)
+
+/**
+ * @brief Walk the entries of a tree with keys from @p lo to @p hi included
+ *
+ * @param tree Tree to walk.
+ * @param iter A struct sys_btree_iter.
+ * @param lo Smallest key.
+ * @param hi Greatest key.
+ * @param key A uintptr_t set to the key of each entry.
+ * @param value A uintptr_t set to the value of each entry.
+ */
+#define SYS_BTREE_FOR_EACH_RANGE(tree, iter, lo, hi, key, value)                 \
+	for (sys_btree_iter_init(tree, &(iter), lo);                             \
+	     sys_btree_iter_next(&(iter), &(key), &(value)) && (key) <= (hi);)
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_BTREE_H_ */
@@ -0,0 +1,216 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPMC_RING_H_
+#define ZEPHYR_INCLUDE_SYS_MPMC_RING_H_
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @defgroup mpmc_ring_apis Multi-producer multi-consumer ring APIs
+ * @ingroup datastructure_apis
+ *
+ * @brief Lock-free ring of fixed size elements.
+ *
+ * Any number of threads and ISRs, on any number of CPUs, can add elements to
+ * and remove elements from the ring concurrently, without a lock. Each
+ * element has a sequence number that tells whether it can be written, read,
+ * or is still being accessed, so an element is reserved with a single atomic
+ * compare and swap of the head or tail index, and then accessed in place.
+ *
+ * Elements are removed in the order in which their space was reserved, and
+ * an element that is reserved but not yet finished holds back the ones that
+ * follow it. The ring is not a byte stream, but a ring of 1 byte elements
+ * can carry bytes.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define Z_MPMC_RING_ALIGN CONFIG_DCACHE_LINE_SIZE
+#elif defined(CONFIG_SMP)
+#define Z_MPMC_RING_ALIGN 64
+#else
+#define Z_MPMC_RING_ALIGN sizeof(atomic_t)
+#endif
+/** @endcond */
+
+/**
+ * @brief Multi-producer multi-consumer ring
+ */
+struct mpmc_ring {
+	/** @cond INTERNAL_HIDDEN */
+	/* Producers and consumers each update their own cache line */
+	atomic_t head __aligned(Z_MPMC_RING_ALIGN);
+	atomic_t tail __aligned(Z_MPMC_RING_ALIGN);
+	atomic_t *seq __aligned(Z_MPMC_RING_ALIGN);
+	uint8_t *buffer;
+	size_t elem_size;
+	uint32_t mask;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically define and initialize a ring
+ *
+ * @param name Name of the ring.
+ * @param _elem_size Size of an element in bytes.
+ * @param n_elems Number of elements, a power of 2 of at most 2048.
+ */
+#define MPMC_RING_DEFINE(name, _elem_size, n_elems)                              \
+	BUILD_ASSERT(IS_POWER_OF_TWO(n_elems), "Size must be a power of 2");      \
+	static atomic_t _mpmc_ring_seq_##name[n_elems] = {                       \
+		LISTIFY(n_elems, Z_MPMC_RING_SEQ_INIT, (,))                      \
+	};                                                                       \
+	static uint8_t __aligned(sizeof(void *))                                 \
+		_mpmc_ring_buf_##name[(_elem_size) * (n_elems)];                 \
+	struct mpmc_ring name = {                                                \
+		.seq = _mpmc_ring_seq_##name,                                    \
+		.buffer = _mpmc_ring_buf_##name,                                 \
+		.elem_size = (_elem_size),                                       \
+		.mask = (n_elems) - 1,                                           \
+	}
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_MPMC_RING_SEQ_INIT(i, _) i
+/** @endcond */
+
+/**
+ * @brief Initialize a ring
+ *
+ * @param ring Ring to initialize.
+ * @param seq Array of @p n_elems sequence numbers.
+ * @param buffer Storage for @p n_elems elements of @p elem_size bytes.
+ * @param elem_size Size of an element in bytes.
+ * @param n_elems Number of elements, must be a power of 2.
+ */
+void mpmc_ring_init(struct mpmc_ring *ring, atomic_t *seq, void *buffer,
+		    size_t elem_size, uint32_t n_elems);
+
+/**
+ * @brief Reserve an element to write in place
+ *
+ * @param ring Ring.
+ *
+ * @return Element to write and then pass to mpmc_ring_put_finish(), or NULL
+ *	   if the ring is full.
+ */
+void *mpmc_ring_put_claim(struct mpmc_ring *ring);
+
+/**
+ * @brief Make an element reserved with mpmc_ring_put_claim() readable
+ *
+ * A reserved element can not be given back, so a producer that changes its
+ * mind has to write something that consumers can skip.
+ *
+ * @param ring Ring.
+ * @param elem Element returned by mpmc_ring_put_claim().
+ */
+void mpmc_ring_put_finish(struct mpmc_ring *ring, void *elem);
+
+/**
+ * @brief Reserve the oldest element to read in place
+ *
+ * @param ring Ring.
+ *
+ * @return Element to read and then pass to mpmc_ring_get_finish(), or NULL
+ *	   if no element is readable.
+ */
+void *mpmc_ring_get_claim(struct mpmc_ring *ring);
+
+/**
+ * @brief Free an element reserved with mpmc_ring_get_claim()
+ *
+ * @param ring Ring.
+ * @param elem Element returned by mpmc_ring_get_claim().
+ */
+void mpmc_ring_get_finish(struct mpmc_ring *ring, void *elem);
+
+/**
+ * @brief Copy an element into the ring
+ *
+ * @param ring Ring.
+ * @param elem Element to copy.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if the ring is full.
+ */
+int mpmc_ring_put(struct mpmc_ring *ring, const void *elem);
+
+/**
+ * @brief Copy the oldest element out of the ring
+ *
+ * @param ring Ring.
+ * @param elem Destination of the element.
+ *
+ * @retval 0 on success.
+ * @retval -EAGAIN if no element is readable.
+ */
+int mpmc_ring_get(struct mpmc_ring *ring, void *elem);
+
+/**
+ * @brief Copy up to @p n of the oldest elements out of the ring
+ *
+ * All the elements are reserved with a single atomic operation, which makes
+ * this cheaper than calling mpmc_ring_get() for each.
+ *
+ * @param ring Ring.
+ * @param elems Destination of the elements.
+ * @param n Maximum number of elements to copy.
+ *
+ * @return Number of elements copied.
+ */
+size_t mpmc_ring_get_n(struct mpmc_ring *ring, void *elems, size_t n);
+
+/**
+ * @brief Get the number of elements in the ring
+ *
+ * The value is only a snapshot when other contexts use the ring. It counts
+ * the elements that are reserved but not yet finished.
+ *
+ * @param ring Ring.
+ *
+ * @return Number of elements in the ring.
+ */
+static inline uint32_t mpmc_ring_size_get(struct mpmc_ring *ring)
+{
+	/* The tail first, which can only move up to where the head is then */
+	uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+
+	return (uint32_t)atomic_get(&ring->head) - tail;
+}
+
+/**
+ * @brief Get the capacity of the ring
+ *
+ * @param ring Ring.
+ *
+ * @return Number of elements the ring holds.
+ */
+static inline uint32_t mpmc_ring_capacity_get(struct mpmc_ring *ring)
+{
+	return ring->mask + 1;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPMC_RING_H_ */
@@ -0,0 +1,59 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Time page shared with user threads
+ *
+ * With @kconfig{CONFIG_USERSPACE_TIME_PAGE}, the kernel publishes the tick
+ * count, the cycle counter at which it last changed and the realtime clock
+ * base in a page that user threads can read. k_uptime_ticks() and
+ * clock_gettime() then read the time there instead of making a system
+ * call. Updates are detected with a sequence counter, odd while the page is
+ * being written, so readers never block the kernel.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_TIME_PAGE_H_
+#define ZEPHYR_INCLUDE_SYS_TIME_PAGE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+struct k_mem_partition;
+
+/* Memory partition of the time page, added to the default memory domain */
+extern struct k_mem_partition z_time_page_partition;
+
+/*
+ * Publish a new tick count, from the kernel only
+ */
+void z_time_page_update(uint64_t ticks);
+
+/*
+ * Publish a new realtime clock base, from the kernel only
+ */
+void z_time_page_set_realtime(int64_t sec, int32_t nsec);
+
+/*
+ * Get the current tick count and, if @p rt_sec is not NULL, the realtime
+ * clock base, from any context. With @kconfig{CONFIG_USERSPACE_CYCLE_COUNTER}
+ * the tick count is extrapolated from the cycle counter, otherwise it is the
+ * one of the last tick announced to the kernel.
+ */
+int64_t z_time_page_read(int64_t *rt_sec, int32_t *rt_nsec);
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_TIME_PAGE_H_ */
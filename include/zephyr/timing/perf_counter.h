@@ -0,0 +1,87 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_TIMING_PERF_COUNTER_H_
+#define ZEPHYR_INCLUDE_TIMING_PERF_COUNTER_H_
+
+#include <errno.h>
+#include <zephyr/arch/cpu.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Performance counter APIs
+ * @defgroup perf_counter_api Performance counter APIs
+ * @ingroup os_services
+ *
+ * Hardware counters of events such as instructions retired or cache misses.
+ * Counters are per CPU: they are configured on, and read from, the calling
+ * CPU. With CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS the kernel also counts
+ * the events of each thread, see k_thread_perf_counters_get().
+ *
+ * @{
+ */
+
+/**
+ * @brief Get the number of performance counters
+ *
+ * @return Number of counters, at most CONFIG_PERF_COUNTERS_MAX.
+ */
+static inline unsigned int perf_counter_num_get(void)
+{
+	return MIN(arch_perf_counter_num_get(), CONFIG_PERF_COUNTERS_MAX);
+}
+
+/**
+ * @brief Select the event a performance counter counts, and start it
+ *
+ * Counts accumulated by threads are not reset, so counters are best
+ * configured once, before the threads to measure run.
+ *
+ * @param idx Counter number.
+ * @param event Event to count.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if there is no such counter.
+ * @retval -ENOTSUP if the counter can not count the event.
+ */
+static inline int perf_counter_config(unsigned int idx, enum perf_counter_event event)
+{
+	if (idx >= perf_counter_num_get()) {
+		return -EINVAL;
+	}
+
+	return arch_perf_counter_config(idx, event);
+}
+
+/**
+ * @brief Read a performance counter
+ *
+ * The counter wraps around, so only the difference between two reads is
+ * meaningful.
+ *
+ * @param idx Counter number, less than perf_counter_num_get().
+ *
+ * @return Counter value.
+ */
+static inline uint32_t perf_counter_read(unsigned int idx)
+{
+	return arch_perf_counter_read(idx);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_TIMING_PERF_COUNTER_H_ */
@@ -9,4 +9,16 @@
 
 typedef uint64_t timing_t;
 
+/** Events counted by performance counters */
+enum perf_counter_event {
+	/** CPU cycles */
+	PERF_COUNTER_CYCLES,
+	/** Instructions retired */
+	PERF_COUNTER_INSTRUCTIONS,
+	/** Data cache misses, at the level the hardware counts */
+	PERF_COUNTER_CACHE_MISSES,
+	/** Mispredicted branches */
+	PERF_COUNTER_BRANCH_MISSES,
+};
+
 #endif /* ZEPHYR_INCLUDE_TIMING_TYPES_H_ */
@@ -1,4 +1,4 @@
-/* usb_cdc.h - USB CDC-ACM and CDC-ECM public header */
+/* usb_cdc.h - USB CDC-ACM, CDC-ECM and CDC-NCM public header */
 
 /*
  * Copyright (c) 2017 PHYTEC Messtechnik GmbH
@@ -13,9 +13,10 @@
  *
  * Header follows the Class Definitions for
  * Communications Devices Specification (CDC120-20101103-track.pdf),
- * PSTN Devices Specification (PSTN120.pdf) and
- * Ethernet Control Model Devices Specification (ECM120.pdf).
- * Header is limited to ACM and ECM Subclasses.
+ * PSTN Devices Specification (PSTN120.pdf),
+ * Ethernet Control Model Devices Specification (ECM120.pdf) and
+ * Network Control Model Devices Specification (NCM10.pdf).
+ * Header is limited to ACM, ECM and NCM Subclasses.
  */
 
 #ifndef ZEPHYR_INCLUDE_USB_CLASS_USB_CDC_H_
@@ -28,6 +29,7 @@
 #define ACM_SUBCLASS			0x02
 #define ECM_SUBCLASS			0x06
 #define EEM_SUBCLASS			0x0c
+#define NCM_SUBCLASS			0x0d
 
 /** Communications Class Protocol Codes */
 #define AT_CMD_V250_PROTOCOL		0x01
@@ -40,6 +42,12 @@
  */
 #define DATA_INTERFACE_CLASS		0x0A
 
+/**
+ * @brief Data Class Protocol Code of the NCM Data Interface
+ * @note NCM10.pdf, 4.3, Table 4-2
+ */
+#define NCM_DATA_PROTOCOL		0x01
+
 /**
  * @brief bDescriptor SubType for Communications
  * Class Functional Descriptors
@@ -50,6 +58,7 @@
 #define ACM_FUNC_DESC			0x02
 #define UNION_FUNC_DESC			0x06
 #define ETHERNET_FUNC_DESC		0x0F
+#define NCM_FUNC_DESC			0x1A
 
 /**
  * @brief PSTN Subclass Specific Requests
@@ -139,6 +148,34 @@
 #define SET_ETHERNET_PACKET_FILTER	0x43
 #define GET_ETHERNET_STATISTIC		0x44
 
+/**
+ * @brief Class-Specific Request Codes for NCM subclass
+ * @note NCM10.pdf, 6.2, Table 6-2
+ */
+#define GET_NTB_PARAMETERS		0x80
+#define GET_NET_ADDRESS			0x81
+#define SET_NET_ADDRESS			0x82
+#define GET_NTB_FORMAT			0x83
+#define SET_NTB_FORMAT			0x84
+#define GET_NTB_INPUT_SIZE		0x85
+#define SET_NTB_INPUT_SIZE		0x86
+#define GET_MAX_DATAGRAM_SIZE		0x87
+#define SET_MAX_DATAGRAM_SIZE		0x88
+#define GET_CRC_MODE			0x89
+#define SET_CRC_MODE			0x8A
+
+/** NTB formats supported, bmNtbFormatsSupported of NTB Parameter Structure */
+#define NCM_NTB_FORMAT_16		BIT(0)
+#define NCM_NTB_FORMAT_32		BIT(1)
+
+/**
+ * @brief Signatures of the NTB16 headers
+ * @note NCM10.pdf, 3.2.1 and 3.3.1
+ */
+#define NCM_NTH16_SIGNATURE		0x484D434E
+#define NCM_NDP16_SIGNATURE_NOCRC	0x304D434E
+#define NCM_NDP16_SIGNATURE_CRC		0x314D434E
+
 /** Ethernet Packet Filter Bitmap */
 #define PACKET_TYPE_MULTICAST		0x10
 #define PACKET_TYPE_BROADCAST		0x08
@@ -210,4 +247,52 @@ struct cdc_ecm_descriptor {
 	uint8_t bNumberPowerFilters;
 } __packed;
 
+/** NCM Functional Descriptor */
+struct cdc_ncm_descriptor {
+	uint8_t bFunctionLength;
+	uint8_t bDescriptorType;
+	uint8_t bDescriptorSubtype;
+	uint16_t bcdNcmVersion;
+	uint8_t bmNetworkCapabilities;
+} __packed;
+
+/** NTB Parameter Structure, data of GET_NTB_PARAMETERS */
+struct cdc_ncm_ntb_parameters {
+	uint16_t wLength;
+	uint16_t bmNtbFormatsSupported;
+	uint32_t dwNtbInMaxSize;
+	uint16_t wNdpInDivisor;
+	uint16_t wNdpInPayloadRemainder;
+	uint16_t wNdpInAlignment;
+	uint16_t wReserved;
+	uint32_t dwNtbOutMaxSize;
+	uint16_t wNdpOutDivisor;
+	uint16_t wNdpOutPayloadRemainder;
+	uint16_t wNdpOutAlignment;
+	uint16_t wNtbOutMaxDatagrams;
+} __packed;
+
+/** NCM Transfer Header, 16-bit */
+struct cdc_ncm_nth16 {
+	uint32_t dwSignature;
+	uint16_t wHeaderLength;
+	uint16_t wSequence;
+	uint16_t wBlockLength;
+	uint16_t wNdpIndex;
+} __packed;
+
+/** Datagram pointer entry of a 16-bit NCM Datagram Pointer Table */
+struct cdc_ncm_ndp16_datagram {
+	uint16_t wDatagramIndex;
+	uint16_t wDatagramLength;
+} __packed;
+
+/** NCM Datagram Pointer Table, 16-bit */
+struct cdc_ncm_ndp16 {
+	uint32_t dwSignature;
+	uint16_t wLength;
+	uint16_t wNextNdpIndex;
+	struct cdc_ncm_ndp16_datagram datagram[];
+} __packed;
+
 #endif /* ZEPHYR_INCLUDE_USB_CLASS_USB_CDC_H_ */
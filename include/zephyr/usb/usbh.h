@@ -77,7 +77,10 @@ struct usbh_class_data {
 	/** Request completion event handler */
 	int (*request)(struct usbh_contex *const uhs_ctx,
 			struct uhc_transfer *const xfer, int err);
-	/** Device connected handler  */
+	/**
+	 * Device connected handler, called once the device is configured,
+	 * returns 0 if the class implementation bound to the device
+	 */
 	int (*connected)(struct usbh_contex *const uhs_ctx);
 	/** Device removed handler  */
 	int (*removed)(struct usbh_contex *const uhs_ctx);
@@ -43,6 +43,13 @@ struct zbus_channel_data {
 	 */
 	struct k_sem sem;
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+	/** Message sequence counter. Odd while the message is being written, it lets the readers
+	 * copy the message without taking the semaphore.
+	 */
+	atomic_t seq;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 #if defined(CONFIG_ZBUS_PRIORITY_BOOST)
 	/** Highest observer priority. Indicates the priority that the VDED will use to boost the
 	 * notification process avoiding preemptions.
@@ -111,6 +118,17 @@ struct zbus_observer_data {
 	/** Subscriber attached thread priority. */
 	int priority;
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
+
+#if defined(CONFIG_ZBUS_OBSERVER_STATS) || defined(__DOXYGEN__)
+	/** Count of notifications delivered. */
+	uint32_t notify_count;
+
+	/** Longest delivery delay, in cycles. */
+	uint32_t notify_max_cyc;
+
+	/** Sum of the delivery delays, in cycles. */
+	uint64_t notify_total_cyc;
+#endif /* CONFIG_ZBUS_OBSERVER_STATS */
 };
 
 /**
@@ -158,6 +176,10 @@ struct zbus_observer {
 /** @cond INTERNAL_HIDDEN */
 struct zbus_channel_observation_mask {
 	bool enabled;
+#if defined(CONFIG_ZBUS_OBSERVER_PRIORITY_ORDER)
+	/* Already notified in the running VDED */
+	bool notified;
+#endif
 };
 
 struct zbus_channel_observation {
@@ -849,6 +871,50 @@ int zbus_obs_detach_from_thread(const struct zbus_observer *obs);
 
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
 
+#if defined(CONFIG_ZBUS_OBSERVER_STATS) || defined(__DOXYGEN__)
+
+/**
+ * @brief Notification statistics of an observer.
+ *
+ * The delay of a notification is measured from the start of the publication to its delivery: the
+ * end of the callback for a listener, the enqueuing for a subscriber or a msg subscriber.
+ */
+struct zbus_observer_stats {
+	/** Count of notifications delivered. */
+	uint32_t notifications;
+
+	/** Average delivery delay, in nanoseconds. */
+	uint32_t latency_avg_ns;
+
+	/** Longest delivery delay, in nanoseconds. */
+	uint32_t latency_max_ns;
+};
+
+/**
+ * @brief Get the notification statistics of an observer.
+ *
+ * @param[in] obs The observer's reference.
+ * @param[out] stats The statistics.
+ *
+ * @retval 0 Statistics retrieved.
+ * @retval -EFAULT A parameter is incorrect. The function only returns this value when the
+ * CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_obs_get_stats(const struct zbus_observer *obs, struct zbus_observer_stats *stats);
+
+/**
+ * @brief Clear the notification statistics of an observer.
+ *
+ * @param[in] obs The observer's reference.
+ *
+ * @retval 0 Statistics cleared.
+ * @retval -EFAULT A parameter is incorrect. The function only returns this value when the
+ * CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_obs_reset_stats(const struct zbus_observer *obs);
+
+#endif /* CONFIG_ZBUS_OBSERVER_STATS */
+
 /**
  * @brief Wait for a channel notification.
  *
@@ -893,6 +959,33 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
 		      k_timeout_t timeout);
 
+struct net_buf;
+
+/**
+ * @brief Wait for a channel message, without copying it.
+ *
+ * This routine makes the subscriber wait for the new message in case of channel publication,
+ * and gives it the buffer holding the message instead of a copy. The message is at
+ * @c buf->data and is @c buf->len bytes long. It must not be modified, and the buffer must be
+ * released with net_buf_unref() once the message is processed.
+ *
+ * With @kconfig{CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_DYNAMIC}, the message data of a
+ * publication is shared by all the msg subscribers and freed with the last reference.
+ *
+ * @param[in] sub The subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] buf The buffer holding the published message.
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values, K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Could not retrieve the net_buf from the subscriber FIFO.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_sub_wait_msg_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout);
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 /**
@@ -6,6 +6,7 @@
 #include <zephyr/kernel.h>
 #include <ksched.h>
 #include <zephyr/spinlock.h>
+#include <zephyr/sys/math_extras.h>
 
 extern struct k_spinlock _sched_spinlock;
 
@@ -29,6 +30,14 @@ static int cpu_mask_mod(k_tid_t thread, uint32_t enable_mask, uint32_t disable_m
 		if (z_is_thread_prevented_from_running(thread)) {
 			thread->base.cpu_mask |= enable_mask;
 			thread->base.cpu_mask  &= ~disable_mask;
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+			/* Make sure it gets queued on a CPU it may run on */
+			uint32_t m = thread->base.cpu_mask & BIT_MASK(arch_num_cpus());
+
+			if ((m != 0U) && ((m & BIT(thread->base.cpu)) == 0U)) {
+				thread->base.cpu = u32_count_trailing_zeros(m);
+			}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 		} else {
 			ret = -EINVAL;
 		}
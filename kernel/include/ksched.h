@@ -55,6 +55,10 @@ void *z_get_next_switch_handle(void *interrupted);
 
 void z_time_slice(void);
 void z_reset_time_slice(struct k_thread *curr);
+#ifdef CONFIG_SCHED_SPORADIC
+/* Store the priority of a throttled thread as the one to restore, if so */
+bool z_sched_sporadic_prio_set(struct k_thread *thread, int prio);
+#endif /* CONFIG_SCHED_SPORADIC */
 void z_sched_abort(struct k_thread *thread);
 void z_sched_ipi(void);
 void z_sched_start(struct k_thread *thread);
@@ -281,6 +285,22 @@ void z_sched_usage_stop(void);
 
 void z_sched_usage_start(struct k_thread *thread);
 
+/**
+ * @brief Marks the time a thread is made ready to run
+ *
+ * This is called by the scheduler when a pended, sleeping or new thread is
+ * added to the run queue, to measure its scheduling latency.
+ */
+void z_sched_usage_ready(struct k_thread *thread);
+
+/**
+ * @brief Records the end of a run of a thread
+ *
+ * This is called when the current thread is switched out, before
+ * z_sched_usage_stop(), to measure its run length.
+ */
+void z_sched_usage_switch_out(struct k_thread *thread);
+
 /**
  * @brief Retrieves CPU cycle usage data for specified core
  */
@@ -296,6 +316,11 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
 #ifdef CONFIG_SCHED_THREAD_USAGE
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	if (thread != _current) {
+		z_sched_usage_switch_out(_current);
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
 #endif /* CONFIG_SCHED_THREAD_USAGE */
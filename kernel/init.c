@@ -301,6 +301,186 @@ extern volatile uintptr_t __stack_chk_guard;
 __pinned_bss
 bool z_sys_post_kernel;
 
+static void do_device_init(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+	int rc = 0;
+
+	if (entry->init_fn.dev != NULL) {
+		rc = entry->init_fn.dev(dev);
+		/* Mark device initialized. If initialization
+		 * failed, record the error condition.
+		 */
+		if (rc != 0) {
+			if (rc < 0) {
+				rc = -rc;
+			}
+			if (rc > UINT8_MAX) {
+				rc = UINT8_MAX;
+			}
+			dev->state->init_res = rc;
+		}
+	}
+
+	dev->state->initialized = true;
+
+	if (rc == 0) {
+		/* Run automatic device runtime enablement */
+		(void)pm_device_runtime_auto_enable(dev);
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+/* Devices initialized in parallel, contiguous in a level */
+static const struct init_entry *par_init_start, *par_init_end;
+static K_MUTEX_DEFINE(par_init_lock);
+static K_CONDVAR_DEFINE(par_init_done);
+
+static struct k_thread par_init_threads[CONFIG_DEVICE_INIT_PARALLEL_THREADS];
+static K_KERNEL_STACK_ARRAY_DEFINE(par_init_stacks,
+				   CONFIG_DEVICE_INIT_PARALLEL_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+
+/* Whether a device required by a device of the batch is still to be
+ * initialized in the batch. Requirements outside of the batch are
+ * initialized before it, or can't be waited for.
+ */
+static bool par_init_dep_pending(const struct device *dep)
+{
+	const struct init_entry *entry;
+
+	if (dep->state->initialized) {
+		return false;
+	}
+
+	for (entry = par_init_start; entry < par_init_end; entry++) {
+		if (entry->dev == dep) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool par_init_ready(const struct device *dev)
+{
+	const device_handle_t *deps;
+	size_t count = 0;
+
+	deps = device_required_handles_get(dev, &count);
+
+	for (size_t i = 0; i < count; i++) {
+		const struct device *dep = device_from_handle(deps[i]);
+
+		if (dep != NULL && par_init_dep_pending(dep)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Run the device initializations of the batch whose requirements are met,
+ * until all of them are started.
+ */
+static void par_init_run(void *p1, void *p2, void *p3)
+{
+	const struct init_entry *entry, *next;
+	bool all_started;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&par_init_lock, K_FOREVER);
+
+	do {
+		all_started = true;
+		next = NULL;
+
+		for (entry = par_init_start; entry < par_init_end; entry++) {
+			if (entry->dev->state->init_started) {
+				continue;
+			}
+
+			all_started = false;
+
+			if (par_init_ready(entry->dev)) {
+				next = entry;
+				break;
+			}
+		}
+
+		if (next != NULL) {
+			next->dev->state->init_started = true;
+			k_mutex_unlock(&par_init_lock);
+
+			do_device_init(next);
+
+			k_mutex_lock(&par_init_lock, K_FOREVER);
+			k_condvar_broadcast(&par_init_done);
+		} else if (!all_started) {
+			/* Wait for the initialization of another device */
+			k_condvar_wait(&par_init_done, &par_init_lock, K_FOREVER);
+		}
+	} while (!all_started);
+
+	k_mutex_unlock(&par_init_lock);
+}
+
+static void par_init_batch(const struct init_entry *start,
+			   const struct init_entry *end)
+{
+	int num_threads = MIN(end - start - 1,
+			      CONFIG_DEVICE_INIT_PARALLEL_THREADS);
+
+	par_init_start = start;
+	par_init_end = end;
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_create(&par_init_threads[i], par_init_stacks[i],
+				K_KERNEL_STACK_SIZEOF(par_init_stacks[i]),
+				par_init_run, NULL, NULL, NULL,
+				CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&par_init_threads[i], "dev_init");
+	}
+
+	par_init_run(NULL, NULL, NULL);
+
+	/* Every device is started, wait for the others to complete */
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&par_init_threads[i], K_FOREVER);
+	}
+}
+
+/* Devices are split in batches at each non-device init function, which
+ * still sees every device before it initialized.
+ */
+static void par_init_run_level(const struct init_entry *start,
+			       const struct init_entry *end)
+{
+	const struct init_entry *entry, *batch = start;
+
+	for (entry = start; entry <= end; entry++) {
+		if (entry < end && entry->dev != NULL) {
+			continue;
+		}
+
+		if (entry - batch == 1) {
+			do_device_init(batch);
+		} else if (entry > batch) {
+			par_init_batch(batch, entry);
+		}
+
+		if (entry < end) {
+			(void)entry->init_fn.sys();
+		}
+
+		batch = entry + 1;
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -328,34 +508,17 @@ static void z_sys_init_run_level(enum init_level level)
 	};
 	const struct init_entry *entry;
 
-	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
-
-		if (dev != NULL) {
-			int rc = 0;
-
-			if (entry->init_fn.dev != NULL) {
-				rc = entry->init_fn.dev(dev);
-				/* Mark device initialized. If initialization
-				 * failed, record the error condition.
-				 */
-				if (rc != 0) {
-					if (rc < 0) {
-						rc = -rc;
-					}
-					if (rc > UINT8_MAX) {
-						rc = UINT8_MAX;
-					}
-					dev->state->init_res = rc;
-				}
-			}
-
-			dev->state->initialized = true;
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	/* Threads can only be used once the kernel is up */
+	if (level >= INIT_LEVEL_POST_KERNEL) {
+		par_init_run_level(levels[level], levels[level+1]);
+		return;
+	}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
 
-			if (rc == 0) {
-				/* Run automatic device runtime enablement */
-				(void)pm_device_runtime_auto_enable(dev);
-			}
+	for (entry = levels[level]; entry < levels[level+1]; entry++) {
+		if (entry->dev != NULL) {
+			do_device_init(entry);
 		} else {
 			(void)entry->init_fn.sys();
 		}
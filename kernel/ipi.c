@@ -13,30 +13,82 @@ extern void z_trace_sched_ipi(void);
 #endif
 
 
-void flag_ipi(void)
+void flag_ipi(uint32_t ipi_mask)
 {
 #if defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		_kernel.pending_ipi = true;
+		atomic_or(&_kernel.pending_ipi, (atomic_val_t)ipi_mask);
 	}
+#else
+	ARG_UNUSED(ipi_mask);
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
 }
 
+/* Create a mask of the CPUs that need to reschedule now that @p thread is
+ * ready. Without CONFIG_IPI_OPTIMIZE every CPU is flagged.
+ */
+uint32_t ipi_mask_create(struct k_thread *thread)
+{
+	if (!IS_ENABLED(CONFIG_IPI_OPTIMIZE)) {
+		return (CONFIG_MP_MAX_NUM_CPUS > 1) ? IPI_ALL_CPUS_MASK : 0;
+	}
+
+	uint32_t ipi_mask = 0;
+	uint32_t num_cpus = (uint32_t)arch_num_cpus();
+	uint32_t id = _current_cpu->id;
+	struct k_thread *cpu_thread;
+
+	for (uint32_t i = 0; i < num_cpus; i++) {
+		if (id == i) {
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0) {
+			continue;
+		}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+		/* Only a CPU running something the thread may preempt will
+		 * switch to it. A CPU that has not started yet has no
+		 * current thread and picks it up when it does.
+		 */
+		cpu_thread = _kernel.cpus[i].current;
+		if (cpu_thread == NULL) {
+			continue;
+		}
+
+		if (z_is_idle_thread_object(cpu_thread) ||
+		    thread_is_metairq(thread) ||
+		    ((z_sched_prio_cmp(cpu_thread, thread) < 0) &&
+		     thread_is_preemptible(cpu_thread))) {
+			ipi_mask |= BIT(i);
+		}
+	}
+
+	return ipi_mask;
+}
 
 void signal_pending_ipi(void)
 {
 	/* Synchronization note: you might think we need to lock these
 	 * two steps, but an IPI is idempotent.  It's OK if we do it
-	 * twice.  All we require is that if a CPU sees the flag true,
-	 * it is guaranteed to send the IPI, and if a core sets
-	 * pending_ipi, the IPI will be sent the next time through
-	 * this code.
+	 * twice.  All we require is that if a CPU sees a bit set in
+	 * pending_ipi, it is guaranteed to send the IPI, and if a core
+	 * sets a bit, the IPI will be sent the next time through this
+	 * code.
 	 */
 #if defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		if (_kernel.pending_ipi) {
-			_kernel.pending_ipi = false;
+		uint32_t cpu_bitmap;
+
+		cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+		if (cpu_bitmap != 0) {
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+			arch_sched_directed_ipi(cpu_bitmap);
+#else
 			arch_sched_ipi();
+#endif /* CONFIG_ARCH_HAS_DIRECTED_IPIS */
 		}
 	}
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
@@ -8,14 +8,167 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/math_extras.h>
+#include <string.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_K_HEAP_MAGAZINE
+
+/*
+ * Each CPU owns one struct k_heap_magazine per heap, an array of
+ * stacks of free blocks for the size classes (16 << n) bytes. A
+ * magazine is only ever touched by its CPU with interrupts locked, so
+ * the fast paths below need no spinlock. Blocks are filed by their
+ * usable size, which is why refills allocate the full class size.
+ */
+#define MAG_CLASSES CONFIG_K_HEAP_MAGAZINE_CLASSES
+#define MAG_DEPTH CONFIG_K_HEAP_MAGAZINE_DEPTH
+#define MAG_BATCH (MAG_DEPTH / 2)
+#define MAG_MIN_SHIFT 4
+#define MAG_CLASS_BYTES(c) ((size_t)1 << ((c) + MAG_MIN_SHIFT))
+
+/* Smallest class whose blocks can hold the request, or -1 */
+static inline int mag_alloc_class(size_t bytes)
+{
+	if (bytes > MAG_CLASS_BYTES(MAG_CLASSES - 1)) {
+		return -1;
+	}
+
+	if (bytes <= MAG_CLASS_BYTES(0)) {
+		return 0;
+	}
+
+	return (32 - u32_count_leading_zeros((uint32_t)bytes - 1U)) - MAG_MIN_SHIFT;
+}
+
+/* Largest class a block of the given usable size can serve, or -1 */
+static inline int mag_free_class(size_t usable)
+{
+	int c;
+
+	if ((usable < MAG_CLASS_BYTES(0)) ||
+	    (usable >= MAG_CLASS_BYTES(MAG_CLASSES))) {
+		return -1;
+	}
+
+	c = (31 - u32_count_leading_zeros((uint32_t)usable)) - MAG_MIN_SHIFT;
+
+	return c;
+}
+
+/* Returns the magazines of the current CPU, interrupts must be locked */
+static inline struct k_heap_magazine *mag_get(struct k_heap *heap)
+{
+	return &heap->magazines[_current_cpu->id];
+}
+
+/* Must be called with heap->lock held */
+static void mag_drain(struct k_heap *heap, struct k_heap_magazine *mag)
+{
+	for (int c = 0; c < MAG_CLASSES; c++) {
+		while (mag->count[c] > 0U) {
+			sys_heap_free(&heap->heap, mag->blocks[c][--mag->count[c]]);
+		}
+	}
+}
+
+static void *mag_alloc(struct k_heap *heap, size_t bytes)
+{
+	int c = mag_alloc_class(bytes);
+	struct k_heap_magazine *mag;
+	void *ret = NULL;
+	unsigned int key;
+
+	if (c < 0) {
+		return NULL;
+	}
+
+	key = arch_irq_lock();
+	mag = mag_get(heap);
+
+	if (mag->count[c] == 0U) {
+		k_spinlock_key_t k = k_spin_lock(&heap->lock);
+
+		while (mag->count[c] < MAG_BATCH) {
+			void *mem = sys_heap_alloc(&heap->heap, MAG_CLASS_BYTES(c));
+
+			if (mem == NULL) {
+				break;
+			}
+			mag->blocks[c][mag->count[c]++] = mem;
+		}
+
+		k_spin_unlock(&heap->lock, k);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		mag->misses++;
+	} else {
+		mag->hits++;
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+	}
+
+	if (mag->count[c] > 0U) {
+		ret = mag->blocks[c][--mag->count[c]];
+	}
+
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+static bool mag_free(struct k_heap *heap, void *mem)
+{
+	/* The chunk header of a block we own can't change under us, so
+	 * this is safe to read without the heap lock.
+	 */
+	int c = mag_free_class(sys_heap_usable_size(&heap->heap, mem));
+	struct k_heap_magazine *mag;
+	unsigned int key;
+
+	/* Don't hide memory from threads waiting for it.  A thread
+	 * pending concurrently with this check gets woken up by the
+	 * next free going through the heap.
+	 */
+	if ((c < 0) || (IS_ENABLED(CONFIG_MULTITHREADING) &&
+			(z_waitq_head(&heap->wait_q) != NULL))) {
+		return false;
+	}
+
+	key = arch_irq_lock();
+	mag = mag_get(heap);
+
+	if (mag->count[c] == MAG_DEPTH) {
+		/* Hand the oldest half back to the heap */
+		k_spinlock_key_t k = k_spin_lock(&heap->lock);
+
+		for (int i = 0; i < MAG_BATCH; i++) {
+			sys_heap_free(&heap->heap, mag->blocks[c][i]);
+		}
+
+		k_spin_unlock(&heap->lock, k);
+
+		memmove(&mag->blocks[c][0], &mag->blocks[c][MAG_BATCH],
+			(MAG_DEPTH - MAG_BATCH) * sizeof(void *));
+		mag->count[c] -= MAG_BATCH;
+	}
+
+	mag->blocks[c][mag->count[c]++] = mem;
+
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+#endif /* CONFIG_K_HEAP_MAGAZINE */
+
 void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 {
 	z_waitq_init(&heap->wait_q);
 	sys_heap_init(&heap->heap, mem, bytes);
+#ifdef CONFIG_K_HEAP_MAGAZINE
+	memset(heap->magazines, 0, sizeof(heap->magazines));
+#endif /* CONFIG_K_HEAP_MAGAZINE */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
 }
@@ -68,6 +221,18 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_K_HEAP_MAGAZINE
+	/* Magazine blocks are only guaranteed the heap's natural alignment */
+	if (align <= sizeof(void *)) {
+		ret = mag_alloc(heap, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
+			return ret;
+		}
+	}
+#endif /* CONFIG_K_HEAP_MAGAZINE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
@@ -79,6 +244,14 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
 
+#ifdef CONFIG_K_HEAP_MAGAZINE
+		if (ret == NULL) {
+			/* Give this CPU's cached blocks back and retry */
+			mag_drain(heap, mag_get(heap));
+			ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
+		}
+#endif /* CONFIG_K_HEAP_MAGAZINE */
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -118,6 +291,13 @@ void *k_heap_alloc(struct k_heap *heap, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_K_HEAP_MAGAZINE
+	if ((mem != NULL) && mag_free(heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+		return;
+	}
+#endif /* CONFIG_K_HEAP_MAGAZINE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
@@ -361,6 +361,16 @@ static int init_mem_domain_module(void)
 	__ASSERT(ret == 0, "failed to add default libc mem partition");
 #endif /* Z_LIBC_PARTITION_EXISTS */
 
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+#ifdef K_MEM_PARTITION_P_RW_U_RO
+	/* Only the kernel updates the time page */
+	z_time_page_partition.attr = K_MEM_PARTITION_P_RW_U_RO;
+#endif
+	ret = k_mem_domain_add_partition(&k_mem_domain_default,
+					 &z_time_page_partition);
+	__ASSERT(ret == 0, "failed to add time page mem partition");
+#endif /* CONFIG_USERSPACE_TIME_PAGE */
+
 	return 0;
 }
 
@@ -48,11 +48,12 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) *
+			       slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
+	ptr->max_allocated_bytes = k_mem_slab_max_used_get(slab) *
+				   slab->info.block_size;
 #else
 	ptr->max_allocated_bytes = 0;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
@@ -72,7 +73,11 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	key = k_spin_lock(&slab->lock);
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	atomic_set(&slab->info.max_used, atomic_get(&slab->info.num_used));
+#else
 	slab->info.max_used = slab->info.num_used;
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
 	k_spin_unlock(&slab->lock, key);
@@ -92,6 +97,90 @@ static struct k_obj_core_stats_desc mem_slab_stats_desc = {
 #endif /* CONFIG_OBJ_CORE_STATS_MEM_SLAB */
 #endif /* CONFIG_OBJ_CORE_MEM_SLAB */
 
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+/*
+ * The free list is a Treiber stack. Its head word holds the index + 1
+ * of the first free block (0 meaning empty) in the low half and a tag
+ * that is bumped on every update in the high half, so that a stale
+ * head can't be swapped in after the block was taken and returned in
+ * between (ABA). Each free block stores the index + 1 of the next one
+ * in its first word. Pushing onto an empty list always happens with
+ * the slab lock held after checking for waiters, so threads can only
+ * be pending while the list is empty.
+ */
+#define HEAD_IDX_BITS (sizeof(atomic_val_t) * 4)
+#define HEAD_IDX_MASK ((atomic_val_t)BIT_MASK(HEAD_IDX_BITS))
+#define HEAD_TAG_INC  ((atomic_val_t)HEAD_IDX_MASK + 1)
+
+static inline char *block_at(struct k_mem_slab *slab, atomic_val_t idx)
+{
+	return slab->buffer + ((size_t)(idx - 1) * slab->info.block_size);
+}
+
+static inline atomic_val_t block_idx(struct k_mem_slab *slab, void *mem)
+{
+	return (atomic_val_t)(((char *)mem - slab->buffer) / slab->info.block_size) + 1;
+}
+
+static inline atomic_val_t next_head(atomic_val_t head, atomic_val_t idx)
+{
+	return ((head + HEAD_TAG_INC) & ~HEAD_IDX_MASK) | idx;
+}
+
+static char *free_list_pop(struct k_mem_slab *slab)
+{
+	atomic_val_t head, next;
+	char *block;
+
+	do {
+		head = atomic_get(&slab->free_head);
+		if ((head & HEAD_IDX_MASK) == 0) {
+			return NULL;
+		}
+
+		/* The block may be taken and written to concurrently, in
+		 * which case the link read here is garbage but the CAS
+		 * below fails because the tag has moved on.
+		 */
+		block = block_at(slab, head & HEAD_IDX_MASK);
+		next = next_head(head, *(volatile atomic_val_t *)block & HEAD_IDX_MASK);
+	} while (!atomic_cas(&slab->free_head, head, next));
+
+	atomic_val_t used = atomic_inc(&slab->info.num_used) + 1;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_val_t max = atomic_get(&slab->info.max_used);
+
+	while ((used > max) && !atomic_cas(&slab->info.max_used, max, used)) {
+		max = atomic_get(&slab->info.max_used);
+	}
+#else
+	ARG_UNUSED(used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+
+	return block;
+}
+
+/* Fails without pushing if only_if_busy is set and the list is empty */
+static bool free_list_push(struct k_mem_slab *slab, void *mem, bool only_if_busy)
+{
+	atomic_val_t head;
+
+	do {
+		head = atomic_get(&slab->free_head);
+		if (only_if_busy && ((head & HEAD_IDX_MASK) == 0)) {
+			return false;
+		}
+		*(atomic_val_t *)mem = head & HEAD_IDX_MASK;
+	} while (!atomic_cas(&slab->free_head, head,
+			     next_head(head, block_idx(slab, mem))));
+
+	atomic_dec(&slab->info.num_used);
+
+	return true;
+}
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
+
 /**
  * @brief Initialize kernel memory slab subsystem.
  *
@@ -112,6 +201,22 @@ static int create_free_list(struct k_mem_slab *slab)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	CHECKIF(slab->info.num_blocks >= (uint32_t)HEAD_IDX_MASK) {
+		return -EINVAL;
+	}
+
+	atomic_val_t head = 0;
+
+	p = slab->buffer;
+
+	for (j = 0U; j < slab->info.num_blocks; j++) {
+		*(atomic_val_t *)p = head;
+		head = (atomic_val_t)j + 1;
+		p += slab->info.block_size;
+	}
+	atomic_set(&slab->free_head, head);
+#else
 	slab->free_list = NULL;
 	p = slab->buffer;
 
@@ -120,6 +225,7 @@ static int create_free_list(struct k_mem_slab *slab)
 		slab->free_list = p;
 		p += slab->info.block_size;
 	}
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 	return 0;
 }
 
@@ -207,11 +313,30 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	char *block = free_list_pop(slab);
+
+	if (block != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		*mem = block;
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	/* Someone may have freed a block since the attempt above */
+	block = free_list_pop(slab);
+	if (block != NULL) {
+		*mem = block;
+		result = 0;
+	} else
+#else
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -224,7 +349,9 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
 		result = 0;
-	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+	} else
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
 		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
 		/* don't wait for a free block to become available */
 		*mem = NULL;
@@ -252,16 +379,30 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
-
 	__ASSERT(((char *)mem >= slab->buffer) &&
 		 ((((char *)mem - slab->buffer) % slab->info.block_size) == 0) &&
 		 ((char *)mem <= (slab->buffer + (slab->info.block_size *
 						  (slab->info.num_blocks - 1)))),
 		 "Invalid memory pointer provided");
 
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	/* Nobody can be waiting while there are free blocks */
+	if (free_list_push(slab, mem, true)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
+
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	if (((atomic_get(&slab->free_head) & HEAD_IDX_MASK) == 0) &&
+	    IS_ENABLED(CONFIG_MULTITHREADING)) {
+#else
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
 		if (pending_thread != NULL) {
@@ -273,9 +414,13 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 			return;
 		}
 	}
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	(void)free_list_push(slab, mem, false);
+#else
 	*(char **) mem = slab->free_list;
 	slab->free_list = (char *) mem;
 	slab->info.num_used--;
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
@@ -289,12 +434,13 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = k_mem_slab_num_used_get(slab);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = num_used * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - num_used) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	stats->max_allocated_bytes = slab->info.max_used *
+	stats->max_allocated_bytes = k_mem_slab_max_used_get(slab) *
 				     slab->info.block_size;
 #else
 	stats->max_allocated_bytes = 0;
@@ -314,7 +460,11 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	atomic_set(&slab->info.max_used, atomic_get(&slab->info.num_used));
+#else
 	slab->info.max_used = slab->info.num_used;
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 
 	k_spin_unlock(&slab->lock, key);
 
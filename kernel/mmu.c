@@ -298,6 +298,15 @@ static void *virt_region_alloc(size_t size, size_t align)
 	num_bits = (size + align - CONFIG_MMU_PAGE_SIZE) / CONFIG_MMU_PAGE_SIZE;
 	alloc_size = num_bits * CONFIG_MMU_PAGE_SIZE;
 	ret = sys_bitarray_alloc(&virt_region_bitmap, num_bits, &offset);
+	if (ret != 0 && align > CONFIG_MMU_PAGE_SIZE) {
+		/* The alignment only lets the architecture use larger block
+		 * mappings, fall back to page alignment rather than failing.
+		 */
+		align = CONFIG_MMU_PAGE_SIZE;
+		num_bits = size / CONFIG_MMU_PAGE_SIZE;
+		alloc_size = size;
+		ret = sys_bitarray_alloc(&virt_region_bitmap, num_bits, &offset);
+	}
 	if (ret != 0) {
 		LOG_ERR("insufficient virtual address space (requested %zu)",
 			size);
@@ -1334,10 +1343,46 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+#ifdef CONFIG_DEMAND_PAGING_STATS
+/* Ring of the virtual addresses of the last evicted pages */
+static void *paging_stats_evicted[CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW];
+static size_t paging_stats_evicted_next;
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
+static inline void paging_stats_refault_check(struct k_thread *faulting_thread,
+					      void *addr)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	void *page = (void *)ROUND_DOWN(addr, CONFIG_MMU_PAGE_SIZE);
+
+	ARRAY_FOR_EACH(paging_stats_evicted, i) {
+		if (paging_stats_evicted[i] != page) {
+			continue;
+		}
+
+		/* Count a refault only once per eviction */
+		paging_stats_evicted[i] = NULL;
+		paging_stats.pagefaults.refault++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+		faulting_thread->paging_stats.pagefaults.refault++;
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+		break;
+	}
+#else
+	ARG_UNUSED(faulting_thread);
+	ARG_UNUSED(addr);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
+					     struct z_page_frame *pf,
 					     bool dirty)
 {
 #ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats_evicted[paging_stats_evicted_next] = pf->addr;
+	paging_stats_evicted_next = (paging_stats_evicted_next + 1) %
+				    ARRAY_SIZE(paging_stats_evicted);
+
 	if (dirty) {
 		paging_stats.eviction.dirty++;
 	} else {
@@ -1352,6 +1397,8 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #else
 	ARG_UNUSED(faulting_thread);
 #endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#else
+	ARG_UNUSED(pf);
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
@@ -1389,7 +1436,7 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+static bool do_page_fault(void *addr, bool pin, bool read_ahead)
 {
 	struct z_page_frame *pf;
 	int key, ret;
@@ -1468,7 +1515,10 @@ static bool do_page_fault(void *addr, bool pin)
 	__ASSERT(status == ARCH_PAGE_LOCATION_PAGED_OUT,
 		 "unexpected status value %d", status);
 
-	paging_stats_faults_inc(faulting_thread, key);
+	if (!read_ahead) {
+		paging_stats_faults_inc(faulting_thread, key);
+		paging_stats_refault_check(faulting_thread, addr);
+	}
 
 	pf = free_page_frame_list_get();
 	if (pf == NULL) {
@@ -1478,7 +1528,7 @@ static bool do_page_fault(void *addr, bool pin)
 		LOG_DBG("evicting %p at 0x%lx", pf->addr,
 			z_page_frame_to_phys(pf));
 
-		paging_stats_eviction_inc(faulting_thread, dirty);
+		paging_stats_eviction_inc(faulting_thread, pf, dirty);
 	}
 	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
 	__ASSERT(ret == 0, "failed to prepare page frame");
@@ -1521,7 +1571,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1538,7 +1588,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1551,9 +1601,76 @@ void k_mem_pin(void *addr, size_t size)
 	virt_region_foreach(addr, size, do_mem_pin);
 }
 
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+/* Page of the last page fault, to detect sequential access */
+static uint8_t *last_fault_page;
+
+/* On sequential access, the data pages following the faulting one are
+ * likely accessed next. Page them in while the backing store is being
+ * accessed already, instead of taking one page fault for each of them.
+ */
+static void page_fault_read_ahead(void *addr)
+{
+	uint8_t *page = (uint8_t *)ROUND_DOWN(addr, CONFIG_MMU_PAGE_SIZE);
+	bool sequential = (page == last_fault_page + CONFIG_MMU_PAGE_SIZE);
+	struct z_page_frame *pf = NULL;
+	unsigned int key;
+	uintptr_t phys;
+
+	last_fault_page = page;
+
+	/* Keep the time spent with interrupts locked bounded in ISRs */
+	if (!sequential || k_is_in_isr()) {
+		return;
+	}
+
+	/* The faulting data page is not accessed yet, make sure it is not
+	 * evicted to make room for the following ones.
+	 */
+	key = irq_lock();
+	if ((arch_page_info_get(page, &phys, false) &
+	     ARCH_DATA_PAGE_LOADED) != 0U) {
+		pf = z_phys_to_page_frame(phys);
+		if (z_page_frame_is_pinned(pf)) {
+			pf = NULL;
+		} else {
+			pf->flags |= Z_PAGE_FRAME_PINNED;
+		}
+	}
+	irq_unlock(key);
+
+	for (int i = 1; i <= CONFIG_DEMAND_PAGING_READ_AHEAD; i++) {
+		page += CONFIG_MMU_PAGE_SIZE;
+
+		/* Stop at the end of the mapped region */
+		if (page >= Z_VIRT_RAM_END ||
+		    !do_page_fault(page, false, true)) {
+			break;
+		}
+
+		/* The next fault is sequential if it follows the read-ahead */
+		last_fault_page = page;
+	}
+
+	if (pf != NULL) {
+		key = irq_lock();
+		pf->flags &= ~Z_PAGE_FRAME_PINNED;
+		irq_unlock(key);
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+
 bool z_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	bool ret = do_page_fault(addr, false, false);
+
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	if (ret) {
+		page_fault_read_ahead(addr);
+	}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+
+	return ret;
 }
 
 static void do_mem_unpin(void *addr)
@@ -133,7 +133,10 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIMED) != 0U) {
+		/* the claimed slot is the one to be written next */
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
 		if (pending_thread != NULL) {
@@ -225,7 +228,10 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
-	if (msgq->used_msgs > 0U) {
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIMED) != 0U) {
+		/* the claimed message is the one to be read next */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
 		msgq->read_ptr += msgq->msg_size;
@@ -373,6 +379,286 @@ static inline int z_vrfy_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_
 #include <syscalls/k_msgq_peek_at_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static void msgq_write_advance(struct k_msgq *msgq, uint32_t num_msgs)
+{
+	msgq->write_ptr += num_msgs * msgq->msg_size;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs += num_msgs;
+}
+
+static void msgq_read_advance(struct k_msgq *msgq, uint32_t num_msgs)
+{
+	msgq->read_ptr += num_msgs * msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs -= num_msgs;
+}
+
+/* Move the messages of threads waiting to write into the freed slots */
+static bool msgq_fill_from_writers(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	bool woken = false;
+
+	while (msgq->used_msgs < msgq->max_msgs) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+			     msgq->msg_size);
+		msgq_write_advance(msgq, 1);
+
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
+int k_msgq_put_claim(struct k_msgq *msgq, void **slot)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIMED) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
+		__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
+				msgq->write_ptr < msgq->buffer_end);
+		msgq->flags |= K_MSGQ_FLAG_PUT_CLAIMED;
+		*slot = msgq->write_ptr;
+		result = 0;
+	} else {
+		result = -ENOMSG;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_put_finish(struct k_msgq *msgq, bool commit)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIMED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_PUT_CLAIMED;
+
+	if (!commit) {
+		k_spin_unlock(&msgq->lock, key);
+		return 0;
+	}
+
+	/* The queue had room when the slot was claimed and no put has been
+	 * done since, so only threads waiting to read can be pending.
+	 */
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		/* give message to waiting thread */
+		(void)memcpy(pending_thread->base.swap_data, msgq->write_ptr,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		z_reschedule(&msgq->lock, key);
+		return 0;
+	}
+
+	msgq_write_advance(msgq, 1);
+#ifdef CONFIG_POLL
+	handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return 0;
+}
+
+int k_msgq_get_claim(struct k_msgq *msgq, void **slot)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIMED) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
+		msgq->flags |= K_MSGQ_FLAG_GET_CLAIMED;
+		*slot = msgq->read_ptr;
+		result = 0;
+	} else {
+		result = -ENOMSG;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_get_finish(struct k_msgq *msgq, bool consume)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	/* The claim is dropped if the queue was purged meanwhile */
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIMED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_GET_CLAIMED;
+
+	if (consume) {
+		msgq_read_advance(msgq, 1);
+
+		if (msgq_fill_from_writers(msgq)) {
+			z_reschedule(&msgq->lock, key);
+			return 0;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return 0;
+}
+
+int z_impl_k_msgq_put_n(struct k_msgq *msgq, const void *data, uint32_t num_msgs)
+{
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	uint32_t chunk;
+	bool woken = false;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIMED) != 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EBUSY;
+	}
+
+	/* Threads only wait to read while the queue is empty */
+	while (count < num_msgs && msgq->used_msgs == 0U) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		/* give message to waiting thread */
+		(void)memcpy(pending_thread->base.swap_data, src, msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		woken = true;
+
+		src += msgq->msg_size;
+		count++;
+	}
+
+	/* Copy the rest in at most two runs, before and after the wrap */
+	while (count < num_msgs && msgq->used_msgs < msgq->max_msgs) {
+		chunk = MIN(num_msgs - count, msgq->max_msgs - msgq->used_msgs);
+		chunk = MIN(chunk, (msgq->buffer_end - msgq->write_ptr) /
+				   msgq->msg_size);
+
+		(void)memcpy(msgq->write_ptr, src, chunk * msgq->msg_size);
+		msgq_write_advance(msgq, chunk);
+
+		src += chunk * msgq->msg_size;
+		count += chunk;
+	}
+
+#ifdef CONFIG_POLL
+	if (msgq->used_msgs > 0U) {
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+	}
+#endif /* CONFIG_POLL */
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_n(struct k_msgq *msgq, const void *data,
+				      uint32_t num_msgs)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_n(msgq, data, num_msgs);
+}
+#include <syscalls/k_msgq_put_n_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_msgq_get_n(struct k_msgq *msgq, void *data, uint32_t num_msgs)
+{
+	char *dst = data;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	uint32_t chunk;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIMED) != 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EBUSY;
+	}
+
+	/* Copy out in at most two runs, before and after the wrap */
+	while (count < num_msgs && msgq->used_msgs > 0U) {
+		chunk = MIN(num_msgs - count, msgq->used_msgs);
+		chunk = MIN(chunk, (msgq->buffer_end - msgq->read_ptr) /
+				   msgq->msg_size);
+
+		(void)memcpy(dst, msgq->read_ptr, chunk * msgq->msg_size);
+		msgq_read_advance(msgq, chunk);
+
+		dst += chunk * msgq->msg_size;
+		count += chunk;
+	}
+
+	if (count > 0U && msgq_fill_from_writers(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_n(struct k_msgq *msgq, void *data,
+				      uint32_t num_msgs)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_n(msgq, data, num_msgs);
+}
+#include <syscalls/k_msgq_get_n_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
@@ -390,6 +676,7 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+	msgq->flags &= ~K_MSGQ_FLAG_GET_CLAIMED;
 
 	z_reschedule(&msgq->lock, key);
 }
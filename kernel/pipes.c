@@ -113,6 +113,8 @@ void z_impl_k_pipe_flush(struct k_pipe *pipe)
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIMED;
+
 	(void) pipe_get_internal(key, pipe, NULL, (size_t) -1, &bytes_read, 0U,
 				 K_NO_WAIT);
 
@@ -138,6 +140,7 @@ void z_impl_k_pipe_buffer_flush(struct k_pipe *pipe)
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
 	if (pipe->buffer != NULL) {
+		pipe->flags &= ~K_PIPE_FLAG_GET_CLAIMED;
 		(void) pipe_get_internal(key, pipe, NULL, pipe->size,
 					 &bytes_read, 0U, K_NO_WAIT);
 	} else {
@@ -184,7 +187,8 @@ int k_pipe_cleanup(struct k_pipe *pipe)
 		pipe->bytes_used = 0U;
 		pipe->read_index = 0U;
 		pipe->write_index = 0U;
-		pipe->flags &= ~K_PIPE_FLAG_ALLOC;
+		pipe->flags &= ~(K_PIPE_FLAG_ALLOC | K_PIPE_FLAG_PUT_CLAIMED |
+				 K_PIPE_FLAG_GET_CLAIMED);
 	}
 
 	k_spin_unlock(&pipe->lock, key);
@@ -346,6 +350,17 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 		src->buffer         += bytes_copied;
 		src->bytes_to_xfer  -= bytes_copied;
 
+		if (src->thread == NULL) {
+
+			/* Reading from the pipe buffer. Update details. */
+
+			pipe->bytes_used -= bytes_copied;
+			pipe->read_index += bytes_copied;
+			if (pipe->read_index >= pipe->size) {
+				pipe->read_index -= pipe->size;
+			}
+		}
+
 		if (dest->thread == NULL) {
 
 			/* Writing to the pipe buffer. Update details. */
@@ -377,6 +392,67 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	return num_bytes_written;
 }
 
+/**
+ * @brief Refill the pipe buffer from the waiting writer(s)
+ */
+static void pipe_buffer_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	sys_dlist_t         src_list;
+	sys_dlist_t         pipe_list;
+
+	/* The free space is being written in place */
+	if ((pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) != 0U) {
+		return;
+	}
+
+	if (pipe->bytes_used == pipe->size) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&src_list,
+					 &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	(void) pipe_write(pipe, &src_list, &pipe_list, reschedule);
+}
+
+/**
+ * @brief Copy data from the pipe buffer to the waiting reader(s)
+ */
+static void pipe_buffer_drain(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	sys_dlist_t         dest_list;
+	sys_dlist_t         pipe_list;
+
+	if (pipe->bytes_used == 0U) {
+		return;
+	}
+
+	sys_dlist_init(&dest_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&dest_list,
+					 &pipe->wait_q.readers,
+					 pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->read_index,
+					 pipe->write_index);
+
+	(void) pipe_write(pipe, &pipe_list, &dest_list, reschedule);
+}
+
 int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 		      size_t bytes_to_write, size_t *bytes_written,
 		      size_t min_xfer, k_timeout_t timeout)
@@ -406,6 +482,16 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if ((pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0U;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe,
+					       timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	/*
 	 * First, write to any waiting readers, if any exist.
 	 * Second, write to the pipe buffer, if it exists.
@@ -625,29 +711,12 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
-
-		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
-		 */
-
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
+	/*
+	 * The pipe is not full. If there are any waiting writers,
+	 * refill the pipe.
+	 */
 
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
-
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
-	}
+	pipe_buffer_refill(pipe, &reschedule_needed);
 
 	/*
 	 * The immediate success conditions below are backwards
@@ -713,6 +782,16 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if ((pipe->flags & K_PIPE_FLAG_GET_CLAIMED) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0U;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe,
+					       timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	int ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
 				    min_xfer, timeout);
 
@@ -810,6 +889,159 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 #include <syscalls/k_pipe_write_avail_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Contiguous free space that follows the data in the buffer */
+static size_t pipe_put_room(struct k_pipe *pipe)
+{
+	if (pipe->bytes_used == pipe->size) {
+		return 0U;
+	}
+
+	if (pipe->write_index < pipe->read_index) {
+		return pipe->read_index - pipe->write_index;
+	}
+
+	return pipe->size - pipe->write_index;
+}
+
+/* Contiguous data at the start of the buffer */
+static size_t pipe_get_room(struct k_pipe *pipe)
+{
+	if (pipe->bytes_used == 0U) {
+		return 0U;
+	}
+
+	if (pipe->read_index < pipe->write_index) {
+		return pipe->write_index - pipe->read_index;
+	}
+
+	return pipe->size - pipe->read_index;
+}
+
+int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) != 0U) {
+		result = -EBUSY;
+	} else if (pipe_put_room(pipe) != 0U) {
+		pipe->flags |= K_PIPE_FLAG_PUT_CLAIMED;
+		*data = &pipe->buffer[pipe->write_index];
+		*size = pipe_put_room(pipe);
+		result = 0;
+	} else {
+		result = -ENOMSG;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return result;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t bytes)
+{
+	k_spinlock_key_t key;
+	bool reschedule_needed = false;
+
+	key = k_spin_lock(&pipe->lock);
+
+	/* Reads only grow the claimed region, it can be checked against now */
+	if (((pipe->flags & K_PIPE_FLAG_PUT_CLAIMED) == 0U) ||
+	    (bytes > pipe_put_room(pipe))) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_PUT_CLAIMED;
+
+	if (bytes != 0U) {
+		pipe->bytes_used += bytes;
+		pipe->write_index += bytes;
+		if (pipe->write_index >= pipe->size) {
+			pipe->write_index -= pipe->size;
+		}
+
+		pipe_buffer_drain(pipe, &reschedule_needed);
+
+		if (pipe->bytes_used != 0U) {
+			handle_poll_events(pipe);
+		}
+	}
+
+	/* Reads done meanwhile did not refill the buffer */
+	pipe_buffer_refill(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->flags & K_PIPE_FLAG_GET_CLAIMED) != 0U) {
+		result = -EBUSY;
+	} else if (pipe_get_room(pipe) != 0U) {
+		pipe->flags |= K_PIPE_FLAG_GET_CLAIMED;
+		*data = &pipe->buffer[pipe->read_index];
+		*size = pipe_get_room(pipe);
+		result = 0;
+	} else {
+		result = -ENOMSG;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return result;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t bytes)
+{
+	k_spinlock_key_t key;
+	bool reschedule_needed = false;
+
+	key = k_spin_lock(&pipe->lock);
+
+	/* The claim is dropped if the pipe was flushed meanwhile. Writes only
+	 * grow the claimed region, it can be checked against now.
+	 */
+	if (((pipe->flags & K_PIPE_FLAG_GET_CLAIMED) == 0U) ||
+	    (bytes > pipe_get_room(pipe))) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIMED;
+
+	if (bytes != 0U) {
+		pipe->bytes_used -= bytes;
+		pipe->read_index += bytes;
+		if (pipe->read_index >= pipe->size) {
+			pipe->read_index -= pipe->size;
+		}
+
+		pipe_buffer_refill(pipe, &reschedule_needed);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
 #ifdef CONFIG_OBJ_CORE_PIPE
 static int init_pipe_obj_core_list(void)
 {
@@ -35,10 +35,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static void signal_set(struct k_poll_event *event);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -114,8 +115,12 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* Poll sets have no thread to order them by, they queue behind the
+	 * threads already polling the object.
+	 */
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
+	if ((pending == NULL) || (poller->mode == MODE_SET) ||
+		(pending->poller->mode == MODE_SET) ||
 		(z_sched_prio_cmp(poller_thread(pending->poller),
 							   poller_thread(poller)) > 0)) {
 		sys_dlist_append(events, &event->_node);
@@ -123,8 +128,9 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if ((pending->poller->mode != MODE_SET) &&
+		    (z_sched_prio_cmp(poller_thread(poller),
+				      poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -443,6 +449,17 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+	if (poller != NULL && poller->mode == MODE_SET) {
+		/* The object dropped the event from its list, keep it
+		 * registered for the next waits on the set.
+		 */
+		event->state |= state;
+		register_event(event, poller);
+		signal_set(event);
+
+		return 0;
+	}
+
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -813,3 +830,116 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+static void signal_set(struct k_poll_event *event)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+
+	if (set->poller.is_polling) {
+		set->poller.is_polling = false;
+		(void)z_sched_wake(&set->wait_q, 0, NULL);
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set, struct k_poll_event *events,
+		     int num_events)
+{
+	__ASSERT(events != NULL || num_events == 0, "NULL events\n");
+	__ASSERT(num_events >= 0, "<0 events\n");
+
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	set->events = events;
+	set->num_events = num_events;
+	z_waitq_init(&set->wait_q);
+
+	for (int ii = 0; ii < num_events; ii++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		register_event(&events[ii], &set->poller);
+		k_spin_unlock(&lock, key);
+	}
+}
+
+/* must be called with interrupts locked */
+static int collect_set_events(struct k_poll_set *set,
+			      struct k_poll_event **ready, int max_ready)
+{
+	int num_ready = 0;
+
+	for (int ii = 0; ii < set->num_events && num_ready < max_ready; ii++) {
+		struct k_poll_event *event = &set->events[ii];
+		uint32_t state;
+
+		/* Also report the conditions still met from earlier */
+		if (event->state == K_POLL_STATE_NOT_READY &&
+		    is_condition_met(event, &state)) {
+			event->state = state;
+		}
+
+		if (event->state != K_POLL_STATE_NOT_READY) {
+			ready[num_ready++] = event;
+		}
+	}
+
+	return num_ready;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int num_ready;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(ready != NULL && max_ready > 0, "no room for events\n");
+
+	key = k_spin_lock(&lock);
+
+	__ASSERT(!set->poller.is_polling, "set already waited on\n");
+
+	for (;;) {
+		num_ready = collect_set_events(set, ready, max_ready);
+		if (num_ready > 0) {
+			break;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			num_ready = -EAGAIN;
+			break;
+		}
+
+		set->poller.is_polling = true;
+		ret = z_pend_curr(&lock, key, &set->wait_q, timeout);
+		key = k_spin_lock(&lock);
+		set->poller.is_polling = false;
+
+		if (ret == -EAGAIN) {
+			/* Take what got ready while timing out */
+			num_ready = collect_set_events(set, ready, max_ready);
+			if (num_ready == 0) {
+				num_ready = -EAGAIN;
+			}
+			break;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return num_ready;
+}
+
+void k_poll_set_release(struct k_poll_set *set)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(!set->poller.is_polling, "set still waited on\n");
+
+	clear_event_registrations(set->events, set->num_events, key);
+	set->num_events = 0;
+	k_spin_unlock(&lock, key);
+}
@@ -133,6 +133,11 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	/* Threads are queued where they last ran, see next_up() and
+	 * cpu_mask_mod().  It can't change while the thread is queued.
+	 */
+	return &_kernel.cpus[thread->base.cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -141,11 +146,11 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
@@ -160,7 +165,34 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Prefer the local queue, but steal from another CPU's queue
+	 * when it holds a thread of strictly higher priority that may
+	 * run here (the CPU mask, if any, is applied by the backend's
+	 * best function).  This keeps the global priority order intact
+	 * while only ever touching remote queues to peek at their head.
+	 */
+	struct k_thread *best = _priq_run_best(curr_cpu_runq());
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct k_thread *thread;
+
+		if (i == _current_cpu->id) {
+			continue;
+		}
+
+		thread = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if ((thread != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -311,6 +343,11 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 		dequeue_thread(thread);
 	}
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Requeue it here when it gets preempted or wakes up again */
+	thread->base.cpu = _current_cpu->id;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	_current_cpu->swap_ok = false;
 	return thread;
 #endif /* CONFIG_SMP */
@@ -411,9 +448,12 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+		z_sched_usage_ready(thread);
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 		queue_thread(thread);
 		update_cache(0);
-		flag_ipi();
+		flag_ipi(ipi_mask_create(thread));
 	}
 }
 
@@ -487,7 +527,9 @@ static void z_thread_halt(struct k_thread *thread, k_spinlock_key_t key,
 		/* We might spin to wait, so a true synchronous IPI is needed
 		 * here, not deferred!
 		 */
-#ifdef CONFIG_SCHED_IPI_SUPPORTED
+#if defined(CONFIG_SCHED_IPI_SUPPORTED) && defined(CONFIG_ARCH_HAS_DIRECTED_IPIS)
+		arch_sched_directed_ipi(IPI_CPU_MASK(thread->base.cpu));
+#elif defined(CONFIG_SCHED_IPI_SUPPORTED)
 		arch_sched_ipi();
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
 	}
@@ -772,8 +814,15 @@ bool z_thread_prio_set(struct k_thread *thread, int prio)
 				dequeue_thread(thread);
 				thread->base.prio = prio;
 				queue_thread(thread);
+
+				flag_ipi(ipi_mask_create(thread));
 			} else {
 				thread->base.prio = prio;
+
+				/* Its CPU may now have better to run */
+				if (thread_active_elsewhere(thread)) {
+					flag_ipi(IPI_CPU_MASK(thread->base.cpu));
+				}
 			}
 			update_cache(1);
 		} else {
@@ -1006,7 +1055,7 @@ void init_ready_q(struct _ready_q *ready_q)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(ready_q->runq.queues); i++) {
 		sys_dlist_init(&ready_q->runq.queues[i]);
 	}
 #else
@@ -1016,13 +1065,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1034,9 +1083,15 @@ void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
 	Z_ASSERT_VALID_PRIO(prio, NULL);
 	__ASSERT(!arch_is_in_isr(), "");
 
+#ifdef CONFIG_SCHED_SPORADIC
+	/* A throttled thread gets the priority once replenished */
+	if (z_sched_sporadic_prio_set((struct k_thread *)thread, prio)) {
+		return;
+	}
+#endif /* CONFIG_SCHED_SPORADIC */
+
 	bool need_sched = z_thread_prio_set((struct k_thread *)thread, prio);
 
-	flag_ipi();
 	if (need_sched && _current->base.sched_locked == 0U) {
 		z_reschedule_unlocked();
 	}
@@ -1347,6 +1402,9 @@ static void halt_thread(struct k_thread *thread, uint8_t new_state)
 				unpend_thread_no_timeout(thread);
 			}
 			(void)z_abort_thread_timeout(thread);
+#ifdef CONFIG_SCHED_SPORADIC
+			(void)z_abort_timeout(&thread->base.ss_replenish);
+#endif /* CONFIG_SCHED_SPORADIC */
 			unpend_all(&thread->join_queue);
 		}
 #ifdef CONFIG_SMP
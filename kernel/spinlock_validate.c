@@ -38,3 +38,28 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l)
 	return arch_mem_coherent((void *)l);
 }
 #endif /* CONFIG_KERNEL_COHERENCE */
+
+#ifdef CONFIG_SPIN_LOCK_STATS
+void k_spin_stats_get(struct k_spinlock *l, struct k_spinlock_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(l);
+
+	/* Not counting this acquisition */
+	stats->acquired = l->acquired - 1U;
+	stats->contended = l->contended;
+	stats->spins = l->spins;
+
+	k_spin_unlock(l, key);
+}
+
+void k_spin_stats_reset(struct k_spinlock *l)
+{
+	k_spinlock_key_t key = k_spin_lock(l);
+
+	l->acquired = 0U;
+	l->contended = 0U;
+	l->spins = 0U;
+
+	k_spin_unlock(l, key);
+}
+#endif /* CONFIG_SPIN_LOCK_STATS */
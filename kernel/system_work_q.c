@@ -17,6 +17,17 @@
 static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
 			     CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
 
+#if defined(CONFIG_SYSTEM_WORKQUEUE_THREADS) && (CONFIG_SYSTEM_WORKQUEUE_THREADS > 1)
+#define SYS_WORK_Q_WORKERS (CONFIG_SYSTEM_WORKQUEUE_THREADS - 1)
+
+static K_KERNEL_STACK_ARRAY_DEFINE(sys_work_q_worker_stacks, SYS_WORK_Q_WORKERS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+
+static struct k_work_q_worker sys_work_q_workers[SYS_WORK_Q_WORKERS];
+#else
+#define SYS_WORK_Q_WORKERS 0
+#endif
+
 struct k_work_q k_sys_work_q;
 
 static int k_sys_work_q_init(void)
@@ -30,6 +41,16 @@ static int k_sys_work_q_init(void)
 			    sys_work_q_stack,
 			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+
+#if SYS_WORK_Q_WORKERS > 0
+	for (int i = 0; i < SYS_WORK_Q_WORKERS; i++) {
+		k_work_queue_add_worker(&k_sys_work_q, &sys_work_q_workers[i],
+					sys_work_q_worker_stacks[i],
+					K_KERNEL_STACK_SIZEOF(sys_work_q_worker_stacks[i]),
+					CONFIG_SYSTEM_WORKQUEUE_PRIORITY, -1);
+	}
+#endif
+
 	return 0;
 }
 
@@ -725,6 +725,7 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 #ifdef CONFIG_SMP
 	thread_base->is_idle = 0;
+	thread_base->cpu = 0U;
 #endif /* CONFIG_SMP */
 
 #ifdef CONFIG_TIMESLICE_PER_THREAD
@@ -732,6 +733,12 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->slice_expired = NULL;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_SCHED_SPORADIC
+	thread_base->ss_budget = 0;
+	thread_base->ss_throttled = false;
+	z_init_timeout(&thread_base->ss_replenish);
+#endif /* CONFIG_SCHED_SPORADIC */
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -893,6 +900,9 @@ void z_thread_mark_switched_in(void)
 void z_thread_mark_switched_out(void)
 {
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	z_sched_usage_switch_out(_current);
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 	z_sched_usage_stop();
 #endif /*CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
@@ -0,0 +1,111 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/app_memory/app_memdomain.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/time_page.h>
+
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+typedef uint64_t time_page_cycles_t;
+#define time_page_cycles() k_cycle_get_64()
+#else
+typedef uint32_t time_page_cycles_t;
+#define time_page_cycles() k_cycle_get_32()
+#endif
+
+struct z_time_page {
+	/* Odd while the page is being updated */
+	volatile uint32_t seq;
+	/* Cycles per tick, 0 until the first update */
+	uint32_t cyc_per_tick;
+	/* Tick count and cycle counter at the last update */
+	uint64_t ticks;
+	time_page_cycles_t cycles;
+	/* Realtime clock base */
+	int64_t rt_sec;
+	int32_t rt_nsec;
+};
+
+K_APPMEM_PARTITION_DEFINE(z_time_page_partition);
+
+static K_APP_BMEM(z_time_page_partition) struct z_time_page time_page;
+
+/* Serializes the writers, the readers rely on the sequence counter */
+static struct k_spinlock time_page_lock;
+
+static void time_page_write_begin(void)
+{
+	time_page.seq++;
+	barrier_dmem_fence_full();
+}
+
+static void time_page_write_end(void)
+{
+	barrier_dmem_fence_full();
+	time_page.seq++;
+}
+
+void z_time_page_update(uint64_t ticks)
+{
+	K_SPINLOCK(&time_page_lock) {
+		time_page_write_begin();
+		time_page.cyc_per_tick = sys_clock_hw_cycles_per_sec() /
+					 CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+		time_page.ticks = ticks;
+		time_page.cycles = time_page_cycles();
+		time_page_write_end();
+	}
+}
+
+void z_time_page_set_realtime(int64_t sec, int32_t nsec)
+{
+	K_SPINLOCK(&time_page_lock) {
+		time_page_write_begin();
+		time_page.rt_sec = sec;
+		time_page.rt_nsec = nsec;
+		time_page_write_end();
+	}
+}
+
+int64_t z_time_page_read(int64_t *rt_sec, int32_t *rt_nsec)
+{
+	uint32_t seq;
+	uint32_t cyc_per_tick;
+	uint64_t ticks;
+	time_page_cycles_t cycles;
+	int64_t sec;
+	int32_t nsec;
+
+	do {
+		seq = time_page.seq;
+		barrier_dmem_fence_full();
+
+		cyc_per_tick = time_page.cyc_per_tick;
+		ticks = time_page.ticks;
+		cycles = time_page.cycles;
+		sec = time_page.rt_sec;
+		nsec = time_page.rt_nsec;
+
+		barrier_dmem_fence_full();
+	} while (((seq & 1U) != 0U) || (seq != time_page.seq));
+
+	/*
+	 * The cycle counter was read after the tick was announced, so this
+	 * never runs ahead of the kernel, but may lag it by less than a tick.
+	 */
+	if (IS_ENABLED(CONFIG_USERSPACE_CYCLE_COUNTER) && (cyc_per_tick != 0U)) {
+		ticks += (time_page_cycles_t)(time_page_cycles() - cycles) / cyc_per_tick;
+	}
+
+	if (rt_sec != NULL) {
+		*rt_sec = sec;
+		*rt_nsec = nsec;
+	}
+
+	return (int64_t)ticks;
+}
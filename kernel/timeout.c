@@ -11,10 +11,13 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +39,227 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/*
+ * Hierarchical timer wheel. Every pending timeout stores its absolute
+ * expiry tick in dticks and lives at the level given by the most
+ * significant WHEEL_SLOT_BITS group in which its expiry differs from
+ * curr_tick, in the slot selected by that group of the expiry. All
+ * entries of a level 0 slot thus expire on the same tick and, as no
+ * entry expires before curr_tick, the lowest set bit of the lowest
+ * non-empty level designates the next expiry. Whenever curr_tick
+ * moves, the slots matching the new tick on the upper levels are
+ * cascaded down. curr_tick is never advanced beyond the earliest
+ * expiry, so this is sufficient to keep the above invariant.
+ */
+#define WHEEL_SLOT_BITS 5
+#define WHEEL_SLOTS BIT(WHEEL_SLOT_BITS)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_HORIZON_BITS (WHEEL_LEVELS * WHEEL_SLOT_BITS)
+
+/* Slot lists are initialized when their pending bit gets set */
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint32_t wheel_pending[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+/* Earliest pending timeout, recomputed when wheel_next_valid is false */
+static struct _timeout *wheel_next;
+static bool wheel_next_valid = true;
+
+static inline uint64_t expiry_of(const struct _timeout *t)
+{
+	return (uint64_t)t->dticks;
+}
+
+/* Returns WHEEL_LEVELS for timeouts beyond the wheel horizon */
+static int wheel_level(uint64_t expiry)
+{
+	uint64_t diff = expiry ^ curr_tick;
+	int level;
+
+	if (diff == 0U) {
+		return 0;
+	}
+
+	level = (63 - u64_count_leading_zeros(diff)) / WHEEL_SLOT_BITS;
+
+	return MIN(level, WHEEL_LEVELS);
+}
+
+static inline int wheel_index(uint64_t expiry, int level)
+{
+	return (int)(expiry >> (level * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1);
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	uint64_t expiry = expiry_of(to);
+	int level = wheel_level(expiry);
+
+	if (level == WHEEL_LEVELS) {
+		sys_dlist_append(&wheel_overflow, &to->node);
+	} else {
+		int idx = wheel_index(expiry, level);
+
+		if ((wheel_pending[level] & BIT(idx)) == 0U) {
+			sys_dlist_init(&wheel[level][idx]);
+			wheel_pending[level] |= BIT(idx);
+		}
+		sys_dlist_append(&wheel[level][idx], &to->node);
+	}
+
+	if (wheel_next_valid &&
+	    ((wheel_next == NULL) || (expiry < expiry_of(wheel_next)))) {
+		wheel_next = to;
+	}
+}
+
+/* Re-hashes all entries of a list against the current curr_tick */
+static void wheel_requeue(sys_dlist_t *list)
+{
+	sys_dlist_t tmp = SYS_DLIST_STATIC_INIT(&tmp);
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&tmp, node);
+	}
+
+	while ((node = sys_dlist_get(&tmp)) != NULL) {
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* Must not move past the earliest pending expiry */
+static void advance_tick(k_ticks_t ticks)
+{
+	uint64_t prev = curr_tick;
+
+	curr_tick += ticks;
+
+	if ((prev >> WHEEL_HORIZON_BITS) != (curr_tick >> WHEEL_HORIZON_BITS)) {
+		wheel_requeue(&wheel_overflow);
+	}
+
+	for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		int idx = wheel_index(curr_tick, level);
+
+		if ((wheel_pending[level] & BIT(idx)) != 0U) {
+			wheel_pending[level] &= ~BIT(idx);
+			wheel_requeue(&wheel[level][idx]);
+		}
+	}
+}
+
+static struct _timeout *earliest(sys_dlist_t *list)
+{
+	struct _timeout *ret = NULL;
+	struct _timeout *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		if ((ret == NULL) || (expiry_of(t) < expiry_of(ret))) {
+			ret = t;
+		}
+	}
+
+	return ret;
+}
+
+static struct _timeout *first(void)
+{
+	if (wheel_next_valid) {
+		return wheel_next;
+	}
+
+	wheel_next = NULL;
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		if (wheel_pending[level] != 0U) {
+			int idx = u32_count_trailing_zeros(wheel_pending[level]);
+
+			wheel_next = level == 0
+				? CONTAINER_OF(sys_dlist_peek_head(&wheel[0][idx]),
+					       struct _timeout, node)
+				: earliest(&wheel[level][idx]);
+			break;
+		}
+	}
+
+	if (wheel_next == NULL) {
+		wheel_next = earliest(&wheel_overflow);
+	}
+
+	wheel_next_valid = true;
+
+	return wheel_next;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t ticks)
+{
+	to->dticks = (int64_t)(curr_tick + ticks);
+	wheel_insert(to);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	int level = wheel_level(expiry_of(t));
+
+	sys_dlist_remove(&t->node);
+
+	if (level < WHEEL_LEVELS) {
+		int idx = wheel_index(expiry_of(t), level);
+
+		if (sys_dlist_is_empty(&wheel[level][idx])) {
+			wheel_pending[level] &= ~BIT(idx);
+		}
+	}
+
+	if (t == wheel_next) {
+		wheel_next_valid = false;
+	}
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return (k_ticks_t)(expiry_of(timeout) - curr_tick);
+}
+
+#ifdef CONFIG_ZTEST
+/* Moves all pending timeouts along with curr_tick, keeping their delay */
+static void set_tick(uint64_t tick)
+{
+	sys_dlist_t tmp = SYS_DLIST_STATIC_INIT(&tmp);
+	int64_t shift = (int64_t)(tick - curr_tick);
+	sys_dnode_t *node;
+
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		while (wheel_pending[level] != 0U) {
+			int idx = u32_count_trailing_zeros(wheel_pending[level]);
+
+			while ((node = sys_dlist_get(&wheel[level][idx])) != NULL) {
+				sys_dlist_append(&tmp, node);
+			}
+			wheel_pending[level] &= ~BIT(idx);
+		}
+	}
+
+	while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+		sys_dlist_append(&tmp, node);
+	}
+
+	curr_tick = tick;
+
+	while ((node = sys_dlist_get(&tmp)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		t->dticks += shift;
+		wheel_insert(t);
+	}
+}
+#endif /* CONFIG_ZTEST */
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +283,59 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static void insert_timeout(struct _timeout *to, k_ticks_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			return;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	sys_dlist_append(&timeout_list, &to->node);
+}
+
+/* Must not move past the earliest pending expiry */
+static void advance_tick(k_ticks_t ticks)
+{
+	struct _timeout *t = first();
+
+	curr_tick += ticks;
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#ifdef CONFIG_ZTEST
+static void set_tick(uint64_t tick)
+{
+	curr_tick = tick;
+}
+#endif /* CONFIG_ZTEST */
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -87,10 +364,10 @@ static int32_t next_timeout(void)
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_rem(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_rem(to) - ticks_elapsed);
 	}
 
 	return ret;
@@ -111,29 +388,32 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t ticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = MAX(1, Z_TICK_ABS(timeout.ticks) - curr_tick);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
+			ticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
+#ifdef CONFIG_TIMEOUT_SLACK
+		if (to->slack != 0U) {
+			/* Delay to a tick aligned on a power of two within the
+			 * slack, where the expiry of other timeouts with a
+			 * slack is likely to be aligned as well.
+			 */
+			uint64_t align = BIT64(31 - u32_count_leading_zeros(to->slack + 1U));
+			uint64_t expiry = curr_tick + ticks;
+
+			to->slack_delay = (uint32_t)(ROUND_UP(expiry, align) - expiry);
+			ticks += to->slack_delay;
+		} else {
+			to->slack_delay = 0U;
 		}
+#endif /* CONFIG_TIMEOUT_SLACK */
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, ticks);
 
 		if (to == first()) {
 			sys_clock_set_timeout(next_timeout(), false);
@@ -155,21 +435,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -228,12 +493,11 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t;
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (timeout_rem(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = timeout_rem(t);
 
-		curr_tick += dt;
-		t->dticks = 0;
+		advance_tick(dt);
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
@@ -242,13 +506,13 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
-	curr_tick += announce_remaining;
+	advance_tick(announce_remaining);
 	announce_remaining = 0;
 
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+	z_time_page_update(curr_tick);
+#endif
+
 	sys_clock_set_timeout(next_timeout(), false);
 
 	k_spin_unlock(&timeout_lock, key);
@@ -277,17 +541,17 @@ uint32_t sys_clock_tick_get_32(void)
 #endif /* CONFIG_TICKLESS_KERNEL */
 }
 
-int64_t z_impl_k_uptime_ticks(void)
+int64_t z_impl_k_uptime_ticks_query(void)
 {
 	return sys_clock_tick_get();
 }
 
 #ifdef CONFIG_USERSPACE
-static inline int64_t z_vrfy_k_uptime_ticks(void)
+static inline int64_t z_vrfy_k_uptime_ticks_query(void)
 {
-	return z_impl_k_uptime_ticks();
+	return z_impl_k_uptime_ticks_query();
 }
-#include <syscalls/k_uptime_ticks_mrsh.c>
+#include <syscalls/k_uptime_ticks_query_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 k_timepoint_t sys_timepoint_calc(k_timeout_t timeout)
@@ -330,7 +594,12 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
-	curr_tick = tick;
+	K_SPINLOCK(&timeout_lock) {
+		set_tick(tick);
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+		z_time_page_update(curr_tick);
+#endif
+	}
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
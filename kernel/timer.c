@@ -59,6 +59,13 @@ void z_timer_expiration_handler(struct _timeout *t)
 		/* see note about z_add_timeout() in z_impl_k_timer_start() */
 		next.ticks = MAX(next.ticks - 1, 0);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* Keep the period from the expiry before it was delayed
+		 * within the slack, so that the delays don't accumulate.
+		 */
+		next.ticks = MAX(next.ticks - (k_ticks_t)t->slack_delay, 0);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 #ifdef CONFIG_TIMEOUT_64BIT
 		/* Exploit the fact that uptime during a kernel
 		 * timeout handler reflects the time of the scheduled
@@ -342,6 +349,16 @@ static inline void z_vrfy_k_timer_user_data_set(struct k_timer *timer,
 }
 #include <syscalls/k_timer_user_data_set_mrsh.c>
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	K_OOPS(K_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	z_impl_k_timer_slack_set(timer, slack);
+}
+#include <syscalls/k_timer_slack_set_mrsh.c>
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_OBJ_CORE_TIMER
@@ -22,6 +22,189 @@ static bool slice_expired[CONFIG_MP_MAX_NUM_CPUS];
 struct k_thread *pending_current;
 #endif
 
+#ifdef CONFIG_SCHED_SPORADIC
+static struct _timeout budget_timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static bool budget_expired[CONFIG_MP_MAX_NUM_CPUS];
+/* Thread charged for the CPU time of each CPU, and since which tick */
+static struct k_thread *budget_thread[CONFIG_MP_MAX_NUM_CPUS];
+static int64_t budget_since[CONFIG_MP_MAX_NUM_CPUS];
+
+static void budget_timeout(struct _timeout *timeout)
+{
+	int cpu = ARRAY_INDEX(budget_timeouts, timeout);
+
+	budget_expired[cpu] = true;
+
+	if (IS_ENABLED(CONFIG_SMP) && cpu != _current_cpu->id) {
+		flag_ipi(IPI_CPU_MASK(cpu));
+	}
+}
+
+/* Charge the CPU time used since budget_start() to its thread */
+static void budget_charge(int cpu)
+{
+	struct k_thread *thread = budget_thread[cpu];
+	int64_t used;
+
+	if (thread == NULL) {
+		return;
+	}
+
+	z_abort_timeout(&budget_timeouts[cpu]);
+	budget_expired[cpu] = false;
+
+	used = sys_clock_tick_get() - budget_since[cpu];
+	thread->base.ss_budget_left -= (int32_t)MIN(used, thread->base.ss_budget_left);
+	budget_thread[cpu] = NULL;
+}
+
+static void ss_replenish(struct _timeout *timeout);
+
+/* Start charging the CPU time of @a thread, running on @a cpu */
+static void budget_start(struct k_thread *thread, int cpu)
+{
+	if ((thread->base.ss_budget == 0) || thread->base.ss_throttled) {
+		return;
+	}
+
+	/* The budget used from the activation is replenished a period later */
+	if (z_is_inactive_timeout(&thread->base.ss_replenish)) {
+		z_add_timeout(&thread->base.ss_replenish, ss_replenish,
+			      K_TICKS(thread->base.ss_period - 1));
+	}
+
+	budget_thread[cpu] = thread;
+	budget_since[cpu] = sys_clock_tick_get();
+	z_add_timeout(&budget_timeouts[cpu], budget_timeout,
+		      K_TICKS(MAX(thread->base.ss_budget_left - 1, 0)));
+}
+
+static int running_cpu(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		if (_kernel.cpus[i].current == thread) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static void ss_replenish(struct _timeout *timeout)
+{
+	struct k_thread *thread = CONTAINER_OF(timeout, struct k_thread, base.ss_replenish);
+	bool throttled = false;
+	int prio = 0;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		int cpu = running_cpu(thread);
+
+		if ((cpu >= 0) && (budget_thread[cpu] == thread)) {
+			budget_charge(cpu);
+		}
+
+		throttled = thread->base.ss_throttled;
+		prio = thread->base.ss_prio;
+		thread->base.ss_throttled = false;
+		thread->base.ss_budget_left = thread->base.ss_budget;
+
+		/* A running thread starts a new activation right away */
+		if (cpu >= 0) {
+			budget_start(thread, cpu);
+		}
+	}
+
+	/* Out of the timer interrupt, this CPU reschedules on its exit */
+	if (throttled && z_thread_prio_set(thread, prio)) {
+		signal_pending_ipi();
+	}
+}
+
+/* Called with the scheduler lock held, which is released to throttle */
+static k_spinlock_key_t budget_check(struct k_thread *curr, k_spinlock_key_t key)
+{
+	int cpu = _current_cpu->id;
+
+	if (!budget_expired[cpu] || (budget_thread[cpu] != curr)) {
+		return key;
+	}
+
+	budget_charge(cpu);
+	if (curr->base.ss_budget_left > 0) {
+		/* expired early, e.g. as ticks were announced late */
+		budget_start(curr, cpu);
+		return key;
+	}
+
+	curr->base.ss_throttled = true;
+	curr->base.ss_prio = curr->base.prio;
+
+	k_spin_unlock(&_sched_spinlock, key);
+	if (z_thread_prio_set(curr, curr->base.ss_low_prio)) {
+		signal_pending_ipi();
+	}
+
+	return k_spin_lock(&_sched_spinlock);
+}
+
+bool z_sched_sporadic_prio_set(struct k_thread *thread, int prio)
+{
+	bool throttled = false;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		throttled = thread->base.ss_throttled;
+		if (throttled) {
+			thread->base.ss_prio = prio;
+		}
+	}
+
+	return throttled;
+}
+
+int k_thread_sporadic_set(struct k_thread *thread, int32_t budget_ticks,
+			  int32_t period_ticks, int low_prio)
+{
+	bool throttled = false;
+	int prio = 0;
+
+	if ((budget_ticks < 0) || ((budget_ticks > 0) && (period_ticks < budget_ticks)) ||
+	    ((budget_ticks > 0) && !_is_valid_prio(low_prio, NULL))) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		int cpu = running_cpu(thread);
+
+		if ((cpu >= 0) && (budget_thread[cpu] == thread)) {
+			budget_charge(cpu);
+		}
+		(void)z_abort_timeout(&thread->base.ss_replenish);
+
+		throttled = thread->base.ss_throttled;
+		prio = thread->base.ss_prio;
+
+		thread->base.ss_budget = budget_ticks;
+		thread->base.ss_period = period_ticks;
+		thread->base.ss_budget_left = budget_ticks;
+		thread->base.ss_low_prio = low_prio;
+		thread->base.ss_throttled = false;
+
+		if (cpu >= 0) {
+			budget_start(thread, cpu);
+		}
+	}
+
+	if (throttled && z_thread_prio_set(thread, prio) &&
+	    (_current->base.sched_locked == 0U)) {
+		z_reschedule_unlocked();
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SCHED_SPORADIC */
+
 static inline int slice_time(struct k_thread *thread)
 {
 	int ret = slice_ticks;
@@ -58,11 +241,10 @@ static void slice_timeout(struct _timeout *timeout)
 	slice_expired[cpu] = true;
 
 	/* We need an IPI if we just handled a timeslice expiration
-	 * for a different CPU.  Ideally this would be able to target
-	 * the specific core, but that's not part of the API yet.
+	 * for a different CPU.
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && cpu != _current_cpu->id) {
-		flag_ipi();
+		flag_ipi(IPI_CPU_MASK(cpu));
 	}
 }
 
@@ -70,6 +252,11 @@ void z_reset_time_slice(struct k_thread *thread)
 {
 	int cpu = _current_cpu->id;
 
+#ifdef CONFIG_SCHED_SPORADIC
+	budget_charge(cpu);
+	budget_start(thread, cpu);
+#endif /* CONFIG_SCHED_SPORADIC */
+
 	z_abort_timeout(&slice_timeouts[cpu]);
 	slice_expired[cpu] = false;
 	if (thread_is_sliceable(thread)) {
@@ -114,6 +301,10 @@ void z_time_slice(void)
 	pending_current = NULL;
 #endif
 
+#ifdef CONFIG_SCHED_SPORADIC
+	key = budget_check(curr, key);
+#endif /* CONFIG_SCHED_SPORADIC */
+
 	if (slice_expired[_current_cpu->id] && thread_is_sliceable(curr)) {
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 		if (curr->base.slice_expired) {
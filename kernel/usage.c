@@ -7,6 +7,7 @@
 #include <zephyr/kernel.h>
 
 #include <zephyr/timing/timing.h>
+#include <zephyr/timing/perf_counter.h>
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
@@ -58,6 +59,113 @@ static void sched_cpu_update_usage(struct _cpu *cpu, uint32_t cycles)
 #define sched_cpu_update_usage(cpu, cycles)   do { } while (0)
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+static void sched_histogram_inc(uint32_t *bins, uint32_t cycles)
+{
+	uint32_t bin;
+
+	cycles >>= CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_SHIFT;
+	bin = (cycles == 0U) ? 0U : (32U - __builtin_clz(cycles));
+
+	bins[MIN(bin, CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BINS - 1)]++;
+}
+
+/* The histogram state of a thread is only changed under usage_lock, from
+ * the scheduler when the thread is readied and from the CPU switching it in
+ * or out. Nothing is kept per CPU, so an aborted thread leaves no reference
+ * behind.
+ */
+void z_sched_usage_ready(struct k_thread *thread)
+{
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+
+	thread->base.usage.ready_stamp = usage_now();
+	thread->base.usage.waiting = true;
+	thread->base.usage.preempted = false;
+
+	k_spin_unlock(&usage_lock, key);
+}
+
+void z_sched_usage_switch_out(struct k_thread *thread)
+{
+	struct k_cycle_stats *usage = &thread->base.usage;
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+	uint32_t now = usage_now();
+
+	if (usage->running && usage->track_usage &&
+	    thread != _current_cpu->idle_thread) {
+		sched_histogram_inc(usage->hist.run, now - usage->run_stamp);
+
+		/* Still runnable, so it was preempted or it yielded */
+		if (z_is_thread_ready(thread)) {
+			usage->ready_stamp = now;
+			usage->waiting = true;
+			usage->preempted = true;
+		}
+	}
+
+	usage->running = false;
+
+	k_spin_unlock(&usage_lock, key);
+}
+
+static void sched_histogram_switch_in(struct k_thread *thread, uint32_t now)
+{
+	struct k_cycle_stats *usage = &thread->base.usage;
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+
+	if (usage->running) {
+		/* Not switched out, the run goes on */
+		k_spin_unlock(&usage_lock, key);
+		return;
+	}
+
+	if (usage->waiting && usage->track_usage &&
+	    thread != _current_cpu->idle_thread) {
+		sched_histogram_inc(usage->preempted ? usage->hist.preempt :
+				    usage->hist.wakeup,
+				    now - usage->ready_stamp);
+	}
+
+	usage->waiting = false;
+	usage->running = true;
+	usage->run_stamp = now;
+
+	k_spin_unlock(&usage_lock, key);
+}
+#else
+#define sched_histogram_switch_in(thread, now)   do { } while (0)
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS
+static void sched_perf_start(struct _cpu *cpu)
+{
+	unsigned int num = perf_counter_num_get();
+
+	for (unsigned int i = 0; i < num; i++) {
+		cpu->perf0[i] = perf_counter_read(i);
+	}
+}
+
+/* Counters are per CPU, so the events since the start of the window are
+ * those of the thread running on it. The deltas are 32 bit, like cycles.
+ */
+static void sched_perf_update(struct _cpu *cpu, struct k_thread *thread)
+{
+	unsigned int num = perf_counter_num_get();
+
+	for (unsigned int i = 0; i < num; i++) {
+		uint32_t now = perf_counter_read(i);
+
+		thread->base.usage.perf[i] += now - cpu->perf0[i];
+		cpu->perf0[i] = now;
+	}
+}
+#else
+#define sched_perf_start(cpu)            do { } while (0)
+#define sched_perf_update(cpu, thread)   do { } while (0)
+#endif /* CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS */
+
 static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 {
 	thread->base.usage.total += cycles;
@@ -79,6 +187,7 @@ void z_sched_usage_start(struct k_thread *thread)
 	key = k_spin_lock(&usage_lock);
 
 	_current_cpu->usage0 = usage_now();   /* Always update */
+	sched_perf_start(_current_cpu);
 
 	if (thread->base.usage.track_usage) {
 		thread->base.usage.num_windows++;
@@ -86,6 +195,8 @@ void z_sched_usage_start(struct k_thread *thread)
 	}
 
 	k_spin_unlock(&usage_lock, key);
+
+	sched_histogram_switch_in(thread, _current_cpu->usage0);
 #else
 	/* One write through a volatile pointer doesn't require
 	 * synchronization as long as _usage() treats it as volatile
@@ -93,6 +204,8 @@ void z_sched_usage_start(struct k_thread *thread)
 	 */
 
 	_current_cpu->usage0 = usage_now();
+	sched_histogram_switch_in(thread, _current_cpu->usage0);
+	sched_perf_start(_current_cpu);
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 }
 
@@ -109,6 +222,7 @@ void z_sched_usage_stop(void)
 
 		if (cpu->current->base.usage.track_usage) {
 			sched_thread_update_usage(cpu->current, cycles);
+			sched_perf_update(cpu, cpu->current);
 		}
 
 		sched_cpu_update_usage(cpu, cycles);
@@ -141,6 +255,7 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 
 		if (cpu->current->base.usage.track_usage) {
 			sched_thread_update_usage(cpu->current, cycles);
+			sched_perf_update(cpu, cpu->current);
 		}
 
 		sched_cpu_update_usage(cpu, cycles);
@@ -193,6 +308,7 @@ void z_sched_thread_usage(struct k_thread *thread,
 
 		if (thread->base.usage.track_usage) {
 			sched_thread_update_usage(thread, cycles);
+			sched_perf_update(cpu, thread);
 		}
 
 		sched_cpu_update_usage(cpu, cycles);
@@ -225,6 +341,55 @@ void z_sched_thread_usage(struct k_thread *thread,
 	k_spin_unlock(&usage_lock, key);
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+int k_thread_sched_histogram_get(k_tid_t thread,
+				 struct k_sched_histogram *hist)
+{
+	k_spinlock_key_t  key;
+
+	CHECKIF((thread == NULL) || (hist == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	*hist = thread->base.usage.hist;
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS
+int k_thread_perf_counters_get(k_tid_t thread, uint64_t *counts, size_t n)
+{
+	k_spinlock_key_t  key;
+	struct _cpu *cpu;
+
+	CHECKIF((thread == NULL) || (counts == NULL)) {
+		return -EINVAL;
+	}
+
+	n = MIN(n, perf_counter_num_get());
+
+	key = k_spin_lock(&usage_lock);
+	cpu = _current_cpu;
+
+	/* Bring the counts of the calling thread up to date */
+	if ((thread == cpu->current) && (cpu->usage0 != 0) &&
+	    thread->base.usage.track_usage) {
+		sched_perf_update(cpu, thread);
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		counts[i] = thread->base.usage.perf[i];
+	}
+
+	k_spin_unlock(&usage_lock, key);
+
+	return (int)n;
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_PERF_COUNTERS */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 int k_thread_runtime_stats_enable(k_tid_t  thread)
 {
@@ -266,6 +431,7 @@ int k_thread_runtime_stats_disable(k_tid_t  thread)
 
 			sched_thread_update_usage(thread, cycles);
 			sched_cpu_update_usage(cpu, cycles);
+			sched_perf_update(cpu, thread);
 		}
 	}
 
@@ -383,6 +549,9 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->longest = 0ULL;
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	memset(&stats->hist, 0, sizeof(stats->hist));
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 
 	if (thread != _current_cpu->current) {
 
@@ -168,6 +168,7 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 struct dyn_obj {
 	struct k_object kobj;
 	sys_dnode_t dobj_list;
+	sys_dnode_t dobj_hash;
 
 	/* The object itself */
 	void *data;
@@ -184,8 +185,23 @@ extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
 /*
- * TODO: Write some hash table code that will replace obj_list.
+ * Hash table of the same objects keyed by their address, for the lookups
+ * done by every system call. Buckets are initialized on first use.
  */
+static sys_dlist_t obj_hash[CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
+
+static sys_dlist_t *obj_hash_bucket(const void *obj)
+{
+	/* Fibonacci hashing, keeping the well mixed upper bits */
+	uint32_t hash = ((uint32_t)((uintptr_t)obj >> 2) * 0x9e3779b1U) >> 16;
+	sys_dlist_t *bucket = &obj_hash[hash % CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
+
+	if (bucket->head == NULL) {
+		sys_dlist_init(bucket);
+	}
+
+	return bucket;
+}
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -226,14 +242,10 @@ static struct dyn_obj *dyn_object_find(void *obj)
 	struct dyn_obj *node;
 	k_spinlock_key_t key;
 
-	/* For any dynamically allocated kernel object, the object
-	 * pointer is just a member of the containing struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
-	 */
+	/* Only the objects hashing to the same bucket are compared */
 	key = k_spin_lock(&lists_lock);
 
-	SYS_DLIST_FOR_EACH_CONTAINER(&obj_list, node, dobj_list) {
+	SYS_DLIST_FOR_EACH_CONTAINER(obj_hash_bucket(obj), node, dobj_hash) {
 		if (node->kobj.name == obj) {
 			goto end;
 		}
@@ -370,6 +382,7 @@ static struct k_object *dynamic_object_create(enum k_objects otype, size_t align
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
 	sys_dlist_append(&obj_list, &dyn->dobj_list);
+	sys_dlist_append(obj_hash_bucket(dyn->kobj.name), &dyn->dobj_hash);
 	k_spin_unlock(&lists_lock, key);
 
 	return &dyn->kobj;
@@ -464,6 +477,7 @@ void k_object_free(void *obj)
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
 		sys_dlist_remove(&dyn->dobj_list);
+		sys_dlist_remove(&dyn->dobj_hash);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
@@ -574,6 +588,7 @@ static void unref_check(struct k_object *ko, uintptr_t index)
 	}
 
 	sys_dlist_remove(&dyn->dobj_list);
+	sys_dlist_remove(&dyn->dobj_hash);
 	k_free(dyn->data);
 	k_free(dyn);
 out:
@@ -200,6 +200,9 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	}
 
 	init_flusher(flusher);
+#ifdef CONFIG_WORKQUEUE_POOL
+	flusher->flushed = work;
+#endif
 	if (in_list) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -223,6 +226,117 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 	}
 }
 
+/* Check whether a thread animates the given queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to check.
+ * @param thread the thread that may be one of the queue threads.
+ */
+static inline bool queue_has_thread_locked(struct k_work_q *queue,
+					   struct k_thread *thread)
+{
+	if (thread == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (thread == &worker->thread) {
+			return true;
+		}
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	return false;
+}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Check whether a pending work item can be started now.
+ *
+ * A work item resubmitted while it runs must wait for the thread running
+ * it, and a flusher must wait for the item it flushes, which another thread
+ * of the queue may still be processing.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool work_startable_locked(struct k_work *work)
+{
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		return false;
+	}
+
+	if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+		struct z_work_flusher *flusher
+			= CONTAINER_OF(work, struct z_work_flusher, work);
+
+		return !flag_test(&flusher->flushed->flags,
+				  K_WORK_RUNNING_BIT);
+	}
+
+	return true;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+/* Take the first work item that can be started from the queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to take work from.
+ *
+ * @return the work item, or NULL if nothing can be started.
+ */
+static struct k_work *queue_take_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	sys_snode_t *prev = NULL;
+	struct k_work *work;
+
+	/* With a single thread the first item can always be started */
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->pending, work, node) {
+		if (work_startable_locked(work)) {
+			sys_slist_remove(&queue->pending, prev, &work->node);
+			return work;
+		}
+		prev = &work->node;
+	}
+
+	return NULL;
+#else
+	sys_snode_t *node = sys_slist_get(&queue->pending);
+
+	return (node != NULL) ? CONTAINER_OF(node, struct k_work, node) : NULL;
+#endif /* CONFIG_WORKQUEUE_POOL */
+}
+
+/* Account for a work item started or completed by a queue thread.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_busy_locked(struct k_work_q *queue, bool busy)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (busy) {
+		queue->running++;
+	} else {
+		queue->running--;
+	}
+
+	if (queue->running != 0U) {
+		flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		return;
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	if (busy) {
+		flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+	} else {
+		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+	}
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -272,7 +386,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_has_thread_locked(queue, _current) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -621,37 +735,24 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
 
 	while (true) {
-		sys_snode_t *node;
-		struct k_work *work = NULL;
+		struct k_work *work;
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
-		if (node != NULL) {
+		work = queue_take_locked(queue);
+		if (work != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			work = CONTAINER_OF(node, struct k_work, node);
+			queue_busy_locked(queue, true);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
 
-			/* Static code analysis tool can raise a false-positive violation
-			 * in the line below that 'work' is checked for null after being
-			 * dereferenced.
-			 *
-			 * The work is figured out by CONTAINER_OF, as a container
-			 * of type struct k_work that contains the node.
-			 * The only way for it to be NULL is if node would be a member
-			 * of struct k_work object that has been placed at address NULL,
-			 * which should never happen, even line 'if (work != NULL)'
-			 * ensures that.
-			 * This means that if node is not NULL, then work will not be NULL.
-			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT) &&
+			   flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
@@ -702,7 +803,17 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
-		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		queue_busy_locked(queue, false);
+
+#ifdef CONFIG_WORKQUEUE_POOL
+		/* Completing the item may have made pending items
+		 * startable, let an idle thread of the queue look too.
+		 */
+		if (!sys_slist_is_empty(&queue->pending)) {
+			(void)notify_queue_locked(queue);
+		}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -742,6 +853,10 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_POOL
+	sys_slist_init(&queue->workers);
+	queue->running = 0U;
+#endif /* CONFIG_WORKQUEUE_POOL */
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -766,6 +881,46 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_queue_add_worker(struct k_work_q *queue,
+			     struct k_work_q_worker *worker,
+			     k_thread_stack_t *stack,
+			     size_t stack_size,
+			     int prio,
+			     int cpu)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	(void)k_thread_create(&worker->thread, stack, stack_size,
+			      work_queue_main, queue, NULL, NULL,
+			      prio, 0, K_FOREVER);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		(void)k_thread_cpu_pin(&worker->thread, cpu);
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+#ifdef CONFIG_THREAD_NAME
+	(void)k_thread_name_set(&worker->thread,
+				k_thread_name_get(&queue->thread));
+#endif /* CONFIG_THREAD_NAME */
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&queue->workers, &worker->node);
+
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&worker->thread);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
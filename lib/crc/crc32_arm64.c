@@ -0,0 +1,65 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/byteorder.h>
+
+/*
+ * The ARMv8 CRC32 instructions use the reflected IEEE and Castagnoli
+ * polynomials, and leave the initial and final inversion to software.
+ * The extension is enabled here rather than for the whole build since
+ * it is optional on ARMv8.0 cores.
+ */
+#define CRC32_INSN(insn, width, reg)                                          \
+	static inline uint32_t insn(uint32_t crc, uint##width##_t val)        \
+	{                                                                     \
+		__asm__ (".arch_extension crc\n\t"                            \
+			 #insn " %w0, %w0, %" reg "1"                         \
+			 : "+r" (crc) : "r" (val));                           \
+		return crc;                                                   \
+	}
+
+CRC32_INSN(crc32b, 8, "w")
+CRC32_INSN(crc32x, 64, "x")
+CRC32_INSN(crc32cb, 8, "w")
+CRC32_INSN(crc32cx, 64, "x")
+
+uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	crc = ~crc;
+
+	for (; len >= 8; data += 8, len -= 8) {
+		crc = crc32x(crc, sys_get_le64(data));
+	}
+
+	for (; len > 0; data++, len--) {
+		crc = crc32b(crc, *data);
+	}
+
+	return ~crc;
+}
+
+/* Same initial and final values as the software implementations */
+#define CRC32C_XOR_OUT	0xFFFFFFFFUL
+#define CRC32C_INIT	0xFFFFFFFFUL
+
+uint32_t crc32_c(uint32_t crc, const uint8_t *data,
+		 size_t len, bool first_pkt, bool last_pkt)
+{
+	if (first_pkt) {
+		crc = CRC32C_INIT;
+	}
+
+	for (; len >= 8; data += 8, len -= 8) {
+		crc = crc32cx(crc, sys_get_le64(data));
+	}
+
+	for (; len > 0; data++, len--) {
+		crc = crc32cb(crc, *data);
+	}
+
+	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
+}
@@ -11,6 +11,7 @@ uint32_t crc32_ieee(const uint8_t *data, size_t len)
 	return crc32_ieee_update(0x0, data, len);
 }
 
+#ifdef CONFIG_CRC32_NIBBLE_TABLE
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
 	/* crc table generated from polynomial 0xedb88320 */
@@ -32,3 +33,4 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 
 	return (~crc);
 }
+#endif /* CONFIG_CRC32_NIBBLE_TABLE */
@@ -0,0 +1,357 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_oa_rh.h>
+#include <zephyr/sys/util.h>
+
+/* Buckets of the old table drained per insertion or removal */
+#define MIGRATE_STEP 8
+
+struct oarh_entry {
+	uint64_t key;
+	uint64_t value;
+	uint32_t hash;
+	/* Distance from the home bucket plus one, 0 if the bucket is unused */
+	uint32_t dist;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+static struct oarh_entry *sys_hashmap_oa_rh_find(struct oarh_entry *buckets, size_t n_buckets,
+						 uint32_t hash, uint64_t key)
+{
+	struct oarh_entry *entry;
+
+	if (n_buckets == 0) {
+		return NULL;
+	}
+
+	for (uint32_t dist = 1, j = hash;; ++dist, ++j) {
+		j &= (n_buckets - 1);
+		entry = &buckets[j];
+
+		/* Every entry is at most as far from home as the ones it displaced */
+		if (entry->dist < dist) {
+			return NULL;
+		}
+
+		if (entry->hash == hash && entry->key == key) {
+			return entry;
+		}
+	}
+}
+
+/* Place an entry that is not in the table yet, taking from the rich */
+static void sys_hashmap_oa_rh_place(struct oarh_entry *buckets, size_t n_buckets,
+				    struct oarh_entry entry)
+{
+	struct oarh_entry tmp;
+
+	entry.dist = 1;
+
+	for (size_t j = entry.hash;; ++j, ++entry.dist) {
+		j &= (n_buckets - 1);
+
+		if (buckets[j].dist == 0) {
+			buckets[j] = entry;
+			return;
+		}
+
+		if (buckets[j].dist < entry.dist) {
+			tmp = buckets[j];
+			buckets[j] = entry;
+			entry = tmp;
+		}
+	}
+}
+
+/* Remove an entry by shifting the rest of its cluster back, no tombstone needed */
+static void sys_hashmap_oa_rh_erase(struct oarh_entry *buckets, size_t n_buckets,
+				    struct oarh_entry *entry)
+{
+	size_t j = entry - buckets;
+	size_t k;
+
+	for (;; j = k) {
+		k = (j + 1) & (n_buckets - 1);
+
+		if (buckets[k].dist <= 1) {
+			buckets[j].dist = 0;
+			return;
+		}
+
+		buckets[j] = buckets[k];
+		--buckets[j].dist;
+	}
+}
+
+/*
+ * Move up to n_steps buckets of the old table into the new one. Erasing from
+ * the old table only shifts entries back into the bucket being drained, or
+ * around to the start of the table, which is drained again until it is empty.
+ */
+static void sys_hashmap_oa_rh_migrate(struct sys_hashmap *map, size_t n_steps)
+{
+	struct oarh_entry *entry;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	struct oarh_entry *const old_buckets = data->old_buckets;
+
+	if (old_buckets == NULL) {
+		return;
+	}
+
+	for (; n_steps > 0 && data->old_size > 0; --n_steps) {
+		entry = &old_buckets[data->old_pos];
+
+		if (entry->dist == 0) {
+			data->old_pos = (data->old_pos + 1) & (data->old_n_buckets - 1);
+			continue;
+		}
+
+		sys_hashmap_oa_rh_place(data->buckets, data->n_buckets, *entry);
+		sys_hashmap_oa_rh_erase(old_buckets, data->old_n_buckets, entry);
+		--data->old_size;
+	}
+
+	if (data->old_size == 0) {
+		map->alloc_func(old_buckets, 0);
+		data->old_buckets = NULL;
+		data->old_n_buckets = 0;
+		data->old_pos = 0;
+	}
+}
+
+static int sys_hashmap_oa_rh_rehash(struct sys_hashmap *map, bool grow)
+{
+	size_t new_n_buckets = 0;
+	struct oarh_entry *new_buckets;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	if (!sys_hashmap_should_rehash(map, grow, 0, &new_n_buckets)) {
+		return 0;
+	}
+
+	if (map->data->size != SIZE_MAX && map->data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	new_buckets = (struct oarh_entry *)map->alloc_func(NULL,
+							   new_n_buckets * sizeof(*new_buckets));
+	if (new_buckets == NULL && new_n_buckets != 0) {
+		return -ENOMEM;
+	}
+
+	if (new_buckets != NULL) {
+		/* ensure all buckets are empty / initialized */
+		memset(new_buckets, 0, new_n_buckets * sizeof(*new_buckets));
+	}
+
+	/* a previous resize that is not done yet has to be finished first */
+	sys_hashmap_oa_rh_migrate(map, SIZE_MAX);
+
+	data->old_buckets = data->buckets;
+	data->old_n_buckets = data->n_buckets;
+	data->old_size = data->size;
+	data->old_pos = 0;
+
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	/* frees an empty old table right away */
+	sys_hashmap_oa_rh_migrate(map, 0);
+
+	return 0;
+}
+
+static void sys_hashmap_oa_rh_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	struct oarh_entry *entry;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	/* the state is the index of the next bucket, the old table following the new one */
+	for (i = (uintptr_t)it->state; i < data->n_buckets + data->old_n_buckets; ++i) {
+		if (i < data->n_buckets) {
+			entry = &((struct oarh_entry *)data->buckets)[i];
+		} else {
+			entry = &((struct oarh_entry *)data->old_buckets)[i - data->n_buckets];
+		}
+
+		if (entry->dist != 0) {
+			it->state = (void *)(uintptr_t)(i + 1);
+			it->key = entry->key;
+			it->value = entry->value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Open Addressing / Robin Hood Hashmap API
+ */
+
+static void sys_hashmap_oa_rh_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_oa_rh_iter_next;
+	it->state = NULL;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_oa_rh_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_iterator it;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	if (cb != NULL) {
+		for (sys_hashmap_oa_rh_iter(map, &it); sys_hashmap_iterator_has_next(&it);) {
+			it.next(&it);
+			cb(it.key, it.value, cookie);
+		}
+	}
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	if (data->old_buckets != NULL) {
+		map->alloc_func(data->old_buckets, 0);
+		data->old_buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+	data->old_n_buckets = 0;
+	data->old_size = 0;
+	data->old_pos = 0;
+}
+
+static int sys_hashmap_oa_rh_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	int ret;
+	struct oarh_entry *entry;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	uint32_t hash = map->hash_func(&key, sizeof(key));
+
+	ret = sys_hashmap_oa_rh_rehash(map, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	sys_hashmap_oa_rh_migrate(map, MIGRATE_STEP);
+
+	entry = sys_hashmap_oa_rh_find(data->buckets, data->n_buckets, hash, key);
+	if (entry == NULL) {
+		entry = sys_hashmap_oa_rh_find(data->old_buckets, data->old_n_buckets, hash, key);
+	}
+
+	if (entry != NULL) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+
+		entry->value = value;
+
+		return 0;
+	}
+
+	sys_hashmap_oa_rh_place(data->buckets, data->n_buckets,
+				(struct oarh_entry){ .key = key, .value = value, .hash = hash });
+	++data->size;
+
+	return 1;
+}
+
+static bool sys_hashmap_oa_rh_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct oarh_entry *entry;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	uint32_t hash = map->hash_func(&key, sizeof(key));
+
+	sys_hashmap_oa_rh_migrate(map, MIGRATE_STEP);
+
+	entry = sys_hashmap_oa_rh_find(data->buckets, data->n_buckets, hash, key);
+	if (entry != NULL) {
+		if (value != NULL) {
+			*value = entry->value;
+		}
+
+		sys_hashmap_oa_rh_erase(data->buckets, data->n_buckets, entry);
+	} else {
+		entry = sys_hashmap_oa_rh_find(data->old_buckets, data->old_n_buckets, hash, key);
+		if (entry == NULL) {
+			return false;
+		}
+
+		if (value != NULL) {
+			*value = entry->value;
+		}
+
+		sys_hashmap_oa_rh_erase(data->old_buckets, data->old_n_buckets, entry);
+		--data->old_size;
+	}
+
+	--data->size;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	(void)sys_hashmap_oa_rh_rehash(map, false);
+
+	return true;
+}
+
+static bool sys_hashmap_oa_rh_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct oarh_entry *entry;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	uint32_t hash = map->hash_func(&key, sizeof(key));
+
+	entry = sys_hashmap_oa_rh_find(data->buckets, data->n_buckets, hash, key);
+	if (entry == NULL) {
+		entry = sys_hashmap_oa_rh_find(data->old_buckets, data->old_n_buckets, hash, key);
+	}
+
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_oa_rh_api = {
+	.iter = sys_hashmap_oa_rh_iter,
+	.clear = sys_hashmap_oa_rh_clear,
+	.insert = sys_hashmap_oa_rh_insert,
+	.remove = sys_hashmap_oa_rh_remove,
+	.get = sys_hashmap_oa_rh_get,
+};
@@ -160,12 +160,112 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+BUILD_ASSERT(IS_POWER_OF_TWO(RUN_SIZE), "run size must be a power of 2");
+
+static const uint16_t run_class_bytes[RUN_CLASSES] = {
+	16, 24, 32, 48, 64, 96, 128
+};
+
+/* Size class of the requests, by 8 byte step */
+static const uint8_t run_class_of[RUN_MAX_BYTES / CHUNK_UNIT] = {
+	0, 0, 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6
+};
+
+static inline uint8_t *run_blocks(struct z_heap_run *run)
+{
+	return (uint8_t *)(run + 1);
+}
+
+static inline uint16_t run_nblocks(unsigned int cls)
+{
+	return (RUN_SIZE - CHUNK_UNIT - sizeof(struct z_heap_run)) /
+	       run_class_bytes[cls];
+}
+
+static size_t run_block_bytes(struct z_heap *h, void *mem)
+{
+	return run_class_bytes[slot_run(h, run_slot(h, mem))->cls];
+}
+
+static void run_list_add(struct z_heap *h, struct z_heap_run *run,
+			 uint32_t slot)
+{
+	run->prev = 0;
+	run->next = h->runs[run->cls];
+	if (run->next != 0U) {
+		slot_run(h, run->next - 1)->prev = slot + 1;
+	}
+	h->runs[run->cls] = slot + 1;
+}
+
+static void run_list_remove(struct z_heap *h, struct z_heap_run *run)
+{
+	if (run->prev != 0U) {
+		slot_run(h, run->prev - 1)->next = run->next;
+	} else {
+		h->runs[run->cls] = run->next;
+	}
+	if (run->next != 0U) {
+		slot_run(h, run->next - 1)->prev = run->prev;
+	}
+}
+
+static void run_free(struct z_heap *h, void *mem)
+{
+	uint32_t slot = run_slot(h, mem);
+	struct z_heap_run *run = slot_run(h, slot);
+	size_t offset = (uint8_t *)mem - run_blocks(run);
+	uint16_t idx = offset / run_class_bytes[run->cls];
+
+	__ASSERT(offset % run_class_bytes[run->cls] == 0U && idx < run->bump,
+		 "unexpected heap state (bad pointer?) for memory at %p", mem);
+
+	*(uint16_t *)mem = run->free;
+	run->free = idx + 1;
+
+	/* A full run is not listed */
+	if (run->used-- == run_nblocks(run->cls)) {
+		run_list_add(h, run, slot);
+	}
+
+	/* Give an empty run back to the heap, unless it is the last
+	 * one of its class, to not carve a new one for the next block
+	 */
+	if (run->used == 0U &&
+	    (h->runs[run->cls] != slot + 1 || run->next != 0U)) {
+		chunkid_t c = mem_to_chunkid(h, run);
+
+		run_list_remove(h, run);
+		h->run_map[slot / 32U] &= ~BIT(slot % 32U);
+
+		set_chunk_used(h, c, false);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+		free_chunk(h, c);
+	}
+}
+#endif /* CONFIG_SYS_HEAP_SEGREGATED */
+
 void sys_heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
 		return; /* ISO C free() semantics */
 	}
 	struct z_heap *h = heap->heap;
+
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+	if (mem_in_run(h, mem)) {
+#ifdef CONFIG_SYS_HEAP_LISTENER
+		heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
+					  run_block_bytes(h, mem));
+#endif
+		run_free(h, mem);
+		return;
+	}
+#endif
+
 	chunkid_t c = mem_to_chunkid(h, mem);
 
 	/*
@@ -200,6 +300,13 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 {
 	struct z_heap *h = heap->heap;
+
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+	if (mem_in_run(h, mem)) {
+		return run_block_bytes(h, mem);
+	}
+#endif
+
 	chunkid_t c = mem_to_chunkid(h, mem);
 	size_t addr = (size_t)mem;
 	size_t chunk_base = (size_t)&chunk_buf(h)[c];
@@ -260,6 +367,111 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
+/* Allocates a chunk holding @bytes at @align minus @rew, see
+ * sys_heap_aligned_alloc(), and returns the aligned memory in it
+ */
+static uint8_t *aligned_alloc_mem(struct z_heap *h, size_t align, size_t rew,
+				  size_t gap, size_t bytes)
+{
+	/*
+	 * Find a free block that is guaranteed to fit.
+	 * We over-allocate to account for alignment and then free
+	 * the extra allocations afterwards.
+	 */
+	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
+	chunkid_t c0 = alloc_chunk(h, padded_sz);
+
+	if (c0 == 0) {
+		return NULL;
+	}
+	uint8_t *mem = chunk_mem(h, c0);
+
+	/* Align allocated memory */
+	mem = (uint8_t *) ROUND_UP(mem + rew, align) - rew;
+	chunk_unit_t *end = (chunk_unit_t *) ROUND_UP(mem + bytes, CHUNK_UNIT);
+
+	/* Get corresponding chunks */
+	chunkid_t c = mem_to_chunkid(h, mem);
+	chunkid_t c_end = end - chunk_buf(h);
+	CHECK(c >= c0 && c  < c_end && c_end <= c0 + padded_sz);
+
+	/* Split and free unused prefix */
+	if (c > c0) {
+		split_chunks(h, c0, c);
+		free_list_add(h, c0);
+	}
+
+	/* Split and free unused suffix */
+	if (right_chunk(h, c) > c_end) {
+		split_chunks(h, c, c_end);
+		free_list_add(h, c_end);
+	}
+
+	set_chunk_used(h, c, true);
+
+	return mem;
+}
+
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+/* Carves a run for a size class, returns its slot + 1 or 0 */
+static uint32_t run_new(struct z_heap *h, unsigned int cls)
+{
+	uint8_t *mem = aligned_alloc_mem(h, RUN_SIZE, 0, chunk_header_bytes(h),
+					 RUN_SIZE - CHUNK_UNIT);
+
+	if (mem == NULL) {
+		return 0;
+	}
+
+	struct z_heap_run *run = (struct z_heap_run *)mem;
+	uint32_t slot = run_slot(h, mem);
+
+	CHECK(((uintptr_t)mem & (RUN_SIZE - 1)) == 0);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, mem_to_chunkid(h, mem))));
+#endif
+
+	h->run_map[slot / 32U] |= BIT(slot % 32U);
+	run->free = 0;
+	run->bump = 0;
+	run->used = 0;
+	run->cls = cls;
+	run_list_add(h, run, slot);
+
+	return slot + 1;
+}
+
+static void *run_alloc(struct z_heap *h, size_t bytes)
+{
+	unsigned int cls = run_class_of[(bytes - 1) / CHUNK_UNIT];
+	uint32_t slot1 = h->runs[cls];
+	uint8_t *mem;
+
+	if (slot1 == 0U) {
+		slot1 = run_new(h, cls);
+		if (slot1 == 0U) {
+			return NULL;
+		}
+	}
+
+	struct z_heap_run *run = slot_run(h, slot1 - 1);
+
+	if (run->free != 0U) {
+		mem = run_blocks(run) + (run->free - 1) * run_class_bytes[cls];
+		run->free = *(uint16_t *)mem;
+	} else {
+		mem = run_blocks(run) + run->bump++ * run_class_bytes[cls];
+	}
+
+	if (++run->used == run_nblocks(cls)) {
+		run_list_remove(h, run);
+	}
+
+	return mem;
+}
+#endif /* CONFIG_SYS_HEAP_SEGREGATED */
+
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
@@ -269,6 +481,21 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 		return NULL;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+	/* Small requests go to the runs, or to a chunk if no run fits */
+	if (bytes <= RUN_MAX_BYTES) {
+		mem = run_alloc(h, bytes);
+		if (mem != NULL) {
+#ifdef CONFIG_SYS_HEAP_LISTENER
+			heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+						   run_block_bytes(h, mem));
+#endif
+			IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
+			return mem;
+		}
+	}
+#endif
+
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
 	chunkid_t c = alloc_chunk(h, chunk_sz);
 	if (c == 0U) {
@@ -327,41 +554,13 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 		return NULL;
 	}
 
-	/*
-	 * Find a free block that is guaranteed to fit.
-	 * We over-allocate to account for alignment and then free
-	 * the extra allocations afterwards.
-	 */
-	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
-	chunkid_t c0 = alloc_chunk(h, padded_sz);
+	uint8_t *mem = aligned_alloc_mem(h, align, rew, gap, bytes);
 
-	if (c0 == 0) {
+	if (mem == NULL) {
 		return NULL;
 	}
-	uint8_t *mem = chunk_mem(h, c0);
 
-	/* Align allocated memory */
-	mem = (uint8_t *) ROUND_UP(mem + rew, align) - rew;
-	chunk_unit_t *end = (chunk_unit_t *) ROUND_UP(mem + bytes, CHUNK_UNIT);
-
-	/* Get corresponding chunks */
-	chunkid_t c = mem_to_chunkid(h, mem);
-	chunkid_t c_end = end - chunk_buf(h);
-	CHECK(c >= c0 && c  < c_end && c_end <= c0 + padded_sz);
-
-	/* Split and free unused prefix */
-	if (c > c0) {
-		split_chunks(h, c0, c);
-		free_list_add(h, c0);
-	}
-
-	/* Split and free unused suffix */
-	if (right_chunk(h, c) > c_end) {
-		split_chunks(h, c, c_end);
-		free_list_add(h, c_end);
-	}
-
-	set_chunk_used(h, c, true);
+	chunkid_t c __maybe_unused = mem_to_chunkid(h, mem);
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, c)));
@@ -396,6 +595,26 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 		return NULL;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+	if (mem_in_run(h, ptr)) {
+		size_t block_bytes = run_block_bytes(h, ptr);
+
+		/* Blocks stay in their size class when shrunk */
+		if (bytes <= block_bytes &&
+		    (align == 0 || ((uintptr_t)ptr & (align - 1)) == 0)) {
+			return ptr;
+		}
+
+		void *ptr2 = sys_heap_aligned_alloc(heap, align, bytes);
+
+		if (ptr2 != NULL) {
+			memcpy(ptr2, ptr, MIN(block_bytes, bytes));
+			sys_heap_free(heap, ptr);
+		}
+		return ptr2;
+	}
+#endif
+
 	chunkid_t c = mem_to_chunkid(h, ptr);
 	chunkid_t rc = right_chunk(h, c);
 	size_t align_gap = (uint8_t *)ptr - (uint8_t *)chunk_mem(h, c);
@@ -518,8 +737,18 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 #endif
 
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
+	size_t run_map_bytes = 0;
+
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+	/* One bit per run slot, up to the end marker chunk */
+	h->run_base = ROUND_DOWN(addr, RUN_SIZE);
+	run_map_bytes = DIV_ROUND_UP((end - h->run_base) / RUN_SIZE + 1, 32) *
+			sizeof(uint32_t);
+#endif
+
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+				     nb_buckets * sizeof(struct z_heap_bucket) +
+				     run_map_bytes);
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
@@ -527,6 +756,12 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+	h->run_map = (uint32_t *)&h->buckets[nb_buckets];
+	memset(h->run_map, 0, run_map_bytes);
+	memset(h->runs, 0, sizeof(h->runs));
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
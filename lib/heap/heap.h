@@ -65,6 +65,35 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+/* Small requests are served from "runs": chunks of RUN_SIZE bytes
+ * aligned on RUN_SIZE, each one split into blocks of a single size
+ * class.  A bitmap with one bit per RUN_SIZE slot of the heap, stored
+ * after the buckets, tells whether a pointer is in a run.  The last
+ * CHUNK_UNIT bytes of a slot hold the header of the next chunk, so
+ * runs can be adjacent and the memory of a regular chunk is never in
+ * the part of a slot that a run covers.
+ */
+#define RUN_SIZE CONFIG_SYS_HEAP_SEGREGATED_RUN_SIZE
+#define RUN_CLASSES 7
+#define RUN_MAX_BYTES 128U
+
+struct z_heap_run {
+	/* Slot + 1 of the neighbors in the list of the runs of the
+	 * class with free blocks, 0 for none
+	 */
+	uint32_t prev;
+	uint32_t next;
+	/* Index + 1 of the first free block, 0 for none */
+	uint16_t free;
+	/* Number of blocks handed out at least once */
+	uint16_t bump;
+	uint16_t used;
+	uint8_t cls;
+	uint8_t listed;
+};
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +102,12 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+	uintptr_t run_base;
+	uint32_t *run_map;
+	/* Slot + 1 of the first run with free blocks of each class */
+	uint32_t runs[RUN_CLASSES];
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -262,6 +297,27 @@ static inline bool size_too_big(struct z_heap *h, size_t bytes)
 	return (bytes / CHUNK_UNIT) >= h->end_chunk;
 }
 
+#ifdef CONFIG_SYS_HEAP_SEGREGATED
+static inline uint32_t run_slot(struct z_heap *h, void *mem)
+{
+	return ((uintptr_t)mem - h->run_base) / RUN_SIZE;
+}
+
+static inline struct z_heap_run *slot_run(struct z_heap *h, uint32_t slot)
+{
+	return (struct z_heap_run *)(h->run_base + (uintptr_t)slot * RUN_SIZE);
+}
+
+/* Whether memory returned by the heap is a block of a run */
+static inline bool mem_in_run(struct z_heap *h, void *mem)
+{
+	uint32_t slot = run_slot(h, mem);
+
+	return (h->run_map[slot / 32U] & BIT(slot % 32U)) != 0U &&
+	       ((uintptr_t)mem - h->run_base) % RUN_SIZE < RUN_SIZE - CHUNK_UNIT;
+}
+#endif
+
 static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			   size_t *free_bytes)
 {
@@ -32,3 +32,30 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 
 	return 0;
 }
+
+#ifdef CONFIG_K_HEAP_MAGAZINE
+int k_heap_magazine_stats_get(struct k_heap *heap,
+			      struct k_heap_magazine_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	stats->hits = 0U;
+	stats->misses = 0U;
+	stats->cached_bytes = 0U;
+
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		struct k_heap_magazine *mag = &heap->magazines[cpu];
+
+		stats->hits += mag->hits;
+		stats->misses += mag->misses;
+
+		for (int c = 0; c < CONFIG_K_HEAP_MAGAZINE_CLASSES; c++) {
+			stats->cached_bytes += (size_t)mag->count[c] << (c + 4);
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_K_HEAP_MAGAZINE */
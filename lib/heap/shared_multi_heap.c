@@ -13,15 +13,70 @@
 
 static struct sys_multi_heap shared_multi_heap;
 
+struct smh_heap {
+	struct sys_heap heap;
+
+	/* Smallest request refused since the last free, 0 if none */
+	size_t fail_bytes;
+};
+
 static struct {
-	struct sys_heap heap_pool[MAX_MULTI_HEAPS];
+	struct smh_heap heap_pool[MAX_MULTI_HEAPS];
 	unsigned int heap_cnt;
 } smh_data[MAX_SHARED_MULTI_HEAP_ATTR];
 
+/*
+ * Pick the next heap to try among the candidates, dropping the ones that are
+ * known not to be able to satisfy the request.
+ */
+static struct smh_heap *smh_pick(struct smh_heap *pool, uint32_t *candidates, size_t size)
+{
+	struct smh_heap *best = NULL;
+	size_t best_free = 0;
+	unsigned int best_hdx = 0;
+
+	for (unsigned int hdx = 0; hdx < MAX_MULTI_HEAPS; hdx++) {
+		struct smh_heap *h = &pool[hdx];
+		size_t free_bytes = SIZE_MAX;
+
+		if ((*candidates & BIT(hdx)) == 0) {
+			continue;
+		}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		struct sys_memory_stats stats;
+
+		sys_heap_runtime_stats_get(&h->heap, &stats);
+		free_bytes = stats.free_bytes;
+#endif
+
+		if (h->heap.heap == NULL || free_bytes < size ||
+		    (h->fail_bytes != 0 && size >= h->fail_bytes)) {
+			*candidates &= ~BIT(hdx);
+			continue;
+		}
+
+		if (best == NULL || free_bytes > best_free) {
+			best = h;
+			best_free = free_bytes;
+			best_hdx = hdx;
+		}
+
+		if (!IS_ENABLED(CONFIG_MULTI_HEAP_PREFER_FREE)) {
+			break;
+		}
+	}
+
+	*candidates &= ~BIT(best_hdx);
+
+	return best;
+}
+
 static void *smh_choice(struct sys_multi_heap *mheap, void *cfg, size_t align, size_t size)
 {
-	struct sys_heap *h;
+	struct smh_heap *h;
 	enum shared_multi_heap_attr attr;
+	uint32_t candidates;
 	void *block;
 
 	attr = (enum shared_multi_heap_attr)(long) cfg;
@@ -33,17 +88,20 @@ static void *smh_choice(struct sys_multi_heap *mheap, void *cfg, size_t align, s
 	/* Set in case the user requested a non-existing attr */
 	block = NULL;
 
-	for (size_t hdx = 0; hdx < smh_data[attr].heap_cnt; hdx++) {
-		h = &smh_data[attr].heap_pool[hdx];
+	candidates = BIT_MASK(smh_data[attr].heap_cnt);
 
-		if (h->heap == NULL) {
-			return NULL;
-		}
-
-		block = sys_heap_aligned_alloc(h, align, size);
+	while ((h = smh_pick(smh_data[attr].heap_pool, &candidates, size)) != NULL) {
+		block = sys_heap_aligned_alloc(&h->heap, align, size);
 		if (block != NULL) {
 			break;
 		}
+
+		/* Larger requests fail as well until something is freed,
+		 * whatever their alignment.
+		 */
+		if (align <= sizeof(void *)) {
+			h->fail_bytes = size;
+		}
 	}
 
 	return block;
@@ -67,7 +125,7 @@ int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_da
 	}
 
 	slot = smh_data[attr].heap_cnt;
-	h = &smh_data[attr].heap_pool[slot];
+	h = &smh_data[attr].heap_pool[slot].heap;
 
 	sys_heap_init(h, (void *) region->addr, region->size);
 	sys_multi_heap_add_heap(&shared_multi_heap, h, user_data);
@@ -79,7 +137,16 @@ int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_da
 
 void shared_multi_heap_free(void *block)
 {
-	sys_multi_heap_free(&shared_multi_heap, block);
+	const struct sys_multi_heap_rec *rec;
+	struct smh_heap *h;
+
+	rec = sys_multi_heap_get_heap(&shared_multi_heap, block);
+
+	if (rec != NULL) {
+		h = CONTAINER_OF(rec->heap, struct smh_heap, heap);
+		h->fail_bytes = 0;
+		sys_heap_free(&h->heap, block);
+	}
 }
 
 void *shared_multi_heap_alloc(enum shared_multi_heap_attr attr, size_t bytes)
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2018 Linaro Limited
+ * Copyright The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -22,6 +23,7 @@
 #include <zephyr/sys/speculation.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/math_extras.h>
 
 struct fd_entry {
 	void *obj;
@@ -68,7 +70,24 @@ static struct fd_entry fdtable[CONFIG_POSIX_MAX_FDS] = {
 #endif
 };
 
-static K_MUTEX_DEFINE(fdtable_lock);
+/*
+ * Bitmap of the allocated entries, so that free descriptors are found a word
+ * at a time, and claimed without a lock.
+ */
+static atomic_t fdtable_used[ATOMIC_BITMAP_SIZE(CONFIG_POSIX_MAX_FDS)] = {
+#ifdef CONFIG_POSIX_API
+	ATOMIC_INIT(BIT_MASK(3)),
+#endif
+};
+
+static inline int fd_bitmap_lsb(atomic_val_t val)
+{
+	if (sizeof(val) == sizeof(uint64_t)) {
+		return u64_count_trailing_zeros((uint64_t)val);
+	}
+
+	return u32_count_trailing_zeros((uint32_t)val);
+}
 
 static int z_fd_ref(int fd)
 {
@@ -98,16 +117,63 @@ static int z_fd_unref(int fd)
 	fdtable[fd].obj = NULL;
 	fdtable[fd].vtable = NULL;
 
+	/* The entry can be reserved again */
+	atomic_clear_bit(fdtable_used, fd);
+
 	return 0;
 }
 
+/*
+ * Take a reference to an entry which is in use, so that it is not freed
+ * while a call on it is in progress
+ */
+static struct fd_entry *z_fd_get(int fd)
+{
+	atomic_val_t old_rc;
+
+	if (fd < 0 || fd >= ARRAY_SIZE(fdtable)) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	fd = k_array_index_sanitize(fd, ARRAY_SIZE(fdtable));
+
+	do {
+		old_rc = atomic_get(&fdtable[fd].refcount);
+		if (!old_rc) {
+			errno = EBADF;
+			return NULL;
+		}
+	} while (!atomic_cas(&fdtable[fd].refcount, old_rc, old_rc + 1));
+
+	return &fdtable[fd];
+}
+
+static void z_fd_put(struct fd_entry *entry)
+{
+	(void)z_fd_unref(entry - fdtable);
+}
+
+/* Find and claim a free entry */
 static int _find_fd_entry(void)
 {
+	atomic_val_t used;
 	int fd;
 
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (!atomic_get(&fdtable[fd].refcount)) {
-			return fd;
+	for (size_t i = 0; i < ARRAY_SIZE(fdtable_used); i++) {
+		used = atomic_get(&fdtable_used[i]);
+
+		while (~used != 0) {
+			fd = i * ATOMIC_BITS + fd_bitmap_lsb(~used);
+			if (fd >= ARRAY_SIZE(fdtable)) {
+				break;
+			}
+
+			if (atomic_cas(&fdtable_used[i], used, used | BIT(fd % ATOMIC_BITS))) {
+				return fd;
+			}
+
+			used = atomic_get(&fdtable_used[i]);
 		}
 	}
 
@@ -176,11 +242,20 @@ void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err)
 
 static int z_get_fd_by_obj_and_vtable(void *obj, const struct fd_op_vtable *vtable)
 {
+	atomic_val_t used;
 	int fd;
 
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (fdtable[fd].obj == obj && fdtable[fd].vtable == vtable) {
-			return fd;
+	/* Only look at the entries in use */
+	for (size_t i = 0; i < ARRAY_SIZE(fdtable_used); i++) {
+		used = atomic_get(&fdtable_used[i]);
+
+		while (used != 0) {
+			fd = i * ATOMIC_BITS + fd_bitmap_lsb(used);
+			used &= used - 1;
+
+			if (fdtable[fd].obj == obj && fdtable[fd].vtable == vtable) {
+				return fd;
+			}
 		}
 	}
 
@@ -235,20 +310,16 @@ int z_reserve_fd(void)
 {
 	int fd;
 
-	(void)k_mutex_lock(&fdtable_lock, K_FOREVER);
-
 	fd = _find_fd_entry();
 	if (fd >= 0) {
 		/* Mark entry as used, z_finalize_fd() will fill it in. */
-		(void)z_fd_ref(fd);
 		fdtable[fd].obj = NULL;
 		fdtable[fd].vtable = NULL;
 		k_mutex_init(&fdtable[fd].lock);
 		k_condvar_init(&fdtable[fd].cond);
+		(void)z_fd_ref(fd);
 	}
 
-	k_mutex_unlock(&fdtable_lock);
-
 	return fd;
 }
 
@@ -301,16 +372,20 @@ int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
 ssize_t read(int fd, void *buf, size_t sz)
 {
 	ssize_t res;
+	struct fd_entry *entry;
 
-	if (_check_fd(fd) < 0) {
+	entry = z_fd_get(fd);
+	if (entry == NULL) {
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
 
-	res = fdtable[fd].vtable->read(fdtable[fd].obj, buf, sz);
+	res = entry->vtable->read(entry->obj, buf, sz);
 
-	k_mutex_unlock(&fdtable[fd].lock);
+	k_mutex_unlock(&entry->lock);
+
+	z_fd_put(entry);
 
 	return res;
 }
@@ -319,16 +394,20 @@ FUNC_ALIAS(read, _read, ssize_t);
 ssize_t write(int fd, const void *buf, size_t sz)
 {
 	ssize_t res;
+	struct fd_entry *entry;
 
-	if (_check_fd(fd) < 0) {
+	entry = z_fd_get(fd);
+	if (entry == NULL) {
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
+
+	res = entry->vtable->write(entry->obj, buf, sz);
 
-	res = fdtable[fd].vtable->write(fdtable[fd].obj, buf, sz);
+	k_mutex_unlock(&entry->lock);
 
-	k_mutex_unlock(&fdtable[fd].lock);
+	z_fd_put(entry);
 
 	return res;
 }
@@ -337,18 +416,22 @@ FUNC_ALIAS(write, _write, ssize_t);
 int close(int fd)
 {
 	int res;
+	struct fd_entry *entry;
 
-	if (_check_fd(fd) < 0) {
+	entry = z_fd_get(fd);
+	if (entry == NULL) {
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
 
-	res = fdtable[fd].vtable->close(fdtable[fd].obj);
+	res = entry->vtable->close(entry->obj);
 
-	k_mutex_unlock(&fdtable[fd].lock);
+	k_mutex_unlock(&entry->lock);
 
+	/* Drop the reference of the descriptor, then ours */
 	z_free_fd(fd);
+	z_fd_put(entry);
 
 	return res;
 }
@@ -356,21 +439,37 @@ FUNC_ALIAS(close, _close, int);
 
 int fsync(int fd)
 {
-	if (_check_fd(fd) < 0) {
+	int res;
+	struct fd_entry *entry;
+
+	entry = z_fd_get(fd);
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_FSYNC);
+	res = z_fdtable_call_ioctl(entry->vtable, entry->obj, ZFD_IOCTL_FSYNC);
+
+	z_fd_put(entry);
+
+	return res;
 }
 
 off_t lseek(int fd, off_t offset, int whence)
 {
-	if (_check_fd(fd) < 0) {
+	off_t res;
+	struct fd_entry *entry;
+
+	entry = z_fd_get(fd);
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_LSEEK,
-			  offset, whence);
+	res = z_fdtable_call_ioctl(entry->vtable, entry->obj, ZFD_IOCTL_LSEEK,
+				   offset, whence);
+
+	z_fd_put(entry);
+
+	return res;
 }
 FUNC_ALIAS(lseek, _lseek, off_t);
 
@@ -378,15 +477,19 @@ int ioctl(int fd, unsigned long request, ...)
 {
 	va_list args;
 	int res;
+	struct fd_entry *entry;
 
-	if (_check_fd(fd) < 0) {
+	entry = z_fd_get(fd);
+	if (entry == NULL) {
 		return -1;
 	}
 
 	va_start(args, request);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, request, args);
+	res = entry->vtable->ioctl(entry->obj, request, args);
 	va_end(args);
 
+	z_fd_put(entry);
+
 	return res;
 }
 
@@ -394,23 +497,28 @@ int fcntl(int fd, int cmd, ...)
 {
 	va_list args;
 	int res;
+	struct fd_entry *entry;
 
-	if (_check_fd(fd) < 0) {
+	entry = z_fd_get(fd);
+	if (entry == NULL) {
 		return -1;
 	}
 
 	/* Handle fdtable commands. */
 	if (cmd == F_DUPFD) {
 		/* Not implemented so far. */
+		z_fd_put(entry);
 		errno = EINVAL;
 		return -1;
 	}
 
 	/* The rest of commands are per-fd, handled by ioctl vmethod. */
 	va_start(args, cmd);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, cmd, args);
+	res = entry->vtable->ioctl(entry->obj, cmd, args);
 	va_end(args);
 
+	z_fd_put(entry);
+
 	return res;
 }
 
@@ -23,7 +23,9 @@
 #include <zephyr/llext/symbol.h>
 #include <sys/types.h>
 
-/* Option present only when CONFIG_USERSPACE enabled. */
+/* Option present only when CONFIG_USERSPACE or CONFIG_PRINTK_LINE_BUFFER
+ * enabled.
+ */
 #ifndef CONFIG_PRINTK_BUFFER_SIZE
 #define CONFIG_PRINTK_BUFFER_SIZE 0
 #endif
@@ -54,18 +56,36 @@ __attribute__((weak)) int arch_printk_char_out(int c)
 
 int (*_char_out)(int c) = arch_printk_char_out;
 
+static void (*_str_out)(const char *s, size_t n);
+
 /**
  * @brief Install the character output routine for printk
  *
  * To be called by the platform's console driver at init time. Installs a
- * routine that outputs one ASCII character at a time.
+ * routine that outputs one ASCII character at a time. This drops the string
+ * output routine, which belongs to the previous console.
  * @param fn putc routine to install
  */
 void __printk_hook_install(int (*fn)(int c))
 {
+	_str_out = NULL;
 	_char_out = fn;
 }
 
+/**
+ * @brief Install the string output routine for printk
+ *
+ * To be called by the platform's console driver at init time, after
+ * __printk_hook_install(). Installs a routine that outputs a whole buffer
+ * of characters, used instead of the character output routine for the
+ * buffered output of printk.
+ * @param fn routine to install, NULL to output each character on its own
+ */
+void __printk_str_hook_install(void (*fn)(const char *s, size_t n))
+{
+	_str_out = fn;
+}
+
 /**
  * @brief Get the current character output routine for printk
  *
@@ -98,7 +118,8 @@ static int buf_char_out(int c, void *ctx_p)
 	struct buf_out_context *ctx = ctx_p;
 
 	ctx->buf[ctx->buf_count++] = c;
-	if (ctx->buf_count == CONFIG_PRINTK_BUFFER_SIZE) {
+	if (ctx->buf_count == CONFIG_PRINTK_BUFFER_SIZE ||
+	    (IS_ENABLED(CONFIG_PRINTK_LINE_BUFFER) && c == '\n')) {
 		buf_flush(ctx);
 	}
 
@@ -118,7 +139,11 @@ void vprintk(const char *fmt, va_list ap)
 		return;
 	}
 
-	if (k_is_user_context()) {
+	/* The line buffer is on the stack of the caller, so that threads and
+	 * CPUs printing at the same time each fill their own and hand whole
+	 * lines to the console.
+	 */
+	if (IS_ENABLED(CONFIG_PRINTK_LINE_BUFFER) || k_is_user_context()) {
 		struct buf_out_context ctx = {
 #ifdef CONFIG_PICOLIBC
 			.file = FDEV_SETUP_STREAM((int(*)(char, FILE *))buf_char_out,
@@ -163,8 +188,12 @@ void z_impl_k_str_out(char *c, size_t n)
 	k_spinlock_key_t key = k_spin_lock(&lock);
 #endif
 
-	for (i = 0; i < n; i++) {
-		_char_out(c[i]);
+	if (_str_out != NULL) {
+		_str_out(c, n);
+	} else {
+		for (i = 0; i < n; i++) {
+			_char_out(c[i]);
+		}
 	}
 
 #ifdef CONFIG_PRINTK_SYNC
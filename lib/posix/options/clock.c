@@ -64,22 +64,52 @@ int clock_gettime(clockid_t clock_id, struct timespec *ts)
 {
 	struct timespec base;
 
-	switch (clock_id) {
-	case CLOCK_MONOTONIC:
-		base.tv_sec = 0;
-		base.tv_nsec = 0;
-		break;
-
-	case CLOCK_REALTIME:
-		(void)__posix_clock_get_base(clock_id, &base);
-		break;
+	uint64_t ticks;
+
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+	if (k_is_user_context()) {
+		int64_t rt_sec;
+		int32_t rt_nsec;
+
+		/* Read both from the time page, without a system call */
+		ticks = z_time_page_read(&rt_sec, &rt_nsec);
+
+		switch (clock_id) {
+		case CLOCK_MONOTONIC:
+			base.tv_sec = 0;
+			base.tv_nsec = 0;
+			break;
+
+		case CLOCK_REALTIME:
+			base.tv_sec = (time_t)rt_sec;
+			base.tv_nsec = rt_nsec;
+			break;
+
+		default:
+			errno = EINVAL;
+			return -1;
+		}
+	} else
+#endif /* CONFIG_USERSPACE_TIME_PAGE */
+	{
+		switch (clock_id) {
+		case CLOCK_MONOTONIC:
+			base.tv_sec = 0;
+			base.tv_nsec = 0;
+			break;
+
+		case CLOCK_REALTIME:
+			(void)__posix_clock_get_base(clock_id, &base);
+			break;
+
+		default:
+			errno = EINVAL;
+			return -1;
+		}
 
-	default:
-		errno = EINVAL;
-		return -1;
+		ticks = k_uptime_ticks();
 	}
 
-	uint64_t ticks = k_uptime_ticks();
 	uint64_t elapsed_secs = ticks / CONFIG_SYS_CLOCK_TICKS_PER_SEC;
 	uint64_t nremainder = ticks - elapsed_secs * CONFIG_SYS_CLOCK_TICKS_PER_SEC;
 
@@ -151,6 +181,9 @@ int clock_settime(clockid_t clock_id, const struct timespec *tp)
 
 	key = k_spin_lock(&rt_clock_base_lock);
 	rt_clock_base = base;
+#ifdef CONFIG_USERSPACE_TIME_PAGE
+	z_time_page_set_realtime(base.tv_sec, base.tv_nsec);
+#endif
 	k_spin_unlock(&rt_clock_base_lock, key);
 
 	return 0;
@@ -17,7 +17,20 @@ LOG_MODULE_REGISTER(pthread_cond, CONFIG_PTHREAD_COND_LOG_LEVEL);
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+/*
+ * The futex of a condition variable holds a sequence number, incremented on
+ * every signal, and the kernel is only entered when there are waiters.
+ */
+typedef struct k_futex posix_cond_t;
+
+static struct k_futex posix_cond_pool[CONFIG_MAX_PTHREAD_COND_COUNT];
+static atomic_t posix_cond_waiters[CONFIG_MAX_PTHREAD_COND_COUNT];
+#else
+typedef struct k_condvar posix_cond_t;
+
 static struct k_condvar posix_cond_pool[CONFIG_MAX_PTHREAD_COND_COUNT];
+#endif
 SYS_BITARRAY_DEFINE_STATIC(posix_cond_bitarray, CONFIG_MAX_PTHREAD_COND_COUNT);
 
 /*
@@ -28,7 +41,7 @@ SYS_BITARRAY_DEFINE_STATIC(posix_cond_bitarray, CONFIG_MAX_PTHREAD_COND_COUNT);
 BUILD_ASSERT(CONFIG_MAX_PTHREAD_COND_COUNT < PTHREAD_OBJ_MASK_INIT,
 	     "CONFIG_MAX_PTHREAD_COND_COUNT is too high");
 
-static inline size_t posix_cond_to_offset(struct k_condvar *cv)
+static inline size_t posix_cond_to_offset(posix_cond_t *cv)
 {
 	return cv - posix_cond_pool;
 }
@@ -38,7 +51,7 @@ static inline size_t to_posix_cond_idx(pthread_cond_t cond)
 	return mark_pthread_obj_uninitialized(cond);
 }
 
-static struct k_condvar *get_posix_cond(pthread_cond_t cond)
+static posix_cond_t *get_posix_cond(pthread_cond_t cond)
 {
 	int actually_initialized;
 	size_t bit = to_posix_cond_idx(cond);
@@ -64,10 +77,10 @@ static struct k_condvar *get_posix_cond(pthread_cond_t cond)
 	return &posix_cond_pool[bit];
 }
 
-static struct k_condvar *to_posix_cond(pthread_cond_t *cvar)
+static posix_cond_t *to_posix_cond(pthread_cond_t *cvar)
 {
 	size_t bit;
-	struct k_condvar *cv;
+	posix_cond_t *cv;
 
 	if (*cvar != PTHREAD_COND_INITIALIZER) {
 		return get_posix_cond(*cvar);
@@ -87,6 +100,67 @@ static struct k_condvar *to_posix_cond(pthread_cond_t *cvar)
 	return cv;
 }
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+
+static int cond_wait(pthread_cond_t *cond, pthread_mutex_t *mu, k_timeout_t timeout)
+{
+	int ret;
+	int seq;
+	atomic_t *waiters;
+	posix_cond_t *cv;
+
+	cv = to_posix_cond(cond);
+	if (cv == NULL) {
+		return EINVAL;
+	}
+
+	/* Count ourselves as a waiter before a signal can be missed */
+	waiters = &posix_cond_waiters[posix_cond_to_offset(cv)];
+	(void)atomic_inc(waiters);
+	seq = (int)atomic_get(&cv->val);
+
+	ret = pthread_mutex_unlock(mu);
+	if (ret != 0) {
+		(void)atomic_dec(waiters);
+		return ret;
+	}
+
+	LOG_DBG("Waiting on cond %p with timeout %llx", cv, timeout.ticks);
+	ret = k_futex_wait(cv, seq, timeout);
+	(void)atomic_dec(waiters);
+
+	if (ret == -ETIMEDOUT) {
+		LOG_DBG("Timeout waiting on cond %p", cv);
+		ret = ETIMEDOUT;
+	} else {
+		/* -EAGAIN: signaled before we could wait */
+		LOG_DBG("Cond %p received signal", cv);
+		ret = 0;
+	}
+
+	/* The mutex is reacquired, even on timeout */
+	(void)pthread_mutex_lock(mu);
+
+	return ret;
+}
+
+static int cond_wake(posix_cond_t *cv, bool wake_all)
+{
+	int ret;
+
+	/* Fast path: nobody waits on the condition variable */
+	if (atomic_get(&posix_cond_waiters[posix_cond_to_offset(cv)]) == 0) {
+		return 0;
+	}
+
+	(void)atomic_inc(&cv->val);
+	ret = k_futex_wake(cv, wake_all);
+
+	return ret < 0 ? ret : 0;
+}
+
+#else /* CONFIG_PTHREAD_MUTEX_FUTEX */
+
 static int cond_wait(pthread_cond_t *cond, pthread_mutex_t *mu, k_timeout_t timeout)
 {
 	int ret;
@@ -115,10 +189,17 @@ static int cond_wait(pthread_cond_t *cond, pthread_mutex_t *mu, k_timeout_t time
 	return ret;
 }
 
+static int cond_wake(posix_cond_t *cv, bool wake_all)
+{
+	return wake_all ? k_condvar_broadcast(cv) : k_condvar_signal(cv);
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FUTEX */
+
 int pthread_cond_signal(pthread_cond_t *cvar)
 {
 	int ret;
-	struct k_condvar *cv;
+	posix_cond_t *cv;
 
 	cv = to_posix_cond(cvar);
 	if (cv == NULL) {
@@ -126,9 +207,9 @@ int pthread_cond_signal(pthread_cond_t *cvar)
 	}
 
 	LOG_DBG("Signaling cond %p", cv);
-	ret = k_condvar_signal(cv);
+	ret = cond_wake(cv, false);
 	if (ret < 0) {
-		LOG_DBG("k_condvar_signal() failed: %d", ret);
+		LOG_DBG("cond_wake() failed: %d", ret);
 		return -ret;
 	}
 
@@ -140,7 +221,7 @@ int pthread_cond_signal(pthread_cond_t *cvar)
 int pthread_cond_broadcast(pthread_cond_t *cvar)
 {
 	int ret;
-	struct k_condvar *cv;
+	posix_cond_t *cv;
 
 	cv = get_posix_cond(*cvar);
 	if (cv == NULL) {
@@ -148,9 +229,9 @@ int pthread_cond_broadcast(pthread_cond_t *cvar)
 	}
 
 	LOG_DBG("Broadcasting on cond %p", cv);
-	ret = k_condvar_broadcast(cv);
+	ret = cond_wake(cv, true);
 	if (ret < 0) {
-		LOG_DBG("k_condvar_broadcast() failed: %d", ret);
+		LOG_DBG("cond_wake() failed: %d", ret);
 		return -ret;
 	}
 
@@ -171,7 +252,7 @@ int pthread_cond_timedwait(pthread_cond_t *cv, pthread_mutex_t *mut, const struc
 
 int pthread_cond_init(pthread_cond_t *cvar, const pthread_condattr_t *att)
 {
-	struct k_condvar *cv;
+	posix_cond_t *cv;
 
 	ARG_UNUSED(att);
 	*cvar = PTHREAD_COND_INITIALIZER;
@@ -191,7 +272,7 @@ int pthread_cond_destroy(pthread_cond_t *cvar)
 {
 	int err;
 	size_t bit;
-	struct k_condvar *cv;
+	posix_cond_t *cv;
 
 	cv = get_posix_cond(*cvar);
 	if (cv == NULL) {
@@ -211,12 +292,16 @@ int pthread_cond_destroy(pthread_cond_t *cvar)
 
 static int pthread_cond_pool_init(void)
 {
-	int err;
 	size_t i;
 
 	for (i = 0; i < CONFIG_MAX_PTHREAD_COND_COUNT; ++i) {
-		err = k_condvar_init(&posix_cond_pool[i]);
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+		atomic_clear(&posix_cond_waiters[i]);
+#else
+		int err = k_condvar_init(&posix_cond_pool[i]);
+
 		__ASSERT_NO_MSG(err == 0);
+#endif
 	}
 
 	return 0;
@@ -10,14 +10,48 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/posix/mqueue.h>
 #include <zephyr/posix/pthread.h>
+#include <zephyr/posix/unistd.h>
 
 #define SIGEV_MASK (SIGEV_NONE | SIGEV_SIGNAL | SIGEV_THREAD)
 
+/* End of a list of message slots */
+#define MQ_SLOT_END UINT16_MAX
+
+BUILD_ASSERT(MQ_PRIO_MAX <= 32, "priority bitmap holds at most 32 priorities");
+
+/*
+ * Messages are stored in fixed size slots. A slot is either on the free list
+ * or queued in the FIFO bucket of its priority, so that sending and receiving
+ * never walk the queue: the highest non-empty bucket is found in the bitmap.
+ */
+struct mqueue_msg {
+	uint16_t next;
+	uint16_t prio;
+	uint32_t len;
+	char data[];
+};
+
+struct mqueue_bucket {
+	uint16_t head;
+	uint16_t tail;
+};
+
 typedef struct mqueue_object {
 	sys_snode_t snode;
 	char *mem_buffer;
 	char *mem_obj;
-	struct k_msgq queue;
+	struct k_spinlock lock;
+	/* Free slots, taken by the senders */
+	struct k_sem free_sem;
+	/* Queued messages, taken by the receivers */
+	struct k_sem used_sem;
+	size_t msg_size;
+	size_t slot_size;
+	uint16_t max_msgs;
+	uint16_t used_msgs;
+	uint16_t free_head;
+	uint32_t prio_bitmap;
+	struct mqueue_bucket bucket[MQ_PRIO_MAX];
 	atomic_t ref_count;
 	char *name;
 	struct sigevent not;
@@ -37,9 +71,15 @@ sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 static mqueue_object *find_in_list(const char *name);
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout);
+			    unsigned int msg_prio, k_timeout_t timeout);
 static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			   k_timeout_t timeout);
+			       unsigned int *msg_prio, k_timeout_t timeout);
+static void mq_init_slots(mqueue_object *msg_queue);
+static struct mqueue_msg *claim_slot(mqueue_desc *mqd, k_timeout_t timeout);
+static void commit_slot(mqueue_desc *mqd, struct mqueue_msg *msg, size_t msg_len,
+			unsigned int msg_prio);
+static struct mqueue_msg *get_slot(mqueue_desc *mqd, k_timeout_t timeout);
+static void release_slot(mqueue_object *msg_queue, struct mqueue_msg *msg);
 static void remove_notification(mqueue_object *msg_queue);
 static void remove_mq(mqueue_object *msg_queue);
 static void *mq_notify_thread(void *arg);
@@ -143,19 +183,25 @@ mqd_t mq_open(const char *name, int oflags, ...)
 
 		strcpy(msg_queue->name, name);
 
-		mq_buf_ptr = k_malloc(msg_size * max_msgs * sizeof(uint8_t));
+		if (max_msgs >= MQ_SLOT_END || msg_size > UINT32_MAX) {
+			goto free_mq_buffer;
+		}
+
+		msg_queue->msg_size = msg_size;
+		msg_queue->slot_size = ROUND_UP(sizeof(struct mqueue_msg) + msg_size,
+						__alignof__(struct mqueue_msg));
+		msg_queue->max_msgs = max_msgs;
+
+		mq_buf_ptr = k_malloc(msg_queue->slot_size * max_msgs);
 		if (mq_buf_ptr != NULL) {
-			(void)memset(mq_buf_ptr, 0,
-				     msg_size * max_msgs * sizeof(uint8_t));
+			(void)memset(mq_buf_ptr, 0, msg_queue->slot_size * max_msgs);
 			msg_queue->mem_buffer = mq_buf_ptr;
 		} else {
 			goto free_mq_buffer;
 		}
 
 		(void)atomic_set(&msg_queue->ref_count, 1);
-		/* initialize zephyr message queue */
-		k_msgq_init(&msg_queue->queue, msg_queue->mem_buffer, msg_size,
-			    max_msgs);
+		mq_init_slots(msg_queue);
 		k_sem_take(&mq_sem, K_FOREVER);
 		sys_slist_append(&mq_list, (sys_snode_t *)&(msg_queue->snode));
 		k_sem_give(&mq_sem);
@@ -232,7 +278,8 @@ int mq_unlink(const char *name)
 /**
  * @brief Send a message to a message queue.
  *
- * All messages in message queue are of equal priority.
+ * Messages are received by decreasing priority, and in the order they were
+ * sent within a priority.
  *
  * See IEEE 1003.1
  */
@@ -241,14 +288,12 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return send_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, K_FOREVER);
 }
 
 /**
  * @brief Send message to a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
@@ -257,13 +302,13 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	int32_t timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	return send_message(mqd, msg_ptr, msg_len, K_MSEC(timeout));
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, K_MSEC(timeout));
 }
 
 /**
  * @brief Receive a message from a message queue.
  *
- * All messages in message queue are of equal priority.
+ * The oldest message of the highest priority is received.
  *
  * See IEEE 1003.1
  */
@@ -272,14 +317,12 @@ int mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return receive_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, K_FOREVER);
 }
 
 /**
  * @brief Receive message from a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
@@ -288,7 +331,7 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	int32_t timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	return receive_message(mqd, msg_ptr, msg_len, K_MSEC(timeout));
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, K_MSEC(timeout));
 }
 
 /**
@@ -299,19 +342,23 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
-	struct k_msgq_attrs attrs;
+	mqueue_object *msg_queue;
+	k_spinlock_key_t key;
 
 	if (mqd == NULL) {
 		errno = EBADF;
 		return -1;
 	}
 
+	msg_queue = mqd->mqueue;
+
 	k_sem_take(&mq_sem, K_FOREVER);
-	k_msgq_get_attrs(&mqd->mqueue->queue, &attrs);
 	mqstat->mq_flags = mqd->flags;
-	mqstat->mq_maxmsg = attrs.max_msgs;
-	mqstat->mq_msgsize = attrs.msg_size;
-	mqstat->mq_curmsgs = attrs.used_msgs;
+	mqstat->mq_maxmsg = msg_queue->max_msgs;
+	mqstat->mq_msgsize = msg_queue->msg_size;
+	key = k_spin_lock(&msg_queue->lock);
+	mqstat->mq_curmsgs = msg_queue->used_msgs;
+	k_spin_unlock(&msg_queue->lock, key);
 	k_sem_give(&mq_sem);
 	return 0;
 }
@@ -396,6 +443,120 @@ int mq_notify(mqd_t mqdes, const struct sigevent *notification)
 	return 0;
 }
 
+#ifdef CONFIG_POSIX_MQUEUE_ZERO_COPY
+static k_timeout_t mq_abstime_to_timeout(const struct timespec *abstime)
+{
+	if (abstime == NULL) {
+		return K_FOREVER;
+	}
+
+	return K_MSEC((int32_t)timespec_to_timeoutms(abstime));
+}
+
+static struct mqueue_msg *mq_msg_of(mqueue_desc *mqd, void *msg_ptr)
+{
+	mqueue_object *msg_queue = mqd->mqueue;
+	char *slot = (char *)msg_ptr - offsetof(struct mqueue_msg, data);
+	size_t off = slot - msg_queue->mem_buffer;
+
+	if ((msg_ptr == NULL) || (slot < msg_queue->mem_buffer) ||
+	    (off >= msg_queue->slot_size * msg_queue->max_msgs) ||
+	    (off % msg_queue->slot_size) != 0) {
+		return NULL;
+	}
+
+	return (struct mqueue_msg *)slot;
+}
+
+int mq_send_claim_np(mqd_t mqdes, void **msg_ptr, const struct timespec *abstime)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	struct mqueue_msg *msg;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	msg = claim_slot(mqd, mq_abstime_to_timeout(abstime));
+	if (msg == NULL) {
+		return -1;
+	}
+
+	*msg_ptr = msg->data;
+	return 0;
+}
+
+int mq_send_commit_np(mqd_t mqdes, void *msg_ptr, size_t msg_len, unsigned int msg_prio)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	struct mqueue_msg *msg;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	msg = mq_msg_of(mqd, msg_ptr);
+	if ((msg == NULL) || (msg_prio >= MQ_PRIO_MAX)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (msg_len > mqd->mqueue->msg_size) {
+		errno = EMSGSIZE;
+		return -1;
+	}
+
+	commit_slot(mqd, msg, msg_len, msg_prio);
+	return 0;
+}
+
+int mq_receive_claim_np(mqd_t mqdes, void **msg_ptr, unsigned int *msg_prio,
+			const struct timespec *abstime)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	struct mqueue_msg *msg;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	msg = get_slot(mqd, mq_abstime_to_timeout(abstime));
+	if (msg == NULL) {
+		return -1;
+	}
+
+	*msg_ptr = msg->data;
+	if (msg_prio != NULL) {
+		*msg_prio = msg->prio;
+	}
+
+	return msg->len;
+}
+
+int mq_receive_release_np(mqd_t mqdes, void *msg_ptr)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	struct mqueue_msg *msg;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	msg = mq_msg_of(mqd, msg_ptr);
+	if (msg == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	release_slot(mqd->mqueue, msg);
+	return 0;
+}
+#endif /* CONFIG_POSIX_MQUEUE_ZERO_COPY */
+
 static void *mq_notify_thread(void *arg)
 {
 	mqueue_object *mqueue = (mqueue_object *)arg;
@@ -434,74 +595,197 @@ static mqueue_object *find_in_list(const char *name)
 	return NULL;
 }
 
-static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout)
+static inline struct mqueue_msg *mq_slot(mqueue_object *msg_queue, uint16_t idx)
 {
-	int32_t ret = -1;
+	return (struct mqueue_msg *)&msg_queue->mem_buffer[idx * msg_queue->slot_size];
+}
 
-	if (mqd == NULL) {
-		errno = EBADF;
-		return ret;
+static inline uint16_t mq_slot_idx(mqueue_object *msg_queue, struct mqueue_msg *msg)
+{
+	return ((char *)msg - msg_queue->mem_buffer) / msg_queue->slot_size;
+}
+
+static void mq_init_slots(mqueue_object *msg_queue)
+{
+	for (uint16_t i = 0; i < msg_queue->max_msgs; i++) {
+		mq_slot(msg_queue, i)->next = (i + 1 < msg_queue->max_msgs) ? i + 1 : MQ_SLOT_END;
 	}
 
+	for (int prio = 0; prio < MQ_PRIO_MAX; prio++) {
+		msg_queue->bucket[prio].head = MQ_SLOT_END;
+		msg_queue->bucket[prio].tail = MQ_SLOT_END;
+	}
+
+	msg_queue->free_head = 0;
+	msg_queue->used_msgs = 0;
+	msg_queue->prio_bitmap = 0;
+	k_sem_init(&msg_queue->free_sem, msg_queue->max_msgs, msg_queue->max_msgs);
+	k_sem_init(&msg_queue->used_sem, 0, msg_queue->max_msgs);
+}
+
+/* Take a free slot, waiting up to timeout for a receiver to release one */
+static struct mqueue_msg *claim_slot(mqueue_desc *mqd, k_timeout_t timeout)
+{
+	mqueue_object *msg_queue = mqd->mqueue;
+	struct mqueue_msg *msg;
+	k_spinlock_key_t key;
+
 	if ((mqd->flags & O_NONBLOCK) != 0U) {
 		timeout = K_NO_WAIT;
 	}
 
-	if (msg_len >  mqd->mqueue->queue.msg_size) {
-		errno = EMSGSIZE;
-		return ret;
+	if (k_sem_take(&msg_queue->free_sem, timeout) != 0) {
+		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
+		return NULL;
 	}
 
-	uint32_t msgq_num = k_msgq_num_used_get(&mqd->mqueue->queue);
+	key = k_spin_lock(&msg_queue->lock);
+	msg = mq_slot(msg_queue, msg_queue->free_head);
+	msg_queue->free_head = msg->next;
+	k_spin_unlock(&msg_queue->lock, key);
+
+	return msg;
+}
+
+/* Queue a claimed slot at the tail of the bucket of its priority */
+static void commit_slot(mqueue_desc *mqd, struct mqueue_msg *msg, size_t msg_len,
+			unsigned int msg_prio)
+{
+	mqueue_object *msg_queue = mqd->mqueue;
+	struct mqueue_bucket *bucket = &msg_queue->bucket[msg_prio];
+	uint16_t idx = mq_slot_idx(msg_queue, msg);
+	struct sigevent *sevp = &msg_queue->not;
+	k_spinlock_key_t key;
+
+	msg->next = MQ_SLOT_END;
+	msg->prio = msg_prio;
+	msg->len = msg_len;
+
+	key = k_spin_lock(&msg_queue->lock);
+	if (bucket->tail == MQ_SLOT_END) {
+		bucket->head = idx;
+		msg_queue->prio_bitmap |= BIT(msg_prio);
+	} else {
+		mq_slot(msg_queue, bucket->tail)->next = idx;
+	}
+	bucket->tail = idx;
+	msg_queue->used_msgs++;
+	k_spin_unlock(&msg_queue->lock, key);
+
+	k_sem_give(&msg_queue->used_sem);
+
+	if (sevp->sigev_notify == SIGEV_NONE) {
+		sevp->sigev_notify_function(sevp->sigev_value);
+	} else if (sevp->sigev_notify == SIGEV_THREAD) {
+		pthread_t th;
+
+		(void)pthread_create(&th, sevp->sigev_notify_attributes, mq_notify_thread,
+				     msg_queue);
+	}
+}
+
+/* Dequeue the oldest message of the highest priority */
+static struct mqueue_msg *get_slot(mqueue_desc *mqd, k_timeout_t timeout)
+{
+	mqueue_object *msg_queue = mqd->mqueue;
+	struct mqueue_bucket *bucket;
+	struct mqueue_msg *msg;
+	k_spinlock_key_t key;
+
+	if ((mqd->flags & O_NONBLOCK) != 0U) {
+		timeout = K_NO_WAIT;
+	}
 
-	if (k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
+	if (k_sem_take(&msg_queue->used_sem, timeout) != 0) {
 		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
-		return ret;
+		return NULL;
 	}
 
-	if (k_msgq_num_used_get(&mqd->mqueue->queue) - msgq_num > 0) {
-		struct sigevent *sevp = &mqd->mqueue->not;
+	key = k_spin_lock(&msg_queue->lock);
+	bucket = &msg_queue->bucket[find_msb_set(msg_queue->prio_bitmap) - 1];
+	msg = mq_slot(msg_queue, bucket->head);
+	bucket->head = msg->next;
+	if (bucket->head == MQ_SLOT_END) {
+		bucket->tail = MQ_SLOT_END;
+		msg_queue->prio_bitmap &= ~BIT(msg->prio);
+	}
+	msg_queue->used_msgs--;
+	k_spin_unlock(&msg_queue->lock, key);
 
-		if (sevp->sigev_notify == SIGEV_NONE) {
-			sevp->sigev_notify_function(sevp->sigev_value);
-		} else if (sevp->sigev_notify == SIGEV_THREAD) {
-			pthread_t th;
+	return msg;
+}
 
-			ret = pthread_create(&th,
-					     sevp->sigev_notify_attributes,
-					     mq_notify_thread,
-					     mqd->mqueue);
-		}
+/* Give a received slot back to the senders */
+static void release_slot(mqueue_object *msg_queue, struct mqueue_msg *msg)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msg_queue->lock);
+	msg->next = msg_queue->free_head;
+	msg_queue->free_head = mq_slot_idx(msg_queue, msg);
+	k_spin_unlock(&msg_queue->lock, key);
+
+	k_sem_give(&msg_queue->free_sem);
+}
+
+static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
+			    unsigned int msg_prio, k_timeout_t timeout)
+{
+	struct mqueue_msg *msg;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
 	}
 
+	if (msg_len > mqd->mqueue->msg_size) {
+		errno = EMSGSIZE;
+		return -1;
+	}
+
+	if (msg_prio >= MQ_PRIO_MAX) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	msg = claim_slot(mqd, timeout);
+	if (msg == NULL) {
+		return -1;
+	}
+
+	memcpy(msg->data, msg_ptr, msg_len);
+	commit_slot(mqd, msg, msg_len, msg_prio);
+
 	return 0;
 }
 
 static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			     k_timeout_t timeout)
+			       unsigned int *msg_prio, k_timeout_t timeout)
 {
-	int ret = -1;
+	struct mqueue_msg *msg;
+	int32_t ret;
 
 	if (mqd == NULL) {
 		errno = EBADF;
-		return ret;
+		return -1;
 	}
 
-	if (msg_len < mqd->mqueue->queue.msg_size) {
+	if (msg_len < mqd->mqueue->msg_size) {
 		errno = EMSGSIZE;
-		return ret;
+		return -1;
 	}
 
-	if ((mqd->flags & O_NONBLOCK) != 0U) {
-		timeout = K_NO_WAIT;
+	msg = get_slot(mqd, timeout);
+	if (msg == NULL) {
+		return -1;
 	}
 
-	if (k_msgq_get(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
-	} else {
-		ret = mqd->mqueue->queue.msg_size;
+	memcpy(msg_ptr, msg->data, msg->len);
+	ret = msg->len;
+	if (msg_prio != NULL) {
+		*msg_prio = msg->prio;
 	}
+	release_slot(mqd->mqueue, msg);
 
 	return ret;
 }
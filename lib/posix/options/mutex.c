@@ -28,7 +28,22 @@ static const struct pthread_mutexattr def_attr = {
 	.type = PTHREAD_MUTEX_DEFAULT,
 };
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+/*
+ * Values of the futex of a mutex. The kernel is only entered to wait for, or
+ * to wake up a waiter of, a contended mutex.
+ */
+#define MUTEX_INVALID   -1
+#define MUTEX_UNLOCKED  0
+#define MUTEX_LOCKED    1
+#define MUTEX_CONTENDED 2
+
+static struct k_futex posix_mutex_pool[CONFIG_MAX_PTHREAD_MUTEX_COUNT];
+static k_tid_t posix_mutex_owner[CONFIG_MAX_PTHREAD_MUTEX_COUNT];
+static uint16_t posix_mutex_lock_count[CONFIG_MAX_PTHREAD_MUTEX_COUNT];
+#else
 static struct k_mutex posix_mutex_pool[CONFIG_MAX_PTHREAD_MUTEX_COUNT];
+#endif
 static uint8_t posix_mutex_type[CONFIG_MAX_PTHREAD_MUTEX_COUNT];
 SYS_BITARRAY_DEFINE_STATIC(posix_mutex_bitarray, CONFIG_MAX_PTHREAD_MUTEX_COUNT);
 
@@ -40,17 +55,12 @@ SYS_BITARRAY_DEFINE_STATIC(posix_mutex_bitarray, CONFIG_MAX_PTHREAD_MUTEX_COUNT)
 BUILD_ASSERT(CONFIG_MAX_PTHREAD_MUTEX_COUNT < PTHREAD_OBJ_MASK_INIT,
 	"CONFIG_MAX_PTHREAD_MUTEX_COUNT is too high");
 
-static inline size_t posix_mutex_to_offset(struct k_mutex *m)
-{
-	return m - posix_mutex_pool;
-}
-
 static inline size_t to_posix_mutex_idx(pthread_mutex_t mut)
 {
 	return mark_pthread_obj_uninitialized(mut);
 }
 
-static struct k_mutex *get_posix_mutex(pthread_mutex_t mu)
+static bool posix_mutex_allocated(pthread_mutex_t mu)
 {
 	int actually_initialized;
 	size_t bit = to_posix_mutex_idx(mu);
@@ -58,22 +68,216 @@ static struct k_mutex *get_posix_mutex(pthread_mutex_t mu)
 	/* if the provided mutex does not claim to be initialized, its invalid */
 	if (!is_pthread_obj_initialized(mu)) {
 		LOG_DBG("Mutex is uninitialized (%x)", mu);
-		return NULL;
+		return false;
 	}
 
 	/* Mask off the MSB to get the actual bit index */
 	if (sys_bitarray_test_bit(&posix_mutex_bitarray, bit, &actually_initialized) < 0) {
 		LOG_DBG("Mutex is invalid (%x)", mu);
-		return NULL;
+		return false;
 	}
 
 	if (actually_initialized == 0) {
 		/* The mutex claims to be initialized but is actually not */
 		LOG_DBG("Mutex claims to be initialized (%x)", mu);
+		return false;
+	}
+
+	return true;
+}
+
+static int alloc_posix_mutex(pthread_mutex_t *mu, size_t *bit)
+{
+	/* Try and automatically associate a posix_mutex */
+	if (sys_bitarray_alloc(&posix_mutex_bitarray, 1, bit) < 0) {
+		LOG_DBG("Unable to allocate pthread_mutex_t");
+		return -ENOMEM;
+	}
+
+	/* Record the associated posix_mutex in mu and mark as initialized */
+	*mu = mark_pthread_obj_initialized(*bit);
+
+	return 0;
+}
+
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+
+/*
+ * Get the pool index of a mutex, possibly initializing it. Only the range of
+ * the index is checked here: the futex of a mutex that is not allocated holds
+ * MUTEX_INVALID, so locking it falls back to the full check.
+ */
+static int to_posix_mutex_bit(pthread_mutex_t *mu, size_t *bit)
+{
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if (*mu != PTHREAD_MUTEX_INITIALIZER) {
+		*bit = to_posix_mutex_idx(*mu);
+		if (!is_pthread_obj_initialized(*mu) || *bit >= CONFIG_MAX_PTHREAD_MUTEX_COUNT) {
+			LOG_DBG("Mutex is invalid (%x)", *mu);
+			return -EINVAL;
+		}
+
+		return 0;
+	}
+
+	key = k_spin_lock(&pthread_mutex_spinlock);
+
+	if (*mu != PTHREAD_MUTEX_INITIALIZER) {
+		/* Initialized by another thread in the meantime */
+		*bit = to_posix_mutex_idx(*mu);
+	} else {
+		ret = alloc_posix_mutex(mu, bit);
+		if (ret == 0) {
+			posix_mutex_type[*bit] = def_attr.type;
+			posix_mutex_owner[*bit] = NULL;
+			posix_mutex_lock_count[*bit] = 0;
+			atomic_set(&posix_mutex_pool[*bit].val, MUTEX_UNLOCKED);
+		}
+	}
+
+	k_spin_unlock(&pthread_mutex_spinlock, key);
+
+	return ret;
+}
+
+static int acquire_mutex(pthread_mutex_t *mu, k_timeout_t timeout)
+{
+	size_t bit;
+	int ret = 0;
+	k_timepoint_t end;
+	struct k_futex *f;
+	k_tid_t self = k_current_get();
+
+	if (to_posix_mutex_bit(mu, &bit) < 0) {
+		return EINVAL;
+	}
+
+	f = &posix_mutex_pool[bit];
+
+	/* Fast path: take an unlocked mutex with a single atomic operation */
+	if (atomic_cas(&f->val, MUTEX_UNLOCKED, MUTEX_LOCKED)) {
+		posix_mutex_owner[bit] = self;
+		posix_mutex_lock_count[bit] = 1;
+		return 0;
+	}
+
+	if (!posix_mutex_allocated(*mu)) {
+		return EINVAL;
+	}
+
+	LOG_DBG("Locking mutex %zu with timeout %llx", bit, timeout.ticks);
+
+	if (posix_mutex_owner[bit] == self) {
+		switch (posix_mutex_type[bit]) {
+		case PTHREAD_MUTEX_NORMAL:
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				LOG_DBG("Timeout locking mutex %zu", bit);
+				return EBUSY;
+			}
+			/* On most POSIX systems, this usually results in an infinite loop */
+			LOG_DBG("Attempt to relock non-recursive mutex %zu", bit);
+			do {
+				(void)k_sleep(K_FOREVER);
+			} while (true);
+			CODE_UNREACHABLE;
+			break;
+		case PTHREAD_MUTEX_RECURSIVE:
+			if (posix_mutex_lock_count[bit] >= MUTEX_MAX_REC_LOCK) {
+				LOG_DBG("Mutex %zu locked recursively too many times", bit);
+				return EAGAIN;
+			}
+			posix_mutex_lock_count[bit]++;
+			return 0;
+		case PTHREAD_MUTEX_ERRORCHECK:
+			LOG_DBG("Attempt to recursively lock non-recursive mutex %zu", bit);
+			return EDEADLK;
+		default:
+			__ASSERT(false, "invalid pthread type %d", posix_mutex_type[bit]);
+			return EINVAL;
+		}
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return EBUSY;
+	}
+
+	/* Slow path: mark the mutex contended and wait for it in the kernel */
+	end = sys_timepoint_calc(timeout);
+	while (atomic_set(&f->val, MUTEX_CONTENDED) != MUTEX_UNLOCKED) {
+		ret = k_futex_wait(f, MUTEX_CONTENDED, sys_timepoint_timeout(end));
+		if (ret == -ETIMEDOUT) {
+			LOG_DBG("Timeout locking mutex %zu", bit);
+			ret = ETIMEDOUT;
+			break;
+		}
+
+		/* -EAGAIN: the mutex was unlocked before we could wait */
+		ret = 0;
+	}
+
+	if (ret != 0) {
+		/*
+		 * The mutex was marked contended, possibly without waiters
+		 * left, which only costs a spurious wake up at unlock.
+		 */
+		return ret;
+	}
+
+	posix_mutex_owner[bit] = self;
+	posix_mutex_lock_count[bit] = 1;
+
+	LOG_DBG("Locked mutex %zu", bit);
+
+	return 0;
+}
+
+static int release_mutex(pthread_mutex_t *mu)
+{
+	size_t bit;
+	struct k_futex *f;
+
+	if (to_posix_mutex_bit(mu, &bit) < 0) {
+		return EINVAL;
+	}
+
+	if (posix_mutex_owner[bit] != k_current_get()) {
+		return posix_mutex_allocated(*mu) ? EPERM : EINVAL;
+	}
+
+	if (--posix_mutex_lock_count[bit] > 0) {
+		return 0;
+	}
+
+	posix_mutex_owner[bit] = NULL;
+
+	/* Fast path: nobody waits for the mutex */
+	f = &posix_mutex_pool[bit];
+	if (atomic_dec(&f->val) != MUTEX_LOCKED) {
+		atomic_set(&f->val, MUTEX_UNLOCKED);
+		(void)k_futex_wake(f, false);
+	}
+
+	LOG_DBG("Unlocked mutex %zu", bit);
+
+	return 0;
+}
+
+#else /* CONFIG_PTHREAD_MUTEX_FUTEX */
+
+static inline size_t posix_mutex_to_offset(struct k_mutex *m)
+{
+	return m - posix_mutex_pool;
+}
+
+static struct k_mutex *get_posix_mutex(pthread_mutex_t mu)
+{
+	if (!posix_mutex_allocated(mu)) {
 		return NULL;
 	}
 
-	return &posix_mutex_pool[bit];
+	return &posix_mutex_pool[to_posix_mutex_idx(mu)];
 }
 
 struct k_mutex *to_posix_mutex(pthread_mutex_t *mu)
@@ -86,15 +290,10 @@ struct k_mutex *to_posix_mutex(pthread_mutex_t *mu)
 		return get_posix_mutex(*mu);
 	}
 
-	/* Try and automatically associate a posix_mutex */
-	if (sys_bitarray_alloc(&posix_mutex_bitarray, 1, &bit) < 0) {
-		LOG_DBG("Unable to allocate pthread_mutex_t");
+	if (alloc_posix_mutex(mu, &bit) < 0) {
 		return NULL;
 	}
 
-	/* Record the associated posix_mutex in mu and mark as initialized */
-	*mu = mark_pthread_obj_initialized(bit);
-
 	/* Initialize the posix_mutex */
 	m = &posix_mutex_pool[bit];
 
@@ -183,6 +382,30 @@ static int acquire_mutex(pthread_mutex_t *mu, k_timeout_t timeout)
 	return ret;
 }
 
+static int release_mutex(pthread_mutex_t *mu)
+{
+	int ret;
+	struct k_mutex *m;
+
+	m = get_posix_mutex(*mu);
+	if (m == NULL) {
+		return EINVAL;
+	}
+
+	ret = k_mutex_unlock(m);
+	if (ret < 0) {
+		LOG_DBG("k_mutex_unlock() failed: %d", ret);
+		return -ret;
+	}
+
+	__ASSERT_NO_MSG(ret == 0);
+	LOG_DBG("Unlocked mutex %p", m);
+
+	return 0;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FUTEX */
+
 /**
  * @brief Lock POSIX mutex with non-blocking call.
  *
@@ -214,24 +437,31 @@ int pthread_mutex_timedlock(pthread_mutex_t *m,
 int pthread_mutex_init(pthread_mutex_t *mu, const pthread_mutexattr_t *_attr)
 {
 	size_t bit;
-	struct k_mutex *m;
 	const struct pthread_mutexattr *attr = (const struct pthread_mutexattr *)_attr;
 
 	*mu = PTHREAD_MUTEX_INITIALIZER;
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+	if (to_posix_mutex_bit(mu, &bit) < 0) {
+		return ENOMEM;
+	}
+#else
+	struct k_mutex *m;
+
 	m = to_posix_mutex(mu);
 	if (m == NULL) {
 		return ENOMEM;
 	}
 
 	bit = posix_mutex_to_offset(m);
+#endif
 	if (attr == NULL) {
 		posix_mutex_type[bit] = def_attr.type;
 	} else {
 		posix_mutex_type[bit] = attr->type;
 	}
 
-	LOG_DBG("Initialized mutex %p", m);
+	LOG_DBG("Initialized mutex %zu", bit);
 
 	return 0;
 }
@@ -254,24 +484,7 @@ int pthread_mutex_lock(pthread_mutex_t *m)
  */
 int pthread_mutex_unlock(pthread_mutex_t *mu)
 {
-	int ret;
-	struct k_mutex *m;
-
-	m = get_posix_mutex(*mu);
-	if (m == NULL) {
-		return EINVAL;
-	}
-
-	ret = k_mutex_unlock(m);
-	if (ret < 0) {
-		LOG_DBG("k_mutex_unlock() failed: %d", ret);
-		return -ret;
-	}
-
-	__ASSERT_NO_MSG(ret == 0);
-	LOG_DBG("Unlocked mutex %p", m);
-
-	return 0;
+	return release_mutex(mu);
 }
 
 /**
@@ -283,18 +496,24 @@ int pthread_mutex_destroy(pthread_mutex_t *mu)
 {
 	int err;
 	size_t bit;
-	struct k_mutex *m;
 
-	m = get_posix_mutex(*mu);
-	if (m == NULL) {
+	if (!posix_mutex_allocated(*mu)) {
 		return EINVAL;
 	}
 
 	bit = to_posix_mutex_idx(*mu);
+
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+	if (!atomic_cas(&posix_mutex_pool[bit].val, MUTEX_UNLOCKED, MUTEX_INVALID)) {
+		LOG_DBG("Mutex %zu is locked", bit);
+		return EBUSY;
+	}
+#endif
+
 	err = sys_bitarray_free(&posix_mutex_bitarray, 1, bit);
 	__ASSERT_NO_MSG(err == 0);
 
-	LOG_DBG("Destroyed mutex %p", m);
+	LOG_DBG("Destroyed mutex %zu", bit);
 
 	return 0;
 }
@@ -382,12 +601,16 @@ int pthread_mutexattr_settype(pthread_mutexattr_t *attr, int type)
 
 static int pthread_mutex_pool_init(void)
 {
-	int err;
 	size_t i;
 
 	for (i = 0; i < CONFIG_MAX_PTHREAD_MUTEX_COUNT; ++i) {
-		err = k_mutex_init(&posix_mutex_pool[i]);
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+		atomic_set(&posix_mutex_pool[i].val, MUTEX_INVALID);
+#else
+		int err = k_mutex_init(&posix_mutex_pool[i]);
+
 		__ASSERT_NO_MSG(err == 0);
+#endif
 	}
 
 	return 0;
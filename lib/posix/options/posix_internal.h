@@ -101,8 +101,10 @@ static inline uint32_t mark_pthread_obj_uninitialized(uint32_t obj)
 
 struct posix_thread *to_posix_thread(pthread_t pth);
 
+#ifndef CONFIG_PTHREAD_MUTEX_FUTEX
 /* get and possibly initialize a posix_mutex */
 struct k_mutex *to_posix_mutex(pthread_mutex_t *mu);
+#endif
 
 int posix_to_zephyr_priority(int priority, int policy);
 int zephyr_to_posix_priority(int priority, int *policy);
@@ -67,6 +67,149 @@ static const struct smf_state *get_last_of(const struct smf_state *states)
 	return get_child_of(states, NULL);
 }
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+static int table_index(const struct smf_table *table, const struct smf_state *state)
+{
+	if (table == NULL || (uintptr_t)state < (uintptr_t)table->states ||
+	    (uintptr_t)state >= (uintptr_t)(table->states + table->num_states)) {
+		return -1;
+	}
+
+	return state - table->states;
+}
+
+static uint8_t table_common(const struct smf_table *table, int a, int b)
+{
+	return table->common[a * table->num_states + b];
+}
+
+static int table_depth(const struct smf_table *table, const struct smf_state *state)
+{
+	int depth = 0;
+
+	for (state = state->parent; state != NULL; state = state->parent) {
+		if (table_index(table, state) < 0 || ++depth > CONFIG_SMF_TABLE_MAX_DEPTH) {
+			return -1;
+		}
+	}
+
+	return depth;
+}
+
+int smf_table_init(struct smf_table *table)
+{
+	const struct smf_state *states = table->states;
+	const uint16_t num = table->num_states;
+
+	for (int i = 0; i < num; i++) {
+		int depth = table_depth(table, &states[i]);
+
+		if (depth < 0) {
+			return -EINVAL;
+		}
+
+		table->depth[i] = depth;
+	}
+
+	/* Number of ancestors shared by each pair, climb to the same depth then together */
+	for (int i = 0; i < num; i++) {
+		for (int j = 0; j < num; j++) {
+			const struct smf_state *a = states[i].parent;
+			const struct smf_state *b = states[j].parent;
+			int da = table->depth[i];
+			int db = table->depth[j];
+
+			for (; da > db; da--) {
+				a = a->parent;
+			}
+
+			for (; db > da; db--) {
+				b = b->parent;
+			}
+
+			for (; a != b; da--) {
+				a = a->parent;
+				b = b->parent;
+			}
+
+			table->common[i * num + j] = da;
+		}
+	}
+
+#ifdef CONFIG_SMF_INITIAL_TRANSITION
+	for (int i = 0; i < num; i++) {
+		const struct smf_state *leaf = &states[i];
+
+		for (int n = 0; leaf->initial; n++) {
+			leaf = leaf->initial;
+			if (table_index(table, leaf) < 0 || n == num) {
+				return -EINVAL;
+			}
+		}
+
+		table->leaf[i] = leaf - states;
+	}
+#endif
+
+	return 0;
+}
+
+/* Exit the ancestors of the current state not shared with the target */
+static bool smf_table_exit_actions(struct smf_ctx *const ctx, int current, int target)
+{
+	struct internal_ctx * const internal = (void *) &ctx->internal;
+	const struct smf_table *table = ctx->table;
+	int n = table->depth[current] - table_common(table, current, target);
+
+	for (const struct smf_state *tmp_state = ctx->current->parent;
+	     n > 0;
+	     tmp_state = tmp_state->parent, n--) {
+		if (tmp_state->exit) {
+			tmp_state->exit(ctx);
+
+			/* No need to continue if terminate was set */
+			if (internal->terminate) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/* Enter the ancestors of the target not shared with the previous state */
+static bool smf_table_entry_actions(struct smf_ctx *const ctx, int target, int previous)
+{
+	struct internal_ctx * const internal = (void *) &ctx->internal;
+	const struct smf_table *table = ctx->table;
+	const struct smf_state *path[CONFIG_SMF_TABLE_MAX_DEPTH];
+	const struct smf_state *tmp_state = table->states[target].parent;
+	int n = table->depth[target];
+
+	if (previous >= 0) {
+		n -= table_common(table, target, previous);
+	}
+
+	for (int i = n - 1; i >= 0; i--) {
+		path[i] = tmp_state;
+		tmp_state = tmp_state->parent;
+	}
+
+	for (int i = 0; i < n; i++) {
+		if (path[i]->entry) {
+			path[i]->entry(ctx);
+
+			/* No need to continue if terminate was set */
+			if (internal->terminate) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 /**
  * @brief Execute all ancestor entry actions
  *
@@ -79,6 +222,15 @@ __unused static bool smf_execute_ancestor_entry_actions(
 {
 	struct internal_ctx * const internal = (void *) &ctx->internal;
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	int target_idx = table_index(ctx->table, target);
+	int previous_idx = table_index(ctx->table, ctx->previous);
+
+	if (target_idx >= 0 && (ctx->previous == NULL || previous_idx >= 0)) {
+		return smf_table_entry_actions(ctx, target_idx, previous_idx);
+	}
+#endif
+
 	for (const struct smf_state *to_execute = get_last_of(target);
 	     to_execute != NULL && to_execute != target;
 	     to_execute = get_child_of(target, to_execute)) {
@@ -169,6 +321,15 @@ __unused static bool smf_execute_ancestor_exit_actions(
 
 	/* Execute all parent exit actions in reverse order */
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	int current_idx = table_index(ctx->table, ctx->current);
+	int target_idx = table_index(ctx->table, target);
+
+	if (current_idx >= 0 && target_idx >= 0) {
+		return smf_table_exit_actions(ctx, current_idx, target_idx);
+	}
+#endif
+
 	for (const struct smf_state *tmp_state = ctx->current->parent;
 	     tmp_state != NULL;
 	     tmp_state = tmp_state->parent) {
@@ -184,6 +345,26 @@ __unused static bool smf_execute_ancestor_exit_actions(
 	return false;
 }
 
+#ifdef CONFIG_SMF_INITIAL_TRANSITION
+static const struct smf_state *get_initial_leaf(struct smf_ctx *const ctx,
+						const struct smf_state *state)
+{
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	int idx = table_index(ctx->table, state);
+
+	if (idx >= 0) {
+		return &ctx->table->states[ctx->table->leaf[idx]];
+	}
+#endif
+
+	while (state->initial) {
+		state = state->initial;
+	}
+
+	return state;
+}
+#endif
+
 void smf_set_initial(struct smf_ctx *ctx, const struct smf_state *init_state)
 {
 	struct internal_ctx * const internal = (void *) &ctx->internal;
@@ -194,9 +375,7 @@ void smf_set_initial(struct smf_ctx *ctx, const struct smf_state *init_state)
 	 * The final target will be the deepest leaf state that
 	 * the target contains. Set that as the real target.
 	 */
-	while (init_state->initial) {
-		init_state = init_state->initial;
-	}
+	init_state = get_initial_leaf(ctx, init_state);
 #endif
 	internal->exit = false;
 	internal->terminate = false;
@@ -262,9 +441,7 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 	 * The final target will be the deepest leaf state that
 	 * the target contains. Set that as the real target.
 	 */
-	while (target->initial) {
-		target = target->initial;
-	}
+	target = get_initial_leaf(ctx, target);
 #endif
 
 	/* update the state variables */
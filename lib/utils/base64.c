@@ -26,6 +26,10 @@
 #include <errno.h>
 #include <zephyr/sys/base64.h>
 
+#ifdef CONFIG_UTIL_CODEC_SSSE3
+#include "codec_ssse3.h"
+#endif
+
 static const uint8_t base64_enc_map[64] = {
 	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J',
 	'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T',
@@ -84,8 +88,17 @@ int base64_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 	}
 
 	n = (slen / 3) * 3;
+	i = 0;
+	p = dst;
+
+#ifdef CONFIG_UTIL_CODEC_SSSE3
+	/* Blocks of 12 bytes, as long as the 16 byte loads stay in src */
+	for (; i + 16 <= slen; i += 12, src += 12, p += 16) {
+		z_base64_enc12_ssse3(src, p);
+	}
+#endif
 
-	for (i = 0, p = dst; i < n; i += 3) {
+	for (; i < n; i += 3) {
 		C1 = *src++;
 		C2 = *src++;
 		C3 = *src++;
@@ -130,6 +143,16 @@ int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 
 	/* First pass: check for validity and get output length */
 	for (i = n = j = 0U; i < slen; i++) {
+#ifdef CONFIG_UTIL_CODEC_SSSE3
+		/* 16 characters of the alphabet at once, before any padding */
+		if (j == 0U && (slen - i) >= 16 && z_base64_check16_ssse3(&src[i])) {
+			/* The loop steps over the last one */
+			i += 15;
+			n += 16;
+			continue;
+		}
+#endif
+
 		/* Skip spaces before checking for EOL */
 		x = 0U;
 		while (i < slen && src[i] == ' ') {
@@ -188,6 +211,17 @@ int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 	}
 
 	for (j = 3U, n = x = 0U, p = dst; i > 0; i--, src++) {
+#ifdef CONFIG_UTIL_CODEC_SSSE3
+		/* 16 characters into 12 bytes between quads, the store writes 16 */
+		if (n == 0U && i >= 16 && (dst + dlen - p) >= 16 &&
+		    z_base64_dec16_ssse3(src, p)) {
+			/* The loop steps over the last one */
+			i -= 15;
+			src += 15;
+			p += 12;
+			continue;
+		}
+#endif
 
 		if (*src == '\r' || *src == '\n' || *src == ' ') {
 			continue;
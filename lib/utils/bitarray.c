@@ -45,6 +45,126 @@ static void setup_bundle_data(sys_bitarray_t *bitarray,
 	}
 }
 
+/*
+ * Refresh the summary bits of bundles sidx to eidx after they changed.
+ */
+static void update_summary(sys_bitarray_t *bitarray, size_t sidx, size_t eidx)
+{
+	size_t idx;
+
+	for (idx = sidx; idx <= eidx; idx++) {
+		uint32_t *word = &bitarray->summary[idx / bundle_bitness(bitarray)];
+		uint32_t mask = BIT(idx % bundle_bitness(bitarray));
+
+		if (~bitarray->bundles[idx] == 0U) {
+			*word |= mask;
+		} else {
+			*word &= ~mask;
+		}
+	}
+}
+
+/*
+ * Account for bits cleared from @p bit on, which may now be the lowest
+ * free ones.
+ */
+static inline void update_first_free(sys_bitarray_t *bitarray, size_t bit)
+{
+	bitarray->first_free = MIN(bitarray->first_free, bit);
+}
+
+/*
+ * Find the first bundle, from bundle idx on, which is not full.
+ *
+ * @return Index of the bundle, num_bundles or more if there is none
+ */
+static size_t next_free_bundle(sys_bitarray_t *bitarray, size_t idx)
+{
+	uint32_t free;
+
+	while (idx < bitarray->num_bundles) {
+		free = ~bitarray->summary[idx / bundle_bitness(bitarray)];
+		free >>= idx % bundle_bitness(bitarray);
+
+		if (free != 0U) {
+			return idx + find_lsb_set(free) - 1;
+		}
+
+		idx = ROUND_DOWN(idx, bundle_bitness(bitarray)) +
+		      bundle_bitness(bitarray);
+	}
+
+	return idx;
+}
+
+/*
+ * Find the lowest region of cleared bits big enough for an allocation.
+ *
+ * This walks the bundles a run of set or cleared bits at a time,
+ * starting from the first_free hint and jumping over full bundles with
+ * the help of the summary.
+ *
+ * @param[in]  bitarray   Bitarray struct
+ * @param[in]  num_bits   Number of bits in the region
+ * @param[out] offset     Offset to the start of the region
+ * @param[out] first_free Lowest cleared bit seen, or num_bits of the
+ *                        bitarray if there is none
+ *
+ * @retval     true       If a region is found
+ * @retval     false      There is no region big enough
+ */
+static bool find_region(sys_bitarray_t *bitarray, size_t num_bits,
+			size_t *offset, size_t *first_free)
+{
+	size_t bitness = bundle_bitness(bitarray);
+	size_t bit = bitarray->first_free;
+	size_t start = bit;
+	size_t len = 0;
+	uint32_t bundle;
+	size_t off, n;
+
+	*first_free = bitarray->num_bits;
+
+	while (bit < bitarray->num_bits) {
+		off = bit % bitness;
+		bundle = bitarray->bundles[bit / bitness] >> off;
+
+		if ((bundle & 1U) != 0U) {
+			/* Skip the set bits, then any full bundles after them */
+			n = (~bundle == 0U) ? bitness : (find_lsb_set(~bundle) - 1);
+			bit += n;
+			len = 0;
+
+			if ((bit % bitness) == 0U) {
+				bit = MAX(bit, next_free_bundle(bitarray, bit / bitness) *
+					       bitness);
+			}
+			continue;
+		}
+
+		if (len == 0) {
+			start = bit;
+			*first_free = MIN(*first_free, start);
+
+			if ((start + num_bits) > bitarray->num_bits) {
+				break;
+			}
+		}
+
+		/* Count the cleared bits up to the next set one */
+		n = (bundle == 0U) ? (bitness - off) : (find_lsb_set(bundle) - 1);
+		bit += n;
+		len += n;
+
+		if (len >= num_bits) {
+			*offset = start;
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /*
  * Find out if the bits in a region is all set or all clear.
  *
@@ -208,6 +328,11 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 			}
 		}
 	}
+
+	update_summary(bitarray, bd->sidx, bd->eidx);
+	if (!to_set) {
+		update_first_free(bitarray, offset);
+	}
 }
 
 int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
@@ -230,6 +355,7 @@ int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -258,6 +384,8 @@ int sys_bitarray_clear_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx, idx);
+	update_first_free(bitarray, bit);
 
 	ret = 0;
 
@@ -334,6 +462,7 @@ int sys_bitarray_test_and_set_bit(sys_bitarray_t *bitarray, size_t bit, int *pre
 	}
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -373,6 +502,8 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 	}
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx, idx);
+	update_first_free(bitarray, bit);
 
 	ret = 0;
 
@@ -385,11 +516,9 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
+	size_t bit_idx;
+	size_t first_free;
 	int ret;
-	struct bundle_data bd;
-	size_t off_start, off_end;
-	size_t mismatch;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
 	__ASSERT_NO_MSG(bitarray->num_bits > 0);
@@ -406,47 +535,21 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	bit_idx = 0;
+	if (find_region(bitarray, num_bits, &bit_idx, &first_free)) {
+		set_region(bitarray, bit_idx, num_bits, true, NULL);
 
-	/* Find the first non-allocated bit by looking at bundles
-	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
-	 */
-	for (size_t idx = 0; idx < bitarray->num_bundles; idx++) {
-		if (~bitarray->bundles[idx] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
+		/* The region may have used up the lowest free bits */
+		if (bit_idx == first_free) {
+			first_free += num_bits;
 		}
 
-		if (bitarray->bundles[idx] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[idx]) - 1;
-			bit_idx += off_start;
-		}
-
-		break;
+		*offset = bit_idx;
+		ret = 0;
+	} else {
+		ret = -ENOSPC;
 	}
 
-	off_end = bitarray->num_bits - num_bits;
-	ret = -ENOSPC;
-	while (bit_idx <= off_end) {
-		if (match_region(bitarray, bit_idx, num_bits, false,
-				 &bd, &mismatch)) {
-			set_region(bitarray, bit_idx, num_bits, true, &bd);
-
-			*offset = bit_idx;
-			ret = 0;
-			break;
-		}
-
-		/* Fast-forward to the bit just after
-		 * the mismatched bit.
-		 */
-		bit_idx = mismatch + 1;
-	}
+	bitarray->first_free = first_free;
 
 out:
 	k_spin_unlock(&bitarray->lock, key);
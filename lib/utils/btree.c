@@ -0,0 +1,543 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/btree.h>
+
+#define MAX_KEYS Z_BTREE_MAX_KEYS
+#define MIN_KEYS Z_BTREE_MIN_KEYS
+
+/*
+ * Separators in the internal nodes route the keys: the keys under
+ * children[i] are greater than or equal to keys[i - 1] and less than
+ * keys[i]. The keys and values themselves are only in the leaves, so a
+ * separator may outlive the key it was copied from.
+ *
+ * Insertion and removal are done in a single pass from the root: a full
+ * node is split before descending into it, and a node with the minimum
+ * number of keys is refilled from a sibling or merged with it, so that
+ * nothing has to be propagated back up.
+ */
+
+static struct sys_btree_node *node_alloc(struct sys_btree *tree, bool leaf)
+{
+	struct sys_btree_node *node;
+
+	if (tree->free_list != NULL) {
+		node = tree->free_list;
+		tree->free_list = node->children[0];
+	} else if (tree->pool_used < tree->pool_size) {
+		node = &tree->pool[tree->pool_used++];
+	} else {
+		return NULL;
+	}
+
+	node->nkeys = 0;
+	node->leaf = leaf;
+	if (leaf) {
+		node->next = NULL;
+	}
+
+	return node;
+}
+
+static void node_free(struct sys_btree *tree, struct sys_btree_node *node)
+{
+	node->children[0] = tree->free_list;
+	tree->free_list = node;
+}
+
+/* Index of the first key greater than key, which is the child to follow */
+static size_t upper_bound(const struct sys_btree_node *node, uintptr_t key)
+{
+	size_t i = 0;
+
+	while (i < node->nkeys && node->keys[i] <= key) {
+		i++;
+	}
+
+	return i;
+}
+
+/* Index of the first key greater than or equal to key */
+static size_t lower_bound(const struct sys_btree_node *node, uintptr_t key)
+{
+	size_t i = 0;
+
+	while (i < node->nkeys && node->keys[i] < key) {
+		i++;
+	}
+
+	return i;
+}
+
+static const struct sys_btree_node *find_leaf(const struct sys_btree *tree, uintptr_t key)
+{
+	const struct sys_btree_node *node = tree->root;
+
+	while (node != NULL && !node->leaf) {
+		node = node->children[upper_bound(node, key)];
+	}
+
+	return node;
+}
+
+/* Insert a separator and the child to its right in an internal node */
+static void insert_child(struct sys_btree_node *parent, size_t i, uintptr_t sep,
+			 struct sys_btree_node *child)
+{
+	memmove(&parent->keys[i + 1], &parent->keys[i],
+		(parent->nkeys - i) * sizeof(parent->keys[0]));
+	memmove(&parent->children[i + 2], &parent->children[i + 1],
+		(parent->nkeys - i) * sizeof(parent->children[0]));
+	parent->keys[i] = sep;
+	parent->children[i + 1] = child;
+	parent->nkeys++;
+}
+
+/* Remove a separator and the child to its right from an internal node */
+static void remove_child(struct sys_btree_node *parent, size_t i)
+{
+	memmove(&parent->keys[i], &parent->keys[i + 1],
+		(parent->nkeys - i - 1) * sizeof(parent->keys[0]));
+	memmove(&parent->children[i + 1], &parent->children[i + 2],
+		(parent->nkeys - i - 1) * sizeof(parent->children[0]));
+	parent->nkeys--;
+}
+
+/* Split the full child i of a non-full parent in two */
+static int split_child(struct sys_btree *tree, struct sys_btree_node *parent, size_t i)
+{
+	struct sys_btree_node *left = parent->children[i];
+	struct sys_btree_node *right;
+	size_t mid = MAX_KEYS / 2;
+	uintptr_t sep;
+
+	right = node_alloc(tree, left->leaf);
+	if (right == NULL) {
+		return -ENOMEM;
+	}
+
+	if (left->leaf) {
+		right->nkeys = MAX_KEYS - mid;
+		memcpy(right->keys, &left->keys[mid], right->nkeys * sizeof(left->keys[0]));
+		memcpy(right->values, &left->values[mid], right->nkeys * sizeof(left->values[0]));
+		right->next = left->next;
+		left->next = right;
+		sep = right->keys[0];
+	} else {
+		/* The middle key moves up */
+		right->nkeys = MAX_KEYS - mid - 1;
+		memcpy(right->keys, &left->keys[mid + 1], right->nkeys * sizeof(left->keys[0]));
+		memcpy(right->children, &left->children[mid + 1],
+		       (right->nkeys + 1) * sizeof(left->children[0]));
+		sep = left->keys[mid];
+	}
+
+	left->nkeys = mid;
+	insert_child(parent, i, sep, right);
+
+	return 0;
+}
+
+/* Move the last entry of child i - 1 to the front of child i */
+static void borrow_left(struct sys_btree_node *parent, size_t i)
+{
+	struct sys_btree_node *node = parent->children[i];
+	struct sys_btree_node *left = parent->children[i - 1];
+
+	memmove(&node->keys[1], &node->keys[0], node->nkeys * sizeof(node->keys[0]));
+
+	if (node->leaf) {
+		memmove(&node->values[1], &node->values[0], node->nkeys * sizeof(node->values[0]));
+		node->keys[0] = left->keys[left->nkeys - 1];
+		node->values[0] = left->values[left->nkeys - 1];
+		parent->keys[i - 1] = node->keys[0];
+	} else {
+		memmove(&node->children[1], &node->children[0],
+			(node->nkeys + 1) * sizeof(node->children[0]));
+		node->keys[0] = parent->keys[i - 1];
+		node->children[0] = left->children[left->nkeys];
+		parent->keys[i - 1] = left->keys[left->nkeys - 1];
+	}
+
+	left->nkeys--;
+	node->nkeys++;
+}
+
+/* Move the first entry of child i + 1 to the end of child i */
+static void borrow_right(struct sys_btree_node *parent, size_t i)
+{
+	struct sys_btree_node *node = parent->children[i];
+	struct sys_btree_node *right = parent->children[i + 1];
+
+	if (node->leaf) {
+		node->keys[node->nkeys] = right->keys[0];
+		node->values[node->nkeys] = right->values[0];
+		memmove(&right->keys[0], &right->keys[1], (right->nkeys - 1) * sizeof(right->keys[0]));
+		memmove(&right->values[0], &right->values[1],
+			(right->nkeys - 1) * sizeof(right->values[0]));
+		parent->keys[i] = right->keys[0];
+	} else {
+		node->keys[node->nkeys] = parent->keys[i];
+		node->children[node->nkeys + 1] = right->children[0];
+		parent->keys[i] = right->keys[0];
+		memmove(&right->keys[0], &right->keys[1], (right->nkeys - 1) * sizeof(right->keys[0]));
+		memmove(&right->children[0], &right->children[1],
+			right->nkeys * sizeof(right->children[0]));
+	}
+
+	right->nkeys--;
+	node->nkeys++;
+}
+
+/* Merge child i + 1 into child i */
+static void merge_children(struct sys_btree *tree, struct sys_btree_node *parent, size_t i)
+{
+	struct sys_btree_node *left = parent->children[i];
+	struct sys_btree_node *right = parent->children[i + 1];
+
+	if (left->leaf) {
+		memcpy(&left->keys[left->nkeys], right->keys, right->nkeys * sizeof(right->keys[0]));
+		memcpy(&left->values[left->nkeys], right->values,
+		       right->nkeys * sizeof(right->values[0]));
+		left->next = right->next;
+	} else {
+		left->keys[left->nkeys++] = parent->keys[i];
+		memcpy(&left->keys[left->nkeys], right->keys, right->nkeys * sizeof(right->keys[0]));
+		memcpy(&left->children[left->nkeys], right->children,
+		       (right->nkeys + 1) * sizeof(right->children[0]));
+	}
+
+	left->nkeys += right->nkeys;
+	remove_child(parent, i);
+	node_free(tree, right);
+}
+
+/*
+ * Give child i, which has the minimum number of keys, one more.
+ *
+ * @return Index of the child now covering the keys of child i.
+ */
+static size_t refill_child(struct sys_btree *tree, struct sys_btree_node *parent, size_t i)
+{
+	if (i > 0 && parent->children[i - 1]->nkeys > MIN_KEYS) {
+		borrow_left(parent, i);
+	} else if (i < parent->nkeys && parent->children[i + 1]->nkeys > MIN_KEYS) {
+		borrow_right(parent, i);
+	} else if (i < parent->nkeys) {
+		merge_children(tree, parent, i);
+	} else {
+		merge_children(tree, parent, i - 1);
+		i--;
+	}
+
+	return i;
+}
+
+void sys_btree_init(struct sys_btree *tree, struct sys_btree_node *nodes, size_t num_nodes)
+{
+	tree->root = NULL;
+	tree->pool = nodes;
+	tree->free_list = NULL;
+	tree->pool_size = num_nodes;
+	tree->pool_used = 0;
+	tree->size = 0;
+}
+
+int sys_btree_insert(struct sys_btree *tree, uintptr_t key, uintptr_t value,
+		     uintptr_t *old_value)
+{
+	struct sys_btree_node *node;
+	size_t i;
+
+	if (tree->root == NULL) {
+		tree->root = node_alloc(tree, true);
+		if (tree->root == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	if (tree->root->nkeys == MAX_KEYS) {
+		node = node_alloc(tree, false);
+		if (node == NULL) {
+			return -ENOMEM;
+		}
+
+		node->children[0] = tree->root;
+		if (split_child(tree, node, 0) != 0) {
+			node_free(tree, node);
+			return -ENOMEM;
+		}
+		tree->root = node;
+	}
+
+	node = tree->root;
+	while (!node->leaf) {
+		i = upper_bound(node, key);
+
+		if (node->children[i]->nkeys == MAX_KEYS) {
+			if (split_child(tree, node, i) != 0) {
+				return -ENOMEM;
+			}
+			if (key >= node->keys[i]) {
+				i++;
+			}
+		}
+
+		node = node->children[i];
+	}
+
+	i = lower_bound(node, key);
+	if (i < node->nkeys && node->keys[i] == key) {
+		if (old_value != NULL) {
+			*old_value = node->values[i];
+		}
+		node->values[i] = value;
+		return 1;
+	}
+
+	memmove(&node->keys[i + 1], &node->keys[i], (node->nkeys - i) * sizeof(node->keys[0]));
+	memmove(&node->values[i + 1], &node->values[i],
+		(node->nkeys - i) * sizeof(node->values[0]));
+	node->keys[i] = key;
+	node->values[i] = value;
+	node->nkeys++;
+	tree->size++;
+
+	return 0;
+}
+
+bool sys_btree_get(const struct sys_btree *tree, uintptr_t key, uintptr_t *value)
+{
+	const struct sys_btree_node *node = find_leaf(tree, key);
+	size_t i;
+
+	if (node == NULL) {
+		return false;
+	}
+
+	i = lower_bound(node, key);
+	if (i == node->nkeys || node->keys[i] != key) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = node->values[i];
+	}
+
+	return true;
+}
+
+bool sys_btree_remove(struct sys_btree *tree, uintptr_t key, uintptr_t *value)
+{
+	struct sys_btree_node *node = tree->root;
+	size_t i;
+
+	if (node == NULL) {
+		return false;
+	}
+
+	while (!node->leaf) {
+		i = upper_bound(node, key);
+
+		if (node->children[i]->nkeys <= MIN_KEYS) {
+			i = refill_child(tree, node, i);
+
+			/* Only the root can be left without keys by a merge */
+			if (node->nkeys == 0) {
+				tree->root = node->children[0];
+				node_free(tree, node);
+				node = tree->root;
+				continue;
+			}
+		}
+
+		node = node->children[i];
+	}
+
+	i = lower_bound(node, key);
+	if (i == node->nkeys || node->keys[i] != key) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = node->values[i];
+	}
+
+	memmove(&node->keys[i], &node->keys[i + 1], (node->nkeys - i - 1) * sizeof(node->keys[0]));
+	memmove(&node->values[i], &node->values[i + 1],
+		(node->nkeys - i - 1) * sizeof(node->values[0]));
+	node->nkeys--;
+	tree->size--;
+
+	if (node->nkeys == 0) {
+		__ASSERT_NO_MSG(node == tree->root);
+		node_free(tree, node);
+		tree->root = NULL;
+	}
+
+	return true;
+}
+
+/*
+ * Append a node to the right of level, with sep the smallest key under it,
+ * adding parents as needed.
+ */
+static int load_append(struct sys_btree *tree, struct sys_btree_node **spine, size_t *depth,
+		       size_t level, struct sys_btree_node *node, uintptr_t sep)
+{
+	struct sys_btree_node *parent;
+
+	for (;;) {
+		if (level + 1 == *depth) {
+			if (*depth == Z_BTREE_MAX_DEPTH) {
+				return -ENOMEM;
+			}
+
+			parent = node_alloc(tree, false);
+			if (parent == NULL) {
+				return -ENOMEM;
+			}
+
+			parent->children[0] = spine[level];
+			insert_child(parent, 0, sep, node);
+			spine[level] = node;
+			spine[level + 1] = parent;
+			(*depth)++;
+			return 0;
+		}
+
+		parent = spine[level + 1];
+		spine[level] = node;
+
+		if (parent->nkeys < MAX_KEYS) {
+			insert_child(parent, parent->nkeys, sep, node);
+			return 0;
+		}
+
+		/* The parent is full, start a new one to its right */
+		parent = node_alloc(tree, false);
+		if (parent == NULL) {
+			return -ENOMEM;
+		}
+
+		parent->children[0] = node;
+		node = parent;
+		level++;
+	}
+}
+
+int sys_btree_load(struct sys_btree *tree, const uintptr_t *keys, const uintptr_t *values,
+		   size_t n)
+{
+	struct sys_btree_node *spine[Z_BTREE_MAX_DEPTH];
+	struct sys_btree_node *leaf, *node;
+	size_t depth = 1;
+	int ret = 0;
+
+	if (tree->root != NULL) {
+		return -EINVAL;
+	}
+
+	if (n == 0) {
+		return 0;
+	}
+
+	leaf = node_alloc(tree, true);
+	if (leaf == NULL) {
+		return -ENOMEM;
+	}
+	spine[0] = leaf;
+	tree->root = leaf;
+
+	for (size_t k = 0; k < n; k++) {
+		if (k > 0 && keys[k] <= keys[k - 1]) {
+			ret = -EINVAL;
+			goto out;
+		}
+
+		if (leaf->nkeys == MAX_KEYS) {
+			node = node_alloc(tree, true);
+			if (node == NULL) {
+				ret = -ENOMEM;
+				goto out;
+			}
+
+			leaf->next = node;
+			ret = load_append(tree, spine, &depth, 0, node, keys[k]);
+			if (ret != 0) {
+				goto out;
+			}
+			leaf = node;
+		}
+
+		leaf->keys[leaf->nkeys] = keys[k];
+		leaf->values[leaf->nkeys] = (values != NULL) ? values[k] : 0;
+		leaf->nkeys++;
+	}
+
+	/*
+	 * Only the nodes on the right edge may be short of keys. Going down
+	 * from the root, refill each of them from its left sibling, which is
+	 * full: this leaves at least the minimum in both.
+	 */
+	tree->root = spine[depth - 1];
+	for (size_t level = depth - 1; level > 0; level--) {
+		node = spine[level];
+
+		while (node->children[node->nkeys]->nkeys < MIN_KEYS) {
+			borrow_left(node, node->nkeys);
+		}
+	}
+
+	tree->size = n;
+
+out:
+	if (ret != 0) {
+		sys_btree_clear(tree);
+	}
+
+	return ret;
+}
+
+void sys_btree_clear(struct sys_btree *tree)
+{
+	/* Once the tree is empty, all the nodes of the pool are free */
+	tree->root = NULL;
+	tree->free_list = NULL;
+	tree->pool_used = 0;
+	tree->size = 0;
+}
+
+bool sys_btree_get_max(const struct sys_btree *tree, uintptr_t *key, uintptr_t *value)
+{
+	const struct sys_btree_node *node = tree->root;
+
+	if (node == NULL) {
+		return false;
+	}
+
+	while (!node->leaf) {
+		node = node->children[node->nkeys];
+	}
+
+	*key = node->keys[node->nkeys - 1];
+	if (value != NULL) {
+		*value = node->values[node->nkeys - 1];
+	}
+
+	return true;
+}
+
+void sys_btree_iter_init(const struct sys_btree *tree, struct sys_btree_iter *iter,
+			 uintptr_t from)
+{
+	iter->node = find_leaf(tree, from);
+	iter->idx = (iter->node != NULL) ? lower_bound(iter->node, from) : 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SSSE3 blocks for the base64 and hex codecs.
+ *
+ * The functions are compiled for SSSE3 whatever the target flags are, so
+ * CONFIG_UTIL_CODEC_SSSE3 must only be enabled for CPUs that implement it.
+ * The base64 encoder follows Wojciech Muła's "Base64 encoding with SIMD
+ * instructions"; the decoders classify characters by ranges, so that any
+ * character the scalar code would refuse makes the block fall back to it.
+ */
+
+#ifndef ZEPHYR_LIB_UTILS_CODEC_SSSE3_H_
+#define ZEPHYR_LIB_UTILS_CODEC_SSSE3_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <tmmintrin.h>
+
+#define Z_SSSE3 __attribute__((target("ssse3")))
+
+/* Mask of the bytes of v in [lo, hi] */
+static inline Z_SSSE3 __m128i z_ssse3_in_range(__m128i v, char lo, char hi)
+{
+	__m128i d = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+
+	return _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(hi - lo)), d);
+}
+
+/* Encode 12 bytes into 16 characters, reading 16 bytes from src */
+static inline Z_SSSE3 void z_base64_enc12_ssse3(const uint8_t *src, uint8_t *dst)
+{
+	__m128i in = _mm_loadu_si128((const __m128i *)src);
+	__m128i t0, t1, t2, t3, idx, res, less;
+
+	/* Spread every 3 bytes over a 32 bit lane, then move each 6 bit
+	 * index to its own byte
+	 */
+	in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+					       4, 5, 3, 4, 1, 2, 0, 1));
+	t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+	t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+	t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+	t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+	idx = _mm_or_si128(t1, t3);
+
+	/* Offset of each range of the alphabet, looked up by range */
+	res = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+	less = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+	res = _mm_or_si128(res, _mm_and_si128(less, _mm_set1_epi8(13)));
+	res = _mm_shuffle_epi8(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52,
+					     '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+					     '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+					     '/' - 63, 'A', 0, 0), res);
+
+	_mm_storeu_si128((__m128i *)dst, _mm_add_epi8(res, idx));
+}
+
+/* 6 bit values of 16 characters, false if one is not in the alphabet */
+static inline Z_SSSE3 bool z_base64_values_ssse3(const uint8_t *src, __m128i *values)
+{
+	__m128i in = _mm_loadu_si128((const __m128i *)src);
+	__m128i upper = z_ssse3_in_range(in, 'A', 'Z');
+	__m128i lower = z_ssse3_in_range(in, 'a', 'z');
+	__m128i digit = z_ssse3_in_range(in, '0', '9');
+	__m128i plus = _mm_cmpeq_epi8(in, _mm_set1_epi8('+'));
+	__m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+	__m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+				     _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+	__m128i shift;
+
+	if (_mm_movemask_epi8(valid) != 0xffff) {
+		return false;
+	}
+
+	shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+	shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+	shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+	shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+	shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+
+	*values = _mm_add_epi8(in, shift);
+
+	return true;
+}
+
+/* Whether 16 characters are all in the alphabet */
+static inline Z_SSSE3 bool z_base64_check16_ssse3(const uint8_t *src)
+{
+	__m128i values;
+
+	return z_base64_values_ssse3(src, &values);
+}
+
+/* Decode 16 characters into 12 bytes, writing 16 bytes to dst */
+static inline Z_SSSE3 bool z_base64_dec16_ssse3(const uint8_t *src, uint8_t *dst)
+{
+	__m128i values, out;
+
+	if (!z_base64_values_ssse3(src, &values)) {
+		return false;
+	}
+
+	/* Merge 4 values into 24 bits, then drop the top byte of each lane */
+	out = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+	out = _mm_madd_epi16(out, _mm_set1_epi32(0x00011000));
+	out = _mm_shuffle_epi8(out, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9,
+						  8, 14, 13, 12, -1, -1, -1, -1));
+
+	_mm_storeu_si128((__m128i *)dst, out);
+
+	return true;
+}
+
+/* Encode 8 bytes into 16 lower case hex characters */
+static inline Z_SSSE3 void z_bin2hex8_ssse3(const uint8_t *buf, char *hex)
+{
+	__m128i in = _mm_loadl_epi64((const __m128i *)buf);
+	__m128i mask = _mm_set1_epi8(0x0f);
+	__m128i hi = _mm_and_si128(_mm_srli_epi16(in, 4), mask);
+	__m128i lo = _mm_and_si128(in, mask);
+	__m128i nibbles = _mm_unpacklo_epi8(hi, lo);
+
+	_mm_storeu_si128((__m128i *)hex,
+			 _mm_shuffle_epi8(_mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+							'8', '9', 'a', 'b', 'c', 'd', 'e', 'f'),
+					  nibbles));
+}
+
+/* Decode 16 hex characters into 8 bytes, false if one is not a hex digit */
+static inline Z_SSSE3 bool z_hex2bin16_ssse3(const char *hex, uint8_t *buf)
+{
+	__m128i in = _mm_loadu_si128((const __m128i *)hex);
+	__m128i digit = z_ssse3_in_range(in, '0', '9');
+	__m128i letter = z_ssse3_in_range(_mm_or_si128(in, _mm_set1_epi8(0x20)), 'a', 'f');
+	__m128i nibbles;
+
+	if (_mm_movemask_epi8(_mm_or_si128(digit, letter)) != 0xffff) {
+		return false;
+	}
+
+	/* '0' - 0 is 48, and ('A' | 0x20) - 10 is 87 */
+	nibbles = _mm_sub_epi8(_mm_or_si128(in, _mm_and_si128(letter, _mm_set1_epi8(0x20))),
+			       _mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8('0')),
+					    _mm_and_si128(letter, _mm_set1_epi8('a' - 10))));
+
+	/* High nibble times 16 plus low nibble, then narrow to bytes */
+	nibbles = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+	_mm_storel_epi64((__m128i *)buf, _mm_packus_epi16(nibbles, nibbles));
+
+	return true;
+}
+
+#endif /* ZEPHYR_LIB_UTILS_CODEC_SSSE3_H_ */
@@ -9,6 +9,10 @@
 #include <errno.h>
 #include <zephyr/sys/util.h>
 
+#ifdef CONFIG_UTIL_CODEC_SSSE3
+#include "codec_ssse3.h"
+#endif
+
 int char2hex(char c, uint8_t *x)
 {
 	if (c >= '0' && c <= '9') {
@@ -43,7 +47,15 @@ size_t bin2hex(const uint8_t *buf, size_t buflen, char *hex, size_t hexlen)
 		return 0;
 	}
 
-	for (size_t i = 0; i < buflen; i++) {
+	size_t i = 0;
+
+#ifdef CONFIG_UTIL_CODEC_SSSE3
+	for (; i + 8U <= buflen; i += 8U) {
+		z_bin2hex8_ssse3(&buf[i], &hex[2U * i]);
+	}
+#endif
+
+	for (; i < buflen; i++) {
 		if (hex2char(buf[i] >> 4, &hex[2U * i]) < 0) {
 			return 0;
 		}
@@ -74,8 +86,17 @@ size_t hex2bin(const char *hex, size_t hexlen, uint8_t *buf, size_t buflen)
 		buf++;
 	}
 
+	size_t i = 0;
+
+#ifdef CONFIG_UTIL_CODEC_SSSE3
+	/* Blocks that are not all hex digits are left to the regular loop */
+	while (i + 8U <= hexlen / 2U && z_hex2bin16_ssse3(&hex[2U * i], &buf[i])) {
+		i += 8U;
+	}
+#endif
+
 	/* regular hex conversion */
-	for (size_t i = 0; i < hexlen / 2U; i++) {
+	for (; i < hexlen / 2U; i++) {
 		if (char2hex(hex[2U * i], &dec) < 0) {
 			return 0;
 		}
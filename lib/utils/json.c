@@ -661,12 +661,49 @@ static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val)
 	return -EINVAL;
 }
 
+/* Find the descriptor of a field that has not been decoded yet. The search
+ * starts at @a hint, the descriptor after the last decoded field, so that
+ * fields in the order of the descriptors are found at the first compare.
+ */
+static int descr_find(const struct json_obj_descr *descr, size_t descr_len,
+		      int64_t decoded_fields, const char *key, size_t key_len,
+		      size_t hint)
+{
+	size_t i, n;
+
+	for (n = 0; n < descr_len; n++) {
+		i = hint + n;
+		if (i >= descr_len) {
+			i -= descr_len;
+		}
+
+		/* Field has been decoded already, skip */
+		if (decoded_fields & ((int64_t)1 << i)) {
+			continue;
+		}
+
+		/* Check if it's the i-th field */
+		if (key_len != descr[i].field_name_len) {
+			continue;
+		}
+
+		if (memcmp(key, descr[i].field_name, descr[i].field_name_len)) {
+			continue;
+		}
+
+		return i;
+	}
+
+	return -1;
+}
+
 static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 			 size_t descr_len, void *val)
 {
 	struct json_obj_key_value kv;
 	int64_t decoded_fields = 0;
-	size_t i;
+	size_t hint = 0;
+	int i;
 	int ret;
 
 	while (!obj_next(obj, &kv)) {
@@ -674,42 +711,28 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
-
-			/* Field has been decoded already, skip */
-			if (decoded_fields & ((int64_t)1 << i)) {
-				continue;
-			}
-
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
-			}
-
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
-				continue;
-			}
+		i = descr_find(descr, descr_len, decoded_fields, kv.key,
+			       kv.key_len, hint);
 
-			/* Store the decoded value */
-			ret = decode_value(obj, &descr[i], &kv.value,
-					   decode_field, val);
+		/* Skip field, if no descriptor was found */
+		if (i < 0) {
+			ret = skip_field(obj, &kv);
 			if (ret < 0) {
 				return ret;
 			}
 
-			decoded_fields |= (int64_t)1<<i;
-			break;
+			continue;
 		}
 
-		/* Skip field, if no descriptor was found */
-		if (i >= descr_len) {
-			ret = skip_field(obj, &kv);
-			if (ret < 0) {
-				return ret;
-			}
+		/* Store the decoded value */
+		ret = decode_value(obj, &descr[i], &kv.value,
+				   (char *)val + descr[i].offset, val);
+		if (ret < 0) {
+			return ret;
 		}
+
+		decoded_fields |= (int64_t)1<<i;
+		hint = i + 1;
 	}
 
 	return -EINVAL;
@@ -779,6 +802,617 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+/* Grammar states of the streaming parser */
+enum {
+	STREAM_VALUE,
+	STREAM_VALUE_OR_END,
+	STREAM_KEY,
+	STREAM_KEY_OR_END,
+	STREAM_COLON,
+	STREAM_COMMA_OR_END,
+	STREAM_DONE,
+	STREAM_ERROR,
+};
+
+/* Lexer states of the streaming parser */
+enum {
+	STREAM_LEX_NONE,
+	STREAM_LEX_KEY,
+	STREAM_LEX_STRING,
+	STREAM_LEX_ESCAPE,
+	STREAM_LEX_UNICODE,
+	STREAM_LEX_NUMBER,
+	STREAM_LEX_LITERAL,
+};
+
+#define STREAM_MAX_NESTING 32
+
+void json_stream_init(struct json_stream *js, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data)
+{
+	memset(js, 0, sizeof(*js));
+
+	js->cb = cb;
+	js->user_data = user_data;
+	js->buf = buf;
+	js->buf_size = buf_size;
+	js->state = STREAM_VALUE;
+	js->lex = STREAM_LEX_NONE;
+}
+
+static bool stream_in_object(struct json_stream *js)
+{
+	return js->depth > 0 &&
+	       (js->nesting & BIT(js->depth - 1)) != 0U;
+}
+
+static int stream_emit(struct json_stream *js, enum json_tokens type)
+{
+	struct json_stream_event event = {
+		.type = type,
+		.depth = js->depth,
+	};
+
+	if (type != JSON_TOK_OBJECT_END && type != JSON_TOK_ARRAY_END &&
+	    stream_in_object(js)) {
+		event.key = js->buf;
+		event.key_len = js->key_len;
+	}
+
+	if (type != JSON_TOK_OBJECT_START && type != JSON_TOK_ARRAY_START &&
+	    type != JSON_TOK_OBJECT_END && type != JSON_TOK_ARRAY_END) {
+		js->buf[js->key_len + js->tok_len] = '\0';
+		event.value = &js->buf[js->key_len];
+		event.value_len = js->tok_len;
+	}
+
+	return js->cb(&event, js->user_data);
+}
+
+static int stream_append(struct json_stream *js, char chr)
+{
+	/* Keep room for the NUL terminator */
+	if (js->key_len + js->tok_len + 1 >= js->buf_size) {
+		return -ENOMEM;
+	}
+
+	js->buf[js->key_len + js->tok_len++] = chr;
+
+	return 0;
+}
+
+static void stream_value_done(struct json_stream *js)
+{
+	js->key_len = 0;
+	js->tok_len = 0;
+	js->state = js->depth == 0 ? STREAM_DONE : STREAM_COMMA_OR_END;
+}
+
+static int stream_scalar(struct json_stream *js)
+{
+	int ret;
+
+	js->lex = STREAM_LEX_NONE;
+
+	if (js->tok_type == JSON_TOK_NUMBER &&
+	    (js->tok_len == 1 && js->buf[js->key_len] == '-')) {
+		return -EINVAL;
+	}
+
+	ret = stream_emit(js, js->tok_type);
+	if (ret < 0) {
+		return ret;
+	}
+
+	stream_value_done(js);
+
+	return 0;
+}
+
+static const char *stream_literal(enum json_tokens type)
+{
+	switch (type) {
+	case JSON_TOK_TRUE:
+		return "true";
+	case JSON_TOK_FALSE:
+		return "false";
+	default:
+		return "null";
+	}
+}
+
+static bool stream_expects_value(struct json_stream *js)
+{
+	return js->state == STREAM_VALUE || js->state == STREAM_VALUE_OR_END;
+}
+
+static int stream_start(struct json_stream *js, char chr)
+{
+	bool object = chr == '{';
+	int ret;
+
+	if (!stream_expects_value(js) || js->depth >= STREAM_MAX_NESTING) {
+		return -EINVAL;
+	}
+
+	ret = stream_emit(js, (enum json_tokens)chr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (object) {
+		js->nesting |= BIT(js->depth);
+	} else {
+		js->nesting &= ~BIT(js->depth);
+	}
+
+	js->depth++;
+	js->key_len = 0;
+	js->state = object ? STREAM_KEY_OR_END : STREAM_VALUE_OR_END;
+
+	return 0;
+}
+
+static int stream_end(struct json_stream *js, char chr)
+{
+	bool object = chr == '}';
+	int ret;
+
+	if (js->depth == 0 || stream_in_object(js) != object) {
+		return -EINVAL;
+	}
+
+	if (js->state != STREAM_COMMA_OR_END &&
+	    js->state != (object ? STREAM_KEY_OR_END : STREAM_VALUE_OR_END)) {
+		return -EINVAL;
+	}
+
+	js->depth--;
+
+	ret = stream_emit(js, (enum json_tokens)chr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	stream_value_done(js);
+
+	return 0;
+}
+
+static int stream_token_start(struct json_stream *js, int lex,
+			      enum json_tokens type, char chr)
+{
+	if (!stream_expects_value(js)) {
+		return -EINVAL;
+	}
+
+	js->lex = lex;
+	js->tok_type = type;
+
+	return stream_append(js, chr);
+}
+
+static int stream_structural(struct json_stream *js, char chr)
+{
+	switch (chr) {
+	case '{':
+	case '[':
+		return stream_start(js, chr);
+	case '}':
+	case ']':
+		return stream_end(js, chr);
+	case ',':
+		if (js->state != STREAM_COMMA_OR_END) {
+			return -EINVAL;
+		}
+
+		js->state = stream_in_object(js) ? STREAM_KEY : STREAM_VALUE;
+		return 0;
+	case ':':
+		if (js->state != STREAM_COLON) {
+			return -EINVAL;
+		}
+
+		js->state = STREAM_VALUE;
+		return 0;
+	case '"':
+		if (js->state == STREAM_KEY || js->state == STREAM_KEY_OR_END) {
+			/* The previous member name is not needed anymore */
+			js->key_len = 0;
+			js->lex = STREAM_LEX_KEY;
+			return 0;
+		}
+
+		if (!stream_expects_value(js)) {
+			return -EINVAL;
+		}
+
+		js->lex = STREAM_LEX_STRING;
+		js->tok_type = JSON_TOK_STRING;
+		return 0;
+	case 't':
+		return stream_token_start(js, STREAM_LEX_LITERAL,
+					  JSON_TOK_TRUE, chr);
+	case 'f':
+		return stream_token_start(js, STREAM_LEX_LITERAL,
+					  JSON_TOK_FALSE, chr);
+	case 'n':
+		return stream_token_start(js, STREAM_LEX_LITERAL,
+					  JSON_TOK_NULL, chr);
+	default:
+		if (isspace((unsigned char)chr) != 0) {
+			return 0;
+		}
+
+		if (chr == '-' || isdigit((unsigned char)chr) != 0) {
+			return stream_token_start(js, STREAM_LEX_NUMBER,
+						  JSON_TOK_NUMBER, chr);
+		}
+
+		return -EINVAL;
+	}
+}
+
+static int stream_char(struct json_stream *js, char chr)
+{
+	const char *literal;
+	int ret;
+
+	switch (js->lex) {
+	case STREAM_LEX_KEY:
+	case STREAM_LEX_STRING:
+		if (chr == '"') {
+			if (js->lex == STREAM_LEX_STRING) {
+				return stream_scalar(js);
+			}
+
+			/* The member name stays at the start of the buffer */
+			js->key_len = js->tok_len;
+			js->tok_len = 0;
+			js->lex = STREAM_LEX_NONE;
+			js->state = STREAM_COLON;
+			return 0;
+		}
+
+		if (chr == '\\') {
+			/* Return to the string or the key after the escape */
+			js->lex_count = js->lex;
+			js->lex = STREAM_LEX_ESCAPE;
+		}
+
+		return stream_append(js, chr);
+	case STREAM_LEX_ESCAPE:
+		switch (chr) {
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			js->lex = js->lex_count;
+			break;
+		case 'u':
+			/* Four hex digits, the string lexer in the low bits */
+			js->lex = STREAM_LEX_UNICODE;
+			js->lex_count |= 4 << 4;
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		return stream_append(js, chr);
+	case STREAM_LEX_UNICODE:
+		if (isxdigit((unsigned char)chr) == 0) {
+			return -EINVAL;
+		}
+
+		js->lex_count -= 1 << 4;
+		if ((js->lex_count >> 4) == 0) {
+			js->lex = js->lex_count;
+		}
+
+		return stream_append(js, chr);
+	case STREAM_LEX_NUMBER:
+		if (isdigit((unsigned char)chr) != 0 || chr == '.') {
+			return stream_append(js, chr);
+		}
+
+		ret = stream_scalar(js);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* The character after the number still has to be parsed */
+		return stream_structural(js, chr);
+	case STREAM_LEX_LITERAL:
+		literal = stream_literal(js->tok_type);
+
+		if (chr != literal[js->tok_len]) {
+			return -EINVAL;
+		}
+
+		if (stream_append(js, chr) < 0) {
+			return -ENOMEM;
+		}
+
+		if (literal[js->tok_len] == '\0') {
+			return stream_scalar(js);
+		}
+
+		return 0;
+	default:
+		return stream_structural(js, chr);
+	}
+}
+
+int json_stream_feed(struct json_stream *js, const char *data, size_t len)
+{
+	size_t i;
+	int ret;
+
+	if (js->state == STREAM_ERROR) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < len; i++) {
+		ret = stream_char(js, data[i]);
+		if (ret < 0) {
+			js->state = STREAM_ERROR;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int json_stream_finish(struct json_stream *js)
+{
+	int ret;
+
+	if (js->state != STREAM_ERROR && js->lex == STREAM_LEX_NUMBER) {
+		ret = stream_scalar(js);
+		if (ret < 0) {
+			js->state = STREAM_ERROR;
+			return ret;
+		}
+	}
+
+	if (js->state != STREAM_DONE || js->lex != STREAM_LEX_NONE) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Copy a decoded value to the end of the buffer, where it is not
+ * overwritten by the following tokens.
+ */
+static char *obj_stream_keep(struct json_stream *js, const char *value,
+			     size_t len)
+{
+	char *kept;
+
+	if (js->key_len + js->tok_len + len + 1 > js->buf_size) {
+		return NULL;
+	}
+
+	js->buf_size -= len + 1;
+	kept = &js->buf[js->buf_size];
+
+	memmove(kept, value, len);
+	kept[len] = '\0';
+
+	return kept;
+}
+
+static int obj_stream_scalar(struct json_obj_stream *os,
+			     const struct json_obj_descr *descr,
+			     const struct json_stream_event *event,
+			     void *field)
+{
+	switch (descr->type) {
+	case JSON_TOK_FALSE:
+	case JSON_TOK_TRUE: {
+		bool *v = field;
+
+		*v = event->type == JSON_TOK_TRUE;
+
+		return 0;
+	}
+	case JSON_TOK_NUMBER: {
+		struct json_token token = {
+			.type = event->type,
+			.start = (char *)event->value,
+			.end = (char *)event->value + event->value_len,
+		};
+
+		return decode_num(&token, field);
+	}
+	case JSON_TOK_OPAQUE:
+	case JSON_TOK_FLOAT: {
+		struct json_obj_token *obj_token = field;
+
+		obj_token->start = obj_stream_keep(&os->stream, event->value,
+						   event->value_len);
+		obj_token->length = event->value_len;
+
+		return obj_token->start != NULL ? 0 : -ENOMEM;
+	}
+	case JSON_TOK_STRING: {
+		char **str = field;
+
+		*str = obj_stream_keep(&os->stream, event->value,
+				       event->value_len);
+
+		return *str != NULL ? 0 : -ENOMEM;
+	}
+	default:
+		return -EINVAL;
+	}
+}
+
+static int obj_stream_container(struct json_obj_stream *os,
+				const struct json_obj_descr *descr,
+				struct json_obj_stream_frame *parent,
+				void *field, int index)
+{
+	struct json_obj_stream_frame *frame;
+	const struct json_obj_descr *elem_descr;
+
+	if (os->stream.depth >= JSON_OBJ_STREAM_MAX_DEPTH) {
+		return -ENOSPC;
+	}
+
+	frame = &os->frames[os->stream.depth];
+	memset(frame, 0, sizeof(*frame));
+	frame->index = index;
+
+	if (descr->type == JSON_TOK_OBJECT_START) {
+		frame->descr = descr->object.sub_descr;
+		frame->descr_len = descr->object.sub_descr_len;
+		frame->val = field;
+
+		return 0;
+	}
+
+	elem_descr = descr->array.element_descr;
+	if (elem_descr->type == JSON_TOK_ARRAY_START) {
+		return -ENOTSUP;
+	}
+
+	/* The element count is a field of the enclosing object */
+	frame->descr = elem_descr;
+	frame->descr_len = descr->array.n_elements;
+	frame->val = field;
+	frame->elements = (size_t *)((char *)parent->val + elem_descr->offset);
+	*frame->elements = 0;
+
+	return 0;
+}
+
+static int obj_stream_cb(const struct json_stream_event *event,
+			 void *user_data)
+{
+	struct json_obj_stream *os = user_data;
+	struct json_obj_stream_frame *frame;
+	const struct json_obj_descr *descr;
+	bool start = event->type == JSON_TOK_OBJECT_START ||
+		     event->type == JSON_TOK_ARRAY_START;
+	bool end = event->type == JSON_TOK_OBJECT_END ||
+		   event->type == JSON_TOK_ARRAY_END;
+	void *field;
+	int i = -1;
+	int ret;
+
+	if (os->skip != 0U) {
+		if (end && event->depth == os->skip - 1) {
+			os->skip = 0U;
+		}
+
+		return 0;
+	}
+
+	if (event->depth == 0) {
+		/* The top level frame is set up by json_obj_stream_init() */
+		return event->type == JSON_TOK_OBJECT_START ||
+		       event->type == JSON_TOK_OBJECT_END ? 0 : -EINVAL;
+	}
+
+	frame = &os->frames[event->depth - 1];
+
+	if (end) {
+		/* The field is decoded once the object or array is complete */
+		if (os->frames[event->depth].index >= 0 &&
+		    frame->elements == NULL) {
+			frame->decoded |= (int64_t)1 << os->frames[event->depth].index;
+		}
+
+		return 0;
+	}
+
+	if (frame->elements != NULL) {
+		descr = frame->descr;
+
+		if (*frame->elements == frame->descr_len) {
+			return -ENOSPC;
+		}
+
+		field = frame->val;
+		frame->val = (char *)frame->val + get_elem_size(descr);
+		(*frame->elements)++;
+	} else {
+		i = descr_find(frame->descr, frame->descr_len, frame->decoded,
+			       event->key, event->key_len, frame->hint);
+		if (i < 0) {
+			/* Skip the field, if no descriptor was found */
+			if (start) {
+				os->skip = event->depth + 1;
+			}
+
+			return 0;
+		}
+
+		descr = &frame->descr[i];
+		field = (char *)frame->val + descr->offset;
+		frame->hint = i + 1;
+	}
+
+	if (!equivalent_types(event->type, descr->type)) {
+		return -EINVAL;
+	}
+
+	if (start) {
+		return obj_stream_container(os, descr, frame, field, i);
+	}
+
+	ret = obj_stream_scalar(os, descr, event, field);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (i >= 0) {
+		frame->decoded |= (int64_t)1 << i;
+	}
+
+	return 0;
+}
+
+void json_obj_stream_init(struct json_obj_stream *os, char *buf,
+			  size_t buf_size, const struct json_obj_descr *descr,
+			  size_t descr_len, void *val)
+{
+	__ASSERT_NO_MSG(descr_len < (sizeof(int64_t) * CHAR_BIT - 1));
+
+	json_stream_init(&os->stream, buf, buf_size, obj_stream_cb, os);
+
+	memset(os->frames, 0, sizeof(os->frames));
+	os->frames[0].descr = descr;
+	os->frames[0].descr_len = descr_len;
+	os->frames[0].val = val;
+	os->frames[0].index = -1;
+	os->skip = 0U;
+}
+
+int json_obj_stream_feed(struct json_obj_stream *os, const char *data,
+			 size_t len)
+{
+	return json_stream_feed(&os->stream, data, len);
+}
+
+int64_t json_obj_stream_finish(struct json_obj_stream *os)
+{
+	int ret;
+
+	ret = json_stream_finish(&os->stream);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return os->frames[0].decoded;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -1166,3 +1800,86 @@ ssize_t json_calc_encoded_arr_len(const struct json_obj_descr *descr,
 
 	return total;
 }
+
+void json_enc_raw(struct json_enc *enc, const char *bytes, size_t len)
+{
+	if (enc->len < enc->size) {
+		/* Keep the last byte of the buffer for the terminator */
+		memcpy(enc->buf + enc->len, bytes,
+		       MIN(len, enc->size - 1 - enc->len));
+	}
+
+	enc->len += len;
+}
+
+void json_enc_str(struct json_enc *enc, const char *str)
+{
+	const char *run = str;
+	const char *cur;
+
+	json_enc_raw(enc, "\"", 1);
+
+	/* Copy the runs of characters that need no escape at once */
+	for (cur = str; *cur; cur++) {
+		char escaped = escape_as(*cur);
+
+		if (escaped) {
+			char bytes[2] = { '\\', escaped };
+
+			json_enc_raw(enc, run, cur - run);
+			json_enc_raw(enc, bytes, sizeof(bytes));
+			run = cur + 1;
+		}
+	}
+
+	json_enc_raw(enc, run, cur - run);
+	json_enc_raw(enc, "\"", 1);
+}
+
+void json_enc_num(struct json_enc *enc, int32_t num)
+{
+	char buf[3 * sizeof(int32_t)];
+	char *pos = &buf[sizeof(buf)];
+	uint32_t mag = num < 0 ? 0U - (uint32_t)num : (uint32_t)num;
+
+	do {
+		*(--pos) = '0' + (mag % 10U);
+		mag /= 10U;
+	} while (mag != 0U);
+
+	if (num < 0) {
+		*(--pos) = '-';
+	}
+
+	json_enc_raw(enc, pos, &buf[sizeof(buf)] - pos);
+}
+
+void json_enc_bool(struct json_enc *enc, bool value)
+{
+	if (value) {
+		json_enc_raw(enc, "true", 4);
+	} else {
+		json_enc_raw(enc, "false", 5);
+	}
+}
+
+void json_enc_float(struct json_enc *enc, const struct json_obj_token *num)
+{
+	json_enc_raw(enc, num->start, num->length);
+}
+
+void json_enc_opaque(struct json_enc *enc, const struct json_obj_token *opaque)
+{
+	json_enc_raw(enc, "\"", 1);
+	json_enc_raw(enc, opaque->start, opaque->length);
+	json_enc_raw(enc, "\"", 1);
+}
+
+ssize_t json_enc_finish(struct json_enc *enc)
+{
+	if (enc->size > 0) {
+		enc->buf[MIN(enc->len, enc->size - 1)] = '\0';
+	}
+
+	return (ssize_t)enc->len;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/mpmc_ring.h>
+#include <zephyr/sys/__assert.h>
+#include <errno.h>
+#include <string.h>
+
+/*
+ * Bounded queue after Dmitry Vyukov's: the element at index pos & mask has
+ * the sequence number pos when it can be written for position pos, pos + 1
+ * once that write is finished, and pos + mask + 1 once it has been read,
+ * which makes it writable for the next lap. Positions only take 32 bits, so
+ * they are compared through their signed difference.
+ */
+
+static inline int32_t seq_diff(atomic_val_t seq, uint32_t pos)
+{
+	return (int32_t)((uint32_t)seq - pos);
+}
+
+static inline uint8_t *elem_get(struct mpmc_ring *ring, uint32_t idx)
+{
+	return &ring->buffer[(size_t)idx * ring->elem_size];
+}
+
+static inline uint32_t elem_idx(struct mpmc_ring *ring, void *elem)
+{
+	size_t offset = (uint8_t *)elem - ring->buffer;
+
+	__ASSERT((offset % ring->elem_size) == 0 &&
+		 (offset / ring->elem_size) <= ring->mask, "Invalid element %p", elem);
+
+	return offset / ring->elem_size;
+}
+
+void mpmc_ring_init(struct mpmc_ring *ring, atomic_t *seq, void *buffer,
+		    size_t elem_size, uint32_t n_elems)
+{
+	__ASSERT(IS_POWER_OF_TWO(n_elems), "Number of elements must be a power of 2");
+
+	ring->seq = seq;
+	ring->buffer = buffer;
+	ring->elem_size = elem_size;
+	ring->mask = n_elems - 1;
+
+	for (uint32_t i = 0; i < n_elems; i++) {
+		atomic_set(&seq[i], i);
+	}
+
+	atomic_set(&ring->head, 0);
+	atomic_set(&ring->tail, 0);
+}
+
+void *mpmc_ring_put_claim(struct mpmc_ring *ring)
+{
+	uint32_t pos = (uint32_t)atomic_get(&ring->head);
+	int32_t diff;
+
+	for (;;) {
+		diff = seq_diff(atomic_get(&ring->seq[pos & ring->mask]), pos);
+
+		if (diff < 0) {
+			/* Not read yet since the previous lap */
+			return NULL;
+		}
+
+		if (diff == 0 && atomic_cas(&ring->head, pos, pos + 1)) {
+			return elem_get(ring, pos & ring->mask);
+		}
+
+		/* Another producer took it */
+		pos = (uint32_t)atomic_get(&ring->head);
+	}
+}
+
+void mpmc_ring_put_finish(struct mpmc_ring *ring, void *elem)
+{
+	atomic_t *seq = &ring->seq[elem_idx(ring, elem)];
+
+	(void)atomic_inc(seq);
+}
+
+void *mpmc_ring_get_claim(struct mpmc_ring *ring)
+{
+	uint32_t pos = (uint32_t)atomic_get(&ring->tail);
+	int32_t diff;
+
+	for (;;) {
+		diff = seq_diff(atomic_get(&ring->seq[pos & ring->mask]), pos + 1);
+
+		if (diff < 0) {
+			/* Not written yet */
+			return NULL;
+		}
+
+		if (diff == 0 && atomic_cas(&ring->tail, pos, pos + 1)) {
+			return elem_get(ring, pos & ring->mask);
+		}
+
+		/* Another consumer took it */
+		pos = (uint32_t)atomic_get(&ring->tail);
+	}
+}
+
+void mpmc_ring_get_finish(struct mpmc_ring *ring, void *elem)
+{
+	atomic_t *seq = &ring->seq[elem_idx(ring, elem)];
+
+	(void)atomic_add(seq, ring->mask);
+}
+
+int mpmc_ring_put(struct mpmc_ring *ring, const void *elem)
+{
+	void *dst = mpmc_ring_put_claim(ring);
+
+	if (dst == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(dst, elem, ring->elem_size);
+	mpmc_ring_put_finish(ring, dst);
+
+	return 0;
+}
+
+int mpmc_ring_get(struct mpmc_ring *ring, void *elem)
+{
+	void *src = mpmc_ring_get_claim(ring);
+
+	if (src == NULL) {
+		return -EAGAIN;
+	}
+
+	memcpy(elem, src, ring->elem_size);
+	mpmc_ring_get_finish(ring, src);
+
+	return 0;
+}
+
+size_t mpmc_ring_get_n(struct mpmc_ring *ring, void *elems, size_t n)
+{
+	uint8_t *dst = elems;
+	uint32_t pos;
+	uint32_t idx;
+	size_t avail;
+
+	n = MIN(n, (size_t)ring->mask + 1);
+
+	do {
+		pos = (uint32_t)atomic_get(&ring->tail);
+
+		/* Count the finished elements that follow the tail */
+		for (avail = 0; avail < n; avail++) {
+			idx = (pos + avail) & ring->mask;
+
+			if (seq_diff(atomic_get(&ring->seq[idx]), pos + avail + 1) != 0) {
+				break;
+			}
+		}
+
+		if (avail == 0) {
+			return 0;
+		}
+	} while (!atomic_cas(&ring->tail, pos, pos + avail));
+
+	for (size_t i = 0; i < avail; i++) {
+		idx = (pos + i) & ring->mask;
+
+		memcpy(dst, elem_get(ring, idx), ring->elem_size);
+		dst += ring->elem_size;
+		(void)atomic_add(&ring->seq[idx], ring->mask);
+	}
+
+	return avail;
+}
@@ -71,6 +71,12 @@
 #define FF_FS_TIMEOUT		K_FOREVER
 #endif /* defined(CONFIG_FS_FATFS_REENTRANT) */
 
+/* The fast seek link map lists the fragments of files read in place */
+#if defined(CONFIG_FILE_SYSTEM_READ_DIRECT)
+#undef FF_USE_FASTSEEK
+#define FF_USE_FASTSEEK 1
+#endif /* defined(CONFIG_FILE_SYSTEM_READ_DIRECT) */
+
 /*
  * These options are override from default values, but have no Kconfig
  * options.
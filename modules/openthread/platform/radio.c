@@ -148,6 +148,17 @@ static void set_pending_event(enum pending_events event)
 	otSysEventSignalPending();
 }
 
+/* Signals an event with a queue of frames, unless still pending: the frames
+ * queued meanwhile are handled by the same pass of platformRadioProcess(),
+ * which resets the event before emptying the queue.
+ */
+static void set_pending_queue_event(enum pending_events event)
+{
+	if (!atomic_test_and_set_bit(pending_events, event)) {
+		otSysEventSignalPending();
+	}
+}
+
 static void reset_pending_event(enum pending_events event)
 {
 	atomic_clear_bit(pending_events, event);
@@ -480,12 +491,24 @@ static inline void handle_tx_done(otInstance *aInstance)
 static void openthread_handle_received_frame(otInstance *instance,
 					     struct net_pkt *pkt)
 {
+	static uint8_t rx_psdu[OT_RADIO_FRAME_MAX_SIZE];
 	otRadioFrame recv_frame;
 	memset(&recv_frame, 0, sizeof(otRadioFrame));
 
-	recv_frame.mPsdu = net_buf_frag_last(pkt->buffer)->data;
 	/* Length inc. CRC. */
 	recv_frame.mLength = net_buf_frags_len(pkt->buffer);
+
+	/* The frame is handed to OpenThread in place, unless the driver spread
+	 * it over several fragments.
+	 */
+	if (pkt->buffer->frags == NULL) {
+		recv_frame.mPsdu = pkt->buffer->data;
+	} else {
+		recv_frame.mLength = net_buf_linearize(rx_psdu, sizeof(rx_psdu),
+						       pkt->buffer, 0,
+						       recv_frame.mLength);
+		recv_frame.mPsdu = rx_psdu;
+	}
 	recv_frame.mChannel = platformRadioChannelGet(instance);
 	recv_frame.mInfo.mRxInfo.mLqi = net_pkt_ieee802154_lqi(pkt);
 	recv_frame.mInfo.mRxInfo.mRssi = net_pkt_ieee802154_rssi_dbm(pkt);
@@ -544,7 +567,7 @@ exit:
 int notify_new_rx_frame(struct net_pkt *pkt)
 {
 	k_fifo_put(&rx_pkt_fifo, pkt);
-	set_pending_event(PENDING_EVENT_FRAME_RECEIVED);
+	set_pending_queue_event(PENDING_EVENT_FRAME_RECEIVED);
 
 	return 0;
 }
@@ -552,7 +575,7 @@ int notify_new_rx_frame(struct net_pkt *pkt)
 int notify_new_tx_frame(struct net_pkt *pkt)
 {
 	k_fifo_put(&tx_pkt_fifo, pkt);
-	set_pending_event(PENDING_EVENT_FRAME_TO_SEND);
+	set_pending_queue_event(PENDING_EVENT_FRAME_TO_SEND);
 
 	return 0;
 }
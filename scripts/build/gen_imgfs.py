@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Build an image of the read-only image file system (imgfs)
+
+The image holds the files and directories found in a host directory. It is
+meant to be linked into the application, and mounted by passing its address
+as the storage device of an FS_IMGFS mount point.
+
+Layout of the image, all values little endian:
+
+  header     magic "ZIMG", version, flags, entry count, number of entries
+             of the root directory, offset of the names, image size and
+             size of the compressed blocks
+  entries    sorted by parent directory, then by name, so that the entries
+             of a directory are contiguous, and a path is found with a
+             binary search
+  names      full paths of the entries, without leading '/'
+  data       uncompressed files are stored as is, aligned for in place
+             access; compressed files have a table of the offsets of their
+             blocks, followed by the blocks
+"""
+
+import argparse
+import fnmatch
+import os
+import struct
+import sys
+
+IMGFS_MAGIC = b"ZIMG"
+IMGFS_VERSION = 1
+
+HEADER = struct.Struct("<4sHHIIIII")
+ENTRY = struct.Struct("<IHHIIBBH")
+
+TYPE_FILE = 0
+TYPE_DIR = 1
+
+COMP_NONE = 0
+COMP_LZ4 = 1
+
+# LZ4 block format constraints
+LZ4_MIN_MATCH = 4
+LZ4_LAST_LITERALS = 5
+LZ4_MF_LIMIT = 12
+LZ4_MAX_OFFSET = 65535
+
+
+def lz4_compress_block(data):
+    """Compress data into a single LZ4 block, without size header"""
+    out = bytearray()
+    table = {}
+    end = len(data)
+    match_limit = end - LZ4_MF_LIMIT
+    anchor = 0
+    pos = 0
+
+    def emit(literals, match_len, offset):
+        lit_len = len(literals)
+        token = (min(lit_len, 15) << 4)
+        if match_len is not None:
+            token |= min(match_len - LZ4_MIN_MATCH, 15)
+        out.append(token)
+        if lit_len >= 15:
+            rest = lit_len - 15
+            while rest >= 255:
+                out.append(255)
+                rest -= 255
+            out.append(rest)
+        out.extend(literals)
+        if match_len is not None:
+            out.extend(struct.pack("<H", offset))
+            if match_len - LZ4_MIN_MATCH >= 15:
+                rest = match_len - LZ4_MIN_MATCH - 15
+                while rest >= 255:
+                    out.append(255)
+                    rest -= 255
+                out.append(rest)
+
+    while pos < match_limit:
+        key = data[pos:pos + LZ4_MIN_MATCH]
+        ref = table.get(key)
+        table[key] = pos
+        if ref is None or pos - ref > LZ4_MAX_OFFSET:
+            pos += 1
+            continue
+
+        # The last literals can not be part of a match
+        length = LZ4_MIN_MATCH
+        while (pos + length < end - LZ4_LAST_LITERALS and
+               data[ref + length] == data[pos + length]):
+            length += 1
+
+        emit(data[anchor:pos], length, pos - ref)
+        pos += length
+        anchor = pos
+
+    emit(data[anchor:], None, 0)
+
+    return bytes(out)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+
+    parser.add_argument("-i", "--input", required=True,
+                        help="Directory to build the image from")
+    parser.add_argument("-o", "--output", required=True, help="Image file")
+    parser.add_argument("-c", "--compress", choices=["none", "lz4"], default="none",
+                        help="Compression of the files")
+    parser.add_argument("-b", "--block-size", type=lambda x: int(x, 0), default=4096,
+                        help="Size of the compressed blocks, a power of 2")
+    parser.add_argument("-a", "--align", type=lambda x: int(x, 0), default=4,
+                        help="Alignment of uncompressed files in the image")
+    parser.add_argument("-n", "--no-compress", action="append", default=[],
+                        metavar="PATTERN",
+                        help="""Store the files with a path matching PATTERN
+                        uncompressed, so that they can be read in place.
+                        Can be given several times.""")
+    parser.add_argument("-m", "--max-name", type=int, default=255,
+                        help="Maximum length of a file name")
+
+    args = parser.parse_args()
+
+    if args.block_size < 64 or args.block_size & (args.block_size - 1):
+        parser.error("block size must be a power of 2 of at least 64")
+    if args.align < 1 or args.align & (args.align - 1):
+        parser.error("alignment must be a power of 2")
+
+    return args
+
+
+def scan(root, max_name):
+    """Paths of the directories and files under root, relative to it"""
+    entries = []
+
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames.sort()
+        rel = os.path.relpath(dirpath, root)
+        rel = "" if rel == "." else rel.replace(os.sep, "/")
+
+        for name, is_dir in [(d, True) for d in dirnames] + [(f, False) for f in filenames]:
+            if len(name.encode()) > max_name:
+                sys.exit(f"error: name too long: {name}")
+            path = f"{rel}/{name}" if rel else name
+            entries.append((path, is_dir))
+
+    return entries
+
+
+def sort_key(path):
+    parent, _, name = path.encode().rpartition(b"/")
+    return (parent, name)
+
+
+def pack_file(data, compressed, block_size):
+    """Data of a file, and whether it is compressed"""
+    if not compressed or not data:
+        return data, False
+
+    blocks = []
+    for i in range(0, len(data), block_size):
+        block = data[i:i + block_size]
+        packed = lz4_compress_block(block)
+        # Blocks that do not shrink are stored as is
+        blocks.append(packed if len(packed) < len(block) else block)
+
+    table_size = 4 * (len(blocks) + 1)
+    if table_size + sum(len(b) for b in blocks) >= len(data):
+        return data, False
+
+    return blocks, True
+
+
+def main():
+    args = parse_args()
+
+    paths = sorted(scan(args.input, args.max_name), key=lambda e: sort_key(e[0]))
+    index = {path: i for i, (path, _) in enumerate(paths)}
+
+    names = bytearray()
+    name_offs = []
+    for path, _ in paths:
+        name_offs.append(len(names))
+        names.extend(path.encode() + b"\0")
+
+    names_off = HEADER.size + ENTRY.size * len(paths)
+    data_off = names_off + len(names)
+
+    # Children of each directory, contiguous thanks to the sort order
+    children = {}
+    for path, _ in paths:
+        parent = path.rpartition("/")[0]
+        children.setdefault(parent, []).append(path)
+
+    data = bytearray()
+    entries = []
+    for i, (path, is_dir) in enumerate(paths):
+        encoded = path.encode()
+        base = encoded.rfind(b"/") + 1
+
+        if is_dir:
+            sub = children.get(path, [])
+            first = index[sub[0]] if sub else 0
+            entries.append((name_offs[i], len(encoded), base, len(sub), first,
+                            TYPE_DIR, COMP_NONE, 0))
+            continue
+
+        with open(os.path.join(args.input, path), "rb") as f:
+            content = f.read()
+
+        compress = (args.compress == "lz4" and
+                    not any(fnmatch.fnmatch(path, p) for p in args.no_compress))
+        packed, compressed = pack_file(content, compress, args.block_size)
+
+        if compressed:
+            while (data_off + len(data)) % 4:
+                data.append(0)
+            table_off = data_off + len(data)
+            off = table_off + 4 * (len(packed) + 1)
+            for block in packed:
+                data.extend(struct.pack("<I", off))
+                off += len(block)
+            data.extend(struct.pack("<I", off))
+            for block in packed:
+                data.extend(block)
+            entries.append((name_offs[i], len(encoded), base, len(content), table_off,
+                            TYPE_FILE, COMP_LZ4, 0))
+        else:
+            while (data_off + len(data)) % args.align:
+                data.append(0)
+            entries.append((name_offs[i], len(encoded), base, len(content),
+                            data_off + len(data), TYPE_FILE, COMP_NONE, 0))
+            data.extend(packed)
+
+    image_size = data_off + len(data)
+    root_count = len(children.get("", []))
+
+    with open(args.output, "wb") as f:
+        f.write(HEADER.pack(IMGFS_MAGIC, IMGFS_VERSION, 0, len(entries), root_count,
+                            names_off, image_size, args.block_size))
+        for entry in entries:
+            f.write(ENTRY.pack(*entry))
+        f.write(names)
+        f.write(data)
+
+
+if __name__ == "__main__":
+    main()
@@ -38,6 +38,15 @@ Configuration that needs to be sent to the python script.
 
 Multiple regions can be appended together like SRAM2_DATA_BSS
 this will place data and bss inside SRAM2.
+
+- PROFILE with BUDGET=<bytes> means the files are profiles rather than sources:
+  each line is a hit count followed by a function name, and the hottest
+  functions found in the object files are placed in the memory region until
+  the budget is used up, for example::
+
+   ITCM_TEXT:COPY;PROFILE;BUDGET=16384:/home/xyz/zephyr/samples/hello_world/hot.txt
+
+  The functions must be in sections of their own, as with -ffunction-sections.
 """
 
 
@@ -267,6 +276,96 @@ def find_sections(filename: str) -> 'dict[SectionKind, list[OutputSection]]':
     return out
 
 
+def find_function_sections(searchpath: str) -> 'dict[str, list[Tuple[OutputSection, int]]]':
+    """
+    Locate the sections of the functions in all the object files of the build.
+
+    The output value maps function names to the text and literal sections
+    holding them, each with its size including alignment padding.
+    """
+    out = defaultdict(list)
+
+    for dirpath, _, files in os.walk(searchpath):
+        for obj_file_name in files:
+            if not obj_file_name.endswith((".obj", ".o")):
+                continue
+
+            with open(os.path.join(dirpath, obj_file_name), 'rb') as obj_file_desc:
+                try:
+                    obj_file = ELFFile(obj_file_desc)
+                    sections = [x for x in obj_file.iter_sections()]
+                except Exception:
+                    continue
+
+                for section in sections:
+                    for prefix in (".text.", ".literal."):
+                        if section.name.startswith(prefix):
+                            break
+                    else:
+                        continue
+
+                    align = max(section['sh_addralign'], 1)
+                    size = (section['sh_size'] + align - 1) // align * align
+                    out[section.name[len(prefix):]].append(
+                        (OutputSection(obj_file_name, section.name), size))
+
+    return out
+
+
+def find_hot_sections(
+    profiles: 'list[str]',
+    budget: int,
+    kinds: 'set[SectionKind]',
+    function_sections: 'dict[str, list[Tuple[OutputSection, int]]]',
+    placed: 'set[Tuple[str, str]]'
+) -> 'dict[SectionKind, list[OutputSection]]':
+    """
+    Select the hottest functions of the given profiles that fit in the budget.
+
+    Functions are taken by decreasing hit count. One too large for what is
+    left of the budget is skipped, so that smaller, colder ones may still fit.
+    Only the sections of the given kinds are counted, leaving out those already
+    relocated by another directive.
+    """
+    hits = defaultdict(int)
+    for profile in profiles:
+        with open(profile) as profile_desc:
+            for line in profile_desc:
+                fields = line.split('#', 1)[0].split()
+                if not fields:
+                    continue
+                if len(fields) != 2 or not fields[0].isdigit():
+                    sys.exit(f"Invalid line in profile {profile}: {line.strip()}")
+                hits[fields[1]] += int(fields[0])
+
+    out = defaultdict(list)
+    used = 0
+    for function in sorted(hits, key=lambda f: (-hits[f], f)):
+        if function not in function_sections:
+            if args.verbose:
+                print("Hot function", function, "not found in a section of its own")
+            continue
+
+        sections = [(section, size) for (section, size) in function_sections[function]
+                    if SectionKind.for_section_named(section.section_name) in kinds
+                    and (section.obj_file_name, section.section_name) not in placed]
+        size = sum(size for (_, size) in sections)
+        if not sections or used + size > budget:
+            continue
+
+        used += size
+        for (section, _) in sections:
+            placed.add((section.obj_file_name, section.section_name))
+            out[SectionKind.for_section_named(section.section_name)].append(section)
+        if args.verbose:
+            print("Hot function", function, "relocated,", size, "bytes")
+
+    if args.verbose:
+        print("Hot functions use", used, "of", budget, "bytes")
+
+    return out
+
+
 def assign_to_correct_mem_region(
     memory_region: str,
     full_list_of_sections: 'dict[SectionKind, list[OutputSection]]'
@@ -520,11 +619,13 @@ def parse_input_string(line):
 
 
 # Create a dict with key as memory type and files as a list of values.
-# Also, return another dict with program headers for memory regions
+# Also, return another dict with program headers for memory regions, and one
+# with the profiles and budget of the memory regions given hot functions
 def create_dict_wrt_mem():
     # need to support wild card *
     rel_dict = dict()
     phdrs = dict()
+    profile_dict = dict()
 
     input_rel_dict = args.input_rel_dict.read()
     if input_rel_dict == '':
@@ -556,14 +657,24 @@ def create_dict_wrt_mem():
         if args.verbose:
             print("Memory region ", mem_region, " Selected for files:", file_name_list)
 
+        budget = None
+        if "PROFILE" in flag_list:
+            budget = next((int(flag.split('=', 1)[1]) for flag in flag_list
+                           if flag.startswith("BUDGET=")), 0)
+            flag_list = [flag for flag in flag_list
+                         if flag != "PROFILE" and not flag.startswith("BUDGET=")]
+
         mem_region = "|".join((mem_region, *flag_list))
 
-        if mem_region in rel_dict:
+        if budget is not None:
+            profiles, total = profile_dict.get(mem_region, ([], 0))
+            profile_dict[mem_region] = (profiles + file_name_list, total + budget)
+        elif mem_region in rel_dict:
             rel_dict[mem_region].extend(file_name_list)
         else:
             rel_dict[mem_region] = file_name_list
 
-    return rel_dict, phdrs
+    return rel_dict, phdrs, profile_dict
 
 
 def main():
@@ -574,7 +685,7 @@ def main():
     linker_file = args.output
     sram_data_linker_file = args.output_sram_data
     sram_bss_linker_file = args.output_sram_bss
-    rel_dict, phdrs = create_dict_wrt_mem()
+    rel_dict, phdrs, profile_dict = create_dict_wrt_mem()
     complete_list_of_sections: 'dict[MemoryRegion, dict[SectionKind, list[OutputSection]]]' \
         = defaultdict(lambda: defaultdict(list))
 
@@ -602,6 +713,22 @@ def main():
             for (category, sections) in section_category_map.items():
                 complete_list_of_sections[region][category].extend(sections)
 
+    # Hot functions fill their budget with what is not relocated otherwise
+    if profile_dict:
+        function_sections = find_function_sections(searchpath)
+        placed = {(section.obj_file_name, section.section_name)
+                  for section_category_map in complete_list_of_sections.values()
+                  for sections in section_category_map.values()
+                  for section in sections}
+
+    for memory_type, (profiles, budget) in profile_dict.items():
+        kinds, _ = section_kinds_from_memory_region(memory_type)
+        hot_sections = find_hot_sections(profiles, budget, kinds, function_sections, placed)
+        sections_by_category = assign_to_correct_mem_region(memory_type, hot_sections)
+        for (region, section_category_map) in sections_by_category.items():
+            for (category, sections) in section_category_map.items():
+                complete_list_of_sections[region][category].extend(sections)
+
     generate_linker_script(linker_file, sram_data_linker_file,
                            sram_bss_linker_file, complete_list_of_sections, phdrs)
 
@@ -25,6 +25,37 @@ def convert_hex_file_to_bin(hexfile):
     return bin_data
 
 
+def extract_itm_port_data(itm_data, port):
+    """
+    This extracts the data written to one ITM stimulus port from
+    a raw ITM trace (e.g. captured from SWO without TPIU formatting)
+    """
+    bin_data = bytearray()
+    idx = 0
+
+    while idx < len(itm_data):
+        header = itm_data[idx]
+        idx += 1
+
+        if header & 0x03:
+            # Source packet with 1, 2 or 4 bytes of payload. Bit 2
+            # is set for hardware (DWT) packets.
+            size = (1, 2, 4)[(header & 0x03) - 1]
+            if not header & 0x04 and header >> 3 == port:
+                bin_data += itm_data[idx:idx + size]
+            idx += size
+        elif header & 0x7f and header != 0x70:
+            # Timestamp and extension packets, followed by
+            # continuation bytes as long as bit 7 is set.
+            cont = header & 0x80
+            while cont and idx < len(itm_data):
+                cont = itm_data[idx] & 0x80
+                idx += 1
+        # Otherwise this is a synchronization or overflow packet.
+
+    return bytes(bin_data)
+
+
 def extract_one_string_in_section(section, str_ptr):
     """Extract one string in an ELF section"""
     data = section['data']
@@ -36,6 +36,9 @@ def parse_args():
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
                            help="Log file only contains hexadecimal log data")
+    argparser.add_argument("--itm", type=int, metavar="PORT",
+                           help="Log Data file is a raw ITM trace (e.g. from SWO), "
+                                "log data is written to the given stimulus port")
     argparser.add_argument("--debug", action="store_true",
                            help="Print extra debugging information")
 
@@ -98,6 +101,9 @@ def read_log_file(args):
 
         logfile.close()
 
+        if args.itm is not None:
+            logdata = dictionary_parser.utils.extract_itm_port_data(logdata, args.itm)
+
     return logdata
 
 
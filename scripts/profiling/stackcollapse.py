@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to turn the output of the "profiler dump" shell command into folded
+stacks with function names, ready for flame graph tools.
+
+    uart:~$ profiler start 1000
+    uart:~$ profiler stop
+    uart:~$ profiler dump
+
+Save the dump to a file, then:
+
+    ./scripts/profiling/stackcollapse.py build/zephyr/zephyr.elf dump.txt \
+      | flamegraph.pl > profile.svg
+"""
+
+import argparse
+import bisect
+import re
+import sys
+from collections import Counter
+
+try:
+    from elftools.elf.elffile import ELFFile
+    from elftools.elf.sections import SymbolTableSection
+except ImportError:
+    sys.exit("Missing dependency: You need to install pyelftools.")
+
+LINE_RE = re.compile(r"^(\S+) (\d+)$")
+
+
+class Symbolizer:
+    """Map code addresses to function names"""
+
+    def __init__(self, elf_path):
+        funcs = []
+
+        with open(elf_path, "rb") as elf_file:
+            elf = ELFFile(elf_file)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] != "STT_FUNC" or sym["st_size"] == 0:
+                        continue
+                    # Thumb functions have bit 0 set
+                    start = sym["st_value"] & ~1
+                    funcs.append((start, start + sym["st_size"], sym.name))
+
+        funcs.sort()
+        self.starts = [f[0] for f in funcs]
+        self.funcs = funcs
+
+    def name(self, addr):
+        idx = bisect.bisect_right(self.starts, addr) - 1
+        if idx >= 0 and addr < self.funcs[idx][1]:
+            return self.funcs[idx][2]
+        return f"0x{addr:x}"
+
+
+def collapse(lines, symbolizer):
+    """Symbolize the frames and merge the stacks that become identical"""
+    stacks = Counter()
+
+    for line in lines:
+        match = LINE_RE.match(line.strip())
+        if not match:
+            continue
+
+        frames = []
+        for frame in match.group(1).split(";"):
+            if frame.startswith("0x"):
+                frame = symbolizer.name(int(frame, 16))
+            # The caller taken from the link register is often the
+            # function itself
+            if not frames or frames[-1] != frame:
+                frames.append(frame)
+
+        stacks[";".join(frames)] += int(match.group(2))
+
+    return stacks
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("elf", help="Zephyr ELF file")
+    parser.add_argument("dump", nargs="?", help="profiler dump, default is stdin")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    symbolizer = Symbolizer(args.elf)
+
+    if args.dump:
+        with open(args.dump, "r", encoding="utf-8", errors="replace") as dump:
+            stacks = collapse(dump, symbolizer)
+    else:
+        stacks = collapse(sys.stdin, symbolizer)
+
+    for stack, count in sorted(stacks.items()):
+        print(f"{stack} {count}")
+
+
+if __name__ == "__main__":
+    main()
@@ -46,6 +46,9 @@ def main():
     msg_it = bt2.TraceCollectionMessageIterator(args.trace)
     last_event_ns_from_origin = None
     timeline = []
+    # With per CPU tracing buffers, a cpu_stream event tells the CPU of
+    # the events that follow it
+    stream_cpu = None
 
     def get_thread(name):
         for t in timeline:
@@ -79,7 +82,7 @@ def main():
                 'thread_abort'
                 ]:
 
-            cpu = event.payload_field.get("cpu", None)
+            cpu = event.payload_field.get("cpu", stream_cpu)
             thread_id = event.payload_field.get("thread_id", None)
             thread_name = event.payload_field.get("name", None)
 
@@ -118,6 +121,9 @@ def main():
 
                     timeline.append(th)
 
+        elif event.name in ['cpu_stream']:
+            stream_cpu = event.payload_field['cpu_id']
+            continue
         elif event.name in ['thread_info']:
             stack_size = event.payload_field['stack_size']
             print(f"{dt} (+{diff_s:.6f} s): {event.name} (Stack size: {stack_size})")
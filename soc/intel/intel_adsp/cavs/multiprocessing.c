@@ -121,18 +121,24 @@ void soc_start_core(int cpu_num)
 	IDC[curr_cpu].core[cpu_num].itc = IDC_MSG_POWER_UP;
 }
 
-void arch_sched_ipi(void)
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
 {
 	uint32_t curr = arch_proc_id();
 	unsigned int num_cpus = arch_num_cpus();
 
 	for (int c = 0; c < num_cpus; c++) {
-		if (c != curr && soc_cpus_active[c]) {
+		if ((c != curr) && soc_cpus_active[c] &&
+		    ((cpu_bitmap & BIT(c)) != 0)) {
 			IDC[curr].core[c].itc = BIT(31);
 		}
 	}
 }
 
+void arch_sched_ipi(void)
+{
+	arch_sched_directed_ipi(IPI_ALL_CPUS_MASK);
+}
+
 void idc_isr(const void *param)
 {
 	ARG_UNUSED(param);
@@ -340,6 +340,44 @@ int bt_bap_stream_send_ts(struct bt_bap_stream *stream, struct net_buf *buf, uin
 	return bap_stream_send(stream, buf, seq_num, ts, true);
 }
 
+static int bap_stream_send_batch(const struct bt_bap_stream_sdu *sdus, size_t count, uint32_t ts,
+				 bool has_ts)
+{
+	size_t i;
+	int ret = 0;
+
+	CHECKIF(sdus == NULL || count == 0U) {
+		LOG_DBG("Invalid parameters: sdus %p count %zu", sdus, count);
+
+		return -EINVAL;
+	}
+
+	/* The TX thread only runs once all the SDUs are queued */
+	k_sched_lock();
+
+	for (i = 0U; i < count; i++) {
+		ret = bap_stream_send(sdus[i].stream, sdus[i].buf, sdus[i].seq_num, ts, has_ts);
+		if (ret < 0) {
+			LOG_DBG("Unable to send SDU %zu of %zu: %d", i, count, ret);
+			break;
+		}
+	}
+
+	k_sched_unlock();
+
+	return (i > 0U) ? (int)i : ret;
+}
+
+int bt_bap_stream_send_batch(const struct bt_bap_stream_sdu *sdus, size_t count)
+{
+	return bap_stream_send_batch(sdus, count, 0, false);
+}
+
+int bt_bap_stream_send_batch_ts(const struct bt_bap_stream_sdu *sdus, size_t count, uint32_t ts)
+{
+	return bap_stream_send_batch(sdus, count, ts, true);
+}
+
 int bt_bap_stream_get_tx_sync(struct bt_bap_stream *stream, struct bt_iso_tx_info *info)
 {
 	struct bt_iso_chan *iso_chan;
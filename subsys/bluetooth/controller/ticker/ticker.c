@@ -277,6 +277,19 @@ struct ticker_user {
 	struct ticker_user_op *user_op; /* Pointer to user operation array */
 };
 
+#if defined(CONFIG_BT_TICKER_LOOKAHEAD)
+#define TICKER_LOOKAHEAD_MAX 4
+
+/* Ticker node inserted by ticker_job_list_insert
+ */
+struct ticker_lookahead {
+	uint8_t  id;			/* Ticker node id */
+	uint32_t ticks_to_expire;	/* Ticks from ticks_current until
+					 * the node expires
+					 */
+};
+#endif /* CONFIG_BT_TICKER_LOOKAHEAD */
+
 /* Ticker instance
  */
 struct ticker_instance {
@@ -323,6 +336,12 @@ struct ticker_instance {
 	bool expire_infos_outdated;
 #endif /* CONFIG_BT_TICKER_EXT_EXPIRE_INFO */
 
+#if defined(CONFIG_BT_TICKER_LOOKAHEAD)
+	struct ticker_lookahead lookahead[TICKER_LOOKAHEAD_MAX];
+	uint8_t  lookahead_count;	/* Number of valid lookahead entries */
+	uint8_t  lookahead_last;	/* Index of last lookahead entry set */
+#endif /* CONFIG_BT_TICKER_LOOKAHEAD */
+
 	ticker_caller_id_get_cb_t caller_id_get_cb; /* Function for retrieving
 						     * the caller id from user
 						     * id
@@ -541,6 +560,74 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
 }
 #endif /* CONFIG_BT_TICKER_NEXT_SLOT_GET */
 
+#if defined(CONFIG_BT_TICKER_LOOKAHEAD)
+/**
+ * @brief Skip ahead to a known insertion point
+ *
+ * @details Moves the search for the insertion point of a node expiring in
+ * ticks_to_expire to after the furthest node inserted by the current
+ * ticker_job_list_insert that expires strictly before. The nodes skipped
+ * all expire before too, so the search ends at the same insertion point.
+ *
+ * @param instance        Pointer to ticker instance
+ * @param ticks_to_expire Ticks until expiration, made relative to the node
+ *                        skipped to
+ * @param previous        Set to the node skipped to
+ * @param current         Set to the node following the node skipped to
+ * @internal
+ */
+static void ticker_lookahead_skip(struct ticker_instance *instance,
+				  uint32_t *ticks_to_expire,
+				  uint8_t *previous, uint8_t *current)
+{
+	struct ticker_lookahead *best;
+
+	best = NULL;
+	for (uint8_t i = 0U; i < instance->lookahead_count; i++) {
+		struct ticker_lookahead *lookahead = &instance->lookahead[i];
+
+		if ((lookahead->ticks_to_expire < *ticks_to_expire) &&
+		    ((best == NULL) ||
+		     (lookahead->ticks_to_expire > best->ticks_to_expire))) {
+			best = lookahead;
+		}
+	}
+
+	if (best != NULL) {
+		*ticks_to_expire -= best->ticks_to_expire;
+		*previous = best->id;
+		*current = instance->nodes[best->id].next;
+	}
+}
+
+/**
+ * @brief Remember an inserted node
+ *
+ * @param instance        Pointer to ticker instance
+ * @param id              Ticker node id inserted
+ * @param ticks_to_expire Ticks from ticks_current until the node expires
+ * @internal
+ */
+static void ticker_lookahead_set(struct ticker_instance *instance, uint8_t id,
+				 uint32_t ticks_to_expire)
+{
+	struct ticker_lookahead *lookahead;
+
+	if (instance->lookahead_count < TICKER_LOOKAHEAD_MAX) {
+		instance->lookahead_last = instance->lookahead_count++;
+	} else {
+		instance->lookahead_last++;
+		if (instance->lookahead_last == TICKER_LOOKAHEAD_MAX) {
+			instance->lookahead_last = 0U;
+		}
+	}
+
+	lookahead = &instance->lookahead[instance->lookahead_last];
+	lookahead->id = id;
+	lookahead->ticks_to_expire = ticks_to_expire;
+}
+#endif /* CONFIG_BT_TICKER_LOOKAHEAD */
+
 #if !defined(CONFIG_BT_TICKER_LOW_LAT)
 /**
  * @brief Enqueue ticker node
@@ -561,6 +648,9 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	uint32_t ticks_to_expire_current;
 	struct ticker_node *node;
 	uint32_t ticks_to_expire;
+#if defined(CONFIG_BT_TICKER_LOOKAHEAD)
+	uint32_t ticks_to_expire_new;
+#endif /* CONFIG_BT_TICKER_LOOKAHEAD */
 	uint8_t previous;
 	uint8_t current;
 
@@ -574,6 +664,11 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	 */
 	previous = TICKER_NULL;
 
+#if defined(CONFIG_BT_TICKER_LOOKAHEAD)
+	ticks_to_expire_new = ticks_to_expire;
+	ticker_lookahead_skip(instance, &ticks_to_expire, &previous, &current);
+#endif /* CONFIG_BT_TICKER_LOOKAHEAD */
+
 	while ((current != TICKER_NULL) && (ticks_to_expire >=
 		(ticks_to_expire_current =
 		(ticker_current = &node[current])->ticks_to_expire))) {
@@ -608,6 +703,10 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 		node[current].ticks_to_expire -= ticks_to_expire;
 	}
 
+#if defined(CONFIG_BT_TICKER_LOOKAHEAD)
+	ticker_lookahead_set(instance, id, ticks_to_expire_new);
+#endif /* CONFIG_BT_TICKER_LOOKAHEAD */
+
 	return id;
 }
 #else /* CONFIG_BT_TICKER_LOW_LAT */
@@ -2740,6 +2839,11 @@ static inline void ticker_job_list_insert(struct ticker_instance *instance,
 	users = &instance->users[0];
 	count_user = instance->count_user;
 
+#if defined(CONFIG_BT_TICKER_LOOKAHEAD)
+	/* Only the nodes inserted from here on have a known position */
+	instance->lookahead_count = 0U;
+#endif /* CONFIG_BT_TICKER_LOOKAHEAD */
+
 	/* Iterate through all user ids */
 	while (count_user--) {
 		struct ticker_user_op *user_ops;
@@ -2834,6 +2938,10 @@ static inline void ticker_job_list_insert(struct ticker_instance *instance,
 	*/
 
 	}
+
+#if defined(CONFIG_BT_TICKER_LOOKAHEAD)
+	instance->lookahead_count = 0U;
+#endif /* CONFIG_BT_TICKER_LOOKAHEAD */
 }
 
 #if defined(CONFIG_BT_TICKER_JOB_IDLE_GET) || \
@@ -114,6 +114,31 @@ NET_BUF_POOL_FIXED_DEFINE(frag_pool, CONFIG_BT_L2CAP_TX_FRAG_COUNT,
 
 #endif /* CONFIG_BT_L2CAP_TX_FRAG_COUNT > 0 */
 
+#if defined(CONFIG_BT_CONN_TX_ZERO_COPY)
+static void frag_view_destroy(struct net_buf *view);
+
+/* Memory in front of the data of a fragment view for its headers */
+#define FRAG_VIEW_HEAD (BT_BUF_RESERVE + MAX(sizeof(struct bt_hci_acl_hdr), \
+					     sizeof(struct bt_hci_iso_hdr)))
+
+/* Fragments that point into the data of the buffer they are part of. The own
+ * memory of a view keeps the bytes of that buffer its headers are written
+ * over, they are written back when the view is destroyed.
+ */
+NET_BUF_POOL_FIXED_DEFINE(frag_view_pool, CONFIG_BT_CONN_TX_FRAG_VIEW_COUNT,
+			  FRAG_VIEW_HEAD, CONFIG_BT_CONN_TX_USER_DATA_SIZE,
+			  frag_view_destroy);
+
+static struct frag_view {
+	struct bt_conn *conn;
+	struct net_buf *parent;
+	/* Bytes of the parent under the headers, and end of the view's data */
+	uint8_t *backup;
+	uint8_t *end;
+	uint8_t head;
+} frag_views[CONFIG_BT_CONN_TX_FRAG_VIEW_COUNT];
+#endif /* CONFIG_BT_CONN_TX_ZERO_COPY */
+
 #if defined(CONFIG_BT_SMP) || defined(CONFIG_BT_CLASSIC)
 const struct bt_conn_auth_cb *bt_auth;
 sys_slist_t bt_auth_info_cbs = SYS_SLIST_STATIC_INIT(&bt_auth_info_cbs);
@@ -703,6 +728,12 @@ static int send_frag(struct bt_conn *conn,
 	}
 
 	/* Add the data to the buffer */
+#if defined(CONFIG_BT_CONN_TX_ZERO_COPY)
+	if (frag && net_buf_pool_get(frag->pool_id) == &frag_view_pool) {
+		/* A view already has its data */
+		net_buf_pull(buf, frag->len);
+	} else
+#endif /* CONFIG_BT_CONN_TX_ZERO_COPY */
 	if (frag) {
 		uint16_t frag_len = MIN(conn_mtu(conn), net_buf_tailroom(frag));
 
@@ -753,6 +784,136 @@ static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 	return frag;
 }
 
+#if defined(CONFIG_BT_CONN_TX_ZERO_COPY)
+static struct k_poll_signal conn_change;
+
+static size_t frag_view_head(struct bt_conn *conn)
+{
+	return BT_BUF_RESERVE + (conn->type == BT_CONN_TYPE_ISO ?
+				 sizeof(struct bt_hci_iso_hdr) :
+				 sizeof(struct bt_hci_acl_hdr));
+}
+
+static void frag_view_destroy(struct net_buf *view)
+{
+	struct frag_view *fv = &frag_views[net_buf_id(view)];
+	struct net_buf *parent;
+	unsigned int key;
+	bool waiting;
+
+	key = irq_lock();
+
+	/* Give the parent its bytes back before anything else goes there */
+	memcpy(view->__buf, fv->backup, fv->head);
+
+	/* The connection objects are static, it is still there */
+	waiting = atomic_test_and_clear_bit(fv->conn->flags, BT_CONN_TX_FRAG_VIEW);
+	parent = fv->parent;
+	fv->conn = NULL;
+	fv->parent = NULL;
+
+	irq_unlock(key);
+
+	net_buf_destroy(view);
+	net_buf_unref(parent);
+
+	if (waiting) {
+		/* The last fragment can go */
+		k_poll_signal_raise(&conn_change, 0);
+	}
+}
+
+/* Whether the headers of the next fragment of buf would go over the data of a
+ * view the HCI driver still has. Needs the IRQ lock.
+ */
+static bool frag_view_busy(struct bt_conn *conn, struct net_buf *buf)
+{
+	const uint8_t *head = buf->data - frag_view_head(conn);
+
+	for (size_t i = 0; i < ARRAY_SIZE(frag_views); i++) {
+		if (frag_views[i].parent == buf && frag_views[i].end > head) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Fragment, for the HCI driver, of the first conn_mtu() bytes of buf, which
+ * shares their memory, and the memory in front of them for the headers.
+ */
+static struct net_buf *create_frag_view(struct bt_conn *conn, struct net_buf *buf)
+{
+	const size_t head = frag_view_head(conn);
+	struct frag_view *fv;
+	struct net_buf *view;
+	unsigned int key;
+	bool busy;
+
+	if ((!IS_ENABLED(CONFIG_BT_ISO_TX) && conn->type == BT_CONN_TYPE_ISO) ||
+	    net_buf_headroom(buf) < head) {
+		return NULL;
+	}
+
+	/* The previous fragment is a view the driver still reads, the
+	 * fragment is copied instead of waiting for it.
+	 */
+	key = irq_lock();
+	busy = frag_view_busy(conn, buf);
+	irq_unlock(key);
+
+	if (busy) {
+		return NULL;
+	}
+
+	view = net_buf_alloc(&frag_view_pool, K_NO_WAIT);
+	if (!view) {
+		return NULL;
+	}
+
+	fv = &frag_views[net_buf_id(view)];
+	fv->backup = view->__buf;
+	fv->head = head;
+	memcpy(fv->backup, buf->data - head, head);
+
+	net_buf_simple_init_with_data(&view->b, buf->data - head,
+				      head + conn_mtu(conn));
+	view->flags = NET_BUF_EXTERNAL_DATA;
+	net_buf_pull(view, head);
+
+	tx_data(view)->tx = NULL;
+	tx_data(view)->is_cont = false;
+	tx_data(view)->iso_has_ts = tx_data(buf)->iso_has_ts;
+
+	key = irq_lock();
+	fv->conn = conn;
+	fv->end = buf->data + conn_mtu(conn);
+	fv->parent = net_buf_ref(buf);
+	irq_unlock(key);
+
+	return view;
+}
+
+/* Whether the last fragment of buf has to wait for the HCI driver to be done
+ * with the view in front of it. The destruction of the view then raises
+ * conn_change.
+ */
+static bool frag_view_wait(struct bt_conn *conn, struct net_buf *buf)
+{
+	unsigned int key;
+	bool busy;
+
+	key = irq_lock();
+	busy = frag_view_busy(conn, buf);
+	if (busy) {
+		atomic_set_bit(conn->flags, BT_CONN_TX_FRAG_VIEW);
+	}
+	irq_unlock(key);
+
+	return busy;
+}
+#endif /* CONFIG_BT_CONN_TX_ZERO_COPY */
+
 /* Tentatively send a buffer to the HCI driver.
  *
  * This is designed to be async, as in most failures due to lack of resources
@@ -795,7 +956,14 @@ static int send_buf(struct bt_conn *conn, struct net_buf *buf)
 	}
 
 	while (buf->len > conn_mtu(conn)) {
+#if defined(CONFIG_BT_CONN_TX_ZERO_COPY)
+		frag = create_frag_view(conn, buf);
+		if (!frag) {
+			frag = create_frag(conn, buf);
+		}
+#else
 		frag = create_frag(conn, buf);
+#endif /* CONFIG_BT_CONN_TX_ZERO_COPY */
 		if (!frag) {
 			return -ENOMEM;
 		}
@@ -813,6 +981,14 @@ static int send_buf(struct bt_conn *conn, struct net_buf *buf)
 
 	LOG_DBG("last frag");
 	tx_data(buf)->is_cont = true;
+
+#if defined(CONFIG_BT_CONN_TX_ZERO_COPY)
+	/* Its headers go over the end of the previous fragment */
+	if (frag_view_wait(conn, buf)) {
+		return -EAGAIN;
+	}
+#endif /* CONFIG_BT_CONN_TX_ZERO_COPY */
+
 	return send_frag(conn, buf, NULL, FRAG_END);
 }
 
@@ -878,6 +1054,13 @@ static int conn_prepare_events(struct bt_conn *conn,
 		return -ENOTCONN;
 	}
 
+	if (IS_ENABLED(CONFIG_BT_CONN_TX_ZERO_COPY) &&
+	    atomic_test_bit(conn->flags, BT_CONN_TX_FRAG_VIEW)) {
+		/* The destruction of the fragment view raises conn_change */
+		LOG_DBG("last frag waits on fragment view");
+		return -EAGAIN;
+	}
+
 	LOG_DBG("Adding conn %p to poll list", conn);
 
 	/* ISO Synchronized Receiver only builds do not transmit and hence
@@ -927,8 +1110,19 @@ int bt_conn_prepare_events(struct k_poll_event events[])
 			  K_POLL_MODE_NOTIFY_ONLY, &conn_change);
 
 #if defined(CONFIG_BT_CONN)
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	/* The connections are processed in the order of the events, start each
+	 * round with the next one so that none always gets the free buffers.
+	 */
+	static uint8_t first;
+
+	first = (first + 1) % ARRAY_SIZE(acl_conns);
+#else
+	const uint8_t first = 0;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	for (i = 0; i < ARRAY_SIZE(acl_conns); i++) {
-		conn = &acl_conns[i];
+		conn = &acl_conns[(first + i) % ARRAY_SIZE(acl_conns)];
 
 		if (!conn_prepare_events(conn, &events[ev_count])) {
 			ev_count++;
@@ -949,6 +1143,63 @@ int bt_conn_prepare_events(struct k_poll_event events[])
 	return ev_count;
 }
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+/* Size the PDU in buf counts for in the deficit of its connection */
+static int32_t tx_sched_cost(const struct net_buf *buf)
+{
+	const struct bt_l2cap_hdr *hdr = (const void *)buf->data;
+	uint16_t weight = 1;
+
+	if (buf->len >= sizeof(*hdr)) {
+		switch (sys_le16_to_cpu(hdr->cid)) {
+		case BT_L2CAP_CID_ATT:
+			weight = CONFIG_BT_CONN_TX_SCHED_WEIGHT_ATT;
+			break;
+		case BT_L2CAP_CID_LE_SIG:
+		case BT_L2CAP_CID_SMP:
+			weight = CONFIG_BT_CONN_TX_SCHED_WEIGHT_SMP;
+			break;
+		default:
+			break;
+		}
+	}
+
+	return DIV_ROUND_UP(buf->len, weight);
+}
+
+/*
+ * Deficit round robin: each round gives a connection its quantum, and
+ * the connection sends a PDU once its deficit covers it. A PDU is charged
+ * when its first fragment is sent.
+ */
+static bool tx_sched_allow(struct bt_conn *conn, const struct net_buf *buf)
+{
+	if (conn->type == BT_CONN_TYPE_ISO || tx_data(buf)->is_cont) {
+		return true;
+	}
+
+	if (conn->tx_deficit < tx_sched_cost(buf)) {
+		conn->tx_deficit += CONFIG_BT_CONN_TX_SCHED_QUANTUM;
+	}
+
+	return conn->tx_deficit >= tx_sched_cost(buf);
+}
+
+static void tx_sched_charge(struct bt_conn *conn, int32_t cost)
+{
+	if (conn->type == BT_CONN_TYPE_ISO) {
+		return;
+	}
+
+	conn->tx_deficit -= cost;
+
+	/* A connection does not save up while it has nothing to send */
+	if (k_fifo_is_empty(&conn->tx_queue)) {
+		conn->tx_deficit = 0;
+	}
+}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 void bt_conn_process_tx(struct bt_conn *conn)
 {
 	struct net_buf *buf;
@@ -972,11 +1223,28 @@ void bt_conn_process_tx(struct bt_conn *conn)
 	buf = k_fifo_peek_head(&conn->tx_queue);
 	BT_ASSERT(buf);
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	bool first_frag = !tx_data(buf)->is_cont;
+	int32_t cost = tx_sched_cost(buf);
+
+	if (!tx_sched_allow(conn, buf)) {
+		LOG_DBG("conn %p waits for the next round", conn);
+		return;
+	}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	/* Since we used `peek`, the queue still owns the reference to the
 	 * buffer, so we need to take an explicit additional reference here.
 	 */
 	buf = net_buf_ref(buf);
 	err = send_buf(conn, buf);
+
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	if (first_frag && (!err || tx_data(buf)->is_cont)) {
+		tx_sched_charge(conn, cost);
+	}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	net_buf_unref(buf);
 
 	/* HCI driver error. `buf` may have been popped from `tx_queue` and
@@ -1111,6 +1379,9 @@ void bt_conn_set_state(struct bt_conn *conn, bt_conn_state_t state)
 			break;
 		}
 		k_fifo_init(&conn->tx_queue);
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+		conn->tx_deficit = 0;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
 		k_poll_signal_raise(&conn_change, 0);
 
 		if (IS_ENABLED(CONFIG_BT_ISO) &&
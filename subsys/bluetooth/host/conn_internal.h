@@ -37,6 +37,7 @@ enum {
 	BT_CONN_PERIPHERAL_PARAM_SET,         /* If periph param were set from app */
 	BT_CONN_PERIPHERAL_PARAM_L2CAP,       /* If should force L2CAP for CPUP */
 	BT_CONN_FORCE_PAIR,                   /* Pairing even with existing keys. */
+	BT_CONN_TX_FRAG_VIEW,                 /* Last fragment waits on a view */
 #if defined(CONFIG_BT_GATT_CLIENT)
 	BT_CONN_ATT_MTU_EXCHANGED,            /* If ATT MTU has been exchanged. */
 #endif /* CONFIG_BT_GATT_CLIENT */
@@ -210,6 +211,10 @@ struct bt_conn {
 
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	/* Bytes the connection can send in the current scheduling round */
+	int32_t			tx_deficit;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
 
 	/* Active L2CAP channels */
 	sys_slist_t		channels;
@@ -52,10 +52,24 @@
 LOG_MODULE_REGISTER(bt_gatt);
 
 #define SC_TIMEOUT	K_MSEC(10)
-#define DB_HASH_TIMEOUT	K_MSEC(10)
+#if defined(CONFIG_BT_GATT_CACHING)
+#define DB_HASH_TIMEOUT	K_MSEC(CONFIG_BT_GATT_CACHING_HASH_DELAY)
+#endif
 
 static uint16_t last_static_handle;
 
+#if defined(CONFIG_BT_GATT_HANDLE_TABLE)
+/* Attributes indexed by handle - 1, NULL for the handles not in use */
+static const struct bt_gatt_attr *handle_table[CONFIG_BT_GATT_HANDLE_TABLE_SIZE];
+
+static void handle_table_set(uint16_t handle, const struct bt_gatt_attr *attr)
+{
+	if (handle > 0 && handle <= ARRAY_SIZE(handle_table)) {
+		handle_table[handle - 1] = attr;
+	}
+}
+#endif /* CONFIG_BT_GATT_HANDLE_TABLE */
+
 /* Persistent storage format for GATT CCC */
 struct ccc_store {
 	uint16_t handle;
@@ -307,6 +321,15 @@ static struct gatt_sc {
 #endif /* defined(CONFIG_BT_GATT_SERVICE_CHANGED) */
 
 #if defined(CONFIG_BT_GATT_CACHING)
+#if defined(CONFIG_BT_GATT_CACHING_INCREMENTAL)
+/* State of the hash computation after the attributes up to a handle */
+struct db_hash_checkpoint {
+	struct tc_cmac_struct state;
+	uint16_t handle;
+	bool valid;
+};
+#endif /* CONFIG_BT_GATT_CACHING_INCREMENTAL */
+
 static struct db_hash {
 	uint8_t hash[16];
 #if defined(CONFIG_BT_SETTINGS)
@@ -314,6 +337,12 @@ static struct db_hash {
 #endif
 	struct k_work_delayable work;
 	struct k_work_sync sync;
+#if defined(CONFIG_BT_GATT_CACHING_INCREMENTAL)
+	struct tc_aes_key_sched_struct sched;
+	/* After the static services, and after the whole database */
+	struct db_hash_checkpoint statics;
+	struct db_hash_checkpoint last;
+#endif /* CONFIG_BT_GATT_CACHING_INCREMENTAL */
 } db_hash;
 #endif
 
@@ -696,6 +725,10 @@ static ssize_t cf_write(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 struct gen_hash_state {
 	struct tc_cmac_struct state;
 	int err;
+#if defined(CONFIG_BT_GATT_CACHING_INCREMENTAL)
+	/* Last handle the computation went through */
+	uint16_t handle;
+#endif
 };
 
 union hash_attr_value {
@@ -733,6 +766,15 @@ union hash_attr_value {
 	} __packed cep;
 } __packed;
 
+static int gen_hash_update(struct gen_hash_state *state, const uint8_t *data, size_t len)
+{
+	if (tc_cmac_update(&state->state, data, len) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 static uint8_t gen_hash_m(const struct bt_gatt_attr *attr, uint16_t handle,
 			  void *user_data)
 {
@@ -742,6 +784,10 @@ static uint8_t gen_hash_m(const struct bt_gatt_attr *attr, uint16_t handle,
 	ssize_t len;
 	uint16_t value;
 
+#if defined(CONFIG_BT_GATT_CACHING_INCREMENTAL)
+	state->handle = handle;
+#endif
+
 	if (attr->uuid->type != BT_UUID_TYPE_16)
 		return BT_GATT_ITER_CONTINUE;
 
@@ -755,15 +801,13 @@ static uint8_t gen_hash_m(const struct bt_gatt_attr *attr, uint16_t handle,
 	case BT_UUID_GATT_CHRC_VAL:
 	case BT_UUID_GATT_CEP_VAL:
 		value = sys_cpu_to_le16(handle);
-		if (tc_cmac_update(&state->state, (uint8_t *)&value,
-				   sizeof(handle)) == TC_CRYPTO_FAIL) {
+		if (gen_hash_update(state, (uint8_t *)&value, sizeof(handle))) {
 			state->err = -EINVAL;
 			return BT_GATT_ITER_STOP;
 		}
 
 		value = sys_cpu_to_le16(u16->val);
-		if (tc_cmac_update(&state->state, (uint8_t *)&value,
-				   sizeof(u16->val)) == TC_CRYPTO_FAIL) {
+		if (gen_hash_update(state, (uint8_t *)&value, sizeof(u16->val))) {
 			state->err = -EINVAL;
 			return BT_GATT_ITER_STOP;
 		}
@@ -774,8 +818,7 @@ static uint8_t gen_hash_m(const struct bt_gatt_attr *attr, uint16_t handle,
 			return BT_GATT_ITER_STOP;
 		}
 
-		if (tc_cmac_update(&state->state, data, len) ==
-		    TC_CRYPTO_FAIL) {
+		if (gen_hash_update(state, data, len)) {
 			state->err = -EINVAL;
 			return BT_GATT_ITER_STOP;
 		}
@@ -788,15 +831,13 @@ static uint8_t gen_hash_m(const struct bt_gatt_attr *attr, uint16_t handle,
 	case BT_UUID_GATT_CPF_VAL:
 	case BT_UUID_GATT_CAF_VAL:
 		value = sys_cpu_to_le16(handle);
-		if (tc_cmac_update(&state->state, (uint8_t *)&value,
-				   sizeof(handle)) == TC_CRYPTO_FAIL) {
+		if (gen_hash_update(state, (uint8_t *)&value, sizeof(handle))) {
 			state->err = -EINVAL;
 			return BT_GATT_ITER_STOP;
 		}
 
 		value = sys_cpu_to_le16(u16->val);
-		if (tc_cmac_update(&state->state, (uint8_t *)&value,
-				   sizeof(u16->val)) == TC_CRYPTO_FAIL) {
+		if (gen_hash_update(state, (uint8_t *)&value, sizeof(u16->val))) {
 			state->err = -EINVAL;
 			return BT_GATT_ITER_STOP;
 		}
@@ -822,11 +863,95 @@ static void db_hash_store(void)
 #endif	/* CONFIG_BT_SETTINGS */
 }
 
+#if defined(CONFIG_BT_GATT_CACHING_INCREMENTAL)
+static void db_hash_checkpoint_save(struct db_hash_checkpoint *cp,
+				    const struct gen_hash_state *state, uint16_t handle)
+{
+	cp->state = state->state;
+	cp->handle = handle;
+	cp->valid = true;
+}
+
+/*
+ * Drop the computation states that went through a handle from start_handle
+ * on, the attributes there have changed.
+ */
+static void db_hash_checkpoint_drop(uint16_t start_handle)
+{
+	if (start_handle <= db_hash.last.handle) {
+		db_hash.last.valid = false;
+	}
+
+	if (start_handle <= db_hash.statics.handle) {
+		db_hash.statics.valid = false;
+	}
+}
+
+/*
+ * Resume the CMAC from the state after the attributes that have not changed,
+ * and save the states after the static services and after the whole database
+ * for the next computation.
+ */
+static int db_hash_gen_state(struct gen_hash_state *state)
+{
+	static const uint8_t key[16];
+	uint16_t start_handle;
+
+	if (db_hash.last.valid) {
+		state->state = db_hash.last.state;
+		start_handle = db_hash.last.handle + 1;
+	} else if (db_hash.statics.valid) {
+		state->state = db_hash.statics.state;
+		start_handle = db_hash.statics.handle + 1;
+	} else {
+		if (tc_cmac_setup(&state->state, key, &db_hash.sched) == TC_CRYPTO_FAIL) {
+			LOG_ERR("Unable to setup AES CMAC");
+			return -EINVAL;
+		}
+		start_handle = 0x0001;
+	}
+
+	LOG_DBG("Hashing from handle 0x%04x", start_handle);
+
+	state->handle = start_handle - 1;
+
+	if (start_handle <= last_static_handle) {
+		bt_gatt_foreach_attr(start_handle, last_static_handle, gen_hash_m, state);
+		if (state->err) {
+			return state->err;
+		}
+
+		db_hash_checkpoint_save(&db_hash.statics, state, last_static_handle);
+		start_handle = last_static_handle + 1;
+	}
+
+	if (start_handle != 0x0000) {
+		bt_gatt_foreach_attr(start_handle, 0xffff, gen_hash_m, state);
+		if (state->err) {
+			return state->err;
+		}
+	}
+
+	db_hash_checkpoint_save(&db_hash.last, state, state->handle);
+
+	return 0;
+}
+#endif /* CONFIG_BT_GATT_CACHING_INCREMENTAL */
+
 static void db_hash_gen(void)
 {
+	struct gen_hash_state state = {};
+
+#if defined(CONFIG_BT_GATT_CACHING_INCREMENTAL)
+	if (db_hash_gen_state(&state)) {
+		LOG_ERR("Unable to hash database (err %d)", state.err);
+		db_hash.statics.valid = false;
+		db_hash.last.valid = false;
+		return;
+	}
+#else
 	uint8_t key[16] = {};
 	struct tc_aes_key_sched_struct sched;
-	struct gen_hash_state state;
 
 	if (tc_cmac_setup(&state.state, key, &sched) == TC_CRYPTO_FAIL) {
 		LOG_ERR("Unable to setup AES CMAC");
@@ -834,6 +959,7 @@ static void db_hash_gen(void)
 	}
 
 	bt_gatt_foreach_attr(0x0001, 0xffff, gen_hash_m, &state);
+#endif /* CONFIG_BT_GATT_CACHING_INCREMENTAL */
 
 	if (tc_cmac_final(db_hash.hash, &state.state) == TC_CRYPTO_FAIL) {
 		LOG_ERR("Unable to calculate hash");
@@ -1231,6 +1357,12 @@ populate:
 
 	gatt_insert(svc, last_handle);
 
+#if defined(CONFIG_BT_GATT_HANDLE_TABLE)
+	for (uint16_t i = 0; i < svc->attr_count; i++) {
+		handle_table_set(svc->attrs[i].handle, &svc->attrs[i]);
+	}
+#endif /* CONFIG_BT_GATT_HANDLE_TABLE */
+
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
@@ -1450,6 +1582,11 @@ static void bt_gatt_service_init(void)
 	}
 
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
+#if defined(CONFIG_BT_GATT_HANDLE_TABLE)
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			handle_table_set(last_static_handle + 1 + i, &svc->attrs[i]);
+		}
+#endif /* CONFIG_BT_GATT_HANDLE_TABLE */
 		last_static_handle += svc->attr_count;
 	}
 }
@@ -1546,7 +1683,7 @@ void bt_gatt_cb_register(struct bt_gatt_cb *cb)
 }
 
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
-static void db_changed(void)
+static void db_changed(uint16_t start_handle)
 {
 #if defined(CONFIG_BT_GATT_CACHING)
 	struct bt_conn *conn;
@@ -1554,6 +1691,10 @@ static void db_changed(void)
 
 	atomic_clear_bit(gatt_sc.flags, DB_HASH_VALID);
 
+#if defined(CONFIG_BT_GATT_CACHING_INCREMENTAL)
+	db_hash_checkpoint_drop(start_handle);
+#endif
+
 	if (IS_ENABLED(CONFIG_BT_LONG_WQ)) {
 		bt_long_wq_reschedule(&db_hash.work, DB_HASH_TIMEOUT);
 	} else {
@@ -1633,6 +1774,10 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		if (attr->write == bt_gatt_attr_write_ccc) {
 			gatt_unregister_ccc(attr->user_data);
 		}
+
+#if defined(CONFIG_BT_GATT_HANDLE_TABLE)
+		handle_table_set(attr->handle, NULL);
+#endif /* CONFIG_BT_GATT_HANDLE_TABLE */
 	}
 
 	return 0;
@@ -1679,7 +1824,7 @@ int bt_gatt_service_register(struct bt_gatt_service *svc)
 	sc_indicate(svc->attrs[0].handle,
 		    svc->attrs[svc->attr_count - 1].handle);
 
-	db_changed();
+	db_changed(svc->attrs[0].handle);
 
 	k_sched_unlock();
 
@@ -1709,7 +1854,7 @@ int bt_gatt_service_unregister(struct bt_gatt_service *svc)
 	sc_indicate(svc->attrs[0].handle,
 		    svc->attrs[svc->attr_count - 1].handle);
 
-	db_changed();
+	db_changed(svc->attrs[0].handle);
 
 	k_sched_unlock();
 
@@ -1998,6 +2143,27 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_HANDLE_TABLE)
+	/* Go straight to the start of the range for the handles in the table */
+	for (uint32_t handle = MAX(start_handle, 1U);
+	     handle <= MIN(end_handle, ARRAY_SIZE(handle_table)); handle++) {
+		const struct bt_gatt_attr *attr = handle_table[handle - 1];
+
+		if (attr && gatt_foreach_iter(attr, handle, start_handle, end_handle, uuid,
+					      attr_data, &num_matches, func,
+					      user_data) == BT_GATT_ITER_STOP) {
+			return;
+		}
+	}
+
+	if (end_handle <= ARRAY_SIZE(handle_table)) {
+		return;
+	}
+
+	/* The services go on past the table */
+	start_handle = MAX(start_handle, ARRAY_SIZE(handle_table) + 1);
+#endif /* CONFIG_BT_GATT_HANDLE_TABLE */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -4617,6 +4783,270 @@ int bt_gatt_discover(struct bt_conn *conn,
 	return -EINVAL;
 }
 
+#if defined(CONFIG_BT_GATT_DISCOVER_PIPELINE)
+/* Every request in flight may need a range to continue or end its discovery */
+BUILD_ASSERT(CONFIG_BT_GATT_DISCOVER_PIPELINE_RANGES > CONFIG_BT_GATT_DISCOVER_PIPELINE_DEPTH,
+	     "Not enough ranges for the discovery requests");
+
+static uint8_t discover_all_busy(const struct bt_gatt_discover_all_params *all)
+{
+	uint8_t busy = 0U;
+
+	for (size_t i = 0; i < ARRAY_SIZE(all->_reqs); i++) {
+		busy += all->_reqs[i].busy ? 1U : 0U;
+	}
+
+	return busy;
+}
+
+/*
+ * Ranges found are pushed on top of the stack, so that the characteristics
+ * and descriptors of a service are discovered before the services that
+ * follow. A range left to continue a discovery can always be pushed: it goes
+ * to the bottom of the stack and is only taken again once the ranges found
+ * are done.
+ */
+static bool discover_all_push(struct bt_gatt_discover_all_params *all, uint8_t type,
+			      uint16_t start_handle, uint16_t end_handle,
+			      uint16_t svc_end, uint16_t desc_start, bool cont)
+{
+	size_t free = ARRAY_SIZE(all->_ranges) - all->_range_count;
+	struct bt_gatt_discover_all_range *range;
+
+	if (!cont && free <= discover_all_busy(all)) {
+		return false;
+	}
+
+	__ASSERT_NO_MSG(free > 0);
+
+	if (cont) {
+		memmove(&all->_ranges[1], &all->_ranges[0],
+			all->_range_count * sizeof(all->_ranges[0]));
+		range = &all->_ranges[0];
+	} else {
+		range = &all->_ranges[all->_range_count];
+	}
+	all->_range_count++;
+
+	range->type = type;
+	range->start_handle = start_handle;
+	range->end_handle = end_handle;
+	range->svc_end = svc_end;
+	range->desc_start = desc_start;
+
+	return true;
+}
+
+static uint8_t discover_all_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			       struct bt_gatt_discover_params *params);
+
+static void discover_all_kick(struct bt_conn *conn, struct bt_gatt_discover_all_params *all)
+{
+	struct bt_gatt_discover_all_range *range;
+	struct bt_gatt_discover_all_req *req;
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(all->_reqs) && !all->_err; i++) {
+		req = &all->_reqs[i];
+		if (req->busy) {
+			continue;
+		}
+
+		if (all->_range_count == 0U) {
+			break;
+		}
+
+		range = &all->_ranges[all->_range_count - 1U];
+
+		(void)memset(&req->params, 0, sizeof(req->params));
+		req->params.func = discover_all_cb;
+		req->params.type = range->type;
+		req->params.start_handle = range->start_handle;
+		req->params.end_handle = range->end_handle;
+		req->svc_end = range->svc_end;
+		req->desc_start = range->desc_start;
+
+		err = bt_gatt_discover(conn, &req->params);
+		if (err == -ENOMEM && discover_all_busy(all) > 0U) {
+			/* Retry when a request in flight is done */
+			break;
+		}
+		if (err) {
+			LOG_DBG("Discovery of 0x%04x-0x%04x failed (err %d)",
+				range->start_handle, range->end_handle, err);
+			all->_err = err;
+			break;
+		}
+
+		req->busy = true;
+		all->_range_count--;
+	}
+
+	if (discover_all_busy(all) == 0U) {
+#if defined(CONFIG_BT_GATT_CLIENT_CACHE)
+		if (!all->_err) {
+			bt_gatt_cache_store(conn);
+		}
+#endif /* CONFIG_BT_GATT_CLIENT_CACHE */
+		all->done(conn, all->_err, all);
+	}
+}
+
+static uint8_t discover_all_end(struct bt_conn *conn, struct bt_gatt_discover_all_req *req)
+{
+	req->busy = false;
+	discover_all_kick(conn, req->all);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static uint8_t discover_all_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			       struct bt_gatt_discover_params *params)
+{
+	struct bt_gatt_discover_all_req *req =
+		CONTAINER_OF(params, struct bt_gatt_discover_all_req, params);
+	struct bt_gatt_discover_all_params *all = req->all;
+	struct bt_gatt_service_val *svc;
+	struct bt_gatt_chrc *chrc;
+
+	if (all->_err) {
+		return discover_all_end(conn, req);
+	}
+
+	if (!attr) {
+		/* Descriptors of the last characteristic of the service */
+		if (params->type == BT_GATT_DISCOVER_CHARACTERISTIC && req->desc_start &&
+		    req->desc_start <= req->svc_end) {
+			(void)discover_all_push(all, BT_GATT_DISCOVER_DESCRIPTOR,
+						req->desc_start, req->svc_end, 0, 0, true);
+		}
+
+		return discover_all_end(conn, req);
+	}
+
+	switch (params->type) {
+	case BT_GATT_DISCOVER_PRIMARY:
+		svc = attr->user_data;
+		if (attr->handle < svc->end_handle &&
+		    !discover_all_push(all, BT_GATT_DISCOVER_CHARACTERISTIC,
+				       attr->handle + 1, svc->end_handle,
+				       svc->end_handle, 0, false)) {
+			/* Start again from this service once there is room */
+			(void)discover_all_push(all, BT_GATT_DISCOVER_PRIMARY,
+						attr->handle, BT_ATT_LAST_ATTRIBUTE_HANDLE,
+						0, 0, true);
+			return discover_all_end(conn, req);
+		}
+		break;
+	case BT_GATT_DISCOVER_CHARACTERISTIC:
+		chrc = attr->user_data;
+		if (req->desc_start && req->desc_start < attr->handle &&
+		    !discover_all_push(all, BT_GATT_DISCOVER_DESCRIPTOR,
+				       req->desc_start, attr->handle - 1, 0, 0, false)) {
+			(void)discover_all_push(all, BT_GATT_DISCOVER_CHARACTERISTIC,
+						attr->handle, params->end_handle,
+						req->svc_end, req->desc_start, true);
+			return discover_all_end(conn, req);
+		}
+		req->desc_start = chrc->value_handle < req->svc_end ?
+				  chrc->value_handle + 1 : 0;
+		break;
+	default:
+		break;
+	}
+
+#if defined(CONFIG_BT_GATT_CLIENT_CACHE)
+	bt_gatt_cache_add(conn, params->type, attr);
+#endif /* CONFIG_BT_GATT_CLIENT_CACHE */
+
+	if (all->func(conn, attr, params) == BT_GATT_ITER_STOP) {
+		all->_err = -ECANCELED;
+		return discover_all_end(conn, req);
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static int discover_all_start(struct bt_conn *conn, struct bt_gatt_discover_all_params *params)
+{
+	struct bt_gatt_discover_all_req *req = &params->_reqs[0];
+	int err;
+
+	(void)memset(&req->params, 0, sizeof(req->params));
+	req->params.func = discover_all_cb;
+	req->params.type = BT_GATT_DISCOVER_PRIMARY;
+	req->params.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	req->params.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+
+	err = bt_gatt_discover(conn, &req->params);
+	if (err) {
+		return err;
+	}
+
+	req->busy = true;
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_GATT_CLIENT_CACHE)
+static uint8_t discover_all_cached(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+				   uint8_t type, void *user_data)
+{
+	struct bt_gatt_discover_all_params *all = user_data;
+	struct bt_gatt_discover_params *params = &all->_reqs[0].params;
+
+	params->type = type;
+
+	if (all->func(conn, attr, params) == BT_GATT_ITER_STOP) {
+		all->_err = -ECANCELED;
+		return BT_GATT_ITER_STOP;
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void discover_all_cache_checked(struct bt_conn *conn, bool hit, void *user_data)
+{
+	struct bt_gatt_discover_all_params *all = user_data;
+	int err;
+
+	if (hit) {
+		(void)memset(&all->_reqs[0].params, 0, sizeof(all->_reqs[0].params));
+		bt_gatt_cache_foreach(conn, discover_all_cached, all);
+		all->done(conn, all->_err, all);
+		return;
+	}
+
+	err = discover_all_start(conn, all);
+	if (err) {
+		all->done(conn, err, all);
+	}
+}
+#endif /* CONFIG_BT_GATT_CLIENT_CACHE */
+
+int bt_gatt_discover_all(struct bt_conn *conn, struct bt_gatt_discover_all_params *params)
+{
+	__ASSERT(conn, "invalid parameters\n");
+	__ASSERT(params && params->func && params->done, "invalid parameters\n");
+
+	for (size_t i = 0; i < ARRAY_SIZE(params->_reqs); i++) {
+		params->_reqs[i].all = params;
+		params->_reqs[i].busy = false;
+	}
+	params->_range_count = 0U;
+	params->_err = 0;
+
+#if defined(CONFIG_BT_GATT_CLIENT_CACHE)
+	/* Without a Database Hash, the database is discovered but not cached */
+	if (bt_gatt_cache_check(conn, discover_all_cache_checked, params) == 0) {
+		return 0;
+	}
+#endif /* CONFIG_BT_GATT_CLIENT_CACHE */
+
+	return discover_all_start(conn, params);
+}
+#endif /* CONFIG_BT_GATT_DISCOVER_PIPELINE */
+
 static void parse_read_by_uuid(struct bt_conn *conn,
 			       struct bt_gatt_read_params *params,
 			       const void *pdu, uint16_t length)
@@ -6375,6 +6805,13 @@ int bt_gatt_clear(uint8_t id, const bt_addr_le_t *addr)
 		bt_gatt_clear_subscriptions(id, addr);
 	}
 
+#if defined(CONFIG_BT_GATT_CLIENT_CACHE)
+	err = bt_gatt_cache_clear(id, addr);
+	if (err < 0) {
+		return err;
+	}
+#endif /* CONFIG_BT_GATT_CLIENT_CACHE */
+
 	return 0;
 }
 
@@ -0,0 +1,307 @@
+/* gatt_cache.c - Cache of the database of bonded GATT servers */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/bluetooth/gatt.h>
+
+#include "common/bt_str.h"
+
+#include "hci_core.h"
+#include "conn_internal.h"
+#include "settings.h"
+#include "gatt_internal.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(bt_gatt, CONFIG_BT_GATT_LOG_LEVEL);
+
+#define DB_HASH_LEN 16
+
+struct gatt_cache_entry {
+	uint16_t handle;
+	/* End handle of a service, value handle of a characteristic */
+	uint16_t value;
+	uint8_t type;
+	uint8_t properties;
+	uint8_t uuid_len;
+	uint8_t uuid[BT_UUID_SIZE_128];
+} __packed;
+
+/* Layout of the cache in the settings, only the entries in use are stored */
+struct gatt_cache_data {
+	uint8_t hash[DB_HASH_LEN];
+	uint16_t count;
+	struct gatt_cache_entry entries[CONFIG_BT_GATT_CLIENT_CACHE_ATTRS];
+} __packed;
+
+static struct gatt_cache {
+	struct bt_gatt_read_params read;
+	bt_gatt_cache_check_func_t func;
+	void *user_data;
+	/* The Database Hash of the peer has been read */
+	bool hash_valid;
+	/* The database does not fit in the cache */
+	bool overflow;
+	struct gatt_cache_data data;
+} caches[CONFIG_BT_MAX_CONN];
+
+static struct gatt_cache *gatt_cache_get(struct bt_conn *conn)
+{
+	return &caches[bt_conn_index(conn)];
+}
+
+struct gatt_cache_load {
+	struct gatt_cache_data *data;
+	ssize_t len;
+};
+
+static int gatt_cache_load_cb(const char *key, size_t len, settings_read_cb read_cb,
+			      void *cb_arg, void *param)
+{
+	struct gatt_cache_load *load = param;
+
+	/* Cache of the same peer for another identity */
+	if (key) {
+		return 0;
+	}
+
+	if (len > sizeof(*load->data)) {
+		LOG_WRN("Cache larger than %zu bytes", sizeof(*load->data));
+		return 0;
+	}
+
+	load->len = read_cb(cb_arg, load->data, len);
+
+	return 0;
+}
+
+static bool gatt_cache_load(struct bt_conn *conn, struct gatt_cache_data *data)
+{
+	struct gatt_cache_load load = {
+		.data = data,
+		.len = -ENOENT,
+	};
+	char key[BT_SETTINGS_KEY_MAX];
+	char id_str[4];
+
+	if (conn->id) {
+		u8_to_dec(id_str, sizeof(id_str), conn->id);
+	}
+
+	bt_settings_encode_key(key, sizeof(key), "gcache", &conn->le.dst,
+			       conn->id ? id_str : NULL);
+
+	(void)settings_load_subtree_direct(key, gatt_cache_load_cb, &load);
+
+	return load.len >= (ssize_t)offsetof(struct gatt_cache_data, entries) &&
+	       data->count <= ARRAY_SIZE(data->entries) &&
+	       load.len == (ssize_t)(offsetof(struct gatt_cache_data, entries) +
+				     data->count * sizeof(data->entries[0]));
+}
+
+static void gatt_cache_checked(struct bt_conn *conn, struct gatt_cache *cache)
+{
+	uint8_t hash[DB_HASH_LEN];
+	bool hit = false;
+
+	if (cache->hash_valid && bt_addr_le_is_bonded(conn->id, &conn->le.dst)) {
+		memcpy(hash, cache->data.hash, sizeof(hash));
+
+		hit = gatt_cache_load(conn, &cache->data) &&
+		      !memcmp(hash, cache->data.hash, sizeof(hash));
+		if (!hit) {
+			memcpy(cache->data.hash, hash, sizeof(hash));
+		}
+	}
+
+	LOG_DBG("conn %p cache %s", conn, hit ? "hit" : "miss");
+
+	if (!hit) {
+		cache->data.count = 0U;
+	}
+
+	cache->func(conn, hit, cache->user_data);
+}
+
+static uint8_t gatt_cache_hash_read(struct bt_conn *conn, uint8_t err,
+				    struct bt_gatt_read_params *params,
+				    const void *data, uint16_t length)
+{
+	struct gatt_cache *cache = CONTAINER_OF(params, struct gatt_cache, read);
+
+	if (!err && data && length == DB_HASH_LEN) {
+		memcpy(cache->data.hash, data, DB_HASH_LEN);
+		cache->hash_valid = true;
+	} else if (err) {
+		LOG_DBG("Unable to read Database Hash (err 0x%02x)", err);
+	}
+
+	gatt_cache_checked(conn, cache);
+
+	return BT_GATT_ITER_STOP;
+}
+
+int bt_gatt_cache_check(struct bt_conn *conn, bt_gatt_cache_check_func_t func,
+			void *user_data)
+{
+	struct gatt_cache *cache = gatt_cache_get(conn);
+
+	cache->func = func;
+	cache->user_data = user_data;
+	cache->hash_valid = false;
+	cache->overflow = false;
+	cache->data.count = 0U;
+
+	(void)memset(&cache->read, 0, sizeof(cache->read));
+	cache->read.func = gatt_cache_hash_read;
+	cache->read.handle_count = 0U;
+	cache->read.by_uuid.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	cache->read.by_uuid.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	cache->read.by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+
+	return bt_gatt_read(conn, &cache->read);
+}
+
+void bt_gatt_cache_add(struct bt_conn *conn, uint8_t type, const struct bt_gatt_attr *attr)
+{
+	struct gatt_cache *cache = gatt_cache_get(conn);
+	const struct bt_gatt_service_val *svc;
+	const struct bt_gatt_chrc *chrc;
+	struct gatt_cache_entry *entry;
+	const struct bt_uuid *uuid;
+
+	if (!cache->hash_valid || cache->overflow) {
+		return;
+	}
+
+	if (cache->data.count == ARRAY_SIZE(cache->data.entries)) {
+		LOG_WRN("Database of %s too large to cache", bt_addr_le_str(&conn->le.dst));
+		cache->overflow = true;
+		return;
+	}
+
+	entry = &cache->data.entries[cache->data.count++];
+	entry->handle = attr->handle;
+	entry->type = type;
+	entry->value = 0U;
+	entry->properties = 0U;
+
+	switch (type) {
+	case BT_GATT_DISCOVER_PRIMARY:
+		svc = attr->user_data;
+		uuid = svc->uuid;
+		entry->value = svc->end_handle;
+		break;
+	case BT_GATT_DISCOVER_CHARACTERISTIC:
+		chrc = attr->user_data;
+		uuid = chrc->uuid;
+		entry->value = chrc->value_handle;
+		entry->properties = chrc->properties;
+		break;
+	default:
+		uuid = attr->uuid;
+		break;
+	}
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		entry->uuid_len = BT_UUID_SIZE_16;
+		sys_put_le16(BT_UUID_16(uuid)->val, entry->uuid);
+		break;
+	case BT_UUID_TYPE_32:
+		entry->uuid_len = BT_UUID_SIZE_32;
+		sys_put_le32(BT_UUID_32(uuid)->val, entry->uuid);
+		break;
+	default:
+		entry->uuid_len = BT_UUID_SIZE_128;
+		memcpy(entry->uuid, BT_UUID_128(uuid)->val, BT_UUID_SIZE_128);
+		break;
+	}
+}
+
+void bt_gatt_cache_store(struct bt_conn *conn)
+{
+	struct gatt_cache *cache = gatt_cache_get(conn);
+	int err;
+
+	if (!cache->hash_valid || cache->overflow ||
+	    !bt_addr_le_is_bonded(conn->id, &conn->le.dst)) {
+		return;
+	}
+
+	err = bt_settings_store_gatt_cache(conn->id, &conn->le.dst, &cache->data,
+					   offsetof(struct gatt_cache_data, entries) +
+					   cache->data.count * sizeof(cache->data.entries[0]));
+	if (err) {
+		LOG_ERR("Failed to store GATT cache (err %d)", err);
+	}
+}
+
+void bt_gatt_cache_foreach(struct bt_conn *conn, bt_gatt_cache_func_t func, void *user_data)
+{
+	struct gatt_cache *cache = gatt_cache_get(conn);
+
+	for (uint16_t i = 0U; i < cache->data.count; i++) {
+		const struct gatt_cache_entry *entry = &cache->data.entries[i];
+		struct bt_gatt_attr attr = {
+			.handle = entry->handle,
+		};
+		struct bt_gatt_service_val svc;
+		struct bt_gatt_chrc chrc;
+		struct bt_uuid_128 u;
+
+		if (!bt_uuid_create(&u.uuid, entry->uuid, entry->uuid_len)) {
+			continue;
+		}
+
+		switch (entry->type) {
+		case BT_GATT_DISCOVER_PRIMARY:
+			svc.uuid = &u.uuid;
+			svc.end_handle = entry->value;
+			attr.uuid = BT_UUID_GATT_PRIMARY;
+			attr.user_data = &svc;
+			break;
+		case BT_GATT_DISCOVER_CHARACTERISTIC:
+			chrc.uuid = &u.uuid;
+			chrc.value_handle = entry->value;
+			chrc.properties = entry->properties;
+			attr.uuid = BT_UUID_GATT_CHRC;
+			attr.user_data = &chrc;
+			break;
+		default:
+			attr.uuid = &u.uuid;
+			break;
+		}
+
+		if (func(conn, &attr, entry->type, user_data) == BT_GATT_ITER_STOP) {
+			break;
+		}
+	}
+}
+
+int bt_gatt_cache_clear(uint8_t id, const bt_addr_le_t *addr)
+{
+	return bt_settings_delete_gatt_cache(id, addr);
+}
+
+/* The caches are loaded when the peer connects again */
+static int gatt_cache_set(const char *name, size_t len_rd, settings_read_cb read_cb,
+			  void *cb_arg)
+{
+	return 0;
+}
+
+BT_SETTINGS_DEFINE(gatt_cache, "gcache", gatt_cache_set, NULL);
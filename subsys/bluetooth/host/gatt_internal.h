@@ -59,6 +59,29 @@ static inline void bt_gatt_mult_notification(struct bt_conn *conn,
 }
 #endif /* CONFIG_BT_GATT_CLIENT */
 
+#if defined(CONFIG_BT_GATT_CLIENT_CACHE)
+struct bt_gatt_attr;
+
+typedef void (*bt_gatt_cache_check_func_t)(struct bt_conn *conn, bool hit, void *user_data);
+typedef uint8_t (*bt_gatt_cache_func_t)(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+					uint8_t type, void *user_data);
+
+/* Read the Database Hash of the peer and tell whether its cache is valid */
+int bt_gatt_cache_check(struct bt_conn *conn, bt_gatt_cache_check_func_t func,
+			void *user_data);
+
+/* Record an attribute found by the discovery of the database */
+void bt_gatt_cache_add(struct bt_conn *conn, uint8_t type, const struct bt_gatt_attr *attr);
+
+/* Store the attributes recorded, if the peer is bonded */
+void bt_gatt_cache_store(struct bt_conn *conn);
+
+/* Walk the attributes of a valid cache */
+void bt_gatt_cache_foreach(struct bt_conn *conn, bt_gatt_cache_func_t func, void *user_data);
+
+int bt_gatt_cache_clear(uint8_t id, const bt_addr_le_t *addr);
+#endif /* CONFIG_BT_GATT_CLIENT_CACHE */
+
 struct bt_gatt_attr;
 
 /* Check attribute permission */
@@ -837,6 +837,58 @@ int bt_iso_chan_send_ts(struct bt_iso_chan *chan, struct net_buf *buf, uint16_t
 	return bt_conn_send_iso_cb(iso_conn, buf, bt_iso_send_cb, true);
 }
 
+static int iso_chan_send_batch(const struct bt_iso_tx_sdu *sdus, size_t count, uint32_t ts,
+			       bool has_ts)
+{
+	const uint8_t hdr_size = has_ts ? BT_HCI_ISO_TS_DATA_HDR_SIZE : BT_HCI_ISO_DATA_HDR_SIZE;
+	size_t i;
+	int err;
+
+	CHECKIF(sdus == NULL || count == 0U) {
+		LOG_DBG("Invalid parameters: sdus %p count %zu", sdus, count);
+		return -EINVAL;
+	}
+
+	for (i = 0U; i < count; i++) {
+		err = validate_send(sdus[i].chan, sdus[i].buf, hdr_size);
+		if (err != 0) {
+			return err;
+		}
+	}
+
+	/* The TX thread only runs once all the SDUs are queued, and hands them
+	 * to the HCI driver in one pass.
+	 */
+	k_sched_lock();
+
+	for (i = 0U; i < count; i++) {
+		if (has_ts) {
+			err = bt_iso_chan_send_ts(sdus[i].chan, sdus[i].buf, sdus[i].seq_num, ts);
+		} else {
+			err = bt_iso_chan_send(sdus[i].chan, sdus[i].buf, sdus[i].seq_num);
+		}
+
+		if (err != 0) {
+			LOG_DBG("Unable to send SDU %zu of %zu: %d", i, count, err);
+			break;
+		}
+	}
+
+	k_sched_unlock();
+
+	return (i > 0U) ? (int)i : err;
+}
+
+int bt_iso_chan_send_batch(const struct bt_iso_tx_sdu *sdus, size_t count)
+{
+	return iso_chan_send_batch(sdus, count, 0U, false);
+}
+
+int bt_iso_chan_send_batch_ts(const struct bt_iso_tx_sdu *sdus, size_t count, uint32_t ts)
+{
+	return iso_chan_send_batch(sdus, count, ts, true);
+}
+
 #if defined(CONFIG_BT_ISO_CENTRAL) || defined(CONFIG_BT_ISO_BROADCASTER)
 static bool valid_chan_io_qos(const struct bt_iso_chan_io_qos *io_qos,
 			      bool is_tx, bool is_broadcast, bool advanced)
@@ -7,35 +7,57 @@
  */
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
+#include <zephyr/sys/printk.h>
 
-K_THREAD_STACK_DEFINE(bt_lw_stack_area, CONFIG_BT_LONG_WQ_STACK_SIZE);
-static struct k_work_q bt_long_wq;
+K_THREAD_STACK_ARRAY_DEFINE(bt_lw_stack_area, CONFIG_BT_LONG_WQ_COUNT,
+			    CONFIG_BT_LONG_WQ_STACK_SIZE);
+static struct k_work_q bt_long_wq[CONFIG_BT_LONG_WQ_COUNT];
+
+/* A work item always goes to the same queue, so that it is never run by two
+ * threads at once.
+ */
+static struct k_work_q *long_wq_get(const struct k_work *work)
+{
+	if (CONFIG_BT_LONG_WQ_COUNT == 1) {
+		return &bt_long_wq[0];
+	}
+
+	return &bt_long_wq[((uintptr_t)work / sizeof(void *)) % CONFIG_BT_LONG_WQ_COUNT];
+}
 
 int bt_long_wq_schedule(struct k_work_delayable *dwork, k_timeout_t timeout)
 {
-	return k_work_schedule_for_queue(&bt_long_wq, dwork, timeout);
+	return k_work_schedule_for_queue(long_wq_get(&dwork->work), dwork, timeout);
 }
 
 int bt_long_wq_reschedule(struct k_work_delayable *dwork, k_timeout_t timeout)
 {
-	return k_work_reschedule_for_queue(&bt_long_wq, dwork, timeout);
+	return k_work_reschedule_for_queue(long_wq_get(&dwork->work), dwork, timeout);
 }
 
 int bt_long_wq_submit(struct k_work *work)
 {
-	return k_work_submit_to_queue(&bt_long_wq, work);
+	return k_work_submit_to_queue(long_wq_get(work), work);
 }
 
 static int long_wq_init(void)
 {
+	for (size_t i = 0; i < ARRAY_SIZE(bt_long_wq); i++) {
+		char name[sizeof("BT LW WQ 7")];
+		const struct k_work_queue_config cfg = {.name = name};
 
-	const struct k_work_queue_config cfg = {.name = "BT LW WQ"};
+		if (CONFIG_BT_LONG_WQ_COUNT == 1) {
+			snprintk(name, sizeof(name), "BT LW WQ");
+		} else {
+			snprintk(name, sizeof(name), "BT LW WQ %zu", i);
+		}
 
-	k_work_queue_init(&bt_long_wq);
+		k_work_queue_init(&bt_long_wq[i]);
 
-	k_work_queue_start(&bt_long_wq, bt_lw_stack_area,
-			   K_THREAD_STACK_SIZEOF(bt_lw_stack_area),
-			   CONFIG_BT_LONG_WQ_PRIO, &cfg);
+		k_work_queue_start(&bt_long_wq[i], bt_lw_stack_area[i],
+				   K_THREAD_STACK_SIZEOF(bt_lw_stack_area[i]),
+				   CONFIG_BT_LONG_WQ_PRIO, &cfg);
+	}
 
 	return 0;
 }
@@ -4,6 +4,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <string.h>
 #include <sys/types.h>
 
 #include <zephyr/sys/byteorder.h>
@@ -436,12 +437,283 @@ static uint8_t get_adv_props_legacy(uint8_t evt_type)
 	}
 }
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+struct scan_filter_data {
+	uint8_t type;
+	uint8_t len;
+	uint8_t data[CONFIG_BT_SCAN_FILTER_DATA_LEN];
+};
+
+static struct {
+	bt_addr_le_t addrs[CONFIG_BT_SCAN_FILTER_ADDR_COUNT];
+	uint8_t addr_count;
+	struct scan_filter_data data[CONFIG_BT_SCAN_FILTER_DATA_COUNT];
+	uint8_t data_count;
+} scan_filter;
+
+/* The filter is changed by the application while the RX thread matches the
+ * reports against it.
+ */
+static struct k_spinlock scan_filter_lock;
+
+static uint8_t scan_filter_uuid_size(uint8_t type)
+{
+	switch (type) {
+	case BT_DATA_UUID16_SOME:
+	case BT_DATA_UUID16_ALL:
+		return BT_UUID_SIZE_16;
+	case BT_DATA_UUID32_SOME:
+	case BT_DATA_UUID32_ALL:
+		return BT_UUID_SIZE_32;
+	case BT_DATA_UUID128_SOME:
+	case BT_DATA_UUID128_ALL:
+		return BT_UUID_SIZE_128;
+	default:
+		return 0U;
+	}
+}
+
+static bool scan_filter_data_match(const struct scan_filter_data *pattern, uint8_t type,
+				   const uint8_t *data, uint8_t len)
+{
+	uint8_t size;
+
+	if (type != pattern->type) {
+		return false;
+	}
+
+	if (len >= pattern->len && !memcmp(data, pattern->data, pattern->len)) {
+		return true;
+	}
+
+	/* Any UUID of a list can match */
+	size = scan_filter_uuid_size(type);
+	if (size == 0U || pattern->len != size) {
+		return false;
+	}
+
+	for (uint16_t i = size; i + size <= len; i += size) {
+		if (!memcmp(&data[i], pattern->data, size)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool scan_filter_match_locked(const bt_addr_le_t *addr,
+				     const struct net_buf_simple *buf, uint16_t len)
+{
+	const uint8_t *ad = buf->data;
+
+	if (scan_filter.addr_count == 0U && scan_filter.data_count == 0U) {
+		return true;
+	}
+
+	for (uint8_t i = 0U; i < scan_filter.addr_count; i++) {
+		if (bt_addr_le_eq(addr, &scan_filter.addrs[i])) {
+			return true;
+		}
+	}
+
+	/* Walk the AD structures in place, the report is not parsed yet */
+	for (uint16_t i = 0U; scan_filter.data_count > 0U && i + 1U < len;
+	     i += ad[i] + 1U) {
+		if (ad[i] == 0U || i + 1U + ad[i] > len) {
+			break;
+		}
+
+		for (uint8_t j = 0U; j < scan_filter.data_count; j++) {
+			if (scan_filter_data_match(&scan_filter.data[j], ad[i + 1U],
+						   &ad[i + 2U], ad[i] - 1U)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static bool scan_filter_match(const bt_addr_le_t *addr, const struct net_buf_simple *buf,
+			      uint16_t len)
+{
+	bt_addr_le_t resolved;
+	k_spinlock_key_t key;
+	bool match;
+
+	if (bt_addr_le_is_resolved(addr)) {
+		bt_addr_le_copy_resolved(&resolved, addr);
+		addr = &resolved;
+	}
+
+	key = k_spin_lock(&scan_filter_lock);
+	match = scan_filter_match_locked(addr, buf, len);
+	k_spin_unlock(&scan_filter_lock, key);
+
+	return match;
+}
+
+int bt_le_scan_filter_add_addr(const bt_addr_le_t *addr)
+{
+	k_spinlock_key_t key;
+
+	CHECKIF(addr == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&scan_filter_lock);
+
+	if (scan_filter.addr_count == ARRAY_SIZE(scan_filter.addrs)) {
+		k_spin_unlock(&scan_filter_lock, key);
+		return -ENOMEM;
+	}
+
+	bt_addr_le_copy(&scan_filter.addrs[scan_filter.addr_count], addr);
+	scan_filter.addr_count++;
+
+	k_spin_unlock(&scan_filter_lock, key);
+
+	return 0;
+}
+
+int bt_le_scan_filter_add_data(uint8_t type, const uint8_t *data, uint8_t len)
+{
+	struct scan_filter_data *pattern;
+	k_spinlock_key_t key;
+
+	CHECKIF((data == NULL && len > 0U) || len > CONFIG_BT_SCAN_FILTER_DATA_LEN) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&scan_filter_lock);
+
+	if (scan_filter.data_count == ARRAY_SIZE(scan_filter.data)) {
+		k_spin_unlock(&scan_filter_lock, key);
+		return -ENOMEM;
+	}
+
+	pattern = &scan_filter.data[scan_filter.data_count];
+	pattern->type = type;
+	pattern->len = len;
+	memcpy(pattern->data, data, len);
+	scan_filter.data_count++;
+
+	k_spin_unlock(&scan_filter_lock, key);
+
+	return 0;
+}
+
+void bt_le_scan_filter_clear(void)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&scan_filter_lock);
+	scan_filter.addr_count = 0U;
+	scan_filter.data_count = 0U;
+	k_spin_unlock(&scan_filter_lock, key);
+}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
+#if defined(CONFIG_BT_SCAN_BATCH)
+struct scan_batch {
+	struct bt_le_scan_report reports[CONFIG_BT_SCAN_BATCH_SIZE];
+	size_t count;
+};
+
+/* Reports are added to one batch while the other one is delivered */
+static struct scan_batch scan_batches[2];
+static uint8_t scan_batch_fill;
+static uint32_t scan_batch_dropped;
+static struct k_spinlock scan_batch_lock;
+
+static void scan_batch_deliver(struct k_work *work)
+{
+	struct bt_le_scan_cb *listener, *next;
+	struct scan_batch *batch;
+	k_spinlock_key_t key;
+	uint32_t dropped;
+
+	key = k_spin_lock(&scan_batch_lock);
+	batch = &scan_batches[scan_batch_fill];
+	scan_batch_fill ^= 1U;
+	dropped = scan_batch_dropped;
+	scan_batch_dropped = 0U;
+	k_spin_unlock(&scan_batch_lock, key);
+
+	if (dropped) {
+		LOG_WRN("Dropped %u scan reports", dropped);
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&scan_cbs, listener, next, node) {
+		if (listener->recv_batch && batch->count > 0U) {
+			listener->recv_batch(batch->reports, batch->count);
+		}
+	}
+
+	batch->count = 0U;
+}
+
+static K_WORK_DELAYABLE_DEFINE(scan_batch_work, scan_batch_deliver);
+
+static bool scan_batch_listening(void)
+{
+	struct bt_le_scan_cb *listener;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&scan_cbs, listener, node) {
+		if (listener->recv_batch) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void scan_batch_add(const struct bt_le_scan_recv_info *info,
+			   const struct net_buf_simple *buf, uint16_t len)
+{
+	struct bt_le_scan_report *report;
+	struct scan_batch *batch;
+	k_spinlock_key_t key;
+	size_t count;
+
+	key = k_spin_lock(&scan_batch_lock);
+
+	batch = &scan_batches[scan_batch_fill];
+	if (batch->count == ARRAY_SIZE(batch->reports)) {
+		scan_batch_dropped++;
+		k_spin_unlock(&scan_batch_lock, key);
+		return;
+	}
+
+	report = &batch->reports[batch->count];
+	bt_addr_le_copy(&report->addr, info->addr);
+	report->rssi = info->rssi;
+	report->adv_type = info->adv_type;
+	report->adv_props = info->adv_props;
+	report->sid = info->sid;
+	report->data_len = MIN(len, sizeof(report->data));
+	memcpy(report->data, buf->data, report->data_len);
+	count = ++batch->count;
+
+	k_spin_unlock(&scan_batch_lock, key);
+
+	if (count == ARRAY_SIZE(batch->reports)) {
+		(void)k_work_reschedule(&scan_batch_work, K_NO_WAIT);
+	} else if (count == 1U) {
+		(void)k_work_schedule(&scan_batch_work, K_MSEC(CONFIG_BT_SCAN_BATCH_TIMEOUT));
+	}
+}
+#endif /* CONFIG_BT_SCAN_BATCH */
+
 static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 			struct net_buf_simple *buf, uint16_t len)
 {
 	struct bt_le_scan_cb *listener, *next;
 	struct net_buf_simple_state state;
 	bt_addr_le_t id_addr;
+#if defined(CONFIG_BT_SCAN_FILTER)
+	bool deliver;
+#endif /* CONFIG_BT_SCAN_FILTER */
 
 	LOG_DBG("%s event %u, len %u, rssi %d dBm", bt_addr_le_str(addr), info->adv_type, len,
 		info->rssi);
@@ -454,6 +726,16 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 		return;
 	}
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+	deliver = scan_filter_match(addr, buf, len);
+	if (!deliver && (!IS_ENABLED(CONFIG_BT_CENTRAL) ||
+			 atomic_test_bit(bt_dev.flags, BT_DEV_EXPLICIT_SCAN) ||
+			 !(info->adv_props & BT_HCI_LE_ADV_EVT_TYPE_CONN))) {
+		/* No connection is waiting for the report either */
+		return;
+	}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 	if (bt_addr_le_is_resolved(addr)) {
 		bt_addr_le_copy_resolved(&id_addr, addr);
 	} else if (addr->type == BT_HCI_PEER_ADDR_ANONYMOUS) {
@@ -463,6 +745,15 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 				bt_lookup_id_addr(BT_ID_DEFAULT, addr));
 	}
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+	if (!deliver) {
+#if defined(CONFIG_BT_CENTRAL)
+		check_pending_conn(&id_addr, addr, info->adv_props);
+#endif /* CONFIG_BT_CENTRAL */
+		return;
+	}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 	if (scan_dev_found_cb) {
 		net_buf_simple_save(buf, &state);
 
@@ -485,6 +776,12 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 		}
 	}
 
+#if defined(CONFIG_BT_SCAN_BATCH)
+	if (scan_batch_listening()) {
+		scan_batch_add(info, buf, len);
+	}
+#endif /* CONFIG_BT_SCAN_BATCH */
+
 	/* Clear pointer to this stack frame before returning to calling function */
 	info->addr = NULL;
 
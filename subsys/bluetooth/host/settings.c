@@ -373,6 +373,17 @@ int bt_settings_delete_ccc(uint8_t id, const bt_addr_le_t *addr)
 	return bt_settings_delete("ccc", id, addr);
 }
 
+int bt_settings_store_gatt_cache(uint8_t id, const bt_addr_le_t *addr, const void *value,
+				 size_t val_len)
+{
+	return bt_settings_store("gcache", id, addr, value, val_len);
+}
+
+int bt_settings_delete_gatt_cache(uint8_t id, const bt_addr_le_t *addr)
+{
+	return bt_settings_delete("gcache", id, addr);
+}
+
 int bt_settings_store_hash(const void *value, size_t val_len)
 {
 	return bt_settings_store("hash", 0, NULL, value, val_len);
@@ -29,6 +29,12 @@ NET_BUF_POOL_DEFINE(isotp_rx_pool, CONFIG_ISOTP_RX_BUF_COUNT,
 NET_BUF_POOL_DEFINE(isotp_rx_sf_ff_pool, CONFIG_ISOTP_RX_SF_FF_BUF_COUNT,
 		    CAN_MAX_DLEN, sizeof(uint32_t), receive_ff_sf_pool_free);
 
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+/* Buffers without data, pointing to the buffers given by the user */
+NET_BUF_POOL_DEFINE(isotp_rx_user_pool, CONFIG_ISOTP_RX_USER_BUF_COUNT,
+		    0, sizeof(uint32_t), NULL);
+#endif
+
 static struct isotp_global_ctx global_ctx = {
 	.alloc_list = SYS_SLIST_STATIC_INIT(&global_ctx.alloc_list),
 	.ff_sf_alloc_list = SYS_SLIST_STATIC_INIT(&global_ctx.ff_sf_alloc_list)
@@ -202,6 +208,44 @@ static inline struct net_buf *receive_alloc_buffer_chain(uint32_t len)
 	return buf;
 }
 
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+/* Move the FF data to the buffer given by the user if the message fits in.
+ * The CFs are then appended to it directly and no more buffers are needed.
+ */
+static bool receive_to_user_buf(struct isotp_recv_ctx *rctx)
+{
+	struct net_buf *buf;
+
+	if (!rctx->user_buf || rctx->length + rctx->buf->len > rctx->user_buf_size) {
+		return false;
+	}
+
+	buf = net_buf_alloc_with_data(&isotp_rx_user_pool, rctx->user_buf,
+				      rctx->user_buf_size, K_NO_WAIT);
+	if (!buf) {
+		return false;
+	}
+
+	net_buf_simple_reset(&buf->b);
+	net_buf_add_mem(buf, rctx->buf->data, rctx->buf->len);
+	net_buf_unref(rctx->buf);
+
+	rctx->buf = buf;
+	rctx->act_frag = buf;
+	rctx->user_buf = NULL;
+
+	return true;
+}
+
+static inline bool receive_in_user_buf(struct isotp_recv_ctx *rctx)
+{
+	return (rctx->buf->flags & NET_BUF_EXTERNAL_DATA) != 0;
+}
+#else
+#define receive_to_user_buf(rctx) false
+#define receive_in_user_buf(rctx) false
+#endif /* CONFIG_ISOTP_RX_USER_BUF */
+
 static void receive_timeout_handler(struct k_timer *timer)
 {
 	struct isotp_recv_ctx *rctx = CONTAINER_OF(timer, struct isotp_recv_ctx, timer);
@@ -287,6 +331,15 @@ static void receive_state_machine(struct isotp_recv_ctx *rctx)
 		rctx->length = receive_get_ff_length(rctx->buf);
 		LOG_DBG("SM process FF. Length: %d", rctx->length);
 		rctx->length -= rctx->buf->len;
+		if (receive_to_user_buf(rctx)) {
+			LOG_DBG("SM receive into user buffer");
+			rctx->bs = rctx->opts.bs;
+			rctx->wft = ISOTP_WFT_FIRST;
+			rctx->state = ISOTP_RX_STATE_SEND_FC;
+			receive_state_machine(rctx);
+			break;
+		}
+
 		if (rctx->opts.bs == 0 &&
 		    rctx->length > CONFIG_ISOTP_RX_BUF_COUNT * CONFIG_ISOTP_RX_BUF_SIZE) {
 			LOG_ERR("Pkt length is %d but buffer has only %d bytes", rctx->length,
@@ -543,8 +596,14 @@ static void process_cf(struct isotp_recv_ctx *rctx, struct can_frame *frame)
 	}
 
 	if (rctx->opts.bs && !--rctx->bs) {
-		LOG_DBG("Block is complete. Allocate new buffer");
 		rctx->bs = rctx->opts.bs;
+		if (receive_in_user_buf(rctx)) {
+			LOG_DBG("Block is complete. Send FC");
+			rctx->state = ISOTP_RX_STATE_SEND_FC;
+			return;
+		}
+
+		LOG_DBG("Block is complete. Allocate new buffer");
 		*ud_rem_len = rctx->length;
 		net_buf_put(&rctx->fifo, rctx->buf);
 		rctx->state = ISOTP_RX_STATE_TRY_ALLOC;
@@ -635,6 +694,9 @@ int isotp_bind(struct isotp_recv_ctx *rctx, const struct device *can_dev,
 
 	rctx->opts = *opts;
 	rctx->state = ISOTP_RX_STATE_WAIT_FF_SF;
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+	rctx->user_buf = NULL;
+#endif
 
 	if ((rx_addr->flags & ISOTP_MSG_FDF) != 0 || (tx_addr->flags & ISOTP_MSG_FDF) != 0) {
 		ret = can_get_capabilities(can_dev, &cap);
@@ -681,6 +743,9 @@ void isotp_unbind(struct isotp_recv_ctx *rctx)
 	sys_slist_find_and_remove(&global_ctx.alloc_list, &rctx->alloc_node);
 
 	rctx->state = ISOTP_RX_STATE_UNBOUND;
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+	rctx->user_buf = NULL;
+#endif
 
 	while ((buf = net_buf_get(&rctx->fifo, K_NO_WAIT))) {
 		net_buf_unref(buf);
@@ -732,7 +797,10 @@ int isotp_recv(struct isotp_recv_ctx *rctx, uint8_t *data, size_t len, k_timeout
 	copied = 0;
 	while (rctx->recv_buf && copied < len) {
 		to_copy = MIN(len - copied, rctx->recv_buf->len);
-		memcpy((uint8_t *)data + copied, rctx->recv_buf->data, to_copy);
+		/* Nothing to copy if received into this buffer already */
+		if (data + copied != rctx->recv_buf->data) {
+			memcpy((uint8_t *)data + copied, rctx->recv_buf->data, to_copy);
+		}
 
 		if (rctx->recv_buf->len == to_copy) {
 			/* point recv_buf to next frag */
@@ -748,6 +816,14 @@ int isotp_recv(struct isotp_recv_ctx *rctx, uint8_t *data, size_t len, k_timeout
 	return copied;
 }
 
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+void isotp_recv_set_buf(struct isotp_recv_ctx *rctx, uint8_t *buf, size_t size)
+{
+	rctx->user_buf_size = size;
+	rctx->user_buf = buf;
+}
+#endif
+
 static inline void send_report_error(struct isotp_send_ctx *sctx, uint32_t err)
 {
 	sctx->state = ISOTP_TX_ERR;
@@ -760,11 +836,11 @@ static void send_can_tx_cb(const struct device *dev, int error, void *arg)
 
 	ARG_UNUSED(dev);
 
-	sctx->tx_backlog--;
+	atomic_dec(&sctx->tx_backlog);
 	k_sem_give(&sctx->tx_sem);
 
 	if (sctx->state == ISOTP_TX_WAIT_BACKLOG) {
-		if (sctx->tx_backlog > 0) {
+		if (atomic_get(&sctx->tx_backlog) > 0) {
 			return;
 		}
 
@@ -815,7 +891,6 @@ static void send_process_fc(struct isotp_send_ctx *sctx, struct can_frame *frame
 	case ISOTP_PCI_FS_CTS:
 		sctx->state = ISOTP_TX_SEND_CF;
 		sctx->wft = 0;
-		sctx->tx_backlog = 0;
 		k_sem_reset(&sctx->tx_sem);
 		sctx->opts.bs = *data++;
 		sctx->opts.stmin = *data++;
@@ -1019,12 +1094,16 @@ static inline int send_cf(struct isotp_send_ctx *sctx)
 		frame.dlc = can_bytes_to_dlc(len + index);
 	}
 
+	/* Counted before sending as the TX callback may run first */
+	atomic_inc(&sctx->tx_backlog);
+
 	ret = can_send(sctx->can_dev, &frame, K_MSEC(ISOTP_A_TIMEOUT_MS), send_can_tx_cb, sctx);
 	if (ret == 0) {
 		sctx->sn++;
 		pull_send_ctx_data(sctx, len);
 		sctx->bs--;
-		sctx->tx_backlog++;
+	} else {
+		atomic_dec(&sctx->tx_backlog);
 	}
 
 	ret = ret ? ret : rem_len;
@@ -1117,12 +1196,26 @@ static void send_state_machine(struct isotp_send_ctx *sctx)
 				break;
 			}
 
-			/* Ensure FIFO style transmission of CF */
-			k_sem_take(&sctx->tx_sem, K_FOREVER);
+			/* Ensure FIFO style transmission of CF, with at most
+			 * CONFIG_ISOTP_TX_BACKLOG of them queued to the controller.
+			 */
+			while (atomic_get(&sctx->tx_backlog) >= CONFIG_ISOTP_TX_BACKLOG) {
+				k_sem_take(&sctx->tx_sem, K_FOREVER);
+			}
 		} while (ret > 0);
 
 		break;
 
+	case ISOTP_TX_WAIT_BACKLOG:
+		/* The last CFs may have been sent before the state was set */
+		if (atomic_get(&sctx->tx_backlog) > 0) {
+			break;
+		}
+
+		sctx->state = ISOTP_TX_WAIT_FIN;
+		k_work_submit(&sctx->work);
+		break;
+
 	case ISOTP_TX_WAIT_ST:
 		k_timer_start(&sctx->timer, stmin_to_timeout(sctx->opts.stmin), K_NO_WAIT);
 		sctx->state = ISOTP_TX_SEND_CF;
@@ -1211,6 +1304,7 @@ static int send(struct isotp_send_ctx *sctx, const struct device *can_dev,
 	}
 
 	k_sem_init(&sctx->tx_sem, 0, 1);
+	atomic_set(&sctx->tx_backlog, 0);
 	sctx->can_dev = can_dev;
 	sctx->tx_addr = *tx_addr;
 	sctx->rx_addr = *rx_addr;
@@ -0,0 +1,165 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/debug/profiler.h>
+#include <zephyr/sys/util.h>
+#include <stdlib.h>
+
+static struct profiler_sample samples[CONFIG_PROFILER_SAMPLE_COUNT];
+static uint32_t sample_cnt;
+static uint32_t dropped_cnt;
+static bool running;
+static struct k_spinlock lock;
+
+static void sample_take(struct k_timer *timer)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* The timer fires on one CPU, the others are sampled at thread
+	 * level from what they are running at that time.
+	 */
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct profiler_sample *sample;
+
+		if (sample_cnt == ARRAY_SIZE(samples)) {
+			dropped_cnt += num_cpus - i;
+			break;
+		}
+
+		sample = &samples[sample_cnt++];
+		sample->thread = _kernel.cpus[i].current;
+		sample->cpu = i;
+		sample->depth = 0;
+
+#ifdef CONFIG_ARCH_HAS_PROFILER
+		if (i == arch_curr_cpu()->id) {
+			sample->depth = arch_profiler_pc_get(sample->pc,
+							     ARRAY_SIZE(sample->pc));
+		}
+#endif
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static K_TIMER_DEFINE(sample_timer, sample_take, NULL);
+
+int profiler_start(uint32_t frequency)
+{
+	k_timeout_t period;
+	k_spinlock_key_t key;
+
+	if ((frequency == 0U) || (frequency > CONFIG_SYS_CLOCK_TICKS_PER_SEC)) {
+		return -EINVAL;
+	}
+
+	period = K_TICKS(CONFIG_SYS_CLOCK_TICKS_PER_SEC / frequency);
+
+	key = k_spin_lock(&lock);
+	running = true;
+	k_spin_unlock(&lock, key);
+
+	k_timer_start(&sample_timer, period, period);
+
+	return 0;
+}
+
+void profiler_stop(void)
+{
+	k_spinlock_key_t key;
+
+	k_timer_stop(&sample_timer);
+
+	key = k_spin_lock(&lock);
+	running = false;
+	k_spin_unlock(&lock, key);
+}
+
+bool profiler_is_running(void)
+{
+	return running;
+}
+
+int profiler_reset(void)
+{
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (running) {
+		ret = -EBUSY;
+	} else {
+		sample_cnt = 0;
+		dropped_cnt = 0;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+uint32_t profiler_dropped_get(void)
+{
+	return dropped_cnt;
+}
+
+static int sample_cmp(const void *a, const void *b)
+{
+	const struct profiler_sample *sa = a;
+	const struct profiler_sample *sb = b;
+
+	if (sa->thread != sb->thread) {
+		return (uintptr_t)sa->thread < (uintptr_t)sb->thread ? -1 : 1;
+	}
+
+	if (sa->cpu != sb->cpu) {
+		return sa->cpu < sb->cpu ? -1 : 1;
+	}
+
+	if (sa->depth != sb->depth) {
+		return sa->depth < sb->depth ? -1 : 1;
+	}
+
+	for (size_t i = 0; i < sa->depth; i++) {
+		if (sa->pc[i] != sb->pc[i]) {
+			return sa->pc[i] < sb->pc[i] ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+int profiler_folded_foreach(profiler_folded_cb_t cb, void *user_data)
+{
+	uint32_t cnt;
+	uint32_t first = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (running) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	cnt = sample_cnt;
+	k_spin_unlock(&lock, key);
+
+	/* Sorting brings identical stacks next to each other */
+	qsort(samples, cnt, sizeof(samples[0]), sample_cmp);
+
+	for (uint32_t i = 1; i <= cnt; i++) {
+		if ((i == cnt) || (sample_cmp(&samples[first], &samples[i]) != 0)) {
+			cb(&samples[first], i - first, user_data);
+			first = i;
+		}
+	}
+
+	return (int)cnt;
+}
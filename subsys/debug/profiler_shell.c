@@ -0,0 +1,115 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler shell commands
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/debug/profiler.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_string_conv.h>
+
+static int cmd_profiler_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t frequency = 100;
+	int err = 0;
+
+	if (argc > 1) {
+		frequency = shell_strtoul(argv[1], 10, &err);
+		if (err != 0) {
+			shell_error(sh, "Unable to parse input (err %d)", err);
+			return err;
+		}
+	}
+
+	err = profiler_start(frequency);
+	if (err != 0) {
+		shell_error(sh, "Frequency must be 1 to %d Hz",
+			    CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+	}
+
+	return err;
+}
+
+static int cmd_profiler_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_stop();
+
+	return 0;
+}
+
+static int cmd_profiler_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	err = profiler_reset();
+	if (err != 0) {
+		shell_error(sh, "Profiler is running");
+	}
+
+	return err;
+}
+
+/* One line of folded stack: root first, frames separated by ';' */
+static void folded_print(const struct profiler_sample *sample, uint32_t count,
+			 void *user_data)
+{
+	const struct shell *sh = user_data;
+	const char *name = k_thread_name_get((k_tid_t)sample->thread);
+
+	if (IS_ENABLED(CONFIG_SMP)) {
+		shell_fprintf(sh, SHELL_NORMAL, "cpu%u;", sample->cpu);
+	}
+
+	if ((name != NULL) && (name[0] != '\0')) {
+		shell_fprintf(sh, SHELL_NORMAL, "%s", name);
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "%p", (void *)sample->thread);
+	}
+
+	for (size_t i = sample->depth; i > 0; i--) {
+		shell_fprintf(sh, SHELL_NORMAL, ";0x%lx", (unsigned long)sample->pc[i - 1]);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, " %u\n", count);
+}
+
+static int cmd_profiler_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ret = profiler_folded_foreach(folded_print, (void *)sh);
+	if (ret < 0) {
+		shell_error(sh, "Profiler is running");
+		return ret;
+	}
+
+	shell_print(sh, "# %d samples, %u dropped", ret, profiler_dropped_get());
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling or change frequency. [<Hz>]",
+		      cmd_profiler_start, 1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling.", cmd_profiler_stop),
+	SHELL_CMD(reset, NULL, "Drop the samples.", cmd_profiler_reset),
+	SHELL_CMD(dump, NULL, "Print the samples as folded stacks.", cmd_profiler_dump),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler commands", NULL);
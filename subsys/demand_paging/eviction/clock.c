@@ -0,0 +1,76 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock (second chance) eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/* The page frames form a circle swept by a hand. A frame accessed since the
+ * hand last passed gets its accessed bit cleared and is spared once; the
+ * first frame found not accessed is evicted. This approximates LRU without
+ * a periodic timer or any per-frame state, and the hand keeps its position
+ * between evictions so that every frame ages at the same pace.
+ */
+static size_t clock_hand;
+
+static inline struct z_page_frame *clock_advance(void)
+{
+	struct z_page_frame *pf = &z_page_frames[clock_hand];
+
+	clock_hand = (clock_hand + 1) % Z_NUM_PAGE_FRAMES;
+
+	return pf;
+}
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf, *last_pf = NULL;
+	uintptr_t flags;
+
+	/* After one full turn every evictable frame had its accessed bit
+	 * cleared, so the second turn finds a victim unless the pages are
+	 * accessed again meanwhile.
+	 */
+	for (size_t i = 0; i < 2 * Z_NUM_PAGE_FRAMES; i++) {
+		pf = clock_advance();
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, false);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) == 0UL) {
+			*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+			return pf;
+		}
+
+		/* Second chance: clear the accessed bit in page tables */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+		*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+		last_pf = pf;
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(last_pf != NULL, "no page to evict");
+
+	return last_pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
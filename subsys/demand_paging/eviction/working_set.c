@@ -0,0 +1,122 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Working set (WSClock) eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/* A periodic timer samples the accessed bit of every evictable page frame
+ * and records when each was last seen in use. Frames not used for more than
+ * CONFIG_EVICTION_WORKING_SET_WINDOW milliseconds are outside the working
+ * set and are evicted first, clean ones before dirty ones so that no page
+ * out is needed. Frames are visited by a clock hand so that victims rotate.
+ * If the whole memory is in the working set, the least recently used frame
+ * seen is evicted.
+ */
+static uint32_t last_used[Z_NUM_PAGE_FRAMES];
+static size_t ws_hand;
+
+/* Returns the page table flags of the frame, after updating its last use */
+static uintptr_t ws_sample(struct z_page_frame *pf, uint32_t now)
+{
+	uintptr_t flags = arch_page_info_get(pf->addr, NULL, false);
+
+	if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+		last_used[pf - z_page_frames] = now;
+
+		/* Clear accessed bit in page tables */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+	}
+
+	return flags;
+}
+
+static void ws_periodic_update(struct k_timer *timer)
+{
+	uintptr_t phys;
+	struct z_page_frame *pf;
+	uint32_t now = k_uptime_get_32();
+	unsigned int key = irq_lock();
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		(void)ws_sample(pf, now);
+	}
+
+	irq_unlock(key);
+}
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	uint32_t now = k_uptime_get_32();
+	struct z_page_frame *pf, *dirty_pf = NULL, *oldest_pf = NULL;
+	bool oldest_dirty = false;
+	uint32_t age, oldest_age = 0U;
+	uintptr_t flags;
+	bool dirty;
+
+	for (size_t i = 0; i < Z_NUM_PAGE_FRAMES; i++) {
+		pf = &z_page_frames[ws_hand];
+		ws_hand = (ws_hand + 1) % Z_NUM_PAGE_FRAMES;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = ws_sample(pf, now);
+
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+		age = now - last_used[pf - z_page_frames];
+
+		if (age > CONFIG_EVICTION_WORKING_SET_WINDOW) {
+			if (!dirty) {
+				*dirty_ptr = false;
+				return pf;
+			}
+
+			if (dirty_pf == NULL) {
+				dirty_pf = pf;
+			}
+		}
+
+		if (oldest_pf == NULL || age > oldest_age) {
+			oldest_pf = pf;
+			oldest_age = age;
+			oldest_dirty = dirty;
+		}
+	}
+
+	if (dirty_pf != NULL) {
+		*dirty_ptr = true;
+		return dirty_pf;
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(oldest_pf != NULL, "no page to evict");
+
+	*dirty_ptr = oldest_dirty;
+
+	return oldest_pf;
+}
+
+static K_TIMER_DEFINE(ws_timer, ws_periodic_update, NULL);
+
+void k_mem_paging_eviction_init(void)
+{
+	k_timer_start(&ws_timer, K_NO_WAIT,
+		      K_MSEC(CONFIG_EVICTION_WORKING_SET_PERIOD));
+}
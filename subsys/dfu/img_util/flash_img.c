@@ -5,6 +5,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <errno.h>
 #include <zephyr/types.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -13,6 +14,14 @@
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/storage/stream_flash.h>
 
+#if defined(CONFIG_IMG_STREAM_HASH) && defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+#include <tinycrypt/constants.h>
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_PROGRESS
+#include <zephyr/settings/settings.h>
+#endif
+
 #ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
 #include <bootutil/bootutil_public.h>
 #include <zephyr/dfu/mcuboot.h>
@@ -43,12 +52,89 @@ BUILD_ASSERT((CONFIG_IMG_BLOCK_BUF_SIZE % FLASH_WRITE_BLOCK_SIZE == 0),
 	     "FLASH_WRITE_BLOCK_SIZE");
 #endif
 
+#if defined(CONFIG_IMG_STREAM_HASH)
+#define FLASH_IMG_SHA256_SIZE 32
+
+static void flash_img_hash_init(struct flash_img_context *ctx)
+{
+	ctx->sha_len = 0;
+
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	if (tc_sha256_init(&ctx->sha) != TC_CRYPTO_SUCCESS) {
+		ctx->sha_len = SIZE_MAX;
+	}
+#else
+	mbedtls_sha256_init(&ctx->sha);
+	if (mbedtls_sha256_starts(&ctx->sha, 0) != 0) {
+		ctx->sha_len = SIZE_MAX;
+	}
+#endif
+}
+
+static void flash_img_hash_update(struct flash_img_context *ctx,
+				  const uint8_t *data, size_t len)
+{
+	if (ctx->sha_len == SIZE_MAX || len == 0) {
+		return;
+	}
+
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	if (tc_sha256_update(&ctx->sha, data, len) != TC_CRYPTO_SUCCESS) {
+		ctx->sha_len = SIZE_MAX;
+		return;
+	}
+#else
+	if (mbedtls_sha256_update(&ctx->sha, data, len) != 0) {
+		ctx->sha_len = SIZE_MAX;
+		return;
+	}
+#endif
+
+	ctx->sha_len += len;
+}
+
+/*
+ * Hash the bytes the stream hands to the flash in a write: the ones it has
+ * buffered, followed by as much of data as fills whole buffers, or all of it
+ * on a flush. The bytes left in the buffer are hashed when they leave it, so
+ * that the hash follows the progress of the stream, which can be saved.
+ */
+static void flash_img_hash_write(struct flash_img_context *ctx,
+				 const uint8_t *data, size_t len, bool flush)
+{
+	struct stream_flash_ctx *stream = &ctx->stream;
+	size_t bytes = stream->buf_bytes + len;
+
+	if (!flush) {
+		bytes -= bytes % stream->buf_len;
+	}
+
+	if (bytes == 0) {
+		return;
+	}
+
+	flash_img_hash_update(ctx, stream->buf, stream->buf_bytes);
+	flash_img_hash_update(ctx, data, bytes - stream->buf_bytes);
+}
+#endif /* CONFIG_IMG_STREAM_HASH */
+
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 			     size_t len, bool flush)
 {
 	int rc;
 
+#if defined(CONFIG_IMG_STREAM_HASH)
+	flash_img_hash_write(ctx, data, len, flush);
+#endif
+
 	rc = stream_flash_buffered_write(&ctx->stream, data, len, flush);
+
+#if defined(CONFIG_IMG_STREAM_HASH)
+	if (rc != 0) {
+		ctx->sha_len = SIZE_MAX;
+	}
+#endif
+
 	if (!flush) {
 		return rc;
 	}
@@ -88,9 +174,21 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 
 	flash_dev = flash_area_get_device(ctx->flash_area);
 
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	if (rc == 0) {
+		rc = stream_flash_double_buffer_enable(&ctx->stream, ctx->buf2);
+	}
+#endif
+
+#if defined(CONFIG_IMG_STREAM_HASH)
+	flash_img_hash_init(ctx);
+#endif
+
+	return rc;
 }
 
 int flash_img_init(struct flash_img_context *ctx)
@@ -130,3 +228,175 @@ int flash_img_check(struct flash_img_context *ctx,
 	return rc;
 }
 #endif
+
+#if defined(CONFIG_IMG_STREAM_HASH)
+int flash_img_check_written(struct flash_img_context *ctx,
+			    const struct flash_img_check *fic)
+{
+	uint8_t hash[FLASH_IMG_SHA256_SIZE];
+	int rc = 0;
+
+	if (!ctx || !fic || !fic->match) {
+		return -EINVAL;
+	}
+
+	if (fic->clen == 0 || ctx->sha_len != fic->clen) {
+		return -ENODATA;
+	}
+
+	/* Finish a copy, the context can be checked again */
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	struct tc_sha256_state_struct sha = ctx->sha;
+
+	if (tc_sha256_final(hash, &sha) != TC_CRYPTO_SUCCESS) {
+		return -ESRCH;
+	}
+#else
+	mbedtls_sha256_context sha;
+
+	mbedtls_sha256_init(&sha);
+	mbedtls_sha256_clone(&sha, &ctx->sha);
+	if (mbedtls_sha256_finish(&sha, hash) != 0) {
+		rc = -ESRCH;
+	}
+	mbedtls_sha256_free(&sha);
+	if (rc != 0) {
+		return rc;
+	}
+#endif
+
+	if (memcmp(hash, fic->match, sizeof(hash)) != 0) {
+		rc = -EILSEQ;
+	}
+
+	return rc;
+}
+#endif /* CONFIG_IMG_STREAM_HASH */
+
+#if defined(CONFIG_STREAM_FLASH_PROGRESS)
+#if defined(CONFIG_IMG_STREAM_HASH)
+struct flash_img_hash_progress {
+	size_t len;
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	struct tc_sha256_state_struct sha;
+#else
+	mbedtls_sha256_context sha;
+#endif
+};
+
+static int flash_img_hash_key(char *key, size_t size, const char *settings_key)
+{
+	int len = snprintf(key, size, "%s/sha", settings_key);
+
+	return (len < 0 || len >= size) ? -ENAMETOOLONG : 0;
+}
+
+static int flash_img_hash_loader(const char *key, size_t len,
+				 settings_read_cb read_cb, void *cb_arg,
+				 void *param)
+{
+	struct flash_img_context *ctx = (struct flash_img_context *)param;
+	struct flash_img_hash_progress progress;
+
+	if (settings_name_next(key, NULL) != 0) {
+		return 0;
+	}
+
+	/* A hash that is not the one of the data written is not used */
+	if (read_cb(cb_arg, &progress, sizeof(progress)) == sizeof(progress) &&
+	    progress.len == stream_flash_bytes_written(&ctx->stream)) {
+		ctx->sha = progress.sha;
+		ctx->sha_len = progress.len;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_IMG_STREAM_HASH */
+
+int flash_img_progress_load(struct flash_img_context *ctx,
+			    const char *settings_key)
+{
+	int rc;
+
+	if (!ctx || !settings_key) {
+		return -EFAULT;
+	}
+
+	rc = stream_flash_progress_load(&ctx->stream, settings_key);
+
+#if defined(CONFIG_IMG_STREAM_HASH)
+	if (rc != 0 || ctx->sha_len == stream_flash_bytes_written(&ctx->stream)) {
+		return rc;
+	}
+
+	char key[SETTINGS_MAX_NAME_LEN + 1];
+
+	/* Without its hash, the data written before can only be read back */
+	ctx->sha_len = SIZE_MAX;
+
+	rc = flash_img_hash_key(key, sizeof(key), settings_key);
+	if (rc == 0) {
+		rc = settings_load_subtree_direct(key, flash_img_hash_loader, ctx);
+	}
+#endif
+
+	return rc;
+}
+
+int flash_img_progress_save(struct flash_img_context *ctx,
+			    const char *settings_key)
+{
+	int rc;
+
+	if (!ctx || !settings_key) {
+		return -EFAULT;
+	}
+
+	rc = stream_flash_progress_save(&ctx->stream, settings_key);
+
+#if defined(CONFIG_IMG_STREAM_HASH)
+	/* The hash runs ahead while a buffer is written in the background */
+	if (rc != 0 || ctx->sha_len != stream_flash_bytes_written(&ctx->stream)) {
+		return rc;
+	}
+
+	struct flash_img_hash_progress progress = {
+		.len = ctx->sha_len,
+		.sha = ctx->sha,
+	};
+	char key[SETTINGS_MAX_NAME_LEN + 1];
+
+	rc = flash_img_hash_key(key, sizeof(key), settings_key);
+	if (rc == 0) {
+		rc = settings_save_one(key, &progress, sizeof(progress));
+	}
+#endif
+
+	return rc;
+}
+
+int flash_img_progress_clear(struct flash_img_context *ctx,
+			     const char *settings_key)
+{
+	int rc;
+
+	if (!ctx || !settings_key) {
+		return -EFAULT;
+	}
+
+	rc = stream_flash_progress_clear(&ctx->stream, settings_key);
+
+#if defined(CONFIG_IMG_STREAM_HASH)
+	char key[SETTINGS_MAX_NAME_LEN + 1];
+
+	if (rc == 0) {
+		rc = flash_img_hash_key(key, sizeof(key), settings_key);
+	}
+	if (rc == 0) {
+		rc = settings_delete(key);
+	}
+#endif
+
+	return rc;
+}
+#endif /* CONFIG_STREAM_FLASH_PROGRESS */
@@ -13,6 +13,8 @@
 #include <errno.h>
 #include <zephyr/device.h>
 
+#include "disk_cache.h"
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -60,7 +62,12 @@ int disk_access_init(const char *pdrv)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->init != NULL)) {
+		k_mutex_lock(&disk->lock, K_FOREVER);
 		rc = disk->ops->init(disk);
+		if ((rc == 0) && !disk_cache_is_attached(disk)) {
+			(void)disk_cache_attach(disk);
+		}
+		k_mutex_unlock(&disk->lock);
 	}
 
 	return rc;
@@ -73,40 +80,191 @@ int disk_access_status(const char *pdrv)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->status != NULL)) {
+		k_mutex_lock(&disk->lock, K_FOREVER);
 		rc = disk->ops->status(disk);
+		k_mutex_unlock(&disk->lock);
 	}
 
 	return rc;
 }
 
-int disk_access_read(const char *pdrv, uint8_t *data_buf,
+static int disk_read(struct disk_info *disk, uint8_t *data_buf,
 		     uint32_t start_sector, uint32_t num_sector)
 {
-	struct disk_info *disk = disk_access_get_di(pdrv);
 	int rc = -EINVAL;
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
-		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		k_mutex_lock(&disk->lock, K_FOREVER);
+		if (disk_cache_is_attached(disk)) {
+			rc = disk_cache_read(disk, data_buf, start_sector, num_sector);
+		} else {
+			rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		}
+		k_mutex_unlock(&disk->lock);
 	}
 
 	return rc;
 }
 
-int disk_access_write(const char *pdrv, const uint8_t *data_buf,
+static int disk_write(struct disk_info *disk, const uint8_t *data_buf,
 		      uint32_t start_sector, uint32_t num_sector)
 {
-	struct disk_info *disk = disk_access_get_di(pdrv);
 	int rc = -EINVAL;
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
-		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		k_mutex_lock(&disk->lock, K_FOREVER);
+		if (disk_cache_is_attached(disk)) {
+			rc = disk_cache_write(disk, data_buf, start_sector, num_sector);
+		} else {
+			rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		}
+		k_mutex_unlock(&disk->lock);
 	}
 
 	return rc;
 }
 
+int disk_access_read(const char *pdrv, uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	return disk_read(disk_access_get_di(pdrv), data_buf, start_sector, num_sector);
+}
+
+int disk_access_write(const char *pdrv, const uint8_t *data_buf,
+		      uint32_t start_sector, uint32_t num_sector)
+{
+	return disk_write(disk_access_get_di(pdrv), data_buf, start_sector, num_sector);
+}
+
+#ifdef CONFIG_DISK_ACCESS_ASYNC
+/* Requests waiting for the async work queue, in submission order */
+static sys_dlist_t async_queue = SYS_DLIST_STATIC_INIT(&async_queue);
+static struct k_spinlock async_lock;
+static struct k_work_q async_work_q;
+static K_KERNEL_STACK_DEFINE(async_stack, CONFIG_DISK_ACCESS_ASYNC_STACK_SIZE);
+
+static struct disk_access_req *async_queue_get(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&async_lock);
+	sys_dnode_t *node = sys_dlist_get(&async_queue);
+
+	k_spin_unlock(&async_lock, key);
+
+	return (node != NULL) ? CONTAINER_OF(node, struct disk_access_req, node) : NULL;
+}
+
+/*
+ * Take the requests that directly follow req in the queue and continue it:
+ * same disk and operation, next sectors, and next bytes of memory. Return
+ * the number of sectors of the requests put together.
+ */
+static uint32_t async_queue_merge(struct disk_access_req *req, size_t sector_size)
+{
+	uint32_t num_sector = req->num_sector;
+	struct disk_access_req *last = req, *next;
+	k_spinlock_key_t key;
+
+	req->next_merged = NULL;
+
+	key = k_spin_lock(&async_lock);
+	while ((next = SYS_DLIST_PEEK_HEAD_CONTAINER(&async_queue, next, node)) != NULL) {
+		if ((next->disk != req->disk) || (next->op != req->op) ||
+		    (next->start_sector != req->start_sector + num_sector) ||
+		    (next->buf != req->buf + num_sector * sector_size) ||
+		    (num_sector + next->num_sector > CONFIG_DISK_ACCESS_ASYNC_MAX_MERGE)) {
+			break;
+		}
+
+		sys_dlist_remove(&next->node);
+		next->next_merged = NULL;
+		last->next_merged = next;
+		last = next;
+		num_sector += next->num_sector;
+	}
+	k_spin_unlock(&async_lock, key);
+
+	return num_sector;
+}
+
+static void async_work_handler(struct k_work *work)
+{
+	struct disk_access_req *req, *next;
+	uint32_t sector_size;
+	uint32_t num_sector;
+	int rc;
+
+	while ((req = async_queue_get()) != NULL) {
+		num_sector = req->num_sector;
+
+		if ((req->disk->ops->ioctl != NULL) &&
+		    (req->disk->ops->ioctl(req->disk, DISK_IOCTL_GET_SECTOR_SIZE,
+					   &sector_size) == 0)) {
+			num_sector = async_queue_merge(req, sector_size);
+		} else {
+			req->next_merged = NULL;
+		}
+
+		if (req->op == DISK_ACCESS_REQ_READ) {
+			rc = disk_read(req->disk, req->buf, req->start_sector, num_sector);
+		} else {
+			rc = disk_write(req->disk, req->buf, req->start_sector, num_sector);
+		}
+
+		/* A callback can submit the request again, which relinks it */
+		for (; req != NULL; req = next) {
+			next = req->next_merged;
+			req->cb(req, rc);
+		}
+	}
+}
+
+static K_WORK_DEFINE(async_work, async_work_handler);
+
+int disk_access_submit(const char *pdrv, struct disk_access_req *req)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+	k_spinlock_key_t key;
+	int rc;
+
+	if ((disk == NULL) || (disk->ops == NULL) || (req == NULL) || (req->cb == NULL) ||
+	    ((req->op != DISK_ACCESS_REQ_READ) && (req->op != DISK_ACCESS_REQ_WRITE))) {
+		return -EINVAL;
+	}
+
+	req->disk = disk;
+
+	/* Drivers that queue requests themselves, unless the cache is in the way */
+	if ((disk->ops->submit != NULL) && !disk_cache_is_attached(disk)) {
+		k_mutex_lock(&disk->lock, K_FOREVER);
+		rc = disk->ops->submit(disk, req);
+		k_mutex_unlock(&disk->lock);
+
+		return rc;
+	}
+
+	key = k_spin_lock(&async_lock);
+	sys_dlist_append(&async_queue, &req->node);
+	k_spin_unlock(&async_lock, key);
+
+	(void)k_work_submit_to_queue(&async_work_q, &async_work);
+
+	return 0;
+}
+
+static int disk_access_async_init(void)
+{
+	k_work_queue_start(&async_work_q, async_stack, K_KERNEL_STACK_SIZEOF(async_stack),
+			   CONFIG_DISK_ACCESS_ASYNC_PRIORITY, NULL);
+	k_thread_name_set(&async_work_q.thread, "disk_async");
+
+	return 0;
+}
+
+SYS_INIT(disk_access_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_DISK_ACCESS_ASYNC */
+
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 {
 	struct disk_info *disk = disk_access_get_di(pdrv);
@@ -114,7 +272,17 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
-		rc = disk->ops->ioctl(disk, cmd, buf);
+		k_mutex_lock(&disk->lock, K_FOREVER);
+		rc = 0;
+		/* The storage has to be up to date to be read in place */
+		if (((cmd == DISK_IOCTL_CTRL_SYNC) || (cmd == DISK_IOCTL_GET_SECTOR_MAP)) &&
+		    disk_cache_is_attached(disk)) {
+			rc = disk_cache_sync(disk);
+		}
+		if (rc == 0) {
+			rc = disk->ops->ioctl(disk, cmd, buf);
+		}
+		k_mutex_unlock(&disk->lock);
 	}
 
 	return rc;
@@ -137,6 +305,8 @@ int disk_access_register(struct disk_info *disk)
 		goto reg_err;
 	}
 
+	k_mutex_init(&disk->lock);
+
 	/*  append to the disk list */
 	sys_dlist_append(&disk_access_list, &disk->node);
 	LOG_DBG("disk interface(%s) registered", disk->name);
@@ -161,6 +331,12 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+	if (disk_cache_is_attached(disk)) {
+		k_mutex_lock(&disk->lock, K_FOREVER);
+		(void)disk_cache_detach(disk);
+		k_mutex_unlock(&disk->lock);
+	}
+
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistered", disk->name);
@@ -0,0 +1,365 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/storage/disk_access.h>
+
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+#define BLOCK_SIZE CONFIG_DISK_CACHE_BLOCK_SIZE
+
+/* Requests of more sectors than this bypass the cache */
+#define BYPASS_SECTORS (CONFIG_DISK_CACHE_BLOCKS / 2)
+
+struct disk_cache_block {
+	/* Node in the LRU list, if the block is used */
+	sys_dnode_t node;
+	/* Disk of the cached sector, NULL if the block is free */
+	struct disk_info *disk;
+	uint32_t sector;
+	/* Sector modified since it was last written to the disk */
+	bool dirty;
+};
+
+static struct disk_cache_block blocks[CONFIG_DISK_CACHE_BLOCKS];
+static uint8_t __aligned(CONFIG_DISK_CACHE_BUFFER_ALIGNMENT)
+	block_data[CONFIG_DISK_CACHE_BLOCKS][BLOCK_SIZE];
+
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+static uint8_t __aligned(CONFIG_DISK_CACHE_BUFFER_ALIGNMENT)
+	read_ahead_buf[CONFIG_DISK_CACHE_READ_AHEAD * BLOCK_SIZE];
+#endif
+
+/* Used blocks, least recently used first */
+static sys_dlist_t lru = SYS_DLIST_STATIC_INIT(&lru);
+
+/*
+ * Taken with the lock of a disk held. A block is only written back while the
+ * lock of its disk is held, so that the cache never calls the driver of
+ * another disk.
+ */
+static K_MUTEX_DEFINE(cache_lock);
+
+static inline uint8_t *block_buf(struct disk_cache_block *block)
+{
+	return block_data[block - blocks];
+}
+
+static struct disk_cache_block *cache_find(struct disk_info *disk, uint32_t sector)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && (blocks[i].sector == sector)) {
+			return &blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void cache_touch(struct disk_cache_block *block)
+{
+	sys_dlist_remove(&block->node);
+	sys_dlist_append(&lru, &block->node);
+}
+
+static void cache_drop(struct disk_cache_block *block)
+{
+	sys_dlist_remove(&block->node);
+	block->disk = NULL;
+	block->dirty = false;
+}
+
+static int cache_write_back(struct disk_cache_block *block)
+{
+	int rc;
+
+	rc = block->disk->ops->write(block->disk, block_buf(block), block->sector, 1);
+	if (rc == 0) {
+		block->dirty = false;
+	} else {
+		LOG_ERR("%s: write back of sector %u failed (%d)", block->disk->name,
+			block->sector, rc);
+	}
+
+	return rc;
+}
+
+/*
+ * Get a block for a sector that is not cached: a free block, or else the
+ * least recently used one that is clean or belongs to the disk. A dirty block
+ * is written back first, unless clean_only is set. NULL if there is none, or
+ * if the write back fails, with rc set.
+ */
+static struct disk_cache_block *cache_alloc(struct disk_info *disk, uint32_t sector,
+					    bool clean_only, int *rc)
+{
+	struct disk_cache_block *block = NULL, *itr;
+
+	*rc = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if (blocks[i].disk == NULL) {
+			block = &blocks[i];
+			break;
+		}
+	}
+
+	if (block == NULL) {
+		SYS_DLIST_FOR_EACH_CONTAINER(&lru, itr, node) {
+			if (!itr->dirty || (!clean_only && (itr->disk == disk))) {
+				block = itr;
+				break;
+			}
+		}
+
+		if (block == NULL) {
+			return NULL;
+		}
+
+		if (block->dirty) {
+			*rc = cache_write_back(block);
+			if (*rc) {
+				return NULL;
+			}
+		}
+
+		sys_dlist_remove(&block->node);
+	}
+
+	block->disk = disk;
+	block->sector = sector;
+	block->dirty = false;
+	sys_dlist_append(&lru, &block->node);
+
+	return block;
+}
+
+/* Best effort read of the sectors that follow a sequential read */
+static void cache_read_ahead(struct disk_info *disk, uint32_t sector)
+{
+#if CONFIG_DISK_CACHE_READ_AHEAD > 0
+	struct disk_cache_block *block;
+	uint32_t n;
+	int rc;
+
+	if (sector >= disk->cache_sector_count) {
+		return;
+	}
+
+	/* Up to the first sector that is already cached */
+	n = MIN(CONFIG_DISK_CACHE_READ_AHEAD, disk->cache_sector_count - sector);
+	for (uint32_t i = 0; i < n; i++) {
+		if (cache_find(disk, sector + i) != NULL) {
+			n = i;
+			break;
+		}
+	}
+
+	if ((n == 0) || disk->ops->read(disk, read_ahead_buf, sector, n)) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < n; i++) {
+		block = cache_alloc(disk, sector + i, true, &rc);
+		if (block == NULL) {
+			break;
+		}
+		memcpy(block_buf(block), &read_ahead_buf[i * BLOCK_SIZE], BLOCK_SIZE);
+	}
+#endif
+}
+
+int disk_cache_attach(struct disk_info *disk)
+{
+	uint32_t sector_size;
+	uint32_t sector_count;
+	int rc;
+
+	if (disk->ops->ioctl == NULL) {
+		return -ENOTSUP;
+	}
+
+	rc = disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size);
+	if (rc) {
+		return rc;
+	}
+
+	if (sector_size != BLOCK_SIZE) {
+		LOG_DBG("%s: sector size %u is not cached", disk->name, sector_size);
+		return -ENOTSUP;
+	}
+
+	rc = disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT, &sector_count);
+	if (rc) {
+		return rc;
+	}
+
+	if ((disk->ops->read == NULL) || (disk->ops->write == NULL)) {
+		return -ENOTSUP;
+	}
+
+	disk->cache_next_sector = 0;
+	disk->cache_sector_count = sector_count;
+
+	return 0;
+}
+
+int disk_cache_detach(struct disk_info *disk)
+{
+	int rc;
+
+	rc = disk_cache_sync(disk);
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if (blocks[i].disk == disk) {
+			cache_drop(&blocks[i]);
+		}
+	}
+	k_mutex_unlock(&cache_lock);
+
+	disk->cache_sector_count = 0;
+
+	return rc;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *block;
+	uint32_t n;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (uint32_t i = 0; i < num_sector; i += n) {
+		block = cache_find(disk, start_sector + i);
+		if (block != NULL) {
+			memcpy(&data_buf[i * BLOCK_SIZE], block_buf(block), BLOCK_SIZE);
+			cache_touch(block);
+			n = 1;
+			continue;
+		}
+
+		/* Read the sectors that are not cached with a single request */
+		for (n = 1; (i + n < num_sector) &&
+			    (cache_find(disk, start_sector + i + n) == NULL); n++) {
+		}
+
+		rc = disk->ops->read(disk, &data_buf[i * BLOCK_SIZE], start_sector + i, n);
+		if (rc) {
+			goto out;
+		}
+
+		if (n > BYPASS_SECTORS) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j < n; j++) {
+			block = cache_alloc(disk, start_sector + i + j, false, &rc);
+			if (block == NULL) {
+				if (rc) {
+					goto out;
+				}
+				break;
+			}
+			memcpy(block_buf(block), &data_buf[(i + j) * BLOCK_SIZE], BLOCK_SIZE);
+		}
+	}
+
+	if (start_sector == disk->cache_next_sector) {
+		cache_read_ahead(disk, start_sector + num_sector);
+	}
+	disk->cache_next_sector = start_sector + num_sector;
+
+out:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *block;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (num_sector > BYPASS_SECTORS) {
+		/* The cached copies are overwritten, so they are dropped */
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		if (rc == 0) {
+			for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+				if ((blocks[i].disk == disk) &&
+				    (blocks[i].sector - start_sector < num_sector)) {
+					cache_drop(&blocks[i]);
+				}
+			}
+		}
+		goto out;
+	}
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		const uint8_t *src = &data_buf[i * BLOCK_SIZE];
+
+		block = cache_find(disk, start_sector + i);
+		if (block == NULL) {
+			block = cache_alloc(disk, start_sector + i, false, &rc);
+		}
+
+		if (block == NULL) {
+			if (rc) {
+				goto out;
+			}
+
+			/* Every block holds modified sectors of other disks */
+			rc = disk->ops->write(disk, src, start_sector + i, 1);
+			if (rc) {
+				goto out;
+			}
+			continue;
+		}
+
+		memcpy(block_buf(block), src, BLOCK_SIZE);
+		block->dirty = true;
+		cache_touch(block);
+	}
+
+out:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc = 0;
+	int rc2;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	/* Keep writing back the other sectors after an error */
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && blocks[i].dirty) {
+			rc2 = cache_write_back(&blocks[i]);
+			if (rc == 0) {
+				rc = rc2;
+			}
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
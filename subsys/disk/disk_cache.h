@@ -0,0 +1,77 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <errno.h>
+#include <stdbool.h>
+#include <zephyr/drivers/disk.h>
+
+/*
+ * Block cache of the disk access layer. All the functions are called with
+ * the lock of the disk held.
+ */
+
+#ifdef CONFIG_DISK_CACHE
+
+static inline bool disk_cache_is_attached(struct disk_info *disk)
+{
+	return disk->cache_sector_count != 0;
+}
+
+/* Start caching an initialized disk, if its sector size is the cached one */
+int disk_cache_attach(struct disk_info *disk);
+
+/* Write back and drop the sectors of the disk, and stop caching it */
+int disk_cache_detach(struct disk_info *disk);
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+
+/* Write back the modified sectors of the disk */
+int disk_cache_sync(struct disk_info *disk);
+
+#else
+
+static inline bool disk_cache_is_attached(struct disk_info *disk)
+{
+	return false;
+}
+
+static inline int disk_cache_attach(struct disk_info *disk)
+{
+	return -ENOTSUP;
+}
+
+static inline int disk_cache_detach(struct disk_info *disk)
+{
+	return -ENOTSUP;
+}
+
+static inline int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+				  uint32_t start_sector, uint32_t num_sector)
+{
+	return -ENOTSUP;
+}
+
+static inline int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+				   uint32_t start_sector, uint32_t num_sector)
+{
+	return -ENOTSUP;
+}
+
+static inline int disk_cache_sync(struct disk_info *disk)
+{
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_DISK_CACHE */
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
@@ -0,0 +1,509 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Basic math kernels of the native backend. Each kernel is a single loop
+ * without branches on the data, with saturation done by clamping a wider
+ * intermediate, so that the compiler vectorizes it for the SIMD extension of
+ * the target (RISC-V V, Xtensa HiFi, ...). The fixed-point results are bit
+ * exact with those of CMSIS-DSP.
+ */
+
+#include <math.h>
+
+#include <zephyr/dsp/dsp.h>
+#include <zephyr/sys/util.h>
+
+/* Partial sums of the floating-point dot product, so that the additions do
+ * not all depend on each other.
+ */
+#define DOT_PROD_LANES 4
+
+static inline q7_t sat_q7(int32_t x)
+{
+	return (q7_t)CLAMP(x, INT8_MIN, INT8_MAX);
+}
+
+static inline q15_t sat_q15(int32_t x)
+{
+	return (q15_t)CLAMP(x, INT16_MIN, INT16_MAX);
+}
+
+static inline q31_t sat_q31(q63_t x)
+{
+	return (q31_t)CLAMP(x, INT32_MIN, INT32_MAX);
+}
+
+void zdsp_mult_q7(const DSP_DATA q7_t *src_a, const DSP_DATA q7_t *src_b, DSP_DATA q7_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q7(((int32_t)src_a[i] * src_b[i]) >> 7);
+	}
+}
+
+void zdsp_mult_q15(const DSP_DATA q15_t *src_a, const DSP_DATA q15_t *src_b, DSP_DATA q15_t *dst,
+		   uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q15(((int32_t)src_a[i] * src_b[i]) >> 15);
+	}
+}
+
+void zdsp_mult_q31(const DSP_DATA q31_t *src_a, const DSP_DATA q31_t *src_b, DSP_DATA q31_t *dst,
+		   uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		q63_t prod = ((q63_t)src_a[i] * src_b[i]) >> 32;
+
+		/* Only -1 * -1 does not fit, keep the top bit for the sign */
+		dst[i] = (q31_t)CLAMP(prod, INT32_MIN / 2, INT32_MAX / 2) * 2;
+	}
+}
+
+void zdsp_mult_f32(const DSP_DATA float32_t *src_a, const DSP_DATA float32_t *src_b,
+		   DSP_DATA float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] * src_b[i];
+	}
+}
+
+void zdsp_add_f32(const DSP_DATA float32_t *src_a, const DSP_DATA float32_t *src_b,
+		  DSP_DATA float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] + src_b[i];
+	}
+}
+
+void zdsp_add_q7(const DSP_DATA q7_t *src_a, const DSP_DATA q7_t *src_b, DSP_DATA q7_t *dst,
+		 uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q7((int32_t)src_a[i] + src_b[i]);
+	}
+}
+
+void zdsp_add_q15(const DSP_DATA q15_t *src_a, const DSP_DATA q15_t *src_b, DSP_DATA q15_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q15((int32_t)src_a[i] + src_b[i]);
+	}
+}
+
+void zdsp_add_q31(const DSP_DATA q31_t *src_a, const DSP_DATA q31_t *src_b, DSP_DATA q31_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q31((q63_t)src_a[i] + src_b[i]);
+	}
+}
+
+void zdsp_sub_f32(const DSP_DATA float32_t *src_a, const DSP_DATA float32_t *src_b,
+		  DSP_DATA float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] - src_b[i];
+	}
+}
+
+void zdsp_sub_q7(const DSP_DATA q7_t *src_a, const DSP_DATA q7_t *src_b, DSP_DATA q7_t *dst,
+		 uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q7((int32_t)src_a[i] - src_b[i]);
+	}
+}
+
+void zdsp_sub_q15(const DSP_DATA q15_t *src_a, const DSP_DATA q15_t *src_b, DSP_DATA q15_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q15((int32_t)src_a[i] - src_b[i]);
+	}
+}
+
+void zdsp_sub_q31(const DSP_DATA q31_t *src_a, const DSP_DATA q31_t *src_b, DSP_DATA q31_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q31((q63_t)src_a[i] - src_b[i]);
+	}
+}
+
+void zdsp_scale_f32(const DSP_DATA float32_t *src, float32_t scale, DSP_DATA float32_t *dst,
+		    uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src[i] * scale;
+	}
+}
+
+void zdsp_scale_q7(const DSP_DATA q7_t *src, q7_t scale_fract, int8_t shift, DSP_DATA q7_t *dst,
+		   uint32_t block_size)
+{
+	int8_t k_shift = 7 - shift;
+
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q7(((int32_t)src[i] * scale_fract) >> k_shift);
+	}
+}
+
+void zdsp_scale_q15(const DSP_DATA q15_t *src, q15_t scale_fract, int8_t shift,
+		    DSP_DATA q15_t *dst, uint32_t block_size)
+{
+	int8_t k_shift = 15 - shift;
+
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q15(((int32_t)src[i] * scale_fract) >> k_shift);
+	}
+}
+
+void zdsp_scale_q31(const DSP_DATA q31_t *src, q31_t scale_fract, int8_t shift,
+		    DSP_DATA q31_t *dst, uint32_t block_size)
+{
+	int8_t k_shift = shift + 1;
+
+	if (k_shift >= 0) {
+		/* Any non-zero value saturates past 32 bits of shift */
+		k_shift = MIN(k_shift, 32);
+
+		for (uint32_t i = 0; i < block_size; i++) {
+			q63_t prod = ((q63_t)src[i] * scale_fract) >> 32;
+
+			dst[i] = sat_q31(prod << k_shift);
+		}
+	} else {
+		for (uint32_t i = 0; i < block_size; i++) {
+			dst[i] = (q31_t)((((q63_t)src[i] * scale_fract) >> 32) >> -k_shift);
+		}
+	}
+}
+
+void zdsp_abs_f32(const DSP_DATA float32_t *src, DSP_DATA float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = fabsf(src[i]);
+	}
+}
+
+void zdsp_abs_q7(const DSP_DATA q7_t *src, DSP_DATA q7_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		int32_t in = src[i];
+
+		dst[i] = sat_q7(in > 0 ? in : -in);
+	}
+}
+
+void zdsp_abs_q15(const DSP_DATA q15_t *src, DSP_DATA q15_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		int32_t in = src[i];
+
+		dst[i] = sat_q15(in > 0 ? in : -in);
+	}
+}
+
+void zdsp_abs_q31(const DSP_DATA q31_t *src, DSP_DATA q31_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		q63_t in = src[i];
+
+		dst[i] = sat_q31(in > 0 ? in : -in);
+	}
+}
+
+void zdsp_dot_prod_f32(const DSP_DATA float32_t *src_a, const DSP_DATA float32_t *src_b,
+		       uint32_t block_size, DSP_DATA float32_t *result)
+{
+	float32_t sum[DOT_PROD_LANES] = {0};
+	uint32_t i = 0;
+
+	for (; i + DOT_PROD_LANES <= block_size; i += DOT_PROD_LANES) {
+		for (uint32_t j = 0; j < DOT_PROD_LANES; j++) {
+			sum[j] += src_a[i + j] * src_b[i + j];
+		}
+	}
+
+	for (; i < block_size; i++) {
+		sum[0] += src_a[i] * src_b[i];
+	}
+
+	*result = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+void zdsp_dot_prod_q7(const DSP_DATA q7_t *src_a, const DSP_DATA q7_t *src_b, uint32_t block_size,
+		      DSP_DATA q31_t *result)
+{
+	q31_t sum = 0;
+
+	for (uint32_t i = 0; i < block_size; i++) {
+		sum += (q31_t)src_a[i] * src_b[i];
+	}
+
+	*result = sum;
+}
+
+void zdsp_dot_prod_q15(const DSP_DATA q15_t *src_a, const DSP_DATA q15_t *src_b,
+		       uint32_t block_size, DSP_DATA q63_t *result)
+{
+	q63_t sum = 0;
+
+	for (uint32_t i = 0; i < block_size; i++) {
+		sum += (q31_t)src_a[i] * src_b[i];
+	}
+
+	*result = sum;
+}
+
+void zdsp_dot_prod_q31(const DSP_DATA q31_t *src_a, const DSP_DATA q31_t *src_b,
+		       uint32_t block_size, DSP_DATA q63_t *result)
+{
+	q63_t sum = 0;
+
+	for (uint32_t i = 0; i < block_size; i++) {
+		sum += ((q63_t)src_a[i] * src_b[i]) >> 14;
+	}
+
+	*result = sum;
+}
+
+void zdsp_shift_q7(const DSP_DATA q7_t *src, int8_t shift_bits, DSP_DATA q7_t *dst,
+		   uint32_t block_size)
+{
+	if (shift_bits >= 0) {
+		for (uint32_t i = 0; i < block_size; i++) {
+			dst[i] = sat_q7((int32_t)src[i] << shift_bits);
+		}
+	} else {
+		for (uint32_t i = 0; i < block_size; i++) {
+			dst[i] = src[i] >> -shift_bits;
+		}
+	}
+}
+
+void zdsp_shift_q15(const DSP_DATA q15_t *src, int8_t shift_bits, DSP_DATA q15_t *dst,
+		    uint32_t block_size)
+{
+	if (shift_bits >= 0) {
+		for (uint32_t i = 0; i < block_size; i++) {
+			dst[i] = sat_q15((int32_t)src[i] << shift_bits);
+		}
+	} else {
+		for (uint32_t i = 0; i < block_size; i++) {
+			dst[i] = src[i] >> -shift_bits;
+		}
+	}
+}
+
+void zdsp_shift_q31(const DSP_DATA q31_t *src, int8_t shift_bits, DSP_DATA q31_t *dst,
+		    uint32_t block_size)
+{
+	if (shift_bits >= 0) {
+		for (uint32_t i = 0; i < block_size; i++) {
+			dst[i] = sat_q31((q63_t)src[i] << shift_bits);
+		}
+	} else {
+		for (uint32_t i = 0; i < block_size; i++) {
+			dst[i] = src[i] >> -shift_bits;
+		}
+	}
+}
+
+void zdsp_offset_f32(const DSP_DATA float32_t *src, float32_t offset, DSP_DATA float32_t *dst,
+		     uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src[i] + offset;
+	}
+}
+
+void zdsp_offset_q7(const DSP_DATA q7_t *src, q7_t offset, DSP_DATA q7_t *dst,
+		    uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q7((int32_t)src[i] + offset);
+	}
+}
+
+void zdsp_offset_q15(const DSP_DATA q15_t *src, q15_t offset, DSP_DATA q15_t *dst,
+		     uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q15((int32_t)src[i] + offset);
+	}
+}
+
+void zdsp_offset_q31(const DSP_DATA q31_t *src, q31_t offset, DSP_DATA q31_t *dst,
+		     uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q31((q63_t)src[i] + offset);
+	}
+}
+
+void zdsp_negate_f32(const DSP_DATA float32_t *src, DSP_DATA float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = -src[i];
+	}
+}
+
+void zdsp_negate_q7(const DSP_DATA q7_t *src, DSP_DATA q7_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q7(-(int32_t)src[i]);
+	}
+}
+
+void zdsp_negate_q15(const DSP_DATA q15_t *src, DSP_DATA q15_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q15(-(int32_t)src[i]);
+	}
+}
+
+void zdsp_negate_q31(const DSP_DATA q31_t *src, DSP_DATA q31_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = sat_q31(-(q63_t)src[i]);
+	}
+}
+
+void zdsp_and_u8(const DSP_DATA uint8_t *src_a, const DSP_DATA uint8_t *src_b,
+		 DSP_DATA uint8_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] & src_b[i];
+	}
+}
+
+void zdsp_and_u16(const DSP_DATA uint16_t *src_a, const DSP_DATA uint16_t *src_b,
+		  DSP_DATA uint16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] & src_b[i];
+	}
+}
+
+void zdsp_and_u32(const DSP_DATA uint32_t *src_a, const DSP_DATA uint32_t *src_b,
+		  DSP_DATA uint32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] & src_b[i];
+	}
+}
+
+void zdsp_or_u8(const DSP_DATA uint8_t *src_a, const DSP_DATA uint8_t *src_b,
+		DSP_DATA uint8_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] | src_b[i];
+	}
+}
+
+void zdsp_or_u16(const DSP_DATA uint16_t *src_a, const DSP_DATA uint16_t *src_b,
+		 DSP_DATA uint16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] | src_b[i];
+	}
+}
+
+void zdsp_or_u32(const DSP_DATA uint32_t *src_a, const DSP_DATA uint32_t *src_b,
+		 DSP_DATA uint32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] | src_b[i];
+	}
+}
+
+void zdsp_not_u8(const DSP_DATA uint8_t *src, DSP_DATA uint8_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = ~src[i];
+	}
+}
+
+void zdsp_not_u16(const DSP_DATA uint16_t *src, DSP_DATA uint16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = ~src[i];
+	}
+}
+
+void zdsp_not_u32(const DSP_DATA uint32_t *src, DSP_DATA uint32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = ~src[i];
+	}
+}
+
+void zdsp_xor_u8(const DSP_DATA uint8_t *src_a, const DSP_DATA uint8_t *src_b,
+		 DSP_DATA uint8_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] ^ src_b[i];
+	}
+}
+
+void zdsp_xor_u16(const DSP_DATA uint16_t *src_a, const DSP_DATA uint16_t *src_b,
+		  DSP_DATA uint16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] ^ src_b[i];
+	}
+}
+
+void zdsp_xor_u32(const DSP_DATA uint32_t *src_a, const DSP_DATA uint32_t *src_b,
+		  DSP_DATA uint32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = src_a[i] ^ src_b[i];
+	}
+}
+
+void zdsp_clip_f32(const DSP_DATA float32_t *src, DSP_DATA float32_t *dst, float32_t low,
+		   float32_t high, uint32_t num_samples)
+{
+	for (uint32_t i = 0; i < num_samples; i++) {
+		float32_t in = src[i];
+
+		dst[i] = in > high ? high : (in < low ? low : in);
+	}
+}
+
+void zdsp_clip_q31(const DSP_DATA q31_t *src, DSP_DATA q31_t *dst, q31_t low, q31_t high,
+		   uint32_t num_samples)
+{
+	for (uint32_t i = 0; i < num_samples; i++) {
+		q31_t in = src[i];
+
+		dst[i] = in > high ? high : (in < low ? low : in);
+	}
+}
+
+void zdsp_clip_q15(const DSP_DATA q15_t *src, DSP_DATA q15_t *dst, q15_t low, q15_t high,
+		   uint32_t num_samples)
+{
+	for (uint32_t i = 0; i < num_samples; i++) {
+		q15_t in = src[i];
+
+		dst[i] = in > high ? high : (in < low ? low : in);
+	}
+}
+
+void zdsp_clip_q7(const DSP_DATA q7_t *src, DSP_DATA q7_t *dst, q7_t low, q7_t high,
+		  uint32_t num_samples)
+{
+	for (uint32_t i = 0; i < num_samples; i++) {
+		q7_t in = src[i];
+
+		dst[i] = in > high ? high : (in < low ? low : in);
+	}
+}
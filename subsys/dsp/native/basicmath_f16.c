@@ -0,0 +1,92 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Half-precision kernels of the native backend. The arithmetic is done in
+ * single precision and rounded once to half precision for each result.
+ */
+
+#include <math.h>
+
+#include <zephyr/dsp/dsp.h>
+
+void zdsp_mult_f16(const float16_t *src_a, const float16_t *src_b, float16_t *dst,
+		   uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = (float32_t)src_a[i] * (float32_t)src_b[i];
+	}
+}
+
+void zdsp_add_f16(const float16_t *src_a, const float16_t *src_b, float16_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = (float32_t)src_a[i] + (float32_t)src_b[i];
+	}
+}
+
+void zdsp_sub_f16(const float16_t *src_a, const float16_t *src_b, float16_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = (float32_t)src_a[i] - (float32_t)src_b[i];
+	}
+}
+
+void zdsp_scale_f16(const float16_t *src, float16_t scale, float16_t *dst, uint32_t block_size)
+{
+	float32_t s = scale;
+
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = (float32_t)src[i] * s;
+	}
+}
+
+void zdsp_abs_f16(const float16_t *src, float16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = fabsf(src[i]);
+	}
+}
+
+void zdsp_dot_prod_f16(const float16_t *src_a, const float16_t *src_b, uint32_t block_size,
+		       float16_t *result)
+{
+	/* Accumulated in single precision, half precision overflows too soon */
+	float32_t sum = 0.0f;
+
+	for (uint32_t i = 0; i < block_size; i++) {
+		sum += (float32_t)src_a[i] * (float32_t)src_b[i];
+	}
+
+	*result = sum;
+}
+
+void zdsp_offset_f16(const float16_t *src, float16_t offset, float16_t *dst, uint32_t block_size)
+{
+	float32_t o = offset;
+
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = (float32_t)src[i] + o;
+	}
+}
+
+void zdsp_negate_f16(const float16_t *src, float16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0; i < block_size; i++) {
+		dst[i] = -src[i];
+	}
+}
+
+void zdsp_clip_f16(const float16_t *src, float16_t *dst, float16_t low, float16_t high,
+		   uint32_t num_samples)
+{
+	for (uint32_t i = 0; i < num_samples; i++) {
+		float16_t in = src[i];
+
+		dst[i] = in > high ? high : (in < low ? low : in);
+	}
+}
@@ -0,0 +1,15 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SUBSYS_DSP_NATIVE_PUBLIC_ZDSP_BACKEND_H_
+#define SUBSYS_DSP_NATIVE_PUBLIC_ZDSP_BACKEND_H_
+
+/* The native backend implements the zdsp functions out of line in
+ * subsys/dsp/native, the declarations of <zephyr/dsp/basicmath.h> are all
+ * that is needed.
+ */
+
+#endif /* SUBSYS_DSP_NATIVE_PUBLIC_ZDSP_BACKEND_H_ */
@@ -14,6 +14,8 @@
 #include <zephyr/fs/fs_sys.h>
 #include <zephyr/sys/__assert.h>
 #include <ff.h>
+#include <zephyr/drivers/disk.h>
+#include <zephyr/storage/disk_access.h>
 
 #define FATFS_MAX_FILE_NAME 12 /* Uses 8.3 SFN */
 
@@ -180,6 +182,111 @@ static ssize_t fatfs_read(struct fs_file_t *zfp, void *ptr, size_t size)
 	return br;
 }
 
+#ifdef CONFIG_FILE_SYSTEM_READ_DIRECT
+#if FF_MAX_SS == FF_MIN_SS
+#define FATFS_SECTOR_SIZE(fs) ((UINT)FF_MAX_SS)
+#else
+#define FATFS_SECTOR_SIZE(fs) ((UINT)(fs)->ssize)
+#endif
+
+/* Fragments of contiguous clusters looked up in a file */
+#define FATFS_READ_DIRECT_FRAGMENTS 8
+
+/* Length of the disk names, which are the FF_VOLUME_STRS */
+#define FATFS_DISK_NAME_LEN 16
+
+/* The disk of a mount point like /SD: is the volume SD */
+static int fatfs_disk_name(const struct fs_mount_t *mp, char *name)
+{
+	const char *vol = translate_path(mp->mnt_point);
+	size_t len = strcspn(vol, ":");
+
+	if (len >= FATFS_DISK_NAME_LEN) {
+		return -ENAMETOOLONG;
+	}
+
+	memcpy(name, vol, len);
+	name[len] = '\0';
+
+	return 0;
+}
+
+/*
+ * The fragments of the file are listed with f_lseek(CREATE_LINKMAP), and the
+ * data at the position is read in place up to the end of its fragment. Files
+ * opened for writing can have data in FatFs buffers that is newer than the
+ * disk.
+ */
+static ssize_t fatfs_read_direct(struct fs_file_t *zfp, const void **ptr, size_t size)
+{
+	FIL *fp = zfp->filep;
+	FATFS *fs = fp->obj.fs;
+	UINT ss = FATFS_SECTOR_SIZE(fs);
+	FSIZE_t csz = (FSIZE_t)fs->csize * ss;
+	FSIZE_t pos = f_tell(fp);
+	DWORD clmt[2 * FATFS_READ_DIRECT_FRAGMENTS + 2];
+	char disk[FATFS_DISK_NAME_LEN];
+	struct disk_sector_map map;
+	FSIZE_t off = pos;
+	DWORD *frag;
+	size_t n;
+	FRESULT res;
+
+	if ((zfp->flags & FS_O_WRITE) != 0) {
+		return -EAGAIN;
+	}
+
+	if (pos >= f_size(fp)) {
+		return 0;
+	}
+
+	if (fatfs_disk_name(zfp->mp, disk) != 0) {
+		return -EAGAIN;
+	}
+
+	/* The link map is only used here, reads and seeks stay normal */
+	clmt[0] = ARRAY_SIZE(clmt);
+	fp->cltbl = clmt;
+	res = f_lseek(fp, CREATE_LINKMAP);
+	fp->cltbl = NULL;
+	if ((res != FR_OK) && (res != FR_NOT_ENOUGH_CORE)) {
+		return translate_error(res);
+	}
+
+	/* The table holds the first fragments when it is too small */
+	n = (MIN(clmt[0], ARRAY_SIZE(clmt)) - 2) / 2;
+	for (frag = &clmt[1]; n > 0; n--, frag += 2) {
+		if (off < frag[0] * csz) {
+			break;
+		}
+		off -= frag[0] * csz;
+	}
+
+	if (n == 0) {
+		return -EAGAIN;
+	}
+
+	/* First sector of a cluster, as given for f_expand() by FatFs */
+	map.sector = fs->database + (LBA_t)(frag[1] - 2) * fs->csize + off / ss;
+	if (disk_access_ioctl(disk, DISK_IOCTL_GET_SECTOR_MAP, &map) != 0) {
+		return -EAGAIN;
+	}
+
+	size = MIN(size, frag[0] * csz - off);
+	size = MIN(size, f_size(fp) - pos);
+	size = MIN(size, (size_t)map.num_sector * ss - (off % ss));
+
+	res = f_lseek(fp, pos + size);
+	if (res != FR_OK) {
+		return translate_error(res);
+	}
+
+	*ptr = (const uint8_t *)map.addr + (off % ss);
+
+	return size;
+}
+#endif /* CONFIG_FILE_SYSTEM_READ_DIRECT */
+
 static ssize_t fatfs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 {
 	int res = -ENOTSUP;
@@ -506,6 +613,9 @@ static const struct fs_file_system_t fatfs_fs = {
 	.tell = fatfs_tell,
 	.truncate = fatfs_truncate,
 	.sync = fatfs_sync,
+#ifdef CONFIG_FILE_SYSTEM_READ_DIRECT
+	.read_direct = fatfs_read_direct,
+#endif
 	.opendir = fatfs_opendir,
 	.readdir = fatfs_readdir,
 	.closedir = fatfs_closedir,
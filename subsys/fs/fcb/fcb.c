@@ -160,14 +160,19 @@ fcb_init(int f_area_id, struct fcb *fcb)
 	fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
 	fcb->f_active_id = newest;
 
-	while (1) {
-		rc = fcb_getnext_in_sector(fcb, &fcb->f_active);
-		if (rc == -ENOTSUP) {
-			rc = 0;
-			break;
-		}
-		if (rc != 0) {
-			break;
+	if (fcb_summary_enabled(fcb)) {
+		/* Finds the end of the active sector too */
+		rc = fcb_summary_build(fcb);
+	} else {
+		while (1) {
+			rc = fcb_getnext_in_sector(fcb, &fcb->f_active);
+			if (rc == -ENOTSUP) {
+				rc = 0;
+				break;
+			}
+			if (rc != 0) {
+				break;
+			}
 		}
 	}
 	k_mutex_init(&fcb->f_mtx);
@@ -50,6 +50,7 @@ fcb_append_to_scratch(struct fcb *fcb)
 	if (rc) {
 		return rc;
 	}
+	fcb_summary_reset(fcb, sector);
 	fcb->f_active.fe_sector = sector;
 	fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
 	fcb->f_active_id++;
@@ -93,6 +94,7 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 		if (rc) {
 			goto err;
 		}
+		fcb_summary_reset(fcb, sector);
 		fcb->f_active.fe_sector = sector;
 		fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
 		fcb->f_active_id++;
@@ -108,6 +110,7 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 	append_loc->fe_data_off = active->fe_elem_off + cnt;
 
 	active->fe_elem_off = append_loc->fe_data_off + len;
+	fcb_summary_set_end(fcb, active);
 
 	k_mutex_unlock(&fcb->f_mtx);
 
@@ -136,5 +139,14 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	if (rc) {
 		return -EIO;
 	}
+
+	if (fcb_summary_enabled(fcb)) {
+		rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+		if (rc) {
+			return -EINVAL;
+		}
+		fcb_summary_add(fcb, loc);
+		k_mutex_unlock(&fcb->f_mtx);
+	}
 	return 0;
 }
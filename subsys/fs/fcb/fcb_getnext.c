@@ -21,6 +21,9 @@ fcb_getnext_in_sector(struct fcb *fcb, struct fcb_entry *loc)
 			loc->fe_elem_off = loc->fe_data_off +
 			  fcb_len_in_flash(fcb, loc->fe_data_len) +
 			  fcb_len_in_flash(fcb, FCB_CRC_SZ);
+			if (fcb_summary_at_end(fcb, loc)) {
+				return -ENOTSUP;
+			}
 			rc = fcb_elem_info(fcb, loc);
 			if (rc != -EBADMSG) {
 				break;
@@ -55,7 +58,9 @@ fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc)
 		/*
 		 * If offset is zero, we serve the first entry from the sector.
 		 */
-		loc->fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+		if (!fcb_summary_first(fcb, loc)) {
+			goto next_sector;
+		}
 		rc = fcb_elem_info(fcb, loc);
 		switch (rc) {
 		case 0:
@@ -89,7 +94,9 @@ next_sector:
 				return -ENOTSUP;
 			}
 			loc->fe_sector = fcb_getnext_sector(fcb, loc->fe_sector);
-			loc->fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+			if (!fcb_summary_first(fcb, loc)) {
+				goto next_sector;
+			}
 			rc = fcb_elem_info(fcb, loc);
 			switch (rc) {
 			case 0:
@@ -119,3 +126,37 @@ fcb_getnext(struct fcb *fcb, struct fcb_entry *loc)
 
 	return rc;
 }
+
+int
+fcb_getnext_key(struct fcb *fcb, struct fcb_entry *loc, uint32_t key_hash)
+{
+	int rc;
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+	while (true) {
+		if (loc->fe_sector != NULL &&
+		    !fcb_summary_has_key(fcb, loc->fe_sector, key_hash)) {
+			/*
+			 * None of the elements of the sector has the key.
+			 */
+			if (loc->fe_sector == fcb->f_active.fe_sector) {
+				rc = -ENOTSUP;
+				break;
+			}
+			loc->fe_sector = fcb_getnext_sector(fcb, loc->fe_sector);
+			loc->fe_elem_off = 0U;
+			continue;
+		}
+
+		rc = fcb_getnext_nolock(fcb, loc);
+		if (rc != 0 || fcb_summary_has_key(fcb, loc->fe_sector, key_hash)) {
+			break;
+		}
+	}
+	k_mutex_unlock(&fcb->f_mtx);
+
+	return rc;
+}
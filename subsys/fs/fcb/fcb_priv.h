@@ -72,6 +72,61 @@ int fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_endmarker(struct fcb *fcb, struct fcb_entry *loc, uint8_t *crc8p);
 
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+static inline bool fcb_summary_enabled(const struct fcb *fcb)
+{
+	return fcb->f_summary != NULL;
+}
+
+void fcb_summary_reset(struct fcb *fcb, struct flash_sector *sector);
+void fcb_summary_add(struct fcb *fcb, struct fcb_entry *loc);
+void fcb_summary_set_end(struct fcb *fcb, const struct fcb_entry *active);
+bool fcb_summary_first(struct fcb *fcb, struct fcb_entry *loc);
+bool fcb_summary_at_end(struct fcb *fcb, const struct fcb_entry *loc);
+bool fcb_summary_has_key(struct fcb *fcb, const struct flash_sector *sector,
+			 uint32_t key_hash);
+int fcb_summary_build(struct fcb *fcb);
+#else
+static inline bool fcb_summary_enabled(const struct fcb *fcb)
+{
+	return false;
+}
+
+static inline void fcb_summary_reset(struct fcb *fcb, struct flash_sector *sector)
+{
+}
+
+static inline void fcb_summary_add(struct fcb *fcb, struct fcb_entry *loc)
+{
+}
+
+static inline void fcb_summary_set_end(struct fcb *fcb, const struct fcb_entry *active)
+{
+}
+
+static inline bool fcb_summary_first(struct fcb *fcb, struct fcb_entry *loc)
+{
+	loc->fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+	return true;
+}
+
+static inline bool fcb_summary_at_end(struct fcb *fcb, const struct fcb_entry *loc)
+{
+	return false;
+}
+
+static inline bool fcb_summary_has_key(struct fcb *fcb, const struct flash_sector *sector,
+				       uint32_t key_hash)
+{
+	return true;
+}
+
+static inline int fcb_summary_build(struct fcb *fcb)
+{
+	return -ENOTSUP;
+}
+#endif /* CONFIG_FCB_SECTOR_SUMMARY */
+
 int fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t id);
 int fcb_sector_hdr_read(struct fcb *fcb, struct flash_sector *sector,
 			struct fcb_disk_area *fdap);
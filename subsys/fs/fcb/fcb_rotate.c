@@ -24,6 +24,7 @@ fcb_rotate(struct fcb *fcb)
 		rc = -EIO;
 		goto out;
 	}
+	fcb_summary_reset(fcb, fcb->f_oldest);
 	if (fcb->f_oldest == fcb->f_active.fe_sector) {
 		/*
 		 * Need to create a new active area, as we're wiping
@@ -34,6 +35,7 @@ fcb_rotate(struct fcb *fcb)
 		if (rc) {
 			goto out;
 		}
+		fcb_summary_reset(fcb, sector);
 		fcb->f_active.fe_sector = sector;
 		fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
 		fcb->f_active_id++;
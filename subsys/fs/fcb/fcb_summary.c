@@ -0,0 +1,195 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/fs/fcb.h>
+#include "fcb_priv.h"
+
+#define FCB_BLOOM_BITS (32U * CONFIG_FCB_SECTOR_SUMMARY_BLOOM_WORDS)
+
+static struct fcb_sector_summary *
+fcb_summary_get(const struct fcb *fcb, const struct flash_sector *sector)
+{
+	return &fcb->f_summary[sector - fcb->f_sectors];
+}
+
+/*
+ * Each key sets two bits of the filter, from the low and high halves of its
+ * hash.
+ */
+static void fcb_bloom_bits(uint32_t key_hash, uint32_t bits[2])
+{
+	bits[0] = (key_hash & 0xffffU) % FCB_BLOOM_BITS;
+	bits[1] = (key_hash >> 16) % FCB_BLOOM_BITS;
+}
+
+void
+fcb_summary_reset(struct fcb *fcb, struct flash_sector *sector)
+{
+	struct fcb_sector_summary *sum;
+
+	if (!fcb_summary_enabled(fcb)) {
+		return;
+	}
+
+	sum = fcb_summary_get(fcb, sector);
+	(void)memset(sum, 0, sizeof(*sum));
+	sum->fs_end_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+}
+
+void
+fcb_summary_add(struct fcb *fcb, struct fcb_entry *loc)
+{
+	struct fcb_sector_summary *sum;
+	uint32_t key_hash;
+	uint32_t bits[2];
+
+	if (!fcb_summary_enabled(fcb)) {
+		return;
+	}
+
+	sum = fcb_summary_get(fcb, loc->fe_sector);
+	if (sum->fs_count == 0U || loc->fe_elem_off < sum->fs_first_off) {
+		sum->fs_first_off = loc->fe_elem_off;
+	}
+	sum->fs_count++;
+
+	if (fcb->f_key_hash == NULL) {
+		return;
+	}
+
+	if (fcb->f_key_hash(fcb, loc, &key_hash) != 0) {
+		/* The element can not be told apart from any key */
+		(void)memset(sum->fs_bloom, 0xff, sizeof(sum->fs_bloom));
+		return;
+	}
+
+	fcb_bloom_bits(key_hash, bits);
+	for (int i = 0; i < ARRAY_SIZE(bits); i++) {
+		sum->fs_bloom[bits[i] / 32U] |= BIT(bits[i] % 32U);
+	}
+}
+
+void
+fcb_summary_set_end(struct fcb *fcb, const struct fcb_entry *active)
+{
+	if (fcb_summary_enabled(fcb)) {
+		fcb_summary_get(fcb, active->fe_sector)->fs_end_off = active->fe_elem_off;
+	}
+}
+
+/*
+ * Set loc to the first valid element of its sector. Return false if the
+ * sector has none.
+ */
+bool
+fcb_summary_first(struct fcb *fcb, struct fcb_entry *loc)
+{
+	struct fcb_sector_summary *sum;
+
+	if (!fcb_summary_enabled(fcb)) {
+		loc->fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+		return true;
+	}
+
+	sum = fcb_summary_get(fcb, loc->fe_sector);
+	loc->fe_elem_off = sum->fs_first_off;
+
+	return sum->fs_count > 0U;
+}
+
+/*
+ * Whether loc is past the last element of its sector.
+ */
+bool
+fcb_summary_at_end(struct fcb *fcb, const struct fcb_entry *loc)
+{
+	return fcb_summary_enabled(fcb) &&
+	       (loc->fe_elem_off >= fcb_summary_get(fcb, loc->fe_sector)->fs_end_off);
+}
+
+bool
+fcb_summary_has_key(struct fcb *fcb, const struct flash_sector *sector,
+		    uint32_t key_hash)
+{
+	struct fcb_sector_summary *sum;
+	uint32_t bits[2];
+
+	if (!fcb_summary_enabled(fcb) || fcb->f_key_hash == NULL) {
+		return true;
+	}
+
+	sum = fcb_summary_get(fcb, sector);
+	fcb_bloom_bits(key_hash, bits);
+	for (int i = 0; i < ARRAY_SIZE(bits); i++) {
+		if (!(sum->fs_bloom[bits[i] / 32U] & BIT(bits[i] % 32U))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static int
+fcb_summary_scan(struct fcb *fcb, struct flash_sector *sector)
+{
+	struct fcb_entry loc = {
+		.fe_sector = sector,
+		.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)),
+	};
+	int rc;
+
+	while (true) {
+		rc = fcb_elem_info(fcb, &loc);
+		if (rc == 0) {
+			fcb_summary_add(fcb, &loc);
+		} else if (rc != -EBADMSG) {
+			break;
+		}
+		loc.fe_elem_off = loc.fe_data_off +
+			fcb_len_in_flash(fcb, loc.fe_data_len) +
+			fcb_len_in_flash(fcb, FCB_CRC_SZ);
+	}
+
+	if (rc != -ENOTSUP) {
+		return rc;
+	}
+	fcb_summary_set_end(fcb, &loc);
+
+	return 0;
+}
+
+/*
+ * Build the summaries of the sectors in use, from the oldest to the active
+ * one, and set the offset in the active sector where the next element goes.
+ */
+int
+fcb_summary_build(struct fcb *fcb)
+{
+	struct flash_sector *sector;
+	int rc;
+
+	for (int i = 0; i < fcb->f_sector_cnt; i++) {
+		fcb_summary_reset(fcb, &fcb->f_sectors[i]);
+	}
+
+	sector = fcb->f_oldest;
+	while (true) {
+		rc = fcb_summary_scan(fcb, sector);
+		if (rc != 0) {
+			return rc;
+		}
+		if (sector == fcb->f_active.fe_sector) {
+			break;
+		}
+		sector = fcb_getnext_sector(fcb, sector);
+	}
+
+	fcb->f_active.fe_elem_off = fcb_summary_get(fcb, sector)->fs_end_off;
+
+	return 0;
+}
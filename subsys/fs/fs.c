@@ -129,6 +129,208 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 	return 0;
 }
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+/*
+ * Data read ahead ends at the position of the file system, and pos bytes of
+ * it were consumed. Written data goes at the position of the file system.
+ */
+static int fs_buffer_flush(struct fs_file_t *zfp)
+{
+	struct fs_file_buffer *fb = &zfp->buffer;
+	ssize_t rc;
+
+	if (!fb->dirty) {
+		return 0;
+	}
+
+	rc = zfp->mp->fs->write(zfp, fb->data, fb->len);
+	if ((rc >= 0) && (rc != fb->len)) {
+		rc = -ENOSPC;
+	}
+
+	/* Data that could not be written is dropped, like stdio does */
+	fb->len = 0;
+	fb->dirty = false;
+
+	if (rc < 0) {
+		LOG_ERR("file buffer write error (%d)", (int)rc);
+		return rc;
+	}
+
+	return 0;
+}
+
+/* Empty the buffer, moving the position of the file system to the file's */
+static int fs_buffer_settle(struct fs_file_t *zfp)
+{
+	struct fs_file_buffer *fb = &zfp->buffer;
+	int rc;
+
+	if (fb->dirty) {
+		return fs_buffer_flush(zfp);
+	}
+
+	if (fb->pos != fb->len) {
+		rc = zfp->mp->fs->lseek(zfp, (off_t)fb->pos - (off_t)fb->len, FS_SEEK_CUR);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	fb->len = 0;
+	fb->pos = 0;
+
+	return 0;
+}
+
+static ssize_t fs_buffered_read(struct fs_file_t *zfp, uint8_t *ptr, size_t size)
+{
+	struct fs_file_buffer *fb = &zfp->buffer;
+	size_t done = 0;
+	size_t n;
+	ssize_t rc;
+
+	rc = fs_buffer_flush(zfp);
+	if (rc < 0) {
+		return rc;
+	}
+
+	while (done < size) {
+		if (fb->pos < fb->len) {
+			n = MIN(size - done, fb->len - fb->pos);
+			memcpy(&ptr[done], &fb->data[fb->pos], n);
+			fb->pos += n;
+			done += n;
+			continue;
+		}
+
+		fb->len = 0;
+		fb->pos = 0;
+
+		n = size - done;
+		if (n >= fb->size) {
+			rc = zfp->mp->fs->read(zfp, &ptr[done], n);
+			if (rc > 0) {
+				done += rc;
+			}
+			break;
+		}
+
+		/* Read ahead more while the reads are sequential */
+		n = MIN(MAX(n, fb->ahead), fb->size);
+		rc = zfp->mp->fs->read(zfp, fb->data, n);
+		if (rc <= 0) {
+			break;
+		}
+
+		fb->len = rc;
+		fb->ahead = MIN(2 * n, fb->size);
+
+		if (rc < n) {
+			/* End of the file */
+			n = MIN(size - done, fb->len);
+			memcpy(&ptr[done], fb->data, n);
+			fb->pos = n;
+			done += n;
+			break;
+		}
+	}
+
+	return ((rc < 0) && (done == 0)) ? rc : done;
+}
+
+static ssize_t fs_buffered_write(struct fs_file_t *zfp, const uint8_t *ptr, size_t size)
+{
+	struct fs_file_buffer *fb = &zfp->buffer;
+	size_t done = 0;
+	size_t n;
+	ssize_t rc;
+
+	if (!fb->dirty) {
+		rc = fs_buffer_settle(zfp);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	while (done < size) {
+		if ((fb->len == 0) && (size - done >= fb->size)) {
+			rc = zfp->mp->fs->write(zfp, &ptr[done], size - done);
+			if (rc < 0) {
+				return (done == 0) ? rc : done;
+			}
+			return done + rc;
+		}
+
+		n = MIN(size - done, fb->size - fb->len);
+		memcpy(&fb->data[fb->len], &ptr[done], n);
+		fb->len += n;
+		fb->dirty = true;
+		done += n;
+
+		if (fb->len == fb->size) {
+			rc = fs_buffer_flush(zfp);
+			if (rc < 0) {
+				return rc;
+			}
+		}
+	}
+
+	return done;
+}
+
+static int fs_buffered_seek(struct fs_file_t *zfp, off_t offset, int whence)
+{
+	struct fs_file_buffer *fb = &zfp->buffer;
+	off_t target = -1;
+	off_t start;
+	int rc;
+
+	/* Seeks within the data read ahead only move in the buffer */
+	if (!fb->dirty && (fb->len != 0)) {
+		if (whence == FS_SEEK_CUR) {
+			target = (off_t)fb->pos + offset;
+		} else if (whence == FS_SEEK_SET) {
+			start = zfp->mp->fs->tell(zfp);
+			if (start >= 0) {
+				target = offset - (start - (off_t)fb->len);
+			}
+		}
+
+		if ((target >= 0) && (target <= fb->len)) {
+			fb->pos = target;
+			return 0;
+		}
+	}
+
+	rc = fs_buffer_settle(zfp);
+	if (rc < 0) {
+		return rc;
+	}
+
+	fb->ahead = 0;
+
+	return zfp->mp->fs->lseek(zfp, offset, whence);
+}
+
+static off_t fs_buffered_tell(struct fs_file_t *zfp)
+{
+	struct fs_file_buffer *fb = &zfp->buffer;
+	off_t rc;
+
+	rc = zfp->mp->fs->tell(zfp);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (fb->dirty) {
+		return rc + fb->len;
+	}
+
+	return rc - (off_t)(fb->len - fb->pos);
+}
+#endif /* CONFIG_FILE_SYSTEM_BUFFERED */
+
 /* File operations */
 int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 {
@@ -171,6 +373,10 @@ int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 	/* Copy flags to zfp for use with other fs_ API calls */
 	zfp->flags = flags;
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	zfp->buffer = (struct fs_file_buffer){ 0 };
+#endif
+
 	return rc;
 }
 
@@ -186,6 +392,14 @@ int fs_close(struct fs_file_t *zfp)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	int flush_rc = 0;
+
+	if (zfp->buffer.data != NULL) {
+		flush_rc = fs_buffer_flush(zfp);
+	}
+#endif
+
 	rc = zfp->mp->fs->close(zfp);
 	if (rc < 0) {
 		LOG_ERR("file close error (%d)", rc);
@@ -194,6 +408,11 @@ int fs_close(struct fs_file_t *zfp)
 
 	zfp->mp = NULL;
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	zfp->buffer = (struct fs_file_buffer){ 0 };
+	rc = flush_rc;
+#endif
+
 	return rc;
 }
 
@@ -209,6 +428,12 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	if ((zfp->buffer.data != NULL) && (ptr != NULL)) {
+		return fs_buffered_read(zfp, ptr, size);
+	}
+#endif
+
 	rc = zfp->mp->fs->read(zfp, ptr, size);
 	if (rc < 0) {
 		LOG_ERR("file read error (%d)", rc);
@@ -229,6 +454,12 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	if ((zfp->buffer.data != NULL) && (ptr != NULL)) {
+		return fs_buffered_write(zfp, ptr, size);
+	}
+#endif
+
 	rc = zfp->mp->fs->write(zfp, ptr, size);
 	if (rc < 0) {
 		LOG_ERR("file write error (%d)", rc);
@@ -249,6 +480,12 @@ int fs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	if (zfp->buffer.data != NULL) {
+		return fs_buffered_seek(zfp, offset, whence);
+	}
+#endif
+
 	rc = zfp->mp->fs->lseek(zfp, offset, whence);
 	if (rc < 0) {
 		LOG_ERR("file seek error (%d)", rc);
@@ -269,6 +506,12 @@ off_t fs_tell(struct fs_file_t *zfp)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	if (zfp->buffer.data != NULL) {
+		return fs_buffered_tell(zfp);
+	}
+#endif
+
 	rc = zfp->mp->fs->tell(zfp);
 	if (rc < 0) {
 		LOG_ERR("file tell error (%d)", rc);
@@ -289,6 +532,15 @@ int fs_truncate(struct fs_file_t *zfp, off_t length)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	if (zfp->buffer.data != NULL) {
+		rc = fs_buffer_settle(zfp);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+#endif
+
 	rc = zfp->mp->fs->truncate(zfp, length);
 	if (rc < 0) {
 		LOG_ERR("file truncate error (%d)", rc);
@@ -309,6 +561,15 @@ int fs_sync(struct fs_file_t *zfp)
 		return -ENOTSUP;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	if (zfp->buffer.data != NULL) {
+		rc = fs_buffer_flush(zfp);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+#endif
+
 	rc = zfp->mp->fs->sync(zfp);
 	if (rc < 0) {
 		LOG_ERR("file sync error (%d)", rc);
@@ -317,6 +578,81 @@ int fs_sync(struct fs_file_t *zfp)
 	return rc;
 }
 
+#ifdef CONFIG_FILE_SYSTEM_READ_DIRECT
+ssize_t fs_read_direct(struct fs_file_t *zfp, const void **ptr, void *buf, size_t size)
+{
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (zfp->mp->fs->read_direct != NULL) {
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+		if (zfp->buffer.data != NULL) {
+			rc = fs_buffer_settle(zfp);
+			if (rc < 0) {
+				return rc;
+			}
+		}
+#endif
+
+		rc = zfp->mp->fs->read_direct(zfp, ptr, size);
+		if (rc != -EAGAIN) {
+			if (rc < 0) {
+				LOG_ERR("file direct read error (%d)", (int)rc);
+			}
+			return rc;
+		}
+	}
+
+	if (buf == NULL) {
+		return -ENOTSUP;
+	}
+
+	rc = fs_read(zfp, buf, size);
+	if (rc >= 0) {
+		*ptr = buf;
+	}
+
+	return rc;
+}
+#endif /* CONFIG_FILE_SYSTEM_READ_DIRECT */
+
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+int fs_setbuf(struct fs_file_t *zfp, void *buf, size_t size)
+{
+	int rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if ((buf == NULL) != (size == 0)) {
+		return -EINVAL;
+	}
+
+	if ((buf != NULL) &&
+	    ((zfp->mp->fs->lseek == NULL) || (zfp->mp->fs->tell == NULL))) {
+		return -ENOTSUP;
+	}
+
+	if (zfp->buffer.data != NULL) {
+		rc = fs_buffer_settle(zfp);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	zfp->buffer = (struct fs_file_buffer){
+		.data = buf,
+		.size = size,
+	};
+
+	return 0;
+}
+#endif /* CONFIG_FILE_SYSTEM_BUFFERED */
+
 /* Directory operations */
 int fs_opendir(struct fs_dir_t *zdp, const char *abs_path)
 {
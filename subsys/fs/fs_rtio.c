@@ -0,0 +1,94 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_rtio.h>
+#include <zephyr/rtio/work.h>
+
+static ssize_t fs_rtio_sqe(struct fs_file_t *zfp, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+	ssize_t rc;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		/* A read into the memory pool of the RTIO context takes a block */
+		buf_len = sqe->buf_len != 0U ? sqe->buf_len : rtio_mempool_block_size(iodev_sqe->r);
+		rc = rtio_sqe_rx_buf(iodev_sqe, 1, buf_len, &buf, &buf_len);
+		if (rc < 0) {
+			return rc;
+		}
+		rc = fs_read(zfp, buf, buf_len);
+		if (rc == 0 && (sqe->flags & RTIO_SQE_MULTISHOT) != 0) {
+			/* End of the file, there is nothing more to read */
+			return -ENODATA;
+		}
+		return rc;
+	case RTIO_OP_TX:
+		return fs_write(zfp, sqe->buf, sqe->buf_len);
+	case RTIO_OP_TINY_TX:
+		return fs_write(zfp, sqe->tiny_buf, sqe->tiny_buf_len);
+	case RTIO_OP_FS_SEEK:
+		return fs_seek(zfp, sqe->fs_offset, FS_SEEK_SET);
+	default:
+		return -EINVAL;
+	}
+}
+
+static void fs_rtio_handler(struct rtio_iodev_sqe *txn_first)
+{
+	struct fs_rtio_iodev_data *data = txn_first->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = txn_first;
+	ssize_t ret = 0;
+
+	/* Workers may run submissions to the same file concurrently */
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	while (txn_curr != NULL) {
+		ret = fs_rtio_sqe(data->file, txn_curr);
+		if (ret < 0) {
+			break;
+		}
+		txn_curr = rtio_txn_next(txn_curr);
+	}
+
+	k_mutex_unlock(&data->lock);
+
+	if (ret < 0) {
+		/* A multishot read would be submitted again, and fail again */
+		txn_first->sqe.flags &= ~RTIO_SQE_MULTISHOT;
+		rtio_iodev_sqe_err(txn_first, ret);
+	} else {
+		rtio_iodev_sqe_ok(txn_first, ret);
+	}
+}
+
+static void fs_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct fs_rtio_iodev_data *data = iodev_sqe->sqe.iodev->data;
+	struct rtio_work_req *req;
+
+	if (data->file == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -EBADF);
+		return;
+	}
+
+	req = rtio_work_req_alloc();
+	if (req == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, fs_rtio_handler);
+}
+
+const struct rtio_iodev_api fs_rtio_iodev_api = {
+	.submit = fs_rtio_submit,
+};
@@ -0,0 +1,585 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Read-only file system of an image built at compile time by
+ * scripts/build/gen_imgfs.py, which describes the layout. The image is
+ * accessed in place, and the storage device of the mount point is its
+ * address.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <errno.h>
+#include <zephyr/init.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+#ifdef CONFIG_FILE_SYSTEM_IMGFS_LZ4
+#include <lz4.h>
+#endif
+
+#include "fs_impl.h"
+
+LOG_MODULE_DECLARE(fs, CONFIG_FS_LOG_LEVEL);
+
+#define IMGFS_MAGIC "ZIMG"
+#define IMGFS_VERSION 1
+
+#define IMGFS_TYPE_FILE 0
+#define IMGFS_TYPE_DIR 1
+
+#define IMGFS_COMP_NONE 0
+#define IMGFS_COMP_LZ4 1
+
+/* Index of the root directory, which has no entry */
+#define IMGFS_ROOT UINT32_MAX
+
+struct imgfs_header {
+	uint8_t magic[4];
+	uint16_t version;
+	uint16_t flags;
+	uint32_t entry_count;
+	uint32_t root_count;
+	uint32_t names_off;
+	uint32_t image_size;
+	uint32_t block_size;
+} __packed;
+
+/*
+ * Directories hold the number of their entries in size, and the index of
+ * the first one in data_off.
+ */
+struct imgfs_entry {
+	uint32_t path_off;
+	uint16_t path_len;
+	uint16_t base_pos;
+	uint32_t size;
+	uint32_t data_off;
+	uint8_t type;
+	uint8_t comp;
+	uint16_t reserved;
+} __packed;
+
+struct imgfs_file {
+	const uint8_t *image;
+	const struct imgfs_entry *entry;
+	size_t pos;
+};
+
+struct imgfs_dir {
+	const uint8_t *image;
+	uint32_t next;
+	uint32_t end;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(imgfs_file_pool, sizeof(struct imgfs_file),
+			 CONFIG_FILE_SYSTEM_IMGFS_NUM_FILES, 4);
+K_MEM_SLAB_DEFINE_STATIC(imgfs_dir_pool, sizeof(struct imgfs_dir),
+			 CONFIG_FILE_SYSTEM_IMGFS_NUM_DIRS, 4);
+
+#ifdef CONFIG_FILE_SYSTEM_IMGFS_LZ4
+/* Last block decompressed for reads of parts of blocks */
+static K_MUTEX_DEFINE(imgfs_block_lock);
+static uint8_t imgfs_block[CONFIG_FILE_SYSTEM_IMGFS_BLOCK_SIZE];
+static const struct imgfs_entry *imgfs_block_entry;
+static uint32_t imgfs_block_idx;
+#endif
+
+static inline const struct imgfs_header *imgfs_header(const uint8_t *image)
+{
+	return (const struct imgfs_header *)image;
+}
+
+static inline const struct imgfs_entry *imgfs_entry(const uint8_t *image, uint32_t idx)
+{
+	return (const struct imgfs_entry *)(image + sizeof(struct imgfs_header)) + idx;
+}
+
+static inline const char *imgfs_path(const uint8_t *image, const struct imgfs_entry *entry)
+{
+	return (const char *)image + sys_le32_to_cpu(imgfs_header(image)->names_off) +
+	       sys_le32_to_cpu(entry->path_off);
+}
+
+static int imgfs_strcmp(const char *a, size_t a_len, const char *b, size_t b_len)
+{
+	int rc = memcmp(a, b, MIN(a_len, b_len));
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	return (a_len > b_len) - (a_len < b_len);
+}
+
+/* Entries are sorted by parent directory, then by name */
+static int imgfs_entry_cmp(const uint8_t *image, const struct imgfs_entry *entry,
+			   const char *path, size_t dir_len, size_t base_pos, size_t path_len)
+{
+	const char *entry_path = imgfs_path(image, entry);
+	size_t entry_base = sys_le16_to_cpu(entry->base_pos);
+	size_t entry_len = sys_le16_to_cpu(entry->path_len);
+	int rc;
+
+	rc = imgfs_strcmp(entry_path, entry_base ? entry_base - 1 : 0, path, dir_len);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return imgfs_strcmp(entry_path + entry_base, entry_len - entry_base,
+			    path + base_pos, path_len - base_pos);
+}
+
+/* Index of the entry of a path relative to the mount point */
+static int imgfs_lookup(const uint8_t *image, const char *path, uint32_t *idx)
+{
+	const struct imgfs_header *hdr = imgfs_header(image);
+	uint32_t lo = 0;
+	uint32_t hi = sys_le32_to_cpu(hdr->entry_count);
+	const char *base;
+	size_t dir_len, base_pos, path_len;
+
+	while (*path == '/') {
+		path++;
+	}
+
+	path_len = strlen(path);
+	while ((path_len > 0) && (path[path_len - 1] == '/')) {
+		path_len--;
+	}
+
+	if (path_len == 0) {
+		*idx = IMGFS_ROOT;
+		return 0;
+	}
+
+	base = path + path_len;
+	while ((base > path) && (base[-1] != '/')) {
+		base--;
+	}
+	base_pos = base - path;
+	dir_len = base_pos ? base_pos - 1 : 0;
+
+	while (lo < hi) {
+		uint32_t mid = lo + (hi - lo) / 2;
+		int rc = imgfs_entry_cmp(image, imgfs_entry(image, mid),
+					 path, dir_len, base_pos, path_len);
+
+		if (rc == 0) {
+			*idx = mid;
+			return 0;
+		} else if (rc < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static void imgfs_to_dirent(const uint8_t *image, uint32_t idx, struct fs_dirent *entry)
+{
+	const struct imgfs_entry *e;
+	size_t base, len;
+
+	if (idx == IMGFS_ROOT) {
+		entry->type = FS_DIR_ENTRY_DIR;
+		entry->name[0] = '\0';
+		entry->size = 0;
+		return;
+	}
+
+	e = imgfs_entry(image, idx);
+	base = sys_le16_to_cpu(e->base_pos);
+	len = MIN(sys_le16_to_cpu(e->path_len) - base, MAX_FILE_NAME);
+
+	memcpy(entry->name, imgfs_path(image, e) + base, len);
+	entry->name[len] = '\0';
+
+	if (e->type == IMGFS_TYPE_DIR) {
+		entry->type = FS_DIR_ENTRY_DIR;
+		entry->size = 0;
+	} else {
+		entry->type = FS_DIR_ENTRY_FILE;
+		entry->size = sys_le32_to_cpu(e->size);
+	}
+}
+
+static int imgfs_open(struct fs_file_t *fp, const char *path, fs_mode_t flags)
+{
+	const uint8_t *image = fp->mp->storage_dev;
+	const struct imgfs_entry *entry;
+	struct imgfs_file *file;
+	uint32_t idx;
+	int rc;
+
+	if ((flags & (FS_O_WRITE | FS_O_CREATE | FS_O_APPEND)) != 0) {
+		return -EROFS;
+	}
+
+	rc = imgfs_lookup(image, fs_impl_strip_prefix(path, fp->mp), &idx);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (idx == IMGFS_ROOT) {
+		return -EISDIR;
+	}
+
+	entry = imgfs_entry(image, idx);
+	if (entry->type == IMGFS_TYPE_DIR) {
+		return -EISDIR;
+	}
+
+	if ((entry->comp != IMGFS_COMP_NONE) &&
+	    !(IS_ENABLED(CONFIG_FILE_SYSTEM_IMGFS_LZ4) && (entry->comp == IMGFS_COMP_LZ4))) {
+		return -ENOTSUP;
+	}
+
+	if (k_mem_slab_alloc(&imgfs_file_pool, (void **)&file, K_NO_WAIT) != 0) {
+		return -ENOMEM;
+	}
+
+	file->image = image;
+	file->entry = entry;
+	file->pos = 0;
+	fp->filep = file;
+
+	return 0;
+}
+
+static int imgfs_close(struct fs_file_t *fp)
+{
+	k_mem_slab_free(&imgfs_file_pool, fp->filep);
+	fp->filep = NULL;
+
+	return 0;
+}
+
+#ifdef CONFIG_FILE_SYSTEM_IMGFS_LZ4
+/* Compressed and uncompressed sizes of a block of a compressed file */
+static const uint8_t *imgfs_block_get(const struct imgfs_file *file, uint32_t blk,
+				      size_t *comp_len, size_t *len)
+{
+	const uint32_t *table = (const uint32_t *)(file->image +
+						   sys_le32_to_cpu(file->entry->data_off));
+	size_t block_size = sys_le32_to_cpu(imgfs_header(file->image)->block_size);
+	uint32_t off = sys_le32_to_cpu(table[blk]);
+
+	*comp_len = sys_le32_to_cpu(table[blk + 1]) - off;
+	*len = MIN(block_size, sys_le32_to_cpu(file->entry->size) - blk * block_size);
+
+	return file->image + off;
+}
+
+static ssize_t imgfs_read_lz4(struct imgfs_file *file, uint8_t *buf, size_t size)
+{
+	size_t block_size = sys_le32_to_cpu(imgfs_header(file->image)->block_size);
+	size_t done = 0;
+
+	while (done < size) {
+		uint32_t blk = file->pos / block_size;
+		size_t off = file->pos % block_size;
+		size_t comp_len, len, n;
+		const uint8_t *src = imgfs_block_get(file, blk, &comp_len, &len);
+
+		n = MIN(size - done, len - off);
+
+		if (comp_len == len) {
+			/* Stored as is */
+			memcpy(buf + done, src + off, n);
+		} else if (n == len) {
+			if (LZ4_decompress_safe((const char *)src, (char *)buf + done,
+						comp_len, len) != len) {
+				return -EIO;
+			}
+		} else {
+			k_mutex_lock(&imgfs_block_lock, K_FOREVER);
+			if ((imgfs_block_entry != file->entry) || (imgfs_block_idx != blk)) {
+				imgfs_block_entry = NULL;
+				if (LZ4_decompress_safe((const char *)src, (char *)imgfs_block,
+							comp_len, len) != len) {
+					k_mutex_unlock(&imgfs_block_lock);
+					return -EIO;
+				}
+				imgfs_block_entry = file->entry;
+				imgfs_block_idx = blk;
+			}
+			memcpy(buf + done, imgfs_block + off, n);
+			k_mutex_unlock(&imgfs_block_lock);
+		}
+
+		done += n;
+		file->pos += n;
+	}
+
+	return done;
+}
+#endif /* CONFIG_FILE_SYSTEM_IMGFS_LZ4 */
+
+static ssize_t imgfs_read(struct fs_file_t *fp, void *ptr, size_t len)
+{
+	struct imgfs_file *file = fp->filep;
+	size_t size = sys_le32_to_cpu(file->entry->size);
+
+	if (file->pos >= size) {
+		return 0;
+	}
+
+	len = MIN(len, size - file->pos);
+
+#ifdef CONFIG_FILE_SYSTEM_IMGFS_LZ4
+	if (file->entry->comp == IMGFS_COMP_LZ4) {
+		return imgfs_read_lz4(file, ptr, len);
+	}
+#endif
+
+	memcpy(ptr, file->image + sys_le32_to_cpu(file->entry->data_off) + file->pos, len);
+	file->pos += len;
+
+	return len;
+}
+
+#ifdef CONFIG_FILE_SYSTEM_READ_DIRECT
+static ssize_t imgfs_read_direct(struct fs_file_t *fp, const void **ptr, size_t len)
+{
+	struct imgfs_file *file = fp->filep;
+	size_t size = sys_le32_to_cpu(file->entry->size);
+
+	if (file->pos >= size) {
+		return 0;
+	}
+
+	len = MIN(len, size - file->pos);
+
+#ifdef CONFIG_FILE_SYSTEM_IMGFS_LZ4
+	if (file->entry->comp == IMGFS_COMP_LZ4) {
+		size_t block_size = sys_le32_to_cpu(imgfs_header(file->image)->block_size);
+		size_t off = file->pos % block_size;
+		size_t comp_len, block_len;
+		const uint8_t *src = imgfs_block_get(file, file->pos / block_size,
+						     &comp_len, &block_len);
+
+		/* Only blocks stored as is can be read in place */
+		if (comp_len != block_len) {
+			return -EAGAIN;
+		}
+
+		len = MIN(len, block_len - off);
+		*ptr = src + off;
+		file->pos += len;
+
+		return len;
+	}
+#endif
+
+	*ptr = file->image + sys_le32_to_cpu(file->entry->data_off) + file->pos;
+	file->pos += len;
+
+	return len;
+}
+#endif /* CONFIG_FILE_SYSTEM_READ_DIRECT */
+
+static int imgfs_lseek(struct fs_file_t *fp, off_t off, int whence)
+{
+	struct imgfs_file *file = fp->filep;
+	off_t size = sys_le32_to_cpu(file->entry->size);
+	off_t pos;
+
+	switch (whence) {
+	case FS_SEEK_SET:
+		pos = off;
+		break;
+	case FS_SEEK_CUR:
+		pos = file->pos + off;
+		break;
+	case FS_SEEK_END:
+		pos = size + off;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if ((pos < 0) || (pos > size)) {
+		return -EINVAL;
+	}
+
+	file->pos = pos;
+
+	return 0;
+}
+
+static off_t imgfs_tell(struct fs_file_t *fp)
+{
+	struct imgfs_file *file = fp->filep;
+
+	return file->pos;
+}
+
+static int imgfs_opendir(struct fs_dir_t *dp, const char *path)
+{
+	const uint8_t *image = dp->mp->storage_dev;
+	const struct imgfs_entry *entry;
+	struct imgfs_dir *dir;
+	uint32_t idx, first, count;
+	int rc;
+
+	rc = imgfs_lookup(image, fs_impl_strip_prefix(path, dp->mp), &idx);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (idx == IMGFS_ROOT) {
+		first = 0;
+		count = sys_le32_to_cpu(imgfs_header(image)->root_count);
+	} else {
+		entry = imgfs_entry(image, idx);
+		if (entry->type != IMGFS_TYPE_DIR) {
+			return -ENOTDIR;
+		}
+		first = sys_le32_to_cpu(entry->data_off);
+		count = sys_le32_to_cpu(entry->size);
+	}
+
+	if (k_mem_slab_alloc(&imgfs_dir_pool, (void **)&dir, K_NO_WAIT) != 0) {
+		return -ENOMEM;
+	}
+
+	dir->image = image;
+	dir->next = first;
+	dir->end = first + count;
+	dp->dirp = dir;
+
+	return 0;
+}
+
+static int imgfs_readdir(struct fs_dir_t *dp, struct fs_dirent *entry)
+{
+	struct imgfs_dir *dir = dp->dirp;
+
+	if (dir->next >= dir->end) {
+		/* End of directory */
+		entry->name[0] = '\0';
+		return 0;
+	}
+
+	imgfs_to_dirent(dir->image, dir->next++, entry);
+
+	return 0;
+}
+
+static int imgfs_closedir(struct fs_dir_t *dp)
+{
+	k_mem_slab_free(&imgfs_dir_pool, dp->dirp);
+	dp->dirp = NULL;
+
+	return 0;
+}
+
+static int imgfs_stat(struct fs_mount_t *mountp, const char *path, struct fs_dirent *entry)
+{
+	uint32_t idx;
+	int rc;
+
+	rc = imgfs_lookup(mountp->storage_dev, fs_impl_strip_prefix(path, mountp), &idx);
+	if (rc < 0) {
+		return rc;
+	}
+
+	imgfs_to_dirent(mountp->storage_dev, idx, entry);
+
+	return 0;
+}
+
+static int imgfs_statvfs(struct fs_mount_t *mountp, const char *path, struct fs_statvfs *stat)
+{
+	const struct imgfs_header *hdr = imgfs_header(mountp->storage_dev);
+	uint32_t block_size = sys_le32_to_cpu(hdr->block_size);
+
+	ARG_UNUSED(path);
+
+	stat->f_bsize = block_size;
+	stat->f_frsize = block_size;
+	stat->f_blocks = DIV_ROUND_UP(sys_le32_to_cpu(hdr->image_size), block_size);
+	stat->f_bfree = 0;
+
+	return 0;
+}
+
+static int imgfs_mount(struct fs_mount_t *mountp)
+{
+	const uint8_t *image = mountp->storage_dev;
+	const struct imgfs_header *hdr = imgfs_header(image);
+	uint32_t count, names_off, image_size, block_size;
+
+	if ((image == NULL) || !IS_ALIGNED(image, sizeof(uint32_t))) {
+		return -EINVAL;
+	}
+
+	if ((memcmp(hdr->magic, IMGFS_MAGIC, sizeof(hdr->magic)) != 0) ||
+	    (sys_le16_to_cpu(hdr->version) != IMGFS_VERSION)) {
+		LOG_ERR("invalid image at %p", (void *)image);
+		return -EINVAL;
+	}
+
+	count = sys_le32_to_cpu(hdr->entry_count);
+	names_off = sys_le32_to_cpu(hdr->names_off);
+	image_size = sys_le32_to_cpu(hdr->image_size);
+	block_size = sys_le32_to_cpu(hdr->block_size);
+
+	if ((names_off < sizeof(*hdr) + (size_t)count * sizeof(struct imgfs_entry)) ||
+	    (names_off > image_size) || (block_size == 0) ||
+	    (sys_le32_to_cpu(hdr->root_count) > count)) {
+		LOG_ERR("invalid image at %p", (void *)image);
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_FILE_SYSTEM_IMGFS_LZ4
+	if (block_size > sizeof(imgfs_block)) {
+		LOG_ERR("image blocks of %u bytes, more than %u", block_size,
+			CONFIG_FILE_SYSTEM_IMGFS_BLOCK_SIZE);
+		return -EINVAL;
+	}
+#endif
+
+	return 0;
+}
+
+static int imgfs_unmount(struct fs_mount_t *mountp)
+{
+	ARG_UNUSED(mountp);
+
+	return 0;
+}
+
+/* File system interface */
+static const struct fs_file_system_t imgfs_fs = {
+	.open = imgfs_open,
+	.close = imgfs_close,
+	.read = imgfs_read,
+	.lseek = imgfs_lseek,
+	.tell = imgfs_tell,
+#ifdef CONFIG_FILE_SYSTEM_READ_DIRECT
+	.read_direct = imgfs_read_direct,
+#endif
+	.opendir = imgfs_opendir,
+	.readdir = imgfs_readdir,
+	.closedir = imgfs_closedir,
+	.mount = imgfs_mount,
+	.unmount = imgfs_unmount,
+	.stat = imgfs_stat,
+	.statvfs = imgfs_statvfs,
+};
+
+static int imgfs_init(void)
+{
+	return fs_register(FS_IMGFS, &imgfs_fs);
+}
+
+SYS_INIT(imgfs_init, POST_KERNEL, CONFIG_FILE_SYSTEM_INIT_PRIORITY);
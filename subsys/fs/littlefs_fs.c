@@ -85,6 +85,9 @@ static inline void fc_release(void *buf)
 	k_heap_free(&file_cache_heap, buf);
 }
 
+/* The littlefs core shares its read and program caches between all the
+ * operations of a mount, reads included, so these are all serialized.
+ */
 static inline void fs_lock(struct fs_littlefs *fs)
 {
 	k_mutex_lock(&fs->mutex, K_FOREVER);
@@ -168,12 +171,110 @@ static int errno_to_lfs(int error)
 
 #ifdef CONFIG_FS_LITTLEFS_FMP_DEV
 
+#ifdef CONFIG_FS_LITTLEFS_READ_CACHE
+#define READ_CACHE_LINE_SIZE CONFIG_FS_LITTLEFS_READ_CACHE_LINE_SIZE
+#define READ_CACHE_ALL_BLOCKS ((lfs_block_t)-1)
+
+struct read_cache_line {
+	/* Flash area of the line, NULL when unused */
+	const struct flash_area *fa;
+	lfs_block_t block;
+	lfs_off_t off;
+	uint32_t used;
+	uint8_t data[READ_CACHE_LINE_SIZE] __aligned(4);
+};
+
+/* Shared by the mounts, which each hold their own lock while reading */
+static struct read_cache_line read_cache[CONFIG_FS_LITTLEFS_READ_CACHE_LINES];
+static uint32_t read_cache_clock;
+static K_MUTEX_DEFINE(read_cache_mutex);
+
+static bool read_cache_fits(const struct lfs_config *c, lfs_off_t off,
+			    lfs_size_t size)
+{
+	return (c->block_size % READ_CACHE_LINE_SIZE) == 0 && size != 0 &&
+	       (off / READ_CACHE_LINE_SIZE) ==
+	       ((off + size - 1) / READ_CACHE_LINE_SIZE);
+}
+
+static int read_cache_read(const struct flash_area *fa, lfs_block_t block,
+			   lfs_size_t block_size, lfs_off_t off, void *buffer,
+			   lfs_size_t size)
+{
+	lfs_off_t line_off = ROUND_DOWN(off, READ_CACHE_LINE_SIZE);
+	struct read_cache_line *line = NULL;
+	int rc = 0;
+
+	k_mutex_lock(&read_cache_mutex, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(read_cache); i++) {
+		struct read_cache_line *cur = &read_cache[i];
+
+		if (cur->fa == fa && cur->block == block &&
+		    cur->off == line_off) {
+			line = cur;
+			break;
+		}
+
+		/* Otherwise replace an unused line or the least recently used */
+		if (line == NULL || (line->fa != NULL &&
+				     (cur->fa == NULL || cur->used < line->used))) {
+			line = cur;
+		}
+	}
+
+	if (line->fa != fa || line->block != block || line->off != line_off) {
+		rc = flash_area_read(fa, block * block_size + line_off,
+				     line->data, READ_CACHE_LINE_SIZE);
+		if (rc < 0) {
+			line->fa = NULL;
+			goto out;
+		}
+
+		line->fa = fa;
+		line->block = block;
+		line->off = line_off;
+	}
+
+	line->used = ++read_cache_clock;
+	memcpy(buffer, &line->data[off - line_off], size);
+
+out:
+	k_mutex_unlock(&read_cache_mutex);
+
+	return rc;
+}
+
+/* Drops the lines of a block, or of all the blocks with READ_CACHE_ALL_BLOCKS */
+static void read_cache_invalidate(const struct flash_area *fa,
+				  lfs_block_t block)
+{
+	k_mutex_lock(&read_cache_mutex, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(read_cache); i++) {
+		if (read_cache[i].fa == fa &&
+		    (block == READ_CACHE_ALL_BLOCKS || read_cache[i].block == block)) {
+			read_cache[i].fa = NULL;
+		}
+	}
+
+	k_mutex_unlock(&read_cache_mutex);
+}
+#endif /* CONFIG_FS_LITTLEFS_READ_CACHE */
+
 static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
 			lfs_off_t off, void *buffer, lfs_size_t size)
 {
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_CACHE
+	if (read_cache_fits(c, off, size)) {
+		return errno_to_lfs(read_cache_read(fa, block, c->block_size,
+						    off, buffer, size));
+	}
+#endif
+
 	int rc = flash_area_read(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -185,6 +286,10 @@ static int lfs_api_prog(const struct lfs_config *c, lfs_block_t block,
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_CACHE
+	read_cache_invalidate(fa, block);
+#endif
+
 	int rc = flash_area_write(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -195,6 +300,10 @@ static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size;
 
+#ifdef CONFIG_FS_LITTLEFS_READ_CACHE
+	read_cache_invalidate(fa, block);
+#endif
+
 	int rc = flash_area_erase(fa, offset, c->block_size);
 
 	return errno_to_lfs(rc);
@@ -656,6 +765,12 @@ static int littlefs_flash_init(struct fs_littlefs *fs, void *dev_id)
 	}
 
 	fs->backend = (void *) *fap;
+
+#ifdef CONFIG_FS_LITTLEFS_READ_CACHE
+	/* Lines left over from a file system on the area before */
+	read_cache_invalidate(*fap, READ_CACHE_ALL_BLOCKS);
+#endif
+
 	return 0;
 }
 #endif /* CONFIG_FS_LITTLEFS_FMP_DEV */
@@ -983,6 +1098,9 @@ static int littlefs_unmount(struct fs_mount_t *mountp)
 
 #ifdef CONFIG_FS_LITTLEFS_FMP_DEV
 	if (!littlefs_on_blkdev(mountp->flags)) {
+#ifdef CONFIG_FS_LITTLEFS_READ_CACHE
+		read_cache_invalidate(fs->backend, READ_CACHE_ALL_BLOCKS);
+#endif
 		flash_area_close(fs->backend);
 	}
 #endif /* CONFIG_FS_LITTLEFS_FMP_DEV */
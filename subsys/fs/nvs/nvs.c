@@ -19,9 +19,9 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef NVS_LOOKUP
 
-static inline size_t nvs_lookup_cache_pos(uint16_t id)
+static inline uint16_t nvs_lookup_hash(uint16_t id)
 {
 	uint16_t hash;
 
@@ -33,7 +33,16 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	hash *= 0xdb2dU;
 	hash ^= hash >> 9;
 
-	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#endif /* NVS_LOOKUP */
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return nvs_lookup_hash(id) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
@@ -82,8 +91,171 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 	}
 }
 
+static inline uint32_t nvs_lookup_get(struct nvs_fs *fs, uint16_t id)
+{
+	return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+}
+
+static inline void nvs_lookup_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	fs->lookup_cache[nvs_lookup_cache_pos(id)] = addr;
+}
+
+static inline int nvs_lookup_rebuild(struct nvs_fs *fs)
+{
+	return nvs_lookup_cache_rebuild(fs);
+}
+
+static inline void nvs_lookup_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	nvs_lookup_cache_invalidate(fs, sector);
+}
+
+/* Make lookups walk all allocation tables, until the cache is rebuilt */
+static void nvs_lookup_walk_all(struct nvs_fs *fs)
+{
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		fs->lookup_cache[i] = fs->ate_wra;
+	}
+}
+
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NVS_LOOKUP_INDEX_SIZE),
+	     "CONFIG_NVS_LOOKUP_INDEX_SIZE must be a power of 2");
+
+#define NVS_LOOKUP_INDEX_MASK (CONFIG_NVS_LOOKUP_INDEX_SIZE - 1)
+#define NVS_LOOKUP_INDEX_NO_SLOT (-1)
+
+/* The index is an open addressed hash table with linear probing. Slots of
+ * ids that are not in flash anymore keep their id with no address, so that
+ * probing goes on past them, and are reused by the next id that is added.
+ */
+static int nvs_lookup_index_find(struct nvs_fs *fs, uint16_t id, int *free_slot)
+{
+	size_t pos = nvs_lookup_hash(id) & NVS_LOOKUP_INDEX_MASK;
+
+	*free_slot = NVS_LOOKUP_INDEX_NO_SLOT;
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_INDEX_SIZE; i++) {
+		if (fs->lookup_index_id[pos] == id) {
+			return pos;
+		}
+
+		if ((*free_slot == NVS_LOOKUP_INDEX_NO_SLOT) &&
+		    (fs->lookup_index_addr[pos] == NVS_LOOKUP_CACHE_NO_ADDR)) {
+			*free_slot = pos;
+		}
+
+		if (fs->lookup_index_id[pos] == 0xFFFF) {
+			break;
+		}
+
+		pos = (pos + 1) & NVS_LOOKUP_INDEX_MASK;
+	}
+
+	return NVS_LOOKUP_INDEX_NO_SLOT;
+}
+
+static uint32_t nvs_lookup_get(struct nvs_fs *fs, uint16_t id)
+{
+	int slot, free_slot;
+
+	slot = nvs_lookup_index_find(fs, id, &free_slot);
+	if (slot != NVS_LOOKUP_INDEX_NO_SLOT) {
+		return fs->lookup_index_addr[slot];
+	}
+
+	/* The id may only be in flash */
+	if (fs->lookup_index_incomplete) {
+		return fs->ate_wra;
+	}
+
+	return NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static void nvs_lookup_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	int slot, free_slot;
+
+	slot = nvs_lookup_index_find(fs, id, &free_slot);
+	if (slot == NVS_LOOKUP_INDEX_NO_SLOT) {
+		slot = free_slot;
+	}
+
+	if (slot == NVS_LOOKUP_INDEX_NO_SLOT) {
+		if (!fs->lookup_index_incomplete) {
+			LOG_WRN("Lookup index full, increase CONFIG_NVS_LOOKUP_INDEX_SIZE");
+			fs->lookup_index_incomplete = true;
+		}
+		return;
+	}
+
+	fs->lookup_index_id[slot] = id;
+	fs->lookup_index_addr[slot] = addr;
+}
+
+static void nvs_lookup_index_clear(struct nvs_fs *fs)
+{
+	memset(fs->lookup_index_id, 0xff, sizeof(fs->lookup_index_id));
+	memset(fs->lookup_index_addr, 0xff, sizeof(fs->lookup_index_addr));
+	fs->lookup_index_incomplete = false;
+}
+
+static int nvs_lookup_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	int free_slot;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+
+	nvs_lookup_index_clear(fs);
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_pref_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		/* The most recent entry of an id is found first */
+		if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate) &&
+		    (nvs_lookup_index_find(fs, ate.id, &free_slot) ==
+		     NVS_LOOKUP_INDEX_NO_SLOT)) {
+			nvs_lookup_set(fs, ate.id, ate_addr);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static void nvs_lookup_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_INDEX_SIZE; i++) {
+		if ((fs->lookup_index_addr[i] >> ADDR_SECT_SHIFT) == sector) {
+			fs->lookup_index_addr[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+
+/* Make lookups walk all allocation tables, until the index is rebuilt */
+static void nvs_lookup_walk_all(struct nvs_fs *fs)
+{
+	nvs_lookup_index_clear(fs);
+	fs->lookup_index_incomplete = true;
+}
+
+#endif /* CONFIG_NVS_LOOKUP_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -163,10 +335,10 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef NVS_LOOKUP
 	/* 0xFFFF is a special-purpose identifier. Exclude it from the cache */
 	if (entry->id != 0xFFFF) {
-		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+		nvs_lookup_set(fs, entry->id, fs->ate_wra);
 	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -305,8 +477,8 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 	LOG_DBG("Erasing flash at %lx, len %d", (long int) offset,
 		fs->sector_size);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#ifdef NVS_LOOKUP
+	nvs_lookup_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -579,6 +751,73 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+/* Copy the entry at gc_addr, in the sector being garbage collected, to the
+ * write sector unless it is a delete or a more recent entry with the same id
+ * exists.
+ */
+static int nvs_gc_ate_move(struct nvs_fs *fs, uint32_t gc_addr, struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr, data_addr;
+
+	if (!nvs_ate_valid(fs, gc_ate)) {
+		return 0;
+	}
+
+#ifdef NVS_LOOKUP
+	wlk_addr = nvs_lookup_get(fs, gc_ate->id);
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	if ((wlk_prev_addr == gc_addr) && gc_ate->len) {
+		/* copy needed */
+		LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+		data_addr = (gc_addr & ADDR_SECT_MASK);
+		data_addr += gc_ate->offset;
+
+		gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+		nvs_ate_crc8_update(gc_ate);
+
+		rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+		if (rc) {
+			return rc;
+		}
+
+		rc = nvs_flash_ate_wrt(fs, gc_ate);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -586,9 +825,8 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -628,58 +866,9 @@ static int nvs_gc(struct nvs_fs *fs)
 			return rc;
 		}
 
-		if (!nvs_ate_valid(fs, &gc_ate)) {
-			continue;
-		}
-
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
-
-		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
-		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
-
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
-
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
-
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
-
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
+		rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
+		if (rc) {
+			return rc;
 		}
 	} while (gc_prev_addr != stop_addr);
 
@@ -698,6 +887,14 @@ gc_done:
 		}
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	/* Already erased by the incremental gc */
+	if ((fs->gc_state == NVS_GC_INC_ERASED) &&
+	    (fs->gc_sector == (sec_addr >> ADDR_SECT_SHIFT))) {
+		return 0;
+	}
+#endif
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -706,6 +903,123 @@ gc_done:
 	return 0;
 }
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* Incremental garbage collection of the oldest sector, which is the one
+ * after the empty sector that follows the write sector. Its entries are
+ * moved to the write sector a few at a time and it is erased once it holds
+ * no valid data, so that the gc done when the write sector is closed has
+ * nothing left to do.
+ *
+ * The sector is not erased early when it is the only closed sector, as
+ * nvs_startup() finds the write sector from the closed sector before it.
+ *
+ * Returns 0 when nothing more can be done before the write sector is closed,
+ * 1 otherwise.
+ */
+static int nvs_gc_inc_step(struct nvs_fs *fs, size_t max_ates)
+{
+	int rc;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_prev_addr, stop_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+	nvs_sector_advance(fs, &sec_addr);
+
+	/* The oldest sector changes when the write sector is closed */
+	if (fs->gc_sector != (sec_addr >> ADDR_SECT_SHIFT)) {
+		fs->gc_sector = sec_addr >> ADDR_SECT_SHIFT;
+		fs->gc_state = NVS_GC_INC_START;
+	}
+
+	if (fs->gc_state == NVS_GC_INC_START) {
+		fs->gc_addr = sec_addr + fs->sector_size - ate_size;
+
+		rc = nvs_flash_ate_rd(fs, fs->gc_addr, &close_ate);
+		if (rc) {
+			return rc;
+		}
+
+		/* the sector is not closed, so it holds no data, and the
+		 * gc at sector close can skip its erase if it is blank.
+		 */
+		rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
+		if (!rc) {
+			rc = nvs_flash_cmp_const(fs, sec_addr, fs->flash_parameters->erase_value,
+						 fs->sector_size);
+			if (rc < 0) {
+				return rc;
+			}
+
+			fs->gc_state = rc ? NVS_GC_INC_DONE : NVS_GC_INC_ERASED;
+			return 0;
+		}
+
+		if (nvs_close_ate_valid(fs, &close_ate)) {
+			fs->gc_addr &= ADDR_SECT_MASK;
+			fs->gc_addr += close_ate.offset;
+		} else {
+			rc = nvs_recover_last_ate(fs, &fs->gc_addr);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		fs->gc_state = NVS_GC_INC_MOVE;
+	}
+
+	if (fs->gc_state == NVS_GC_INC_ERASE) {
+		/* The erase is a step on its own, being the longest operation */
+		rc = nvs_flash_erase_sector(fs, sec_addr);
+		if (rc) {
+			return rc;
+		}
+
+		fs->gc_state = NVS_GC_INC_ERASED;
+	}
+
+	if ((fs->gc_state == NVS_GC_INC_DONE) || (fs->gc_state == NVS_GC_INC_ERASED)) {
+		return 0;
+	}
+
+	stop_addr = sec_addr + fs->sector_size - 2 * ate_size;
+
+	for (; max_ates > 0; max_ates--) {
+		gc_prev_addr = fs->gc_addr;
+		rc = nvs_flash_ate_rd(fs, gc_prev_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		/* Leave the entries that do not fit in the write sector to the
+		 * gc done when it is closed, and room for a delete ate.
+		 */
+		if (nvs_ate_valid(fs, &gc_ate) && gc_ate.len &&
+		    (fs->ate_wra < (fs->data_wra + nvs_al_size(fs, gc_ate.len) + ate_size))) {
+			return 0;
+		}
+
+		rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (gc_prev_addr == stop_addr) {
+			fs->gc_state = (fs->sector_count > 3) ? NVS_GC_INC_ERASE :
+								NVS_GC_INC_DONE;
+			break;
+		}
+
+		fs->gc_addr += ate_size;
+	}
+
+	return 1;
+}
+#endif /* CONFIG_NVS_GC_INCREMENTAL */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -865,15 +1179,13 @@ static int nvs_startup(struct nvs_fs *fs)
 		fs->ate_wra &= ADDR_SECT_MASK;
 		fs->ate_wra += (fs->sector_size - 2 * ate_size);
 		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef NVS_LOOKUP
 		/**
 		 * At this point, the lookup cache wasn't built but the gc function need to use it.
 		 * So, temporarily, we set the lookup cache to the end of the fs.
 		 * The cache will be rebuilt afterwards
 		 **/
-		for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
-			fs->lookup_cache[i] = fs->ate_wra;
-		}
+		nvs_lookup_walk_all(fs);
 #endif
 		rc = nvs_gc(fs);
 		goto end;
@@ -910,9 +1222,9 @@ static int nvs_startup(struct nvs_fs *fs)
 
 end:
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef NVS_LOOKUP
 	if (!rc) {
-		rc = nvs_lookup_cache_rebuild(fs);
+		rc = nvs_lookup_rebuild(fs);
 	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
@@ -991,6 +1303,10 @@ int nvs_mount(struct nvs_fs *fs)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc_sector = NVS_GC_INC_NO_SECTOR;
+#endif
+
 	rc = nvs_startup(fs);
 	if (rc) {
 		return rc;
@@ -1037,8 +1353,8 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+#ifdef NVS_LOOKUP
+	wlk_addr = nvs_lookup_get(fs, id);
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
@@ -1063,7 +1379,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef NVS_LOOKUP
 no_cached_entry:
 #endif
 
@@ -1134,6 +1450,19 @@ no_cached_entry:
 		}
 		gc_count++;
 	}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	if ((CONFIG_NVS_GC_INCREMENTAL_WRITE_STEP > 0) && (fs->sector_count >= 3)) {
+		/* The entry is written, so a gc failure is only reported
+		 * by the next gc.
+		 */
+		rc = nvs_gc_inc_step(fs, CONFIG_NVS_GC_INCREMENTAL_WRITE_STEP);
+		if (rc < 0) {
+			LOG_WRN("Incremental gc failed: %d", rc);
+		}
+	}
+#endif
+
 	rc = len;
 end:
 	k_mutex_unlock(&fs->nvs_lock);
@@ -1145,6 +1474,29 @@ int nvs_delete(struct nvs_fs *fs, uint16_t id)
 	return nvs_write(fs, id, NULL, 0);
 }
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+int nvs_gc_step(struct nvs_fs *fs, size_t max_entries)
+{
+	int rc;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	/* With 2 sectors the oldest sector is the write sector */
+	if (fs->sector_count < 3) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	rc = nvs_gc_inc_step(fs, max_entries);
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return rc;
+}
+#endif
+
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		      uint16_t cnt)
 {
@@ -1167,8 +1519,8 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+#ifdef NVS_LOOKUP
+	wlk_addr = nvs_lookup_get(fs, id);
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
@@ -30,6 +30,21 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_LOOKUP_INDEX)
+#define NVS_LOOKUP 1
+#endif
+
+/*
+ * Incremental garbage collection states of the oldest sector
+ */
+#define NVS_GC_INC_START  0 /* not looked at yet */
+#define NVS_GC_INC_MOVE   1 /* moving its entries, from fs->gc_addr */
+#define NVS_GC_INC_ERASE  2 /* holds no valid data anymore */
+#define NVS_GC_INC_DONE   3 /* holds no valid data, left for nvs_gc() to erase */
+#define NVS_GC_INC_ERASED 4 /* erased */
+
+#define NVS_GC_INC_NO_SECTOR 0xFFFF
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <zephyr/input/input.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -11,9 +13,34 @@
 
 LOG_MODULE_REGISTER(input, CONFIG_INPUT_LOG_LEVEL);
 
+#ifdef CONFIG_INPUT_COALESCE
+
+/* The events of a device up to a sync, queued as one message */
+struct input_frame {
+	const struct device *dev;
+	uint8_t count;
+	bool sync;
+	struct {
+		uint8_t type;
+		uint16_t code;
+		int32_t value;
+	} events[CONFIG_INPUT_COALESCE_MAX_EVENTS];
+};
+
+#define INPUT_MSG_SIZE sizeof(struct input_frame)
+
+static struct input_frame input_frames[CONFIG_INPUT_COALESCE_MAX_DEVICES];
+static struct k_spinlock input_frames_lock;
+
+#else
+
+#define INPUT_MSG_SIZE sizeof(struct input_event)
+
+#endif /* CONFIG_INPUT_COALESCE */
+
 #ifdef CONFIG_INPUT_MODE_THREAD
 
-K_MSGQ_DEFINE(input_msgq, sizeof(struct input_event),
+K_MSGQ_DEFINE(input_msgq, INPUT_MSG_SIZE,
 	      CONFIG_INPUT_QUEUE_MAX_MSGS, 4);
 
 #endif
@@ -27,6 +54,113 @@ static void input_process(struct input_event *evt)
 	}
 }
 
+#ifdef CONFIG_INPUT_COALESCE
+
+static void input_process_frame(struct input_frame *frame)
+{
+	struct input_event evt = {
+		.dev = frame->dev,
+	};
+
+	for (uint8_t i = 0; i < frame->count; i++) {
+		evt.type = frame->events[i].type;
+		evt.code = frame->events[i].code;
+		evt.value = frame->events[i].value;
+		evt.sync = frame->sync && i == frame->count - 1;
+
+		input_process(&evt);
+	}
+}
+
+static struct input_frame *input_frame_get(const struct device *dev)
+{
+	struct input_frame *free_frame = NULL;
+
+	ARRAY_FOR_EACH_PTR(input_frames, frame) {
+		if (frame->dev == dev) {
+			return frame;
+		}
+
+		if (frame->dev == NULL && free_frame == NULL) {
+			free_frame = frame;
+		}
+	}
+
+	/* Devices keep their slot, there is a handful of them at most */
+	if (free_frame != NULL) {
+		free_frame->dev = dev;
+		free_frame->count = 0;
+	}
+
+	return free_frame;
+}
+
+/*
+ * Add the event to the pending frame of its device. Relative motion is summed
+ * and only the last absolute value of an axis is kept, as long as no other
+ * kind of event was reported since. Returns true with a frame to queue, once
+ * synced or full.
+ */
+static bool input_coalesce(struct input_event *evt, struct input_frame *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&input_frames_lock);
+	struct input_frame *frame;
+	bool ready = false;
+	int i;
+
+	frame = evt->dev != NULL ? input_frame_get(evt->dev) : NULL;
+	if (frame == NULL) {
+		/* No slot, queue the event on its own */
+		out->dev = evt->dev;
+		out->count = 1;
+		out->sync = evt->sync;
+		out->events[0].type = evt->type;
+		out->events[0].code = evt->code;
+		out->events[0].value = evt->value;
+		k_spin_unlock(&input_frames_lock, key);
+		return true;
+	}
+
+	for (i = frame->count - 1; i >= 0; i--) {
+		uint8_t type = frame->events[i].type;
+
+		if (type != INPUT_EV_REL && type != INPUT_EV_ABS) {
+			i = -1;
+			break;
+		}
+
+		if (type == evt->type && frame->events[i].code == evt->code) {
+			break;
+		}
+	}
+
+	if (i >= 0) {
+		if (evt->type == INPUT_EV_REL) {
+			frame->events[i].value += evt->value;
+		} else {
+			frame->events[i].value = evt->value;
+		}
+	} else {
+		i = frame->count++;
+		frame->events[i].type = evt->type;
+		frame->events[i].code = evt->code;
+		frame->events[i].value = evt->value;
+	}
+
+	if (evt->sync || frame->count == CONFIG_INPUT_COALESCE_MAX_EVENTS) {
+		memcpy(out, frame, sizeof(*out));
+		out->sync = evt->sync;
+		frame->count = 0;
+		ready = true;
+	}
+
+	k_spin_unlock(&input_frames_lock, key);
+
+	return ready;
+}
+
+#endif /* CONFIG_INPUT_COALESCE */
+
 bool input_queue_empty(void)
 {
 #ifdef CONFIG_INPUT_MODE_THREAD
@@ -49,7 +183,15 @@ int input_report(const struct device *dev,
 		.value = value,
 	};
 
-#ifdef CONFIG_INPUT_MODE_THREAD
+#if defined(CONFIG_INPUT_COALESCE)
+	struct input_frame frame;
+
+	if (!input_coalesce(&evt, &frame)) {
+		return 0;
+	}
+
+	return k_msgq_put(&input_msgq, &frame, timeout);
+#elif defined(CONFIG_INPUT_MODE_THREAD)
 	return k_msgq_put(&input_msgq, &evt, timeout);
 #else
 	input_process(&evt);
@@ -61,7 +203,11 @@ int input_report(const struct device *dev,
 
 static void input_thread(void)
 {
+#ifdef CONFIG_INPUT_COALESCE
+	struct input_frame evt;
+#else
 	struct input_event evt;
+#endif
 	int ret;
 
 	while (true) {
@@ -71,7 +217,11 @@ static void input_thread(void)
 			continue;
 		}
 
+#ifdef CONFIG_INPUT_COALESCE
+		input_process_frame(&evt);
+#else
 		input_process(&evt);
+#endif
 	}
 }
 
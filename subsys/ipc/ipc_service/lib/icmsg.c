@@ -44,6 +44,12 @@ static int mbox_deinit(const struct icmsg_config_t *conf,
 
 	(void)k_work_cancel(&dev_data->mbox_work);
 	(void)k_work_cancel_delayable(&dev_data->notify_work);
+#ifdef CONFIG_IPC_SERVICE_ICMSG_SIGNAL_COALESCE
+	(void)k_work_cancel_delayable(&dev_data->signal_work);
+#endif
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+	(void)k_work_cancel_delayable(&dev_data->poll_work);
+#endif
 
 	return 0;
 }
@@ -67,6 +73,65 @@ static void notify_process(struct k_work *item)
 	}
 }
 
+#ifdef CONFIG_IPC_SERVICE_ICMSG_SIGNAL_COALESCE
+static void signal_process(struct k_work *item)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
+	struct icmsg_data_t *dev_data =
+		CONTAINER_OF(dwork, struct icmsg_data_t, signal_work);
+
+	if (atomic_set(&dev_data->signal_pending, 0) != 0) {
+		(void)mbox_send_dt(&dev_data->cfg->mbox_tx, NULL);
+	}
+}
+#endif
+
+/* Signal the message of len bytes written at wr_idx to the remote. */
+static int signal_remote(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 uint32_t wr_idx, size_t len)
+{
+	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_SIGNAL_COALESCE
+	bool was_empty = pbuf_reader_at(dev_data->tx_pb, wr_idx);
+	atomic_val_t pending;
+
+	if (CONFIG_IPC_SERVICE_ICMSG_SIGNAL_DELAY_US == 0) {
+		return was_empty ? mbox_send_dt(&conf->mbox_tx, NULL) : 0;
+	}
+
+	if (was_empty) {
+		pending = len;
+		atomic_set(&dev_data->signal_pending, pending);
+	} else if (atomic_get(&dev_data->signal_pending) != 0) {
+		/* The delayed signal covers this message too. */
+		pending = atomic_add(&dev_data->signal_pending, len) + len;
+	} else {
+		/* The remote was signalled and reads until the buffer is empty. */
+		return 0;
+	}
+
+	if (CONFIG_IPC_SERVICE_ICMSG_SIGNAL_BYTES > 0 &&
+	    pending >= CONFIG_IPC_SERVICE_ICMSG_SIGNAL_BYTES) {
+		if (atomic_set(&dev_data->signal_pending, 0) != 0) {
+			return mbox_send_dt(&conf->mbox_tx, NULL);
+		}
+		return 0;
+	}
+
+	(void)k_work_schedule_for_queue(workq, &dev_data->signal_work,
+					K_USEC(CONFIG_IPC_SERVICE_ICMSG_SIGNAL_DELAY_US));
+
+	return 0;
+#else
+	ARG_UNUSED(wr_idx);
+	ARG_UNUSED(len);
+
+	return mbox_send_dt(&conf->mbox_tx, NULL);
+#endif
+}
+
 static bool is_endpoint_ready(struct icmsg_data_t *dev_data)
 {
 	return atomic_get(&dev_data->state) == ICMSG_STATE_READY;
@@ -122,23 +187,9 @@ static void submit_work_if_buffer_free_and_data_available(
 	submit_mbox_work(dev_data);
 }
 
-static void mbox_callback_process(struct k_work *item)
+static int process_message(struct icmsg_data_t *dev_data, atomic_t state,
+			   const uint8_t *rx_buffer, uint32_t len)
 {
-	struct icmsg_data_t *dev_data = CONTAINER_OF(item, struct icmsg_data_t, mbox_work);
-
-	atomic_t state = atomic_get(&dev_data->state);
-
-	uint32_t len = data_available(dev_data);
-
-	if (len == 0) {
-		/* Unlikely, no data in buffer. */
-		return;
-	}
-
-	uint8_t rx_buffer[len];
-
-	len = pbuf_read(dev_data->rx_pb, rx_buffer, len);
-
 	if (state == ICMSG_STATE_READY) {
 		if (dev_data->cb->received) {
 			dev_data->cb->received(rx_buffer, len,
@@ -153,7 +204,7 @@ static void mbox_callback_process(struct k_work *item)
 
 		if (endpoint_invalid) {
 			__ASSERT_NO_MSG(false);
-			return;
+			return -EINVAL;
 		}
 
 		if (dev_data->cb->bound) {
@@ -163,7 +214,102 @@ static void mbox_callback_process(struct k_work *item)
 		atomic_set(&dev_data->state, ICMSG_STATE_READY);
 	}
 
-	submit_work_if_buffer_free_and_data_available(dev_data);
+	return 0;
+}
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+static void poll_process(struct k_work *item)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
+	struct icmsg_data_t *dev_data =
+		CONTAINER_OF(dwork, struct icmsg_data_t, poll_work);
+
+	submit_mbox_work(dev_data);
+}
+#endif
+
+/* All the received messages are processed. */
+static void rx_idle(struct icmsg_data_t *dev_data)
+{
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+	if (!dev_data->rx_polling) {
+		/* Poll instead of taking a signal per message of a burst. */
+		(void)mbox_set_enabled_dt(&dev_data->cfg->mbox_rx, 0);
+		dev_data->rx_polling = true;
+		dev_data->rx_poll_idle = 0;
+	}
+
+	if (++dev_data->rx_poll_idle > CONFIG_IPC_SERVICE_ICMSG_RX_POLL_IDLE_COUNT) {
+		dev_data->rx_polling = false;
+		(void)mbox_set_enabled_dt(&dev_data->cfg->mbox_rx, 1);
+
+		/* A message written while the signal was off is not signalled again. */
+		submit_work_if_buffer_free_and_data_available(dev_data);
+		return;
+	}
+
+	(void)k_work_reschedule_for_queue(workq, &dev_data->poll_work,
+					  K_USEC(CONFIG_IPC_SERVICE_ICMSG_RX_POLL_INTERVAL_US));
+#endif
+}
+
+static void mbox_callback_process(struct k_work *item)
+{
+	struct icmsg_data_t *dev_data = CONTAINER_OF(item, struct icmsg_data_t, mbox_work);
+
+	atomic_t state = atomic_get(&dev_data->state);
+
+	if (atomic_get(&dev_data->rx_held)) {
+		/* Processing resumes when the held message is released. */
+		return;
+	}
+
+	const char *rx_data;
+	int ret = pbuf_read_peek(dev_data->rx_pb, &rx_data);
+
+	if (ret <= 0) {
+		/* No data in buffer, unlikely unless polling. */
+		if (IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_RX_POLL) && state == ICMSG_STATE_READY &&
+		    ret == 0) {
+			rx_idle(dev_data);
+		}
+		return;
+	}
+
+	uint32_t len = ret;
+
+	if (rx_data != NULL) {
+		/* The message is handed over straight from the shared memory. */
+		dev_data->rx_buffer = rx_data;
+		ret = process_message(dev_data, state, (const uint8_t *)rx_data, len);
+		dev_data->rx_buffer = NULL;
+
+		if (atomic_get(&dev_data->rx_held)) {
+			return;
+		}
+
+		(void)pbuf_read_release(dev_data->rx_pb);
+	} else {
+		/* Copy a message wrapping around the end of the shared memory. */
+		uint8_t rx_buffer[len];
+
+		len = pbuf_read(dev_data->rx_pb, rx_buffer, len);
+		ret = process_message(dev_data, state, rx_buffer, len);
+	}
+
+	if (ret < 0) {
+		return;
+	}
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+	dev_data->rx_poll_idle = 0;
+#endif
+
+	if (data_available(dev_data)) {
+		submit_mbox_work(dev_data);
+	} else if (state == ICMSG_STATE_READY) {
+		rx_idle(dev_data);
+	}
 }
 
 static void mbox_callback(const struct device *instance, uint32_t channel,
@@ -180,6 +326,14 @@ static int mbox_init(const struct icmsg_config_t *conf,
 
 	k_work_init(&dev_data->mbox_work, mbox_callback_process);
 	k_work_init_delayable(&dev_data->notify_work, notify_process);
+#ifdef CONFIG_IPC_SERVICE_ICMSG_SIGNAL_COALESCE
+	k_work_init_delayable(&dev_data->signal_work, signal_process);
+	atomic_clear(&dev_data->signal_pending);
+#endif
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+	k_work_init_delayable(&dev_data->poll_work, poll_process);
+	dev_data->rx_polling = false;
+#endif
 
 	err = mbox_register_callback_dt(&conf->mbox_rx, mbox_callback, dev_data);
 	if (err != 0) {
@@ -217,6 +371,11 @@ int icmsg_open(const struct icmsg_config_t *conf,
 	dev_data->rx_pb->data.wr_idx = 0;
 	dev_data->rx_pb->data.rd_idx = 0;
 
+	atomic_clear(&dev_data->tx_claimed);
+	atomic_clear(&dev_data->rx_held);
+	dev_data->rx_buffer = NULL;
+	dev_data->rx_held_buffer = NULL;
+
 	ret = pbuf_write(dev_data->tx_pb, magic, sizeof(magic));
 
 	if (ret < 0) {
@@ -265,6 +424,7 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	int write_ret;
 	int release_ret;
 	int sent_bytes;
+	uint32_t wr_idx;
 
 	if (!is_endpoint_ready(dev_data)) {
 		return -EBUSY;
@@ -280,6 +440,13 @@ int icmsg_send(const struct icmsg_config_t *conf,
 		return -ENOBUFS;
 	}
 
+	if (atomic_get(&dev_data->tx_claimed)) {
+		/* The message would overwrite the claimed TX buffer. */
+		(void)release_tx_buffer(dev_data);
+		return -ENOBUFS;
+	}
+
+	wr_idx = dev_data->tx_pb->data.wr_idx;
 	write_ret = pbuf_write(dev_data->tx_pb, msg, len);
 	release_ret = release_tx_buffer(dev_data);
 	__ASSERT_NO_MSG(!release_ret);
@@ -291,9 +458,7 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	}
 	sent_bytes = write_ret;
 
-	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
-
-	ret = mbox_send_dt(&conf->mbox_tx, NULL);
+	ret = signal_remote(conf, dev_data, wr_idx, sent_bytes);
 	if (ret) {
 		return ret;
 	}
@@ -301,6 +466,129 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	return sent_bytes;
 }
 
+int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
+			struct icmsg_data_t *dev_data,
+			void **data, uint32_t *len)
+{
+	int ret;
+
+	if (!is_endpoint_ready(dev_data)) {
+		return -EBUSY;
+	}
+
+	ret = reserve_tx_buffer_if_unused(dev_data);
+	if (ret < 0) {
+		return -ENOBUFS;
+	}
+
+	if (!atomic_cas(&dev_data->tx_claimed, 0, 1)) {
+		(void)release_tx_buffer(dev_data);
+		return -EALREADY;
+	}
+
+	uint16_t size = MIN(*len, UINT16_MAX);
+
+	ret = pbuf_write_alloc(dev_data->tx_pb, (char **)data, &size);
+	*len = size;
+
+	if (ret < 0) {
+		(void)release_tx_buffer(dev_data);
+		atomic_clear(&dev_data->tx_claimed);
+		return ret;
+	}
+
+	return 0;
+}
+
+int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data)
+{
+	if (!atomic_cas(&dev_data->tx_claimed, 1, 0)) {
+		return -EALREADY;
+	}
+
+	(void)release_tx_buffer(dev_data);
+
+	return 0;
+}
+
+int icmsg_send_nocopy(const struct icmsg_config_t *conf,
+		      struct icmsg_data_t *dev_data, size_t len)
+{
+	int ret;
+	int write_ret;
+	uint32_t wr_idx;
+
+	if (!atomic_get(&dev_data->tx_claimed)) {
+		return -EINVAL;
+	}
+
+	/* Empty message is not allowed */
+	if (len == 0) {
+		return -ENODATA;
+	}
+
+	wr_idx = dev_data->tx_pb->data.wr_idx;
+	write_ret = len > UINT16_MAX ? -EBADMSG : pbuf_write_commit(dev_data->tx_pb, len);
+	if (write_ret == -ENOMEM) {
+		write_ret = -EBADMSG;
+	}
+
+	(void)release_tx_buffer(dev_data);
+	atomic_clear(&dev_data->tx_claimed);
+
+	if (write_ret < 0) {
+		return write_ret;
+	}
+
+	ret = signal_remote(conf, dev_data, wr_idx, write_ret);
+	if (ret) {
+		return ret;
+	}
+
+	return write_ret;
+}
+
+int icmsg_hold_rx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data, const void *data)
+{
+	if (data == NULL || data != dev_data->rx_buffer) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&dev_data->rx_held, 0, 1)) {
+		return -EALREADY;
+	}
+
+	dev_data->rx_held_buffer = data;
+
+	return 0;
+}
+
+int icmsg_release_rx_buffer(const struct icmsg_config_t *conf,
+			    struct icmsg_data_t *dev_data, const void *data)
+{
+	if (data == NULL || data != dev_data->rx_held_buffer) {
+		return -EALREADY;
+	}
+
+	dev_data->rx_held_buffer = NULL;
+
+	if (data == dev_data->rx_buffer) {
+		/* Still in the received callback, the processing releases it. */
+		atomic_clear(&dev_data->rx_held);
+		return 0;
+	}
+
+	(void)pbuf_read_release(dev_data->rx_pb);
+	atomic_clear(&dev_data->rx_held);
+
+	/* Resume the processing of the messages received meanwhile. */
+	submit_mbox_work(dev_data);
+
+	return 0;
+}
+
 #if IS_ENABLED(CONFIG_IPC_SERVICE_BACKEND_ICMSG_WQ_ENABLE)
 
 static int work_q_init(void)
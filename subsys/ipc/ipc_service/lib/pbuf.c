@@ -221,3 +221,192 @@ int pbuf_read(struct pbuf *pb, char *buf, uint16_t len)
 
 	return len;
 }
+
+/* Helper function for getting the contiguous free room for the data of the next packet. */
+static int tx_room(struct pbuf *pb, uint32_t *data_idx)
+{
+	/* Invalidate rd_idx only, local wr_idx is used to increase buffer security. */
+	sys_cache_data_invd_range((void *)(pb->cfg->rd_idx_loc), sizeof(*(pb->cfg->rd_idx_loc)));
+	__sync_synchronize();
+
+	const uint32_t blen = pb->cfg->len;
+	uint32_t rd_idx = *(pb->cfg->rd_idx_loc);
+	uint32_t wr_idx = pb->data.wr_idx;
+
+	__ASSERT_NO_MSG(IS_PTR_ALIGNED_BYTES(wr_idx, _PBUF_IDX_SIZE));
+	if (!IS_PTR_ALIGNED_BYTES(rd_idx, _PBUF_IDX_SIZE)) {
+		return -EINVAL;
+	}
+
+	uint32_t free_space = blen - idx_occupied(blen, wr_idx, rd_idx) - _PBUF_IDX_SIZE;
+
+	if (free_space <= PBUF_PACKET_LEN_SZ) {
+		return 0;
+	}
+
+	*data_idx = idx_wrap(blen, wr_idx + PBUF_PACKET_LEN_SZ);
+
+	/* The data of the packet must not wrap. */
+	return MIN(MIN(free_space - PBUF_PACKET_LEN_SZ, blen - *data_idx), UINT16_MAX);
+}
+
+int pbuf_write_alloc(struct pbuf *pb, char **buf, uint16_t *len)
+{
+	uint32_t data_idx;
+	int room;
+
+	if (pb == NULL || buf == NULL || len == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	room = tx_room(pb, &data_idx);
+	if (room < 0) {
+		return room;
+	}
+
+	if (room == 0 || *len > room) {
+		*len = room;
+		return -ENOMEM;
+	}
+
+	*len = room;
+	*buf = (char *)&pb->cfg->data_loc[data_idx];
+
+	return 0;
+}
+
+int pbuf_write_commit(struct pbuf *pb, uint16_t len)
+{
+	uint32_t data_idx;
+	int room;
+
+	if (pb == NULL || len == 0) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	room = tx_room(pb, &data_idx);
+	if (room < 0) {
+		return room;
+	}
+
+	if (len > room) {
+		return -ENOMEM;
+	}
+
+	uint8_t *const data_loc = pb->cfg->data_loc;
+	const uint32_t blen = pb->cfg->len;
+	uint32_t wr_idx = pb->data.wr_idx;
+
+	/* The data was written in place, only the cache and the packet len are left. */
+	sys_cache_data_flush_range(&data_loc[data_idx], len);
+
+	*((uint32_t *)(&data_loc[wr_idx])) = 0;
+	sys_put_be16(len, &data_loc[wr_idx]);
+	__sync_synchronize();
+	sys_cache_data_flush_range(&data_loc[wr_idx], PBUF_PACKET_LEN_SZ);
+
+	wr_idx = idx_wrap(blen, ROUND_UP(data_idx + len, _PBUF_IDX_SIZE));
+	/* Update wr_idx. */
+	pb->data.wr_idx = wr_idx;
+	*(pb->cfg->wr_idx_loc) = wr_idx;
+	__sync_synchronize();
+	sys_cache_data_flush_range((void *)pb->cfg->wr_idx_loc, sizeof(*(pb->cfg->wr_idx_loc)));
+
+	return len;
+}
+
+/* Helper function for getting the length and the data index of the next packet to read. */
+static int rx_packet(struct pbuf *pb, uint32_t *data_idx)
+{
+	/* Invalidate wr_idx only, local rd_idx is used to increase buffer security. */
+	sys_cache_data_invd_range((void *)(pb->cfg->wr_idx_loc), sizeof(*(pb->cfg->wr_idx_loc)));
+	__sync_synchronize();
+
+	uint8_t *const data_loc = pb->cfg->data_loc;
+	const uint32_t blen = pb->cfg->len;
+	uint32_t wr_idx = *(pb->cfg->wr_idx_loc);
+	uint32_t rd_idx = pb->data.rd_idx;
+
+	__ASSERT_NO_MSG(IS_PTR_ALIGNED_BYTES(rd_idx, _PBUF_IDX_SIZE));
+	if (!IS_PTR_ALIGNED_BYTES(wr_idx, _PBUF_IDX_SIZE)) {
+		return -EINVAL;
+	}
+
+	if (rd_idx == wr_idx) {
+		/* Buffer is empty. */
+		return 0;
+	}
+
+	sys_cache_data_invd_range(&data_loc[rd_idx], PBUF_PACKET_LEN_SZ);
+	uint16_t plen = sys_get_be16(&data_loc[rd_idx]);
+
+	if (idx_occupied(blen, wr_idx, rd_idx) < plen + PBUF_PACKET_LEN_SZ) {
+		/* This should never happen. */
+		return -EAGAIN;
+	}
+
+	*data_idx = idx_wrap(blen, rd_idx + PBUF_PACKET_LEN_SZ);
+
+	return plen;
+}
+
+int pbuf_read_peek(struct pbuf *pb, const char **buf)
+{
+	uint32_t data_idx;
+	int plen;
+
+	if (pb == NULL || buf == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	*buf = NULL;
+
+	plen = rx_packet(pb, &data_idx);
+	if (plen <= 0) {
+		return plen;
+	}
+
+	if (plen <= pb->cfg->len - data_idx) {
+		sys_cache_data_invd_range(&pb->cfg->data_loc[data_idx], plen);
+		*buf = (const char *)&pb->cfg->data_loc[data_idx];
+	}
+
+	return plen;
+}
+
+int pbuf_read_release(struct pbuf *pb)
+{
+	uint32_t data_idx;
+	int plen;
+
+	if (pb == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	plen = rx_packet(pb, &data_idx);
+	if (plen <= 0) {
+		return plen == 0 ? -ENODATA : plen;
+	}
+
+	/* Update rd_idx. */
+	uint32_t rd_idx = idx_wrap(pb->cfg->len, ROUND_UP(data_idx + plen, _PBUF_IDX_SIZE));
+
+	pb->data.rd_idx = rd_idx;
+	*(pb->cfg->rd_idx_loc) = rd_idx;
+	__sync_synchronize();
+	sys_cache_data_flush_range((void *)pb->cfg->rd_idx_loc, sizeof(*(pb->cfg->rd_idx_loc)));
+
+	return plen;
+}
+
+bool pbuf_reader_at(struct pbuf *pb, uint32_t idx)
+{
+	sys_cache_data_invd_range((void *)(pb->cfg->rd_idx_loc), sizeof(*(pb->cfg->rd_idx_loc)));
+	__sync_synchronize();
+
+	return *(pb->cfg->rd_idx_loc) == idx;
+}
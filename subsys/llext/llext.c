@@ -107,15 +107,91 @@ int llext_iterate(int (*fn)(struct llext *ext, void *arg), void *arg)
 	return ret;
 }
 
-const void * const llext_find_sym(const struct llext_symtable *sym_table, const char *sym_name)
+/*
+ * The linker sorts the built-in symbols by the names of their sections, which
+ * end with the name of the symbol followed by "_sym", see EXPORT_SYMBOL().
+ * Compare two symbol names in that order.
+ */
+static int llext_sym_order(const char *a, const char *b)
 {
-	if (sym_table == NULL) {
-		/* Built-in symbol table */
+	static const char suffix[] = "_sym";
+	size_t a_len = strlen(a), b_len = strlen(b);
+
+	for (size_t i = 0; ; i++) {
+		unsigned char ca = i < a_len ? a[i] : suffix[MIN(i - a_len, sizeof(suffix) - 1)];
+		unsigned char cb = i < b_len ? b[i] : suffix[MIN(i - b_len, sizeof(suffix) - 1)];
+
+		if (ca != cb || ca == '\0') {
+			return ca - cb;
+		}
+	}
+}
+
+/*
+ * Whether the built-in symbol table can be searched by bisection, checked once
+ * in case the linker script of the target does not sort it.
+ */
+static bool llext_builtin_sorted(void)
+{
+	static enum { UNCHECKED, SORTED, UNSORTED } state;
+
+	if (state == UNCHECKED) {
+		const struct llext_const_symbol *prev = NULL;
+
+		state = SORTED;
+		STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
+			if (prev != NULL && llext_sym_order(prev->name, sym->name) > 0) {
+				LOG_WRN("Built-in symbols not sorted, searching linearly");
+				state = UNSORTED;
+				break;
+			}
+			prev = sym;
+		}
+	}
+
+	return state == SORTED;
+}
+
+static const void *llext_find_builtin_sym(const char *sym_name)
+{
+	if (!llext_builtin_sorted()) {
 		STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
 			if (strcmp(sym->name, sym_name) == 0) {
 				return sym->addr;
 			}
 		}
+
+		return NULL;
+	}
+
+	struct llext_const_symbol *sym;
+	int lo = 0, hi;
+
+	STRUCT_SECTION_COUNT(llext_const_symbol, &hi);
+
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		int cmp;
+
+		STRUCT_SECTION_GET(llext_const_symbol, mid, &sym);
+		cmp = llext_sym_order(sym_name, sym->name);
+		if (cmp == 0) {
+			return sym->addr;
+		} else if (cmp < 0) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+const void * const llext_find_sym(const struct llext_symtable *sym_table, const char *sym_name)
+{
+	if (sym_table == NULL) {
+		/* Built-in symbol table */
+		return llext_find_builtin_sym(sym_name);
 	} else {
 		/* find symbols in module */
 		for (size_t i = 0; i < sym_table->sym_cnt; i++) {
@@ -290,6 +366,89 @@ static void llext_init_mem_part(struct llext *ext, enum llext_mem mem_idx,
 #endif
 }
 
+/*
+ * Check whether the linker writes to a section: it applies relocations to it,
+ * or for .text, resolves PLT and GOT entries in it
+ */
+static bool llext_section_relocated(struct llext_loader *ldr, struct llext *ext,
+				    enum llext_mem mem_idx)
+{
+	elf_shdr_t shdr;
+	const char *name;
+	size_t pos;
+	int i;
+
+	for (i = 0, pos = ldr->hdr.e_shoff;
+	     i < ldr->hdr.e_shnum;
+	     i++, pos += ldr->hdr.e_shentsize) {
+		if (llext_seek(ldr, pos) != 0 ||
+		    llext_read(ldr, &shdr, sizeof(elf_shdr_t)) != 0) {
+			/* Assume the worst, the section will be copied */
+			return true;
+		}
+
+		if ((shdr.sh_type != SHT_REL && shdr.sh_type != SHT_RELA) ||
+		    !shdr.sh_size) {
+			continue;
+		}
+
+		name = llext_string(ldr, ext, LLEXT_MEM_SHSTRTAB, shdr.sh_name);
+
+		switch (mem_idx) {
+		case LLEXT_MEM_TEXT:
+			if (strcmp(name, ".rel.text") == 0 ||
+			    strcmp(name, ".rela.text") == 0 ||
+			    strcmp(name, ".rela.plt") == 0 ||
+			    strcmp(name, ".rela.dyn") == 0) {
+				return true;
+			}
+			break;
+		case LLEXT_MEM_RODATA:
+			if (strcmp(name, ".rel.rodata") == 0 ||
+			    strcmp(name, ".rela.rodata") == 0) {
+				return true;
+			}
+			break;
+		default:
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Check whether a section can be used straight from the loader storage
+ */
+static bool llext_section_in_place(struct llext_loader *ldr, struct llext *ext,
+				   enum llext_mem mem_idx)
+{
+	if (ldr->sects[mem_idx].sh_type == SHT_NOBITS) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_LLEXT_STORAGE_WRITABLE)) {
+		return true;
+	}
+
+	if (!IS_ENABLED(CONFIG_LLEXT_STORAGE_XIP)) {
+		return false;
+	}
+
+	switch (mem_idx) {
+	case LLEXT_MEM_SHSTRTAB:
+	case LLEXT_MEM_STRTAB:
+	case LLEXT_MEM_SYMTAB:
+		return true;
+	case LLEXT_MEM_TEXT:
+	case LLEXT_MEM_RODATA:
+		return !llext_section_relocated(ldr, ext, mem_idx);
+	default:
+		/* .data and .exported_sym are written to */
+		return false;
+	}
+}
+
 static int llext_copy_section(struct llext_loader *ldr, struct llext *ext,
 			      enum llext_mem mem_idx)
 {
@@ -300,8 +459,7 @@ static int llext_copy_section(struct llext_loader *ldr, struct llext *ext,
 	}
 	ext->mem_size[mem_idx] = ldr->sects[mem_idx].sh_size;
 
-	if (ldr->sects[mem_idx].sh_type != SHT_NOBITS &&
-	    IS_ENABLED(CONFIG_LLEXT_STORAGE_WRITABLE)) {
+	if (llext_section_in_place(ldr, ext, mem_idx)) {
 		ext->mem[mem_idx] = llext_peek(ldr, ldr->sects[mem_idx].sh_offset);
 		if (ext->mem[mem_idx]) {
 			llext_init_mem_part(ext, mem_idx, (uintptr_t)ext->mem[mem_idx],
@@ -560,8 +718,31 @@ __weak void arch_elf_relocate_local(struct llext_loader *ldr, struct llext *ext,
 {
 }
 
+/*
+ * Look up an undefined symbol of the extension in the built-in symbol table.
+ * An extension usually refers to the same symbols in many relocations, so
+ * the addresses found are kept by symbol index while linking.
+ */
+static const void *llext_link_sym(const void **sym_cache, unsigned int sym_cnt,
+				  unsigned int idx, const char *name)
+{
+	const void *addr;
+
+	if (sym_cache != NULL && idx < sym_cnt && sym_cache[idx] != NULL) {
+		return sym_cache[idx];
+	}
+
+	addr = llext_find_sym(NULL, name);
+
+	if (sym_cache != NULL && idx < sym_cnt) {
+		sym_cache[idx] = addr;
+	}
+
+	return addr;
+}
+
 static void llext_link_plt(struct llext_loader *ldr, struct llext *ext,
-			   elf_shdr_t *shdr, bool do_local)
+			   elf_shdr_t *shdr, bool do_local, const void **sym_cache)
 {
 	unsigned int sh_cnt = shdr->sh_size / shdr->sh_entsize;
 	/*
@@ -631,7 +812,7 @@ static void llext_link_plt(struct llext_loader *ldr, struct llext *ext,
 
 		switch (stb) {
 		case STB_GLOBAL:
-			link_addr = llext_find_sym(NULL, name);
+			link_addr = llext_link_sym(sym_cache, sym_cnt, j, name);
 			if (!link_addr)
 				link_addr = llext_find_sym(&ext->sym_tab, name);
 
@@ -664,8 +845,10 @@ __weak void arch_elf_relocate(elf_rela_t *rel, uintptr_t opaddr, uintptr_t opval
 {
 }
 
-static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local)
+static int llext_link_sections(struct llext_loader *ldr, struct llext *ext, bool do_local,
+			       const void **sym_cache)
 {
+	unsigned int sym_cnt = ldr->sects[LLEXT_MEM_SYMTAB].sh_size / sizeof(elf_sym_t);
 	uintptr_t loc = 0;
 	elf_shdr_t shdr;
 	elf_rela_t rel;
@@ -713,7 +896,7 @@ static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local
 			loc = (uintptr_t)ext->mem[LLEXT_MEM_EXPORT];
 		} else if (strcmp(name, ".rela.plt") == 0 ||
 			   strcmp(name, ".rela.dyn") == 0) {
-			llext_link_plt(ldr, ext, &shdr, do_local);
+			llext_link_plt(ldr, ext, &shdr, do_local, sym_cache);
 			continue;
 		}
 
@@ -759,7 +942,8 @@ static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local
 
 			/* If symbol is undefined, then we need to look it up */
 			if (sym.st_shndx == SHN_UNDEF) {
-				link_addr = (uintptr_t)llext_find_sym(NULL, name);
+				link_addr = (uintptr_t)llext_link_sym(sym_cache, sym_cnt,
+								      ELF_R_SYM(rel.r_info), name);
 
 				if (link_addr == 0) {
 					LOG_ERR("Undefined symbol with no entry in "
@@ -799,7 +983,9 @@ static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local
 #ifdef CONFIG_CACHE_MANAGEMENT
 	/* Make sure changes to ext sections are flushed to RAM */
 	for (i = 0; i < LLEXT_MEM_COUNT; ++i) {
-		if (ext->mem[i]) {
+		/* Sections used in place in read-only storage are unchanged */
+		if (ext->mem[i] && (ext->mem_on_heap[i] ||
+				    IS_ENABLED(CONFIG_LLEXT_STORAGE_WRITABLE))) {
 			sys_cache_data_flush_range(ext->mem[i], ext->mem_size[i]);
 			sys_cache_instr_invd_range(ext->mem[i], ext->mem_size[i]);
 		}
@@ -809,6 +995,28 @@ static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local
 	return 0;
 }
 
+static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local)
+{
+	size_t cache_sz = ldr->sects[LLEXT_MEM_SYMTAB].sh_size / sizeof(elf_sym_t) *
+			  sizeof(const void *);
+	const void **sym_cache;
+	int ret;
+
+	/* The cache only saves time, link without it if there is no room */
+	sym_cache = k_heap_alloc(&llext_heap, cache_sz, K_NO_WAIT);
+	if (sym_cache != NULL) {
+		memset(sym_cache, 0, cache_sz);
+	} else {
+		LOG_DBG("No memory for the symbol cache, size %zu", cache_sz);
+	}
+
+	ret = llext_link_sections(ldr, ext, do_local, sym_cache);
+
+	k_heap_free(&llext_heap, sym_cache);
+
+	return ret;
+}
+
 /*
  * Load a valid ELF as an extension
  */
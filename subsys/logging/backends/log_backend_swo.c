@@ -25,6 +25,7 @@
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_core.h>
 #include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_backend_std.h>
 #include <zephyr/drivers/pinctrl.h>
 #include <soc.h>
@@ -133,7 +134,11 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	log_backend_std_dropped(&log_output_swo, cnt);
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_SWO_OUTPUT_DICTIONARY)) {
+		log_dict_output_dropped_process(&log_output_swo, cnt);
+	} else {
+		log_backend_std_dropped(&log_output_swo, cnt);
+	}
 }
 
 const struct log_backend_api log_backend_swo_api = {
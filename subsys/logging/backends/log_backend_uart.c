@@ -19,11 +19,27 @@
 #include <zephyr/pm/device_runtime.h>
 LOG_MODULE_REGISTER(log_uart);
 
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC_DOUBLE_BUFFER
+#define LBU_TX_BUF_SIZE CONFIG_LOG_BACKEND_UART_ASYNC_TX_BUFFER_SIZE
+
+/* Output is packed into one buffer while the other one is transmitted. */
+struct lbu_tx {
+	struct k_spinlock lock;
+	uint8_t (*buf)[LBU_TX_BUF_SIZE];
+	size_t len[2];
+	uint8_t fill_idx;
+	bool busy;
+};
+#endif
+
 struct lbu_data {
 	struct k_sem sem;
 	uint32_t log_format_current;
 	volatile bool in_panic;
 	bool use_async;
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC_DOUBLE_BUFFER
+	struct lbu_tx tx;
+#endif
 };
 
 struct lbu_cb_ctx {
@@ -43,6 +59,107 @@ struct lbu_cb_ctx {
  */
 static const char LOG_HEX_SEP[10] = "##ZLOGV1##";
 
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC_DOUBLE_BUFFER
+/* Transmit the buffer being filled, and start filling the other one. */
+static void tx_start_locked(const struct device *uart_dev, struct lbu_tx *tx)
+{
+	uint8_t idx = tx->fill_idx;
+	int err;
+
+	tx->busy = true;
+	tx->fill_idx ^= 1U;
+	tx->len[tx->fill_idx] = 0;
+
+	err = uart_tx(uart_dev, tx->buf[idx], tx->len[idx], SYS_FOREVER_US);
+	__ASSERT_NO_MSG(err == 0);
+	(void)err;
+}
+
+static void tx_done(const struct device *uart_dev, struct lbu_data *data)
+{
+	struct lbu_tx *tx = &data->tx;
+	k_spinlock_key_t key = k_spin_lock(&tx->lock);
+
+	if (tx->len[tx->fill_idx] > 0) {
+		/* Output packed during the transfer goes out right away. */
+		tx_start_locked(uart_dev, tx);
+	} else {
+		tx->busy = false;
+		/* Taken by the char_out() call that started from idle. */
+		(void)pm_device_runtime_put_async(uart_dev, K_MSEC(1));
+	}
+
+	k_spin_unlock(&tx->lock, key);
+
+	k_sem_give(&data->sem);
+}
+
+static void char_out_double_buffer(const struct device *uart_dev, struct lbu_data *data,
+				   uint8_t *buf, size_t length)
+{
+	struct lbu_tx *tx = &data->tx;
+
+	while (length > 0) {
+		k_spinlock_key_t key = k_spin_lock(&tx->lock);
+		size_t *len = &tx->len[tx->fill_idx];
+		size_t n = MIN(length, LBU_TX_BUF_SIZE - *len);
+		bool start;
+
+		if (n == 0) {
+			/* Both buffers are in use, wait for the transfer to end. */
+			k_spin_unlock(&tx->lock, key);
+			(void)k_sem_take(&data->sem, K_FOREVER);
+			continue;
+		}
+
+		memcpy(&tx->buf[tx->fill_idx][*len], buf, n);
+		*len += n;
+		buf += n;
+		length -= n;
+
+		/* When idle, the device is taken before the transfer starts and
+		 * is released once no transfer follows.
+		 */
+		start = !tx->busy;
+		if (start) {
+			tx->busy = true;
+			k_sem_reset(&data->sem);
+		}
+
+		k_spin_unlock(&tx->lock, key);
+
+		if (start) {
+			(void)pm_device_runtime_get(uart_dev);
+
+			key = k_spin_lock(&tx->lock);
+			tx_start_locked(uart_dev, tx);
+			k_spin_unlock(&tx->lock, key);
+		}
+	}
+}
+
+/* Output what is still buffered, the transfer in progress is repeated. */
+static void tx_panic_flush(const struct device *uart_dev, struct lbu_data *data)
+{
+	struct lbu_tx *tx = &data->tx;
+	uint8_t idx = tx->fill_idx ^ 1U;
+
+	if (tx->busy) {
+		(void)uart_tx_abort(uart_dev);
+		for (size_t i = 0; i < tx->len[idx]; i++) {
+			uart_poll_out(uart_dev, tx->buf[idx][i]);
+		}
+	}
+
+	for (size_t i = 0; i < tx->len[tx->fill_idx]; i++) {
+		uart_poll_out(uart_dev, tx->buf[tx->fill_idx][i]);
+	}
+
+	tx->len[0] = 0;
+	tx->len[1] = 0;
+}
+#endif /* CONFIG_LOG_BACKEND_UART_ASYNC_DOUBLE_BUFFER */
+
 static void uart_callback(const struct device *dev,
 			  struct uart_event *evt,
 			  void *user_data)
@@ -54,7 +171,13 @@ static void uart_callback(const struct device *dev,
 
 	switch (evt->type) {
 	case UART_TX_DONE:
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC_DOUBLE_BUFFER
+		if (!data->in_panic) {
+			tx_done(dev, data);
+		}
+#else
 		k_sem_give(&data->sem);
+#endif
 		break;
 	default:
 		break;
@@ -106,6 +229,10 @@ static int char_out(uint8_t *data, size_t length, void *ctx)
 		goto cleanup;
 	}
 
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC_DOUBLE_BUFFER
+	char_out_double_buffer(uart_dev, lb_data, data, length);
+	ARG_UNUSED(err);
+#else
 	err = uart_tx(uart_dev, data, length, SYS_FOREVER_US);
 	__ASSERT_NO_MSG(err == 0);
 
@@ -113,6 +240,7 @@ static int char_out(uint8_t *data, size_t length, void *ctx)
 	__ASSERT_NO_MSG(err == 0);
 
 	(void)err;
+#endif
 cleanup:
 	/* Use async put to avoid useless device suspension/resumption
 	 * when tranmiting chain of chars.
@@ -203,6 +331,11 @@ static void panic(struct log_backend const *const backend)
 #endif /* CONFIG_PM_DEVICE */
 
 	data->in_panic = true;
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC_DOUBLE_BUFFER
+	if (data->use_async) {
+		tx_panic_flush(uart_dev, data);
+	}
+#endif
 	log_backend_std_panic(ctx->output);
 }
 
@@ -225,13 +358,24 @@ const struct log_backend_api log_backend_uart_api = {
 	.format_set = format_set,
 };
 
+#ifdef CONFIG_LOG_BACKEND_UART_ASYNC_DOUBLE_BUFFER
+#define LBU_TX_DEFINE(...)                                                                         \
+	static uint8_t lbu_tx_buf##__VA_ARGS__[2][LBU_TX_BUF_SIZE];
+#define LBU_TX_INIT(...) .tx = {.buf = lbu_tx_buf##__VA_ARGS__},
+#else
+#define LBU_TX_DEFINE(...)
+#define LBU_TX_INIT(...)
+#endif
+
 #define LBU_DEFINE(node_id, ...)                                                                   \
 	static uint8_t lbu_buffer##__VA_ARGS__[CONFIG_LOG_BACKEND_UART_BUFFER_SIZE];               \
+	LBU_TX_DEFINE(__VA_ARGS__)                                                                 \
 	LOG_OUTPUT_DEFINE(lbu_output##__VA_ARGS__, char_out, lbu_buffer##__VA_ARGS__,              \
 			  CONFIG_LOG_BACKEND_UART_BUFFER_SIZE);                                    \
                                                                                                    \
 	static struct lbu_data lbu_data##__VA_ARGS__ = {                                           \
 		.log_format_current = CONFIG_LOG_BACKEND_UART_OUTPUT_DEFAULT,                      \
+		LBU_TX_INIT(__VA_ARGS__)                                                           \
 	};                                                                                         \
                                                                                                    \
 	static const struct lbu_cb_ctx lbu_cb_ctx##__VA_ARGS__ = {                                 \
@@ -53,6 +53,16 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_BUFFER_SIZE 4
 #endif
 
+/* With per CPU buffers, CONFIG_LOG_BUFFER_SIZE is split between the CPUs. */
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+#define LOG_BUFFER_CNT CONFIG_MP_MAX_NUM_CPUS
+#define LOG_BUFFER_WLEN \
+	(ROUND_DOWN(CONFIG_LOG_BUFFER_SIZE / LOG_BUFFER_CNT, Z_LOG_MSG_ALIGNMENT) / sizeof(int))
+#else
+#define LOG_BUFFER_CNT 1
+#define LOG_BUFFER_WLEN (CONFIG_LOG_BUFFER_SIZE / sizeof(int))
+#endif
+
 #ifdef CONFIG_LOG_PROCESS_THREAD_CUSTOM_PRIORITY
 #define LOG_PROCESS_THREAD_PRIORITY CONFIG_LOG_PROCESS_THREAD_PRIORITY
 #else
@@ -103,7 +113,7 @@ static atomic_t initialized;
 static bool panic_mode;
 static bool backend_attached;
 static atomic_t buffered_cnt;
-static atomic_t dropped_cnt;
+static atomic_t dropped_cnt[LOG_BUFFER_CNT];
 static k_tid_t proc_tid;
 static struct k_timer log_process_thread_timer;
 
@@ -121,7 +131,7 @@ static struct mpsc_pbuf_buffer *curr_log_buffer;
 
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[LOG_BUFFER_WLEN];
 
 static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			      const union mpsc_pbuf_generic *item);
@@ -136,6 +146,17 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 		 (IS_ENABLED(CONFIG_LOG_MEM_UTILIZATION) ?
 		  MPSC_PBUF_MAX_UTILIZATION : 0)
 };
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* CPU 0 uses log_buffer, and the other CPUs use these. Like link buffers,
+ * they are in the iterable sections so that the oldest message is claimed.
+ */
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_cpu_msg_ptr, LOG_BUFFER_CNT - 1);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer,
+					       log_cpu_buffer, LOG_BUFFER_CNT - 1);
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[LOG_BUFFER_CNT - 1][LOG_BUFFER_WLEN];
+#endif
 #endif
 
 /* Check that default tag can fit in tag buffer. */
@@ -251,7 +272,9 @@ static log_timestamp_t default_rt_get_timestamp(void)
 void log_core_init(void)
 {
 	panic_mode = false;
-	dropped_cnt = 0;
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		dropped_cnt[i] = 0;
+	}
 	buffered_cnt = 0;
 
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
@@ -602,9 +625,19 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 #include <syscalls/log_buffered_cnt_mrsh.c>
 #endif
 
+/* Index of the buffer and drop counter of the current CPU. */
+static inline uint32_t curr_buffer_idx(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return arch_curr_cpu()->id;
+#else
+	return 0;
+#endif
+}
+
 void z_log_dropped(bool buffered)
 {
-	atomic_inc(&dropped_cnt);
+	atomic_inc(&dropped_cnt[curr_buffer_idx()]);
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
 	}
@@ -612,20 +645,73 @@ void z_log_dropped(bool buffered)
 
 uint32_t z_log_dropped_read_and_clear(void)
 {
-	return atomic_set(&dropped_cnt, 0);
+	uint32_t dropped = 0;
+
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		dropped += atomic_set(&dropped_cnt[i], 0);
+	}
+
+	return dropped;
 }
 
 bool z_log_dropped_pending(void)
 {
-	return dropped_cnt > 0;
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		if (dropped_cnt[i] > 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#ifdef CONFIG_MPSC_PBUF
+static struct mpsc_pbuf_buffer *buffer_get(uint32_t idx)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (idx > 0) {
+		return &log_cpu_buffer[idx - 1];
+	}
+#endif
+
+	return &log_buffer;
 }
 
+/* A thread can move to another CPU after allocating, so a message is
+ * committed to the buffer that it is in.
+ */
+static struct mpsc_pbuf_buffer *msg_buffer_get(const struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < LOG_BUFFER_CNT - 1; i++) {
+		if (((const uint32_t *)msg >= cpu_buf32[i]) &&
+		    ((const uint32_t *)msg < &cpu_buf32[i][LOG_BUFFER_WLEN])) {
+			return &log_cpu_buffer[i];
+		}
+	}
+#endif
+
+	return &log_buffer;
+}
+#else
+#define buffer_get(idx) (&log_buffer)
+#define msg_buffer_get(msg) (&log_buffer)
+#endif
+
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < LOG_BUFFER_CNT - 1; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(&log_cpu_buffer[i], &config);
+	}
+#endif
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -643,7 +729,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(buffer_get(curr_buffer_idx()), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -665,7 +751,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer_get(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -752,7 +838,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -787,7 +874,8 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) ||
+	    (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -867,7 +955,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
-	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+	*buf_size = 0;
+	*usage = 0;
+
+	for (uint32_t i = 0; i < LOG_BUFFER_CNT; i++) {
+		uint32_t size, used;
+
+		mpsc_pbuf_get_utilization(buffer_get(i), &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
 
 	return 0;
 }
@@ -880,7 +977,21 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
-	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	/* With per CPU buffers, the sum of the peaks of each buffer. */
+	*max = 0;
+
+	for (uint32_t i = 0; i < LOG_BUFFER_CNT; i++) {
+		uint32_t used;
+		int err = mpsc_pbuf_get_max_utilization(buffer_get(i), &used);
+
+		if (err < 0) {
+			return err;
+		}
+
+		*max += used;
+	}
+
+	return 0;
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -338,6 +338,27 @@ static uint32_t *get_dynamic_filter(uint8_t domain_id, uint32_t source_id)
 	return z_log_link_get_dynamic_filter(domain_id, source_id);
 }
 
+/* Update the enable flags of the logging calls of a source, or of all the
+ * sources if NULL.
+ */
+static void call_sites_update(struct log_source_dynamic_data *source)
+{
+	if (!IS_ENABLED(CONFIG_LOG_CALL_SITES)) {
+		return;
+	}
+
+	STRUCT_SECTION_FOREACH(log_call_site, site) {
+		struct log_source_dynamic_data *site_source = *site->source;
+
+		if ((source != NULL) && (site_source != source)) {
+			continue;
+		}
+
+		site->enabled = (site_source != NULL) &&
+			(site->level <= LOG_FILTER_AGGR_SLOT_GET(&site_source->filters));
+	}
+}
+
 void z_log_runtime_filters_init(void)
 {
 	/*
@@ -358,6 +379,8 @@ void z_log_runtime_filters_init(void)
 				    LOG_FILTER_AGGR_SLOT_IDX,
 				    level);
 	}
+
+	call_sites_update(NULL);
 }
 
 int log_source_id_get(const char *name)
@@ -407,7 +430,13 @@ static void set_runtime_filter(uint8_t backend_id, uint8_t domain_id,
 
 	LOG_FILTER_SLOT_SET(filters, LOG_FILTER_AGGR_SLOT_IDX, new_max);
 
-	if (!z_log_is_local_domain(domain_id) && (new_max != prev_max)) {
+	if (new_max == prev_max) {
+		return;
+	}
+
+	if (z_log_is_local_domain(domain_id)) {
+		call_sites_update(&TYPE_SECTION_START(log_dynamic)[source_id]);
+	} else {
 		(void)z_log_link_set_runtime_level(domain_id, source_id, level);
 	}
 }
@@ -345,15 +345,39 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 				uint32_t package_flags, const char *fmt, va_list ap)
 {
 	int plen;
+	bool packaged = false;
+#if CONFIG_LOG_RUNTIME_PACKAGE_BUF_SIZE > 0
+	/* Laid out as a message so that the package is aligned the same way. */
+	union {
+		struct log_msg msg;
+		uint32_t buf[Z_LOG_MSG_ALIGNED_WLEN(CONFIG_LOG_RUNTIME_PACKAGE_BUF_SIZE, 0)];
+	} __aligned(Z_LOG_MSG_ALIGNMENT) tmp;
+	uint8_t *tmp_pkg = tmp.msg.data;
+#else
+	uint8_t *tmp_pkg = NULL;
+#endif
 
 	if (fmt) {
 		va_list ap2;
 
-		va_copy(ap2, ap);
-		plen = cbvprintf_package(NULL, Z_LOG_MSG_ALIGN_OFFSET,
-					 package_flags, fmt, ap2);
-		__ASSERT_NO_MSG(plen >= 0);
-		va_end(ap2);
+		/* Package into the stack buffer first, which parses the format
+		 * once when the package fits.
+		 */
+		if (tmp_pkg != NULL) {
+			va_copy(ap2, ap);
+			plen = cbvprintf_package(tmp_pkg, CONFIG_LOG_RUNTIME_PACKAGE_BUF_SIZE,
+						 package_flags, fmt, ap2);
+			va_end(ap2);
+			packaged = plen >= 0;
+		}
+
+		if (!packaged) {
+			va_copy(ap2, ap);
+			plen = cbvprintf_package(NULL, Z_LOG_MSG_ALIGN_OFFSET,
+						 package_flags, fmt, ap2);
+			__ASSERT_NO_MSG(plen >= 0);
+			va_end(ap2);
+		}
 	} else {
 		plen = 0;
 	}
@@ -376,7 +400,9 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 		pkg = msg->data;
 	}
 
-	if (pkg && fmt) {
+	if (pkg && packaged) {
+		memcpy(pkg, tmp_pkg, plen);
+	} else if (pkg && fmt) {
 		plen = cbvprintf_package(pkg, (size_t)plen, package_flags, fmt, ap);
 		__ASSERT_NO_MSG(plen >= 0);
 	}
@@ -15,41 +15,118 @@
 struct ma_heap {
 	struct sys_heap heap;
 	uint32_t attr;
+
+	/* Smallest request refused since the last free, 0 if none */
+	size_t fail_bytes;
 };
 
+struct ma_attr {
+	uint32_t attr;
+
+	/* Bitmask of the heaps with this attribute */
+	uint32_t heaps;
+};
+
+BUILD_ASSERT(MAX_MULTI_HEAPS <= 32);
+
 struct {
 	struct ma_heap ma_heaps[MAX_MULTI_HEAPS];
 	struct sys_multi_heap multi_heap;
 	int nheaps;
+	struct ma_attr ma_attrs[MAX_MULTI_HEAPS];
+	int nattrs;
 } mah_data;
 
+static struct ma_attr *mah_find_attr(uint32_t attr)
+{
+	for (size_t adx = 0; adx < mah_data.nattrs; adx++) {
+		if (mah_data.ma_attrs[adx].attr == attr) {
+			return &mah_data.ma_attrs[adx];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Pick the next heap to try among the candidates, dropping the ones that are
+ * known not to be able to satisfy the request.
+ */
+static struct ma_heap *mah_pick(uint32_t *candidates, size_t size)
+{
+	struct ma_heap *best = NULL;
+	size_t best_free = 0;
+	size_t best_hdx = 0;
+
+	for (size_t hdx = 0; hdx < mah_data.nheaps; hdx++) {
+		struct ma_heap *h = &mah_data.ma_heaps[hdx];
+		size_t free_bytes = SIZE_MAX;
+
+		if ((*candidates & BIT(hdx)) == 0) {
+			continue;
+		}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		struct sys_memory_stats stats;
+
+		sys_heap_runtime_stats_get(&h->heap, &stats);
+		free_bytes = stats.free_bytes;
+#endif
+
+		if (free_bytes < size || (h->fail_bytes != 0 && size >= h->fail_bytes)) {
+			*candidates &= ~BIT(hdx);
+			continue;
+		}
+
+		if (best == NULL || free_bytes > best_free) {
+			best = h;
+			best_free = free_bytes;
+			best_hdx = hdx;
+		}
+
+		if (!IS_ENABLED(CONFIG_MULTI_HEAP_PREFER_FREE)) {
+			break;
+		}
+	}
+
+	*candidates &= ~BIT(best_hdx);
+
+	return best;
+}
+
 static void *mah_choice(struct sys_multi_heap *m_heap, void *cfg, size_t align, size_t size)
 {
-	uint32_t attr;
+	struct ma_attr *ma;
+	struct ma_heap *h;
+	uint32_t candidates;
 	void *block;
 
 	if (size == 0) {
 		return NULL;
 	}
 
-	attr = (uint32_t)(long) cfg;
-
 	/* Set in case the user requested a non-existing attr */
 	block = NULL;
 
-	for (size_t hdx = 0; hdx < mah_data.nheaps; hdx++) {
-		struct ma_heap *h;
-
-		h = &mah_data.ma_heaps[hdx];
+	ma = mah_find_attr((uint32_t)(long) cfg);
+	if (ma == NULL) {
+		return NULL;
+	}
 
-		if (h->attr != attr) {
-			continue;
-		}
+	candidates = ma->heaps;
 
+	while ((h = mah_pick(&candidates, size)) != NULL) {
 		block = sys_heap_aligned_alloc(&h->heap, align, size);
 		if (block != NULL) {
 			break;
 		}
+
+		/* Larger requests fail as well until something is freed,
+		 * whatever their alignment.
+		 */
+		if (align <= sizeof(void *)) {
+			h->fail_bytes = size;
+		}
 	}
 
 	return block;
@@ -57,7 +134,16 @@ static void *mah_choice(struct sys_multi_heap *m_heap, void *cfg, size_t align,
 
 void mem_attr_heap_free(void *block)
 {
-	sys_multi_heap_free(&mah_data.multi_heap, block);
+	const struct sys_multi_heap_rec *heap_rec;
+	struct ma_heap *h;
+
+	heap_rec = sys_multi_heap_get_heap(&mah_data.multi_heap, block);
+
+	if (heap_rec != NULL) {
+		h = CONTAINER_OF(heap_rec->heap, struct ma_heap, heap);
+		h->fail_bytes = 0;
+		sys_heap_free(&h->heap, block);
+	}
 }
 
 void *mem_attr_heap_alloc(uint32_t attr, size_t bytes)
@@ -83,6 +169,7 @@ const struct mem_attr_region_t *mem_attr_heap_get_region(void *addr)
 
 static int ma_heap_add(const struct mem_attr_region_t *region, uint32_t attr)
 {
+	struct ma_attr *ma;
 	struct ma_heap *mh;
 	struct sys_heap *h;
 
@@ -91,6 +178,14 @@ static int ma_heap_add(const struct mem_attr_region_t *region, uint32_t attr)
 		return -ENOMEM;
 	}
 
+	ma = mah_find_attr(attr);
+	if (ma == NULL) {
+		ma = &mah_data.ma_attrs[mah_data.nattrs++];
+		ma->attr = attr;
+	}
+
+	ma->heaps |= BIT(mah_data.nheaps);
+
 	mh = &mah_data.ma_heaps[mah_data.nheaps++];
 	h = &mh->heap;
 
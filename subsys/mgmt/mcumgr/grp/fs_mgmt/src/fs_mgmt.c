@@ -27,6 +27,10 @@
 #include <mgmt/mcumgr/util/zcbor_bulk.h>
 #include <mgmt/mcumgr/grp/fs_mgmt/fs_mgmt_config.h>
 
+#if defined(CONFIG_MCUMGR_GRP_FS_FILE_UPLOAD_WINDOW)
+#include <mgmt/mcumgr/util/upload_window.h>
+#endif
+
 #if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_IEEE_CRC32)
 #include <mgmt/mcumgr/grp/fs_mgmt/fs_mgmt_hash_checksum_crc32.h>
 #endif
@@ -108,6 +112,11 @@ static struct {
 	struct k_work_delayable file_close_work;
 } fs_mgmt_ctxt;
 
+#if defined(CONFIG_MCUMGR_GRP_FS_FILE_UPLOAD_WINDOW)
+static uint8_t fs_mgmt_window_buf[CONFIG_MCUMGR_GRP_FS_FILE_UPLOAD_WINDOW_SIZE];
+static struct upload_window fs_mgmt_window = UPLOAD_WINDOW_INITIALIZER(fs_mgmt_window_buf);
+#endif
+
 static const struct mgmt_handler fs_mgmt_handlers[];
 
 #if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH)
@@ -129,6 +138,10 @@ static void fs_mgmt_cleanup(void)
 		fs_close(&fs_mgmt_ctxt.file);
 		fs_mgmt_ctxt.transport = NULL;
 	}
+
+#if defined(CONFIG_MCUMGR_GRP_FS_FILE_UPLOAD_WINDOW)
+	upload_window_reset(&fs_mgmt_window);
+#endif
 }
 
 static void file_close_work_handler(struct k_work *work)
@@ -347,6 +360,29 @@ end:
 /**
  * Command handler: fs file (write)
  */
+#if defined(CONFIG_MCUMGR_GRP_FS_FILE_UPLOAD_WINDOW)
+/**
+ * Writes the data kept in the window from the offset the upload has reached.
+ */
+static int fs_mgmt_file_write_window(void)
+{
+	const uint8_t *data;
+	size_t len;
+	ssize_t rc;
+
+	while ((len = upload_window_get(&fs_mgmt_window, fs_mgmt_ctxt.off, &data)) > 0) {
+		rc = fs_write(&fs_mgmt_ctxt.file, data, len);
+		if (rc < 0) {
+			return rc;
+		}
+
+		fs_mgmt_ctxt.off += len;
+	}
+
+	return 0;
+}
+#endif
+
 static int fs_mgmt_file_upload(struct smp_streamer *ctxt)
 {
 	char file_name[CONFIG_MCUMGR_GRP_FS_PATH_LEN + 1];
@@ -450,6 +486,9 @@ static int fs_mgmt_file_upload(struct smp_streamer *ctxt)
 		 * still be closed automatically after a timeout.
 		 */
 		fs_mgmt_ctxt.len = len;
+#if defined(CONFIG_MCUMGR_GRP_FS_FILE_UPLOAD_WINDOW)
+		upload_window_reset(&fs_mgmt_window);
+#endif
 		rc = fs_mgmt_filelen(file_name, &existing_file_size);
 
 		if (rc != 0) {
@@ -469,6 +508,21 @@ static int fs_mgmt_file_upload(struct smp_streamer *ctxt)
 
 	/* Verify that the data offset matches the expected offset (i.e. current size of file) */
 	if (off > 0 && off != fs_mgmt_ctxt.off) {
+#if defined(CONFIG_MCUMGR_GRP_FS_FILE_UPLOAD_WINDOW)
+		/* Data already written is sent again by clients that retry requests in
+		 * flight, data ahead of the offset is kept until the data before it
+		 * arrives: answer both with the offset reached.
+		 */
+		if (off < fs_mgmt_ctxt.off ||
+		    ((fs_mgmt_ctxt.len == 0 || off + file_data.len <= fs_mgmt_ctxt.len) &&
+		     upload_window_put(&fs_mgmt_window, fs_mgmt_ctxt.off, off, file_data.value,
+				       file_data.len))) {
+			ok = fs_mgmt_file_rsp(zse, MGMT_ERR_EOK, fs_mgmt_ctxt.off);
+			fs_mgmt_upload_download_finish_check();
+			goto end;
+		}
+#endif
+
 		/* Offset mismatch, send file length, client needs to handle this */
 		ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_FS, FS_MGMT_ERR_FILE_OFFSET_NOT_VALID);
 		ok = zcbor_tstr_put_lit(zse, "len")		&&
@@ -549,6 +603,15 @@ static int fs_mgmt_file_upload(struct smp_streamer *ctxt)
 		}
 
 		fs_mgmt_ctxt.off += file_data.len;
+
+#if defined(CONFIG_MCUMGR_GRP_FS_FILE_UPLOAD_WINDOW)
+		if (fs_mgmt_file_write_window() < 0) {
+			ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_FS,
+					     FS_MGMT_ERR_FILE_WRITE_FAILED);
+			fs_mgmt_cleanup();
+			goto end;
+		}
+#endif
 	}
 
 	/* Send the response. */
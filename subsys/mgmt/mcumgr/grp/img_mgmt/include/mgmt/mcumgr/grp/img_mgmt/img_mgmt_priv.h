@@ -75,6 +75,18 @@ int img_mgmt_read(int slot, unsigned int offset, void *dst, unsigned int num_byt
 int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned int num_bytes,
 			      bool last);
 
+/**
+ * @brief Verifies the image just uploaded to slot 1 against the SHA256 hash
+ * given by the client.
+ *
+ * With CONFIG_IMG_STREAM_HASH, the hash of the data computed while it was
+ * written is used; otherwise the image is read back from flash.
+ *
+ * @return 0 on match, -EILSEQ on mismatch, negative errno code if the image
+ * could not be checked.
+ */
+int img_mgmt_check_image_data(void);
+
 /**
  * @brief Indicates the type of swap operation that will occur on the next
  * reboot, if any, between provided slot and it's pair.
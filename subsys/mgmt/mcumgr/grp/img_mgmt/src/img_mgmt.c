@@ -23,6 +23,9 @@
 #include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
 
 #include <mgmt/mcumgr/util/zcbor_bulk.h>
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+#include <mgmt/mcumgr/util/upload_window.h>
+#endif
 #include <mgmt/mcumgr/grp/img_mgmt/img_mgmt_priv.h>
 
 #ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
@@ -77,6 +80,11 @@ LOG_MODULE_REGISTER(mcumgr_img_grp, CONFIG_MCUMGR_GRP_IMG_LOG_LEVEL);
 
 struct img_mgmt_state g_img_mgmt_state;
 
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+static uint8_t img_mgmt_window_buf[CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_SIZE];
+static struct upload_window img_mgmt_window = UPLOAD_WINDOW_INITIALIZER(img_mgmt_window_buf);
+#endif
+
 #ifdef CONFIG_MCUMGR_GRP_IMG_MUTEX
 static K_MUTEX_DEFINE(img_mgmt_mutex);
 #endif
@@ -314,9 +322,36 @@ static void img_mgmt_reset_upload(void)
 	img_mgmt_take_lock();
 	memset(&g_img_mgmt_state, 0, sizeof(g_img_mgmt_state));
 	g_img_mgmt_state.area_id = -1;
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+	upload_window_reset(&img_mgmt_window);
+#endif
 	img_mgmt_release_lock();
 }
 
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+/**
+ * Writes the data kept in the window from the offset the upload has reached.
+ */
+static int img_mgmt_write_window(void)
+{
+	const uint8_t *data;
+	size_t len;
+	int rc;
+
+	while ((len = upload_window_get(&img_mgmt_window, g_img_mgmt_state.off, &data)) > 0) {
+		rc = img_mgmt_write_image_data(g_img_mgmt_state.off, data, len,
+					       g_img_mgmt_state.off + len == g_img_mgmt_state.size);
+		if (rc != 0) {
+			return rc;
+		}
+
+		g_img_mgmt_state.off += len;
+	}
+
+	return 0;
+}
+#endif
+
 /**
  * Command handler: image erase
  */
@@ -461,6 +496,10 @@ img_mgmt_upload(struct smp_streamer *ctxt)
 	bool data_match = false;
 #endif
 
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+	bool ahead = false;
+#endif
+
 #if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_CHECK_HOOK)
 	enum mgmt_cb_return status;
 #endif
@@ -520,6 +559,18 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 		goto end;
 	}
 
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+	/* Data ahead of the offset is checked like the data written at once, and kept
+	 * to be written once the data before it arrives.
+	 */
+	if (!action.proceed && g_img_mgmt_state.area_id != -1 && req.off > g_img_mgmt_state.off &&
+	    req.img_data.len != 0 && req.off + req.img_data.len <= g_img_mgmt_state.size) {
+		ahead = true;
+		action.proceed = true;
+		action.write_bytes = req.img_data.len;
+	}
+#endif
+
 	if (!action.proceed) {
 		/* Request specifies incorrect offset.  Respond with a success code and
 		 * the correct offset.
@@ -551,6 +602,17 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 	}
 #endif
 
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+	if (ahead) {
+		(void)upload_window_put(&img_mgmt_window, g_img_mgmt_state.off, req.off,
+					req.img_data.value, req.img_data.len);
+#if defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
+		cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_ONGOING;
+#endif
+		goto end;
+	}
+#endif
+
 	/* Remember flash area ID and image size for subsequent upload requests. */
 	g_img_mgmt_state.area_id = action.area_id;
 	g_img_mgmt_state.size = action.size;
@@ -565,6 +627,9 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #endif
 
 		g_img_mgmt_state.off = 0;
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+		upload_window_reset(&img_mgmt_window);
+#endif
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
 		(void)mgmt_callback_notify(MGMT_EVT_OP_IMG_MGMT_DFU_STARTED, NULL, 0, &err_rc,
@@ -642,7 +707,14 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 						    last);
 		if (rc == 0) {
 			g_img_mgmt_state.off += action.write_bytes;
-		} else {
+
+#ifdef CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW
+			rc = img_mgmt_write_window();
+			last = (g_img_mgmt_state.off == g_img_mgmt_state.size);
+#endif
+		}
+
+		if (rc != 0) {
 			/* Write failed, currently not able to recover from this */
 #if defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 			cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_COMPLETE;
@@ -665,19 +737,12 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 			reset = true;
 
 #ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
-			static struct flash_img_context ctx;
-
-			if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) == 0) {
-				struct flash_img_check fic = {
-					.match = g_img_mgmt_state.data_sha,
-					.clen = g_img_mgmt_state.size,
-				};
-
-				if (flash_img_check(&ctx, &fic, g_img_mgmt_state.area_id) == 0) {
-					data_match = true;
-				} else {
-					LOG_ERR("Uploaded image sha256 hash verification failed");
-				}
+			int check_rc = img_mgmt_check_image_data();
+
+			if (check_rc == 0) {
+				data_match = true;
+			} else if (check_rc == -EILSEQ) {
+				LOG_ERR("Uploaded image sha256 hash verification failed");
 			} else {
 				LOG_ERR("Uploaded image sha256 could not be checked");
 			}
@@ -372,6 +372,21 @@ int img_mgmt_read(int slot, unsigned int offset, void *dst, unsigned int num_byt
 	return 0;
 }
 
+#if defined(CONFIG_IMG_STREAM_HASH)
+/* Result of checking the uploaded data, as it was written */
+static int img_mgmt_written_rc = -ENODATA;
+
+static void img_mgmt_check_written(struct flash_img_context *ctx)
+{
+	struct flash_img_check fic = {
+		.match = g_img_mgmt_state.data_sha,
+		.clen = g_img_mgmt_state.size,
+	};
+
+	img_mgmt_written_rc = flash_img_check_written(ctx, &fic);
+}
+#endif
+
 #if defined(CONFIG_MCUMGR_GRP_IMG_USE_HEAP_FOR_FLASH_IMG_CONTEXT)
 int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned int num_bytes,
 			      bool last)
@@ -395,6 +410,10 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 		if (ctx != NULL) {
 			return IMG_MGMT_ERR_FLASH_CONTEXT_ALREADY_SET;
 		}
+
+#if defined(CONFIG_IMG_STREAM_HASH)
+		img_mgmt_written_rc = -ENODATA;
+#endif
 		ctx = k_malloc(sizeof(struct flash_img_context));
 
 		if (ctx == NULL) {
@@ -412,6 +431,12 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 		goto out;
 	}
 
+#if defined(CONFIG_IMG_STREAM_HASH)
+	if (last) {
+		img_mgmt_check_written(ctx);
+	}
+#endif
+
 out:
 	if (last || rc != MGMT_ERR_EOK) {
 		k_free(ctx);
@@ -427,6 +452,10 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 	static struct flash_img_context ctx;
 
 	if (offset == 0) {
+#if defined(CONFIG_IMG_STREAM_HASH)
+		img_mgmt_written_rc = -ENODATA;
+#endif
+
 		if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) != 0) {
 			return IMG_MGMT_ERR_FLASH_OPEN_FAILED;
 		}
@@ -436,10 +465,36 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 		return IMG_MGMT_ERR_FLASH_WRITE_FAILED;
 	}
 
+#if defined(CONFIG_IMG_STREAM_HASH)
+	if (last) {
+		img_mgmt_check_written(&ctx);
+	}
+#endif
+
 	return IMG_MGMT_ERR_OK;
 }
 #endif
 
+#if defined(CONFIG_IMG_ENABLE_IMAGE_CHECK)
+int img_mgmt_check_image_data(void)
+{
+	static struct flash_img_context ctx;
+	struct flash_img_check fic = {
+		.match = g_img_mgmt_state.data_sha,
+		.clen = g_img_mgmt_state.size,
+	};
+
+#if defined(CONFIG_IMG_STREAM_HASH)
+	/* Fall back to reading the image if its hash was not computed */
+	if (img_mgmt_written_rc != -ENODATA) {
+		return img_mgmt_written_rc;
+	}
+#endif
+
+	return flash_img_check(&ctx, &fic, g_img_mgmt_state.area_id);
+}
+#endif
+
 int img_mgmt_erase_image_data(unsigned int off, unsigned int num_bytes)
 {
 	const struct flash_area *fa;
@@ -41,6 +41,26 @@ static struct mcumgr_image_upload *image_upload_buf;
 static K_SEM_DEFINE(mcumgr_img_client_grp_sem, 0, 1);
 static K_MUTEX_DEFINE(mcumgr_img_client_grp_mutex);
 
+BUILD_ASSERT(CONFIG_SMP_CLIENT_CMD_MAX >= CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW,
+	     "The SMP client can not keep the upload window in flight");
+
+/* Upload request in flight */
+struct image_upload_req {
+	/* Offset past the data of the request */
+	size_t end;
+	bool busy;
+};
+
+static struct image_upload_req image_upload_reqs[CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW];
+/* Given once for each response to an upload request */
+static K_SEM_DEFINE(mcumgr_img_client_upload_sem, 0, CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW);
+/* Whether a response reported an offset short of the data of its request */
+static bool image_upload_short;
+/* Offset of the data of the upload request handler */
+static size_t image_upload_start;
+/* Lowest offset reported before image_upload_start, SIZE_MAX if none */
+static size_t image_upload_rewind;
+
 static const char smp_images_str[] = "images";
 #define IMAGES_STR_LEN (sizeof(smp_images_str) - 1)
 
@@ -187,34 +207,51 @@ out:
 static int image_upload_res_fn(struct net_buf *nb, void *user_data)
 {
 	zcbor_state_t zsd[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
+	struct image_upload_req *req = user_data;
 	size_t decoded;
+	size_t offset = SIZE_MAX;
 	int rc;
 	int32_t res_rc = MGMT_ERR_EOK;
 
 	struct zcbor_map_decode_key_val upload_res_decode[] = {
-		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_size_decode,
-					     &image_upload_buf->image_upload_offset),
+		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_size_decode, &offset),
 		ZCBOR_MAP_DECODE_KEY_DECODER("rc", zcbor_int32_decode, &res_rc)};
 
 	if (!nb) {
-		image_upload_buf->status = MGMT_ERR_ETIMEOUT;
+		rc = MGMT_ERR_ETIMEOUT;
 		goto end;
 	}
 
 	zcbor_new_decode_state(zsd, ARRAY_SIZE(zsd), nb->data, nb->len, 1, NULL, 0);
 
 	rc = zcbor_map_decode_bulk(zsd, upload_res_decode, ARRAY_SIZE(upload_res_decode), &decoded);
-	if (rc || image_upload_buf->image_upload_offset == SIZE_MAX) {
-		image_upload_buf->status = MGMT_ERR_EINVAL;
+	if (rc || offset == SIZE_MAX) {
+		rc = MGMT_ERR_EINVAL;
 		goto end;
 	}
-	image_upload_buf->status = res_rc;
+	rc = res_rc;
 
-	active_client->upload.offset = image_upload_buf->image_upload_offset;
+	/* The server went back before the data it was given, e.g. it restarted the
+	 * upload: the data from there has to be given again.
+	 */
+	if (offset < image_upload_start) {
+		image_upload_rewind = MIN(image_upload_rewind, offset);
+	}
+
+	/* Responses can come in any order, the server has reached the highest offset */
+	if (offset > active_client->upload.offset) {
+		active_client->upload.offset = offset;
+	}
+	if (offset < req->end) {
+		image_upload_short = true;
+	}
 end:
-	/* Set status for Upload request handler */
-	rc = image_upload_buf->status;
-	k_sem_give(user_data);
+	/* Keep the first error for the upload request handler */
+	if (image_upload_buf->status == MGMT_ERR_EOK) {
+		image_upload_buf->status = rc;
+	}
+	req->busy = false;
+	k_sem_give(&mcumgr_img_client_upload_sem);
 	return rc;
 }
 
@@ -328,23 +365,101 @@ int img_mgmt_client_upload_init(struct img_mgmt_client *client, size_t image_siz
 	return rc;
 }
 
-int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data, size_t length,
-			   struct mcumgr_image_upload *res_buf)
+static struct image_upload_req *image_upload_req_get(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(image_upload_reqs); i++) {
+		if (!image_upload_reqs[i].busy) {
+			image_upload_reqs[i].busy = true;
+			return &image_upload_reqs[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int image_upload_send(size_t offset, const uint8_t *data, size_t length)
 {
 	struct net_buf *nb;
-	const uint8_t *write_ptr;
+	struct image_upload_req *req;
 	int rc;
 	uint32_t map_count;
 	bool ok;
-	size_t write_length, max_data_length, offset_before_send, request_length, wrote_length;
 	zcbor_state_t zse[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
 
+	nb = smp_client_buf_allocation(active_client->smp_client, MGMT_GROUP_ID_IMAGE,
+				       IMG_MGMT_ID_UPLOAD, MGMT_OP_WRITE,
+				       SMP_MCUMGR_VERSION_1);
+	if (!nb) {
+		return MGMT_ERR_ENOMEM;
+	}
+
+	zcbor_new_encode_state(zse, ARRAY_SIZE(zse), nb->data + nb->len,
+			       net_buf_tailroom(nb), 0);
+	if (offset) {
+		map_count = 6;
+	} else if (active_client->upload.hash_initialized) {
+		map_count = 12;
+	} else {
+		map_count = 10;
+	}
+
+	/* Init map start and write image info, data and offset */
+	ok = zcbor_map_start_encode(zse, map_count) && zcbor_tstr_put_lit(zse, "image") &&
+	     zcbor_uint32_put(zse, active_client->upload.image_num) &&
+	     zcbor_tstr_put_lit(zse, "data") &&
+	     zcbor_bstr_encode_ptr(zse, data, length) &&
+	     zcbor_tstr_put_lit(zse, "off") &&
+	     zcbor_size_put(zse, offset);
+	/* Write Len and configured hash when offset is zero */
+	if (ok && !offset) {
+		ok = zcbor_tstr_put_lit(zse, "len") &&
+		     zcbor_size_put(zse, active_client->upload.image_size);
+		if (ok && active_client->upload.hash_initialized) {
+			ok = zcbor_tstr_put_lit(zse, "sha") &&
+			     zcbor_bstr_encode_ptr(zse, active_client->upload.sha256,
+						   IMG_MGMT_DATA_SHA_LEN);
+		}
+	}
+
+	if (ok) {
+		ok = zcbor_map_end_encode(zse, map_count);
+	}
+
+	if (!ok) {
+		LOG_ERR("Failed to encode Image Upload packet");
+		smp_packet_free(nb);
+		return MGMT_ERR_ENOMEM;
+	}
+
+	nb->len = zse->payload - nb->data;
+
+	/* There is a free one, as long as the window is not full */
+	req = image_upload_req_get();
+	req->end = offset + length;
+
+	rc = smp_client_send_cmd(active_client->smp_client, nb, image_upload_res_fn, req,
+				 CONFIG_MCUMGR_GRP_IMG_FLASH_OPERATION_TIMEOUT);
+	if (rc) {
+		LOG_ERR("Failed to send SMP Upload init packet, err: %d", rc);
+		smp_packet_free(nb);
+		req->busy = false;
+	}
+
+	return rc;
+}
+
+int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data, size_t length,
+			   struct mcumgr_image_upload *res_buf)
+{
+	int rc;
+	size_t write_length, max_data_length, start, end, next;
+	int in_flight = 0;
+	int window;
+
 	k_mutex_lock(&mcumgr_img_client_grp_mutex, K_FOREVER);
 	active_client = client;
 	image_upload_buf = res_buf;
 
-	request_length = length;
-	wrote_length = 0;
 	/* Calculate max data length based on
 	 * net_buf size - (SMP header + CBOR message_len + 16-bit CRC + 16-bit length)
 	 */
@@ -356,91 +471,68 @@ int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data,
 			(max_data_length % CONFIG_MCUMGR_GRP_IMG_UPLOAD_DATA_ALIGNMENT_SIZE);
 	}
 
-	while (request_length != wrote_length) {
-		write_ptr = data + wrote_length;
-		write_length = request_length - wrote_length;
-		if (write_length > max_data_length) {
-			write_length = max_data_length;
-		}
+	/* The data is the part of the image from the offset the upload has reached */
+	start = active_client->upload.offset;
+	end = start + length;
+	next = start;
 
-		nb = smp_client_buf_allocation(active_client->smp_client, MGMT_GROUP_ID_IMAGE,
-					       IMG_MGMT_ID_UPLOAD, MGMT_OP_WRITE,
-					       SMP_MCUMGR_VERSION_1);
-		if (!nb) {
-			image_upload_buf->status = MGMT_ERR_ENOMEM;
-			goto end;
-		}
+	image_upload_buf->status = MGMT_ERR_EOK;
+	image_upload_short = false;
+	image_upload_start = start;
+	image_upload_rewind = SIZE_MAX;
+	k_sem_reset(&mcumgr_img_client_upload_sem);
 
-		zcbor_new_encode_state(zse, ARRAY_SIZE(zse), nb->data + nb->len,
-				       net_buf_tailroom(nb), 0);
-		if (active_client->upload.offset) {
-			map_count = 6;
-		} else if (active_client->upload.hash_initialized) {
-			map_count = 12;
-		} else {
-			map_count = 10;
-		}
+	/* A new upload is started by a single request, the server may refuse it */
+	window = start ? CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW : 1;
+
+	while (true) {
+		if (next < end && in_flight < window && !image_upload_short &&
+		    image_upload_rewind == SIZE_MAX && image_upload_buf->status == MGMT_ERR_EOK) {
+			write_length = MIN(end - next, max_data_length);
 
-		/* Init map start and write image info, data and offset */
-		ok = zcbor_map_start_encode(zse, map_count) && zcbor_tstr_put_lit(zse, "image") &&
-		     zcbor_uint32_put(zse, active_client->upload.image_num) &&
-		     zcbor_tstr_put_lit(zse, "data") &&
-		     zcbor_bstr_encode_ptr(zse, write_ptr, write_length) &&
-		     zcbor_tstr_put_lit(zse, "off") &&
-		     zcbor_size_put(zse, active_client->upload.offset);
-		/* Write Len and configured hash when offset is zero */
-		if (ok && !active_client->upload.offset) {
-			ok = zcbor_tstr_put_lit(zse, "len") &&
-			     zcbor_size_put(zse, active_client->upload.image_size);
-			if (ok && active_client->upload.hash_initialized) {
-				ok = zcbor_tstr_put_lit(zse, "sha") &&
-				     zcbor_bstr_encode_ptr(zse, active_client->upload.sha256,
-							   IMG_MGMT_DATA_SHA_LEN);
+			rc = image_upload_send(next, data + (next - start), write_length);
+			if (rc) {
+				/* Let the requests in flight complete */
+				image_upload_buf->status = rc;
+				continue;
 			}
-		}
 
-		if (ok) {
-			ok = zcbor_map_end_encode(zse, map_count);
+			next += write_length;
+			in_flight++;
+			continue;
 		}
 
-		if (!ok) {
-			LOG_ERR("Failed to encode Image Upload packet");
-			smp_packet_free(nb);
-			image_upload_buf->status = MGMT_ERR_ENOMEM;
-			goto end;
+		if (in_flight > 0) {
+			k_sem_take(&mcumgr_img_client_upload_sem, K_FOREVER);
+			in_flight--;
+			continue;
 		}
 
-		offset_before_send = active_client->upload.offset;
-		nb->len = zse->payload - nb->data;
-		k_sem_reset(&mcumgr_img_client_grp_sem);
-
-		image_upload_buf->status = MGMT_ERR_EINVAL;
-		image_upload_buf->image_upload_offset = SIZE_MAX;
-
-		rc = smp_client_send_cmd(active_client->smp_client, nb, image_upload_res_fn,
-					 &mcumgr_img_client_grp_sem,
-					 CONFIG_MCUMGR_GRP_IMG_FLASH_OPERATION_TIMEOUT);
-		if (rc) {
-			LOG_ERR("Failed to send SMP Upload init packet, err: %d", rc);
-			smp_packet_free(nb);
-			image_upload_buf->status = rc;
-			goto end;
-
-		}
-		k_sem_take(&mcumgr_img_client_grp_sem, K_FOREVER);
 		if (image_upload_buf->status) {
 			LOG_ERR("Upload Fail: %d", image_upload_buf->status);
-			goto end;
+			break;
 		}
 
-		if (offset_before_send + write_length < active_client->upload.offset) {
-			/* Offset further than expected which indicate upload session resume */
-			goto end;
+		if (image_upload_rewind != SIZE_MAX) {
+			LOG_WRN("Upload rewound to %zu", image_upload_rewind);
+			active_client->upload.offset = image_upload_rewind;
+			break;
 		}
 
-		wrote_length += write_length;
+		/* With all the responses in, go on from the offset the server has reached:
+		 * behind what was sent when requests were lost, ahead when it resumes an
+		 * earlier upload.
+		 */
+		if (active_client->upload.offset < start || active_client->upload.offset >= end) {
+			break;
+		}
+
+		next = active_client->upload.offset;
+		image_upload_short = false;
+		window = CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW;
 	}
-end:
+
+	image_upload_buf->image_upload_offset = active_client->upload.offset;
 	rc = image_upload_buf->status;
 	active_client = NULL;
 	image_upload_buf = NULL;
@@ -0,0 +1,87 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef H_UPLOAD_WINDOW_PRIV_
+#define H_UPLOAD_WINDOW_PRIV_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+/** Number of separate ranges of data a window keeps */
+#define UPLOAD_WINDOW_RANGES 4
+
+struct upload_window_range {
+	size_t off;
+	size_t len;
+};
+
+/**
+ * Data of an upload received ahead of the offset the upload has reached,
+ * kept until the data before it arrives. The byte at offset off of the
+ * upload is kept at buf[off % size], so offsets from the current one up to
+ * size bytes ahead of it can be kept.
+ */
+struct upload_window {
+	uint8_t *buf;
+	size_t size;
+	struct upload_window_range ranges[UPLOAD_WINDOW_RANGES];
+};
+
+/** @brief Static initializer of a window that keeps its data in array _buf */
+#define UPLOAD_WINDOW_INITIALIZER(_buf)		\
+	{					\
+		.buf = (_buf),			\
+		.size = sizeof(_buf),		\
+	}
+
+/**
+ * @brief Drop all the data kept by a window.
+ *
+ * @param win	window
+ */
+void upload_window_reset(struct upload_window *win);
+
+/**
+ * @brief Keep data received ahead of the offset reached by the upload.
+ *
+ * @param win	window
+ * @param base	offset the upload has reached
+ * @param off	offset of the data, past base
+ * @param data	data
+ * @param len	length of the data
+ *
+ * @return true if the data is kept, false if it does not fit in the window.
+ */
+bool upload_window_put(struct upload_window *win, size_t base, size_t off,
+		       const uint8_t *data, size_t len);
+
+/**
+ * @brief Get the data kept from the offset the upload has reached.
+ *
+ * The data is returned in at most two parts, when it wraps around the end
+ * of the buffer of the window: call again after writing the first.
+ *
+ * @param win	window
+ * @param base	offset the upload has reached
+ * @param data	set to the data at base
+ *
+ * @return length of the data at base, 0 if none was kept.
+ */
+size_t upload_window_get(struct upload_window *win, size_t base, const uint8_t **data);
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_UPLOAD_WINDOW_PRIV_ */
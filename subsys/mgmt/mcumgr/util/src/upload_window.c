@@ -0,0 +1,107 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include <mgmt/mcumgr/util/upload_window.h>
+
+void upload_window_reset(struct upload_window *win)
+{
+	memset(win->ranges, 0, sizeof(win->ranges));
+}
+
+/* Drop the ranges the upload has gone past */
+static void upload_window_drop(struct upload_window *win, size_t base)
+{
+	for (int i = 0; i < ARRAY_SIZE(win->ranges); i++) {
+		struct upload_window_range *range = &win->ranges[i];
+
+		if (range->len == 0) {
+			continue;
+		}
+
+		if (range->off + range->len <= base) {
+			range->len = 0;
+		} else if (range->off < base) {
+			range->len -= base - range->off;
+			range->off = base;
+		}
+	}
+}
+
+bool upload_window_put(struct upload_window *win, size_t base, size_t off,
+		       const uint8_t *data, size_t len)
+{
+	size_t start = off;
+	size_t end = off + len;
+	size_t done;
+	int slot = -1;
+	bool merged;
+
+	if (len == 0 || off <= base || end - base > win->size) {
+		return false;
+	}
+
+	upload_window_drop(win, base);
+
+	/* Merge the ranges that overlap or touch the new one into it */
+	do {
+		merged = false;
+
+		for (int i = 0; i < ARRAY_SIZE(win->ranges); i++) {
+			struct upload_window_range *range = &win->ranges[i];
+
+			if (range->len == 0) {
+				slot = (slot < 0) ? i : slot;
+				continue;
+			}
+
+			if (range->off <= end && off <= range->off + range->len) {
+				end = MAX(end, range->off + range->len);
+				off = MIN(off, range->off);
+				range->len = 0;
+				slot = (slot < 0) ? i : slot;
+				merged = true;
+			}
+		}
+	} while (merged);
+
+	if (slot < 0) {
+		return false;
+	}
+
+	for (done = 0; done < len; ) {
+		size_t pos = (start + done) % win->size;
+		size_t part = MIN(len - done, win->size - pos);
+
+		memcpy(&win->buf[pos], &data[done], part);
+		done += part;
+	}
+
+	win->ranges[slot].off = off;
+	win->ranges[slot].len = end - off;
+
+	return true;
+}
+
+size_t upload_window_get(struct upload_window *win, size_t base, const uint8_t **data)
+{
+	size_t pos = base % win->size;
+
+	upload_window_drop(win, base);
+
+	for (int i = 0; i < ARRAY_SIZE(win->ranges); i++) {
+		struct upload_window_range *range = &win->ranges[i];
+
+		if (range->len != 0 && range->off == base) {
+			*data = &win->buf[pos];
+			return MIN(range->len, win->size - pos);
+		}
+	}
+
+	return 0;
+}
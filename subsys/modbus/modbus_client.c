@@ -640,3 +640,292 @@ int modbus_write_holding_regs_fp(const int iface,
 	return err;
 }
 #endif
+
+#ifdef CONFIG_MODBUS_CLIENT_BATCH
+/* Largest quantity of registers a FC03 or FC04 response can carry */
+#define MBC_BATCH_MAX_REGS \
+	MIN(125, (sizeof(((struct modbus_adu *)NULL)->data) - 1) / sizeof(uint16_t))
+
+static uint8_t mbc_batch_fc(const struct modbus_reg_read *req)
+{
+	return req->input ? MODBUS_FC04_IN_REG_RD : MODBUS_FC03_HOLDING_REG_RD;
+}
+
+static bool mbc_batch_req_valid(const struct modbus_reg_read *req)
+{
+	uint32_t end = (uint32_t)req->start_addr + req->num_regs;
+
+	if (req->reg_buf == NULL || req->num_regs == 0 ||
+	    req->num_regs > MBC_BATCH_MAX_REGS) {
+		return false;
+	}
+
+	/* Reads of floating-point registers are not merged */
+	if (IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS) && !req->input &&
+	    end > MODBUS_FP_EXTENSIONS_ADDR) {
+		return false;
+	}
+
+	return end <= UINT16_MAX + 1U;
+}
+
+/* Index of the next read to send, the others already have their result */
+static size_t mbc_batch_next(const struct modbus_reg_read *reqs,
+			     size_t num_reqs, size_t idx)
+{
+	while (idx < num_reqs && reqs[idx].err != -EINPROGRESS) {
+		idx++;
+	}
+
+	return idx;
+}
+
+/* Cover reqs[0] and the reads that follow it and can share its request */
+static void mbc_batch_merge(struct modbus_batch_txn *txn,
+			    struct modbus_reg_read *reqs, size_t num_reqs)
+{
+	uint32_t end = (uint32_t)reqs[0].start_addr + reqs[0].num_regs;
+	uint16_t num_regs = reqs[0].num_regs;
+	size_t n = 1;
+
+	while (n < num_reqs && reqs[n].err == -EINPROGRESS &&
+	       reqs[n].unit_id == reqs[0].unit_id &&
+	       reqs[n].input == reqs[0].input &&
+	       reqs[n].start_addr == end &&
+	       num_regs + reqs[n].num_regs <= MBC_BATCH_MAX_REGS) {
+		num_regs += reqs[n].num_regs;
+		end += reqs[n].num_regs;
+		n++;
+	}
+
+	txn->req = reqs;
+	txn->num_reqs = n;
+}
+
+static void mbc_batch_tx_setup(struct modbus_context *ctx,
+			       const struct modbus_batch_txn *txn)
+{
+	uint16_t num_regs = 0;
+
+	for (size_t i = 0; i < txn->num_reqs; i++) {
+		num_regs += txn->req[i].num_regs;
+	}
+
+	ctx->tx_adu.trans_id = txn->trans_id;
+	ctx->tx_adu.proto_id = MODBUS_ADU_PROTO_ID;
+	ctx->tx_adu.unit_id = txn->req->unit_id;
+	ctx->tx_adu.fc = mbc_batch_fc(txn->req);
+	ctx->tx_adu.length = 4;
+	sys_put_be16(txn->req->start_addr, &ctx->tx_adu.data[0]);
+	sys_put_be16(num_regs, &ctx->tx_adu.data[2]);
+}
+
+/* Spread the registers of the response over the reads of the request */
+static int mbc_batch_rd_response(const struct modbus_adu *adu,
+				 const struct modbus_batch_txn *txn)
+{
+	const struct modbus_reg_read *req = txn->req;
+	const uint8_t *resp_data = &adu->data[1];
+	const uint8_t excep_bit = BIT(7);
+	const uint8_t excep_mask = BIT_MASK(7);
+	size_t req_byte_cnt = 0;
+
+	if (adu->unit_id != req->unit_id ||
+	    (adu->fc & excep_mask) != mbc_batch_fc(req)) {
+		return -EIO;
+	}
+
+	if (adu->fc & excep_bit) {
+		if (adu->data[0] > MODBUS_EXC_NONE) {
+			return adu->data[0];
+		}
+
+		return -EIO;
+	}
+
+	for (size_t i = 0; i < txn->num_reqs; i++) {
+		req_byte_cnt += req[i].num_regs * sizeof(uint16_t);
+	}
+
+	if (adu->data[0] != req_byte_cnt || adu->length < req_byte_cnt + 1) {
+		LOG_ERR("Mismatch in the number of registers");
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < txn->num_reqs; i++) {
+		for (uint16_t j = 0; j < req[i].num_regs; j++) {
+			req[i].reg_buf[j] = sys_get_be16(resp_data);
+			resp_data += sizeof(uint16_t);
+		}
+	}
+
+	return 0;
+}
+
+static void mbc_batch_complete(const struct modbus_batch_txn *txn, int err)
+{
+	for (size_t i = 0; i < txn->num_reqs; i++) {
+		txn->req[i].err = err;
+	}
+}
+
+static void mbc_batch_sequential(struct modbus_context *ctx,
+				 struct modbus_reg_read *reqs, size_t num_reqs)
+{
+	struct modbus_batch_txn txn = {0};
+	size_t next = mbc_batch_next(reqs, num_reqs, 0);
+	int err;
+
+	while (next < num_reqs) {
+		mbc_batch_merge(&txn, &reqs[next], num_reqs - next);
+		mbc_batch_tx_setup(ctx, &txn);
+
+		err = modbus_tx_wait_rx_adu(ctx);
+		if (err == 0) {
+			err = mbc_batch_rd_response(&ctx->rx_adu, &txn);
+		}
+
+		mbc_batch_complete(&txn, err);
+		next = mbc_batch_next(reqs, num_reqs, next + txn.num_reqs);
+	}
+}
+
+#ifdef CONFIG_MODBUS_RAW_ADU
+bool modbus_batch_rx_adu(struct modbus_context *ctx,
+			 const struct modbus_adu *adu)
+{
+	k_spinlock_key_t key = k_spin_lock(&ctx->batch_lock);
+	bool consumed = ctx->batch_active;
+	bool matched = false;
+
+	ARRAY_FOR_EACH_PTR(ctx->batch_txn, txn) {
+		if (consumed && txn->pending && txn->trans_id == adu->trans_id) {
+			mbc_batch_complete(txn, mbc_batch_rd_response(adu, txn));
+			txn->pending = false;
+			txn->done = true;
+			matched = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&ctx->batch_lock, key);
+
+	if (consumed && !matched) {
+		LOG_WRN("No request for transaction %u", adu->trans_id);
+	} else if (matched) {
+		k_sem_give(&ctx->client_wait_sem);
+	}
+
+	return consumed;
+}
+
+static void mbc_batch_pipelined(struct modbus_context *ctx,
+				struct modbus_reg_read *reqs, size_t num_reqs)
+{
+	size_t next = mbc_batch_next(reqs, num_reqs, 0);
+	size_t in_flight = 0;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ctx->batch_lock);
+	memset(ctx->batch_txn, 0, sizeof(ctx->batch_txn));
+	ctx->batch_active = true;
+	k_spin_unlock(&ctx->batch_lock, key);
+	k_sem_reset(&ctx->client_wait_sem);
+
+	while (next < num_reqs || in_flight > 0) {
+		bool timeout = false;
+
+		/* Fill the free slots, every response received frees one */
+		ARRAY_FOR_EACH_PTR(ctx->batch_txn, txn) {
+			if (next >= num_reqs) {
+				break;
+			}
+
+			if (txn->pending || txn->done) {
+				continue;
+			}
+
+			key = k_spin_lock(&ctx->batch_lock);
+			mbc_batch_merge(txn, &reqs[next], num_reqs - next);
+			txn->trans_id = ++ctx->batch_trans_id;
+			txn->pending = true;
+			k_spin_unlock(&ctx->batch_lock, key);
+
+			next = mbc_batch_next(reqs, num_reqs, next + txn->num_reqs);
+			in_flight++;
+
+			/* The response may be submitted before this returns */
+			mbc_batch_tx_setup(ctx, txn);
+			modbus_tx_adu(ctx);
+		}
+
+		if (k_sem_take(&ctx->client_wait_sem, K_USEC(ctx->rxwait_to)) != 0) {
+			LOG_WRN("Client wait-for-RX timeout");
+			timeout = true;
+		}
+
+		key = k_spin_lock(&ctx->batch_lock);
+		ARRAY_FOR_EACH_PTR(ctx->batch_txn, txn) {
+			if (timeout && txn->pending) {
+				mbc_batch_complete(txn, -ETIMEDOUT);
+				txn->pending = false;
+				txn->done = true;
+			}
+
+			if (txn->done) {
+				txn->done = false;
+				in_flight--;
+			}
+		}
+		k_spin_unlock(&ctx->batch_lock, key);
+	}
+
+	key = k_spin_lock(&ctx->batch_lock);
+	ctx->batch_active = false;
+	k_spin_unlock(&ctx->batch_lock, key);
+}
+#endif /* CONFIG_MODBUS_RAW_ADU */
+
+int modbus_read_regs_batch(const int iface,
+			   struct modbus_reg_read *reqs,
+			   const size_t num_reqs)
+{
+	struct modbus_context *ctx = modbus_get_context(iface);
+	bool pipelined = false;
+
+	if (ctx == NULL) {
+		return -ENODEV;
+	}
+
+	if (reqs == NULL && num_reqs > 0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < num_reqs; i++) {
+		reqs[i].err = mbc_batch_req_valid(&reqs[i]) ? -EINPROGRESS : -EINVAL;
+	}
+
+	k_mutex_lock(&ctx->iface_lock, K_FOREVER);
+
+#ifdef CONFIG_MODBUS_RAW_ADU
+	pipelined = ctx->mode == MODBUS_MODE_RAW;
+	if (pipelined) {
+		mbc_batch_pipelined(ctx, reqs, num_reqs);
+	}
+#endif
+
+	if (!pipelined) {
+		mbc_batch_sequential(ctx, reqs, num_reqs);
+	}
+
+	k_mutex_unlock(&ctx->iface_lock);
+
+	for (size_t i = 0; i < num_reqs; i++) {
+		if (reqs[i].err != 0) {
+			return reqs[i].err;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_MODBUS_CLIENT_BATCH */
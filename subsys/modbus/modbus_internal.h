@@ -89,6 +89,23 @@ struct modbus_serial_config {
 
 #define MODBUS_STATE_CONFIGURED		0
 
+#ifdef CONFIG_MODBUS_CLIENT_BATCH
+/* Request of a batch, covering one or more merged register reads */
+struct modbus_batch_txn {
+	/* First register read covered by the request */
+	struct modbus_reg_read *req;
+	/* Number of register reads covered */
+	size_t num_reqs;
+	/* Transaction identifier of the request */
+	uint16_t trans_id;
+	/* True while waiting for the response */
+	bool pending;
+	/* True once the response is processed or has timed out */
+	bool done;
+};
+#endif
+
+
 struct modbus_context {
 	/* Interface name */
 	const char *iface_name;
@@ -135,6 +152,16 @@ struct modbus_context {
 	/* Unit ID */
 	uint8_t unit_id;
 
+#if defined(CONFIG_MODBUS_CLIENT_BATCH) && defined(CONFIG_MODBUS_RAW_ADU)
+	/* Requests of the batch in flight on a raw ADU interface */
+	struct modbus_batch_txn batch_txn[CONFIG_MODBUS_CLIENT_BATCH_DEPTH];
+	/* Protects the requests in flight against the backend RX */
+	struct k_spinlock batch_lock;
+	/* True while a batch is in progress */
+	bool batch_active;
+	/* Last transaction identifier used */
+	uint16_t batch_trans_id;
+#endif
 };
 
 /**
@@ -252,4 +279,15 @@ int modbus_raw_tx_adu(struct modbus_context *ctx);
 int modbus_raw_init(struct modbus_context *ctx,
 		    struct modbus_iface_param param);
 
+/**
+ * @brief Let a batch in progress handle a raw ADU received by a client.
+ *
+ * @param ctx        Modbus interface context
+ * @param adu        Received ADU
+ *
+ * @retval           True if the ADU was consumed by the batch.
+ */
+bool modbus_batch_rx_adu(struct modbus_context *ctx,
+			 const struct modbus_adu *adu);
+
 #endif /* ZEPHYR_INCLUDE_MODBUS_INTERNAL_H_ */
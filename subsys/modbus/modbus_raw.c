@@ -64,6 +64,11 @@ int modbus_raw_submit_rx(const int iface, const struct modbus_adu *adu)
 		return -ENOTSUP;
 	}
 
+	if (IS_ENABLED(CONFIG_MODBUS_CLIENT_BATCH) && ctx->client &&
+	    modbus_batch_rx_adu(ctx, adu)) {
+		return 0;
+	}
+
 	ctx->rx_adu.trans_id = adu->trans_id;
 	ctx->rx_adu.proto_id = adu->proto_id;
 	ctx->rx_adu.length = adu->length;
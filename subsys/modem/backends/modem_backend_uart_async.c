@@ -15,8 +15,6 @@ LOG_MODULE_REGISTER(modem_backend_uart_async, CONFIG_MODEM_MODULES_LOG_LEVEL);
 enum {
 	MODEM_BACKEND_UART_ASYNC_STATE_TRANSMITTING_BIT,
 	MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT,
-	MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT,
-	MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF1_USED_BIT,
 	MODEM_BACKEND_UART_ASYNC_STATE_OPEN_BIT,
 };
 
@@ -25,11 +23,7 @@ static bool modem_backend_uart_async_is_uart_stopped(struct modem_backend_uart *
 	if (!atomic_test_bit(&backend->async.state,
 			    MODEM_BACKEND_UART_ASYNC_STATE_TRANSMITTING_BIT) &&
 	    !atomic_test_bit(&backend->async.state,
-			    MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT) &&
-	    !atomic_test_bit(&backend->async.state,
-			    MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT) &&
-	    !atomic_test_bit(&backend->async.state,
-			    MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF1_USED_BIT)) {
+			    MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT)) {
 		return true;
 	}
 
@@ -42,12 +36,40 @@ static bool modem_backend_uart_async_is_open(struct modem_backend_uart *backend)
 			       MODEM_BACKEND_UART_ASYNC_STATE_OPEN_BIT);
 }
 
+/* Start receiving again once the data filling all the receive buffers is consumed */
+static int modem_backend_uart_async_rx_enable(struct modem_backend_uart *backend)
+{
+	uint8_t *buf;
+	int ret;
+
+	if (atomic_test_and_set_bit(&backend->async.state,
+				    MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT)) {
+		return 0;
+	}
+
+	buf = uart_async_rx_buf_req(&backend->async.rx);
+	if (buf == NULL) {
+		atomic_clear_bit(&backend->async.state,
+				 MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT);
+		return -ENOMEM;
+	}
+
+	ret = uart_rx_enable(backend->uart, buf, uart_async_rx_get_buf_len(&backend->async.rx),
+			     CONFIG_MODEM_BACKEND_UART_ASYNC_RECEIVE_IDLE_TIMEOUT_MS * 1000L);
+	if (ret < 0) {
+		uart_async_rx_on_buf_rel(&backend->async.rx, buf);
+		atomic_clear_bit(&backend->async.state,
+				 MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT);
+	}
+
+	return ret;
+}
+
 static void modem_backend_uart_async_event_handler(const struct device *dev,
 						   struct uart_event *evt, void *user_data)
 {
 	struct modem_backend_uart *backend = (struct modem_backend_uart *) user_data;
-	k_spinlock_key_t key;
-	uint32_t received;
+	uint8_t *buf;
 
 	switch (evt->type) {
 	case UART_TX_DONE:
@@ -68,67 +90,41 @@ static void modem_backend_uart_async_event_handler(const struct device *dev,
 		break;
 
 	case UART_RX_BUF_REQUEST:
-		if (!atomic_test_and_set_bit(&backend->async.state,
-					     MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT)) {
-			uart_rx_buf_rsp(backend->uart, backend->async.receive_bufs[0],
-					backend->async.receive_buf_size);
-
+		buf = uart_async_rx_buf_req(&backend->async.rx);
+		if (buf == NULL) {
+			/* The driver stops at the end of the current buffer,
+			 * receiving is enabled again when data is consumed.
+			 */
+			LOG_WRN("No receive buffer available");
 			break;
 		}
 
-		if (!atomic_test_and_set_bit(&backend->async.state,
-					     MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF1_USED_BIT)) {
-			uart_rx_buf_rsp(backend->uart, backend->async.receive_bufs[1],
-					backend->async.receive_buf_size);
-
-			break;
+		if (uart_rx_buf_rsp(backend->uart, buf,
+				    uart_async_rx_get_buf_len(&backend->async.rx)) < 0) {
+			uart_async_rx_on_buf_rel(&backend->async.rx, buf);
 		}
-
-		LOG_WRN("No receive buffer available");
 		break;
 
 	case UART_RX_BUF_RELEASED:
-		if (evt->data.rx_buf.buf == backend->async.receive_bufs[0]) {
-			atomic_clear_bit(&backend->async.state,
-					 MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT);
-
-			break;
-		}
-
-		if (evt->data.rx_buf.buf == backend->async.receive_bufs[1]) {
-			atomic_clear_bit(&backend->async.state,
-					 MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF1_USED_BIT);
-
-			break;
-		}
-
-		LOG_WRN("Unknown receive buffer released");
+		uart_async_rx_on_buf_rel(&backend->async.rx, evt->data.rx_buf.buf);
 		break;
 
 	case UART_RX_RDY:
-		key = k_spin_lock(&backend->async.receive_rb_lock);
-		received = ring_buf_put(&backend->async.receive_rb,
-					&evt->data.rx.buf[evt->data.rx.offset],
-					evt->data.rx.len);
-
-		if (received < evt->data.rx.len) {
-			const unsigned int buf_size = ring_buf_size_get(&backend->async.receive_rb);
-
-			ring_buf_reset(&backend->async.receive_rb);
-			k_spin_unlock(&backend->async.receive_rb_lock, key);
-
-			LOG_WRN("Receive buffer overrun (dropped %u + %u)",
-				buf_size - received, (unsigned int)evt->data.rx.len);
-			break;
-		}
-
-		k_spin_unlock(&backend->async.receive_rb_lock, key);
+		/* Data is left in place in the receive buffers until it is
+		 * consumed, the driver keeps receiving into the next ones.
+		 */
+		uart_async_rx_on_rdy(&backend->async.rx, evt->data.rx.buf, evt->data.rx.len);
 		k_work_schedule(&backend->receive_ready_work, K_NO_WAIT);
 		break;
 
 	case UART_RX_DISABLED:
 		atomic_clear_bit(&backend->async.state,
 				 MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT);
+		if (modem_backend_uart_async_is_open(backend)) {
+			/* Receive buffers are all full, or receiving failed */
+			k_work_submit(&backend->async.rx_disabled_work);
+			return;
+		}
 		break;
 
 	case UART_RX_STOPPED:
@@ -150,18 +146,17 @@ static int modem_backend_uart_async_open(void *data)
 	int ret;
 
 	atomic_clear(&backend->async.state);
-	ring_buf_reset(&backend->async.receive_rb);
+	ret = uart_async_rx_init(&backend->async.rx, &backend->async.rx_config);
+	if (ret < 0) {
+		return ret;
+	}
 
-	atomic_set_bit(&backend->async.state, MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT);
-	atomic_set_bit(&backend->async.state, MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT);
 	atomic_set_bit(&backend->async.state, MODEM_BACKEND_UART_ASYNC_STATE_OPEN_BIT);
 
-	/* Receive buffers are used internally by UART, receive ring buffer is
-	 * used to store received data.
+	/* The UART receives directly into the receive buffers, received data
+	 * is copied out of them only by modem_pipe_receive().
 	 */
-	ret = uart_rx_enable(backend->uart, backend->async.receive_bufs[0],
-			     backend->async.receive_buf_size,
-			     CONFIG_MODEM_BACKEND_UART_ASYNC_RECEIVE_IDLE_TIMEOUT_MS * 1000L);
+	ret = modem_backend_uart_async_rx_enable(backend);
 	if (ret < 0) {
 		atomic_clear(&backend->async.state);
 		return ret;
@@ -205,16 +200,30 @@ static int modem_backend_uart_async_transmit(void *data, const uint8_t *buf, siz
 static int modem_backend_uart_async_receive(void *data, uint8_t *buf, size_t size)
 {
 	struct modem_backend_uart *backend = (struct modem_backend_uart *)data;
-	k_spinlock_key_t key;
-	uint32_t received;
-	bool empty;
+	struct uart_async_rx *rx = &backend->async.rx;
+	size_t received = 0;
+	uint8_t *claimed;
+	size_t len;
+
+	/* Received data may span several receive buffers */
+	while (received < size) {
+		len = uart_async_rx_data_claim(rx, &claimed, size - received);
+		if (len == 0) {
+			break;
+		}
 
-	key = k_spin_lock(&backend->async.receive_rb_lock);
-	received = ring_buf_get(&backend->async.receive_rb, buf, size);
-	empty = ring_buf_is_empty(&backend->async.receive_rb);
-	k_spin_unlock(&backend->async.receive_rb_lock, key);
+		memcpy(&buf[received], claimed, len);
+		received += len;
+		(void)uart_async_rx_data_consume(rx, len);
+	}
+
+	if ((atomic_get(&rx->free_buf_cnt) > 0) && modem_backend_uart_async_is_open(backend) &&
+	    !atomic_test_bit(&backend->async.state,
+			     MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT)) {
+		(void)modem_backend_uart_async_rx_enable(backend);
+	}
 
-	if (!empty) {
+	if (atomic_get(&rx->pending_bytes) > 0) {
 		k_work_schedule(&backend->receive_ready_work, K_NO_WAIT);
 	}
 
@@ -228,6 +237,11 @@ static int modem_backend_uart_async_close(void *data)
 	atomic_clear_bit(&backend->async.state, MODEM_BACKEND_UART_ASYNC_STATE_OPEN_BIT);
 	uart_tx_abort(backend->uart);
 	uart_rx_disable(backend->uart);
+
+	/* No event follows if receiving has already stopped */
+	if (modem_backend_uart_async_is_uart_stopped(backend)) {
+		k_work_submit(&backend->async.rx_disabled_work);
+	}
 	return 0;
 }
 
@@ -252,22 +266,28 @@ static void modem_backend_uart_async_notify_closed(struct k_work *item)
 	struct modem_backend_uart *backend =
 		CONTAINER_OF(async, struct modem_backend_uart, async);
 
-	modem_pipe_notify_closed(&backend->pipe);
+	if (modem_backend_uart_async_is_open(backend)) {
+		/* Fails if all receive buffers hold data, receiving is then
+		 * enabled again when it is consumed.
+		 */
+		(void)modem_backend_uart_async_rx_enable(backend);
+		return;
+	}
+
+	if (modem_backend_uart_async_is_uart_stopped(backend)) {
+		modem_pipe_notify_closed(&backend->pipe);
+	}
 }
 
 void modem_backend_uart_async_init(struct modem_backend_uart *backend,
 				   const struct modem_backend_uart_config *config)
 {
-	uint32_t receive_buf_size_quarter = config->receive_buf_size / 4;
-
-	/* Use half the receive buffer for UART receive buffers */
-	backend->async.receive_buf_size = receive_buf_size_quarter;
-	backend->async.receive_bufs[0] = &config->receive_buf[0];
-	backend->async.receive_bufs[1] = &config->receive_buf[receive_buf_size_quarter];
-
-	/* Use half the receive buffer for the received data ring buffer */
-	ring_buf_init(&backend->async.receive_rb, (receive_buf_size_quarter * 2),
-		      &config->receive_buf[receive_buf_size_quarter * 2]);
+	/* The whole receive buffer is split into UART receive buffers, which
+	 * hold received data until it is consumed.
+	 */
+	backend->async.rx_config.buffer = config->receive_buf;
+	backend->async.rx_config.length = config->receive_buf_size;
+	backend->async.rx_config.buf_cnt = CONFIG_MODEM_BACKEND_UART_ASYNC_RECEIVE_BUF_COUNT;
 
 	backend->async.transmit_buf = config->transmit_buf;
 	backend->async.transmit_buf_size = config->transmit_buf_size;
@@ -838,6 +838,60 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 	}
 }
 
+/*
+ * Process the received bytes, skipping to the next flag (0xF9) while waiting for
+ * the start of a frame and copying the data field of a frame in one go. The other
+ * fields are processed byte by byte.
+ */
+static void modem_cmux_process_received_data(struct modem_cmux *cmux, const uint8_t *data,
+					     size_t size)
+{
+	const uint8_t *sof;
+	size_t len;
+
+	while (size > 0) {
+		switch (cmux->receive_state) {
+		case MODEM_CMUX_RECEIVE_STATE_SOF:
+			sof = memchr(data, 0xF9, size);
+			if (sof == NULL) {
+				return;
+			}
+
+			len = sof - data;
+			data += len;
+			size -= len;
+			break;
+
+		case MODEM_CMUX_RECEIVE_STATE_DATA:
+			len = MIN(size, cmux->frame.data_len - cmux->receive_buf_len);
+
+			/* One byte is left for the byte by byte path, which moves to the FCS */
+			if (len > 1) {
+				len--;
+				if (cmux->receive_buf_len < cmux->receive_buf_size) {
+					memcpy(&cmux->receive_buf[cmux->receive_buf_len], data,
+					       MIN(len, cmux->receive_buf_size -
+							cmux->receive_buf_len));
+				}
+
+				cmux->receive_buf_len += len;
+				data += len;
+				size -= len;
+				continue;
+			}
+
+			break;
+
+		default:
+			break;
+		}
+
+		modem_cmux_process_received_byte(cmux, *data);
+		data++;
+		size--;
+	}
+}
+
 static void modem_cmux_receive_handler(struct k_work *item)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
@@ -854,9 +908,7 @@ static void modem_cmux_receive_handler(struct k_work *item)
 	}
 
 	/* Process received data */
-	for (int i = 0; i < ret; i++) {
-		modem_cmux_process_received_byte(cmux, cmux->work_buf[i]);
-	}
+	modem_cmux_process_received_data(cmux, cmux->work_buf, ret);
 
 	/* Reschedule received work */
 	k_work_schedule(&cmux->receive_work, K_NO_WAIT);
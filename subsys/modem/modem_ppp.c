@@ -34,6 +34,12 @@ static uint16_t modem_ppp_fcs_final(uint16_t fcs)
 	return fcs ^ 0xFFFF;
 }
 
+static bool modem_ppp_needs_escape(uint8_t byte)
+{
+	return (byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
+	       (byte < MODEM_PPP_VALUE_ESCAPE);
+}
+
 static uint16_t modem_ppp_ppp_protocol(struct net_pkt *pkt)
 {
 	if (net_pkt_family(pkt) == AF_INET) {
@@ -88,8 +94,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 		byte = (ppp->tx_pkt_protocol >> 8) & 0xFF;
 		ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, byte);
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_PROTOCOL_HIGH;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -106,8 +111,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 		byte = ppp->tx_pkt_protocol & 0xFF;
 		ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, byte);
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_PROTOCOL_LOW;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -125,8 +129,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 		net_pkt_read_u8(ppp->tx_pkt, &byte);
 		ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, byte);
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_DATA;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -152,8 +155,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 		ppp->tx_pkt_fcs = modem_ppp_fcs_final(ppp->tx_pkt_fcs);
 		byte = ppp->tx_pkt_fcs & 0xFF;
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_FCS_LOW;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -169,8 +171,7 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 	case MODEM_PPP_TRANSMIT_STATE_FCS_HIGH:
 		byte = (ppp->tx_pkt_fcs >> 8) & 0xFF;
 
-		if ((byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
-		    (byte < MODEM_PPP_VALUE_ESCAPE)) {
+		if (modem_ppp_needs_escape(byte)) {
 			ppp->tx_pkt_escaped = byte ^ MODEM_PPP_VALUE_ESCAPE;
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_ESCAPING_FCS_HIGH;
 			return MODEM_PPP_CODE_ESCAPE;
@@ -192,6 +193,45 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 	return 0;
 }
 
+/*
+ * Put the data bytes of the current net_buf of the packet up to the next byte
+ * to escape in the transmit ring buffer at once. Return the number of bytes put.
+ */
+static uint32_t modem_ppp_wrap_net_pkt_data(struct modem_ppp *ppp)
+{
+	struct net_pkt_cursor *cursor = &ppp->tx_pkt->cursor;
+	const uint8_t *data = cursor->pos;
+	uint32_t len;
+	uint32_t run;
+
+	if (cursor->buf == NULL) {
+		return 0;
+	}
+
+	len = (cursor->buf->data + cursor->buf->len) - cursor->pos;
+	len = MIN(len, ring_buf_space_get(&ppp->transmit_rb));
+
+	for (run = 0; run < len; run++) {
+		if (modem_ppp_needs_escape(data[run])) {
+			break;
+		}
+	}
+
+	if (run == 0) {
+		return 0;
+	}
+
+	ring_buf_put(&ppp->transmit_rb, data, run);
+	ppp->tx_pkt_fcs = crc16_ccitt(ppp->tx_pkt_fcs, data, run);
+	net_pkt_skip(ppp->tx_pkt, run);
+
+	if (net_pkt_remaining_data(ppp->tx_pkt) == 0) {
+		ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_FCS_LOW;
+	}
+
+	return run;
+}
+
 static bool modem_ppp_is_byte_expected(uint8_t byte, uint8_t expected_byte)
 {
 	if (byte == expected_byte) {
@@ -313,6 +353,52 @@ static void modem_ppp_process_received_byte(struct modem_ppp *ppp, uint8_t byte)
 	}
 }
 
+/*
+ * Process the received bytes, writing the runs of frame data which need no
+ * unescaping to the packet at once. The other bytes are processed one by one.
+ */
+static void modem_ppp_process_received_data(struct modem_ppp *ppp, const uint8_t *data,
+					    size_t size)
+{
+	size_t available;
+	size_t run;
+
+	while (size > 0) {
+		if (ppp->receive_state == MODEM_PPP_RECEIVE_STATE_WRITING) {
+			/* Keep a byte of buffer for the byte path, which allocates more */
+			available = net_pkt_available_buffer(ppp->rx_pkt);
+			available = (available > 1) ? (available - 1) : 0;
+
+			for (run = 0; run < MIN(size, available); run++) {
+				if ((data[run] == MODEM_PPP_CODE_DELIMITER) ||
+				    (data[run] == MODEM_PPP_CODE_ESCAPE)) {
+					break;
+				}
+			}
+
+			if (run > 0) {
+				if (net_pkt_write(ppp->rx_pkt, data, run) < 0) {
+					LOG_WRN("Dropped PPP frame");
+					net_pkt_unref(ppp->rx_pkt);
+					ppp->rx_pkt = NULL;
+					ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
+#if defined(CONFIG_NET_STATISTICS_PPP)
+					ppp->stats.drop++;
+#endif
+				}
+
+				data += run;
+				size -= run;
+				continue;
+			}
+		}
+
+		modem_ppp_process_received_byte(ppp, *data);
+		data++;
+		size--;
+	}
+}
+
 static void modem_ppp_pipe_callback(struct modem_pipe *pipe, enum modem_pipe_event event,
 				    void *user_data)
 {
@@ -353,6 +439,11 @@ static void modem_ppp_send_handler(struct k_work *item)
 
 		/* Fill transmit ring buffer */
 		while (ring_buf_space_get(&ppp->transmit_rb) > 0) {
+			if ((ppp->transmit_state == MODEM_PPP_TRANSMIT_STATE_DATA) &&
+			    (modem_ppp_wrap_net_pkt_data(ppp) > 0)) {
+				continue;
+			}
+
 			byte = modem_ppp_wrap_net_pkt_byte(ppp);
 
 			ring_buf_put(&ppp->transmit_rb, &byte, 1);
@@ -392,9 +483,7 @@ static void modem_ppp_process_handler(struct k_work *item)
 		return;
 	}
 
-	for (int i = 0; i < ret; i++) {
-		modem_ppp_process_received_byte(ppp, ppp->receive_buf[i]);
-	}
+	modem_ppp_process_received_data(ppp, ppp->receive_buf, ret);
 
 	k_work_submit(&ppp->process_work);
 }
@@ -44,6 +44,48 @@ static inline uint8_t get_6co_cid(struct net_icmpv6_nd_opt_6co *opt)
 }
 
 static struct net_6lo_context ctx_6co[CONFIG_NET_MAX_6LO_CONTEXTS];
+
+/* Slot + 1 of the context last set for each CID, 0 if none */
+static uint8_t ctx_6co_by_cid[16];
+#endif
+
+#if defined(CONFIG_NET_6LO_COMPRESS_CACHE)
+/* Compressed form of the addresses of a flow. The address fields of the IPHC
+ * header only depend on the addresses, the link layer addresses and the
+ * contexts, so packets of the same flow get a copy of them.
+ */
+struct net_6lo_flow {
+	struct net_if *iface;
+	uint8_t src[NET_IPV6_ADDR_SIZE];
+	uint8_t dst[NET_IPV6_ADDR_SIZE];
+	uint8_t ll_src[NET_LINK_ADDR_MAX_LENGTH];
+	uint8_t ll_dst[NET_LINK_ADDR_MAX_LENGTH];
+	uint8_t ll_src_len;
+	uint8_t ll_dst_len;
+	/* CID, SAC, SAM, M, DAC and DAM bits of IPHC */
+	uint16_t iphc;
+	/* CID byte when CID is set */
+	uint8_t cid;
+	/* Inline source address followed by inline destination address */
+	uint8_t inline_len;
+	uint8_t inline_addr[2 * NET_IPV6_ADDR_SIZE];
+};
+
+static struct net_6lo_flow flows_6lo[CONFIG_NET_6LO_COMPRESS_CACHE_SIZE];
+static uint8_t flows_6lo_last;
+static uint8_t flows_6lo_next;
+static struct k_spinlock flows_6lo_lock;
+
+static void flush_6lo_flows(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&flows_6lo_lock);
+
+	ARRAY_FOR_EACH(flows_6lo, i) {
+		flows_6lo[i].iface = NULL;
+	}
+
+	k_spin_unlock(&flows_6lo_lock, key);
+}
 #endif
 
 static const uint8_t udp_nhc_inline_size_table[] = {4, 3, 3, 1};
@@ -170,6 +212,8 @@ static inline void set_6lo_context(struct net_if *iface, uint8_t index,
 	ctx_6co[index].cid = get_6co_cid(context);
 
 	net_ipv6_addr_copy_raw((uint8_t *)&ctx_6co[index].prefix, context->prefix);
+
+	ctx_6co_by_cid[ctx_6co[index].cid] = index + 1U;
 }
 
 void net_6lo_set_context(struct net_if *iface,
@@ -178,6 +222,11 @@ void net_6lo_set_context(struct net_if *iface,
 	int unused = -1;
 	uint8_t i;
 
+#if defined(CONFIG_NET_6LO_COMPRESS_CACHE)
+	/* Flows compressed with the previous contexts are stale */
+	flush_6lo_flows();
+#endif
+
 	/* If the context information already exists, update or remove
 	 * as per data.
 	 */
@@ -214,7 +263,13 @@ void net_6lo_set_context(struct net_if *iface,
 static inline struct net_6lo_context *
 get_6lo_context_by_cid(struct net_if *iface, uint8_t cid)
 {
-	uint8_t i;
+	uint8_t i = ctx_6co_by_cid[cid];
+
+	/* Usually a single interface uses each CID, found right away */
+	if (i != 0U && ctx_6co[i - 1U].is_used && ctx_6co[i - 1U].iface == iface &&
+	    ctx_6co[i - 1U].cid == cid) {
+		return &ctx_6co[i - 1U];
+	}
 
 	for (i = 0U; i < CONFIG_NET_MAX_6LO_CONTEXTS; i++) {
 		if (!ctx_6co[i].is_used) {
@@ -717,6 +772,152 @@ static struct net_6lo_context *get_dst_addr_ctx(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_6LO_CONTEXT */
 
+/* Helper to compress the source and destination addresses, sets the CID byte
+ * in cid when a context is used.
+ */
+static uint8_t *compress_addrs(struct net_pkt *pkt, struct net_ipv6_hdr *ipv6,
+			       uint8_t *inline_pos, uint16_t *iphc, uint8_t *cid)
+{
+#if defined(CONFIG_NET_6LO_CONTEXT)
+	struct net_6lo_context *src_ctx;
+	struct net_6lo_context *dst_ctx;
+#endif
+
+	if (net_6lo_ll_prefix_padded_with_zeros((struct in6_addr *)ipv6->dst)) {
+		inline_pos = compress_da(ipv6, pkt, inline_pos, iphc);
+		goto da_end;
+	}
+
+	if (net_ipv6_is_addr_mcast((struct in6_addr *)ipv6->dst)) {
+		inline_pos = compress_da_mcast(ipv6, inline_pos, iphc);
+		goto da_end;
+	}
+
+#if defined(CONFIG_NET_6LO_CONTEXT)
+	dst_ctx = get_dst_addr_ctx(pkt, ipv6);
+	if (dst_ctx) {
+		*iphc |= NET_6LO_IPHC_CID_1;
+		*cid |= dst_ctx->cid & 0x0F;
+		inline_pos = compress_da_ctx(ipv6, inline_pos, pkt, iphc,
+					     dst_ctx);
+		goto da_end;
+	}
+#endif
+	inline_pos = set_da_inline(ipv6, inline_pos, iphc);
+da_end:
+
+	if (net_6lo_ll_prefix_padded_with_zeros((struct in6_addr *)ipv6->src)) {
+		inline_pos = compress_sa(ipv6, pkt, inline_pos, iphc);
+		goto sa_end;
+	}
+
+	if (net_ipv6_is_addr_unspecified((struct in6_addr *)ipv6->src)) {
+		NET_DBG("SAM_00, SAC_1 unspecified src address");
+
+		/* Unspecified IPv6 src address */
+		*iphc |= NET_6LO_IPHC_SAC_1;
+		*iphc |= NET_6LO_IPHC_SAM_00;
+		goto sa_end;
+	}
+
+#if defined(CONFIG_NET_6LO_CONTEXT)
+	src_ctx = get_src_addr_ctx(pkt, ipv6);
+	if (src_ctx) {
+		inline_pos = compress_sa_ctx(ipv6, inline_pos, pkt, iphc,
+					     src_ctx);
+		*iphc |= NET_6LO_IPHC_CID_1;
+		*cid |= src_ctx->cid << 4;
+		goto sa_end;
+	}
+#endif
+	inline_pos = set_sa_inline(ipv6, inline_pos, iphc);
+sa_end:
+	return inline_pos;
+}
+
+#if defined(CONFIG_NET_6LO_COMPRESS_CACHE)
+static bool flow_6lo_matches(struct net_6lo_flow *flow, struct net_pkt *pkt,
+			     struct net_ipv6_hdr *ipv6)
+{
+	struct net_linkaddr *ll_src = net_pkt_lladdr_src(pkt);
+	struct net_linkaddr *ll_dst = net_pkt_lladdr_dst(pkt);
+
+	return flow->iface == net_pkt_iface(pkt) &&
+	       !memcmp(flow->dst, ipv6->dst, NET_IPV6_ADDR_SIZE) &&
+	       !memcmp(flow->src, ipv6->src, NET_IPV6_ADDR_SIZE) &&
+	       flow->ll_src_len == ll_src->len && flow->ll_dst_len == ll_dst->len &&
+	       !memcmp(flow->ll_src, ll_src->addr, ll_src->len) &&
+	       !memcmp(flow->ll_dst, ll_dst->addr, ll_dst->len);
+}
+
+static bool flow_6lo_cacheable(struct net_pkt *pkt)
+{
+	struct net_linkaddr *ll_src = net_pkt_lladdr_src(pkt);
+	struct net_linkaddr *ll_dst = net_pkt_lladdr_dst(pkt);
+
+	return ll_src->addr != NULL && ll_src->len <= NET_LINK_ADDR_MAX_LENGTH &&
+	       ll_dst->addr != NULL && ll_dst->len <= NET_LINK_ADDR_MAX_LENGTH;
+}
+
+/* Copy the compressed addresses of the flow of the packet, if known */
+static bool get_cached_addrs(struct net_pkt *pkt, struct net_ipv6_hdr *ipv6,
+			     uint8_t **inline_pos, uint16_t *iphc, uint8_t *cid)
+{
+	k_spinlock_key_t key = k_spin_lock(&flows_6lo_lock);
+	struct net_6lo_flow *flow = &flows_6lo[flows_6lo_last];
+	bool found = flow_6lo_matches(flow, pkt, ipv6);
+
+	for (uint8_t i = 0U; !found && i < ARRAY_SIZE(flows_6lo); i++) {
+		flow = &flows_6lo[i];
+		if (i != flows_6lo_last && flow_6lo_matches(flow, pkt, ipv6)) {
+			flows_6lo_last = i;
+			found = true;
+		}
+	}
+
+	if (found) {
+		*inline_pos -= flow->inline_len;
+		memcpy(*inline_pos, flow->inline_addr, flow->inline_len);
+		*iphc |= flow->iphc;
+		*cid = flow->cid;
+	}
+
+	k_spin_unlock(&flows_6lo_lock, key);
+
+	return found;
+}
+
+/* Remember the compressed addresses of a flow, src and dst are copies of the
+ * addresses taken before compression, which may overwrite them.
+ */
+static void cache_addrs(struct net_pkt *pkt, const uint8_t *src, const uint8_t *dst,
+			const uint8_t *inline_addr, uint8_t inline_len, uint16_t iphc,
+			uint8_t cid)
+{
+	struct net_linkaddr *ll_src = net_pkt_lladdr_src(pkt);
+	struct net_linkaddr *ll_dst = net_pkt_lladdr_dst(pkt);
+	k_spinlock_key_t key = k_spin_lock(&flows_6lo_lock);
+	struct net_6lo_flow *flow = &flows_6lo[flows_6lo_next];
+
+	flow->iface = net_pkt_iface(pkt);
+	memcpy(flow->src, src, NET_IPV6_ADDR_SIZE);
+	memcpy(flow->dst, dst, NET_IPV6_ADDR_SIZE);
+	memcpy(flow->ll_src, ll_src->addr, ll_src->len);
+	memcpy(flow->ll_dst, ll_dst->addr, ll_dst->len);
+	flow->ll_src_len = ll_src->len;
+	flow->ll_dst_len = ll_dst->len;
+	flow->iphc = iphc;
+	flow->cid = cid;
+	flow->inline_len = inline_len;
+	memcpy(flow->inline_addr, inline_addr, inline_len);
+
+	flows_6lo_last = flows_6lo_next;
+	flows_6lo_next = (flows_6lo_next + 1U) % ARRAY_SIZE(flows_6lo);
+
+	k_spin_unlock(&flows_6lo_lock, key);
+}
+#endif /* CONFIG_NET_6LO_COMPRESS_CACHE */
+
 /* RFC 6282 LOWPAN IPHC Encoding format (3.1)
  *  Base Format
  *   0                                       1
@@ -727,11 +928,8 @@ static struct net_6lo_context *get_dst_addr_ctx(struct net_pkt *pkt,
  */
 static inline int compress_IPHC_header(struct net_pkt *pkt)
 {
-#if defined(CONFIG_NET_6LO_CONTEXT)
-	struct net_6lo_context *src_ctx = NULL;
-	struct net_6lo_context *dst_ctx = NULL;
-#endif
 	uint8_t compressed = 0;
+	uint8_t cid = 0U;
 	uint16_t iphc = (NET_6LO_DISPATCH_IPHC << 8);
 	struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(pkt);
 	struct net_udp_hdr *udp;
@@ -759,72 +957,37 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 		inline_pos = compress_nh_udp(udp, inline_pos, false);
 	}
 
-	if (net_6lo_ll_prefix_padded_with_zeros((struct in6_addr *)ipv6->dst)) {
-		inline_pos = compress_da(ipv6, pkt, inline_pos, &iphc);
-		goto da_end;
-	}
+#if defined(CONFIG_NET_6LO_COMPRESS_CACHE)
+	if (flow_6lo_cacheable(pkt)) {
+		uint16_t addr_iphc = 0U;
+		uint8_t *addr_end = inline_pos;
+		uint8_t src[NET_IPV6_ADDR_SIZE];
+		uint8_t dst[NET_IPV6_ADDR_SIZE];
 
-	if (net_ipv6_is_addr_mcast((struct in6_addr *)ipv6->dst)) {
-		inline_pos = compress_da_mcast(ipv6, inline_pos, &iphc);
-		goto da_end;
-	}
+		if (!get_cached_addrs(pkt, ipv6, &inline_pos, &iphc, &cid)) {
+			memcpy(src, ipv6->src, sizeof(src));
+			memcpy(dst, ipv6->dst, sizeof(dst));
 
-#if defined(CONFIG_NET_6LO_CONTEXT)
-	dst_ctx = get_dst_addr_ctx(pkt, ipv6);
-	if (dst_ctx) {
-		iphc |= NET_6LO_IPHC_CID_1;
-		inline_pos = compress_da_ctx(ipv6, inline_pos, pkt, &iphc,
-					     dst_ctx);
-		goto da_end;
-	}
-#endif
-	inline_pos = set_da_inline(ipv6, inline_pos, &iphc);
-da_end:
-
-	if (net_6lo_ll_prefix_padded_with_zeros((struct in6_addr *)ipv6->src)) {
-		inline_pos = compress_sa(ipv6, pkt, inline_pos, &iphc);
-		goto sa_end;
-	}
-
-	if (net_ipv6_is_addr_unspecified((struct in6_addr *)ipv6->src)) {
-		NET_DBG("SAM_00, SAC_1 unspecified src address");
-
-		/* Unspecified IPv6 src address */
-		iphc |= NET_6LO_IPHC_SAC_1;
-		iphc |= NET_6LO_IPHC_SAM_00;
-		goto sa_end;
-	}
-
-#if defined(CONFIG_NET_6LO_CONTEXT)
-	src_ctx = get_src_addr_ctx(pkt, ipv6);
-	if (src_ctx) {
-		inline_pos = compress_sa_ctx(ipv6, inline_pos, pkt, &iphc,
-					     src_ctx);
-		iphc |= NET_6LO_IPHC_CID_1;
-		goto sa_end;
+			inline_pos = compress_addrs(pkt, ipv6, inline_pos, &addr_iphc, &cid);
+			cache_addrs(pkt, src, dst, inline_pos, addr_end - inline_pos,
+				    addr_iphc, cid);
+			iphc |= addr_iphc;
+		}
+	} else {
+		inline_pos = compress_addrs(pkt, ipv6, inline_pos, &iphc, &cid);
 	}
+#else
+	inline_pos = compress_addrs(pkt, ipv6, inline_pos, &iphc, &cid);
 #endif
-	inline_pos = set_sa_inline(ipv6, inline_pos, &iphc);
-sa_end:
 
 	inline_pos = compress_hoplimit(ipv6, inline_pos, &iphc);
 	inline_pos = compress_nh(ipv6, inline_pos, &iphc);
 	inline_pos = compress_tfl(ipv6, inline_pos, &iphc);
 
-#if defined(CONFIG_NET_6LO_CONTEXT)
 	if (iphc & NET_6LO_IPHC_CID_1) {
 		inline_pos -= sizeof(uint8_t);
-		*inline_pos = 0;
-
-		if (src_ctx) {
-			*inline_pos = src_ctx->cid << 4;
-		}
-
-		if (dst_ctx) {
-			*inline_pos |= dst_ctx->cid & 0x0F;
-		}
+		*inline_pos = cid;
 	}
-#endif
 
 	inline_pos -= sizeof(iphc);
 	iphc = htons(iphc);
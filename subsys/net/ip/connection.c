@@ -116,6 +116,105 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+BUILD_ASSERT((CONFIG_NET_CONN_HASH_SIZE & (CONFIG_NET_CONN_HASH_SIZE - 1)) == 0,
+	     "NET_CONN_HASH_SIZE must be a power of two");
+
+/* UDP and TCP handlers are also kept in a hash table. A handler with a
+ * local port and a specific remote address and port is hashed on all of
+ * them, one with only a local port is hashed on protocol and port, and
+ * one without a local port goes to the (protocol, 0) bucket. A received
+ * unicast packet can therefore only match handlers in three buckets. The
+ * rank bits differ between these three kinds of handlers, so taking the
+ * best rank over the three buckets gives the same result as scanning
+ * conn_used.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_SIZE];
+
+static uint32_t conn_hash_fold(uint32_t hash, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash * 31U) + p[i];
+	}
+
+	return hash;
+}
+
+static uint32_t conn_hash_key(uint16_t proto, uint16_t local_port,
+			      uint16_t remote_port, const void *remote_addr,
+			      size_t addr_len)
+{
+	uint32_t hash = ((uint32_t)proto << 16) | local_port;
+
+	if (remote_addr != NULL) {
+		hash = conn_hash_fold(hash, &remote_port, sizeof(remote_port));
+		hash = conn_hash_fold(hash, remote_addr, addr_len);
+	}
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash & (CONFIG_NET_CONN_HASH_SIZE - 1);
+}
+
+static bool conn_is_hashed(struct net_conn *conn)
+{
+	return (conn->proto == IPPROTO_UDP || conn->proto == IPPROTO_TCP) &&
+	       (conn->family == AF_INET || conn->family == AF_INET6 ||
+		conn->family == AF_UNSPEC);
+}
+
+static uint32_t conn_hash_bucket(struct net_conn *conn)
+{
+	uint16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	uint16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+
+	if (local_port != 0U && remote_port != 0U &&
+	    (conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    conn->remote_addr.sa_family == AF_INET6 &&
+		    !net_ipv6_is_addr_unspecified(&net_sin6(&conn->remote_addr)->sin6_addr)) {
+			return conn_hash_key(conn->proto, local_port, remote_port,
+					     &net_sin6(&conn->remote_addr)->sin6_addr,
+					     sizeof(struct in6_addr));
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    conn->remote_addr.sa_family == AF_INET &&
+		    net_sin(&conn->remote_addr)->sin_addr.s_addr != 0U) {
+			return conn_hash_key(conn->proto, local_port, remote_port,
+					     &net_sin(&conn->remote_addr)->sin_addr,
+					     sizeof(struct in_addr));
+		}
+	}
+
+	return conn_hash_key(conn->proto, local_port, 0U, NULL, 0);
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	if (conn_is_hashed(conn)) {
+		sys_slist_prepend(&conn_hash[conn_hash_bucket(conn)],
+				  &conn->hash_node);
+	}
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_remove(struct net_conn *conn)
+{
+	if (conn_is_hashed(conn)) {
+		sys_slist_find_and_remove(&conn_hash[conn_hash_bucket(conn)],
+					  &conn->hash_node);
+	}
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +240,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -450,6 +550,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -476,7 +577,11 @@ int net_conn_update(struct net_conn_handle *handle,
 
 	net_conn_change_callback(conn, cb, user_data);
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_hash_remove(conn);
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_hash_add(conn);
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -622,6 +727,115 @@ static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 	return NET_OK;
 }
 
+static bool conn_ip_endpoints_match(struct net_conn *conn, struct net_pkt *pkt,
+				    union net_ip_header *ip_hdr,
+				    uint16_t src_port, uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && net_pkt_family(pkt) == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping,
+		 * continue with rank checking.
+		 */
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* Find the best unicast UDP/TCP handler, must be called with conn_lock held */
+static struct net_conn *conn_hash_find(struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       uint8_t proto,
+				       uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	uint32_t buckets[3];
+	struct net_conn *conn;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && pkt_family == AF_INET6) {
+		buckets[0] = conn_hash_key(proto, dst_port, src_port,
+					   ip_hdr->ipv6->src, sizeof(struct in6_addr));
+	} else {
+		buckets[0] = conn_hash_key(proto, dst_port, src_port,
+					   ip_hdr->ipv4->src, sizeof(struct in_addr));
+	}
+
+	buckets[1] = conn_hash_key(proto, dst_port, 0U, NULL, 0);
+	buckets[2] = conn_hash_key(proto, 0U, 0U, NULL, 0);
+
+	for (int i = 0; i < ARRAY_SIZE(buckets); i++) {
+		if ((i > 0 && buckets[i] == buckets[0]) ||
+		    (i > 1 && buckets[i] == buckets[1])) {
+			continue; /* bucket already checked */
+		}
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&conn_hash[buckets[i]], conn, hash_node) {
+			if (conn->context != NULL &&
+			    net_context_is_bound_to_iface(conn->context) &&
+			    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+				continue; /* wrong interface */
+			}
+
+			if (conn->family != AF_UNSPEC && conn->family != pkt_family &&
+			    !(IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6) &&
+			      conn->family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only)) {
+				continue; /* wrong protocol family */
+			}
+
+			if (conn->proto != proto) {
+				continue; /* wrong protocol */
+			}
+
+			if (!conn_ip_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port)) {
+				continue;
+			}
+
+			if (best_rank < NET_CONN_RANK(conn->flags)) {
+				best_rank = NET_CONN_RANK(conn->flags);
+				best_match = conn;
+			}
+		}
+	}
+
+	return best_match;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -698,6 +912,14 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	if (!is_mcast_pkt && (pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP)) {
+		best_match = conn_hash_find(pkt, ip_hdr, proto, src_port, dst_port);
+		goto lookup_done;
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
@@ -786,43 +1008,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 			/* Is the candidate connection matching the packet's TCP/UDP
 			 * address and port?
 			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+			if (!conn_ip_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port)) {
+				continue;
 			}
 
 			if (best_rank < NET_CONN_RANK(conn->flags)) {
@@ -866,6 +1053,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	} /* loop end */
 
+#if defined(CONFIG_NET_CONN_HASH)
+lookup_done:
+#endif
 	if (best_match) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -953,6 +1143,12 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < ARRAY_SIZE(conn_hash); i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
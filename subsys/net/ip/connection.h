@@ -54,6 +54,11 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal hash bucket node */
+	sys_snode_t hash_node;
+#endif
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
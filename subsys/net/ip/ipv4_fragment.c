@@ -28,6 +28,8 @@ LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
 static void reassembly_timeout(struct k_work *work);
+static bool reassembly_cancel(uint32_t id, struct in_addr *src, struct in_addr *dst);
+static void reassembly_info(char *str, struct net_ipv4_reassembly *reass);
 
 static struct net_ipv4_reassembly reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
 
@@ -55,9 +57,24 @@ static struct net_ipv4_reassembly *reassembly_get(uint16_t id, struct in_addr *s
 	}
 
 	if (avail < 0) {
-		return NULL;
+		/* Make room by evicting the reassembly that waited longest */
+		for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+			if (avail < 0 ||
+			    (int32_t)(reassembly[i].last_used -
+				      reassembly[avail].last_used) < 0) {
+				avail = i;
+			}
+		}
+
+		reassembly_info("Reassembly evicted", &reassembly[avail]);
+		reassembly_cancel(reassembly[avail].id, &reassembly[avail].src,
+				  &reassembly[avail].dst);
 	}
 
+	reassembly[avail].total_len = 0U;
+	reassembly[avail].received_len = 0U;
+	reassembly[avail].bufs = 0U;
+
 	k_work_reschedule(&reassembly[avail].timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
 
 	net_ipaddr_copy(&reassembly[avail].src, src);
@@ -187,6 +204,11 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 	pkt = reass->pkt[0];
 	reass->pkt[0] = NULL;
 
+	/* Move the data into as few buffers as possible, this frees the
+	 * buffers that were left partly empty by the fragment boundaries.
+	 */
+	net_pkt_compact(pkt);
+
 	/* Update the header details for the packet */
 	net_pkt_cursor_init(pkt);
 
@@ -234,61 +256,111 @@ void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
 	}
 }
 
-/* Verify that we have all the fragments received and in correct order.
- * Return:
- * - a negative value if the fragments are erroneous and must be dropped
- * - zero if we are expecting more fragments
- * - a positive value if we can proceed with the reassembly
+static int fragment_payload_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+}
+
+static uint16_t fragment_bufs(struct net_pkt *pkt)
+{
+	struct net_buf *buf;
+	uint16_t count = 0U;
+
+	for (buf = pkt->buffer; buf != NULL; buf = buf->frags) {
+		count++;
+	}
+
+	return count;
+}
+
+/* Check that the fragment neither overlaps the ones around its place in the
+ * ordered list nor extends past the end of the datagram. Return the length
+ * of its payload, or a negative value if the whole datagram must be dropped.
  */
-static int fragments_are_ready(struct net_ipv4_reassembly *reass)
+static int fragment_check(struct net_ipv4_reassembly *reass, int pos,
+			  struct net_pkt *pkt)
 {
-	unsigned int expected_offset = 0;
-	bool more = true;
-	int i;
+	unsigned int offset = net_pkt_ipv4_fragment_offset(pkt);
+	int len = fragment_payload_len(pkt);
+	unsigned int end;
 
-	/* Fragments can arrive in any order, for example in reverse order:
-	 *   1 -> Fragment3(M=0, offset=x2)
-	 *   2 -> Fragment2(M=1, offset=x1)
-	 *   3 -> Fragment1(M=1, offset=0)
-	 * We have to test several requirements before proceeding with the reassembly:
-	 * - We received the first fragment (Fragment Offset is 0)
-	 * - All intermediate fragments are contiguous
-	 * - The More bit of the last fragment is 0
-	 */
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		struct net_pkt *pkt = reass->pkt[i];
-		unsigned int offset;
-		int payload_len;
+	if (len < 0) {
+		return -EBADMSG;
+	}
 
-		if (!pkt) {
-			break;
-		}
+	end = offset + len;
 
-		offset = net_pkt_ipv4_fragment_offset(pkt);
+	if (pos > 0) {
+		struct net_pkt *prev = reass->pkt[pos - 1];
 
-		if (offset < expected_offset) {
-			/* Overlapping or duplicated, drop it */
+		if (net_pkt_ipv4_fragment_offset(prev) + fragment_payload_len(prev) > offset) {
 			return -EBADMSG;
-		} else if (offset != expected_offset) {
-			/* Not contiguous, let's wait for fragments */
-			return 0;
 		}
+	}
 
-		payload_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+	if (pos < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT && reass->pkt[pos] &&
+	    (net_pkt_ipv4_fragment_offset(reass->pkt[pos]) < end ||
+	     net_pkt_ipv4_fragment_offset(reass->pkt[pos]) == offset)) {
+		return -EBADMSG;
+	}
 
-		if (payload_len < 0) {
+	if (!net_pkt_ipv4_fragment_more(pkt)) {
+		/* The last fragment tells the datagram length, nothing
+		 * was received beyond it.
+		 */
+		if (reass->total_len != 0U ||
+		    (pos < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT && reass->pkt[pos])) {
 			return -EBADMSG;
 		}
-
-		expected_offset += payload_len;
-		more = net_pkt_ipv4_fragment_more(pkt);
+	} else if (reass->total_len != 0U && end > reass->total_len) {
+		return -EBADMSG;
 	}
 
-	if (more) {
-		return 0;
+	return len;
+}
+
+/* Drop the least recently updated reassemblies, other than the one of the
+ * current fragment, until the held buffers fit in the budget.
+ */
+static bool reassembly_budget_check(struct net_ipv4_reassembly *current)
+{
+	struct net_ipv4_reassembly *lru;
+	unsigned int bufs;
+	int i;
+
+	if (CONFIG_NET_IPV4_FRAGMENT_MAX_BUFS == 0) {
+		return true;
 	}
 
-	return 1;
+	while (true) {
+		bufs = 0U;
+		lru = NULL;
+
+		for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+			if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
+				continue;
+			}
+
+			bufs += reassembly[i].bufs;
+
+			if (&reassembly[i] != current &&
+			    (lru == NULL ||
+			     (int32_t)(reassembly[i].last_used - lru->last_used) < 0)) {
+				lru = &reassembly[i];
+			}
+		}
+
+		if (bufs <= CONFIG_NET_IPV4_FRAGMENT_MAX_BUFS) {
+			return true;
+		}
+
+		if (lru == NULL) {
+			return false;
+		}
+
+		reassembly_info("Reassembly evicted", lru);
+		reassembly_cancel(lru->id, &lru->src, &lru->dst);
+	}
 }
 
 static int shift_packets(struct net_ipv4_reassembly *reass, int pos)
@@ -321,10 +393,9 @@ enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ip
 {
 	struct net_ipv4_reassembly *reass = NULL;
 	uint16_t flag;
-	bool found;
 	uint8_t more;
 	uint16_t id;
-	int ret;
+	int len;
 	int i;
 
 	flag = ntohs(*((uint16_t *)&hdr->offset));
@@ -352,50 +423,51 @@ enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ip
 	/* The fragments might come in wrong order so place them in the reassembly chain in the
 	 * correct order.
 	 */
-	for (i = 0, found = false; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv4_fragment_offset(pkt)) {
-				continue;
-			}
-
-			/* Make room for this fragment. If there is no room then it will discard
-			 * the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (!reass->pkt[i] ||
+		    net_pkt_ipv4_fragment_offset(reass->pkt[i]) >= net_pkt_ipv4_fragment_offset(pkt)) {
+			break;
 		}
+	}
 
-		LOG_DBG("Storing pkt %p to slot %d offset %d", pkt, i,
-			net_pkt_ipv4_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
+	len = fragment_check(reass, i, pkt);
+	if (len < 0) {
+		LOG_ERR("Overlapping IPv4 fragment, dropping id %u", reass->id);
+		net_pkt_unref(pkt);
+		goto drop;
 	}
 
-	if (!found) {
-		/* We could not add this fragment into our saved fragment list. The whole packet
-		 * must be discarded at this point.
-		 */
+	/* Make room for this fragment. If there is no room then it will discard
+	 * the whole reassembly.
+	 */
+	if (i == CONFIG_NET_IPV4_FRAGMENT_MAX_PKT ||
+	    (reass->pkt[i] && shift_packets(reass, i))) {
 		LOG_ERR("No slots available for 0x%x", reass->id);
 		net_pkt_unref(pkt);
 		goto drop;
 	}
 
-	ret = fragments_are_ready(reass);
-	if (ret < 0) {
-		LOG_ERR("Reassembled IPv4 verify failed, dropping id %u", reass->id);
+	LOG_DBG("Storing pkt %p to slot %d offset %d", pkt, i,
+		net_pkt_ipv4_fragment_offset(pkt));
 
-		/* Let the caller release the already inserted pkt */
-		if (i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
+	reass->pkt[i] = pkt;
+	reass->received_len += len;
+	reass->bufs += fragment_bufs(pkt);
+	reass->last_used = k_uptime_get_32();
 
-		net_pkt_unref(pkt);
+	if (!net_pkt_ipv4_fragment_more(pkt)) {
+		reass->total_len = net_pkt_ipv4_fragment_offset(pkt) + len;
+	}
+
+	if (!reassembly_budget_check(reass)) {
+		LOG_ERR("No buffer budget for 0x%x", reass->id);
 		goto drop;
-	} else if (ret == 0) {
+	}
+
+	/* As the fragments do not overlap, all of them have been received once
+	 * their payload adds up to the datagram length.
+	 */
+	if (reass->total_len == 0U || reass->received_len < reass->total_len) {
 		reassembly_info("Reassembly nth pkt", reass);
 
 		LOG_DBG("More fragments to be received");
@@ -621,9 +693,10 @@ enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
 	}
 
 	/* If we have already fragmented the packet, the ID field will contain a non-zero value
-	 * and we can skip other checks.
+	 * and we can skip other checks. A packet to be segmented by L2 or the
+	 * device is not fragmented either.
 	 */
-	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0) {
+	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0 && net_pkt_gso_size(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
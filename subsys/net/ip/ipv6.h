@@ -458,6 +458,18 @@ struct net_ipv6_reassembly {
 	/** Pointers to pending fragments */
 	struct net_pkt *pkt[CONFIG_NET_IPV6_FRAGMENT_MAX_PKT];
 
+	/** Payload length of the datagram, 0 until the last fragment */
+	uint32_t total_len;
+
+	/** Payload bytes received so far */
+	uint32_t received_len;
+
+	/** Uptime of the latest fragment, the oldest slot is evicted first */
+	uint32_t last_used;
+
+	/** Number of buffers held by the pending fragments */
+	uint16_t bufs;
+
 	/** IPv6 fragment identification */
 	uint32_t id;
 };
@@ -98,6 +98,13 @@ NET_NBR_TABLE_INIT(NET_NBR_GLOBAL,
 
 static K_MUTEX_DEFINE(nbr_lock);
 
+/* Index of the neighbor pool by IPv6 address, protected by nbr_lock */
+static uint8_t nbr_hash[NET_NBR_HASH_SIZE] = {
+	[0 ... (NET_NBR_HASH_SIZE - 1)] = NET_NBR_HASH_END,
+};
+
+static uint8_t nbr_hash_next[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+
 void net_ipv6_nbr_lock(void)
 {
 	(void)k_mutex_lock(&nbr_lock, K_FOREVER);
@@ -133,6 +140,41 @@ static inline struct net_nbr *get_nbr(int idx)
 	return &net_neighbor_pool[idx].nbr;
 }
 
+static inline uint8_t nbr_index(struct net_nbr *nbr)
+{
+	return ((uint8_t *)nbr - (uint8_t *)net_neighbor_pool) /
+		sizeof(net_neighbor_pool[0]);
+}
+
+static inline uint8_t nbr_hash_bucket(const struct in6_addr *addr)
+{
+	return net_nbr_hash(addr->s6_addr, sizeof(addr->s6_addr));
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	uint8_t bucket = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	uint8_t idx = nbr_index(nbr);
+
+	nbr_hash_next[idx] = nbr_hash[bucket];
+	nbr_hash[bucket] = idx;
+}
+
+static void nbr_hash_del(struct net_nbr *nbr)
+{
+	uint8_t *link = &nbr_hash[nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr)];
+	uint8_t idx = nbr_index(nbr);
+
+	while (*link != NET_NBR_HASH_END) {
+		if (*link == idx) {
+			*link = nbr_hash_next[idx];
+			return;
+		}
+
+		link = &nbr_hash_next[*link];
+	}
+}
+
 static inline struct net_nbr *get_nbr_from_data(struct net_ipv6_nbr_data *data)
 {
 	int i;
@@ -269,9 +311,12 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
-	int i;
+	uint8_t i;
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+	ARG_UNUSED(table);
+
+	for (i = nbr_hash[nbr_hash_bucket(addr)]; i != NET_NBR_HASH_END;
+	     i = nbr_hash_next[i]) {
 		struct net_nbr *nbr = get_nbr(i);
 
 		if (!nbr->ref) {
@@ -425,6 +470,7 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	nbr->iface = iface;
 
 	net_ipaddr_copy(&net_ipv6_nbr_data(nbr)->addr, addr);
+	nbr_hash_add(nbr);
 	ipv6_nbr_set_state(nbr, state);
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
@@ -623,8 +669,7 @@ struct net_nbr *net_ipv6_nbr_add(struct net_if *iface,
 		if (memcmp(cached_lladdr->addr, lladdr->addr, lladdr->len)) {
 			dbg_update_neighbor_lladdr(lladdr, cached_lladdr, addr);
 
-			net_linkaddr_set(cached_lladdr, lladdr->addr,
-					 lladdr->len);
+			net_nbr_update_lladdr(nbr, lladdr->addr, lladdr->len);
 
 			ipv6_nbr_set_state(nbr, NET_IPV6_NBR_STATE_STALE);
 		} else if (net_ipv6_nbr_data(nbr)->state ==
@@ -668,7 +713,7 @@ void net_neighbor_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	nbr_hash_del(nbr);
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -806,9 +851,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. A packet to be
+	 * segmented by L2 or the device is not fragmented either.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && net_pkt_gso_size(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -1689,8 +1735,8 @@ static inline bool handle_na_neighbor(struct net_pkt *pkt,
 				lladdr.addr, cached_lladdr,
 				(struct in6_addr *)na_hdr->tgt);
 
-			net_linkaddr_set(cached_lladdr, lladdr.addr,
-					 cached_lladdr->len);
+			net_nbr_update_lladdr(nbr, lladdr.addr,
+					      cached_lladdr->len);
 		}
 
 		if (na_hdr->flags & NET_ICMPV6_NA_FLAG_SOLICITED) {
@@ -1734,8 +1780,8 @@ static inline bool handle_na_neighbor(struct net_pkt *pkt,
 				lladdr.addr, cached_lladdr,
 				(struct in6_addr *)na_hdr->tgt);
 
-			net_linkaddr_set(cached_lladdr, lladdr.addr,
-					 cached_lladdr->len);
+			net_nbr_update_lladdr(nbr, lladdr.addr,
+					      cached_lladdr->len);
 		}
 
 		if (na_hdr->flags & NET_ICMPV6_NA_FLAG_SOLICITED) {
@@ -19,6 +19,58 @@ LOG_MODULE_REGISTER(net_nbr, CONFIG_NET_IPV6_NBR_CACHE_LOG_LEVEL);
 
 NET_NBR_LLADDR_INIT(net_neighbor_lladdr, CONFIG_NET_IPV6_MAX_NEIGHBORS);
 
+static uint8_t lladdr_hash[NET_NBR_HASH_SIZE] = {
+	[0 ... (NET_NBR_HASH_SIZE - 1)] = NET_NBR_HASH_END,
+};
+
+static void lladdr_hash_add(uint8_t idx)
+{
+	struct net_linkaddr_storage *lladdr = &net_neighbor_lladdr[idx].lladdr;
+	uint8_t bucket = net_nbr_hash(lladdr->addr, lladdr->len);
+
+	net_neighbor_lladdr[idx].hash_next = lladdr_hash[bucket];
+	lladdr_hash[bucket] = idx;
+}
+
+static void lladdr_hash_del(uint8_t idx)
+{
+	struct net_linkaddr_storage *lladdr = &net_neighbor_lladdr[idx].lladdr;
+	uint8_t *link = &lladdr_hash[net_nbr_hash(lladdr->addr, lladdr->len)];
+
+	while (*link != NET_NBR_HASH_END) {
+		if (*link == idx) {
+			*link = net_neighbor_lladdr[idx].hash_next;
+			return;
+		}
+
+		link = &net_neighbor_lladdr[*link].hash_next;
+	}
+}
+
+/* Find the next slot holding the link layer address, after the slot prev
+ * or from the start of the bucket if prev is negative. A slot updated with
+ * net_nbr_update_lladdr() may end up with the same address as another one,
+ * so there can be more than one match.
+ */
+static int lladdr_hash_find(const uint8_t *addr, uint8_t len, int prev)
+{
+	uint8_t i;
+
+	i = prev < 0 ? lladdr_hash[net_nbr_hash(addr, len)] :
+		       net_neighbor_lladdr[prev].hash_next;
+
+	for (; i != NET_NBR_HASH_END; i = net_neighbor_lladdr[i].hash_next) {
+		struct net_linkaddr_storage *lladdr =
+			&net_neighbor_lladdr[i].lladdr;
+
+		if (lladdr->len == len && !memcmp(lladdr->addr, addr, len)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
 #if defined(CONFIG_NET_IPV6_NBR_CACHE_LOG_LEVEL_DBG)
 void net_nbr_unref_debug(struct net_nbr *nbr, const char *caller, int line)
 #define net_nbr_unref(nbr) net_nbr_unref_debug(nbr, __func__, __LINE__)
@@ -91,24 +143,23 @@ int net_nbr_link(struct net_nbr *nbr, struct net_if *iface,
 		return -EALREADY;
 	}
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		if (avail < 0 && !net_neighbor_lladdr[i].ref) {
-			avail = i;
-		}
+	i = lladdr_hash_find(lladdr->addr, lladdr->len, -1);
+	if (i >= 0) {
+		/* We found same lladdr in nbr cache so just
+		 * increase the ref count.
+		 */
+		net_neighbor_lladdr[i].ref++;
 
-		if (net_neighbor_lladdr[i].ref &&
-		    !memcmp(lladdr->addr,
-			    net_neighbor_lladdr[i].lladdr.addr,
-			    lladdr->len)) {
-			/* We found same lladdr in nbr cache so just
-			 * increase the ref count.
-			 */
-			net_neighbor_lladdr[i].ref++;
+		nbr->idx = i;
+		nbr->iface = iface;
 
-			nbr->idx = i;
-			nbr->iface = iface;
+		return 0;
+	}
 
-			return 0;
+	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+		if (!net_neighbor_lladdr[i].ref) {
+			avail = i;
+			break;
 		}
 	}
 
@@ -126,6 +177,7 @@ int net_nbr_link(struct net_nbr *nbr, struct net_if *iface,
 			 lladdr->len);
 	net_neighbor_lladdr[avail].lladdr.len = lladdr->len;
 	net_neighbor_lladdr[avail].lladdr.type = lladdr->type;
+	lladdr_hash_add(avail);
 
 	nbr->iface = iface;
 
@@ -146,6 +198,7 @@ int net_nbr_unlink(struct net_nbr *nbr, struct net_linkaddr *lladdr)
 	net_neighbor_lladdr[nbr->idx].ref--;
 
 	if (!net_neighbor_lladdr[nbr->idx].ref) {
+		lladdr_hash_del(nbr->idx);
 		(void)memset(net_neighbor_lladdr[nbr->idx].lladdr.addr, 0,
 			     sizeof(net_neighbor_lladdr[nbr->idx].lladdr.addr));
 	}
@@ -156,20 +209,37 @@ int net_nbr_unlink(struct net_nbr *nbr, struct net_linkaddr *lladdr)
 	return 0;
 }
 
+int net_nbr_update_lladdr(struct net_nbr *nbr, const uint8_t *addr,
+			  uint8_t len)
+{
+	int ret;
+
+	if (nbr->idx == NET_NBR_LLADDR_UNKNOWN) {
+		return -EINVAL;
+	}
+
+	lladdr_hash_del(nbr->idx);
+	ret = net_linkaddr_set(&net_neighbor_lladdr[nbr->idx].lladdr,
+			       (uint8_t *)addr, len);
+	lladdr_hash_add(nbr->idx);
+
+	return ret;
+}
+
 struct net_nbr *net_nbr_lookup(struct net_nbr_table *table,
 			       struct net_if *iface,
 			       struct net_linkaddr *lladdr)
 {
+	int idx = -1;
 	int i;
 
-	for (i = 0; i < table->nbr_count; i++) {
-		struct net_nbr *nbr = get_nbr(table->nbr, i);
+	while ((idx = lladdr_hash_find(lladdr->addr, lladdr->len, idx)) >= 0) {
+		for (i = 0; i < table->nbr_count; i++) {
+			struct net_nbr *nbr = get_nbr(table->nbr, i);
 
-		if (nbr->ref && nbr->iface == iface &&
-		    net_neighbor_lladdr[nbr->idx].ref &&
-		    !memcmp(net_neighbor_lladdr[nbr->idx].lladdr.addr,
-			    lladdr->addr, lladdr->len)) {
-			return nbr;
+			if (nbr->ref && nbr->iface == iface && nbr->idx == idx) {
+				return nbr;
+			}
 		}
 	}
 
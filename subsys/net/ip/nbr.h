@@ -32,8 +32,35 @@ struct net_nbr_lladdr {
 
 	/** Reference count. */
 	uint8_t ref;
+
+	/** Next link layer address in the same hash bucket. */
+	uint8_t hash_next;
 };
 
+/* The neighbor and link layer address tables are indexed by hash. The
+ * buckets and the chains hold table indexes, and NET_NBR_HASH_END ends
+ * a chain.
+ */
+#if defined(CONFIG_NET_IPV6_MAX_NEIGHBORS)
+#define NET_NBR_HASH_SIZE NHPOT(CONFIG_NET_IPV6_MAX_NEIGHBORS)
+#else
+#define NET_NBR_HASH_SIZE 1
+#endif
+#define NET_NBR_HASH_END 0xff
+
+/* FNV-1a folded to the number of buckets */
+static inline uint8_t net_nbr_hash(const uint8_t *data, size_t len)
+{
+	uint32_t hash = 2166136261U;
+
+	while (len--) {
+		hash ^= *data++;
+		hash *= 16777619U;
+	}
+
+	return (hash ^ (hash >> 16)) & (NET_NBR_HASH_SIZE - 1);
+}
+
 #define NET_NBR_LLADDR_INIT(_name, _count)	\
 	struct net_nbr_lladdr _name[_count] = { }
 
@@ -171,6 +198,17 @@ int net_nbr_link(struct net_nbr *nbr, struct net_if *iface,
  */
 int net_nbr_unlink(struct net_nbr *nbr, struct net_linkaddr *lladdr);
 
+/**
+ * @brief Change the link layer address linked to a neighbor.
+ * The address is shared by all the neighbors linked to it.
+ * @param nbr Neighbor
+ * @param addr New link layer address
+ * @param len Length of the address
+ * @return 0 if ok, <0 if the neighbor has no link layer address
+ */
+int net_nbr_update_lladdr(struct net_nbr *nbr, const uint8_t *addr,
+			  uint8_t len);
+
 /**
  * @brief Return link address for a specific lladdr table index
  * @param idx Link layer address index in ll table.
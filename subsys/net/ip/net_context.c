@@ -477,6 +477,10 @@ int net_context_get(sa_family_t family, enum net_sock_type type, uint16_t proto,
 #if defined(CONFIG_NET_IPV4_MAPPING_TO_IPV6)
 		/* By default IPv4 and IPv6 are in different port spaces */
 		contexts[i].options.ipv6_v6only = true;
+#endif
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+		contexts[i].options.rx_quota = CONFIG_NET_CONTEXT_RX_QUOTA_DEFAULT;
+		atomic_clear(&contexts[i].rx_quota_used);
 #endif
 		if (IS_ENABLED(CONFIG_NET_IP)) {
 			(void)memset(&contexts[i].remote, 0, sizeof(struct sockaddr));
@@ -1711,6 +1715,20 @@ static int get_context_recv_pktinfo(struct net_context *context,
 #endif
 }
 
+static int get_context_rx_quota(struct net_context *context,
+				void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+	return get_uint16_option(context->options.rx_quota, value, len);
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -2339,6 +2357,47 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+bool net_context_rx_quota_charge(struct net_context *context,
+				 struct net_pkt *pkt)
+{
+	uint16_t quota = context->options.rx_quota;
+	struct net_buf *buf;
+	uint16_t bufs = 0U;
+	atomic_val_t used;
+
+	for (buf = pkt->buffer; buf != NULL; buf = buf->frags) {
+		bufs++;
+	}
+
+	do {
+		used = atomic_get(&context->rx_quota_used);
+
+		/* An idle context always gets the packet, however large */
+		if (quota > 0U && used > 0 && used + bufs > quota) {
+			NET_DBG("Context %p RX quota %u used, drop pkt %p",
+				context, quota, pkt);
+			net_stats_update_rx_quota_drop(net_pkt_iface(pkt));
+			return false;
+		}
+	} while (!atomic_cas(&context->rx_quota_used, used, used + bufs));
+
+	pkt->rx_quota_bufs = bufs;
+
+	return true;
+}
+
+void net_context_rx_quota_release(struct net_pkt *pkt)
+{
+	if (pkt->rx_quota_bufs == 0U || pkt->context == NULL) {
+		return;
+	}
+
+	atomic_sub(&pkt->context->rx_quota_used, pkt->rx_quota_bufs);
+	pkt->rx_quota_bufs = 0U;
+}
+#endif /* CONFIG_NET_CONTEXT_RX_QUOTA */
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -2366,6 +2425,9 @@ enum net_verdict net_context_packet_received(struct net_conn *conn,
 	if (net_context_get_proto(context) == IPPROTO_TCP) {
 		net_stats_update_tcp_recv(net_pkt_iface(pkt),
 					  net_pkt_remaining_data(pkt));
+	} else if (!net_context_rx_quota_charge(context, pkt)) {
+		/* TCP is bounded by its receive window instead */
+		goto unlock;
 	}
 
 #if defined(CONFIG_NET_CONTEXT_SYNC_RECV)
@@ -2493,6 +2555,10 @@ static enum net_verdict net_context_raw_packet_received(
 	net_context_set_iface(context, net_pkt_iface(pkt));
 	net_pkt_set_context(pkt, context);
 
+	if (!net_context_rx_quota_charge(context, pkt)) {
+		return NET_DROP;
+	}
+
 	context->recv_cb(context, pkt, ip_hdr, proto_hdr, 0, user_data);
 
 #if defined(CONFIG_NET_CONTEXT_SYNC_RECV)
@@ -3001,6 +3067,20 @@ static int set_context_recv_pktinfo(struct net_context *context,
 #endif
 }
 
+static int set_context_rx_quota(struct net_context *context,
+				const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+	return set_uint16_option(&context->options.rx_quota, value, len);
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -3064,6 +3144,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_RECV_PKTINFO:
 		ret = set_context_recv_pktinfo(context, value, len);
 		break;
+	case NET_OPT_RX_QUOTA:
+		ret = set_context_rx_quota(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -3134,6 +3217,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_RECV_PKTINFO:
 		ret = get_context_recv_pktinfo(context, value, len);
 		break;
+	case NET_OPT_RX_QUOTA:
+		ret = get_context_rx_quota(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
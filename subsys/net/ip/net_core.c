@@ -463,7 +463,7 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+static uint8_t net_queue_rx_tc(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_rx_priority2tc(prio);
@@ -478,6 +478,13 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
 
+	return tc;
+}
+
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t tc = net_queue_rx_tc(iface, pkt);
+
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
@@ -485,13 +492,11 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
-/* Called by driver when a packet has been received */
-int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+/* Returns 0 if the packet should be queued, 1 if it was filtered out and
+ * freed, or <0 if it was rejected and is still owned by the caller.
+ */
+static int net_recv_prepare(struct net_if *iface, struct net_pkt *pkt)
 {
-	if (!pkt || !iface) {
-		return -EINVAL;
-	}
-
 	if (net_pkt_is_empty(pkt)) {
 		return -ENODATA;
 	}
@@ -515,13 +520,89 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 	if (!net_pkt_filter_recv_ok(pkt)) {
 		/* silently drop the packet */
 		net_pkt_unref(pkt);
-	} else {
+		return 1;
+	}
+
+	return 0;
+}
+
+/* Called by driver when a packet has been received */
+int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+{
+	int ret;
+
+	if (!pkt || !iface) {
+		return -EINVAL;
+	}
+
+	ret = net_recv_prepare(iface, pkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (ret == 0) {
 		net_queue_rx(iface, pkt);
 	}
 
 	return 0;
 }
 
+/* Called by driver when a burst of packets has been received */
+int net_recv_data_list(struct net_if *iface, sys_slist_t *pkts)
+{
+	sys_slist_t rejected;
+	sys_snode_t *node;
+	int status = 0;
+	int ret;
+#if NET_TC_RX_COUNT > 0
+	sys_slist_t queues[NET_TC_RX_COUNT];
+
+	for (int i = 0; i < NET_TC_RX_COUNT; i++) {
+		sys_slist_init(&queues[i]);
+	}
+#endif
+
+	if (!pkts || !iface) {
+		return -EINVAL;
+	}
+
+	sys_slist_init(&rejected);
+
+	while ((node = sys_slist_get(pkts)) != NULL) {
+		struct net_pkt *pkt = (struct net_pkt *)node;
+
+		ret = net_recv_prepare(iface, pkt);
+		if (ret < 0) {
+			sys_slist_append(&rejected, node);
+			status = ret;
+			continue;
+		}
+
+		if (ret > 0) {
+			continue;
+		}
+
+#if NET_TC_RX_COUNT > 0
+		sys_slist_append(&queues[net_queue_rx_tc(iface, pkt)], node);
+#else
+		(void)net_queue_rx_tc(iface, pkt);
+		net_process_rx_packet(pkt);
+#endif
+	}
+
+#if NET_TC_RX_COUNT > 0
+	for (int i = 0; i < NET_TC_RX_COUNT; i++) {
+		if (!sys_slist_is_empty(&queues[i])) {
+			net_tc_submit_list_to_rx_queue(i, &queues[i]);
+		}
+	}
+#endif
+
+	*pkts = rejected;
+
+	return status;
+}
+
 static inline void l3_init(void)
 {
 	net_icmpv4_init();
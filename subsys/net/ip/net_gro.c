@@ -0,0 +1,361 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generic receive offload. The RX traffic class thread hands over the
+ * packets waiting in its queue, and consecutive in-order TCP segments of
+ * the same flow are merged into one packet before the IP stack sees them.
+ * Only packets that are already queued are merged, so no latency is added.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tc, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+
+/* The only TCP flags a mergeable segment may have */
+#define GRO_TCP_PSH BIT(3)
+#define GRO_TCP_ACK BIT(4)
+
+struct gro_seg {
+	struct net_pkt *pkt;
+	uint8_t *ip;
+	struct net_tcp_hdr *tcp;
+	/* L2, IP and TCP headers, all in the first buffer */
+	uint16_t hdr_len;
+	uint16_t ip_len;
+	uint16_t tcp_len;
+	uint16_t payload_len;
+	uint8_t l2_len;
+	sa_family_t family;
+};
+
+struct gro_flow {
+	struct gro_seg head;
+	uint32_t next_seq;
+	uint16_t seg_size;
+	uint8_t segs;
+	/* Nothing more can be appended */
+	bool closed;
+};
+
+/* One's complement addition of host order 16-bit words */
+static uint16_t gro_csum_add(uint16_t a, uint16_t b)
+{
+	uint32_t sum = (uint32_t)a + b;
+
+	return (uint16_t)((sum & 0xffff) + (sum >> 16));
+}
+
+static int gro_l2_hdr_len(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return sizeof(struct net_eth_hdr);
+	}
+#endif
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		return 0;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+
+	return -ENOTSUP;
+}
+
+static bool gro_parse_ip(struct gro_seg *seg, struct net_buf *buf,
+			 uint16_t *ip_total)
+{
+	uint16_t type = 0;
+
+	if (seg->l2_len > 0) {
+		type = ntohs(((struct net_eth_hdr *)buf->data)->type);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && (seg->ip[0] >> 4) == 4) {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)seg->ip;
+		uint16_t offset = (hdr->offset[0] << 8) | hdr->offset[1];
+
+		if ((seg->l2_len > 0 && type != NET_ETH_PTYPE_IP) ||
+		    hdr->vhl != 0x45 || hdr->proto != IPPROTO_TCP ||
+		    (offset & (NET_IPV4_MORE_FRAG_MASK |
+			       NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+			return false;
+		}
+
+		seg->family = AF_INET;
+		seg->ip_len = sizeof(struct net_ipv4_hdr);
+		*ip_total = ntohs(hdr->len);
+
+		return true;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && (seg->ip[0] >> 4) == 6) {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)seg->ip;
+
+		if ((seg->l2_len > 0 && type != NET_ETH_PTYPE_IPV6) ||
+		    buf->len < seg->l2_len + sizeof(struct net_ipv6_hdr) ||
+		    hdr->nexthdr != IPPROTO_TCP) {
+			return false;
+		}
+
+		seg->family = AF_INET6;
+		seg->ip_len = sizeof(struct net_ipv6_hdr);
+		*ip_total = ntohs(hdr->len) + sizeof(struct net_ipv6_hdr);
+
+		return true;
+	}
+
+	return false;
+}
+
+static bool gro_parse(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_buf *buf = pkt->frags;
+	uint16_t ip_total;
+	int l2_len;
+
+	if (buf == NULL || net_pkt_is_l2_processed(pkt)) {
+		return false;
+	}
+
+	l2_len = gro_l2_hdr_len(pkt);
+	if (l2_len < 0 || buf->len < l2_len + sizeof(struct net_ipv4_hdr)) {
+		return false;
+	}
+
+	seg->pkt = pkt;
+	seg->l2_len = l2_len;
+	seg->ip = buf->data + l2_len;
+
+	if (!gro_parse_ip(seg, buf, &ip_total) ||
+	    ip_total != net_pkt_get_len(pkt) - l2_len ||
+	    buf->len < l2_len + seg->ip_len + sizeof(struct net_tcp_hdr)) {
+		return false;
+	}
+
+	seg->tcp = (struct net_tcp_hdr *)(seg->ip + seg->ip_len);
+	seg->tcp_len = (seg->tcp->offset >> 4) * 4;
+	seg->hdr_len = l2_len + seg->ip_len + seg->tcp_len;
+
+	if (seg->tcp_len < sizeof(struct net_tcp_hdr) ||
+	    buf->len < seg->hdr_len ||
+	    ip_total <= seg->ip_len + seg->tcp_len ||
+	    (seg->tcp->flags & ~GRO_TCP_PSH) != GRO_TCP_ACK) {
+		return false;
+	}
+
+	seg->payload_len = ip_total - seg->ip_len - seg->tcp_len;
+
+	return true;
+}
+
+/* Forwarded packets are left alone, they would not fit in the MTU */
+static bool gro_is_local(struct gro_seg *seg)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4) && seg->family == AF_INET) {
+		return net_if_ipv4_addr_lookup(
+			(struct in_addr *)((struct net_ipv4_hdr *)seg->ip)->dst,
+			NULL) != NULL;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && seg->family == AF_INET6) {
+		return net_if_ipv6_addr_lookup(
+			(struct in6_addr *)((struct net_ipv6_hdr *)seg->ip)->dst,
+			NULL) != NULL;
+	}
+
+	return false;
+}
+
+static bool gro_same_flow(struct gro_seg *head, struct gro_seg *seg)
+{
+	if (net_pkt_iface(head->pkt) != net_pkt_iface(seg->pkt) ||
+	    head->family != seg->family || head->tcp_len != seg->tcp_len ||
+	    memcmp(head->pkt->frags->data, seg->pkt->frags->data,
+		   head->l2_len) != 0) {
+		return false;
+	}
+
+	if (head->family == AF_INET) {
+		struct net_ipv4_hdr *a = (struct net_ipv4_hdr *)head->ip;
+		struct net_ipv4_hdr *b = (struct net_ipv4_hdr *)seg->ip;
+
+		if (a->tos != b->tos || a->ttl != b->ttl ||
+		    memcmp(a->offset, b->offset, sizeof(a->offset)) != 0 ||
+		    memcmp(a->src, b->src, sizeof(a->src) + sizeof(a->dst)) != 0) {
+			return false;
+		}
+	} else {
+		struct net_ipv6_hdr *a = (struct net_ipv6_hdr *)head->ip;
+		struct net_ipv6_hdr *b = (struct net_ipv6_hdr *)seg->ip;
+
+		/* Version, traffic class and flow label */
+		if (memcmp(a, b, 4) != 0 || a->hop_limit != b->hop_limit ||
+		    memcmp(a->src, b->src, sizeof(a->src) + sizeof(a->dst)) != 0) {
+			return false;
+		}
+	}
+
+	/* Ports, acknowledgment, window and options must all match */
+	return head->tcp->src_port == seg->tcp->src_port &&
+	       head->tcp->dst_port == seg->tcp->dst_port &&
+	       memcmp(head->tcp->ack, seg->tcp->ack, sizeof(seg->tcp->ack)) == 0 &&
+	       memcmp(head->tcp->wnd, seg->tcp->wnd, sizeof(seg->tcp->wnd)) == 0 &&
+	       memcmp(head->tcp->optdata, seg->tcp->optdata,
+		      seg->tcp_len - sizeof(struct net_tcp_hdr)) == 0;
+}
+
+static bool gro_can_merge(struct gro_flow *flow, struct gro_seg *seg)
+{
+	struct gro_seg *head = &flow->head;
+	uint32_t len = head->payload_len + seg->payload_len + head->tcp_len;
+
+	if (head->family == AF_INET) {
+		len += head->ip_len;
+	}
+
+	return !flow->closed && flow->segs < CONFIG_NET_GRO_MAX_SEGS &&
+	       len <= UINT16_MAX && seg->payload_len <= flow->seg_size &&
+	       sys_get_be32(seg->tcp->seq) == flow->next_seq &&
+	       gro_same_flow(head, seg);
+}
+
+static void gro_start(struct gro_flow *flow, struct gro_seg *seg)
+{
+	flow->head = *seg;
+	flow->next_seq = sys_get_be32(seg->tcp->seq) + seg->payload_len;
+	flow->seg_size = seg->payload_len;
+	flow->segs = 1;
+	flow->closed = (seg->tcp->flags & GRO_TCP_PSH) ||
+		       (seg->payload_len & 1) || !gro_is_local(seg);
+}
+
+/* The TCP checksum is not verified here. Instead the checksum of the
+ * merged segment is set so that the one's complement sum over it is the
+ * sum of the sums of the original segments. It then verifies only if all
+ * of them did, and TCP checks it in a single pass as usual. Appending at
+ * an even offset keeps the payload words aligned.
+ */
+static void gro_merge(struct gro_flow *flow, struct gro_seg *seg)
+{
+	struct gro_seg *head = &flow->head;
+	uint16_t addr_len = head->family == AF_INET ? 2 * sizeof(struct in_addr) :
+			    2 * sizeof(struct in6_addr);
+	uint16_t old_len = head->tcp_len + head->payload_len;
+	uint16_t new_len = old_len + seg->payload_len;
+	uint16_t old_word;
+	struct net_buf *frags;
+	uint16_t sum;
+
+	/* Pseudo header and TCP header of the appended segment */
+	sum = calc_chksum(0, head->ip + head->ip_len - addr_len, addr_len);
+	sum = gro_csum_add(sum, IPPROTO_TCP);
+	sum = gro_csum_add(sum, seg->tcp_len + seg->payload_len);
+	sum = calc_chksum(sum, (uint8_t *)seg->tcp, seg->tcp_len);
+
+	/* Length change of the merged pseudo header */
+	sum = gro_csum_add(sum, ntohs(head->tcp->chksum));
+	sum = gro_csum_add(sum, old_len);
+	sum = gro_csum_add(sum, ~new_len);
+
+	if (seg->tcp->flags & GRO_TCP_PSH) {
+		/* The field compensates for the change in the header */
+		old_word = (head->tcp->offset << 8) | head->tcp->flags;
+		head->tcp->flags |= GRO_TCP_PSH;
+		sum = gro_csum_add(sum, old_word);
+		sum = gro_csum_add(sum, ~((head->tcp->offset << 8) | head->tcp->flags));
+		flow->closed = true;
+	}
+
+	head->tcp->chksum = htons(sum);
+
+	if (head->family == AF_INET) {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)head->ip;
+		uint16_t total = ntohs(hdr->len);
+
+		/* Incremental update (RFC 1624) keeps a bad header detectable */
+		sum = gro_csum_add(~ntohs(hdr->chksum), ~total);
+		sum = gro_csum_add(sum, total + seg->payload_len);
+		hdr->chksum = htons((uint16_t)~sum);
+		hdr->len = htons(total + seg->payload_len);
+	} else {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)head->ip;
+
+		hdr->len = htons(ntohs(hdr->len) + seg->payload_len);
+	}
+
+	net_buf_pull(seg->pkt->frags, seg->hdr_len);
+
+	frags = seg->pkt->frags;
+	seg->pkt->frags = NULL;
+
+	if (frags->len == 0U) {
+		frags = net_buf_frag_del(NULL, frags);
+	}
+
+	net_pkt_append_buffer(head->pkt, frags);
+	net_pkt_unref(seg->pkt);
+
+	head->payload_len += seg->payload_len;
+	flow->next_seq += seg->payload_len;
+	flow->segs++;
+
+	/* A short segment ends the run */
+	if (seg->payload_len < flow->seg_size) {
+		flow->closed = true;
+	}
+
+	NET_DBG("pkt %p: %u segments, %u bytes", head->pkt, flow->segs,
+		head->payload_len);
+}
+
+void net_gro_rx(struct k_fifo *fifo, struct net_pkt *pkt)
+{
+	struct gro_flow flow;
+	struct gro_seg seg;
+	bool active = false;
+
+	do {
+		if (!gro_parse(pkt, &seg)) {
+			if (active) {
+				net_process_rx_packet(flow.head.pkt);
+				active = false;
+			}
+
+			net_process_rx_packet(pkt);
+			continue;
+		}
+
+		if (active && gro_can_merge(&flow, &seg)) {
+			gro_merge(&flow, &seg);
+			continue;
+		}
+
+		if (active) {
+			net_process_rx_packet(flow.head.pkt);
+		}
+
+		gro_start(&flow, &seg);
+		active = true;
+	} while ((pkt = k_fifo_get(fifo, K_NO_WAIT)) != NULL);
+
+	if (active) {
+		net_process_rx_packet(flow.head.pkt);
+	}
+}
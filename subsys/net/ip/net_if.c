@@ -94,6 +94,25 @@ static struct {
 } ipv4_addresses[CONFIG_NET_IF_MAX_IPV4_COUNT];
 #endif /* CONFIG_NET_IPV4 */
 
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+BUILD_ASSERT((CONFIG_NET_IF_ADDR_HASH_SIZE & (CONFIG_NET_IF_ADDR_HASH_SIZE - 1)) == 0,
+	     "NET_IF_ADDR_HASH_SIZE must be a power of two");
+
+/* Protects the local address hash tables. The tables are only changed with
+ * the lock of the interface owning the address also held, and read without
+ * taking any interface lock.
+ */
+static struct k_spinlock addr_hash_lock;
+
+static uint32_t addr_hash_key(uint32_t hash)
+{
+	hash *= 0x9e3779b1U;
+	hash ^= hash >> 16;
+
+	return hash & (CONFIG_NET_IF_ADDR_HASH_SIZE - 1);
+}
+#endif /* CONFIG_NET_IF_ADDR_HASH */
+
 /* We keep track of the link callbacks in this list.
  */
 static sys_slist_t link_callbacks;
@@ -373,6 +392,58 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+void net_if_queue_tx_list(struct net_if *iface, sys_slist_t *pkts)
+{
+	sys_snode_t *node;
+#if NET_TC_TX_COUNT > 0
+	sys_slist_t queues[NET_TC_TX_COUNT];
+
+	for (int i = 0; i < NET_TC_TX_COUNT; i++) {
+		sys_slist_init(&queues[i]);
+	}
+#endif
+
+	while ((node = sys_slist_get(pkts)) != NULL) {
+		struct net_pkt *pkt = (struct net_pkt *)node;
+
+		if (!net_pkt_filter_send_ok(pkt)) {
+			/* silently drop the packet */
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		uint8_t prio = net_pkt_priority(pkt);
+		uint8_t tc = net_tx_priority2tc(prio);
+
+		net_stats_update_tc_sent_pkt(iface, tc);
+		net_stats_update_tc_sent_bytes(iface, tc, net_pkt_get_len(pkt));
+		net_stats_update_tc_sent_priority(iface, tc, prio);
+
+		if ((IS_ENABLED(CONFIG_NET_TC_SKIP_FOR_HIGH_PRIO) &&
+		     prio >= NET_PRIORITY_CA) || NET_TC_TX_COUNT == 0) {
+			net_pkt_set_tx_stats_tick(pkt, k_cycle_get_32());
+
+			net_if_tx(net_pkt_iface(pkt), pkt);
+			continue;
+		}
+
+#if NET_TC_TX_COUNT > 0
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+		iface->tx_pending++;
+#endif
+		sys_slist_append(&queues[tc], node);
+#endif
+	}
+
+#if NET_TC_TX_COUNT > 0
+	for (int i = 0; i < NET_TC_TX_COUNT; i++) {
+		if (!sys_slist_is_empty(&queues[i])) {
+			(void)net_tc_submit_list_to_tx_queue(i, &queues[i]);
+		}
+	}
+#endif
+}
+
 void net_if_stats_reset(struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
@@ -1519,6 +1590,102 @@ out:
 
 #endif
 
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+#define IPV6_ADDR_HASH_SLOTS (CONFIG_NET_IF_MAX_IPV6_COUNT * NET_IF_MAX_IPV6_ADDR)
+
+BUILD_ASSERT(IPV6_ADDR_HASH_SLOTS < UINT16_MAX);
+
+/* The unicast addresses in use of all the IPv6 configurations are chained
+ * in hash buckets by address. Address i of ipv6_addresses[k] is slot
+ * k * NET_IF_MAX_IPV6_ADDR + i + 1, and slot 0 ends a chain.
+ */
+static uint16_t ipv6_addr_hash[CONFIG_NET_IF_ADDR_HASH_SIZE];
+static uint16_t ipv6_addr_hash_next[IPV6_ADDR_HASH_SLOTS];
+
+static uint32_t ipv6_addr_hash_bucket(const struct in6_addr *addr)
+{
+	return addr_hash_key(UNALIGNED_GET(&addr->s6_addr32[0]) ^
+			     UNALIGNED_GET(&addr->s6_addr32[1]) ^
+			     UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			     UNALIGNED_GET(&addr->s6_addr32[3]));
+}
+
+static uint16_t ipv6_addr_hash_slot(struct net_if_ipv6 *ipv6, size_t i)
+{
+	size_t k = ((uintptr_t)ipv6 - (uintptr_t)&ipv6_addresses[0].ipv6) /
+		   sizeof(ipv6_addresses[0]);
+
+	return k * NET_IF_MAX_IPV6_ADDR + i + 1;
+}
+
+/* Must be called with the interface lock held */
+static void ipv6_addr_hash_add(struct net_if_ipv6 *ipv6, size_t i)
+{
+	uint16_t slot = ipv6_addr_hash_slot(ipv6, i);
+	uint32_t bucket = ipv6_addr_hash_bucket(&ipv6->unicast[i].address.in6_addr);
+	k_spinlock_key_t key = k_spin_lock(&addr_hash_lock);
+
+	ipv6_addr_hash_next[slot - 1] = ipv6_addr_hash[bucket];
+	ipv6_addr_hash[bucket] = slot;
+
+	k_spin_unlock(&addr_hash_lock, key);
+}
+
+/* Must be called with the interface lock held */
+static void ipv6_addr_hash_rm(struct net_if_ipv6 *ipv6, size_t i)
+{
+	uint16_t slot = ipv6_addr_hash_slot(ipv6, i);
+	uint32_t bucket = ipv6_addr_hash_bucket(&ipv6->unicast[i].address.in6_addr);
+	k_spinlock_key_t key = k_spin_lock(&addr_hash_lock);
+	uint16_t *prev = &ipv6_addr_hash[bucket];
+
+	while (*prev != 0U) {
+		if (*prev == slot) {
+			*prev = ipv6_addr_hash_next[slot - 1];
+			break;
+		}
+
+		prev = &ipv6_addr_hash_next[*prev - 1];
+	}
+
+	k_spin_unlock(&addr_hash_lock, key);
+}
+
+struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
+					    struct net_if **ret)
+{
+	struct net_if_addr *ifaddr = NULL;
+	k_spinlock_key_t key = k_spin_lock(&addr_hash_lock);
+	uint16_t slot = ipv6_addr_hash[ipv6_addr_hash_bucket(addr)];
+
+	for (; slot != 0U; slot = ipv6_addr_hash_next[slot - 1]) {
+		size_t k = (slot - 1) / NET_IF_MAX_IPV6_ADDR;
+		struct net_if_addr *cur =
+			&ipv6_addresses[k].ipv6.unicast[(slot - 1) % NET_IF_MAX_IPV6_ADDR];
+
+		/* A configuration keeps its addresses when released */
+		if (ipv6_addresses[k].iface == NULL ||
+		    memcmp(addr->s6_addr, cur->address.in6_addr.s6_addr,
+			   sizeof(struct in6_addr)) != 0) {
+			continue;
+		}
+
+		if (ret) {
+			*ret = ipv6_addresses[k].iface;
+		}
+
+		ifaddr = cur;
+		break;
+	}
+
+	k_spin_unlock(&addr_hash_lock, key);
+
+	return ifaddr;
+}
+#else
+#define ipv6_addr_hash_add(...)
+#define ipv6_addr_hash_rm(...)
+
 struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
 					    struct net_if **ret)
 {
@@ -1562,6 +1729,7 @@ struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
 out:
 	return ifaddr;
 }
+#endif /* CONFIG_NET_IF_ADDR_HASH */
 
 struct net_if_addr *net_if_ipv6_addr_lookup_by_iface(struct net_if *iface,
 						     struct in6_addr *addr)
@@ -1824,6 +1992,7 @@ struct net_if_addr *net_if_ipv6_addr_add(struct net_if *iface,
 
 		net_if_addr_init(&ipv6->unicast[i], addr, addr_type,
 				 vlifetime);
+		ipv6_addr_hash_add(ipv6, i);
 
 		NET_DBG("[%zu] interface %d (%p) address %s type %s added", i,
 			net_if_get_by_iface(iface), iface,
@@ -1938,6 +2107,7 @@ bool net_if_ipv6_addr_rm(struct net_if *iface, const struct in6_addr *addr)
 		}
 #endif
 
+		ipv6_addr_hash_rm(ipv6, found);
 		ipv6->unicast[found].is_used = false;
 
 		if (maddr_count == 1) {
@@ -3668,6 +3838,91 @@ out:
 	return src;
 }
 
+#if defined(CONFIG_NET_IF_ADDR_HASH)
+#define IPV4_ADDR_HASH_SLOTS (CONFIG_NET_IF_MAX_IPV4_COUNT * NET_IF_MAX_IPV4_ADDR)
+
+BUILD_ASSERT(IPV4_ADDR_HASH_SLOTS < UINT16_MAX);
+
+/* Same as ipv6_addr_hash, for the unicast addresses of ipv4_addresses */
+static uint16_t ipv4_addr_hash[CONFIG_NET_IF_ADDR_HASH_SIZE];
+static uint16_t ipv4_addr_hash_next[IPV4_ADDR_HASH_SLOTS];
+
+static uint16_t ipv4_addr_hash_slot(struct net_if_ipv4 *ipv4, size_t i)
+{
+	size_t k = ((uintptr_t)ipv4 - (uintptr_t)&ipv4_addresses[0].ipv4) /
+		   sizeof(ipv4_addresses[0]);
+
+	return k * NET_IF_MAX_IPV4_ADDR + i + 1;
+}
+
+/* Must be called with the interface lock held */
+static void ipv4_addr_hash_add(struct net_if_ipv4 *ipv4, size_t i)
+{
+	uint16_t slot = ipv4_addr_hash_slot(ipv4, i);
+	uint32_t bucket = addr_hash_key(ipv4->unicast[i].ipv4.address.in_addr.s_addr);
+	k_spinlock_key_t key = k_spin_lock(&addr_hash_lock);
+
+	ipv4_addr_hash_next[slot - 1] = ipv4_addr_hash[bucket];
+	ipv4_addr_hash[bucket] = slot;
+
+	k_spin_unlock(&addr_hash_lock, key);
+}
+
+/* Must be called with the interface lock held */
+static void ipv4_addr_hash_rm(struct net_if_ipv4 *ipv4, size_t i)
+{
+	uint16_t slot = ipv4_addr_hash_slot(ipv4, i);
+	uint32_t bucket = addr_hash_key(ipv4->unicast[i].ipv4.address.in_addr.s_addr);
+	k_spinlock_key_t key = k_spin_lock(&addr_hash_lock);
+	uint16_t *prev = &ipv4_addr_hash[bucket];
+
+	while (*prev != 0U) {
+		if (*prev == slot) {
+			*prev = ipv4_addr_hash_next[slot - 1];
+			break;
+		}
+
+		prev = &ipv4_addr_hash_next[*prev - 1];
+	}
+
+	k_spin_unlock(&addr_hash_lock, key);
+}
+
+struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
+					    struct net_if **ret)
+{
+	uint32_t s_addr = UNALIGNED_GET(&addr->s4_addr32[0]);
+	struct net_if_addr *ifaddr = NULL;
+	k_spinlock_key_t key = k_spin_lock(&addr_hash_lock);
+	uint16_t slot = ipv4_addr_hash[addr_hash_key(s_addr)];
+
+	for (; slot != 0U; slot = ipv4_addr_hash_next[slot - 1]) {
+		size_t k = (slot - 1) / NET_IF_MAX_IPV4_ADDR;
+		struct net_if_addr *cur =
+			&ipv4_addresses[k].ipv4.unicast[(slot - 1) % NET_IF_MAX_IPV4_ADDR].ipv4;
+
+		/* A configuration keeps its addresses when released */
+		if (ipv4_addresses[k].iface == NULL ||
+		    cur->address.in_addr.s_addr != s_addr) {
+			continue;
+		}
+
+		if (ret) {
+			*ret = ipv4_addresses[k].iface;
+		}
+
+		ifaddr = cur;
+		break;
+	}
+
+	k_spin_unlock(&addr_hash_lock, key);
+
+	return ifaddr;
+}
+#else
+#define ipv4_addr_hash_add(...)
+#define ipv4_addr_hash_rm(...)
+
 struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
 					    struct net_if **ret)
 {
@@ -3709,6 +3964,7 @@ struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
 out:
 	return ifaddr;
 }
+#endif /* CONFIG_NET_IF_ADDR_HASH */
 
 int z_impl_net_if_ipv4_addr_lookup_by_index(const struct in_addr *addr)
 {
@@ -4082,10 +4338,16 @@ struct net_if_addr *net_if_ipv4_addr_add(struct net_if *iface,
 	}
 
 	if (ifaddr) {
+		if (ifaddr->is_used) {
+			/* Overriding an address added earlier */
+			ipv4_addr_hash_rm(ipv4, idx);
+		}
+
 		ifaddr->is_used = true;
 		ifaddr->address.family = AF_INET;
 		ifaddr->address.in_addr.s4_addr32[0] =
 						addr->s4_addr32[0];
+		ipv4_addr_hash_add(ipv4, idx);
 		ifaddr->addr_type = addr_type;
 
 		/* Caller has to take care of timers and their expiry */
@@ -4140,6 +4402,7 @@ bool net_if_ipv4_addr_rm(struct net_if *iface, const struct in_addr *addr)
 			continue;
 		}
 
+		ipv4_addr_hash_rm(ipv4, i);
 		ipv4->unicast[i].ipv4.is_used = false;
 
 		NET_DBG("[%zu] interface %d (%p) address %s removed",
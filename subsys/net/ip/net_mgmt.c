@@ -47,8 +47,40 @@ K_KERNEL_STACK_DEFINE(mgmt_stack, CONFIG_NET_MGMT_EVENT_STACK_SIZE);
 static struct k_work_q mgmt_work_q_obj;
 #endif
 
+BUILD_ASSERT((CONFIG_NET_MGMT_EVENT_CALLBACK_BUCKETS &
+	      (CONFIG_NET_MGMT_EVENT_CALLBACK_BUCKETS - 1)) == 0,
+	     "NET_MGMT_EVENT_CALLBACK_BUCKETS must be a power of two");
+
 static uint32_t global_event_mask;
-static sys_slist_t event_callbacks = SYS_SLIST_STATIC_INIT(&event_callbacks);
+
+/* A callback only matches events of the layer and layer code of its event
+ * mask, so callbacks are kept in lists selected from these two fields. All
+ * the callbacks an event can match are then in one list, in the order they
+ * were added.
+ */
+static sys_slist_t event_callbacks[CONFIG_NET_MGMT_EVENT_CALLBACK_BUCKETS];
+
+static sys_slist_t *mgmt_event_callbacks(uint32_t event_mask)
+{
+	uint32_t hash = NET_MGMT_GET_LAYER_CODE(event_mask) ^
+			(NET_MGMT_GET_LAYER(event_mask) << 11);
+
+	hash ^= hash >> 6;
+
+	return &event_callbacks[hash & (CONFIG_NET_MGMT_EVENT_CALLBACK_BUCKETS - 1)];
+}
+
+/* The event mask of a callback may have changed since it was added, so
+ * look for it in all the lists.
+ */
+static void mgmt_remove_event_callback(struct net_mgmt_event_callback *cb)
+{
+	ARRAY_FOR_EACH(event_callbacks, i) {
+		if (sys_slist_find_and_remove(&event_callbacks[i], &cb->node)) {
+			break;
+		}
+	}
+}
 
 /* Forward declaration for the actual caller */
 static void mgmt_run_callbacks(const struct mgmt_event_entry * const mgmt_event);
@@ -158,8 +190,10 @@ static inline void mgmt_rebuild_global_event_mask(void)
 		mgmt_add_event_mask(it->event_mask);
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		mgmt_add_event_mask(cb->event_mask);
+	ARRAY_FOR_EACH(event_callbacks, i) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks[i], cb, tmp, node) {
+			mgmt_add_event_mask(cb->event_mask);
+		}
 	}
 }
 
@@ -178,6 +212,7 @@ static inline bool mgmt_is_event_handled(uint32_t mgmt_event)
 
 static inline void mgmt_run_slist_callbacks(const struct mgmt_event_entry * const mgmt_event)
 {
+	sys_slist_t *callbacks = mgmt_event_callbacks(mgmt_event->event);
 	sys_snode_t *prev = NULL;
 	struct net_mgmt_event_callback *cb, *tmp;
 
@@ -187,7 +222,7 @@ static inline void mgmt_run_slist_callbacks(const struct mgmt_event_entry * cons
 		NET_MGMT_GET_LAYER_CODE(mgmt_event->event),
 		NET_MGMT_GET_COMMAND(mgmt_event->event));
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(callbacks, cb, tmp, node) {
 		if (!(NET_MGMT_GET_LAYER(mgmt_event->event) ==
 		      NET_MGMT_GET_LAYER(cb->event_mask)) ||
 		    !(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
@@ -224,7 +259,7 @@ static inline void mgmt_run_slist_callbacks(const struct mgmt_event_entry * cons
 			cb->raised_event = mgmt_event->event;
 			sync_data->iface = mgmt_event->iface;
 
-			sys_slist_remove(&event_callbacks, prev, &cb->node);
+			sys_slist_remove(callbacks, prev, &cb->node);
 
 			k_sem_give(cb->sync_call);
 		} else {
@@ -339,9 +374,9 @@ void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb)
 	(void)k_mutex_lock(&net_mgmt_callback_lock, K_FOREVER);
 
 	/* Remove the callback if it already exists to avoid loop */
-	sys_slist_find_and_remove(&event_callbacks, &cb->node);
+	mgmt_remove_event_callback(cb);
 
-	sys_slist_prepend(&event_callbacks, &cb->node);
+	sys_slist_prepend(mgmt_event_callbacks(cb->event_mask), &cb->node);
 
 	mgmt_add_event_mask(cb->event_mask);
 
@@ -354,7 +389,7 @@ void net_mgmt_del_event_callback(struct net_mgmt_event_callback *cb)
 
 	(void)k_mutex_lock(&net_mgmt_callback_lock, K_FOREVER);
 
-	sys_slist_find_and_remove(&event_callbacks, &cb->node);
+	mgmt_remove_event_callback(cb);
 
 	mgmt_rebuild_global_event_mask();
 
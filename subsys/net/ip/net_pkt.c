@@ -593,6 +593,8 @@ done:
 		return;
 	}
 
+	net_context_rx_quota_release(pkt);
+
 	if (pkt->frags) {
 		net_pkt_frag_unref(pkt->frags);
 	}
@@ -1879,6 +1881,8 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
+	net_pkt_set_rx_hash(clone_pkt, net_pkt_rx_hash(pkt));
 
 	if (pkt->buffer && clone_pkt->buffer) {
 		memcpy(net_pkt_lladdr_src(clone_pkt), net_pkt_lladdr_src(pkt),
@@ -108,6 +108,24 @@ static inline bool net_context_is_recv_pktinfo_set(struct net_context *context)
 }
 #endif
 
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+extern bool net_context_rx_quota_charge(struct net_context *context,
+					struct net_pkt *pkt);
+extern void net_context_rx_quota_release(struct net_pkt *pkt);
+#else
+static inline bool net_context_rx_quota_charge(struct net_context *context,
+					       struct net_pkt *pkt)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(pkt);
+	return true;
+}
+static inline void net_context_rx_quota_release(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+}
+#endif
+
 #if defined(CONFIG_NET_NATIVE)
 enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback);
 enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback);
@@ -132,6 +150,20 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern bool net_tc_submit_list_to_tx_queue(uint8_t tc, sys_slist_t *list);
+extern void net_tc_submit_list_to_rx_queue(uint8_t tc, sys_slist_t *list);
+#if defined(CONFIG_NET_GRO)
+extern void net_gro_rx(struct k_fifo *fifo, struct net_pkt *pkt);
+#endif
+#if defined(CONFIG_NET_RX_RSS)
+extern uint8_t net_rx_rss_queue(struct net_pkt *pkt);
+#endif
+#if defined(CONFIG_NET_TX_SCHED)
+struct net_tx_sched;
+extern bool net_tx_sched_wait(struct net_pkt *pkt);
+extern int64_t net_tx_sched_gate_delay(const struct net_tx_sched *sched, uint8_t tc,
+				       uint64_t now);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -0,0 +1,177 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Receive side scaling. Every RX traffic class has one queue and thread per
+ * CPU, and a received packet is steered to one of them by its flow hash so
+ * that the packets of a flow stay in order while different flows are
+ * processed in parallel. The hash is taken from the device if it has
+ * hardware RSS, otherwise it is computed here from the flow 5-tuple.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tc, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <zephyr/sys/hash_function.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+
+struct rss_flow_key {
+	uint8_t src[NET_IPV6_ADDR_SIZE];
+	uint8_t dst[NET_IPV6_ADDR_SIZE];
+	uint16_t ports[2];
+	uint8_t proto;
+};
+
+/* Leave the cursor at the network header and return its ethertype */
+static int rss_skip_l2(struct net_pkt *pkt, uint16_t *type)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		if (net_pkt_skip(pkt, 2 * sizeof(struct net_eth_addr)) ||
+		    net_pkt_read_be16(pkt, type)) {
+			return -ENODATA;
+		}
+
+		if (*type == NET_ETH_PTYPE_VLAN &&
+		    (net_pkt_skip(pkt, sizeof(uint16_t)) ||
+		     net_pkt_read_be16(pkt, type))) {
+			return -ENODATA;
+		}
+
+		return 0;
+	}
+#endif
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		uint8_t vhl;
+
+		if (net_pkt_read_u8(pkt, &vhl)) {
+			return -ENODATA;
+		}
+
+		net_pkt_cursor_init(pkt);
+
+		if ((vhl >> 4) == 4) {
+			*type = NET_ETH_PTYPE_IP;
+		} else if ((vhl >> 4) == 6) {
+			*type = NET_ETH_PTYPE_IPV6;
+		} else {
+			return -ENOTSUP;
+		}
+
+		return 0;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+
+	return -ENOTSUP;
+}
+
+/* Fill in the addresses and protocol of the key, and return whether the
+ * packet carries the ports of the flow.
+ */
+static int rss_parse_ip(struct net_pkt *pkt, uint16_t type,
+			struct rss_flow_key *key)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4) && type == NET_ETH_PTYPE_IP) {
+		struct net_ipv4_hdr hdr;
+		uint16_t offset;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(hdr)) ||
+		    (hdr.vhl & 0x0f) < 5 ||
+		    net_pkt_skip(pkt, (hdr.vhl & 0x0f) * 4 - sizeof(hdr))) {
+			return -ENODATA;
+		}
+
+		memcpy(key->src, hdr.src, sizeof(hdr.src));
+		memcpy(key->dst, hdr.dst, sizeof(hdr.dst));
+		key->proto = hdr.proto;
+
+		/* The fragments of a datagram must stay together */
+		offset = (hdr.offset[0] << 8) | hdr.offset[1];
+
+		return (offset & (NET_IPV4_MORE_FRAG_MASK |
+				  NET_IPV4_FRAGH_OFFSET_MASK)) == 0U;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && type == NET_ETH_PTYPE_IPV6) {
+		struct net_ipv6_hdr hdr;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(hdr))) {
+			return -ENODATA;
+		}
+
+		memcpy(key->src, hdr.src, sizeof(hdr.src));
+		memcpy(key->dst, hdr.dst, sizeof(hdr.dst));
+		key->proto = hdr.nexthdr;
+
+		/* Extension headers are not walked, such flows hash by
+		 * their addresses only.
+		 */
+		return 1;
+	}
+
+	return -ENOTSUP;
+}
+
+static uint32_t rss_flow_hash(struct net_pkt *pkt)
+{
+	struct rss_flow_key key;
+	struct net_pkt_cursor backup;
+	uint32_t hash = 0;
+	uint16_t type;
+	int ret;
+
+	/* The padding is hashed too */
+	memset(&key, 0, sizeof(key));
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (rss_skip_l2(pkt, &type) < 0) {
+		goto out;
+	}
+
+	ret = rss_parse_ip(pkt, type, &key);
+	if (ret < 0) {
+		goto out;
+	}
+
+	if (ret > 0 && (key.proto == IPPROTO_TCP || key.proto == IPPROTO_UDP) &&
+	    net_pkt_read(pkt, key.ports, sizeof(key.ports))) {
+		memset(key.ports, 0, sizeof(key.ports));
+	}
+
+	hash = sys_hash32(&key, sizeof(key));
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return hash;
+}
+
+uint8_t net_rx_rss_queue(struct net_pkt *pkt)
+{
+	uint32_t hash = net_pkt_rx_hash(pkt);
+
+	if (hash == 0U) {
+		hash = rss_flow_hash(pkt);
+		net_pkt_set_rx_hash(pkt, hash);
+	}
+
+	return hash % CONFIG_NET_RX_RSS_QUEUES;
+}
@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
 #include <stdlib.h>
 #include <errno.h>
 #include <zephyr/net/net_core.h>
+#include <zephyr/stats/stats.h>
 
 #include "net_stats.h"
 #include "net_private.h"
@@ -27,7 +28,7 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
  * The variable needs to be global so that the GET_STAT() macro can access it
  * from net_shell.c
  */
-struct net_stats net_stats = { 0 };
+struct net_stats net_stats __stats_hot = { 0 };
 
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 
@@ -158,6 +159,10 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("Bytes sent     %u", GET_STAT(iface, bytes.sent));
 		NET_INFO("Processing err %d",
 			 GET_STAT(iface, processing_error));
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+		NET_INFO("RX quota drop  %d",
+			 GET_STAT(iface, rx_quota_drop));
+#endif
 
 #if NET_TC_COUNT > 1
 #if NET_TC_TX_COUNT > 1
@@ -54,6 +54,15 @@ static inline void net_stats_update_bytes_recv(struct net_if *iface,
 	UPDATE_STAT(iface, stats.bytes.received += bytes);
 }
 
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+static inline void net_stats_update_rx_quota_drop(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.rx_quota_drop++);
+}
+#else
+#define net_stats_update_rx_quota_drop(iface)
+#endif
+
 static inline void net_stats_update_bytes_sent(struct net_if *iface,
 					       uint32_t bytes)
 {
@@ -65,6 +74,7 @@ static inline void net_stats_update_bytes_sent(struct net_if *iface,
 #define net_stats_update_ip_errors_vhlerr(iface)
 #define net_stats_update_bytes_recv(iface, bytes)
 #define net_stats_update_bytes_sent(iface, bytes)
+#define net_stats_update_rx_quota_drop(iface)
 #endif /* CONFIG_NET_STATISTICS */
 
 #if defined(CONFIG_NET_STATISTICS_IPV6) && defined(CONFIG_NET_NATIVE_IPV6)
@@ -24,12 +24,25 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
  */
 #define MAX_NAME_LEN sizeof("xx_q[y]")
 
+/* With receive side scaling each RX traffic class has one queue per CPU,
+ * and the RX thread name gets the queue index z as "rx_q[y.z]".
+ */
+#if defined(CONFIG_NET_RX_RSS)
+#define RX_QUEUE_COUNT CONFIG_NET_RX_RSS_QUEUES
+#define RX_NAME_LEN sizeof("rx_q[y.zz]")
+#else
+#define RX_QUEUE_COUNT 1
+#define RX_NAME_LEN MAX_NAME_LEN
+#endif
+
+#define RX_THREAD_COUNT (NET_TC_RX_COUNT * RX_QUEUE_COUNT)
+
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, RX_THREAD_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +50,18 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[RX_THREAD_COUNT];
+
+static struct k_fifo *rx_queue(uint8_t tc, struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_RX_RSS)
+	return &rx_classes[tc * RX_QUEUE_COUNT + net_rx_rss_queue(pkt)].fifo;
+#else
+	ARG_UNUSED(pkt);
+
+	return &rx_classes[tc].fifo;
+#endif
+}
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -65,13 +89,72 @@ void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #if NET_TC_RX_COUNT > 0
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(rx_queue(tc, pkt), pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
 #endif
 }
 
+bool net_tc_submit_list_to_tx_queue(uint8_t tc, sys_slist_t *list)
+{
+#if NET_TC_TX_COUNT > 0
+	sys_snode_t *node;
+
+	/* Packets are linked through their leading fifo word */
+	SYS_SLIST_FOR_EACH_NODE(list, node) {
+		net_pkt_set_tx_stats_tick((struct net_pkt *)node,
+					  k_cycle_get_32());
+	}
+
+	(void)k_fifo_put_slist(&tx_classes[tc].fifo, list);
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(list);
+#endif
+	return true;
+}
+
+void net_tc_submit_list_to_rx_queue(uint8_t tc, sys_slist_t *list)
+{
+#if NET_TC_RX_COUNT > 0 && defined(CONFIG_NET_RX_RSS)
+	sys_slist_t queues[RX_QUEUE_COUNT];
+	sys_snode_t *node;
+
+	/* Keep the burst together per RX queue */
+	for (int i = 0; i < RX_QUEUE_COUNT; i++) {
+		sys_slist_init(&queues[i]);
+	}
+
+	while ((node = sys_slist_get(list)) != NULL) {
+		struct net_pkt *pkt = (struct net_pkt *)node;
+
+		net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+		sys_slist_append(&queues[net_rx_rss_queue(pkt)], node);
+	}
+
+	for (int i = 0; i < RX_QUEUE_COUNT; i++) {
+		if (!sys_slist_is_empty(&queues[i])) {
+			(void)k_fifo_put_slist(
+				&rx_classes[tc * RX_QUEUE_COUNT + i].fifo,
+				&queues[i]);
+		}
+	}
+#elif NET_TC_RX_COUNT > 0
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(list, node) {
+		net_pkt_set_rx_stats_tick((struct net_pkt *)node,
+					  k_cycle_get_32());
+	}
+
+	(void)k_fifo_put_slist(&rx_classes[tc].fifo, list);
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(list);
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -254,7 +337,11 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 			continue;
 		}
 
+#if defined(CONFIG_NET_GRO)
+		net_gro_rx(fifo, pkt);
+#else
 		net_process_rx_packet(pkt);
+#endif
 	}
 }
 #endif
@@ -274,6 +361,16 @@ static void tc_tx_handler(void *p1, void *p2, void *p3)
 			continue;
 		}
 
+#if defined(CONFIG_NET_TX_SCHED)
+		if (!net_tx_sched_wait(pkt)) {
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+			net_pkt_iface(pkt)->tx_pending--;
+#endif
+			net_pkt_unref(pkt);
+			continue;
+		}
+#endif
+
 		net_process_tx_packet(pkt);
 	}
 }
@@ -354,12 +451,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < RX_THREAD_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / RX_QUEUE_COUNT);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -387,12 +484,26 @@ void net_tc_rx_init(void)
 		}
 
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
-			char name[MAX_NAME_LEN];
+			char name[RX_NAME_LEN];
+
+			if (IS_ENABLED(CONFIG_NET_RX_RSS)) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]",
+					 i / RX_QUEUE_COUNT, i % RX_QUEUE_COUNT);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_RX_RSS) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Each queue of a traffic class runs on its own CPU */
+		if (k_thread_cpu_pin(tid, (i % RX_QUEUE_COUNT) %
+				     arch_num_cpus()) < 0) {
+			NET_WARN("Cannot pin RX handler %d to a CPU", i);
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
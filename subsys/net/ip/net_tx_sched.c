@@ -0,0 +1,348 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Software time-aware shaper of the TX traffic classes. The TX thread of
+ * each class holds a packet until its launch time, when the device cannot
+ * launch it at that time itself, and until the gate of the class is open
+ * in the schedule of the interface, when the device has no IEEE 802.1Qbv
+ * support.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_tx_sched, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/ptp_clock.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/ethernet_mgmt.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_tx_sched.h>
+
+#include "net_private.h"
+
+/* Left to poll the clock once a packet is this close to its time */
+#define SPIN_NS (CONFIG_NET_TX_SCHED_SPIN_US * NSEC_PER_USEC)
+
+struct tx_sched_slot {
+	struct net_if *iface;
+	struct net_tx_sched sched;
+};
+
+static struct tx_sched_slot slots[CONFIG_NET_TX_SCHED_MAX_IFACES];
+static struct k_spinlock lock;
+
+static enum ethernet_hw_caps eth_caps(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return net_eth_get_hw_capabilities(iface);
+	}
+#endif
+
+	return (enum ethernet_hw_caps)0;
+}
+
+static uint64_t clock_now(const struct device *clk)
+{
+#if defined(CONFIG_PTP_CLOCK)
+	struct net_ptp_time tm;
+
+	if (clk != NULL && ptp_clock_get(clk, &tm) == 0) {
+		return tm.second * NSEC_PER_SEC + tm.nanosecond;
+	}
+#else
+	ARG_UNUSED(clk);
+#endif
+
+	return k_ticks_to_ns_floor64(k_uptime_ticks());
+}
+
+uint64_t net_tx_sched_time(struct net_if *iface)
+{
+	return clock_now(net_eth_get_ptp_clock(iface));
+}
+
+static void wait_until(const struct device *clk, uint64_t target)
+{
+	uint64_t now = clock_now(clk);
+
+	/* Sleep most of the way, then poll the clock for the last bit */
+	while (now < target) {
+		if (target - now > SPIN_NS) {
+			k_sleep(K_NSEC(target - now - SPIN_NS));
+		}
+
+		now = clock_now(clk);
+	}
+}
+
+static struct tx_sched_slot *find_slot(struct net_if *iface)
+{
+	ARRAY_FOR_EACH(slots, i) {
+		if (slots[i].iface == iface) {
+			return &slots[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* How long the gate stays open from the start of a cycle */
+static uint64_t open_prefix(const struct net_tx_sched *sched, uint8_t tc)
+{
+	uint64_t off = 0;
+
+	for (uint16_t i = 0; i < sched->num_entries; i++) {
+		uint64_t len = sched->cycle_time - off;
+
+		if (i != sched->num_entries - 1U) {
+			len = MIN(len, sched->entries[i].interval);
+		}
+
+		if (len != 0U && !(sched->entries[i].gate_mask & BIT(tc))) {
+			break;
+		}
+
+		off += len;
+	}
+
+	return off;
+}
+
+int64_t net_tx_sched_gate_delay(const struct net_tx_sched *sched, uint8_t tc, uint64_t now)
+{
+	uint16_t n = sched->num_entries;
+	uint64_t start = 0, end = 0, pos, off = 0;
+	bool open = false;
+
+	if (now < sched->base_time) {
+		return 0;
+	}
+
+	pos = (now - sched->base_time) % sched->cycle_time;
+
+	/* Find the first window of the gate in which a frame can start at pos
+	 * or later. Scan two cycles since a window may span the end of one.
+	 */
+	for (uint32_t k = 0; k < 2U * n; k++) {
+		const struct net_tx_sched_entry *entry = &sched->entries[k % n];
+		uint64_t len;
+
+		if (k % n == 0U) {
+			off = (k / n) * (uint64_t)sched->cycle_time;
+		}
+
+		len = (k / n + 1U) * (uint64_t)sched->cycle_time - off;
+		if (k % n != n - 1U) {
+			len = MIN(len, entry->interval);
+		}
+
+		if (len == 0U) {
+			continue;
+		}
+
+		if (entry->gate_mask & BIT(tc)) {
+			if (!open) {
+				start = off;
+				open = true;
+			}
+			end = off + len;
+		} else if (open) {
+			uint64_t at = MAX(start, pos);
+
+			open = false;
+			if (at + sched->guard_band < end) {
+				return at - pos;
+			}
+		}
+
+		off += len;
+	}
+
+	/* Still open at the end of the scan, the window goes on with the
+	 * gate open at the start of the next cycle.
+	 */
+	if (open) {
+		uint64_t at = MAX(start, pos);
+		uint64_t prefix = open_prefix(sched, tc);
+
+		if (prefix == sched->cycle_time || at + sched->guard_band < end + prefix) {
+			return at - pos;
+		}
+	}
+
+	return -1;
+}
+
+bool net_tx_sched_wait(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	uint8_t tc = net_tx_priority2tc(net_pkt_priority(pkt));
+	const struct device *clk = NULL;
+	uint64_t target = 0;
+	k_spinlock_key_t key;
+	bool scheduled;
+
+	if (IS_ENABLED(CONFIG_NET_PKT_TXTIME) && !(eth_caps(iface) & ETHERNET_TXTIME)) {
+		target = net_pkt_txtime(pkt);
+	}
+
+	key = k_spin_lock(&lock);
+	scheduled = find_slot(iface) != NULL;
+	k_spin_unlock(&lock, key);
+
+	if (!scheduled && target == 0U) {
+		return true;
+	}
+
+	clk = net_eth_get_ptp_clock(iface);
+
+	while (true) {
+		uint64_t now = clock_now(clk);
+		uint64_t at = MAX(now, target);
+		struct tx_sched_slot *slot;
+		int64_t delay = 0;
+
+		/* The schedule may change while waiting, check it again */
+		key = k_spin_lock(&lock);
+		slot = find_slot(iface);
+		if (slot != NULL) {
+			delay = net_tx_sched_gate_delay(&slot->sched, tc, at);
+		}
+		k_spin_unlock(&lock, key);
+
+		if (delay < 0) {
+			NET_DBG("Gate of TC %d never opens, dropping %p", tc, pkt);
+			return false;
+		}
+
+		if (at + delay <= now) {
+			return true;
+		}
+
+		wait_until(clk, at + delay);
+	}
+}
+
+#if defined(CONFIG_NET_L2_ETHERNET_MGMT)
+static int qbv_set(struct net_if *iface, struct ethernet_req_params *params)
+{
+	params->qbv_param.port_id = 0;
+	params->qbv_param.state = ETHERNET_QBV_STATE_TYPE_ADMIN;
+
+	return net_mgmt(NET_REQUEST_ETHERNET_SET_QBV_PARAM, iface, params,
+			sizeof(struct ethernet_req_params));
+}
+
+/* Same sequence as the txtime sample: rows, length, times, then status */
+static int offload_sched(struct net_if *iface, const struct net_tx_sched *sched)
+{
+	struct ethernet_req_params params;
+	int ret = 0;
+
+	for (uint16_t row = 0; sched != NULL && row < sched->num_entries; row++) {
+		memset(&params, 0, sizeof(params));
+		params.qbv_param.type = ETHERNET_QBV_PARAM_TYPE_GATE_CONTROL_LIST;
+		params.qbv_param.gate_control.operation = ETHERNET_SET_GATE_STATE;
+		params.qbv_param.gate_control.time_interval = sched->entries[row].interval;
+		params.qbv_param.gate_control.row = row;
+
+		for (int tc = 0; tc < NET_TC_TX_COUNT; tc++) {
+			params.qbv_param.gate_control.gate_status[tc] =
+				(sched->entries[row].gate_mask & BIT(tc)) != 0U;
+		}
+
+		ret = qbv_set(iface, &params);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (sched != NULL) {
+		memset(&params, 0, sizeof(params));
+		params.qbv_param.type = ETHERNET_QBV_PARAM_TYPE_GATE_CONTROL_LIST_LEN;
+		params.qbv_param.gate_control_list_len = sched->num_entries;
+
+		ret = qbv_set(iface, &params);
+		if (ret < 0) {
+			return ret;
+		}
+
+		memset(&params, 0, sizeof(params));
+		params.qbv_param.type = ETHERNET_QBV_PARAM_TYPE_TIME;
+		params.qbv_param.base_time.second = sched->base_time / NSEC_PER_SEC;
+		params.qbv_param.base_time.fract_nsecond = sched->base_time % NSEC_PER_SEC;
+		params.qbv_param.cycle_time.second = sched->cycle_time / NSEC_PER_SEC;
+		params.qbv_param.cycle_time.nanosecond = sched->cycle_time % NSEC_PER_SEC;
+
+		ret = qbv_set(iface, &params);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	memset(&params, 0, sizeof(params));
+	params.qbv_param.type = ETHERNET_QBV_PARAM_TYPE_STATUS;
+	params.qbv_param.enabled = sched != NULL;
+
+	return qbv_set(iface, &params);
+}
+#endif /* CONFIG_NET_L2_ETHERNET_MGMT */
+
+int net_tx_sched_set(struct net_if *iface, const struct net_tx_sched *sched)
+{
+	struct tx_sched_slot *slot;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if (sched != NULL && (sched->num_entries == 0U ||
+			      sched->num_entries > CONFIG_NET_TX_SCHED_MAX_ENTRIES ||
+			      sched->cycle_time == 0U)) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET_MGMT)
+	if (eth_caps(iface) & ETHERNET_QBV) {
+		if (offload_sched(iface, sched) < 0) {
+			NET_DBG("Device of iface %d refused the schedule",
+				net_if_get_by_iface(iface));
+			return -EIO;
+		}
+
+		/* The device does the gating now */
+		sched = NULL;
+	}
+#endif
+
+	key = k_spin_lock(&lock);
+
+	slot = find_slot(iface);
+	if (sched == NULL) {
+		if (slot != NULL) {
+			slot->iface = NULL;
+		}
+		goto out;
+	}
+
+	if (slot == NULL) {
+		slot = find_slot(NULL);
+	}
+
+	if (slot == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	slot->iface = iface;
+	slot->sched = *sched;
+
+out:
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
@@ -267,15 +267,13 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+static struct net_route_entry *route_lookup_linear(struct net_if *iface,
+						  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +296,22 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	if (IS_ENABLED(CONFIG_NET_ROUTE_TRIE)) {
+		found = net_route_trie_lookup(iface, dst);
+	} else {
+		found = route_lookup_linear(iface, dst);
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -308,6 +322,31 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 	return found;
 }
 
+/* Route for exactly the prefix, not the longest match of it */
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  uint8_t prefix_len)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
+		struct net_nbr *nbr = get_nbr(i);
+		struct net_route_entry *route = net_route_data(nbr);
+
+		if (!nbr->ref || nbr->iface != iface) {
+			continue;
+		}
+
+		if (route->prefix_len == prefix_len &&
+		    net_ipv6_is_prefix(addr->s6_addr, route->addr.s6_addr,
+				       prefix_len)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
 static inline bool route_preference_is_lower(uint8_t old, uint8_t new)
 {
 	if (new == NET_ROUTE_PREFERENCE_RESERVED || (new & 0xfc) != 0) {
@@ -361,11 +400,13 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	route = route_find(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
 
+		update_route_access(route);
+
 		nexthop_addr = net_route_get_nexthop(route);
 		if (nexthop_addr && net_ipv6_addr_cmp(nexthop, nexthop_addr)) {
 			NET_DBG("No changes, return old route %p", route);
@@ -442,6 +483,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	if (net_route_trie_add(route) < 0) {
+		/* Keep the route list and the trie in sync */
+		NET_ERR("No route trie node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+#endif
+
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
@@ -588,6 +640,10 @@ int net_route_del(struct net_route_entry *route)
 
 	sys_slist_find_and_remove(&routes, &route->node);
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	net_route_trie_del(route);
+#endif
+
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		net_ipv6_nbr_unlock();
@@ -920,28 +976,16 @@ exit:
 	return ret;
 }
 
-int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
+/* Set the link layer addresses of the packet to reach the neighbor */
+static int route_packet_nbr(struct net_pkt *pkt, struct net_nbr *nbr)
 {
 	struct net_linkaddr_storage *lladdr;
-	struct net_nbr *nbr;
-	int err;
-
-	net_ipv6_nbr_lock();
-
-	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
-	if (!nbr) {
-		NET_DBG("Cannot find %s neighbor",
-			net_sprint_ipv6_addr(nexthop));
-		err = -ENOENT;
-		goto error;
-	}
 
 	lladdr = net_nbr_get_lladdr(nbr->idx);
 	if (!lladdr) {
 		NET_DBG("Cannot find %s neighbor link layer address.",
-			net_sprint_ipv6_addr(nexthop));
-		err = -ESRCH;
-		goto error;
+			net_sprint_ipv6_addr(&net_ipv6_nbr_data(nbr)->addr));
+		return -ESRCH;
 	}
 
 #if defined(CONFIG_NET_L2_DUMMY)
@@ -957,8 +1001,7 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 #endif
 			if (!net_pkt_lladdr_src(pkt)->addr) {
 				NET_DBG("Link layer source address not set");
-				err = -EINVAL;
-				goto error;
+				return -EINVAL;
 			}
 
 			/* Sanitycheck: If src and dst ll addresses are going
@@ -968,8 +1011,7 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 			if (!memcmp(net_pkt_lladdr_src(pkt)->addr, lladdr->addr,
 				    lladdr->len)) {
 				NET_ERR("Src ll and Dst ll are same");
-				err = -EINVAL;
-				goto error;
+				return -EINVAL;
 			}
 #if defined(CONFIG_NET_L2_PPP)
 		}
@@ -993,6 +1035,147 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 
 	net_pkt_set_iface(pkt, nbr->iface);
 
+	return 0;
+}
+
+#if defined(CONFIG_NET_ROUTE_FWD_CACHE)
+/* Forwarding decision of a flow, protected by the IPv6 neighbor lock */
+struct route_fwd_entry {
+	struct net_if *iface;
+	struct net_nbr *nbr;
+	struct in6_addr src;
+	struct in6_addr dst;
+	struct in6_addr nexthop;
+};
+
+static struct route_fwd_entry fwd_cache[CONFIG_NET_ROUTE_FWD_CACHE_SIZE];
+static struct net_mgmt_event_callback fwd_cache_cb;
+
+#define FWD_CACHE_EVENTS (NET_EVENT_IPV6_ROUTE_ADD |	\
+			  NET_EVENT_IPV6_ROUTE_DEL |	\
+			  NET_EVENT_IPV6_ROUTER_ADD |	\
+			  NET_EVENT_IPV6_ROUTER_DEL |	\
+			  NET_EVENT_IPV6_NBR_ADD |	\
+			  NET_EVENT_IPV6_NBR_DEL)
+
+static struct route_fwd_entry *fwd_cache_slot(struct net_if *iface,
+					      const uint8_t *src,
+					      const uint8_t *dst)
+{
+	uint32_t hash = POINTER_TO_UINT(iface);
+	int i;
+
+	for (i = 0; i < NET_IPV6_ADDR_SIZE; i += sizeof(uint32_t)) {
+		hash = hash * 31U + UNALIGNED_GET((uint32_t *)&src[i]);
+		hash = hash * 31U + UNALIGNED_GET((uint32_t *)&dst[i]);
+	}
+
+	return &fwd_cache[hash % CONFIG_NET_ROUTE_FWD_CACHE_SIZE];
+}
+
+static void fwd_cache_add(struct net_pkt *pkt, struct in6_addr *nexthop,
+			  struct net_nbr *nbr)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+	struct route_fwd_entry *entry;
+
+	entry = fwd_cache_slot(net_pkt_orig_iface(pkt), hdr->src, hdr->dst);
+
+	entry->iface = net_pkt_orig_iface(pkt);
+	entry->nbr = nbr;
+	net_ipv6_addr_copy_raw(entry->src.s6_addr, hdr->src);
+	net_ipv6_addr_copy_raw(entry->dst.s6_addr, hdr->dst);
+	net_ipaddr_copy(&entry->nexthop, nexthop);
+}
+
+int net_route_fwd_cache_packet(struct net_pkt *pkt, struct net_ipv6_hdr *hdr)
+{
+	struct route_fwd_entry *entry;
+	int err = -ENOENT;
+
+	net_ipv6_nbr_lock();
+
+	entry = fwd_cache_slot(net_pkt_iface(pkt), hdr->src, hdr->dst);
+
+	if (entry->nbr == NULL || entry->iface != net_pkt_iface(pkt) ||
+	    !net_ipv6_addr_cmp_raw(entry->src.s6_addr, hdr->src) ||
+	    !net_ipv6_addr_cmp_raw(entry->dst.s6_addr, hdr->dst)) {
+		goto out;
+	}
+
+	/* The flush is done from the management thread, so the neighbor
+	 * might have been released or reused meanwhile.
+	 */
+	if (entry->nbr->ref == 0U ||
+	    !net_ipv6_addr_cmp(&net_ipv6_nbr_data(entry->nbr)->addr,
+			       &entry->nexthop)) {
+		entry->nbr = NULL;
+		goto out;
+	}
+
+	net_pkt_set_orig_iface(pkt, net_pkt_iface(pkt));
+
+	err = route_packet_nbr(pkt, entry->nbr);
+	if (err < 0) {
+		entry->nbr = NULL;
+		err = -ENOENT;
+		goto out;
+	}
+
+	net_ipv6_nbr_unlock();
+
+	return net_send_data(pkt);
+
+out:
+	net_ipv6_nbr_unlock();
+	return err;
+}
+
+static void fwd_cache_flush(struct net_mgmt_event_callback *cb,
+			    uint32_t mgmt_event, struct net_if *iface)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(mgmt_event);
+	ARG_UNUSED(iface);
+
+	net_ipv6_nbr_lock();
+	memset(fwd_cache, 0, sizeof(fwd_cache));
+	net_ipv6_nbr_unlock();
+}
+
+static void fwd_cache_init(void)
+{
+	net_mgmt_init_event_callback(&fwd_cache_cb, fwd_cache_flush,
+				     FWD_CACHE_EVENTS);
+	net_mgmt_add_event_callback(&fwd_cache_cb);
+}
+#else
+#define fwd_cache_add(...)
+#define fwd_cache_init(...)
+#endif /* CONFIG_NET_ROUTE_FWD_CACHE */
+
+int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
+{
+	struct net_nbr *nbr;
+	int err;
+
+	net_ipv6_nbr_lock();
+
+	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
+	if (!nbr) {
+		NET_DBG("Cannot find %s neighbor",
+			net_sprint_ipv6_addr(nexthop));
+		err = -ENOENT;
+		goto error;
+	}
+
+	err = route_packet_nbr(pkt, nbr);
+	if (err < 0) {
+		goto error;
+	}
+
+	fwd_cache_add(pkt, nexthop, nbr);
+
 	net_ipv6_nbr_unlock();
 	return net_send_data(pkt);
 
@@ -1028,4 +1211,6 @@ void net_route_init(void)
 		CONFIG_NET_MAX_NEXTHOPS, sizeof(net_route_nexthop_pool));
 
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
+
+	fwd_cache_init();
 }
@@ -55,6 +55,11 @@ struct net_route_entry {
 	/** Network interface for the route. */
 	struct net_if *iface;
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	/** Routes with the same prefix in the lookup trie. */
+	sys_snode_t trie_node;
+#endif
+
 	/** Route lifetime timer. */
 	struct net_timeout lifetime;
 
@@ -76,6 +81,14 @@ struct net_route_entry {
 #define NET_ROUTE_PREFERENCE_LOW      0x03 /* -1 if treated as 2 bit signed int */
 #define NET_ROUTE_PREFERENCE_RESERVED 0x02
 
+/* Index of the route table for the longest prefix match, called with the
+ * IPv6 neighbor lock held.
+ */
+int net_route_trie_add(struct net_route_entry *route);
+void net_route_trie_del(struct net_route_entry *route);
+struct net_route_entry *net_route_trie_lookup(struct net_if *iface,
+					      struct in6_addr *dst);
+
 /**
  * @brief Lookup route to a given destination.
  *
@@ -303,6 +316,28 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+/**
+ * @brief Forward the network packet using the cached decision of its flow.
+ *
+ * @param pkt Network packet to send.
+ * @param hdr IPv6 header of the packet.
+ *
+ * @return 0 if the packet was sent, -ENOENT if the flow is not cached,
+ * other <0 value if the packet could not be sent.
+ */
+#if defined(CONFIG_NET_ROUTE_FWD_CACHE)
+int net_route_fwd_cache_packet(struct net_pkt *pkt, struct net_ipv6_hdr *hdr);
+#else
+static inline int net_route_fwd_cache_packet(struct net_pkt *pkt,
+					     struct net_ipv6_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return -ENOENT;
+}
+#endif
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
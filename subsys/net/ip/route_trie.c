@@ -0,0 +1,271 @@
+/** @file
+ * @brief Route lookup trie.
+ *
+ * A path compressed binary trie over the route prefixes, so that the
+ * longest prefix match of a destination visits at most one node per
+ * distinct prefix length on its path instead of every route. The trie is
+ * protected by the IPv6 neighbor lock like the route table itself.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <zephyr/sys/slist.h>
+
+#include <zephyr/net/net_ip.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+struct route_trie_node {
+	struct route_trie_node *parent;
+	struct route_trie_node *child[2];
+
+	/** Routes for exactly this prefix, one per interface. Empty for
+	 * the nodes that only branch.
+	 */
+	sys_slist_t routes;
+
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+	bool in_use;
+};
+
+/* Every distinct prefix needs one node and at most one branching node */
+static struct route_trie_node trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *trie_root;
+
+static inline int addr_bit(const struct in6_addr *addr, uint8_t bit)
+{
+	return (addr->s6_addr[bit / 8] >> (7 - (bit % 8))) & 0x01;
+}
+
+static uint8_t common_prefix_len(const struct in6_addr *a,
+				 const struct in6_addr *b, uint8_t max_len)
+{
+	uint8_t len = 0U;
+	int i;
+
+	for (i = 0; i < sizeof(a->s6_addr) && len < max_len; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff == 0U) {
+			len += 8U;
+			continue;
+		}
+
+		while ((diff & 0x80) == 0U) {
+			diff <<= 1;
+			len++;
+		}
+
+		break;
+	}
+
+	return MIN(len, max_len);
+}
+
+static void prefix_copy(struct in6_addr *dst, const struct in6_addr *src,
+			uint8_t prefix_len)
+{
+	uint8_t bytes = prefix_len / 8;
+
+	memset(dst, 0, sizeof(*dst));
+	memcpy(dst->s6_addr, src->s6_addr, bytes);
+
+	if (prefix_len % 8) {
+		dst->s6_addr[bytes] = src->s6_addr[bytes] &
+				      (uint8_t)(0xff << (8 - (prefix_len % 8)));
+	}
+}
+
+static struct route_trie_node *node_alloc(const struct in6_addr *prefix,
+					  uint8_t prefix_len)
+{
+	ARRAY_FOR_EACH_PTR(trie_nodes, node) {
+		if (node->in_use) {
+			continue;
+		}
+
+		memset(node, 0, sizeof(*node));
+		node->in_use = true;
+		node->prefix_len = prefix_len;
+		prefix_copy(&node->prefix, prefix, prefix_len);
+		sys_slist_init(&node->routes);
+
+		return node;
+	}
+
+	return NULL;
+}
+
+static void node_replace(struct route_trie_node *node,
+			 struct route_trie_node *with)
+{
+	struct route_trie_node *parent = node->parent;
+
+	if (with != NULL) {
+		with->parent = parent;
+	}
+
+	if (parent == NULL) {
+		trie_root = with;
+	} else {
+		parent->child[parent->child[1] == node] = with;
+	}
+}
+
+static void node_link(struct route_trie_node *parent,
+		      struct route_trie_node *child)
+{
+	parent->child[addr_bit(&child->prefix, parent->prefix_len)] = child;
+	child->parent = parent;
+}
+
+/* Find the node of the prefix, creating it if needed */
+static struct route_trie_node *node_get(const struct in6_addr *prefix,
+					uint8_t prefix_len)
+{
+	struct route_trie_node *parent = NULL;
+	struct route_trie_node *node = trie_root;
+	struct route_trie_node *branch, *leaf;
+	uint8_t common;
+
+	while (node != NULL) {
+		common = common_prefix_len(prefix, &node->prefix,
+					   MIN(prefix_len, node->prefix_len));
+
+		if (common < node->prefix_len) {
+			break;
+		}
+
+		if (prefix_len == node->prefix_len) {
+			return node;
+		}
+
+		parent = node;
+		node = node->child[addr_bit(prefix, node->prefix_len)];
+	}
+
+	leaf = node_alloc(prefix, prefix_len);
+	if (leaf == NULL) {
+		return NULL;
+	}
+
+	if (node == NULL) {
+		if (parent == NULL) {
+			trie_root = leaf;
+		} else {
+			node_link(parent, leaf);
+		}
+
+		return leaf;
+	}
+
+	if (common == prefix_len) {
+		/* The new prefix covers the node */
+		node_replace(node, leaf);
+		node_link(leaf, node);
+
+		return leaf;
+	}
+
+	/* The prefixes diverge after the common bits */
+	branch = node_alloc(prefix, common);
+	if (branch == NULL) {
+		leaf->in_use = false;
+		return NULL;
+	}
+
+	node_replace(node, branch);
+	node_link(branch, node);
+	node_link(branch, leaf);
+
+	return leaf;
+}
+
+/* Drop nodes that neither hold routes nor branch */
+static void node_prune(struct route_trie_node *node)
+{
+	while (node != NULL && sys_slist_is_empty(&node->routes)) {
+		struct route_trie_node *parent = node->parent;
+
+		if (node->child[0] != NULL && node->child[1] != NULL) {
+			break;
+		}
+
+		node_replace(node, node->child[0] != NULL ?
+			     node->child[0] : node->child[1]);
+		node->in_use = false;
+
+		node = parent;
+	}
+}
+
+int net_route_trie_add(struct net_route_entry *route)
+{
+	struct route_trie_node *node;
+
+	node = node_get(&route->addr, route->prefix_len);
+	if (node == NULL) {
+		return -ENOMEM;
+	}
+
+	sys_slist_append(&node->routes, &route->trie_node);
+
+	return 0;
+}
+
+void net_route_trie_del(struct net_route_entry *route)
+{
+	struct route_trie_node *node = trie_root;
+
+	while (node != NULL && node->prefix_len <= route->prefix_len) {
+		if (sys_slist_find_and_remove(&node->routes,
+					      &route->trie_node)) {
+			node_prune(node);
+			return;
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[addr_bit(&route->addr, node->prefix_len)];
+	}
+}
+
+struct net_route_entry *net_route_trie_lookup(struct net_if *iface,
+					      struct in6_addr *dst)
+{
+	struct route_trie_node *node = trie_root;
+	struct net_route_entry *found = NULL;
+	struct net_route_entry *route;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[addr_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
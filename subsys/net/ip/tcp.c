@@ -64,10 +64,6 @@ static int tcp_tx_window =
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
-
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
@@ -470,29 +466,117 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+TCP_CA_REGISTER(reno, tcp_new_reno_init, tcp_new_reno_fast_retransmit,
+		tcp_new_reno_timeout, tcp_new_reno_dup_ack,
+		tcp_new_reno_pkts_acked);
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strlen(ops->name) == len && strncmp(ops->name, name, len) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+static const struct tcp_ca_ops *tcp_ca_default(void)
+{
+	static const struct tcp_ca_ops *ops;
+
+	if (ops == NULL) {
+		ops = tcp_ca_find(CONFIG_NET_TCP_CONGESTION_DEFAULT_NAME,
+				  sizeof(CONFIG_NET_TCP_CONGESTION_DEFAULT_NAME) - 1);
+		if (ops == NULL) {
+			ops = &TCP_CA_GET_NAME(reno);
+		}
+	}
+
+	return ops;
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.rtt = 0;
+	conn->ca.rtt_pending = false;
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca.ops->pkts_acked(conn, acked_len);
+}
+
+/* Time one segment per round trip. Retransmitted data gives no sample as
+ * the ACK may be for either transmission (Karn's algorithm).
+ */
+static void tcp_ca_sent(struct tcp *conn, uint32_t seq, uint32_t len,
+			bool resend)
+{
+	if (resend) {
+		conn->ca.rtt_pending = false;
+	} else if (!conn->ca.rtt_pending) {
+		conn->ca.rtt_seq = seq + len;
+		conn->ca.rtt_start = k_uptime_get_32();
+		conn->ca.rtt_pending = true;
+	}
+}
+
+static void tcp_ca_rtt_update(struct tcp *conn, uint32_t ack)
+{
+	if (conn->ca.rtt_pending && net_tcp_seq_cmp(ack, conn->ca.rtt_seq) >= 0) {
+		conn->ca.rtt = MAX(k_uptime_get_32() - conn->ca.rtt_start, 1);
+		conn->ca.rtt_pending = false;
+	}
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	ops = tcp_ca_find(value, strnlen(value, len));
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	conn->ca.ops = ops;
+
+	/* Otherwise the state is set up when the connection is established */
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		tcp_ca_init(conn);
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name) + 1;
+
+	if (len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, name_len);
+	memcpy(value, conn->ca.ops->name, *len);
+
+	return 0;
 }
 #else
 
@@ -506,6 +590,20 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_sent(struct tcp *conn, uint32_t seq, uint32_t len,
+			bool resend) { }
+
+static void tcp_ca_rtt_update(struct tcp *conn, uint32_t ack) { }
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	return -ENOPROTOOPT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	return -ENOPROTOOPT;
+}
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -1041,7 +1139,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1051,8 +1149,16 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* Options negotiated in the handshake are only sent with SYN */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_cnt = 0;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1101,6 +1207,35 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = syn;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    (opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_cnt < NET_TCP_SACK_MAX_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_cnt++];
+
+				block->left = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				block->right = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+			}
+
+			NET_DBG("SACK blocks=%hu", (uint16_t)recv_options->sack_cnt);
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1274,6 +1409,82 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static bool tcp_sack_enabled(struct tcp *conn)
+{
+	return conn->recv_options.sack_perm_found;
+}
+
+/* SACK permitted goes in our SYN, and in the SYN-ACK if the peer sent it */
+static bool tcp_sack_perm_send(struct tcp *conn, uint8_t flags)
+{
+	return (flags & SYN) && (!(flags & ACK) || tcp_sack_enabled(conn));
+}
+
+/* The receive queue holds one contiguous range of out-of-order data, which
+ * is reported as a single block.
+ */
+static bool tcp_sack_block_send(struct tcp *conn, uint8_t flags)
+{
+	return !(flags & SYN) && (flags & ACK) && tcp_sack_enabled(conn) &&
+	       conn->queue_recv_data != NULL &&
+	       !net_pkt_is_empty(conn->queue_recv_data);
+}
+
+static size_t tcp_sack_opts_len(struct tcp *conn, uint8_t flags)
+{
+	if (tcp_sack_perm_send(conn, flags)) {
+		return 2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (tcp_sack_block_send(conn, flags)) {
+		return 2 * NET_TCP_NOP_SIZE + 2 + NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return 0;
+}
+
+static int tcp_sack_opts_add(struct tcp *conn, struct net_pkt *pkt,
+			     uint8_t flags)
+{
+	uint8_t opts[2 * NET_TCP_NOP_SIZE + 2 + NET_TCP_SACK_BLOCK_SIZE] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+	};
+	uint32_t left, right;
+
+	if (tcp_sack_perm_send(conn, flags)) {
+		opts[2] = NET_TCP_SACK_PERM_OPT;
+		opts[3] = NET_TCP_SACK_PERM_SIZE;
+
+		return net_pkt_write(pkt, opts, 4);
+	}
+
+	if (!tcp_sack_block_send(conn, flags)) {
+		return 0;
+	}
+
+	left = tcp_get_seq(conn->queue_recv_data->buffer);
+	right = left + net_pkt_get_len(conn->queue_recv_data);
+
+	opts[2] = NET_TCP_SACK_OPT;
+	opts[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+	UNALIGNED_PUT(htonl(left), (uint32_t *)&opts[4]);
+	UNALIGNED_PUT(htonl(right), (uint32_t *)&opts[8]);
+
+	return net_pkt_write(pkt, opts, sizeof(opts));
+}
+#else
+static bool tcp_sack_enabled(struct tcp *conn) { return false; }
+
+static size_t tcp_sack_opts_len(struct tcp *conn, uint8_t flags) { return 0; }
+
+static int tcp_sack_opts_add(struct tcp *conn, struct net_pkt *pkt,
+			     uint8_t flags)
+{
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 			  uint32_t seq)
 {
@@ -1295,6 +1506,8 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 		th->th_off++;
 	}
 
+	th->th_off += tcp_sack_opts_len(conn, flags) / 4;
+
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
@@ -1485,6 +1698,8 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		alloc_len += sizeof(uint32_t);
 	}
 
+	alloc_len += tcp_sack_opts_len(conn, flags);
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1492,6 +1707,12 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) &&
+		    net_pkt_get_len(data) > conn_mss(conn)) {
+			/* Leave the segmentation to L2 or the device */
+			net_pkt_set_gso_size(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1517,6 +1738,12 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	ret = tcp_sack_opts_add(conn, pkt, flags);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1581,11 +1808,13 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
-static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
+/* Make room for len more bytes at the end of pkt, return the first buffer
+ * to write them to.
+ */
+static struct net_buf *tcp_pkt_extend(struct net_pkt *pkt, size_t len)
 {
 	size_t alloc_len = len;
 	struct net_buf *buf = NULL;
-	int ret = 0;
 
 	if (pkt->buffer) {
 		buf = net_buf_frag_last(pkt->buffer);
@@ -1598,10 +1827,9 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 	}
 
 	if (alloc_len > 0) {
-		ret = net_pkt_alloc_buffer_raw(pkt, alloc_len,
-					       TCP_PKT_ALLOC_TIMEOUT);
-		if (ret < 0) {
-			return -ENOBUFS;
+		if (net_pkt_alloc_buffer_raw(pkt, alloc_len,
+					     TCP_PKT_ALLOC_TIMEOUT) < 0) {
+			return NULL;
 		}
 	}
 
@@ -1609,6 +1837,18 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 		buf = pkt->buffer;
 	}
 
+	return buf;
+}
+
+static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
+{
+	struct net_buf *buf;
+
+	buf = tcp_pkt_extend(pkt, len);
+	if (buf == NULL) {
+		return -ENOBUFS;
+	}
+
 	while (buf != NULL && len > 0) {
 		size_t write_len = MIN(len, net_buf_tailroom(buf));
 
@@ -1621,7 +1861,51 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 
 	NET_ASSERT(len == 0, "Not all bytes written");
 
-	return ret;
+	return 0;
+}
+
+/* Like tcp_pkt_append(), but let the data source write straight into the
+ * packet buffers. Returns the number of bytes appended, which is less than
+ * len if the source ran short.
+ */
+static int tcp_pkt_append_fill(struct net_pkt *pkt, size_t len,
+			       net_tcp_fill_cb_t fill, void *user_data)
+{
+	struct net_buf *buf;
+	size_t appended = 0;
+	int ret = 0;
+
+	buf = tcp_pkt_extend(pkt, len);
+	if (buf == NULL) {
+		return -ENOBUFS;
+	}
+
+	while (buf != NULL && appended < len) {
+		size_t fill_len = MIN(len - appended, net_buf_tailroom(buf));
+
+		if (fill_len > 0) {
+			ret = fill(net_buf_tail(buf), fill_len, user_data);
+			if (ret < 0) {
+				break;
+			}
+
+			net_buf_add(buf, ret);
+			appended += ret;
+
+			if (ret < fill_len) {
+				break;
+			}
+		}
+
+		buf = buf->frags;
+	}
+
+	if (appended < len) {
+		/* Do not keep the buffers that were allocated for nothing */
+		net_pkt_trim_buffer(pkt);
+	}
+
+	return appended > 0 ? appended : ret;
 }
 
 static bool tcp_window_full(struct tcp *conn)
@@ -1668,42 +1952,461 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Largest amount of data to send in one packet. With segmentation offload,
+ * an Ethernet interface takes several segments at once.
+ */
+static uint16_t conn_tx_size(struct tcp *conn)
 {
-	int ret = 0;
-	int len;
-	struct net_pkt *pkt;
+	uint16_t mss = conn_mss(conn);
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
+#if defined(CONFIG_NET_TCP_GSO)
+	if (conn->iface != NULL &&
+	    net_if_l2(conn->iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return MAX(mss, ROUND_DOWN(CONFIG_NET_TCP_GSO_MAX_SIZE, mss));
 	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+#endif
+
+	return mss;
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Minimum tail loss probe timeout and the delayed ACK time of the peer
+ * assumed when only one segment is in flight (RFC 8985 ch. 7.2)
+ */
+#define TLP_MIN_TIMEOUT_MS 10
+#define TLP_MAX_ACK_DELAY_MS 200
+
+#define time_after(_a, _b) ((int32_t)((_a) - (_b)) > 0)
+
+/* Highest sequence number sent so far */
+static uint32_t tcp_sack_snd_max(struct tcp *conn)
+{
+	struct tcp_sack *sack = &conn->sack;
+
+	if (sack->seg_cnt == 0) {
+		return conn->seq + conn->unacked_len;
+	}
+
+	return sack->segs[sack->seg_cnt - 1].end;
+}
+
+static uint32_t tcp_sack_board_bytes(struct tcp *conn, uint32_t from)
+{
+	struct tcp_sack *sack = &conn->sack;
+	uint32_t bytes = 0;
+
+	for (int i = 0; i < sack->board_cnt; i++) {
+		struct tcp_sack_block *block = &sack->board[i];
+
+		if (net_tcp_seq_cmp(block->right, from) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block->left, from) < 0) {
+			bytes += block->right - from;
+		} else {
+			bytes += block->right - block->left;
+		}
 	}
 
+	return bytes;
+}
+
+/* Return the scoreboard block holding seq, if any */
+static struct tcp_sack_block *tcp_sack_board_find(struct tcp *conn,
+						  uint32_t seq)
+{
+	struct tcp_sack *sack = &conn->sack;
+
+	for (int i = 0; i < sack->board_cnt; i++) {
+		if (net_tcp_seq_cmp(seq, sack->board[i].left) >= 0 &&
+		    net_tcp_seq_cmp(seq, sack->board[i].right) < 0) {
+			return &sack->board[i];
+		}
+	}
+
+	return NULL;
+}
+
+static bool tcp_sack_covered(struct tcp *conn, uint32_t seq, uint32_t end)
+{
+	struct tcp_sack_block *block = tcp_sack_board_find(conn, seq);
+
+	return block != NULL && net_tcp_seq_cmp(end, block->right) <= 0;
+}
+
+static void tcp_sack_board_remove(struct tcp *conn, int i)
+{
+	struct tcp_sack *sack = &conn->sack;
+
+	sack->board_cnt--;
+	memmove(&sack->board[i], &sack->board[i + 1],
+		(sack->board_cnt - i) * sizeof(sack->board[0]));
+}
+
+/* Insert a block keeping the board sorted and the blocks disjoint. If the
+ * board is full, the highest block is forgotten.
+ */
+static void tcp_sack_board_add(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack *sack = &conn->sack;
+	int i;
+
+	for (i = 0; i < sack->board_cnt; i++) {
+		if (net_tcp_seq_cmp(left, sack->board[i].right) <= 0) {
+			break;
+		}
+	}
+
+	if (i < sack->board_cnt &&
+	    net_tcp_seq_cmp(right, sack->board[i].left) >= 0) {
+		/* Overlaps or touches block i, grow it */
+		struct tcp_sack_block *block = &sack->board[i];
+
+		if (net_tcp_seq_cmp(left, block->left) < 0) {
+			block->left = left;
+		}
+
+		if (net_tcp_seq_cmp(right, block->right) > 0) {
+			block->right = right;
+		}
+
+		while (i + 1 < sack->board_cnt &&
+		       net_tcp_seq_cmp(block->right, sack->board[i + 1].left) >= 0) {
+			if (net_tcp_seq_cmp(sack->board[i + 1].right,
+					    block->right) > 0) {
+				block->right = sack->board[i + 1].right;
+			}
+
+			tcp_sack_board_remove(conn, i + 1);
+		}
+
+		return;
+	}
+
+	if (sack->board_cnt == ARRAY_SIZE(sack->board)) {
+		if (i == sack->board_cnt) {
+			return;
+		}
+
+		sack->board_cnt--;
+	}
+
+	memmove(&sack->board[i + 1], &sack->board[i],
+		(sack->board_cnt - i) * sizeof(sack->board[0]));
+	sack->board[i].left = left;
+	sack->board[i].right = right;
+	sack->board_cnt++;
+}
+
+/* Record a transmission of [seq, seq + len) */
+static void tcp_sack_sent(struct tcp *conn, uint32_t seq, uint32_t len)
+{
+	struct tcp_sack *sack = &conn->sack;
+	uint32_t now = k_uptime_get_32();
+	uint32_t snd_max = tcp_sack_snd_max(conn);
+	uint32_t end = seq + len;
+	struct tcp_tx_seg *seg;
+
+	if (!tcp_sack_enabled(conn)) {
+		return;
+	}
+
+	for (int i = 0; i < sack->seg_cnt; i++) {
+		seg = &sack->segs[i];
+
+		if (net_tcp_seq_cmp(seg->end, seq) <= 0 ||
+		    net_tcp_seq_cmp(seg->seq, end) >= 0) {
+			continue;
+		}
+
+		seg->xmit_time = now;
+		seg->rexmit = true;
+		seg->lost = false;
+	}
+
+	if (sack->seg_cnt == 0) {
+		/* Nothing outstanding, the new data starts here */
+		snd_max = seq;
+	}
+
+	if (net_tcp_seq_cmp(end, snd_max) <= 0) {
+		return;
+	}
+
+	if (sack->seg_cnt == ARRAY_SIZE(sack->segs)) {
+		/* Merging into the newer record only delays loss detection */
+		sack->segs[1].seq = sack->segs[0].seq;
+		sack->segs[1].rexmit |= sack->segs[0].rexmit;
+		sack->segs[1].lost &= sack->segs[0].lost;
+		sack->segs[1].sacked &= sack->segs[0].sacked;
+		sack->seg_cnt--;
+		memmove(&sack->segs[0], &sack->segs[1],
+			sack->seg_cnt * sizeof(sack->segs[0]));
+	}
+
+	seg = &sack->segs[sack->seg_cnt++];
+	seg->seq = net_tcp_seq_cmp(seq, snd_max) < 0 ? snd_max : seq;
+	seg->end = end;
+	seg->xmit_time = now;
+	seg->rexmit = false;
+	seg->lost = false;
+	seg->sacked = false;
+}
+
+/* Limit a transmission at offset from the start of the send queue so that it
+ * does not resend data the peer already has. Returns the offset to send from.
+ */
+static int tcp_sack_skip(struct tcp *conn, int offset, int *len)
+{
+	struct tcp_sack_block *block;
+	uint32_t seq = conn->seq + offset;
+
+	block = tcp_sack_board_find(conn, seq);
+	if (block != NULL) {
+		offset += block->right - seq;
+		seq = block->right;
+	}
+
+	for (int i = 0; i < conn->sack.board_cnt; i++) {
+		block = &conn->sack.board[i];
+
+		if (net_tcp_seq_cmp(block->left, seq) > 0) {
+			*len = MIN(*len, (int)(block->left - seq));
+			break;
+		}
+	}
+
+	return offset;
+}
+
+static void tcp_rack_update(struct tcp *conn, struct tcp_tx_seg *seg,
+			    uint32_t now)
+{
+	struct tcp_sack *sack = &conn->sack;
+	uint32_t rtt = now - seg->xmit_time;
+
+	/* A retransmitted segment may have been delivered by its first
+	 * transmission, only trust it if it could not have been.
+	 */
+	if (seg->rexmit && rtt < sack->min_rtt) {
+		return;
+	}
+
+	sack->rack_rtt = rtt;
+
+	if (!seg->rexmit) {
+		if (sack->srtt == 0) {
+			sack->srtt = rtt;
+			sack->min_rtt = rtt;
+		} else {
+			sack->srtt = (7 * sack->srtt + rtt) / 8;
+			sack->min_rtt = MIN(sack->min_rtt, rtt);
+		}
+	}
+
+	if (time_after(seg->xmit_time, sack->rack_xmit_time) ||
+	    (seg->xmit_time == sack->rack_xmit_time &&
+	     net_tcp_seq_cmp(seg->end, sack->rack_end) > 0)) {
+		sack->rack_xmit_time = seg->xmit_time;
+		sack->rack_end = seg->end;
+	}
+}
+
+/* A segment is lost if one sent after it has been delivered at least a
+ * reordering window earlier (RACK), or if three segments worth of data above
+ * it has been selectively acknowledged (RFC 6675).
+ */
+static bool tcp_rack_is_lost(struct tcp *conn, struct tcp_tx_seg *seg,
+			     uint32_t now)
+{
+	struct tcp_sack *sack = &conn->sack;
+	uint32_t reo_wnd = sack->min_rtt / 4;
+
+	if (time_after(sack->rack_xmit_time, seg->xmit_time) ||
+	    (sack->rack_xmit_time == seg->xmit_time &&
+	     net_tcp_seq_cmp(sack->rack_end, seg->end) > 0)) {
+		if (now - seg->xmit_time >= sack->rack_rtt + reo_wnd) {
+			return true;
+		}
+	}
+
+	return tcp_sack_board_bytes(conn, seg->end) >=
+		DUPLICATE_ACK_RETRANSMIT_TRHESHOLD * conn_mss(conn);
+}
+
+/* Update the scoreboard and the loss state from a received ACK, before the
+ * acknowledged data is removed from the send queue.
+ */
+static void tcp_sack_ack(struct tcp *conn, struct tcphdr *th)
+{
+	struct tcp_sack *sack = &conn->sack;
+	uint32_t snd_max = tcp_sack_snd_max(conn);
+	uint32_t now = k_uptime_get_32();
+	uint32_t ack = th_ack(th);
+	uint32_t sacked;
+	uint32_t delivered;
+	bool lost = false;
+
+	if (!tcp_sack_enabled(conn)) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(ack, conn->seq) < 0 ||
+	    net_tcp_seq_cmp(ack, snd_max) > 0) {
+		ack = conn->seq;
+	}
+
+	delivered = ack - conn->seq;
+
+	for (int i = 0; i < sack->board_cnt; ) {
+		struct tcp_sack_block *block = &sack->board[i];
+
+		if (net_tcp_seq_cmp(block->right, ack) <= 0) {
+			tcp_sack_board_remove(conn, i);
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block->left, ack) < 0) {
+			block->left = ack;
+		}
+
+		i++;
+	}
+
+	sacked = tcp_sack_board_bytes(conn, ack);
+
+	for (int i = 0; i < conn->recv_options.sack_cnt; i++) {
+		struct tcp_sack_block *block = &conn->recv_options.sack[i];
+
+		/* Ignore blocks for data not sent or already acknowledged */
+		if (net_tcp_seq_cmp(block->left, ack) < 0 ||
+		    net_tcp_seq_cmp(block->right, snd_max) > 0 ||
+		    net_tcp_seq_cmp(block->left, block->right) >= 0) {
+			continue;
+		}
+
+		tcp_sack_board_add(conn, block->left, block->right);
+	}
+
+	/* Blocks forgotten on a full board can make the total shrink */
+	sacked = tcp_sack_board_bytes(conn, ack) - MIN(sacked,
+		 tcp_sack_board_bytes(conn, ack));
+	delivered += sacked;
+
+	for (int i = 0; i < sack->seg_cnt; ) {
+		struct tcp_tx_seg *seg = &sack->segs[i];
+
+		if (net_tcp_seq_cmp(seg->end, ack) <= 0) {
+			tcp_rack_update(conn, seg, now);
+			sack->seg_cnt--;
+			memmove(seg, seg + 1,
+				(sack->seg_cnt - i) * sizeof(*seg));
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(seg->seq, ack) < 0) {
+			seg->seq = ack;
+		}
+
+		if (!seg->sacked && tcp_sack_covered(conn, seg->seq, seg->end)) {
+			seg->sacked = true;
+			tcp_rack_update(conn, seg, now);
+		}
+
+		i++;
+	}
+
+	for (int i = 0; i < sack->seg_cnt; i++) {
+		struct tcp_tx_seg *seg = &sack->segs[i];
+
+		if (!seg->lost && !seg->sacked) {
+			seg->lost = tcp_rack_is_lost(conn, seg, now);
+		}
+
+		lost |= seg->lost;
+	}
+
+	if (sack->in_recovery) {
+		if (net_tcp_seq_cmp(ack, sack->recovery_point) >= 0) {
+			NET_DBG("conn: %p recovery done", conn);
+			sack->in_recovery = false;
+			sack->rexmit_quota = 0;
+		} else {
+			sack->rexmit_quota += delivered;
+		}
+	} else if (lost) {
+		NET_DBG("conn: %p enter recovery, una %u max %u", conn,
+			conn->seq, snd_max);
+		sack->in_recovery = true;
+		sack->recovery_point = snd_max;
+		sack->rexmit_quota = conn_mss(conn);
+		tcp_ca_fast_retransmit(conn);
+	}
+
+	if (ack == conn->seq && delivered > 0) {
+		/* SACK carrying duplicate ACK */
+		tcp_ca_dup_ack(conn);
+	}
+}
+
+/* The retransmission timer expired: the go-back-N resend skips the data the
+ * peer reported. A second timeout in a row may mean the peer has dropped the
+ * out-of-order data, so the scoreboard is no longer trusted.
+ */
+static void tcp_sack_timeout(struct tcp *conn)
+{
+	struct tcp_sack *sack = &conn->sack;
+
+	sack->in_recovery = false;
+	sack->tlp_pending = false;
+	sack->rexmit_quota = 0;
+
+	if (conn->send_data_retries > 0) {
+		sack->board_cnt = 0;
+
+		for (int i = 0; i < sack->seg_cnt; i++) {
+			sack->segs[i].sacked = false;
+		}
+	}
+}
+#else
+static void tcp_sack_sent(struct tcp *conn, uint32_t seq, uint32_t len) { }
+
+static int tcp_sack_skip(struct tcp *conn, int offset, int *len)
+{
+	return offset;
+}
+
+static void tcp_sack_ack(struct tcp *conn, struct tcphdr *th) { }
+
+static void tcp_sack_timeout(struct tcp *conn) { }
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Send len bytes starting at offset from the start of the send queue */
+static int tcp_send_segment(struct tcp *conn, int offset, int len, bool resend)
+{
+	struct net_pkt *pkt;
+	int ret;
+
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
+		tcp_sack_sent(conn, conn->seq + offset, len);
+		tcp_ca_sent(conn, conn->seq + offset, len, resend);
 
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -1718,12 +2421,161 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int offset;
+	int len;
+
+	len = MIN(tcp_unsent_len(conn), conn_tx_size(conn));
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+
+	offset = tcp_sack_skip(conn, conn->unacked_len, &len);
+	if (offset != conn->unacked_len) {
+		/* The peer already has the data up to offset */
+		conn->unacked_len = offset;
+		len = MIN(len, tcp_unsent_len(conn));
+	}
+
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, offset, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Resend the missing parts of the segments marked lost, as long as the data
+ * delivered since the recovery started allows.
+ */
+static void tcp_sack_recover(struct tcp *conn)
+{
+	struct tcp_sack *sack = &conn->sack;
+
+	if (!sack->in_recovery || conn->data_mode == TCP_DATA_MODE_RESEND) {
+		return;
+	}
+
+	for (int i = 0; i < sack->seg_cnt && sack->rexmit_quota > 0; i++) {
+		struct tcp_tx_seg *seg = &sack->segs[i];
+		uint32_t end = seg->end;
+		int offset = seg->seq - conn->seq;
+
+		if (!seg->lost) {
+			continue;
+		}
+
+		while (net_tcp_seq_cmp(conn->seq + offset, end) < 0 &&
+		       sack->rexmit_quota > 0) {
+			int len = MIN(end - (conn->seq + offset), conn_mss(conn));
+
+			offset = tcp_sack_skip(conn, offset, &len);
+			if (net_tcp_seq_cmp(conn->seq + offset, end) >= 0) {
+				break;
+			}
+
+			len = MIN(len, (int)(end - (conn->seq + offset)));
+
+			NET_DBG("conn: %p resend %u len %d", conn,
+				conn->seq + offset, len);
+
+			if (tcp_send_segment(conn, offset, len, true) < 0) {
+				return;
+			}
+
+			sack->rexmit_quota -= len;
+			offset += len;
+		}
+	}
+}
+
+static void tcp_sack_arm_tlp(struct tcp *conn)
+{
+	struct tcp_sack *sack = &conn->sack;
+	uint32_t pto;
+
+	sack->tlp_pending = false;
+
+	if (!tcp_sack_enabled(conn) || sack->in_recovery || sack->srtt == 0 ||
+	    conn->unacked_len == 0 || conn->data_mode == TCP_DATA_MODE_RESEND) {
+		return;
+	}
+
+	pto = MAX(2 * sack->srtt, TLP_MIN_TIMEOUT_MS);
+	if (conn->unacked_len <= conn_mss(conn)) {
+		pto += TLP_MAX_ACK_DELAY_MS;
+	}
+
+	/* Only worth it if the probe goes out before the retransmission */
+	if (pto >= TCP_RTO_MS) {
+		return;
+	}
+
+	sack->tlp_pending = true;
+	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
+				    K_MSEC(pto));
+}
+
+/* Send a tail loss probe if one is due: new data if the window allows, or
+ * else the last segment again. An ACK for it then triggers the normal SACK
+ * based recovery instead of waiting for the retransmission timer.
+ */
+static bool tcp_sack_tlp(struct tcp *conn)
+{
+	struct tcp_sack *sack = &conn->sack;
+	int len;
+
+	if (!sack->tlp_pending) {
+		return false;
+	}
+
+	sack->tlp_pending = false;
+
+	if (tcp_unsent_len(conn) > 0) {
+		len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+		if (tcp_send_segment(conn, conn->unacked_len, len, false) == 0) {
+			conn->unacked_len += len;
+		}
+	} else if (conn->unacked_len > 0) {
+		len = MIN(conn->unacked_len, conn_mss(conn));
+		(void)tcp_send_segment(conn, conn->unacked_len - len, len, true);
+	}
+
+	NET_DBG("conn: %p tail loss probe", conn);
+
+	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
+				    K_MSEC(TCP_RTO_MS));
+
+	return true;
+}
+#else
+static void tcp_sack_recover(struct tcp *conn) { }
+
+static void tcp_sack_arm_tlp(struct tcp *conn) { }
+
+static bool tcp_sack_tlp(struct tcp *conn)
+{
+	return false;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1767,6 +2619,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 		conn->send_data_retries = 0;
 		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
 					    K_MSEC(TCP_RTO_MS));
+		tcp_sack_arm_tlp(conn);
 	}
  out:
 	return ret;
@@ -1801,6 +2654,10 @@ static void tcp_resend_data(struct k_work *work)
 
 	NET_DBG("send_data_retries=%hu", conn->send_data_retries);
 
+	if (tcp_sack_tlp(conn)) {
+		goto out;
+	}
+
 	if (conn->send_data_retries >= tcp_retries) {
 		NET_DBG("conn: %p close, data retransmissions exceeded", conn);
 		conn_unref = true;
@@ -1815,6 +2672,8 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
+	tcp_sack_timeout(conn);
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -2070,6 +2929,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.ops = tcp_ca_default();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2783,7 +3643,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
@@ -2872,6 +3733,9 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+				conn->ca.ops = conn->accepted_conn->ca.ops;
+#endif
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3048,8 +3912,14 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th) {
+			tcp_sack_ack(conn, th);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
-		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
+		/* With SACK, losses are detected from the scoreboard */
+		if (th && !tcp_sack_enabled(conn) &&
+		    (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
 			if (conn->send_data_total > 0) {
 				/* There could be also payload, only without payload account them */
@@ -3112,6 +3982,7 @@ next_state:
 			/* New segment, reset duplicate ack counter */
 			conn->dup_ack_cnt = 0;
 #endif
+			tcp_ca_rtt_update(conn, th_ack(th));
 			tcp_ca_pkts_acked(conn, len_acked);
 
 			conn->send_data_total -= len_acked;
@@ -3175,8 +4046,12 @@ next_state:
 			if (tcp_window_full(conn)) {
 				(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 			}
+
+			tcp_sack_arm_tlp(conn);
 		}
 
+		tcp_sack_recover(conn);
+
 		if (th) {
 			if (th_seq(th) == conn->ack) {
 				if (len > 0) {
@@ -3620,6 +4495,32 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return ret;
 }
 
+/* Account for queued_len bytes appended to conn->send_data and try to send
+ * them, with conn->lock held.
+ */
+static int tcp_queue_commit(struct tcp *conn, size_t queued_len)
+{
+	int ret;
+
+	conn->send_data_total += queued_len;
+
+	/* Successfully queued data for transmission. Even if there's a transmit
+	 * failure now (out-of-buf case), it can be ignored for now, retransmit
+	 * timer will take care of queued data retransmission.
+	 */
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_conn_close(conn, ret);
+		return ret;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	return queued_len;
+}
+
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		  const struct msghdr *msg)
 {
@@ -3688,23 +4589,38 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		queued_len = len;
 	}
 
-	conn->send_data_total += queued_len;
+	ret = tcp_queue_commit(conn, queued_len);
+out:
+	k_mutex_unlock(&conn->lock);
 
-	/* Successfully queued data for transmission. Even if there's a transmit
-	 * failure now (out-of-buf case), it can be ignored for now, retransmit
-	 * timer will take care of queued data retransmission.
-	 */
-	ret = tcp_send_queued_data(conn);
-	if (ret < 0 && ret != -ENOBUFS) {
-		tcp_conn_close(conn, ret);
-		goto out;
+	return ret;
+}
+
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t fill, void *user_data)
+{
+	struct tcp *conn = context->tcp;
+	int ret;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
 	}
 
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
 	if (tcp_window_full(conn)) {
-		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+		ret = -EAGAIN;
+		goto out;
 	}
 
-	ret = queued_len;
+	len = MIN(conn->send_win - conn->send_data_total, len);
+
+	ret = tcp_pkt_append_fill(conn->send_data, len, fill, user_data);
+	if (ret <= 0) {
+		goto out;
+	}
+
+	ret = tcp_queue_commit(conn, ret);
 out:
 	k_mutex_unlock(&conn->lock);
 
@@ -3982,7 +4898,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) || force_chksum) {
+	/* A packet to be segmented gets its checksums per segment */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	     net_pkt_gso_size(pkt) == 0U) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4358,6 +5276,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4395,6 +5316,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
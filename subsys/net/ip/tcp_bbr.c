@@ -0,0 +1,223 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* BBR congestion control, a model based on the bottleneck bandwidth and the
+ * round trip propagation time. The stack does not pace its output, so the
+ * pacing gains of the BBR state machine are applied to the congestion window.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include "tcp_internal.h"
+
+enum bbr_state {
+	BBR_STARTUP,
+	BBR_DRAIN,
+	BBR_PROBE_BW,
+	BBR_PROBE_RTT,
+};
+
+/* Gains are in 1/1000 */
+#define BBR_GAIN_UNIT 1000
+#define BBR_HIGH_GAIN 2885
+#define BBR_CYCLE_LEN 8
+/* The bandwidth has not grown by 25% in 3 rounds, the pipe is full */
+#define BBR_FULL_BW_THRESH 1250
+#define BBR_FULL_BW_CNT 3
+#define BBR_MIN_RTT_WIN_MS 10000
+#define BBR_PROBE_RTT_MS 200
+#define BBR_MIN_CWND_SEGS 4
+
+static const uint16_t bbr_cycle_gain[BBR_CYCLE_LEN] = {
+	1250, 750, 1000, 1000, 1000, 1000, 1000, 1000
+};
+
+static uint32_t bbr_bw(struct tcp_ca_bbr *bbr)
+{
+	uint32_t bw = 0;
+
+	ARRAY_FOR_EACH(bbr->btl_bw, i) {
+		bw = MAX(bw, bbr->btl_bw[i]);
+	}
+
+	return bw;
+}
+
+static void bbr_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, state=%d, bw=%u, min_rtt=%u",
+		conn, step, conn->ca.cwnd, conn->ca.bbr.state,
+		bbr_bw(&conn->ca.bbr), conn->ca.bbr.min_rtt);
+}
+
+static uint32_t bbr_min_cwnd(struct tcp *conn)
+{
+	return BBR_MIN_CWND_SEGS * conn_mss(conn);
+}
+
+static void bbr_start_round(struct tcp *conn, uint32_t now)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	bbr->round_start = now;
+	bbr->round_end_seq = conn->seq + conn->unacked_len;
+	bbr->round_delivered = 0;
+}
+
+static void bbr_init(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+
+	memset(bbr, 0, sizeof(*bbr));
+	bbr->min_rtt = UINT32_MAX;
+	bbr->min_rtt_stamp = now;
+	bbr->state = BBR_STARTUP;
+	bbr_start_round(conn, now);
+
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = UINT16_MAX;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	bbr_log(conn, "init");
+}
+
+/* A round trip ended, take a delivery rate sample */
+static void bbr_end_round(struct tcp *conn, uint32_t now)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t elapsed = MAX(now - bbr->round_start, 1);
+	uint32_t bw;
+
+	bbr->round++;
+	bbr->btl_bw[bbr->round % ARRAY_SIZE(bbr->btl_bw)] =
+		(uint64_t)bbr->round_delivered * MSEC_PER_SEC / elapsed;
+
+	bw = bbr_bw(bbr);
+
+	if (bbr->state == BBR_STARTUP) {
+		if ((uint64_t)bw * BBR_GAIN_UNIT >=
+		    (uint64_t)bbr->full_bw * BBR_FULL_BW_THRESH) {
+			bbr->full_bw = bw;
+			bbr->full_bw_cnt = 0;
+		} else if (++bbr->full_bw_cnt >= BBR_FULL_BW_CNT) {
+			bbr->state = BBR_DRAIN;
+		}
+	} else if (bbr->state == BBR_PROBE_BW) {
+		bbr->cycle_idx = (bbr->cycle_idx + 1) % BBR_CYCLE_LEN;
+	}
+
+	bbr_start_round(conn, now);
+}
+
+static void bbr_update_min_rtt(struct tcp *conn, uint32_t now)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	bool expired = (now - bbr->min_rtt_stamp) > BBR_MIN_RTT_WIN_MS;
+
+	if (conn->ca.rtt != 0 && (conn->ca.rtt <= bbr->min_rtt || expired)) {
+		bbr->min_rtt = conn->ca.rtt;
+		bbr->min_rtt_stamp = now;
+	} else if (expired && bbr->state != BBR_PROBE_RTT) {
+		/* Drain the queue to measure the propagation delay again */
+		bbr->state = BBR_PROBE_RTT;
+		bbr->probe_rtt_done = now + BBR_PROBE_RTT_MS;
+	}
+
+	if (bbr->state == BBR_PROBE_RTT &&
+	    (int32_t)(now - bbr->probe_rtt_done) >= 0) {
+		bbr->min_rtt_stamp = now;
+		bbr->state = bbr->full_bw_cnt >= BBR_FULL_BW_CNT ?
+			BBR_PROBE_BW : BBR_STARTUP;
+	}
+}
+
+static uint32_t bbr_target_cwnd(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t gain;
+	uint64_t bdp;
+
+	switch (bbr->state) {
+	case BBR_STARTUP:
+		gain = BBR_HIGH_GAIN;
+		break;
+	case BBR_PROBE_BW:
+		gain = bbr_cycle_gain[bbr->cycle_idx];
+		break;
+	case BBR_PROBE_RTT:
+		return bbr_min_cwnd(conn);
+	default:
+		gain = BBR_GAIN_UNIT;
+		break;
+	}
+
+	bdp = (uint64_t)bbr_bw(bbr) * bbr->min_rtt / MSEC_PER_SEC;
+
+	return MAX(bdp * gain / BBR_GAIN_UNIT, bbr_min_cwnd(conn));
+}
+
+static void bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+
+	bbr->round_delivered += acked_len;
+
+	if (net_tcp_seq_cmp(conn->seq + acked_len, bbr->round_end_seq) >= 0) {
+		bbr_end_round(conn, now);
+	}
+
+	bbr_update_min_rtt(conn, now);
+
+	if (bbr->min_rtt == UINT32_MAX || bbr_bw(bbr) == 0) {
+		/* No model yet, grow like slow start */
+		cwnd += acked_len;
+	} else {
+		target = bbr_target_cwnd(conn);
+
+		if (bbr->state == BBR_DRAIN && conn->unacked_len <= target) {
+			bbr->state = BBR_PROBE_BW;
+			bbr->cycle_idx = 0;
+		}
+
+		if (bbr->state == BBR_STARTUP) {
+			if (cwnd < target) {
+				cwnd += acked_len;
+			}
+		} else {
+			cwnd = MIN(cwnd + acked_len, target);
+		}
+	}
+
+	conn->ca.cwnd = CLAMP(cwnd, bbr_min_cwnd(conn), UINT16_MAX);
+	bbr_log(conn, "pkts_acked");
+}
+
+/* Isolated losses are not a congestion signal for the model */
+static void bbr_fast_retransmit(struct tcp *conn)
+{
+	bbr_log(conn, "fast_retransmit");
+}
+
+static void bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void bbr_timeout(struct tcp *conn)
+{
+	conn->ca.cwnd = bbr_min_cwnd(conn);
+	bbr_start_round(conn, k_uptime_get_32());
+	bbr_log(conn, "timeout");
+}
+
+TCP_CA_REGISTER(bbr, bbr_init, bbr_fast_retransmit, bbr_timeout,
+		bbr_dup_ack, bbr_pkts_acked);
@@ -0,0 +1,176 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, implementation according to RFC9438 */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include "tcp_internal.h"
+
+/* beta_cubic = 0.7 and C = 0.4, as fractions */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+/* Reno friendly additive increase, alpha_cubic = 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_ALPHA_NUM 9
+#define CUBIC_ALPHA_DEN 17
+/* K in ms is cbrt((w_max - cwnd) / mss / C * 10^9) */
+#define CUBIC_K_SCALE 2500000000ULL
+/* Limit t - K so that the cube of it times the window fits in 64 bits */
+#define CUBIC_MAX_DELTA_MS 60000
+
+static uint32_t cubic_cbrt(uint64_t val)
+{
+	uint64_t res = 0;
+
+	for (int shift = 63; shift >= 0; shift -= 3) {
+		uint64_t bit;
+
+		res <<= 1;
+		bit = 3 * res * (res + 1) + 1;
+
+		if ((val >> shift) >= bit) {
+			val -= bit << shift;
+			res++;
+		}
+	}
+
+	return (uint32_t)res;
+}
+
+static void cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, w_max=%u, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+static void cubic_set_cwnd(struct tcp *conn, uint32_t cwnd)
+{
+	conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+}
+
+static void cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+
+	/* Fast convergence, release bandwidth for new flows */
+	if (cwnd < cubic->w_max) {
+		cubic->w_max = cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			       (2 * CUBIC_BETA_DEN);
+	} else {
+		cubic->w_max = cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN,
+				2 * conn_mss(conn));
+	cubic->epoch_start = 0;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = UINT16_MAX;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.cubic.epoch_start = 0;
+	conn->ca.cubic.w_max = 0;
+	cubic_log(conn, "init");
+}
+
+static void cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		cubic_reduce(conn);
+		/* Account for the lost segments */
+		cubic_set_cwnd(conn, conn_mss(conn) * 3 + conn->ca.ssthresh);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void cubic_timeout(struct tcp *conn)
+{
+	cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	cubic_log(conn, "timeout");
+}
+
+static void cubic_dup_ack(struct tcp *conn)
+{
+	cubic_set_cwnd(conn, conn->ca.cwnd + conn_mss(conn));
+	cubic_log(conn, "dup_ack");
+}
+
+static void cubic_avoid(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	uint32_t target;
+	int64_t delta;
+	int64_t offs;
+
+	if (cubic->epoch_start == 0) {
+		cubic->epoch_start = MAX(now, 1);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			cubic->k = cubic_cbrt((cubic->w_max - cwnd) *
+					      CUBIC_K_SCALE / mss);
+		} else {
+			cubic->k = 0;
+			cubic->w_max = cwnd;
+		}
+	}
+
+	/* Window one RTT from now: W(t) = C * (t - K)^3 + w_max */
+	delta = (int64_t)(now - cubic->epoch_start) + conn->ca.rtt - cubic->k;
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+	offs = delta * delta * delta * 4 * mss / 10000000000LL;
+	target = CLAMP((int64_t)cubic->w_max + offs, cwnd, 3 * cwnd / 2);
+
+	/* Reno friendly region */
+	cubic->w_est += DIV_ROUND_UP(CUBIC_ALPHA_NUM * mss * MIN(acked_len, mss),
+				     CUBIC_ALPHA_DEN * cwnd);
+	cubic->w_est = MIN(cubic->w_est, UINT16_MAX);
+
+	if (cubic->w_est > target) {
+		target = cubic->w_est;
+	}
+
+	if (target > cwnd) {
+		cwnd += DIV_ROUND_UP((target - cwnd) * MIN(acked_len, mss), cwnd);
+	}
+
+	cubic_set_cwnd(conn, cwnd);
+}
+
+static void cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd -= MIN(acked_len, conn->ca.cwnd - conn_mss(conn));
+		}
+	} else if (conn->ca.cwnd < conn->ca.ssthresh) {
+		cubic_set_cwnd(conn, conn->ca.cwnd + MIN(acked_len, conn_mss(conn)));
+	} else {
+		cubic_avoid(conn, acked_len);
+	}
+
+	cubic_log(conn, "pkts_acked");
+}
+
+TCP_CA_REGISTER(cubic, cubic_init, cubic_fast_retransmit, cubic_timeout,
+		cubic_dup_ack, cubic_pkts_acked);
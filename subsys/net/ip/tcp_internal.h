@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -312,6 +313,50 @@ static inline int net_tcp_queue(struct net_context *context, const void *data,
 }
 #endif
 
+/**
+ * @brief Data source for net_tcp_queue_fill()
+ *
+ * @param dst		Where to write the data
+ * @param len		Number of bytes wanted
+ * @param user_data	User data given to net_tcp_queue_fill()
+ *
+ * @return Number of bytes written, less than len at the end of the
+ * data, < 0 if error
+ */
+typedef int (*net_tcp_fill_cb_t)(void *dst, size_t len, void *user_data);
+
+/**
+ * @brief Enqueue data for transmission, produced directly into the
+ * send buffers
+ *
+ * Same as net_tcp_queue(), but the data is written into the connection
+ * send buffers by the fill callback, so a source such as a file or flash
+ * does not need an intermediate buffer.
+ *
+ * @param context	Network context
+ * @param len		Maximum number of bytes
+ * @param fill		Callback producing the data, called with the
+ *			connection locked
+ * @param user_data	User data for the callback
+ *
+ * @return Number of bytes queued, 0 if the source had no data, < 0 if error
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t fill, void *user_data);
+#else
+static inline int net_tcp_queue_fill(struct net_context *context, size_t len,
+				     net_tcp_fill_cb_t fill, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(len);
+	ARG_UNUSED(fill);
+	ARG_UNUSED(user_data);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
@@ -227,26 +227,155 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* At most this many SACK blocks fit in the 40 bytes of option space */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Blocks of the last received SACK option */
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_cnt;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+};
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Transmission record used for RACK loss detection, one per sent segment */
+struct tcp_tx_seg {
+	uint32_t seq;
+	uint32_t end;
+	uint32_t xmit_time;
+	bool rexmit : 1;
+	bool lost : 1;
+	bool sacked : 1;
 };
 
+struct tcp_sack {
+	/* Sorted ranges above the cumulative ACK the peer has reported */
+	struct tcp_sack_block board[CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE];
+	struct tcp_tx_seg segs[CONFIG_NET_TCP_SACK_TX_SEGMENTS];
+	/* Highest sent sequence when loss recovery was entered */
+	uint32_t recovery_point;
+	/* Send time and end of the most recently sent segment delivered */
+	uint32_t rack_xmit_time;
+	uint32_t rack_end;
+	uint32_t rack_rtt;
+	uint32_t min_rtt;
+	uint32_t srtt;
+	/* Retransmission allowance, grows with the data delivered */
+	int32_t rexmit_quota;
+	uint8_t board_cnt;
+	uint8_t seg_cnt;
+	bool in_recovery : 1;
+	bool tlp_pending : 1;
+};
+#endif
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
+/* Define the number of MSS sections the congestion window is initialized at */
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+struct tcp;
+
+/* Congestion control algorithm. The hooks are called with the connection
+ * locked and only change the state in conn->ca.
+ */
+struct tcp_ca_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	/* New data acknowledged, conn->ca.rtt has the latest RTT sample */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#define TCP_CA_GET_NAME(ca_name) _CONCAT(tcp_ca_ops_, ca_name)
+
+#define TCP_CA_REGISTER(ca_name, init_func, fast_retransmit_func,	\
+			timeout_func, dup_ack_func, pkts_acked_func)	\
+	static const STRUCT_SECTION_ITERABLE(tcp_ca_ops,		\
+				      TCP_CA_GET_NAME(ca_name)) = {	\
+		.name = STRINGIFY(ca_name),				\
+		.init = init_func,					\
+		.fast_retransmit = fast_retransmit_func,		\
+		.timeout = timeout_func,				\
+		.dup_ack = dup_ack_func,				\
+		.pkts_acked = pkts_acked_func,				\
+	}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+struct tcp_ca_cubic {
+	/* Start of the current congestion avoidance epoch, 0 if none */
+	uint32_t epoch_start;
+	/* Window before the last reduction, in bytes */
+	uint32_t w_max;
+	/* Time to get back to w_max, in ms */
+	uint32_t k;
+	/* Estimate of the window New Reno would have, in bytes */
+	uint32_t w_est;
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+struct tcp_ca_bbr {
+	/* Windowed maximum of the delivery rate, in bytes per second */
+	uint32_t btl_bw[3];
+	uint32_t min_rtt;
+	uint32_t min_rtt_stamp;
+	uint32_t probe_rtt_done;
+	uint32_t round_start;
+	uint32_t round_end_seq;
+	uint32_t round_delivered;
+	uint32_t full_bw;
+	uint8_t round;
+	uint8_t state;
+	uint8_t cycle_idx;
+	uint8_t full_bw_cnt;
+};
+#endif
+
 struct tcp_collision_avoidance_reno {
+	const struct tcp_ca_ops *ops;
 	uint16_t cwnd;
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
+	/* Latest RTT sample in ms, taken from one segment per round trip */
+	uint32_t rtt;
+	uint32_t rtt_seq;
+	uint32_t rtt_start;
+	bool rtt_pending;
+	union {
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		struct tcp_ca_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+		struct tcp_ca_bbr bbr;
+#endif
+		uint8_t dummy;
+	};
 };
 #endif
 
@@ -323,6 +452,9 @@ struct tcp { /* TCP connection */
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 	struct tcp_collision_avoidance_reno ca;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack sack;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -26,6 +26,17 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/socketcan.h>
 
+#if defined(CONFIG_X86_64) && defined(CONFIG_X86_SSE2)
+#include <emmintrin.h>
+#define CHKSUM_WORDS_SSE2
+#elif defined(CONFIG_ARMV8_1_M_MVEI) && defined(CONFIG_FPU) && \
+	defined(CONFIG_FPU_SHARING) && defined(__ARM_FEATURE_MVE)
+#include <arm_mve.h>
+#define CHKSUM_WORDS_MVE
+#elif defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+#define CHKSUM_WORDS_ADC
+#endif
+
 char *net_sprint_addr(sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -533,6 +544,108 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+/* Sum of the aligned 32-bit words, folded to 16 bits by the caller. The
+ * SIMD variants use the vector registers, so they are only picked where
+ * those are saved for every thread.
+ */
+#if defined(CHKSUM_WORDS_SSE2)
+static inline uint64_t chksum_words(const uint32_t *p, size_t words)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc = zero;
+	uint64_t lanes[2];
+	size_t i = 0;
+
+	/* Widen the words to 64-bit lanes so that no carry is lost */
+	for (; i + 4 <= words; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *)&p[i]);
+
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, zero));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, zero));
+	}
+
+	_mm_storeu_si128((__m128i *)lanes, acc);
+	lanes[0] += lanes[1];
+
+	for (; i < words; i++) {
+		lanes[0] += p[i];
+	}
+
+	return lanes[0];
+}
+#elif defined(CHKSUM_WORDS_MVE)
+static inline uint64_t chksum_words(const uint32_t *p, size_t words)
+{
+	uint64_t sum = 0;
+	size_t i = 0;
+
+	for (; i + 4 <= words; i += 4) {
+		sum = vaddlvaq_u32(sum, vld1q_u32(&p[i]));
+	}
+
+	for (; i < words; i++) {
+		sum += p[i];
+	}
+
+	return sum;
+}
+#elif defined(CHKSUM_WORDS_ADC)
+static inline uint64_t chksum_words(const uint32_t *p, size_t words)
+{
+	uint32_t sum = 0;
+	size_t i = 0;
+
+	/* Add with end around carry, one instruction per word. The 32-bit
+	 * one's complement sum folds to the same 16-bit one.
+	 */
+	for (; i + 4 <= words; i += 4) {
+		__asm__ ("adds %0, %0, %1\n\t"
+			 "adcs %0, %0, %2\n\t"
+			 "adcs %0, %0, %3\n\t"
+			 "adcs %0, %0, %4\n\t"
+			 "adc %0, %0, #0"
+			 : "+r" (sum)
+			 : "r" (p[i]), "r" (p[i + 1]), "r" (p[i + 2]),
+			   "r" (p[i + 3])
+			 : "cc");
+	}
+
+	for (; i < words; i++) {
+		sum += p[i];
+		if (sum < p[i]) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+#else
+static inline uint64_t chksum_words(const uint32_t *p, size_t words)
+{
+	uint64_t sum = 0;
+	size_t i = 0;
+
+	/* Do loop unrolling for the very large data sets */
+	while (words >= 4) {
+		uint64_t sum_a = p[i];
+		uint64_t sum_b = p[i + 1];
+
+		words -= 4;
+		sum_a += p[i + 2];
+		sum_b += p[i + 3];
+		i += 4;
+		sum += sum_a + sum_b;
+	}
+
+	while (words > 0) {
+		words--;
+		sum += p[i++];
+	}
+
+	return sum;
+}
+#endif
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -544,7 +657,6 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
 	uint64_t sum;
 	uint32_t *p;
-	size_t i = 0;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
 
@@ -570,22 +682,10 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 	p = (uint32_t *)data;
 
-	/* Do loop unrolling for the very large data sets */
-	while (pending >= sizeof(uint32_t) * 4) {
-		uint64_t sum_a = p[i];
-		uint64_t sum_b = p[i + 1];
+	sum += chksum_words(p, pending / sizeof(uint32_t));
+	data = (uint8_t *)(p + pending / sizeof(uint32_t));
+	pending %= sizeof(uint32_t);
 
-		pending -= sizeof(uint32_t) * 4;
-		sum_a += p[i + 2];
-		sum_b += p[i + 3];
-		i += 4;
-		sum += sum_a + sum_b;
-	}
-	while (pending >= sizeof(uint32_t)) {
-		pending -= sizeof(uint32_t);
-		sum = sum + p[i++];
-	}
-	data = (uint8_t *)(p + i);
 	if (pending >= 2) {
 		pending -= sizeof(uint16_t);
 		sum = sum + *((uint16_t *)data);
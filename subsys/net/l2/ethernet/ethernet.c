@@ -25,6 +25,7 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "arp.h"
 #include "eth_stats.h"
 #include "net_private.h"
+#include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
 #include "bridge.h"
@@ -599,6 +600,173 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* TCP FIN and PSH flags, set only on the last segment */
+#define GSO_TCP_LAST_SEG_FLAGS (BIT(0) | BIT(3))
+
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt);
+
+static void gso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tci(seg, net_pkt_vlan_tci(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_timestamp(seg, net_pkt_timestamp(pkt));
+	net_pkt_set_tcp_1st_msg(seg, net_pkt_tcp_1st_msg(pkt));
+
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_hdr_prev(seg, net_pkt_ipv6_hdr_prev(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+/* Build one segment from the headers of pkt and len bytes of its TCP
+ * payload starting at offset.
+ */
+static struct net_pkt *gso_build_segment(struct net_if *iface,
+					 struct net_pkt *pkt,
+					 size_t ip_hdr_len, size_t hdr_len,
+					 size_t offset, size_t len, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+	int ret;
+
+	seg = net_pkt_alloc_on_iface(iface, NET_BUF_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	if (net_pkt_alloc_buffer_raw(seg, hdr_len + len, NET_BUF_TIMEOUT)) {
+		goto fail;
+	}
+
+	gso_copy_attributes(seg, pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) || net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, ip_hdr_len)) {
+		goto fail;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		goto fail;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+
+	if (!last) {
+		tcp_hdr->flags &= ~GSO_TCP_LAST_SEG_FLAGS;
+	}
+
+	net_pkt_set_data(seg, &tcp_access);
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		ret = net_ipv4_finalize(seg, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+/* Software fallback for devices without ETHERNET_HW_TX_TSO: split a TCP
+ * packet carrying several segments and send each of them.
+ */
+static int ethernet_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t payload_len;
+	size_t hdr_len;
+	int sent = 0;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_hdr_len)) {
+		return -EINVAL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_hdr_len + (tcp_hdr->offset >> 4) * 4U;
+	if (hdr_len > net_pkt_get_len(pkt)) {
+		return -EINVAL;
+	}
+
+	payload_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (size_t offset = 0; offset < payload_len; offset += mss) {
+		size_t len = MIN(mss, payload_len - offset);
+		struct net_pkt *seg;
+
+		seg = gso_build_segment(iface, pkt, ip_hdr_len, hdr_len, offset,
+					len, offset + len == payload_len);
+		if (!seg) {
+			/* TCP resends whatever did not make it */
+			NET_DBG("Cannot build segment at %zu/%zu", offset,
+				payload_len);
+			return -ENOBUFS;
+		}
+
+		ret = ethernet_send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			return ret;
+		}
+
+		sent += ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->api;
@@ -612,6 +780,13 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		goto error;
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_pkt_gso_size(pkt) > 0U &&
+	    !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TX_TSO)) {
+		return ethernet_gso_send(iface, pkt);
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_NET_ETHERNET_BRIDGE) &&
 	    net_pkt_is_l2_bridged(pkt)) {
 		net_pkt_cursor_init(pkt);
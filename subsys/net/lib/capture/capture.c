@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
 #include <zephyr/net/virtual_mgmt.h>
 #include <zephyr/net/capture.h>
 #include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_pkt_filter.h>
 
 #include "net_private.h"
 #include "ipv4.h"
@@ -49,6 +50,26 @@ NET_BUF_POOL_VAR_DEFINE(capture_bufs, CONFIG_NET_CAPTURE_BUF_COUNT,
 
 static sys_slist_t net_capture_devlist;
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+#if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
+/* Lowest priority cooperative thread */
+#define THREAD_PRIORITY K_PRIO_COOP(CONFIG_NUM_COOP_PRIORITIES - 1)
+#else
+#define THREAD_PRIORITY K_PRIO_PREEMPT(CONFIG_NUM_PREEMPT_PRIORITIES - 1)
+#endif
+
+struct net_capture;
+
+/* A captured packet waiting in the ring to be sent */
+struct capture_slot {
+	struct net_capture *ctx;
+	struct net_pkt *pkt;
+};
+
+K_MSGQ_DEFINE(capture_ring, sizeof(struct capture_slot),
+	      CONFIG_NET_CAPTURE_RING_SIZE, sizeof(void *));
+#endif /* CONFIG_NET_CAPTURE_RING */
+
 struct net_capture {
 	sys_snode_t node;
 
@@ -82,6 +103,26 @@ struct net_capture {
 	 */
 	struct sockaddr local;
 
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+	/**
+	 * Rules selecting the packets to capture, NULL for all packets.
+	 */
+	struct npf_rule_list *filter;
+#endif
+
+	/**
+	 * Number of bytes captured from each packet, 0 for all.
+	 */
+	size_t snaplen;
+
+	/**
+	 * Number of packets captured, skipped by the filter, and dropped
+	 * for lack of buffers or ring space.
+	 */
+	uint32_t captured;
+	uint32_t filtered;
+	uint32_t dropped;
+
 	/**
 	 * Is this context setup already
 	 */
@@ -128,6 +169,9 @@ void net_capture_foreach(net_capture_cb_t cb, void *user_data)
 		info.tunnel_iface = ctx->tunnel_iface;
 		info.peer = &ctx->peer;
 		info.local = &ctx->local;
+		info.captured = ctx->captured;
+		info.filtered = ctx->filtered;
+		info.dropped = ctx->dropped;
 		info.is_enabled = ctx->is_enabled;
 
 		k_mutex_unlock(&lock);
@@ -153,6 +197,9 @@ static struct net_capture *alloc_capture_dev(void)
 		}
 
 		ctx->in_use = true;
+		ctx->captured = 0;
+		ctx->filtered = 0;
+		ctx->dropped = 0;
 		goto out;
 	}
 
@@ -455,6 +502,9 @@ static int capture_cleanup(const struct device *dev)
 
 	(void)cleanup_iface(ctx->tunnel_iface, &ctx->local);
 
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+	ctx->filter = NULL;
+#endif
 	ctx->tunnel_iface = NULL;
 	ctx->in_use = false;
 
@@ -508,9 +558,146 @@ static int capture_disable(const struct device *dev)
 	return 0;
 }
 
-int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+int net_capture_set_filter(const struct device *dev, struct npf_rule_list *rules)
+{
+	struct net_capture *ctx = dev->data;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	ctx->filter = rules;
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+#endif
+
+int net_capture_set_snaplen(const struct device *dev, size_t snaplen)
 {
+	struct net_capture *ctx = dev->data;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	ctx->snaplen = snaplen;
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+static bool capture_filter_ok(struct net_capture *ctx, struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+	if (ctx->filter != NULL) {
+		return npf_rules_ok(ctx->filter, pkt);
+	}
+#else
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(pkt);
+#endif
+
+	return true;
+}
+
+/* Copy at most snaplen bytes of the packet to a packet of the capture slab */
+static struct net_pkt *capture_clone(struct net_pkt *pkt, size_t snaplen)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_pkt_cursor backup;
 	struct k_mem_slab *orig_slab;
+	struct net_pkt *captured;
+	int ret;
+
+	if (snaplen == 0U || net_pkt_get_len(pkt) <= snaplen) {
+		orig_slab = pkt->slab;
+		pkt->slab = get_net_pkt();
+
+		captured = net_pkt_clone(pkt, K_NO_WAIT);
+
+		pkt->slab = orig_slab;
+
+		return captured;
+	}
+
+	/* No need to copy the whole packet only to drop most of it */
+	captured = net_pkt_alloc_from_slab(get_net_pkt(), K_NO_WAIT);
+	if (captured == NULL) {
+		return NULL;
+	}
+
+	net_pkt_set_iface(captured, net_pkt_iface(pkt));
+
+	if (net_pkt_alloc_buffer(captured, snaplen, 0, K_NO_WAIT) < 0) {
+		net_pkt_unref(captured);
+		return NULL;
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	ret = net_pkt_copy(captured, pkt, snaplen);
+
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	if (ret < 0) {
+		net_pkt_unref(captured);
+		return NULL;
+	}
+
+	net_pkt_cursor_init(captured);
+
+	return captured;
+}
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+static int capture_queue(struct net_capture *ctx, struct net_pkt *pkt)
+{
+	struct capture_slot slot = {
+		.ctx = ctx,
+		.pkt = pkt,
+	};
+
+	return k_msgq_put(&capture_ring, &slot, K_NO_WAIT) < 0 ? -ENOMEM : 0;
+}
+
+static void capture_thread(void *p1, void *p2, void *p3)
+{
+	struct capture_slot slot;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		int count = 0;
+
+		(void)k_msgq_get(&capture_ring, &slot, K_FOREVER);
+
+		k_mutex_lock(&lock, K_FOREVER);
+
+		/* Send what is queued while holding the lock only once */
+		do {
+			struct net_capture *ctx = slot.ctx;
+
+			if (!ctx->in_use || !ctx->is_enabled ||
+			    net_capture_send(ctx->dev, ctx->tunnel_iface, slot.pkt) < 0) {
+				ctx->dropped++;
+				net_pkt_unref(slot.pkt);
+			}
+		} while (++count < CONFIG_NET_CAPTURE_RING_BATCH &&
+			 k_msgq_get(&capture_ring, &slot, K_NO_WAIT) == 0);
+
+		k_mutex_unlock(&lock);
+
+		k_yield();
+	}
+}
+
+K_THREAD_DEFINE(capture_tid, CONFIG_NET_CAPTURE_RING_STACK_SIZE,
+		capture_thread, NULL, NULL, NULL, THREAD_PRIORITY, 0, 0);
+#endif /* CONFIG_NET_CAPTURE_RING */
+
+int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
+{
 	struct net_pkt *captured;
 	sys_snode_t *sn, *sns;
 	bool skip_clone = false;
@@ -534,6 +721,14 @@ int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 			continue;
 		}
 
+		/* Filter before anything is copied */
+		if (!capture_filter_ok(ctx, pkt)) {
+			ctx->filtered++;
+			net_pkt_set_cooked_mode(pkt, false);
+			ret = -EPERM;
+			goto out;
+		}
+
 		/* If the packet is marked as "cooked", then it means that the
 		 * packet was directed here by "any" interface and was already
 		 * cooked mode captured. So no need to clone it here.
@@ -545,16 +740,10 @@ int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 		if (skip_clone) {
 			captured = pkt;
 		} else {
-			orig_slab = pkt->slab;
-			pkt->slab = get_net_pkt();
-
-			captured = net_pkt_clone(pkt, K_NO_WAIT);
-
-			pkt->slab = orig_slab;
-
+			captured = capture_clone(pkt, ctx->snaplen);
 			if (captured == NULL) {
 				NET_DBG("Captured pkt %s", "dropped");
-				/* TODO: update capture data statistics */
+				ctx->dropped++;
 				ret = -ENOMEM;
 				goto out;
 			}
@@ -564,11 +753,18 @@ int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 		net_pkt_set_iface(captured, ctx->tunnel_iface);
 		net_pkt_set_captured(pkt, true);
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+		ret = capture_queue(ctx, captured);
+#else
 		ret = net_capture_send(ctx->dev, ctx->tunnel_iface, captured);
+#endif
 		if (ret < 0) {
+			ctx->dropped++;
 			if (!skip_clone) {
 				net_pkt_unref(captured);
 			}
+		} else {
+			ctx->captured++;
 		}
 
 		net_pkt_set_cooked_mode(pkt, false);
@@ -597,6 +793,7 @@ static int capture_dev_init(const struct device *dev)
 	sys_slist_prepend(&net_capture_devlist, &ctx->node);
 
 	ctx->dev = dev;
+	ctx->snaplen = CONFIG_NET_CAPTURE_SNAPLEN;
 	ctx->init_done = true;
 
 	k_mutex_unlock(&lock);
@@ -1159,6 +1159,68 @@ bool coap_packet_is_request(const struct coap_packet *cpkt)
 	return !(code & ~COAP_REQUEST_MASK);
 }
 
+#if defined(CONFIG_COAP_RESOURCE_PATH_HASH)
+/* Hashes of literal paths have their lowest bit set, so they are never 0 (not
+ * computed yet) nor PATH_HASH_WILDCARD.
+ */
+#define PATH_HASH_WILDCARD 2U
+
+#define FNV1A_OFFSET_BASIS 2166136261U
+#define FNV1A_PRIME        16777619U
+
+static uint32_t path_segment_hash(uint32_t hash, const uint8_t *segment, size_t len)
+{
+	/* The length sets the segments apart, "a/bc" and "ab/c" hash differently */
+	hash = (hash ^ (uint8_t)len) * FNV1A_PRIME;
+
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ segment[i]) * FNV1A_PRIME;
+	}
+
+	return hash;
+}
+
+static uint32_t uri_path_hash(const struct coap_option *options, uint8_t opt_num)
+{
+	uint32_t hash = FNV1A_OFFSET_BASIS;
+
+	for (uint8_t i = 0U; i < opt_num; i++) {
+		if (options[i].delta != COAP_OPTION_URI_PATH) {
+			continue;
+		}
+
+		hash = path_segment_hash(hash, options[i].value, options[i].len);
+	}
+
+	return hash | BIT(0);
+}
+
+static bool resource_path_hash_match(struct coap_resource *resource, uint32_t hash)
+{
+	if (resource->path_hash == 0U) {
+		uint32_t path_hash = FNV1A_OFFSET_BASIS;
+
+		for (const char * const *p = resource->path; p && *p; p++) {
+			if (IS_ENABLED(CONFIG_COAP_URI_WILDCARD) &&
+			    (strcmp(*p, "+") == 0 || strcmp(*p, "#") == 0)) {
+				path_hash = PATH_HASH_WILDCARD;
+				break;
+			}
+
+			path_hash = path_segment_hash(path_hash, (const uint8_t *)*p, strlen(*p));
+		}
+
+		if (path_hash != PATH_HASH_WILDCARD) {
+			path_hash |= BIT(0);
+		}
+
+		resource->path_hash = path_hash;
+	}
+
+	return resource->path_hash == PATH_HASH_WILDCARD || resource->path_hash == hash;
+}
+#endif /* CONFIG_COAP_RESOURCE_PATH_HASH */
+
 int coap_handle_request_len(struct coap_packet *cpkt,
 			    struct coap_resource *resources,
 			    size_t resources_len,
@@ -1170,11 +1232,21 @@ int coap_handle_request_len(struct coap_packet *cpkt,
 		return 0;
 	}
 
+#if defined(CONFIG_COAP_RESOURCE_PATH_HASH)
+	uint32_t hash = uri_path_hash(options, opt_num);
+#endif
+
 	/* FIXME: deal with hierarchical resources */
 	for (size_t i = 0; i < resources_len; i++) {
 		coap_method_t method;
 		uint8_t code;
 
+#if defined(CONFIG_COAP_RESOURCE_PATH_HASH)
+		if (!resource_path_hash_match(&resources[i], hash)) {
+			continue;
+		}
+#endif
+
 		if (!coap_uri_path_match(resources[i].path, options, opt_num)) {
 			continue;
 		}
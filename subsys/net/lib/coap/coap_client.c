@@ -62,6 +62,60 @@ static void reset_internal_request(struct coap_client_internal_request *request)
 	reset_block_contexts(request);
 }
 
+static uint16_t token_bucket(const uint8_t *token, uint8_t tkl)
+{
+	uint32_t hash = tkl;
+
+	for (uint8_t i = 0; i < tkl; i++) {
+		hash = (hash * 31U) ^ token[i];
+	}
+
+	return hash & (COAP_CLIENT_TOKEN_INDEX_SIZE - 1U);
+}
+
+/* The token index is only changed and walked with the send mutex held */
+static void token_index_remove(struct coap_client *client,
+			       struct coap_client_internal_request *internal_req)
+{
+	int16_t index = internal_req - client->requests;
+	int16_t *it;
+
+	if (!internal_req->token_indexed) {
+		return;
+	}
+
+	it = &client->token_index[token_bucket(internal_req->request_token,
+					       internal_req->request_tkl)];
+	while (*it != index) {
+		it = &client->requests[*it].token_next;
+	}
+
+	*it = internal_req->token_next;
+	internal_req->token_indexed = false;
+}
+
+static void token_index_add(struct coap_client *client,
+			    struct coap_client_internal_request *internal_req)
+{
+	int16_t *bucket = &client->token_index[token_bucket(internal_req->request_token,
+							    internal_req->request_tkl)];
+
+	internal_req->token_next = *bucket;
+	*bucket = internal_req - client->requests;
+	internal_req->token_indexed = true;
+}
+
+static bool has_block2_option(const struct coap_client_request *req)
+{
+	for (int i = 0; i < req->num_options; i++) {
+		if (req->options[i].code == COAP_OPTION_BLOCK2) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 static int coap_client_schedule_poll(struct coap_client *client, int sock,
 				     struct coap_client_request *req,
 				     struct coap_client_internal_request *internal_req)
@@ -146,9 +200,11 @@ static int coap_client_init_request(struct coap_client *client,
 	if (!reconstruct) {
 		uint8_t *token = coap_next_token();
 
+		token_index_remove(client, internal_req);
 		internal_req->last_id = coap_next_id();
 		internal_req->request_tkl = COAP_TOKEN_MAX_LEN & 0xf;
 		memcpy(internal_req->request_token, token, internal_req->request_tkl);
+		token_index_add(client, internal_req);
 	}
 
 	ret = coap_packet_init(&internal_req->request, client->send_buf, MAX_COAP_MSG_LEN,
@@ -586,25 +642,28 @@ struct coap_client_internal_request *get_request_with_id(struct coap_client *cli
 struct coap_client_internal_request *get_request_with_token(struct coap_client *client,
 							    const struct coap_packet *resp)
 {
-
+	struct coap_client_internal_request *found = NULL;
 	uint8_t response_token[COAP_TOKEN_MAX_LEN];
 	uint8_t response_tkl;
 
 	response_tkl = coap_header_get_token(resp, response_token);
 
-	for (int i = 0; i < CONFIG_COAP_CLIENT_MAX_REQUESTS; i++) {
-		if (client->requests[i].request_ongoing) {
-			if (client->requests[i].request_tkl != response_tkl) {
-				continue;
-			}
-			if (memcmp(&client->requests[i].request_token, &response_token,
-			    response_tkl) == 0) {
-				return &client->requests[i];
-			}
+	k_mutex_lock(&client->send_mutex, K_FOREVER);
+
+	for (int16_t i = client->token_index[token_bucket(response_token, response_tkl)]; i >= 0;
+	     i = client->requests[i].token_next) {
+		struct coap_client_internal_request *internal_req = &client->requests[i];
+
+		if (internal_req->request_ongoing && internal_req->request_tkl == response_tkl &&
+		    memcmp(internal_req->request_token, response_token, response_tkl) == 0) {
+			found = internal_req;
+			break;
 		}
 	}
 
-	return NULL;
+	k_mutex_unlock(&client->send_mutex);
+
+	return found;
 }
 
 static bool find_echo_option(const struct coap_packet *response, struct coap_option *option)
@@ -730,7 +789,12 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 
 	/* Check if block2 exists */
 	block_option = coap_get_option_int(response, COAP_OPTION_BLOCK2);
-	if (block_option > 0) {
+	if (block_option > 0 && has_block2_option(&internal_req->coap_request)) {
+		/* A single block asked by the user, this response completes the request */
+		last_block = !GET_MORE(block_option);
+		block_num = GET_BLOCK_NUM(block_option);
+		internal_req->offset = block_num << (GET_BLOCK_SIZE(block_option) + 4);
+	} else if (block_option > 0) {
 		blockwise_transfer = true;
 		last_block = !GET_MORE(block_option);
 		block_num = GET_BLOCK_NUM(block_option);
@@ -872,6 +936,10 @@ int coap_client_init(struct coap_client *client, const char *info)
 
 	k_mutex_init(&client->send_mutex);
 
+	for (int i = 0; i < COAP_CLIENT_TOKEN_INDEX_SIZE; i++) {
+		client->token_index[i] = -1;
+	}
+
 	clients[num_clients] = client;
 	num_clients++;
 
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2024 Endress+Hauser AG
+ * Copyright The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -9,7 +10,145 @@
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+/* A popular entry is refreshed once found this many times */
+#define DNS_CACHE_PREFETCH_HITS 2
+
+static void dns_cache_clean(struct dns_cache *cache);
+
+static uint32_t dns_cache_hash(char const *query)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	while (*query != '\0') {
+		hash ^= (uint8_t)*query++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static bool heap_before(struct dns_cache *cache, size_t a, size_t b)
+{
+	return sys_timepoint_cmp(cache->entries[cache->heap[a]].expiry,
+				 cache->entries[cache->heap[b]].expiry) < 0;
+}
+
+static void heap_swap(struct dns_cache *cache, size_t a, size_t b)
+{
+	uint16_t tmp = cache->heap[a];
+
+	cache->heap[a] = cache->heap[b];
+	cache->heap[b] = tmp;
+	cache->entries[cache->heap[a]].heap_pos = a;
+	cache->entries[cache->heap[b]].heap_pos = b;
+}
+
+static void heap_sift_up(struct dns_cache *cache, size_t pos)
+{
+	while (pos > 0 && heap_before(cache, pos, (pos - 1) / 2)) {
+		heap_swap(cache, pos, (pos - 1) / 2);
+		pos = (pos - 1) / 2;
+	}
+}
+
+static void heap_sift_down(struct dns_cache *cache, size_t pos)
+{
+	while (true) {
+		size_t first = pos;
+		size_t child = 2 * pos + 1;
+
+		if (child < cache->heap_len && heap_before(cache, child, first)) {
+			first = child;
+		}
+
+		if (child + 1 < cache->heap_len && heap_before(cache, child + 1, first)) {
+			first = child + 1;
+		}
+
+		if (first == pos) {
+			break;
+		}
+
+		heap_swap(cache, pos, first);
+		pos = first;
+	}
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_link(struct dns_cache *cache, size_t index)
+{
+	struct dns_cache_entry *entry = &cache->entries[index];
+	uint16_t *link = &cache->buckets[entry->hash & cache->bucket_mask];
+
+	/* Keep the entries of a query in the order they were added */
+	while (*link != 0) {
+		link = &cache->entries[*link - 1].next;
+	}
+
+	*link = index + 1;
+	entry->next = 0;
+	entry->in_use = true;
+
+	entry->heap_pos = cache->heap_len;
+	cache->heap[cache->heap_len++] = index;
+	heap_sift_up(cache, entry->heap_pos);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_unlink(struct dns_cache *cache, size_t index)
+{
+	struct dns_cache_entry *entry = &cache->entries[index];
+	uint16_t *link = &cache->buckets[entry->hash & cache->bucket_mask];
+	size_t pos = entry->heap_pos;
+
+	while (*link != index + 1) {
+		link = &cache->entries[*link - 1].next;
+	}
+
+	*link = entry->next;
+	entry->in_use = false;
+
+	cache->heap_len--;
+	if (pos != cache->heap_len) {
+		heap_swap(cache, pos, cache->heap_len);
+		heap_sift_up(cache, pos);
+		heap_sift_down(cache, pos);
+	}
+}
+
+/* Needs to be called when lock is already acquired */
+static size_t dns_cache_alloc(struct dns_cache *cache)
+{
+	size_t index;
+
+	if (cache->heap_len < cache->size) {
+		for (size_t i = 0; i < cache->size; i++) {
+			if (!cache->entries[i].in_use) {
+				return i;
+			}
+		}
+	}
+
+	/* Replace the entry closest to expiry */
+	index = cache->heap[0];
+	NET_DBG("Overwrite \"%s\"", cache->entries[index].query);
+	dns_cache_unlink(cache, index);
+
+	return index;
+}
+
+static bool dns_cache_query_valid(char const *query)
+{
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return false;
+	}
+
+	return true;
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
@@ -17,26 +156,48 @@ int dns_cache_flush(struct dns_cache *cache)
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
 	}
+	for (size_t i = 0; i <= cache->bucket_mask; i++) {
+		cache->buckets[i] = 0;
+	}
+	cache->heap_len = 0;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
 }
 
+static void dns_cache_insert(struct dns_cache *cache, char const *query, uint32_t hash,
+			     uint32_t ttl, int status, uint8_t type,
+			     struct dns_addrinfo const *addrinfo)
+{
+	size_t index = dns_cache_alloc(cache);
+	struct dns_cache_entry *entry = &cache->entries[index];
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	if (addrinfo != NULL) {
+		entry->data = *addrinfo;
+	} else {
+		memset(&entry->data, 0, sizeof(entry->data));
+	}
+	entry->hash = hash;
+	entry->ttl = ttl;
+	entry->status = status;
+	entry->type = type;
+	entry->hits = 0;
+	entry->prefetched = false;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+
+	dns_cache_link(cache, index);
+}
+
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
-
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
 
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (!dns_cache_query_valid(query)) {
 		return -EINVAL;
 	}
 
@@ -46,26 +207,48 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	dns_cache_insert(cache, query, dns_cache_hash(query), ttl, 0, 0, addrinfo);
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   int status, uint32_t ttl)
+{
+	uint32_t hash;
+	uint16_t next;
+
+	if (cache == NULL || query == NULL || status >= 0 || ttl == 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (!dns_cache_query_valid(query)) {
+		return -EINVAL;
+	}
+
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" type %d with TTL %" PRIu32, query, type, ttl);
+
+	dns_cache_clean(cache);
+
+	next = cache->buckets[hash & cache->bucket_mask];
+	while (next != 0) {
+		struct dns_cache_entry *entry = &cache->entries[next - 1];
+		size_t index = next - 1;
+
+		next = entry->next;
+		if (entry->status != 0 && entry->type == type && entry->hash == hash &&
+		    strcmp(entry->query, query) == 0) {
+			dns_cache_unlink(cache, index);
+		}
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	dns_cache_insert(cache, query, hash, ttl, status, type, NULL);
 
 	k_mutex_unlock(cache->lock);
 
@@ -74,21 +257,28 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
+	uint32_t hash;
+	uint16_t next;
+
 	NET_DBG("Remove all entries with query \"%s\"", query);
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (!dns_cache_query_valid(query)) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+	next = cache->buckets[hash & cache->bucket_mask];
+	while (next != 0) {
+		struct dns_cache_entry *entry = &cache->entries[next - 1];
+		size_t index = next - 1;
+
+		next = entry->next;
+		if (entry->hash == hash && strcmp(entry->query, query) == 0) {
+			dns_cache_unlink(cache, index);
 		}
 	}
 
@@ -97,39 +287,46 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len)
 {
 	size_t found = 0;
+	uint32_t hash;
+	uint16_t next;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (!dns_cache_query_valid(query)) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	for (next = cache->buckets[hash & cache->bucket_mask]; next != 0;
+	     next = cache->entries[next - 1].next) {
+		struct dns_cache_entry *entry = &cache->entries[next - 1];
+
+		if (entry->status != 0 || entry->hash != hash) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (strcmp(entry->query, query) != 0) {
 			continue;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
+			if (entry->hits < UINT16_MAX) {
+				entry->hits++;
+			}
 			NET_DBG("Found \"%s\"", query);
 		}
 	}
@@ -146,17 +343,95 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+int dns_cache_find_negative(struct dns_cache *cache, const char *query, enum dns_query_type type)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	uint32_t hash;
+	uint16_t next;
+	int status = 0;
+
+	if (cache == NULL || query == NULL || !dns_cache_query_valid(query)) {
+		return 0;
+	}
+
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	dns_cache_clean(cache);
+
+	for (next = cache->buckets[hash & cache->bucket_mask]; next != 0;
+	     next = cache->entries[next - 1].next) {
+		struct dns_cache_entry *entry = &cache->entries[next - 1];
+
+		if (entry->status != 0 && entry->type == type && entry->hash == hash &&
+		    strcmp(entry->query, query) == 0) {
+			NET_DBG("Found negative \"%s\" type %d", query, type);
+			status = entry->status;
+			break;
+		}
+	}
+
+	k_mutex_unlock(cache->lock);
+
+	return status;
+}
+
+bool dns_cache_prefetch_due(struct dns_cache *cache, const char *query)
+{
+	bool due = false;
+	uint32_t hash;
+	uint16_t next;
+
+	if (cache == NULL || query == NULL || !dns_cache_query_valid(query)) {
+		return false;
+	}
+
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	for (next = cache->buckets[hash & cache->bucket_mask]; next != 0;
+	     next = cache->entries[next - 1].next) {
+		struct dns_cache_entry *entry = &cache->entries[next - 1];
+		k_timeout_t left;
+
+		if (entry->status != 0 || entry->prefetched || entry->hash != hash ||
+		    strcmp(entry->query, query) != 0) {
 			continue;
 		}
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+		left = sys_timepoint_timeout(entry->expiry);
+		if (entry->hits >= DNS_CACHE_PREFETCH_HITS &&
+		    k_ticks_to_ms_floor64(left.ticks) < entry->ttl * 100ULL) {
+			due = true;
+		}
+	}
+
+	if (due) {
+		/* Ask for a single refresh of the query */
+		for (next = cache->buckets[hash & cache->bucket_mask]; next != 0;
+		     next = cache->entries[next - 1].next) {
+			struct dns_cache_entry *entry = &cache->entries[next - 1];
+
+			if (entry->hash == hash && strcmp(entry->query, query) == 0) {
+				entry->prefetched = true;
+			}
 		}
+
+		NET_DBG("Prefetch \"%s\"", query);
+	}
+
+	k_mutex_unlock(cache->lock);
+
+	return due;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_clean(struct dns_cache *cache)
+{
+	while (cache->heap_len > 0 &&
+	       sys_timepoint_expired(cache->entries[cache->heap[0]].expiry)) {
+		NET_DBG("Remove \"%s\"", cache->entries[cache->heap[0]].query);
+		dns_cache_unlink(cache, cache->heap[0]);
 	}
 }
@@ -22,15 +22,41 @@ struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Hash of the query */
+	uint32_t hash;
+	/* TTL the entry was added with, in seconds */
+	uint32_t ttl;
+	/* DNS_EAI_* status of a negative entry, 0 for an address */
+	int status;
+	/* Next entry in the same hash bucket, as index + 1, 0 if none */
+	uint16_t next;
+	/* Position in the expiry heap */
+	uint16_t heap_pos;
+	/* Number of lookups answered from the entry */
+	uint16_t hits;
+	/* Query type of a negative entry */
+	uint8_t type;
 	bool in_use;
+	bool prefetched;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
 	struct k_mutex *lock;
+	/* Hash buckets, holding the first entry as index + 1, 0 if empty */
+	uint16_t *buckets;
+	size_t bucket_mask;
+	/* Indexes of the entries in use, as a min-heap ordered by expiry */
+	uint16_t *heap;
+	size_t heap_len;
 };
 
+/* Number of hash buckets of a cache, a power of two */
+#define DNS_CACHE_BUCKETS(cache_size)                                                              \
+	((cache_size) <= 4 ? 4 : (cache_size) <= 8 ? 8 : (cache_size) <= 16 ? 16                    \
+	 : (cache_size) <= 32 ? 32 : (cache_size) <= 64 ? 64 : 128)
+
 /**
  * @brief Statically define and initialize a DNS queue.
  *
@@ -41,10 +67,15 @@ struct dns_cache {
  * @param name Name of the cache.
  */
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+	BUILD_ASSERT((cache_size) <= UINT16_MAX, "DNS cache too large");                          \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static uint16_t name##_buckets[DNS_CACHE_BUCKETS(cache_size)];                             \
+	static uint16_t name##_heap[cache_size];                                                   \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex,              \
+		.buckets = name##_buckets, .bucket_mask = DNS_CACHE_BUCKETS(cache_size) - 1,       \
+		.heap = name##_heap};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -94,7 +125,48 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
+/**
+ * @brief Adds a negative entry to the dns cache, recording that the query
+ * has no answer of the given type.
+ *
+ * A previous negative entry for the same query and type is replaced.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param type Type of the query.
+ * @param status DNS_EAI_* status to answer the query with, e.g. DNS_EAI_NODATA.
+ * @param ttl Time to live for the entry in seconds.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   int status, uint32_t ttl);
+
+/**
+ * @brief Tries to find a negative entry for the specified query and type.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param type Type of the query.
+ * @retval The cached DNS_EAI_* status if found.
+ * @retval 0 if there is no negative entry.
+ */
+int dns_cache_find_negative(struct dns_cache *cache, const char *query, enum dns_query_type type);
+
+/**
+ * @brief Checks whether the entries of a popular query should be refreshed
+ * before they expire.
+ *
+ * Returns true once for entries found at least twice that have less than a
+ * tenth of their TTL left, so that only one refresh query is sent.
+ *
+ * @param cache Cache where the entries should be searched.
+ * @param query Query which should be searched for.
+ * @retval true if the query should be resolved again.
+ */
+bool dns_cache_prefetch_due(struct dns_cache *cache, const char *query);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -72,6 +72,21 @@ NET_BUF_POOL_DEFINE(dns_qname_pool, DNS_RESOLVER_BUF_CTR, CONFIG_DNS_RESOLVER_MA
 DNS_CACHE_DEFINE(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+/* Names of the refresh queries, which outlive the callers' strings */
+static char dns_prefetch_names[CONFIG_DNS_NUM_CONCUR_QUERIES][CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+
+/* The answers of a refresh query only update the cache */
+static void dns_prefetch_cb(enum dns_resolve_status status,
+			    struct dns_addrinfo *info,
+			    void *user_data)
+{
+	ARG_UNUSED(status);
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 static struct dns_resolve_context dns_default_ctx;
 
 /* Must be invoked with context lock held */
@@ -633,6 +648,12 @@ query_known:
 
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+			/* The fresh answers of a refresh replace the cached ones */
+			if (items == 0 && ctx->queries[*query_idx].cb == dns_prefetch_cb) {
+				dns_cache_remove(&dns_cache, ctx->queries[*query_idx].query);
+			}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 			dns_cache_add(&dns_cache,
 				ctx->queries[*query_idx].query, &info, ttl);
@@ -704,6 +725,11 @@ query_known:
 
 	if (items == 0) {
 		ret = DNS_EAI_NODATA;
+#if defined(CONFIG_DNS_RESOLVER_CACHE) && CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL > 0
+		dns_cache_add_negative(&dns_cache, ctx->queries[*query_idx].query,
+				       ctx->queries[*query_idx].query_type, ret,
+				       CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+#endif
 	} else {
 		ret = DNS_EAI_ALLDONE;
 	}
@@ -1124,6 +1150,7 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	int ret, i = -1, j = 0;
 	int failure = 0;
 	bool mdns_query = false;
+	bool prefetch = false;
 	uint8_t hop_limit;
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 	struct dns_addrinfo cached_info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES] = {0};
@@ -1190,7 +1217,15 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 
 try_resolve:
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-	ret = dns_cache_find(&dns_cache, query, cached_info, sizeof(cached_info));
+	ret = dns_cache_find_negative(&dns_cache, query, type);
+	if (ret < 0) {
+		/* The name is known to have no answer of this type */
+		cb(ret, NULL, user_data);
+
+		return 0;
+	}
+
+	ret = dns_cache_find(&dns_cache, query, cached_info, ARRAY_SIZE(cached_info));
 	if (ret > 0) {
 		/* The query was cached, no
 		 * need to continue further.
@@ -1200,7 +1235,16 @@ try_resolve:
 		}
 		cb(DNS_EAI_ALLDONE, NULL, user_data);
 
-		return 0;
+		if (!IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE_PREFETCH) ||
+		    !dns_cache_prefetch_due(&dns_cache, query)) {
+			return 0;
+		}
+
+		/* Refresh the popular entry in the background, the caller
+		 * already got its answer.
+		 */
+		prefetch = true;
+		dns_id = NULL;
 	}
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
@@ -1225,6 +1269,15 @@ try_resolve:
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+	if (prefetch) {
+		strncpy(dns_prefetch_names[i], query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+		ctx->queries[i].query = dns_prefetch_names[i];
+		ctx->queries[i].cb = dns_prefetch_cb;
+		ctx->queries[i].user_data = NULL;
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
@@ -1343,7 +1396,8 @@ quit:
 fail:
 	k_mutex_unlock(&ctx->lock);
 
-	return ret;
+	/* A failed refresh is not an error for the caller */
+	return prefetch ? 0 : ret;
 }
 
 /* Must be invoked with context lock held */
@@ -344,6 +344,9 @@ static int on_message_complete(struct http_parser *parser)
 
 	req->internal.response.message_complete = 1;
 
+	/* Stop at the end of the response, what follows is the next one */
+	http_parser_pause(parser, 1);
+
 	return 0;
 }
 
@@ -439,10 +442,17 @@ static void http_report_progress(struct http_request *req)
 	}
 }
 
-static int http_wait_data(int sock, struct http_request *req, int32_t timeout)
+/* Receive and parse a response. On entry, pending is the length of the data
+ * already at the start of the receive buffer. On return, it is the length of
+ * the data received past the end of the response, moved to the start of the
+ * receive buffer.
+ */
+static int http_wait_data(int sock, struct http_request *req, int32_t timeout,
+			  size_t *pending)
 {
 	int total_received = 0;
 	size_t offset = 0;
+	size_t parsed;
 	int received, ret;
 	struct zsock_pollfd fds[1];
 	int nfds = 1;
@@ -453,30 +463,38 @@ static int http_wait_data(int sock, struct http_request *req, int32_t timeout)
 	fds[0].events = ZSOCK_POLLIN;
 
 	do {
-		if (timeout > 0) {
-			remaining_time -= (int32_t)k_uptime_delta(&timestamp);
-			if (remaining_time < 0) {
-				/* timeout, make poll return immediately */
-				remaining_time = 0;
+		if (*pending > 0) {
+			/* Received with the previous response */
+			received = *pending;
+			*pending = 0;
+		} else {
+			if (timeout > 0) {
+				remaining_time -= (int32_t)k_uptime_delta(&timestamp);
+				if (remaining_time < 0) {
+					/* timeout, make poll return immediately */
+					remaining_time = 0;
+				}
+			}
+
+			ret = zsock_poll(fds, nfds, remaining_time);
+			if (ret == 0) {
+				LOG_DBG("Timeout");
+				ret = -ETIMEDOUT;
+				goto error;
+			} else if (ret < 0) {
+				ret = -errno;
+				goto error;
+			}
+			if (fds[0].revents & (ZSOCK_POLLERR | ZSOCK_POLLNVAL)) {
+				ret = -errno;
+				goto error;
+			} else if (fds[0].revents & ZSOCK_POLLHUP) {
+				/* Connection closed */
+				goto closed;
+			} else if (!(fds[0].revents & ZSOCK_POLLIN)) {
+				continue;
 			}
-		}
 
-		ret = zsock_poll(fds, nfds, remaining_time);
-		if (ret == 0) {
-			LOG_DBG("Timeout");
-			ret = -ETIMEDOUT;
-			goto error;
-		} else if (ret < 0) {
-			ret = -errno;
-			goto error;
-		}
-		if (fds[0].revents & (ZSOCK_POLLERR | ZSOCK_POLLNVAL)) {
-			ret = -errno;
-			goto error;
-		} else if (fds[0].revents & ZSOCK_POLLHUP) {
-			/* Connection closed */
-			goto closed;
-		} else if (fds[0].revents & ZSOCK_POLLIN) {
 			received = zsock_recv(sock, req->internal.response.recv_buf + offset,
 					      req->internal.response.recv_buf_len - offset, 0);
 			if (received == 0) {
@@ -485,34 +503,51 @@ static int http_wait_data(int sock, struct http_request *req, int32_t timeout)
 			} else if (received < 0) {
 				ret = -errno;
 				goto error;
-			} else {
-				req->internal.response.data_len += received;
-
-				(void)http_parser_execute(
-					&req->internal.parser, &req->internal.parser_settings,
-					req->internal.response.recv_buf + offset, received);
 			}
+		}
 
-			total_received += received;
-			offset += received;
+		req->internal.response.data_len += received;
 
-			if (offset >= req->internal.response.recv_buf_len) {
-				offset = 0;
-			}
+		parsed = http_parser_execute(
+			&req->internal.parser, &req->internal.parser_settings,
+			req->internal.response.recv_buf + offset, received);
 
-			if (req->internal.response.message_complete) {
-				http_report_complete(req);
-				break;
-			} else if (offset == 0) {
-				http_report_progress(req);
+		total_received += received;
+		offset += received;
 
-				/* Re-use the result buffer and start to fill it again */
-				req->internal.response.data_len = 0;
-				req->internal.response.body_frag_start = NULL;
-				req->internal.response.body_frag_len = 0;
+		if (req->internal.response.message_complete) {
+			/* Keep what follows the response for the next one */
+			*pending = received - parsed;
+			total_received -= *pending;
+			req->internal.response.data_len -= *pending;
+
+			if (req->internal.response.body_frag_start != NULL) {
+				req->internal.response.body_frag_len =
+					req->internal.response.data_len -
+					(req->internal.response.body_frag_start -
+					 req->internal.response.recv_buf);
 			}
+
+			http_report_complete(req);
+
+			memmove(req->internal.response.recv_buf,
+				req->internal.response.recv_buf + offset - *pending,
+				*pending);
+			break;
 		}
 
+		if (offset >= req->internal.response.recv_buf_len) {
+			offset = 0;
+		}
+
+		if (offset == 0) {
+			http_report_progress(req);
+
+			/* Re-use the result buffer and start to fill it again */
+			req->internal.response.data_len = 0;
+			req->internal.response.body_frag_start = NULL;
+			req->internal.response.body_frag_len = 0;
+		}
 	} while (true);
 
 	return total_received;
@@ -538,15 +573,16 @@ error:
 	return ret;
 }
 
-int http_client_req(int sock, struct http_request *req,
-		    int32_t timeout, void *user_data)
+/* Send a request and get ready to parse its response */
+static int http_client_send_req(int sock, struct http_request *req,
+				void *user_data)
 {
 	/* Utilize the network usage by sending data in bigger blocks */
 	char send_buf[MAX_SEND_BUF_LEN];
 	const size_t send_buf_max_len = sizeof(send_buf);
 	size_t send_buf_pos = 0;
 	int total_sent = 0;
-	int ret, total_recv, i;
+	int ret, i;
 	const char *method;
 
 	if (sock < 0 || req == NULL || req->response == NULL ||
@@ -728,18 +764,175 @@ int http_client_req(int sock, struct http_request *req,
 	http_client_init_parser(&req->internal.parser,
 				&req->internal.parser_settings);
 
+	return total_sent;
+
+out:
+	return ret;
+}
+
+int http_client_req(int sock, struct http_request *req,
+		    int32_t timeout, void *user_data)
+{
+	size_t pending = 0;
+	int total_sent;
+	int total_recv;
+
+	total_sent = http_client_send_req(sock, req, user_data);
+	if (total_sent < 0) {
+		return total_sent;
+	}
+
 	/* Request is sent, now wait data to be received */
-	total_recv = http_wait_data(sock, req, timeout);
+	total_recv = http_wait_data(sock, req, timeout, &pending);
 	if (total_recv < 0) {
 		NET_DBG("Wait data failure (%d)", total_recv);
-		ret = total_recv;
-		goto out;
+		return total_recv;
 	}
 
 	NET_DBG("Received %d bytes", total_recv);
 
 	return total_sent;
+}
+
+void http_client_session_init(struct http_client_session *session,
+			      http_client_connect_cb_t connect, void *user_data)
+{
+	session->connect = connect;
+	session->user_data = user_data;
+	session->sock = -1;
+}
+
+void http_client_session_close(struct http_client_session *session)
+{
+	if (session->sock >= 0) {
+		(void)zsock_close(session->sock);
+		session->sock = -1;
+	}
+}
+
+/* Connect unless the connection of the session is still open */
+static int http_client_session_connect(struct http_client_session *session)
+{
+	struct zsock_pollfd fds[1];
+	int sock;
+
+	if (session->sock >= 0) {
+		fds[0].fd = session->sock;
+		fds[0].events = ZSOCK_POLLIN;
+
+		/* An idle connection can only become readable by being closed */
+		if (zsock_poll(fds, 1, 0) == 0) {
+			return 0;
+		}
+
+		NET_DBG("Connection closed by the server");
+		http_client_session_close(session);
+	}
+
+	sock = session->connect(session->user_data);
+	if (sock < 0) {
+		return sock;
+	}
+
+	session->sock = sock;
+
+	return 1;
+}
+
+static bool http_method_is_idempotent(enum http_method method)
+{
+	return method == HTTP_GET || method == HTTP_HEAD || method == HTTP_PUT ||
+	       method == HTTP_DELETE || method == HTTP_OPTIONS;
+}
+
+int http_client_session_pipeline(struct http_client_session *session,
+				 struct http_request **reqs, size_t count,
+				 int32_t timeout, void *user_data)
+{
+	bool keep_alive = true;
+	size_t pending = 0;
+	int total_sent = 0;
+	bool reused;
+	int ret;
+
+	if (session == NULL || session->connect == NULL || reqs == NULL ||
+	    count == 0) {
+		return -EINVAL;
+	}
+
+	ret = http_client_session_connect(session);
+	if (ret < 0) {
+		return ret;
+	}
+
+	reused = (ret == 0);
+
+	for (size_t i = 0; i < count; i++) {
+		ret = http_client_send_req(session->sock, reqs[i], user_data);
+
+		/* The server may have closed the idle connection meanwhile */
+		if (ret < 0 && i == 0 && reused && ret != -EINVAL &&
+		    http_method_is_idempotent(reqs[0]->method)) {
+			NET_DBG("Reconnecting (%d)", ret);
+			http_client_session_close(session);
+
+			ret = http_client_session_connect(session);
+			if (ret >= 0) {
+				ret = http_client_send_req(session->sock, reqs[0],
+							   user_data);
+			}
+		}
+
+		if (ret < 0) {
+			goto close;
+		}
+
+		total_sent += ret;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (pending > 0 && reqs[i]->recv_buf != reqs[i - 1]->recv_buf) {
+			if (pending > reqs[i]->recv_buf_len) {
+				ret = -EMSGSIZE;
+				goto close;
+			}
+
+			memcpy(reqs[i]->recv_buf, reqs[i - 1]->recv_buf, pending);
+		}
+
+		ret = http_wait_data(session->sock, reqs[i], timeout, &pending);
+		if (ret < 0) {
+			goto close;
+		}
+
+		if (!reqs[i]->internal.response.message_complete ||
+		    !http_should_keep_alive(&reqs[i]->internal.parser)) {
+			keep_alive = false;
+
+			/* The requests past this one are not answered */
+			if (i + 1 < count) {
+				ret = -ECONNRESET;
+				goto close;
+			}
+		}
+	}
+
+	if (!keep_alive || pending > 0) {
+		http_client_session_close(session);
+	}
+
+	return total_sent;
+
+close:
+	NET_DBG("Session request failure (%d)", ret);
+	http_client_session_close(session);
 
-out:
 	return ret;
 }
+
+int http_client_session_req(struct http_client_session *session,
+			    struct http_request *req, int32_t timeout,
+			    void *user_data)
+{
+	return http_client_session_pipeline(session, &req, 1, timeout, user_data);
+}
@@ -0,0 +1,725 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include <errno.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_service.h>
+#include <zephyr/net/http/parser.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/status.h>
+
+#define MAX_SERVICES CONFIG_HTTP_SERVER_MAX_SERVICES
+#define MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
+
+/* The listening sockets come first, then the clients */
+#define SOCK_COUNT (MAX_SERVICES + MAX_CLIENTS)
+
+#define INACTIVITY_TIMEOUT K_SECONDS(CONFIG_HTTP_SERVER_CLIENT_INACTIVITY_TIMEOUT)
+
+/* Status line and headers of a response */
+#define RESPONSE_HEADER_SIZE 192
+
+#define HTTP_SERVER_THREAD_PRIORITY                                                                \
+	CLAMP(CONFIG_HTTP_SERVER_THREAD_PRIORITY, K_HIGHEST_APPLICATION_THREAD_PRIO,               \
+	      K_LOWEST_APPLICATION_THREAD_PRIO)
+
+struct http_client_ctx {
+	const struct http_service_desc *service;
+	struct http_parser parser;
+	struct k_work_delayable inactivity_timer;
+	/* Resource of the request being received, NULL if none */
+	const struct http_resource_detail *resource;
+	/* Status to answer the request with instead of the resource, 0 for none */
+	enum http_status error;
+	/* Close the connection after the response */
+	bool close;
+	/* Close the connection without a response */
+	bool drop;
+	bool head;
+	bool url_overflow;
+	size_t url_len;
+	char url[CONFIG_HTTP_SERVER_MAX_URL_LENGTH];
+	int fd;
+};
+
+static void http_server_cb(struct k_work *work);
+
+static K_THREAD_STACK_DEFINE(http_server_stack, CONFIG_HTTP_SERVER_STACK_SIZE);
+static struct k_work_q http_server_work_q;
+
+NET_SOCKET_SERVICE_ASYNC_DEFINE_STATIC(http_service, &http_server_work_q, http_server_cb,
+				       SOCK_COUNT);
+
+static K_MUTEX_DEFINE(lock);
+static bool running;
+static bool work_q_started;
+
+static struct http_client_ctx clients[MAX_CLIENTS];
+static struct zsock_pollfd fds[SOCK_COUNT];
+static const struct http_service_desc *listen_services[MAX_SERVICES];
+static struct http_parser_settings parser_settings;
+
+/* The requests of all the clients are parsed on the work queue of the
+ * server, one at a time, so they share the receive buffer.
+ */
+static char recv_buf[CONFIG_HTTP_SERVER_CLIENT_BUFFER_SIZE];
+
+static const char *status_str(enum http_status status)
+{
+	switch (status) {
+	case HTTP_200_OK:
+		return "OK";
+	case HTTP_400_BAD_REQUEST:
+		return "Bad Request";
+	case HTTP_404_NOT_FOUND:
+		return "Not Found";
+	case HTTP_405_METHOD_NOT_ALLOWED:
+		return "Method Not Allowed";
+	case HTTP_414_URI_TOO_LONG:
+		return "URI Too Long";
+	default:
+		return "";
+	}
+}
+
+/* Send all the data of an I/O vector, which is modified in the process */
+static int sendv_all(int fd, struct iovec *iov, size_t iovcnt)
+{
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = iovcnt,
+	};
+	ssize_t ret;
+
+	while (msg.msg_iovlen > 0) {
+		ret = zsock_sendmsg(fd, &msg, 0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		while (msg.msg_iovlen > 0 && (size_t)ret >= msg.msg_iov->iov_len) {
+			ret -= msg.msg_iov->iov_len;
+			msg.msg_iov++;
+			msg.msg_iovlen--;
+		}
+
+		if (msg.msg_iovlen > 0) {
+			msg.msg_iov->iov_base = (uint8_t *)msg.msg_iov->iov_base + ret;
+			msg.msg_iov->iov_len -= ret;
+		}
+	}
+
+	return 0;
+}
+
+static void header_append(char *header, int *len, const char *fmt, ...)
+{
+	va_list ap;
+
+	if (*len >= RESPONSE_HEADER_SIZE) {
+		return;
+	}
+
+	va_start(ap, fmt);
+	*len += vsnprintk(header + *len, RESPONSE_HEADER_SIZE - *len, fmt, ap);
+	va_end(ap);
+}
+
+/* Send the header of a response, followed by its body unless chunked */
+static int response_send(struct http_client_ctx *client, enum http_status status,
+			 const struct http_resource_detail *detail, const void *body,
+			 size_t body_len, bool chunked)
+{
+	char header[RESPONSE_HEADER_SIZE];
+	struct iovec iov[2];
+	int len = 0;
+
+	header_append(header, &len, "HTTP/1.1 %d %s\r\n", status, status_str(status));
+
+	if (detail != NULL && detail->content_type != NULL) {
+		header_append(header, &len, "Content-Type: %s\r\n", detail->content_type);
+	}
+
+	if (detail != NULL && detail->content_encoding != NULL) {
+		header_append(header, &len, "Content-Encoding: %s\r\n", detail->content_encoding);
+	}
+
+	if (chunked) {
+		header_append(header, &len, "Transfer-Encoding: chunked\r\n");
+	} else {
+		header_append(header, &len, "Content-Length: %zu\r\n", body_len);
+	}
+
+	header_append(header, &len, "%s\r\n", client->close ? "Connection: close\r\n" : "");
+
+	if (len >= RESPONSE_HEADER_SIZE) {
+		LOG_ERR("Response header too long");
+		return -ENOMEM;
+	}
+
+	iov[0].iov_base = header;
+	iov[0].iov_len = len;
+	iov[1].iov_base = (void *)body;
+	iov[1].iov_len = body_len;
+
+	return sendv_all(client->fd, iov, (client->head || chunked) ? 1 : 2);
+}
+
+/* Send a chunk of a response, the last one has no data */
+static int chunk_send(struct http_client_ctx *client, const uint8_t *data, size_t len)
+{
+	char chunk_header[sizeof("ffffffff\r\n")];
+	struct iovec iov[3];
+
+	if (client->head) {
+		return 0;
+	}
+
+	iov[0].iov_base = chunk_header;
+	iov[0].iov_len = snprintk(chunk_header, sizeof(chunk_header), "%x\r\n", (unsigned int)len);
+	iov[1].iov_base = (void *)data;
+	iov[1].iov_len = len;
+	iov[2].iov_base = "\r\n";
+	iov[2].iov_len = 2;
+
+	return sendv_all(client->fd, iov, ARRAY_SIZE(iov));
+}
+
+static const struct http_resource_detail *resource_find(const struct http_service_desc *service,
+							 const char *path, size_t path_len)
+{
+	HTTP_SERVICE_FOREACH_RESOURCE(service, res) {
+		if (strlen(res->resource) == path_len &&
+		    strncmp(res->resource, path, path_len) == 0) {
+			return res->detail;
+		}
+	}
+
+	return NULL;
+}
+
+static inline struct http_client_ctx *parser_client(struct http_parser *parser)
+{
+	return CONTAINER_OF(parser, struct http_client_ctx, parser);
+}
+
+static inline const struct http_resource_detail_dynamic *
+resource_dynamic(const struct http_client_ctx *client)
+{
+	return CONTAINER_OF(client->resource, struct http_resource_detail_dynamic, common);
+}
+
+static int on_message_begin(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser_client(parser);
+
+	client->resource = NULL;
+	client->error = 0;
+	client->url_len = 0;
+	client->url_overflow = false;
+
+	return 0;
+}
+
+static int on_url(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_client_ctx *client = parser_client(parser);
+
+	if (client->url_overflow || length > sizeof(client->url) - client->url_len) {
+		client->url_overflow = true;
+		return 0;
+	}
+
+	memcpy(&client->url[client->url_len], at, length);
+	client->url_len += length;
+
+	return 0;
+}
+
+static int on_headers_complete(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser_client(parser);
+	const struct http_resource_detail *detail;
+	const char *query;
+	size_t path_len;
+
+	client->close = !http_should_keep_alive(parser);
+	client->head = (parser->method == HTTP_HEAD);
+
+	if (client->url_overflow) {
+		client->error = HTTP_414_URI_TOO_LONG;
+		return 0;
+	}
+
+	query = memchr(client->url, '?', client->url_len);
+	path_len = (query != NULL) ? (size_t)(query - client->url) : client->url_len;
+
+	detail = resource_find(client->service, client->url, path_len);
+	if (detail == NULL) {
+		client->error = HTTP_404_NOT_FOUND;
+		return 0;
+	}
+
+	if ((detail->bitmask_of_supported_http_methods & BIT(parser->method)) == 0U) {
+		client->error = HTTP_405_METHOD_NOT_ALLOWED;
+		return 0;
+	}
+
+	client->resource = detail;
+
+	if (detail->type == HTTP_RESOURCE_TYPE_DYNAMIC &&
+	    response_send(client, HTTP_200_OK, detail, NULL, 0, true) < 0) {
+		client->drop = true;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int on_body(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_client_ctx *client = parser_client(parser);
+	const struct http_resource_detail_dynamic *dynamic;
+	int ret;
+
+	if (client->resource == NULL || client->resource->type != HTTP_RESOURCE_TYPE_DYNAMIC) {
+		return 0;
+	}
+
+	dynamic = resource_dynamic(client);
+
+	ret = dynamic->cb(client, HTTP_SERVER_DATA_MORE, (const uint8_t *)at, length,
+			  dynamic->user_data);
+	if (ret > 0) {
+		ret = chunk_send(client, dynamic->data_buffer,
+				 MIN((size_t)ret, dynamic->data_buffer_len));
+	}
+
+	if (ret < 0) {
+		client->drop = true;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int dynamic_final(struct http_client_ctx *client)
+{
+	const struct http_resource_detail_dynamic *dynamic = resource_dynamic(client);
+	int ret;
+
+	do {
+		ret = dynamic->cb(client, HTTP_SERVER_DATA_FINAL, NULL, 0, dynamic->user_data);
+		if (ret > 0) {
+			ret = chunk_send(client, dynamic->data_buffer,
+					 MIN((size_t)ret, dynamic->data_buffer_len));
+			if (ret == 0) {
+				ret = 1;
+			}
+		}
+	} while (ret > 0);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	return chunk_send(client, NULL, 0);
+}
+
+static int on_message_complete(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser_client(parser);
+	const struct http_resource_detail_static *data;
+	int ret;
+
+	if (client->error != 0) {
+		ret = response_send(client, client->error, NULL, NULL, 0, false);
+	} else if (client->resource->type == HTTP_RESOURCE_TYPE_STATIC) {
+		data = CONTAINER_OF(client->resource, struct http_resource_detail_static, common);
+		ret = response_send(client, HTTP_200_OK, client->resource, data->static_data,
+				    data->static_data_len, false);
+	} else {
+		ret = dynamic_final(client);
+	}
+
+	client->resource = NULL;
+
+	if (ret < 0) {
+		client->drop = true;
+		return -1;
+	}
+
+	/* The requests pipelined after this one are not answered */
+	if (client->close) {
+		http_parser_pause(parser, 1);
+	}
+
+	return 0;
+}
+
+static void client_close(struct http_client_ctx *client)
+{
+	const struct http_resource_detail_dynamic *dynamic;
+
+	if (client->resource != NULL && client->resource->type == HTTP_RESOURCE_TYPE_DYNAMIC) {
+		dynamic = resource_dynamic(client);
+		(void)dynamic->cb(client, HTTP_SERVER_DATA_ABORTED, NULL, 0, dynamic->user_data);
+		client->resource = NULL;
+	}
+
+	LOG_DBG("Closing client %d", client->fd);
+
+	(void)k_work_cancel_delayable(&client->inactivity_timer);
+	(void)zsock_close(client->fd);
+
+	fds[MAX_SERVICES + (client - clients)].fd = -1;
+	client->fd = -1;
+	client->service = NULL;
+}
+
+static void client_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct http_client_ctx *client =
+		CONTAINER_OF(dwork, struct http_client_ctx, inactivity_timer);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (client->fd >= 0) {
+		LOG_DBG("Client %d inactive", client->fd);
+
+		client_close(client);
+		(void)net_socket_service_register(&http_service, fds, ARRAY_SIZE(fds), NULL);
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+/* Parse the received data, answering each complete request in turn */
+static void client_recv(struct http_client_ctx *client)
+{
+	enum http_errno err;
+	size_t parsed;
+	ssize_t len;
+
+	/* The socket may have been closed, and reused, since the event */
+	len = zsock_recv(client->fd, recv_buf, sizeof(recv_buf), ZSOCK_MSG_DONTWAIT);
+	if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+		return;
+	}
+
+	if (len <= 0) {
+		client_close(client);
+		return;
+	}
+
+	(void)k_work_reschedule_for_queue(&http_server_work_q, &client->inactivity_timer,
+					  INACTIVITY_TIMEOUT);
+
+	parsed = http_parser_execute(&client->parser, &parser_settings, recv_buf, len);
+	err = HTTP_PARSER_ERRNO(&client->parser);
+	if (err == HPE_OK && parsed == (size_t)len) {
+		return;
+	}
+
+	if (err != HPE_PAUSED && !client->drop) {
+		LOG_DBG("Bad request from client %d: %s", client->fd, http_errno_name(err));
+
+		client->close = true;
+		client->head = false;
+		(void)response_send(client, HTTP_400_BAD_REQUEST, NULL, NULL, 0, false);
+	}
+
+	client_close(client);
+}
+
+static void server_accept(int idx)
+{
+	const struct http_service_desc *service = listen_services[idx];
+	struct http_client_ctx *client = NULL;
+	size_t count = 0;
+	int fd;
+
+	fd = zsock_accept(fds[idx].fd, NULL, NULL);
+	if (fd < 0) {
+		LOG_DBG("accept failed (%d)", -errno);
+		return;
+	}
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		if (clients[i].fd < 0) {
+			if (client == NULL) {
+				client = &clients[i];
+			}
+		} else if (clients[i].service == service) {
+			count++;
+		}
+	}
+
+	if (client == NULL || count >= service->concurrent) {
+		LOG_WRN("Dropping connection to %s, too many clients", service->host);
+		(void)zsock_close(fd);
+		return;
+	}
+
+	client->fd = fd;
+	client->service = service;
+	client->resource = NULL;
+	client->drop = false;
+	http_parser_init(&client->parser, HTTP_REQUEST);
+
+	fds[MAX_SERVICES + (client - clients)].fd = fd;
+	fds[MAX_SERVICES + (client - clients)].events = ZSOCK_POLLIN;
+
+	(void)k_work_reschedule_for_queue(&http_server_work_q, &client->inactivity_timer,
+					  INACTIVITY_TIMEOUT);
+	(void)net_socket_service_register(&http_service, fds, ARRAY_SIZE(fds), NULL);
+
+	LOG_DBG("Client %d connected to %s", fd, service->host);
+}
+
+static void http_server_cb(struct k_work *work)
+{
+	struct net_socket_service_event *pev =
+		CONTAINER_OF(work, struct net_socket_service_event, work);
+	struct http_client_ctx *client;
+	int i;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(fds); i++) {
+		if (fds[i].fd >= 0 && fds[i].fd == pev->event.fd) {
+			break;
+		}
+	}
+
+	if (!running || i == ARRAY_SIZE(fds)) {
+		goto out;
+	}
+
+	if (i < MAX_SERVICES) {
+		if (pev->event.revents & ZSOCK_POLLIN) {
+			server_accept(i);
+		}
+
+		goto out;
+	}
+
+	client = &clients[i - MAX_SERVICES];
+
+	if (pev->event.revents & ZSOCK_POLLIN) {
+		client_recv(client);
+	} else {
+		client_close(client);
+	}
+
+	if (client->fd < 0) {
+		(void)net_socket_service_register(&http_service, fds, ARRAY_SIZE(fds), NULL);
+	}
+
+out:
+	k_mutex_unlock(&lock);
+}
+
+static int service_listen(const struct http_service_desc *service)
+{
+	struct sockaddr_storage addr_storage = {0};
+	union {
+		struct sockaddr *addr;
+		struct sockaddr_in *addr4;
+		struct sockaddr_in6 *addr6;
+	} addr_ptrs = {
+		.addr = (struct sockaddr *)&addr_storage,
+	};
+	int optval = 1;
+	socklen_t len;
+	int ret;
+	int fd;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    zsock_inet_pton(AF_INET6, service->host, &addr_ptrs.addr6->sin6_addr) == 1) {
+		addr_ptrs.addr6->sin6_family = AF_INET6;
+		addr_ptrs.addr6->sin6_port = htons(*service->port);
+		len = sizeof(struct sockaddr_in6);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   zsock_inet_pton(AF_INET, service->host, &addr_ptrs.addr4->sin_addr) == 1) {
+		addr_ptrs.addr4->sin_family = AF_INET;
+		addr_ptrs.addr4->sin_port = htons(*service->port);
+		len = sizeof(struct sockaddr_in);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6)) {
+		/* A host name or a virtual host, listen on all the addresses */
+		addr_ptrs.addr6->sin6_family = AF_INET6;
+		addr_ptrs.addr6->sin6_port = htons(*service->port);
+		len = sizeof(struct sockaddr_in6);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4)) {
+		addr_ptrs.addr4->sin_family = AF_INET;
+		addr_ptrs.addr4->sin_port = htons(*service->port);
+		len = sizeof(struct sockaddr_in);
+	} else {
+		return -ENOTSUP;
+	}
+
+	fd = zsock_socket(addr_ptrs.addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	(void)zsock_setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+
+	if (zsock_bind(fd, addr_ptrs.addr, len) < 0 ||
+	    zsock_listen(fd, service->backlog) < 0) {
+		ret = -errno;
+		goto close;
+	}
+
+	if (*service->port == 0) {
+		/* ephemeral port - read back the port number */
+		len = sizeof(addr_storage);
+		if (zsock_getsockname(fd, addr_ptrs.addr, &len) < 0) {
+			ret = -errno;
+			goto close;
+		}
+
+		if (addr_ptrs.addr->sa_family == AF_INET6) {
+			*service->port = ntohs(addr_ptrs.addr6->sin6_port);
+		} else {
+			*service->port = ntohs(addr_ptrs.addr4->sin_port);
+		}
+	}
+
+	LOG_DBG("Service %s listening on port %u", service->host, *service->port);
+
+	return fd;
+
+close:
+	(void)zsock_close(fd);
+
+	return ret;
+}
+
+static void server_close_all(void)
+{
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		if (clients[i].fd >= 0) {
+			client_close(&clients[i]);
+		}
+	}
+
+	for (int i = 0; i < MAX_SERVICES; i++) {
+		if (fds[i].fd >= 0) {
+			(void)zsock_close(fds[i].fd);
+			fds[i].fd = -1;
+		}
+
+		listen_services[i] = NULL;
+	}
+}
+
+int http_server_start(void)
+{
+	int count = 0;
+	int ret = 0;
+	int fd;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (running) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	if (!work_q_started) {
+		k_work_queue_init(&http_server_work_q);
+		k_work_queue_start(&http_server_work_q, http_server_stack,
+				   K_THREAD_STACK_SIZEOF(http_server_stack),
+				   HTTP_SERVER_THREAD_PRIORITY, NULL);
+		k_thread_name_set(&http_server_work_q.thread, "http_server");
+
+		http_parser_settings_init(&parser_settings);
+		parser_settings.on_message_begin = on_message_begin;
+		parser_settings.on_url = on_url;
+		parser_settings.on_headers_complete = on_headers_complete;
+		parser_settings.on_body = on_body;
+		parser_settings.on_message_complete = on_message_complete;
+
+		for (int i = 0; i < MAX_CLIENTS; i++) {
+			k_work_init_delayable(&clients[i].inactivity_timer, client_timeout);
+		}
+
+		work_q_started = true;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(fds); i++) {
+		fds[i].fd = -1;
+	}
+
+	for (int i = 0; i < MAX_CLIENTS; i++) {
+		clients[i].fd = -1;
+	}
+
+	HTTP_SERVICE_FOREACH(service) {
+		if (count == MAX_SERVICES) {
+			LOG_ERR("Too many services, increase CONFIG_HTTP_SERVER_MAX_SERVICES");
+			ret = -ENOMEM;
+			goto error;
+		}
+
+		fd = service_listen(service);
+		if (fd < 0) {
+			LOG_ERR("Cannot listen on port %u of %s (%d)", *service->port,
+				service->host, fd);
+			ret = fd;
+			goto error;
+		}
+
+		listen_services[count] = service;
+		fds[count].fd = fd;
+		fds[count].events = ZSOCK_POLLIN;
+		count++;
+	}
+
+	ret = net_socket_service_register(&http_service, fds, ARRAY_SIZE(fds), NULL);
+	if (ret < 0) {
+		LOG_ERR("Cannot register socket service (%d)", ret);
+		goto error;
+	}
+
+	running = true;
+	goto out;
+
+error:
+	server_close_all();
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+int http_server_stop(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (!running) {
+		k_mutex_unlock(&lock);
+		return -EALREADY;
+	}
+
+	(void)net_socket_service_unregister(&http_service);
+	server_close_all();
+	running = false;
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
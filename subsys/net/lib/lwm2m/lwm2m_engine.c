@@ -591,17 +591,10 @@ static int64_t check_notifications(struct lwm2m_ctx *ctx, const int64_t timestam
 	int64_t next = INT64_MAX;
 
 	lwm2m_registry_lock();
-	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
-		if (!obs->event_timestamp) {
-			continue;
-		}
-
-		if (obs->event_timestamp < next) {
-			next = obs->event_timestamp;
-		}
-
+	/* Scheduled observers are ordered by deadline, stop at the first one not due */
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer_sched, obs, sched_node) {
 		if (timestamp < obs->event_timestamp) {
-			continue;
+			break;
 		}
 		/* Check That There is not pending process*/
 		if (obs->active_notify != NULL) {
@@ -611,18 +604,21 @@ static int64_t check_notifications(struct lwm2m_ctx *ctx, const int64_t timestam
 		rc = generate_notify_message(ctx, obs, NULL);
 		if (rc == -ENOMEM) {
 			/* no memory/messages available, retry later */
-			goto cleanup;
+			break;
 		}
-		obs->event_timestamp =
-			engine_observe_shedule_next_event(obs, ctx->srv_obj_inst, timestamp);
+		/* Rescheduling moves the observer, so the rest is handled on the next call */
+		engine_observe_event_set(ctx, obs,
+					 engine_observe_shedule_next_event(obs, ctx->srv_obj_inst,
+									   timestamp));
 		obs->last_timestamp = timestamp;
+		break;
+	}
 
-		if (!rc) {
-			/* create at most one notification */
-			goto cleanup;
-		}
+	obs = SYS_SLIST_PEEK_HEAD_CONTAINER(&ctx->observer_sched, obs, sched_node);
+	if (obs) {
+		next = obs->event_timestamp;
 	}
-cleanup:
+
 	lwm2m_registry_unlock();
 	return next;
 }
@@ -368,7 +368,7 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
 
 				if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
 					obs->resource_update = true;
-					obs->event_timestamp = timestamp;
+					engine_observe_event_set(sock_ctx[i], obs, timestamp);
 				}
 
 				LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id,
@@ -433,10 +433,9 @@ static void engine_observe_node_init(struct observe_node *obs, const uint8_t *to
 	obs->tkl = tkl;
 
 	obs->last_timestamp = k_uptime_get();
+	obs->event_timestamp = 0;
 	if (att_pmax) {
-		obs->event_timestamp = obs->last_timestamp + MSEC_PER_SEC * att_pmax;
-	} else {
-		obs->event_timestamp = 0;
+		engine_observe_event_set(ctx, obs, obs->last_timestamp + MSEC_PER_SEC * att_pmax);
 	}
 	obs->resource_update = false;
 	obs->active_notify = NULL;
@@ -720,6 +719,7 @@ void remove_observer_from_list(struct lwm2m_ctx *ctx, sys_snode_t *prev_node,
 		remove_observer_path_from_list(ctx, obs, o_p, NULL);
 	}
 	sys_slist_remove(&ctx->observer, prev_node, &obs->node);
+	engine_observe_event_set(ctx, obs, 0);
 	(void)memset(obs, 0, sizeof(*obs));
 }
 
@@ -916,7 +916,7 @@ const char *lwm2m_engine_get_attr_name(const struct lwm2m_attr *attr)
 	return LWM2M_ATTR_STR[attr->type];
 }
 
-static int lwm2m_engine_observer_timestamp_update(sys_slist_t *observer,
+static int lwm2m_engine_observer_timestamp_update(struct lwm2m_ctx *ctx,
 						  const struct lwm2m_obj_path *path,
 						  uint16_t srv_obj_inst)
 {
@@ -926,7 +926,7 @@ static int lwm2m_engine_observer_timestamp_update(sys_slist_t *observer,
 	int64_t timestamp;
 
 	/* update observe_node accordingly */
-	SYS_SLIST_FOR_EACH_CONTAINER(observer, obs, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
 		if (obs->resource_update) {
 			/* Resource Update on going skip this*/
 			continue;
@@ -950,7 +950,7 @@ static int lwm2m_engine_observer_timestamp_update(sys_slist_t *observer,
 			/* Disable Automatic Notify */
 			timestamp = 0;
 		}
-		obs->event_timestamp = timestamp;
+		engine_observe_event_set(ctx, obs, timestamp);
 
 		(void)memset(&nattrs, 0, sizeof(nattrs));
 	}
@@ -1103,7 +1103,7 @@ int lwm2m_update_observer_max_period(struct lwm2m_ctx *client_ctx,
 	}
 
 	/* Update Observer timestamp */
-	return lwm2m_engine_observer_timestamp_update(&client_ctx->observer, path,
+	return lwm2m_engine_observer_timestamp_update(client_ctx, path,
 						      client_ctx->srv_obj_inst);
 }
 
@@ -1370,7 +1370,7 @@ int lwm2m_write_attr_handler(struct lwm2m_engine_obj *obj, struct lwm2m_message
 		return 0;
 	}
 
-	lwm2m_engine_observer_timestamp_update(&msg->ctx->observer, &msg->path,
+	lwm2m_engine_observer_timestamp_update(msg->ctx, &msg->path,
 					       msg->ctx->srv_obj_inst);
 
 	return 0;
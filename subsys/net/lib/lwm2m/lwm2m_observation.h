@@ -14,6 +14,7 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path);
 
 struct observe_node {
 	sys_snode_t node;
+	sys_snode_t sched_node;              /* Node in the list of scheduled observers */
 	sys_slist_t path_list;               /* List of Observation path */
 	uint8_t token[MAX_TOKEN_LEN];        /* Observation Token */
 	int64_t event_timestamp;             /* Timestamp for trig next Notify  */
@@ -25,6 +26,41 @@ struct observe_node {
 	bool resource_update : 1;            /* Resource is updated */
 	bool composite : 1;                  /* Composite Observation */
 };
+/**
+ * @brief Set the time of the next notification of an observer
+ *
+ * Keeps the scheduled observers of @p ctx ordered by the time of their next
+ * notification, so the engine only looks at the ones that are due.
+ *
+ * @param ctx Client context of the observer.
+ * @param obs Observer.
+ * @param timestamp Time of the next notification, 0 for none.
+ */
+static inline void engine_observe_event_set(struct lwm2m_ctx *ctx, struct observe_node *obs,
+					    int64_t timestamp)
+{
+	struct observe_node *next;
+	sys_snode_t *prev = NULL;
+
+	if (obs->event_timestamp) {
+		(void)sys_slist_find_and_remove(&ctx->observer_sched, &obs->sched_node);
+	}
+
+	obs->event_timestamp = timestamp;
+	if (!timestamp) {
+		return;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer_sched, next, sched_node) {
+		if (next->event_timestamp > timestamp) {
+			break;
+		}
+		prev = &next->sched_node;
+	}
+
+	sys_slist_insert(&ctx->observer_sched, prev, &obs->sched_node);
+}
+
 /* Attribute handling. */
 
 struct lwm2m_attr *lwm2m_engine_get_next_attr(const void *ref, struct lwm2m_attr *prev);
@@ -89,6 +89,17 @@ static const struct default_obj_version default_obj_versions[] = {
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
 
+/* Object instances hashed by object and instance ID, for path lookups */
+#define OBJ_INST_INDEX_SIZE NHPOT(CONFIG_LWM2M_ENGINE_OBJ_INST_INDEX_SIZE)
+static sys_slist_t obj_inst_index[OBJ_INST_INDEX_SIZE];
+
+static sys_slist_t *obj_inst_index_bucket(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	uint32_t hash = ((uint32_t)obj_id * 31U) ^ obj_inst_id;
+
+	return &obj_inst_index[(hash ^ (hash >> 8)) & (OBJ_INST_INDEX_SIZE - 1)];
+}
+
 /* Resource wrappers */
 sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
@@ -145,6 +156,12 @@ struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_ob
 	int i;
 
 	if (obj && obj->fields && obj->field_count > 0) {
+		/* Fields are usually defined in the order of their IDs, from 0 */
+		if (res_id >= 0 && res_id < obj->field_count &&
+		    obj->fields[res_id].res_id == res_id) {
+			return &obj->fields[res_id];
+		}
+
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
@@ -176,6 +193,8 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_prepend(obj_inst_index_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			  &obj_inst->index_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,13 +204,21 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(obj_inst_index_bucket(obj_inst->obj->obj_id,
+							obj_inst->obj_inst_id),
+				  &obj_inst->index_node);
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
+	if (obj_id < 0 || obj_id > UINT16_MAX || obj_inst_id < 0 || obj_inst_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_index_bucket(obj_id, obj_inst_id), obj_inst,
+				     index_node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
@@ -427,10 +454,16 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
+	/* Resources are usually initialized in the order of the fields */
+	i = of - oi->obj->fields;
+	if (i < oi->resource_count && oi->resources[i].res_id == path->res_id) {
+		r = &oi->resources[i];
+	} else {
+		for (i = 0; i < oi->resource_count; i++) {
+			if (oi->resources[i].res_id == path->res_id) {
+				r = &oi->resources[i];
+				break;
+			}
 		}
 	}
 
@@ -49,6 +49,11 @@ struct cbor_out_fmt_data {
 	/* Basetime for Cached data timestamp */
 	time_t basetime;
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+	/* Number of records already encoded */
+	uint32_t records_streamed;
+#endif
+
 	/* Storage for object links */
 	struct {
 		char objlnk[CONFIG_LWM2M_RW_SENML_CBOR_RECORDS][sizeof("65535:65535")];
@@ -185,6 +190,63 @@ static int put_empty_array(struct lwm2m_output_context *out)
 	return len;
 }
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+#define CBOR_ARRAY_INDEFINITE 0x9f
+#define CBOR_BREAK 0xff
+
+/* Records are encoded as soon as they are complete, within an array of
+ * indefinite length, so a single record needs to be kept.
+ */
+static int put_begin(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+{
+	uint8_t start = CBOR_ARRAY_INDEFINITE;
+
+	return buf_append(CPKT_BUF_WRITE(out->out_cpkt), &start, sizeof(start));
+}
+
+static int flush_record(struct lwm2m_output_context *out)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	size_t len;
+
+	if (cbor_encode_lwm2m_senml_record(CPKT_BUF_W_REGION(out->out_cpkt),
+					   &fd->input.lwm2m_senml_record_m[0],
+					   &len) != ZCBOR_SUCCESS) {
+		LOG_ERR("unable to encode senml cbor record");
+		return -ENOMEM;
+	}
+
+	out->out_cpkt->offset += len;
+	fd->records_streamed++;
+
+	(void)memset(&fd->input.lwm2m_senml_record_m[0], 0, sizeof(struct record));
+	fd->input.lwm2m_senml_record_m_count = 0;
+	fd->name_cnt = 0;
+	fd->objlnk_cnt = 0;
+
+	return 0;
+}
+
+static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+{
+	uint8_t end = CBOR_BREAK;
+
+	if (!LWM2M_OFD_CBOR(out)->records_streamed) {
+		/* Replace the start of the array with an empty array */
+		out->out_cpkt->offset--;
+		return put_empty_array(out);
+	}
+
+	return buf_append(CPKT_BUF_WRITE(out->out_cpkt), &end, sizeof(end));
+}
+#else
+static int flush_record(struct lwm2m_output_context *out)
+{
+	ARG_UNUSED(out);
+
+	return 0;
+}
+
 static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
 	size_t len;
@@ -209,6 +271,7 @@ static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path
 
 	return len;
 }
+#endif /* CONFIG_LWM2M_RW_SENML_CBOR_STREAMING */
 
 static int put_begin_oi(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
@@ -376,7 +439,7 @@ static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	record->record_union.union_vi = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_s8(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int8_t value)
@@ -414,7 +477,7 @@ static int put_time(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 	record->record_union.union_vi = (int64_t)value;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, double *value)
@@ -432,7 +495,7 @@ static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	record->record_union.union_vf = *value;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -452,7 +515,7 @@ static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vs.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, bool value)
@@ -470,7 +533,7 @@ static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 	record->record_union.union_vb = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -490,7 +553,7 @@ static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vd.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
@@ -529,7 +592,7 @@ static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 
 	fd->objlnk_cnt++;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int get_opaque(struct lwm2m_input_context *in,
@@ -778,6 +841,9 @@ static int do_write_op_item(struct lwm2m_message *msg, struct record *rec)
 }
 
 const struct lwm2m_writer senml_cbor_writer = {
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+	.put_begin = put_begin,
+#endif
 	.put_end = put_end,
 	.put_begin_oi = put_begin_oi,
 	.put_begin_r = put_begin_r,
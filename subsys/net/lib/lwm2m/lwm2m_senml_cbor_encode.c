@@ -282,3 +282,13 @@ int cbor_encode_lwm2m_senml(uint8_t *payload, size_t payload_len, const struct l
 				    (zcbor_decoder_t *)encode_lwm2m_senml,
 				    sizeof(states) / sizeof(zcbor_state_t), 1);
 }
+
+int cbor_encode_lwm2m_senml_record(uint8_t *payload, size_t payload_len, const struct record *input,
+				   size_t *payload_len_out)
+{
+	zcbor_state_t states[4];
+
+	return zcbor_entry_function(payload, payload_len, (void *)input, payload_len_out, states,
+				    (zcbor_decoder_t *)encode_record,
+				    sizeof(states) / sizeof(zcbor_state_t), 1);
+}
@@ -27,6 +27,155 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.remaining_payload = 0U;
 }
 
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0
+static uint16_t *inflight_find(struct mqtt_client *client, uint16_t message_id)
+{
+	for (int i = 0; i < CONFIG_MQTT_PUBLISH_INFLIGHT_MAX; i++) {
+		if (client->internal.inflight[i] == message_id) {
+			return &client->internal.inflight[i];
+		}
+	}
+
+	return NULL;
+}
+
+/** @brief Start tracking a publication, return the entry if it is a new one. */
+static int inflight_add(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			uint16_t **entry)
+{
+	*entry = NULL;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	if (param->message_id == 0U) {
+		return -EINVAL;
+	}
+
+	if (inflight_find(client, param->message_id) != NULL) {
+		/* Retransmission of a publication in flight */
+		return param->dup_flag ? 0 : -EBUSY;
+	}
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (client->protocol_version == MQTT_VERSION_5_0) {
+		uint16_t count = 0U;
+
+		for (int i = 0; i < CONFIG_MQTT_PUBLISH_INFLIGHT_MAX; i++) {
+			count += (client->internal.inflight[i] != 0U) ? 1U : 0U;
+		}
+
+		/* Flow control, MQTT 5.0 section 4.9 */
+		if (count >= client->internal.receive_maximum) {
+			return -EAGAIN;
+		}
+	}
+#endif
+
+	*entry = inflight_find(client, 0U);
+	if (*entry == NULL) {
+		return -EAGAIN;
+	}
+
+	**entry = param->message_id;
+
+	return 0;
+}
+
+void mqtt_inflight_remove(struct mqtt_client *client, uint16_t message_id)
+{
+	uint16_t *entry;
+
+	if (message_id == 0U) {
+		return;
+	}
+
+	entry = inflight_find(client, message_id);
+	if (entry != NULL) {
+		*entry = 0U;
+	}
+}
+#else
+void mqtt_inflight_remove(struct mqtt_client *client, uint16_t message_id)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(message_id);
+}
+#endif /* CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0 */
+
+#if defined(CONFIG_MQTT_VERSION_5_0) && (CONFIG_MQTT_TOPIC_ALIAS_MAX > 0)
+/** @brief Get the alias of a topic, or the alias to set up for it, 0 for none. */
+static uint16_t topic_alias_get(const struct mqtt_client *client,
+				const struct mqtt_utf8 *topic, bool *alias_only)
+{
+	uint16_t count = client->internal.topic_alias_count;
+
+	*alias_only = false;
+
+	for (uint16_t i = 0U; i < count; i++) {
+		if (client->internal.topic_aliases[i].size == topic->size &&
+		    memcmp(client->internal.topic_aliases[i].topic, topic->utf8,
+			   topic->size) == 0) {
+			*alias_only = true;
+			return i + 1U;
+		}
+	}
+
+	if (topic->size == 0U || topic->size > CONFIG_MQTT_TOPIC_ALIAS_TOPIC_SIZE ||
+	    count >= client->internal.topic_alias_maximum) {
+		return 0U;
+	}
+
+	return count + 1U;
+}
+
+static void topic_alias_set(struct mqtt_client *client, uint16_t alias,
+			    const struct mqtt_utf8 *topic)
+{
+	memcpy(client->internal.topic_aliases[alias - 1U].topic, topic->utf8,
+	       topic->size);
+	client->internal.topic_aliases[alias - 1U].size = topic->size;
+	client->internal.topic_alias_count = alias;
+}
+#endif
+
+static int client_publish_encode(struct mqtt_client *client,
+				 const struct mqtt_publish_param *param,
+				 struct buf_ctx *packet)
+{
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (client->protocol_version == MQTT_VERSION_5_0) {
+		const struct mqtt_utf8 *topic = &param->message.topic.topic;
+		uint16_t alias = 0U;
+		bool alias_only = false;
+		int err_code;
+
+#if CONFIG_MQTT_TOPIC_ALIAS_MAX > 0
+		alias = topic_alias_get(client, topic, &alias_only);
+#endif
+
+		err_code = publish_encode_5(param, alias, alias_only, packet);
+
+#if CONFIG_MQTT_TOPIC_ALIAS_MAX > 0
+		/* A failure to send drops the connection, and its aliases */
+		if (err_code == 0 && alias != 0U && !alias_only) {
+			topic_alias_set(client, alias, topic);
+		}
+#else
+		ARG_UNUSED(topic);
+#endif
+
+		return err_code;
+	}
+#endif
+
+	ARG_UNUSED(client);
+
+	return publish_encode(param, packet);
+}
+
 /** @brief Initialize tx buffer. */
 static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
 {
@@ -83,6 +232,22 @@ static int client_connect(struct mqtt_client *client)
 	tx_buf_init(client, &packet);
 	MQTT_SET_STATE(client, MQTT_STATE_TCP_CONNECTED);
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	/* Broker limits and topic aliases only hold for a connection */
+	client->internal.receive_maximum = UINT16_MAX;
+	client->internal.topic_alias_maximum = 0U;
+#if CONFIG_MQTT_TOPIC_ALIAS_MAX > 0
+	client->internal.topic_alias_count = 0U;
+#endif
+#endif
+
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0
+	/* Publications in flight only survive with a persistent session */
+	if (client->clean_session) {
+		memset(client->internal.inflight, 0, sizeof(client->internal.inflight));
+	}
+#endif
+
 	err_code = connect_request_encode(client, &packet);
 	if (err_code < 0) {
 		goto error;
@@ -243,6 +408,9 @@ int mqtt_publish(struct mqtt_client *client,
 	struct buf_ctx packet;
 	struct iovec io_vector[2];
 	struct msghdr msg;
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0
+	uint16_t *inflight;
+#endif
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -261,11 +429,18 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
-	err_code = publish_encode(param, &packet);
+	err_code = client_publish_encode(client, param, &packet);
 	if (err_code < 0) {
 		goto error;
 	}
 
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0
+	err_code = inflight_add(client, param, &inflight);
+	if (err_code < 0) {
+		goto error;
+	}
+#endif
+
 	io_vector[0].iov_base = packet.cur;
 	io_vector[0].iov_len = packet.end - packet.cur;
 	io_vector[1].iov_base = param->message.payload.data;
@@ -278,6 +453,12 @@ int mqtt_publish(struct mqtt_client *client,
 
 	err_code = client_write_msg(client, &msg);
 
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0
+	if (err_code < 0 && inflight != NULL) {
+		*inflight = 0U;
+	}
+#endif
+
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
 			 client, client->internal.state, err_code);
@@ -494,7 +675,15 @@ int mqtt_subscribe(struct mqtt_client *client,
 		goto error;
 	}
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (client->protocol_version == MQTT_VERSION_5_0) {
+		err_code = subscribe_encode_5(param, &packet);
+	} else {
+		err_code = subscribe_encode(param, &packet);
+	}
+#else
 	err_code = subscribe_encode(param, &packet);
+#endif
 	if (err_code < 0) {
 		goto error;
 	}
@@ -528,7 +717,15 @@ int mqtt_unsubscribe(struct mqtt_client *client,
 		goto error;
 	}
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (client->protocol_version == MQTT_VERSION_5_0) {
+		err_code = unsubscribe_encode_5(param, &packet);
+	} else {
+		err_code = unsubscribe_encode(param, &packet);
+	}
+#else
 	err_code = unsubscribe_encode(param, &packet);
+#endif
 	if (err_code < 0) {
 		goto error;
 	}
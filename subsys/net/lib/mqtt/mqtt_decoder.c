@@ -188,6 +188,135 @@ static int packet_length_decode(struct buf_ctx *buf, uint32_t *length)
 	return 0;
 }
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/**@brief Skip the properties of an MQTT 5.0 packet.
+ *
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position, set after the properties on return.
+ * @param[out] length Length of the properties, with their Property Length.
+ *                    May be NULL.
+ *
+ * @retval 0 if the procedure is successful.
+ * @retval -EINVAL if the buffer would be exceeded during the read.
+ */
+static int properties_skip(struct buf_ctx *buf, uint32_t *length)
+{
+	uint8_t *start = buf->cur;
+	uint32_t prop_length;
+	int err_code;
+
+	err_code = packet_length_decode(buf, &prop_length);
+	if (err_code != 0) {
+		return -EINVAL;
+	}
+
+	if ((buf->end - buf->cur) < prop_length) {
+		return -EINVAL;
+	}
+
+	buf->cur += prop_length;
+
+	if (length != NULL) {
+		*length = buf->cur - start;
+	}
+
+	return 0;
+}
+
+/**@brief Decode the CONNACK properties used by the client, skip the others.
+ *
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position.
+ * @param[out] param Connect Ack parameters to update.
+ *
+ * @retval 0 if the procedure is successful.
+ * @retval -EINVAL if the properties are malformed.
+ */
+static int connect_ack_properties_decode(struct buf_ctx *buf,
+					 struct mqtt_connack_param *param)
+{
+	struct mqtt_utf8 str;
+	uint32_t prop_length;
+	uint8_t *end;
+	uint8_t id;
+	uint16_t u16;
+	uint8_t u8;
+	int err_code;
+
+	/* Defaults when the properties are absent */
+	param->receive_maximum = UINT16_MAX;
+	param->topic_alias_maximum = 0U;
+
+	err_code = packet_length_decode(buf, &prop_length);
+	if (err_code != 0 || (buf->end - buf->cur) < prop_length) {
+		return -EINVAL;
+	}
+
+	end = buf->cur + prop_length;
+
+	while (buf->cur < end) {
+		err_code = unpack_uint8(buf, &id);
+		if (err_code != 0) {
+			return err_code;
+		}
+
+		switch (id) {
+		case MQTT_PROP_RECEIVE_MAXIMUM:
+			err_code = unpack_uint16(buf, &param->receive_maximum);
+			break;
+		case MQTT_PROP_TOPIC_ALIAS_MAXIMUM:
+			err_code = unpack_uint16(buf, &param->topic_alias_maximum);
+			break;
+		/* Byte properties */
+		case 0x24: /* Maximum QoS */
+		case 0x25: /* Retain Available */
+		case 0x28: /* Wildcard Subscription Available */
+		case 0x29: /* Subscription Identifier Available */
+		case 0x2A: /* Shared Subscription Available */
+			err_code = unpack_uint8(buf, &u8);
+			break;
+		/* Two Byte Integer properties */
+		case 0x13: /* Server Keep Alive */
+			err_code = unpack_uint16(buf, &u16);
+			break;
+		/* Four Byte Integer properties */
+		case 0x11: /* Session Expiry Interval */
+		case 0x27: /* Maximum Packet Size */
+			if ((buf->end - buf->cur) < sizeof(uint32_t)) {
+				return -EINVAL;
+			}
+			buf->cur += sizeof(uint32_t);
+			break;
+		/* UTF-8 String and Binary Data properties */
+		case 0x12: /* Assigned Client Identifier */
+		case 0x15: /* Authentication Method */
+		case 0x16: /* Authentication Data */
+		case 0x1A: /* Response Information */
+		case 0x1C: /* Server Reference */
+		case 0x1F: /* Reason String */
+			err_code = unpack_utf8_str(buf, &str);
+			break;
+		/* UTF-8 String Pair properties */
+		case 0x26: /* User Property */
+			err_code = unpack_utf8_str(buf, &str);
+			if (err_code == 0) {
+				err_code = unpack_utf8_str(buf, &str);
+			}
+			break;
+		default:
+			NET_ERR("Unexpected CONNACK property 0x%02x", id);
+			return -EINVAL;
+		}
+
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
+	return buf->cur == end ? 0 : -EINVAL;
+}
+#endif /* CONFIG_MQTT_VERSION_5_0 */
+
 int fixed_header_decode(struct buf_ctx *buf, uint8_t *type_and_flags,
 			uint32_t *length)
 {
@@ -217,7 +346,8 @@ int connect_ack_decode(const struct mqtt_client *client, struct buf_ctx *buf,
 		return err_code;
 	}
 
-	if (client->protocol_version == MQTT_VERSION_3_1_1) {
+	if (client->protocol_version == MQTT_VERSION_3_1_1 ||
+	    client->protocol_version == MQTT_VERSION_5_0) {
 		param->session_present_flag =
 			flags & MQTT_CONNACK_FLAG_SESSION_PRESENT;
 
@@ -227,11 +357,17 @@ int connect_ack_decode(const struct mqtt_client *client, struct buf_ctx *buf,
 
 	param->return_code = (enum mqtt_conn_return_code)ret_code;
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (client->protocol_version == MQTT_VERSION_5_0) {
+		return connect_ack_properties_decode(buf, param);
+	}
+#endif
+
 	return 0;
 }
 
-int publish_decode(uint8_t flags, uint32_t var_length, struct buf_ctx *buf,
-		   struct mqtt_publish_param *param)
+static int publish_decode_common(uint8_t flags, uint32_t var_length, bool version_5,
+				 struct buf_ctx *buf, struct mqtt_publish_param *param)
 {
 	int err_code;
 	uint32_t var_header_length;
@@ -256,6 +392,21 @@ int publish_decode(uint8_t flags, uint32_t var_length, struct buf_ctx *buf,
 		var_header_length += sizeof(uint16_t);
 	}
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (version_5) {
+		uint32_t prop_length;
+
+		err_code = properties_skip(buf, &prop_length);
+		if (err_code != 0) {
+			return err_code;
+		}
+
+		var_header_length += prop_length;
+	}
+#else
+	ARG_UNUSED(version_5);
+#endif
+
 	if (var_length < var_header_length) {
 		NET_ERR("Corrupted PUBLISH message, header length (%u) larger "
 			 "than total length (%u)", var_header_length,
@@ -269,6 +420,20 @@ int publish_decode(uint8_t flags, uint32_t var_length, struct buf_ctx *buf,
 	return 0;
 }
 
+int publish_decode(uint8_t flags, uint32_t var_length, struct buf_ctx *buf,
+		   struct mqtt_publish_param *param)
+{
+	return publish_decode_common(flags, var_length, false, buf, param);
+}
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int publish_decode_5(uint8_t flags, uint32_t var_length, struct buf_ctx *buf,
+		     struct mqtt_publish_param *param)
+{
+	return publish_decode_common(flags, var_length, true, buf, param);
+}
+#endif
+
 int publish_ack_decode(struct buf_ctx *buf, struct mqtt_puback_param *param)
 {
 	return unpack_uint16(buf, &param->message_id);
@@ -302,6 +467,26 @@ int subscribe_ack_decode(struct buf_ctx *buf, struct mqtt_suback_param *param)
 	return unpack_data(buf->end - buf->cur, buf, &param->return_codes);
 }
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int subscribe_ack_decode_5(struct buf_ctx *buf, struct mqtt_suback_param *param)
+{
+	int err_code;
+
+	err_code = unpack_uint16(buf, &param->message_id);
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	err_code = properties_skip(buf, NULL);
+	if (err_code != 0) {
+		return err_code;
+	}
+
+	/* The reason codes below 0x80 are the granted QoS, as in MQTT 3.1.1 */
+	return unpack_data(buf->end - buf->cur, buf, &param->return_codes);
+}
+#endif
+
 int unsubscribe_ack_decode(struct buf_ctx *buf,
 			   struct mqtt_unsuback_param *param)
 {
@@ -277,7 +277,8 @@ int connect_request_encode(const struct mqtt_client *client,
 	int err_code;
 	uint8_t *start;
 
-	if (client->protocol_version == MQTT_VERSION_3_1_1) {
+	if (client->protocol_version == MQTT_VERSION_3_1_1 ||
+	    client->protocol_version == MQTT_VERSION_5_0) {
 		mqtt_proto_desc = &mqtt_3_1_1_proto_desc;
 	} else {
 		mqtt_proto_desc = &mqtt_3_1_0_proto_desc;
@@ -317,6 +318,14 @@ int connect_request_encode(const struct mqtt_client *client,
 		return err_code;
 	}
 
+	if (client->protocol_version == MQTT_VERSION_5_0) {
+		/* No CONNECT properties */
+		err_code = pack_uint8(0, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
 	NET_HEXDUMP_DBG(client->client_id.utf8, client->client_id.size,
 			 "Encoding Client Id.");
 	err_code = pack_utf8_str(&client->client_id, buf);
@@ -331,6 +340,14 @@ int connect_request_encode(const struct mqtt_client *client,
 		connect_flags |= ((client->will_topic->qos & 0x03) << 3);
 		connect_flags |= client->will_retain << 5;
 
+		if (client->protocol_version == MQTT_VERSION_5_0) {
+			/* No Will properties */
+			err_code = pack_uint8(0, buf);
+			if (err_code != 0) {
+				return err_code;
+			}
+		}
+
 		NET_HEXDUMP_DBG(client->will_topic->topic.utf8,
 				 client->will_topic->topic.size,
 				 "Encoding Will Topic.");
@@ -388,7 +405,9 @@ int connect_request_encode(const struct mqtt_client *client,
 	return mqtt_encode_fixed_header(message_type, start, buf);
 }
 
-int publish_encode(const struct mqtt_publish_param *param, struct buf_ctx *buf)
+static int publish_encode_common(const struct mqtt_publish_param *param, bool version_5,
+				 uint16_t topic_alias, bool alias_only,
+				 struct buf_ctx *buf)
 {
 	const uint8_t message_type = MQTT_MESSAGES_OPTIONS(
 			MQTT_PKT_TYPE_PUBLISH, param->dup_flag,
@@ -405,7 +424,11 @@ int publish_encode(const struct mqtt_publish_param *param, struct buf_ctx *buf)
 	buf->cur += MQTT_FIXED_HEADER_MAX_SIZE;
 	start = buf->cur;
 
-	err_code = pack_utf8_str(&param->message.topic.topic, buf);
+	if (alias_only) {
+		err_code = zero_len_str_encode(buf);
+	} else {
+		err_code = pack_utf8_str(&param->message.topic.topic, buf);
+	}
 	if (err_code != 0) {
 		return err_code;
 	}
@@ -417,6 +440,26 @@ int publish_encode(const struct mqtt_publish_param *param, struct buf_ctx *buf)
 		}
 	}
 
+	if (version_5) {
+		/* Property Length, then the Topic Alias if any */
+		err_code = pack_uint8(topic_alias != 0U ? 3U : 0U, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+
+		if (topic_alias != 0U) {
+			err_code = pack_uint8(MQTT_PROP_TOPIC_ALIAS, buf);
+			if (err_code != 0) {
+				return err_code;
+			}
+
+			err_code = pack_uint16(topic_alias, buf);
+			if (err_code != 0) {
+				return err_code;
+			}
+		}
+	}
+
 	/* Do not copy payload. We move the buffer pointer to ensure that
 	 * message length in fixed header is encoded correctly.
 	 */
@@ -432,6 +475,19 @@ int publish_encode(const struct mqtt_publish_param *param, struct buf_ctx *buf)
 	return 0;
 }
 
+int publish_encode(const struct mqtt_publish_param *param, struct buf_ctx *buf)
+{
+	return publish_encode_common(param, false, 0U, false, buf);
+}
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int publish_encode_5(const struct mqtt_publish_param *param, uint16_t topic_alias,
+		     bool alias_only, struct buf_ctx *buf)
+{
+	return publish_encode_common(param, true, topic_alias, alias_only, buf);
+}
+#endif
+
 int publish_ack_encode(const struct mqtt_puback_param *param,
 		       struct buf_ctx *buf)
 {
@@ -480,8 +536,8 @@ int disconnect_encode(struct buf_ctx *buf)
 	return 0;
 }
 
-int subscribe_encode(const struct mqtt_subscription_list *param,
-		     struct buf_ctx *buf)
+static int subscribe_encode_common(const struct mqtt_subscription_list *param,
+				   bool version_5, struct buf_ctx *buf)
 {
 	const uint8_t message_type = MQTT_MESSAGES_OPTIONS(
 			MQTT_PKT_TYPE_SUBSCRIBE, 0, 1, 0);
@@ -502,12 +558,21 @@ int subscribe_encode(const struct mqtt_subscription_list *param,
 		return err_code;
 	}
 
+	if (version_5) {
+		/* No SUBSCRIBE properties */
+		err_code = pack_uint8(0, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
 	for (i = 0; i < param->list_count; i++) {
 		err_code = pack_utf8_str(&param->list[i].topic, buf);
 		if (err_code != 0) {
 			return err_code;
 		}
 
+		/* The QoS is in the same bits of the MQTT 5.0 subscription options */
 		err_code = pack_uint8(param->list[i].qos, buf);
 		if (err_code != 0) {
 			return err_code;
@@ -517,8 +582,22 @@ int subscribe_encode(const struct mqtt_subscription_list *param,
 	return mqtt_encode_fixed_header(message_type, start, buf);
 }
 
-int unsubscribe_encode(const struct mqtt_subscription_list *param,
+int subscribe_encode(const struct mqtt_subscription_list *param,
+		     struct buf_ctx *buf)
+{
+	return subscribe_encode_common(param, false, buf);
+}
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int subscribe_encode_5(const struct mqtt_subscription_list *param,
 		       struct buf_ctx *buf)
+{
+	return subscribe_encode_common(param, true, buf);
+}
+#endif
+
+static int unsubscribe_encode_common(const struct mqtt_subscription_list *param,
+				     bool version_5, struct buf_ctx *buf)
 {
 	const uint8_t message_type = MQTT_MESSAGES_OPTIONS(
 		MQTT_PKT_TYPE_UNSUBSCRIBE, 0, MQTT_QOS_1_AT_LEAST_ONCE, 0);
@@ -534,6 +613,14 @@ int unsubscribe_encode(const struct mqtt_subscription_list *param,
 		return err_code;
 	}
 
+	if (version_5) {
+		/* No UNSUBSCRIBE properties */
+		err_code = pack_uint8(0, buf);
+		if (err_code != 0) {
+			return err_code;
+		}
+	}
+
 	for (i = 0; i < param->list_count; i++) {
 		err_code = pack_utf8_str(&param->list[i].topic, buf);
 		if (err_code != 0) {
@@ -544,6 +631,20 @@ int unsubscribe_encode(const struct mqtt_subscription_list *param,
 	return mqtt_encode_fixed_header(message_type, start, buf);
 }
 
+int unsubscribe_encode(const struct mqtt_subscription_list *param,
+		       struct buf_ctx *buf)
+{
+	return unsubscribe_encode_common(param, false, buf);
+}
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+int unsubscribe_encode_5(const struct mqtt_subscription_list *param,
+			 struct buf_ctx *buf)
+{
+	return unsubscribe_encode_common(param, true, buf);
+}
+#endif
+
 int ping_request_encode(struct buf_ctx *buf)
 {
 	if (buf->end - buf->cur < sizeof(ping_packet)) {
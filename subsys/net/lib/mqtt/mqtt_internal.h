@@ -69,6 +69,11 @@ extern "C" {
 
 #define MQTT_CONNACK_FLAG_SESSION_PRESENT 0x01
 
+/**@brief MQTT 5.0 property identifiers used by the client. */
+#define MQTT_PROP_RECEIVE_MAXIMUM     0x21
+#define MQTT_PROP_TOPIC_ALIAS_MAXIMUM 0x22
+#define MQTT_PROP_TOPIC_ALIAS         0x23
+
 /**@brief Maximum payload size of MQTT packet. */
 #define MQTT_MAX_PAYLOAD_SIZE 0x0FFFFFFF
 
@@ -154,6 +159,13 @@ enum mqtt_state {
  */
 void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
 
+/**@brief Stops tracking a QoS 1 or 2 publication, once acknowledged.
+ *
+ * @param[in] client Identifies the client which published the message.
+ * @param[in] message_id Message ID of the publication.
+ */
+void mqtt_inflight_remove(struct mqtt_client *client, uint16_t message_id);
+
 /**@brief Handles MQTT messages received from the peer.
  *
  * @param[in] client Identifies the client for which the data was received.
@@ -191,6 +203,24 @@ int connect_request_encode(const struct mqtt_client *client,
  */
 int publish_encode(const struct mqtt_publish_param *param, struct buf_ctx *buf);
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/**@brief Constructs/encodes MQTT 5.0 Publish packet.
+ *
+ * @param[in] param Publish message parameters.
+ * @param[in] topic_alias Topic Alias property, 0 to leave it out.
+ * @param[in] alias_only Leave the topic name out, the broker knows the topic
+ *                       of the alias already.
+ * @param[inout] buf_ctx Pointer to the buffer context structure,
+ *                       containing buffer for the encoded message.
+ *                       As output points to the beginning and end of
+ *                       the frame.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int publish_encode_5(const struct mqtt_publish_param *param, uint16_t topic_alias,
+		     bool alias_only, struct buf_ctx *buf);
+#endif
+
 /**@brief Constructs/encodes Publish Ack packet.
  *
  * @param[in] param Publish Ack message parameters.
@@ -267,6 +297,21 @@ int disconnect_encode(struct buf_ctx *buf);
 int subscribe_encode(const struct mqtt_subscription_list *param,
 		     struct buf_ctx *buf);
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/**@brief Constructs/encodes MQTT 5.0 Subscribe packet, without properties.
+ *
+ * @param[in] param Subscribe message parameters.
+ * @param[inout] buf_ctx Pointer to the buffer context structure,
+ *                       containing buffer for the encoded message.
+ *                       As output points to the beginning and end of
+ *                       the frame.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int subscribe_encode_5(const struct mqtt_subscription_list *param,
+		       struct buf_ctx *buf);
+#endif
+
 /**@brief Constructs/encodes Unsubscribe packet.
  *
  * @param[in] param Unsubscribe message parameters.
@@ -280,6 +325,21 @@ int subscribe_encode(const struct mqtt_subscription_list *param,
 int unsubscribe_encode(const struct mqtt_subscription_list *param,
 		       struct buf_ctx *buf);
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/**@brief Constructs/encodes MQTT 5.0 Unsubscribe packet, without properties.
+ *
+ * @param[in] param Unsubscribe message parameters.
+ * @param[inout] buf_ctx Pointer to the buffer context structure,
+ *                       containing buffer for the encoded message.
+ *                       As output points to the beginning and end of
+ *                       the frame.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int unsubscribe_encode_5(const struct mqtt_subscription_list *param,
+			 struct buf_ctx *buf);
+#endif
+
 /**@brief Constructs/encodes Ping Request packet.
  *
  * @param[inout] buf_ctx Pointer to the buffer context structure,
@@ -328,6 +388,21 @@ int connect_ack_decode(const struct mqtt_client *client, struct buf_ctx *buf,
 int publish_decode(uint8_t flags, uint32_t var_length, struct buf_ctx *buf,
 		   struct mqtt_publish_param *param);
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/**@brief Decode MQTT 5.0 Publish packet, skipping its properties.
+ *
+ * @param[in] flags Byte containing message type and flags.
+ * @param[in] var_length Length of the variable part of the message.
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position.
+ * @param[out] param Pointer to buffer for decoded Publish parameters.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int publish_decode_5(uint8_t flags, uint32_t var_length, struct buf_ctx *buf,
+		     struct mqtt_publish_param *param);
+#endif
+
 /**@brief Decode MQTT Publish Ack packet.
  *
  * @param[inout] buf A pointer to the buf_ctx structure containing current
@@ -382,6 +457,19 @@ int publish_complete_decode(struct buf_ctx *buf,
 int subscribe_ack_decode(struct buf_ctx *buf,
 			 struct mqtt_suback_param *param);
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/**@brief Decode MQTT 5.0 Subscribe packet, skipping its properties.
+ *
+ * @param[inout] buf A pointer to the buf_ctx structure containing current
+ *                   buffer position.
+ * @param[out] param Pointer to buffer for decoded Subscribe parameters.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int subscribe_ack_decode_5(struct buf_ctx *buf,
+			   struct mqtt_suback_param *param);
+#endif
+
 /**@brief Decode MQTT Unsubscribe packet.
  *
  * @param[inout] buf A pointer to the buf_ctx structure containing current
@@ -42,6 +42,16 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 						MQTT_CONNECTION_ACCEPTED) {
 				/* Set state. */
 				MQTT_SET_STATE(client, MQTT_STATE_CONNECTED);
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+				if (client->protocol_version == MQTT_VERSION_5_0) {
+					client->internal.receive_maximum =
+						evt.param.connack.receive_maximum;
+					client->internal.topic_alias_maximum =
+						MIN(evt.param.connack.topic_alias_maximum,
+						    CONFIG_MQTT_TOPIC_ALIAS_MAX);
+				}
+#endif
 			} else {
 				err_code = -ECONNREFUSED;
 			}
@@ -57,8 +67,18 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		NET_DBG("[CID %p]: Received MQTT_PKT_TYPE_PUBLISH", client);
 
 		evt.type = MQTT_EVT_PUBLISH;
+#if defined(CONFIG_MQTT_VERSION_5_0)
+		if (client->protocol_version == MQTT_VERSION_5_0) {
+			err_code = publish_decode_5(type_and_flags, var_length, buf,
+						    &evt.param.publish);
+		} else {
+			err_code = publish_decode(type_and_flags, var_length, buf,
+						  &evt.param.publish);
+		}
+#else
 		err_code = publish_decode(type_and_flags, var_length, buf,
 					  &evt.param.publish);
+#endif
 		evt.result = err_code;
 
 		client->internal.remaining_payload =
@@ -77,6 +97,9 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+		if (err_code == 0) {
+			mqtt_inflight_remove(client, evt.param.puback.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -101,13 +124,24 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+		if (err_code == 0) {
+			mqtt_inflight_remove(client, evt.param.pubcomp.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
 		NET_DBG("[CID %p]: Received MQTT_PKT_TYPE_SUBACK!", client);
 
 		evt.type = MQTT_EVT_SUBACK;
+#if defined(CONFIG_MQTT_VERSION_5_0)
+		if (client->protocol_version == MQTT_VERSION_5_0) {
+			err_code = subscribe_ack_decode_5(buf, &evt.param.suback);
+		} else {
+			err_code = subscribe_ack_decode(buf, &evt.param.suback);
+		}
+#else
 		err_code = subscribe_ack_decode(buf, &evt.param.suback);
+#endif
 		evt.result = err_code;
 		break;
 
@@ -132,6 +166,18 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PINGRESP;
 		break;
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	case MQTT_PKT_TYPE_DISCONNECT:
+		NET_DBG("[CID %p]: Received MQTT_PKT_TYPE_DISCONNECT!", client);
+
+		/* An MQTT 5.0 broker closes the connection, the application is
+		 * notified by the disconnection.
+		 */
+		notify_event = false;
+		err_code = -ECONNRESET;
+		break;
+#endif
+
 	default:
 		/* Nothing to notify. */
 		notify_event = false;
@@ -225,6 +271,38 @@ static int mqtt_read_publish_var_header(struct mqtt_client *client,
 		return err_code;
 	}
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (client->protocol_version == MQTT_VERSION_5_0) {
+		uint32_t prop_length = 0U;
+		uint8_t shift = 0U;
+		uint8_t byte;
+
+		/* Read the Property Length byte by byte, then the properties. */
+		do {
+			if (shift >= MQTT_MAX_LENGTH_BYTES * MQTT_LENGTH_SHIFT) {
+				return -EINVAL;
+			}
+
+			variable_header_length++;
+			err_code = mqtt_read_message_chunk(client, buf,
+							   variable_header_length);
+			if (err_code < 0) {
+				return err_code;
+			}
+
+			byte = buf->cur[variable_header_length - 1];
+			prop_length |= (uint32_t)(byte & MQTT_LENGTH_VALUE_MASK) << shift;
+			shift += MQTT_LENGTH_SHIFT;
+		} while ((byte & MQTT_LENGTH_CONTINUATION_BIT) != 0U);
+
+		err_code = mqtt_read_message_chunk(client, buf,
+						   variable_header_length + prop_length);
+		if (err_code < 0) {
+			return err_code;
+		}
+	}
+#endif
+
 	return 0;
 }
 
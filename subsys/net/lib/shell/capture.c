@@ -65,6 +65,8 @@ static void capture_cb(struct net_capture_info *info, void *user_data)
 	   (net_if_get_by_iface(info->capture_iface) + '0') : '-',
 	   net_if_get_by_iface(info->tunnel_iface),
 	   addr_local, addr_peer);
+	PR("\tcaptured %u  filtered %u  dropped %u\n", info->captured,
+	   info->filtered, info->dropped);
 
 	(*count)++;
 }
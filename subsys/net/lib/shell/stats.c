@@ -541,6 +541,9 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	PR("Bytes received %u\n", GET_STAT(iface, bytes.received));
 	PR("Bytes sent     %u\n", GET_STAT(iface, bytes.sent));
 	PR("Processing err %d\n", GET_STAT(iface, processing_error));
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+	PR("RX quota drop  %d\n", GET_STAT(iface, rx_quota_drop));
+#endif
 
 	print_tc_tx_stats(sh, iface);
 	print_tc_rx_stats(sh, iface);
@@ -875,6 +875,72 @@ ssize_t z_vrfy_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 #include <syscalls/zsock_sendto_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+ssize_t zsock_send_fill(int sock, size_t len, int flags,
+			zsock_fill_cb_t fill, void *user_data)
+{
+	const struct socket_op_vtable *vtable;
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	int status;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Only native TCP lets the data be produced into its send buffers */
+	if (vtable != &sock_fd_op_vtable ||
+	    net_context_get_type(ctx) != SOCK_STREAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	while (1) {
+		status = net_tcp_queue_fill(ctx, len, fill, user_data);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				break;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_send_stats(sock, status);
+
+	return status;
+}
+#endif /* CONFIG_NET_SOCKETS_SENDFILE */
+
 size_t msghdr_non_empty_iov_count(const struct msghdr *msg)
 {
 	size_t non_empty_iov_count = 0;
@@ -1347,6 +1413,41 @@ out:
 	return ret;
 }
 
+static int sock_get_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		ret = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
+			return ret;
+		}
+	} else {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					    src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_pkt_src_addr %d", ret);
+			return ret;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       struct msghdr *msg,
 				       void *buf,
@@ -1398,38 +1499,11 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			int ret;
-
-			ret  = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
-								*addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		} else {
-			int ret;
-
-			ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
-						   src_addr, *addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		}
+		int ret;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			errno = -ret;
 			goto fail;
 		}
 	}
@@ -2020,6 +2094,187 @@ fail:
 #include <syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY_RECV)
+static struct net_context *zc_get_context(int sock, struct k_mutex **lock)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable, lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	/* The packets are only reachable for native sockets */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	return ctx;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx, struct zsock_zc_buf *zc,
+				 int flags, struct sockaddr *src_addr,
+				 socklen_t *addrlen)
+{
+	const bool stream = net_context_get_type(ctx) == SOCK_STREAM;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_buf *frag;
+	struct net_pkt *pkt;
+	k_timepoint_t end;
+	size_t offset;
+	int ret;
+
+	if (stream && net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (stream && sock_is_eof(ctx)) {
+			memset(zc, 0, sizeof(*zc));
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (pkt == NULL) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				errno = EAGAIN;
+				return -1;
+			}
+
+			continue;
+		}
+
+		if (!stream) {
+			break;
+		}
+
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		/* A stream packet may be empty, or already partially read */
+		if (net_pkt_remaining_data(pkt) > 0) {
+			break;
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	if (!stream && src_addr && addrlen) {
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	/* Start at the cursor, i.e. after the headers and anything read */
+	frag = pkt->cursor.buf;
+	offset = frag != NULL ? pkt->cursor.pos - frag->data : 0;
+
+	while (frag != NULL && offset >= frag->len) {
+		frag = frag->frags;
+		offset = 0;
+	}
+
+	zc->frag = frag;
+	zc->offset = offset;
+	zc->len = net_pkt_remaining_data(pkt);
+	zc->pkt = pkt;
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	return zc->len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_buf *zc, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (zc == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (flags & ~ZSOCK_MSG_DONTWAIT) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	ctx = zc_get_context(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zsock_recv_zc_ctx(ctx, zc, flags, src_addr, addrlen);
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_recv_stats(sock, ret);
+
+	return ret;
+}
+
+int zsock_recv_zc_release(int sock, struct zsock_zc_buf *zc)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	int ret = 0;
+
+	if (zc == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (zc->pkt == NULL) {
+		return 0;
+	}
+
+	ctx = zc_get_context(sock, &lock);
+	if (ctx == NULL) {
+		ret = -1;
+	} else if (net_context_get_type(ctx) == SOCK_STREAM) {
+		(void)k_mutex_lock(lock, K_FOREVER);
+		net_context_update_recv_wnd(ctx, zc->len);
+		k_mutex_unlock(lock);
+	}
+
+	net_pkt_unref(zc->pkt);
+	memset(zc, 0, sizeof(*zc));
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY_RECV */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2628,6 +2883,21 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx,
+							 TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -3165,6 +3435,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx,
+							 TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
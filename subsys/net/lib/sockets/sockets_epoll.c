@@ -0,0 +1,481 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_epoll, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/net/socket.h>
+
+#include "sockets_internal.h"
+
+#define EPOLL_POLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLPRI | ZSOCK_EPOLLOUT)
+#define EPOLL_VALID_EVENTS (EPOLL_POLL_EVENTS | ZSOCK_EPOLLERR | \
+			    ZSOCK_EPOLLHUP | ZSOCK_EPOLLONESHOT)
+
+/* Enough for POLLIN and POLLOUT of a socket, plus the handshake events of
+ * a TLS socket on top of it.
+ */
+#define EPOLL_ENTRY_POLL_EVENTS 4
+
+struct epoll_instance;
+
+struct epoll_entry {
+	/** Registered socket, -1 if the slot is free */
+	int fd;
+	uint32_t events;
+	zsock_epoll_data_t data;
+	struct epoll_instance *ep;
+	/** Waits for the socket to become ready and queues the entry */
+	struct k_work_poll work;
+	struct k_poll_event poll_events[EPOLL_ENTRY_POLL_EVENTS];
+	/** Node in the ready list of the instance */
+	sys_dnode_t ready_node;
+	/** The entry is watched, false for a disabled one-shot entry */
+	bool armed;
+};
+
+struct epoll_instance {
+	struct k_mutex lock;
+	bool in_use;
+	/** Number of slots in use, free slots may be between them */
+	int count;
+	struct epoll_entry entries[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	/* Entries that may be ready, in the order they became ready. The
+	 * list is also fed from the system workqueue, so it has its own
+	 * spinlock and is not covered by the mutex.
+	 */
+	struct k_spinlock ready_lock;
+	sys_dlist_t ready;
+	/** Given each time an entry is put on the ready list */
+	struct k_sem ready_sem;
+};
+
+static struct epoll_instance epolls[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static K_MUTEX_DEFINE(epolls_lock);
+
+static const struct fd_op_vtable epoll_fd_vtable;
+
+static void epoll_ready_push(struct epoll_instance *ep, struct epoll_entry *entry)
+{
+	k_spinlock_key_t key = k_spin_lock(&ep->ready_lock);
+
+	if (entry->armed && !sys_dnode_is_linked(&entry->ready_node)) {
+		sys_dlist_append(&ep->ready, &entry->ready_node);
+		k_sem_give(&ep->ready_sem);
+	}
+
+	k_spin_unlock(&ep->ready_lock, key);
+}
+
+static struct epoll_entry *epoll_ready_pop(struct epoll_instance *ep)
+{
+	k_spinlock_key_t key = k_spin_lock(&ep->ready_lock);
+	sys_dnode_t *node = sys_dlist_get(&ep->ready);
+
+	k_spin_unlock(&ep->ready_lock, key);
+
+	return node == NULL ? NULL :
+	       CONTAINER_OF(node, struct epoll_entry, ready_node);
+}
+
+static void epoll_triggered(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll, work);
+	struct epoll_entry *entry = CONTAINER_OF(pwork, struct epoll_entry, work);
+
+	if (pwork->poll_result != 0) {
+		/* Canceled */
+		return;
+	}
+
+	epoll_ready_push(entry->ep, entry);
+}
+
+/* Start watching the socket of an entry. The entry is put on the ready list
+ * from the system workqueue once one of its events is signaled, or right
+ * away if the socket is already ready.
+ */
+static int epoll_entry_arm(struct epoll_instance *ep, struct epoll_entry *entry)
+{
+	const struct fd_op_vtable *vtable;
+	struct zsock_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->events & EPOLL_POLL_EVENTS,
+	};
+	struct k_poll_event *pev = entry->poll_events;
+	struct k_mutex *lock;
+	void *ctx;
+	int ret;
+
+	ctx = z_get_fd_obj_and_vtable(entry->fd, &vtable, &lock);
+	if (ctx == NULL) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE, &pfd,
+				   &pev, entry->poll_events + ARRAY_SIZE(entry->poll_events));
+	k_mutex_unlock(lock);
+
+	if (ret == -EALREADY) {
+		epoll_ready_push(ep, entry);
+		return 0;
+	} else if (ret == -EXDEV) {
+		/* Offloaded sockets have no events to wait on */
+		return -EPERM;
+	} else if (ret < 0) {
+		return ret;
+	}
+
+	if (pev == entry->poll_events) {
+		/* Nothing to wait for, only errors would be reported */
+		return 0;
+	}
+
+	return k_work_poll_submit(&entry->work, entry->poll_events,
+				  pev - entry->poll_events, K_FOREVER);
+}
+
+static void epoll_entry_disarm(struct epoll_instance *ep, struct epoll_entry *entry)
+{
+	k_spinlock_key_t key = k_spin_lock(&ep->ready_lock);
+
+	entry->armed = false;
+	if (sys_dnode_is_linked(&entry->ready_node)) {
+		sys_dlist_remove(&entry->ready_node);
+	}
+
+	k_spin_unlock(&ep->ready_lock, key);
+
+	if (k_work_poll_cancel(&entry->work) == -EINVAL) {
+		struct k_work_sync sync;
+
+		/* Already triggered, the slot may be reused once the
+		 * handler is done with it.
+		 */
+		(void)k_work_cancel_sync(&entry->work.work, &sync);
+	}
+}
+
+static struct epoll_entry *epoll_find(struct epoll_instance *ep, int fd)
+{
+	for (int i = 0; i < ep->count; i++) {
+		if (ep->entries[i].fd == fd) {
+			return &ep->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int epoll_entry_set(struct epoll_instance *ep, struct epoll_entry *entry,
+			   const struct zsock_epoll_event *event)
+{
+	entry->events = event->events;
+	entry->data = event->data;
+	entry->armed = true;
+
+	return epoll_entry_arm(ep, entry);
+}
+
+static void epoll_entry_free(struct epoll_instance *ep, struct epoll_entry *entry)
+{
+	epoll_entry_disarm(ep, entry);
+	entry->fd = -1;
+
+	while (ep->count > 0 && ep->entries[ep->count - 1].fd < 0) {
+		ep->count--;
+	}
+}
+
+static int epoll_ctl_add(struct epoll_instance *ep, int fd,
+			 const struct zsock_epoll_event *event)
+{
+	struct epoll_entry *entry = NULL;
+	int ret;
+
+	if (epoll_find(ep, fd) != NULL) {
+		return -EEXIST;
+	}
+
+	for (int i = 0; i < ep->count; i++) {
+		if (ep->entries[i].fd < 0) {
+			entry = &ep->entries[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		if (ep->count == ARRAY_SIZE(ep->entries)) {
+			return -ENOSPC;
+		}
+
+		entry = &ep->entries[ep->count++];
+	}
+
+	entry->fd = fd;
+	entry->ep = ep;
+	sys_dnode_init(&entry->ready_node);
+	k_work_poll_init(&entry->work, epoll_triggered);
+
+	ret = epoll_entry_set(ep, entry, event);
+	if (ret < 0) {
+		epoll_entry_free(ep, entry);
+	}
+
+	return ret;
+}
+
+int zsock_epoll_create(int size)
+{
+	struct epoll_instance *ep = NULL;
+	int fd;
+
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&epolls_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			ep = &epolls[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epolls_lock);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	k_mutex_init(&ep->lock);
+	ep->count = 0;
+	sys_dlist_init(&ep->ready);
+	k_sem_init(&ep->ready_sem, 0, K_SEM_MAX_LIMIT);
+
+	z_finalize_fd(fd, ep, &epoll_fd_vtable);
+
+	NET_DBG("epoll %p created, fd %d", ep, fd);
+
+	return fd;
+}
+
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	struct epoll_instance *ep;
+	struct epoll_entry *entry;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd < 0 || fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL &&
+	    (event == NULL || (event->events & ~EPOLL_VALID_EVENTS) != 0U)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		ret = epoll_ctl_add(ep, fd, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		entry = epoll_find(ep, fd);
+		if (entry == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_entry_disarm(ep, entry);
+		ret = epoll_entry_set(ep, entry, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		entry = epoll_find(ep, fd);
+		if (entry == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_entry_free(ep, entry);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Report the entries on the ready list, only those are looked at. Each one
+ * is checked again, as the event that queued it may be stale by now.
+ */
+static int epoll_collect(struct epoll_instance *ep, struct zsock_epoll_event *events,
+			 int maxevents)
+{
+	sys_dlist_t reported = SYS_DLIST_STATIC_INIT(&reported);
+	struct epoll_entry *entry;
+	sys_dnode_t *node;
+	k_spinlock_key_t key;
+	int count = 0;
+
+	while (count < maxevents && (entry = epoll_ready_pop(ep)) != NULL) {
+		struct zsock_pollfd pfd = {
+			.fd = entry->fd,
+			.events = entry->events & EPOLL_POLL_EVENTS,
+		};
+
+		if (zsock_poll_internal(&pfd, 1, K_NO_WAIT) < 0) {
+			pfd.revents = ZSOCK_POLLNVAL;
+		}
+
+		if (pfd.revents & ZSOCK_POLLNVAL) {
+			/* The socket was closed, drop it like Linux does */
+			epoll_entry_free(ep, entry);
+			continue;
+		}
+
+		if (pfd.revents == 0) {
+			/* Not ready any more, wait for the next event */
+			if (epoll_entry_arm(ep, entry) < 0) {
+				epoll_entry_free(ep, entry);
+			}
+			continue;
+		}
+
+		events[count].events = pfd.revents;
+		events[count].data = entry->data;
+		count++;
+
+		if (entry->events & ZSOCK_EPOLLONESHOT) {
+			epoll_entry_disarm(ep, entry);
+			continue;
+		}
+
+		/* Level triggered: the entry stays ready until the check above
+		 * finds it idle. It goes back behind the entries that are
+		 * already queued, so those get their turn when there are more
+		 * ready sockets than maxevents.
+		 */
+		sys_dlist_append(&reported, &entry->ready_node);
+	}
+
+	key = k_spin_lock(&ep->ready_lock);
+	while ((node = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+	k_spin_unlock(&ep->ready_lock, key);
+
+	return count;
+}
+
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout)
+{
+	struct epoll_instance *ep;
+	k_timepoint_t end;
+	int count;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	do {
+		/* Reset before looking at the list, so that an entry queued
+		 * after the look still wakes the wait below.
+		 */
+		k_sem_reset(&ep->ready_sem);
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+		count = epoll_collect(ep, events, maxevents);
+		k_mutex_unlock(&ep->lock);
+
+		if (count > 0) {
+			break;
+		}
+	} while (k_sem_take(&ep->ready_sem, sys_timepoint_timeout(end)) == 0);
+
+	return count;
+}
+
+static int epoll_close_op(void *obj)
+{
+	struct epoll_instance *ep = obj;
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	for (int i = 0; i < ep->count; i++) {
+		if (ep->entries[i].fd >= 0) {
+			epoll_entry_disarm(ep, &ep->entries[i]);
+			ep->entries[i].fd = -1;
+		}
+	}
+
+	ep->count = 0;
+	k_mutex_unlock(&ep->lock);
+
+	(void)k_mutex_lock(&epolls_lock, K_FOREVER);
+	ep->in_use = false;
+	k_mutex_unlock(&epolls_lock);
+
+	return 0;
+}
+
+static int epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	return -EOPNOTSUPP;
+}
+
+static const struct fd_op_vtable epoll_fd_vtable = {
+	.close = epoll_close_op,
+	.ioctl = epoll_ioctl_op,
+};
@@ -20,6 +20,17 @@ int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
 
 int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout);
 
+/* Data source for zsock_send_fill(), writes up to len bytes to dst and
+ * returns the number written, or < 0 on error.
+ */
+typedef int (*zsock_fill_cb_t)(void *dst, size_t len, void *user_data);
+
+/* Send up to len bytes produced by fill straight into the send buffers
+ * of a native stream socket. Returns like zsock_send().
+ */
+ssize_t zsock_send_fill(int sock, size_t len, int flags,
+			zsock_fill_cb_t fill, void *user_data);
+
 static inline void sock_set_flag(struct net_context *ctx, uintptr_t mask,
 				 uintptr_t flag)
 {
@@ -20,6 +20,7 @@ LOG_MODULE_REGISTER(net_sock_packet, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/net/ethernet.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/barrier.h>
 
 #include "../../ip/net_stats.h"
 
@@ -29,6 +30,28 @@ extern const struct socket_op_vtable sock_fd_op_vtable;
 
 static const struct socket_op_vtable packet_sock_fd_op_vtable;
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+/* Receive ring set with PACKET_RX_RING. The slots are filled in order from
+ * head, which is only moved by the receive callback.
+ */
+struct zpacket_rx_ring {
+	struct net_context *ctx;
+	uint8_t *frames;
+	uint32_t frame_size;
+	uint32_t frame_nr;
+	uint32_t head;
+	bool losing;
+	struct k_poll_signal signal;
+};
+
+static struct zpacket_rx_ring rx_rings[CONFIG_NET_SOCKETS_PACKET_RX_RING_COUNT];
+static K_MUTEX_DEFINE(rx_ring_lock);
+
+static bool zpacket_rx_ring_put(struct net_context *ctx, struct net_pkt *pkt);
+#else
+#define zpacket_rx_ring_put(...) false
+#endif /* CONFIG_NET_SOCKETS_PACKET_RX_RING */
+
 static inline int k_fifo_wait_non_empty(struct k_fifo *fifo,
 					k_timeout_t timeout)
 {
@@ -105,6 +128,10 @@ static void zpacket_received_cb(struct net_context *ctx,
 		return;
 	}
 
+	if (zpacket_rx_ring_put(ctx, pkt)) {
+		return;
+	}
+
 	/* Normal packet */
 	net_pkt_set_eof(pkt, false);
 
@@ -226,6 +253,243 @@ static void zpacket_set_source_addr(struct net_context *ctx,
 	*addrlen = sizeof(struct sockaddr_ll);
 }
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+/* Must be called with rx_ring_lock held */
+static struct zpacket_rx_ring *zpacket_rx_ring_find(struct net_context *ctx)
+{
+	ARRAY_FOR_EACH(rx_rings, i) {
+		if (rx_rings[i].ctx == ctx) {
+			return &rx_rings[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct tpacket_hdr *zpacket_rx_ring_frame(struct zpacket_rx_ring *ring,
+						 uint32_t idx)
+{
+	return (struct tpacket_hdr *)&ring->frames[idx * ring->frame_size];
+}
+
+/* The last written slot is only given back after all the earlier ones */
+static bool zpacket_rx_ring_ready(struct zpacket_rx_ring *ring)
+{
+	uint32_t last = (ring->head == 0U) ? ring->frame_nr - 1U : ring->head - 1U;
+
+	return zpacket_rx_ring_frame(ring, last)->tp_status != TP_STATUS_KERNEL;
+}
+
+static bool zpacket_rx_ring_put(struct net_context *ctx, struct net_pkt *pkt)
+{
+	struct zpacket_rx_ring *ring;
+	struct tpacket_hdr *hdr;
+	socklen_t addrlen = sizeof(struct sockaddr_ll);
+	size_t len;
+	uint32_t status;
+
+	(void)k_mutex_lock(&rx_ring_lock, K_FOREVER);
+
+	ring = zpacket_rx_ring_find(ctx);
+	if (ring == NULL) {
+		k_mutex_unlock(&rx_ring_lock);
+		return false;
+	}
+
+	hdr = zpacket_rx_ring_frame(ring, ring->head);
+	if (hdr->tp_status != TP_STATUS_KERNEL) {
+		NET_DBG("Ring of ctx %p full, dropping pkt %p", ctx, pkt);
+		ring->losing = true;
+		goto out;
+	}
+
+	/* The slot is owned by the stack, so it can be written without
+	 * looking at the status again.
+	 */
+	memset(hdr + 1, 0, sizeof(struct sockaddr_ll));
+	zpacket_set_source_addr(ctx, pkt, (struct sockaddr *)(hdr + 1), &addrlen);
+
+	len = net_pkt_get_len(pkt);
+	hdr->tp_mac = ROUND_UP(sizeof(*hdr) + sizeof(struct sockaddr_ll), 4);
+	hdr->tp_len = len;
+	hdr->tp_snaplen = MIN(len, ring->frame_size - hdr->tp_mac);
+
+	if (net_pkt_read(pkt, (uint8_t *)hdr + hdr->tp_mac, hdr->tp_snaplen)) {
+		goto out;
+	}
+
+	status = TP_STATUS_USER;
+	if (hdr->tp_snaplen < len) {
+		status |= TP_STATUS_COPY;
+	}
+
+	if (ring->losing) {
+		status |= TP_STATUS_LOSING;
+		ring->losing = false;
+	}
+
+	/* Make the frame visible before handing the slot over */
+	barrier_dmem_fence_full();
+	hdr->tp_status = status;
+
+	ring->head = (ring->head + 1U) % ring->frame_nr;
+	k_poll_signal_raise(&ring->signal, 0);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+out:
+	k_mutex_unlock(&rx_ring_lock);
+	net_pkt_unref(pkt);
+
+	return true;
+}
+
+static int zpacket_rx_ring_set(struct net_context *ctx,
+			       const struct tpacket_req *req)
+{
+	size_t min_size = ROUND_UP(sizeof(struct tpacket_hdr) +
+				   sizeof(struct sockaddr_ll), 4);
+	struct zpacket_rx_ring *ring;
+	int ret = 0;
+
+#if defined(CONFIG_USERSPACE)
+	/* The stack writes to the ring from its own threads */
+	if (req->tp_frame_nr > 0U && (k_current_get()->base.user_options & K_USER)) {
+		return -EPERM;
+	}
+#endif
+
+	if (req->tp_frame_nr > 0U &&
+	    (req->tp_ring == NULL || req->tp_frame_size <= min_size ||
+	     (req->tp_frame_size % 4U) != 0U ||
+	     req->tp_frame_nr > UINT32_MAX / req->tp_frame_size)) {
+		return -EINVAL;
+	}
+
+	(void)k_mutex_lock(&rx_ring_lock, K_FOREVER);
+
+	ring = zpacket_rx_ring_find(ctx);
+	if (req->tp_frame_nr == 0U) {
+		if (ring != NULL) {
+			ring->ctx = NULL;
+		}
+
+		goto out;
+	}
+
+	if (ring == NULL) {
+		ring = zpacket_rx_ring_find(NULL);
+		if (ring == NULL) {
+			ret = -ENOMEM;
+			goto out;
+		}
+	}
+
+	ring->frames = req->tp_ring;
+	ring->frame_size = req->tp_frame_size;
+	ring->frame_nr = req->tp_frame_nr;
+	ring->head = 0U;
+	ring->losing = false;
+	k_poll_signal_init(&ring->signal);
+
+	for (uint32_t i = 0U; i < ring->frame_nr; i++) {
+		zpacket_rx_ring_frame(ring, i)->tp_status = TP_STATUS_KERNEL;
+	}
+
+	ring->ctx = ctx;
+
+out:
+	k_mutex_unlock(&rx_ring_lock);
+
+	return ret;
+}
+
+/* Returns 1 if the socket has no ring */
+static int zpacket_rx_ring_poll_prepare(struct net_context *ctx,
+					struct zsock_pollfd *pfd,
+					struct k_poll_event **pev,
+					struct k_poll_event *pev_end)
+{
+	struct zpacket_rx_ring *ring;
+	int ret = 0;
+
+	(void)k_mutex_lock(&rx_ring_lock, K_FOREVER);
+
+	ring = zpacket_rx_ring_find(ctx);
+	if (ring == NULL) {
+		ret = 1;
+		goto out;
+	}
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (*pev == pev_end) {
+			ret = -ENOMEM;
+			goto out;
+		}
+
+		/* Reset before checking, a frame written after the check
+		 * raises the signal again.
+		 */
+		k_poll_signal_reset(&ring->signal);
+
+		(*pev)->obj = &ring->signal;
+		(*pev)->type = K_POLL_TYPE_SIGNAL;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+
+		if (zpacket_rx_ring_ready(ring)) {
+			ret = -EALREADY;
+		}
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		ret = -EALREADY;
+	}
+
+out:
+	k_mutex_unlock(&rx_ring_lock);
+
+	return ret;
+}
+
+/* Returns 1 if the socket has no ring */
+static int zpacket_rx_ring_poll_update(struct net_context *ctx,
+				       struct zsock_pollfd *pfd,
+				       struct k_poll_event **pev)
+{
+	struct zpacket_rx_ring *ring;
+	int ret = 0;
+
+	(void)k_mutex_lock(&rx_ring_lock, K_FOREVER);
+
+	ring = zpacket_rx_ring_find(ctx);
+	if (ring == NULL) {
+		ret = 1;
+		goto out;
+	}
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (zpacket_rx_ring_ready(ring)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+
+		(*pev)++;
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+out:
+	k_mutex_unlock(&rx_ring_lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RX_RING */
+
 ssize_t zpacket_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 			   int flags, const struct sockaddr *dest_addr,
 			   socklen_t addrlen)
@@ -366,6 +630,25 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 int zpacket_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			const void *optval, socklen_t optlen)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	if (level == SOL_PACKET && optname == PACKET_RX_RING) {
+		int ret;
+
+		if (optval == NULL || optlen != sizeof(struct tpacket_req)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		ret = zpacket_rx_ring_set(ctx, optval);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return 0;
+	}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RX_RING */
+
 	return sock_fd_op_vtable.setsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -384,6 +667,33 @@ static ssize_t packet_sock_write_vmeth(void *obj, const void *buffer,
 static int packet_sock_ioctl_vmeth(void *obj, unsigned int request,
 				   va_list args)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	if (request == ZFD_IOCTL_POLL_PREPARE || request == ZFD_IOCTL_POLL_UPDATE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+		va_list copy;
+		int ret;
+
+		va_copy(copy, args);
+		pfd = va_arg(copy, struct zsock_pollfd *);
+		pev = va_arg(copy, struct k_poll_event **);
+
+		if (request == ZFD_IOCTL_POLL_PREPARE) {
+			pev_end = va_arg(copy, struct k_poll_event *);
+			ret = zpacket_rx_ring_poll_prepare(obj, pfd, pev, pev_end);
+		} else {
+			ret = zpacket_rx_ring_poll_update(obj, pfd, pev);
+		}
+
+		va_end(copy);
+
+		if (ret != 1) {
+			return ret;
+		}
+	}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RX_RING */
+
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
@@ -455,6 +765,12 @@ static int packet_sock_setsockopt_vmeth(void *obj, int level, int optname,
 
 static int packet_sock_close_vmeth(void *obj)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	const struct tpacket_req req = { 0 };
+
+	(void)zpacket_rx_ring_set(obj, &req);
+#endif
+
 	return zsock_close_ctx(obj);
 }
 
@@ -0,0 +1,102 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/rtio/work.h>
+
+/* Whether a receive of 0 bytes is an empty datagram rather than the end of stream */
+static bool zsock_rtio_is_dgram(int sock)
+{
+	socklen_t optlen = sizeof(int);
+	int type;
+
+	/* Not all the socket types support it, a socket pair for one */
+	if (zsock_getsockopt(sock, SOL_SOCKET, SO_TYPE, &type, &optlen) < 0) {
+		return false;
+	}
+
+	return type != SOCK_STREAM;
+}
+
+static ssize_t zsock_rtio_sqe(int sock, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+	ssize_t ret;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		ret = rtio_sqe_rx_buf(iodev_sqe, 1, CONFIG_NET_SOCKETS_RTIO_RECV_SIZE, &buf,
+				      &buf_len);
+		if (ret < 0) {
+			return ret;
+		}
+		ret = zsock_recv(sock, buf, buf_len, 0);
+		if (ret == 0 && (sqe->flags & RTIO_SQE_MULTISHOT) != 0 &&
+		    !zsock_rtio_is_dgram(sock)) {
+			/* The peer closed the connection, there is nothing more to receive */
+			return -ENOTCONN;
+		}
+		break;
+	case RTIO_OP_TX:
+		ret = zsock_send(sock, sqe->buf, sqe->buf_len, 0);
+		break;
+	case RTIO_OP_TINY_TX:
+		ret = zsock_send(sock, sqe->tiny_buf, sqe->tiny_buf_len, 0);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return ret < 0 ? -errno : ret;
+}
+
+static void zsock_rtio_handler(struct rtio_iodev_sqe *txn_first)
+{
+	const struct zsock_rtio_iodev_data *data = txn_first->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = txn_first;
+	ssize_t ret = 0;
+
+	while (txn_curr != NULL) {
+		ret = zsock_rtio_sqe(data->sock, txn_curr);
+		if (ret < 0) {
+			/* A multishot receive would be submitted again, and fail again */
+			txn_first->sqe.flags &= ~RTIO_SQE_MULTISHOT;
+			rtio_iodev_sqe_err(txn_first, ret);
+			return;
+		}
+		txn_curr = rtio_txn_next(txn_curr);
+	}
+
+	rtio_iodev_sqe_ok(txn_first, ret);
+}
+
+static void zsock_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct zsock_rtio_iodev_data *data = iodev_sqe->sqe.iodev->data;
+	struct rtio_work_req *req;
+
+	if (data->sock < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, -EBADF);
+		return;
+	}
+
+	req = rtio_work_req_alloc();
+	if (req == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, zsock_rtio_handler);
+}
+
+const struct rtio_iodev_api zsock_rtio_iodev_api = {
+	.submit = zsock_rtio_submit,
+};
@@ -0,0 +1,108 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_sendfile, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+
+#if defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#endif
+
+#if defined(CONFIG_FLASH_MAP)
+#include <zephyr/storage/flash_map.h>
+#endif
+
+#include "sockets_internal.h"
+
+#if defined(CONFIG_FILE_SYSTEM)
+static int file_fill(void *dst, size_t len, void *user_data)
+{
+	return fs_read(user_data, dst, len);
+}
+
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count)
+{
+	off_t pos = 0;
+	ssize_t ret;
+
+	if (file == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (offset != NULL) {
+		pos = fs_tell(file);
+		if (pos < 0) {
+			errno = -pos;
+			return -1;
+		}
+
+		ret = fs_seek(file, *offset, FS_SEEK_SET);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	ret = zsock_send_fill(sock, count, 0, file_fill, file);
+
+	if (offset != NULL) {
+		if (ret > 0) {
+			*offset += ret;
+		}
+
+		(void)fs_seek(file, pos, FS_SEEK_SET);
+	}
+
+	NET_DBG("sock %d: sent %d bytes of file %p", sock, (int)ret, file);
+
+	return ret;
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
+#if defined(CONFIG_FLASH_MAP)
+struct flash_source {
+	const struct flash_area *fa;
+	off_t offset;
+};
+
+static int flash_fill(void *dst, size_t len, void *user_data)
+{
+	struct flash_source *src = user_data;
+	int ret;
+
+	ret = flash_area_read(src->fa, src->offset, dst, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	src->offset += len;
+
+	return len;
+}
+
+ssize_t zsock_send_flash(int sock, const struct flash_area *fa, off_t offset,
+			 size_t count, int flags)
+{
+	struct flash_source src = {
+		.fa = fa,
+		.offset = offset,
+	};
+
+	if (fa == NULL || offset < 0 || offset > fa->fa_size) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return zsock_send_fill(sock, MIN(count, fa->fa_size - offset), flags,
+			       flash_fill, &src);
+}
+#endif /* CONFIG_FLASH_MAP */
@@ -20,12 +20,26 @@ static K_CONDVAR_DEFINE(wait_start);
 STRUCT_SECTION_START_EXTERN(net_socket_service_desc);
 STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 
+#define SERVICE_THREADS CONFIG_NET_SOCKETS_SERVICE_THREADS
+
+/* Each dispatcher thread polls the sockets of its own services. Entry 0 of
+ * the events is the eventfd used to wake the thread up, and for the other
+ * entries the matching service event is kept in pev so that a triggered
+ * socket does not need to be looked up among all the services.
+ */
 static struct service {
 	struct zsock_pollfd events[CONFIG_NET_SOCKETS_POLL_MAX];
+	struct net_socket_service_event *pev[CONFIG_NET_SOCKETS_POLL_MAX];
 	int count;
-} ctx;
+} ctx[SERVICE_THREADS];
 
-#define get_idx(svc) (*(svc->idx))
+static struct k_thread service_threads[SERVICE_THREADS];
+
+/* The index of a service tells both its dispatcher thread and where its
+ * entries are in the events of that thread.
+ */
+#define get_idx(svc) (*(svc->idx) % CONFIG_NET_SOCKETS_POLL_MAX)
+#define get_ctx(svc) (&ctx[*(svc->idx) / CONFIG_NET_SOCKETS_POLL_MAX])
 
 void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 {
@@ -37,7 +51,7 @@ void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 static void cleanup_svc_events(const struct net_socket_service_desc *svc)
 {
 	for (int i = 0; i < svc->pev_len; i++) {
-		ctx.events[get_idx(svc) + i].fd = -1;
+		get_ctx(svc)->events[get_idx(svc) + i].fd = -1;
 		svc->pev[i].event.fd = -1;
 		svc->pev[i].event.events = 0;
 	}
@@ -77,12 +91,12 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 		}
 
 		for (i = 0; i < svc->pev_len; i++) {
-			ctx.events[get_idx(svc) + i] = svc->pev[i].event;
+			get_ctx(svc)->events[get_idx(svc) + i] = svc->pev[i].event;
 		}
 	}
 
 	/* Tell the thread to re-read the variables */
-	eventfd_write(ctx.events[0].fd, 1);
+	eventfd_write(get_ctx(svc)->events[0].fd, 1);
 	ret = 0;
 
 out:
@@ -91,22 +105,6 @@ out:
 	return ret;
 }
 
-static struct net_socket_service_desc *find_svc_and_event(
-	struct zsock_pollfd *pev,
-	struct net_socket_service_event **event)
-{
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int i = 0; i < svc->pev_len; i++) {
-			if (svc->pev[i].event.fd == pev->fd) {
-				*event = &svc->pev[i];
-				return svc;
-			}
-		}
-	}
-
-	return NULL;
-}
-
 /* We do not set the user callback to our work struct because we need to
  * hook into the flow and restore the global poll array so that the next poll
  * round will not notice it and call the callback again while we are
@@ -125,7 +123,7 @@ void net_socket_service_callback(struct k_work *work)
 	 * it as -1 when triggering the work.
 	 */
 	for (int i = 0; i < svc->pev_len; i++) {
-		ctx.events[get_idx(svc) + i] = svc->pev[i].event;
+		get_ctx(svc)->events[get_idx(svc) + i] = svc->pev[i].event;
 	}
 }
 
@@ -156,18 +154,16 @@ static int call_work(struct zsock_pollfd *pev, struct k_work_q *work_q,
 
 }
 
-static int trigger_work(struct zsock_pollfd *pev)
+static int trigger_work(struct service *shard, int i)
 {
-	struct net_socket_service_event *event;
-	struct net_socket_service_desc *svc;
+	struct zsock_pollfd *pev = &shard->events[i];
+	struct net_socket_service_event *event = shard->pev[i];
+	struct net_socket_service_desc *svc = event->svc;
 
-	svc = find_svc_and_event(pev, &event);
-	if (svc == NULL) {
+	if (event->event.fd != pev->fd) {
 		return -ENOENT;
 	}
 
-	event->svc = svc;
-
 	/* Copy the triggered event to our event so that we know what
 	 * was actually causing the event.
 	 */
@@ -176,70 +172,71 @@ static int trigger_work(struct zsock_pollfd *pev)
 	return call_work(pev, svc->work_q, &event->work);
 }
 
-static void socket_service_thread(void)
+/* Give each service to the thread with the fewest entries so far */
+static int assign_services(void)
 {
-	int ret, i, fd, count = 0;
-	eventfd_t value;
+	int count = 0;
 
-	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
-	if (ret == 0) {
-		NET_INFO("No socket services found, service disabled.");
-		goto fail;
+	for (int t = 0; t < SERVICE_THREADS; t++) {
+		ctx[t].count = 1;
 	}
 
-	/* Create contiguous poll event array to enable socket polling */
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		NET_DBG("Service %s has %d pollable sockets",
+		struct service *shard = &ctx[0];
+
+		for (int t = 1; t < SERVICE_THREADS; t++) {
+			if (ctx[t].count < shard->count) {
+				shard = &ctx[t];
+			}
+		}
+
+		NET_DBG("Service %s has %d pollable sockets, thread %d",
 			COND_CODE_1(CONFIG_NET_SOCKETS_LOG_LEVEL_DBG,
 				    (svc->owner), ("")),
-			svc->pev_len);
-		get_idx(svc) = count + 1;
+			svc->pev_len, (int)(shard - ctx));
+
+		*(svc->idx) = (shard - ctx) * CONFIG_NET_SOCKETS_POLL_MAX +
+			      shard->count;
+		shard->count += svc->pev_len;
 		count += svc->pev_len;
-	}
 
-	if ((count + 1) > ARRAY_SIZE(ctx.events)) {
-		NET_ERR("You have %d services to monitor but "
-			"%zd poll entries configured.",
-			count + 1, ARRAY_SIZE(ctx.events));
-		NET_ERR("Please increase value of %s to at least %d",
-			"CONFIG_NET_SOCKETS_POLL_MAX", count + 1);
-		goto fail;
+		if (shard->count > ARRAY_SIZE(shard->events)) {
+			NET_ERR("You have %d services to monitor but "
+				"%zd poll entries configured.",
+				shard->count, ARRAY_SIZE(shard->events));
+			NET_ERR("Please increase value of %s to at least %d",
+				"CONFIG_NET_SOCKETS_POLL_MAX", shard->count);
+			return -ENOMEM;
+		}
+
+		for (int i = 0; i < svc->pev_len; i++) {
+			svc->pev[i].svc = svc;
+			shard->pev[get_idx(svc) + i] = &svc->pev[i];
+		}
 	}
 
 	NET_DBG("Monitoring %d socket entries", count);
 
-	ctx.count = count + 1;
-
-	/* Create an eventfd that can be used to trigger events during polling */
-	fd = eventfd(0, 0);
-	if (fd < 0) {
-		fd = -errno;
-		NET_ERR("eventfd failed (%d)", fd);
-		goto out;
-	}
-
-	init_done = true;
-	k_condvar_broadcast(&wait_start);
+	return 0;
+}
 
-	ctx.events[0].fd = fd;
-	ctx.events[0].events = ZSOCK_POLLIN;
+static void socket_service_poll(struct service *shard)
+{
+	int ret, i;
+	eventfd_t value;
 
 restart:
-	i = 1;
-
 	k_mutex_lock(&lock, K_FOREVER);
 
 	/* Copy individual events to the big array */
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int j = 0; j < svc->pev_len; j++) {
-			ctx.events[get_idx(svc) + j] = svc->pev[j].event;
-		}
+	for (i = 1; i < shard->count; i++) {
+		shard->events[i] = shard->pev[i]->event;
 	}
 
 	k_mutex_unlock(&lock);
 
 	while (true) {
-		ret = zsock_poll(ctx.events, count + 1, -1);
+		ret = zsock_poll(shard->events, shard->count, -1);
 		if (ret < 0) {
 			ret = -errno;
 			NET_ERR("poll failed (%d)", ret);
@@ -251,19 +248,19 @@ restart:
 			break;
 		}
 
-		if (ret > 0 && ctx.events[0].revents) {
-			eventfd_read(ctx.events[0].fd, &value);
+		if (ret > 0 && shard->events[0].revents) {
+			eventfd_read(shard->events[0].fd, &value);
 			NET_DBG("Received restart event.");
 			goto restart;
 		}
 
-		for (i = 1; i < (count + 1); i++) {
-			if (ctx.events[i].fd < 0) {
+		for (i = 1; i < shard->count; i++) {
+			if (shard->events[i].fd < 0) {
 				continue;
 			}
 
-			if (ctx.events[i].revents > 0) {
-				ret = trigger_work(&ctx.events[i]);
+			if (shard->events[i].revents > 0) {
+				ret = trigger_work(shard, i);
 				if (ret < 0) {
 					NET_DBG("Triggering work failed (%d)", ret);
 				}
@@ -274,6 +271,53 @@ restart:
 out:
 	NET_DBG("Socket service thread stopped");
 	init_done = false;
+}
+
+static void socket_service_thread(void *p1, void *p2, void *p3)
+{
+	struct service *shard = p1;
+	int ret, fd;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if (shard != &ctx[0]) {
+		socket_service_poll(shard);
+		return;
+	}
+
+	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
+	if (ret == 0) {
+		NET_INFO("No socket services found, service disabled.");
+		goto fail;
+	}
+
+	if (assign_services() < 0) {
+		goto fail;
+	}
+
+	/* Create eventfds that can be used to trigger events during polling */
+	for (int t = 0; t < SERVICE_THREADS; t++) {
+		fd = eventfd(0, 0);
+		if (fd < 0) {
+			fd = -errno;
+			NET_ERR("eventfd failed (%d)", fd);
+			return;
+		}
+
+		ctx[t].events[0].fd = fd;
+		ctx[t].events[0].events = ZSOCK_POLLIN;
+	}
+
+	init_done = true;
+	k_condvar_broadcast(&wait_start);
+
+	/* This thread did the setup, the others can start polling now */
+	for (int t = 1; t < SERVICE_THREADS; t++) {
+		k_thread_start(&service_threads[t]);
+	}
+
+	socket_service_poll(shard);
 
 	return;
 
@@ -283,21 +327,41 @@ fail:
 
 static int init_socket_service(void)
 {
-	k_tid_t ssm;
-	static struct k_thread service_thread;
+	static K_THREAD_STACK_ARRAY_DEFINE(service_thread_stacks, SERVICE_THREADS,
+					   CONFIG_NET_SOCKETS_SERVICE_STACK_SIZE);
+
+	for (int t = 0; t < SERVICE_THREADS; t++) {
+		k_tid_t ssm;
+
+		ssm = k_thread_create(&service_threads[t],
+				      service_thread_stacks[t],
+				      K_THREAD_STACK_SIZEOF(service_thread_stacks[t]),
+				      socket_service_thread, &ctx[t], NULL, NULL,
+				      CLAMP(CONFIG_NET_SOCKETS_SERVICE_THREAD_PRIO,
+					    K_HIGHEST_APPLICATION_THREAD_PRIO,
+					    K_LOWEST_APPLICATION_THREAD_PRIO), 0, K_FOREVER);
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+		if (SERVICE_THREADS > 1) {
+			(void)k_thread_cpu_pin(ssm, t % arch_num_cpus());
+		}
+#endif
+
+#if defined(CONFIG_THREAD_NAME)
+		if (SERVICE_THREADS > 1) {
+			char name[CONFIG_THREAD_MAX_NAME_LEN];
 
-	static K_THREAD_STACK_DEFINE(service_thread_stack,
-				     CONFIG_NET_SOCKETS_SERVICE_STACK_SIZE);
+			snprintk(name, sizeof(name), "net_socket_service%d", t);
+			k_thread_name_set(ssm, name);
+			continue;
+		}
+#endif
 
-	ssm = k_thread_create(&service_thread,
-			      service_thread_stack,
-			      K_THREAD_STACK_SIZEOF(service_thread_stack),
-			      (k_thread_entry_t)socket_service_thread, NULL, NULL, NULL,
-			      CLAMP(CONFIG_NET_SOCKETS_SERVICE_THREAD_PRIO,
-				    K_HIGHEST_APPLICATION_THREAD_PRIO,
-				    K_LOWEST_APPLICATION_THREAD_PRIO), 0, K_NO_WAIT);
+		k_thread_name_set(ssm, "net_socket_service");
+	}
 
-	k_thread_name_set(ssm, "net_socket_service");
+	/* The first thread sets up the services and starts the others */
+	k_thread_start(&service_threads[0]);
 
 	return 0;
 }
@@ -46,7 +46,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
+#include <mbedtls/platform_util.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -68,6 +70,12 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #define DTLS_SENDMSG_BUF_SIZE 0
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE)
+#define TLS_SENDMSG_BUF_SIZE (CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE)
+#else
+#define TLS_SENDMSG_BUF_SIZE 0
+#endif /* CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE */
+
 static const struct socket_op_vtable tls_sock_fd_op_vtable;
 
 #ifndef MBEDTLS_ERR_SSL_PEER_VERIFY_FAILED
@@ -158,6 +166,14 @@ __net_socket struct tls_context {
 	/** Information whether TLS handshake is complete or not. */
 	struct k_sem tls_established;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+	/** State of a handshake run by a worker, TLS_HANDSHAKE_OFFLOAD_* bits. */
+	atomic_t handshake_offload;
+
+	/** Given when the handshake run by a worker has finished. */
+	struct k_sem handshake_done;
+#endif
+
 	/* TLS socket mutex lock. */
 	struct k_mutex *lock;
 
@@ -192,6 +208,9 @@ __net_socket struct tls_context {
 		/** Session cache enabled on a socket. */
 		bool cache_enabled;
 
+		/** Session tickets issued on a server socket. */
+		bool tickets_enabled;
+
 		/** Socket TX timeout */
 		k_timeout_t timeout_tx;
 
@@ -245,6 +264,25 @@ __net_socket struct tls_context {
 };
 
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+enum {
+	/* Handshake queued to or run by a worker. */
+	TLS_HANDSHAKE_OFFLOAD_PENDING,
+	/* Socket closed while the handshake is pending. */
+	TLS_HANDSHAKE_OFFLOAD_ABORT,
+};
+
+K_MSGQ_DEFINE(tls_handshake_msgq, sizeof(struct tls_context *),
+	      CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS, sizeof(void *));
+
+static K_THREAD_STACK_ARRAY_DEFINE(tls_handshake_stacks,
+				   CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKERS,
+				   CONFIG_NET_SOCKETS_TLS_HANDSHAKE_STACK_SIZE);
+static struct k_thread tls_handshake_threads[CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKERS];
+
+static void tls_handshake_worker(void *p1, void *p2, void *p3);
+#endif /* CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD */
+
 /* A global pool of TLS contexts. */
 static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 
@@ -254,6 +292,22 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+#if defined(MBEDTLS_AES_C) && defined(MBEDTLS_GCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_GCM
+#elif defined(MBEDTLS_AES_C) && defined(MBEDTLS_CCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_CCM
+#else
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_CHACHA20_POLY1305
+#endif
+#define TLS_TICKET_KEY_LEN 32
+
+/* Ticket keys shared by all the server sockets, set up on first use. */
+static mbedtls_ssl_ticket_context server_ticket;
+static bool server_ticket_ready;
+static struct k_mutex ticket_lock;
+#endif
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -373,6 +427,23 @@ static int tls_init(void)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&server_ticket);
+	k_mutex_init(&ticket_lock);
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+	for (int i = 0; i < ARRAY_SIZE(tls_handshake_threads); i++) {
+		k_thread_create(&tls_handshake_threads[i], tls_handshake_stacks[i],
+				K_THREAD_STACK_SIZEOF(tls_handshake_stacks[i]),
+				tls_handshake_worker, NULL, NULL, NULL,
+				CLAMP(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_THREAD_PRIO,
+				      K_HIGHEST_APPLICATION_THREAD_PRIO,
+				      K_LOWEST_APPLICATION_THREAD_PRIO), 0, K_NO_WAIT);
+		k_thread_name_set(&tls_handshake_threads[i], "tls_handshake");
+	}
+#endif
+
 	return 0;
 }
 
@@ -463,6 +534,9 @@ static struct tls_context *tls_alloc(void)
 
 	if (tls) {
 		k_sem_init(&tls->tls_established, 0, 1);
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+		k_sem_init(&tls->handshake_done, 0, 1);
+#endif
 
 		mbedtls_ssl_init(&tls->ssl);
 		mbedtls_ssl_config_init(&tls->config);
@@ -731,6 +805,58 @@ static void tls_session_purge(void)
 #endif
 }
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Must be called with ticket_lock held. */
+static int tls_session_ticket_setup(void)
+{
+	int ret;
+
+	if (server_ticket_ready) {
+		return 0;
+	}
+
+	ret = mbedtls_ssl_ticket_setup(&server_ticket, tls_ctr_drbg_random, NULL,
+				       TLS_TICKET_CIPHER,
+				       CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+	if (ret != 0) {
+		NET_ERR("Failed to set up session tickets (-0x%04X)", -ret);
+		return -ENOMEM;
+	}
+
+	server_ticket_ready = true;
+
+	return 0;
+}
+
+/* The ticket keys may be rotated while other sockets handshake, so serialize
+ * access to them.
+ */
+static int tls_session_ticket_write(void *p_ticket, const mbedtls_ssl_session *session,
+				    unsigned char *start, const unsigned char *end,
+				    size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&ticket_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen, lifetime);
+	k_mutex_unlock(&ticket_lock);
+
+	return ret;
+}
+
+static int tls_session_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+				    unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&ticket_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	k_mutex_unlock(&ticket_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 static inline int time_left(uint32_t start, uint32_t timeout)
 {
 	uint32_t elapsed = k_uptime_get_32() - start;
@@ -1226,6 +1352,34 @@ static int tls_mbedtls_handshake(struct tls_context *context,
 			}
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+			if (atomic_test_bit(&context->handshake_offload,
+					    TLS_HANDSHAKE_OFFLOAD_PENDING)) {
+				/* Wait in slices, to notice when the socket is
+				 * closed.
+				 */
+				if (timeout_ms == SYS_FOREVER_MS || timeout_ms > TLS_WAIT_MS) {
+					timeout_ms = TLS_WAIT_MS;
+				}
+
+				if (atomic_test_bit(&context->handshake_offload,
+						    TLS_HANDSHAKE_OFFLOAD_ABORT)) {
+					ret = -ECONNABORTED;
+					break;
+				}
+
+				/* Let the socket calls in while waiting. */
+				k_mutex_unlock(context->lock);
+				ret = wait_for_reason(context->sock, timeout_ms, ret);
+				k_mutex_lock(context->lock, K_FOREVER);
+				if (ret != 0) {
+					break;
+				}
+
+				continue;
+			}
+#endif
+
 			ret = wait_for_reason(context->sock, timeout_ms, ret);
 			if (ret != 0) {
 				break;
@@ -1282,6 +1436,74 @@ static int tls_mbedtls_handshake(struct tls_context *context,
 	return ret;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+/* The worker holds the socket lock while running the handshake, and releases
+ * it only while waiting for data. The socket calls check the pending bit and
+ * wait for handshake_done, which is given once the lock is released for good.
+ */
+static void tls_handshake_worker(void *p1, void *p2, void *p3)
+{
+	struct tls_context *ctx;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&tls_handshake_msgq, &ctx, K_FOREVER);
+
+		k_mutex_lock(ctx->lock, K_FOREVER);
+
+		if (atomic_test_bit(&ctx->handshake_offload,
+				    TLS_HANDSHAKE_OFFLOAD_ABORT)) {
+			ret = -ECONNABORTED;
+		} else {
+			ret = tls_mbedtls_handshake(
+				ctx, K_MSEC(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_TIMEOUT));
+		}
+
+		if (ret < 0 && ctx->error == 0) {
+			ctx->error = (ret == -EAGAIN) ? ETIMEDOUT : -ret;
+		}
+
+		atomic_clear_bit(&ctx->handshake_offload, TLS_HANDSHAKE_OFFLOAD_PENDING);
+		k_mutex_unlock(ctx->lock);
+
+		/* The socket may be closed from now on. */
+		k_sem_give(&ctx->handshake_done);
+	}
+}
+
+static int tls_handshake_offload_wait(struct tls_context *ctx, bool is_block,
+				      k_timeout_t timeout)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+		&ctx->handshake_done);
+
+	if (!atomic_test_bit(&ctx->handshake_offload,
+			     TLS_HANDSHAKE_OFFLOAD_PENDING)) {
+		return 0;
+	}
+
+	if (!is_block) {
+		return -EAGAIN;
+	}
+
+	k_mutex_unlock(ctx->lock);
+	(void)k_poll(&event, 1, timeout);
+	k_mutex_lock(ctx->lock, K_FOREVER);
+
+	if (atomic_test_bit(&ctx->handshake_offload,
+			    TLS_HANDSHAKE_OFFLOAD_PENDING)) {
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD */
+
 static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 {
 	int role, type, ret;
@@ -1418,6 +1640,22 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (is_server && context->options.tickets_enabled) {
+		k_mutex_lock(&ticket_lock, K_FOREVER);
+		ret = tls_session_ticket_setup();
+		k_mutex_unlock(&ticket_lock);
+		if (ret < 0) {
+			return ret;
+		}
+
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    tls_session_ticket_write,
+						    tls_session_ticket_parse,
+						    &server_ticket);
+	}
+#endif
+
 	ret = mbedtls_ssl_setup(&context->ssl,
 				&context->config);
 	if (ret != 0) {
@@ -1950,6 +2188,83 @@ static int tls_opt_session_cache_purge_set(struct tls_context *context,
 	return 0;
 }
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int tls_opt_session_ticket_set(struct tls_context *context,
+				      const void *optval, socklen_t optlen)
+{
+	int *val = (int *)optval;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (sizeof(int) != optlen) {
+		return -EINVAL;
+	}
+
+	context->options.tickets_enabled = (*val == TLS_SESSION_TICKET_ENABLED);
+
+	return 0;
+}
+
+static int tls_opt_session_ticket_get(struct tls_context *context,
+				      void *optval, socklen_t *optlen)
+{
+	int tickets_enabled = context->options.tickets_enabled ?
+			      TLS_SESSION_TICKET_ENABLED :
+			      TLS_SESSION_TICKET_DISABLED;
+
+	if (*optlen != sizeof(tickets_enabled)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = tickets_enabled;
+
+	return 0;
+}
+
+static int tls_opt_session_ticket_key_set(struct tls_context *context,
+					  const void *optval, socklen_t optlen)
+{
+	uint8_t key[MBEDTLS_SSL_TICKET_KEY_NAME_BYTES + TLS_TICKET_KEY_LEN];
+	int ret;
+
+	ARG_UNUSED(context);
+
+	if (optlen == 0) {
+		ret = tls_ctr_drbg_random(NULL, key, sizeof(key));
+		if (ret != 0) {
+			return -EIO;
+		}
+	} else if (optval != NULL && optlen == sizeof(key)) {
+		memcpy(key, optval, sizeof(key));
+	} else {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&ticket_lock, K_FOREVER);
+
+	ret = tls_session_ticket_setup();
+	if (ret == 0) {
+		ret = mbedtls_ssl_ticket_rotate(&server_ticket, key,
+						MBEDTLS_SSL_TICKET_KEY_NAME_BYTES,
+						&key[MBEDTLS_SSL_TICKET_KEY_NAME_BYTES],
+						TLS_TICKET_KEY_LEN,
+						CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+		if (ret != 0) {
+			NET_ERR("Failed to rotate ticket key (-0x%04X)", -ret);
+			ret = -EINVAL;
+		}
+	}
+
+	k_mutex_unlock(&ticket_lock);
+
+	mbedtls_platform_zeroize(key, sizeof(key));
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 static int tls_opt_peer_verify_set(struct tls_context *context,
 				   const void *optval, socklen_t optlen)
 {
@@ -2105,6 +2420,18 @@ int ztls_close_ctx(struct tls_context *ctx)
 {
 	int ret, err = 0;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+	if (atomic_test_bit(&ctx->handshake_offload,
+			    TLS_HANDSHAKE_OFFLOAD_PENDING)) {
+		atomic_set_bit(&ctx->handshake_offload, TLS_HANDSHAKE_OFFLOAD_ABORT);
+
+		/* The worker needs the lock to finish the handshake. */
+		k_mutex_unlock(ctx->lock);
+		(void)k_sem_take(&ctx->handshake_done, K_FOREVER);
+		k_mutex_lock(ctx->lock, K_FOREVER);
+	}
+#endif
+
 	/* Try to send close notification. */
 	ctx->flags = 0;
 
@@ -2228,6 +2555,19 @@ int ztls_accept_ctx(struct tls_context *parent, struct sockaddr *addr,
 	/* Do not use any socket flags during the handshake. */
 	child->flags = 0;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+	if (!is_blocking(parent->sock, 0)) {
+		/* Let a worker run the handshake, so that a non-blocking
+		 * accept loop is not stalled by it.
+		 */
+		atomic_set_bit(&child->handshake_offload,
+			       TLS_HANDSHAKE_OFFLOAD_PENDING);
+		(void)k_msgq_put(&tls_handshake_msgq, &child, K_NO_WAIT);
+
+		return fd;
+	}
+#endif
+
 	/* TODO For simplicity, TLS handshake blocks the socket even for
 	 * non-blocking socket.
 	 */
@@ -2422,6 +2762,15 @@ ssize_t ztls_sendto_ctx(struct tls_context *ctx, const void *buf, size_t len,
 
 	/* TLS */
 	if (ctx->type == SOCK_STREAM) {
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+		int ret = tls_handshake_offload_wait(ctx, is_blocking(ctx->sock, flags),
+						     ctx->options.timeout_tx);
+
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+#endif
 		return send_tls(ctx, buf, len, flags);
 	}
 
@@ -2474,6 +2823,27 @@ static ssize_t dtls_sendmsg_merge_and_send(struct tls_context *ctx,
 	return len;
 }
 
+static ssize_t tls_sendmsg_send_all(struct tls_context *ctx,
+				    const struct msghdr *msg,
+				    const uint8_t *buf, size_t len,
+				    int flags)
+{
+	size_t sent = 0;
+	ssize_t ret;
+
+	while (sent < len) {
+		ret = ztls_sendto_ctx(ctx, buf + sent, len - sent,
+				      flags, msg->msg_name,
+				      msg->msg_namelen);
+		if (ret < 0) {
+			return ret;
+		}
+		sent += ret;
+	}
+
+	return sent;
+}
+
 static ssize_t tls_sendmsg_loop_and_send(struct tls_context *ctx,
 					 const struct msghdr *msg,
 					 int flags)
@@ -2483,27 +2853,97 @@ static ssize_t tls_sendmsg_loop_and_send(struct tls_context *ctx,
 
 	for (int i = 0; i < msg->msg_iovlen; i++) {
 		struct iovec *vec = msg->msg_iov + i;
-		size_t sent = 0;
 
 		if (vec->iov_len == 0) {
 			continue;
 		}
 
-		while (sent < vec->iov_len) {
-			uint8_t *ptr = (uint8_t *)vec->iov_base + sent;
+		ret = tls_sendmsg_send_all(ctx, msg, vec->iov_base,
+					   vec->iov_len, flags);
+		if (ret < 0) {
+			return ret;
+		}
+		len += ret;
+	}
 
-			ret = ztls_sendto_ctx(ctx, ptr, vec->iov_len - sent,
-					      flags, msg->msg_name,
-					      msg->msg_namelen);
+	return len;
+}
+
+/* Coalesce small buffers into full records, instead of encrypting and sending
+ * a record for each of them. Buffers too large to be merged are sent as is.
+ */
+static ssize_t tls_sendmsg_merge_and_send(struct tls_context *ctx,
+					  const struct msghdr *msg,
+					  int flags)
+{
+	static K_MUTEX_DEFINE(tls_sendmsg_lock);
+	static uint8_t tls_sendmsg_buf[TLS_SENDMSG_BUF_SIZE];
+	size_t max_merge = sizeof(tls_sendmsg_buf);
+	size_t merged = 0;
+	ssize_t len = 0;
+	ssize_t ret;
+	int payload;
+
+	payload = mbedtls_ssl_get_max_out_record_payload(&ctx->ssl);
+	if (payload > 0) {
+		max_merge = MIN(max_merge, payload);
+	}
+
+	k_mutex_lock(&tls_sendmsg_lock, K_FOREVER);
+
+	for (int i = 0; i < msg->msg_iovlen; i++) {
+		struct iovec *vec = msg->msg_iov + i;
+
+		if (vec->iov_len == 0) {
+			continue;
+		}
+
+		if (merged + vec->iov_len <= max_merge) {
+			memcpy(tls_sendmsg_buf + merged, vec->iov_base,
+			       vec->iov_len);
+			merged += vec->iov_len;
+			continue;
+		}
+
+		if (merged > 0) {
+			ret = tls_sendmsg_send_all(ctx, msg, tls_sendmsg_buf,
+						   merged, flags);
 			if (ret < 0) {
-				return ret;
+				goto out;
 			}
-			sent += ret;
+			len += ret;
+			merged = 0;
+		}
+
+		if (vec->iov_len < max_merge) {
+			memcpy(tls_sendmsg_buf, vec->iov_base, vec->iov_len);
+			merged = vec->iov_len;
+			continue;
 		}
-		len += sent;
+
+		ret = tls_sendmsg_send_all(ctx, msg, vec->iov_base,
+					   vec->iov_len, flags);
+		if (ret < 0) {
+			goto out;
+		}
+		len += ret;
 	}
 
-	return len;
+	if (merged > 0) {
+		ret = tls_sendmsg_send_all(ctx, msg, tls_sendmsg_buf,
+					   merged, flags);
+		if (ret < 0) {
+			goto out;
+		}
+		len += ret;
+	}
+
+	ret = len;
+
+out:
+	k_mutex_unlock(&tls_sendmsg_lock);
+
+	return ret;
 }
 
 ssize_t ztls_sendmsg_ctx(struct tls_context *ctx, const struct msghdr *msg,
@@ -2538,6 +2978,11 @@ ssize_t ztls_sendmsg_ctx(struct tls_context *ctx, const struct msghdr *msg,
 		}
 	}
 
+	if (TLS_SENDMSG_BUF_SIZE > 0 && ctx->type == SOCK_STREAM &&
+	    msghdr_non_empty_iov_count(msg) > 1) {
+		return tls_sendmsg_merge_and_send(ctx, msg, flags);
+	}
+
 send_loop:
 	return tls_sendmsg_loop_and_send(ctx, msg, flags);
 }
@@ -2928,6 +3373,15 @@ ssize_t ztls_recvfrom_ctx(struct tls_context *ctx, void *buf, size_t max_len,
 
 	/* TLS */
 	if (ctx->type == SOCK_STREAM) {
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+		int ret = tls_handshake_offload_wait(ctx, is_blocking(ctx->sock, flags),
+						     ctx->options.timeout_rx);
+
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+#endif
 		return recv_tls(ctx, buf, max_len, flags);
 	}
 
@@ -2990,6 +3444,23 @@ static int ztls_poll_prepare_ctx(struct tls_context *ctx,
 		pfd->events &= ~ZSOCK_POLLIN;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+	/* Accepted socket with the handshake still run by a worker, only
+	 * data or the error of the handshake can be reported.
+	 */
+	if ((pfd->events & (ZSOCK_POLLIN | ZSOCK_POLLOUT)) &&
+	    atomic_test_bit(&ctx->handshake_offload,
+			    TLS_HANDSHAKE_OFFLOAD_PENDING)) {
+		(*pev)->obj = &ctx->handshake_done;
+		(*pev)->type = K_POLL_TYPE_SEM_AVAILABLE;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+
+		pfd->events &= ~(ZSOCK_POLLIN | ZSOCK_POLLOUT);
+	}
+#endif
+
 	obj = z_get_fd_obj_and_vtable(
 		ctx->sock, (const struct fd_op_vtable **)&vtable, &lock);
 	if (obj == NULL) {
@@ -3220,6 +3691,36 @@ static int ztls_poll_update_ctx(struct tls_context *ctx,
 		pfd->events &= ~ZSOCK_POLLIN;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD)
+	if ((pfd->events & (ZSOCK_POLLIN | ZSOCK_POLLOUT)) &&
+	    ((*pev)->obj == &ctx->handshake_done)) {
+		if ((*pev)->state == K_POLL_STATE_NOT_READY) {
+			/* Handshake still run by the worker. */
+		} else if (ctx->error != 0) {
+			pfd->revents |= ZSOCK_POLLERR;
+		} else if (pfd->events & ZSOCK_POLLOUT) {
+			/* A newly established connection is writable. */
+			pfd->revents |= ZSOCK_POLLOUT;
+		} else {
+			/* Monitor the underlying socket for data now, as
+			 * with the DTLS client above.
+			 */
+			ret = z_fdtable_call_ioctl(vtable, obj,
+						   ZFD_IOCTL_POLL_PREPARE,
+						   pfd, pev, *pev + 1);
+			if (ret != 0 && ret != -EALREADY) {
+				goto out;
+			}
+
+			ret = -EAGAIN;
+			goto out;
+		}
+
+		(*pev)++;
+		pfd->events &= ~(ZSOCK_POLLIN | ZSOCK_POLLOUT);
+	}
+#endif
+
 	ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE,
 				   pfd, pev);
 	if (ret != 0) {
@@ -3459,6 +3960,12 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_get(ctx, optval, optlen);
 		break;
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	case TLS_SESSION_TICKET:
+		err = tls_opt_session_ticket_get(ctx, optval, optlen);
+		break;
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_get(ctx, optval,
@@ -3581,6 +4088,16 @@ int ztls_setsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_purge_set(ctx, optval, optlen);
 		break;
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	case TLS_SESSION_TICKET:
+		err = tls_opt_session_ticket_set(ctx, optval, optlen);
+		break;
+
+	case TLS_SESSION_TICKET_KEY:
+		err = tls_opt_session_ticket_key_set(ctx, optval, optlen);
+		break;
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_set(ctx, optval,
@@ -574,6 +574,41 @@ static int sendmsg_all(int sock, const struct msghdr *message, int flags)
 }
 #endif /* !defined(CONFIG_NET_TEST) */
 
+/* XOR payload data with the masking key, a word at a time. The data starts at
+ * the given offset of the payload, dst and src may be the same buffer.
+ */
+static void websocket_mask(uint8_t *dst, const uint8_t *src, size_t len,
+			   uint32_t masking_value, uint64_t offset)
+{
+	uint8_t key[sizeof(uint32_t)];
+	uint8_t key_at[sizeof(uint32_t)];
+	uint32_t key_word;
+	uint32_t word;
+	size_t i = 0;
+
+	sys_put_be32(masking_value, key);
+
+	for (; i < len && !IS_ALIGNED(&dst[i], sizeof(uint32_t)); i++) {
+		dst[i] = src[i] ^ key[(offset + i) % sizeof(key)];
+	}
+
+	/* The key in memory order, starting at the first aligned byte */
+	for (size_t j = 0; j < sizeof(key); j++) {
+		key_at[j] = key[(offset + i + j) % sizeof(key)];
+	}
+
+	memcpy(&key_word, key_at, sizeof(key_word));
+
+	for (; i + sizeof(word) <= len; i += sizeof(word)) {
+		memcpy(&word, &src[i], sizeof(word));
+		*(uint32_t *)&dst[i] = word ^ key_word;
+	}
+
+	for (; i < len; i++) {
+		dst[i] = src[i] ^ key[(offset + i) % sizeof(key)];
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
 				      uint8_t *payload, size_t payload_len,
@@ -687,8 +722,6 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
-
 		ctx->masking_value = sys_rand32_get();
 
 		header[hdr_len++] |= ctx->masking_value >> 24;
@@ -697,16 +730,14 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		header[hdr_len++] |= ctx->masking_value;
 
 		if ((payload != NULL) && (payload_len > 0)) {
+			/* The payload is const, mask while copying it */
 			data_to_send = k_malloc(payload_len);
 			if (!data_to_send) {
 				return -ENOMEM;
 			}
 
-			memcpy(data_to_send, payload, payload_len);
-
-			for (i = 0; i < payload_len; i++) {
-				data_to_send[i] ^= ctx->masking_value >> (8 * (3 - i % 4));
-			}
+			websocket_mask(data_to_send, payload, payload_len,
+				       ctx->masking_value, 0);
 		}
 	}
 
@@ -945,13 +976,19 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 		size_t parsed_count;
 
 		if (ctx->recv_buf.count == 0) {
+			/* Receive the rest of a payload straight into the user buffer */
+			bool direct = (ctx->parser_state == WEBSOCKET_PARSER_STATE_PAYLOAD);
+			uint8_t *dst = direct ? &payload.buf[payload.count] : ctx->recv_buf.buf;
+			size_t dst_len = direct ? MIN(ctx->parser_remaining,
+						      payload.size - payload.count)
+						: ctx->recv_buf.size;
+
 #if defined(CONFIG_NET_TEST)
-			size_t input_len = MIN(ctx->recv_buf.size,
+			size_t input_len = MIN(dst_len,
 					       test_data->input_len - test_data->input_pos);
 
 			if (input_len > 0) {
-				memcpy(ctx->recv_buf.buf,
-				       &test_data->input_buf[test_data->input_pos], input_len);
+				memcpy(dst, &test_data->input_buf[test_data->input_pos], input_len);
 				test_data->input_pos += input_len;
 				ret = input_len;
 			} else {
@@ -963,8 +1000,7 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 			ret = wait_rx(ctx->real_sock, timeout_to_ms(&tout));
 			if (ret == 0) {
-				ret = zsock_recv(ctx->real_sock, ctx->recv_buf.buf,
-						 ctx->recv_buf.size, MSG_DONTWAIT);
+				ret = zsock_recv(ctx->real_sock, dst, dst_len, MSG_DONTWAIT);
 				if (ret < 0) {
 					ret = -errno;
 				}
@@ -984,9 +1020,30 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 				return -ENOTCONN;
 			}
 
-			ctx->recv_buf.count = ret;
+			NET_DBG("[%p] Received %d bytes%s", ctx, ret, direct ? " of payload" : "");
+
+			if (direct) {
+				payload.count += ret;
+				ctx->parser_remaining -= ret;
+				if (ctx->parser_remaining == 0) {
+					ctx->parser_state = WEBSOCKET_PARSER_STATE_OPCODE;
+				}
+
+				if ((ctx->parser_state == WEBSOCKET_PARSER_STATE_OPCODE) ||
+				    (payload.count >= payload.size)) {
+					if (remaining != NULL) {
+						*remaining = ctx->parser_remaining;
+					}
+					if (message_type != NULL) {
+						*message_type = ctx->message_type;
+					}
+					break;
+				}
+
+				continue;
+			}
 
-			NET_DBG("[%p] Received %d bytes", ctx, ret);
+			ctx->recv_buf.count = ret;
 		}
 
 		ret = websocket_parse(ctx, &payload);
@@ -1019,15 +1076,8 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	/* Unmask the data */
 	if (ctx->masked) {
-		uint8_t *mask_as_bytes = (uint8_t *)&ctx->masking_value;
-		size_t data_buf_offset = ctx->message_len - ctx->parser_remaining - payload.count;
-
-		for (size_t i = 0; i < payload.count; i++) {
-			size_t m = data_buf_offset % 4;
-
-			payload.buf[i] ^= mask_as_bytes[3 - m];
-			data_buf_offset++;
-		}
+		websocket_mask(payload.buf, payload.buf, payload.count, ctx->masking_value,
+			       ctx->message_len - ctx->parser_remaining - payload.count);
 	}
 
 	return payload.count;
@@ -211,6 +211,135 @@ void zperf_async_work_submit(struct k_work *work)
 	k_work_submit_to_queue(&zperf_work_q, work);
 }
 
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+K_THREAD_STACK_ARRAY_DEFINE(zperf_stream_stacks, CONFIG_NET_ZPERF_MAX_STREAMS,
+			    CONFIG_NET_ZPERF_STREAM_STACK_SIZE);
+
+static struct zperf_stream {
+	struct k_thread thread;
+	const struct zperf_upload_params *param;
+	zperf_stream_upload_t upload;
+	struct zperf_results results;
+	int ret;
+} zperf_streams[CONFIG_NET_ZPERF_MAX_STREAMS];
+
+/* Serializes the parallel uploads, which share the stream threads */
+static K_MUTEX_DEFINE(zperf_streams_lock);
+
+static void zperf_stream_thread(void *p1, void *p2, void *p3)
+{
+	struct zperf_stream *stream = p1;
+
+	ARG_UNUSED(p3);
+
+	stream->ret = stream->upload(stream->param, POINTER_TO_INT(p2),
+				     &stream->results);
+}
+
+static void zperf_results_add(struct zperf_results *total,
+			      const struct zperf_results *results)
+{
+	total->nb_packets_sent += results->nb_packets_sent;
+	total->nb_packets_rcvd += results->nb_packets_rcvd;
+	total->nb_packets_lost += results->nb_packets_lost;
+	total->nb_packets_outorder += results->nb_packets_outorder;
+	total->nb_packets_errors += results->nb_packets_errors;
+	total->total_len += results->total_len;
+	total->time_in_us = MAX(total->time_in_us, results->time_in_us);
+	total->client_time_in_us = MAX(total->client_time_in_us,
+				       results->client_time_in_us);
+	total->jitter_in_us = MAX(total->jitter_in_us, results->jitter_in_us);
+	total->packet_size = results->packet_size;
+
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+	for (int i = 0; i < ZPERF_HIST_BUCKETS; i++) {
+		total->send_hist[i] += results->send_hist[i];
+		total->jitter_hist[i] += results->jitter_hist[i];
+	}
+#endif
+}
+
+static int zperf_upload_parallel(const struct zperf_upload_params *param,
+				 struct zperf_results *results,
+				 zperf_stream_upload_t upload)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	int ret = 0;
+
+	if (k_mutex_lock(&zperf_streams_lock, K_NO_WAIT) != 0) {
+		return -EBUSY;
+	}
+
+	for (int i = 0; i < param->num_streams; i++) {
+		struct zperf_stream *stream = &zperf_streams[i];
+
+		(void)memset(&stream->results, 0, sizeof(stream->results));
+		stream->param = param;
+		stream->upload = upload;
+		stream->ret = 0;
+
+		k_thread_create(&stream->thread, zperf_stream_stacks[i],
+				K_THREAD_STACK_SIZEOF(zperf_stream_stacks[i]),
+				zperf_stream_thread, stream, INT_TO_POINTER(i),
+				NULL, prio, 0, K_FOREVER);
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+		(void)k_thread_cpu_pin(&stream->thread,
+				       i % arch_num_cpus());
+#endif
+
+		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+			char name[CONFIG_THREAD_MAX_NAME_LEN];
+
+			snprintk(name, sizeof(name), "zperf_stream%d", i);
+			k_thread_name_set(&stream->thread, name);
+		}
+	}
+
+	for (int i = 0; i < param->num_streams; i++) {
+		k_thread_start(&zperf_streams[i].thread);
+	}
+
+	for (int i = 0; i < param->num_streams; i++) {
+		struct zperf_stream *stream = &zperf_streams[i];
+
+		(void)k_thread_join(&stream->thread, K_FOREVER);
+
+		if (stream->ret < 0) {
+			NET_ERR("Stream %d failed (%d)", i, stream->ret);
+			ret = stream->ret;
+			continue;
+		}
+
+		zperf_results_add(results, &stream->results);
+	}
+
+	k_mutex_unlock(&zperf_streams_lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_ZPERF_MAX_STREAMS > 1 */
+
+int zperf_upload_streams(const struct zperf_upload_params *param,
+			 struct zperf_results *results,
+			 zperf_stream_upload_t upload)
+{
+	if (param->num_streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+		NET_ERR("Too many streams, max %d", CONFIG_NET_ZPERF_MAX_STREAMS);
+		return -EINVAL;
+	}
+
+	(void)memset(results, 0, sizeof(*results));
+
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+	if (param->num_streams > 1) {
+		return zperf_upload_parallel(param, results, upload);
+	}
+#endif
+
+	return upload(param, 0, results);
+}
+
 static int zperf_init(void)
 {
 
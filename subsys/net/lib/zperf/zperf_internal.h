@@ -7,6 +7,7 @@
 #define __ZPERF_INTERNAL_H
 
 #include <limits.h>
+#include <zephyr/kernel.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/zperf.h>
 #include <zephyr/shell/shell.h>
@@ -87,6 +88,48 @@ static inline uint32_t time_delta(uint32_t ts, uint32_t t)
 	return (t >= ts) ? (t - ts) : (ULONG_MAX - ts + t);
 }
 
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+static inline void zperf_hist_add(uint32_t hist[ZPERF_HIST_BUCKETS], uint32_t us)
+{
+	uint32_t bucket = (us == 0U) ? 0U : 32U - __builtin_clz(us);
+
+	hist[MIN(bucket, ZPERF_HIST_BUCKETS - 1U)]++;
+}
+
+static inline uint32_t zperf_hist_start(void)
+{
+	return k_cycle_get_32();
+}
+
+static inline void zperf_hist_send(struct zperf_results *results,
+				   uint32_t start)
+{
+	zperf_hist_add(results->send_hist,
+		       k_cyc_to_us_floor32(k_cycle_get_32() - start));
+}
+#else
+static inline uint32_t zperf_hist_start(void)
+{
+	return 0U;
+}
+
+static inline void zperf_hist_send(struct zperf_results *results,
+				   uint32_t start)
+{
+	ARG_UNUSED(results);
+	ARG_UNUSED(start);
+}
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
+
+/* Upload of one stream, numbered from 0, to the results given */
+typedef int (*zperf_stream_upload_t)(const struct zperf_upload_params *param,
+				     int stream,
+				     struct zperf_results *results);
+
+int zperf_upload_streams(const struct zperf_upload_params *param,
+			 struct zperf_results *results,
+			 zperf_stream_upload_t upload);
+
 int zperf_get_ipv6_addr(char *host, char *prefix_str, struct in6_addr *addr);
 struct sockaddr_in6 *zperf_get_sin6(void);
 
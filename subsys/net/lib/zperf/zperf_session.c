@@ -100,6 +100,9 @@ void zperf_reset_session_stats(struct session *session)
 	session->error = 0U;
 	session->jitter = 0;
 	session->last_transit_time = 0;
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+	(void)memset(session->jitter_hist, 0, sizeof(session->jitter_hist));
+#endif
 }
 
 void zperf_session_reset(enum session_proto proto)
@@ -49,6 +49,9 @@ struct session {
 	uint32_t last_time;
 	int32_t jitter;
 	int32_t last_transit_time;
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+	uint32_t jitter_hist[ZPERF_HIST_BUCKETS];
+#endif
 
 	/* Stats packet*/
 	struct zperf_server_hdr stat;
@@ -132,6 +132,76 @@ static void print_number_64(const struct shell *sh, uint64_t value,
 	}
 }
 
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+static void print_histogram(const struct shell *sh, const char *title,
+			    const uint32_t hist[ZPERF_HIST_BUCKETS])
+{
+	shell_fprintf(sh, SHELL_NORMAL, "%s:\n", title);
+
+	for (int i = 0; i < ZPERF_HIST_BUCKETS; i++) {
+		if (hist[i] == 0U) {
+			continue;
+		}
+
+		if (i == ZPERF_HIST_BUCKETS - 1) {
+			shell_fprintf(sh, SHELL_NORMAL, "  >= %u us:\t%u\n",
+				      (uint32_t)BIT(i - 1), hist[i]);
+		} else {
+			shell_fprintf(sh, SHELL_NORMAL, "  <  %u us:\t%u\n",
+				      (uint32_t)BIT(i), hist[i]);
+		}
+	}
+}
+
+static void print_histogram_json(const struct shell *sh, const char *name,
+				 const uint32_t hist[ZPERF_HIST_BUCKETS])
+{
+	shell_fprintf(sh, SHELL_NORMAL, ",\"%s\":[", name);
+
+	for (int i = 0; i < ZPERF_HIST_BUCKETS; i++) {
+		shell_fprintf(sh, SHELL_NORMAL, "%s%u", i ? "," : "", hist[i]);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "]");
+}
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
+
+/* Print the results of an upload on one line, as a JSON object */
+static void print_upload_json(const struct shell *sh, const char *proto,
+			      const struct zperf_results *results)
+{
+	uint64_t client_rate_in_kbps = 0U;
+
+	if (results->client_time_in_us != 0U) {
+		client_rate_in_kbps =
+			((uint64_t)results->nb_packets_sent *
+			 (uint64_t)results->packet_size * 8ULL * USEC_PER_SEC) /
+			(results->client_time_in_us * 1000U);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "{\"proto\":\"%s\",\"client_time_us\":%llu,"
+		      "\"server_time_us\":%llu,\"packet_size\":%u,"
+		      "\"packets_sent\":%u,\"packets_rcvd\":%u,"
+		      "\"packets_lost\":%u,\"packets_outorder\":%u,"
+		      "\"errors\":%u,\"bytes_rcvd\":%llu,\"jitter_us\":%u,"
+		      "\"client_rate_kbps\":%llu",
+		      proto, (unsigned long long)results->client_time_in_us,
+		      (unsigned long long)results->time_in_us,
+		      results->packet_size, results->nb_packets_sent,
+		      results->nb_packets_rcvd, results->nb_packets_lost,
+		      results->nb_packets_outorder, results->nb_packets_errors,
+		      (unsigned long long)results->total_len,
+		      results->jitter_in_us,
+		      (unsigned long long)client_rate_in_kbps);
+
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+	print_histogram_json(sh, "send_hist", results->send_hist);
+#endif
+
+	shell_fprintf(sh, SHELL_NORMAL, "}\n");
+}
+
 static long parse_number(const char *string, const uint32_t *divisor_arr,
 			 const char **units)
 {
@@ -355,6 +425,9 @@ static void udp_session_cb(enum zperf_status status,
 		print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+		print_histogram(sh, " jitter histogram", result->jitter_hist);
+#endif
 		break;
 	}
 
@@ -472,12 +545,20 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 	}
 }
 
+/* Set by the -J option of the upload commands */
+static bool upload_json;
+
 static void shell_udp_upload_print_stats(const struct shell *sh,
 					 struct zperf_results *results)
 {
 	if (IS_ENABLED(CONFIG_NET_UDP)) {
 		unsigned int rate_in_kbps, client_rate_in_kbps;
 
+		if (upload_json) {
+			print_upload_json(sh, "udp", results);
+			return;
+		}
+
 		shell_fprintf(sh, SHELL_NORMAL, "-\nUpload completed!\n");
 
 		if (results->time_in_us != 0U) {
@@ -533,6 +614,10 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 		shell_fprintf(sh, SHELL_NORMAL, "\t(");
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, ")\n");
+
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+		print_histogram(sh, "Send time histogram", results->send_hist);
+#endif
 	}
 }
 
@@ -542,6 +627,11 @@ static void shell_tcp_upload_print_stats(const struct shell *sh,
 	if (IS_ENABLED(CONFIG_NET_TCP)) {
 		unsigned int client_rate_in_kbps;
 
+		if (upload_json) {
+			print_upload_json(sh, "tcp", results);
+			return;
+		}
+
 		shell_fprintf(sh, SHELL_NORMAL, "-\nUpload completed!\n");
 
 		if (results->client_time_in_us != 0U) {
@@ -566,6 +656,10 @@ static void shell_tcp_upload_print_stats(const struct shell *sh,
 		shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t");
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+		print_histogram(sh, "Send time histogram", results->send_hist);
+#endif
 	}
 }
 
@@ -664,11 +758,13 @@ static void send_ping(const struct shell *sh,
 
 static int execute_upload(const struct shell *sh,
 			  const struct zperf_upload_params *param,
-			  bool is_udp, bool async)
+			  bool is_udp, bool async, bool json)
 {
 	struct zperf_results results = { 0 };
 	int ret;
 
+	upload_json = json;
+
 	shell_fprintf(sh, SHELL_NORMAL, "Duration:\t");
 	print_number_64(sh, (uint64_t)param->duration_ms * USEC_PER_MSEC, TIME_US,
 		     TIME_US_UNIT);
@@ -677,6 +773,10 @@ static int execute_upload(const struct shell *sh,
 		      param->packet_size);
 	shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t%u kbps\n",
 		      param->rate_kbps);
+	if (param->num_streams > 1) {
+		shell_fprintf(sh, SHELL_NORMAL, "Streams:\t%u\n",
+			      param->num_streams);
+	}
 	shell_fprintf(sh, SHELL_NORMAL, "Starting...\n");
 
 	if (IS_ENABLED(CONFIG_NET_IPV6) && param->peer_addr.sa_family == AF_INET6) {
@@ -796,6 +896,7 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 	struct sockaddr_in ipv4 = { .sin_family = AF_INET };
 	char *port_str;
 	bool async = false;
+	bool json = false;
 	bool is_udp;
 	int start = 0;
 	size_t opt_cnt = 0;
@@ -830,6 +931,27 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'J':
+			json = true;
+			opt_cnt += 1;
+			break;
+
+		case 'P': {
+			int streams = parse_arg(&i, argc, argv);
+
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Invalid number of streams, "
+					      "max %d\n",
+					      CONFIG_NET_ZPERF_MAX_STREAMS);
+				return -ENOEXEC;
+			}
+
+			param.num_streams = streams;
+			opt_cnt += 2;
+			break;
+		}
+
 		case 'n':
 			if (is_udp) {
 				shell_fprintf(sh, SHELL_WARNING,
@@ -990,7 +1112,7 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 		param.rate_kbps = 10U;
 	}
 
-	return execute_upload(sh, &param, is_udp, async);
+	return execute_upload(sh, &param, is_udp, async, json);
 }
 
 static int cmd_tcp_upload(const struct shell *sh, size_t argc, char *argv[])
@@ -1010,6 +1132,7 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 	sa_family_t family;
 	uint8_t is_udp;
 	bool async = false;
+	bool json = false;
 	int start = 0;
 	size_t opt_cnt = 0;
 
@@ -1041,6 +1164,27 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'J':
+			json = true;
+			opt_cnt += 1;
+			break;
+
+		case 'P': {
+			int streams = parse_arg(&i, argc, argv);
+
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Invalid number of streams, "
+					      "max %d\n",
+					      CONFIG_NET_ZPERF_MAX_STREAMS);
+				return -ENOEXEC;
+			}
+
+			param.num_streams = streams;
+			opt_cnt += 2;
+			break;
+		}
+
 		case 'n':
 			if (is_udp) {
 				shell_fprintf(sh, SHELL_WARNING,
@@ -1154,7 +1298,7 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 		param.rate_kbps = 10U;
 	}
 
-	return execute_upload(sh, &param, is_udp, async);
+	return execute_upload(sh, &param, is_udp, async, json);
 }
 
 static int cmd_tcp_upload2(const struct shell *sh, size_t argc,
@@ -1380,6 +1524,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P num: Number of parallel streams\n"
+		  "-J: Print the results as a JSON object on one line\n"
 		  "-n: Disable Nagle's algorithm\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
@@ -1397,6 +1543,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P num: Number of parallel streams\n"
+		  "-J: Print the results as a JSON object on one line\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1440,6 +1588,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P num: Number of parallel streams\n"
+		  "-J: Print the results as a JSON object on one line\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1458,6 +1608,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P num: Number of parallel streams\n"
+		  "-J: Print the results as a JSON object on one line\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -183,6 +183,10 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 			results.time_in_us = duration;
 			results.jitter_in_us = session->jitter;
 			results.packet_size = session->length / session->counter;
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+			memcpy(results.jitter_hist, session->jitter_hist,
+			       sizeof(results.jitter_hist));
+#endif
 
 			if (udp_session_cb != NULL) {
 				udp_session_cb(ZPERF_SESSION_FINISHED, &results,
@@ -208,6 +212,10 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 
 				session->jitter +=
 					(delta_transit - session->jitter) / 16;
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM)
+				zperf_hist_add(session->jitter_hist,
+					       delta_transit);
+#endif
 			}
 
 			session->last_transit_time = transit_time;
@@ -14,9 +14,12 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include "zperf_internal.h"
 
-static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
-			     sizeof(struct zperf_client_hdr_v1) +
-			     PACKET_SIZE_MAX];
+#define SAMPLE_PACKET_SIZE (sizeof(struct zperf_udp_datagram) +		\
+			    sizeof(struct zperf_client_hdr_v1) +	\
+			    PACKET_SIZE_MAX)
+
+/* One packet buffer per stream of a parallel upload */
+static uint8_t sample_packets[CONFIG_NET_ZPERF_MAX_STREAMS][SAMPLE_PACKET_SIZE];
 
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
@@ -46,7 +49,8 @@ static inline void zperf_upload_decode_stat(const uint8_t *data,
 		ntohl(UNALIGNED_GET(&stat->jitter1)) * USEC_PER_SEC;
 }
 
-static inline int zperf_upload_fin(int sock,
+static inline int zperf_upload_fin(int sock, uint8_t *sample_packet,
+				   uint32_t num_streams,
 				   uint32_t nb_packets,
 				   uint64_t end_time,
 				   uint32_t packet_size,
@@ -83,9 +87,9 @@ static inline int zperf_upload_fin(int sock,
 		 * to set there some meaningful values.
 		 */
 		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
+		hdr->num_of_threads = htonl(num_streams);
 		hdr->port = 0;
-		hdr->buffer_len = sizeof(sample_packet) -
+		hdr->buffer_len = SAMPLE_PACKET_SIZE -
 			sizeof(*datagram) - sizeof(*hdr);
 		hdr->bandwidth = 0;
 		hdr->num_of_bytes = htonl(packet_size);
@@ -138,10 +142,11 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
-static int udp_upload(int sock, int port,
+static int udp_upload(int sock, int port, uint8_t *sample_packet,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
 {
+	uint32_t num_streams = MAX(param->num_streams, 1);
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
@@ -174,13 +179,14 @@ static int udp_upload(int sock, int port,
 	print_period = k_ms_to_ticks_ceil32(MSEC_PER_SEC);
 	print_time = start_time + print_period;
 
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+	(void)memset(sample_packet, 'z', SAMPLE_PACKET_SIZE);
 
 	do {
 		struct zperf_udp_datagram *datagram;
 		struct zperf_client_hdr_v1 *hdr;
 		uint64_t usecs64;
 		uint32_t secs, usecs;
+		uint32_t send_start;
 		int64_t loop_time;
 		int32_t adjust;
 
@@ -219,15 +225,17 @@ static int udp_upload(int sock, int port,
 		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
 						     sizeof(*datagram));
 		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
+		hdr->num_of_threads = htonl(num_streams);
 		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
+		hdr->buffer_len = SAMPLE_PACKET_SIZE -
 			sizeof(*datagram) - sizeof(*hdr);
 		hdr->bandwidth = htonl(rate_in_kbps);
 		hdr->num_of_bytes = htonl(packet_size);
 
 		/* Send the packet */
+		send_start = zperf_hist_start();
 		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		zperf_hist_send(results, send_start);
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
@@ -267,8 +275,8 @@ static int udp_upload(int sock, int port,
 	} else {
 		return -EINVAL;
 	}
-	ret = zperf_upload_fin(sock, nb_packets, end_time, packet_size,
-			       results, is_mcast_pkt);
+	ret = zperf_upload_fin(sock, sample_packet, num_streams, nb_packets,
+			       end_time, packet_size, results, is_mcast_pkt);
 	if (ret < 0) {
 		return ret;
 	}
@@ -282,18 +290,14 @@ static int udp_upload(int sock, int port,
 	return 0;
 }
 
-int zperf_udp_upload(const struct zperf_upload_params *param,
-		     struct zperf_results *result)
+static int udp_upload_stream(const struct zperf_upload_params *param,
+			     int stream, struct zperf_results *result)
 {
 	int port = 0;
 	int sock;
 	int ret;
 	struct ifreq req;
 
-	if (param == NULL || result == NULL) {
-		return -EINVAL;
-	}
-
 	if (param->peer_addr.sa_family == AF_INET) {
 		port = ntohs(net_sin(&param->peer_addr)->sin_port);
 	} else if (param->peer_addr.sa_family == AF_INET6) {
@@ -321,13 +325,23 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 		}
 	}
 
-	ret = udp_upload(sock, port, param, result);
+	ret = udp_upload(sock, port, sample_packets[stream], param, result);
 
 	zsock_close(sock);
 
 	return ret;
 }
 
+int zperf_udp_upload(const struct zperf_upload_params *param,
+		     struct zperf_results *result)
+{
+	if (param == NULL || result == NULL) {
+		return -EINVAL;
+	}
+
+	return zperf_upload_streams(param, result, udp_upload_stream);
+}
+
 static void udp_upload_async_work(struct k_work *work)
 {
 	struct zperf_async_upload_context *upload_ctx =
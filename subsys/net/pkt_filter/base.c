@@ -167,6 +167,13 @@ bool net_pkt_filter_ip_recv_ok(struct net_pkt *pkt)
 }
 #endif /* CONFIG_NET_PKT_FILTER_IPV4_HOOK || CONFIG_NET_PKT_FILTER_IPV6_HOOK */
 
+bool npf_rules_ok(struct npf_rule_list *rules, struct net_pkt *pkt)
+{
+	enum net_verdict result = lock_evaluate(rules, pkt);
+
+	return result == NET_OK;
+}
+
 /*
  * Rule management
  */
@@ -19,6 +19,10 @@
 
 #include "pm_stats.h"
 
+#ifdef CONFIG_PM_HIBERNATE
+#include <zephyr/arch/common/pm_s2ram.h>
+#endif
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm, CONFIG_PM_LOG_LEVEL);
 
@@ -170,6 +174,10 @@ bool pm_system_suspend(int32_t ticks)
 {
 	uint8_t id = _current_cpu->id;
 	k_spinlock_key_t key;
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+	bool predicted = false;
+	uint32_t idle_start_cyc;
+#endif
 
 	SYS_PORT_TRACING_FUNC_ENTER(pm, system_suspend, ticks);
 
@@ -183,6 +191,9 @@ bool pm_system_suspend(int32_t ticks)
 		info = pm_policy_next_state(id, ticks);
 		if (info != NULL) {
 			z_cpus_pm_state[id] = *info;
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+			predicted = true;
+#endif
 		} else {
 			z_cpus_pm_state[id].state = PM_STATE_ACTIVE;
 		}
@@ -233,11 +244,19 @@ bool pm_system_suspend(int32_t ticks)
 	 */
 	k_sched_lock();
 	pm_stats_start();
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+	idle_start_cyc = k_cycle_get_32();
+#endif
 	/* Enter power state */
 	pm_state_notify(true);
 	atomic_set_bit(z_post_ops_required, id);
 	pm_state_set(z_cpus_pm_state[id].state, z_cpus_pm_state[id].substate_id);
 	pm_stats_stop();
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+	if (predicted) {
+		pm_policy_residency_update(id, k_cycle_get_32() - idle_start_cyc);
+	}
+#endif
 
 	/* Wake up sequence starts here */
 #if defined(CONFIG_PM_DEVICE) && !defined(CONFIG_PM_DEVICE_RUNTIME_EXCLUSIVE)
@@ -276,6 +295,34 @@ int pm_notifier_unregister(struct pm_notifier *notifier)
 	return ret;
 }
 
+#ifdef CONFIG_PM_HIBERNATE
+int pm_system_hibernate(void)
+{
+	unsigned int key;
+	int ret;
+
+	k_sched_lock();
+	key = irq_lock();
+
+#if defined(CONFIG_PM_DEVICE) && !defined(CONFIG_PM_DEVICE_RUNTIME_EXCLUSIVE)
+	ret = pm_suspend_devices();
+	if (ret == 0) {
+		/* returns on wakeup, or if the system could not be powered off */
+		ret = arch_pm_s2ram_suspend(pm_hibernate_system_off);
+	}
+
+	pm_resume_devices();
+#else
+	ret = arch_pm_s2ram_suspend(pm_hibernate_system_off);
+#endif
+
+	irq_unlock(key);
+	k_sched_unlock();
+
+	return ret;
+}
+#endif /* CONFIG_PM_HIBERNATE */
+
 const struct pm_state_info *pm_state_next_get(uint8_t cpu)
 {
 	return &z_cpus_pm_state[cpu];
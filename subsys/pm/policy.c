@@ -130,12 +130,121 @@ static void update_next_event(uint32_t cyc)
 	next_event_cyc = new_next_event_cyc;
 }
 
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+/** Number of history bins: one per power state, plus one for too short idle */
+#define IDLE_HISTORY_BINS (DT_NUM_INST_STATUS_OKAY(zephyr_power_state) + 1)
+/** Weight of the last idle period in the history */
+#define IDLE_HISTORY_PULSE 1024U
+
+/**
+ * Idle history of each CPU.
+ *
+ * Idle periods are counted in the bin of the deepest state they were long
+ * enough for, bin 0 being for the periods too short for any state. A period
+ * ended by the timer as expected is a hit, one ended earlier by another
+ * wakeup source (an interrupt) is an intercept. The history decays at each
+ * idle period, so that it follows the recent behavior of the system.
+ */
+static struct {
+	uint32_t hits[IDLE_HISTORY_BINS];
+	uint32_t intercepts[IDLE_HISTORY_BINS];
+	/** Idle time allowed by the timer when entering the state (<0: forever) */
+	int64_t expected_cyc;
+	/** Exit latency of the entered state */
+	uint32_t exit_latency_cyc;
+} idle_history[CONFIG_MP_MAX_NUM_CPUS];
+
+/** @brief Get the bin of an idle period. */
+static uint8_t idle_history_bin(const struct pm_state_info *cpu_states,
+				uint8_t num_cpu_states, int64_t cyc)
+{
+	for (int16_t i = (int16_t)num_cpu_states - 1; i >= 0; i--) {
+		if (cyc >= (k_us_to_cyc_ceil32(cpu_states[i].min_residency_us) +
+			    k_us_to_cyc_ceil32(cpu_states[i].exit_latency_us))) {
+			return i + 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Check if the history predicts that a state pays off.
+ *
+ * The state is rejected when most of the recent idle periods were interrupted
+ * before its minimum residency, however long the timer would have allowed.
+ */
+static bool idle_history_predicts(uint8_t cpu, int16_t state_idx)
+{
+	uint32_t early = 0U, total = 0U;
+
+	if (cpu >= ARRAY_SIZE(idle_history)) {
+		return true;
+	}
+
+	for (int16_t i = 0; i < IDLE_HISTORY_BINS; i++) {
+		if (i <= state_idx) {
+			early += idle_history[cpu].intercepts[i];
+		}
+		total += idle_history[cpu].hits[i] + idle_history[cpu].intercepts[i];
+	}
+
+	return (2U * early) <= total;
+}
+
+/** @brief Record what the timer allows for the state about to be entered. */
+static const struct pm_state_info *idle_history_enter(uint8_t cpu, int64_t cyc,
+						      const struct pm_state_info *state)
+{
+	if (cpu < ARRAY_SIZE(idle_history)) {
+		idle_history[cpu].expected_cyc = cyc;
+		idle_history[cpu].exit_latency_cyc = k_us_to_cyc_ceil32(state->exit_latency_us);
+	}
+
+	return state;
+}
+
+void pm_policy_residency_update(uint8_t cpu, uint32_t residency_cyc)
+{
+	const struct pm_state_info *cpu_states;
+	uint8_t num_cpu_states = pm_state_cpu_get_all(cpu, &cpu_states);
+	int64_t expected_cyc;
+
+	if (cpu >= ARRAY_SIZE(idle_history)) {
+		return;
+	}
+
+	expected_cyc = idle_history[cpu].expected_cyc;
+
+	for (int16_t i = 0; i < IDLE_HISTORY_BINS; i++) {
+		idle_history[cpu].hits[i] -=
+			idle_history[cpu].hits[i] >> CONFIG_PM_POLICY_PREDICTIVE_DECAY_SHIFT;
+		idle_history[cpu].intercepts[i] -=
+			idle_history[cpu].intercepts[i] >> CONFIG_PM_POLICY_PREDICTIVE_DECAY_SHIFT;
+	}
+
+	/* the timer is set to expire the exit latency early, within a tick */
+	if ((expected_cyc >= 0) &&
+	    ((int64_t)residency_cyc + idle_history[cpu].exit_latency_cyc +
+	     k_ticks_to_cyc_ceil32(1) >= expected_cyc)) {
+		idle_history[cpu].hits[idle_history_bin(cpu_states, num_cpu_states,
+							expected_cyc)] += IDLE_HISTORY_PULSE;
+	} else {
+		idle_history[cpu].intercepts[idle_history_bin(cpu_states, num_cpu_states,
+							      residency_cyc)] += IDLE_HISTORY_PULSE;
+	}
+}
+#endif /* CONFIG_PM_POLICY_PREDICTIVE */
+
 #ifdef CONFIG_PM_POLICY_DEFAULT
 const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
 {
 	int64_t cyc = -1;
 	uint8_t num_cpu_states;
 	const struct pm_state_info *cpu_states;
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+	const struct pm_state_info *fallback = NULL;
+#endif
 
 #ifdef CONFIG_PM_NEED_ALL_DEVICES_IDLE
 	if (pm_device_is_any_busy()) {
@@ -190,10 +299,30 @@ const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
 
 		if ((cyc < 0) ||
 		    (cyc >= (min_residency_cyc + exit_latency_cyc))) {
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+			/*
+			 * skip state if wakeups are expected before it pays
+			 * off, but keep the shallowest such state in case no
+			 * other fits: the history only learns when sleeping.
+			 */
+			if (!idle_history_predicts(cpu, i)) {
+				fallback = state;
+				continue;
+			}
+
+			return idle_history_enter(cpu, cyc, state);
+#else
 			return state;
+#endif
 		}
 	}
 
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+	if (fallback != NULL) {
+		return idle_history_enter(cpu, cyc, fallback);
+	}
+#endif
+
 	return NULL;
 }
 #endif
@@ -10,6 +10,8 @@
 #include <zephyr/kernel.h>
 #include <string.h>
 
+#include "random_entropy_pool.h"
+
 #if defined(CONFIG_MBEDTLS)
 #if !defined(CONFIG_MBEDTLS_CFG_FILE)
 #include "mbedtls/config.h"
@@ -41,6 +43,10 @@ static mbedtls_ctr_drbg_context ctr_ctx;
 
 static int ctr_drbg_entropy_func(void *ctx, unsigned char *buf, size_t len)
 {
+	if (z_entropy_pool_get(buf, len) == 0) {
+		return 0;
+	}
+
 	return entropy_get_entropy(entropy_dev, (void *)buf, len);
 }
 
@@ -131,8 +137,11 @@ int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
 		ret = 0;
 	} else if (ret == TC_CTR_PRNG_RESEED_REQ) {
 
-		ret = entropy_get_entropy(entropy_dev,
-				    (void *)&entropy, sizeof(entropy));
+		ret = z_entropy_pool_get(entropy, sizeof(entropy));
+		if (ret != 0) {
+			ret = entropy_get_entropy(entropy_dev,
+					    (void *)&entropy, sizeof(entropy));
+		}
 		if (ret != 0) {
 			ret = -EIO;
 			goto end;
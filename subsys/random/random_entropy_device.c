@@ -9,6 +9,8 @@
 #include <zephyr/drivers/entropy.h>
 #include <string.h>
 
+#include "random_entropy_pool.h"
+
 static const struct device *const entropy_dev =
 	DEVICE_DT_GET(DT_CHOSEN(zephyr_entropy));
 
@@ -20,6 +22,10 @@ static int rand_get(uint8_t *dst, size_t outlen, bool csrand)
 	__ASSERT(device_is_ready(entropy_dev), "Entropy device %s not ready",
 		 entropy_dev->name);
 
+	if (z_entropy_pool_get(dst, outlen) == 0) {
+		return 0;
+	}
+
 	ret = entropy_get_entropy(entropy_dev, dst, outlen);
 
 	if (unlikely(ret < 0)) {
@@ -0,0 +1,89 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/entropy.h>
+#include <string.h>
+
+#include "random_entropy_pool.h"
+
+/* Bytes read from the entropy device per refill step */
+#define POOL_CHUNK_SIZE 32
+
+static const struct device *const entropy_dev =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_entropy));
+
+static uint8_t pool[CONFIG_ENTROPY_POOL_SIZE];
+static size_t pool_count;
+static struct k_spinlock pool_lock;
+
+static void pool_refill(struct k_work *work)
+{
+	uint8_t chunk[POOL_CHUNK_SIZE];
+	k_spinlock_key_t key;
+	size_t len;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&pool_lock);
+		len = MIN(sizeof(pool) - pool_count, sizeof(chunk));
+		k_spin_unlock(&pool_lock, key);
+
+		/* The device is read without the lock, so gets are served meanwhile */
+		if ((len == 0U) || (entropy_get_entropy(entropy_dev, chunk, len) != 0)) {
+			break;
+		}
+
+		key = k_spin_lock(&pool_lock);
+		len = MIN(sizeof(pool) - pool_count, len);
+		(void)memcpy(&pool[pool_count], chunk, len);
+		pool_count += len;
+		k_spin_unlock(&pool_lock, key);
+	}
+
+	(void)memset(chunk, 0, sizeof(chunk));
+}
+
+static K_WORK_DEFINE(pool_refill_work, pool_refill);
+
+int z_entropy_pool_get(uint8_t *dst, size_t len)
+{
+	k_spinlock_key_t key;
+	bool low;
+	int ret = -EAGAIN;
+
+	key = k_spin_lock(&pool_lock);
+	if (len <= pool_count) {
+		pool_count -= len;
+		(void)memcpy(dst, &pool[pool_count], len);
+		/* Bytes served are not left behind in the pool */
+		(void)memset(&pool[pool_count], 0, len);
+		ret = 0;
+	}
+	low = pool_count < (sizeof(pool) / 2U);
+	k_spin_unlock(&pool_lock, key);
+
+	if (low) {
+		(void)k_work_submit(&pool_refill_work);
+	}
+
+	return ret;
+}
+
+static int entropy_pool_init(void)
+{
+	if (!device_is_ready(entropy_dev)) {
+		return -ENODEV;
+	}
+
+	(void)k_work_submit(&pool_refill_work);
+
+	return 0;
+}
+
+SYS_INIT(entropy_pool_init, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY);
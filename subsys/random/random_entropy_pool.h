@@ -0,0 +1,33 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_RANDOM_RANDOM_ENTROPY_POOL_H_
+#define ZEPHYR_SUBSYS_RANDOM_RANDOM_ENTROPY_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <errno.h>
+
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_ENTROPY_POOL)
+/*
+ * Take len bytes from the pool of entropy read ahead from the entropy device.
+ * Return -EAGAIN if the pool holds fewer bytes, the caller then reads the
+ * entropy device itself.
+ */
+int z_entropy_pool_get(uint8_t *dst, size_t len);
+#else
+static inline int z_entropy_pool_get(uint8_t *dst, size_t len)
+{
+	ARG_UNUSED(dst);
+	ARG_UNUSED(len);
+
+	return -EAGAIN;
+}
+#endif /* CONFIG_ENTROPY_POOL */
+
+#endif /* ZEPHYR_SUBSYS_RANDOM_RANDOM_ENTROPY_POOL_H_ */
@@ -0,0 +1,78 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/work.h>
+#include <zephyr/sys/__assert.h>
+
+K_MEM_SLAB_DEFINE_STATIC(rtio_work_items, sizeof(struct rtio_work_req),
+			 CONFIG_RTIO_WORKQ_POOL_ITEMS, __alignof__(struct rtio_work_req));
+
+static K_FIFO_DEFINE(rtio_work_fifo);
+
+static K_THREAD_STACK_ARRAY_DEFINE(rtio_work_stacks, CONFIG_RTIO_WORKQ_THREADS_POOL,
+				   CONFIG_RTIO_WORKQ_STACK_SIZE);
+static struct k_thread rtio_work_threads[CONFIG_RTIO_WORKQ_THREADS_POOL];
+
+struct rtio_work_req *rtio_work_req_alloc(void)
+{
+	struct rtio_work_req *req;
+
+	if (k_mem_slab_alloc(&rtio_work_items, (void **)&req, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	return req;
+}
+
+void rtio_work_req_submit(struct rtio_work_req *req, struct rtio_iodev_sqe *iodev_sqe,
+			  rtio_work_submit_t handler)
+{
+	__ASSERT_NO_MSG(req != NULL);
+	__ASSERT_NO_MSG(handler != NULL);
+
+	req->iodev_sqe = iodev_sqe;
+	req->handler = handler;
+
+	k_fifo_put(&rtio_work_fifo, req);
+}
+
+uint32_t rtio_work_req_used_count_get(void)
+{
+	return k_mem_slab_num_used_get(&rtio_work_items);
+}
+
+static void rtio_work_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		struct rtio_work_req *req = k_fifo_get(&rtio_work_fifo, K_FOREVER);
+
+		req->handler(req->iodev_sqe);
+
+		k_mem_slab_free(&rtio_work_items, req);
+	}
+}
+
+static int rtio_workq_init(void)
+{
+	for (int i = 0; i < CONFIG_RTIO_WORKQ_THREADS_POOL; i++) {
+		k_tid_t tid = k_thread_create(&rtio_work_threads[i], rtio_work_stacks[i],
+					      K_THREAD_STACK_SIZEOF(rtio_work_stacks[i]),
+					      rtio_work_thread, NULL, NULL, NULL,
+					      CONFIG_RTIO_WORKQ_PRIO, 0, K_NO_WAIT);
+
+		k_thread_name_set(tid, "rtio_workq");
+	}
+
+	return 0;
+}
+
+SYS_INIT(rtio_workq_init, POST_KERNEL, 0);
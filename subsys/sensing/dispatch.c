@@ -11,36 +11,157 @@
 
 LOG_MODULE_DECLARE(sensing, CONFIG_SENSING_LOG_LEVEL);
 
-/* check whether it is right time for client to consume this sample */
-static inline bool sensor_test_consume_time(struct sensing_sensor *sensor,
+/* Decimate the samples of the sensor to the interval of the client. The
+ * sample timestamps are used rather than the dispatch time, with half an
+ * interval of the sensor as tolerance, so a client at a multiple of the
+ * sensor interval gets exactly every n-th sample despite dispatch jitter.
+ */
+static bool sensor_test_consume_time(struct sensing_sensor *sensor,
 				     struct sensing_connection *conn,
-				     uint64_t cur_time)
+				     uint64_t sample_time)
 {
-	LOG_DBG("sensor:%s next_consume_time:%lld cur_time:%lld",
-			sensor->dev->name, conn->next_consume_time, cur_time);
+	LOG_DBG("sensor:%s next_consume_time:%lld sample_time:%lld",
+			sensor->dev->name, conn->next_consume_time, sample_time);
+
+	if (conn->next_consume_time == EXEC_TIME_INIT) {
+		conn->next_consume_time = sample_time;
+	}
 
-	return conn->next_consume_time <= cur_time;
+	return conn->next_consume_time <= sample_time + sensor->interval / 2;
 }
 
 static void update_client_consume_time(struct sensing_sensor *sensor,
-				       struct sensing_connection *conn)
+				       struct sensing_connection *conn,
+				       uint64_t sample_time)
+{
+	conn->next_consume_time += conn->interval;
+
+	/* fell behind, e.g. after the sensor was restarted */
+	if (conn->next_consume_time <= sample_time) {
+		conn->next_consume_time = sample_time + conn->interval;
+	}
+}
+
+/* Protects the batches of the clients, which are filled by the dispatch
+ * thread, flushed on their latency by the runtime thread, and flushed by the
+ * applications when they change their configuration.
+ */
+K_MUTEX_DEFINE(sensing_batch_lock);
+
+/* latency deadline sensing_batch_timer is armed for */
+static uint64_t batch_timer_deadline = EXEC_TIME_OFF;
+
+/* called with sensing_batch_lock held */
+static void arm_batch_timer(uint64_t deadline)
+{
+	uint64_t now = get_us();
+
+	if (deadline >= batch_timer_deadline) {
+		return;
+	}
+
+	batch_timer_deadline = deadline;
+	k_timer_start(&sensing_batch_timer, K_USEC(deadline > now ? deadline - now : 0),
+		      K_NO_WAIT);
+}
+
+/* called with sensing_batch_lock held */
+static void flush_client_batch(struct sensing_connection *conn)
+{
+	if (conn->batch_count == 0) {
+		return;
+	}
+
+	if (conn->callback_list && conn->callback_list->on_batch_event) {
+		conn->callback_list->on_batch_event(conn, conn->batch, conn->batch_count,
+				conn->callback_list->context);
+	}
+	conn->batch_count = 0;
+}
+
+void flush_batch(struct sensing_connection *conn)
+{
+	k_mutex_lock(&sensing_batch_lock, K_FOREVER);
+	flush_client_batch(conn);
+	k_mutex_unlock(&sensing_batch_lock);
+}
+
+/* deliver the batches whose latency is up, e.g. as the sensor stopped
+ * reporting, and arm the timer for the next one
+ */
+void flush_expired_batches(void)
+{
+	struct sensing_connection *conn;
+	uint64_t now = get_us();
+	uint64_t deadline;
+
+	k_mutex_lock(&sensing_batch_lock, K_FOREVER);
+
+	batch_timer_deadline = EXEC_TIME_OFF;
+
+	for_each_sensor(sensor) {
+		for_each_client_conn(sensor, conn) {
+			if (conn->batch_count == 0) {
+				continue;
+			}
+
+			deadline = conn->batch_start + conn->latency;
+			if (deadline <= now) {
+				flush_client_batch(conn);
+			} else {
+				arm_batch_timer(deadline);
+			}
+		}
+	}
+
+	k_mutex_unlock(&sensing_batch_lock);
+}
+
+/* buffer the sample for the client, deliver the batch once the latency
+ * budget of its first sample is used up or it is full
+ */
+static void batch_client_data(struct sensing_sensor *sensor,
+			      struct sensing_connection *conn,
+			      const void *data, uint64_t sample_time)
 {
-	uint32_t interval = conn->interval;
+	const uint16_t size = sensor->register_info->sample_size;
+
+	k_mutex_lock(&sensing_batch_lock, K_FOREVER);
 
-	if (conn->next_consume_time == 0) {
-		conn->next_consume_time = get_us();
+	if (conn->batch_count == 0) {
+		conn->batch_start = sample_time;
 	}
 
-	conn->next_consume_time += interval;
+	memcpy((uint8_t *)conn->batch + conn->batch_count * size, data, size);
+	conn->batch_count++;
+
+	if (conn->batch_count == CONFIG_SENSING_MAX_BATCH_COUNT ||
+	    sample_time - conn->batch_start >= conn->latency) {
+		flush_client_batch(conn);
+	} else if (conn->batch_count == 1) {
+		/* delivered on time even if no further sample comes */
+		arm_batch_timer(conn->batch_start + conn->latency);
+	}
+
+	k_mutex_unlock(&sensing_batch_lock);
 }
 
-/* send data to clients based on interval and sensitivity */
+/* send data to clients based on interval and sensitivity. The data is
+ * decoded once by the reporter, and shared by reference by all the clients.
+ */
 static int send_data_to_clients(struct sensing_sensor *sensor,
 				void *data)
 {
+	const struct sensing_sensor_value_header *header = data;
+	uint64_t sample_time = header->base_timestamp;
 	struct sensing_sensor *client;
 	struct sensing_connection *conn;
 
+	/* the reporter does not time stamp its samples */
+	if (sample_time == 0) {
+		sample_time = get_us();
+	}
+
 	for_each_client_conn(sensor, conn) {
 		client = conn->sink;
 		LOG_DBG("sensor:%s send data to client:%p", conn->source->dev->name, conn);
@@ -53,11 +174,21 @@ static int send_data_to_clients(struct sensing_sensor *sensor,
 		 * true: it's time for client consuming the data
 		 * false: client time not arrived yet, not consume the data
 		 */
-		if (!sensor_test_consume_time(sensor, conn, get_us())) {
+		if (!sensor_test_consume_time(sensor, conn, sample_time)) {
+			continue;
+		}
+
+		update_client_consume_time(sensor, conn, sample_time);
+
+		if (conn->latency && conn->batch && conn->callback_list->on_batch_event) {
+			batch_client_data(sensor, conn, data, sample_time);
 			continue;
 		}
 
-		update_client_consume_time(sensor, conn);
+		if (conn->batch_count) {
+			/* latency removed, deliver what is left first */
+			flush_batch(conn);
+		}
 
 		if (!conn->callback_list->on_data_event) {
 			LOG_WRN("sensor:%s event callback not registered",
@@ -87,6 +218,8 @@ static void dispatch_task(void *a, void *b, void *c)
 
 	if (IS_ENABLED(CONFIG_USERSPACE) && !k_is_user_context()) {
 		rtio_access_grant(&sensing_rtio_ctx, k_current_get());
+		k_object_access_grant(&sensing_batch_lock, k_current_get());
+		k_object_access_grant(&sensing_batch_timer, k_current_get());
 		k_thread_user_mode_enter(dispatch_task, a, b, c);
 	}
 
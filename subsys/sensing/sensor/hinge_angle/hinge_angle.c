@@ -144,6 +144,10 @@ static void hinge_reporter_on_data_event(sensing_sensor_handle_t handle,
 			return;
 		}
 
+		sample->header.base_timestamp = MAX(data->sample[0].header.base_timestamp,
+						    data->sample[1].header.base_timestamp);
+		sample->header.reading_count = 1;
+		sample->readings[0].timestamp_delta = 0;
 		sample->readings[0].v = calc_hinge_angle(data);
 
 		rtio_iodev_sqe_ok(data->sqe, 0);
@@ -196,7 +196,9 @@ static int phy_3d_sensor_submit(const struct device *dev,
 		sample->readings[0].v[i] = custom->sensor_value_to_q31(&value[i]);
 	}
 
+	sample->header.base_timestamp = k_ticks_to_us_floor64(k_uptime_ticks());
 	sample->header.reading_count = 1;
+	sample->readings[0].timestamp_delta = 0;
 	sample->shift = custom->shift;
 
 	LOG_DBG("%s: Sample data:\t x: %d, y: %d, z: %d",
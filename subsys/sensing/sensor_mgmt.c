@@ -125,6 +125,13 @@ static int config_interval(struct sensing_sensor *sensor)
 
 	LOG_INF("config interval, sensor:%s, interval:%d", sensor->dev->name, interval);
 
+	/* clients only changing their own rate are decimated by the dispatcher,
+	 * no need to restart the sensor
+	 */
+	if (interval == sensor->interval) {
+		return 0;
+	}
+
 	return set_arbitrate_interval(sensor, interval);
 }
 
@@ -229,6 +236,10 @@ static void sensing_runtime_thread(void *p1, void *p2, void *p3)
 				LOG_INF("runtime thread triggered by EVENT_CONFIG_READY");
 				sensor_later_config();
 			}
+			if (atomic_test_and_clear_bit(&ctx->event_flag, EVENT_BATCH_TIMEOUT)) {
+				LOG_DBG("runtime thread triggered by EVENT_BATCH_TIMEOUT");
+				flush_expired_batches();
+			}
 		}
 	} while (1);
 }
@@ -250,6 +261,20 @@ static void save_config_and_notify(struct sensing_sensor *sensor)
 	k_sem_give(&ctx->event_sem);
 }
 
+/* the latency of a batch is up, let sensing_runtime_thread deliver it */
+static void sensing_batch_timeout(struct k_timer *timer_id)
+{
+	struct sensing_context *ctx = &sensing_ctx;
+
+	ARG_UNUSED(timer_id);
+
+	atomic_set_bit(&ctx->event_flag, EVENT_BATCH_TIMEOUT);
+
+	k_sem_give(&ctx->event_sem);
+}
+
+K_TIMER_DEFINE(sensing_batch_timer, sensing_batch_timeout, NULL);
+
 static int set_sensor_state(struct sensing_sensor *sensor, enum sensing_sensor_state state)
 {
 	__ASSERT(sensor, "set sensor state, sensing_sensor is NULL");
@@ -275,6 +300,10 @@ static void init_connection(struct sensing_connection *conn,
 
 	conn->interval = 0;
 	memset(conn->sensitivity, 0x00, sizeof(conn->sensitivity));
+	conn->latency = 0;
+	conn->batch = NULL;
+	conn->batch_count = 0;
+	conn->batch_start = 0;
 	/* link connection to its reporter's client_list */
 	sys_slist_append(&conn->source->client_list, &conn->snode);
 }
@@ -382,6 +411,9 @@ int close_sensor(struct sensing_connection **conn)
 
 	save_config_and_notify(tmp_conn->source);
 
+	/* deliver the samples still batched before freeing them */
+	flush_batch(tmp_conn);
+	free(tmp_conn->batch);
 	free(*conn);
 	*conn = NULL;
 
@@ -419,6 +451,9 @@ int set_interval(struct sensing_connection *conn, uint32_t interval)
 		return -EINVAL;
 	}
 
+	/* the samples batched at the former interval are delivered first */
+	flush_batch(conn);
+
 	conn->interval = interval;
 	conn->next_consume_time = EXEC_TIME_INIT;
 
@@ -500,6 +535,36 @@ int get_sensitivity(struct sensing_connection *conn, int8_t index, uint32_t *sen
 	return 0;
 }
 
+int set_latency(struct sensing_connection *conn, uint64_t latency)
+{
+	__ASSERT(conn && conn->source, "set latency, connection or reporter not be NULL");
+
+	LOG_INF("set latency, sensor:%s, latency:%llu(us)", conn->source->dev->name, latency);
+
+	/* the buffer is kept until the connection is closed, since the
+	 * dispatch thread may be using it
+	 */
+	if (latency && conn->batch == NULL) {
+		conn->batch = malloc((size_t)conn->source->register_info->sample_size *
+				     CONFIG_SENSING_MAX_BATCH_COUNT);
+		if (conn->batch == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	conn->latency = latency;
+
+	return 0;
+}
+
+int get_latency(struct sensing_connection *conn, uint64_t *latency)
+{
+	__ASSERT(conn, "get latency, connection not be NULL");
+	*latency = conn->latency;
+
+	return 0;
+}
+
 int sensing_get_sensors(int *sensor_nums, const struct sensing_sensor_info **info)
 {
 	if (info == NULL) {
@@ -39,6 +39,7 @@ extern "C" {
 #define EXEC_TIME_OFF UINT64_MAX
 
 extern struct rtio sensing_rtio_ctx;
+extern struct k_timer sensing_batch_timer;
 /**
  * @struct sensing_context
  * @brief sensing subsystem context to include global variables
@@ -57,6 +58,10 @@ int set_interval(struct sensing_connection *conn, uint32_t interval);
 int get_interval(struct sensing_connection *con, uint32_t *sensitivity);
 int set_sensitivity(struct sensing_connection *conn, int8_t index, uint32_t interval);
 int get_sensitivity(struct sensing_connection *con, int8_t index, uint32_t *sensitivity);
+int set_latency(struct sensing_connection *conn, uint64_t latency);
+int get_latency(struct sensing_connection *conn, uint64_t *latency);
+void flush_batch(struct sensing_connection *conn);
+void flush_expired_batches(void);
 
 static inline struct sensing_sensor *get_sensor_by_dev(const struct device *dev)
 {
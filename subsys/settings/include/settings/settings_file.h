@@ -9,6 +9,7 @@
 #define __SETTINGS_FILE_H_
 
 #include <zephyr/toolchain.h>
+#include <zephyr/kernel.h>
 #include <zephyr/settings/settings.h>
 
 #ifdef __cplusplus
@@ -22,6 +23,9 @@ struct settings_file {
 	const char *cf_name;	/* filename */
 	int cf_maxlines;	/* max # of lines before compressing */
 	int cf_lines;		/* private */
+#ifdef CONFIG_SETTINGS_FILE_BACKGROUND_COMPRESS
+	struct k_work_delayable cf_compress_work; /* private */
+#endif
 };
 
 /* register file to be source of settings */
@@ -41,6 +41,7 @@ struct settings_nvs {
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	struct {
 		uint16_t name_hash;
+		uint16_t top_hash; /* hash of the first element of the name */
 		uint16_t name_id;
 	} cache[CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE];
 
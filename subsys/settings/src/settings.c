@@ -14,6 +14,7 @@
 #include <zephyr/settings/settings.h>
 #include "settings_priv.h"
 #include <zephyr/types.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(settings, CONFIG_SETTINGS_LOG_LEVEL);
@@ -102,6 +103,13 @@ int settings_name_steq(const char *name, const char *key, const char **next)
 	return 0;
 }
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_CACHE) || defined(CONFIG_SETTINGS_FILE_LOAD_INDEX)
+uint16_t settings_name_top_hash(const char *name)
+{
+	return crc16_ccitt(0xffff, name, settings_name_next(name, NULL));
+}
+#endif
+
 int settings_name_next(const char *name, const char **next)
 {
 	int rc = 0;
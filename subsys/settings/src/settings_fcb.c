@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <stdbool.h>
 #include <zephyr/fs/fcb.h>
+#include <zephyr/sys/hash_function.h>
 #include <string.h>
 
 #include <zephyr/settings/settings.h>
@@ -54,12 +55,52 @@ __weak int settings_fcb_get_flash_area(void)
 	return SETTINGS_PARTITION;
 }
 
+static uint32_t settings_fcb_name_hash(const char *name, size_t len)
+{
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	return sys_hash32(name, len);
+#else
+	ARG_UNUSED(name);
+	ARG_UNUSED(len);
+
+	return 0;
+#endif
+}
+
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+/* Hash of the name of a "name=value" line, for the FCB sector summaries */
+static int settings_fcb_key_hash(struct fcb *fcb, const struct fcb_entry *loc,
+				 uint32_t *hash)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	size_t len = MIN(loc->fe_data_len, sizeof(name));
+	const char *sep;
+	int rc;
+
+	rc = flash_area_read(fcb->fap, FCB_ENTRY_FA_DATA_OFF((*loc)), name, len);
+	if (rc) {
+		return rc;
+	}
+
+	sep = memchr(name, '=', len);
+	if (sep == NULL) {
+		return -EINVAL;
+	}
+
+	*hash = settings_fcb_name_hash(name, sep - name);
+	return 0;
+}
+#endif /* CONFIG_FCB_SECTOR_SUMMARY */
+
 int settings_fcb_src(struct settings_fcb *cf)
 {
 	int rc;
 
 	cf->cf_fcb.f_version = SETTINGS_FCB_VERS;
 	cf->cf_fcb.f_scratch_cnt = 1;
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	cf->cf_fcb.f_key_hash = settings_fcb_key_hash;
+#endif
 
 	while (1) {
 		rc = fcb_init(settings_fcb_get_flash_area(), &cf->cf_fcb);
@@ -117,8 +158,9 @@ static bool settings_fcb_check_duplicate(struct settings_fcb *cf,
 					const char * const name)
 {
 	struct fcb_entry_ctx entry2_ctx = *entry_ctx;
+	uint32_t hash = settings_fcb_name_hash(name, strlen(name));
 
-	while (fcb_getnext(&cf->cf_fcb, &entry2_ctx.loc) == 0) {
+	while (fcb_getnext_key(&cf->cf_fcb, &entry2_ctx.loc, hash) == 0) {
 		char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 		size_t name2_len;
 
@@ -223,6 +265,7 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN];
 	int copy;
 	uint8_t rbs;
+	uint32_t hash;
 
 	rc = fcb_append_to_scratch(&cf->cf_fcb);
 	if (rc) {
@@ -258,8 +301,9 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 
 		loc2 = loc1;
 		copy = 1;
+		hash = settings_fcb_name_hash(name1, val1_off);
 
-		while (fcb_getnext(&cf->cf_fcb, &loc2.loc) == 0) {
+		while (fcb_getnext_key(&cf->cf_fcb, &loc2.loc, hash) == 0) {
 			size_t val2_off;
 
 			rc = settings_line_name_read(name2, sizeof(name2),
@@ -400,9 +444,16 @@ int settings_backend_init(void)
 {
 	static struct flash_sector
 		settings_fcb_area[CONFIG_SETTINGS_FCB_NUM_AREAS + 1];
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	static struct fcb_sector_summary
+		settings_fcb_summary[CONFIG_SETTINGS_FCB_NUM_AREAS + 1];
+#endif
 	static struct settings_fcb config_init_settings_fcb = {
 		.cf_fcb.f_magic = CONFIG_SETTINGS_FCB_MAGIC,
 		.cf_fcb.f_sectors = settings_fcb_area,
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+		.cf_fcb.f_summary = settings_fcb_summary,
+#endif
 	};
 	uint32_t cnt = sizeof(settings_fcb_area) /
 		    sizeof(settings_fcb_area[0]);
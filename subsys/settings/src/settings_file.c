@@ -10,6 +10,7 @@
 #include <zephyr/kernel.h>
 
 #include <zephyr/fs/fs.h>
+#include <zephyr/sys/crc.h>
 
 #include <zephyr/settings/settings.h>
 #include "settings/settings_file.h"
@@ -29,18 +30,35 @@ LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
 
 int settings_backend_init(void);
 
+extern struct k_mutex settings_lock;
+
+#define SETTINGS_FILE_WRITE_BUFFER (CONFIG_SETTINGS_FILE_WRITE_BUFFER_SIZE > 0)
+
 static int settings_file_load(struct settings_store *cs,
 			      const struct settings_load_arg *arg);
 static int settings_file_save(struct settings_store *cs, const char *name,
 			      const char *value, size_t val_len);
 static void *settings_file_storage_get(struct settings_store *cs);
 
+#if SETTINGS_FILE_WRITE_BUFFER
+static int settings_file_save_start(struct settings_store *cs);
+static int settings_file_save_end(struct settings_store *cs);
+#endif
+
 static const struct settings_store_itf settings_file_itf = {
 	.csi_load = settings_file_load,
+#if SETTINGS_FILE_WRITE_BUFFER
+	.csi_save_start = settings_file_save_start,
+	.csi_save_end = settings_file_save_end,
+#endif
 	.csi_save = settings_file_save,
 	.csi_storage_get = settings_file_storage_get
 };
 
+#ifdef CONFIG_SETTINGS_FILE_BACKGROUND_COMPRESS
+static void settings_file_compress_work(struct k_work *work);
+#endif
+
 /*
  * Register a file to be a source of configuration.
  */
@@ -64,6 +82,9 @@ int settings_file_dst(struct settings_file *cf)
 		return -EINVAL;
 	}
 	cf->cf_store.cs_itf = &settings_file_itf;
+#ifdef CONFIG_SETTINGS_FILE_BACKGROUND_COMPRESS
+	k_work_init_delayable(&cf->cf_compress_work, settings_file_compress_work);
+#endif
 	settings_dst_register(&cf->cf_store);
 
 	return 0;
@@ -180,12 +201,165 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 	return rc;
 }
 
+#ifdef CONFIG_SETTINGS_FILE_LOAD_INDEX
+/* Lines of the file, filled by the first pass of settings_file_load_indexed().
+ * Loads are serialized by the settings lock.
+ */
+static struct settings_file_line {
+	uint32_t seek;
+	uint16_t len;
+	uint16_t name_len;
+	uint16_t name_hash;
+	bool in_subtree;
+} load_index[CONFIG_SETTINGS_FILE_LOAD_INDEX_SIZE];
+
+/* Whether a line after the given one has the same name */
+static bool settings_file_index_duplicate(int line, int lines, const char *name,
+					  struct line_entry_ctx *entry_ctx)
+{
+	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	size_t name2_len;
+
+	for (int i = line + 1; i < lines; i++) {
+		if ((load_index[i].name_hash != load_index[line].name_hash) ||
+		    (load_index[i].name_len != load_index[line].name_len)) {
+			continue;
+		}
+
+		entry_ctx->seek = load_index[i].seek;
+		entry_ctx->len = load_index[i].len;
+
+		if (settings_line_name_read(name2, sizeof(name2), &name2_len,
+					    entry_ctx)) {
+			continue;
+		}
+		name2[name2_len] = '\0';
+
+		if (!strcmp(name, name2)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Load in two passes: the first reads the name of each line once, and the
+ * second only reads again the lines of the subtree, looking for newer values
+ * among the lines of the same name hash. Returns -ENOMEM if the file has more
+ * lines than the index holds.
+ */
+static int settings_file_load_indexed(struct settings_store *cs,
+				      const struct settings_load_arg *arg)
+{
+	struct settings_file *cf = CONTAINER_OF(cs, struct settings_file, cf_store);
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	const char *subtree = arg ? arg->subtree : NULL;
+	struct fs_file_t file;
+	size_t name_len;
+	int lines;
+	int rc;
+
+	struct line_entry_ctx entry_ctx = {
+		.stor_ctx = (void *)&file,
+		.seek = 0,
+		.len = 0 /* unknown length */
+	};
+
+	lines = 0;
+
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, cf->cf_name, FS_O_READ);
+	if (rc != 0) {
+		if (rc == -ENOENT) {
+			return -ENOENT;
+		}
+
+		return -EINVAL;
+	}
+
+	while (1) {
+		rc = settings_next_line_ctx(&entry_ctx);
+		if (rc || entry_ctx.len == 0) {
+			break;
+		}
+
+		rc = settings_line_name_read(name, sizeof(name), &name_len,
+					     &entry_ctx);
+		if (rc || name_len == 0) {
+			break;
+		}
+		name[name_len] = '\0';
+
+		if (lines == ARRAY_SIZE(load_index)) {
+			(void)fs_close(&file);
+			return -ENOMEM;
+		}
+
+		load_index[lines].seek = entry_ctx.seek;
+		load_index[lines].len = entry_ctx.len;
+		load_index[lines].name_len = name_len;
+		load_index[lines].name_hash = crc16_ccitt(0xffff, name, name_len);
+		load_index[lines].in_subtree = !subtree ||
+					       settings_name_steq(name, subtree, NULL);
+		lines++;
+	}
+
+	for (int i = 0; i < lines; i++) {
+		name_len = load_index[i].name_len;
+
+		/* Skip other subtrees and deletion records */
+		if (!load_index[i].in_subtree || (load_index[i].len <= name_len + 1)) {
+			continue;
+		}
+
+		entry_ctx.seek = load_index[i].seek;
+		entry_ctx.len = load_index[i].len;
+
+		rc = settings_line_name_read(name, sizeof(name), &name_len,
+					     &entry_ctx);
+		if (rc) {
+			continue;
+		}
+		name[name_len] = '\0';
+
+		if (settings_file_index_duplicate(i, lines, name, &entry_ctx)) {
+			continue;
+		}
+
+		entry_ctx.seek = load_index[i].seek;
+		entry_ctx.len = load_index[i].len;
+
+		/* take into account '=' separator after the name */
+		settings_line_load_cb(name, (void *)&entry_ctx, name_len + 1,
+				      (void *)arg);
+	}
+
+	rc = fs_close(&file);
+	cf->cf_lines = lines;
+
+	return rc;
+}
+#endif /* CONFIG_SETTINGS_FILE_LOAD_INDEX */
+
 /*
  * Called to load configuration items.
  */
 static int settings_file_load(struct settings_store *cs,
 			      const struct settings_load_arg *arg)
 {
+#ifdef CONFIG_SETTINGS_FILE_LOAD_INDEX
+	int rc;
+
+	rc = settings_file_load_indexed(cs, arg);
+	if (rc != -ENOMEM) {
+		return rc;
+	}
+
+	LOG_DBG("Too many lines to index, loading without index");
+#endif
+
 	return settings_file_load_priv(cs,
 				       settings_line_load_cb,
 				       (void *)arg,
@@ -226,7 +400,8 @@ static int settings_file_create_or_replace(struct fs_file_t *zfp,
 }
 
 /*
- * Try to compress configuration file by keeping unique names only.
+ * Try to compress configuration file by keeping unique names only, and
+ * append the new value, if name is not NULL.
  */
 static int settings_file_save_and_compress(struct settings_file *cf,
 			   const char *name, const char *value,
@@ -270,7 +445,7 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 	}
 
 	lines = 0;
-	new_name_len = strlen(name);
+	new_name_len = name ? strlen(name) : 0;
 
 	while (1) {
 		rc = settings_next_line_ctx(&loc1);
@@ -295,7 +470,7 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 		}
 
 		/* avoid copping value which will be overwritten by new value*/
-		if ((val1_off == new_name_len) &&
+		if (name && (val1_off == new_name_len) &&
 		    !memcmp(name1, name, val1_off)) {
 			continue;
 		}
@@ -343,10 +518,14 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 	}
 
 	/* at last store the new value */
-	rc = settings_line_write(name, value, val_len, 0, &loc3);
-	if (rc) {
-		/* compressed file might be corrupted */
-		goto end_rolback;
+	if (name) {
+		rc = settings_line_write(name, value, val_len, 0, &loc3);
+		if (rc) {
+			/* compressed file might be corrupted */
+			goto end_rolback;
+		}
+
+		lines++;
 	}
 
 	rc = fs_close(&wf);
@@ -355,7 +534,7 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 		if (fs_rename(tmp_file, cf->cf_name)) {
 			return -ENOENT;
 		}
-		cf->cf_lines = lines + 1;
+		cf->cf_lines = lines;
 	} else {
 		rc = -EIO;
 	}
@@ -373,6 +552,38 @@ end_rolback:
 
 }
 
+static void settings_file_compress_schedule(struct settings_file *cf, k_timeout_t delay)
+{
+#ifdef CONFIG_SETTINGS_FILE_BACKGROUND_COMPRESS
+	(void)k_work_schedule(&cf->cf_compress_work, delay);
+#endif
+}
+
+#ifdef CONFIG_SETTINGS_FILE_BACKGROUND_COMPRESS
+static void settings_file_compress_work(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct settings_file *cf = CONTAINER_OF(dwork, struct settings_file,
+						cf_compress_work);
+	int rc;
+
+	/* Do not block the work queue during a transaction */
+	if (k_mutex_lock(&settings_lock, K_NO_WAIT)) {
+		settings_file_compress_schedule(cf, K_MSEC(100));
+		return;
+	}
+
+	if (cf->cf_maxlines && (cf->cf_lines + 1 >= cf->cf_maxlines)) {
+		rc = settings_file_save_and_compress(cf, NULL, NULL, 0);
+		if (rc) {
+			LOG_ERR("Failed to compress %s: %d", cf->cf_name, rc);
+		}
+	}
+
+	k_mutex_unlock(&settings_lock);
+}
+#endif /* CONFIG_SETTINGS_FILE_BACKGROUND_COMPRESS */
+
 static int settings_file_save_priv(struct settings_store *cs, const char *name,
 				   const char *value, size_t val_len)
 {
@@ -389,12 +600,21 @@ static int settings_file_save_priv(struct settings_store *cs, const char *name,
 	fs_file_t_init(&file);
 
 	if (cf->cf_maxlines && (cf->cf_lines + 1 >= cf->cf_maxlines)) {
-		/*
-		 * Compress before config file size exceeds
-		 * the max number of lines.
-		 */
-		return settings_file_save_and_compress(cf, name, value,
-						       val_len);
+		if (IS_ENABLED(CONFIG_SETTINGS_FILE_BACKGROUND_COMPRESS) &&
+		    (cf->cf_lines + 1 < 2 * cf->cf_maxlines)) {
+			/*
+			 * Leave the compression to the system work queue,
+			 * unless it is late by as many lines again.
+			 */
+			settings_file_compress_schedule(cf, K_NO_WAIT);
+		} else {
+			/*
+			 * Compress before config file size exceeds
+			 * the max number of lines.
+			 */
+			return settings_file_save_and_compress(cf, name, value,
+							       val_len);
+		}
 	}
 
 	/*
@@ -423,26 +643,216 @@ static int settings_file_save_priv(struct settings_store *cs, const char *name,
 
 
 /*
- * Called to save configuration.
+ * Check if we're writing the same value again.
  */
-static int settings_file_save(struct settings_store *cs, const char *name,
-			      const char *value, size_t val_len)
+static bool settings_file_is_dup(struct settings_store *cs, const char *name,
+				 const char *value, size_t val_len)
 {
 	struct settings_line_dup_check_arg cdca;
 
-	if (val_len > 0 && value == NULL) {
-		return -EINVAL;
-	}
-
-	/*
-	 * Check if we're writing the same value again.
-	 */
 	cdca.name = name;
 	cdca.val = (char *)value;
 	cdca.is_dup = 0;
 	cdca.val_len = val_len;
 	settings_file_load_priv(cs, settings_line_dup_check_cb, &cdca, false);
-	if (cdca.is_dup == 1) {
+
+	return cdca.is_dup == 1;
+}
+
+#if SETTINGS_FILE_WRITE_BUFFER
+/*
+ * The saves of a transaction are collected here, and written together by
+ * settings_file_flush(). Each record is a flag telling whether it has to be
+ * written, the name with its '\0', the 16 bit length of the value and the
+ * value. Transactions hold the settings lock.
+ */
+static struct {
+	uint8_t buf[CONFIG_SETTINGS_FILE_WRITE_BUFFER_SIZE];
+	size_t used;
+	bool active;
+} write_buffer;
+
+#define WRITE_BUFFER_REC_SKIP  0
+#define WRITE_BUFFER_REC_WRITE 1
+
+/* Decode the record at off and return the offset of the next one */
+static size_t write_buffer_rec(size_t off, const char **name, const char **value,
+			       uint16_t *val_len)
+{
+	uint8_t *rec = &write_buffer.buf[off + 1];
+
+	*name = (const char *)rec;
+	rec += strlen(*name) + 1;
+	memcpy(val_len, rec, sizeof(*val_len));
+	rec += sizeof(*val_len);
+	*value = (const char *)rec;
+
+	return (rec - write_buffer.buf) + *val_len;
+}
+
+static int settings_file_flush(struct settings_file *cf)
+{
+	struct line_entry_ctx entry_ctx;
+	struct fs_file_t file;
+	const char *name, *name2, *value, *value2;
+	uint16_t val_len, val2_len;
+	size_t next, next2;
+	bool opened = false;
+	int rc = 0;
+	int rc2;
+
+	/*
+	 * Only write the last save of each name, if it changes the stored
+	 * value. This is decided before the file is opened for writing.
+	 */
+	for (size_t off = 0; off < write_buffer.used; off = next) {
+		next = write_buffer_rec(off, &name, &value, &val_len);
+		write_buffer.buf[off] = WRITE_BUFFER_REC_WRITE;
+
+		for (size_t off2 = next; off2 < write_buffer.used; off2 = next2) {
+			next2 = write_buffer_rec(off2, &name2, &value2, &val2_len);
+			if (!strcmp(name, name2)) {
+				write_buffer.buf[off] = WRITE_BUFFER_REC_SKIP;
+				break;
+			}
+		}
+
+		if ((write_buffer.buf[off] == WRITE_BUFFER_REC_WRITE) &&
+		    settings_file_is_dup(&cf->cf_store, name, value, val_len)) {
+			write_buffer.buf[off] = WRITE_BUFFER_REC_SKIP;
+		}
+	}
+
+	fs_file_t_init(&file);
+	entry_ctx.stor_ctx = &file;
+
+	for (size_t off = 0; off < write_buffer.used; off = next) {
+		next = write_buffer_rec(off, &name, &value, &val_len);
+		if (write_buffer.buf[off] == WRITE_BUFFER_REC_SKIP) {
+			continue;
+		}
+
+		/* Let the single save handle the compression */
+		if (cf->cf_maxlines && (cf->cf_lines + 1 >= cf->cf_maxlines)) {
+			if (opened) {
+				opened = false;
+				rc = fs_close(&file);
+				if (rc) {
+					break;
+				}
+			}
+
+			rc = settings_file_save_priv(&cf->cf_store, name, value, val_len);
+			if (rc) {
+				break;
+			}
+			continue;
+		}
+
+		if (!opened) {
+			rc = fs_open(&file, cf->cf_name, FS_O_CREATE | FS_O_RDWR);
+			if (rc) {
+				break;
+			}
+			opened = true;
+		}
+
+		rc = settings_line_write(name, value, val_len, 0, (void *)&entry_ctx);
+		if (rc) {
+			break;
+		}
+		cf->cf_lines++;
+	}
+
+	if (opened) {
+		rc2 = fs_close(&file);
+		if (rc == 0) {
+			rc = rc2;
+		}
+	}
+
+	write_buffer.used = 0;
+
+	return rc;
+}
+
+static int settings_file_buffer_add(struct settings_file *cf, const char *name,
+				    const char *value, size_t val_len)
+{
+	size_t name_len = strlen(name) + 1;
+	size_t rec_len = 1 + name_len + sizeof(uint16_t) + val_len;
+	uint16_t len16 = val_len;
+	uint8_t *rec;
+	int rc;
+
+	if (write_buffer.used + rec_len > sizeof(write_buffer.buf)) {
+		rc = settings_file_flush(cf);
+		if (rc) {
+			return rc;
+		}
+
+		if (rec_len > sizeof(write_buffer.buf)) {
+			if (settings_file_is_dup(&cf->cf_store, name, value, val_len)) {
+				return 0;
+			}
+			return settings_file_save_priv(&cf->cf_store, name, value, val_len);
+		}
+	}
+
+	rec = &write_buffer.buf[write_buffer.used];
+	*rec++ = WRITE_BUFFER_REC_WRITE;
+	memcpy(rec, name, name_len);
+	rec += name_len;
+	memcpy(rec, &len16, sizeof(len16));
+	rec += sizeof(len16);
+	if (val_len) {
+		memcpy(rec, value, val_len);
+	}
+	write_buffer.used += rec_len;
+
+	return 0;
+}
+
+static int settings_file_save_start(struct settings_store *cs)
+{
+	write_buffer.used = 0;
+	write_buffer.active = true;
+
+	return 0;
+}
+
+static int settings_file_save_end(struct settings_store *cs)
+{
+	struct settings_file *cf = CONTAINER_OF(cs, struct settings_file, cf_store);
+
+	write_buffer.active = false;
+
+	return settings_file_flush(cf);
+}
+#endif /* SETTINGS_FILE_WRITE_BUFFER */
+
+/*
+ * Called to save configuration.
+ */
+static int settings_file_save(struct settings_store *cs, const char *name,
+			      const char *value, size_t val_len)
+{
+	if (val_len > 0 && value == NULL) {
+		return -EINVAL;
+	}
+
+#if SETTINGS_FILE_WRITE_BUFFER
+	if (write_buffer.active) {
+		if (!name) {
+			return -EINVAL;
+		}
+
+		return settings_file_buffer_add(CONTAINER_OF(cs, struct settings_file, cf_store),
+						name, value, val_len);
+	}
+#endif
+
+	if (settings_file_is_dup(cs, name, value, val_len)) {
 		return 0;
 	}
 	return settings_file_save_priv(cs, name, value, val_len);
@@ -82,6 +82,7 @@ static void settings_nvs_cache_add(struct settings_nvs *cf, const char *name,
 	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
 
 	cf->cache[cf->cache_next].name_hash = name_hash;
+	cf->cache[cf->cache_next].top_hash = settings_name_top_hash(name);
 	cf->cache[cf->cache_next++].name_id = name_id;
 
 	cf->cache_next %= CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE;
@@ -118,6 +119,64 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 
 	return NVS_NAMECNT_ID;
 }
+
+static void settings_nvs_cache_del(struct settings_nvs *cf, uint16_t name_id)
+{
+	for (int i = 0; i < CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE; i++) {
+		if (cf->cache[i].name_id == name_id) {
+			cf->cache[i].name_id = NVS_NAMECNT_ID;
+		}
+	}
+}
+
+/* Once a load has put all names in the cache, a subtree is loaded by reading
+ * only the names that share the hash of its first element.
+ */
+static int settings_nvs_cache_load(struct settings_nvs *cf,
+				   const struct settings_load_arg *arg)
+{
+	struct settings_nvs_read_fn_arg read_fn_arg;
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t top_hash = settings_name_top_hash(arg->subtree);
+	uint16_t name_id;
+	char buf;
+	ssize_t rc1, rc2;
+	int ret;
+
+	for (int i = 0; i < cf->cache_total; i++) {
+		name_id = cf->cache[i].name_id;
+
+		if ((cf->cache[i].top_hash != top_hash) || (name_id <= NVS_NAMECNT_ID)) {
+			continue;
+		}
+
+		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
+			       &buf, sizeof(buf));
+
+		if ((rc1 <= 0) || (rc2 <= 0)) {
+			continue;
+		}
+
+		name[rc1] = '\0';
+
+		/* The id may have been given to another name since it was cached */
+		if (crc16_ccitt(0xffff, name, rc1) != cf->cache[i].name_hash) {
+			continue;
+		}
+
+		read_fn_arg.fs = &cf->cf_nvs;
+		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
+
+		ret = settings_call_set_handler(name, rc2, settings_nvs_read_fn,
+						&read_fn_arg, (void *)arg);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
 static int settings_nvs_load(struct settings_store *cs,
@@ -134,7 +193,14 @@ static int settings_nvs_load(struct settings_store *cs,
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	uint16_t cached = 0;
 
+	if (cf->loaded && !SETTINGS_NVS_CACHE_OVFL(cf) && arg && arg->subtree) {
+		return settings_nvs_cache_load(cf, arg);
+	}
+
+	/* The cache is filled again from the start */
 	cf->loaded = false;
+	cf->cache_next = 0;
+	memset(cf->cache, 0, sizeof(cf->cache));
 #endif
 
 	name_id = cf->last_name_id + 1;
@@ -297,6 +363,10 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+		settings_nvs_cache_del(cf, name_id);
+#endif
+
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -32,6 +32,13 @@ int settings_line_load_cb(const char *name, void *val_read_cb_ctx,
 typedef int (*line_load_cb)(const char *name, void *val_read_cb_ctx,
 			     off_t off, void *cb_arg);
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_CACHE) || defined(CONFIG_SETTINGS_FILE_LOAD_INDEX)
+/* Hash of the first element of a name, which all the names that a subtree
+ * matches share.
+ */
+uint16_t settings_name_top_hash(const char *name);
+#endif
+
 struct settings_line_read_value_cb_ctx {
 	void *read_cb_ctx;
 	off_t off;
@@ -24,6 +24,9 @@ sys_slist_t settings_load_srcs;
 struct settings_store *settings_save_dst;
 extern struct k_mutex settings_lock;
 
+/* Nesting depth of transactions, protected by settings_lock */
+static unsigned int settings_transaction_depth;
+
 void settings_src_register(struct settings_store *cs)
 {
 	sys_slist_append(&settings_load_srcs, &cs->cs_next);
@@ -115,6 +118,76 @@ int settings_delete(const char *name)
 	return settings_save_one(name, NULL, 0);
 }
 
+/* Called with settings_lock held. The depth is taken even when the back-end
+ * fails to start, settings_save() calls save_end() regardless.
+ */
+static int settings_save_start(struct settings_store *cs)
+{
+	int rc = 0;
+
+	if ((settings_transaction_depth == 0) && cs->cs_itf->csi_save_start) {
+		rc = cs->cs_itf->csi_save_start(cs);
+	}
+	settings_transaction_depth++;
+
+	return rc;
+}
+
+/* Called with settings_lock held */
+static int settings_save_end(struct settings_store *cs)
+{
+	int rc = 0;
+
+	__ASSERT(settings_transaction_depth > 0, "no transaction");
+
+	settings_transaction_depth--;
+	if ((settings_transaction_depth == 0) && cs->cs_itf->csi_save_end) {
+		rc = cs->cs_itf->csi_save_end(cs);
+	}
+
+	return rc;
+}
+
+int settings_transaction_begin(void)
+{
+	struct settings_store *cs;
+	int rc;
+
+	cs = settings_save_dst;
+	if (!cs) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	rc = settings_save_start(cs);
+	if (rc) {
+		settings_transaction_depth--;
+		k_mutex_unlock(&settings_lock);
+		return rc;
+	}
+
+	/* The lock is held until settings_transaction_end() */
+	return 0;
+}
+
+int settings_transaction_end(void)
+{
+	struct settings_store *cs;
+	int rc;
+
+	cs = settings_save_dst;
+	if (!cs) {
+		return -ENOENT;
+	}
+
+	rc = settings_save_end(cs);
+
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
 int settings_save(void)
 {
 	struct settings_store *cs;
@@ -126,10 +199,21 @@ int settings_save(void)
 		return -ENOENT;
 	}
 
-	if (cs->cs_itf->csi_save_start) {
-		cs->cs_itf->csi_save_start(cs);
+#if defined(CONFIG_SETTINGS_SAVE_TRANSACTION)
+	rc = settings_transaction_begin();
+	if (rc) {
+		return rc;
 	}
+#else
+	/* The lock is only taken by each save, so that the export handlers
+	 * can block on other threads that save, and errors of the back-end
+	 * in starting and ending the save are not reported.
+	 */
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	(void)settings_save_start(cs);
+	k_mutex_unlock(&settings_lock);
 	rc = 0;
+#endif
 
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (ch->h_export) {
@@ -152,9 +236,17 @@ int settings_save(void)
 	}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
-	if (cs->cs_itf->csi_save_end) {
-		cs->cs_itf->csi_save_end(cs);
+#if defined(CONFIG_SETTINGS_SAVE_TRANSACTION)
+	rc2 = settings_transaction_end();
+	if (!rc) {
+		rc = rc2;
 	}
+#else
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	(void)settings_save_end(cs);
+	k_mutex_unlock(&settings_lock);
+#endif
+
 	return rc;
 }
 
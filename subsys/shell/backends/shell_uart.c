@@ -28,14 +28,60 @@ NET_BUF_POOL_DEFINE(smp_shell_rx_pool, CONFIG_MCUMGR_TRANSPORT_SHELL_RX_BUF_COUN
 		    SMP_SHELL_RX_BUF_SIZE, 0, NULL);
 #endif /* CONFIG_MCUMGR_TRANSPORT_SHELL */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFERED
+/* Start sending the buffered data, unless a transfer is already ongoing. */
+static void async_tx_start(struct shell_uart_async *sh_uart)
+{
+	uint8_t *data;
+	uint32_t len;
+	int err;
+
+	if (ring_buf_is_empty(&sh_uart->tx_ringbuf) ||
+	    !atomic_cas(&sh_uart->tx_busy, 0, 1)) {
+		return;
+	}
+
+	len = ring_buf_get_claim(&sh_uart->tx_ringbuf, &data, sh_uart->tx_ringbuf.size);
+	err = uart_tx(sh_uart->common.dev, data, len, SYS_FOREVER_US);
+	if (err < 0) {
+		(void)ring_buf_get_finish(&sh_uart->tx_ringbuf, 0);
+		atomic_clear(&sh_uart->tx_busy);
+	}
+}
+
+static void async_tx_done(struct shell_uart_async *sh_uart, size_t len)
+{
+	int err;
+
+	err = ring_buf_get_finish(&sh_uart->tx_ringbuf, len);
+	(void)err;
+	__ASSERT_NO_MSG(err == 0);
+
+	atomic_clear(&sh_uart->tx_busy);
+	/* Data put while the transfer was ongoing is sent now. */
+	async_tx_start(sh_uart);
+
+	sh_uart->common.handler(SHELL_TRANSPORT_EVT_TX_RDY, sh_uart->common.context);
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFERED */
+
 static void async_callback(const struct device *dev, struct uart_event *evt, void *user_data)
 {
 	struct shell_uart_async *sh_uart = (struct shell_uart_async *)user_data;
 
 	switch (evt->type) {
 	case  UART_TX_DONE:
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFERED
+		async_tx_done(sh_uart, evt->data.tx.len);
+#else
 		k_sem_give(&sh_uart->tx_sem);
+#endif
+		break;
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFERED
+	case  UART_TX_ABORTED:
+		async_tx_done(sh_uart, evt->data.tx.len);
 		break;
+#endif
 	case  UART_RX_RDY:
 		uart_async_rx_on_rdy(&sh_uart->async_rx, evt->data.rx.buf, evt->data.rx.len);
 		sh_uart->common.handler(SHELL_TRANSPORT_EVT_RX_RDY, sh_uart->common.context);
@@ -244,6 +290,11 @@ static void async_init(struct shell_uart_async *sh_uart)
 	};
 
 	k_sem_init(&sh_uart->tx_sem, 0, 1);
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFERED
+	ring_buf_init(&sh_uart->tx_ringbuf, CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFER_SIZE,
+		      sh_uart->tx_buf);
+	atomic_clear(&sh_uart->tx_busy);
+#endif
 
 	err = uart_async_rx_init(async_rx, &sh_uart->async_rx_config);
 	(void)err;
@@ -383,6 +434,17 @@ static int irq_write(struct shell_uart_int_driven *sh_uart,
 	return 0;
 }
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFERED
+static int async_write(struct shell_uart_async *sh_uart,
+		       const void *data, size_t length, size_t *cnt)
+{
+	/* The shell waits for TX_RDY if nothing fits in the buffer. */
+	*cnt = ring_buf_put(&sh_uart->tx_ringbuf, data, length);
+	async_tx_start(sh_uart);
+
+	return 0;
+}
+#else
 static int async_write(struct shell_uart_async *sh_uart,
 		       const void *data, size_t length, size_t *cnt)
 {
@@ -401,6 +463,7 @@ static int async_write(struct shell_uart_async *sh_uart,
 
 	return err;
 }
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFERED */
 
 static int write(const struct shell_transport *transport,
 		 const void *data, size_t length, size_t *cnt)
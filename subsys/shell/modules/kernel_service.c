@@ -95,6 +95,31 @@ static int cmd_kernel_cycles(const struct shell *sh,
 
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 	defined(CONFIG_THREAD_MONITOR)
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+static void shell_histogram_dump(const struct shell *sh, const char *name,
+				 const uint32_t *bins)
+{
+	shell_print(sh, "\t%s histogram (cycles):", name);
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BINS; i++) {
+		if (bins[i] == 0U) {
+			continue;
+		}
+
+		/* Bounds as powers of two, as %llu may not be supported */
+		if (i == CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BINS - 1) {
+			shell_print(sh, "\t  >= 2^%d: %u",
+				    CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_SHIFT + i - 1,
+				    bins[i]);
+		} else {
+			shell_print(sh, "\t  < 2^%d: %u",
+				    CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_SHIFT + i,
+				    bins[i]);
+		}
+	}
+}
+#endif
+
 static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 {
 	struct k_thread *thread = (struct k_thread *)cthread;
@@ -110,6 +135,9 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	k_thread_runtime_stats_t rt_stats_thread;
 	k_thread_runtime_stats_t rt_stats_all;
 #endif
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	struct k_sched_histogram hist;
+#endif
 
 	tname = k_thread_name_get(thread);
 
@@ -169,6 +197,14 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	}
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	if (k_thread_sched_histogram_get(thread, &hist) == 0) {
+		shell_histogram_dump(sh, "Wakeup latency", hist.wakeup);
+		shell_histogram_dump(sh, "Preempted time", hist.preempt);
+		shell_histogram_dump(sh, "Run length", hist.run);
+	}
+#endif
+
 	ret = k_thread_stack_space_get(thread, &unused);
 	if (ret) {
 		shell_print(sh,
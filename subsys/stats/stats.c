@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <errno.h>
 #include <zephyr/types.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/stats/stats.h>
 
 #define STATS_GEN_NAME_MAX_LEN  (sizeof("s255"))
@@ -15,6 +16,44 @@
 /* The global list of registered statistic groups. */
 static struct stats_hdr *stats_list;
 
+#ifdef CONFIG_STATS_PER_CPU
+/* The copies of a group for each CPU are a cache line apart, so that no two
+ * CPUs write to the same line.
+ */
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define STATS_CPU_ALIGN CONFIG_DCACHE_LINE_SIZE
+#else
+#define STATS_CPU_ALIGN 64
+#endif
+
+static uint8_t stats_cpu_pool[CONFIG_STATS_PER_CPU_POOL_SIZE]
+	__aligned(STATS_CPU_ALIGN) __stats_hot;
+static size_t stats_cpu_pool_used;
+
+/* Groups initialized again, or left without room in the pool, keep counting
+ * in the group structure itself.
+ */
+static void
+stats_cpu_alloc(struct stats_hdr *hdr)
+{
+	size_t stride = ROUND_UP(hdr->s_size * hdr->s_cnt, STATS_CPU_ALIGN);
+	size_t len = stride * CONFIG_MP_MAX_NUM_CPUS;
+
+	if (hdr->s_cpu != NULL) {
+		return;
+	}
+
+	if (stride > UINT16_MAX ||
+	    len > sizeof(stats_cpu_pool) - stats_cpu_pool_used) {
+		return;
+	}
+
+	hdr->s_cpu = stats_cpu_pool + stats_cpu_pool_used;
+	hdr->s_cpu_stride = stride;
+	stats_cpu_pool_used += len;
+}
+#endif /* CONFIG_STATS_PER_CPU */
+
 static const char *
 stats_get_name(const struct stats_hdr *hdr, int idx)
 {
@@ -139,6 +178,9 @@ stats_init(struct stats_hdr *hdr, uint8_t size, uint16_t cnt,
 	hdr->s_map = map;
 	hdr->s_map_cnt = map_cnt;
 #endif
+#ifdef CONFIG_STATS_PER_CPU
+	stats_cpu_alloc(hdr);
+#endif
 
 	stats_reset(hdr);
 }
@@ -281,4 +323,104 @@ void
 stats_reset(struct stats_hdr *hdr)
 {
 	(void)memset((uint8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+
+#ifdef CONFIG_STATS_PER_CPU
+	if (hdr->s_cpu != NULL) {
+		(void)memset(hdr->s_cpu, 0,
+			     hdr->s_cpu_stride * CONFIG_MP_MAX_NUM_CPUS);
+	}
+#endif
+}
+
+static uint64_t
+stats_entry_get(const uint8_t *entry, uint8_t size)
+{
+	switch (size) {
+	case sizeof(uint16_t):
+		return *(const uint16_t *)entry;
+	case sizeof(uint32_t):
+		return *(const uint32_t *)entry;
+	case sizeof(uint64_t):
+		return *(const uint64_t *)entry;
+	default:
+		return 0;
+	}
+}
+
+static void
+stats_entry_set(uint8_t *entry, uint8_t size, uint64_t val)
+{
+	switch (size) {
+	case sizeof(uint16_t):
+		*(uint16_t *)entry = (uint16_t)val;
+		break;
+	case sizeof(uint32_t):
+		*(uint32_t *)entry = (uint32_t)val;
+		break;
+	case sizeof(uint64_t):
+		*(uint64_t *)entry = val;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Retrieves the value of a stat entry, the sum of its copies for each CPU
+ * when these exist.  The copies are read while the CPUs keep counting, the
+ * sum may miss the increases made meanwhile.
+ *
+ * @param hdr The statistics header of the group
+ * @param off The offset of the entry from hdr
+ *
+ * @return The value of the entry.
+ */
+uint64_t
+stats_get(const struct stats_hdr *hdr, uint16_t off)
+{
+	uint64_t val;
+
+	val = stats_entry_get((const uint8_t *)hdr + off, hdr->s_size);
+
+#ifdef CONFIG_STATS_PER_CPU
+	if (hdr->s_cpu != NULL) {
+		const uint8_t *entry = hdr->s_cpu + off - sizeof(*hdr);
+
+		for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+			val += stats_entry_get(entry, hdr->s_size);
+			entry += hdr->s_cpu_stride;
+		}
+	}
+#endif
+
+	/* Wrap around like the entry itself would have */
+	if (hdr->s_size < sizeof(uint64_t)) {
+		val &= BIT64_MASK(hdr->s_size * 8);
+	}
+
+	return val;
+}
+
+/**
+ * Sets a stat entry to the specified value, dropping the counts of the CPUs.
+ *
+ * @param hdr The statistics header of the group
+ * @param off The offset of the entry from hdr
+ * @param val The value to set the entry to
+ */
+void
+stats_set(struct stats_hdr *hdr, uint16_t off, uint64_t val)
+{
+	stats_entry_set((uint8_t *)hdr + off, hdr->s_size, val);
+
+#ifdef CONFIG_STATS_PER_CPU
+	if (hdr->s_cpu != NULL) {
+		uint8_t *entry = hdr->s_cpu + off - sizeof(*hdr);
+
+		for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+			stats_entry_set(entry, hdr->s_size, 0);
+			entry += hdr->s_cpu_stride;
+		}
+	}
+#endif
 }
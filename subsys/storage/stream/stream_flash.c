@@ -12,6 +12,8 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <zephyr/types.h>
 #include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
 #include <zephyr/drivers/flash.h>
 
 #include <zephyr/storage/stream_flash.h>
@@ -104,23 +106,19 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+/* Write buf_bytes of buf at write_addr, and verify them with the callback */
+static int flash_sync_buf(struct stream_flash_ctx *ctx, uint8_t *buf,
+			  size_t buf_bytes, size_t write_addr)
 {
 	int rc = 0;
-	size_t write_addr = ctx->offset + ctx->bytes_written;
 	size_t buf_bytes_aligned;
 	size_t fill_length;
 	uint8_t filler;
 
-
-	if (ctx->buf_bytes == 0) {
-		return 0;
-	}
-
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+					     write_addr + buf_bytes - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -129,17 +127,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	fill_length = flash_get_write_block_size(ctx->fdev);
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = flash_get_parameters(ctx->fdev)->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -151,30 +149,172 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
 
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+
+static struct k_work_q stream_flash_work_q;
+static K_KERNEL_STACK_DEFINE(stream_flash_stack, CONFIG_STREAM_FLASH_DOUBLE_BUFFER_STACK_SIZE);
+
+static void stream_flash_bg_work(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx = CONTAINER_OF(work, struct stream_flash_ctx, bg_work);
+	size_t next = ctx->bg_addr + ctx->bg_bytes;
+	int rc;
+
+	rc = flash_sync_buf(ctx, ctx->bg_buf, ctx->bg_bytes, ctx->bg_addr);
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	/* Erase the page that the next buffer starts in, while it is filled.
+	 * It has no data yet if it is not the page just written to.
+	 */
+	if ((rc == 0) && (next < ctx->offset + ctx->available)) {
+		rc = stream_flash_erase_page(ctx, next);
+	}
+#else
+	ARG_UNUSED(next);
+#endif
+
+	ctx->bg_rc = rc;
+	k_sem_give(&ctx->bg_idle);
+}
+
+/* Wait for the background write, and account for it */
+static int stream_flash_bg_wait(struct stream_flash_ctx *ctx, bool keep_idle)
+{
+	k_sem_take(&ctx->bg_idle, K_FOREVER);
+	if (!keep_idle) {
+		k_sem_give(&ctx->bg_idle);
+	}
+
+	if (ctx->bg_rc == 0) {
+		ctx->bytes_written += ctx->bg_bytes;
+		ctx->bg_bytes = 0;
+	}
+
+	return ctx->bg_rc;
+}
+
+/* Swap the buffers, and write the full one in the background */
+static int stream_flash_bg_sync(struct stream_flash_ctx *ctx)
+{
+	uint8_t *buf = ctx->bg_buf;
+	int rc;
+
+	rc = stream_flash_bg_wait(ctx, true);
+	if (rc != 0) {
+		k_sem_give(&ctx->bg_idle);
+		return rc;
+	}
+
+	ctx->bg_buf = ctx->buf;
+	ctx->bg_bytes = ctx->buf_bytes;
+	ctx->bg_addr = ctx->offset + ctx->bytes_written;
+	ctx->buf = buf;
+	ctx->buf_bytes = 0U;
+
+	k_work_submit_to_queue(&stream_flash_work_q, &ctx->bg_work);
+
+	return 0;
+}
+
+int stream_flash_double_buffer_enable(struct stream_flash_ctx *ctx, uint8_t *buf)
+{
+	if (!ctx || !buf) {
+		return -EFAULT;
+	}
+
+	ctx->bg_buf = buf;
+	ctx->bg_bytes = 0U;
+	ctx->bg_rc = 0;
+	k_work_init(&ctx->bg_work, stream_flash_bg_work);
+	k_sem_init(&ctx->bg_idle, 1, 1);
+
+	return 0;
+}
+
+static int stream_flash_double_buffer_init(void)
+{
+	k_work_queue_start(&stream_flash_work_q, stream_flash_stack,
+			   K_KERNEL_STACK_SIZEOF(stream_flash_stack),
+			   CONFIG_STREAM_FLASH_DOUBLE_BUFFER_PRIORITY, NULL);
+	k_thread_name_set(&stream_flash_work_q.thread, "stream_flash");
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_double_buffer_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_STREAM_FLASH_DOUBLE_BUFFER */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (ctx->buf_bytes == 0) {
+		return 0;
+	}
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	if (ctx->bg_buf != NULL) {
+		return stream_flash_bg_sync(ctx);
+	}
+#endif
+
+	rc = flash_sync_buf(ctx, ctx->buf, ctx->buf_bytes,
+			    ctx->offset + ctx->bytes_written);
+	if (rc != 0) {
+		return rc;
+	}
+
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
 	return rc;
 }
 
+/* Wait for the buffer written in the background, if any */
+static int flash_sync_wait(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	if (ctx->bg_buf != NULL) {
+		return stream_flash_bg_wait(ctx, false);
+	}
+#endif
+
+	return 0;
+}
+
+/* Bytes written, being written and buffered */
+static size_t stream_flash_pending(struct stream_flash_ctx *ctx)
+{
+	size_t bytes = ctx->bytes_written + ctx->buf_bytes;
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	bytes += ctx->bg_bytes;
+#endif
+
+	return bytes;
+}
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
@@ -186,7 +326,7 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (stream_flash_pending(ctx) + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -216,6 +356,10 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+	if (flush && rc == 0) {
+		rc = flash_sync_wait(ctx);
+	}
+
 	return rc;
 }
 
@@ -296,6 +440,11 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 				      size);
 	ctx->callback = cb;
 
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	ctx->bg_buf = NULL;
+	ctx->bg_bytes = 0U;
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	ctx->last_erased_page_start_offset = -1;
 #endif
@@ -8,6 +8,7 @@
 #include <zephyr/kernel_structs.h>
 #include <kernel_internal.h>
 #include <ctf_top.h>
+#include <tracing_core.h>
 
 
 static void _get_thread_name(struct k_thread *thread,
@@ -319,3 +320,26 @@ void sys_trace_k_timer_status_sync_exit(struct k_timer *timer, uint32_t result)
 		result
 		);
 }
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Called by the tracing thread, which does not trace itself, so the event
+ * goes straight to the backend.
+ */
+void tracing_cpu_stream_start(uint8_t cpu_id)
+{
+	uint8_t event[] = {
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+		0, 0, 0, 0,
+#endif
+		CTF_EVENT_CPU_STREAM, cpu_id
+	};
+
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+	const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32());
+
+	memcpy(event, &tstamp, sizeof(tstamp));
+#endif
+
+	tracing_buffer_handle(event, sizeof(event));
+}
+#endif
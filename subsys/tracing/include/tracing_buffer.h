@@ -16,13 +16,18 @@ extern "C" {
 
 /**
  * @brief Initialize tracing buffer.
+ *
+ * With CONFIG_TRACING_PER_CPU_BUFFERS, each CPU has its own buffer. The put
+ * and space functions use the buffer of the current CPU, with interrupts
+ * locked on that CPU, and the get functions drain the buffers in turn.
  */
 void tracing_buffer_init(void);
 
 /**
  * @brief Tracing buffer is empty or not.
  *
- * @return true if the ring buffer is empty, or false if not.
+ * @return true if the ring buffer (all of them with per CPU buffers) is
+ *         empty, or false if not.
  */
 bool tracing_buffer_is_empty(void);
 
@@ -104,6 +109,13 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+/**
+ * @brief Get the CPU of the data returned by tracing_buffer_get_claim().
+ *
+ * @return CPU ID, always 0 without per CPU buffers.
+ */
+uint32_t tracing_buffer_cpu_get(void);
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
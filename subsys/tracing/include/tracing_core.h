@@ -14,9 +14,16 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Each CPU only writes to its own buffer */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -38,6 +45,17 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length);
  */
 void tracing_packet_drop_handle(void);
 
+/**
+ * @brief Mark the start of the data of a CPU in the output.
+ *
+ * Called by the tracing thread with per CPU buffers, before the data of
+ * another CPU than the previous one is given to the backend. Formats that
+ * tell CPUs apart implement it, the default does nothing.
+ *
+ * @param cpu_id CPU of the data that follows.
+ */
+void tracing_cpu_stream_start(uint8_t cpu_id);
+
 /**
  * @brief Handle tracing command.
  *
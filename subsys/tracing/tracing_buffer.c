@@ -4,12 +4,49 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/ring_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#define TRACING_BUFFER_CNT CONFIG_MP_MAX_NUM_CPUS
+#else
+#define TRACING_BUFFER_CNT 1
+#endif
+
+static struct ring_buf tracing_ring_buf[TRACING_BUFFER_CNT];
+static uint8_t tracing_buffer[TRACING_BUFFER_CNT][CONFIG_TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Buffer being drained, and how much of it is left to drain. Data of the
+ * current CPU is always complete packets, so a buffer is only left after
+ * what it held when it was picked.
+ */
+static uint8_t drain_idx;
+static uint32_t drain_left;
+#endif
+
+/* Buffer of the current CPU, the caller has interrupts locked */
+static inline struct ring_buf *put_buf(void)
+{
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	return &tracing_ring_buf[arch_curr_cpu()->id];
+#else
+	return &tracing_ring_buf[0];
+#endif
+}
+
+static inline struct ring_buf *get_buf(void)
+{
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	return &tracing_ring_buf[drain_idx];
+#else
+	return &tracing_ring_buf[0];
+#endif
+}
+
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 {
 	*data = &tracing_cmd_buffer[0];
@@ -19,51 +56,125 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(put_buf(), data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		/* The data is read without a lock from another CPU */
+		barrier_dmem_fence_full();
+	}
+
+	return ring_buf_put_finish(put_buf(), size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		uint32_t total = 0;
+		uint32_t n;
+		uint8_t *dst;
+
+		do {
+			n = ring_buf_put_claim(put_buf(), &dst, size - total);
+			memcpy(dst, &data[total], n);
+			total += n;
+		} while ((n != 0) && (total < size));
+
+		(void)tracing_buffer_put_finish(total);
+
+		return total;
+	}
+
+	return ring_buf_put(put_buf(), data, size);
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	uint32_t n;
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	for (int i = 0; (i < TRACING_BUFFER_CNT) && (drain_left == 0); i++) {
+		drain_idx = (drain_idx + 1) % TRACING_BUFFER_CNT;
+		drain_left = ring_buf_size_get(&tracing_ring_buf[drain_idx]);
+	}
+
+	size = MIN(size, drain_left);
+#endif
+
+	n = ring_buf_get_claim(get_buf(), data, size);
+
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		barrier_dmem_fence_full();
+	}
+
+	return n;
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	drain_left -= MIN(size, drain_left);
+#endif
+
+	return ring_buf_get_finish(get_buf(), size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	uint32_t total = 0;
+	uint32_t n;
+	uint8_t *src;
+
+	if (!IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		return ring_buf_get(get_buf(), data, size);
+	}
+
+	do {
+		n = tracing_buffer_get_claim(&src, size - total);
+		memcpy(&data[total], src, n);
+		(void)tracing_buffer_get_finish(n);
+		total += n;
+	} while ((n != 0) && (total < size));
+
+	return total;
+}
+
+uint32_t tracing_buffer_cpu_get(void)
+{
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	return drain_idx;
+#else
+	return 0;
+#endif
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFER_CNT; i++) {
+		ring_buf_init(&tracing_ring_buf[i],
+			      sizeof(tracing_buffer[i]), tracing_buffer[i]);
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	for (int i = 0; i < TRACING_BUFFER_CNT; i++) {
+		if (!ring_buf_is_empty(&tracing_ring_buf[i])) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(put_buf());
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(put_buf());
 }
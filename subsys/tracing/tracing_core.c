@@ -58,6 +58,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
 	uint32_t transferring_length, tracing_buffer_max_length;
+	uint32_t cpu = UINT32_MAX;
 
 	tracing_thread_tid = k_current_get();
 
@@ -71,6 +72,11 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 				tracing_buffer_get_claim(
 						&transferring_buf,
 						tracing_buffer_max_length);
+			if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS) &&
+			    (tracing_buffer_cpu_get() != cpu)) {
+				cpu = tracing_buffer_cpu_get();
+				tracing_cpu_stream_start(cpu);
+			}
 			tracing_buffer_handle(transferring_buf,
 					      transferring_length);
 			tracing_buffer_get_finish(transferring_length);
@@ -160,3 +166,8 @@ void tracing_packet_drop_handle(void)
 {
 	atomic_inc(&tracing_packet_drop_num);
 }
+
+__weak void tracing_cpu_stream_start(uint8_t cpu_id)
+{
+	ARG_UNUSED(cpu_id);
+}
@@ -28,18 +28,43 @@ enum {
 	CDC_ECM_IFACE_UP,
 	CDC_ECM_CLASS_ENABLED,
 	CDC_ECM_CLASS_SUSPENDED,
-	CDC_ECM_OUT_ENGAGED,
+	CDC_ECM_RX_STARVED,
 };
 
 /*
- * Transfers through two endpoints proceed in a synchronous manner,
- * with maximum block of NET_ETH_MAX_FRAME_SIZE.
+ * Up to CONFIG_USBD_CDC_ECM_RX_QUEUE_DEPTH OUT and
+ * CONFIG_USBD_CDC_ECM_TX_QUEUE_DEPTH IN transfers are queued on the bulk
+ * endpoints of each instance, with maximum block of NET_ETH_MAX_FRAME_SIZE.
+ * The pools are separate as the network stack can hold OUT buffers.
  */
-NET_BUF_POOL_FIXED_DEFINE(cdc_ecm_ep_pool,
-			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * 2,
+NET_BUF_POOL_FIXED_DEFINE(cdc_ecm_rx_pool,
+			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) *
+			  CONFIG_USBD_CDC_ECM_RX_QUEUE_DEPTH,
 			  NET_ETH_MAX_FRAME_SIZE,
 			  sizeof(struct udc_buf_info), NULL);
 
+NET_BUF_POOL_FIXED_DEFINE(cdc_ecm_tx_pool,
+			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) *
+			  CONFIG_USBD_CDC_ECM_TX_QUEUE_DEPTH,
+			  NET_ETH_MAX_FRAME_SIZE,
+			  sizeof(struct udc_buf_info), NULL);
+
+#if defined(CONFIG_USBD_CDC_ECM_RX_ZERO_COPY)
+#define CDC_ECM_RX_VIEW_COUNT (DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * \
+			       CONFIG_USBD_CDC_ECM_RX_QUEUE_DEPTH)
+
+static void cdc_ecm_rx_view_destroy(struct net_buf *view);
+
+/* Fragments of received packets, which share the memory of transfer buffers */
+NET_BUF_POOL_FIXED_DEFINE(cdc_ecm_rx_view_pool, CDC_ECM_RX_VIEW_COUNT, 0, 0,
+			  cdc_ecm_rx_view_destroy);
+
+static struct cdc_ecm_rx_view {
+	struct usbd_class_node *c_nd;
+	struct net_buf *parent;
+} cdc_ecm_rx_views[CDC_ECM_RX_VIEW_COUNT];
+#endif /* CONFIG_USBD_CDC_ECM_RX_ZERO_COPY */
+
 struct cdc_ecm_notification {
 	union {
 		uint8_t bmRequestType;
@@ -58,8 +83,15 @@ struct cdc_ecm_eth_data {
 	struct net_if *iface;
 	uint8_t mac_addr[6];
 
-	struct k_sem sync_sem;
+	/* Free slots in the queue of IN transfers */
+	struct k_sem tx_sem;
 	struct k_sem notif_sem;
+	/* Number of OUT transfers queued */
+	atomic_t rx_queued;
+#if defined(CONFIG_USBD_CDC_ECM_RX_ZERO_COPY)
+	/* Queue OUT transfers again once the stack released their buffers */
+	struct k_work rx_work;
+#endif
 	atomic_t state;
 };
 
@@ -109,12 +141,13 @@ static uint8_t cdc_ecm_get_bulk_out(struct usbd_class_node *const c_nd)
 	return desc->if1_1_out_ep.bEndpointAddress;
 }
 
-static struct net_buf *cdc_ecm_buf_alloc(const uint8_t ep)
+static struct net_buf *cdc_ecm_buf_alloc(struct net_buf_pool *const pool,
+					 const uint8_t ep)
 {
 	struct net_buf *buf = NULL;
 	struct udc_buf_info *bi;
 
-	buf = net_buf_alloc(&cdc_ecm_ep_pool, K_NO_WAIT);
+	buf = net_buf_alloc(pool, K_NO_WAIT);
 	if (!buf) {
 		return NULL;
 	}
@@ -155,6 +188,30 @@ static size_t ecm_eth_size(void *const ecm_pkt, const size_t len)
 	return sizeof(struct net_eth_hdr) + ip_len;
 }
 
+static struct net_buf *cdc_ecm_out_buf_alloc(struct cdc_ecm_eth_data *const data,
+					      const uint8_t ep)
+{
+	struct net_buf *buf;
+
+	buf = cdc_ecm_buf_alloc(&cdc_ecm_rx_pool, ep);
+	if (buf != NULL || !IS_ENABLED(CONFIG_USBD_CDC_ECM_RX_ZERO_COPY)) {
+		return buf;
+	}
+
+	/*
+	 * The network stack holds all the buffers. Try again after setting
+	 * the flag, in case the last one was released in between.
+	 */
+	atomic_set_bit(&data->state, CDC_ECM_RX_STARVED);
+	buf = cdc_ecm_buf_alloc(&cdc_ecm_rx_pool, ep);
+	if (buf != NULL) {
+		atomic_clear_bit(&data->state, CDC_ECM_RX_STARVED);
+	}
+
+	return buf;
+}
+
+/* Queue OUT transfers until CONFIG_USBD_CDC_ECM_RX_QUEUE_DEPTH are pending */
 static int cdc_ecm_out_start(struct usbd_class_node *const c_nd)
 {
 	const struct device *dev = c_nd->data->priv;
@@ -167,23 +224,117 @@ static int cdc_ecm_out_start(struct usbd_class_node *const c_nd)
 		return -EACCES;
 	}
 
-	if (atomic_test_and_set_bit(&data->state, CDC_ECM_OUT_ENGAGED)) {
-		return -EBUSY;
+	ep = cdc_ecm_get_bulk_out(c_nd);
+
+	/* Also called from the work queue, a slot is reserved before it is used */
+	while (atomic_inc(&data->rx_queued) < CONFIG_USBD_CDC_ECM_RX_QUEUE_DEPTH) {
+		buf = cdc_ecm_out_buf_alloc(data, ep);
+		if (buf == NULL) {
+			atomic_dec(&data->rx_queued);
+			return -ENOMEM;
+		}
+
+		ret = usbd_ep_enqueue(c_nd, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			atomic_dec(&data->rx_queued);
+			net_buf_unref(buf);
+			return ret;
+		}
 	}
 
-	ep = cdc_ecm_get_bulk_out(c_nd);
-	buf = cdc_ecm_buf_alloc(ep);
-	if (buf == NULL) {
-		return -ENOMEM;
+	atomic_dec(&data->rx_queued);
+
+	return 0;
+}
+
+#if defined(CONFIG_USBD_CDC_ECM_RX_ZERO_COPY)
+static void cdc_ecm_rx_work_handler(struct k_work *work)
+{
+	struct cdc_ecm_eth_data *data;
+
+	data = CONTAINER_OF(work, struct cdc_ecm_eth_data, rx_work);
+	(void)cdc_ecm_out_start(data->c_nd);
+}
+
+static void cdc_ecm_rx_view_destroy(struct net_buf *view)
+{
+	struct cdc_ecm_rx_view *rv = &cdc_ecm_rx_views[net_buf_id(view)];
+	const struct device *dev = rv->c_nd->data->priv;
+	struct cdc_ecm_eth_data *data = dev->data;
+	struct net_buf *parent = rv->parent;
+
+	rv->c_nd = NULL;
+	rv->parent = NULL;
+
+	net_buf_destroy(view);
+	net_buf_unref(parent);
+
+	if (atomic_test_and_clear_bit(&data->state, CDC_ECM_RX_STARVED)) {
+		k_work_submit(&data->rx_work);
 	}
+}
 
-	ret = usbd_ep_enqueue(c_nd, buf);
-	if (ret) {
-		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
-		net_buf_unref(buf);
+/* Packet whose fragment references the data of the transfer buffer */
+static struct net_pkt *cdc_ecm_rx_pkt_view(struct usbd_class_node *const c_nd,
+					   struct net_buf *const buf)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ecm_eth_data *data = dev->data;
+	struct cdc_ecm_rx_view *rv;
+	struct net_buf *view;
+	struct net_pkt *pkt;
+
+	view = net_buf_alloc_with_data(&cdc_ecm_rx_view_pool, buf->data, buf->len,
+				       K_NO_WAIT);
+	if (view == NULL) {
+		return NULL;
+	}
+
+	rv = &cdc_ecm_rx_views[net_buf_id(view)];
+	rv->c_nd = c_nd;
+	rv->parent = net_buf_ref(buf);
+
+	pkt = net_pkt_rx_alloc_on_iface(data->iface, K_FOREVER);
+	if (!pkt) {
+		net_buf_unref(view);
+		return NULL;
 	}
 
-	return  ret;
+	net_pkt_frag_add(pkt, view);
+
+	return pkt;
+}
+#endif /* CONFIG_USBD_CDC_ECM_RX_ZERO_COPY */
+
+static struct net_pkt *cdc_ecm_rx_pkt(struct usbd_class_node *const c_nd,
+				      struct net_buf *const buf)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ecm_eth_data *data = dev->data;
+	struct net_pkt *pkt;
+
+#if defined(CONFIG_USBD_CDC_ECM_RX_ZERO_COPY)
+	pkt = cdc_ecm_rx_pkt_view(c_nd, buf);
+	if (pkt) {
+		return pkt;
+	}
+#endif
+
+	pkt = net_pkt_rx_alloc_with_buffer(data->iface, buf->len,
+					   AF_UNSPEC, 0, K_FOREVER);
+	if (!pkt) {
+		LOG_ERR("No memory for net_pkt");
+		return NULL;
+	}
+
+	if (net_pkt_write(pkt, buf->data, buf->len)) {
+		LOG_ERR("Unable to write into pkt");
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
 }
 
 static int cdc_ecm_acl_out_cb(struct usbd_class_node *const c_nd,
@@ -210,16 +361,8 @@ static int cdc_ecm_acl_out_cb(struct usbd_class_node *const c_nd,
 		}
 	}
 
-	pkt = net_pkt_rx_alloc_with_buffer(data->iface, buf->len,
-					   AF_UNSPEC, 0, K_FOREVER);
+	pkt = cdc_ecm_rx_pkt(c_nd, buf);
 	if (!pkt) {
-		LOG_ERR("No memory for net_pkt");
-		goto restart_out_transfer;
-	}
-
-	if (net_pkt_write(pkt, buf->data, buf->len)) {
-		LOG_ERR("Unable to write into pkt");
-		net_pkt_unref(pkt);
 		goto restart_out_transfer;
 	}
 
@@ -231,7 +374,7 @@ static int cdc_ecm_acl_out_cb(struct usbd_class_node *const c_nd,
 
 restart_out_transfer:
 	net_buf_unref(buf);
-	atomic_clear_bit(&data->state, CDC_ECM_OUT_ENGAGED);
+	atomic_dec(&data->rx_queued);
 
 	return cdc_ecm_out_start(c_nd);
 }
@@ -251,7 +394,8 @@ static int usbd_cdc_ecm_request(struct usbd_class_node *const c_nd,
 	}
 
 	if (bi->ep == cdc_ecm_get_bulk_in(c_nd)) {
-		k_sem_give(&data->sync_sem);
+		net_buf_unref(buf);
+		k_sem_give(&data->tx_sem);
 
 		return 0;
 	}
@@ -435,6 +579,7 @@ static int cdc_ecm_send(const struct device *dev, struct net_pkt *const pkt)
 	size_t len = net_pkt_get_len(pkt);
 	struct net_buf *buf;
 	uint16_t bulk_mps;
+	int ret;
 
 	if (len > NET_ETH_MAX_FRAME_SIZE) {
 		LOG_WRN("Trying to send too large packet, drop");
@@ -447,15 +592,20 @@ static int cdc_ecm_send(const struct device *dev, struct net_pkt *const pkt)
 		return -EACCES;
 	}
 
-	buf = cdc_ecm_buf_alloc(cdc_ecm_get_bulk_in(c_nd));
+	/* Wait for a free slot, the buffer is released on transfer completion */
+	k_sem_take(&data->tx_sem, K_FOREVER);
+
+	buf = cdc_ecm_buf_alloc(&cdc_ecm_tx_pool, cdc_ecm_get_bulk_in(c_nd));
 	if (buf == NULL) {
 		LOG_ERR("Failed to allocate buffer");
+		k_sem_give(&data->tx_sem);
 		return -ENOMEM;
 	}
 
 	if (net_pkt_read(pkt, buf->data, len)) {
 		LOG_ERR("Failed copy net_pkt");
 		net_buf_unref(buf);
+		k_sem_give(&data->tx_sem);
 
 		return -ENOBUFS;
 	}
@@ -476,11 +626,14 @@ static int cdc_ecm_send(const struct device *dev, struct net_pkt *const pkt)
 		udc_ep_buf_set_zlp(buf);
 	}
 
-	usbd_ep_enqueue(c_nd, buf);
-	k_sem_take(&data->sync_sem, K_FOREVER);
-	net_buf_unref(buf);
+	ret = usbd_ep_enqueue(c_nd, buf);
+	if (ret) {
+		LOG_ERR("Failed to enqueue net_buf for 0x%02x", cdc_ecm_get_bulk_in(c_nd));
+		net_buf_unref(buf);
+		k_sem_give(&data->tx_sem);
+	}
 
-	return 0;
+	return ret;
 }
 
 static int cdc_ecm_set_config(const struct device *dev,
@@ -715,8 +868,13 @@ static struct usbd_cdc_ecm_desc cdc_ecm_desc_##n = {				\
 	static struct cdc_ecm_eth_data eth_data_##n = {				\
 		.c_nd = &cdc_ecm_##n,						\
 		.mac_addr = DT_INST_PROP_OR(n, local_mac_address, {0}),		\
-		.sync_sem = Z_SEM_INITIALIZER(eth_data_##n.sync_sem, 0, 1),	\
+		.tx_sem = Z_SEM_INITIALIZER(eth_data_##n.tx_sem,		\
+			CONFIG_USBD_CDC_ECM_TX_QUEUE_DEPTH,		\
+			CONFIG_USBD_CDC_ECM_TX_QUEUE_DEPTH),		\
 		.notif_sem = Z_SEM_INITIALIZER(eth_data_##n.notif_sem, 0, 1),	\
+		IF_ENABLED(CONFIG_USBD_CDC_ECM_RX_ZERO_COPY, (			\
+			.rx_work = Z_WORK_INITIALIZER(cdc_ecm_rx_work_handler),	\
+		))								\
 		.mac_desc_nd = &mac_desc_nd_##n,				\
 	};									\
 										\
@@ -0,0 +1,1161 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zephyr_cdc_ncm_ethernet
+
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <eth.h>
+
+#include <zephyr/usb/usbd.h>
+#include <zephyr/usb/usb_ch9.h>
+#include <zephyr/usb/class/usb_cdc.h>
+#include <zephyr/drivers/usb/udc.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(cdc_ncm, CONFIG_USBD_CDC_NCM_LOG_LEVEL);
+
+#define CDC_NCM_EP_MPS_BULK		0
+#define CDC_NCM_EP_MPS_INT		16
+#define CDC_NCM_EP_INTERVAL_INT		0x0A
+
+/* Datagrams of the IN and OUT NTBs start at multiples of the divisor */
+#define CDC_NCM_NDP_DIVISOR		4
+#define CDC_NCM_NDP_ALIGNMENT		4
+
+/*
+ * The NDP16 of an IN NTB directly follows the NTH16, with room for all the
+ * datagram pointers and the terminating null entry.
+ */
+#define CDC_NCM_IN_NDP_OFFSET		ROUND_UP(sizeof(struct cdc_ncm_nth16),	\
+						 CDC_NCM_NDP_ALIGNMENT)
+#define CDC_NCM_IN_NDP_SIZE		(sizeof(struct cdc_ncm_ndp16) +		\
+					 (CONFIG_USBD_CDC_NCM_MAX_DATAGRAMS + 1) * \
+					 sizeof(struct cdc_ncm_ndp16_datagram))
+#define CDC_NCM_IN_PAYLOAD_OFFSET	ROUND_UP(CDC_NCM_IN_NDP_OFFSET +	\
+						 CDC_NCM_IN_NDP_SIZE,		\
+						 CDC_NCM_NDP_DIVISOR)
+
+/* Smallest NTB that holds a frame of maximum size */
+#define CDC_NCM_NTB_MIN_SIZE		(CDC_NCM_IN_PAYLOAD_OFFSET +		\
+					 NET_ETH_MAX_FRAME_SIZE)
+
+BUILD_ASSERT(CDC_NCM_NTB_MIN_SIZE <= CONFIG_USBD_CDC_NCM_NTB_SIZE,
+	     "NTB size too small for CONFIG_USBD_CDC_NCM_MAX_DATAGRAMS");
+
+enum {
+	CDC_NCM_IFACE_UP,
+	CDC_NCM_CLASS_ENABLED,
+	CDC_NCM_CLASS_SUSPENDED,
+	CDC_NCM_RX_STARVED,
+};
+
+/*
+ * Up to CONFIG_USBD_CDC_NCM_RX_QUEUE_DEPTH OUT and
+ * CONFIG_USBD_CDC_NCM_TX_QUEUE_DEPTH IN NTBs are queued on the bulk
+ * endpoints of each instance, and one more IN NTB per instance is filled
+ * while the IN queue is full.
+ */
+NET_BUF_POOL_FIXED_DEFINE(cdc_ncm_rx_pool,
+			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) *
+			  CONFIG_USBD_CDC_NCM_RX_QUEUE_DEPTH,
+			  CONFIG_USBD_CDC_NCM_NTB_SIZE,
+			  sizeof(struct udc_buf_info), NULL);
+
+NET_BUF_POOL_FIXED_DEFINE(cdc_ncm_tx_pool,
+			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) *
+			  (CONFIG_USBD_CDC_NCM_TX_QUEUE_DEPTH + 1),
+			  CONFIG_USBD_CDC_NCM_NTB_SIZE,
+			  sizeof(struct udc_buf_info), NULL);
+
+#if defined(CONFIG_USBD_CDC_NCM_RX_ZERO_COPY)
+#define CDC_NCM_RX_VIEW_COUNT (DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * \
+			       CONFIG_USBD_CDC_NCM_RX_QUEUE_DEPTH * \
+			       CONFIG_USBD_CDC_NCM_MAX_DATAGRAMS)
+
+static void cdc_ncm_rx_view_destroy(struct net_buf *view);
+
+/* Fragments of received packets, which share the memory of OUT NTBs */
+NET_BUF_POOL_FIXED_DEFINE(cdc_ncm_rx_view_pool, CDC_NCM_RX_VIEW_COUNT, 0, 0,
+			  cdc_ncm_rx_view_destroy);
+
+static struct cdc_ncm_rx_view {
+	struct usbd_class_node *c_nd;
+	struct net_buf *parent;
+} cdc_ncm_rx_views[CDC_NCM_RX_VIEW_COUNT];
+#endif /* CONFIG_USBD_CDC_NCM_RX_ZERO_COPY */
+
+struct cdc_ncm_notification {
+	union {
+		uint8_t bmRequestType;
+		struct usb_req_type_field RequestType;
+	};
+	uint8_t bNotificationType;
+	uint16_t wValue;
+	uint16_t wIndex;
+	uint16_t wLength;
+} __packed;
+
+struct cdc_ncm_eth_data {
+	struct usbd_class_node *c_nd;
+	struct usbd_desc_node *const mac_desc_nd;
+
+	struct net_if *iface;
+	uint8_t mac_addr[6];
+
+	/* IN NTB being filled, protected by tx_lock */
+	struct net_buf *tx_ntb;
+	uint8_t tx_count;
+	uint16_t tx_seq;
+	struct k_mutex tx_lock;
+	/* Free slots in the queue of IN transfers */
+	struct k_sem tx_sem;
+	/* Maximum size of IN NTBs, as set by the host */
+	uint32_t ntb_in_size;
+
+	struct k_sem notif_sem;
+	/* Number of OUT transfers queued */
+	atomic_t rx_queued;
+#if defined(CONFIG_USBD_CDC_NCM_RX_ZERO_COPY)
+	/* Queue OUT transfers again once the stack released their buffers */
+	struct k_work rx_work;
+#endif
+	atomic_t state;
+};
+
+struct usbd_cdc_ncm_desc {
+	struct usb_association_descriptor iad;
+
+	struct usb_if_descriptor if0;
+	struct cdc_header_descriptor if0_header;
+	struct cdc_union_descriptor if0_union;
+	struct cdc_ecm_descriptor if0_ecm;
+	struct cdc_ncm_descriptor if0_ncm;
+	struct usb_ep_descriptor if0_int_ep;
+
+	struct usb_if_descriptor if1_0;
+
+	struct usb_if_descriptor if1_1;
+	struct usb_ep_descriptor if1_1_in_ep;
+	struct usb_ep_descriptor if1_1_out_ep;
+
+	struct usb_desc_header nil_desc;
+} __packed;
+
+static uint8_t cdc_ncm_get_ctrl_if(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+
+	return desc->if0.bInterfaceNumber;
+}
+
+static uint8_t cdc_ncm_get_int_in(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+
+	return desc->if0_int_ep.bEndpointAddress;
+}
+
+static uint8_t cdc_ncm_get_bulk_in(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+
+	return desc->if1_1_in_ep.bEndpointAddress;
+}
+
+static uint8_t cdc_ncm_get_bulk_out(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+
+	return desc->if1_1_out_ep.bEndpointAddress;
+}
+
+static struct net_buf *cdc_ncm_buf_alloc(struct net_buf_pool *const pool,
+					 const uint8_t ep)
+{
+	struct net_buf *buf = NULL;
+	struct udc_buf_info *bi;
+
+	buf = net_buf_alloc(pool, K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	bi = udc_get_buf_info(buf);
+	memset(bi, 0, sizeof(struct udc_buf_info));
+	bi->ep = ep;
+
+	return buf;
+}
+
+static struct net_buf *cdc_ncm_out_buf_alloc(struct cdc_ncm_eth_data *const data,
+					     const uint8_t ep)
+{
+	struct net_buf *buf;
+
+	buf = cdc_ncm_buf_alloc(&cdc_ncm_rx_pool, ep);
+	if (buf != NULL || !IS_ENABLED(CONFIG_USBD_CDC_NCM_RX_ZERO_COPY)) {
+		return buf;
+	}
+
+	/*
+	 * The network stack holds all the buffers. Try again after setting
+	 * the flag, in case the last one was released in between.
+	 */
+	atomic_set_bit(&data->state, CDC_NCM_RX_STARVED);
+	buf = cdc_ncm_buf_alloc(&cdc_ncm_rx_pool, ep);
+	if (buf != NULL) {
+		atomic_clear_bit(&data->state, CDC_NCM_RX_STARVED);
+	}
+
+	return buf;
+}
+
+/* Queue OUT transfers until CONFIG_USBD_CDC_NCM_RX_QUEUE_DEPTH are pending */
+static int cdc_ncm_out_start(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct net_buf *buf;
+	uint8_t ep;
+	int ret;
+
+	if (!atomic_test_bit(&data->state, CDC_NCM_CLASS_ENABLED)) {
+		return -EACCES;
+	}
+
+	ep = cdc_ncm_get_bulk_out(c_nd);
+
+	/* Also called from the work queue, a slot is reserved before it is used */
+	while (atomic_inc(&data->rx_queued) < CONFIG_USBD_CDC_NCM_RX_QUEUE_DEPTH) {
+		buf = cdc_ncm_out_buf_alloc(data, ep);
+		if (buf == NULL) {
+			atomic_dec(&data->rx_queued);
+			return -ENOMEM;
+		}
+
+		ret = usbd_ep_enqueue(c_nd, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			atomic_dec(&data->rx_queued);
+			net_buf_unref(buf);
+			return ret;
+		}
+	}
+
+	atomic_dec(&data->rx_queued);
+
+	return 0;
+}
+
+#if defined(CONFIG_USBD_CDC_NCM_RX_ZERO_COPY)
+static void cdc_ncm_rx_work_handler(struct k_work *work)
+{
+	struct cdc_ncm_eth_data *data;
+
+	data = CONTAINER_OF(work, struct cdc_ncm_eth_data, rx_work);
+	(void)cdc_ncm_out_start(data->c_nd);
+}
+
+static void cdc_ncm_rx_view_destroy(struct net_buf *view)
+{
+	struct cdc_ncm_rx_view *rv = &cdc_ncm_rx_views[net_buf_id(view)];
+	const struct device *dev = rv->c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct net_buf *parent = rv->parent;
+
+	rv->c_nd = NULL;
+	rv->parent = NULL;
+
+	net_buf_destroy(view);
+	net_buf_unref(parent);
+
+	if (atomic_test_and_clear_bit(&data->state, CDC_NCM_RX_STARVED)) {
+		k_work_submit(&data->rx_work);
+	}
+}
+
+/* Packet whose fragment references the datagram in the OUT NTB */
+static struct net_pkt *cdc_ncm_rx_pkt_view(struct usbd_class_node *const c_nd,
+					   struct net_buf *const buf,
+					   const uint16_t offset, const uint16_t len)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct cdc_ncm_rx_view *rv;
+	struct net_buf *view;
+	struct net_pkt *pkt;
+
+	view = net_buf_alloc_with_data(&cdc_ncm_rx_view_pool, buf->data + offset, len,
+				       K_NO_WAIT);
+	if (view == NULL) {
+		return NULL;
+	}
+
+	rv = &cdc_ncm_rx_views[net_buf_id(view)];
+	rv->c_nd = c_nd;
+	rv->parent = net_buf_ref(buf);
+
+	pkt = net_pkt_rx_alloc_on_iface(data->iface, K_FOREVER);
+	if (!pkt) {
+		net_buf_unref(view);
+		return NULL;
+	}
+
+	net_pkt_frag_add(pkt, view);
+
+	return pkt;
+}
+#endif /* CONFIG_USBD_CDC_NCM_RX_ZERO_COPY */
+
+static void cdc_ncm_rx_datagram(struct usbd_class_node *const c_nd,
+				struct net_buf *const buf,
+				const uint16_t offset, const uint16_t len)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct net_pkt *pkt = NULL;
+
+#if defined(CONFIG_USBD_CDC_NCM_RX_ZERO_COPY)
+	pkt = cdc_ncm_rx_pkt_view(c_nd, buf, offset, len);
+#endif
+
+	if (pkt == NULL) {
+		pkt = net_pkt_rx_alloc_with_buffer(data->iface, len,
+						   AF_UNSPEC, 0, K_FOREVER);
+		if (!pkt) {
+			LOG_ERR("No memory for net_pkt");
+			return;
+		}
+
+		if (net_pkt_write(pkt, buf->data + offset, len)) {
+			LOG_ERR("Unable to write into pkt");
+			net_pkt_unref(pkt);
+			return;
+		}
+	}
+
+	LOG_DBG("Received packet len %zu", net_pkt_get_len(pkt));
+	if (net_recv_data(data->iface, pkt) < 0) {
+		LOG_ERR("Packet %p dropped by network stack", pkt);
+		net_pkt_unref(pkt);
+	}
+}
+
+/* Pass the datagrams of an NDP16 of the NTB to the network stack */
+static int cdc_ncm_rx_ndp16(struct usbd_class_node *const c_nd,
+			    struct net_buf *const buf,
+			    const uint16_t block_len, const uint16_t ndp_idx,
+			    uint16_t *const next_ndp_idx)
+{
+	const struct cdc_ncm_ndp16 *ndp;
+	uint16_t ndp_len;
+	uint16_t count;
+
+	if ((ndp_idx % CDC_NCM_NDP_ALIGNMENT) ||
+	    ndp_idx < sizeof(struct cdc_ncm_nth16) ||
+	    ndp_idx + sizeof(struct cdc_ncm_ndp16) > block_len) {
+		LOG_WRN("Invalid NDP16 index %u", ndp_idx);
+		return -EINVAL;
+	}
+
+	ndp = (const void *)(buf->data + ndp_idx);
+	ndp_len = sys_le16_to_cpu(ndp->wLength);
+
+	if (sys_le32_to_cpu(ndp->dwSignature) != NCM_NDP16_SIGNATURE_NOCRC ||
+	    ndp_len < sizeof(struct cdc_ncm_ndp16) +
+		      2 * sizeof(struct cdc_ncm_ndp16_datagram) ||
+	    ndp_idx + ndp_len > block_len) {
+		LOG_WRN("Invalid NDP16 at %u", ndp_idx);
+		return -EINVAL;
+	}
+
+	count = (ndp_len - sizeof(struct cdc_ncm_ndp16)) /
+		sizeof(struct cdc_ncm_ndp16_datagram);
+
+	for (uint16_t i = 0; i < count; i++) {
+		uint16_t idx = sys_le16_to_cpu(ndp->datagram[i].wDatagramIndex);
+		uint16_t len = sys_le16_to_cpu(ndp->datagram[i].wDatagramLength);
+
+		/* Null entry terminates the table */
+		if (idx == 0 || len == 0) {
+			break;
+		}
+
+		if (len < sizeof(struct net_eth_hdr) || len > NET_ETH_MAX_FRAME_SIZE ||
+		    idx + len > block_len) {
+			LOG_WRN("Invalid datagram at %u length %u", idx, len);
+			continue;
+		}
+
+		cdc_ncm_rx_datagram(c_nd, buf, idx, len);
+	}
+
+	*next_ndp_idx = sys_le16_to_cpu(ndp->wNextNdpIndex);
+
+	return 0;
+}
+
+static void cdc_ncm_rx_ntb(struct usbd_class_node *const c_nd,
+			   struct net_buf *const buf)
+{
+	const struct cdc_ncm_nth16 *nth = (const void *)buf->data;
+	uint16_t block_len;
+	uint16_t ndp_idx;
+
+	if (buf->len < sizeof(struct cdc_ncm_nth16) ||
+	    sys_le32_to_cpu(nth->dwSignature) != NCM_NTH16_SIGNATURE ||
+	    sys_le16_to_cpu(nth->wHeaderLength) != sizeof(struct cdc_ncm_nth16)) {
+		LOG_WRN("Invalid NTH16");
+		return;
+	}
+
+	block_len = sys_le16_to_cpu(nth->wBlockLength);
+	if (block_len > buf->len) {
+		LOG_WRN("NTB block length %u larger than transfer %u",
+			block_len, buf->len);
+		return;
+	}
+
+	ndp_idx = sys_le16_to_cpu(nth->wNdpIndex);
+
+	/* An NTB can not hold more NDPs than that, stop on a loop */
+	for (uint16_t n = block_len / sizeof(struct cdc_ncm_ndp16);
+	     ndp_idx != 0 && n > 0; n--) {
+		if (cdc_ncm_rx_ndp16(c_nd, buf, block_len, ndp_idx, &ndp_idx)) {
+			return;
+		}
+	}
+}
+
+static int cdc_ncm_acl_out_cb(struct usbd_class_node *const c_nd,
+			      struct net_buf *const buf, const int err)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	if (!err && buf->len) {
+		cdc_ncm_rx_ntb(c_nd, buf);
+	}
+
+	net_buf_unref(buf);
+	atomic_dec(&data->rx_queued);
+
+	return cdc_ncm_out_start(c_nd);
+}
+
+static struct cdc_ncm_ndp16 *cdc_ncm_tx_ndp(struct net_buf *const ntb)
+{
+	return (void *)(ntb->data + CDC_NCM_IN_NDP_OFFSET);
+}
+
+/* Whether a datagram of len fits in the IN NTB that is being filled */
+static bool cdc_ncm_tx_fits(const struct cdc_ncm_eth_data *const data,
+			    const size_t len)
+{
+	return data->tx_count < CONFIG_USBD_CDC_NCM_MAX_DATAGRAMS &&
+	       ROUND_UP(data->tx_ntb->len, CDC_NCM_NDP_DIVISOR) + len <=
+	       data->ntb_in_size;
+}
+
+static int cdc_ncm_tx_append(struct cdc_ncm_eth_data *const data,
+			     struct net_pkt *const pkt, const size_t len)
+{
+	struct net_buf *ntb = data->tx_ntb;
+	struct cdc_ncm_ndp16 *ndp = cdc_ncm_tx_ndp(ntb);
+	const uint16_t offset = ROUND_UP(ntb->len, CDC_NCM_NDP_DIVISOR);
+
+	if (net_pkt_read(pkt, ntb->data + offset, len)) {
+		LOG_ERR("Failed copy net_pkt");
+		return -ENOBUFS;
+	}
+
+	/* Padding between the datagrams */
+	memset(net_buf_add(ntb, offset - ntb->len), 0, offset - ntb->len);
+	net_buf_add(ntb, len);
+
+	ndp->datagram[data->tx_count].wDatagramIndex = sys_cpu_to_le16(offset);
+	ndp->datagram[data->tx_count].wDatagramLength = sys_cpu_to_le16(len);
+	data->tx_count++;
+
+	return 0;
+}
+
+/* Queue the IN NTB that is being filled, a free slot has been taken */
+static void cdc_ncm_tx_flush(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct net_buf *ntb = data->tx_ntb;
+	struct cdc_ncm_ndp16 *ndp = cdc_ncm_tx_ndp(ntb);
+	struct cdc_ncm_nth16 *nth = (void *)ntb->data;
+	uint16_t bulk_mps;
+	int ret;
+
+	data->tx_ntb = NULL;
+
+	nth->dwSignature = sys_cpu_to_le32(NCM_NTH16_SIGNATURE);
+	nth->wHeaderLength = sys_cpu_to_le16(sizeof(struct cdc_ncm_nth16));
+	nth->wSequence = sys_cpu_to_le16(data->tx_seq++);
+	nth->wBlockLength = sys_cpu_to_le16(ntb->len);
+	nth->wNdpIndex = sys_cpu_to_le16(CDC_NCM_IN_NDP_OFFSET);
+
+	ndp->dwSignature = sys_cpu_to_le32(NCM_NDP16_SIGNATURE_NOCRC);
+	ndp->wLength = sys_cpu_to_le16(sizeof(struct cdc_ncm_ndp16) +
+				       (data->tx_count + 1) *
+				       sizeof(struct cdc_ncm_ndp16_datagram));
+	ndp->wNextNdpIndex = 0;
+	ndp->datagram[data->tx_count].wDatagramIndex = 0;
+	ndp->datagram[data->tx_count].wDatagramLength = 0;
+	data->tx_count = 0;
+
+	/*
+	 * REVISE: It should be more abstract and
+	 * not pull UDC stuff in the class code.
+	 */
+	if (udc_device_speed(c_nd->data->uds_ctx->dev) == UDC_BUS_SPEED_FS) {
+		bulk_mps = 64;
+	} else {
+		bulk_mps = 512;
+	}
+
+	/* The host reads up to ntb_in_size, a shorter NTB must be terminated */
+	if (!(ntb->len % bulk_mps) && ntb->len < data->ntb_in_size) {
+		udc_ep_buf_set_zlp(ntb);
+	}
+
+	ret = usbd_ep_enqueue(c_nd, ntb);
+	if (ret) {
+		LOG_ERR("Failed to enqueue net_buf for 0x%02x", cdc_ncm_get_bulk_in(c_nd));
+		net_buf_unref(ntb);
+		k_sem_give(&data->tx_sem);
+	}
+}
+
+static void cdc_ncm_tx_drop(struct cdc_ncm_eth_data *const data)
+{
+	if (data->tx_ntb != NULL) {
+		net_buf_unref(data->tx_ntb);
+		data->tx_ntb = NULL;
+		data->tx_count = 0;
+	}
+}
+
+static void cdc_ncm_acl_in_cb(struct usbd_class_node *const c_nd,
+			      struct net_buf *const buf)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	net_buf_unref(buf);
+	/* Given before locking, a sender may wait for it with the lock held */
+	k_sem_give(&data->tx_sem);
+
+	/* Queue the datagrams that were aggregated meanwhile */
+	k_mutex_lock(&data->tx_lock, K_FOREVER);
+	if (data->tx_ntb != NULL) {
+		if (!atomic_test_bit(&data->state, CDC_NCM_CLASS_ENABLED)) {
+			cdc_ncm_tx_drop(data);
+		} else if (k_sem_take(&data->tx_sem, K_NO_WAIT) == 0) {
+			cdc_ncm_tx_flush(c_nd);
+		}
+	}
+	k_mutex_unlock(&data->tx_lock);
+}
+
+static int usbd_cdc_ncm_request(struct usbd_class_node *const c_nd,
+				struct net_buf *buf, int err)
+{
+	struct usbd_contex *uds_ctx = c_nd->data->uds_ctx;
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct udc_buf_info *bi;
+
+	bi = udc_get_buf_info(buf);
+
+	if (bi->ep == cdc_ncm_get_bulk_out(c_nd)) {
+		return cdc_ncm_acl_out_cb(c_nd, buf, err);
+	}
+
+	if (bi->ep == cdc_ncm_get_bulk_in(c_nd)) {
+		cdc_ncm_acl_in_cb(c_nd, buf);
+
+		return 0;
+	}
+
+	if (bi->ep == cdc_ncm_get_int_in(c_nd)) {
+		k_sem_give(&data->notif_sem);
+
+		return 0;
+	}
+
+	return usbd_ep_buf_free(uds_ctx, buf);
+}
+
+static int cdc_ncm_send_notification(const struct device *dev,
+				     const bool connected)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct usbd_class_node *c_nd = data->c_nd;
+	struct cdc_ncm_notification notification = {
+		.RequestType = {
+			.direction = USB_REQTYPE_DIR_TO_HOST,
+			.type = USB_REQTYPE_TYPE_CLASS,
+			.recipient = USB_REQTYPE_RECIPIENT_INTERFACE,
+		},
+		.bNotificationType = USB_CDC_NETWORK_CONNECTION,
+		.wValue = sys_cpu_to_le16((uint16_t)connected),
+		.wIndex = sys_cpu_to_le16(cdc_ncm_get_ctrl_if(c_nd)),
+		.wLength = 0,
+	};
+	struct net_buf *buf;
+	uint8_t ep;
+	int ret;
+
+	if (!atomic_test_bit(&data->state, CDC_NCM_CLASS_ENABLED)) {
+		LOG_INF("USB configuration is not enabled");
+		return 0;
+	}
+
+	if (atomic_test_bit(&data->state, CDC_NCM_CLASS_SUSPENDED)) {
+		LOG_INF("USB device is suspended (FIXME)");
+		return 0;
+	}
+
+	ep = cdc_ncm_get_int_in(c_nd);
+	buf = usbd_ep_buf_alloc(c_nd, ep, sizeof(struct cdc_ncm_notification));
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	net_buf_add_mem(buf, &notification, sizeof(struct cdc_ncm_notification));
+	ret = usbd_ep_enqueue(c_nd, buf);
+	if (ret) {
+		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+		net_buf_unref(buf);
+		return ret;
+	}
+
+	k_sem_take(&data->notif_sem, K_FOREVER);
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+static void usbd_cdc_ncm_update(struct usbd_class_node *const c_nd,
+				const uint8_t iface, const uint8_t alternate)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+	const uint8_t data_iface = desc->if1_1.bInterfaceNumber;
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	LOG_INF("New configuration, interface %u alternate %u",
+		iface, alternate);
+
+	if (data_iface == iface && alternate == 0) {
+		net_if_carrier_off(data->iface);
+		/* NCM10.pdf, 7.2, the NTB parameters are reset */
+		data->ntb_in_size = CONFIG_USBD_CDC_NCM_NTB_SIZE;
+		data->tx_seq = 0;
+	}
+
+	if (data_iface == iface && alternate == 1) {
+		net_if_carrier_on(data->iface);
+		if (cdc_ncm_out_start(c_nd)) {
+			LOG_ERR("Failed to start OUT transfer");
+		}
+	}
+}
+
+static void usbd_cdc_ncm_enable(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	atomic_set_bit(&data->state, CDC_NCM_CLASS_ENABLED);
+	LOG_INF("Configuration enabled");
+}
+
+static void usbd_cdc_ncm_disable(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	if (atomic_test_and_clear_bit(&data->state, CDC_NCM_CLASS_ENABLED)) {
+		net_if_carrier_off(data->iface);
+	}
+
+	atomic_clear_bit(&data->state, CDC_NCM_CLASS_SUSPENDED);
+	LOG_INF("Configuration disabled");
+}
+
+static void usbd_cdc_ncm_suspended(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	atomic_set_bit(&data->state, CDC_NCM_CLASS_SUSPENDED);
+}
+
+static void usbd_cdc_ncm_resumed(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	atomic_clear_bit(&data->state, CDC_NCM_CLASS_SUSPENDED);
+}
+
+static int usbd_cdc_ncm_cth(struct usbd_class_node *const c_nd,
+			    const struct usb_setup_packet *const setup,
+			    struct net_buf *const buf)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct cdc_ncm_ntb_parameters params = {
+		.wLength = sys_cpu_to_le16(sizeof(struct cdc_ncm_ntb_parameters)),
+		.bmNtbFormatsSupported = sys_cpu_to_le16(NCM_NTB_FORMAT_16),
+		.dwNtbInMaxSize = sys_cpu_to_le32(CONFIG_USBD_CDC_NCM_NTB_SIZE),
+		.wNdpInDivisor = sys_cpu_to_le16(CDC_NCM_NDP_DIVISOR),
+		.wNdpInPayloadRemainder = 0,
+		.wNdpInAlignment = sys_cpu_to_le16(CDC_NCM_NDP_ALIGNMENT),
+		.dwNtbOutMaxSize = sys_cpu_to_le32(CONFIG_USBD_CDC_NCM_NTB_SIZE),
+		.wNdpOutDivisor = sys_cpu_to_le16(CDC_NCM_NDP_DIVISOR),
+		.wNdpOutPayloadRemainder = 0,
+		.wNdpOutAlignment = sys_cpu_to_le16(CDC_NCM_NDP_ALIGNMENT),
+		.wNtbOutMaxDatagrams = sys_cpu_to_le16(CONFIG_USBD_CDC_NCM_MAX_DATAGRAMS),
+	};
+	uint32_t ntb_in_size;
+
+	if (buf == NULL) {
+		errno = -ENOMEM;
+		return 0;
+	}
+
+	switch (setup->bRequest) {
+	case GET_NTB_PARAMETERS:
+		net_buf_add_mem(buf, &params, MIN(sizeof(params), setup->wLength));
+		return 0;
+	case GET_NTB_INPUT_SIZE:
+		ntb_in_size = sys_cpu_to_le32(data->ntb_in_size);
+		net_buf_add_mem(buf, &ntb_in_size,
+				MIN(sizeof(ntb_in_size), setup->wLength));
+		return 0;
+	case GET_NTB_FORMAT:
+		/* Only NTB16 is supported */
+		net_buf_add_le16(buf, 0);
+		return 0;
+	default:
+		break;
+	}
+
+	LOG_DBG("bmRequestType 0x%02x bRequest 0x%02x unsupported",
+		setup->bmRequestType, setup->bRequest);
+	errno = -ENOTSUP;
+
+	return 0;
+}
+
+static int usbd_cdc_ncm_ctd(struct usbd_class_node *const c_nd,
+			    const struct usb_setup_packet *const setup,
+			    const struct net_buf *const buf)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	uint32_t ntb_in_size;
+
+	switch (setup->bRequest) {
+	case SET_ETHERNET_PACKET_FILTER:
+		LOG_INF("bRequest 0x%02x (SetPacketFilter) not implemented",
+			setup->bRequest);
+		return 0;
+	case SET_NTB_FORMAT:
+		if (setup->wValue == 0) {
+			return 0;
+		}
+
+		break;
+	case SET_NTB_INPUT_SIZE:
+		if (setup->wLength != sizeof(ntb_in_size)) {
+			break;
+		}
+
+		ntb_in_size = sys_get_le32(buf->data);
+		if (ntb_in_size < CDC_NCM_NTB_MIN_SIZE ||
+		    ntb_in_size > CONFIG_USBD_CDC_NCM_NTB_SIZE) {
+			LOG_WRN("Unsupported NTB input size %u", ntb_in_size);
+			break;
+		}
+
+		data->ntb_in_size = ntb_in_size;
+		return 0;
+	default:
+		break;
+	}
+
+	LOG_DBG("bmRequestType 0x%02x bRequest 0x%02x unsupported",
+		setup->bmRequestType, setup->bRequest);
+	errno = -ENOTSUP;
+
+	return 0;
+}
+
+static int usbd_cdc_ncm_init(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+	const uint8_t if_num = desc->if0.bInterfaceNumber;
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *const data = dev->data;
+
+	/* Update relevant b*Interface fields */
+	desc->iad.bFirstInterface = if_num;
+	desc->if0_union.bControlInterface = if_num;
+	desc->if0_union.bSubordinateInterface0 = if_num + 1;
+	LOG_DBG("CDC NCM class initialized");
+
+	if (usbd_add_descriptor(c_nd->data->uds_ctx, data->mac_desc_nd)) {
+		LOG_ERR("Failed to add iMACAddress string descriptor");
+	} else {
+		desc->if0_ecm.iMACAddress = data->mac_desc_nd->idx;
+	}
+
+	return 0;
+}
+
+static void usbd_cdc_ncm_shutdown(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *const data = dev->data;
+
+	desc->if0_ecm.iMACAddress = 0;
+	sys_dlist_remove(&data->mac_desc_nd->node);
+}
+
+static int cdc_ncm_send(const struct device *dev, struct net_pkt *const pkt)
+{
+	struct cdc_ncm_eth_data *const data = dev->data;
+	struct usbd_class_node *c_nd = data->c_nd;
+	size_t len = net_pkt_get_len(pkt);
+	int ret;
+
+	if (len > NET_ETH_MAX_FRAME_SIZE) {
+		LOG_WRN("Trying to send too large packet, drop");
+		return -ENOMEM;
+	}
+
+	if (!atomic_test_bit(&data->state, CDC_NCM_CLASS_ENABLED) ||
+	    !atomic_test_bit(&data->state, CDC_NCM_IFACE_UP)) {
+		LOG_INF("Configuration is not enabled or interface not ready");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&data->tx_lock, K_FOREVER);
+
+	if (data->tx_ntb != NULL && !cdc_ncm_tx_fits(data, len)) {
+		/* The NTB is full, wait for a free slot to queue it */
+		k_sem_take(&data->tx_sem, K_FOREVER);
+		cdc_ncm_tx_flush(c_nd);
+	}
+
+	if (data->tx_ntb == NULL) {
+		data->tx_ntb = cdc_ncm_buf_alloc(&cdc_ncm_tx_pool,
+						 cdc_ncm_get_bulk_in(c_nd));
+		if (data->tx_ntb == NULL) {
+			LOG_ERR("Failed to allocate buffer");
+			k_mutex_unlock(&data->tx_lock);
+			return -ENOMEM;
+		}
+
+		/* The headers are written when the NTB is queued */
+		net_buf_add(data->tx_ntb, CDC_NCM_IN_PAYLOAD_OFFSET);
+	}
+
+	ret = cdc_ncm_tx_append(data, pkt, len);
+	if (ret && data->tx_count == 0) {
+		cdc_ncm_tx_drop(data);
+	}
+
+	/*
+	 * Queue the NTB right away if there is a free slot, otherwise the
+	 * next datagrams are aggregated until a previous NTB is completed.
+	 */
+	if (data->tx_ntb != NULL && k_sem_take(&data->tx_sem, K_NO_WAIT) == 0) {
+		cdc_ncm_tx_flush(c_nd);
+	}
+
+	k_mutex_unlock(&data->tx_lock);
+
+	return ret;
+}
+
+static int cdc_ncm_set_config(const struct device *dev,
+			      const enum ethernet_config_type type,
+			      const struct ethernet_config *config)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	if (type == ETHERNET_CONFIG_TYPE_MAC_ADDRESS) {
+		memcpy(data->mac_addr, config->mac_address.addr,
+		       sizeof(data->mac_addr));
+
+		return 0;
+	}
+
+	return -ENOTSUP;
+}
+
+static int cdc_ncm_get_config(const struct device *dev,
+			      enum ethernet_config_type type,
+			      struct ethernet_config *config)
+{
+	return -ENOTSUP;
+}
+
+static enum ethernet_hw_caps cdc_ncm_get_capabilities(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return ETHERNET_LINK_10BASE_T;
+}
+
+static int cdc_ncm_iface_start(const struct device *dev)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+	int ret;
+
+	LOG_DBG("Start interface %p", data->iface);
+	ret = cdc_ncm_send_notification(dev, true);
+	if (!ret) {
+		atomic_set_bit(&data->state, CDC_NCM_IFACE_UP);
+	}
+
+	return ret;
+}
+
+static int cdc_ncm_iface_stop(const struct device *dev)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+	int ret;
+
+	LOG_DBG("Stop interface %p", data->iface);
+	ret = cdc_ncm_send_notification(dev, false);
+	if (!ret) {
+		atomic_clear_bit(&data->state, CDC_NCM_IFACE_UP);
+	}
+
+	return ret;
+}
+
+static void cdc_ncm_iface_init(struct net_if *const iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	data->iface = iface;
+	ethernet_init(iface);
+	net_if_set_link_addr(iface, data->mac_addr,
+			     sizeof(data->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	net_if_carrier_off(iface);
+
+	LOG_DBG("CDC NCM interface initialized");
+}
+
+static int usbd_cdc_ncm_preinit(const struct device *dev)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	if (sys_get_le48(data->mac_addr) == sys_cpu_to_le48(0)) {
+		gen_random_mac(data->mac_addr, 0, 0, 0);
+	}
+
+	LOG_DBG("CDC NCM device initialized");
+
+	return 0;
+}
+
+static struct usbd_class_api usbd_cdc_ncm_api = {
+	.request = usbd_cdc_ncm_request,
+	.update = usbd_cdc_ncm_update,
+	.enable = usbd_cdc_ncm_enable,
+	.disable = usbd_cdc_ncm_disable,
+	.suspended = usbd_cdc_ncm_suspended,
+	.resumed = usbd_cdc_ncm_resumed,
+	.control_to_host = usbd_cdc_ncm_cth,
+	.control_to_dev = usbd_cdc_ncm_ctd,
+	.init = usbd_cdc_ncm_init,
+	.shutdown = usbd_cdc_ncm_shutdown,
+};
+
+static const struct ethernet_api cdc_ncm_eth_api = {
+	.iface_api.init = cdc_ncm_iface_init,
+	.get_config = cdc_ncm_get_config,
+	.set_config = cdc_ncm_set_config,
+	.get_capabilities = cdc_ncm_get_capabilities,
+	.send = cdc_ncm_send,
+	.start = cdc_ncm_iface_start,
+	.stop = cdc_ncm_iface_stop,
+};
+
+#define CDC_NCM_DEFINE_DESCRIPTOR(n)						\
+static struct usbd_cdc_ncm_desc cdc_ncm_desc_##n = {				\
+	.iad = {								\
+		.bLength = sizeof(struct usb_association_descriptor),		\
+		.bDescriptorType = USB_DESC_INTERFACE_ASSOC,			\
+		.bFirstInterface = 0,						\
+		.bInterfaceCount = 0x02,					\
+		.bFunctionClass = USB_BCC_CDC_CONTROL,				\
+		.bFunctionSubClass = NCM_SUBCLASS,				\
+		.bFunctionProtocol = 0,						\
+		.iFunction = 0,							\
+	},									\
+										\
+	.if0 = {								\
+		.bLength = sizeof(struct usb_if_descriptor),			\
+		.bDescriptorType = USB_DESC_INTERFACE,				\
+		.bInterfaceNumber = 0,						\
+		.bAlternateSetting = 0,						\
+		.bNumEndpoints = 1,						\
+		.bInterfaceClass = USB_BCC_CDC_CONTROL,				\
+		.bInterfaceSubClass = NCM_SUBCLASS,				\
+		.bInterfaceProtocol = 0,					\
+		.iInterface = 0,						\
+	},									\
+										\
+	.if0_header = {								\
+		.bFunctionLength = sizeof(struct cdc_header_descriptor),	\
+		.bDescriptorType = USB_DESC_CS_INTERFACE,			\
+		.bDescriptorSubtype = HEADER_FUNC_DESC,				\
+		.bcdCDC = sys_cpu_to_le16(USB_SRN_1_1),				\
+	},									\
+										\
+	.if0_union = {								\
+		.bFunctionLength = sizeof(struct cdc_union_descriptor),		\
+		.bDescriptorType = USB_DESC_CS_INTERFACE,			\
+		.bDescriptorSubtype = UNION_FUNC_DESC,				\
+		.bControlInterface = 0,						\
+		.bSubordinateInterface0 = 1,					\
+	},									\
+										\
+	.if0_ecm = {								\
+		.bFunctionLength = sizeof(struct cdc_ecm_descriptor),		\
+		.bDescriptorType = USB_DESC_CS_INTERFACE,			\
+		.bDescriptorSubtype = ETHERNET_FUNC_DESC,			\
+		.iMACAddress = 0,						\
+		.bmEthernetStatistics = sys_cpu_to_le32(0),			\
+		.wMaxSegmentSize = sys_cpu_to_le16(NET_ETH_MAX_FRAME_SIZE),	\
+		.wNumberMCFilters = sys_cpu_to_le16(0),				\
+		.bNumberPowerFilters = 0,					\
+	},									\
+										\
+	.if0_ncm = {								\
+		.bFunctionLength = sizeof(struct cdc_ncm_descriptor),		\
+		.bDescriptorType = USB_DESC_CS_INTERFACE,			\
+		.bDescriptorSubtype = NCM_FUNC_DESC,				\
+		.bcdNcmVersion = sys_cpu_to_le16(0x0100),			\
+		.bmNetworkCapabilities = 0,					\
+	},									\
+										\
+	.if0_int_ep = {								\
+		.bLength = sizeof(struct usb_ep_descriptor),			\
+		.bDescriptorType = USB_DESC_ENDPOINT,				\
+		.bEndpointAddress = 0x81,					\
+		.bmAttributes = USB_EP_TYPE_INTERRUPT,				\
+		.wMaxPacketSize = sys_cpu_to_le16(CDC_NCM_EP_MPS_INT),		\
+		.bInterval = CDC_NCM_EP_INTERVAL_INT,				\
+	},									\
+										\
+	.if1_0 = {								\
+		.bLength = sizeof(struct usb_if_descriptor),			\
+		.bDescriptorType = USB_DESC_INTERFACE,				\
+		.bInterfaceNumber = 1,						\
+		.bAlternateSetting = 0,						\
+		.bNumEndpoints = 0,						\
+		.bInterfaceClass = USB_BCC_CDC_DATA,				\
+		.bInterfaceSubClass = 0,					\
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,			\
+		.iInterface = 0,						\
+	},									\
+										\
+	.if1_1 = {								\
+		.bLength = sizeof(struct usb_if_descriptor),			\
+		.bDescriptorType = USB_DESC_INTERFACE,				\
+		.bInterfaceNumber = 1,						\
+		.bAlternateSetting = 1,						\
+		.bNumEndpoints = 2,						\
+		.bInterfaceClass = USB_BCC_CDC_DATA,				\
+		.bInterfaceSubClass = 0,					\
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,			\
+		.iInterface = 0,						\
+	},									\
+										\
+	.if1_1_in_ep = {							\
+		.bLength = sizeof(struct usb_ep_descriptor),			\
+		.bDescriptorType = USB_DESC_ENDPOINT,				\
+		.bEndpointAddress = 0x82,					\
+		.bmAttributes = USB_EP_TYPE_BULK,				\
+		.wMaxPacketSize = sys_cpu_to_le16(CDC_NCM_EP_MPS_BULK),		\
+		.bInterval = 0,							\
+	},									\
+										\
+	.if1_1_out_ep = {							\
+		.bLength = sizeof(struct usb_ep_descriptor),			\
+		.bDescriptorType = USB_DESC_ENDPOINT,				\
+		.bEndpointAddress = 0x01,					\
+		.bmAttributes = USB_EP_TYPE_BULK,				\
+		.wMaxPacketSize = sys_cpu_to_le16(CDC_NCM_EP_MPS_BULK),		\
+		.bInterval = 0,							\
+	},									\
+										\
+	.nil_desc = {								\
+		.bLength = 0,							\
+		.bDescriptorType = 0,						\
+	},									\
+}
+
+#define USBD_CDC_NCM_DT_DEVICE_DEFINE(n)					\
+	CDC_NCM_DEFINE_DESCRIPTOR(n);						\
+	USBD_DESC_STRING_DEFINE(mac_desc_nd_##n,				\
+				DT_INST_PROP(n, remote_mac_address),		\
+				USBD_DUT_STRING_INTERFACE);			\
+										\
+	static struct usbd_class_data usbd_cdc_ncm_data_##n;			\
+										\
+	USBD_DEFINE_CLASS(cdc_ncm_##n,						\
+			  &usbd_cdc_ncm_api,					\
+			  &usbd_cdc_ncm_data_##n);				\
+										\
+	static struct cdc_ncm_eth_data eth_data_##n = {				\
+		.c_nd = &cdc_ncm_##n,						\
+		.mac_addr = DT_INST_PROP_OR(n, local_mac_address, {0}),		\
+		.tx_lock = Z_MUTEX_INITIALIZER(eth_data_##n.tx_lock),		\
+		.tx_sem = Z_SEM_INITIALIZER(eth_data_##n.tx_sem,		\
+			CONFIG_USBD_CDC_NCM_TX_QUEUE_DEPTH,		\
+			CONFIG_USBD_CDC_NCM_TX_QUEUE_DEPTH),		\
+		.ntb_in_size = CONFIG_USBD_CDC_NCM_NTB_SIZE,			\
+		.notif_sem = Z_SEM_INITIALIZER(eth_data_##n.notif_sem, 0, 1),	\
+		IF_ENABLED(CONFIG_USBD_CDC_NCM_RX_ZERO_COPY, (			\
+			.rx_work = Z_WORK_INITIALIZER(cdc_ncm_rx_work_handler),	\
+		))								\
+		.mac_desc_nd = &mac_desc_nd_##n,				\
+	};									\
+										\
+	static struct usbd_class_data usbd_cdc_ncm_data_##n = {			\
+		.desc = (struct usb_desc_header *)&cdc_ncm_desc_##n,		\
+		.priv = (void *)DEVICE_DT_GET(DT_DRV_INST(n)),			\
+	};									\
+										\
+	ETH_NET_DEVICE_DT_INST_DEFINE(n, usbd_cdc_ncm_preinit, NULL,		\
+		&eth_data_##n, NULL,						\
+		CONFIG_ETH_INIT_PRIORITY,					\
+		&cdc_ncm_eth_api,						\
+		NET_ETH_MTU);
+
+DT_INST_FOREACH_STATUS_OKAY(USBD_CDC_NCM_DT_DEVICE_DEFINE);
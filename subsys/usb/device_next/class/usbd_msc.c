@@ -71,9 +71,24 @@ struct CSW {
 /* Can be 64 if device is not High-Speed capable */
 #define MSC_BUF_SIZE 512
 
+/* Number of data transfers queued on each endpoint */
+#if defined(CONFIG_USBD_MSC_DOUBLE_BUFFERING)
+#define MSC_QUEUE_DEPTH 2
+#else
+#define MSC_QUEUE_DEPTH 1
+#endif
+
 NET_BUF_POOL_FIXED_DEFINE(msc_ep_pool,
-			  MSC_NUM_INSTANCES * 2, MSC_BUF_SIZE,
+			  MSC_NUM_INSTANCES * (MSC_QUEUE_DEPTH + 1), MSC_BUF_SIZE,
+			  sizeof(struct udc_buf_info), NULL);
+
+#if defined(CONFIG_USBD_MSC_DOUBLE_BUFFERING)
+/* Data IN buffers, the SCSI layer reads the sectors directly into them */
+NET_BUF_POOL_FIXED_DEFINE(msc_data_pool,
+			  MSC_NUM_INSTANCES * MSC_QUEUE_DEPTH,
+			  CONFIG_USBD_MSC_SCSI_BUFFER_SIZE,
 			  sizeof(struct udc_buf_info), NULL);
+#endif
 
 struct msc_event {
 	struct usbd_class_node *node;
@@ -85,7 +100,8 @@ struct msc_event {
 };
 
 /* Each instance has 2 endpoints and can receive bulk only reset command */
-K_MSGQ_DEFINE(msc_msgq, sizeof(struct msc_event), MSC_NUM_INSTANCES * 3, 4);
+K_MSGQ_DEFINE(msc_msgq, sizeof(struct msc_event),
+	      MSC_NUM_INSTANCES * (2 * MSC_QUEUE_DEPTH + 1), 4);
 
 /* Make supported vendor request visible for the device stack */
 static const struct usbd_cctx_vendor_req msc_bot_vregs =
@@ -100,8 +116,6 @@ struct msc_bot_desc {
 
 enum {
 	MSC_CLASS_ENABLED,
-	MSC_BULK_OUT_QUEUED,
-	MSC_BULK_IN_QUEUED,
 	MSC_BULK_IN_WEDGED,
 	MSC_BULK_OUT_WEDGED,
 };
@@ -128,14 +142,18 @@ struct msc_bot_ctx {
 	uint32_t transferred_data;
 	size_t scsi_offset;
 	size_t scsi_bytes;
+	/* Transfers queued on the endpoints, only used by the MSC thread */
+	uint8_t out_queued;
+	uint8_t in_queued;
 };
 
-static struct net_buf *msc_buf_alloc(const uint8_t ep)
+static struct net_buf *msc_pool_buf_alloc(struct net_buf_pool *const pool,
+					  const uint8_t ep)
 {
 	struct net_buf *buf = NULL;
 	struct udc_buf_info *bi;
 
-	buf = net_buf_alloc(&msc_ep_pool, K_NO_WAIT);
+	buf = net_buf_alloc(pool, K_NO_WAIT);
 	if (!buf) {
 		return NULL;
 	}
@@ -147,6 +165,11 @@ static struct net_buf *msc_buf_alloc(const uint8_t ep)
 	return buf;
 }
 
+static struct net_buf *msc_buf_alloc(const uint8_t ep)
+{
+	return msc_pool_buf_alloc(&msc_ep_pool, ep);
+}
+
 static uint8_t msc_get_bulk_in(struct usbd_class_node *const node)
 {
 	struct msc_bot_desc *desc = node->data->desc;
@@ -161,6 +184,13 @@ static uint8_t msc_get_bulk_out(struct usbd_class_node *const node)
 	return desc->if0_out_ep.bEndpointAddress;
 }
 
+/* Whether the host has data to send that no queued OUT transfer is for */
+static bool msc_expects_more_out(struct msc_bot_ctx *const ctx)
+{
+	return ctx->transferred_data + ctx->out_queued * MSC_BUF_SIZE <
+	       ctx->cbw.dCBWDataTransferLength;
+}
+
 static void msc_queue_bulk_out_ep(struct usbd_class_node *const node)
 {
 	struct msc_bot_ctx *ctx = node->data->priv;
@@ -168,24 +198,28 @@ static void msc_queue_bulk_out_ep(struct usbd_class_node *const node)
 	uint8_t ep;
 	int ret;
 
-	if (atomic_test_and_set_bit(&ctx->bits, MSC_BULK_OUT_QUEUED)) {
-		/* Already queued */
-		return;
-	}
-
-	LOG_DBG("Queuing OUT");
-	ep = msc_get_bulk_out(node);
-	buf = msc_buf_alloc(ep);
-	/* The pool is large enough to support all allocations. Failing alloc
-	 * indicates either a memory leak or logic error.
+	/* The next data OUT transfer is received while the current one is
+	 * written to the disk, there is a single CBW to receive.
 	 */
-	__ASSERT_NO_MSG(buf);
+	while (ctx->out_queued == 0 ||
+	       (ctx->state == MSC_BBB_PROCESS_WRITE &&
+		ctx->out_queued < MSC_QUEUE_DEPTH && msc_expects_more_out(ctx))) {
+		LOG_DBG("Queuing OUT");
+		ep = msc_get_bulk_out(node);
+		buf = msc_buf_alloc(ep);
+		/* The pool is large enough to support all allocations. Failing
+		 * alloc indicates either a memory leak or logic error.
+		 */
+		__ASSERT_NO_MSG(buf);
 
-	ret = usbd_ep_enqueue(node, buf);
-	if (ret) {
-		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
-		net_buf_unref(buf);
-		atomic_clear_bit(&ctx->bits, MSC_BULK_OUT_QUEUED);
+		ret = usbd_ep_enqueue(node, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			net_buf_unref(buf);
+			return;
+		}
+
+		ctx->out_queued++;
 	}
 }
 
@@ -240,6 +274,80 @@ static bool is_cbw_meaningful(struct msc_bot_ctx *const ctx)
 	return true;
 }
 
+/* All the data of the read command has been sent */
+static void msc_read_done(struct msc_bot_ctx *ctx)
+{
+	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
+
+	if (ctx->csw.dCSWDataResidue > 0) {
+		/* Case (5) Hi > Di
+		 * While we may have sent short packet, device
+		 * shall STALL the Bulk-In pipe (if it does not
+		 * send padding data).
+		 */
+		msc_stall_bulk_in_ep(ctx->class_node);
+	}
+	if (scsi_cmd_get_status(lun) == GOOD) {
+		ctx->csw.bCSWStatus = CSW_STATUS_COMMAND_PASSED;
+	} else {
+		ctx->csw.bCSWStatus = CSW_STATUS_COMMAND_FAILED;
+	}
+	ctx->state = MSC_BBB_SEND_CSW;
+}
+
+#if defined(CONFIG_USBD_MSC_DOUBLE_BUFFERING)
+/*
+ * Queue up to MSC_QUEUE_DEPTH data IN transfers, the sectors of the next one
+ * are read from the disk while the previous one is on the bus.
+ */
+static void msc_process_read(struct msc_bot_ctx *ctx)
+{
+	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
+	struct net_buf *buf;
+	uint8_t ep;
+	int ret;
+
+	ep = msc_get_bulk_in(ctx->class_node);
+
+	while (ctx->in_queued < MSC_QUEUE_DEPTH) {
+		buf = msc_pool_buf_alloc(&msc_data_pool, ep);
+		/* The pool is large enough to support all allocations. Failing
+		 * alloc indicates either a memory leak or logic error.
+		 */
+		__ASSERT_NO_MSG(buf);
+
+		if (ctx->scsi_bytes > ctx->scsi_offset) {
+			/* Data the command put in the SCSI buffer */
+			net_buf_add_mem(buf, &ctx->scsi_buf[ctx->scsi_offset],
+					ctx->scsi_bytes - ctx->scsi_offset);
+			ctx->scsi_bytes = 0;
+			ctx->scsi_offset = 0;
+		} else if (scsi_cmd_remaining_data_len(lun) > 0) {
+			net_buf_add(buf, scsi_read_data(lun, buf->data));
+		}
+
+		if (buf->len == 0) {
+			net_buf_unref(buf);
+			break;
+		}
+
+		ctx->csw.dCSWDataResidue -= buf->len;
+		ret = usbd_ep_enqueue(ctx->class_node, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			net_buf_unref(buf);
+			break;
+		}
+
+		ctx->in_queued++;
+	}
+
+	if (ctx->in_queued == 0) {
+		/* No data could be read at all */
+		msc_read_done(ctx);
+	}
+}
+#else
 static void msc_process_read(struct msc_bot_ctx *ctx)
 {
 	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
@@ -255,12 +363,6 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 		ctx->scsi_offset = 0;
 	}
 
-	if (atomic_test_and_set_bit(&ctx->bits, MSC_BULK_IN_QUEUED)) {
-		__ASSERT_NO_MSG(false);
-		LOG_ERR("IN already queued");
-		return;
-	}
-
 	ep = msc_get_bulk_in(ctx->class_node);
 	buf = msc_buf_alloc(ep);
 	/* The pool is large enough to support all allocations. Failing alloc
@@ -295,9 +397,12 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 	if (ret) {
 		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
 		net_buf_unref(buf);
-		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
+		return;
 	}
+
+	ctx->in_queued++;
 }
+#endif /* CONFIG_USBD_MSC_DOUBLE_BUFFERING */
 
 static void msc_process_cbw(struct msc_bot_ctx *ctx)
 {
@@ -504,21 +609,9 @@ static void msc_handle_bulk_in(struct msc_bot_ctx *ctx,
 		struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
 
 		ctx->transferred_data += len;
-		if (ctx->scsi_bytes == 0) {
-			if (ctx->csw.dCSWDataResidue > 0) {
-				/* Case (5) Hi > Di
-				 * While we may have sent short packet, device
-				 * shall STALL the Bulk-In pipe (if it does not
-				 * send padding data).
-				 */
-				msc_stall_bulk_in_ep(ctx->class_node);
-			}
-			if (scsi_cmd_get_status(lun) == GOOD) {
-				ctx->csw.bCSWStatus = CSW_STATUS_COMMAND_PASSED;
-			} else {
-				ctx->csw.bCSWStatus = CSW_STATUS_COMMAND_FAILED;
-			}
-			ctx->state = MSC_BBB_SEND_CSW;
+		if (ctx->in_queued == 0 && ctx->scsi_bytes == 0 &&
+		    scsi_cmd_remaining_data_len(lun) == 0) {
+			msc_read_done(ctx);
 		}
 	}
 }
@@ -529,7 +622,7 @@ static void msc_send_csw(struct msc_bot_ctx *ctx)
 	uint8_t ep;
 	int ret;
 
-	if (atomic_test_and_set_bit(&ctx->bits, MSC_BULK_IN_QUEUED)) {
+	if (ctx->in_queued > 0) {
 		__ASSERT_NO_MSG(false);
 		LOG_ERR("IN already queued");
 		return;
@@ -549,7 +642,8 @@ static void msc_send_csw(struct msc_bot_ctx *ctx)
 	if (ret) {
 		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
 		net_buf_unref(buf);
-		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
+	} else {
+		ctx->in_queued++;
 	}
 	ctx->state = MSC_BBB_WAIT_FOR_CSW_SENT;
 }
@@ -562,6 +656,12 @@ static void usbd_msc_handle_request(struct usbd_class_node *node,
 	struct udc_buf_info *bi;
 
 	bi = udc_get_buf_info(buf);
+	if (bi->ep == msc_get_bulk_out(node)) {
+		ctx->out_queued--;
+	} else if (bi->ep == msc_get_bulk_in(node)) {
+		ctx->in_queued--;
+	}
+
 	if (err) {
 		if (err == -ECONNABORTED) {
 			LOG_WRN("request ep 0x%02x, len %u cancelled",
@@ -581,11 +681,6 @@ static void usbd_msc_handle_request(struct usbd_class_node *node,
 	}
 
 ep_request_error:
-	if (bi->ep == msc_get_bulk_out(node)) {
-		atomic_clear_bit(&ctx->bits, MSC_BULK_OUT_QUEUED);
-	} else if (bi->ep == msc_get_bulk_in(node)) {
-		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
-	}
 	usbd_ep_buf_free(uds_ctx, buf);
 }
 
@@ -622,9 +717,11 @@ static void usbd_msc_thread(void *arg1, void *arg2, void *arg3)
 		}
 
 		/* Skip (potentially) response generating code if there is
-		 * IN data already available for the host to pick up.
+		 * IN data already available for the host to pick up, unless
+		 * more read data can be queued behind it.
 		 */
-		if (atomic_test_bit(&ctx->bits, MSC_BULK_IN_QUEUED)) {
+		if (ctx->in_queued >= MSC_QUEUE_DEPTH ||
+		    (ctx->in_queued > 0 && ctx->state != MSC_BBB_PROCESS_READ)) {
 			continue;
 		}
 
@@ -636,7 +733,10 @@ static void usbd_msc_thread(void *arg1, void *arg2, void *arg3)
 			msc_process_read(ctx);
 		} else if (ctx->state == MSC_BBB_PROCESS_WRITE) {
 			msc_queue_bulk_out_ep(evt.node);
-		} else if (ctx->state == MSC_BBB_SEND_CSW) {
+		}
+
+		/* A read that could not get any data is done right away */
+		if (ctx->state == MSC_BBB_SEND_CSW) {
 			msc_send_csw(ctx);
 		}
 	}
@@ -0,0 +1,706 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * USB Mass Storage Bulk-Only Transport host class. The stages of the
+ * commands, CBW, data and CSW, are queued to the controller as bulk
+ * transfers up to CONFIG_USBH_MSC_XFER_COUNT ahead, across the command
+ * boundaries, so that a large disk access keeps the bus busy while the
+ * completed transfers are handled.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/disk.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/usb/usbh.h>
+#include <zephyr/usb/usb_ch9.h>
+
+#include "usbh_ch9.h"
+#include "usbh_device.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(usbh_msc, CONFIG_USBH_MSC_LOG_LEVEL);
+
+/* Each completion is passed through the UHC event queue of the host stack */
+BUILD_ASSERT(CONFIG_USBH_MSC_XFER_COUNT <= CONFIG_USBH_MAX_UHC_MSG,
+	     "More bulk transfers in flight than UHC events can be queued");
+
+#define MSC_SUBCLASS_SCSI		0x06
+#define MSC_PROTOCOL_BBB		0x50
+#define MSC_REQ_BOMSR			0xFF
+
+#define MSC_CBW_SIGNATURE		0x43425355
+#define MSC_CSW_SIGNATURE		0x53425355
+#define MSC_CBW_LEN			31
+#define MSC_CSW_LEN			13
+#define MSC_CBW_FLAG_IN			BIT(7)
+#define MSC_CSW_STATUS_PASSED		0x00
+#define MSC_CSW_STATUS_FAILED		0x01
+
+#define SCSI_TEST_UNIT_READY		0x00
+#define SCSI_REQUEST_SENSE		0x03
+#define SCSI_READ_CAPACITY_10		0x25
+#define SCSI_READ_10			0x28
+#define SCSI_WRITE_10			0x2A
+#define SCSI_SENSE_LEN			18
+#define SCSI_CAPACITY_LEN		8
+
+/* Same upper limit as for the standard requests, in milliseconds */
+#define MSC_XFER_TIMEOUT		5000U
+#define MSC_READY_RETRIES		5
+
+enum msc_stage {
+	MSC_STAGE_CBW,
+	MSC_STAGE_DATA,
+	MSC_STAGE_CSW,
+};
+
+/* Bulk transfer queued to the controller */
+struct msc_step {
+	struct uhc_transfer *xfer;
+	/* Data of a data stage */
+	uint8_t *data;
+	/* Length of a data stage */
+	size_t len;
+	/* Tag of the command of a status stage */
+	uint32_t tag;
+	/* A short data IN stage is an error */
+	bool exact;
+	enum msc_stage stage;
+};
+
+/* Commands of a disk access, or a single other command */
+struct msc_job {
+	uint8_t cdb[16];
+	uint8_t cdb_len;
+	bool in;
+	uint8_t *data;
+	size_t len;
+	/* Data length of each command */
+	size_t cmd_len;
+	/* Block size of READ(10) and WRITE(10), 0 for the other commands */
+	uint32_t block_size;
+	uint32_t lba;
+	/* Submission cursor: data offset of the command, of its stage */
+	size_t off;
+	size_t cmd_off;
+	size_t cmds_left;
+	uint32_t tag;
+	enum msc_stage next;
+};
+
+struct usbh_msc {
+	struct disk_info info;
+	struct k_mutex lock;
+	struct usb_device *udev;
+	/* Ring of the transfers in flight, in the order they were queued */
+	struct msc_step steps[CONFIG_USBH_MSC_XFER_COUNT];
+	size_t head;
+	size_t count;
+	uint32_t tag;
+	uint32_t block_count;
+	uint32_t block_size;
+	uint16_t mps_in;
+	uint16_t mps_out;
+	uint8_t ep_in;
+	uint8_t ep_out;
+	uint8_t iface;
+	atomic_t attached;
+	bool registered;
+};
+
+K_MSGQ_DEFINE(msc_done_msgq, sizeof(struct uhc_transfer *),
+	      CONFIG_USBH_MSC_XFER_COUNT, sizeof(void *));
+
+static int msc_xfer_cb(struct usb_device *const udev,
+		       struct uhc_transfer *const xfer)
+{
+	return k_msgq_put(&msc_done_msgq, &xfer, K_NO_WAIT);
+}
+
+static void msc_put_cbw(struct net_buf *const buf,
+			const struct msc_job *const job,
+			const size_t cmd_len)
+{
+	uint8_t cdb[sizeof(job->cdb)];
+
+	memcpy(cdb, job->cdb, sizeof(cdb));
+	if (job->block_size != 0) {
+		sys_put_be32(job->lba + job->off / job->block_size, &cdb[2]);
+		sys_put_be16(cmd_len / job->block_size, &cdb[7]);
+	}
+
+	net_buf_add_le32(buf, MSC_CBW_SIGNATURE);
+	net_buf_add_le32(buf, job->tag);
+	net_buf_add_le32(buf, cmd_len);
+	net_buf_add_u8(buf, job->in ? MSC_CBW_FLAG_IN : 0);
+	net_buf_add_u8(buf, 0);
+	net_buf_add_u8(buf, job->cdb_len);
+	net_buf_add_mem(buf, cdb, sizeof(cdb));
+}
+
+/* Queue the next stage of the job, -ENOMEM if out of transfers or buffers */
+static int msc_submit(struct usbh_msc *const msc, struct msc_job *const job)
+{
+	struct msc_step *step = &msc->steps[(msc->head + msc->count) % ARRAY_SIZE(msc->steps)];
+	size_t cmd_len = MIN(job->cmd_len, job->len - job->off);
+	uint8_t ep = msc->ep_in;
+	uint16_t mps = msc->mps_in;
+	struct uhc_transfer *xfer;
+	struct net_buf *buf;
+	size_t len;
+
+	switch (job->next) {
+	case MSC_STAGE_CBW:
+		len = MSC_CBW_LEN;
+		break;
+	case MSC_STAGE_DATA:
+		len = MIN(CONFIG_USBH_MSC_XFER_SIZE, cmd_len - job->cmd_off);
+		break;
+	default:
+		len = MSC_CSW_LEN;
+		break;
+	}
+
+	if (job->next == MSC_STAGE_CBW || (job->next == MSC_STAGE_DATA && !job->in)) {
+		ep = msc->ep_out;
+		mps = msc->mps_out;
+	}
+
+	buf = usbh_xfer_buf_alloc(msc->udev, len);
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	xfer = usbh_xfer_alloc(msc->udev, ep, USB_EP_TYPE_BULK, mps,
+			       MSC_XFER_TIMEOUT, (void *)msc_xfer_cb);
+	if (xfer == NULL) {
+		usbh_xfer_buf_free(msc->udev, buf);
+		return -ENOMEM;
+	}
+
+	memset(step, 0, sizeof(*step));
+	step->stage = job->next;
+
+	switch (job->next) {
+	case MSC_STAGE_CBW:
+		job->tag = ++msc->tag;
+		msc_put_cbw(buf, job, cmd_len);
+		job->cmd_off = 0;
+		job->next = cmd_len != 0 ? MSC_STAGE_DATA : MSC_STAGE_CSW;
+		break;
+	case MSC_STAGE_DATA:
+		step->data = job->data + job->off + job->cmd_off;
+		step->len = len;
+		step->exact = job->block_size != 0;
+		if (!job->in) {
+			net_buf_add_mem(buf, step->data, len);
+		}
+
+		job->cmd_off += len;
+		if (job->cmd_off == cmd_len) {
+			job->next = MSC_STAGE_CSW;
+		}
+		break;
+	default:
+		step->tag = job->tag;
+		job->off += cmd_len;
+		job->cmds_left--;
+		job->next = MSC_STAGE_CBW;
+		break;
+	}
+
+	if (usbh_xfer_buf_add(msc->udev, xfer, buf) != 0 ||
+	    usbh_xfer_enqueue(msc->udev, xfer) != 0) {
+		LOG_ERR("Failed to queue stage %u", step->stage);
+		usbh_xfer_buf_free(msc->udev, buf);
+		usbh_xfer_free(msc->udev, xfer);
+		return -EIO;
+	}
+
+	step->xfer = xfer;
+	msc->count++;
+
+	return 0;
+}
+
+static int msc_check_csw(const struct net_buf *const buf, const uint32_t tag,
+			 bool *const recover)
+{
+	if (buf->len != MSC_CSW_LEN ||
+	    sys_get_le32(&buf->data[0]) != MSC_CSW_SIGNATURE ||
+	    sys_get_le32(&buf->data[4]) != tag) {
+		LOG_ERR("Invalid CSW of command %u", tag);
+		*recover = true;
+		return -EIO;
+	}
+
+	switch (buf->data[12]) {
+	case MSC_CSW_STATUS_PASSED:
+		return 0;
+	case MSC_CSW_STATUS_FAILED:
+		LOG_DBG("Command %u failed", tag);
+		return -EIO;
+	default:
+		LOG_ERR("Phase error of command %u", tag);
+		*recover = true;
+		return -EIO;
+	}
+}
+
+/* Wait for the oldest transfer in flight and handle its stage */
+static int msc_complete(struct usbh_msc *const msc, bool *const recover)
+{
+	struct msc_step *step = &msc->steps[msc->head];
+	struct uhc_transfer *xfer;
+	struct net_buf *buf;
+	int err;
+
+	if (k_msgq_get(&msc_done_msgq, &xfer, K_MSEC(MSC_XFER_TIMEOUT)) != 0) {
+		return -ETIMEDOUT;
+	}
+
+	/* The controller starts the bulk transfers in the order they are queued */
+	__ASSERT(xfer == step->xfer, "Transfer %p completed out of order", xfer);
+
+	buf = xfer->buf;
+	err = xfer->err;
+	if (err != 0) {
+		LOG_ERR("Transfer of stage %u failed, err %d", step->stage, err);
+		*recover = true;
+	} else if (step->stage == MSC_STAGE_DATA && USB_EP_DIR_IS_IN(xfer->ep)) {
+		if (step->exact && buf->len != step->len) {
+			LOG_ERR("Short data stage, %u of %zu bytes", buf->len, step->len);
+			*recover = true;
+			err = -EIO;
+		} else {
+			memcpy(step->data, buf->data, MIN(buf->len, step->len));
+		}
+	} else if (step->stage == MSC_STAGE_CSW) {
+		err = msc_check_csw(buf, step->tag, recover);
+	}
+
+	usbh_xfer_buf_free(msc->udev, buf);
+	usbh_xfer_free(msc->udev, xfer);
+	msc->head = (msc->head + 1) % ARRAY_SIZE(msc->steps);
+	msc->count--;
+
+	return err;
+}
+
+static void msc_cancel(struct usbh_msc *const msc)
+{
+	while (msc->count > 0) {
+		struct uhc_transfer *xfer = msc->steps[msc->head].xfer;
+		struct net_buf *buf = xfer->buf;
+
+		usbh_xfer_dequeue(msc->udev, xfer);
+		usbh_xfer_buf_free(msc->udev, buf);
+		usbh_xfer_free(msc->udev, xfer);
+		msc->head = (msc->head + 1) % ARRAY_SIZE(msc->steps);
+		msc->count--;
+	}
+
+	k_msgq_purge(&msc_done_msgq);
+}
+
+/* Bulk-Only Mass Storage Reset, then clear the halt of both endpoints */
+static void msc_reset_recovery(struct usbh_msc *const msc)
+{
+	const uint8_t reset_type = USB_REQTYPE_DIR_TO_DEVICE << 7 |
+				   USB_REQTYPE_TYPE_CLASS << 5 |
+				   USB_REQTYPE_RECIPIENT_INTERFACE;
+	const uint8_t halt_type = USB_REQTYPE_DIR_TO_DEVICE << 7 |
+				  USB_REQTYPE_RECIPIENT_ENDPOINT;
+	int ret;
+
+	LOG_WRN("Reset recovery");
+
+	ret = usbh_req_setup(msc->udev, reset_type, MSC_REQ_BOMSR,
+			     0, msc->iface, 0, NULL);
+	if (ret == 0) {
+		ret = usbh_req_setup(msc->udev, halt_type, USB_SREQ_CLEAR_FEATURE,
+				     USB_SFS_ENDPOINT_HALT, msc->ep_in, 0, NULL);
+	}
+
+	if (ret == 0) {
+		ret = usbh_req_setup(msc->udev, halt_type, USB_SREQ_CLEAR_FEATURE,
+				     USB_SFS_ENDPOINT_HALT, msc->ep_out, 0, NULL);
+	}
+
+	if (ret != 0) {
+		LOG_ERR("Reset recovery failed, err %d", ret);
+	}
+}
+
+static int msc_run(struct usbh_msc *const msc, struct msc_job *const job)
+{
+	bool recover = false;
+	int err = 0;
+	int ret;
+
+	job->next = MSC_STAGE_CBW;
+	job->off = 0;
+	job->cmds_left = job->len == 0 ? 1 : DIV_ROUND_UP(job->len, job->cmd_len);
+
+	while (msc->count > 0 || (err == 0 && job->cmds_left > 0)) {
+		/* Keep the controller queue filled */
+		while (err == 0 && job->cmds_left > 0 &&
+		       msc->count < ARRAY_SIZE(msc->steps)) {
+			ret = msc_submit(msc, job);
+			if (ret == -ENOMEM && msc->count > 0) {
+				break;
+			}
+
+			if (ret != 0) {
+				err = ret;
+				/* The device may wait for the rest of a command */
+				recover = recover || ret != -ENOMEM ||
+					  job->next != MSC_STAGE_CBW;
+			}
+		}
+
+		if (msc->count == 0) {
+			break;
+		}
+
+		ret = msc_complete(msc, &recover);
+		if (ret == -ETIMEDOUT) {
+			LOG_ERR("Bulk transfer timeout");
+			msc_cancel(msc);
+			recover = true;
+			err = ret;
+			break;
+		}
+
+		if (err == 0) {
+			err = ret;
+		}
+	}
+
+	if (recover) {
+		msc_reset_recovery(msc);
+	}
+
+	return err;
+}
+
+static int msc_scsi_cmd(struct usbh_msc *const msc,
+			const uint8_t *const cdb, const uint8_t cdb_len,
+			uint8_t *const data, const size_t len)
+{
+	struct msc_job job = {
+		.cdb_len = cdb_len,
+		.in = true,
+		.data = data,
+		.len = len,
+		.cmd_len = len,
+	};
+
+	memcpy(job.cdb, cdb, cdb_len);
+
+	return msc_run(msc, &job);
+}
+
+static int msc_rw(struct usbh_msc *const msc, const bool in,
+		  uint8_t *const data, const uint32_t lba, const uint32_t count)
+{
+	struct msc_job job = {
+		.cdb = {in ? SCSI_READ_10 : SCSI_WRITE_10},
+		.cdb_len = 10,
+		.in = in,
+		.data = data,
+		.len = (size_t)count * msc->block_size,
+		.cmd_len = (size_t)CONFIG_USBH_MSC_CMD_BLOCKS * msc->block_size,
+		.block_size = msc->block_size,
+		.lba = lba,
+	};
+
+	if (count == 0) {
+		return 0;
+	}
+
+	return msc_run(msc, &job);
+}
+
+static int msc_find_iface(struct usbh_msc *const msc,
+			  const uint8_t *desc, size_t len)
+{
+	bool found = false;
+
+	msc->ep_in = 0;
+	msc->ep_out = 0;
+
+	while (len >= sizeof(struct usb_desc_header)) {
+		const struct usb_desc_header *head = (const void *)desc;
+
+		if (head->bLength < sizeof(*head) || head->bLength > len) {
+			break;
+		}
+
+		if (head->bDescriptorType == USB_DESC_INTERFACE &&
+		    head->bLength >= sizeof(struct usb_if_descriptor)) {
+			const struct usb_if_descriptor *if_desc = (const void *)desc;
+
+			if (found) {
+				break;
+			}
+
+			found = if_desc->bInterfaceClass == USB_BCC_MASS_STORAGE &&
+				if_desc->bInterfaceSubClass == MSC_SUBCLASS_SCSI &&
+				if_desc->bInterfaceProtocol == MSC_PROTOCOL_BBB &&
+				if_desc->bAlternateSetting == 0;
+			msc->iface = if_desc->bInterfaceNumber;
+		} else if (found && head->bDescriptorType == USB_DESC_ENDPOINT &&
+			   head->bLength >= sizeof(struct usb_ep_descriptor)) {
+			const struct usb_ep_descriptor *ep_desc = (const void *)desc;
+			uint16_t mps = sys_le16_to_cpu(ep_desc->wMaxPacketSize) & BIT_MASK(11);
+
+			if ((ep_desc->bmAttributes & USB_EP_TRANSFER_TYPE_MASK) ==
+			    USB_EP_TYPE_BULK) {
+				if (USB_EP_DIR_IS_IN(ep_desc->bEndpointAddress)) {
+					msc->ep_in = ep_desc->bEndpointAddress;
+					msc->mps_in = mps;
+				} else {
+					msc->ep_out = ep_desc->bEndpointAddress;
+					msc->mps_out = mps;
+				}
+			}
+		}
+
+		desc += head->bLength;
+		len -= head->bLength;
+	}
+
+	return (msc->ep_in != 0 && msc->ep_out != 0) ? 0 : -ENOTSUP;
+}
+
+/* Only the first configuration of the device is looked at */
+static int msc_read_cfg(struct usbh_msc *const msc)
+{
+	struct usb_cfg_descriptor cfg;
+	struct net_buf *buf;
+	int ret;
+
+	ret = usbh_req_desc_cfg(msc->udev, 0, sizeof(cfg), &cfg);
+	if (ret != 0) {
+		return ret;
+	}
+
+	buf = usbh_xfer_buf_alloc(msc->udev, cfg.wTotalLength);
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	ret = usbh_req_desc(msc->udev, USB_DESC_CONFIGURATION, 0, 0,
+			    cfg.wTotalLength, buf);
+	if (ret == 0) {
+		ret = msc_find_iface(msc, buf->data, buf->len);
+	}
+
+	usbh_xfer_buf_free(msc->udev, buf);
+
+	return ret;
+}
+
+static int msc_wait_ready(struct usbh_msc *const msc)
+{
+	const uint8_t tur_cmd[6] = {SCSI_TEST_UNIT_READY};
+	const uint8_t sense_cmd[6] = {SCSI_REQUEST_SENSE, 0, 0, 0, SCSI_SENSE_LEN};
+	uint8_t sense[SCSI_SENSE_LEN];
+	int ret = -EIO;
+
+	for (int i = 0; i < MSC_READY_RETRIES; i++) {
+		ret = msc_scsi_cmd(msc, tur_cmd, sizeof(tur_cmd), NULL, 0);
+		if (ret != -EIO) {
+			break;
+		}
+
+		/* Fetch the sense data, e.g. a unit attention after reset */
+		(void)msc_scsi_cmd(msc, sense_cmd, sizeof(sense_cmd),
+				   sense, sizeof(sense));
+		k_msleep(100);
+	}
+
+	return ret;
+}
+
+static int msc_read_capacity(struct usbh_msc *const msc)
+{
+	const uint8_t cap_cmd[10] = {SCSI_READ_CAPACITY_10};
+	uint8_t cap[SCSI_CAPACITY_LEN];
+	uint32_t last_lba;
+	int ret;
+
+	ret = msc_scsi_cmd(msc, cap_cmd, sizeof(cap_cmd), cap, sizeof(cap));
+	if (ret != 0) {
+		return ret;
+	}
+
+	last_lba = sys_get_be32(&cap[0]);
+	msc->block_size = sys_get_be32(&cap[4]);
+	if (last_lba == UINT32_MAX || msc->block_size == 0) {
+		LOG_ERR("Unsupported capacity");
+		return -ENOTSUP;
+	}
+
+	msc->block_count = last_lba + 1;
+
+	return 0;
+}
+
+static int msc_disk_init(struct disk_info *const disk)
+{
+	struct usbh_msc *const msc = CONTAINER_OF(disk, struct usbh_msc, info);
+
+	return atomic_get(&msc->attached) ? 0 : -ENODEV;
+}
+
+static int msc_disk_status(struct disk_info *const disk)
+{
+	struct usbh_msc *const msc = CONTAINER_OF(disk, struct usbh_msc, info);
+
+	return atomic_get(&msc->attached) ? DISK_STATUS_OK : DISK_STATUS_NOMEDIA;
+}
+
+static int msc_disk_access(struct usbh_msc *const msc, const bool in,
+			   uint8_t *const data, const uint32_t sector,
+			   const uint32_t count)
+{
+	int ret;
+
+	k_mutex_lock(&msc->lock, K_FOREVER);
+
+	if (!atomic_get(&msc->attached)) {
+		ret = -ENODEV;
+	} else if (sector >= msc->block_count || count > msc->block_count - sector) {
+		ret = -EINVAL;
+	} else {
+		ret = msc_rw(msc, in, data, sector, count);
+	}
+
+	k_mutex_unlock(&msc->lock);
+
+	return ret;
+}
+
+static int msc_disk_read(struct disk_info *const disk, uint8_t *const data,
+			 const uint32_t sector, const uint32_t count)
+{
+	struct usbh_msc *const msc = CONTAINER_OF(disk, struct usbh_msc, info);
+
+	return msc_disk_access(msc, true, data, sector, count);
+}
+
+static int msc_disk_write(struct disk_info *const disk, const uint8_t *const data,
+			  const uint32_t sector, const uint32_t count)
+{
+	struct usbh_msc *const msc = CONTAINER_OF(disk, struct usbh_msc, info);
+
+	/* The data is only read by the data OUT stages */
+	return msc_disk_access(msc, false, (uint8_t *)data, sector, count);
+}
+
+static int msc_disk_ioctl(struct disk_info *const disk, const uint8_t cmd,
+			  void *const buff)
+{
+	struct usbh_msc *const msc = CONTAINER_OF(disk, struct usbh_msc, info);
+
+	switch (cmd) {
+	case DISK_IOCTL_CTRL_SYNC:
+		break;
+	case DISK_IOCTL_GET_SECTOR_COUNT:
+		*(uint32_t *)buff = msc->block_count;
+		break;
+	case DISK_IOCTL_GET_SECTOR_SIZE:
+		*(uint32_t *)buff = msc->block_size;
+		break;
+	case DISK_IOCTL_GET_ERASE_BLOCK_SZ:
+		*(uint32_t *)buff = 1U;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static const struct disk_operations msc_disk_ops = {
+	.init = msc_disk_init,
+	.status = msc_disk_status,
+	.read = msc_disk_read,
+	.write = msc_disk_write,
+	.ioctl = msc_disk_ioctl,
+};
+
+static struct usbh_msc msc_data = {
+	.info = {
+		.name = CONFIG_USBH_MSC_DISK_NAME,
+		.ops = &msc_disk_ops,
+	},
+	.lock = Z_MUTEX_INITIALIZER(msc_data.lock),
+};
+
+static int msc_connected(struct usbh_contex *const uhs_ctx)
+{
+	struct usbh_msc *const msc = &msc_data;
+	int ret;
+
+	k_mutex_lock(&msc->lock, K_FOREVER);
+
+	msc->udev = usbh_device_get_any(uhs_ctx);
+	msc->head = 0;
+	msc->count = 0;
+	k_msgq_purge(&msc_done_msgq);
+
+	ret = msc_read_cfg(msc);
+	if (ret == 0) {
+		ret = msc_wait_ready(msc);
+	}
+
+	if (ret == 0) {
+		ret = msc_read_capacity(msc);
+	}
+
+	if (ret == 0 && !msc->registered) {
+		ret = disk_access_register(&msc->info);
+		msc->registered = ret == 0;
+	}
+
+	if (ret == 0) {
+		atomic_set(&msc->attached, 1);
+		LOG_INF("Disk %s, %u blocks of %u bytes", msc->info.name,
+			msc->block_count, msc->block_size);
+	} else if (ret != -ENOTSUP) {
+		LOG_ERR("Failed to attach mass storage device, err %d", ret);
+	}
+
+	k_mutex_unlock(&msc->lock);
+
+	return ret;
+}
+
+static int msc_removed(struct usbh_contex *const uhs_ctx)
+{
+	ARG_UNUSED(uhs_ctx);
+
+	/* Accesses in progress fail on their own, the disk stays registered */
+	atomic_clear(&msc_data.attached);
+
+	return 0;
+}
+
+USBH_DEFINE_CLASS(msc_class) = {
+	.code = {
+		.dclass = USB_BCC_MASS_STORAGE,
+		.sub = MSC_SUBCLASS_SCSI,
+		.proto = MSC_PROTOCOL_BBB,
+	},
+	.connected = msc_connected,
+	.removed = msc_removed,
+};
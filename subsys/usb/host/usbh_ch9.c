@@ -13,6 +13,7 @@
 #include <zephyr/net/buf.h>
 
 #include "usbh_device.h"
+#include "usbh_internal.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(usbh_ch9, CONFIG_USBH_LOG_LEVEL);
@@ -190,6 +191,7 @@ int usbh_req_set_cfg(struct usb_device *const udev,
 
 		if (cfg != 0 && udev->state == USB_STATE_ADDRESSED) {
 			udev->state = USB_STATE_CONFIGURED;
+			usbh_class_connected(udev->ctx);
 		}
 	}
 
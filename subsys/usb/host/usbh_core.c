@@ -67,6 +67,11 @@ static ALWAYS_INLINE int usbh_event_handler(struct usbh_contex *const ctx,
 		break;
 	case UHC_EVT_DEV_REMOVED:
 		LOG_DBG("Device removed event");
+		STRUCT_SECTION_FOREACH(usbh_class_data, cdata) {
+			if (cdata->removed != NULL) {
+				cdata->removed(ctx);
+			}
+		}
 		break;
 	case UHC_EVT_RESETED:
 		LOG_DBG("Bus reset");
@@ -130,6 +135,15 @@ int usbh_init_device_intl(struct usbh_contex *const uhs_ctx)
 	return 0;
 }
 
+void usbh_class_connected(struct usbh_contex *const uhs_ctx)
+{
+	STRUCT_SECTION_FOREACH(usbh_class_data, cdata) {
+		if (cdata->connected != NULL && cdata->connected(uhs_ctx) == 0) {
+			LOG_DBG("Class %02x bound to the device", cdata->code.dclass);
+		}
+	}
+}
+
 static int uhs_pre_init(void)
 {
 	k_thread_create(&usbh_thread_data, usbh_stack,
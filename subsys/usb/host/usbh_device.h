@@ -92,4 +92,12 @@ static inline int usbh_xfer_enqueue(const struct usb_device *udev,
 	return uhc_ep_enqueue(ctx->dev, xfer);
 }
 
+static inline int usbh_xfer_dequeue(const struct usb_device *udev,
+				    struct uhc_transfer *const xfer)
+{
+	struct usbh_contex *const ctx = udev->ctx;
+
+	return uhc_ep_dequeue(ctx->dev, xfer);
+}
+
 #endif /* ZEPHYR_INCLUDE_USBH_DEVICE_H */
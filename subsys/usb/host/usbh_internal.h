@@ -12,4 +12,7 @@
 
 int usbh_init_device_intl(struct usbh_contex *const uhs_ctx);
 
+/* Let the class implementations bind to the newly configured device */
+void usbh_class_connected(struct usbh_contex *const uhs_ctx);
+
 #endif /* ZEPHYR_INCLUDE_USBH_INTERNAL_H */
@@ -8,6 +8,7 @@
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/net/buf.h>
 #include <zephyr/zbus/zbus.h>
 LOG_MODULE_REGISTER(zbus, CONFIG_ZBUS_LOG_LEVEL);
@@ -119,11 +120,150 @@ static inline int _zbus_notify_observer(const struct zbus_channel *chan,
 	return 0;
 }
 
+#if defined(CONFIG_ZBUS_OBSERVER_PRIORITY_ORDER)
+
+/* Rank of an observer in the notification sequence, the lowest first. The listeners come after
+ * all the subscribers, as they run in the publisher context.
+ */
+static inline int observer_rank(const struct zbus_observer *obs)
+{
+	int rank = obs->data->priority;
+
+	if (obs->type == ZBUS_OBSERVER_LISTENER_TYPE) {
+		rank += CONFIG_NUM_COOP_PRIORITIES + CONFIG_NUM_PREEMPT_PRIORITIES;
+	}
+
+	return rank;
+}
+
+/* Pick the next observation of the channel to notify, or the end index when all are done. The
+ * first at the lowest rank wins, so the static sequence breaks the ties. The observations are
+ * marked as they are picked, hence a priority changing meanwhile neither skips nor repeats one.
+ */
+static int16_t vded_next(const struct zbus_channel *chan, int16_t idx)
+{
+	struct zbus_channel_observation *observation;
+	struct zbus_channel_observation_mask *observation_mask;
+	struct zbus_channel_observation_mask *next_mask = NULL;
+	int16_t next = chan->data->observers_end_idx;
+	int next_rank = INT_MAX;
+
+	ARG_UNUSED(idx);
+
+	for (int16_t i = chan->data->observers_start_idx, limit = chan->data->observers_end_idx;
+	     i < limit; ++i) {
+		STRUCT_SECTION_GET(zbus_channel_observation, i, &observation);
+		STRUCT_SECTION_GET(zbus_channel_observation_mask, i, &observation_mask);
+
+		if (observation_mask->notified) {
+			continue;
+		}
+
+		int rank = observer_rank(observation->obs);
+
+		if (rank < next_rank) {
+			next_rank = rank;
+			next = i;
+			next_mask = observation_mask;
+		}
+	}
+
+	if (next_mask != NULL) {
+		next_mask->notified = true;
+	}
+
+	return next;
+}
+
+static inline int16_t vded_first(const struct zbus_channel *chan)
+{
+	struct zbus_channel_observation_mask *observation_mask;
+
+	for (int16_t i = chan->data->observers_start_idx, limit = chan->data->observers_end_idx;
+	     i < limit; ++i) {
+		STRUCT_SECTION_GET(zbus_channel_observation_mask, i, &observation_mask);
+
+		observation_mask->notified = false;
+	}
+
+	return vded_next(chan, -1);
+}
+
+#else
+
+static inline int16_t vded_first(const struct zbus_channel *chan)
+{
+	return chan->data->observers_start_idx;
+}
+
+static inline int16_t vded_next(const struct zbus_channel *chan, int16_t idx)
+{
+	ARG_UNUSED(chan);
+
+	return idx + 1;
+}
+
+#endif /* CONFIG_ZBUS_OBSERVER_PRIORITY_ORDER */
+
+#if defined(CONFIG_ZBUS_OBSERVER_STATS)
+
+static inline void obs_stats_update(const struct zbus_observer *obs, uint32_t start)
+{
+	uint32_t delay = k_cycle_get_32() - start;
+
+	K_SPINLOCK(&obs_slock) {
+		obs->data->notify_count++;
+		obs->data->notify_total_cyc += delay;
+		obs->data->notify_max_cyc = MAX(obs->data->notify_max_cyc, delay);
+	}
+}
+
+int zbus_obs_get_stats(const struct zbus_observer *obs, struct zbus_observer_stats *stats)
+{
+	_ZBUS_ASSERT(obs != NULL, "obs is required");
+	_ZBUS_ASSERT(stats != NULL, "stats is required");
+
+	uint64_t total;
+
+	K_SPINLOCK(&obs_slock) {
+		stats->notifications = obs->data->notify_count;
+		stats->latency_max_ns = k_cyc_to_ns_floor64(obs->data->notify_max_cyc);
+		total = obs->data->notify_total_cyc;
+	}
+
+	stats->latency_avg_ns =
+		stats->notifications ? k_cyc_to_ns_floor64(total / stats->notifications) : 0;
+
+	return 0;
+}
+
+int zbus_obs_reset_stats(const struct zbus_observer *obs)
+{
+	_ZBUS_ASSERT(obs != NULL, "obs is required");
+
+	K_SPINLOCK(&obs_slock) {
+		obs->data->notify_count = 0;
+		obs->data->notify_max_cyc = 0;
+		obs->data->notify_total_cyc = 0;
+	}
+
+	return 0;
+}
+
+#else
+
+static inline void obs_stats_update(const struct zbus_observer *obs, uint32_t start)
+{
+}
+
+#endif /* CONFIG_ZBUS_OBSERVER_STATS */
+
 static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t end_time)
 {
 	int err = 0;
 	int last_error = 0;
 	struct net_buf *buf = NULL;
+	uint32_t __maybe_unused start = IS_ENABLED(CONFIG_ZBUS_OBSERVER_STATS) ? k_cycle_get_32() : 0;
 
 	/* Static observer event dispatcher logic */
 	struct zbus_channel_observation *observation;
@@ -143,8 +283,8 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 
 	int __maybe_unused index = 0;
 
-	for (int16_t i = chan->data->observers_start_idx, limit = chan->data->observers_end_idx;
-	     i < limit; ++i) {
+	for (int16_t i = vded_first(chan), limit = chan->data->observers_end_idx; i < limit;
+	     i = vded_next(chan, i)) {
 		STRUCT_SECTION_GET(zbus_channel_observation, i, &observation);
 		STRUCT_SECTION_GET(zbus_channel_observation_mask, i, &observation_mask);
 
@@ -158,7 +298,9 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 
 		err = _zbus_notify_observer(chan, obs, end_time, buf);
 
-		if (err) {
+		if (!err) {
+			obs_stats_update(obs, start);
+		} else {
 			last_error = err;
 			LOG_ERR("could not deliver notification to observer %s. Error code %d",
 				_ZBUS_OBS_NAME(obs), err);
@@ -189,6 +331,8 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 
 		if (err) {
 			last_error = err;
+		} else {
+			obs_stats_update(obs, start);
 		}
 	}
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS */
@@ -329,6 +473,57 @@ static inline int chan_lock(const struct zbus_channel *chan, k_timeout_t timeout
 	return 0;
 }
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+
+/* Number of lock-free copies tried before waiting for the semaphore */
+#define CHAN_SEQ_READ_TRIES 3
+
+/* Must be called with the channel semaphore taken, so the writers never overlap */
+static inline void chan_write_begin(const struct zbus_channel *chan)
+{
+	(void)atomic_inc(&chan->data->seq);
+}
+
+static inline void chan_write_end(const struct zbus_channel *chan)
+{
+	(void)atomic_inc(&chan->data->seq);
+}
+
+static bool chan_read_lockless(const struct zbus_channel *chan, void *msg)
+{
+	for (int i = 0; i < CHAN_SEQ_READ_TRIES; ++i) {
+		atomic_val_t seq = atomic_get(&chan->data->seq);
+
+		if (seq & 1) {
+			/* Written or claimed, the copy would not be consistent */
+			return false;
+		}
+
+		memcpy(msg, chan->message, chan->message_size);
+
+		/* The copy must be complete before the counter is checked again */
+		barrier_dmem_fence_full();
+
+		if (atomic_get(&chan->data->seq) == seq) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#else
+
+static inline void chan_write_begin(const struct zbus_channel *chan)
+{
+}
+
+static inline void chan_write_end(const struct zbus_channel *chan)
+{
+}
+
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 static inline void chan_unlock(const struct zbus_channel *chan, int prio)
 {
 	k_sem_give(&chan->data->sem);
@@ -367,8 +562,12 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 		return err;
 	}
 
+	chan_write_begin(chan);
+
 	memcpy(chan->message, msg, chan->message_size);
 
+	chan_write_end(chan);
+
 	err = _zbus_vded_exec(chan, end_time);
 
 	chan_unlock(chan, context_priority);
@@ -385,6 +584,12 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 		timeout = K_NO_WAIT;
 	}
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	if (chan_read_lockless(chan, msg)) {
+		return 0;
+	}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 	int err = k_sem_take(&chan->data->sem, timeout);
 	if (err) {
 		return err;
@@ -437,6 +642,9 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
+	/* The claimer may change the message in place */
+	chan_write_begin(chan);
+
 	return 0;
 }
 
@@ -444,6 +652,8 @@ int zbus_chan_finish(const struct zbus_channel *chan)
 {
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 
+	chan_write_end(chan);
+
 	k_sem_give(&chan->data->sem);
 
 	return 0;
@@ -489,6 +699,28 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 	return 0;
 }
 
+int zbus_sub_wait_msg_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus_sub_wait_msg_buf cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(sub->type == ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE,
+		     "sub must be a MSG_SUBSCRIBER");
+	_ZBUS_ASSERT(sub->message_fifo != NULL, "sub message_fifo is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	*buf = net_buf_get(sub->message_fifo, timeout);
+
+	if (*buf == NULL) {
+		return -ENOMSG;
+	}
+
+	*chan = *((struct zbus_channel **)net_buf_user_data(*buf));
+
+	return 0;
+}
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 int zbus_obs_set_chan_notification_mask(const struct zbus_observer *obs,
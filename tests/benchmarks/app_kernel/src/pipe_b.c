@@ -46,6 +46,7 @@
  */
 int pipeput(struct k_pipe *pipe, enum pipe_options
 		 option, int size, int count, uint32_t *time);
+int pipeput_claim(struct k_pipe *pipe, int size, int count, uint32_t *time);
 
 /*
  * Function declarations.
@@ -138,6 +139,30 @@ void pipe_test(void)
 		PRINT_STRING(dashline);
 		k_thread_priority_set(k_current_get(), TaskPrio);
 	}
+
+	/* data written in place in the pipe buffer, matching (ALL_N) */
+	PRINT_STRING("|                   "
+		     "in place writes, matching sizes (_ALL_N)"
+		     "                  |\n");
+	PRINT_STRING(dashline);
+	PRINT_ALL_TO_N_HEADER_UNIT();
+	PRINT_STRING(dashline);
+	PRINT_STRING("| put | get |  no buf  | small buf| big buf  |"
+		     "  no buf  | small buf| big buf  |\n");
+	PRINT_STRING(dashline);
+
+	for (putsize = 8U; putsize <= MESSAGE_SIZE_PIPE; putsize <<= 1) {
+		for (pipe = 0; pipe < 3; pipe++) {
+			putcount = NR_OF_PIPE_RUNS;
+			pipeput_claim(test_pipes[pipe], putsize, putcount,
+				      &puttime[pipe]);
+
+			/* waiting for ack */
+			k_msgq_get(&CH_COMM, &getinfo, K_FOREVER);
+		}
+		PRINT_ALL_TO_N();
+	}
+	PRINT_STRING(dashline);
 }
 
 
@@ -204,3 +229,60 @@ int pipeput(struct k_pipe *pipe,
 
 	return 0;
 }
+
+/**
+ * @brief Write data portions in place in the pipe buffer and measure time
+ *
+ * A chunk that does not fit in the contiguous free space of the buffer is
+ * written with k_pipe_put(), as is every chunk of a pipe without buffer or
+ * of a user thread, which cannot claim pipe memory.
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     The pipe to be tested.
+ * @param size     Data chunk size.
+ * @param count    Number of data chunks.
+ * @param time     Total write time.
+ */
+int pipeput_claim(struct k_pipe *pipe, int size, int count, uint32_t *time)
+{
+	int i;
+	unsigned int t;
+	timing_t  start;
+	timing_t  end;
+	bool user = k_is_user_context();
+
+	/* first sync with the receiver */
+	k_sem_give(&SEM0);
+	start = timing_timestamp_get();
+	for (i = 0; i < count; i++) {
+		size_t sizexferd = 0;
+		size_t room = 0;
+		void *region;
+		int ret;
+
+		if (!user && k_pipe_put_claim(pipe, &region, &room) == 0) {
+			if (room >= size) {
+				(void)memcpy(region, data_bench, size);
+				k_pipe_put_finish(pipe, size);
+				continue;
+			}
+
+			k_pipe_put_finish(pipe, 0);
+		}
+
+		ret = k_pipe_put(pipe, data_bench, size,
+				 &sizexferd, size, K_FOREVER);
+
+		if (ret != 0 || sizexferd != size) {
+			return 1;
+		}
+	}
+
+	end = timing_timestamp_get();
+	t = (unsigned int)timing_cycles_get(&start, &end);
+
+	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+
+	return 0;
+}
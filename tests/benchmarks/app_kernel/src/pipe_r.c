@@ -65,6 +65,20 @@ void piperecvtask(void)
 		}
 	}
 
+	/* in place writes, matching (ALL_N) */
+
+	for (getsize = 8; getsize <= MESSAGE_SIZE_PIPE; getsize <<= 1) {
+		for (pipe = 0; pipe < 3; pipe++) {
+			getcount = NR_OF_PIPE_RUNS;
+			pipeget(test_pipes[pipe], _ALL_N, getsize,
+				getcount, &gettime);
+			getinfo.time = gettime;
+			getinfo.size = getsize;
+			getinfo.count = getcount;
+			/* acknowledge to master */
+			k_msgq_put(&CH_COMM, &getinfo, K_FOREVER);
+		}
+	}
 }
 
 
@@ -0,0 +1,246 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Same operations on the B-tree and on the red/black tree keyed by an
+ * integer, the way rb.c is typically used: a node embedded in each entry and
+ * a comparison callback.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+#include <zephyr/sys/rb.h>
+
+#define N_ENTRIES CONFIG_BENCHMARK_BTREE_ENTRIES
+
+/* Number of range walks, each over RANGE_LEN keys */
+#define N_RANGES 64
+#define RANGE_LEN 32
+
+struct op_stats {
+	uint64_t total;
+	uint32_t worst;
+};
+
+struct entry {
+	struct rbnode node;
+	uintptr_t key;
+	uintptr_t value;
+};
+
+struct results {
+	struct op_stats insert, hit, miss, walk, range, remove;
+};
+
+SYS_BTREE_DEFINE(btree, SYS_BTREE_NODES(N_ENTRIES));
+
+static bool entry_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct entry, node)->key < CONTAINER_OF(b, struct entry, node)->key;
+}
+
+static struct rbtree rbtree = {
+	.lessthan_fn = entry_lessthan,
+};
+
+static struct entry entries[N_ENTRIES];
+static uintptr_t sorted_keys[N_ENTRIES];
+
+static inline void op_stats_add(struct op_stats *stats, uint32_t start)
+{
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	stats->total += cycles;
+	stats->worst = MAX(stats->worst, cycles);
+}
+
+/* Even keys, inserted in a scattered order. Odd keys are misses. */
+static inline uintptr_t key_of(uint32_t i)
+{
+	return 2 * (((uint64_t)i * 7919) % N_ENTRIES);
+}
+
+static struct entry *rb_find(uintptr_t key)
+{
+	struct entry probe = {.key = key};
+	struct rbnode *n = rbtree.root;
+
+	while (n != NULL) {
+		struct entry *e = CONTAINER_OF(n, struct entry, node);
+
+		if (e->key == key) {
+			return e;
+		}
+		n = z_rb_child(n, rbtree.lessthan_fn(n, &probe.node));
+	}
+
+	return NULL;
+}
+
+static void print_results(const char *name, struct results *r)
+{
+	TC_PRINT("%-6s %u entries, cycles per op average / worst:\n", name, N_ENTRIES);
+	TC_PRINT("  insert %6u / %u\n", (uint32_t)(r->insert.total / N_ENTRIES), r->insert.worst);
+	TC_PRINT("  hit    %6u / %u\n", (uint32_t)(r->hit.total / N_ENTRIES), r->hit.worst);
+	TC_PRINT("  miss   %6u / %u\n", (uint32_t)(r->miss.total / N_ENTRIES), r->miss.worst);
+	TC_PRINT("  walk   %6u / %u\n", (uint32_t)(r->walk.total / N_ENTRIES), r->walk.worst);
+	TC_PRINT("  range  %6u / %u (%u keys)\n", (uint32_t)(r->range.total / N_RANGES),
+		 r->range.worst, RANGE_LEN);
+	TC_PRINT("  remove %6u / %u\n", (uint32_t)(r->remove.total / N_ENTRIES), r->remove.worst);
+}
+
+ZTEST(btree_perf, test_btree)
+{
+	struct results r = {0};
+	struct sys_btree_iter iter;
+	uintptr_t key, value, next;
+	uint32_t start;
+	int ret;
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		start = k_cycle_get_32();
+		ret = sys_btree_insert(&btree, key_of(i), i, NULL);
+		op_stats_add(&r.insert, start);
+		zassert_equal(ret, 0, "insert %u failed: %d", i, ret);
+	}
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		start = k_cycle_get_32();
+		ret = sys_btree_get(&btree, key_of(i), &value);
+		op_stats_add(&r.hit, start);
+		zassert_true(ret && value == i);
+
+		start = k_cycle_get_32();
+		ret = sys_btree_get(&btree, key_of(i) + 1, NULL);
+		op_stats_add(&r.miss, start);
+		zassert_false(ret);
+	}
+
+	next = 0;
+	start = k_cycle_get_32();
+	SYS_BTREE_FOR_EACH(&btree, iter, key, value) {
+		zassert_equal(key, next);
+		next += 2;
+	}
+	op_stats_add(&r.walk, start);
+	zassert_equal(next, 2 * N_ENTRIES);
+
+	for (uint32_t i = 0; i < N_RANGES; i++) {
+		uintptr_t lo = key_of(i) % (2 * (N_ENTRIES - RANGE_LEN));
+		uint32_t count = 0;
+
+		start = k_cycle_get_32();
+		SYS_BTREE_FOR_EACH_RANGE(&btree, iter, lo, lo + 2 * RANGE_LEN - 1, key, value) {
+			count++;
+		}
+		op_stats_add(&r.range, start);
+		zassert_equal(count, RANGE_LEN);
+	}
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		start = k_cycle_get_32();
+		ret = sys_btree_remove(&btree, key_of(i), NULL);
+		op_stats_add(&r.remove, start);
+		zassert_true(ret);
+	}
+
+	zassert_equal(sys_btree_size(&btree), 0);
+	print_results("btree", &r);
+}
+
+ZTEST(btree_perf, test_rbtree)
+{
+	struct results r = {0};
+	struct entry *e;
+	uintptr_t next;
+	uint32_t start;
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		entries[i].key = key_of(i);
+		entries[i].value = i;
+
+		start = k_cycle_get_32();
+		rb_insert(&rbtree, &entries[i].node);
+		op_stats_add(&r.insert, start);
+	}
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		start = k_cycle_get_32();
+		e = rb_find(key_of(i));
+		op_stats_add(&r.hit, start);
+		zassert_true(e != NULL && e->value == i);
+
+		start = k_cycle_get_32();
+		e = rb_find(key_of(i) + 1);
+		op_stats_add(&r.miss, start);
+		zassert_is_null(e);
+	}
+
+	next = 0;
+	start = k_cycle_get_32();
+	RB_FOR_EACH_CONTAINER(&rbtree, e, node) {
+		zassert_equal(e->key, next);
+		next += 2;
+	}
+	op_stats_add(&r.walk, start);
+	zassert_equal(next, 2 * N_ENTRIES);
+
+	/* rb.c has no lower bound search, ranges are walked from the minimum */
+	for (uint32_t i = 0; i < N_RANGES; i++) {
+		uintptr_t lo = key_of(i) % (2 * (N_ENTRIES - RANGE_LEN));
+		uint32_t count = 0;
+
+		start = k_cycle_get_32();
+		RB_FOR_EACH_CONTAINER(&rbtree, e, node) {
+			if (e->key >= lo + 2 * RANGE_LEN) {
+				break;
+			}
+			count += e->key >= lo;
+		}
+		op_stats_add(&r.range, start);
+		zassert_equal(count, RANGE_LEN);
+	}
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		start = k_cycle_get_32();
+		rb_remove(&rbtree, &entries[i].node);
+		op_stats_add(&r.remove, start);
+	}
+
+	zassert_is_null(rbtree.root);
+	print_results("rbtree", &r);
+}
+
+ZTEST(btree_perf, test_btree_load)
+{
+	struct op_stats load = {0}, insert = {0};
+	uint32_t start;
+	int ret;
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		sorted_keys[i] = 2 * i;
+	}
+
+	start = k_cycle_get_32();
+	ret = sys_btree_load(&btree, sorted_keys, NULL, N_ENTRIES);
+	op_stats_add(&load, start);
+	zassert_equal(ret, 0, "load failed: %d", ret);
+	sys_btree_clear(&btree);
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		ret = sys_btree_insert(&btree, sorted_keys[i], 0, NULL);
+		zassert_equal(ret, 0, "insert %u failed: %d", i, ret);
+	}
+	op_stats_add(&insert, start);
+	sys_btree_clear(&btree);
+
+	TC_PRINT("btree  %u sorted entries, total cycles:\n", N_ENTRIES);
+	TC_PRINT("  load   %u\n", load.worst);
+	TC_PRINT("  insert %u\n", insert.worst);
+}
+
+ZTEST_SUITE(btree_perf, NULL, NULL, NULL, NULL, NULL);
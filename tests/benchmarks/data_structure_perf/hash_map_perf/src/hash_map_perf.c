@@ -0,0 +1,94 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#define N_ENTRIES CONFIG_BENCHMARK_HASH_MAP_ENTRIES
+
+SYS_HASHMAP_SC_DEFINE_STATIC(sc_map);
+SYS_HASHMAP_OA_LP_DEFINE_STATIC(oa_lp_map);
+SYS_HASHMAP_OA_RH_DEFINE_STATIC(oa_rh_map);
+
+struct op_stats {
+	uint64_t total;
+	uint32_t worst;
+};
+
+static inline void op_stats_add(struct op_stats *stats, uint32_t start)
+{
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	stats->total += cycles;
+	stats->worst = MAX(stats->worst, cycles);
+}
+
+/* Spread the keys like device identifiers rather than using 0..N-1 */
+static inline uint64_t key_of(uint32_t i)
+{
+	return (uint64_t)i * 0x9e3779b97f4a7c15ULL;
+}
+
+static void bench(const char *name, struct sys_hashmap *map)
+{
+	struct op_stats insert = {0}, hit = {0}, miss = {0}, remove = {0};
+	uint64_t value;
+	uint32_t start;
+	int ret;
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		start = k_cycle_get_32();
+		ret = sys_hashmap_insert(map, key_of(i), i, NULL);
+		op_stats_add(&insert, start);
+		zassert_equal(ret, 1, "insert %u failed: %d", i, ret);
+	}
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		start = k_cycle_get_32();
+		ret = sys_hashmap_get(map, key_of(i), &value);
+		op_stats_add(&hit, start);
+		zassert_true(ret && value == i);
+
+		start = k_cycle_get_32();
+		ret = sys_hashmap_get(map, key_of(i + N_ENTRIES), NULL);
+		op_stats_add(&miss, start);
+		zassert_false(ret);
+	}
+
+	for (uint32_t i = 0; i < N_ENTRIES; i++) {
+		start = k_cycle_get_32();
+		ret = sys_hashmap_remove(map, key_of(i), NULL);
+		op_stats_add(&remove, start);
+		zassert_true(ret);
+	}
+
+	zassert_true(sys_hashmap_is_empty(map));
+
+	TC_PRINT("%-6s %u entries, cycles per op average / worst:\n", name, N_ENTRIES);
+	TC_PRINT("  insert %6u / %u\n", (uint32_t)(insert.total / N_ENTRIES), insert.worst);
+	TC_PRINT("  hit    %6u / %u\n", (uint32_t)(hit.total / N_ENTRIES), hit.worst);
+	TC_PRINT("  miss   %6u / %u\n", (uint32_t)(miss.total / N_ENTRIES), miss.worst);
+	TC_PRINT("  remove %6u / %u\n", (uint32_t)(remove.total / N_ENTRIES), remove.worst);
+
+	sys_hashmap_clear(map, NULL, NULL);
+}
+
+ZTEST(hash_map_perf, test_separate_chaining)
+{
+	bench("sc", &sc_map);
+}
+
+ZTEST(hash_map_perf, test_open_addressing)
+{
+	bench("oa_lp", &oa_lp_map);
+}
+
+ZTEST(hash_map_perf, test_robin_hood)
+{
+	bench("oa_rh", &oa_rh_map);
+}
+
+ZTEST_SUITE(hash_map_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,81 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Cycles taken by the zdsp basic math functions of the selected backend, to
+ * be compared between the builds for each backend.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/dsp/dsp.h>
+#include "../../../cmsis_dsp/common/benchmark_common.h"
+
+#define PATTERN_LENGTH	(256)
+
+static q7_t q7_a[PATTERN_LENGTH], q7_b[PATTERN_LENGTH], q7_dst[PATTERN_LENGTH];
+static q15_t q15_a[PATTERN_LENGTH], q15_b[PATTERN_LENGTH], q15_dst[PATTERN_LENGTH];
+static q31_t q31_a[PATTERN_LENGTH], q31_b[PATTERN_LENGTH], q31_dst[PATTERN_LENGTH];
+static float32_t f32_a[PATTERN_LENGTH], f32_b[PATTERN_LENGTH], f32_dst[PATTERN_LENGTH];
+static q31_t q31_result;
+static q63_t q63_result;
+static float32_t f32_result;
+
+#define BENCHMARK(name, call)                                                                     \
+	ZTEST(dsp_basicmath_benchmark, test_benchmark_##name)                                     \
+	{                                                                                         \
+		uint32_t irq_key, timestamp, timespan;                                            \
+                                                                                                  \
+		benchmark_begin(&irq_key, &timestamp);                                            \
+		call;                                                                             \
+		timespan = benchmark_end(irq_key, timestamp);                                     \
+                                                                                                  \
+		TC_PRINT(BENCHMARK_TYPE " = %u\n", timespan);                                     \
+	}
+
+BENCHMARK(vec_add_q7, zdsp_add_q7(q7_a, q7_b, q7_dst, PATTERN_LENGTH))
+BENCHMARK(vec_mult_q7, zdsp_mult_q7(q7_a, q7_b, q7_dst, PATTERN_LENGTH))
+BENCHMARK(vec_scale_q7, zdsp_scale_q7(q7_a, 0x40, 1, q7_dst, PATTERN_LENGTH))
+BENCHMARK(vec_dot_prod_q7, zdsp_dot_prod_q7(q7_a, q7_b, PATTERN_LENGTH, &q31_result))
+
+BENCHMARK(vec_add_q15, zdsp_add_q15(q15_a, q15_b, q15_dst, PATTERN_LENGTH))
+BENCHMARK(vec_mult_q15, zdsp_mult_q15(q15_a, q15_b, q15_dst, PATTERN_LENGTH))
+BENCHMARK(vec_scale_q15, zdsp_scale_q15(q15_a, 0x4000, 1, q15_dst, PATTERN_LENGTH))
+BENCHMARK(vec_dot_prod_q15, zdsp_dot_prod_q15(q15_a, q15_b, PATTERN_LENGTH, &q63_result))
+
+BENCHMARK(vec_add_q31, zdsp_add_q31(q31_a, q31_b, q31_dst, PATTERN_LENGTH))
+BENCHMARK(vec_mult_q31, zdsp_mult_q31(q31_a, q31_b, q31_dst, PATTERN_LENGTH))
+BENCHMARK(vec_scale_q31, zdsp_scale_q31(q31_a, 0x40000000, 1, q31_dst, PATTERN_LENGTH))
+BENCHMARK(vec_dot_prod_q31, zdsp_dot_prod_q31(q31_a, q31_b, PATTERN_LENGTH, &q63_result))
+
+BENCHMARK(vec_add_f32, zdsp_add_f32(f32_a, f32_b, f32_dst, PATTERN_LENGTH))
+BENCHMARK(vec_mult_f32, zdsp_mult_f32(f32_a, f32_b, f32_dst, PATTERN_LENGTH))
+BENCHMARK(vec_scale_f32, zdsp_scale_f32(f32_a, 0.5f, f32_dst, PATTERN_LENGTH))
+BENCHMARK(vec_dot_prod_f32, zdsp_dot_prod_f32(f32_a, f32_b, PATTERN_LENGTH, &f32_result))
+
+static void *setup(void)
+{
+	uint32_t state = 0x2545f491;
+
+	/* Any data will do, the kernels take about the same time on all */
+	for (int i = 0; i < PATTERN_LENGTH; i++) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		q7_a[i] = state;
+		q7_b[i] = state >> 8;
+		q15_a[i] = state;
+		q15_b[i] = state >> 16;
+		q31_a[i] = state;
+		q31_b[i] = ~state;
+		f32_a[i] = (float32_t)q15_a[i] / 32768.0f;
+		f32_b[i] = (float32_t)q15_b[i] / 32768.0f;
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(dsp_basicmath_benchmark, NULL, setup, NULL, NULL, NULL);
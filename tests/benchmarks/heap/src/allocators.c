@@ -0,0 +1,229 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Allocators compared by the heap benchmarks.
+ *
+ * All of them manage the same memory, one after the other. The sys_heap based
+ * allocators are not thread safe and take a spinlock, as k_heap does, so that
+ * the costs compare with k_mem_slab and sys_mem_blocks that lock internally.
+ */
+
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/multi_heap.h>
+#include <zephyr/sys/mem_blocks.h>
+
+#include "utils.h"
+
+#define BENCH_MEM_SIZE (BENCH_HEAP_SIZE * BENCH_NUM_CPUS)
+
+static uint8_t __aligned(8) bench_mem[BENCH_MEM_SIZE];
+
+static struct k_spinlock lock;
+
+/* sys_heap */
+
+static struct sys_heap heap;
+
+static void heap_init(size_t max_size)
+{
+	ARG_UNUSED(max_size);
+
+	sys_heap_init(&heap, bench_mem, sizeof(bench_mem));
+}
+
+static void *heap_alloc(size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	void *ptr = sys_heap_alloc(&heap, size);
+
+	k_spin_unlock(&lock, key);
+
+	return ptr;
+}
+
+static void heap_free(void *ptr, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	ARG_UNUSED(size);
+
+	sys_heap_free(&heap, ptr);
+	k_spin_unlock(&lock, key);
+}
+
+static size_t heap_used(void)
+{
+	struct sys_memory_stats stats;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	k_spin_unlock(&lock, key);
+
+	return stats.allocated_bytes;
+}
+
+/* k_mem_slab, with blocks of the largest request of the trace */
+
+static struct k_mem_slab slab;
+
+static void slab_init(size_t max_size)
+{
+	size_t block_size = ROUND_UP(max_size, 8);
+
+	(void)k_mem_slab_init(&slab, bench_mem, block_size,
+			      sizeof(bench_mem) / block_size);
+}
+
+static void *slab_alloc(size_t size)
+{
+	void *ptr;
+
+	ARG_UNUSED(size);
+
+	return k_mem_slab_alloc(&slab, &ptr, K_NO_WAIT) == 0 ? ptr : NULL;
+}
+
+static void slab_free(void *ptr, size_t size)
+{
+	ARG_UNUSED(size);
+
+	k_mem_slab_free(&slab, ptr);
+}
+
+static size_t slab_used(void)
+{
+	return k_mem_slab_num_used_get(&slab) * slab.info.block_size;
+}
+
+/* sys_mem_blocks, a request taking contiguous blocks */
+
+SYS_MEM_BLOCKS_DEFINE_STATIC_WITH_EXT_BUF(blocks, BENCH_MEM_BLOCK_SIZE,
+					  BENCH_MEM_SIZE / BENCH_MEM_BLOCK_SIZE,
+					  bench_mem);
+
+static atomic_t blocks_count;
+
+static void blocks_init(size_t max_size)
+{
+	ARG_UNUSED(max_size);
+
+	atomic_clear(&blocks_count);
+}
+
+static void *blocks_alloc(size_t size)
+{
+	size_t count = DIV_ROUND_UP(size, BENCH_MEM_BLOCK_SIZE);
+	void *ptr;
+
+	if (sys_mem_blocks_alloc_contiguous(&blocks, count, &ptr) != 0) {
+		return NULL;
+	}
+
+	atomic_add(&blocks_count, count);
+
+	return ptr;
+}
+
+static void blocks_free(void *ptr, size_t size)
+{
+	size_t count = DIV_ROUND_UP(size, BENCH_MEM_BLOCK_SIZE);
+
+	(void)sys_mem_blocks_free_contiguous(&blocks, ptr, count);
+	atomic_sub(&blocks_count, count);
+}
+
+static size_t blocks_used(void)
+{
+	return atomic_get(&blocks_count) * BENCH_MEM_BLOCK_SIZE;
+}
+
+/*
+ * sys_multi_heap, over a heap for the small requests in the first quarter of
+ * the memory and a heap for the others in the rest, each request falling
+ * back to the other heap when its own one is full.
+ */
+
+#define MULTI_SMALL_MAX 256
+
+static struct sys_multi_heap multi;
+static struct sys_heap multi_heaps[2];
+
+static void *multi_choice(struct sys_multi_heap *mheap, void *cfg, size_t align,
+			  size_t size)
+{
+	unsigned int first = size <= MULTI_SMALL_MAX ? 0 : 1;
+	void *ptr;
+
+	ARG_UNUSED(mheap);
+	ARG_UNUSED(cfg);
+	ARG_UNUSED(align);
+
+	ptr = sys_heap_alloc(&multi_heaps[first], size);
+	if (ptr == NULL) {
+		ptr = sys_heap_alloc(&multi_heaps[!first], size);
+	}
+
+	return ptr;
+}
+
+static void multi_init(size_t max_size)
+{
+	ARG_UNUSED(max_size);
+
+	sys_heap_init(&multi_heaps[0], bench_mem, sizeof(bench_mem) / 4);
+	sys_heap_init(&multi_heaps[1], &bench_mem[sizeof(bench_mem) / 4],
+		      sizeof(bench_mem) - sizeof(bench_mem) / 4);
+
+	sys_multi_heap_init(&multi, multi_choice);
+	sys_multi_heap_add_heap(&multi, &multi_heaps[0], NULL);
+	sys_multi_heap_add_heap(&multi, &multi_heaps[1], NULL);
+}
+
+static void *multi_alloc(size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	void *ptr = sys_multi_heap_alloc(&multi, NULL, size);
+
+	k_spin_unlock(&lock, key);
+
+	return ptr;
+}
+
+static void multi_free(void *ptr, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	ARG_UNUSED(size);
+
+	sys_multi_heap_free(&multi, ptr);
+	k_spin_unlock(&lock, key);
+}
+
+static size_t multi_used(void)
+{
+	struct sys_memory_stats stats;
+	size_t used = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (int i = 0; i < ARRAY_SIZE(multi_heaps); i++) {
+		sys_heap_runtime_stats_get(&multi_heaps[i], &stats);
+		used += stats.allocated_bytes;
+	}
+	k_spin_unlock(&lock, key);
+
+	return used;
+}
+
+const struct bench_allocator bench_allocators[] = {
+	{ "sys_heap", heap_init, heap_alloc, heap_free, heap_used },
+	{ "k_mem_slab", slab_init, slab_alloc, slab_free, slab_used },
+	{ "sys_mem_blocks", blocks_init, blocks_alloc, blocks_free, blocks_used },
+	{ "multi_heap", multi_init, multi_alloc, multi_free, multi_used },
+};
+
+const size_t bench_num_allocators = ARRAY_SIZE(bench_allocators);
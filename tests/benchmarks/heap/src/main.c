@@ -0,0 +1,224 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main module of the heap allocator benchmarks: it
+ * replays each trace against each allocator, on all the CPUs at once.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+
+#include "utils.h"
+
+#define BENCH_STACK_SIZE 1024
+
+struct bench_result {
+	uint64_t alloc_cycles;
+	uint64_t free_cycles;
+	uint32_t alloc_max;
+	uint32_t free_max;
+	uint32_t allocs;
+	uint32_t frees;
+	uint32_t failed;
+};
+
+int error_count;
+
+static struct bench_op ops[BENCH_TRACE_OPS];
+static size_t num_ops;
+
+static void *slots[BENCH_NUM_CPUS][BENCH_SLOTS];
+static uint16_t slot_sizes[BENCH_NUM_CPUS][BENCH_SLOTS];
+static struct bench_result results[BENCH_NUM_CPUS];
+
+/* Memory used and requested when the allocator used the most */
+static struct k_spinlock peak_lock;
+static atomic_t requested;
+static size_t peak_used;
+static size_t peak_requested;
+
+static void track_peak(const struct bench_allocator *allocator)
+{
+	size_t used = allocator->used();
+	k_spinlock_key_t key = k_spin_lock(&peak_lock);
+
+	if (used > peak_used) {
+		peak_used = used;
+		/* Frees on other CPUs may not be accounted for yet */
+		peak_requested = MIN(atomic_get(&requested), used);
+	}
+
+	k_spin_unlock(&peak_lock, key);
+}
+
+static void replay(const struct bench_allocator *allocator, unsigned int cpu)
+{
+	struct bench_result *result = &results[cpu];
+	void **live = slots[cpu];
+	uint16_t *sizes = slot_sizes[cpu];
+	timing_t start, end;
+	uint32_t cycles;
+
+	for (size_t i = 0; i < num_ops; i++) {
+		const struct bench_op *op = &ops[i];
+
+		if (op->size != 0) {
+			start = timing_counter_get();
+			live[op->slot] = allocator->alloc(op->size);
+			end = timing_counter_get();
+
+			if (live[op->slot] == NULL) {
+				result->failed++;
+				continue;
+			}
+
+			cycles = timing_cycles_get(&start, &end);
+			result->alloc_cycles += cycles;
+			result->alloc_max = MAX(result->alloc_max, cycles);
+			result->allocs++;
+
+			sizes[op->slot] = op->size;
+			atomic_add(&requested, op->size);
+			track_peak(allocator);
+		} else if (live[op->slot] != NULL) {
+			start = timing_counter_get();
+			allocator->free(live[op->slot], sizes[op->slot]);
+			end = timing_counter_get();
+			live[op->slot] = NULL;
+
+			cycles = timing_cycles_get(&start, &end);
+			result->free_cycles += cycles;
+			result->free_max = MAX(result->free_max, cycles);
+			result->frees++;
+
+			atomic_sub(&requested, sizes[op->slot]);
+		}
+	}
+}
+
+#if BENCH_NUM_CPUS > 1
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, BENCH_NUM_CPUS - 1, BENCH_STACK_SIZE);
+static struct k_thread threads[BENCH_NUM_CPUS - 1];
+static atomic_t go;
+
+static void replay_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&go)) {
+		/* Wait for all the CPUs */
+	}
+
+	replay(p1, POINTER_TO_UINT(p2));
+}
+#endif
+
+static void replay_all(const struct bench_allocator *allocator)
+{
+#if BENCH_NUM_CPUS > 1
+	unsigned int num_cpus = arch_num_cpus();
+
+	atomic_clear(&go);
+
+	/* At the priority of the main thread, so each one gets its own CPU */
+	for (unsigned int cpu = 1; cpu < num_cpus; cpu++) {
+		k_thread_create(&threads[cpu - 1], stacks[cpu - 1],
+				K_THREAD_STACK_SIZEOF(stacks[cpu - 1]), replay_thread,
+				(void *)allocator, UINT_TO_POINTER(cpu), NULL,
+				k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	}
+
+	atomic_set(&go, 1);
+	replay(allocator, 0);
+
+	for (unsigned int cpu = 1; cpu < num_cpus; cpu++) {
+		k_thread_join(&threads[cpu - 1], K_FOREVER);
+	}
+#else
+	replay(allocator, 0);
+#endif
+}
+
+static void bench_run(const struct bench_trace *trace,
+		      const struct bench_allocator *allocator, size_t max_size)
+{
+	struct bench_result total = { 0 };
+	char metric[48];
+	char summary[80];
+
+	memset(results, 0, sizeof(results));
+	memset(slots, 0, sizeof(slots));
+	atomic_clear(&requested);
+	peak_used = 0;
+	peak_requested = 0;
+
+	allocator->init(max_size);
+	replay_all(allocator);
+
+	for (unsigned int cpu = 0; cpu < BENCH_NUM_CPUS; cpu++) {
+		total.alloc_cycles += results[cpu].alloc_cycles;
+		total.free_cycles += results[cpu].free_cycles;
+		total.alloc_max = MAX(total.alloc_max, results[cpu].alloc_max);
+		total.free_max = MAX(total.free_max, results[cpu].free_max);
+		total.allocs += results[cpu].allocs;
+		total.frees += results[cpu].frees;
+		total.failed += results[cpu].failed;
+	}
+
+	snprintk(metric, sizeof(metric), "heap.%s.%s", trace->name, allocator->name);
+
+	if (total.allocs == 0) {
+		bench_fail(metric, "no allocation succeeded");
+		return;
+	}
+
+	if (total.frees != total.allocs || allocator->used() != 0) {
+		bench_fail(metric, "memory leaked");
+	}
+
+	bench_report(metric, "Average alloc", total.alloc_cycles, total.allocs);
+	bench_report(metric, "Worst-case alloc", total.alloc_max, 1);
+	bench_report(metric, "Average free", total.free_cycles, total.frees);
+	bench_report(metric, "Worst-case free", total.free_max, 1);
+
+	/* The share of the memory used at the peak that was not requested */
+	snprintk(summary, sizeof(summary), "%s - Peak fragmentation", metric);
+	printk("%-70s:%8u %% ,%8u failed allocations\n", summary,
+	       (uint32_t)((peak_used - peak_requested) * 100 / peak_used), total.failed);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	TC_START("Heap allocator benchmark");
+
+	for (size_t t = 0; t < bench_num_traces; t++) {
+		const struct bench_trace *trace = &bench_traces[t];
+		size_t max_size = 0;
+
+		num_ops = trace->generate(ops, ARRAY_SIZE(ops));
+
+		for (size_t i = 0; i < num_ops; i++) {
+			max_size = MAX(max_size, ops[i].size);
+		}
+
+		for (size_t a = 0; a < bench_num_allocators; a++) {
+			bench_run(trace, &bench_allocators[a], max_size);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+
+	return 0;
+}
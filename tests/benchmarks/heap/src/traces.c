@@ -0,0 +1,147 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Allocation traces replayed by the heap benchmarks.
+ *
+ * The traces come from a fixed seed, so that all the allocators, and all the
+ * runs, see the very same sequence of requests.
+ */
+
+#include "utils.h"
+
+static uint32_t trace_seed;
+
+static uint32_t trace_rand(void)
+{
+	/* xorshift32 */
+	trace_seed ^= trace_seed << 13;
+	trace_seed ^= trace_seed >> 17;
+	trace_seed ^= trace_seed << 5;
+
+	return trace_seed;
+}
+
+/* Random value in [min, max] */
+static uint16_t trace_range(uint16_t min, uint16_t max)
+{
+	return min + trace_rand() % (max - min + 1);
+}
+
+/*
+ * Network stack: bursts of up to 8 packets received back to back, half small
+ * control packets and half full sized frames, processed and freed in their
+ * order of arrival.
+ */
+static size_t net_burst_generate(struct bench_op *ops, size_t max_ops)
+{
+	size_t n = 0;
+
+	trace_seed = 0x6e657462;
+
+	while (n + 2 * 8 <= max_ops) {
+		uint16_t burst = trace_range(1, 8);
+
+		for (uint16_t i = 0; i < burst; i++) {
+			ops[n].slot = i;
+			ops[n++].size = (trace_rand() & 1) ? trace_range(64, 128)
+							   : trace_range(1280, 1536);
+		}
+
+		for (uint16_t i = 0; i < burst; i++) {
+			ops[n].slot = i;
+			ops[n++].size = 0;
+		}
+	}
+
+	return n;
+}
+
+/*
+ * JSON/CBOR decoding: a document is parsed into a tree of small nodes, one
+ * in eight holding a longer string, and the whole tree is freed once used,
+ * from the root down, that is in the order of allocation.
+ */
+static size_t parse_free_generate(struct bench_op *ops, size_t max_ops)
+{
+	size_t n = 0;
+
+	trace_seed = 0x6a736f6e;
+
+	while (n + 2 * BENCH_SLOTS <= max_ops) {
+		uint16_t nodes = trace_range(BENCH_SLOTS / 4, BENCH_SLOTS);
+
+		for (uint16_t i = 0; i < nodes; i++) {
+			ops[n].slot = i;
+			ops[n++].size = (trace_rand() % 8 == 0) ? trace_range(64, 192)
+								: trace_range(16, 64);
+		}
+
+		for (uint16_t i = 0; i < nodes; i++) {
+			ops[n].slot = i;
+			ops[n++].size = 0;
+		}
+	}
+
+	return n;
+}
+
+#define MIX_LONG_SLOTS 8
+#define MIX_SHORT_SLOTS 32
+
+/*
+ * Application mix: a few long-lived buffers, replaced from time to time,
+ * between which short-lived allocations come and go. This is the pattern
+ * that fragments a heap the most.
+ */
+static size_t mixed_generate(struct bench_op *ops, size_t max_ops)
+{
+	bool live[MIX_LONG_SLOTS + MIX_SHORT_SLOTS] = { false };
+	size_t n = 0;
+	uint16_t slot;
+
+	trace_seed = 0x6d697865;
+
+	for (slot = 0; slot < MIX_LONG_SLOTS; slot++) {
+		ops[n].slot = slot;
+		ops[n++].size = trace_range(128, 768);
+	}
+
+	/* Room for a replacement and for freeing everything at the end */
+	while (n + 2 + ARRAY_SIZE(live) <= max_ops) {
+		if (n % 64 == 0) {
+			slot = trace_range(0, MIX_LONG_SLOTS - 1);
+			ops[n].slot = slot;
+			ops[n++].size = 0;
+			ops[n].slot = slot;
+			ops[n++].size = trace_range(128, 768);
+			continue;
+		}
+
+		slot = trace_range(MIX_LONG_SLOTS, ARRAY_SIZE(live) - 1);
+		ops[n].slot = slot;
+		ops[n++].size = live[slot] ? 0 : trace_range(16, 256);
+		live[slot] = !live[slot];
+	}
+
+	for (slot = 0; slot < ARRAY_SIZE(live); slot++) {
+		if (slot < MIX_LONG_SLOTS || live[slot]) {
+			ops[n].slot = slot;
+			ops[n++].size = 0;
+		}
+	}
+
+	return n;
+}
+
+const struct bench_trace bench_traces[] = {
+	{ "net_burst", net_burst_generate },
+	{ "parse_free", parse_free_generate },
+	{ "mixed", mixed_generate },
+};
+
+const size_t bench_num_traces = ARRAY_SIZE(bench_traces);
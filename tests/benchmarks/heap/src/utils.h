@@ -0,0 +1,62 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _HEAP_BENCH_UTILS_H
+#define _HEAP_BENCH_UTILS_H
+
+/*
+ * @brief Helpers shared by the heap allocator benchmarks
+ */
+
+#include <zephyr/kernel.h>
+#include <bench_utils.h>
+
+/* Memory given to each allocator, per CPU replaying the traces */
+#define BENCH_HEAP_SIZE 16384
+
+/* Maximum number of operations of a trace */
+#define BENCH_TRACE_OPS 2048
+
+/* Maximum number of allocations of a trace alive at once */
+#define BENCH_SLOTS 64
+
+/* Granularity of the sys_mem_blocks allocator, a power of two */
+#define BENCH_MEM_BLOCK_SIZE 32
+
+#define BENCH_NUM_CPUS CONFIG_MP_MAX_NUM_CPUS
+
+/**
+ * One step of an allocation trace: allocate @a size bytes for @a slot, or
+ * free the allocation of @a slot if @a size is 0.
+ */
+struct bench_op {
+	uint16_t slot;
+	uint16_t size;
+};
+
+struct bench_trace {
+	const char *name;
+	/* Fill the operations, return their number */
+	size_t (*generate)(struct bench_op *ops, size_t max_ops);
+};
+
+struct bench_allocator {
+	const char *name;
+	/* Prepare the allocator for requests of up to @p max_size bytes */
+	void (*init)(size_t max_size);
+	void *(*alloc)(size_t size);
+	void (*free)(void *ptr, size_t size);
+	/* Bytes of memory taken by the live allocations, with the overhead */
+	size_t (*used)(void);
+};
+
+extern const struct bench_trace bench_traces[];
+extern const size_t bench_num_traces;
+
+extern const struct bench_allocator bench_allocators[];
+extern const size_t bench_num_allocators;
+
+#endif /* _HEAP_BENCH_UTILS_H */
@@ -0,0 +1,54 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_BENCHMARKS_INCLUDE_BENCH_UTILS_H_
+#define ZEPHYR_TESTS_BENCHMARKS_INCLUDE_BENCH_UTILS_H_
+
+/*
+ * @brief Reporting helpers shared by the benchmarks
+ *
+ * A benchmark including this header defines error_count, the number of
+ * failed measurements.
+ */
+
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/printk.h>
+
+extern int error_count;
+
+/**
+ * @brief Display the average cost of one operation
+ *
+ * The line has the same layout as the ones of the latency_measure benchmark,
+ * "<metric> - <description>: <cycles> cycles , <ns> ns", so that the same
+ * tools can record and compare the results of both.
+ */
+static inline void bench_report(const char *metric, const char *description,
+				uint64_t cycles, uint32_t count)
+{
+	char summary[80];
+
+	snprintk(summary, sizeof(summary), "%s - %s", metric, description);
+	printk("%-70s:%8u cycles ,%8u ns\n", summary, (uint32_t)(cycles / count),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, count));
+}
+
+/* Cycles elapsed since @p start */
+static inline uint64_t bench_cycles_since(timing_t *start)
+{
+	timing_t end = timing_counter_get();
+
+	return timing_cycles_get(start, &end);
+}
+
+/* Report a failed measurement */
+static inline void bench_fail(const char *metric, const char *reason)
+{
+	printk("%s - FAILED: %s\n", metric, reason);
+	error_count++;
+}
+
+#endif /* ZEPHYR_TESTS_BENCHMARKS_INCLUDE_BENCH_UTILS_H_ */
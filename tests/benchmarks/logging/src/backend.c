@@ -0,0 +1,85 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Backend of the logging benchmarks: it formats the messages as a real
+ * backend would, timing the formatting, and throws the output away.
+ */
+
+#include <string.h>
+
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
+
+#include "utils.h"
+
+#define BENCH_OUTPUT_FLAGS (LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP | \
+			    LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP)
+
+struct bench_backend_stats bench_backend_stats;
+
+static uint8_t output_buf[64];
+
+static int output_func(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(ctx);
+
+	bench_backend_stats.bytes += length;
+
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(bench_output, output_func, output_buf, sizeof(output_buf));
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	timing_t start = timing_counter_get();
+
+	ARG_UNUSED(backend);
+
+	if (IS_ENABLED(CONFIG_BENCH_LOG_DICTIONARY)) {
+		log_dict_output_msg_process(&bench_output, &msg->log, BENCH_OUTPUT_FLAGS);
+	} else {
+		log_output_msg_process(&bench_output, &msg->log, BENCH_OUTPUT_FLAGS);
+	}
+
+	bench_backend_stats.format_cycles += bench_cycles_since(&start);
+	bench_backend_stats.messages++;
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	bench_backend_stats.dropped += cnt;
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = process,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+void bench_backend_reset(void)
+{
+	(void)bench_log_flush();
+	memset(&bench_backend_stats, 0, sizeof(bench_backend_stats));
+}
+
+uint64_t bench_log_flush(void)
+{
+	timing_t start = timing_counter_get();
+
+	while (log_process()) {
+	}
+
+	return bench_cycles_since(&start);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Cost of a message with 0 to 6 arguments, on the side of the caller, in the
+ * processing and in the formatting by the backend.
+ */
+
+#include <zephyr/logging/log.h>
+
+#include "utils.h"
+
+LOG_MODULE_REGISTER(bench_caller, LOG_LEVEL_INF);
+
+#define BENCH_ARG_FORMAT(i, _) " %d"
+#define BENCH_ARG_VALUE(i, _) , i
+
+#define BENCH_LOG_INF(nargs) \
+	LOG_INF("message" LISTIFY(nargs, BENCH_ARG_FORMAT, ()) LISTIFY(nargs, BENCH_ARG_VALUE, ()))
+
+static void log_0_args(void) { BENCH_LOG_INF(0); }
+static void log_1_args(void) { BENCH_LOG_INF(1); }
+static void log_2_args(void) { BENCH_LOG_INF(2); }
+static void log_3_args(void) { BENCH_LOG_INF(3); }
+static void log_4_args(void) { BENCH_LOG_INF(4); }
+static void log_5_args(void) { BENCH_LOG_INF(5); }
+static void log_6_args(void) { BENCH_LOG_INF(6); }
+
+static void (*const log_funcs[BENCH_MAX_ARGS + 1])(void) = {
+	log_0_args, log_1_args, log_2_args, log_3_args, log_4_args, log_5_args, log_6_args,
+};
+
+void bench_caller(void)
+{
+	for (int nargs = 0; nargs <= BENCH_MAX_ARGS; nargs++) {
+		uint64_t caller_cycles = 0;
+		uint64_t process_cycles = 0;
+		uint32_t count = 0;
+		char metric[32];
+		char summary[80];
+		timing_t start;
+
+		snprintk(metric, sizeof(metric), "log.%dargs", nargs);
+		bench_backend_reset();
+
+		while (count < BENCH_ITERATIONS) {
+			for (int i = 0; i < BENCH_BATCH; i++) {
+				start = timing_counter_get();
+				log_funcs[nargs]();
+				caller_cycles += bench_cycles_since(&start);
+			}
+
+			count += BENCH_BATCH;
+			process_cycles += bench_log_flush();
+		}
+
+		if (bench_backend_stats.messages != count || bench_backend_stats.dropped != 0) {
+			bench_fail(metric, "messages lost");
+			continue;
+		}
+
+		bench_report(metric, "LOG_INF, caller side", caller_cycles, count);
+
+		if (!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+			bench_report(metric, "Processing, backend included", process_cycles, count);
+			bench_report(metric, "End to end", caller_cycles + process_cycles, count);
+		}
+
+		bench_report(metric, "Formatting by the backend",
+			     bench_backend_stats.format_cycles, count);
+
+		snprintk(summary, sizeof(summary), "%s - Formatting throughput", metric);
+		printk("%-70s:%8u bytes/s\n", summary,
+		       (uint32_t)((uint64_t)bench_backend_stats.bytes * NSEC_PER_SEC /
+				  MAX(timing_cycles_to_ns(bench_backend_stats.format_cycles), 1)));
+	}
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Cost of a message while 1 to 4 threads and a timer ISR log at once, all of
+ * them contending for the buffer of the messages.
+ */
+
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+#include "utils.h"
+
+LOG_MODULE_REGISTER(bench_contention, LOG_LEVEL_INF);
+
+#define BENCH_MAX_PRODUCERS 4
+#define BENCH_PRODUCER_PRIO K_PRIO_PREEMPT(4)
+
+struct producer_stats {
+	uint64_t cycles;
+	uint32_t max;
+	uint32_t count;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, BENCH_MAX_PRODUCERS, 1024);
+static struct k_thread threads[BENCH_MAX_PRODUCERS];
+static struct producer_stats stats[BENCH_MAX_PRODUCERS];
+static struct producer_stats isr_stats;
+static atomic_t running;
+
+static void producer_stats_add(struct producer_stats *s, uint32_t cycles)
+{
+	s->cycles += cycles;
+	s->max = MAX(s->max, cycles);
+	s->count++;
+}
+
+static void isr_producer(struct k_timer *timer)
+{
+	timing_t start = timing_counter_get();
+
+	ARG_UNUSED(timer);
+
+	LOG_INF("isr message %u", isr_stats.count);
+	producer_stats_add(&isr_stats, bench_cycles_since(&start));
+}
+
+static K_TIMER_DEFINE(isr_timer, isr_producer, NULL);
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	struct producer_stats *s = &stats[POINTER_TO_UINT(p1)];
+	timing_t start;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		start = timing_counter_get();
+		LOG_INF("producer %u message %d", POINTER_TO_UINT(p1), i);
+		producer_stats_add(s, bench_cycles_since(&start));
+
+		/* Leave time to the main thread to process the messages */
+		if (i % BENCH_BATCH == BENCH_BATCH - 1) {
+			k_sleep(K_TICKS(1));
+		}
+	}
+
+	atomic_dec(&running);
+}
+
+void bench_contention(void)
+{
+	for (int num = 1; num <= BENCH_MAX_PRODUCERS; num++) {
+		struct producer_stats total = { 0 };
+		char metric[32];
+		char summary[80];
+
+		snprintk(metric, sizeof(metric), "log.contention.%dproducers", num);
+		bench_backend_reset();
+		memset(stats, 0, sizeof(stats));
+		memset(&isr_stats, 0, sizeof(isr_stats));
+		atomic_set(&running, num);
+
+		for (int i = 0; i < num; i++) {
+			k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]),
+					producer, UINT_TO_POINTER(i), NULL, NULL,
+					BENCH_PRODUCER_PRIO, 0, K_NO_WAIT);
+		}
+		k_timer_start(&isr_timer, K_TICKS(1), K_TICKS(1));
+
+		while (atomic_get(&running) != 0) {
+			(void)log_process();
+		}
+
+		k_timer_stop(&isr_timer);
+		for (int i = 0; i < num; i++) {
+			k_thread_join(&threads[i], K_FOREVER);
+			total.cycles += stats[i].cycles;
+			total.max = MAX(total.max, stats[i].max);
+			total.count += stats[i].count;
+		}
+		(void)bench_log_flush();
+
+		bench_report(metric, "LOG_INF from a thread", total.cycles, total.count);
+		bench_report(metric, "Worst-case LOG_INF from a thread", total.max, 1);
+		if (isr_stats.count != 0) {
+			bench_report(metric, "LOG_INF from an ISR", isr_stats.cycles,
+				     isr_stats.count);
+			bench_report(metric, "Worst-case LOG_INF from an ISR", isr_stats.max, 1);
+		}
+
+		snprintk(summary, sizeof(summary), "%s - Dropped messages", metric);
+		printk("%-70s:%8u dropped ,%8u processed\n", summary,
+		       bench_backend_stats.dropped, bench_backend_stats.messages);
+	}
+}
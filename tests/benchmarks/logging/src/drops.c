@@ -0,0 +1,52 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Messages dropped by the deferred mode when the backend does not keep up:
+ * the backend processes a given number of messages per message logged.
+ */
+
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+#include "utils.h"
+
+LOG_MODULE_REGISTER(bench_drops, LOG_LEVEL_INF);
+
+/* Messages processed per message logged, in quarters */
+static const uint8_t bandwidths[] = { 1, 2, 3, 4 };
+
+void bench_drops(void)
+{
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		/* Nothing is ever dropped */
+		return;
+	}
+
+	for (int b = 0; b < ARRAY_SIZE(bandwidths); b++) {
+		uint32_t credit = 0;
+		char summary[80];
+
+		bench_backend_reset();
+
+		for (int i = 0; i < BENCH_ITERATIONS; i++) {
+			LOG_INF("message %d %d", i, b);
+
+			for (credit += bandwidths[b]; credit >= 4; credit -= 4) {
+				(void)log_process();
+			}
+		}
+
+		(void)bench_log_flush();
+
+		snprintk(summary, sizeof(summary),
+			 "log.drops.bandwidth%d - Backend at %d%% of the logging rate",
+			 bandwidths[b] * 25, bandwidths[b] * 25);
+		printk("%-70s:%8u dropped ,%8u processed\n", summary,
+		       bench_backend_stats.dropped, bench_backend_stats.messages);
+	}
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main module of the logging benchmarks.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+
+#include "utils.h"
+
+int error_count;
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	TC_START("Logging benchmark");
+
+	printk("Logging mode: %s%s\n",
+	       IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE) ? "immediate" : "deferred",
+	       IS_ENABLED(CONFIG_BENCH_LOG_DICTIONARY) ? ", dictionary" : "");
+
+	bench_caller();
+	bench_contention();
+	bench_drops();
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+
+	return 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _LOGGING_BENCH_UTILS_H
+#define _LOGGING_BENCH_UTILS_H
+
+/*
+ * @brief Helpers shared by the logging benchmarks
+ */
+
+#include <zephyr/kernel.h>
+#include <bench_utils.h>
+
+/* Number of messages averaged by each measurement */
+#define BENCH_ITERATIONS 1000
+
+/* Messages logged before processing them, so that they fit in the buffer */
+#define BENCH_BATCH 16
+
+/* Largest number of arguments of the measured messages */
+#define BENCH_MAX_ARGS 6
+
+/* What the benchmark backend did since the last bench_backend_reset() */
+struct bench_backend_stats {
+	/* Cycles spent formatting the messages */
+	uint64_t format_cycles;
+	uint32_t messages;
+	uint32_t bytes;
+	uint32_t dropped;
+};
+
+extern struct bench_backend_stats bench_backend_stats;
+
+void bench_backend_reset(void);
+
+/* Process all the pending messages, return the cycles taken */
+uint64_t bench_log_flush(void);
+
+void bench_caller(void);
+void bench_contention(void);
+void bench_drops(void);
+
+#endif /* _LOGGING_BENCH_UTILS_H */
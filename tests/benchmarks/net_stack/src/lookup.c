@@ -0,0 +1,154 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the IPv6 neighbor and route lookups, with full tables.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+
+#include "ipv6.h"
+#include "route.h"
+#include "utils.h"
+
+static uint8_t peer_mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+static struct net_linkaddr peer_lladdr = {
+	.addr = peer_mac,
+	.len = sizeof(peer_mac),
+	.type = NET_LINK_DUMMY,
+};
+
+/* 2001:db8:<table>::<index>, or the <index>:th /64 prefix of the table */
+static void bench_addr(struct in6_addr *addr, uint16_t table, uint16_t index,
+		       bool prefix)
+{
+	net_ipv6_addr_create(addr, 0x2001, 0x0db8, table, prefix ? index : 0,
+			     0, 0, 0, prefix ? 1 : index);
+}
+
+static void bench_lookup_nbr(const char *metric, const char *description,
+			     struct net_if *iface, struct in6_addr *addr)
+{
+	timing_t start;
+	uint64_t cycles;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		(void)net_ipv6_nbr_lookup(iface, addr);
+	}
+
+	cycles = bench_cycles_since(&start);
+
+	bench_report(metric, description, cycles, BENCH_ITERATIONS);
+}
+
+void bench_nbr_lookup(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct in6_addr addr;
+	int count;
+
+	if (!IS_ENABLED(CONFIG_NET_IPV6_NBR_CACHE)) {
+		return;
+	}
+
+	for (count = 1; count <= CONFIG_NET_IPV6_MAX_NEIGHBORS; count++) {
+		bench_addr(&addr, 1, count, false);
+
+		if (net_ipv6_nbr_add(iface, &addr, &peer_lladdr, false,
+				     NET_IPV6_NBR_STATE_STATIC) == NULL) {
+			break;
+		}
+	}
+
+	if (--count == 0) {
+		bench_fail("nbr.lookup", "cannot add neighbors");
+		return;
+	}
+
+	bench_addr(&addr, 1, count, false);
+	bench_lookup_nbr("nbr.lookup.hit",
+			 "Look up the last of a full neighbor cache",
+			 iface, &addr);
+
+	bench_addr(&addr, 1, count + 1, false);
+	bench_lookup_nbr("nbr.lookup.miss",
+			 "Look up a missing neighbor in a full cache",
+			 iface, &addr);
+
+	while (count > 0) {
+		bench_addr(&addr, 1, count--, false);
+		(void)net_ipv6_nbr_rm(iface, &addr);
+	}
+}
+
+static void bench_lookup_route(const char *metric, const char *description,
+			       struct net_if *iface, struct in6_addr *addr)
+{
+	timing_t start;
+	uint64_t cycles;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		(void)net_route_lookup(iface, addr);
+	}
+
+	cycles = bench_cycles_since(&start);
+
+	bench_report(metric, description, cycles, BENCH_ITERATIONS);
+}
+
+void bench_route_lookup(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct in6_addr nexthop;
+	struct in6_addr addr;
+	int count;
+
+	if (!IS_ENABLED(CONFIG_NET_ROUTE)) {
+		return;
+	}
+
+	bench_addr(&nexthop, 1, 1, false);
+
+	if (net_ipv6_nbr_add(iface, &nexthop, &peer_lladdr, true,
+			     NET_IPV6_NBR_STATE_STATIC) == NULL) {
+		bench_fail("route.lookup", "cannot add the next hop");
+		return;
+	}
+
+	for (count = 1; count <= CONFIG_NET_MAX_ROUTES; count++) {
+		bench_addr(&addr, 2, count, true);
+
+		if (net_route_add(iface, &addr, 64, &nexthop,
+				  NET_IPV6_ND_INFINITE_LIFETIME,
+				  NET_ROUTE_PREFERENCE_LOW) == NULL) {
+			break;
+		}
+	}
+
+	if (--count == 0) {
+		bench_fail("route.lookup", "cannot add routes");
+	} else {
+		bench_addr(&addr, 2, count, true);
+		bench_lookup_route("route.lookup.hit",
+				   "Look up the last of a full route table",
+				   iface, &addr);
+
+		bench_addr(&addr, 2, count + 1, true);
+		bench_lookup_route("route.lookup.miss",
+				   "Look up a missing route in a full table",
+				   iface, &addr);
+	}
+
+	(void)net_route_del_by_nexthop(iface, &nexthop);
+	(void)net_ipv6_nbr_rm(iface, &nexthop);
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main module of the network stack benchmarks.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+
+#include "utils.h"
+
+int error_count;
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	TC_START("Network stack benchmark");
+
+	bench_pkt();
+	bench_checksum();
+	bench_nbr_lookup();
+	bench_route_lookup();
+	bench_udp();
+	bench_udp_demux();
+	bench_tcp_bulk();
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+
+	return 0;
+}
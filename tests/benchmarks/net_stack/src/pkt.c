@@ -0,0 +1,86 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the packet allocation and the checksum computation.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "utils.h"
+
+static void bench_pkt_size(const char *metric, const char *description,
+			   size_t size)
+{
+	struct net_if *iface = net_if_get_default();
+	struct net_pkt *pkt;
+	timing_t start;
+	uint64_t cycles;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		pkt = net_pkt_alloc_with_buffer(iface, size, AF_INET,
+						IPPROTO_UDP, K_NO_WAIT);
+		if (pkt == NULL) {
+			bench_fail(metric, "out of packets");
+			return;
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	cycles = bench_cycles_since(&start);
+
+	bench_report(metric, description, cycles, BENCH_ITERATIONS);
+}
+
+void bench_pkt(void)
+{
+	bench_pkt_size("net_pkt.alloc_free.64",
+		       "Allocate and free a packet of 64 bytes", 64);
+	bench_pkt_size("net_pkt.alloc_free.1024",
+		       "Allocate and free a packet of 1024 bytes", 1024);
+}
+
+static uint8_t chksum_data[1500];
+
+/* The checksum of n bytes costs "cycles" cycles, that is n / cycles bytes
+ * per cycle. The sizes are the ones of a small, a minimum IPv4 MTU and an
+ * Ethernet MTU packet.
+ */
+static void bench_checksum_size(const char *metric, const char *description,
+				size_t size)
+{
+	volatile uint16_t sum = 0U;
+	timing_t start;
+	uint64_t cycles;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		sum = calc_chksum(sum, chksum_data, size);
+	}
+
+	cycles = bench_cycles_since(&start);
+
+	bench_report(metric, description, cycles, BENCH_ITERATIONS);
+}
+
+void bench_checksum(void)
+{
+	for (int i = 0; i < sizeof(chksum_data); i++) {
+		chksum_data[i] = i;
+	}
+
+	bench_checksum_size("checksum.64", "Internet checksum of 64 bytes", 64);
+	bench_checksum_size("checksum.576", "Internet checksum of 576 bytes", 576);
+	bench_checksum_size("checksum.1500", "Internet checksum of 1500 bytes", 1500);
+}
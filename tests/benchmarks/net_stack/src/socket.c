@@ -0,0 +1,291 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the packet path through the stack with sockets on the loopback
+ * interface: UDP round trips, the connection demux and TCP bulk transfer.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+
+#include "utils.h"
+
+#define UDP_PORT 4242
+#define UDP_DEMUX_PORT 5000
+#define UDP_PAYLOAD 64
+
+#define TCP_PORT 4243
+#define TCP_CHUNK 1024
+#define TCP_BYTES (256 * 1024)
+
+static uint8_t tx_buf[TCP_CHUNK];
+static uint8_t rx_buf[TCP_CHUNK];
+
+static void loopback_addr(sa_family_t family, uint16_t port,
+			  struct sockaddr_storage *addr, socklen_t *addrlen)
+{
+	(void)memset(addr, 0, sizeof(*addr));
+
+	if (family == AF_INET) {
+		struct sockaddr_in *sin = (struct sockaddr_in *)addr;
+		struct in_addr ipv4_loopback = INADDR_LOOPBACK_INIT;
+
+		sin->sin_family = AF_INET;
+		sin->sin_port = htons(port);
+		sin->sin_addr = ipv4_loopback;
+		*addrlen = sizeof(*sin);
+	} else {
+		struct sockaddr_in6 *sin6 = (struct sockaddr_in6 *)addr;
+
+		sin6->sin6_family = AF_INET6;
+		sin6->sin6_port = htons(port);
+		sin6->sin6_addr = in6addr_loopback;
+		*addrlen = sizeof(*sin6);
+	}
+}
+
+/* UDP socket bound to the loopback address and connected to itself */
+static int udp_self_socket(sa_family_t family, uint16_t port)
+{
+	struct timeval timeo = {
+		.tv_sec = 1,
+	};
+	struct sockaddr_storage addr;
+	socklen_t addrlen;
+	int sock;
+
+	sock = zsock_socket(family, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return -1;
+	}
+
+	loopback_addr(family, port, &addr, &addrlen);
+
+	if (zsock_bind(sock, (struct sockaddr *)&addr, addrlen) < 0 ||
+	    zsock_connect(sock, (struct sockaddr *)&addr, addrlen) < 0 ||
+	    zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeo,
+			     sizeof(timeo)) < 0) {
+		zsock_close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+static void bench_udp_round_trip(const char *metric, const char *description,
+				 sa_family_t family)
+{
+	timing_t start;
+	uint64_t cycles;
+	int sock;
+
+	sock = udp_self_socket(family, UDP_PORT);
+	if (sock < 0) {
+		bench_fail(metric, "cannot create the socket");
+		return;
+	}
+
+	/* Warm up the neighbor and the connection caches */
+	(void)zsock_send(sock, tx_buf, UDP_PAYLOAD, 0);
+	(void)zsock_recv(sock, rx_buf, sizeof(rx_buf), 0);
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		if (zsock_send(sock, tx_buf, UDP_PAYLOAD, 0) != UDP_PAYLOAD ||
+		    zsock_recv(sock, rx_buf, sizeof(rx_buf), 0) != UDP_PAYLOAD) {
+			bench_fail(metric, "packet lost");
+			zsock_close(sock);
+			return;
+		}
+	}
+
+	cycles = bench_cycles_since(&start);
+
+	zsock_close(sock);
+
+	bench_report(metric, description, cycles, BENCH_ITERATIONS);
+}
+
+void bench_udp(void)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4)) {
+		bench_udp_round_trip("udp4.round_trip",
+				     "Send and receive a UDP/IPv4 datagram",
+				     AF_INET);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6)) {
+		bench_udp_round_trip("udp6.round_trip",
+				     "Send and receive a UDP/IPv6 datagram",
+				     AF_INET6);
+	}
+}
+
+/* Compare with udp4.round_trip for the cost of the other connections */
+void bench_udp_demux(void)
+{
+	int socks[BENCH_DEMUX_SOCKETS];
+	int count;
+
+	if (!IS_ENABLED(CONFIG_NET_IPV4)) {
+		return;
+	}
+
+	for (count = 0; count < BENCH_DEMUX_SOCKETS; count++) {
+		socks[count] = udp_self_socket(AF_INET, UDP_DEMUX_PORT + count);
+		if (socks[count] < 0) {
+			break;
+		}
+	}
+
+	if (count < BENCH_DEMUX_SOCKETS) {
+		bench_fail("udp4.demux", "cannot create the sockets");
+	} else {
+		bench_udp_round_trip("udp4.demux." STRINGIFY(BENCH_DEMUX_SOCKETS),
+				     "UDP/IPv4 round trip with "
+				     STRINGIFY(BENCH_DEMUX_SOCKETS)
+				     " other sockets bound",
+				     AF_INET);
+	}
+
+	while (count > 0) {
+		zsock_close(socks[--count]);
+	}
+}
+
+static K_THREAD_STACK_DEFINE(tcp_rx_stack, 1024);
+static struct k_thread tcp_rx_thread;
+static K_SEM_DEFINE(tcp_rx_done, 0, 1);
+static size_t tcp_rx_bytes;
+
+static void tcp_rx(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	ssize_t ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (tcp_rx_bytes < TCP_BYTES) {
+		ret = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		tcp_rx_bytes += ret;
+	}
+
+	k_sem_give(&tcp_rx_done);
+}
+
+static int tcp_send_all(int sock)
+{
+	for (size_t sent = 0; sent < TCP_BYTES; ) {
+		ssize_t ret = zsock_send(sock, tx_buf,
+					 MIN(sizeof(tx_buf), TCP_BYTES - sent), 0);
+
+		if (ret < 0) {
+			return -1;
+		}
+
+		sent += ret;
+	}
+
+	return 0;
+}
+
+void bench_tcp_bulk(void)
+{
+	struct timeval timeo = {
+		.tv_sec = 2,
+	};
+	struct sockaddr_storage addr;
+	socklen_t addrlen;
+	int listener, client = -1, server = -1;
+	timing_t start;
+	uint64_t cycles;
+	uint64_t ns;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP) || !IS_ENABLED(CONFIG_NET_IPV4)) {
+		return;
+	}
+
+	loopback_addr(AF_INET, TCP_PORT, &addr, &addrlen);
+
+	listener = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listener < 0 ||
+	    zsock_bind(listener, (struct sockaddr *)&addr, addrlen) < 0 ||
+	    zsock_listen(listener, 1) < 0) {
+		bench_fail("tcp.bulk", "cannot listen");
+		goto out;
+	}
+
+	client = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (client < 0 ||
+	    zsock_connect(client, (struct sockaddr *)&addr, addrlen) < 0) {
+		bench_fail("tcp.bulk", "cannot connect");
+		goto out;
+	}
+
+	server = zsock_accept(listener, NULL, NULL);
+	if (server < 0 ||
+	    zsock_setsockopt(server, SOL_SOCKET, SO_RCVTIMEO, &timeo,
+			     sizeof(timeo)) < 0) {
+		bench_fail("tcp.bulk", "cannot accept");
+		goto out;
+	}
+
+	tcp_rx_bytes = 0;
+	k_thread_create(&tcp_rx_thread, tcp_rx_stack,
+			K_THREAD_STACK_SIZEOF(tcp_rx_stack), tcp_rx,
+			INT_TO_POINTER(server), NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+
+	start = timing_counter_get();
+
+	if (tcp_send_all(client) < 0) {
+		bench_fail("tcp.bulk", "send failed");
+	}
+
+	(void)k_sem_take(&tcp_rx_done, K_FOREVER);
+
+	cycles = bench_cycles_since(&start);
+
+	(void)k_thread_join(&tcp_rx_thread, K_FOREVER);
+
+	if (tcp_rx_bytes < TCP_BYTES) {
+		bench_fail("tcp.bulk", "data lost");
+		goto out;
+	}
+
+	bench_report("tcp.bulk",
+		     "Transfer 1 KiB over a TCP/IPv4 loopback connection",
+		     cycles, TCP_BYTES / 1024);
+
+	ns = timing_cycles_to_ns(cycles);
+	if (ns > 0U) {
+		printk("tcp.bulk throughput: %u kbps\n",
+		       (uint32_t)((uint64_t)TCP_BYTES * 8U * 1000000U / ns));
+	}
+
+out:
+	if (server >= 0) {
+		zsock_close(server);
+	}
+
+	if (client >= 0) {
+		zsock_close(client);
+	}
+
+	if (listener >= 0) {
+		zsock_close(listener);
+	}
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _NET_STACK_BENCH_UTILS_H
+#define _NET_STACK_BENCH_UTILS_H
+
+/*
+ * @brief Helpers shared by the network stack benchmarks
+ */
+
+#include <bench_utils.h>
+
+/* Number of operations averaged by each measurement */
+#define BENCH_ITERATIONS 1000
+
+/* Number of sockets bound by the connection demux benchmark */
+#define BENCH_DEMUX_SOCKETS 16
+
+void bench_pkt(void);
+void bench_checksum(void);
+void bench_nbr_lookup(void);
+void bench_route_lookup(void);
+void bench_udp(void);
+void bench_udp_demux(void);
+void bench_tcp_bulk(void);
+
+#endif /* _NET_STACK_BENCH_UTILS_H */
@@ -116,6 +116,81 @@ static int exec_test(uint8_t nb_threads)
 	return yielder_status;
 }
 
+static struct k_sem *dyn_sems[MAX_NB_THREADS];
+
+void syscall_entry(void *_thread, void *sem, void *p3)
+{
+	struct k_app_thread *thread = (struct k_app_thread *) _thread;
+	int ret;
+
+	struct k_mem_partition *parts[] = {
+		thread->partition,
+	};
+
+	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	if (ret != 0) {
+		printk("k_mem_domain_init failed %d\n", ret);
+		yielder_status = 1;
+		return;
+	}
+
+	k_mem_domain_add_thread(&thread->domain, k_current_get());
+
+	k_thread_user_mode_enter(object_syscall, sem, NULL, NULL);
+}
+
+static int exec_syscall_test(uint8_t nb_objects)
+{
+	struct k_sem *target;
+	k_tid_t tid;
+
+	yielder_status = 0;
+
+	for (size_t i = 0; i < nb_objects; i++) {
+		dyn_sems[i] = k_object_alloc(K_OBJ_SEM);
+		if (dyn_sems[i] == NULL) {
+			printk("Cannot allocate semaphore %zu\n", i);
+			nb_objects = i;
+			yielder_status = 1;
+			goto out;
+		}
+
+		k_sem_init(dyn_sems[i], 0, 1);
+	}
+
+	/* The most recently allocated object is looked up */
+	target = dyn_sems[nb_objects - 1];
+
+	app_threads[0].partition = app_partitions[0];
+	app_threads[0].stack = &app_thread_stacks[0];
+
+	tid = k_thread_create(&app_threads[0].thread, app_thread_stacks[0],
+			      APP_STACKSIZE, syscall_entry,
+			      &app_threads[0], target, NULL,
+			      THREADS_PRIO, 0, K_FOREVER);
+	k_object_access_grant(target, tid);
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	stamp(MEAS_START);
+	k_thread_start(tid);
+	k_thread_join(tid, K_FOREVER);
+	stamp(MEAS_END);
+
+	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time) / NB_SYSCALLS;
+
+	printk("Syscall on 1 of %2u dynamic objects: %8" PRIu32 " cyc & %6" PRIu32
+	       " calls -> %6" PRIu64 " ns per call\n", nb_objects, full_time,
+	       NB_SYSCALLS, time_ns);
+
+out:
+	for (size_t i = 0; i < nb_objects; i++) {
+		k_object_free(dyn_sems[i]);
+	}
+
+	return yielder_status;
+}
 
 int main(void)
 {
@@ -136,6 +211,19 @@ int main(void)
 		}
 	}
 
+	printk("============================\n");
+	printk("user syscall on dynamic kernel object\n");
+
+	k_thread_system_pool_assign(k_current_get());
+
+	for (size_t i = 0; nb_threads_list[i] > 0; i++) {
+		ret = exec_syscall_test(nb_threads_list[i]);
+		if (ret != 0) {
+			printk("FAIL\n");
+			return 0;
+		}
+	}
+
 	printk("SUCCESS\n");
 	return 0;
 }
@@ -19,3 +19,14 @@ void context_switch_yield(void *p1, void *p2, void *p3)
 		k_yield();
 	}
 }
+
+void object_syscall(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+	uint32_t rounds = NB_SYSCALLS;
+
+	/* Each call validates the semaphore with a kernel object lookup */
+	while (rounds--) {
+		(void)k_sem_count_get(sem);
+	}
+}
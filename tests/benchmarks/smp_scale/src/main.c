@@ -0,0 +1,148 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main module of the SMP scalability benchmarks: it
+ * runs each scenario on 1 to N CPUs and reports the throughput and the
+ * latency distribution of its operations for each number of CPUs.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+
+#include "utils.h"
+
+#define BENCH_STACK_SIZE 1024
+
+int error_count;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, BENCH_MAX_THREADS, BENCH_STACK_SIZE);
+static struct k_thread threads[BENCH_MAX_THREADS];
+static K_SEM_DEFINE(go, 0, BENCH_MAX_THREADS);
+
+static uint32_t samples[BENCH_MAX_THREADS][BENCH_OPS];
+static uint32_t num_samples[BENCH_MAX_THREADS];
+static uint32_t sorted[BENCH_MAX_THREADS * BENCH_OPS];
+
+void bench_sample(unsigned int idx, uint32_t cycles)
+{
+	if (num_samples[idx] < BENCH_OPS) {
+		samples[idx][num_samples[idx]++] = cycles;
+	}
+}
+
+static void bench_thread(void *p1, void *p2, void *p3)
+{
+	const struct bench_scenario *scenario = p1;
+
+	ARG_UNUSED(p3);
+
+	k_sem_take(&go, K_FOREVER);
+	scenario->entry(POINTER_TO_UINT(p2));
+}
+
+static int cmp_cycles(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void bench_run(const struct bench_scenario *scenario, unsigned int num_cpus)
+{
+	unsigned int num_threads = scenario->threads_per_cpu * num_cpus;
+	uint32_t count = 0;
+	uint64_t total = 0;
+	timing_t start, end;
+	uint64_t ns;
+	char metric[48];
+	char summary[80];
+
+	snprintk(metric, sizeof(metric), "smp.%s.%ucpu", scenario->name, num_cpus);
+
+	memset(num_samples, 0, sizeof(num_samples));
+	if (scenario->setup != NULL) {
+		scenario->setup(num_threads);
+	}
+
+	for (unsigned int idx = 0; idx < num_threads; idx++) {
+		k_thread_create(&threads[idx], stacks[idx], K_THREAD_STACK_SIZEOF(stacks[idx]),
+				bench_thread, (void *)scenario, UINT_TO_POINTER(idx), NULL,
+				BENCH_PRIO, 0, K_FOREVER);
+		if (k_thread_cpu_pin(&threads[idx], idx % num_cpus) != 0) {
+			bench_fail(metric, "cannot pin the threads");
+			k_thread_abort(&threads[idx]);
+			num_threads = idx;
+			break;
+		}
+		k_thread_start(&threads[idx]);
+	}
+
+	/* Release all the threads at once */
+	k_sched_lock();
+	for (unsigned int idx = 0; idx < num_threads; idx++) {
+		k_sem_give(&go);
+	}
+	start = timing_counter_get();
+	k_sched_unlock();
+
+	for (unsigned int idx = 0; idx < num_threads; idx++) {
+		k_thread_join(&threads[idx], K_FOREVER);
+	}
+	end = timing_counter_get();
+
+	for (unsigned int idx = 0; idx < num_threads; idx++) {
+		memcpy(&sorted[count], samples[idx], num_samples[idx] * sizeof(uint32_t));
+		count += num_samples[idx];
+	}
+
+	if (count == 0) {
+		bench_fail(metric, "no operation completed");
+		return;
+	}
+
+	qsort(sorted, count, sizeof(sorted[0]), cmp_cycles);
+	for (uint32_t i = 0; i < count; i++) {
+		total += sorted[i];
+	}
+
+	bench_report(metric, "Average", total, count);
+	bench_report(metric, "Median", sorted[count / 2], 1);
+	bench_report(metric, "99th percentile", sorted[count * 99 / 100], 1);
+	bench_report(metric, "Maximum", sorted[count - 1], 1);
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	snprintk(summary, sizeof(summary), "%s - Throughput", metric);
+	printk("%-70s:%8u ops/s\n", summary,
+	       (uint32_t)(ns == 0 ? 0 : (uint64_t)count * NSEC_PER_SEC / ns));
+}
+
+int main(void)
+{
+	unsigned int max_cpus = arch_num_cpus();
+
+	timing_init();
+	timing_start();
+
+	TC_START("SMP scalability benchmark");
+
+	for (size_t s = 0; s < bench_num_scenarios; s++) {
+		for (unsigned int num_cpus = 1; num_cpus <= max_cpus; num_cpus++) {
+			bench_run(&bench_scenarios[s], num_cpus);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+
+	return 0;
+}
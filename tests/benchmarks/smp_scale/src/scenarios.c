@@ -0,0 +1,168 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Scenarios of the SMP scalability benchmarks.
+ *
+ * The pair scenarios use two consecutive threads, that are on two different
+ * CPUs as soon as there is more than one in use.
+ */
+
+#include "utils.h"
+
+#define BENCH_MAX_PAIRS (BENCH_MAX_THREADS / 2)
+
+static struct k_sem ping[BENCH_MAX_PAIRS];
+static struct k_sem pong[BENCH_MAX_PAIRS];
+
+static void pairs_setup(unsigned int num_threads)
+{
+	for (unsigned int pair = 0; pair < num_threads / 2; pair++) {
+		k_sem_init(&ping[pair], 0, 1);
+		k_sem_init(&pong[pair], 0, 1);
+	}
+}
+
+/* Round trip through two semaphores */
+static void sem_pingpong_entry(unsigned int idx)
+{
+	unsigned int pair = idx / 2;
+	timing_t start;
+
+	for (int i = 0; i < BENCH_OPS; i++) {
+		if (idx % 2 == 0) {
+			start = timing_counter_get();
+			k_sem_give(&ping[pair]);
+			k_sem_take(&pong[pair], K_FOREVER);
+			bench_sample(idx, bench_cycles_since(&start));
+		} else {
+			k_sem_take(&ping[pair], K_FOREVER);
+			k_sem_give(&pong[pair]);
+		}
+	}
+}
+
+static timing_t wake_start[BENCH_MAX_PAIRS];
+
+/*
+ * Time from the give of a semaphore to the return of the thread blocked on
+ * it. The timing counters of the CPUs are assumed to be synchronized.
+ */
+static void wakeup_entry(unsigned int idx)
+{
+	unsigned int pair = idx / 2;
+
+	for (int i = 0; i < BENCH_OPS; i++) {
+		if (idx % 2 == 0) {
+			/* Let the other thread block */
+			k_sem_take(&ping[pair], K_FOREVER);
+			k_busy_wait(10);
+			wake_start[pair] = timing_counter_get();
+			k_sem_give(&pong[pair]);
+		} else {
+			k_sem_give(&ping[pair]);
+			k_sem_take(&pong[pair], K_FOREVER);
+			bench_sample(idx, bench_cycles_since(&wake_start[pair]));
+		}
+	}
+}
+
+static K_MUTEX_DEFINE(mutex);
+static volatile uint32_t mutex_counter;
+
+/* Lock and unlock of a mutex shared by all the threads */
+static void mutex_entry(unsigned int idx)
+{
+	timing_t start;
+
+	for (int i = 0; i < BENCH_OPS; i++) {
+		start = timing_counter_get();
+		k_mutex_lock(&mutex, K_FOREVER);
+		mutex_counter++;
+		k_mutex_unlock(&mutex);
+		bench_sample(idx, bench_cycles_since(&start));
+	}
+}
+
+K_MSGQ_DEFINE(msgq, sizeof(uint32_t), BENCH_MAX_THREADS, sizeof(uint32_t));
+
+static void msgq_setup(unsigned int num_threads)
+{
+	ARG_UNUSED(num_threads);
+
+	k_msgq_purge(&msgq);
+}
+
+/* Put and get of a message through a queue shared by all the threads */
+static void msgq_entry(unsigned int idx)
+{
+	uint32_t msg = idx;
+	timing_t start;
+
+	for (int i = 0; i < BENCH_OPS; i++) {
+		start = timing_counter_get();
+		k_msgq_put(&msgq, &msg, K_FOREVER);
+		k_msgq_get(&msgq, &msg, K_FOREVER);
+		bench_sample(idx, bench_cycles_since(&start));
+	}
+}
+
+static K_THREAD_STACK_DEFINE(work_q_stack, 1024);
+static struct k_work_q work_q;
+
+struct bench_work {
+	struct k_work work;
+	struct k_sem done;
+};
+
+static struct bench_work works[BENCH_MAX_THREADS];
+
+static void work_handler(struct k_work *work)
+{
+	struct bench_work *bench_work = CONTAINER_OF(work, struct bench_work, work);
+
+	k_sem_give(&bench_work->done);
+}
+
+static void work_setup(unsigned int num_threads)
+{
+	static bool started;
+
+	if (!started) {
+		k_work_queue_start(&work_q, work_q_stack, K_THREAD_STACK_SIZEOF(work_q_stack),
+				   K_PRIO_COOP(1), NULL);
+		started = true;
+	}
+
+	for (unsigned int idx = 0; idx < num_threads; idx++) {
+		k_work_init(&works[idx].work, work_handler);
+		k_sem_init(&works[idx].done, 0, 1);
+	}
+}
+
+/* Submission of a work item to a queue shared by all the threads, to its end */
+static void work_entry(unsigned int idx)
+{
+	timing_t start;
+
+	for (int i = 0; i < BENCH_OPS; i++) {
+		start = timing_counter_get();
+		k_work_submit_to_queue(&work_q, &works[idx].work);
+		k_sem_take(&works[idx].done, K_FOREVER);
+		bench_sample(idx, bench_cycles_since(&start));
+	}
+}
+
+const struct bench_scenario bench_scenarios[] = {
+	{ "sem_pingpong", 2, pairs_setup, sem_pingpong_entry },
+	{ "wakeup", 2, pairs_setup, wakeup_entry },
+	{ "mutex", 1, NULL, mutex_entry },
+	{ "msgq", 1, msgq_setup, msgq_entry },
+	{ "work", 1, work_setup, work_entry },
+};
+
+const size_t bench_num_scenarios = ARRAY_SIZE(bench_scenarios);
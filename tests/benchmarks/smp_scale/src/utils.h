@@ -0,0 +1,48 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _SMP_SCALE_BENCH_UTILS_H
+#define _SMP_SCALE_BENCH_UTILS_H
+
+/*
+ * @brief Helpers shared by the SMP scalability benchmarks
+ */
+
+#include <zephyr/kernel.h>
+#include <bench_utils.h>
+
+/* Number of operations timed by each thread of a scenario */
+#define BENCH_OPS 1000
+
+/* Maximum number of threads per CPU of a scenario */
+#define BENCH_THREADS_PER_CPU 2
+
+#define BENCH_MAX_THREADS (BENCH_THREADS_PER_CPU * CONFIG_MP_MAX_NUM_CPUS)
+
+/* Priority of the threads of the scenarios */
+#define BENCH_PRIO K_PRIO_COOP(2)
+
+/**
+ * A scenario runs @a threads_per_cpu threads on each of the CPUs in use,
+ * thread @a idx being pinned to CPU @a idx modulo the number of CPUs, so
+ * consecutive threads are on different CPUs.
+ */
+struct bench_scenario {
+	const char *name;
+	unsigned int threads_per_cpu;
+	/* Reset the shared state for @p num_threads threads, may be NULL */
+	void (*setup)(unsigned int num_threads);
+	/* Body of thread @p idx, timing its operations with bench_sample() */
+	void (*entry)(unsigned int idx);
+};
+
+extern const struct bench_scenario bench_scenarios[];
+extern const size_t bench_num_scenarios;
+
+/* Record the cycles taken by one operation of thread @p idx */
+void bench_sample(unsigned int idx, uint32_t cycles);
+
+#endif /* _SMP_SCALE_BENCH_UTILS_H */
@@ -252,6 +252,51 @@ ZTEST_F(bap_broadcast_source_test_suite, test_broadcast_source_create_start_send
 	fixture->source = NULL;
 }
 
+ZTEST_F(bap_broadcast_source_test_suite, test_broadcast_source_create_start_send_batch_stop_delete)
+{
+	struct bt_bap_broadcast_source_param *create_param = fixture->param;
+	struct bt_bap_stream_sdu sdus[CONFIG_BT_BAP_BROADCAST_SRC_STREAM_COUNT];
+	struct bt_le_ext_adv ext_adv = {0};
+	size_t sdu_cnt = 0U;
+	int err;
+
+	err = bt_bap_broadcast_source_create(create_param, &fixture->source);
+	zassert_equal(0, err, "Unable to create broadcast source: err %d", err);
+
+	err = bt_bap_broadcast_source_start(fixture->source, &ext_adv);
+	zassert_equal(0, err, "Unable to start broadcast source: err %d", err);
+
+	for (size_t i = 0U; i < create_param->params_count; i++) {
+		for (size_t j = 0U; j < create_param->params[i].params_count; j++) {
+			/* Since BAP doesn't care about the `buf` we can just provide NULL */
+			sdus[sdu_cnt].stream = create_param->params[i].params[j].stream;
+			sdus[sdu_cnt].buf = NULL;
+			sdus[sdu_cnt].seq_num = 0U;
+			sdu_cnt++;
+		}
+	}
+
+	err = bt_bap_stream_send_batch_ts(sdus, sdu_cnt, 0U);
+	zassert_equal(sdu_cnt, err, "Unable to send batch: err %d", err);
+
+	zexpect_call_count("bt_bap_stream_ops.sent", fixture->stream_cnt,
+			   mock_bap_stream_sent_cb_fake.call_count);
+
+	err = bt_bap_stream_send_batch(sdus, 0U);
+	zassert_equal(-EINVAL, err, "Unexpected return value %d", err);
+
+	err = bt_bap_broadcast_source_stop(fixture->source);
+	zassert_equal(0, err, "Unable to stop broadcast source: err %d", err);
+
+	/* The streams can not send once stopped */
+	err = bt_bap_stream_send_batch(sdus, sdu_cnt);
+	zassert_true(err < 0, "Unexpected return value %d", err);
+
+	err = bt_bap_broadcast_source_delete(fixture->source);
+	zassert_equal(0, err, "Unable to delete broadcast source: err %d", err);
+	fixture->source = NULL;
+}
+
 ZTEST_F(bap_broadcast_source_test_suite, test_broadcast_source_create_inval_param_null)
 {
 	int err;
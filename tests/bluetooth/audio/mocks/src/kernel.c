@@ -109,6 +109,14 @@ int k_work_busy_get(const struct k_work *work)
 	return 0;
 }
 
+void k_sched_lock(void)
+{
+}
+
+void k_sched_unlock(void)
+{
+}
+
 int32_t k_sleep(k_timeout_t timeout)
 {
 	struct k_work *work;
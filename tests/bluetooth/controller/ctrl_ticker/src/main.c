@@ -0,0 +1,266 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include <zephyr/types.h>
+#include <zephyr/ztest.h>
+
+#include "hal/cntr.h"
+#include "ticker/ticker.h"
+
+#define TICKER_INSTANCE  0
+#define TICKER_USER_ID   3
+#define TICKER_USERS     4
+#define TICKER_USER_OPS  4
+#define TICKER_NODES_MAX 64
+
+/* Roughly 3 seconds at 32768 Hz */
+#define TICKS_RUN 100000U
+
+static uint8_t ticker_nodes[TICKER_NODES_MAX][TICKER_NODE_T_SIZE];
+static uint8_t ticker_users[TICKER_USERS][TICKER_USER_T_SIZE];
+static uint8_t ticker_user_ops[TICKER_USERS * TICKER_USER_OPS][TICKER_USER_OP_T_SIZE];
+
+static uint8_t const caller_id_lut[TICKER_USERS] = {
+	TICKER_CALL_ID_ISR,
+	TICKER_CALL_ID_WORKER,
+	TICKER_CALL_ID_JOB,
+	TICKER_CALL_ID_PROGRAM
+};
+
+/* Counter of the ticker, only moved by the tests */
+static uint32_t cntr;
+static uint32_t cntr_cmp;
+
+static void *sched_instance;
+static bool worker_pending;
+static bool job_pending;
+
+static struct {
+	uint32_t period;
+	uint32_t count;
+	bool order_ok;
+} tickers[TICKER_NODES_MAX];
+
+static uint32_t ticks_at_expire_last;
+static bool expire_order_ok;
+
+void cntr_init(void)
+{
+}
+
+uint32_t cntr_start(void)
+{
+	return 0;
+}
+
+uint32_t cntr_stop(void)
+{
+	return 0;
+}
+
+uint32_t cntr_cnt_get(void)
+{
+	return cntr;
+}
+
+void cntr_cmp_set(uint8_t cmp, uint32_t value)
+{
+	ARG_UNUSED(cmp);
+
+	cntr_cmp = value;
+}
+
+void bt_ctlr_assert_handle(char *file, uint32_t line)
+{
+	zassert_unreachable("Assertion failed in %s:%u", file, line);
+}
+
+static uint8_t caller_id_get(uint8_t user_id)
+{
+	zassert_true(user_id < ARRAY_SIZE(caller_id_lut));
+
+	return caller_id_lut[user_id];
+}
+
+static void sched(uint8_t caller_id, uint8_t callee_id, uint8_t chain, void *instance)
+{
+	ARG_UNUSED(caller_id);
+	ARG_UNUSED(chain);
+
+	sched_instance = instance;
+
+	if (callee_id == TICKER_CALL_ID_WORKER) {
+		worker_pending = true;
+	} else if (callee_id == TICKER_CALL_ID_JOB) {
+		job_pending = true;
+	}
+}
+
+static void trigger_set(uint32_t value)
+{
+	cntr_cmp = value;
+}
+
+static void ticker_cb(uint32_t ticks_at_expire, uint32_t ticks_drift, uint32_t remainder,
+		      uint16_t lazy, uint8_t force, void *context)
+{
+	uint8_t id = POINTER_TO_UINT(context);
+
+	ARG_UNUSED(ticks_drift);
+	ARG_UNUSED(remainder);
+	ARG_UNUSED(lazy);
+	ARG_UNUSED(force);
+
+	tickers[id].count++;
+	if (ticks_at_expire != tickers[id].period * tickers[id].count) {
+		tickers[id].order_ok = false;
+	}
+
+	if (ticks_at_expire < ticks_at_expire_last) {
+		expire_order_ok = false;
+	}
+	ticks_at_expire_last = ticks_at_expire;
+}
+
+static void op_cb(uint32_t status, void *op_context)
+{
+	uint32_t *op_status = op_context;
+
+	*op_status = status;
+}
+
+/* Run the worker and the job of the ticker until they are idle */
+static void ticker_run(void)
+{
+	while (worker_pending || job_pending) {
+		if (worker_pending) {
+			worker_pending = false;
+			ticker_worker(sched_instance);
+		} else {
+			job_pending = false;
+			ticker_job(sched_instance);
+		}
+	}
+}
+
+static void ticker_setup(void *f)
+{
+	ARG_UNUSED(f);
+
+	memset(ticker_nodes, 0, sizeof(ticker_nodes));
+	memset(ticker_users, 0, sizeof(ticker_users));
+	memset(tickers, 0, sizeof(tickers));
+
+	for (uint8_t i = 0U; i < TICKER_USERS; i++) {
+		/* The first member of a ticker user is its operation count */
+		ticker_users[i][0] = TICKER_USER_OPS;
+	}
+
+	cntr = 0U;
+	cntr_cmp = 0U;
+	worker_pending = false;
+	job_pending = false;
+	ticks_at_expire_last = 0U;
+	expire_order_ok = true;
+
+	zassert_equal(ticker_init(TICKER_INSTANCE, TICKER_NODES_MAX, ticker_nodes, TICKER_USERS,
+				  ticker_users, ARRAY_SIZE(ticker_user_ops), ticker_user_ops,
+				  caller_id_get, sched, trigger_set),
+		      TICKER_STATUS_SUCCESS);
+}
+
+static void tickers_start(uint8_t count)
+{
+	for (uint8_t id = 0U; id < count; id++) {
+		uint32_t op_status = TICKER_STATUS_BUSY;
+		uint32_t ret;
+
+		/* Periods that are spread out and often expire together */
+		tickers[id].period = 40U + (id % 8U) * 20U + (id / 8U) * 3U;
+		tickers[id].order_ok = true;
+
+		ret = ticker_start(TICKER_INSTANCE, TICKER_USER_ID, id, 0U,
+				   tickers[id].period, tickers[id].period, TICKER_NULL_REMAINDER,
+				   TICKER_NULL_LAZY, TICKER_NULL_SLOT, ticker_cb,
+				   UINT_TO_POINTER(id), op_cb, &op_status);
+		zassert_equal(ret, TICKER_STATUS_BUSY);
+
+		ticker_run();
+		zassert_equal(op_status, TICKER_STATUS_SUCCESS);
+	}
+}
+
+/* Move the counter to each compare value set by the job, return the number
+ * of times the worker was triggered
+ */
+static uint32_t tickers_expire(uint32_t ticks)
+{
+	uint32_t triggers = 0U;
+
+	while (cntr_cmp <= ticks) {
+		cntr = cntr_cmp;
+		ticker_trigger(TICKER_INSTANCE);
+		ticker_run();
+		triggers++;
+	}
+
+	return triggers;
+}
+
+/* All the expiries up to the last move of the counter have been handled */
+static void tickers_verify(uint8_t count)
+{
+	zassert_true(expire_order_ok, "Tickers expired out of order");
+
+	for (uint8_t id = 0U; id < count; id++) {
+		zassert_true(tickers[id].order_ok, "Ticker %u expired late", id);
+		zassert_equal(tickers[id].count, cntr / tickers[id].period,
+			      "Ticker %u expired %u times", id, tickers[id].count);
+	}
+}
+
+ZTEST(ticker, test_periodic_expire)
+{
+	tickers_start(8U);
+	(void)tickers_expire(TICKS_RUN);
+	tickers_verify(8U);
+}
+
+ZTEST(ticker, test_periodic_expire_many)
+{
+	tickers_start(TICKER_NODES_MAX);
+	(void)tickers_expire(TICKS_RUN);
+	tickers_verify(TICKER_NODES_MAX);
+}
+
+ZTEST(ticker, test_benchmark)
+{
+	static const uint8_t counts[] = { 4U, 16U, 32U, TICKER_NODES_MAX };
+
+	for (uint8_t i = 0U; i < ARRAY_SIZE(counts); i++) {
+		uint32_t triggers;
+		clock_t start;
+		clock_t end;
+
+		ticker_setup(NULL);
+		tickers_start(counts[i]);
+
+		start = clock();
+		triggers = tickers_expire(TICKS_RUN);
+		end = clock();
+
+		tickers_verify(counts[i]);
+
+		TC_PRINT("%u tickers: %u triggers, %llu ns per trigger\n", counts[i], triggers,
+			 (unsigned long long)(end - start) * (1000000000ULL / CLOCKS_PER_SEC) /
+			 MAX(triggers, 1U));
+	}
+}
+
+ZTEST_SUITE(ticker, NULL, NULL, ticker_setup, NULL, NULL);
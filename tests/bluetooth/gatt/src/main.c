@@ -14,6 +14,12 @@
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/gatt.h>
 
+#if defined(CONFIG_BT_GATT_CACHING)
+#include <zephyr/sys/byteorder.h>
+#include <tinycrypt/constants.h>
+#include <tinycrypt/cmac_mode.h>
+#endif
+
 /* Custom Service Variables */
 static const struct bt_uuid_128 test_uuid = BT_UUID_INIT_128(
 	0xf0, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
@@ -274,3 +280,219 @@ ZTEST(test_gatt, test_gatt_write)
 	zassert_mem_equal(value, test_value, ret,
 			  "Attribute write value don't match");
 }
+
+struct attr_list {
+	const struct bt_gatt_attr *attrs[64];
+	uint16_t handles[64];
+	uint16_t count;
+};
+
+static uint8_t list_attr(const struct bt_gatt_attr *attr, uint16_t handle,
+			 void *user_data)
+{
+	struct attr_list *list = user_data;
+
+	zassert_true(list->count < ARRAY_SIZE(list->attrs), "Too many attributes");
+	list->attrs[list->count] = attr;
+	list->handles[list->count] = handle;
+	list->count++;
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+ZTEST(test_gatt, test_gatt_handle_lookup)
+{
+	static struct attr_list all;
+	static struct attr_list range;
+	const struct bt_gatt_attr *attr;
+	uint16_t first, last;
+	uint16_t num;
+
+	/* Need our services to be registered */
+	(void)bt_gatt_service_register(&test_svc);
+	(void)bt_gatt_service_register(&test1_svc);
+
+	all.count = 0;
+	bt_gatt_foreach_attr(0x0001, 0xffff, list_attr, &all);
+	zassert_true(all.count >= ARRAY_SIZE(test_attrs) + ARRAY_SIZE(test1_attrs),
+		     "Attributes missing");
+
+	/* Each handle resolves to the attribute found by walking the database */
+	for (uint16_t i = 0; i < all.count; i++) {
+		zassert_true(i == 0 || all.handles[i] > all.handles[i - 1],
+			     "Handles out of order");
+
+		attr = NULL;
+		bt_gatt_foreach_attr(all.handles[i], all.handles[i], find_attr, &attr);
+		zassert_equal_ptr(attr, all.attrs[i], "Wrong attribute for handle 0x%04x",
+				  all.handles[i]);
+		zassert_equal_ptr(bt_gatt_attr_next(all.attrs[i]),
+				  (i + 1 < all.count) ? all.attrs[i + 1] : NULL,
+				  "Wrong next attribute of handle 0x%04x", all.handles[i]);
+	}
+
+	/* Ranges starting and ending anywhere */
+	for (uint16_t i = 0; i < all.count; i++) {
+		range.count = 0;
+		bt_gatt_foreach_attr(all.handles[i], 0xffff, list_attr, &range);
+		zassert_equal(range.count, all.count - i, "Wrong count from 0x%04x",
+			      all.handles[i]);
+		zassert_mem_equal(range.attrs, &all.attrs[i], range.count * sizeof(range.attrs[0]),
+				  "Wrong attributes from 0x%04x", all.handles[i]);
+
+		num = 0;
+		bt_gatt_foreach_attr(0x0001, all.handles[i], count_attr, &num);
+		zassert_equal(num, i + 1, "Wrong count up to 0x%04x", all.handles[i]);
+	}
+
+	/* Handles of an unregistered service resolve to nothing */
+	first = test1_attrs[0].handle;
+	last = test1_attrs[ARRAY_SIZE(test1_attrs) - 1].handle;
+	zassert_false(bt_gatt_service_unregister(&test1_svc),
+		      "Test service1 unregister failed");
+
+	for (uint16_t handle = first; handle <= last; handle++) {
+		attr = NULL;
+		bt_gatt_foreach_attr(handle, handle, find_attr, &attr);
+		zassert_is_null(attr, "Attribute found for unregistered handle 0x%04x", handle);
+	}
+
+	zassert_false(bt_gatt_service_register(&test1_svc),
+		      "Test service1 re-registration failed");
+
+	attr = NULL;
+	bt_gatt_foreach_attr(test1_attrs[0].handle, test1_attrs[0].handle, find_attr, &attr);
+	zassert_equal_ptr(attr, &test1_attrs[0], "Re-registered attribute not found");
+}
+
+#if defined(CONFIG_BT_GATT_CACHING)
+static void hash_add(struct tc_cmac_struct *cmac, const void *data, size_t len)
+{
+	zassert_equal(tc_cmac_update(cmac, data, len), TC_CRYPTO_SUCCESS,
+		      "Unable to update AES CMAC");
+}
+
+/* Database Hash as defined by Core Spec 5.1 | Vol 3, Part G, 7.3.1 */
+static uint8_t ref_hash_attr(const struct bt_gatt_attr *attr, uint16_t handle,
+			     void *user_data)
+{
+	struct tc_cmac_struct *cmac = user_data;
+	uint8_t data[32];
+	uint16_t value;
+	ssize_t len;
+
+	if (attr->uuid->type != BT_UUID_TYPE_16) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	switch (BT_UUID_16(attr->uuid)->val) {
+	case BT_UUID_GATT_PRIMARY_VAL:
+	case BT_UUID_GATT_SECONDARY_VAL:
+	case BT_UUID_GATT_INCLUDE_VAL:
+	case BT_UUID_GATT_CHRC_VAL:
+	case BT_UUID_GATT_CEP_VAL:
+		value = sys_cpu_to_le16(handle);
+		hash_add(cmac, &value, sizeof(value));
+		value = sys_cpu_to_le16(BT_UUID_16(attr->uuid)->val);
+		hash_add(cmac, &value, sizeof(value));
+
+		len = attr->read(NULL, attr, data, sizeof(data), 0);
+		zassert_true(len >= 0, "Unable to read attribute 0x%04x", handle);
+		hash_add(cmac, data, len);
+		break;
+	case BT_UUID_GATT_CUD_VAL:
+	case BT_UUID_GATT_CCC_VAL:
+	case BT_UUID_GATT_SCC_VAL:
+	case BT_UUID_GATT_CPF_VAL:
+	case BT_UUID_GATT_CAF_VAL:
+		value = sys_cpu_to_le16(handle);
+		hash_add(cmac, &value, sizeof(value));
+		value = sys_cpu_to_le16(BT_UUID_16(attr->uuid)->val);
+		hash_add(cmac, &value, sizeof(value));
+		break;
+	default:
+		break;
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void ref_hash(uint8_t hash[16])
+{
+	static const uint8_t key[16];
+	struct tc_aes_key_sched_struct sched;
+	struct tc_cmac_struct cmac;
+
+	zassert_equal(tc_cmac_setup(&cmac, key, &sched), TC_CRYPTO_SUCCESS,
+		      "Unable to setup AES CMAC");
+	bt_gatt_foreach_attr(0x0001, 0xffff, ref_hash_attr, &cmac);
+	zassert_equal(tc_cmac_final(hash, &cmac), TC_CRYPTO_SUCCESS,
+		      "Unable to calculate hash");
+}
+
+/* Read the Database Hash characteristic and check it against the reference */
+static void check_db_hash(uint8_t hash[16])
+{
+	const struct bt_gatt_attr *attr;
+	uint8_t expected[16];
+	ssize_t len;
+
+	attr = bt_gatt_find_by_uuid(NULL, 0, BT_UUID_GATT_DB_HASH);
+	zassert_not_null(attr, "Database Hash characteristic not found");
+
+	len = attr->read(NULL, attr, hash, 16, 0);
+	zassert_equal(len, 16, "Unable to read Database Hash (err %zd)", len);
+
+	ref_hash(expected);
+	zassert_mem_equal(hash, expected, sizeof(expected), "Wrong Database Hash");
+}
+
+ZTEST(test_gatt, test_gatt_db_hash)
+{
+	uint8_t none[16], one[16], both[16], hash[16];
+
+	(void)bt_gatt_service_unregister(&test_svc);
+	(void)bt_gatt_service_unregister(&test1_svc);
+
+	check_db_hash(none);
+
+	/* Services appended one after the other */
+	zassert_false(bt_gatt_service_register(&test_svc),
+		      "Test service registration failed");
+	check_db_hash(one);
+	zassert_false(bt_gatt_service_register(&test1_svc),
+		      "Test service1 registration failed");
+	check_db_hash(both);
+
+	zassert_true(memcmp(none, one, sizeof(one)) != 0, "Registration left hash unchanged");
+	zassert_true(memcmp(one, both, sizeof(both)) != 0, "Registration left hash unchanged");
+
+	/* Removal of the last service, and of the first one */
+	zassert_false(bt_gatt_service_unregister(&test1_svc),
+		      "Test service1 unregister failed");
+	check_db_hash(hash);
+	zassert_mem_equal(hash, one, sizeof(one), "Hash not restored");
+
+	zassert_false(bt_gatt_service_register(&test1_svc),
+		      "Test service1 re-registration failed");
+	check_db_hash(hash);
+	zassert_mem_equal(hash, both, sizeof(both), "Hash not restored");
+
+	zassert_false(bt_gatt_service_unregister(&test_svc),
+		      "Test service unregister failed");
+	check_db_hash(hash);
+	zassert_true(memcmp(hash, both, sizeof(both)) != 0, "Unregister left hash unchanged");
+
+	/* A change of the database without a read in between */
+	zassert_false(bt_gatt_service_register(&test_svc),
+		      "Test service re-registration failed");
+	zassert_false(bt_gatt_service_unregister(&test1_svc),
+		      "Test service1 unregister failed");
+	check_db_hash(hash);
+
+	zassert_false(bt_gatt_service_unregister(&test_svc),
+		      "Test service unregister failed");
+	check_db_hash(hash);
+	zassert_mem_equal(hash, none, sizeof(none), "Hash not restored");
+}
+#endif /* CONFIG_BT_GATT_CACHING */
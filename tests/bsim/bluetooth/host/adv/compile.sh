@@ -16,6 +16,7 @@ app=tests/bsim/bluetooth/host/adv/resume2/connectable compile
 app=tests/bsim/bluetooth/host/adv/resume2/connecter compile
 app=tests/bsim/bluetooth/host/adv/resume2/dut compile
 app=tests/bsim/bluetooth/host/adv/chain compile
+app=tests/bsim/bluetooth/host/adv/scan_filter compile
 app=tests/bsim/bluetooth/host/adv/extended conf_file=prj_advertiser.conf compile
 app=tests/bsim/bluetooth/host/adv/extended conf_file=prj_scanner.conf compile
 app=tests/bsim/bluetooth/host/adv/periodic compile
@@ -0,0 +1,368 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/uuid.h>
+
+#include "bs_types.h"
+#include "bs_tracing.h"
+#include "time_machine.h"
+#include "bstests.h"
+
+#define FAIL(...)					\
+	do {						\
+		bst_result = Failed;			\
+		bs_trace_error_time_line(__VA_ARGS__);	\
+	} while (0)
+
+#define PASS(...)					\
+	do {						\
+		bst_result = Passed;			\
+		bs_trace_info_time(1, __VA_ARGS__);	\
+	} while (0)
+
+#define WAIT_TIME_S 30
+
+/* Time for the reports matched against the previous filter to be delivered */
+#define SETTLE_TIME K_MSEC(CONFIG_BT_SCAN_BATCH_TIMEOUT * 4)
+#define SCAN_TIME   K_SECONDS(2)
+
+/* The matching UUID is not the first of the list */
+#define TEST_UUID_LIST BT_UUID_16_ENCODE(BT_UUID_HRS_VAL), BT_UUID_16_ENCODE(BT_UUID_BAS_VAL)
+#define TEST_UUID      BT_UUID_16_ENCODE(BT_UUID_BAS_VAL)
+#define TEST_MFG_DATA  0xff, 0xff, 0x01
+
+extern enum bst_result_t bst_result;
+
+enum {
+	ADV_UUID,
+	ADV_OTHER,
+	ADV_COUNT,
+};
+
+static atomic_t recv_count[ADV_COUNT];
+static atomic_t batch_count[ADV_COUNT];
+static atomic_t unknown_count;
+static bt_addr_le_t other_addr;
+static bool other_addr_valid;
+
+static bool data_cb(struct bt_data *data, void *user_data)
+{
+	const uint8_t mfg_data[] = { TEST_MFG_DATA };
+	int *adv = user_data;
+
+	switch (data->type) {
+	case BT_DATA_UUID16_ALL:
+		*adv = ADV_UUID;
+		return false;
+	case BT_DATA_MANUFACTURER_DATA:
+		if (data->data_len == sizeof(mfg_data) &&
+		    memcmp(data->data, mfg_data, sizeof(mfg_data)) == 0) {
+			*adv = ADV_OTHER;
+			return false;
+		}
+		return true;
+	default:
+		return true;
+	}
+}
+
+static int adv_of(struct net_buf_simple *buf)
+{
+	int adv = ADV_COUNT;
+
+	bt_data_parse(buf, data_cb, &adv);
+
+	return adv;
+}
+
+static void count_report(atomic_t *counts, int adv)
+{
+	if (adv == ADV_COUNT) {
+		atomic_inc(&unknown_count);
+		return;
+	}
+
+	atomic_inc(&counts[adv]);
+}
+
+static void scan_recv(const struct bt_le_scan_recv_info *info,
+		      struct net_buf_simple *buf)
+{
+	int adv = adv_of(buf);
+
+	if (adv == ADV_OTHER && !other_addr_valid) {
+		bt_addr_le_copy(&other_addr, info->addr);
+		other_addr_valid = true;
+	}
+
+	count_report(recv_count, adv);
+}
+
+static void scan_recv_batch(const struct bt_le_scan_report *reports, size_t count)
+{
+	struct net_buf_simple buf;
+
+	if (k_current_get() != &k_sys_work_q.thread) {
+		FAIL("Batch not delivered from the system work queue\n");
+	}
+
+	if (count == 0U || count > CONFIG_BT_SCAN_BATCH_SIZE) {
+		FAIL("Batch of %zu reports\n", count);
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		net_buf_simple_init_with_data(&buf, (void *)reports[i].data,
+					      reports[i].data_len);
+		count_report(batch_count, adv_of(&buf));
+	}
+}
+
+static struct bt_le_scan_cb scan_callbacks = {
+	.recv = scan_recv,
+	.recv_batch = scan_recv_batch,
+};
+
+static void reset_counts(void)
+{
+	for (int i = 0; i < ADV_COUNT; i++) {
+		atomic_clear(&recv_count[i]);
+		atomic_clear(&batch_count[i]);
+	}
+
+	atomic_clear(&unknown_count);
+}
+
+/* Scan for a while with the filter just set, and check which advertisers
+ * the reports came from, one at a time and in batches.
+ */
+static void check_reports(const char *step, bool uuid_expected, bool other_expected)
+{
+	const bool expected[ADV_COUNT] = {
+		[ADV_UUID] = uuid_expected,
+		[ADV_OTHER] = other_expected,
+	};
+
+	k_sleep(SETTLE_TIME);
+	reset_counts();
+	k_sleep(SCAN_TIME);
+
+	for (int i = 0; i < ADV_COUNT; i++) {
+		atomic_val_t recv = atomic_get(&recv_count[i]);
+		atomic_val_t batch = atomic_get(&batch_count[i]);
+
+		printk("%s: advertiser %d, %ld reports, %ld batched\n", step, i,
+		       (long)recv, (long)batch);
+
+		if (expected[i] && (recv == 0 || batch == 0)) {
+			FAIL("%s: no report of advertiser %d\n", step, i);
+		} else if (!expected[i] && (recv != 0 || batch != 0)) {
+			FAIL("%s: reports of filtered advertiser %d\n", step, i);
+		}
+	}
+
+	if (atomic_get(&unknown_count) != 0) {
+		FAIL("%s: reports of unknown advertisers\n", step);
+	}
+}
+
+static void test_scan_main(void)
+{
+	const uint8_t uuid[] = { TEST_UUID };
+	const uint8_t long_data[CONFIG_BT_SCAN_FILTER_DATA_LEN + 1] = { 0 };
+	bt_addr_le_t addr;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	bt_le_scan_cb_register(&scan_callbacks);
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, NULL);
+	if (err) {
+		FAIL("Scanning failed to start (err %d)\n", err);
+		return;
+	}
+
+	/* An empty filter lets every report through */
+	check_reports("no filter", true, true);
+	if (!other_addr_valid) {
+		FAIL("Address of the other advertiser not found\n");
+		return;
+	}
+
+	/* The filter is changed while scanning */
+	err = bt_le_scan_filter_add_data(BT_DATA_UUID16_ALL, uuid, sizeof(uuid));
+	if (err) {
+		FAIL("Adding the UUID pattern failed (err %d)\n", err);
+		return;
+	}
+
+	check_reports("uuid", true, false);
+
+	bt_le_scan_filter_clear();
+	err = bt_le_scan_filter_add_addr(&other_addr);
+	if (err) {
+		FAIL("Adding the address failed (err %d)\n", err);
+		return;
+	}
+
+	check_reports("address", false, true);
+
+	/* The filter matches one advertiser or the other */
+	err = bt_le_scan_filter_add_data(BT_DATA_UUID16_ALL, uuid, sizeof(uuid));
+	if (err) {
+		FAIL("Adding the UUID pattern failed (err %d)\n", err);
+		return;
+	}
+
+	check_reports("address or uuid", true, true);
+
+	/* Fill the address table */
+	addr = other_addr;
+	for (int i = 1; i < CONFIG_BT_SCAN_FILTER_ADDR_COUNT; i++) {
+		addr.a.val[0]++;
+		err = bt_le_scan_filter_add_addr(&addr);
+		if (err) {
+			FAIL("Adding address %d failed (err %d)\n", i, err);
+			return;
+		}
+	}
+
+	addr.a.val[0]++;
+	err = bt_le_scan_filter_add_addr(&addr);
+	if (err != -ENOMEM) {
+		FAIL("Address added to a full filter (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_scan_filter_add_data(BT_DATA_NAME_COMPLETE, long_data, sizeof(long_data));
+	if (err != -EINVAL) {
+		FAIL("Pattern longer than the maximum added (err %d)\n", err);
+		return;
+	}
+
+	bt_le_scan_filter_clear();
+	check_reports("cleared", true, true);
+
+	err = bt_le_scan_stop();
+	if (err) {
+		FAIL("Scanning failed to stop (err %d)\n", err);
+		return;
+	}
+
+	if (bst_result != Failed) {
+		PASS("Scan tests passed\n");
+	}
+}
+
+static void adv_main(const struct bt_data *ad, size_t ad_len)
+{
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_NCONN_IDENTITY, ad, ad_len, NULL, 0);
+	if (err) {
+		FAIL("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	PASS("Advertiser started\n");
+}
+
+static void test_adv_uuid_main(void)
+{
+	const struct bt_data ad[] = {
+		BT_DATA_BYTES(BT_DATA_FLAGS, BT_LE_AD_NO_BREDR),
+		BT_DATA_BYTES(BT_DATA_UUID16_ALL, TEST_UUID_LIST),
+	};
+
+	adv_main(ad, ARRAY_SIZE(ad));
+}
+
+static void test_adv_other_main(void)
+{
+	const struct bt_data ad[] = {
+		BT_DATA_BYTES(BT_DATA_FLAGS, BT_LE_AD_NO_BREDR),
+		BT_DATA_BYTES(BT_DATA_MANUFACTURER_DATA, TEST_MFG_DATA),
+	};
+
+	adv_main(ad, ARRAY_SIZE(ad));
+}
+
+static void test_scan_filter_init(void)
+{
+	bst_ticker_set_next_tick_absolute(WAIT_TIME_S * 1e6);
+	bst_result = In_progress;
+}
+
+static void test_scan_filter_tick(bs_time_t HW_device_time)
+{
+	if (bst_result != Passed) {
+		bst_result = Failed;
+		bs_trace_error_time_line("Test failed (not passed after %d seconds)\n",
+					 WAIT_TIME_S);
+	}
+}
+
+static const struct bst_test_instance test_def[] = {
+	{
+		.test_id = "adv_uuid",
+		.test_descr = "Advertiser of a UUID list",
+		.test_post_init_f = test_scan_filter_init,
+		.test_tick_f = test_scan_filter_tick,
+		.test_main_f = test_adv_uuid_main
+	},
+	{
+		.test_id = "adv_other",
+		.test_descr = "Advertiser of manufacturer data",
+		.test_post_init_f = test_scan_filter_init,
+		.test_tick_f = test_scan_filter_tick,
+		.test_main_f = test_adv_other_main
+	},
+	{
+		.test_id = "scan",
+		.test_descr = "Scanner changing its scan filter",
+		.test_post_init_f = test_scan_filter_init,
+		.test_tick_f = test_scan_filter_tick,
+		.test_main_f = test_scan_main
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_scan_filter_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_def);
+}
+
+bst_test_install_t test_installers[] = {
+	test_scan_filter_install,
+	NULL
+};
+
+int main(void)
+{
+	bst_main();
+	return 0;
+}
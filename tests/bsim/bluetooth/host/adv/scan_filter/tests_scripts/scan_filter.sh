@@ -0,0 +1,27 @@
+#!/usr/bin/env bash
+# Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+# Host scan filter and batched reports: a scanner changes its scan filter
+# while it scans two advertisers, and checks that the reports it gets, one
+# at a time and in batches, are only those of the filter.
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+simulation_id="adv_scan_filter"
+verbosity_level=2
+
+cd ${BSIM_OUT_PATH}/bin
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_host_adv_scan_filter_prj_conf \
+  -v=${verbosity_level} -s=${simulation_id} -d=0 -testid=adv_uuid
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_host_adv_scan_filter_prj_conf \
+  -v=${verbosity_level} -s=${simulation_id} -d=1 -testid=adv_other
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_host_adv_scan_filter_prj_conf \
+  -v=${verbosity_level} -s=${simulation_id} -d=2 -testid=scan
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=${simulation_id} \
+  -D=3 -sim_length=20e6 $@
+
+wait_for_background_jobs
@@ -0,0 +1,413 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <stdlib.h>
+
+#include "common.h"
+
+CREATE_FLAG(flag_is_connected);
+CREATE_FLAG(flag_security_changed);
+CREATE_FLAG(flag_bonded);
+CREATE_FLAG(flag_discover_all_complete);
+CREATE_FLAG(flag_read_complete);
+
+#define MAX_ATTRS CONFIG_BT_GATT_CLIENT_CACHE_ATTRS
+
+struct found_attr {
+	uint16_t handle;
+	uint8_t type;
+};
+
+/* Attributes found on the first connection, and on the current one */
+static struct found_attr first_attrs[MAX_ATTRS];
+static size_t first_count;
+static struct found_attr found_attrs[MAX_ATTRS];
+static size_t found_count;
+static int discover_all_err;
+
+static struct bt_conn *g_conn;
+static uint16_t count_handle;
+static bool new_svc_found;
+static uint16_t svc_reads;
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	if (err != 0) {
+		FAIL("Failed to connect to %s (%u)\n", addr, err);
+		return;
+	}
+
+	printk("Connected to %s\n", addr);
+
+	__ASSERT_NO_MSG(g_conn == conn);
+
+	SET_FLAG(flag_is_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	if (conn != g_conn) {
+		return;
+	}
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	printk("Disconnected: %s (reason 0x%02x)\n", addr, reason);
+
+	bt_conn_unref(g_conn);
+
+	g_conn = NULL;
+	UNSET_FLAG(flag_is_connected);
+}
+
+static void security_changed(struct bt_conn *conn, bt_security_t level, enum bt_security_err err)
+{
+	if (err != BT_SECURITY_ERR_SUCCESS) {
+		FAIL("Security failed (err %d)\n", err);
+	} else {
+		SET_FLAG(flag_security_changed);
+	}
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.security_changed = security_changed,
+};
+
+static void pairing_complete(struct bt_conn *conn, bool bonded)
+{
+	if (!bonded) {
+		FAIL("Paired without bonding\n");
+		return;
+	}
+
+	SET_FLAG(flag_bonded);
+}
+
+static struct bt_conn_auth_info_cb auth_info_cb = {
+	.pairing_complete = pairing_complete,
+};
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			 struct net_buf_simple *ad)
+{
+	char addr_str[BT_ADDR_LE_STR_LEN];
+	int err;
+
+	if (g_conn != NULL) {
+		return;
+	}
+
+	/* We're only interested in connectable events */
+	if (type != BT_HCI_ADV_IND && type != BT_HCI_ADV_DIRECT_IND) {
+		return;
+	}
+
+	bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+	printk("Device found: %s (RSSI %d)\n", addr_str, rssi);
+
+	printk("Stopping scan\n");
+	err = bt_le_scan_stop();
+	if (err != 0) {
+		FAIL("Could not stop scan: %d\n", err);
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN,
+				BT_LE_CONN_PARAM_DEFAULT, &g_conn);
+	if (err != 0) {
+		FAIL("Could not connect to peer: %d\n", err);
+	}
+}
+
+static void connect_secure(void)
+{
+	int err;
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+	if (err != 0) {
+		FAIL("Scanning failed to start (err %d)\n", err);
+		return;
+	}
+
+	printk("Scanning successfully started\n");
+
+	WAIT_FOR_FLAG(flag_is_connected);
+
+	err = bt_conn_set_security(g_conn, BT_SECURITY_L2);
+	if (err != 0) {
+		FAIL("Set security failed (err %d)\n", err);
+		return;
+	}
+
+	WAIT_FOR_FLAG(flag_security_changed);
+	UNSET_FLAG(flag_security_changed);
+
+	/* The cache is only stored for bonded servers */
+	WAIT_FOR_FLAG(flag_bonded);
+	printk("Security changed\n");
+}
+
+static void disconnect(void)
+{
+	int err;
+
+	err = bt_conn_disconnect(g_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	if (err != 0) {
+		FAIL("Disconnection failed (err %d)\n", err);
+		return;
+	}
+
+	while (g_conn != NULL) {
+		(void)k_sleep(K_MSEC(1));
+	}
+}
+
+static uint8_t discover_all_func(struct bt_conn *conn,
+				 const struct bt_gatt_attr *attr,
+				 struct bt_gatt_discover_params *params)
+{
+	const struct bt_gatt_service_val *svc;
+	const struct bt_gatt_chrc *chrc;
+
+	if (found_count == ARRAY_SIZE(found_attrs)) {
+		FAIL("Too many attributes\n");
+		return BT_GATT_ITER_STOP;
+	}
+
+	found_attrs[found_count].handle = attr->handle;
+	found_attrs[found_count].type = params->type;
+	found_count++;
+
+	switch (params->type) {
+	case BT_GATT_DISCOVER_PRIMARY:
+		svc = attr->user_data;
+		if (bt_uuid_cmp(svc->uuid, TEST_NEW_SERVICE_UUID) == 0) {
+			new_svc_found = true;
+		}
+		break;
+	case BT_GATT_DISCOVER_CHARACTERISTIC:
+		chrc = attr->user_data;
+		if (bt_uuid_cmp(chrc->uuid, TEST_COUNT_CHRC_UUID) == 0) {
+			count_handle = chrc->value_handle;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void discover_all_done(struct bt_conn *conn, int err,
+			      struct bt_gatt_discover_all_params *params)
+{
+	discover_all_err = err;
+
+	SET_FLAG(flag_discover_all_complete);
+}
+
+static int cmp_attrs(const void *a, const void *b)
+{
+	return ((const struct found_attr *)a)->handle - ((const struct found_attr *)b)->handle;
+}
+
+static bool same_attrs(void)
+{
+	if (found_count != first_count) {
+		return false;
+	}
+
+	for (size_t i = 0; i < found_count; i++) {
+		if (found_attrs[i].handle != first_attrs[i].handle ||
+		    found_attrs[i].type != first_attrs[i].type) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void gatt_discover_all(void)
+{
+	static struct bt_gatt_discover_all_params all_params;
+	int err;
+
+	printk("Discovering all attributes\n");
+
+	found_count = 0;
+	count_handle = 0;
+	new_svc_found = false;
+
+	all_params.func = discover_all_func;
+	all_params.done = discover_all_done;
+
+	UNSET_FLAG(flag_discover_all_complete);
+
+	err = bt_gatt_discover_all(g_conn, &all_params);
+	if (err != 0) {
+		FAIL("Discovery failed (err %d)\n", err);
+		return;
+	}
+
+	WAIT_FOR_FLAG(flag_discover_all_complete);
+
+	if (discover_all_err != 0) {
+		FAIL("Discovery ended with err %d\n", discover_all_err);
+		return;
+	}
+
+	if (count_handle == 0) {
+		FAIL("Did not discover the count chrc\n");
+		return;
+	}
+
+	/* The cache gives the attributes in the order they were stored */
+	qsort(found_attrs, found_count, sizeof(found_attrs[0]), cmp_attrs);
+
+	printk("Discovery complete: %zu attributes\n", found_count);
+}
+
+static uint8_t read_cb(struct bt_conn *conn, uint8_t err,
+		       struct bt_gatt_read_params *params,
+		       const void *data, uint16_t length)
+{
+	if (err != BT_ATT_ERR_SUCCESS) {
+		FAIL("Read failed: 0x%02X\n", err);
+	} else if (data != NULL) {
+		if (length != sizeof(svc_reads)) {
+			FAIL("Invalid count length %u\n", length);
+		} else {
+			svc_reads = sys_get_le16(data);
+		}
+	}
+
+	(void)memset(params, 0, sizeof(*params));
+
+	SET_FLAG(flag_read_complete);
+
+	return BT_GATT_ITER_STOP;
+}
+
+/* Number of times the server has been asked for its test service */
+static uint16_t read_svc_reads(void)
+{
+	static struct bt_gatt_read_params read_params;
+	int err;
+
+	read_params.func = read_cb;
+	read_params.handle_count = 1;
+	read_params.single.handle = count_handle;
+	read_params.single.offset = 0;
+
+	UNSET_FLAG(flag_read_complete);
+
+	err = bt_gatt_read(g_conn, &read_params);
+	if (err != 0) {
+		FAIL("bt_gatt_read failed: %d\n", err);
+		return 0;
+	}
+
+	WAIT_FOR_FLAG(flag_read_complete);
+
+	return svc_reads;
+}
+
+static void test_main(void)
+{
+	uint16_t reads;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err != 0) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	printk("Bluetooth initialized\n");
+
+	err = settings_load();
+	if (err != 0) {
+		FAIL("Settings load failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_conn_auth_info_cb_register(&auth_info_cb);
+	if (err != 0) {
+		FAIL("Auth info callback registration failed (err %d)\n", err);
+		return;
+	}
+
+	/* Bond and discover: the database is stored */
+	connect_secure();
+	gatt_discover_all();
+	reads = read_svc_reads();
+	if (reads == 0) {
+		FAIL("The test service was not discovered\n");
+		return;
+	}
+
+	memcpy(first_attrs, found_attrs, found_count * sizeof(found_attrs[0]));
+	first_count = found_count;
+	disconnect();
+
+	/* Same Database Hash: the attributes come from the cache */
+	connect_secure();
+	gatt_discover_all();
+	if (read_svc_reads() != reads) {
+		FAIL("Database discovered again with the same Database Hash\n");
+		return;
+	}
+
+	if (!same_attrs()) {
+		FAIL("Cache gave %zu of %zu attributes\n", found_count, first_count);
+		return;
+	}
+
+	disconnect();
+
+	/* The server has registered a service: the database is discovered */
+	connect_secure();
+	gatt_discover_all();
+	if (read_svc_reads() == reads) {
+		FAIL("Cached database given after the Database Hash changed\n");
+		return;
+	}
+
+	if (!new_svc_found || found_count <= first_count) {
+		FAIL("New service not discovered\n");
+		return;
+	}
+
+	disconnect();
+
+	PASS("GATT client Passed\n");
+}
+
+static const struct bst_test_instance test_vcs[] = {
+	{
+		.test_id = "gatt_client",
+		.test_post_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_main
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_gatt_client_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_vcs);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "common.h"
+
+CREATE_FLAG(flag_is_connected);
+CREATE_FLAG(flag_is_disconnected);
+
+static struct bt_conn *g_conn;
+
+/* Reads of the test service declaration, done by the discoveries only */
+static uint16_t svc_reads;
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	if (err != 0) {
+		FAIL("Failed to connect to %s (%u)\n", addr, err);
+		return;
+	}
+
+	printk("Connected to %s\n", addr);
+
+	g_conn = bt_conn_ref(conn);
+	SET_FLAG(flag_is_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	if (conn != g_conn) {
+		return;
+	}
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	printk("Disconnected: %s (reason 0x%02x)\n", addr, reason);
+
+	bt_conn_unref(g_conn);
+
+	g_conn = NULL;
+	UNSET_FLAG(flag_is_connected);
+	SET_FLAG(flag_is_disconnected);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static ssize_t read_counted_service(struct bt_conn *conn,
+				    const struct bt_gatt_attr *attr,
+				    void *buf, uint16_t len, uint16_t offset)
+{
+	svc_reads++;
+
+	return bt_gatt_attr_read_service(conn, attr, buf, len, offset);
+}
+
+static ssize_t read_count_chrc(struct bt_conn *conn,
+			       const struct bt_gatt_attr *attr,
+			       void *buf, uint16_t len, uint16_t offset)
+{
+	uint16_t value = sys_cpu_to_le16(svc_reads);
+
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, &value, sizeof(value));
+}
+
+BT_GATT_SERVICE_DEFINE(test_svc,
+	BT_GATT_ATTRIBUTE(BT_UUID_GATT_PRIMARY, BT_GATT_PERM_READ,
+			  read_counted_service, NULL, (void *)TEST_SERVICE_UUID),
+	BT_GATT_CHARACTERISTIC(TEST_COUNT_CHRC_UUID, BT_GATT_CHRC_READ,
+			       BT_GATT_PERM_READ, read_count_chrc, NULL, NULL),
+);
+
+static struct bt_gatt_attr new_attrs[] = {
+	BT_GATT_PRIMARY_SERVICE(TEST_NEW_SERVICE_UUID),
+	BT_GATT_CHARACTERISTIC(TEST_NEW_CHRC_UUID, BT_GATT_CHRC_READ,
+			       BT_GATT_PERM_READ, read_count_chrc, NULL, NULL),
+};
+
+static struct bt_gatt_service new_svc = BT_GATT_SERVICE(new_attrs);
+
+static void test_main(void)
+{
+	int err;
+	const struct bt_data ad[] = {
+		BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR))
+	};
+
+	err = bt_enable(NULL);
+	if (err != 0) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	printk("Bluetooth initialized\n");
+
+	err = settings_load();
+	if (err != 0) {
+		FAIL("Settings load failed (err %d)\n", err);
+		return;
+	}
+
+	for (int i = 0; i < CONN_COUNT; i++) {
+		err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+		if (err != 0) {
+			FAIL("Advertising failed to start (err %d)\n", err);
+			return;
+		}
+
+		printk("Advertising successfully started\n");
+
+		WAIT_FOR_FLAG(flag_is_connected);
+		WAIT_FOR_FLAG(flag_is_disconnected);
+		UNSET_FLAG(flag_is_disconnected);
+
+		/* Change the Database Hash before the last connection */
+		if (i == CONN_COUNT - 2) {
+			err = bt_gatt_service_register(&new_svc);
+			if (err != 0) {
+				FAIL("Service registration failed (err %d)\n", err);
+				return;
+			}
+		}
+	}
+
+	PASS("GATT server passed\n");
+}
+
+static const struct bst_test_instance test_gatt_server[] = {
+	{
+		.test_id = "gatt_server",
+		.test_post_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_main
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_gatt_server_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_gatt_server);
+}
@@ -0,0 +1,29 @@
+#!/usr/bin/env bash
+# Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+# GATT client cache test: a central bonds with a peripheral, discovers its
+# database and reconnects twice. The database must be given from the cache
+# on the first reconnection, and discovered again on the second one, once
+# the peripheral has registered a new service.
+
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+simulation_id="gatt_client_cache"
+verbosity_level=2
+EXECUTE_TIMEOUT=120
+
+cd ${BSIM_OUT_PATH}/bin
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_host_gatt_client_cache_prj_conf \
+  -v=${verbosity_level} -s=${simulation_id} -d=0 -testid=gatt_client \
+  -flash="${simulation_id}_client.log.bin" -flash_rm
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_host_gatt_client_cache_prj_conf \
+  -v=${verbosity_level} -s=${simulation_id} -d=1 -testid=gatt_server \
+  -flash="${simulation_id}_server.log.bin" -flash_rm
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=${simulation_id} \
+  -D=2 -sim_length=60e6 $@
+
+wait_for_background_jobs
@@ -12,7 +12,9 @@ source ${ZEPHYR_BASE}/tests/bsim/compile.source
 
 app=tests/bsim/bluetooth/host/gatt/authorization compile
 app=tests/bsim/bluetooth/host/gatt/caching compile
+app=tests/bsim/bluetooth/host/gatt/client_cache compile
 app=tests/bsim/bluetooth/host/gatt/general compile
+app=tests/bsim/bluetooth/host/gatt/general conf_file=prj_discover_pipeline.conf compile
 app=tests/bsim/bluetooth/host/gatt/notify compile
 app=tests/bsim/bluetooth/host/gatt/notify_multiple compile
 app=tests/bsim/bluetooth/host/gatt/settings compile
@@ -7,6 +7,8 @@
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/gatt.h>
 
+#include <stdlib.h>
+
 #include "common.h"
 
 CREATE_FLAG(flag_is_connected);
@@ -14,6 +16,7 @@ CREATE_FLAG(flag_discover_complete);
 CREATE_FLAG(flag_security_changed);
 CREATE_FLAG(flag_write_complete);
 CREATE_FLAG(flag_read_complete);
+CREATE_FLAG(flag_discover_all_complete);
 
 static struct bt_conn *g_conn;
 static uint16_t chrc_handle;
@@ -189,6 +192,141 @@ static void gatt_discover(void)
 	printk("Discover complete\n");
 }
 
+#if defined(CONFIG_BT_GATT_DISCOVER_PIPELINE)
+#define MAX_ATTRS 32
+
+/* Handles found by the attribute discovery, and by the pipelined discovery */
+static uint16_t attr_handles[MAX_ATTRS];
+static size_t attr_count;
+static uint16_t found_handles[MAX_ATTRS];
+static size_t found_count;
+static int discover_all_err;
+
+static void add_handle(uint16_t *handles, size_t *count, uint16_t handle)
+{
+	for (size_t i = 0; i < *count; i++) {
+		if (handles[i] == handle) {
+			FAIL("Handle 0x%04x found twice\n", handle);
+			return;
+		}
+	}
+
+	if (*count == MAX_ATTRS) {
+		FAIL("Too many attributes\n");
+		return;
+	}
+
+	handles[(*count)++] = handle;
+}
+
+static uint8_t discover_attr_func(struct bt_conn *conn,
+				  const struct bt_gatt_attr *attr,
+				  struct bt_gatt_discover_params *params)
+{
+	if (attr == NULL) {
+		(void)memset(params, 0, sizeof(*params));
+		SET_FLAG(flag_discover_complete);
+
+		return BT_GATT_ITER_STOP;
+	}
+
+	add_handle(attr_handles, &attr_count, attr->handle);
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static uint8_t discover_all_func(struct bt_conn *conn,
+				 const struct bt_gatt_attr *attr,
+				 struct bt_gatt_discover_params *params)
+{
+	const struct bt_gatt_chrc *chrc;
+
+	if (attr == NULL) {
+		FAIL("Pipelined discovery called back without attribute\n");
+		return BT_GATT_ITER_STOP;
+	}
+
+	add_handle(found_handles, &found_count, attr->handle);
+
+	if (params->type == BT_GATT_DISCOVER_CHARACTERISTIC) {
+		chrc = attr->user_data;
+		add_handle(found_handles, &found_count, chrc->value_handle);
+
+		if (bt_uuid_cmp(chrc->uuid, TEST_CHRC_UUID) == 0 &&
+		    chrc->value_handle != chrc_handle) {
+			FAIL("Wrong chrc handle 0x%04x\n", chrc->value_handle);
+		}
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void discover_all_done(struct bt_conn *conn, int err,
+			      struct bt_gatt_discover_all_params *params)
+{
+	discover_all_err = err;
+
+	SET_FLAG(flag_discover_all_complete);
+}
+
+static int cmp_handles(const void *a, const void *b)
+{
+	return *(const uint16_t *)a - *(const uint16_t *)b;
+}
+
+/* The pipelined discovery finds the services, the characteristics and their
+ * values, and the descriptors: that is every attribute of the server.
+ */
+static void gatt_discover_all(void)
+{
+	static struct bt_gatt_discover_params discover_params;
+	static struct bt_gatt_discover_all_params all_params;
+	int err;
+
+	printk("Discovering all attributes\n");
+
+	discover_params.uuid = NULL;
+	discover_params.func = discover_attr_func;
+	discover_params.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	discover_params.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	discover_params.type = BT_GATT_DISCOVER_ATTRIBUTE;
+
+	UNSET_FLAG(flag_discover_complete);
+
+	err = bt_gatt_discover(g_conn, &discover_params);
+	if (err != 0) {
+		FAIL("Discover failed (err %d)\n", err);
+	}
+
+	WAIT_FOR_FLAG(flag_discover_complete);
+
+	printk("Pipelined discovery\n");
+
+	all_params.func = discover_all_func;
+	all_params.done = discover_all_done;
+
+	err = bt_gatt_discover_all(g_conn, &all_params);
+	if (err != 0) {
+		FAIL("Pipelined discovery failed (err %d)\n", err);
+	}
+
+	WAIT_FOR_FLAG(flag_discover_all_complete);
+
+	if (discover_all_err != 0) {
+		FAIL("Pipelined discovery ended with err %d\n", discover_all_err);
+	}
+
+	qsort(found_handles, found_count, sizeof(found_handles[0]), cmp_handles);
+
+	if (found_count != attr_count ||
+	    memcmp(found_handles, attr_handles, attr_count * sizeof(attr_handles[0])) != 0) {
+		FAIL("Pipelined discovery found %zu of %zu attributes\n", found_count, attr_count);
+	}
+
+	printk("Pipelined discovery complete\n");
+}
+#endif /* CONFIG_BT_GATT_DISCOVER_PIPELINE */
+
 static void update_security(void)
 {
 	int err;
@@ -367,6 +505,10 @@ static void test_main(void)
 
 	gatt_discover();
 
+#if defined(CONFIG_BT_GATT_DISCOVER_PIPELINE)
+	gatt_discover_all();
+#endif /* CONFIG_BT_GATT_DISCOVER_PIPELINE */
+
 	/* Write and read a few times to ensure stateless behavior */
 	for (size_t i = 0; i < 3; i++) {
 		gatt_write(chrc_handle, BT_ATT_ERR_SUCCESS);
@@ -14,6 +14,7 @@ app=tests/bsim/bluetooth/host/l2cap/general compile
 app=tests/bsim/bluetooth/host/l2cap/userdata compile
 app=tests/bsim/bluetooth/host/l2cap/stress compile
 app=tests/bsim/bluetooth/host/l2cap/stress conf_file=prj_syswq.conf compile
+app=tests/bsim/bluetooth/host/l2cap/stress conf_file=prj_tx_sched.conf compile
 app=tests/bsim/bluetooth/host/l2cap/split/dut compile
 app=tests/bsim/bluetooth/host/l2cap/split/tester compile
 app=tests/bsim/bluetooth/host/l2cap/credits compile
@@ -21,6 +22,7 @@ app=tests/bsim/bluetooth/host/l2cap/credits conf_file=prj_ecred.conf compile
 app=tests/bsim/bluetooth/host/l2cap/credits_seg_recv compile
 app=tests/bsim/bluetooth/host/l2cap/credits_seg_recv conf_file=prj_ecred.conf compile
 app=tests/bsim/bluetooth/host/l2cap/frags compile
+app=tests/bsim/bluetooth/host/l2cap/frags conf_file=prj_zero_copy.conf compile
 app=tests/bsim/bluetooth/host/l2cap/send_on_connect compile
 app=tests/bsim/bluetooth/host/l2cap/send_on_connect conf_file=prj_ecred.conf compile
 
@@ -8,5 +8,6 @@ INCR_BUILD=1
 source ${ZEPHYR_BASE}/tests/bsim/compile.source
 
 app="$(guess_test_relpath)" compile
+app="$(guess_test_relpath)" conf_file=prj_zero_copy.conf compile
 
 wait_for_background_jobs
@@ -23,6 +23,9 @@ CREATE_FLAG(flag_l2cap_connected);
 #define NUM_SEGMENTS    10
 #define RESCHEDULE_DELAY K_MSEC(100)
 
+/* With the TX scheduler, no channel gets more SDUs ahead of another */
+#define MAX_SDU_SPREAD  4
+
 static void sdu_destroy(struct net_buf *buf)
 {
 	LOG_DBG("%p", buf);
@@ -144,6 +147,23 @@ void continue_sending(struct test_ctx *ctx)
 	}
 }
 
+static void check_fairness(void)
+{
+	size_t min_left = SDU_NUM;
+	size_t max_left = 0;
+
+	for (int i = 0; i < L2CAP_CHANS; i++) {
+		min_left = MIN(min_left, contexts[i].tx_left);
+		max_left = MAX(max_left, contexts[i].tx_left);
+	}
+
+	/* Only while all channels still have data to send */
+	if (min_left) {
+		ASSERT(max_left - min_left <= MAX_SDU_SPREAD,
+		       "Unfair TX: %zu to %zu SDUs left\n", min_left, max_left);
+	}
+}
+
 void sent_cb(struct bt_l2cap_chan *chan)
 {
 	struct test_ctx *ctx = get_ctx(chan);
@@ -154,6 +174,10 @@ void sent_cb(struct bt_l2cap_chan *chan)
 		ctx->tx_left--;
 	}
 
+	if (IS_ENABLED(CONFIG_BT_CONN_TX_SCHED)) {
+		check_fairness();
+	}
+
 	continue_sending(ctx);
 }
 
@@ -458,6 +482,9 @@ static void test_central_main(void)
 	/* Send SDU_NUM SDUs to each peripheral */
 	for (int i = 0; i < NUM_PERIPHERALS; i++) {
 		contexts[i].tx_left = SDU_NUM;
+	}
+
+	for (int i = 0; i < NUM_PERIPHERALS; i++) {
 		l2cap_chan_send(&contexts[i].le_chan.chan, tx_data, sizeof(tx_data));
 	}
 
@@ -9,5 +9,6 @@ source ${ZEPHYR_BASE}/tests/bsim/compile.source
 
 app="$(guess_test_relpath)" compile
 app="$(guess_test_relpath)" conf_file=prj_syswq.conf compile
+app="$(guess_test_relpath)" conf_file=prj_tx_sched.conf compile
 
 wait_for_background_jobs
@@ -161,4 +161,65 @@ ZTEST_USER(crypto_hash, test_hash)
 	hash_free_session(dev, &ctx);
 }
 
+#if defined(CONFIG_CRYPTO_ASYNC)
+static K_SEM_DEFINE(async_done, 0, ARRAY_SIZE(sha256_results));
+
+static void hash_async_cb(struct crypto_async_req *req, int result)
+{
+	zassert_equal(result, 0, "Failed to compute hash for test %d",
+		      POINTER_TO_INT(req->user_data));
+	k_sem_give(&async_done);
+}
+
+ZTEST(crypto_hash, test_hash_async)
+{
+	static uint8_t *const tests[] = { test1, test2, test3, test4, test5, test6, test7 };
+	static const size_t lens[] = { sizeof(test1), sizeof(test2), sizeof(test3),
+				       sizeof(test4), sizeof(test5), sizeof(test6),
+				       sizeof(test7) };
+	static uint8_t out_bufs[ARRAY_SIZE(tests)][32];
+	static struct hash_pkt pkts[ARRAY_SIZE(tests)];
+	static struct crypto_async_req reqs[ARRAY_SIZE(tests)];
+	const struct device *dev = device_get_binding(CRYPTO_DRV_NAME);
+	struct hash_ctx ctx;
+	int ret;
+
+	ctx.flags = CAP_SYNC_OPS | CAP_SEPARATE_IO_BUFS;
+
+	ret = hash_begin_session(dev, &ctx, CRYPTO_HASH_ALGO_SHA256);
+	zassert_true(ret == 0, "Failed to init sha256 session");
+
+	/* All the requests are queued before the first one completes */
+	for (int i = 0; i < ARRAY_SIZE(tests); i++) {
+		pkts[i] = (struct hash_pkt) {
+			.in_buf = tests[i],
+			.in_len = lens[i],
+			.out_buf = out_bufs[i],
+		};
+		reqs[i] = (struct crypto_async_req) {
+			.op = CRYPTO_ASYNC_HASH_COMPUTE,
+			.hash_ctx = &ctx,
+			.hash_pkt = &pkts[i],
+			.cb = hash_async_cb,
+			.user_data = INT_TO_POINTER(i + 1),
+		};
+
+		ret = crypto_async_submit(&reqs[i]);
+		zassert_true(ret == 0, "Failed to submit test %d", i + 1);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(tests); i++) {
+		ret = k_sem_take(&async_done, K_SECONDS(1));
+		zassert_true(ret == 0, "Missing completion");
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(tests); i++) {
+		ret = memcmp(out_bufs[i], sha256_results[i], 32);
+		zassert_true(ret == 0, "Wrong hash for test %d", i + 1);
+	}
+
+	hash_free_session(dev, &ctx);
+}
+#endif /* CONFIG_CRYPTO_ASYNC */
+
 ZTEST_SUITE(crypto_hash, NULL, NULL, NULL, NULL, NULL);
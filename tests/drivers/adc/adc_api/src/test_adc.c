@@ -229,6 +229,43 @@ ZTEST_USER(adc_basic, test_adc_asynchronous_call)
 #endif /* defined(CONFIG_ADC_ASYNC) */
 }
 
+/*
+ * test_adc_sample_without_callback
+ */
+static int test_task_without_callback(void)
+{
+	int ret;
+	const struct adc_sequence_options options = {
+		/* Short enough to be paced by the hardware where possible */
+		.interval_us     = 100,
+		.extra_samplings = 4,
+	};
+	struct adc_sequence sequence = {
+		.options     = &options,
+		.buffer      = m_sample_buffer,
+		.buffer_size = sizeof(m_sample_buffer),
+	};
+
+	init_adc();
+
+	(void)adc_sequence_init_dt(&adc_channels[0], &sequence);
+
+	ret = adc_read_dt(&adc_channels[0], &sequence);
+	if (ret == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_equal(ret, 0, "adc_read() failed with code %d", ret);
+
+	check_samples(1 + options.extra_samplings);
+
+	return TC_PASS;
+}
+
+ZTEST(adc_basic, test_adc_sample_without_callback)
+{
+	zassert_true(test_task_without_callback() == TC_PASS);
+}
+
 /*
  * test_adc_sample_with_interval
  */
@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <zephyr/drivers/can.h>
 #include <zephyr/ztest.h>
 
@@ -795,6 +797,127 @@ ZTEST_USER(can_classic, test_send_receive_msgq)
 	can_remove_rx_filter(can_dev, filter_id);
 }
 
+/**
+ * @brief Test send/receive of batches of frames.
+ */
+ZTEST(can_classic, test_send_receive_batch)
+{
+	struct can_frame frames[3];
+	int filter_id;
+	int nframes;
+	int err;
+	int i;
+
+	k_sem_reset(&tx_callback_sem);
+	filter_id = add_rx_msgq(can_dev, &test_std_filter_1);
+
+	for (i = 0; i < ARRAY_SIZE(frames); i++) {
+		frames[i] = test_std_frame_1;
+	}
+
+	err = can_send_batch(can_dev, frames, ARRAY_SIZE(frames), TEST_SEND_TIMEOUT,
+			     tx_std_callback_1, (void *)&test_std_frame_1);
+	zassert_equal(err, ARRAY_SIZE(frames), "failed to send batch (err %d)", err);
+
+	for (i = 0; i < ARRAY_SIZE(frames); i++) {
+		err = k_sem_take(&tx_callback_sem, TEST_SEND_TIMEOUT);
+		zassert_equal(err, 0, "missing TX callback");
+	}
+
+	/* Let all the frames reach the message queue */
+	k_sleep(K_MSEC(10));
+
+	(void)memset(frames, 0, sizeof(frames));
+	nframes = can_msgq_get_batch(&can_msgq, frames, ARRAY_SIZE(frames), TEST_RECEIVE_TIMEOUT);
+	zassert_equal(nframes, ARRAY_SIZE(frames), "received %d frames", nframes);
+
+	for (i = 0; i < nframes; i++) {
+		assert_frame_equal(&frames[i], &test_std_frame_1, 0);
+	}
+
+	nframes = can_msgq_get_batch(&can_msgq, frames, ARRAY_SIZE(frames), K_NO_WAIT);
+	zassert_equal(nframes, -ENOMSG, "received a frame without sending one");
+
+	can_remove_rx_filter(can_dev, filter_id);
+}
+
+static int peer_filter_ids[2];
+static atomic_t peer_rx_count[2];
+
+/**
+ * @brief Receive callback removing the other filter of the pair.
+ *
+ * See @a can_rx_callback_t() for argument description.
+ */
+static void rx_remove_peer_callback(const struct device *dev, struct can_frame *frame,
+				    void *user_data)
+{
+	int self = POINTER_TO_INT(user_data);
+
+	assert_frame_equal(frame, &test_std_frame_1, 0);
+	atomic_inc(&peer_rx_count[self]);
+
+	/* Fails once the peer is already removed */
+	(void)can_remove_rx_filter(dev, peer_filter_ids[!self]);
+}
+
+/**
+ * @brief Test removing a filter from the receive callback of another one.
+ *
+ * The filter removed while the frame is dispatched is not called, and the
+ * other filters matching the frame still are.
+ */
+ZTEST(can_classic, test_remove_filter_in_callback)
+{
+	int filter_id;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_CAN_SW_FILTER)) {
+		ztest_test_skip();
+	}
+
+	filter_id = add_rx_filter(can_dev, &test_std_filter_1, rx_std_callback_1);
+
+	for (int i = 0; i < ARRAY_SIZE(peer_filter_ids); i++) {
+		atomic_clear(&peer_rx_count[i]);
+		peer_filter_ids[i] = can_add_rx_filter(can_dev, rx_remove_peer_callback,
+						       INT_TO_POINTER(i), &test_std_filter_1);
+		zassert_true(peer_filter_ids[i] >= 0, "failed to add filter (err %d)",
+			     peer_filter_ids[i]);
+	}
+
+	for (int n = 1; n <= 2; n++) {
+		send_test_frame(can_dev, &test_std_frame_1);
+
+		err = k_sem_take(&rx_callback_sem, TEST_RECEIVE_TIMEOUT);
+		zassert_equal(err, 0, "frame %d not received by the remaining filter", n);
+
+		/* Let the frame reach all the filters */
+		k_sleep(K_MSEC(10));
+
+		/* Only the first one of the pair called is left */
+		zassert_equal(atomic_get(&peer_rx_count[0]) + atomic_get(&peer_rx_count[1]), n,
+			      "removed filter called");
+		zassert_true(atomic_get(&peer_rx_count[0]) == 0 ||
+			     atomic_get(&peer_rx_count[1]) == 0, "both filters of the pair called");
+	}
+
+	/* The filters removed during the dispatch are unlinked, their slots free */
+	for (int i = 0; i < ARRAY_SIZE(peer_filter_ids); i++) {
+		(void)can_remove_rx_filter(can_dev, peer_filter_ids[i]);
+	}
+
+	can_remove_rx_filter(can_dev, filter_id);
+
+	filter_id = add_rx_filter(can_dev, &test_std_filter_1, rx_std_callback_1);
+	send_test_frame(can_dev, &test_std_frame_1);
+
+	err = k_sem_take(&rx_callback_sem, TEST_RECEIVE_TIMEOUT);
+	zassert_equal(err, 0, "frame not received after the filters were removed");
+
+	can_remove_rx_filter(can_dev, filter_id);
+}
+
 /**
  * @brief Test send/receive with standard (11-bit) CAN IDs and remote transmission request (RTR).
  */
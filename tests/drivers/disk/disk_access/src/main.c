@@ -221,6 +221,72 @@ ZTEST(disk_driver, test_write)
 	}
 }
 
+#ifdef CONFIG_DISK_ACCESS_ASYNC
+#define ASYNC_REQS 4
+
+static K_SEM_DEFINE(async_sem, 0, ASYNC_REQS);
+static int async_results[ASYNC_REQS];
+
+static void async_cb(struct disk_access_req *req, int result)
+{
+	async_results[POINTER_TO_UINT(req->user_data)] = result;
+	k_sem_give(&async_sem);
+}
+
+/* Submit adjacent requests of one sector, which the queue can merge */
+static void async_sectors(uint8_t op, uint8_t *buf, uint32_t start)
+{
+	static struct disk_access_req reqs[ASYNC_REQS];
+	int rc;
+
+	for (int i = 0; i < ASYNC_REQS; i++) {
+		reqs[i] = (struct disk_access_req){
+			.op = op,
+			.buf = &buf[i * disk_sector_size],
+			.start_sector = start + i,
+			.num_sector = 1,
+			.cb = async_cb,
+			.user_data = UINT_TO_POINTER(i),
+		};
+		async_results[i] = -EINPROGRESS;
+		rc = disk_access_submit(disk_pdrv, &reqs[i]);
+		zassert_equal(rc, 0, "Failed to submit request %d", i);
+	}
+
+	for (int i = 0; i < ASYNC_REQS; i++) {
+		zassert_equal(k_sem_take(&async_sem, K_SECONDS(10)), 0,
+			      "Request did not complete");
+	}
+
+	for (int i = 0; i < ASYNC_REQS; i++) {
+		zassert_equal(async_results[i], 0, "Request %d failed", i);
+	}
+}
+
+/* Test asynchronous writes and reads against the synchronous API */
+ZTEST(disk_driver, test_async)
+{
+	uint32_t start = disk_sector_count / 2;
+	int rc;
+
+	for (int i = 0; i < ASYNC_REQS * disk_sector_size; i++) {
+		scratch_buf[0][i] = (uint8_t)(i * 7);
+	}
+
+	async_sectors(DISK_ACCESS_REQ_WRITE, scratch_buf[0], start);
+
+	memset(scratch_buf[1], 0, ASYNC_REQS * disk_sector_size);
+	rc = read_sector(scratch_buf[1], start, ASYNC_REQS);
+	zassert_equal(rc, 0, "Failed to read from disk");
+	zassert_mem_equal(scratch_buf[0], scratch_buf[1], ASYNC_REQS * disk_sector_size,
+			  "Async write mismatch");
+
+	memset(scratch_buf[1], 0, ASYNC_REQS * disk_sector_size);
+	async_sectors(DISK_ACCESS_REQ_READ, scratch_buf[1], start);
+	zassert_mem_equal(scratch_buf[0], scratch_buf[1], ASYNC_REQS * disk_sector_size,
+			  "Async read mismatch");
+}
+#endif /* CONFIG_DISK_ACCESS_ASYNC */
 
 static void *disk_driver_setup(void)
 {
@@ -159,3 +159,84 @@ ZTEST(dma_m2m_sg, test_dma_m2m_sg)
 {
 	zassert_true((test_sg() == TC_PASS));
 }
+
+#define CYCLIC_ROUNDS 3
+
+K_SEM_DEFINE(block_sem, 0, XFERS * CYCLIC_ROUNDS);
+
+static void dma_sg_cyclic_callback(const struct device *dma_dev, void *user_data,
+				   uint32_t channel, int status)
+{
+	if (status == DMA_STATUS_BLOCK) {
+		k_sem_give(&block_sem);
+	} else if (status < 0) {
+		TC_PRINT("callback status %d\n", status);
+	}
+}
+
+/* The list is transferred again and again until stopped */
+ZTEST(dma_m2m_sg, test_dma_m2m_sg_cyclic)
+{
+	const struct device *dma = DEVICE_DT_GET(DT_ALIAS(dma0));
+	uint32_t cyclic = 0U;
+	int chan_id;
+
+	zassert_true(device_is_ready(dma), "dma controller device is not ready");
+
+	if ((dma_get_attribute(dma, DMA_ATTR_CYCLIC, &cyclic) != 0) || (cyclic == 0U)) {
+		ztest_test_skip();
+	}
+
+	for (int i = 0; i < XFER_SIZE; i++) {
+		tx_data[i] = XFER_SIZE - i;
+	}
+	memset(rx_data, 0, sizeof(rx_data));
+	k_sem_reset(&block_sem);
+
+	memset(&dma_cfg, 0, sizeof(dma_cfg));
+	dma_cfg.channel_direction = MEMORY_TO_MEMORY;
+	dma_cfg.source_data_size = 4U;
+	dma_cfg.dest_data_size = 4U;
+	dma_cfg.source_burst_length = 4U;
+	dma_cfg.dest_burst_length = 4U;
+#ifdef CONFIG_DMAMUX_STM32
+	dma_cfg.user_data = (struct device *)dma;
+#endif /* CONFIG_DMAMUX_STM32 */
+	dma_cfg.dma_callback = dma_sg_cyclic_callback;
+	dma_cfg.block_count = XFERS;
+	dma_cfg.head_block = dma_block_cfgs;
+	dma_cfg.complete_callback_en = true;
+	dma_cfg.cyclic = true;
+
+#ifdef CONFIG_DMA_MCUX_TEST_SLOT_START
+	dma_cfg.dma_slot = CONFIG_DMA_MCUX_TEST_SLOT_START;
+#endif
+
+	chan_id = dma_request_channel(dma, NULL);
+	if (chan_id < 0) {
+		chan_id = CONFIG_DMA_SG_CHANNEL_NR;
+	}
+
+	memset(dma_block_cfgs, 0, sizeof(dma_block_cfgs));
+	for (int i = 0; i < XFERS; i++) {
+		dma_block_cfgs[i].block_size = XFER_SIZE;
+		dma_block_cfgs[i].source_address = (uintptr_t)tx_data;
+		dma_block_cfgs[i].dest_address = (uintptr_t)rx_data[i];
+		if (i < XFERS - 1) {
+			dma_block_cfgs[i].next_block = &dma_block_cfgs[i + 1];
+		}
+	}
+
+	zassert_ok(dma_config(dma, chan_id, &dma_cfg), "transfer config (%d)", chan_id);
+	zassert_ok(dma_start(dma, chan_id), "transfer start (%d)", chan_id);
+
+	for (int i = 0; i < XFERS * CYCLIC_ROUNDS; i++) {
+		zassert_ok(k_sem_take(&block_sem, K_MSEC(1000)), "block %d not completed", i);
+	}
+
+	zassert_ok(dma_stop(dma, chan_id));
+
+	for (int i = 0; i < XFERS; i++) {
+		zassert_mem_equal(tx_data, rx_data[i], XFER_SIZE, "rx_data[%d] differs", i);
+	}
+}
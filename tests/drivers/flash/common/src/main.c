@@ -149,4 +149,60 @@ ZTEST(flash_driver, test_read_unaligned_address)
 	}
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+static K_SEM_DEFINE(async_done, 0, 3);
+
+static void async_cb(struct flash_async_req *req, int result)
+{
+	req->user_data = INT_TO_POINTER(result);
+	k_sem_give(&async_done);
+}
+
+ZTEST(flash_driver, test_async)
+{
+	uint8_t buf[EXPECTED_SIZE];
+	struct flash_async_req reqs[] = {
+		{
+			.op = FLASH_ASYNC_ERASE,
+			.offset = page_info.start_offset,
+			.len = page_info.size,
+		},
+		{
+			.op = FLASH_ASYNC_WRITE,
+			.offset = page_info.start_offset,
+			.data = expected,
+			.len = EXPECTED_SIZE,
+		},
+		{
+			.op = FLASH_ASYNC_READ,
+			.offset = page_info.start_offset,
+			.data = buf,
+			.len = EXPECTED_SIZE,
+		},
+	};
+
+	memset(buf, erase_value, sizeof(buf));
+
+	/* Requests are done in order, the read gets the written data */
+	for (size_t i = 0; i < ARRAY_SIZE(reqs); i++) {
+		reqs[i].cb = async_cb;
+		reqs[i].user_data = INT_TO_POINTER(-EINPROGRESS);
+		zassert_ok(flash_async_submit(flash_dev, &reqs[i]));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(reqs); i++) {
+		zassert_ok(k_sem_take(&async_done, K_SECONDS(30)));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(reqs); i++) {
+		zassert_equal(POINTER_TO_INT(reqs[i].user_data), 0, "request %zu failed", i);
+	}
+	zassert_mem_equal(buf, expected, EXPECTED_SIZE);
+
+	reqs[0].op = FLASH_ASYNC_READ;
+	reqs[0].cb = NULL;
+	zassert_equal(flash_async_submit(flash_dev, &reqs[0]), -EINVAL);
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 ZTEST_SUITE(flash_driver, NULL, flash_driver_setup, NULL, NULL, NULL);
@@ -0,0 +1,54 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gpio/gpio_capture.h>
+
+#include "test_gpio.h"
+
+#define CAPTURE_EDGES 4
+
+GPIO_CAPTURE_DEFINE(test_capture, 8);
+
+ZTEST(gpio_port_cb_mgmt, test_gpio_capture)
+{
+	const struct device *const dev = DEVICE_DT_GET(DEV);
+	struct gpio_capture_event events[CAPTURE_EDGES];
+	int rc;
+
+	zassert_equal(gpio_pin_configure(dev, PIN_OUT, GPIO_OUTPUT_LOW | PIN_OUT_FLAGS), 0);
+	zassert_equal(gpio_pin_configure(dev, PIN_IN, GPIO_INPUT | PIN_IN_FLAGS), 0);
+
+	rc = gpio_pin_interrupt_configure(dev, PIN_IN, GPIO_INT_EDGE_BOTH);
+	if (rc == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_equal(rc, 0, "interrupt configuration failed");
+
+	zassert_equal(gpio_capture_start(dev, &test_capture, BIT(PIN_IN)), 0);
+
+	/* Edges are read in one batch after they all occurred */
+	for (int i = 0; i < CAPTURE_EDGES; i++) {
+		gpio_pin_set(dev, PIN_OUT, (i + 1) % 2);
+		k_sleep(K_MSEC(10));
+	}
+
+	rc = gpio_capture_read(&test_capture, events, ARRAY_SIZE(events), K_MSEC(100));
+	zassert_equal(rc, CAPTURE_EDGES, "%d edges captured", rc);
+
+	for (int i = 0; i < CAPTURE_EDGES; i++) {
+		zassert_equal(events[i].pins, BIT(PIN_IN));
+		if (i > 0) {
+			zassert_true(events[i].timestamp - events[i - 1].timestamp > 0);
+		}
+	}
+
+	zassert_equal(gpio_capture_read(&test_capture, events, ARRAY_SIZE(events), K_NO_WAIT),
+		      -EAGAIN);
+	zassert_equal(gpio_capture_overruns_get(&test_capture), 0);
+
+	zassert_equal(gpio_capture_stop(dev, &test_capture), 0);
+	gpio_pin_interrupt_configure(dev, PIN_IN, GPIO_INT_DISABLE);
+}
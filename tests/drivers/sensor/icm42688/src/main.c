@@ -12,6 +12,8 @@
 #include <zephyr/fff.h>
 #include <zephyr/ztest.h>
 
+#include "icm42688.h"
+#include "icm42688_decoder.h"
 #include "icm42688_emul.h"
 #include "icm42688_reg.h"
 
@@ -240,3 +242,75 @@ ZTEST_F(icm42688, test_interrupt)
 	/* Verify the handler was called */
 	zassert_equal(test_interrupt_trigger_handler_fake.call_count, 1);
 }
+
+#define FIFO_FRAMES      3
+#define FIFO_PACKET_SIZE 16
+
+static void fifo_packet_put(uint8_t *pkt, const int16_t accel[3], const int16_t gyro[3])
+{
+	pkt[0] = FIFO_HEADER_ACCEL | FIFO_HEADER_GYRO;
+	for (int i = 0; i < 3; i++) {
+		sys_put_be16(accel[i], &pkt[1 + i * 2]);
+		sys_put_be16(gyro[i], &pkt[7 + i * 2]);
+	}
+}
+
+ZTEST(icm42688, test_fifo_decode)
+{
+	static uint8_t buffer[sizeof(struct icm42688_fifo_data) + FIFO_FRAMES * FIFO_PACKET_SIZE];
+	static uint8_t decoded[sizeof(struct sensor_three_axis_data) +
+			       (FIFO_FRAMES - 1) * sizeof(struct sensor_three_axis_sample_data)];
+	struct icm42688_fifo_data *edata = (struct icm42688_fifo_data *)buffer;
+	struct sensor_three_axis_data *data = (struct sensor_three_axis_data *)decoded;
+	const struct sensor_decoder_api *decoder;
+	uint32_t fit = 0;
+
+	memset(buffer, 0, sizeof(buffer));
+	edata->header.is_fifo = 1;
+	edata->header.accel_fs = ICM42688_ACCEL_FS_16G;
+	edata->header.gyro_fs = ICM42688_GYRO_FS_2000;
+	edata->header.timestamp = 1000;
+	edata->accel_odr = ICM42688_ACCEL_ODR_1000;
+	edata->gyro_odr = ICM42688_GYRO_ODR_500;
+	edata->fifo_count = FIFO_FRAMES * FIFO_PACKET_SIZE;
+
+	for (int i = 0; i < FIFO_FRAMES; i++) {
+		const int16_t accel[3] = {1000 * (i + 1), -1000 * (i + 1), 2000 * (i + 1)};
+		const int16_t gyro[3] = {8192 * (i + 1), -8192 * (i + 1), 4096 * (i + 1)};
+
+		fifo_packet_put(&buffer[sizeof(*edata) + i * FIFO_PACKET_SIZE], accel, gyro);
+	}
+
+	zassert_ok(sensor_get_decoder(DEVICE_DT_GET(NODE), &decoder));
+
+	/* All the frames are decoded in a single call */
+	zassert_equal(decoder->decode(buffer, SENSOR_CHAN_ACCEL_XYZ, 0, &fit, FIFO_FRAMES, data),
+		      FIFO_FRAMES);
+	zassert_equal(data->header.base_timestamp_ns, 1000);
+	zassert_equal(data->shift, 8);
+	for (int i = 0; i < FIFO_FRAMES; i++) {
+		/* 16g over the 16 bit range, in um/s^2 */
+		const int64_t expect_x = INT64_C(1000) * (i + 1) * 16 * 9806650 / 32768;
+		const int64_t actual_x = ((int64_t)data->readings[i].x * 1000000) >> (31 - 8);
+		const int64_t actual_y = ((int64_t)data->readings[i].y * 1000000) >> (31 - 8);
+		const int64_t actual_z = ((int64_t)data->readings[i].z * 1000000) >> (31 - 8);
+
+		zassert_equal(data->readings[i].timestamp_delta, i * 1000000);
+		zassert_within(actual_x, expect_x, 1000);
+		zassert_within(actual_y, -expect_x, 1000);
+		zassert_within(actual_z, 2 * expect_x, 1000);
+	}
+	zassert_equal(decoder->decode(buffer, SENSOR_CHAN_ACCEL_XYZ, 0, &fit, FIFO_FRAMES, data),
+		      0);
+
+	/* The gyro is read after the accel in the packet */
+	fit = 0;
+	zassert_equal(decoder->decode(buffer, SENSOR_CHAN_GYRO_XYZ, 0, &fit, FIFO_FRAMES, data),
+		      FIFO_FRAMES);
+	for (int i = 0; i < FIFO_FRAMES; i++) {
+		zassert_equal(data->readings[i].timestamp_delta, i * 2000000);
+		zassert_equal(data->readings[i].x, data->readings[0].x * (i + 1));
+		zassert_equal(data->readings[i].y, -data->readings[i].x);
+		zassert_equal(data->readings[i].z, data->readings[i].x / 2);
+	}
+}
@@ -144,6 +144,52 @@ ZTEST(uart_async_rx, test_rx_late_consume)
 	zassert_equal(claim_len, 0);
 }
 
+ZTEST(uart_async_rx, test_rx_large_buffers)
+{
+	int err;
+	static uint8_t buf[2 * (1024 + UART_ASYNC_RX_BUF_OVERHEAD)];
+	static const int buf_cnt = 2;
+	size_t aloc_len;
+	size_t claim_len;
+	uint8_t *claim_buf;
+	uint8_t *aloc_buf;
+	struct uart_async_rx async_rx;
+	const struct uart_async_rx_config config = {
+		.buffer = buf,
+		.length = sizeof(buf),
+		.buf_cnt = buf_cnt
+	};
+
+	err = uart_async_rx_init(&async_rx, &config);
+	zassert_equal(err, 0);
+
+	aloc_len = uart_async_rx_get_buf_len(&async_rx);
+	zassert_equal(aloc_len, 1024);
+
+	aloc_buf = uart_async_rx_buf_req(&async_rx);
+	mem_fill(aloc_buf, 0, aloc_len);
+
+	/* Simulate the buffer filled in two chunks */
+	uart_async_rx_on_rdy(&async_rx, aloc_buf, 600);
+	uart_async_rx_on_rdy(&async_rx, aloc_buf, aloc_len - 600);
+	uart_async_rx_on_buf_rel(&async_rx, aloc_buf);
+
+	claim_len = uart_async_rx_data_claim(&async_rx, &claim_buf, 2048);
+	zassert_equal(claim_len, aloc_len);
+	zassert_equal(claim_buf, aloc_buf);
+	zassert_true(mem_check(claim_buf, 0, aloc_len));
+
+	(void)uart_async_rx_data_consume(&async_rx, 700);
+	claim_len = uart_async_rx_data_claim(&async_rx, &claim_buf, 2048);
+	zassert_equal(claim_len, aloc_len - 700);
+	zassert_equal(claim_buf, &aloc_buf[700]);
+
+	zassert_true(uart_async_rx_data_consume(&async_rx, claim_len));
+
+	claim_len = uart_async_rx_data_claim(&async_rx, &claim_buf, 2048);
+	zassert_equal(claim_len, 0);
+}
+
 struct test_async_rx {
 	struct uart_async_rx async_rx;
 	atomic_t pending_req;
@@ -65,6 +65,32 @@ ZTEST(cache_api, test_data_cache_api)
 
 }
 
+ZTEST(cache_api, test_data_cache_ranges)
+{
+	/* Contiguous, overlapping, sharing a line and apart */
+	struct sys_cache_range ranges[] = {
+		{ user_buffer, 100 },
+		{ user_buffer + 100, 28 },
+		{ user_buffer + 120, 200 },
+		{ user_buffer + 330, 10 },
+		{ user_buffer + 2048, 1024 },
+		{ user_buffer + 3072, 0 },
+	};
+	int ret;
+
+	ret = sys_cache_data_flush_ranges(ranges, ARRAY_SIZE(ranges));
+	zassert_true((ret == 0) || (ret == -ENOTSUP));
+
+	ret = sys_cache_data_invd_ranges(ranges, ARRAY_SIZE(ranges));
+	zassert_true((ret == 0) || (ret == -ENOTSUP));
+
+	ret = sys_cache_data_flush_and_invd_ranges(ranges, ARRAY_SIZE(ranges));
+	zassert_true((ret == 0) || (ret == -ENOTSUP));
+
+	ret = sys_cache_data_flush_ranges(ranges, 0);
+	zassert_true((ret == 0) || (ret == -ENOTSUP));
+}
+
 ZTEST_USER(cache_api, test_data_cache_api_user)
 {
 	int ret;
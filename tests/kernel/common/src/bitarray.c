@@ -519,6 +519,66 @@ ZTEST(bitarray, test_bitarray_alloc_free)
 	alloc_and_free_interval();
 }
 
+/**
+ * @brief Test bitarrays allocation in a large, mostly full, bit array
+ *
+ * @see sys_bitarray_alloc()
+ * @see sys_bitarray_free()
+ */
+ZTEST(bitarray, test_bitarray_alloc_large)
+{
+	int ret;
+	size_t offset;
+
+	SYS_BITARRAY_DEFINE_STATIC(ba, 4100);
+
+	printk("Testing bit array alloc and free in a large bit array
+");
+
+	ret = sys_bitarray_alloc(&ba, ba.num_bits, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 0, "sys_bitarray_alloc() offset expected %d, got %d", 0, offset);
+
+	/* Punch a small hole and a bigger one after it */
+	zassert_equal(sys_bitarray_free(&ba, 5, 1000), 0, "sys_bitarray_free() failed");
+	zassert_equal(sys_bitarray_free(&ba, 40, 3000), 0, "sys_bitarray_free() failed");
+
+	/* The lowest hole big enough is picked, skipping full bundles */
+	ret = sys_bitarray_alloc(&ba, 10, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 3000, "sys_bitarray_alloc() offset expected %d, got %d",
+		      3000, offset);
+
+	ret = sys_bitarray_alloc(&ba, 5, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 1000, "sys_bitarray_alloc() offset expected %d, got %d",
+		      1000, offset);
+
+	ret = sys_bitarray_alloc(&ba, 31, &offset);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc() should fail but not");
+
+	ret = sys_bitarray_alloc(&ba, 30, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 3010, "sys_bitarray_alloc() offset expected %d, got %d",
+		      3010, offset);
+
+	/* Clearing a single low bit makes it the next one allocated */
+	zassert_equal(sys_bitarray_clear_bit(&ba, 7), 0, "sys_bitarray_clear_bit() failed");
+	ret = sys_bitarray_alloc(&ba, 1, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 7, "sys_bitarray_alloc() offset expected %d, got %d", 7, offset);
+
+	/* The last, partial, bundle is usable */
+	zassert_equal(sys_bitarray_free(&ba, 4, 4096), 0, "sys_bitarray_free() failed");
+	ret = sys_bitarray_alloc(&ba, 4, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 4096, "sys_bitarray_alloc() offset expected %d, got %d",
+		      4096, offset);
+
+	zassert_equal(sys_bitarray_free(&ba, ba.num_bits, 0), 0, "sys_bitarray_free() failed");
+	zassert_true(bitarray_bundles_is_zero(&ba), "bundles not all cleared");
+}
+
 ZTEST(bitarray, test_bitarray_region_set_clear)
 {
 	int ret;
@@ -0,0 +1,142 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/device.h>
+#include <zephyr/ztest.h>
+
+#define INIT_SLEEP_MS 100
+
+static int64_t barrier_uptime;
+static bool barrier_saw_devices;
+static int64_t late_start_uptime;
+
+static int slow_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_msleep(INIT_SLEEP_MS);
+
+	return 0;
+}
+
+static int late_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	late_start_uptime = k_uptime_get();
+
+	return 0;
+}
+
+DEVICE_DEFINE(slow_a, "slow_a", slow_init, NULL, NULL, NULL,
+	      POST_KERNEL, 90, NULL);
+DEVICE_DEFINE(slow_b, "slow_b", slow_init, NULL, NULL, NULL,
+	      POST_KERNEL, 91, NULL);
+
+static int barrier_init(void)
+{
+	barrier_uptime = k_uptime_get();
+	barrier_saw_devices = device_is_ready(DEVICE_GET(slow_a)) &&
+			      device_is_ready(DEVICE_GET(slow_b));
+
+	return 0;
+}
+
+SYS_INIT(barrier_init, POST_KERNEL, 92);
+
+DEVICE_DEFINE(late, "late", late_init, NULL, NULL, NULL,
+	      POST_KERNEL, 93, NULL);
+
+/* Devicetree devices, initialized after the barrier so that the child has
+ * free threads to run on while its supply is initializing.
+ */
+#define DT_DRV_COMPAT vnd_init_parallel
+
+struct init_parallel_config {
+	const struct device *supply;
+	bool slow;
+};
+
+struct init_parallel_data {
+	int64_t start_uptime;
+	int64_t end_uptime;
+	bool supply_ready;
+};
+
+static int dt_init(const struct device *dev)
+{
+	const struct init_parallel_config *config = dev->config;
+	struct init_parallel_data *data = dev->data;
+
+	data->start_uptime = k_uptime_get();
+	data->supply_ready = config->supply == NULL ||
+			     device_is_ready(config->supply);
+
+	if (config->slow) {
+		k_msleep(INIT_SLEEP_MS);
+	}
+
+	data->end_uptime = k_uptime_get();
+
+	return 0;
+}
+
+#define DT_INIT_DEFINE(inst)							\
+	static struct init_parallel_data init_parallel_data_##inst;		\
+										\
+	static const struct init_parallel_config init_parallel_config_##inst = { \
+		.supply = COND_CODE_1(DT_INST_NODE_HAS_PROP(inst, supply),	\
+				      (DEVICE_DT_GET(DT_INST_PHANDLE(inst, supply))), \
+				      (NULL)),					\
+		.slow = DT_INST_PROP(inst, slow),				\
+	};									\
+										\
+	DEVICE_DT_INST_DEFINE(inst, dt_init, NULL,				\
+			      &init_parallel_data_##inst,			\
+			      &init_parallel_config_##inst,			\
+			      POST_KERNEL, 95, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(DT_INIT_DEFINE)
+
+/* Devices that don't depend on each other are initialized concurrently. */
+ZTEST(device_init_parallel, test_overlap)
+{
+	zassert_true(barrier_uptime >= INIT_SLEEP_MS);
+	zassert_true(barrier_uptime < 2 * INIT_SLEEP_MS,
+		     "initializations did not overlap (%lld ms)", barrier_uptime);
+}
+
+/* A SYS_INIT() still sees all the preceding devices initialized, and the
+ * following ones are only initialized after it.
+ */
+ZTEST(device_init_parallel, test_barrier)
+{
+	zassert_true(barrier_saw_devices);
+	zassert_true(device_is_ready(DEVICE_GET(late)));
+	zassert_true(late_start_uptime >= barrier_uptime);
+}
+
+/* A device is only initialized once the devices it requires in devicetree
+ * are, even though a thread is free to run it earlier.
+ */
+ZTEST(device_init_parallel, test_dt_dependency)
+{
+	const struct device *parent = DEVICE_DT_GET(DT_NODELABEL(init_parallel_parent));
+	const struct device *child = DEVICE_DT_GET(DT_NODELABEL(init_parallel_child));
+	const struct init_parallel_data *parent_data = parent->data;
+	const struct init_parallel_data *child_data = child->data;
+
+	zassert_true(device_is_ready(parent));
+	zassert_true(device_is_ready(child));
+	zassert_true(child_data->supply_ready,
+		     "child initialized before its supply");
+	zassert_true(child_data->start_uptime >= parent_data->end_uptime);
+	zassert_true(parent_data->end_uptime - parent_data->start_uptime >=
+		     INIT_SLEEP_MS);
+}
+
+ZTEST_SUITE(device_init_parallel, NULL, NULL, NULL, NULL, NULL);
@@ -265,3 +265,38 @@ ZTEST(k_heap_api, test_k_heap_alloc_pending_null)
 
 	k_heap_free(&k_heap_test, p);
 }
+
+/**
+ * @brief Validate that small blocks are recycled through the magazines
+ *
+ * @details Free a small block and allocate one of the same size again,
+ * which must be served from the current CPU's magazine and be reported
+ * as a hit.
+ *
+ * @ingroup kernel_heap_tests
+ */
+ZTEST(k_heap_api, test_k_heap_magazine)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_K_HEAP_MAGAZINE);
+	Z_TEST_SKIP_IFNDEF(CONFIG_SYS_HEAP_RUNTIME_STATS);
+
+#if defined(CONFIG_K_HEAP_MAGAZINE) && defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	struct k_heap_magazine_stats before, after;
+	char *p, *q;
+
+	p = k_heap_alloc(&k_heap_test, 24, K_NO_WAIT);
+	zassert_not_null(p, "k_heap_alloc operation failed");
+	k_heap_free(&k_heap_test, p);
+
+	zassert_ok(k_heap_magazine_stats_get(&k_heap_test, &before));
+	zassert_true(before.cached_bytes >= 32, "freed block not cached");
+
+	q = k_heap_alloc(&k_heap_test, 24, K_NO_WAIT);
+	zassert_not_null(q, "k_heap_alloc operation failed");
+
+	zassert_ok(k_heap_magazine_stats_get(&k_heap_test, &after));
+	zassert_equal(after.hits, before.hits + 1, "allocation missed magazine");
+
+	k_heap_free(&k_heap_test, q);
+#endif
+}
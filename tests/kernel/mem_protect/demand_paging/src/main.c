@@ -105,6 +105,7 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 #ifndef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	printk("    - in ISR: %lu\n", stats->pagefaults.in_isr);
 #endif
+	printk("    - Refaults: %lu\n", stats->pagefaults.refault);
 
 	printk("* Eviction (%s):\n", scope);
 	printk("    - Total pages evicted: %lu\n",
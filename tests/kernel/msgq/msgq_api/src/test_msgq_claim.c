@@ -0,0 +1,173 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 4
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * MSGQ_LEN];
+static ZTEST_BMEM char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_DMEM uint32_t data[MSGQ_LEN] = { MSG0, MSG1 };
+static K_SEM_DEFINE(recv_sema, 0, 1);
+
+static void tThread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t rx_data;
+	int ret = k_msgq_get((struct k_msgq *)p1, &rx_data, K_FOREVER);
+
+	zassert_equal(ret, 0);
+	zassert_equal(rx_data, MSG0);
+
+	k_sem_give(&recv_sema);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test writing a message in place
+ * @see k_msgq_put_claim(), k_msgq_put_finish()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_claim)
+{
+	uint32_t rx_data;
+	void *slot;
+
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MSGQ_LEN);
+
+	zassert_equal(k_msgq_put_finish(&msgq, true), -EINVAL);
+
+	zassert_ok(k_msgq_put_claim(&msgq, &slot));
+	*(uint32_t *)slot = MSG0;
+
+	/**TESTPOINT: the claimed slot locks the put side */
+	zassert_equal(k_msgq_put_claim(&msgq, &slot), -EBUSY);
+	zassert_equal(k_msgq_put(&msgq, &data[1], K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+
+	zassert_ok(k_msgq_put_finish(&msgq, true));
+	zassert_equal(k_msgq_num_used_get(&msgq), 1);
+
+	/**TESTPOINT: a discarded slot is not queued */
+	zassert_ok(k_msgq_put_claim(&msgq, &slot));
+	zassert_ok(k_msgq_put_finish(&msgq, false));
+	zassert_equal(k_msgq_num_used_get(&msgq), 1);
+
+	zassert_ok(k_msgq_put(&msgq, &data[1], K_NO_WAIT));
+	zassert_equal(k_msgq_put_claim(&msgq, &slot), -ENOMSG);
+
+	zassert_ok(k_msgq_get(&msgq, &rx_data, K_NO_WAIT));
+	zassert_equal(rx_data, MSG0);
+	zassert_ok(k_msgq_get(&msgq, &rx_data, K_NO_WAIT));
+	zassert_equal(rx_data, MSG1);
+}
+
+/**
+ * @brief Test committing a claimed slot to a waiting reader
+ * @see k_msgq_put_claim(), k_msgq_put_finish()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_claim_pending)
+{
+	void *slot;
+
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MSGQ_LEN);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			tThread_entry, &msgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_ok(k_msgq_put_claim(&msgq, &slot));
+	*(uint32_t *)slot = MSG0;
+	zassert_ok(k_msgq_put_finish(&msgq, true));
+
+	zassert_ok(k_sem_take(&recv_sema, TIMEOUT));
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+
+	k_thread_join(&tdata, K_FOREVER);
+}
+
+/**
+ * @brief Test reading a message in place
+ * @see k_msgq_get_claim(), k_msgq_get_finish()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_get_claim)
+{
+	uint32_t rx_data;
+	void *slot;
+
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MSGQ_LEN);
+
+	zassert_equal(k_msgq_get_claim(&msgq, &slot), -ENOMSG);
+	zassert_equal(k_msgq_get_finish(&msgq, true), -EINVAL);
+
+	zassert_ok(k_msgq_put(&msgq, &data[0], K_NO_WAIT));
+	zassert_ok(k_msgq_put(&msgq, &data[1], K_NO_WAIT));
+
+	zassert_ok(k_msgq_get_claim(&msgq, &slot));
+	zassert_equal(*(uint32_t *)slot, MSG0);
+
+	/**TESTPOINT: the claimed message locks the get side */
+	zassert_equal(k_msgq_get_claim(&msgq, &slot), -EBUSY);
+	zassert_equal(k_msgq_get(&msgq, &rx_data, K_NO_WAIT), -EBUSY);
+
+	/**TESTPOINT: a message that is not consumed stays first */
+	zassert_ok(k_msgq_get_finish(&msgq, false));
+	zassert_ok(k_msgq_get_claim(&msgq, &slot));
+	zassert_equal(*(uint32_t *)slot, MSG0);
+	zassert_ok(k_msgq_get_finish(&msgq, true));
+
+	zassert_equal(k_msgq_num_used_get(&msgq), 1);
+	zassert_ok(k_msgq_get(&msgq, &rx_data, K_NO_WAIT));
+	zassert_equal(rx_data, MSG1);
+
+	/**TESTPOINT: purge drops the claim */
+	zassert_ok(k_msgq_put(&msgq, &data[0], K_NO_WAIT));
+	zassert_ok(k_msgq_get_claim(&msgq, &slot));
+	k_msgq_purge(&msgq);
+	zassert_equal(k_msgq_get_finish(&msgq, true), -EINVAL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+}
+
+/**
+ * @brief Test sending and receiving several messages at once
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_get_n)
+{
+	uint32_t tx_data[BATCH_LEN + 1];
+	uint32_t rx_data[BATCH_LEN + 1];
+
+	for (int i = 0; i < ARRAY_SIZE(tx_data); i++) {
+		tx_data[i] = MSG0 + i;
+	}
+
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	/* Move the ring pointers so that the batch wraps around */
+	zassert_equal(k_msgq_put_n(&msgq, tx_data, 3), 3);
+	zassert_equal(k_msgq_get_n(&msgq, rx_data, 3), 3);
+
+	/**TESTPOINT: only the messages that fit are sent */
+	zassert_equal(k_msgq_put_n(&msgq, tx_data, ARRAY_SIZE(tx_data)),
+		      BATCH_LEN);
+	zassert_equal(k_msgq_put_n(&msgq, tx_data, 1), 0);
+
+	memset(rx_data, 0, sizeof(rx_data));
+	zassert_equal(k_msgq_get_n(&msgq, rx_data, ARRAY_SIZE(rx_data)),
+		      BATCH_LEN);
+	zassert_mem_equal(rx_data, tx_data, BATCH_LEN * MSG_SIZE);
+	zassert_equal(k_msgq_get_n(&msgq, rx_data, 1), 0);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,177 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CLAIM_LEN	8
+#define TIMEOUT		K_MSEC(100)
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+static unsigned char __aligned(4) claim_buf[CLAIM_LEN];
+static struct k_pipe claim_pipe;
+static K_SEM_DEFINE(claim_sema, 0, 1);
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	unsigned char rx_data[4];
+	size_t rd_byte;
+
+	zassert_ok(k_pipe_get(&claim_pipe, rx_data, sizeof(rx_data),
+			      &rd_byte, sizeof(rx_data), K_FOREVER));
+	zassert_equal(rd_byte, sizeof(rx_data));
+	zassert_mem_equal(rx_data, "wxyz", sizeof(rx_data));
+
+	k_sem_give(&claim_sema);
+}
+
+/**
+ * @addtogroup kernel_pipe_tests
+ * @{
+ */
+
+/**
+ * @brief Test writing data in place
+ * @see k_pipe_put_claim(), k_pipe_put_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_put_claim)
+{
+	unsigned char rx_data[CLAIM_LEN];
+	size_t wt_byte, rd_byte, size;
+	void *region;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), -EINVAL);
+
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &region, &size));
+	zassert_equal(size, CLAIM_LEN);
+	memcpy(region, "abcde", 5);
+
+	/**TESTPOINT: the claimed region locks the put side */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &region, &size), -EBUSY);
+	zassert_equal(k_pipe_put(&claim_pipe, "f", 1, &wt_byte, 1, K_NO_WAIT),
+		      -EBUSY);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 5));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 5);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), -EINVAL);
+
+	/**TESTPOINT: the region ends where the free space does */
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &region, &size));
+	zassert_equal(size, CLAIM_LEN - 5);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, size + 1), -EINVAL);
+
+	/**TESTPOINT: a discarded region is not added */
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 0));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 5);
+
+	zassert_ok(k_pipe_get(&claim_pipe, rx_data, sizeof(rx_data),
+			      &rd_byte, 0, K_NO_WAIT));
+	zassert_equal(rd_byte, 5);
+	zassert_mem_equal(rx_data, "abcde", 5);
+}
+
+/**
+ * @brief Test committing a claimed region to a waiting reader
+ * @see k_pipe_put_claim(), k_pipe_put_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_put_claim_pending)
+{
+	size_t size;
+	void *region;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+			reader_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &region, &size));
+	memcpy(region, "wxyz", 4);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 4));
+
+	zassert_ok(k_sem_take(&claim_sema, TIMEOUT));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+
+	k_thread_join(&claim_thread, K_FOREVER);
+}
+
+/**
+ * @brief Test reading data in place
+ * @see k_pipe_get_claim(), k_pipe_get_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_get_claim)
+{
+	unsigned char rx_data[CLAIM_LEN];
+	size_t wt_byte, rd_byte, size;
+	void *region;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &region, &size), -ENOMSG);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 0), -EINVAL);
+
+	/* Move the ring indexes so that the data wraps around */
+	zassert_ok(k_pipe_put(&claim_pipe, "012345", 6, &wt_byte, 6,
+			      K_NO_WAIT));
+	zassert_ok(k_pipe_get(&claim_pipe, rx_data, 6, &rd_byte, 6,
+			      K_NO_WAIT));
+	zassert_ok(k_pipe_put(&claim_pipe, "abcd", 4, &wt_byte, 4,
+			      K_NO_WAIT));
+
+	/**TESTPOINT: the region ends at the end of the buffer */
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &region, &size));
+	zassert_equal(size, 2);
+	zassert_mem_equal(region, "ab", 2);
+
+	/**TESTPOINT: the claimed region locks the get side */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &region, &size), -EBUSY);
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, 1, &rd_byte, 1,
+				 K_NO_WAIT), -EBUSY);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, size + 1), -EINVAL);
+
+	/**TESTPOINT: data that is not consumed stays first */
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 1));
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &region, &size));
+	zassert_equal(size, 1);
+	zassert_mem_equal(region, "b", 1);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 1));
+
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &region, &size));
+	zassert_equal(size, 2);
+	zassert_mem_equal(region, "cd", 2);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 0));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2);
+
+	/**TESTPOINT: flush drops the claim */
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &region, &size));
+	k_pipe_flush(&claim_pipe);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, size), -EINVAL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+}
+
+/**
+ * @brief Test claiming on a pipe without a buffer
+ * @see k_pipe_put_claim(), k_pipe_get_claim()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_no_buffer)
+{
+	size_t size;
+	void *region;
+
+	k_pipe_init(&claim_pipe, NULL, 0);
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &region, &size), -ENOMSG);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &region, &size), -ENOMSG);
+}
+
+/**
+ * @}
+ */
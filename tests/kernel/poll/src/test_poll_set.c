@@ -0,0 +1,154 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MSGQ_MSG_SIZE 4
+#define MSGQ_MAX_MSGS 4
+
+static K_SEM_DEFINE(set_sem, 0, K_SEM_MAX_LIMIT);
+K_MSGQ_DEFINE(set_msgq, MSGQ_MSG_SIZE, MSGQ_MAX_MSGS, 4);
+static struct k_poll_signal set_signal;
+
+static struct k_poll_event set_events[3];
+static struct k_poll_set poll_set;
+
+static struct k_thread set_thread;
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+
+static void set_init(void)
+{
+	k_sem_reset(&set_sem);
+	k_msgq_purge(&set_msgq);
+	k_poll_signal_init(&set_signal);
+
+	k_poll_event_init(&set_events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+	k_poll_event_init(&set_events[1], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+	k_poll_event_init(&set_events[2], K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_msgq);
+
+	k_poll_set_init(&poll_set, set_events, ARRAY_SIZE(set_events));
+}
+
+/**
+ * @brief Test waiting on a poll set returns the ready events only
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_wait(), k_poll_set_release()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_ready_only)
+{
+	struct k_poll_event *ready[ARRAY_SIZE(set_events)];
+	uint32_t msg = 0x12345678;
+
+	set_init();
+
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	k_poll_signal_raise(&set_signal, 0);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[1]);
+	zassert_equal(set_events[1].state, K_POLL_STATE_SIGNALED);
+
+	k_poll_signal_reset(&set_signal);
+	set_events[1].state = K_POLL_STATE_NOT_READY;
+
+	/* The events stay registered across the waits */
+	k_sem_give(&set_sem);
+	zassert_ok(k_msgq_put(&set_msgq, &msg, K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 2);
+	zassert_equal_ptr(ready[0], &set_events[0]);
+	zassert_equal_ptr(ready[1], &set_events[2]);
+
+	/**TESTPOINT: only as many ready events as there is room for */
+	zassert_equal(k_poll_set_wait(&poll_set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[0]);
+
+	zassert_ok(k_sem_take(&set_sem, K_NO_WAIT));
+	zassert_ok(k_msgq_get(&set_msgq, &msg, K_NO_WAIT));
+	set_events[0].state = K_POLL_STATE_NOT_READY;
+	set_events[2].state = K_POLL_STATE_NOT_READY;
+
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	k_poll_set_release(&poll_set);
+}
+
+/**
+ * @brief Test a poll set reports conditions still met
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_level)
+{
+	struct k_poll_event *ready[ARRAY_SIZE(set_events)];
+
+	set_init();
+
+	k_sem_give(&set_sem);
+	k_sem_give(&set_sem);
+
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_ok(k_sem_take(&set_sem, K_NO_WAIT));
+	set_events[0].state = K_POLL_STATE_NOT_READY;
+
+	/* The semaphore still has a count */
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[0]);
+	zassert_equal(set_events[0].state, K_POLL_STATE_SEM_AVAILABLE);
+
+	k_poll_set_release(&poll_set);
+}
+
+static void set_giver(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_give(&set_sem);
+}
+
+/**
+ * @brief Test waiting on a poll set blocks until an event occurs
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event *ready[ARRAY_SIZE(set_events)];
+
+	set_init();
+
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(50)), -EAGAIN);
+
+	k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			set_giver, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_MSEC(50));
+
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(500)), 1);
+	zassert_equal_ptr(ready[0], &set_events[0]);
+
+	k_thread_join(&set_thread, K_FOREVER);
+	k_poll_set_release(&poll_set);
+}
@@ -203,6 +203,94 @@ ZTEST(threads_scheduling, test_slice_perthread)
 	zassert_false(perthread_running, "thread failed to suspend");
 }
 
+#ifdef CONFIG_SCHED_SPORADIC
+#define SS_BUDGET_TICKS 10
+#define SS_PERIOD_TICKS 40
+
+static void sporadic_fn(void *a, void *b, void *c)
+{
+	ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
+	while (true) {
+		k_busy_wait(10);
+	}
+}
+
+/* Spin until preempted, returns the tick preempted at and for how long */
+static int64_t wait_preemption(int64_t *len)
+{
+	int64_t last = k_uptime_ticks();
+	int64_t now;
+
+	while (true) {
+		now = k_uptime_ticks();
+		if (now - last > 1) {
+			*len = now - last;
+			return last;
+		}
+		last = now;
+	}
+}
+
+/**
+ * @brief Check the sporadic server budget of a thread
+ *
+ * @details A thread of higher priority than the test thread runs for its
+ * budget, is throttled to a lower priority, then preempts the test thread
+ * again for its budget once replenished a period after its activation.
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(threads_scheduling, test_sporadic_budget)
+{
+	int old_prio = k_thread_priority_get(k_current_get());
+	int64_t start, preempted, len;
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(5));
+
+	k_thread_create(&t[0], tstacks[0], STACK_SIZE,
+			sporadic_fn, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(2), 0, K_FOREVER);
+	zassert_equal(k_thread_sporadic_set(&t[0], SS_PERIOD_TICKS + 1, SS_PERIOD_TICKS,
+					    K_PRIO_PREEMPT(10)), -EINVAL);
+	zassert_ok(k_thread_sporadic_set(&t[0], SS_BUDGET_TICKS, SS_PERIOD_TICKS,
+					 K_PRIO_PREEMPT(10)));
+
+	/* Tick align, then start */
+	k_usleep(1);
+	start = k_uptime_ticks();
+	k_thread_start(&t[0]);
+
+	/* The thread ran for its budget, then got throttled */
+	len = k_uptime_ticks() - start;
+	zassert_within(len, SS_BUDGET_TICKS, TICK_SLOP, "ran for %lld ticks", len);
+	zassert_equal(k_thread_priority_get(&t[0]), K_PRIO_PREEMPT(10));
+
+	/* It preempts again for its budget once replenished */
+	preempted = wait_preemption(&len);
+	zassert_within(preempted - start, SS_PERIOD_TICKS, TICK_SLOP,
+		       "replenished after %lld ticks", preempted - start);
+	zassert_within(len, SS_BUDGET_TICKS, TICK_SLOP, "ran for %lld ticks", len);
+
+	/* A priority set while throttled is the one restored */
+	k_thread_priority_set(&t[0], K_PRIO_PREEMPT(7));
+	zassert_equal(k_thread_priority_get(&t[0]), K_PRIO_PREEMPT(10));
+
+	/* Once replenished, it is below the test thread and no longer preempts */
+	start = preempted + SS_PERIOD_TICKS + 2 * TICK_SLOP;
+	preempted = k_uptime_ticks();
+	while (preempted < start) {
+		int64_t now = k_uptime_ticks();
+
+		zassert_true(now - preempted <= 1, "preempted at %lld", now);
+		preempted = now;
+	}
+	zassert_equal(k_thread_priority_get(&t[0]), K_PRIO_PREEMPT(7));
+
+	k_thread_abort(&t[0]);
+	k_thread_priority_set(k_current_get(), old_prio);
+}
+#endif /* CONFIG_SCHED_SPORADIC */
+
 #else /* CONFIG_TIMESLICING */
 ZTEST(threads_scheduling, test_slice_scheduling)
 {
@@ -755,6 +755,43 @@ ZTEST(smp, test_smp_ipi)
 				sched_ipi_has_called);
 	}
 }
+
+/**
+ * @brief Test interprocessor interrupt sent to each CPU in turn
+ *
+ * @ingroup kernel_smp_integration_tests
+ *
+ * @see arch_sched_directed_ipi()
+ */
+ZTEST(smp, test_smp_directed_ipi)
+{
+#if !defined(CONFIG_TRACE_SCHED_IPI) || !defined(CONFIG_ARCH_HAS_DIRECTED_IPIS)
+	ztest_test_skip();
+#else
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		/* Do not migrate between the check and the IPI */
+		unsigned int key = arch_irq_lock();
+
+		if (i == _current_cpu->id) {
+			arch_irq_unlock(key);
+			continue;
+		}
+
+		sched_ipi_has_called = 0;
+		arch_sched_directed_ipi(BIT(i));
+		arch_irq_unlock(key);
+
+		k_msleep(100);
+
+		/**TESTPOINT: check the targeted CPU took the IPI */
+		zassert_true(sched_ipi_has_called != 0,
+			     "CPU %d did not receive IPI.(%d)", i,
+			     sched_ipi_has_called);
+	}
+#endif
+}
 #endif
 
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *esf)
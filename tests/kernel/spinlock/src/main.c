@@ -228,6 +228,55 @@ ZTEST(spinlock, test_trylock)
 	zassert_true(trylock_successes > 0);
 }
 
+/**
+ * @brief Test the spinlock contention counters
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spin_stats_get(), k_spin_stats_reset()
+ */
+ZTEST(spinlock, test_spinlock_stats)
+{
+#ifdef CONFIG_SPIN_LOCK_STATS
+	struct k_spinlock_stats stats;
+	k_spinlock_key_t key;
+	int i;
+
+	k_spin_stats_reset(&bounce_lock);
+
+	for (i = 0; i < 3; i++) {
+		key = k_spin_lock(&bounce_lock);
+		k_spin_unlock(&bounce_lock, key);
+	}
+
+	k_spin_stats_get(&bounce_lock, &stats);
+	zassert_equal(stats.acquired, 3);
+	zassert_equal(stats.contended, 0);
+	zassert_equal(stats.spins, 0);
+
+	k_thread_create(&cpu1_thread, cpu1_stack, CPU1_STACK_SIZE,
+			cpu1_fn, NULL, NULL, NULL,
+			0, 0, K_NO_WAIT);
+
+	k_busy_wait(10);
+
+	for (i = 0; i < 1000; i++) {
+		bounce_once(1234, false);
+	}
+
+	bounce_done = 1;
+
+	k_thread_join(&cpu1_thread, K_FOREVER);
+
+	k_spin_stats_get(&bounce_lock, &stats);
+	zassert_true(stats.acquired >= 1000 + 3);
+	zassert_true(stats.contended <= stats.acquired);
+	zassert_true(stats.spins >= stats.contended);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void before(void *ctx)
 {
 	ARG_UNUSED(ctx);
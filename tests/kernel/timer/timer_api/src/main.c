@@ -64,6 +64,7 @@ static struct k_timer status_timer;
 static struct k_timer status_anytime_timer;
 static struct k_timer status_sync_timer;
 static struct k_timer remain_timer;
+static struct k_timer slack_timer;
 
 static ZTEST_BMEM struct timer_data tdata;
 
@@ -809,6 +810,80 @@ ZTEST_USER(timer_api, test_sleep_abs)
 		     start + sleep_ticks, end, late);
 }
 
+/**
+ * @brief Test the uptime read without a system call
+ *
+ * @details With CONFIG_USERSPACE_TIME_PAGE, user threads read the uptime
+ * from the time page. It must never run ahead of the kernel and lag it
+ * by less than a tick.
+ */
+ZTEST_USER(timer_api, test_uptime_ticks_query)
+{
+	int64_t before, now, after;
+
+	for (int i = 0; i < 100; i++) {
+		before = k_uptime_ticks_query();
+		now = k_uptime_ticks();
+		after = k_uptime_ticks_query();
+
+		zassert_true(now >= before - 1 && now <= after,
+			     "uptime %lld out of [%lld, %lld]", now, before - 1, after);
+
+		k_busy_wait(k_ticks_to_us_ceil32(1) / 3);
+	}
+}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Test the slack of a timer
+ *
+ * @details The expirations of a timer with a slack are delayed to ticks
+ * aligned on the largest power of two within the slack, and the periodic
+ * expirations keep their stride from the nominal ones instead of
+ * accumulating the delays.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+ZTEST_USER(timer_api, test_timer_slack)
+{
+	const k_ticks_t slack = 15, align = 16, period = 20;
+	k_ticks_t start, end, expires;
+
+	k_timer_slack_set(&slack_timer, K_TICKS(slack));
+
+	tick_sync();
+	start = k_uptime_ticks();
+	k_timer_start(&slack_timer, K_TICKS(period), K_TICKS(period));
+	end = k_uptime_ticks();
+
+	for (int i = 1; i <= EXPIRE_TIMES; i++) {
+		expires = k_timer_expires_ticks(&slack_timer);
+
+		TIMER_ASSERT(expires % align == 0, &slack_timer);
+		TIMER_ASSERT(expires >= start + i * period, &slack_timer);
+		TIMER_ASSERT(expires <= end + i * period + slack, &slack_timer);
+
+		TIMER_ASSERT(k_timer_status_sync(&slack_timer) == 1, &slack_timer);
+	}
+
+	k_timer_stop(&slack_timer);
+	k_timer_slack_set(&slack_timer, K_NO_WAIT);
+
+	/* without slack, the expiry is the nominal one again */
+	start = k_uptime_ticks();
+	k_timer_start(&slack_timer, K_TICKS(period), K_NO_WAIT);
+	end = k_uptime_ticks();
+	expires = k_timer_expires_ticks(&slack_timer);
+	k_timer_stop(&slack_timer);
+
+	zassert_true(expires >= start + period && expires <= end + period,
+		     "expiry %lld not in [%lld, %lld]", (long long)expires,
+		     (long long)(start + period), (long long)(end + period));
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -830,6 +905,7 @@ void *setup_timer_api(void)
 	timer_init(&status_anytime_timer, NULL, NULL);
 	timer_init(&status_sync_timer, duration_expire, duration_stop);
 	timer_init(&remain_timer, duration_expire, duration_stop);
+	timer_init(&slack_timer, NULL, NULL);
 
 	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 		k_thread_access_grant(k_current_get(), &ktimer, &timer0, &timer1,
@@ -0,0 +1,118 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/perf_counter.h>
+
+#define HELPER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define LOOP_COUNT 100000
+
+static struct k_thread helper_thread;
+static K_THREAD_STACK_DEFINE(helper_stack, HELPER_STACK_SIZE);
+
+static int event_idx[2];
+
+static void busy_loop(void *p1, void *p2, void *p3)
+{
+	for (volatile unsigned int i = 0; i < LOOP_COUNT; i++) {
+	}
+}
+
+static void sleeper(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(50));
+}
+
+static void run_helper(k_thread_entry_t entry, uint64_t *counts)
+{
+	k_thread_create(&helper_thread, helper_stack,
+			K_THREAD_STACK_SIZEOF(helper_stack), entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	zassert_equal(k_thread_perf_counters_get(&helper_thread, counts,
+						 CONFIG_PERF_COUNTERS_MAX),
+		      perf_counter_num_get());
+}
+
+/**
+ * @brief Verify the counters can only count the events they support
+ */
+ZTEST(perf_counters, test_config)
+{
+	unsigned int num = perf_counter_num_get();
+
+	zassert_true(num <= CONFIG_PERF_COUNTERS_MAX);
+
+	if (num < CONFIG_PERF_COUNTERS_MAX) {
+		zassert_equal(perf_counter_config(num, PERF_COUNTER_CYCLES), -EINVAL);
+	}
+}
+
+/**
+ * @brief Verify the events are counted for the thread causing them
+ */
+ZTEST(perf_counters, test_thread_events)
+{
+	uint64_t busy[CONFIG_PERF_COUNTERS_MAX];
+	uint64_t idle[CONFIG_PERF_COUNTERS_MAX];
+	uint64_t own[CONFIG_PERF_COUNTERS_MAX];
+
+	run_helper(busy_loop, busy);
+	run_helper(sleeper, idle);
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(event_idx); i++) {
+		int idx = event_idx[i];
+
+		if (idx < 0) {
+			continue;
+		}
+
+		/* Each iteration takes at least one cycle and instruction */
+		zassert_true(busy[idx] >= LOOP_COUNT, "%llu events",
+			     (unsigned long long)busy[idx]);
+		zassert_true(idle[idx] < busy[idx] / 10, "%llu events while sleeping",
+			     (unsigned long long)idle[idx]);
+	}
+
+	/* The counts of the calling thread keep going up */
+	zassert_equal(k_thread_perf_counters_get(k_current_get(), own, ARRAY_SIZE(own)),
+		      perf_counter_num_get());
+}
+
+static void *perf_counters_setup(void)
+{
+	static const enum perf_counter_event events[] = {
+		PERF_COUNTER_CYCLES,
+		PERF_COUNTER_INSTRUCTIONS,
+	};
+	unsigned int num = perf_counter_num_get();
+	unsigned int next = 0;
+
+	/* Give cycles and instructions the first counters that count them */
+	for (unsigned int i = 0; i < ARRAY_SIZE(events); i++) {
+		event_idx[i] = -1;
+
+		for (unsigned int idx = next; idx < num; idx++) {
+			if (perf_counter_config(idx, events[i]) == 0) {
+				event_idx[i] = idx;
+				next = idx + 1;
+				break;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static void perf_counters_before(void *fixture)
+{
+	if ((event_idx[0] < 0) && (event_idx[1] < 0)) {
+		ztest_test_skip();
+	}
+}
+
+ZTEST_SUITE(perf_counters, NULL, perf_counters_setup, perf_counters_before, NULL, NULL);
@@ -541,5 +541,73 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+#define HISTOGRAM_WAKEUPS 5
+
+static K_SEM_DEFINE(histogram_sem, 0, 1);
+
+static void helper_wait(void *p1, void *p2, void *p3)
+{
+	while (1) {
+		k_sem_take(&histogram_sem, K_FOREVER);
+	}
+}
+
+static uint32_t histogram_sum(const uint32_t *bins)
+{
+	uint32_t sum = 0;
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BINS; i++) {
+		sum += bins[i];
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Test the k_thread_sched_histogram_get() API
+ *
+ * A higher priority helper thread is woken up several times. Each wakeup
+ * counts as a scheduling latency and a run of the helper, and as a
+ * preemption of the main thread.
+ */
+ZTEST(usage_api, test_thread_sched_histogram)
+{
+	struct k_sched_histogram  main_hist1;
+	struct k_sched_histogram  main_hist2;
+	struct k_sched_histogram  hist;
+	k_tid_t  tid;
+
+	zassert_equal(k_thread_sched_histogram_get(NULL, &hist), -EINVAL);
+	zassert_equal(k_thread_sched_histogram_get(_current, NULL), -EINVAL);
+
+	zassert_ok(k_thread_sched_histogram_get(_current, &main_hist1));
+
+	/* The helper runs right away and waits for the semaphore */
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_wait, NULL, NULL, NULL,
+			      k_thread_priority_get(_current) - 1, 0,
+			      K_NO_WAIT);
+
+	for (int i = 0; i < HISTOGRAM_WAKEUPS; i++) {
+		k_sem_give(&histogram_sem);
+	}
+
+	zassert_ok(k_thread_sched_histogram_get(tid, &hist));
+	zassert_ok(k_thread_sched_histogram_get(_current, &main_hist2));
+
+	zassert_equal(histogram_sum(hist.wakeup), HISTOGRAM_WAKEUPS + 1);
+	zassert_equal(histogram_sum(hist.run), HISTOGRAM_WAKEUPS + 1);
+	zassert_equal(histogram_sum(hist.preempt), 0);
+
+	zassert_true(histogram_sum(main_hist2.preempt) >=
+		     histogram_sum(main_hist1.preempt) + HISTOGRAM_WAKEUPS + 1);
+
+	k_thread_abort(tid);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
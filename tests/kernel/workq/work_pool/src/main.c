@@ -0,0 +1,199 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define POOL_PRIORITY K_PRIO_COOP(0)
+#define NUM_WORKERS 2
+
+#define DELAY_MS 100
+#define DELAY_TIMEOUT K_MSEC(DELAY_MS)
+
+static K_THREAD_STACK_DEFINE(pool_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q_worker workers[NUM_WORKERS];
+static struct k_work_q pool_queue;
+
+/* Given by test thread to release a blocking work item. */
+static K_SEM_DEFINE(rel_sem, 0, 1);
+
+/* Given by work items that have completed. */
+static K_SEM_DEFINE(done_sem, 0, 10);
+
+static struct k_work block_work;
+static struct k_work quick_work;
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+static atomic_t block_ctr;
+static atomic_t block_active;
+static bool block_reentered;
+static atomic_t quick_ctr;
+
+static void block_handler(struct k_work *work)
+{
+	if (atomic_inc(&block_active) != 0) {
+		block_reentered = true;
+	}
+
+	(void)k_sem_take(&rel_sem, K_FOREVER);
+
+	atomic_inc(&block_ctr);
+	atomic_dec(&block_active);
+	k_sem_give(&done_sem);
+}
+
+static void quick_handler(struct k_work *work)
+{
+	atomic_inc(&quick_ctr);
+	k_sem_give(&done_sem);
+}
+
+static void async_release_cb(struct k_timer *timer)
+{
+	k_sem_give(&rel_sem);
+}
+
+static K_TIMER_DEFINE(async_releaser, async_release_cb, NULL);
+
+static void check_parallel(struct k_work_q *queue)
+{
+	zassert_equal(k_work_submit_to_queue(queue, &block_work), 1);
+	zassert_equal(k_work_submit_to_queue(queue, &quick_work), 1);
+
+	/* The quick item is not held up by the blocked one */
+	zassert_ok(k_sem_take(&done_sem, DELAY_TIMEOUT));
+	zassert_equal(atomic_get(&quick_ctr), 1);
+	zassert_equal(k_work_busy_get(&block_work), K_WORK_RUNNING);
+
+	k_sem_give(&rel_sem);
+	zassert_ok(k_sem_take(&done_sem, DELAY_TIMEOUT));
+	zassert_equal(atomic_get(&block_ctr), 1);
+}
+
+/* Items on a queue with several threads do not wait behind each other. */
+ZTEST(work_pool, test_parallel)
+{
+	check_parallel(&pool_queue);
+}
+
+/* A resubmitted item is not run again before it completes. */
+ZTEST(work_pool, test_no_reentrancy)
+{
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &block_work), 1);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&block_work), K_WORK_RUNNING);
+
+	/* Resubmitting while running queues it to the same queue */
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &block_work), 2);
+
+	/* The idle threads leave it pending */
+	k_sleep(DELAY_TIMEOUT);
+	zassert_equal(k_work_busy_get(&block_work),
+		      K_WORK_RUNNING | K_WORK_QUEUED);
+
+	k_sem_give(&rel_sem);
+	zassert_ok(k_sem_take(&done_sem, DELAY_TIMEOUT));
+	k_sem_give(&rel_sem);
+	zassert_ok(k_sem_take(&done_sem, DELAY_TIMEOUT));
+
+	zassert_equal(atomic_get(&block_ctr), 2);
+	zassert_false(block_reentered);
+}
+
+/* Flushing a running item waits for it even when other threads are idle. */
+ZTEST(work_pool, test_running_flush)
+{
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &block_work), 1);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&block_work), K_WORK_RUNNING);
+
+	k_timer_start(&async_releaser, DELAY_TIMEOUT, K_NO_WAIT);
+
+	zassert_true(k_work_flush(&block_work, &work_sync));
+	zassert_equal(atomic_get(&block_ctr), 1);
+	zassert_equal(k_work_busy_get(&block_work), 0);
+
+	zassert_ok(k_sem_take(&done_sem, K_NO_WAIT));
+}
+
+/* Canceling a running item waits for it to complete. */
+ZTEST(work_pool, test_running_cancel_sync)
+{
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &block_work), 1);
+	k_sleep(K_TICKS(1));
+
+	k_timer_start(&async_releaser, DELAY_TIMEOUT, K_NO_WAIT);
+
+	zassert_true(k_work_cancel_sync(&block_work, &work_sync));
+	zassert_equal(atomic_get(&block_ctr), 1);
+	zassert_equal(k_work_busy_get(&block_work), 0);
+
+	zassert_ok(k_sem_take(&done_sem, K_NO_WAIT));
+}
+
+/* Draining waits for the items being run by every thread. */
+ZTEST(work_pool, test_drain)
+{
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &block_work), 1);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &quick_work), 1);
+
+	k_timer_start(&async_releaser, DELAY_TIMEOUT, K_NO_WAIT);
+
+	zassert_equal(k_work_queue_drain(&pool_queue, false), 1);
+	zassert_equal(atomic_get(&block_ctr), 1);
+	zassert_equal(atomic_get(&quick_ctr), 1);
+
+	zassert_ok(k_sem_take(&done_sem, K_NO_WAIT));
+	zassert_ok(k_sem_take(&done_sem, K_NO_WAIT));
+}
+
+/* The system work queue can be served by several threads too. */
+ZTEST(work_pool, test_system_queue)
+{
+	if (CONFIG_SYSTEM_WORKQUEUE_THREADS == 1) {
+		ztest_test_skip();
+	}
+
+	check_parallel(&k_sys_work_q);
+}
+
+static void work_pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_work_init(&block_work, block_handler);
+	k_work_init(&quick_work, quick_handler);
+
+	k_sem_reset(&rel_sem);
+	k_sem_reset(&done_sem);
+
+	atomic_set(&block_ctr, 0);
+	atomic_set(&block_active, 0);
+	atomic_set(&quick_ctr, 0);
+	block_reentered = false;
+}
+
+static void *work_pool_setup(void)
+{
+	k_work_queue_init(&pool_queue);
+	k_work_queue_start(&pool_queue, pool_stack, K_THREAD_STACK_SIZEOF(pool_stack),
+			   POOL_PRIORITY, NULL);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_work_queue_add_worker(&pool_queue, &workers[i], worker_stacks[i],
+					K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+					POOL_PRIORITY, -1);
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, work_pool_before, NULL, NULL);
@@ -0,0 +1,231 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+
+#define N_KEYS 1024
+
+SYS_BTREE_DEFINE(tree, SYS_BTREE_NODES(N_KEYS));
+
+/* Entries expected in the tree, key i maps to values[i] when present[i] */
+static bool present[2 * N_KEYS];
+static uintptr_t values[2 * N_KEYS];
+static uintptr_t keys[N_KEYS];
+
+static uint32_t rand_state = 0x2545f491;
+
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+/* Walk the whole tree and compare it to the expected entries */
+static void check_tree(void)
+{
+	struct sys_btree_iter iter;
+	uintptr_t key, value, last = 0;
+	size_t count = 0, expected = 0;
+
+	SYS_BTREE_FOR_EACH(&tree, iter, key, value) {
+		zassert_true(key < ARRAY_SIZE(present) && present[key], "unexpected key %lu",
+			     (unsigned long)key);
+		zassert_equal(value, values[key], "wrong value for %lu", (unsigned long)key);
+		zassert_true(count == 0 || key > last, "keys out of order");
+		last = key;
+		count++;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(present); i++) {
+		expected += present[i];
+	}
+
+	zassert_equal(count, expected, "%zu entries walked, %zu expected", count, expected);
+	zassert_equal(sys_btree_size(&tree), expected, "wrong size");
+}
+
+static void reset(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sys_btree_clear(&tree);
+	memset(present, 0, sizeof(present));
+}
+
+ZTEST(btree, test_insert_get_remove)
+{
+	uintptr_t value;
+
+	zassert_false(sys_btree_get(&tree, 1, &value), "empty tree has a key");
+	zassert_false(sys_btree_remove(&tree, 1, NULL), "removed from an empty tree");
+
+	for (uintptr_t i = 0; i < N_KEYS; i++) {
+		uintptr_t key = (i * 37) % N_KEYS;
+
+		zassert_equal(sys_btree_insert(&tree, key, key + 1, NULL), 0, "insert failed");
+		present[key] = true;
+		values[key] = key + 1;
+	}
+	check_tree();
+
+	zassert_equal(sys_btree_insert(&tree, 10, 100, &value), 1, "value not replaced");
+	zassert_equal(value, 11, "wrong replaced value");
+	values[10] = 100;
+
+	zassert_true(sys_btree_get(&tree, 10, &value), "key not found");
+	zassert_equal(value, 100, "wrong value");
+	zassert_false(sys_btree_get(&tree, N_KEYS, NULL), "missing key found");
+
+	zassert_true(sys_btree_get_max(&tree, &value, NULL), "no maximum");
+	zassert_equal(value, N_KEYS - 1, "wrong maximum");
+
+	for (uintptr_t key = 0; key < N_KEYS; key += 2) {
+		zassert_true(sys_btree_remove(&tree, key, &value), "remove failed");
+		zassert_equal(value, values[key], "wrong removed value");
+		present[key] = false;
+	}
+	check_tree();
+
+	zassert_false(sys_btree_remove(&tree, 0, NULL), "removed twice");
+
+	for (uintptr_t key = 1; key < N_KEYS; key += 2) {
+		zassert_true(sys_btree_remove(&tree, key, NULL), "remove failed");
+		present[key] = false;
+	}
+	check_tree();
+	zassert_false(sys_btree_get_max(&tree, &value, NULL), "maximum of an empty tree");
+}
+
+ZTEST(btree, test_range)
+{
+	struct sys_btree_iter iter;
+	uintptr_t key, value, expected;
+
+	/* Even keys only */
+	for (uintptr_t i = 0; i < N_KEYS; i++) {
+		zassert_equal(sys_btree_insert(&tree, 2 * i, i, NULL), 0, "insert failed");
+	}
+
+	/* From a missing key */
+	expected = 102;
+	SYS_BTREE_FOR_EACH_RANGE(&tree, iter, 101, 201, key, value) {
+		zassert_equal(key, expected, "got %lu instead of %lu", (unsigned long)key,
+			      (unsigned long)expected);
+		zassert_equal(value, key / 2, "wrong value");
+		expected += 2;
+	}
+	zassert_equal(expected, 202, "range ended at %lu", (unsigned long)expected);
+
+	/* Past the end */
+	sys_btree_iter_init(&tree, &iter, 2 * N_KEYS);
+	zassert_false(sys_btree_iter_next(&iter, &key, &value), "entry past the end");
+}
+
+ZTEST(btree, test_load)
+{
+	/* The pool is sized for N_KEYS entries, twice the largest load */
+	for (size_t n = 0; n <= N_KEYS / 2; n = 2 * n + 1) {
+		sys_btree_clear(&tree);
+		memset(present, 0, sizeof(present));
+
+		for (size_t i = 0; i < n; i++) {
+			keys[i] = 2 * i + 1;
+			present[keys[i]] = true;
+			values[keys[i]] = 0;
+		}
+
+		zassert_equal(sys_btree_load(&tree, keys, NULL, n), 0, "load of %zu failed", n);
+		check_tree();
+
+		/* The tree is fully usable after a load */
+		for (size_t i = 0; i < n; i++) {
+			zassert_equal(sys_btree_insert(&tree, 2 * i, i, NULL), 0, "insert failed");
+			present[2 * i] = true;
+			values[2 * i] = i;
+		}
+		check_tree();
+	}
+
+	zassert_equal(sys_btree_load(&tree, keys, NULL, 1), -EINVAL, "loaded a full tree");
+
+	sys_btree_clear(&tree);
+	keys[0] = 5;
+	keys[1] = 5;
+	zassert_equal(sys_btree_load(&tree, keys, NULL, 2), -EINVAL, "loaded unsorted keys");
+	zassert_equal(sys_btree_size(&tree), 0, "tree not left empty");
+}
+
+ZTEST(btree, test_random)
+{
+	uintptr_t value;
+	bool found;
+
+	for (int i = 0; i < 20 * N_KEYS; i++) {
+		uint32_t r = next_rand();
+		uintptr_t key = (r >> 8) % (2 * N_KEYS);
+
+		switch (r % 3) {
+		case 0:
+			if (sys_btree_size(&tree) == N_KEYS && !present[key]) {
+				break;
+			}
+			zassert_equal(sys_btree_insert(&tree, key, r, NULL), present[key],
+				      "wrong insert result");
+			present[key] = true;
+			values[key] = r;
+			break;
+		case 1:
+			found = sys_btree_remove(&tree, key, &value);
+			zassert_equal(found, present[key], "wrong remove result");
+			zassert_true(!found || value == values[key], "wrong removed value");
+			present[key] = false;
+			break;
+		default:
+			found = sys_btree_get(&tree, key, &value);
+			zassert_equal(found, present[key], "wrong get result");
+			zassert_true(!found || value == values[key], "wrong value");
+			break;
+		}
+
+		if (i % N_KEYS == 0) {
+			check_tree();
+		}
+	}
+
+	check_tree();
+}
+
+ZTEST(btree, test_pool_exhaustion)
+{
+	struct sys_btree_node nodes[3];
+	struct sys_btree small;
+	uintptr_t key = 0;
+	int ret;
+
+	sys_btree_init(&small, nodes, ARRAY_SIZE(nodes));
+
+	do {
+		ret = sys_btree_insert(&small, key++, 0, NULL);
+	} while (ret == 0);
+
+	zassert_equal(ret, -ENOMEM, "no error when out of nodes");
+
+	/* Everything inserted before is still there */
+	for (uintptr_t k = 0; k < key - 1; k++) {
+		zassert_true(sys_btree_get(&small, k, NULL), "lost key %lu", (unsigned long)k);
+	}
+	zassert_equal(sys_btree_size(&small), key - 1, "wrong size");
+
+	/* Removing makes room again */
+	zassert_true(sys_btree_remove(&small, 0, NULL), "remove failed");
+	zassert_equal(sys_btree_insert(&small, 0, 0, NULL), 0, "insert failed");
+}
+
+ZTEST_SUITE(btree, NULL, NULL, reset, NULL, NULL);
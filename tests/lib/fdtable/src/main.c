@@ -31,6 +31,36 @@ ZTEST(fdtable, test_z_reserve_fd)
 	z_free_fd(fd);
 }
 
+ZTEST(fdtable, test_z_reserve_fd_lowest)
+{
+	static int fds[CONFIG_POSIX_MAX_FDS];
+	int count = 0;
+	int fd;
+
+	/* Exhaust the table */
+	while ((fd = z_reserve_fd()) >= 0) {
+		zassert_true(count < ARRAY_SIZE(fds), "too many fds");
+		fds[count++] = fd;
+	}
+
+	zassert_equal(errno, ENFILE, "unexpected errno %d", errno);
+	zassert_true(count >= 2, "too few fds");
+
+	/* The lowest free descriptor is reused first */
+	z_free_fd(fds[count - 1]);
+	z_free_fd(fds[count / 2]);
+
+	fd = z_reserve_fd();
+	zassert_equal(fd, fds[count / 2], "fd %d is not the lowest free", fd);
+
+	fd = z_reserve_fd();
+	zassert_equal(fd, fds[count - 1], "fd %d is not the lowest free", fd);
+
+	for (int i = 0; i < count; i++) {
+		z_free_fd(fds[i]);
+	}
+}
+
 ZTEST(fdtable, test_z_get_fd_obj_and_vtable)
 {
 	const struct fd_op_vtable *vtable;
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <stdlib.h>
 #include <string.h>
 #include <zephyr/types.h>
 #include <stdbool.h>
@@ -1209,4 +1210,316 @@ ZTEST(lib_json_test, test_large_descriptor)
 	zassert_true(ret & ((int64_t)1 << 39), "Field int39 not decoded");
 }
 
+ZTEST(lib_json_test, test_json_stream_decoding)
+{
+	static const char encoded[] = "{\"some_string\":\"zephyr 123\\uABCD456\","
+		"\"some_int\":\t42\n,"
+		"\"some_bool\":true    \t  "
+		"\n"
+		"\r   ,"
+		"\"some_nested_struct\":{    "
+		"\"nested_int\":-1234,\n\n"
+		"\"nested_bool\":false,\t"
+		"\"nested_string\":\"this should be escaped: \\t\","
+		"\"extra_nested_array\":[0,-1]},"
+		"\"extra_struct\":{\"nested_bool\":false},"
+		"\"extra_bool\":true,"
+		"\"some_array\":[11,22, 33,\t45,\n299],"
+		"\"another_b!@l\":true,"
+		"\"if\":false,"
+		"\"another-array\":[2,3,5,7],"
+		"\"4nother_ne$+\":{\"nested_int\":1234,"
+		"\"nested_bool\":true,"
+		"\"nested_string\":\"no escape necessary\"},"
+		"\"nested_obj_array\":["
+		"{\"nested_int\":1,\"nested_bool\":true,\"nested_string\":\"true\"},"
+		"{\"nested_int\":0,\"nested_bool\":false,\"nested_string\":\"false\"}]"
+		"}\n";
+	const int expected_array[] = { 11, 22, 33, 45, 299 };
+	const size_t chunk_sizes[] = { 1, 3, 16, sizeof(encoded) - 1 };
+	struct json_obj_stream os;
+	struct test_struct ts;
+	char buf[256];
+	int64_t ret;
+
+	ARRAY_FOR_EACH(chunk_sizes, n) {
+		size_t chunk = chunk_sizes[n];
+
+		memset(&ts, 0, sizeof(ts));
+		json_obj_stream_init(&os, buf, sizeof(buf), test_descr,
+				     ARRAY_SIZE(test_descr), &ts);
+
+		for (size_t i = 0; i < sizeof(encoded) - 1; i += chunk) {
+			zassert_ok(json_obj_stream_feed(&os, &encoded[i],
+					MIN(chunk, sizeof(encoded) - 1 - i)),
+				   "Chunk at %zu not decoded", i);
+		}
+
+		ret = json_obj_stream_finish(&os);
+		zassert_equal(ret, (1 << ARRAY_SIZE(test_descr)) - 1,
+			      "Not all fields decoded correctly");
+
+		zassert_true(!strcmp(ts.some_string, "zephyr 123\\uABCD456"),
+			     "String not decoded correctly");
+		zassert_equal(ts.some_int, 42,
+			      "Positive integer not decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int, -1234,
+			      "Nested negative integer not decoded correctly");
+		zassert_true(!strcmp(ts.some_nested_struct.nested_string,
+				     "this should be escaped: \\t"),
+			     "Nested string not decoded correctly");
+		zassert_equal(ts.some_array_len, 5,
+			      "Array doesn't have correct number of items");
+		zassert_true(!memcmp(ts.some_array, expected_array,
+				     sizeof(expected_array)),
+			     "Array not decoded with expected values");
+		zassert_true(ts.another_bxxl,
+			     "Named boolean (special chars) not decoded correctly");
+		zassert_true(!strcmp(ts.xnother_nexx.nested_string,
+				     "no escape necessary"),
+			     "Named nested string not decoded correctly");
+		zassert_equal(ts.obj_array_len, 2,
+			      "Array of objects does not have correct number of items");
+		zassert_true(!strcmp(ts.nested_obj_array[1].nested_string, "false"),
+			     "String in second object array element not decoded correctly");
+	}
+}
+
+struct stream_events {
+	char types[16];
+	int count;
+	int max_depth;
+	int32_t last_number;
+};
+
+static int stream_events_cb(const struct json_stream_event *event,
+			    void *user_data)
+{
+	struct stream_events *events = user_data;
+
+	zassert_true(events->count < sizeof(events->types) - 1);
+	events->types[events->count++] = event->type;
+	events->max_depth = MAX(events->max_depth, event->depth);
+
+	if (event->type == JSON_TOK_NUMBER) {
+		events->last_number = strtol(event->value, NULL, 10);
+	}
+
+	if (event->type == JSON_TOK_STRING) {
+		zassert_equal(event->key_len, 1);
+		zassert_mem_equal(event->key, "s", 1);
+		zassert_equal(event->value_len, 3);
+		zassert_true(!strcmp(event->value, "abc"));
+	}
+
+	return 0;
+}
+
+ZTEST(lib_json_test, test_json_stream_events)
+{
+	static const char encoded[] = "{\"s\":\"abc\",\"a\":[1,null,{\"t\":true}]}";
+	struct stream_events events = { 0 };
+	struct json_stream js;
+	char buf[16];
+
+	json_stream_init(&js, buf, sizeof(buf), stream_events_cb, &events);
+
+	for (size_t i = 0; i < sizeof(encoded) - 1; i++) {
+		zassert_ok(json_stream_feed(&js, &encoded[i], 1));
+	}
+
+	zassert_ok(json_stream_finish(&js));
+	zassert_true(!strcmp(events.types, "{\"[0n{t}]}"),
+		     "Unexpected events %s", events.types);
+	zassert_equal(events.max_depth, 3);
+
+	/**TESTPOINT: a number ends with the document */
+	memset(&events, 0, sizeof(events));
+	json_stream_init(&js, buf, sizeof(buf), stream_events_cb, &events);
+	zassert_ok(json_stream_feed(&js, "-12", 3));
+	zassert_equal(events.count, 0);
+	zassert_ok(json_stream_finish(&js));
+	zassert_equal(events.last_number, -12);
+}
+
+ZTEST(lib_json_test, test_json_stream_invalid)
+{
+	static const char * const encoded[] = {
+		"{\"a\" 1}",
+		"{\"a\":1,}",
+		"[1,]",
+		"{]",
+		"{\"a\":-}",
+		"[1 2]",
+		"{}{}",
+		"{\"a\":\"\\X\"}",
+		"{\"a\":truffle}",
+	};
+	static const char * const incomplete[] = {
+		"{\"a\":1",
+		"\"abc",
+		"tru",
+		"",
+	};
+	struct stream_events events;
+	struct json_stream js;
+	char buf[16];
+
+	ARRAY_FOR_EACH(encoded, i) {
+		memset(&events, 0, sizeof(events));
+		json_stream_init(&js, buf, sizeof(buf), stream_events_cb, &events);
+		zassert_equal(json_stream_feed(&js, encoded[i], strlen(encoded[i])),
+			      -EINVAL, "'%s' not refused", encoded[i]);
+		zassert_equal(json_stream_feed(&js, "1", 1), -EINVAL);
+	}
+
+	ARRAY_FOR_EACH(incomplete, i) {
+		memset(&events, 0, sizeof(events));
+		json_stream_init(&js, buf, sizeof(buf), stream_events_cb, &events);
+		zassert_ok(json_stream_feed(&js, incomplete[i],
+					    strlen(incomplete[i])));
+		zassert_equal(json_stream_finish(&js), -EINVAL,
+			      "'%s' not refused", incomplete[i]);
+	}
+
+	/**TESTPOINT: a token larger than the buffer */
+	json_stream_init(&js, buf, 4, stream_events_cb, &events);
+	zassert_equal(json_stream_feed(&js, "[1234]", 6), -ENOMEM);
+}
+
+ZTEST(lib_json_test, test_json_obj_stream_invalid)
+{
+	static const char encoded[] = "{\"some_int\":\"abc\"}";
+	static const char long_array[] = "{\"some_array\":[1,2,3,4,5,6,7,8,9,10,"
+		"11,12,13,14,15,16,17]}";
+	struct json_obj_stream os;
+	struct test_struct ts;
+	char buf[32];
+
+	/**TESTPOINT: a value of the wrong type */
+	json_obj_stream_init(&os, buf, sizeof(buf), test_descr,
+			     ARRAY_SIZE(test_descr), &ts);
+	zassert_equal(json_obj_stream_feed(&os, encoded, sizeof(encoded) - 1),
+		      -EINVAL);
+
+	/**TESTPOINT: more elements than the array holds */
+	json_obj_stream_init(&os, buf, sizeof(buf), test_descr,
+			     ARRAY_SIZE(test_descr), &ts);
+	zassert_equal(json_obj_stream_feed(&os, long_array,
+					   sizeof(long_array) - 1), -ENOSPC);
+
+	/**TESTPOINT: the top level value must be an object */
+	json_obj_stream_init(&os, buf, sizeof(buf), test_descr,
+			     ARRAY_SIZE(test_descr), &ts);
+	zassert_equal(json_obj_stream_feed(&os, "[]", 2), -EINVAL);
+}
+
+JSON_ENCODER_DEFINE(nested_encode, struct test_nested,
+		    JSON_ENC_NUMBER(nested_int),
+		    JSON_ENC_BOOL(nested_bool),
+		    JSON_ENC_STRING(nested_string));
+
+JSON_ENCODER_DEFINE(test_encode, struct test_struct,
+		    JSON_ENC_STRING(some_string),
+		    JSON_ENC_NUMBER(some_int),
+		    JSON_ENC_BOOL(some_bool),
+		    JSON_ENC_OBJECT(some_nested_struct, nested_encode),
+		    JSON_ENC_ARRAY(some_array, some_array_len,
+				   JSON_ENC_ELEM_NUMBER),
+		    JSON_ENC_BOOL_NAMED(another_bxxl, "another_b!@l"),
+		    JSON_ENC_BOOL_NAMED(if_, "if"),
+		    JSON_ENC_ARRAY_NAMED(another_array, "another-array",
+					 another_array_len, JSON_ENC_ELEM_NUMBER),
+		    JSON_ENC_OBJECT_NAMED(xnother_nexx, "4nother_ne$+",
+					  nested_encode),
+		    JSON_ENC_OBJ_ARRAY(nested_obj_array, obj_array_len,
+				       nested_encode));
+
+struct test_tokens {
+	struct json_obj_token num;
+	struct json_obj_token opaque;
+	const char *names[2];
+	size_t names_len;
+};
+
+static const struct json_obj_descr tokens_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct test_tokens, num, JSON_TOK_FLOAT),
+	JSON_OBJ_DESCR_PRIM(struct test_tokens, opaque, JSON_TOK_OPAQUE),
+	JSON_OBJ_DESCR_ARRAY(struct test_tokens, names, 2, names_len,
+			     JSON_TOK_STRING),
+};
+
+JSON_ENCODER_DEFINE(tokens_encode, struct test_tokens,
+		    JSON_ENC_FLOAT(num),
+		    JSON_ENC_OPAQUE(opaque),
+		    JSON_ENC_ARRAY(names, names_len, JSON_ENC_ELEM_STRING));
+
+ZTEST(lib_json_test, test_json_encoder_define)
+{
+	struct test_struct ts = {
+		.some_string = "zephyr \"123\"\n",
+		.some_int = INT32_MIN,
+		.some_bool = true,
+		.some_nested_struct = {
+			.nested_int = -1234,
+			.nested_string = "this should be escaped: \t",
+		},
+		.some_array = { 1, 4, 8, 16, INT32_MAX },
+		.some_array_len = 5,
+		.another_bxxl = true,
+		.xnother_nexx = {
+			.nested_int = 0,
+			.nested_bool = true,
+			.nested_string = "",
+		},
+		.nested_obj_array = {
+			{1, true, "true"},
+			{0, false, "false"}
+		},
+		.obj_array_len = 2
+	};
+	struct test_tokens tt = {
+		.num = { .start = "-1.5e3", .length = 6 },
+		.opaque = { .start = "raw", .length = 3 },
+	};
+	char expected[512];
+	char buffer[512];
+	ssize_t len;
+
+	zassert_ok(json_obj_encode_buf(test_descr, ARRAY_SIZE(test_descr),
+				       &ts, expected, sizeof(expected)));
+
+	/**TESTPOINT: same output and length as the descriptor encoder */
+	len = test_encode(&ts, buffer, sizeof(buffer));
+	zassert_equal(len, json_calc_encoded_len(test_descr,
+						 ARRAY_SIZE(test_descr), &ts));
+	zassert_equal(len, strlen(expected));
+	zassert_mem_equal(buffer, expected, len + 1);
+
+	/**TESTPOINT: measuring only */
+	zassert_equal(test_encode(&ts, NULL, 0), len);
+
+	/**TESTPOINT: the output is truncated and terminated */
+	memset(buffer, 'x', sizeof(buffer));
+	zassert_equal(test_encode(&ts, buffer, 10), len);
+	zassert_mem_equal(buffer, expected, 9);
+	zassert_equal(buffer[9], '\0');
+	zassert_equal(buffer[10], 'x');
+
+	zassert_ok(json_obj_encode_buf(tokens_descr, ARRAY_SIZE(tokens_descr),
+				       &tt, expected, sizeof(expected)));
+	len = tokens_encode(&tt, buffer, sizeof(buffer));
+	zassert_equal(len, strlen(expected));
+	zassert_mem_equal(buffer, expected, len + 1);
+
+	tt.names[0] = "a\\b";
+	tt.names[1] = "c";
+	tt.names_len = 2;
+	zassert_ok(json_obj_encode_buf(tokens_descr, ARRAY_SIZE(tokens_descr),
+				       &tt, expected, sizeof(expected)));
+	len = tokens_encode(&tt, buffer, sizeof(buffer));
+	zassert_equal(len, strlen(expected));
+	zassert_mem_equal(buffer, expected, len + 1);
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,222 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/ztress.h>
+#include <zephyr/sys/mpmc_ring.h>
+
+#define RING_LEN 8
+#define N_PRODUCERS 3
+#define STRESS_TIMEOUT_MS 1000
+
+struct elem {
+	uint16_t producer;
+	uint16_t seq;
+	uint32_t check;
+};
+
+MPMC_RING_DEFINE(ring, sizeof(struct elem), RING_LEN);
+
+static atomic_t dyn_seq[4];
+static uint32_t dyn_buf[4];
+static struct mpmc_ring dyn_ring;
+
+static void check_elem(const struct elem *e, uint16_t producer, uint16_t seq)
+{
+	zassert_equal(e->producer, producer);
+	zassert_equal(e->seq, seq);
+	zassert_equal(e->check, ~(((uint32_t)producer << 16) | seq));
+}
+
+static void fill_elem(struct elem *e, uint16_t producer, uint16_t seq)
+{
+	e->producer = producer;
+	e->seq = seq;
+	e->check = ~(((uint32_t)producer << 16) | seq);
+}
+
+ZTEST(mpmc_ring, test_put_get)
+{
+	struct elem e;
+
+	zassert_equal(mpmc_ring_capacity_get(&ring), RING_LEN);
+	zassert_equal(mpmc_ring_get(&ring, &e), -EAGAIN);
+
+	/* Several laps, to check the sequence numbers */
+	for (uint16_t lap = 0; lap < 3; lap++) {
+		for (uint16_t i = 0; i < RING_LEN; i++) {
+			fill_elem(&e, lap, i);
+			zassert_ok(mpmc_ring_put(&ring, &e));
+		}
+
+		zassert_equal(mpmc_ring_size_get(&ring), RING_LEN);
+		zassert_equal(mpmc_ring_put(&ring, &e), -ENOMEM);
+
+		for (uint16_t i = 0; i < RING_LEN; i++) {
+			zassert_ok(mpmc_ring_get(&ring, &e));
+			check_elem(&e, lap, i);
+		}
+
+		zassert_equal(mpmc_ring_get(&ring, &e), -EAGAIN);
+		zassert_equal(mpmc_ring_size_get(&ring), 0);
+	}
+}
+
+ZTEST(mpmc_ring, test_claim_finish)
+{
+	struct elem *first, *second, *rd;
+	struct elem e;
+
+	first = mpmc_ring_put_claim(&ring);
+	second = mpmc_ring_put_claim(&ring);
+	zassert_not_null(first);
+	zassert_not_null(second);
+	zassert_not_equal(first, second);
+
+	/**TESTPOINT: an unfinished element holds back the ones after it */
+	fill_elem(second, 0, 1);
+	mpmc_ring_put_finish(&ring, second);
+	zassert_is_null(mpmc_ring_get_claim(&ring));
+	zassert_equal(mpmc_ring_get_n(&ring, &e, 1), 0);
+
+	fill_elem(first, 0, 0);
+	mpmc_ring_put_finish(&ring, first);
+
+	rd = mpmc_ring_get_claim(&ring);
+	zassert_equal(rd, first);
+	check_elem(rd, 0, 0);
+
+	/**TESTPOINT: consumers do not wait for each other */
+	zassert_ok(mpmc_ring_get(&ring, &e));
+	check_elem(&e, 0, 1);
+
+	/**TESTPOINT: the space is only reusable once the read is finished */
+	for (int i = 0; i < RING_LEN - 2; i++) {
+		zassert_ok(mpmc_ring_put(&ring, &e));
+	}
+	zassert_is_null(mpmc_ring_put_claim(&ring));
+	mpmc_ring_get_finish(&ring, rd);
+	zassert_not_null(mpmc_ring_put_claim(&ring));
+}
+
+ZTEST(mpmc_ring, test_get_n)
+{
+	struct elem out[RING_LEN + 1];
+	struct elem e = {0};
+
+	/* Start in the middle so that the batch wraps around */
+	for (uint16_t i = 0; i < RING_LEN / 2; i++) {
+		zassert_ok(mpmc_ring_put(&ring, &e));
+		zassert_ok(mpmc_ring_get(&ring, &e));
+	}
+
+	for (uint16_t i = 0; i < RING_LEN - 1; i++) {
+		fill_elem(&e, 1, i);
+		zassert_ok(mpmc_ring_put(&ring, &e));
+	}
+
+	zassert_equal(mpmc_ring_get_n(&ring, out, 2), 2);
+	check_elem(&out[0], 1, 0);
+	check_elem(&out[1], 1, 1);
+
+	/**TESTPOINT: only the available elements are copied */
+	memset(out, 0, sizeof(out));
+	zassert_equal(mpmc_ring_get_n(&ring, out, ARRAY_SIZE(out)), RING_LEN - 3);
+	for (uint16_t i = 0; i < RING_LEN - 3; i++) {
+		check_elem(&out[i], 1, i + 2);
+	}
+
+	zassert_equal(mpmc_ring_get_n(&ring, out, ARRAY_SIZE(out)), 0);
+}
+
+ZTEST(mpmc_ring, test_init)
+{
+	uint32_t val;
+
+	mpmc_ring_init(&dyn_ring, dyn_seq, dyn_buf, sizeof(dyn_buf[0]), ARRAY_SIZE(dyn_buf));
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(dyn_buf); i++) {
+		zassert_ok(mpmc_ring_put(&dyn_ring, &i));
+	}
+	zassert_equal(mpmc_ring_put(&dyn_ring, &val), -ENOMEM);
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(dyn_buf); i++) {
+		zassert_ok(mpmc_ring_get(&dyn_ring, &val));
+		zassert_equal(val, i);
+	}
+}
+
+static atomic_t produced;
+static uint16_t next_seq[N_PRODUCERS];
+static uint16_t expect_seq[N_PRODUCERS];
+static uint32_t consumed;
+
+static bool produce(void *user_data, uint32_t cnt, bool last, int prio)
+{
+	uint16_t id = (uint16_t)(uintptr_t)user_data;
+	struct elem *e = mpmc_ring_put_claim(&ring);
+
+	if (e != NULL) {
+		fill_elem(e, id, next_seq[id]++);
+		mpmc_ring_put_finish(&ring, e);
+		atomic_inc(&produced);
+	}
+
+	return true;
+}
+
+static void consume_one(const struct elem *e)
+{
+	zassert_true(e->producer < N_PRODUCERS);
+	check_elem(e, e->producer, expect_seq[e->producer]);
+	expect_seq[e->producer]++;
+	consumed++;
+}
+
+static bool consume(void *user_data, uint32_t cnt, bool last, int prio)
+{
+	struct elem out[RING_LEN / 2];
+	size_t n;
+
+	if (cnt & 1) {
+		n = mpmc_ring_get_n(&ring, out, ARRAY_SIZE(out));
+	} else {
+		n = mpmc_ring_get(&ring, &out[0]) == 0 ? 1 : 0;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		consume_one(&out[i]);
+	}
+
+	return true;
+}
+
+ZTEST(mpmc_ring, test_stress)
+{
+	struct elem e;
+
+	ztress_set_timeout(K_MSEC(STRESS_TIMEOUT_MS));
+	ZTRESS_EXECUTE(ZTRESS_TIMER(produce, (void *)0, 0, Z_TIMEOUT_TICKS(4)),
+		       ZTRESS_THREAD(produce, (void *)1, 0, 0, Z_TIMEOUT_TICKS(4)),
+		       ZTRESS_THREAD(consume, NULL, 0, 0, Z_TIMEOUT_TICKS(4)),
+		       ZTRESS_THREAD(produce, (void *)2, 0, 0, Z_TIMEOUT_TICKS(4)));
+
+	while (mpmc_ring_get(&ring, &e) == 0) {
+		consume_one(&e);
+	}
+
+	zassert_true(consumed > 0);
+	zassert_equal(consumed, atomic_get(&produced));
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	mpmc_ring_init(&ring, ring.seq, ring.buffer, sizeof(struct elem), RING_LEN);
+}
+
+ZTEST_SUITE(mpmc_ring, NULL, NULL, before, NULL, NULL);
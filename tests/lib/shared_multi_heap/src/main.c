@@ -205,6 +205,21 @@ ZTEST(shared_multi_heap, test_shared_multi_heap)
 	block = shared_multi_heap_alloc(SMH_REG_ATTR_NON_CACHEABLE, 0x10000);
 	zassert_is_null(block, "allocated buffer too big for the region");
 
+	/*
+	 * A smaller request is still served from the region that just failed
+	 * a bigger one, and freeing makes room for bigger ones again
+	 */
+	block = shared_multi_heap_alloc(SMH_REG_ATTR_NON_CACHEABLE, 0x100);
+	reg_map = get_region_map(block);
+
+	zassert_equal(reg_map->p_addr, RES1_NOCACHE_ADDR, "block in the wrong memory region");
+
+	shared_multi_heap_free(block);
+	block = shared_multi_heap_alloc(SMH_REG_ATTR_NON_CACHEABLE, 0x100);
+	reg_map = get_region_map(block);
+
+	zassert_equal(reg_map->p_addr, RES1_NOCACHE_ADDR, "block in the wrong memory region");
+
 	/* Request a 0-sized block */
 	block = shared_multi_heap_alloc(SMH_REG_ATTR_NON_CACHEABLE, 0);
 	zassert_is_null(block, "0 size accepted as valid");
@@ -423,8 +423,17 @@ static const struct smf_state test_states[] = {
 	[D] = SMF_CREATE_STATE(d_entry, NULL, NULL, NULL),
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+SMF_TABLE_DEFINE(test_table, test_states);
+#endif
+
 ZTEST(smf_tests, test_smf_hierarchical_5_ancestors)
 {
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	zassert_ok(smf_table_init(&test_table), "Failed to fill transition table");
+	smf_set_table(SMF_CTX(&test_obj), &test_table);
+#endif
+
 	test_obj.tv_idx = 0;
 	test_obj.transition_bits = 0;
 	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[A]);
@@ -371,8 +371,17 @@ static const struct smf_state test_states[] = {
 				     NULL, NULL),
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+SMF_TABLE_DEFINE(test_table, test_states);
+#endif
+
 ZTEST(smf_tests, test_smf_initial_transitions)
 {
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	zassert_ok(smf_table_init(&test_table), "Failed to fill transition table");
+	smf_set_table(SMF_CTX(&test_obj), &test_table);
+#endif
+
 	/* A) Test state transitions */
 
 	test_obj.transition_bits = 0;
@@ -1148,10 +1148,8 @@ static const struct {
 #endif
 };
 
-ZTEST(t_6lo, test_loop)
+static void setup_6lo(void)
 {
-	int count;
-
 	if (IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE)) {
 		k_thread_priority_set(k_current_get(),
 				K_PRIO_COOP(CONFIG_NUM_COOP_PRIORITIES - 1));
@@ -1165,6 +1163,13 @@ ZTEST(t_6lo, test_loop)
 	net_6lo_set_context(net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY)),
 			    &ctx2);
 #endif
+}
+
+ZTEST(t_6lo, test_loop)
+{
+	int count;
+
+	setup_6lo();
 
 	for (count = 0; count < ARRAY_SIZE(tests); count++) {
 		TC_PRINT("Starting %s\n", tests[count].name);
@@ -1174,5 +1179,29 @@ ZTEST(t_6lo, test_loop)
 	net_pkt_print();
 }
 
+/* Packets of the same flows in a row, compressed from the flow cache when
+ * CONFIG_NET_6LO_COMPRESS_CACHE is enabled.
+ */
+ZTEST(t_6lo, test_loop_repeat)
+{
+	int count;
+
+	setup_6lo();
+
+	for (count = 0; count < ARRAY_SIZE(tests); count++) {
+		TC_PRINT("Starting %s three times\n", tests[count].name);
+
+		for (int i = 0; i < 3; i++) {
+			test_6lo(tests[count].data);
+		}
+
+		/* And once more after the other flows */
+		if (count > 0) {
+			test_6lo(tests[count - 1].data);
+		}
+	}
+	net_pkt_print();
+}
+
 /*test case main entry*/
 ZTEST_SUITE(t_6lo, NULL, NULL, NULL, NULL, NULL);
@@ -550,6 +550,81 @@ ZTEST(net_context, test_net_ctx_recv_v4)
 	net_ctx_put();
 }
 
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+static struct net_pkt *quota_pkt;
+static int quota_recv_count;
+
+static void recv_cb_quota(struct net_context *context,
+			  struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr,
+			  union net_proto_header *proto_hdr,
+			  int status,
+			  void *user_data)
+{
+	/* Hold the first packet like an application that does not read */
+	if (quota_pkt == NULL) {
+		quota_pkt = pkt;
+	} else {
+		net_pkt_unref(pkt);
+	}
+
+	quota_recv_count++;
+	k_sem_give(&wait_data);
+}
+#endif /* CONFIG_NET_CONTEXT_RX_QUOTA */
+
+ZTEST(net_context, test_net_ctx_recv_v4_quota)
+{
+#if defined(CONFIG_NET_CONTEXT_RX_QUOTA)
+	int quota = 1;
+	int ret;
+
+	net_ctx_create();
+	net_ctx_setups_order_dependent();
+
+	/* A new context starts with nothing charged */
+	zassert_equal(atomic_get(&udp_v4_ctx->rx_quota_used), 0,
+		      "Stale RX quota usage");
+
+	ret = net_context_set_option(udp_v4_ctx, NET_OPT_RX_QUOTA,
+				     &quota, sizeof(quota));
+	zassert_equal(ret, 0, "Cannot set RX quota (%d)", ret);
+
+	ret = net_context_recv(udp_v4_ctx, recv_cb_quota, K_NO_WAIT,
+			       INT_TO_POINTER(AF_INET));
+	zassert_false((ret || cb_failure),
+		      "Context recv IPv4 UDP test failed");
+
+	quota_recv_count = 0;
+
+	net_ctx_sendto_v4();
+	k_sem_take(&wait_data, WAIT_TIME);
+	zassert_equal(quota_recv_count, 1, "No data received on time");
+
+	/* The held packet uses the whole quota */
+	net_ctx_sendto_v4();
+	k_sem_take(&wait_data, WAIT_TIME);
+	zassert_equal(quota_recv_count, 1, "Data over the quota received");
+
+	net_pkt_unref(quota_pkt);
+	quota_pkt = NULL;
+
+	net_ctx_sendto_v4();
+	k_sem_take(&wait_data, WAIT_TIME);
+	zassert_equal(quota_recv_count, 2, "No data received after release");
+
+	net_pkt_unref(quota_pkt);
+	quota_pkt = NULL;
+
+	zassert_equal(atomic_get(&udp_v4_ctx->rx_quota_used), 0,
+		      "RX quota not released");
+
+	net_ctx_put();
+#else
+	ztest_test_skip();
+#endif
+}
+
 static bool net_ctx_sendto_v6_wrong_src(void)
 {
 	int ret;
@@ -0,0 +1,263 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_gro_test, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <net_private.h>
+#include <ipv4.h>
+
+#define SEG_LEN 100
+#define ALLOC_TIMEOUT K_MSEC(500)
+#define WAIT_TIME K_MSEC(100)
+
+#define TCP_PSH 0x08
+#define TCP_ACK 0x10
+
+#define MY_PORT 5555
+#define PEER_PORT 4242
+
+/* 192.0.2.1 is ours, 192.0.2.2 is the peer */
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static int received_pkts;
+static int received_len;
+static bool data_ok;
+
+static uint8_t net_iface_dummy_data;
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_gro_test, "net_gro_test", NULL, NULL,
+		&net_iface_dummy_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+static enum net_verdict tcp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	uint32_t seq = sys_get_be32(proto_hdr->tcp->seq);
+	uint16_t len = net_pkt_get_len(pkt) - NET_IPV4H_LEN - NET_TCPH_LEN;
+	uint8_t byte;
+
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(user_data);
+
+	received_pkts++;
+	received_len += len;
+
+	/* The payload is the sequence number modulo 256 */
+	net_pkt_cursor_init(pkt);
+	net_pkt_skip(pkt, NET_IPV4H_LEN + NET_TCPH_LEN);
+
+	for (uint16_t i = 0; i < len; i++) {
+		if (net_pkt_read_u8(pkt, &byte) < 0 || byte != (uint8_t)(seq + i)) {
+			data_ok = false;
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static struct net_pkt *build_segment(uint32_t seq, uint8_t flags, bool corrupt)
+{
+	struct net_ipv4_hdr ip = {
+		.vhl = 0x45,
+		.len = htons(NET_IPV4H_LEN + NET_TCPH_LEN + SEG_LEN),
+		.ttl = 64,
+		.proto = IPPROTO_TCP,
+	};
+	struct net_tcp_hdr tcp = {
+		.src_port = htons(PEER_PORT),
+		.dst_port = htons(MY_PORT),
+		.offset = (NET_TCPH_LEN / 4) << 4,
+		.flags = flags,
+		.wnd = { 0x10, 0x00 },
+	};
+	struct net_tcp_hdr *hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, NET_IPV4H_LEN + NET_TCPH_LEN +
+					   SEG_LEN, AF_INET, IPPROTO_TCP,
+					   ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	memcpy(ip.src, &peer_addr, sizeof(ip.src));
+	memcpy(ip.dst, &my_addr, sizeof(ip.dst));
+	sys_put_be32(seq, tcp.seq);
+
+	zassert_ok(net_pkt_write(pkt, &ip, sizeof(ip)));
+	zassert_ok(net_pkt_write(pkt, &tcp, sizeof(tcp)));
+
+	for (uint16_t i = 0; i < SEG_LEN; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, seq + i));
+	}
+
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+	net_pkt_cursor_init(pkt);
+
+	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+	hdr = (struct net_tcp_hdr *)(pkt->buffer->data + NET_IPV4H_LEN);
+	hdr->chksum = net_calc_chksum_tcp(pkt);
+
+	if (corrupt) {
+		hdr->chksum ^= htons(0x0101);
+	}
+
+	return pkt;
+}
+
+/* Queue the segments together so that the RX thread sees them at once */
+static void receive_segments(const uint32_t *seqs, const uint8_t *flags,
+			     int count, int corrupt_idx)
+{
+	struct net_pkt *pkts[8];
+
+	zassert_true(count <= ARRAY_SIZE(pkts));
+
+	received_pkts = 0;
+	received_len = 0;
+	data_ok = true;
+
+	for (int i = 0; i < count; i++) {
+		pkts[i] = build_segment(seqs[i], flags != NULL ? flags[i] : TCP_ACK,
+					i == corrupt_idx);
+	}
+
+	k_sched_lock();
+
+	for (int i = 0; i < count; i++) {
+		zassert_ok(net_recv_data(iface, pkts[i]));
+	}
+
+	k_sched_unlock();
+
+	k_sleep(WAIT_TIME);
+
+	zassert_true(data_ok, "Wrong data received");
+}
+
+ZTEST(net_gro, test_merge_in_order)
+{
+	static const uint32_t seqs[] = { 1000, 1100, 1200, 1300 };
+
+	receive_segments(seqs, NULL, ARRAY_SIZE(seqs), -1);
+
+	zassert_equal(received_pkts, 1, "Segments were not merged (%d)",
+		      received_pkts);
+	zassert_equal(received_len, 4 * SEG_LEN, "Wrong length %d",
+		      received_len);
+}
+
+ZTEST(net_gro, test_max_segments)
+{
+	static const uint32_t seqs[] = { 0, 100, 200, 300, 400, 500 };
+
+	receive_segments(seqs, NULL, ARRAY_SIZE(seqs), -1);
+
+	zassert_equal(received_pkts, 2, "Wrong number of packets %d",
+		      received_pkts);
+	zassert_equal(received_len, 6 * SEG_LEN, "Wrong length %d",
+		      received_len);
+}
+
+ZTEST(net_gro, test_no_merge_out_of_order)
+{
+	static const uint32_t seqs[] = { 5000, 5200, 5300 };
+
+	receive_segments(seqs, NULL, ARRAY_SIZE(seqs), -1);
+
+	zassert_equal(received_pkts, 2, "Wrong number of packets %d",
+		      received_pkts);
+	zassert_equal(received_len, 3 * SEG_LEN, "Wrong length %d",
+		      received_len);
+}
+
+ZTEST(net_gro, test_no_merge_after_push)
+{
+	static const uint32_t seqs[] = { 7000, 7100, 7200 };
+	static const uint8_t flags[] = { TCP_ACK, TCP_ACK | TCP_PSH, TCP_ACK };
+
+	receive_segments(seqs, flags, ARRAY_SIZE(seqs), -1);
+
+	/* The push segment is merged but ends the run */
+	zassert_equal(received_pkts, 2, "Wrong number of packets %d",
+		      received_pkts);
+	zassert_equal(received_len, 3 * SEG_LEN, "Wrong length %d",
+		      received_len);
+}
+
+ZTEST(net_gro, test_bad_checksum)
+{
+	static const uint32_t seqs[] = { 9000, 9100, 9200 };
+
+	/* A corrupted segment must not be hidden by the merge */
+	receive_segments(seqs, NULL, ARRAY_SIZE(seqs), 1);
+
+	zassert_equal(received_pkts, 0, "Corrupted data delivered");
+}
+
+static void *test_setup(void)
+{
+	static struct net_conn_handle *handle;
+	struct sockaddr remote = { 0 };
+	struct sockaddr local = { 0 };
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No interface");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0),
+			 "Cannot add address");
+
+	net_ipaddr_copy(&net_sin(&local)->sin_addr, &my_addr);
+	local.sa_family = AF_INET;
+	net_ipaddr_copy(&net_sin(&remote)->sin_addr, &peer_addr);
+	remote.sa_family = AF_INET;
+
+	ret = net_conn_register(IPPROTO_TCP, AF_INET, &remote, &local,
+				PEER_PORT, MY_PORT, NULL, tcp_data_received,
+				NULL, &handle);
+	zassert_ok(ret, "Cannot register TCP connection (%d)", ret);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_gro, NULL, test_setup, NULL, NULL, NULL);
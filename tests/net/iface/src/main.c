@@ -1332,4 +1332,53 @@ ZTEST(net_iface, test_interface_name)
 #endif
 }
 
+ZTEST(net_iface, test_recv_data_list)
+{
+	static uint8_t data[] = { 't', 'e', 's', 't', '\0' };
+	struct net_pkt *pkt;
+	sys_slist_t pkts;
+	int ret, i;
+
+	sys_slist_init(&pkts);
+
+	ret = net_recv_data_list(NULL, &pkts);
+	zassert_equal(ret, -EINVAL, "Unexpected value (%d) returned", ret);
+
+	/* Packets without data are handed back to the caller */
+	for (i = 0; i < 3; i++) {
+		pkt = net_pkt_alloc_on_iface(iface1, K_NO_WAIT);
+		zassert_not_null(pkt, "Cannot allocate pkt");
+		sys_slist_append(&pkts, (sys_snode_t *)pkt);
+	}
+
+	ret = net_recv_data_list(iface1, &pkts);
+	zassert_equal(ret, -ENODATA, "Unexpected value (%d) returned", ret);
+	zassert_equal(sys_slist_len(&pkts), 3, "Rejected packets not returned");
+
+	while ((pkt = (struct net_pkt *)sys_slist_get(&pkts)) != NULL) {
+		net_pkt_unref(pkt);
+	}
+
+	/* So are packets received on an interface that is down */
+	for (i = 0; i < 3; i++) {
+		pkt = net_pkt_alloc_with_buffer(iface1, sizeof(data),
+						AF_UNSPEC, 0, K_NO_WAIT);
+		zassert_not_null(pkt, "Cannot allocate pkt");
+		net_pkt_write(pkt, data, sizeof(data));
+		sys_slist_append(&pkts, (sys_snode_t *)pkt);
+	}
+
+	net_if_down(iface1);
+
+	ret = net_recv_data_list(iface1, &pkts);
+	zassert_equal(ret, -ENETDOWN, "Unexpected value (%d) returned", ret);
+	zassert_equal(sys_slist_len(&pkts), 3, "Rejected packets not returned");
+
+	net_if_up(iface1);
+
+	while ((pkt = (struct net_pkt *)sys_slist_get(&pkts)) != NULL) {
+		net_pkt_unref(pkt);
+	}
+}
+
 ZTEST_SUITE(net_iface, NULL, iface_setup, NULL, NULL, iface_teardown);
@@ -802,6 +802,91 @@ ZTEST(net_ipv4_fragment, test_fragment_timeout)
 		      "Packet size mismatch");
 }
 
+/* Callback function for collecting the IDs of the pending reassemblies */
+static void reassembly_id_cb(struct net_ipv4_reassembly *reassembly, void *data)
+{
+	uint16_t *id = (uint16_t *)data;
+
+	*id = reassembly->id;
+}
+
+/* Hand a zero filled fragment directly to the reassembly */
+static enum net_verdict recv_fragment(uint16_t id, uint16_t offset, bool more, uint16_t len)
+{
+	struct net_ipv4_hdr hdr = {
+		.vhl = 0x45,
+		.ttl = 64,
+		.proto = IPPROTO_UDP,
+	};
+	uint16_t flags = offset / 8;
+	struct net_pkt *pkt;
+
+	if (more) {
+		flags |= NET_IPV4_MORE_FRAG_MASK;
+	}
+
+	pkt = net_pkt_alloc_with_buffer(iface1, NET_IPV4H_LEN + len, AF_INET,
+					IPPROTO_UDP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Packet creation failure");
+
+	hdr.len = htons(NET_IPV4H_LEN + len);
+	UNALIGNED_PUT(htons(id), (uint16_t *)&hdr.id);
+	UNALIGNED_PUT(htons(flags), (uint16_t *)&hdr.offset);
+	net_ipv4_addr_copy_raw(hdr.src, (uint8_t *)&my_addr2);
+	net_ipv4_addr_copy_raw(hdr.dst, (uint8_t *)&my_addr1);
+
+	zassert_ok(net_pkt_write(pkt, &hdr, sizeof(hdr)));
+	zassert_ok(net_pkt_memset(pkt, 0, len));
+
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+	net_pkt_cursor_init(pkt);
+
+	return net_ipv4_handle_fragment_hdr(pkt, NET_IPV4_HDR(pkt));
+}
+
+/* Test eviction of the oldest reassembly and dropping of overlapping fragments */
+ZTEST(net_ipv4_fragment, test_fragment_evict_overlap)
+{
+	uint8_t packets;
+	uint16_t id;
+	int i;
+
+	/* One more datagram than there are reassembly slots */
+	for (i = 0; i <= CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		zassert_equal(recv_fragment(0x100 + i, 0, true, 16), NET_OK,
+			      "Fragment %d not accepted", i);
+	}
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT,
+		      "Expected all reassembly slots to be in use");
+
+	/* The newest datagram took the slot of the oldest one */
+	id = 0;
+	net_ipv4_frag_foreach(reassembly_id_cb, &id);
+	zassert_not_equal(id, 0x100, "Expected oldest reassembly to be evicted");
+
+	/* A fragment overlapping the stored one cancels its reassembly */
+	id = 0x100 + CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT;
+	zassert_equal(recv_fragment(id, 8, true, 16), NET_OK, "Overlap not consumed");
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT - 1,
+		      "Expected overlapping reassembly to be dropped");
+
+	/* Clean up the remaining reassemblies */
+	for (i = 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		zassert_equal(recv_fragment(0x100 + i, 8, true, 16), NET_OK,
+			      "Overlap not consumed");
+	}
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, 0, "Expected no pending reassemblies");
+}
+
 /* Test inserting large packet with do not fragment bit set */
 ZTEST(net_ipv4_fragment, test_do_not_fragment)
 {
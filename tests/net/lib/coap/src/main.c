@@ -1044,6 +1044,75 @@ ZTEST(coap, test_handle_invalid_coap_req)
 	zassert_equal(r, -ENOTSUP, "Request handling should fail with -ENOTSUP");
 }
 
+static int path_resource_get(struct coap_resource *resource,
+			     struct coap_packet *request,
+			     struct sockaddr *addr, socklen_t addr_len)
+{
+	resource->age++;
+
+	return 0;
+}
+
+ZTEST(coap, test_handle_request_path)
+{
+	static const char * const path_ab_c[] = { "ab", "c", NULL };
+	static const char * const path_a_bc[] = { "a", "bc", NULL };
+	static const char * const path_wildcard[] = { "a", "+", NULL };
+	struct coap_resource resources[] = {
+		{ .path = path_ab_c, .get = path_resource_get },
+		{ .path = path_a_bc, .get = path_resource_get },
+		{ .path = path_wildcard, .get = path_resource_get },
+		{ },
+	};
+	static const char * const requests[][3] = {
+		{ "ab", "c", NULL },
+		{ "a", "bc", NULL },
+		{ "a", "b", NULL },
+	};
+	struct coap_option options[4] = {};
+	uint8_t *data = data_buf[0];
+	struct coap_packet req;
+	int r;
+
+	for (int i = 0; i < ARRAY_SIZE(requests); i++) {
+		r = coap_packet_init(&req, data, COAP_BUF_SIZE, COAP_VERSION_1,
+				     COAP_TYPE_CON, 0, NULL, COAP_METHOD_GET, coap_next_id());
+		zassert_equal(r, 0, "Unable to init req");
+
+		for (const char * const *p = requests[i]; *p; p++) {
+			r = coap_packet_append_option(&req, COAP_OPTION_URI_PATH, *p, strlen(*p));
+			zassert_equal(r, 0, "Unable to append option");
+		}
+
+		r = coap_packet_parse(&req, data, req.offset, options, ARRAY_SIZE(options));
+		zassert_equal(r, 0, "Could not parse req packet");
+
+		/* Twice, with the hash of the path of the resources known */
+		for (int j = 0; j < 2; j++) {
+			r = coap_handle_request(&req, resources, options, ARRAY_SIZE(options),
+						(struct sockaddr *)&dummy_addr,
+						sizeof(dummy_addr));
+			zassert_equal(r, 0, "Could not handle packet");
+		}
+
+		zassert_equal(resources[i].age, 2, "Request %d handled by the wrong resource", i);
+	}
+
+	r = coap_packet_init(&req, data, COAP_BUF_SIZE, COAP_VERSION_1,
+			     COAP_TYPE_CON, 0, NULL, COAP_METHOD_GET, coap_next_id());
+	zassert_equal(r, 0, "Unable to init req");
+
+	r = coap_packet_append_option(&req, COAP_OPTION_URI_PATH, "abc", strlen("abc"));
+	zassert_equal(r, 0, "Unable to append option");
+
+	r = coap_packet_parse(&req, data, req.offset, options, ARRAY_SIZE(options));
+	zassert_equal(r, 0, "Could not parse req packet");
+
+	r = coap_handle_request(&req, resources, options, ARRAY_SIZE(options),
+				(struct sockaddr *)&dummy_addr, sizeof(dummy_addr));
+	zassert_equal(r, -ENOENT, "There should be no handler for this resource");
+}
+
 ZTEST(coap, test_build_options_out_of_order_0)
 {
 	uint8_t result[] = {0x45, 0x02, 0x12, 0x34, 't', 'o', 'k',  'e', 'n', 0xC0, 0xB1, 0x19,
@@ -269,6 +269,34 @@ static ssize_t z_impl_zsock_recvfrom_custom_fake_unmatching(int sock, void *buf,
 	return sizeof(ack_data);
 }
 
+static ssize_t z_impl_zsock_recvfrom_custom_fake_block2(int sock, void *buf, size_t max_len,
+							int flags, struct sockaddr *src_addr,
+							socklen_t *addrlen)
+{
+	uint16_t last_message_id = 0;
+
+	/* Block 3 of 64 bytes, more blocks follow */
+	static uint8_t ack_data[] = {
+		0x68, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xd1, 0x0a, 0x3a, 0xff, 'b', 'l', 'k'
+	};
+
+	if (messages_needing_response[0] != 0) {
+		last_message_id = messages_needing_response[0];
+		messages_needing_response[0] = 0;
+	} else {
+		last_message_id = messages_needing_response[1];
+		messages_needing_response[1] = 0;
+	}
+
+	ack_data[2] = (uint8_t) (last_message_id >> 8);
+	ack_data[3] = (uint8_t) last_message_id;
+
+	memcpy(buf, ack_data, sizeof(ack_data));
+
+	return sizeof(ack_data);
+}
+
 static ssize_t z_impl_zsock_recvfrom_custom_fake_echo(int sock, void *buf, size_t max_len,
 						      int flags, struct sockaddr *src_addr,
 						      socklen_t *addrlen)
@@ -356,6 +384,18 @@ void coap_callback(int16_t code, size_t offset, const uint8_t *payload, size_t l
 	last_response_code = code;
 }
 
+static size_t last_offset;
+static bool last_block_seen;
+
+static void coap_callback_block(int16_t code, size_t offset, const uint8_t *payload, size_t len,
+				bool last_block, void *user_data)
+{
+	LOG_INF("CoAP block response callback, %d", code);
+	last_response_code = code;
+	last_offset = offset;
+	last_block_seen = last_block;
+}
+
 ZTEST_SUITE(coap_client, NULL, suite_setup, test_setup, NULL, NULL);
 
 ZTEST(coap_client, test_get_request)
@@ -687,3 +727,47 @@ ZTEST(coap_client, test_unmatching_tokens)
 	k_sleep(K_MSEC(500));
 	zassert_equal(last_response_code, -ETIMEDOUT, "Unexpected response");
 }
+
+ZTEST(coap_client, test_get_single_block)
+{
+	int ret = 0;
+	struct sockaddr address = {0};
+	struct coap_client_option block2 = {
+		.code = COAP_OPTION_BLOCK2,
+		.len = 1,
+		/* Block 3 of 64 bytes */
+		.value = { 0x32 },
+	};
+	struct coap_client_request client_request = {
+		.method = COAP_METHOD_GET,
+		.confirmable = true,
+		.path = test_path,
+		.fmt = COAP_CONTENT_FORMAT_TEXT_PLAIN,
+		.cb = coap_callback_block,
+		.options = &block2,
+		.num_options = 1,
+		.payload = NULL,
+		.len = 0
+	};
+
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_custom_fake_block2;
+	last_offset = 0;
+	last_block_seen = true;
+
+	k_sleep(K_MSEC(1));
+
+	LOG_INF("Send request");
+	ret = coap_client_req(&client, 0, &address, &client_request, NULL);
+	zassert_true(ret >= 0, "Sending request failed, %d", ret);
+	set_socket_events(ZSOCK_POLLIN);
+
+	k_sleep(K_MSEC(5));
+	k_sleep(K_MSEC(100));
+	clear_socket_events();
+
+	zassert_equal(last_response_code, COAP_RESPONSE_CODE_CONTENT, "Unexpected response");
+	zassert_equal(last_offset, 3 * 64, "Unexpected offset %zu", last_offset);
+	zassert_false(last_block_seen, "The resource has more blocks");
+	/* The following blocks are not requested */
+	zassert_equal(z_impl_zsock_sendto_fake.call_count, 1);
+}
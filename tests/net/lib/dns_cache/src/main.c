@@ -133,3 +133,60 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_many_queries)
+{
+	struct dns_addrinfo info_write = {0};
+	struct dns_addrinfo info_read = {0};
+	char query[16];
+
+	for (int i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host%d.com", i);
+		info_write.ai_addrlen = i;
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL));
+	}
+
+	for (int i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host%d.com", i);
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+		zassert_equal(i, info_read.ai_addrlen);
+	}
+
+	zassert_ok(dns_cache_remove(&test_dns_cache, "host3.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "host3.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "host4.com", &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					  DNS_EAI_NODATA, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(DNS_EAI_NODATA,
+		      dns_cache_find_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA));
+	zassert_equal(0, dns_cache_find_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1),
+		      "Negative entry returned as an address");
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA));
+}
+
+ZTEST(net_dns_cache_test, test_prefetch_popular_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, 10));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+	zassert_false(dns_cache_prefetch_due(&test_dns_cache, query), "Refreshed too early");
+
+	k_sleep(K_MSEC(9500));
+	zassert_true(dns_cache_prefetch_due(&test_dns_cache, query), "Not refreshed");
+	zassert_false(dns_cache_prefetch_due(&test_dns_cache, query), "Refreshed twice");
+}
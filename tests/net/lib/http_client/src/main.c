@@ -0,0 +1,273 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/client.h>
+
+#define TEST_REQUESTS 3
+#define TEST_TIMEOUT_MS 1000
+/* Long enough for the client to read each chunk on its own */
+#define TEST_CHUNK_DELAY_MS 50
+
+#define RSP1 "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nfirst"
+#define RSP2 "HTTP/1.1 404 Not Found\r\nContent-Length: 6\r\n\r\nsecond"
+#define RSP3 "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nthird"
+
+struct test_response {
+	uint16_t status;
+	char body[16];
+	size_t body_len;
+};
+
+static int sock[2];
+static int connects;
+static struct http_client_session session;
+
+static uint8_t recv_buf[256];
+static struct test_response responses[TEST_REQUESTS + 1];
+static int responses_done;
+
+/* What the server received before answering */
+static char server_buf[512];
+
+static const char *const *server_chunks;
+static size_t server_chunk_count;
+static int server_requests;
+
+static K_THREAD_STACK_DEFINE(server_stack, 1024);
+static struct k_thread server_thread;
+
+static int test_connect(void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	connects++;
+
+	return sock[0];
+}
+
+static void test_response_cb(struct http_response *rsp,
+			     enum http_final_call final_data, void *user_data)
+{
+	struct test_response *r = &responses[responses_done];
+
+	ARG_UNUSED(user_data);
+
+	zassert_true(responses_done < ARRAY_SIZE(responses), "Too many responses");
+
+	if (rsp->body_frag_start != NULL) {
+		zassert_true(r->body_len + rsp->body_frag_len <= sizeof(r->body),
+			     "Body too long");
+		memcpy(r->body + r->body_len, rsp->body_frag_start,
+		       rsp->body_frag_len);
+		r->body_len += rsp->body_frag_len;
+	}
+
+	if (final_data == HTTP_DATA_FINAL) {
+		r->status = rsp->http_status_code;
+		responses_done++;
+	}
+}
+
+static int server_requests_received(void)
+{
+	const char *end = server_buf;
+	int count = 0;
+
+	while ((end = strstr(end, "\r\n\r\n")) != NULL) {
+		end += sizeof("\r\n\r\n") - 1;
+		count++;
+	}
+
+	return count;
+}
+
+/* Answer only once all the requests are received, with the given chunks */
+static void server_fn(void *p1, void *p2, void *p3)
+{
+	size_t len = 0;
+	ssize_t ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	memset(server_buf, 0, sizeof(server_buf));
+
+	while (server_requests_received() < server_requests) {
+		ret = zsock_recv(sock[1], server_buf + len,
+				 sizeof(server_buf) - len - 1, 0);
+		if (ret <= 0) {
+			return;
+		}
+
+		len += ret;
+	}
+
+	for (size_t i = 0; i < server_chunk_count; i++) {
+		if (i > 0) {
+			k_msleep(TEST_CHUNK_DELAY_MS);
+		}
+
+		(void)zsock_send(sock[1], server_chunks[i],
+				 strlen(server_chunks[i]), 0);
+	}
+}
+
+static void server_start(const char *const *chunks, size_t count, int requests)
+{
+	server_chunks = chunks;
+	server_chunk_count = count;
+	server_requests = requests;
+
+	k_thread_create(&server_thread, server_stack,
+			K_THREAD_STACK_SIZEOF(server_stack), server_fn,
+			NULL, NULL, NULL, CONFIG_ZTEST_THREAD_PRIORITY, 0,
+			K_NO_WAIT);
+}
+
+static void server_stop(void)
+{
+	zassert_ok(k_thread_join(&server_thread, K_SECONDS(1)),
+		   "Server did not finish");
+}
+
+static void request_init(struct http_request *req, const char *url)
+{
+	memset(req, 0, sizeof(*req));
+
+	req->method = HTTP_GET;
+	req->url = url;
+	req->host = "localhost";
+	req->protocol = "HTTP/1.1";
+	req->response = test_response_cb;
+	req->recv_buf = recv_buf;
+	req->recv_buf_len = sizeof(recv_buf);
+}
+
+static void pipeline(void)
+{
+	static const char *const urls[TEST_REQUESTS] = { "/1", "/2", "/3" };
+	struct http_request reqs[TEST_REQUESTS];
+	struct http_request *req_list[TEST_REQUESTS];
+	int ret;
+
+	for (int i = 0; i < TEST_REQUESTS; i++) {
+		request_init(&reqs[i], urls[i]);
+		req_list[i] = &reqs[i];
+	}
+
+	ret = http_client_session_pipeline(&session, req_list, TEST_REQUESTS,
+					   TEST_TIMEOUT_MS, NULL);
+	zassert_true(ret > 0, "Pipeline failed (%d)", ret);
+
+	server_stop();
+
+	/* All the requests were sent before the first response */
+	zassert_not_null(strstr(server_buf, "GET /1 "), "Request 1 not sent");
+	zassert_true(strstr(server_buf, "GET /1 ") < strstr(server_buf, "GET /2 "),
+		     "Request 2 not sent after request 1");
+	zassert_true(strstr(server_buf, "GET /2 ") < strstr(server_buf, "GET /3 "),
+		     "Request 3 not sent after request 2");
+}
+
+static void check_response(int i, uint16_t status, const char *body)
+{
+	zassert_equal(responses[i].status, status, "Response %d status %u", i,
+		      responses[i].status);
+	zassert_equal(responses[i].body_len, strlen(body), "Response %d length", i);
+	zassert_mem_equal(responses[i].body, body, strlen(body),
+			  "Response %d body", i);
+}
+
+static void check_responses(void)
+{
+	zassert_equal(responses_done, TEST_REQUESTS, "%d responses",
+		      responses_done);
+	check_response(0, 200, "first");
+	check_response(1, 404, "second");
+	check_response(2, 200, "third");
+}
+
+ZTEST(http_client, test_pipeline_split)
+{
+	/* Each response ends within a chunk, and the next one starts there */
+	static const char *const chunks[] = {
+		"HTTP/1.1 200 OK\r\nConte",
+		"nt-Length: 5\r\n\r\nfir",
+		"st" "HTTP/1.1 404 Not Fo",
+		"und\r\nContent-Length: 6\r\n\r\nsec",
+		"ond" RSP3,
+	};
+
+	server_start(chunks, ARRAY_SIZE(chunks), TEST_REQUESTS);
+	pipeline();
+	check_responses();
+
+	/* The connection is kept alive */
+	zassert_equal(connects, 1, "%d connections", connects);
+	zassert_equal(session.sock, sock[0], "Connection closed");
+}
+
+ZTEST(http_client, test_pipeline_one_segment)
+{
+	static const char *const chunks[] = { RSP1 RSP2 RSP3 };
+	static const char *const closing[] = {
+		"HTTP/1.1 200 OK\r\nConnection: close\r\n"
+		"Content-Length: 4\r\n\r\nlast",
+	};
+	struct http_request req;
+	int ret;
+
+	server_start(chunks, ARRAY_SIZE(chunks), TEST_REQUESTS);
+	pipeline();
+	check_responses();
+
+	/* The next request reuses the connection, which the server then closes */
+	server_start(closing, ARRAY_SIZE(closing), 1);
+
+	request_init(&req, "/4");
+	ret = http_client_session_req(&session, &req, TEST_TIMEOUT_MS, NULL);
+	zassert_true(ret > 0, "Request failed (%d)", ret);
+
+	server_stop();
+
+	zassert_not_null(strstr(server_buf, "GET /4 "), "Request 4 not sent");
+	zassert_equal(responses_done, TEST_REQUESTS + 1, "%d responses",
+		      responses_done);
+	check_response(TEST_REQUESTS, 200, "last");
+
+	zassert_equal(connects, 1, "%d connections", connects);
+	zassert_equal(session.sock, -1, "Connection not closed");
+}
+
+static void test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sock),
+		   "socketpair failed");
+
+	http_client_session_init(&session, test_connect, NULL);
+	connects = 0;
+	responses_done = 0;
+	memset(responses, 0, sizeof(responses));
+}
+
+static void test_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* The session owns sock[0] from its first connection */
+	http_client_session_close(&session);
+	(void)zsock_close(sock[1]);
+}
+
+ZTEST_SUITE(http_client, NULL, NULL, test_before, test_after, NULL);
@@ -0,0 +1,283 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+
+#define STATIC_DATA "<html>static</html>"
+
+static uint16_t test_http_service_port;
+HTTP_SERVICE_DEFINE(test_http_service, "127.0.0.1", &test_http_service_port, 2, 2, NULL);
+
+static const uint8_t static_data[] = STATIC_DATA;
+
+static struct http_resource_detail_static static_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET) | BIT(HTTP_HEAD),
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.content_type = "text/html",
+	},
+	.static_data = static_data,
+	.static_data_len = sizeof(static_data) - 1,
+};
+
+HTTP_RESOURCE_DEFINE(static_resource, test_http_service, "/static", &static_detail);
+
+static uint8_t echo_buf[16];
+static size_t echo_len;
+static bool echo_aborted;
+
+/* Answer with the request body, in chunks of up to four bytes */
+static int echo_cb(struct http_client_ctx *client, enum http_data_status status,
+		   const uint8_t *data, size_t len, void *user_data)
+{
+	static size_t echo_sent;
+	size_t chunk;
+
+	switch (status) {
+	case HTTP_SERVER_DATA_MORE:
+		len = MIN(len, sizeof(echo_buf) - echo_len);
+		memcpy(&echo_buf[echo_len], data, len);
+		echo_len += len;
+		return 0;
+	case HTTP_SERVER_DATA_FINAL:
+		chunk = MIN(echo_len - echo_sent, 4);
+		memcpy(user_data, &echo_buf[echo_sent], chunk);
+		echo_sent += chunk;
+		if (chunk == 0) {
+			echo_len = 0;
+			echo_sent = 0;
+		}
+		return chunk;
+	default:
+		echo_aborted = true;
+		echo_len = 0;
+		echo_sent = 0;
+		return 0;
+	}
+}
+
+static uint8_t dynamic_buf[4];
+
+static struct http_resource_detail_dynamic dynamic_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_POST),
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+	},
+	.cb = echo_cb,
+	.data_buffer = dynamic_buf,
+	.data_buffer_len = sizeof(dynamic_buf),
+	.user_data = dynamic_buf,
+};
+
+HTTP_RESOURCE_DEFINE(dynamic_resource, test_http_service, "/echo", &dynamic_detail);
+
+#define STATIC_RESPONSE                                                                            \
+	"HTTP/1.1 200 OK\r\n"                                                                      \
+	"Content-Type: text/html\r\n"                                                              \
+	"Content-Length: 19\r\n"                                                                   \
+	"\r\n" STATIC_DATA
+
+static int client_fd = -1;
+
+static int client_connect(void)
+{
+	struct timeval timeo = {
+		.tv_sec = 2,
+	};
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(test_http_service_port),
+	};
+	int fd;
+
+	zassert_equal(zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr), 1);
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "socket failed (%d)", errno);
+	zassert_ok(zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo)));
+	zassert_ok(zsock_connect(fd, (struct sockaddr *)&addr, sizeof(addr)),
+		   "connect failed (%d)", errno);
+
+	return fd;
+}
+
+static void client_send(int fd, const char *request)
+{
+	zassert_equal(zsock_send(fd, request, strlen(request), 0), strlen(request));
+}
+
+/* Receive exactly the expected response */
+static void client_expect(int fd, const char *response)
+{
+	static char buf[256];
+	size_t expected = strlen(response);
+	size_t offset = 0;
+	ssize_t ret;
+
+	zassert_true(expected < sizeof(buf));
+
+	while (offset < expected) {
+		ret = zsock_recv(fd, &buf[offset], expected - offset, 0);
+		zassert_true(ret > 0, "recv failed (%d, %d)", (int)ret, errno);
+		offset += ret;
+	}
+
+	buf[offset] = '\0';
+	zassert_mem_equal(buf, response, expected, "Unexpected response:\n%s", buf);
+}
+
+static void client_expect_close(int fd)
+{
+	char c;
+
+	zassert_equal(zsock_recv(fd, &c, 1, 0), 0, "Connection not closed");
+}
+
+ZTEST(http_server_core, test_keep_alive)
+{
+	client_fd = client_connect();
+
+	client_send(client_fd, "GET /static HTTP/1.1\r\nHost: test\r\n\r\n");
+	client_expect(client_fd, STATIC_RESPONSE);
+
+	client_send(client_fd, "GET /static?query HTTP/1.1\r\nHost: test\r\n\r\n");
+	client_expect(client_fd, STATIC_RESPONSE);
+}
+
+ZTEST(http_server_core, test_pipelining)
+{
+	client_fd = client_connect();
+
+	/* The requests span several receive buffers of the server */
+	client_send(client_fd, "GET /static HTTP/1.1\r\nHost: test\r\n\r\n"
+			       "HEAD /static HTTP/1.1\r\nHost: test\r\n\r\n"
+			       "GET /missing HTTP/1.1\r\nHost: test\r\n\r\n");
+
+	client_expect(client_fd, STATIC_RESPONSE
+		      "HTTP/1.1 200 OK\r\n"
+		      "Content-Type: text/html\r\n"
+		      "Content-Length: 19\r\n"
+		      "\r\n"
+		      "HTTP/1.1 404 Not Found\r\n"
+		      "Content-Length: 0\r\n"
+		      "\r\n");
+}
+
+ZTEST(http_server_core, test_errors)
+{
+	client_fd = client_connect();
+
+	client_send(client_fd, "POST /static HTTP/1.1\r\nHost: test\r\nContent-Length: 1\r\n\r\nx");
+	client_expect(client_fd, "HTTP/1.1 405 Method Not Allowed\r\n"
+				 "Content-Length: 0\r\n"
+				 "\r\n");
+
+	client_send(client_fd, "GET /a/very/long/path/over/the/url/limit HTTP/1.1\r\n\r\n");
+	client_expect(client_fd, "HTTP/1.1 414 URI Too Long\r\n"
+				 "Content-Length: 0\r\n"
+				 "\r\n");
+
+	client_send(client_fd, "NOT HTTP\r\n\r\n");
+	client_expect(client_fd, "HTTP/1.1 400 Bad Request\r\n"
+				 "Content-Length: 0\r\n"
+				 "Connection: close\r\n"
+				 "\r\n");
+	client_expect_close(client_fd);
+}
+
+ZTEST(http_server_core, test_connection_close)
+{
+	client_fd = client_connect();
+
+	/* The request after the one closing the connection is ignored */
+	client_send(client_fd, "GET /static HTTP/1.1\r\nConnection: close\r\n\r\n"
+			       "GET /static HTTP/1.1\r\n\r\n");
+	client_expect(client_fd, "HTTP/1.1 200 OK\r\n"
+				 "Content-Type: text/html\r\n"
+				 "Content-Length: 19\r\n"
+				 "Connection: close\r\n"
+				 "\r\n" STATIC_DATA);
+	client_expect_close(client_fd);
+
+	client_fd = client_connect();
+
+	/* HTTP/1.0 connections are not kept alive by default */
+	client_send(client_fd, "GET /static HTTP/1.0\r\n\r\n");
+	client_expect(client_fd, "HTTP/1.1 200 OK\r\n"
+				 "Content-Type: text/html\r\n"
+				 "Content-Length: 19\r\n"
+				 "Connection: close\r\n"
+				 "\r\n" STATIC_DATA);
+	client_expect_close(client_fd);
+}
+
+ZTEST(http_server_core, test_dynamic_chunked)
+{
+	client_fd = client_connect();
+
+	client_send(client_fd, "POST /echo HTTP/1.1\r\n"
+			       "Transfer-Encoding: chunked\r\n"
+			       "\r\n"
+			       "5\r\nhello\r\n"
+			       "6\r\n world\r\n"
+			       "0\r\n\r\n");
+	client_expect(client_fd, "HTTP/1.1 200 OK\r\n"
+				 "Transfer-Encoding: chunked\r\n"
+				 "\r\n"
+				 "4\r\nhell\r\n"
+				 "4\r\no wo\r\n"
+				 "3\r\nrld\r\n"
+				 "0\r\n\r\n");
+
+	/* A request cut by the client is aborted */
+	echo_aborted = false;
+	client_send(client_fd, "POST /echo HTTP/1.1\r\nContent-Length: 10\r\n\r\nabc");
+	client_expect(client_fd, "HTTP/1.1 200 OK\r\n"
+				 "Transfer-Encoding: chunked\r\n"
+				 "\r\n");
+	zassert_ok(zsock_close(client_fd));
+	client_fd = -1;
+
+	for (int i = 0; i < 100 && !echo_aborted; i++) {
+		k_msleep(10);
+	}
+
+	zassert_true(echo_aborted, "Request not aborted");
+}
+
+static void *http_server_core_setup(void)
+{
+	zassert_ok(http_server_start());
+	zassert_not_equal(test_http_service_port, 0, "No ephemeral port");
+	zassert_equal(http_server_start(), -EALREADY);
+
+	return NULL;
+}
+
+static void http_server_core_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	if (client_fd >= 0) {
+		(void)zsock_close(client_fd);
+		client_fd = -1;
+	}
+}
+
+static void http_server_core_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(http_server_stop());
+	zassert_equal(http_server_stop(), -EALREADY);
+}
+
+ZTEST_SUITE(http_server_core, NULL, http_server_core_setup, NULL, http_server_core_after,
+	    http_server_core_teardown);
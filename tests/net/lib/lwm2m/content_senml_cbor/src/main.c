@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
+#include <zcbor_decode.h>
 
 #include "lwm2m_util.h"
 #include "lwm2m_rw_senml_cbor.h"
@@ -149,6 +150,19 @@ static void test_payload_set(struct test_payload_buffer payload)
 	test_msg.in.offset = 1;
 }
 
+/* The streaming encoder writes the same records within an array of
+ * indefinite length instead of an array of one.
+ */
+static void test_payload_expected(struct test_payload_buffer *payload)
+{
+	if (!IS_ENABLED(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)) {
+		return;
+	}
+
+	payload->data[0] = (0x04 << 5) | 31;
+	payload->data[payload->len++] = 0xff;
+}
+
 static void test_prepare(void *dummy)
 {
 	ARG_UNUSED(dummy);
@@ -233,6 +247,8 @@ ZTEST(net_content_senml_cbor, test_put_s8)
 	for (i = 0; i < ARRAY_SIZE(expected_payload); i++) {
 		test_s8 = value[i];
 
+		test_payload_expected(&expected_payload[i]);
+
 		ret = do_read_op_senml_cbor(&test_msg);
 		zassert_true(ret >= 0, "Error reported");
 
@@ -321,6 +337,8 @@ ZTEST(net_content_senml_cbor, test_put_s16)
 	for (i = 0; i < ARRAY_SIZE(expected_payload); i++) {
 		test_s16 = value[i];
 
+		test_payload_expected(&expected_payload[i]);
+
 		ret = do_read_op_senml_cbor(&test_msg);
 		zassert_true(ret >= 0, "Error reported");
 
@@ -409,6 +427,8 @@ ZTEST(net_content_senml_cbor, test_put_s32)
 	for (i = 0; i < ARRAY_SIZE(expected_payload); i++) {
 		test_s32 = value[i];
 
+		test_payload_expected(&expected_payload[i]);
+
 		ret = do_read_op_senml_cbor(&test_msg);
 		zassert_true(ret >= 0, "Error reported");
 
@@ -497,6 +517,8 @@ ZTEST(net_content_senml_cbor, test_put_s64)
 	for (i = 0; i < ARRAY_SIZE(expected_payload); i++) {
 		test_s64 = value[i];
 
+		test_payload_expected(&expected_payload[i]);
+
 		ret = do_read_op_senml_cbor(&test_msg);
 		zassert_true(ret >= 0, "Error reported");
 
@@ -546,6 +568,8 @@ ZTEST(net_content_senml_cbor, test_put_string)
 	strcpy(test_string, "test_string");
 	test_msg.path.res_id = TEST_RES_STRING;
 
+	test_payload_expected(&expected_payload);
+
 	ret = do_read_op_senml_cbor(&test_msg);
 	zassert_true(ret >= 0, "Error reported");
 
@@ -677,6 +701,8 @@ ZTEST(net_content_senml_cbor, test_put_float)
 	for (i = 0; i < ARRAY_SIZE(expected_payload); i++) {
 		test_float = value[i];
 
+		test_payload_expected(&expected_payload[i]);
+
 		ret = do_read_op_senml_cbor(&test_msg);
 		zassert_true(ret >= 0, "Error reported");
 
@@ -746,6 +772,8 @@ ZTEST(net_content_senml_cbor, test_put_bool)
 	for (i = 0; i < ARRAY_SIZE(expected_payload); i++) {
 		test_bool = value[i];
 
+		test_payload_expected(&expected_payload[i]);
+
 		ret = do_read_op_senml_cbor(&test_msg);
 		zassert_true(ret >= 0, "Error reported");
 
@@ -839,6 +867,8 @@ ZTEST(net_content_senml_cbor, test_put_objlnk)
 	for (i = 0; i < ARRAY_SIZE(expected_payload); i++) {
 		test_objlnk = value[i];
 
+		test_payload_expected(&expected_payload[i]);
+
 		ret = do_read_op_senml_cbor(&test_msg);
 		zassert_true(ret >= 0, "Error reported");
 
@@ -888,6 +918,8 @@ static void test_put_opaque(void)
 	memcpy(test_opaque, "test_opaque", 11 * sizeof(uint8_t));
 	test_msg.path.res_id = TEST_RES_OPAQUE;
 
+	test_payload_expected(&expected_payload);
+
 	ret = do_read_op_senml_cbor(&test_msg);
 	zassert_true(ret >= 0, "Error reported");
 
@@ -933,6 +965,8 @@ ZTEST(net_content_senml_cbor, test_put_time)
 	test_msg.path.res_id = TEST_RES_TIME;
 	test_time = value;
 
+	test_payload_expected(&expected_payload);
+
 	ret = do_read_op_senml_cbor(&test_msg);
 
 	zassert_true(ret >= 0, "Error reported");
@@ -945,6 +979,44 @@ ZTEST(net_content_senml_cbor, test_put_time)
 
 }
 
+ZTEST(net_content_senml_cbor, test_put_streaming)
+{
+	zcbor_state_t zsd[3];
+	uint8_t *payload = test_msg.msg_data + TEST_PAYLOAD_OFFSET;
+	int records = 0;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING);
+
+	/* Each resource of the instance is a record, more than the
+	 * encoder could hold without streaming.
+	 */
+	zassert_true(TEST_OBJ_RES_MAX_ID > CONFIG_LWM2M_RW_SENML_CBOR_RECORDS,
+		     "Too few resources");
+
+	strcpy(test_string, "test_string");
+	test_msg.path.level = LWM2M_PATH_LEVEL_OBJECT_INST;
+
+	ret = do_read_op_senml_cbor(&test_msg);
+	zassert_true(ret >= 0, "Error reported");
+
+	zassert_equal(payload[0], (0x04 << 5) | 31, "Invalid array header");
+	zassert_equal(test_msg.msg_data[test_msg.cpkt.offset - 1], 0xff,
+		      "Invalid array end");
+
+	zcbor_new_decode_state(zsd, ARRAY_SIZE(zsd), payload,
+			       test_msg.cpkt.offset - TEST_PAYLOAD_OFFSET, 1, NULL, 0);
+	zassert_true(zcbor_list_start_decode(zsd), "Invalid array");
+
+	while (!zcbor_array_at_end(zsd)) {
+		zassert_true(zcbor_any_skip(zsd, NULL), "Invalid record");
+		records++;
+	}
+
+	zassert_true(zcbor_list_end_decode(zsd), "Invalid array end");
+	zassert_equal(records, TEST_OBJ_RES_MAX_ID, "Invalid number of records");
+}
+
 ZTEST(net_content_senml_cbor_nomem, test_put_time_nomem)
 {
 	int ret;
@@ -235,6 +235,7 @@ ZTEST(lwm2m_engine, test_check_notifications)
 	ctx.load_credentials = NULL;
 	ctx.remote_addr.sa_family = AF_INET;
 	sys_slist_init(&ctx.observer);
+	sys_slist_init(&ctx.observer_sched);
 
 	obs.last_timestamp = k_uptime_get();
 	obs.event_timestamp = k_uptime_get() + 1000U;
@@ -242,6 +243,7 @@ ZTEST(lwm2m_engine, test_check_notifications)
 	obs.active_notify = NULL;
 
 	sys_slist_append(&ctx.observer, &obs.node);
+	sys_slist_append(&ctx.observer_sched, &obs.sched_node);
 
 	lwm2m_rd_client_is_registred_fake.return_val = true;
 	ret = lwm2m_engine_start(&ctx);
@@ -689,3 +689,30 @@ ZTEST(lwm2m_registry, test_set_bulk)
 	zassert_equal(memcmp(&objl, &(struct lwm2m_objlnk){.obj_id = 10, .obj_inst = 20},
 		sizeof(objl)), 0);
 }
+
+ZTEST(lwm2m_registry, test_obj_inst_index)
+{
+	struct lwm2m_engine_obj_inst *oi;
+
+	for (uint16_t i = 0; i < CONFIG_LWM2M_IPSO_TEMP_SENSOR_INSTANCE_COUNT; i++) {
+		zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, i * 17)), 0);
+	}
+
+	for (uint16_t i = 0; i < CONFIG_LWM2M_IPSO_TEMP_SENSOR_INSTANCE_COUNT; i++) {
+		oi = lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, i * 17));
+		zassert_not_null(oi);
+		zassert_equal(oi->obj->obj_id, 3303);
+		zassert_equal(oi->obj_inst_id, i * 17);
+	}
+
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 17)), 0);
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 17)));
+
+	for (uint16_t i = 0; i < CONFIG_LWM2M_IPSO_TEMP_SENSOR_INSTANCE_COUNT; i++) {
+		if (i != 1) {
+			zassert_not_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, i * 17)));
+			zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, i * 17)), 0);
+		}
+	}
+}
@@ -8,6 +8,7 @@
 #include <mqtt_internal.h>
 #include <zephyr/sys/util.h>	/* for ARRAY_SIZE */
 #include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
 
 #define CLIENTID	MQTT_UTF8_LITERAL("zephyr")
 #define TOPIC		MQTT_UTF8_LITERAL("sensors")
@@ -1156,4 +1157,405 @@ ZTEST(mqtt_packet_fn, test_mqtt_packet)
 	mqtt_abort(&client);
 }
 
+#if defined(CONFIG_MQTT_VERSION_5_0)
+/*
+ * MQTT 5.0 CONNECT msg:
+ * Same as connect1, with protocol level 5 and no CONNECT properties.
+ */
+static ZTEST_DMEM
+uint8_t connect5_1[] = {0x10, 0x13, 0x00, 0x04, 0x4d, 0x51, 0x54, 0x54,
+		     0x05, 0x02, 0x00, 0x3c, 0x00, 0x00, 0x06, 0x7a,
+		     0x65, 0x70, 0x68, 0x79, 0x72};
+
+/*
+ * MQTT 5.0 CONNECT msg:
+ * Same as connect2, with protocol level 5, no CONNECT properties and no
+ * Will properties.
+ */
+static ZTEST_DMEM
+uint8_t connect5_2[] = {0x10, 0x23, 0x00, 0x04, 0x4d, 0x51, 0x54, 0x54,
+		     0x05, 0x06, 0x00, 0x3c, 0x00, 0x00, 0x06, 0x7a,
+		     0x65, 0x70, 0x68, 0x79, 0x72, 0x00, 0x00, 0x08,
+		     0x71, 0x75, 0x69, 0x74, 0x74, 0x69, 0x6e, 0x67,
+		     0x00, 0x03, 0x62, 0x79, 0x65};
+
+/*
+ * MQTT 5.0 PUBLISH msg:
+ * QoS: 0, topic: sensors, no properties, message: OK
+ */
+static ZTEST_DMEM
+uint8_t publish5_1[] = {0x30, 0x0c, 0x00, 0x07, 0x73, 0x65, 0x6e, 0x73,
+		     0x6f, 0x72, 0x73, 0x00, 0x4f, 0x4b};
+
+/*
+ * MQTT 5.0 PUBLISH msg:
+ * QoS: 1, Retain: 1, pkt_id: 1, topic: sensors, Topic Alias: 1, message: OK
+ */
+static ZTEST_DMEM
+uint8_t publish5_2[] = {0x33, 0x11, 0x00, 0x07, 0x73, 0x65, 0x6e, 0x73,
+		     0x6f, 0x72, 0x73, 0x00, 0x01, 0x03, 0x23, 0x00,
+		     0x01, 0x4f, 0x4b};
+
+/*
+ * MQTT 5.0 PUBLISH msg:
+ * QoS: 0, no topic, Topic Alias: 1, message: OK
+ */
+static ZTEST_DMEM
+uint8_t publish5_3[] = {0x30, 0x08, 0x00, 0x00, 0x03, 0x23, 0x00, 0x01,
+		     0x4f, 0x4b};
+
+/*
+ * MQTT 5.0 PUBLISH msgs with a Property Length beyond the message, and
+ * with a Property Length encoded on more than four bytes.
+ */
+static ZTEST_DMEM
+uint8_t publish5_long_props[] = {0x30, 0x0c, 0x00, 0x07, 0x73, 0x65, 0x6e,
+			      0x73, 0x6f, 0x72, 0x73, 0x05, 0x4f, 0x4b};
+static ZTEST_DMEM
+uint8_t publish5_bad_props[] = {0x30, 0x10, 0x00, 0x07, 0x73, 0x65, 0x6e,
+			     0x73, 0x6f, 0x72, 0x73, 0xff, 0xff, 0xff,
+			     0xff, 0x7f, 0x4f, 0x4b};
+
+/*
+ * MQTT 5.0 SUBSCRIBE msg:
+ * Same as subscribe2, with no SUBSCRIBE properties.
+ */
+static ZTEST_DMEM
+uint8_t subscribe5_1[] = {0x82, 0x0d, 0x00, 0x01, 0x00, 0x00, 0x07, 0x73,
+		       0x65, 0x6e, 0x73, 0x6f, 0x72, 0x73, 0x01};
+
+/*
+ * MQTT 5.0 SUBACK msg:
+ * pkt_id: 1, Reason String: bye, reason code: granted QoS 1
+ */
+static ZTEST_DMEM
+uint8_t suback5_1[] = {0x90, 0x0a, 0x00, 0x01, 0x06, 0x1f, 0x00, 0x03,
+		    0x62, 0x79, 0x65, 0x01};
+static ZTEST_DMEM
+uint8_t suback5_long_props[] = {0x90, 0x04, 0x00, 0x01, 0x08, 0x01};
+
+/*
+ * MQTT 5.0 CONNACK msg:
+ * Session present: 1, return code: 0, Receive Maximum: 10,
+ * Topic Alias Maximum: 5, then Maximum QoS, Session Expiry Interval,
+ * Reason String and User Property to be skipped.
+ */
+static ZTEST_DMEM
+uint8_t connack5_1[] = {0x20, 0x1c, 0x01, 0x00, 0x19, 0x21, 0x00, 0x0a,
+		     0x22, 0x00, 0x05, 0x24, 0x01, 0x11, 0x00, 0x00,
+		     0x00, 0x3c, 0x1f, 0x00, 0x02, 0x6f, 0x6b, 0x26,
+		     0x00, 0x01, 0x6b, 0x00, 0x01, 0x76};
+
+/* MQTT 5.0 CONNACK msg without properties */
+static ZTEST_DMEM
+uint8_t connack5_2[] = {0x20, 0x03, 0x00, 0x00, 0x00};
+
+/* MQTT 5.0 CONNACK msgs with malformed properties, in order:
+ * - Payload Format Indicator, not a CONNACK property;
+ * - Receive Maximum beyond the Property Length;
+ * - Property Length beyond the message;
+ * - Property Length encoded on more than four bytes;
+ * - Reason String beyond the message.
+ */
+static ZTEST_DMEM
+uint8_t connack5_bad1[] = {0x20, 0x05, 0x00, 0x00, 0x02, 0x01, 0x00};
+static ZTEST_DMEM
+uint8_t connack5_bad2[] = {0x20, 0x06, 0x00, 0x00, 0x02, 0x21, 0x00, 0x0a};
+static ZTEST_DMEM
+uint8_t connack5_bad3[] = {0x20, 0x04, 0x00, 0x00, 0x05, 0x21};
+static ZTEST_DMEM
+uint8_t connack5_bad4[] = {0x20, 0x07, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+			0x7f};
+static ZTEST_DMEM
+uint8_t connack5_bad5[] = {0x20, 0x07, 0x00, 0x00, 0x04, 0x1f, 0x00, 0x08,
+			0x6f};
+
+static void packet_5_connect(struct mqtt_client *test_client,
+			     uint8_t *expected, uint16_t expected_len)
+{
+	struct mqtt_test test = {
+		.ctx = test_client,
+		.expected = expected,
+		.expected_len = expected_len,
+	};
+
+	zassert_false(eval_msg_connect(&test), "connect error");
+}
+
+static void packet_5_publish(struct mqtt_publish_param *param, uint16_t alias,
+			     bool alias_only, uint8_t *expected,
+			     uint16_t expected_len)
+{
+	struct mqtt_publish_param dec_param;
+	uint8_t type_and_flags;
+	uint32_t length;
+	struct buf_ctx buf;
+	int rc;
+
+	buf.cur = client.tx_buf;
+	buf.end = client.tx_buf + client.tx_buf_size;
+
+	rc = publish_encode_5(param, alias, alias_only, &buf);
+	zassert_false(rc, "publish_encode_5 failed");
+
+	/* Payload is not copied, copy it manually just after the header.*/
+	memcpy(buf.end, param->message.payload.data,
+	       param->message.payload.len);
+	buf.end += param->message.payload.len;
+
+	rc = eval_buffers(&buf, expected, expected_len);
+	zassert_false(rc, "eval_buffers failed");
+
+	rc = fixed_header_decode(&buf, &type_and_flags, &length);
+	zassert_false(rc, "fixed_header_decode failed");
+
+	memset(&dec_param, 0, sizeof(dec_param));
+
+	rc = publish_decode_5(type_and_flags, length, &buf, &dec_param);
+	zassert_false(rc, "publish_decode_5 failed");
+
+	zassert_equal(dec_param.message_id, param->message_id,
+		      "message_id error");
+	zassert_equal(dec_param.message.topic.qos, param->message.topic.qos,
+		      "topic qos error");
+	zassert_equal(dec_param.message.topic.topic.size,
+		      alias_only ? 0 : param->message.topic.topic.size,
+		      "topic len error");
+	zassert_equal(dec_param.message.payload.len,
+		      param->message.payload.len, "payload len error");
+	zassert_equal(buf.end - buf.cur, param->message.payload.len,
+		      "properties not skipped");
+}
+
+static int packet_5_decode(uint8_t *data, size_t len,
+			   struct mqtt_connack_param *connack,
+			   struct mqtt_publish_param *publish,
+			   struct mqtt_suback_param *suback)
+{
+	struct buf_ctx buf = { .cur = data, .end = data + len };
+	uint8_t type_and_flags;
+	uint32_t length;
+	int rc;
+
+	rc = fixed_header_decode(&buf, &type_and_flags, &length);
+	zassert_false(rc, "fixed_header_decode failed");
+	zassert_equal(buf.end - buf.cur, length, "invalid test vector");
+
+	if (connack != NULL) {
+		return connect_ack_decode(&client, &buf, connack);
+	}
+
+	if (publish != NULL) {
+		return publish_decode_5(type_and_flags, length, &buf, publish);
+	}
+
+	return subscribe_ack_decode_5(&buf, suback);
+}
+
+ZTEST(mqtt_packet_fn, test_mqtt_packet_5)
+{
+	struct mqtt_connack_param connack;
+	struct mqtt_publish_param publish;
+	struct mqtt_suback_param suback;
+	struct {
+		uint8_t *data;
+		size_t len;
+	} bad_connack[] = {
+		{ connack5_bad1, sizeof(connack5_bad1) },
+		{ connack5_bad2, sizeof(connack5_bad2) },
+		{ connack5_bad3, sizeof(connack5_bad3) },
+		{ connack5_bad4, sizeof(connack5_bad4) },
+		{ connack5_bad5, sizeof(connack5_bad5) },
+	};
+	int rc;
+	int i;
+
+	mqtt_client_init(&client);
+	client.protocol_version = MQTT_VERSION_5_0;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+
+	/* Encoded properties */
+	packet_5_connect(&client_connect1, connect5_1, sizeof(connect5_1));
+	packet_5_connect(&client_connect2, connect5_2, sizeof(connect5_2));
+	packet_5_publish(&msg_publish1, 0, false, publish5_1,
+			 sizeof(publish5_1));
+	packet_5_publish(&msg_publish3, 1, false, publish5_2,
+			 sizeof(publish5_2));
+	packet_5_publish(&msg_publish1, 1, true, publish5_3,
+			 sizeof(publish5_3));
+
+	{
+		struct buf_ctx buf = {
+			.cur = client.tx_buf,
+			.end = client.tx_buf + client.tx_buf_size,
+		};
+
+		rc = subscribe_encode_5(&msg_subscribe2, &buf);
+		zassert_false(rc, "subscribe_encode_5 failed");
+		rc = eval_buffers(&buf, subscribe5_1, sizeof(subscribe5_1));
+		zassert_false(rc, "eval_buffers failed");
+	}
+
+	/* Decoded properties */
+	rc = packet_5_decode(connack5_1, sizeof(connack5_1), &connack, NULL,
+			     NULL);
+	zassert_equal(rc, 0, "connect_ack_decode failed");
+	zassert_equal(connack.session_present_flag, 1, "session present error");
+	zassert_equal(connack.return_code, MQTT_CONNECTION_ACCEPTED,
+		      "return code error");
+	zassert_equal(connack.receive_maximum, 10, "receive maximum error");
+	zassert_equal(connack.topic_alias_maximum, 5,
+		      "topic alias maximum error");
+
+	rc = packet_5_decode(connack5_2, sizeof(connack5_2), &connack, NULL,
+			     NULL);
+	zassert_equal(rc, 0, "connect_ack_decode failed");
+	zassert_equal(connack.receive_maximum, UINT16_MAX,
+		      "receive maximum default error");
+	zassert_equal(connack.topic_alias_maximum, 0,
+		      "topic alias maximum default error");
+
+	memset(&suback, 0, sizeof(suback));
+	rc = packet_5_decode(suback5_1, sizeof(suback5_1), NULL, NULL, &suback);
+	zassert_equal(rc, 0, "subscribe_ack_decode_5 failed");
+	zassert_equal(suback.message_id, 1, "packet identifier error");
+	zassert_equal(suback.return_codes.len, 1, "topic count error");
+	zassert_equal(suback.return_codes.data[0], MQTT_SUBACK_SUCCESS_QoS_1,
+		      "subscribe result error");
+
+	/* Malformed and over-long properties */
+	for (i = 0; i < ARRAY_SIZE(bad_connack); i++) {
+		rc = packet_5_decode(bad_connack[i].data, bad_connack[i].len,
+				     &connack, NULL, NULL);
+		zassert_equal(rc, -EINVAL, "malformed CONNACK %d accepted", i);
+	}
+
+	rc = packet_5_decode(publish5_long_props, sizeof(publish5_long_props),
+			     NULL, &publish, NULL);
+	zassert_equal(rc, -EINVAL, "over-long PUBLISH properties accepted");
+
+	rc = packet_5_decode(publish5_bad_props, sizeof(publish5_bad_props),
+			     NULL, &publish, NULL);
+	zassert_equal(rc, -EINVAL, "malformed PUBLISH properties accepted");
+
+	rc = packet_5_decode(suback5_long_props, sizeof(suback5_long_props),
+			     NULL, NULL, &suback);
+	zassert_equal(rc, -EINVAL, "over-long SUBACK properties accepted");
+
+	mqtt_abort(&client);
+}
+#endif /* CONFIG_MQTT_VERSION_5_0 */
+
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0
+static ZTEST_DMEM int inflight_sock[2];
+static ZTEST_DMEM enum mqtt_evt_type inflight_evt;
+
+static void inflight_evt_handler(struct mqtt_client *const c,
+				 const struct mqtt_evt *evt)
+{
+	inflight_evt = evt->type;
+}
+
+static int inflight_publish(struct mqtt_topic *topic, uint16_t message_id,
+			    bool dup)
+{
+	struct mqtt_publish_param param = {
+		.message.topic = *topic,
+		.message.payload.data = (uint8_t *)"OK",
+		.message.payload.len = 2,
+		.message_id = message_id,
+		.dup_flag = dup,
+	};
+	uint8_t data[BUFFER_SIZE];
+	int rc;
+
+	rc = mqtt_publish(&client, &param);
+
+	/* Drain the peer, its buffer only holds a few publications */
+	while (zsock_recv(inflight_sock[1], data, sizeof(data),
+			  ZSOCK_MSG_DONTWAIT) > 0) {
+	}
+
+	return rc;
+}
+
+static void inflight_ack(uint8_t *ack, size_t len, enum mqtt_evt_type type)
+{
+	int rc;
+
+	inflight_evt = MQTT_EVT_DISCONNECT;
+
+	rc = zsock_send(inflight_sock[1], ack, len, 0);
+	zassert_equal(rc, len, "send failed");
+
+	rc = mqtt_input(&client);
+	zassert_equal(rc, 0, "mqtt_input failed");
+	zassert_equal(inflight_evt, type, "invalid event");
+}
+
+ZTEST(mqtt_packet_fn, test_mqtt_publish_inflight)
+{
+	uint8_t puback7[] = {0x40, 0x02, 0x00, 0x07};
+	uint16_t id;
+	int rc;
+
+	rc = zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, inflight_sock);
+	zassert_equal(rc, 0, "socketpair failed");
+
+	mqtt_client_init(&client);
+	client.protocol_version = MQTT_VERSION_3_1_1;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+	client.evt_cb = inflight_evt_handler;
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client.transport.tcp.sock = inflight_sock[0];
+	MQTT_SET_STATE(&client, MQTT_STATE_TCP_CONNECTED | MQTT_STATE_CONNECTED);
+
+	/* Fill the table, alternating QoS 1 and 2 */
+	for (id = 1; id <= CONFIG_MQTT_PUBLISH_INFLIGHT_MAX; id++) {
+		rc = inflight_publish(id % 2 ? &topic_qos_1 : &topic_qos_2, id,
+				      false);
+		zassert_equal(rc, 0, "publish %u failed", id);
+	}
+
+	rc = inflight_publish(&topic_qos_1, id, false);
+	zassert_equal(rc, -EAGAIN, "publish should fail with a full table");
+
+	/* QoS 0 publications are not tracked */
+	rc = inflight_publish(&topic_qos_0, 0, false);
+	zassert_equal(rc, 0, "QoS 0 publish failed");
+
+	/* A message ID in flight can only be reused by a retransmission */
+	rc = inflight_publish(&topic_qos_1, 1, false);
+	zassert_equal(rc, -EBUSY, "message ID reused");
+	rc = inflight_publish(&topic_qos_1, 1, true);
+	zassert_equal(rc, 0, "retransmission failed");
+
+	/* An acknowledgment of an other message ID frees nothing */
+	inflight_ack(puback7, sizeof(puback7), MQTT_EVT_PUBACK);
+	rc = inflight_publish(&topic_qos_1, id, false);
+	zassert_equal(rc, -EAGAIN, "publish should fail with a full table");
+
+	inflight_ack(puback1, sizeof(puback1), MQTT_EVT_PUBACK);
+	rc = inflight_publish(&topic_qos_1, 1, false);
+	zassert_equal(rc, 0, "message ID 1 still in flight");
+
+	if (CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 1) {
+		uint8_t pubcomp2[] = {0x70, 0x02, 0x00, 0x02};
+
+		inflight_ack(pubcomp2, sizeof(pubcomp2), MQTT_EVT_PUBCOMP);
+		rc = inflight_publish(&topic_qos_2, id, false);
+		zassert_equal(rc, 0, "message ID 2 still in flight");
+	}
+
+	mqtt_abort(&client);
+	zsock_close(inflight_sock[1]);
+}
+#endif /* CONFIG_MQTT_PUBLISH_INFLIGHT_MAX > 0 */
+
 ZTEST_SUITE(mqtt_packet_fn, NULL, NULL, NULL, NULL, NULL);
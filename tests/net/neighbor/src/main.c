@@ -293,6 +293,45 @@ ZTEST(neighbor_test_suite, test_neighbor)
 	return;
 }
 
+ZTEST(neighbor_test_suite, test_neighbor_update_lladdr)
+{
+	struct net_if *iface1 = INT_TO_POINTER(1);
+	struct net_linkaddr lladdr = {
+		.len = sizeof(struct net_eth_addr),
+	};
+	struct net_nbr *nbr;
+	int ret;
+
+	nbr = net_nbr_get(&net_test_neighbor.table);
+	zassert_not_null(nbr, "Cannot get neighbor from table %p\n",
+			 &net_test_neighbor.table);
+
+	lladdr.addr = hwaddr1.addr;
+	ret = net_nbr_link(nbr, iface1, &lladdr);
+	zassert_ok(ret, "Cannot add %s to nbr cache (%d)\n",
+		   net_sprint_ll_addr(lladdr.addr, lladdr.len), ret);
+
+	ret = net_nbr_update_lladdr(nbr, hwaddr2.addr, sizeof(hwaddr2));
+	zassert_ok(ret, "Cannot update lladdr (%d)\n", ret);
+
+	/* The lookup follows the new address only */
+	zassert_is_null(net_nbr_lookup(&net_test_neighbor.table, iface1,
+				       &lladdr), "Old lladdr still found");
+
+	lladdr.addr = hwaddr2.addr;
+	zassert_equal_ptr(net_nbr_lookup(&net_test_neighbor.table, iface1,
+					 &lladdr), nbr, "New lladdr not found");
+
+	ret = net_nbr_unlink(nbr, &lladdr);
+	zassert_ok(ret, "Cannot del %s from nbr cache (%d)\n",
+		   net_sprint_ll_addr(lladdr.addr, lladdr.len), ret);
+
+	net_nbr_unref(nbr);
+
+	zassert_is_null(net_nbr_lookup(&net_test_neighbor.table, iface1,
+				       &lladdr), "Unlinked lladdr found");
+}
+
 void *setup(void)
 {
 	if (IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE)) {
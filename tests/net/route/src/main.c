@@ -544,6 +544,132 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct in6_addr other_addr = dest_addr;
+	struct net_route_entry *route_32, *route_64, *route_128;
+	struct in6_addr *nexthop;
+
+	route_32 = net_route_add(my_iface, &dest_addr, 32, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_32, "Route add failed");
+
+	route_128 = net_route_add(my_iface, &dest_addr, 128, &peer_addr,
+				  NET_IPV6_ND_INFINITE_LIFETIME,
+				  NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_128, "Route add failed");
+
+	/* A covering prefix does not replace the more specific routes */
+	route_64 = net_route_add(my_iface, &dest_addr, 64, &peer_addr_alt,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_64, "Route add failed");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), route_128,
+			  "Longest prefix not found");
+
+	other_addr.s6_addr[15] ^= 0x01;
+	zassert_equal_ptr(net_route_lookup(my_iface, &other_addr), route_64,
+			  "/64 prefix not found");
+
+	other_addr.s6_addr[7] ^= 0x01;
+	zassert_equal_ptr(net_route_lookup(my_iface, &other_addr), route_32,
+			  "/32 prefix not found");
+
+	zassert_ok(net_route_del(route_128), "Route del failed");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), route_64,
+			  "/64 prefix not found after delete");
+	nexthop = net_route_get_nexthop(route_64);
+	zassert_true(nexthop && net_ipv6_addr_cmp(nexthop, &peer_addr_alt),
+		     "Route nexthop does not match");
+
+	zassert_ok(net_route_del(route_64), "Route del failed");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), route_32,
+			  "/32 prefix not found after delete");
+
+	zassert_ok(net_route_del(route_32), "Route del failed");
+
+	zassert_is_null(net_route_lookup(my_iface, &dest_addr),
+			"Deleted route found");
+}
+
+#if defined(CONFIG_NET_ROUTE_FWD_CACHE)
+/* Packet from src to dest_addr, as received from the peer interface */
+static struct net_pkt *fwd_pkt_create(const struct in6_addr *src)
+{
+	struct net_ipv6_hdr *hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(peer_iface, sizeof(struct net_ipv6_hdr),
+					AF_INET6, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	hdr = (struct net_ipv6_hdr *)net_buf_add(pkt->buffer, sizeof(*hdr));
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->vtc = 0x60;
+	hdr->nexthdr = IPPROTO_UDP;
+	hdr->hop_limit = 64U;
+	net_ipv6_addr_copy_raw(hdr->src, (const uint8_t *)src);
+	net_ipv6_addr_copy_raw(hdr->dst, (const uint8_t *)&dest_addr);
+
+	net_pkt_set_ip_hdr_len(pkt, sizeof(*hdr));
+	net_pkt_set_orig_iface(pkt, peer_iface);
+
+	return pkt;
+}
+
+static void test_route_fwd_cache(void)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	route_entry = net_route_add(my_iface, &dest_addr, 128, &peer_addr,
+				    NET_IPV6_ND_INFINITE_LIFETIME,
+				    NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_entry, "Route add failed");
+
+	/* Let the flush of the route add event pass */
+	k_sleep(K_MSEC(100));
+
+	/* An unknown flow is left to the route lookup */
+	pkt = fwd_pkt_create(&generic_addr);
+	ret = net_route_fwd_cache_packet(pkt, NET_IPV6_HDR(pkt));
+	zassert_equal(ret, -ENOENT, "Unknown flow found in cache (%d)", ret);
+
+	/* Forwarding the flow once caches it */
+	ret = net_route_packet(pkt, &peer_addr);
+	zassert_ok(ret, "Route packet failed (%d)", ret);
+	zassert_ok(k_sem_take(&wait_data, WAIT_TIME), "Packet not sent");
+
+	pkt = fwd_pkt_create(&generic_addr);
+	ret = net_route_fwd_cache_packet(pkt, NET_IPV6_HDR(pkt));
+	zassert_ok(ret, "Flow not found in cache (%d)", ret);
+	zassert_ok(k_sem_take(&wait_data, WAIT_TIME), "Cached packet not sent");
+
+	/* Another source is another flow */
+	pkt = fwd_pkt_create(&peer_addr_alt);
+	ret = net_route_fwd_cache_packet(pkt, NET_IPV6_HDR(pkt));
+	zassert_equal(ret, -ENOENT, "Other flow found in cache (%d)", ret);
+	net_pkt_unref(pkt);
+
+	/* A route change flushes the cache */
+	zassert_ok(net_route_del(route_entry), "Route del failed");
+	k_sleep(K_MSEC(100));
+
+	pkt = fwd_pkt_create(&generic_addr);
+	ret = net_route_fwd_cache_packet(pkt, NET_IPV6_HDR(pkt));
+	zassert_equal(ret, -ENOENT, "Flow still cached after route del (%d)",
+		      ret);
+	net_pkt_unref(pkt);
+}
+#else
+static void test_route_fwd_cache(void)
+{
+}
+#endif /* CONFIG_NET_ROUTE_FWD_CACHE */
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +692,8 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
+	test_route_fwd_cache();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
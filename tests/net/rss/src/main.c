@@ -0,0 +1,211 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_rss_test, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <net_private.h>
+#include <ipv4.h>
+
+#define ALLOC_TIMEOUT K_MSEC(500)
+#define WAIT_TIME K_MSEC(500)
+
+#define MY_PORT 5555
+#define PEER_PORT_BASE 4000
+#define FLOWS 16
+#define PKTS_PER_FLOW 4
+
+/* 192.0.2.1 is ours, 192.0.2.2 is the peer */
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static k_tid_t flow_thread[FLOWS];
+static bool flow_reordered;
+static K_SEM_DEFINE(recv_sem, 0, UINT_MAX);
+
+static uint8_t net_iface_dummy_data;
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_rss_test, "net_rss_test", NULL, NULL,
+		&net_iface_dummy_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+static enum net_verdict udp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	int flow = ntohs(proto_hdr->udp->src_port) - PEER_PORT_BASE;
+	k_tid_t tid = k_current_get();
+
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(user_data);
+
+	if (flow >= 0 && flow < FLOWS) {
+		if (flow_thread[flow] == NULL) {
+			flow_thread[flow] = tid;
+		} else if (flow_thread[flow] != tid) {
+			flow_reordered = true;
+		}
+	}
+
+	net_pkt_unref(pkt);
+	k_sem_give(&recv_sem);
+
+	return NET_OK;
+}
+
+static struct net_pkt *build_datagram(uint16_t src_port, uint32_t hash)
+{
+	struct net_ipv4_hdr ip = {
+		.vhl = 0x45,
+		.len = htons(NET_IPV4H_LEN + NET_UDPH_LEN),
+		.ttl = 64,
+		.proto = IPPROTO_UDP,
+	};
+	struct net_udp_hdr udp = {
+		.src_port = htons(src_port),
+		.dst_port = htons(MY_PORT),
+		.len = htons(NET_UDPH_LEN),
+	};
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, NET_IPV4H_LEN + NET_UDPH_LEN,
+					   AF_INET, IPPROTO_UDP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	memcpy(ip.src, &peer_addr, sizeof(ip.src));
+	memcpy(ip.dst, &my_addr, sizeof(ip.dst));
+
+	zassert_ok(net_pkt_write(pkt, &ip, sizeof(ip)));
+	zassert_ok(net_pkt_write(pkt, &udp, sizeof(udp)));
+
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+	net_pkt_cursor_init(pkt);
+	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_set_rx_hash(pkt, hash);
+
+	return pkt;
+}
+
+static void receive_all(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&recv_sem, WAIT_TIME),
+			   "Packet %d not received", i);
+	}
+}
+
+static void reset_flows(void)
+{
+	memset(flow_thread, 0, sizeof(flow_thread));
+	flow_reordered = false;
+	k_sem_reset(&recv_sem);
+}
+
+ZTEST(net_rss, test_software_hash)
+{
+	k_tid_t first;
+	bool spread = false;
+
+	reset_flows();
+
+	for (int n = 0; n < PKTS_PER_FLOW; n++) {
+		for (int i = 0; i < FLOWS; i++) {
+			zassert_ok(net_recv_data(iface,
+				build_datagram(PEER_PORT_BASE + i, 0)));
+		}
+	}
+
+	receive_all(FLOWS * PKTS_PER_FLOW);
+
+	zassert_false(flow_reordered, "A flow was handled by several queues");
+
+	first = flow_thread[0];
+
+	for (int i = 1; i < FLOWS; i++) {
+		if (flow_thread[i] != first) {
+			spread = true;
+		}
+	}
+
+	zassert_true(spread, "All flows were handled by one queue");
+}
+
+ZTEST(net_rss, test_device_hash)
+{
+	k_tid_t tid[2];
+
+	/* The hash from the device overrides the flow 5-tuple */
+	for (int i = 0; i < ARRAY_SIZE(tid); i++) {
+		reset_flows();
+
+		zassert_ok(net_recv_data(iface,
+					 build_datagram(PEER_PORT_BASE, i + 1)));
+		receive_all(1);
+
+		tid[i] = flow_thread[0];
+	}
+
+	zassert_not_equal(tid[0], tid[1], "Device hash was not used");
+}
+
+static void *test_setup(void)
+{
+	static struct net_conn_handle *handle;
+	struct sockaddr local = { 0 };
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No interface");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0),
+			 "Cannot add address");
+
+	net_ipaddr_copy(&net_sin(&local)->sin_addr, &my_addr);
+	local.sa_family = AF_INET;
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL, &local,
+				0, MY_PORT, NULL, udp_data_received,
+				NULL, &handle);
+	zassert_ok(ret, "Cannot register UDP connection (%d)", ret);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_rss, NULL, test_setup, NULL, NULL, NULL);
@@ -594,4 +594,89 @@ ZTEST(socket_packet, test_raw_and_dgram_socket_recv)
 	zsock_close(sock3);
 }
 
+ZTEST(socket_packet, test_raw_socket_rx_ring)
+{
+	static uint8_t ring[4][128] __aligned(4);
+	uint8_t data_to_send[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	const uint8_t expected_payload_raw[] = {
+		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, /* Dst ll addr */
+		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, /* Src ll addr */
+		ETH_P_IP >> 8, ETH_P_IP & 0xFF, /* EtherType */
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9 /* Payload */
+	};
+	struct tpacket_req req = {
+		.tp_ring = ring,
+		.tp_frame_size = sizeof(ring[0]),
+		.tp_frame_nr = ARRAY_SIZE(ring),
+	};
+	struct tpacket_hdr *hdr = (struct tpacket_hdr *)ring[0];
+	struct sockaddr_ll *src = (struct sockaddr_ll *)(hdr + 1);
+	struct user_data ud = { 0 };
+	struct sockaddr_ll dst;
+	struct zsock_pollfd pfd;
+	int ret, sock1, sock2;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_SOCKETS_PACKET_RX_RING);
+
+	net_if_foreach(iface_cb, &ud);
+
+	zassert_not_null(ud.first, "1st Ethernet interface not found");
+	zassert_not_null(ud.second, "2nd Ethernet interface not found");
+
+	sock1 = setup_socket(ud.first, SOCK_DGRAM, ETH_P_ALL);
+	sock2 = setup_socket(ud.second, SOCK_RAW, ETH_P_ALL);
+
+	req.tp_frame_size = 20;
+	ret = zsock_setsockopt(sock2, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+	zassert_equal(ret, -1, "Too small slots accepted");
+	zassert_equal(errno, EINVAL, "Unexpected errno (%d)", errno);
+
+	req.tp_frame_size = sizeof(ring[0]);
+	ret = zsock_setsockopt(sock2, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+	zassert_equal(ret, 0, "Cannot set ring (%d)", -errno);
+
+	zassert_equal(bind_socket(sock1, ud.first), 0, "Cannot bind 1st socket");
+	zassert_equal(bind_socket(sock2, ud.second), 0, "Cannot bind 2nd socket");
+
+	pfd.fd = sock2;
+	pfd.events = ZSOCK_POLLIN;
+	zassert_equal(zsock_poll(&pfd, 1, 0), 0, "Empty ring reported readable");
+
+	memset(&dst, 0, sizeof(dst));
+	dst.sll_family = AF_PACKET;
+	dst.sll_protocol = htons(ETH_P_IP);
+	memcpy(dst.sll_addr, lladdr2, sizeof(lladdr2));
+
+	ret = zsock_sendto(sock1, data_to_send, sizeof(data_to_send), 0,
+			   (const struct sockaddr *)&dst, sizeof(struct sockaddr_ll));
+	zassert_equal(ret, sizeof(data_to_send), "Cannot send all data (%d)",
+		      -errno);
+
+	ret = zsock_poll(&pfd, 1, 1000);
+	zassert_equal(ret, 1, "Ring not readable (%d)", ret);
+	zassert_true(pfd.revents & ZSOCK_POLLIN, "No POLLIN");
+
+	zassert_equal(hdr->tp_status, TP_STATUS_USER, "Unexpected status %x",
+		      hdr->tp_status);
+	zassert_equal(hdr->tp_len, sizeof(expected_payload_raw), "Wrong length");
+	zassert_equal(hdr->tp_snaplen, hdr->tp_len, "Frame truncated");
+	zassert_mem_equal(&ring[0][hdr->tp_mac], expected_payload_raw,
+			  sizeof(expected_payload_raw), "Data mismatch");
+	zassert_equal(src->sll_family, AF_PACKET, "Wrong source family");
+	zassert_equal(src->sll_ifindex, net_if_get_by_iface(ud.second),
+		      "Wrong interface");
+
+	/* Give the slot back, the ring is then empty again */
+	hdr->tp_status = TP_STATUS_KERNEL;
+	zassert_equal(zsock_poll(&pfd, 1, 0), 0, "Empty ring reported readable");
+
+	/* Frames went to the ring, not to the socket queue */
+	setblocking(sock2, false);
+	ret = zsock_recv(sock2, data_to_send, sizeof(data_to_send), 0);
+	zassert_equal(ret, -1, "Frame also queued to the socket");
+
+	zsock_close(sock1);
+	zsock_close(sock2);
+}
+
 ZTEST_SUITE(socket_packet, NULL, NULL, NULL, NULL, NULL);
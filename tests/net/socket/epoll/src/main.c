@@ -0,0 +1,174 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+static void send_to(int sock, struct sockaddr_in6 *addr)
+{
+	ssize_t len;
+
+	len = zsock_sendto(sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			   (struct sockaddr *)addr, sizeof(*addr));
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+}
+
+static void recv_from(int sock)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = zsock_recv(sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+}
+
+ZTEST(net_socket_epoll, test_epoll)
+{
+	struct zsock_epoll_event ev, events[2];
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int c_sock;
+	int s_sock;
+	int epfd;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = zsock_bind(c_sock, (struct sockaddr *)&c_addr, sizeof(c_addr));
+	zassert_equal(res, 0, "bind failed");
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	epfd = zsock_epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	ev.events = ZSOCK_EPOLLIN;
+	ev.data.u32 = 1;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, c_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+
+	ev.data.u32 = 2;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "duplicate registration accepted");
+	zassert_equal(errno, EEXIST, "unexpected errno %d", errno);
+
+	/* Only an epoll instance can be waited on */
+	res = zsock_epoll_wait(c_sock, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, -1, "wait on a socket");
+	zassert_equal(errno, EBADF, "unexpected errno %d", errno);
+	res = zsock_epoll_wait(1000, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, -1, "wait on an invalid fd");
+	zassert_equal(errno, EBADF, "unexpected errno %d", errno);
+
+	/* Nothing is ready */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "unexpected events");
+
+	/* Only the ready socket is reported */
+	send_to(c_sock, &s_addr);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "expected one event, got %d", res);
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+	zassert_equal(events[0].data.u32, 2, "");
+
+	/* Level triggered, the socket stays ready until the data is read */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "expected one event, got %d", res);
+
+	recv_from(s_sock);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "unexpected events");
+
+	/* A blocked wait is woken once the idle socket becomes ready again */
+	send_to(c_sock, &s_addr);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "expected one event, got %d", res);
+	zassert_equal(events[0].data.u32, 2, "");
+
+	recv_from(s_sock);
+
+	/* With maxevents of 1, ready sockets are reported in turns */
+	send_to(c_sock, &s_addr);
+	send_to(s_sock, &c_addr);
+	k_msleep(10);
+
+	res = zsock_epoll_wait(epfd, events, 1, 0);
+	zassert_equal(res, 1, "expected one event, got %d", res);
+	res = zsock_epoll_wait(epfd, &events[1], 1, 0);
+	zassert_equal(res, 1, "expected one event, got %d", res);
+	zassert_not_equal(events[0].data.u32, events[1].data.u32,
+			  "same socket reported twice");
+
+	recv_from(s_sock);
+	recv_from(c_sock);
+
+	/* One-shot registration is disabled after the first event */
+	ev.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT;
+	ev.data.u32 = 2;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+
+	send_to(c_sock, &s_addr);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "expected one event, got %d", res);
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "one-shot event reported again");
+
+	recv_from(s_sock);
+
+	/* Removed sockets are not reported */
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, -1, "removed twice");
+	zassert_equal(errno, ENOENT, "unexpected errno %d", errno);
+
+	send_to(c_sock, &s_addr);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 0, "unexpected events");
+
+	recv_from(s_sock);
+
+	res = zsock_close(epfd);
+	zassert_equal(res, 0, "close failed");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, -1, "wait on closed instance");
+	zassert_equal(errno, EBADF, "unexpected errno %d", errno);
+
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,202 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/ztest.h>
+
+#define TEST_BLK_SIZE	64
+#define TEST_MSG_COUNT	3
+#define TEST_TIMEOUT_MS	1000
+
+ZSOCK_RTIO_IODEV_DEFINE(sock_iodev);
+RTIO_DEFINE_WITH_MEMPOOL(sock_rtio, 4, 4, 8, TEST_BLK_SIZE, 4);
+
+static const char test_msg[] = "The quick brown fox jumps over the lazy dog";
+static uint8_t rx_buf[TEST_BLK_SIZE];
+static int sv[2] = {-1, -1};
+
+/* Wait for the next completion, NULL on timeout */
+static struct rtio_cqe *wait_cqe(int timeout_ms)
+{
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < timeout_ms; i += 10) {
+		cqe = rtio_cqe_consume(&sock_rtio);
+		if (cqe != NULL) {
+			return cqe;
+		}
+
+		k_msleep(10);
+	}
+
+	return rtio_cqe_consume(&sock_rtio);
+}
+
+/* Consume the next completion, checking its result and user data */
+static void consume_cqe(int result, void *userdata)
+{
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	cqe = wait_cqe(TEST_TIMEOUT_MS);
+	zassert_not_null(cqe, "No completion");
+	zassert_equal(cqe->result, result, "Completion result %d, expected %d",
+		      cqe->result, result);
+	zassert_equal_ptr(cqe->userdata, userdata, "Wrong completion");
+
+	if (rtio_cqe_get_mempool_buffer(&sock_rtio, cqe, &buf, &buf_len) == 0) {
+		rtio_release_buffer(&sock_rtio, buf, buf_len);
+	}
+
+	rtio_cqe_release(&sock_rtio, cqe);
+}
+
+static struct rtio_sqe *acquire_sqe(void)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&sock_rtio);
+
+	zassert_not_null(sqe, "No submission left");
+
+	return sqe;
+}
+
+static void check_peer_recv(const void *data, size_t len)
+{
+	char buf[sizeof(test_msg)];
+	ssize_t ret;
+
+	ret = zsock_recv(sv[1], buf, sizeof(buf), 0);
+	zassert_equal(ret, len, "Peer received %d bytes (%d)", (int)ret, errno);
+	zassert_mem_equal(buf, data, len, "Peer received wrong data");
+}
+
+ZTEST(socket_rtio, test_write)
+{
+	struct rtio_sqe *sqe = acquire_sqe();
+
+	rtio_sqe_prep_write(sqe, &sock_iodev, RTIO_PRIO_NORM, (uint8_t *)test_msg,
+			    sizeof(test_msg), sqe);
+	zassert_ok(rtio_submit(&sock_rtio, 0), "Failed to submit");
+	consume_cqe(sizeof(test_msg), sqe);
+
+	check_peer_recv(test_msg, sizeof(test_msg));
+}
+
+ZTEST(socket_rtio, test_tiny_write)
+{
+	static const uint8_t tiny[] = {0x01, 0x02, 0x03, 0x04};
+	struct rtio_sqe *sqe = acquire_sqe();
+
+	rtio_sqe_prep_tiny_write(sqe, &sock_iodev, RTIO_PRIO_NORM, tiny, sizeof(tiny), sqe);
+	zassert_ok(rtio_submit(&sock_rtio, 0), "Failed to submit");
+	consume_cqe(sizeof(tiny), sqe);
+
+	check_peer_recv(tiny, sizeof(tiny));
+}
+
+ZTEST(socket_rtio, test_read)
+{
+	struct rtio_sqe *sqe = acquire_sqe();
+	ssize_t ret;
+
+	ret = zsock_send(sv[1], test_msg, sizeof(test_msg), 0);
+	zassert_equal(ret, sizeof(test_msg), "Peer failed to send (%d)", errno);
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, rx_buf, sizeof(rx_buf), sqe);
+	zassert_ok(rtio_submit(&sock_rtio, 0), "Failed to submit");
+	consume_cqe(sizeof(test_msg), sqe);
+
+	zassert_mem_equal(rx_buf, test_msg, sizeof(test_msg), "Wrong data received");
+}
+
+/*
+ * A multishot receive completes once for every message, into buffers of the
+ * memory pool, then once with -ENOTCONN when the peer closes the connection.
+ * It is not submitted again after that.
+ */
+ZTEST(socket_rtio, test_read_multishot)
+{
+	struct rtio_sqe *sqe = acquire_sqe();
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+	ssize_t ret;
+
+	rtio_sqe_prep_read_multishot(sqe, &sock_iodev, RTIO_PRIO_NORM, sqe);
+	zassert_ok(rtio_submit(&sock_rtio, 0), "Failed to submit");
+
+	for (int i = 0; i < TEST_MSG_COUNT; i++) {
+		ret = zsock_send(sv[1], test_msg, sizeof(test_msg) - i, 0);
+		zassert_equal(ret, sizeof(test_msg) - i, "Peer failed to send (%d)", errno);
+
+		cqe = wait_cqe(TEST_TIMEOUT_MS);
+		zassert_not_null(cqe, "Message %d not received", i);
+		zassert_equal(cqe->result, sizeof(test_msg) - i, "Message %d of %d bytes",
+			      i, cqe->result);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&sock_rtio, cqe, &buf, &buf_len),
+			   "No buffer from the memory pool");
+		zassert_mem_equal(buf, test_msg, cqe->result, "Wrong data received");
+		rtio_release_buffer(&sock_rtio, buf, buf_len);
+		rtio_cqe_release(&sock_rtio, cqe);
+	}
+
+	zassert_ok(zsock_close(sv[1]), "Failed to close the peer");
+	sv[1] = -1;
+
+	consume_cqe(-ENOTCONN, sqe);
+	zassert_is_null(wait_cqe(100), "Receive submitted after the peer closed");
+
+	/* The submission was released */
+	for (int i = 0; i < 4; i++) {
+		zassert_not_null(rtio_sqe_acquire(&sock_rtio), "Submission %d not released", i);
+	}
+
+	rtio_sqe_drop_all(&sock_rtio);
+}
+
+ZTEST(socket_rtio, test_no_socket)
+{
+	struct rtio_sqe *sqe = acquire_sqe();
+
+	zsock_rtio_iodev_set(&sock_iodev, -1);
+
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, rx_buf, sizeof(rx_buf), sqe);
+	zassert_ok(rtio_submit(&sock_rtio, 0), "Failed to submit");
+	consume_cqe(-EBADF, sqe);
+}
+
+static void socket_rtio_before(void *fixture)
+{
+	int ret;
+
+	ARG_UNUSED(fixture);
+
+	ret = zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_ok(ret, "Failed to create a socket pair (%d)", errno);
+
+	zsock_rtio_iodev_set(&sock_iodev, sv[0]);
+}
+
+static void socket_rtio_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zsock_rtio_iodev_set(&sock_iodev, -1);
+
+	for (int i = 0; i < ARRAY_SIZE(sv); i++) {
+		if (sv[i] >= 0) {
+			(void)zsock_close(sv[i]);
+			sv[i] = -1;
+		}
+	}
+}
+
+ZTEST_SUITE(socket_rtio, NULL, NULL, socket_rtio_before, socket_rtio_after, NULL);
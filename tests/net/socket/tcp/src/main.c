@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/posix/fcntl.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/loopback.h>
+#include <zephyr/storage/flash_map.h>
 
 #include "../../socket_helpers.h"
 
@@ -2486,6 +2487,131 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) && defined(CONFIG_NET_TCP_CONGESTION_BBR)
+static void check_congestion(int sock, const char *expected)
+{
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int ret;
+
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, strlen(expected) + 1, "getsockopt got invalid size");
+	zassert_equal(strcmp(name, expected), 0, "got %s instead of %s", name,
+		      expected);
+}
+
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in c_saddr, s_saddr;
+	int c_sock, s_sock, new_sock;
+	int ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	check_congestion(c_sock, CONFIG_NET_TCP_CONGESTION_DEFAULT_NAME);
+
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "vegas",
+			       strlen("vegas"));
+	zassert_equal(ret, -1, "unknown algorithm accepted");
+	zassert_equal(errno, ENOENT, "unexpected errno %d", errno);
+
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "bbr",
+			       strlen("bbr"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+	check_congestion(c_sock, "bbr");
+
+	/* Accepted connections inherit the algorithm of the listener */
+	ret = zsock_setsockopt(s_sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+			       sizeof("cubic"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	check_congestion(new_sock, "cubic");
+
+	/* The algorithm can be changed on an established connection */
+	ret = zsock_setsockopt(new_sock, IPPROTO_TCP, TCP_CONGESTION, "reno",
+			       strlen("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+	check_congestion(new_sock, "reno");
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC && CONFIG_NET_TCP_CONGESTION_BBR */
+
+#if defined(CONFIG_NET_SOCKETS_SENDFILE) && defined(CONFIG_FLASH_MAP)
+#define SEND_FLASH_OFFSET 16
+#define SEND_FLASH_LEN 1500
+
+ZTEST(net_socket_tcp, test_v4_send_flash)
+{
+	static uint8_t pattern[SEND_FLASH_OFFSET + SEND_FLASH_LEN];
+	static uint8_t data[SEND_FLASH_LEN];
+	const struct flash_area *fa;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	size_t sent = 0;
+	int new_sock;
+	int c_sock;
+	int s_sock;
+	ssize_t len;
+	int ret;
+
+	for (int i = 0; i < sizeof(pattern); i++) {
+		pattern[i] = i;
+	}
+
+	ret = flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa);
+	zassert_equal(ret, 0, "flash_area_open failed (%d)", ret);
+	ret = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_equal(ret, 0, "flash_area_erase failed (%d)", ret);
+	ret = flash_area_write(fa, 0, pattern, sizeof(pattern));
+	zassert_equal(ret, 0, "flash_area_write failed (%d)", ret);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	while (sent < SEND_FLASH_LEN) {
+		len = zsock_send_flash(c_sock, fa, SEND_FLASH_OFFSET + sent,
+				       SEND_FLASH_LEN - sent, 0);
+		zassert_true(len > 0, "send_flash failed (%d)", errno);
+		sent += len;
+	}
+
+	len = zsock_recv(new_sock, data, sizeof(data), ZSOCK_MSG_WAITALL);
+	zassert_equal(len, sizeof(data), "invalid recv len %d", (int)len);
+	zassert_mem_equal(data, pattern + SEND_FLASH_OFFSET, sizeof(data),
+			  "wrong data");
+
+	/* A read past the end of the area is rejected */
+	len = zsock_send_flash(c_sock, fa, fa->fa_size + 1, 1, 0);
+	zassert_equal(len, -1, "send_flash past the area succeeded");
+	zassert_equal(errno, EINVAL, "unexpected errno %d", errno);
+
+	flash_area_close(fa);
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+#endif /* CONFIG_NET_SOCKETS_SENDFILE && CONFIG_FLASH_MAP */
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -801,6 +801,271 @@ ZTEST(net_socket_tls, test_v6_dtls_sendmsg)
 	test_dtls_sendmsg(AF_INET6);
 }
 
+static void test_tls_sendmsg_record(int sock, const void *expected,
+				    size_t len)
+{
+	uint8_t rx_buf[256];
+	int rv;
+
+	/* TLS recv() returns the data of a single record at most */
+	rv = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(rv, len, "unexpected record length %d", rv);
+	zassert_mem_equal(rx_buf, expected, len, "invalid rx data");
+}
+
+static void test_tls_sendmsg(sa_family_t family)
+{
+	static uint8_t large[200];
+	static uint8_t medium[100];
+	uint8_t expected[sizeof(medium) + sizeof(TEST_STR_SMALL) - 1];
+	struct iovec iov[] = {
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+		{},
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+		{
+			.iov_base = large,
+			.iov_len = sizeof(large),
+		},
+		{
+			.iov_base = medium,
+			.iov_len = sizeof(medium),
+		},
+		{
+			.iov_base = medium,
+			.iov_len = sizeof(medium),
+		},
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+	};
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+
+	for (int i = 0; i < sizeof(large); i++) {
+		large[i] = i;
+	}
+
+	for (int i = 0; i < sizeof(medium); i++) {
+		medium[i] = ~i;
+	}
+
+	test_prepare_tls_connection(family);
+
+	test_sendmsg(c_sock, &msg, 0);
+
+	/* Small buffers are merged, up to a buffer too large to be merged */
+	test_tls_sendmsg_record(new_sock, "testtest", 8);
+	test_tls_sendmsg_record(new_sock, large, sizeof(large));
+
+	/* A buffer that does not fit in the merged record starts a new one */
+	test_tls_sendmsg_record(new_sock, medium, sizeof(medium));
+
+	memcpy(expected, medium, sizeof(medium));
+	memcpy(expected + sizeof(medium), TEST_STR_SMALL,
+	       sizeof(TEST_STR_SMALL) - 1);
+	test_tls_sendmsg_record(new_sock, expected, sizeof(expected));
+
+	test_sockets_close();
+
+	/* Small delay for the final alert exchange */
+	k_msleep(10);
+}
+
+ZTEST(net_socket_tls, test_v4_tls_sendmsg)
+{
+	if (CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE != 128) {
+		ztest_test_skip();
+	}
+
+	test_tls_sendmsg(AF_INET);
+}
+
+ZTEST(net_socket_tls, test_v6_tls_sendmsg)
+{
+	if (CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE != 128) {
+		ztest_test_skip();
+	}
+
+	test_tls_sendmsg(AF_INET6);
+}
+
+/* The server switches to this key with the same identity, so that a full
+ * handshake fails and the client can only connect by resuming its session.
+ */
+#define PSK_TAG_OTHER 2
+
+static const unsigned char psk_other[] = {
+	0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
+	0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
+};
+
+struct ticket_connect_data {
+	struct k_work_delayable work;
+	int sock;
+	struct sockaddr *addr;
+	int ret;
+};
+
+static void ticket_connect_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct ticket_connect_data *data =
+		CONTAINER_OF(dwork, struct ticket_connect_data, work);
+
+	data->ret = zsock_connect(data->sock, data->addr,
+				  sizeof(struct sockaddr_in));
+}
+
+static void test_ticket_session(struct sockaddr *s_saddr, bool expect_success)
+{
+	struct sockaddr_in c_saddr;
+	struct ticket_connect_data test_data = {
+		.addr = s_saddr,
+		.ret = -1,
+	};
+	int optval = TLS_SESSION_CACHE_ENABLED;
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	int rv;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(-1, c_sock);
+
+	rv = zsock_setsockopt(c_sock, SOL_TLS, TLS_SESSION_CACHE, &optval,
+			      sizeof(optval));
+	zassert_equal(rv, 0, "Failed to enable session cache");
+
+	test_data.sock = c_sock;
+	k_work_init_delayable(&test_data.work, ticket_connect_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	new_sock = zsock_accept(s_sock, NULL, NULL);
+
+	test_work_wait(&test_data.work);
+
+	if (!expect_success) {
+		zassert_equal(new_sock, -1, "accept succeeded");
+		zassert_equal(test_data.ret, -1, "connect succeeded");
+	} else {
+		zassert_true(new_sock >= 0, "accept failed");
+		zassert_equal(test_data.ret, 0, "connect failed");
+
+		test_send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, 0);
+
+		rv = zsock_recv(new_sock, rx_buf, sizeof(rx_buf),
+				ZSOCK_MSG_WAITALL);
+		zassert_equal(rv, sizeof(rx_buf), "recv failed");
+		zassert_mem_equal(rx_buf, TEST_STR_SMALL, sizeof(rx_buf),
+				  "invalid rx data");
+
+		test_close(new_sock);
+		new_sock = -1;
+	}
+
+	test_close(c_sock);
+	c_sock = -1;
+
+	/* Small delay for the final alert exchange */
+	k_msleep(10);
+}
+
+ZTEST(net_socket_tls, test_session_ticket)
+{
+	static const uint8_t ticket_key[4 + 32] = "name";
+	sec_tag_t sec_tag_list[] = {
+		PSK_TAG_OTHER
+	};
+	struct sockaddr_in s_saddr;
+	socklen_t optlen = sizeof(int);
+	int optval;
+	int rv;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MBEDTLS_SSL_TICKET_C);
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(s_sock, -1);
+
+	rv = zsock_getsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKET, &optval,
+			      &optlen);
+	zassert_equal(rv, 0, "getsockopt failed");
+	zassert_equal(optval, TLS_SESSION_TICKET_DISABLED,
+		      "Session tickets enabled by default");
+
+	optval = TLS_SESSION_TICKET_ENABLED;
+	rv = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKET, &optval,
+			      sizeof(optval));
+	zassert_equal(rv, 0, "Failed to enable session tickets");
+
+	optval = TLS_SESSION_TICKET_DISABLED;
+	rv = zsock_getsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKET, &optval,
+			      &optlen);
+	zassert_equal(rv, 0, "getsockopt failed");
+	zassert_equal(optval, TLS_SESSION_TICKET_ENABLED,
+		      "Session tickets not enabled");
+
+	rv = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKET_KEY,
+			      ticket_key, sizeof(ticket_key) - 1);
+	zassert_equal(rv, -1, "Invalid ticket key accepted");
+	zassert_equal(errno, EINVAL, "Unexpected errno value: %d", errno);
+
+	rv = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_PURGE, NULL, 0);
+	zassert_equal(rv, 0, "Failed to purge session cache");
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	/* Full handshake, the client stores the session with its ticket */
+	test_ticket_session((struct sockaddr *)&s_saddr, true);
+
+	(void)tls_credential_delete(PSK_TAG_OTHER, TLS_CREDENTIAL_PSK);
+	(void)tls_credential_delete(PSK_TAG_OTHER, TLS_CREDENTIAL_PSK_ID);
+	zassert_equal(tls_credential_add(PSK_TAG_OTHER, TLS_CREDENTIAL_PSK,
+					 psk_other, sizeof(psk_other)),
+		      0, "Failed to register PSK");
+	zassert_equal(tls_credential_add(PSK_TAG_OTHER, TLS_CREDENTIAL_PSK_ID,
+					 psk_id, strlen(psk_id)),
+		      0, "Failed to register PSK ID");
+
+	rv = zsock_setsockopt(s_sock, SOL_TLS, TLS_SEC_TAG_LIST, sec_tag_list,
+			      sizeof(sec_tag_list));
+	zassert_equal(rv, 0, "Failed to set PSK on server socket");
+
+	/* The PSKs differ now, only the ticket lets the client in */
+	test_ticket_session((struct sockaddr *)&s_saddr, true);
+
+	/* The ticket is still accepted after a single key rotation */
+	rv = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKET_KEY, NULL, 0);
+	zassert_equal(rv, 0, "Failed to rotate ticket key");
+
+	test_ticket_session((struct sockaddr *)&s_saddr, true);
+
+	/* Two more rotations drop the key the ticket was issued with */
+	rv = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKET_KEY,
+			      ticket_key, sizeof(ticket_key));
+	zassert_equal(rv, 0, "Failed to set ticket key");
+
+	rv = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_TICKET_KEY, NULL, 0);
+	zassert_equal(rv, 0, "Failed to rotate ticket key");
+
+	test_ticket_session((struct sockaddr *)&s_saddr, false);
+
+	(void)zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_PURGE, NULL, 0);
+	(void)tls_credential_delete(PSK_TAG_OTHER, TLS_CREDENTIAL_PSK);
+	(void)tls_credential_delete(PSK_TAG_OTHER, TLS_CREDENTIAL_PSK_ID);
+
+	test_sockets_close();
+}
+
 struct close_data {
 	struct k_work_delayable work;
 	int *fd;
@@ -1083,6 +1348,161 @@ ZTEST(net_socket_tls, test_accept_invalid_handshake_data)
 	test_sockets_close();
 }
 
+static void test_prepare_handshake_offload(struct sockaddr_in6 *s_saddr)
+{
+	prepare_sock_tls_v6(MY_IPV6_ADDR, ANY_PORT, &s_sock, s_saddr,
+			    IPPROTO_TLS_1_2);
+
+	test_config_psk(s_sock, -1);
+	test_fcntl(s_sock, F_SETFL, O_NONBLOCK);
+	test_bind(s_sock, (struct sockaddr *)s_saddr, sizeof(*s_saddr));
+	test_listen(s_sock);
+}
+
+static void test_accept_handshake_offload(void)
+{
+	struct zsock_pollfd fds[1];
+	int ret;
+
+	fds[0].fd = s_sock;
+	fds[0].events = ZSOCK_POLLIN;
+
+	ret = zsock_poll(fds, 1, 1000);
+	zassert_equal(ret, 1, "poll() did not report incoming connection");
+
+	/* The handshake is left to a worker */
+	new_sock = zsock_accept(s_sock, NULL, NULL);
+	zassert_true(new_sock >= 0, "accept failed");
+}
+
+ZTEST(net_socket_tls, test_handshake_offload_close)
+{
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	struct sockaddr_in6 s_saddr;
+	struct sockaddr_in6 c_saddr;
+	struct zsock_pollfd fds[1];
+	uint32_t timestamp;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD);
+
+	test_prepare_handshake_offload(&s_saddr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock, &c_saddr);
+
+	/* Connect at TCP level only, the handshake waits for the client. */
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept_handshake_offload();
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "recv() did not report error");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	fds[0].fd = new_sock;
+	fds[0].events = ZSOCK_POLLIN | ZSOCK_POLLOUT;
+
+	ret = zsock_poll(fds, 1, 50);
+	zassert_equal(ret, 0, "poll() reported events during handshake");
+
+	/* close() aborts the handshake rather than waiting for its timeout */
+	timestamp = k_uptime_get_32();
+	test_close(new_sock);
+	new_sock = -1;
+	zassert_true(k_uptime_get_32() - timestamp < 1000,
+		     "close() waited for the handshake");
+
+	test_sockets_close();
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tls, test_handshake_offload_poll)
+{
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	struct sockaddr_in6 s_saddr;
+	struct sockaddr_in6 c_saddr;
+	struct connect_data test_data;
+	struct zsock_pollfd fds[1];
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD);
+
+	test_prepare_handshake_offload(&s_saddr);
+	prepare_sock_tls_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock, &c_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(-1, c_sock);
+
+	test_data.sock = c_sock;
+	test_data.addr = (struct sockaddr *)&s_saddr;
+	k_work_init_delayable(&test_data.work, client_connect_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	test_accept_handshake_offload();
+
+	/* POLLOUT is reported once the session is established */
+	fds[0].fd = new_sock;
+	fds[0].events = ZSOCK_POLLOUT;
+
+	ret = zsock_poll(fds, 1, 1000);
+	zassert_equal(ret, 1, "poll() did not report handshake completion");
+	zassert_equal(fds[0].revents, ZSOCK_POLLOUT, "Unexpected events %x",
+		      fds[0].revents);
+
+	test_work_wait(&test_data.work);
+
+	test_send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, 0);
+
+	fds[0].events = ZSOCK_POLLIN;
+
+	ret = zsock_poll(fds, 1, 1000);
+	zassert_equal(ret, 1, "poll() did not report data");
+	zassert_equal(fds[0].revents, ZSOCK_POLLIN, "Unexpected events %x",
+		      fds[0].revents);
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, sizeof(rx_buf), "recv failed");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, sizeof(rx_buf),
+			  "invalid rx data");
+
+	test_sockets_close();
+
+	/* Small delay for the final alert exchange */
+	k_msleep(10);
+}
+
+ZTEST(net_socket_tls, test_handshake_offload_pollerr)
+{
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	struct sockaddr_in6 s_saddr;
+	struct sockaddr_in6 c_saddr;
+	struct zsock_pollfd fds[1];
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_OFFLOAD);
+
+	test_prepare_handshake_offload(&s_saddr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock, &c_saddr);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept_handshake_offload();
+
+	/* Unexpected data fails the handshake run by the worker */
+	test_send(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL), 0);
+
+	fds[0].fd = new_sock;
+	fds[0].events = ZSOCK_POLLIN;
+
+	ret = zsock_poll(fds, 1, 1000);
+	zassert_equal(ret, 1, "poll() did not report handshake failure");
+	zassert_equal(fds[0].revents, ZSOCK_POLLERR, "Unexpected events %x",
+		      fds[0].revents);
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "recv() did not report error");
+	zassert_equal(errno, ECONNABORTED, "Unexpected errno value: %d", errno);
+
+	test_sockets_close();
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 ZTEST(net_socket_tls, test_recv_non_block)
 {
 	int ret;
@@ -2408,6 +2408,66 @@ ZTEST_USER(net_socket_udp, test_35_recvmsg_msg_controllen_update)
 	zassert_equal(rv, 0, "close failed");
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY_RECV)
+ZTEST(net_socket_udp, test_36_v4_recv_zero_copy)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	ssize_t len;
+	size_t copied = 0;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct zsock_zc_buf zc;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	len = zsock_recv_zc(server_sock, &zc, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(len, -1, "received from empty socket");
+	zassert_equal(errno, EAGAIN, "unexpected errno %d", errno);
+
+	len = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+			   (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid send len");
+
+	len = zsock_recv_zc(server_sock, &zc, 0, &addr, &addrlen);
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid recv len %d", (int)len);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "invalid addrlen");
+	zassert_equal(addr.sa_family, AF_INET, "invalid address family");
+	zassert_not_null(zc.pkt, "no packet");
+
+	/* The payload spans several fragments, walk them in place */
+	for (struct net_buf *frag = zc.frag; frag != NULL && copied < zc.len;
+	     frag = frag->frags) {
+		size_t frag_len = MIN(frag->len - zc.offset, zc.len - copied);
+
+		zassert_mem_equal(frag->data + zc.offset, TEST_STR2 + copied,
+				  frag_len, "wrong data");
+		copied += frag_len;
+		zc.offset = 0;
+	}
+
+	zassert_equal(copied, STRLEN(TEST_STR2), "data missing");
+
+	rv = zsock_recv_zc_release(server_sock, &zc);
+	zassert_equal(rv, 0, "release failed");
+	zassert_is_null(zc.pkt, "not cleared");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY_RECV */
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -136,6 +136,7 @@ static void handle_server_recv_out_of_order(struct net_pkt *pkt);
 static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
+static void handle_server_sack_test(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -246,7 +247,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if ((test_case_no == 4U || test_case_no == 18U) && (flags & SYN)) {
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -282,7 +283,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if ((test_case_no == 4U || test_case_no == 18U) && (flags & SYN)) {
 		th->th_off = 10U;
 	} else {
 		th->th_off = 5U;
@@ -301,7 +302,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if ((test_case_no == 4U || test_case_no == 18U) && (flags & SYN)) {
 		/* Add TCP Options */
 		ret = net_pkt_write(pkt, tcp_options, opts_len);
 		if (ret < 0) {
@@ -485,6 +486,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 17:
 		handle_client_fin_wait_2_failure_test(net_pkt_family(pkt), &th);
 		break;
+	case 18:
+		handle_server_sack_test(pkt);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -760,7 +764,7 @@ fail:
 static void test_server_timeout(struct k_work *work)
 {
 	if (test_case_no == 3 || test_case_no == 4 || test_case_no == 13 ||
-	    test_case_no == 14) {
+	    test_case_no == 14 || test_case_no == 18) {
 		handle_server_test(AF_INET, NULL);
 	} else if (test_case_no == 5) {
 		handle_server_test(AF_INET6, NULL);
@@ -2408,4 +2412,180 @@ ZTEST(net_tcp, test_client_rst_on_unexpected_ack_on_syn)
 	test_sem_take(K_MSEC(100), __LINE__);
 }
 
+static bool expect_sack_block;
+static uint32_t expected_sack_left;
+static uint32_t expected_sack_right;
+
+static const uint8_t *find_tcp_option(struct net_pkt *pkt, struct tcphdr *th,
+				      uint8_t *opts, uint8_t kind)
+{
+	size_t len = (th->th_off - 5U) * 4U;
+	size_t i;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 sizeof(struct tcphdr)) < 0 ||
+	    net_pkt_read(pkt, opts, len) < 0) {
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	for (i = 0; i < len && opts[i] != NET_TCP_END_OPT; ) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (opts[i] == kind) {
+			return &opts[i];
+		}
+
+		i += opts[i + 1];
+	}
+
+	return NULL;
+}
+
+static void handle_server_sack_test(struct net_pkt *pkt)
+{
+	uint8_t opts[40];
+	const uint8_t *opt;
+	struct tcphdr th;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	zassert_equal(ret, 0, "Cannot read TCP header");
+
+	if (t_state == T_SYN_ACK) {
+		opt = find_tcp_option(pkt, &th, opts, NET_TCP_SACK_PERM_OPT);
+		zassert_not_null(opt, "No SACK permitted option in SYN ACK");
+	}
+
+	if (t_state != T_DATA_ACK) {
+		handle_server_test(net_pkt_family(pkt), &th);
+		return;
+	}
+
+	test_verify_flags(&th, ACK);
+	zassert_equal(ntohl(th.th_ack), expected_ack,
+		      "Expected ACK %u but got %u", expected_ack,
+		      ntohl(th.th_ack));
+
+	opt = find_tcp_option(pkt, &th, opts, NET_TCP_SACK_OPT);
+	if (!expect_sack_block) {
+		zassert_is_null(opt, "Unexpected SACK option");
+		test_sem_give();
+		return;
+	}
+
+	zassert_not_null(opt, "No SACK option in ACK");
+	zassert_equal(opt[1], 2 + NET_TCP_SACK_BLOCK_SIZE,
+		      "Invalid SACK option length %u", opt[1]);
+	zassert_equal(ntohl(UNALIGNED_GET((uint32_t *)&opt[2])),
+		      expected_sack_left, "Invalid SACK block start");
+	zassert_equal(ntohl(UNALIGNED_GET((uint32_t *)&opt[6])),
+		      expected_sack_right, "Invalid SACK block end");
+
+	test_sem_give();
+}
+
+/* Test case scenario IPv4
+ *   Send SYN with SACK permitted option,
+ *   expect SYN ACK with SACK permitted option,
+ *   send ACK,
+ *   send out of order data,
+ *   expect ACK with a SACK block covering it,
+ *   send the missing data,
+ *   expect ACK for all data without SACK block.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_sack_ipv4)
+{
+	const uint8_t *data = lorem_ipsum;
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	uint32_t base;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) || CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	t_state = T_SYN;
+	test_case_no = 18;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	t_state = T_DATA_ACK;
+	base = seq;
+
+	/* Second segment first, the gap must be reported */
+	seq = base + 10;
+	expected_ack = base;
+	expect_sack_block = true;
+	expected_sack_left = base + 10;
+	expected_sack_right = base + 20;
+
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT),
+				  &data[10], 10);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Fill the gap, all the data is acknowledged */
+	seq = base;
+	expected_ack = base + 20;
+	expect_sack_block = false;
+
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT),
+				  data, 10);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(200), __LINE__);
+
+	/* Abort the connection, the closing handshake is not under test */
+	seq = base + 20;
+	pkt = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -0,0 +1,200 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_tx_sched_test, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_tx_sched.h>
+#include <net_private.h>
+
+#define ALLOC_TIMEOUT K_MSEC(500)
+#define WAIT_TIME K_MSEC(500)
+
+#define MS(x) ((x) * NSEC_PER_MSEC)
+
+static struct net_if *iface;
+static uint64_t sent_time;
+static K_SEM_DEFINE(sent_sem, 0, 1);
+
+static uint8_t net_iface_dummy_data;
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	sent_time = net_tx_sched_time(iface);
+	k_sem_give(&sent_sem);
+
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_tx_sched_test, "net_tx_sched_test", NULL, NULL,
+		&net_iface_dummy_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+static void send_pkt(uint64_t txtime)
+{
+	static const uint8_t data[16];
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(data), AF_UNSPEC, 0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)));
+
+	net_pkt_set_txtime(pkt, txtime);
+	net_if_queue_tx(iface, pkt);
+}
+
+ZTEST(net_tx_sched, test_gate_delay)
+{
+	struct net_tx_sched sched = {
+		.cycle_time = 1000,
+		.num_entries = 2,
+		.entries = {
+			{ .gate_mask = BIT(0), .interval = 300 },
+			{ .gate_mask = BIT(1), .interval = 700 },
+		},
+	};
+
+	zassert_equal(net_tx_sched_gate_delay(&sched, 0, 0), 0);
+	zassert_equal(net_tx_sched_gate_delay(&sched, 0, 299), 0);
+	zassert_equal(net_tx_sched_gate_delay(&sched, 0, 300), 700);
+	zassert_equal(net_tx_sched_gate_delay(&sched, 1, 5000), 300);
+	zassert_equal(net_tx_sched_gate_delay(&sched, 1, 999), 0);
+	zassert_equal(net_tx_sched_gate_delay(&sched, 2, 0), -1);
+
+	/* No frame started too close to the end of the window */
+	sched.guard_band = 50;
+	zassert_equal(net_tx_sched_gate_delay(&sched, 0, 260), 740);
+	zassert_equal(net_tx_sched_gate_delay(&sched, 1, 960), 340);
+
+	/* All open before the base time */
+	sched.base_time = 100000;
+	zassert_equal(net_tx_sched_gate_delay(&sched, 2, 10), 0);
+
+	/* A window across the end of the cycle */
+	sched.base_time = 0;
+	sched.guard_band = 300;
+	sched.num_entries = 3;
+	sched.entries[0].interval = 200;
+	sched.entries[1].interval = 600;
+	sched.entries[2].gate_mask = BIT(0);
+	sched.entries[2].interval = 200;
+	zassert_equal(net_tx_sched_gate_delay(&sched, 0, 850), 0);
+	zassert_equal(net_tx_sched_gate_delay(&sched, 0, 950), 850);
+}
+
+ZTEST(net_tx_sched, test_invalid)
+{
+	struct net_tx_sched sched = {
+		.cycle_time = 1000,
+		.num_entries = 0,
+	};
+
+	zassert_equal(net_tx_sched_set(iface, &sched), -EINVAL);
+
+	sched.num_entries = CONFIG_NET_TX_SCHED_MAX_ENTRIES + 1;
+	zassert_equal(net_tx_sched_set(iface, &sched), -EINVAL);
+
+	sched.num_entries = 1;
+	sched.cycle_time = 0;
+	zassert_equal(net_tx_sched_set(iface, &sched), -EINVAL);
+
+	zassert_ok(net_tx_sched_set(iface, NULL));
+}
+
+ZTEST(net_tx_sched, test_gated_send)
+{
+	struct net_tx_sched sched = {
+		.base_time = net_tx_sched_time(iface),
+		.cycle_time = MS(100),
+		.num_entries = 2,
+		.entries = {
+			{ .gate_mask = 0, .interval = MS(60) },
+			{ .gate_mask = BIT(0), .interval = MS(40) },
+		},
+	};
+	uint64_t offset;
+
+	zassert_ok(net_tx_sched_set(iface, &sched));
+
+	send_pkt(0);
+	zassert_ok(k_sem_take(&sent_sem, WAIT_TIME), "Packet not sent");
+
+	offset = (sent_time - sched.base_time) % sched.cycle_time;
+	zassert_true(offset >= MS(60), "Sent %llu ns into the cycle, gate closed", offset);
+
+	/* Gates open again without a schedule */
+	zassert_ok(net_tx_sched_set(iface, NULL));
+	send_pkt(0);
+	zassert_ok(k_sem_take(&sent_sem, WAIT_TIME), "Packet not sent");
+}
+
+ZTEST(net_tx_sched, test_closed_gate)
+{
+	struct net_tx_sched sched = {
+		.cycle_time = MS(100),
+		.num_entries = 1,
+		.entries = {
+			{ .gate_mask = BIT(1), .interval = MS(100) },
+		},
+	};
+
+	zassert_ok(net_tx_sched_set(iface, &sched));
+
+	/* The gate of the class never opens, the packet is dropped */
+	send_pkt(0);
+	zassert_equal(k_sem_take(&sent_sem, WAIT_TIME), -EAGAIN, "Packet sent");
+
+	zassert_ok(net_tx_sched_set(iface, NULL));
+}
+
+ZTEST(net_tx_sched, test_launch_time)
+{
+	uint64_t txtime = net_tx_sched_time(iface) + MS(50);
+
+	send_pkt(txtime);
+	zassert_ok(k_sem_take(&sent_sem, WAIT_TIME), "Packet not sent");
+	zassert_true(sent_time >= txtime, "Sent %llu ns early", txtime - sent_time);
+}
+
+static void *test_setup(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No interface");
+
+	return NULL;
+}
+
+static void test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&sent_sem);
+}
+
+ZTEST_SUITE(net_tx_sched, NULL, test_setup, test_before, NULL, NULL);
@@ -8,6 +8,7 @@
 #include <fcntl.h>
 #include <mqueue.h>
 #include <pthread.h>
+#include <unistd.h>
 
 #include <zephyr/sys/util.h>
 #include <zephyr/ztest.h>
@@ -276,6 +277,83 @@ ZTEST(mqueue, test_mqueue_notify_errors)
 	zassert_ok(mq_unlink(queue), "Unable to unlink queue");
 }
 
+ZTEST(mqueue, test_mqueue_priority)
+{
+	mqd_t mqd;
+	struct mq_attr attrs = {
+		.mq_msgsize = MESSAGE_SIZE,
+		.mq_maxmsg = MESG_COUNT_PERMQ,
+	};
+	static const struct {
+		char msg;
+		unsigned int prio;
+	} sent[] = {
+		{'a', 1}, {'b', 7}, {'c', 1}, {'d', MQ_PRIO_MAX - 1},
+	};
+	static const char received[] = "dbac";
+	unsigned int prio;
+	int32_t mode = 0777;
+	int flags = O_RDWR | O_CREAT | O_NONBLOCK;
+
+	mqd = mq_open(queue, flags, mode, &attrs);
+
+	zassert_not_ok(mq_send(mqd, send_data, 1, MQ_PRIO_MAX), "Priority should be invalid");
+	zassert_equal(errno, EINVAL);
+
+	for (int i = 0; i < ARRAY_SIZE(sent); i++) {
+		zassert_ok(mq_send(mqd, &sent[i].msg, 1, sent[i].prio), "Unable to send message");
+	}
+
+	zassert_not_ok(mq_send(mqd, send_data, 1, 0), "Queue should be full");
+	zassert_equal(errno, EAGAIN);
+
+	/* Highest priority first, first in first out within a priority */
+	for (int i = 0; i < ARRAY_SIZE(sent); i++) {
+		zassert_equal(mq_receive(mqd, rec_data, MESSAGE_SIZE, &prio), 1);
+		zassert_equal(rec_data[0], received[i]);
+	}
+	zassert_equal(prio, 1);
+
+	zassert_not_ok(mq_receive(mqd, rec_data, MESSAGE_SIZE, &prio), "Queue should be empty");
+	zassert_equal(errno, EAGAIN);
+
+	zassert_ok(mq_close(mqd), "Unable to close message queue descriptor.");
+	zassert_ok(mq_unlink(queue), "Unable to unlink queue");
+}
+
+#ifdef CONFIG_POSIX_MQUEUE_ZERO_COPY
+ZTEST(mqueue, test_mqueue_zero_copy)
+{
+	mqd_t mqd;
+	struct mq_attr attrs = {
+		.mq_msgsize = MESSAGE_SIZE,
+		.mq_maxmsg = MESG_COUNT_PERMQ,
+	};
+	unsigned int prio;
+	void *tx, *rx;
+	int32_t mode = 0777;
+	int flags = O_RDWR | O_CREAT | O_NONBLOCK;
+
+	mqd = mq_open(queue, flags, mode, &attrs);
+
+	zassert_ok(mq_send_claim_np(mqd, &tx, NULL), "Unable to claim message");
+	memcpy(tx, send_data, MESSAGE_SIZE);
+	zassert_ok(mq_send_commit_np(mqd, tx, MESSAGE_SIZE, 3), "Unable to commit message");
+
+	zassert_equal(mq_receive_claim_np(mqd, &rx, &prio, NULL), MESSAGE_SIZE);
+	zassert_equal(rx, tx, "Message should be received in place");
+	zassert_equal(prio, 3);
+	zassert_mem_equal(rx, send_data, MESSAGE_SIZE);
+	zassert_ok(mq_receive_release_np(mqd, rx), "Unable to release message");
+
+	zassert_not_ok(mq_receive_release_np(mqd, send_data), "Message should be invalid");
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(mq_close(mqd), "Unable to close message queue descriptor.");
+	zassert_ok(mq_unlink(queue), "Unable to unlink queue");
+}
+#endif /* CONFIG_POSIX_MQUEUE_ZERO_COPY */
+
 static void before(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -324,6 +324,41 @@ ZTEST(isotp_implementation, test_send_receive_single_block)
 	isotp_unbind(&recv_ctx);
 }
 
+ZTEST(isotp_implementation, test_send_receive_user_buf)
+{
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+	static uint8_t user_buf[sizeof(data_buf) * 2 + 10];
+	const size_t data_size = sizeof(user_buf);
+	int ret, i;
+
+	ret = isotp_bind(&recv_ctx, can_dev, &rx_addr, &tx_addr, &fc_opts,
+			 K_NO_WAIT);
+	zassert_equal(ret, 0, "Binding failed (%d)", ret);
+
+	for (i = 0; i < NUMBER_OF_REPETITIONS; i++) {
+		memset(user_buf, 0, sizeof(user_buf));
+		isotp_recv_set_buf(&recv_ctx, user_buf, sizeof(user_buf));
+		send_test_data(can_dev, random_data, data_size);
+
+		/* In one piece despite BS, already in place */
+		ret = isotp_recv(&recv_ctx, user_buf, sizeof(user_buf),
+				 K_MSEC(1000));
+		zassert_equal(ret, data_size,
+			      "data should be received at once (ret: %d)", ret);
+		check_data(user_buf, random_data, data_size);
+	}
+
+	/* Too large for the buffer, received into net-buffers */
+	isotp_recv_set_buf(&recv_ctx, user_buf, data_size - 1);
+	send_test_data(can_dev, random_data, data_size);
+	receive_test_data_net(&recv_ctx, random_data, data_size, 0);
+
+	isotp_unbind(&recv_ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST(isotp_implementation, test_bind_unbind)
 {
 	int ret, i;
@@ -0,0 +1,121 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/debug/profiler.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define BUSY_MS 500
+#define FREQUENCY 100
+
+static K_THREAD_STACK_DEFINE(busy_stack, STACK_SIZE);
+static struct k_thread busy_thread;
+
+struct folded_stats {
+	uint32_t total;
+	uint32_t busy;
+	uint32_t stacks;
+};
+
+static void busy(void *p1, void *p2, void *p3)
+{
+	k_busy_wait(BUSY_MS * USEC_PER_MSEC);
+}
+
+static void folded_count(const struct profiler_sample *sample, uint32_t count,
+			 void *user_data)
+{
+	struct folded_stats *stats = user_data;
+
+	zassert_true(count > 0);
+	zassert_true(sample->depth <= CONFIG_PROFILER_STACK_DEPTH);
+	zassert_true(sample->cpu < arch_num_cpus());
+
+	stats->total += count;
+	stats->stacks++;
+	if (sample->thread == &busy_thread) {
+		stats->busy += count;
+	}
+}
+
+ZTEST(profiler, test_frequency_range)
+{
+	zassert_equal(profiler_start(0), -EINVAL);
+	zassert_equal(profiler_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1), -EINVAL);
+	zassert_false(profiler_is_running());
+}
+
+ZTEST(profiler, test_busy_while_running)
+{
+	struct folded_stats stats = {0};
+
+	zassert_ok(profiler_start(FREQUENCY));
+	zassert_true(profiler_is_running());
+
+	/* Changing the frequency keeps sampling */
+	zassert_ok(profiler_start(FREQUENCY / 2));
+	zassert_true(profiler_is_running());
+
+	zassert_equal(profiler_reset(), -EBUSY);
+	zassert_equal(profiler_folded_foreach(folded_count, &stats), -EBUSY);
+
+	profiler_stop();
+	zassert_false(profiler_is_running());
+}
+
+ZTEST(profiler, test_busy_thread)
+{
+	struct folded_stats stats = {0};
+	uint32_t expected = BUSY_MS * FREQUENCY / MSEC_PER_SEC;
+	int ret;
+
+	k_thread_create(&busy_thread, busy_stack, STACK_SIZE, busy, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(5), 0, K_FOREVER);
+	k_thread_name_set(&busy_thread, "busy");
+
+	zassert_ok(profiler_start(FREQUENCY));
+	k_thread_start(&busy_thread);
+	k_thread_join(&busy_thread, K_FOREVER);
+	profiler_stop();
+
+	ret = profiler_folded_foreach(folded_count, &stats);
+	zassert_equal(ret, stats.total);
+	zassert_true(stats.stacks <= stats.total);
+	zassert_equal(profiler_dropped_get(), 0);
+
+	/* Nearly all samples are taken while the busy thread runs */
+	zassert_within(stats.total, expected * arch_num_cpus(), expected / 5,
+		       "%u samples", stats.total);
+	zassert_true(stats.busy >= expected * 4 / 5, "%u of %u samples in busy thread",
+		     stats.busy, stats.total);
+}
+
+ZTEST(profiler, test_dropped)
+{
+	struct folded_stats stats = {0};
+
+	zassert_ok(profiler_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC));
+	k_sleep(K_TICKS(2 * CONFIG_PROFILER_SAMPLE_COUNT));
+	profiler_stop();
+
+	zassert_equal(profiler_folded_foreach(folded_count, &stats),
+		      CONFIG_PROFILER_SAMPLE_COUNT);
+	zassert_equal(stats.total, CONFIG_PROFILER_SAMPLE_COUNT);
+	zassert_true(profiler_dropped_get() > 0);
+
+	zassert_ok(profiler_reset());
+	zassert_equal(profiler_folded_foreach(folded_count, &stats), 0);
+	zassert_equal(profiler_dropped_get(), 0);
+}
+
+static void profiler_before(void *fixture)
+{
+	profiler_stop();
+	zassert_ok(profiler_reset());
+}
+
+ZTEST_SUITE(profiler, NULL, NULL, profiler_before, NULL, NULL);
@@ -165,4 +165,59 @@ ZTEST(img_util, test_check_flash)
 	flash_area_close(ctx.flash_area);
 }
 
+#ifdef CONFIG_IMG_STREAM_HASH
+ZTEST(img_util, test_check_written)
+{
+	/* sha256 of the 1500 bytes 0x00, 0x01, ... 0xff, 0x00, ... */
+	uint8_t tst_sha[] = { 0x25, 0x3e, 0x4e, 0x13, 0x15, 0xe8, 0x87, 0x18,
+			      0xb8, 0xf3, 0xb6, 0xca, 0x3c, 0x05, 0xce, 0x76,
+			      0x4d, 0xba, 0xc8, 0x18, 0x1b, 0xce, 0xf8, 0xec,
+			      0xa3, 0x55, 0x1f, 0xf9, 0x4a, 0x56, 0x1b, 0xac };
+	struct flash_img_check fic = { tst_sha, 1500 };
+	struct flash_img_context ctx;
+	uint8_t data[7];
+	size_t written = 0;
+	uint8_t k = 0U;
+	int ret;
+
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	/* Chunks that do not line up with the write buffer */
+	while (written < fic.clen) {
+		size_t len = MIN(sizeof(data), fic.clen - written);
+
+		for (size_t j = 0; j < len; j++) {
+			data[j] = k++;
+		}
+		ret = flash_img_buffered_write(&ctx, data, len, false);
+		zassert_true(ret == 0, "image collection fail: %d", ret);
+		written += len;
+	}
+
+	/* What is still buffered is not hashed yet */
+	ret = flash_img_check_written(&ctx, &fic);
+	zassert_equal(ret, -ENODATA, "Hash of unflushed data");
+
+	ret = flash_img_buffered_write(&ctx, data, 0, true);
+	zassert_true(ret == 0, "Flash img flush");
+
+	ret = flash_img_check_written(&ctx, &fic);
+	zassert_equal(ret, 0, "Flash img check written");
+	ret = flash_img_check(&ctx, &fic, SLOT1_PARTITION_ID);
+	zassert_equal(ret, 0, "Flash img check");
+
+	fic.clen--;
+	ret = flash_img_check_written(&ctx, &fic);
+	zassert_equal(ret, -ENODATA, "Flash img check written len");
+	fic.clen++;
+
+	tst_sha[0] = 0x00;
+	ret = flash_img_check_written(&ctx, &fic);
+	zassert_equal(ret, -EILSEQ, "Flash img check written wrong sha");
+}
+#endif
+
 ZTEST_SUITE(img_util, NULL, NULL, NULL, NULL, NULL);
@@ -187,6 +187,86 @@ static int seek_within_hello(const struct fs_mount_t *mp)
 	return TC_PASS;
 }
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+static int buffered_hello(const struct fs_mount_t *mp)
+{
+	struct testfs_path path;
+	struct fs_file_t file;
+	uint8_t buf[32];
+	uint8_t data[8];
+
+	fs_file_t_init(&file);
+	TC_PRINT("buffered read, seek and write in file\n");
+
+	zassert_equal(fs_open(&file,
+			      testfs_path_init(&path, mp,
+					       HELLO,
+					       TESTFS_PATH_END),
+			      FS_O_CREATE | FS_O_RDWR),
+		      0,
+		      "buffered hello open failed");
+
+	zassert_equal(fs_setbuf(&file, buf, sizeof(buf)), 0,
+		      "buffered hello setbuf failed");
+
+	/* Reads smaller than the buffer */
+	for (unsigned int i = 0; i < TESTFS_BUFFER_SIZE; i += sizeof(data)) {
+		zassert_equal(fs_read(&file, data, sizeof(data)), sizeof(data),
+			      "buffered hello read failed");
+
+		for (unsigned int j = 0; j < sizeof(data); j++) {
+			zassert_equal(data[j], (uint8_t)(i + j),
+				      "buffered hello bad data");
+		}
+	}
+
+	zassert_equal(fs_tell(&file), TESTFS_BUFFER_SIZE,
+		      "buffered hello read tell failed");
+
+	/* Back into the data read ahead, then rewrite it with small writes */
+	zassert_equal(fs_seek(&file, -(off_t)sizeof(data), FS_SEEK_CUR),
+		      0,
+		      "buffered hello seek back failed");
+
+	zassert_equal(fs_tell(&file), TESTFS_BUFFER_SIZE - sizeof(data),
+		      "buffered hello seek back tell failed");
+
+	zassert_equal(testfs_verify_incrementing(&file, TESTFS_BUFFER_SIZE - sizeof(data),
+						 sizeof(data)),
+		      sizeof(data),
+		      "buffered hello verify after seek failed");
+
+	zassert_equal(fs_seek(&file, 0, FS_SEEK_SET),
+		      0,
+		      "buffered hello seek start failed");
+
+	for (unsigned int i = 0; i < TESTFS_BUFFER_SIZE; i += sizeof(data)) {
+		for (unsigned int j = 0; j < sizeof(data); j++) {
+			data[j] = i + j;
+		}
+
+		zassert_equal(fs_write(&file, data, sizeof(data)), sizeof(data),
+			      "buffered hello write failed");
+	}
+
+	zassert_equal(fs_tell(&file), TESTFS_BUFFER_SIZE,
+		      "buffered hello write tell failed");
+
+	zassert_equal(fs_seek(&file, 0, FS_SEEK_SET),
+		      0,
+		      "buffered hello seek after write failed");
+
+	zassert_equal(testfs_verify_incrementing(&file, 0, TESTFS_BUFFER_SIZE),
+		      TESTFS_BUFFER_SIZE,
+		      "buffered hello verify written failed");
+
+	zassert_equal(fs_close(&file), 0,
+		      "buffered hello close failed");
+
+	return TC_PASS;
+}
+#endif /* CONFIG_FILE_SYSTEM_BUFFERED */
+
 static int truncate_hello(const struct fs_mount_t *mp)
 {
 	struct testfs_path path;
@@ -383,6 +463,11 @@ void test_fs_basic(void)
 	zassert_equal(seek_within_hello(fs_basic_test_mp), TC_PASS,
 		      "seek within hello failed");
 
+#ifdef CONFIG_FILE_SYSTEM_BUFFERED
+	zassert_equal(buffered_hello(fs_basic_test_mp), TC_PASS,
+		      "buffered hello failed");
+#endif
+
 	zassert_equal(truncate_hello(fs_basic_test_mp), TC_PASS,
 		      "truncate hello failed");
 
@@ -19,6 +19,12 @@ static void *fat_fs_basic_setup(void)
 	test_fat_fs();
 	test_fat_rename();
 	test_fs_open_flags();
+#ifdef CONFIG_FILE_SYSTEM_READ_DIRECT
+	test_fat_read_direct();
+#endif /* CONFIG_FILE_SYSTEM_READ_DIRECT */
+#ifdef CONFIG_FILE_SYSTEM_RTIO
+	test_fat_rtio();
+#endif /* CONFIG_FILE_SYSTEM_RTIO */
 #ifdef CONFIG_FS_FATFS_REENTRANT
 	test_fat_file_reentrant();
 #endif /* CONFIG_FS_FATFS_REENTRANT */
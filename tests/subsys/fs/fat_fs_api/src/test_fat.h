@@ -46,6 +46,12 @@ void test_fat_file(void);
 void test_fat_dir(void);
 void test_fat_fs(void);
 void test_fat_rename(void);
+#ifdef CONFIG_FILE_SYSTEM_READ_DIRECT
+void test_fat_read_direct(void);
+#endif /* CONFIG_FILE_SYSTEM_READ_DIRECT */
+#ifdef CONFIG_FILE_SYSTEM_RTIO
+void test_fat_rtio(void);
+#endif /* CONFIG_FILE_SYSTEM_RTIO */
 #ifdef CONFIG_FS_FATFS_REENTRANT
 void test_fat_file_reentrant(void);
 #endif /* CONFIG_FS_FATFS_REENTRANT */
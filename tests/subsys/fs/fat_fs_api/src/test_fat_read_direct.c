@@ -0,0 +1,106 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_fat.h"
+#include <string.h>
+
+#define TEST_DIRECT_FILE	FATFS_MNTP"/direct.bin"
+#define TEST_DIRECT_GAP_FILE	FATFS_MNTP"/gap.bin"
+#define TEST_DIRECT_PART	1536
+
+static uint8_t test_data[2 * TEST_DIRECT_PART];
+static uint8_t read_buf[sizeof(test_data)];
+
+static void write_part(const char *path, const uint8_t *data, size_t size)
+{
+	struct fs_file_t file;
+	ssize_t brw;
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, path, FS_O_CREATE | FS_O_WRITE | FS_O_APPEND),
+		   "Failed to open %s", path);
+	brw = fs_write(&file, data, size);
+	zassert_equal(brw, size, "Failed to write %s [%zd]", path, brw);
+	zassert_ok(fs_close(&file), "Failed to close %s", path);
+}
+
+/* Reads the whole file in place, checking each part read against test_data */
+static void read_in_place(struct fs_file_t *file, size_t size)
+{
+	const void *ptr;
+	size_t total = 0;
+	ssize_t brw;
+
+	while (total < size) {
+		brw = fs_read_direct(file, &ptr, NULL, sizeof(read_buf));
+		zassert_true(brw > 0, "Failed to read in place at %zu [%zd]", total, brw);
+		zassert_true((ptr < (const void *)read_buf) ||
+			     (ptr >= (const void *)&read_buf[sizeof(read_buf)]),
+			     "Data not read in place");
+		zassert_mem_equal(ptr, &test_data[total], brw, "Wrong data at %zu", total);
+		total += brw;
+	}
+
+	zassert_equal(total, size, "Read %zu bytes of %zu", total, size);
+	brw = fs_read_direct(file, &ptr, NULL, sizeof(read_buf));
+	zassert_equal(brw, 0, "Read past the end of file [%zd]", brw);
+}
+
+void test_fat_read_direct(void)
+{
+	struct fs_file_t file;
+	const void *ptr;
+	ssize_t brw;
+
+	TC_PRINT("\nDirect read tests:\n");
+
+	for (size_t i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = (uint8_t)(i * 7 + i / 256);
+	}
+
+	(void)fs_unlink(TEST_DIRECT_FILE);
+	(void)fs_unlink(TEST_DIRECT_GAP_FILE);
+
+	/* A file of two fragments, with the clusters of another one in between */
+	write_part(TEST_DIRECT_FILE, test_data, TEST_DIRECT_PART);
+	write_part(TEST_DIRECT_GAP_FILE, test_data, TEST_DIRECT_PART);
+	write_part(TEST_DIRECT_FILE, &test_data[TEST_DIRECT_PART], TEST_DIRECT_PART);
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, TEST_DIRECT_FILE, FS_O_READ), "Failed to open file");
+
+	read_in_place(&file, sizeof(test_data));
+
+	/* From the middle of the second fragment */
+	zassert_ok(fs_seek(&file, TEST_DIRECT_PART + 100, FS_SEEK_SET), "Failed to seek");
+	brw = fs_read_direct(&file, &ptr, NULL, 10);
+	zassert_equal(brw, 10, "Failed to read in place [%zd]", brw);
+	zassert_mem_equal(ptr, &test_data[TEST_DIRECT_PART + 100], 10, "Wrong data");
+	zassert_equal(fs_tell(&file), TEST_DIRECT_PART + 110, "Wrong file position");
+
+	/* Reads still work after reading in place */
+	brw = fs_read(&file, read_buf, 10);
+	zassert_equal(brw, 10, "Failed to read [%zd]", brw);
+	zassert_mem_equal(read_buf, &test_data[TEST_DIRECT_PART + 110], 10, "Wrong data");
+
+	zassert_ok(fs_close(&file), "Failed to close file");
+
+	/* Files open for writing are copied */
+	zassert_ok(fs_open(&file, TEST_DIRECT_FILE, FS_O_RDWR), "Failed to open file");
+
+	brw = fs_read_direct(&file, &ptr, NULL, sizeof(read_buf));
+	zassert_equal(brw, -ENOTSUP, "Read in place a file open for writing [%zd]", brw);
+
+	brw = fs_read_direct(&file, &ptr, read_buf, sizeof(read_buf));
+	zassert_equal(brw, sizeof(test_data), "Failed to read [%zd]", brw);
+	zassert_equal_ptr(ptr, read_buf, "Data not copied");
+	zassert_mem_equal(read_buf, test_data, sizeof(test_data), "Wrong data");
+
+	zassert_ok(fs_close(&file), "Failed to close file");
+
+	zassert_ok(fs_unlink(TEST_DIRECT_FILE), "Failed to delete file");
+	zassert_ok(fs_unlink(TEST_DIRECT_GAP_FILE), "Failed to delete file");
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_fat.h"
+#include <string.h>
+#include <zephyr/fs/fs_rtio.h>
+
+#define TEST_RTIO_FILE		FATFS_MNTP"/rtio.bin"
+#define TEST_RTIO_BLK_SIZE	64
+#define TEST_RTIO_SIZE		(4 * TEST_RTIO_BLK_SIZE)
+
+FS_RTIO_IODEV_DEFINE(fat_rtio_iodev);
+RTIO_DEFINE_WITH_MEMPOOL(fat_rtio, 4, 4, 8, TEST_RTIO_BLK_SIZE, 4);
+
+static uint8_t test_data[TEST_RTIO_SIZE];
+static uint8_t read_buf[TEST_RTIO_SIZE];
+
+/* Consume the next completion, checking its result and user data */
+static void consume_cqe(int result, void *userdata)
+{
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	cqe = rtio_cqe_consume_block(&fat_rtio);
+	zassert_equal(cqe->result, result, "Completion result %d, expected %d",
+		      cqe->result, result);
+	zassert_equal_ptr(cqe->userdata, userdata, "Wrong completion");
+
+	if (rtio_cqe_get_mempool_buffer(&fat_rtio, cqe, &buf, &buf_len) == 0) {
+		rtio_release_buffer(&fat_rtio, buf, buf_len);
+	}
+
+	rtio_cqe_release(&fat_rtio, cqe);
+}
+
+/* Seek to the start of the file and read or write it in one transaction */
+static void seek_rw(uint8_t op, uint8_t *buf)
+{
+	struct rtio_sqe *seek = rtio_sqe_acquire(&fat_rtio);
+	struct rtio_sqe *rw = rtio_sqe_acquire(&fat_rtio);
+
+	zassert_not_null(seek, "No submission left");
+	zassert_not_null(rw, "No submission left");
+
+	fs_rtio_prep_seek(seek, &fat_rtio_iodev, 0, seek);
+	seek->flags |= RTIO_SQE_TRANSACTION;
+	if (op == RTIO_OP_TX) {
+		rtio_sqe_prep_write(rw, &fat_rtio_iodev, RTIO_PRIO_NORM, buf,
+				    TEST_RTIO_SIZE, rw);
+	} else {
+		rtio_sqe_prep_read(rw, &fat_rtio_iodev, RTIO_PRIO_NORM, buf,
+				   TEST_RTIO_SIZE, rw);
+	}
+
+	zassert_ok(rtio_submit(&fat_rtio, 2), "Failed to submit");
+	consume_cqe(0, seek);
+	consume_cqe(TEST_RTIO_SIZE, rw);
+}
+
+/* Multishot read from the memory pool, one block at a time, up to the end of file */
+static void read_multishot(void)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&fat_rtio);
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	zassert_not_null(sqe, "No submission left");
+	fs_rtio_prep_seek(sqe, &fat_rtio_iodev, 0, sqe);
+	zassert_ok(rtio_submit(&fat_rtio, 1), "Failed to submit");
+	consume_cqe(0, sqe);
+
+	sqe = rtio_sqe_acquire(&fat_rtio);
+	zassert_not_null(sqe, "No submission left");
+	rtio_sqe_prep_read_multishot(sqe, &fat_rtio_iodev, RTIO_PRIO_NORM, sqe);
+	zassert_ok(rtio_submit(&fat_rtio, 0), "Failed to submit");
+
+	for (size_t offset = 0; offset < TEST_RTIO_SIZE; offset += TEST_RTIO_BLK_SIZE) {
+		cqe = rtio_cqe_consume_block(&fat_rtio);
+		zassert_equal(cqe->result, TEST_RTIO_BLK_SIZE, "Read %d bytes at %zu",
+			      cqe->result, offset);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&fat_rtio, cqe, &buf, &buf_len),
+			   "No buffer from the memory pool");
+		zassert_mem_equal(buf, &test_data[offset], TEST_RTIO_BLK_SIZE,
+				  "Wrong data at %zu", offset);
+		rtio_release_buffer(&fat_rtio, buf, buf_len);
+		rtio_cqe_release(&fat_rtio, cqe);
+	}
+
+	/* The end of file completes the read, which is not submitted again */
+	consume_cqe(-ENODATA, sqe);
+	k_msleep(100);
+	zassert_is_null(rtio_cqe_consume(&fat_rtio), "Read submitted after the end of file");
+}
+
+void test_fat_rtio(void)
+{
+	struct fs_file_t file;
+	struct rtio_sqe *sqe;
+
+	TC_PRINT("\nRTIO iodev tests:\n");
+
+	for (size_t i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = (uint8_t)(i * 3 + i / TEST_RTIO_BLK_SIZE);
+	}
+
+	(void)fs_unlink(TEST_RTIO_FILE);
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, TEST_RTIO_FILE, FS_O_CREATE | FS_O_RDWR),
+		   "Failed to open file");
+	fs_rtio_iodev_set(&fat_rtio_iodev, &file);
+
+	seek_rw(RTIO_OP_TX, test_data);
+	zassert_equal(fs_tell(&file), TEST_RTIO_SIZE, "Wrong file position");
+
+	memset(read_buf, 0, sizeof(read_buf));
+	seek_rw(RTIO_OP_RX, read_buf);
+	zassert_mem_equal(read_buf, test_data, sizeof(test_data), "Wrong data");
+
+	read_multishot();
+
+	fs_rtio_iodev_set(&fat_rtio_iodev, NULL);
+	zassert_ok(fs_close(&file), "Failed to close file");
+
+	/* Submissions fail without a file */
+	sqe = rtio_sqe_acquire(&fat_rtio);
+	zassert_not_null(sqe, "No submission left");
+	rtio_sqe_prep_read(sqe, &fat_rtio_iodev, RTIO_PRIO_NORM, read_buf,
+			   sizeof(read_buf), sqe);
+	zassert_ok(rtio_submit(&fat_rtio, 1), "Failed to submit");
+	consume_cqe(-EBADF, sqe);
+
+	zassert_ok(fs_unlink(TEST_RTIO_FILE), "Failed to delete file");
+}
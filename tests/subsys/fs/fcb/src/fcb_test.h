@@ -40,6 +40,10 @@ uint8_t fcb_test_append_data(int msg_len, int off);
 int fcb_test_data_walk_cb(struct fcb_entry_ctx *entry_ctx, void *arg);
 int fcb_test_cnt_elems_cb(struct fcb_entry_ctx *entry_ctx, void *arg);
 
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+int fcb_test_key_hash(struct fcb *fcb, const struct fcb_entry *loc, uint32_t *hash);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+
+/* The key of an element is its first byte */
+int fcb_test_key_hash(struct fcb *fcb, const struct fcb_entry *loc, uint32_t *hash)
+{
+	uint8_t key;
+
+	if (loc->fe_data_len == 0U) {
+		return -EINVAL;
+	}
+
+	if (flash_area_read(fcb->fap, FCB_ENTRY_FA_DATA_OFF((*loc)), &key, 1)) {
+		return -EIO;
+	}
+
+	*hash = key * 2654435761U;
+	return 0;
+}
+
+static void fcb_test_summary_append(struct fcb *fcb, uint8_t key, uint16_t len)
+{
+	uint8_t test_data[128];
+	struct fcb_entry loc;
+
+	(void)memset(test_data, key, sizeof(test_data));
+	zassert_ok(fcb_append(fcb, len, &loc), "fcb_append call failure");
+	zassert_ok(flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc), test_data, len),
+		   "flash_area_write call failure");
+	zassert_ok(fcb_append_finish(fcb, &loc), "fcb_append_finish call failure");
+}
+
+static int fcb_test_key_cnt(struct fcb *fcb, uint8_t key, bool skip)
+{
+	struct fcb_entry loc = {0};
+	uint8_t data;
+	int cnt = 0;
+
+	while ((skip ? fcb_getnext_key(fcb, &loc, key * 2654435761U) :
+		       fcb_getnext(fcb, &loc)) == 0) {
+		zassert_ok(flash_area_read(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc), &data, 1));
+		if (data == key) {
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
+static void fcb_test_summary_check(struct fcb *fcb)
+{
+	int cnts[4] = {0};
+	struct append_arg aa_arg = {
+		.elem_cnts = cnts
+	};
+
+	zassert_ok(fcb_walk(fcb, NULL, fcb_test_cnt_elems_cb, &aa_arg));
+	for (int i = 0; i < fcb->f_sector_cnt; i++) {
+		zassert_equal(fcb->f_summary[i].fs_count, cnts[i],
+			      "summary count of sector %d", i);
+	}
+
+	for (int key = 0; key < 6; key++) {
+		zassert_equal(fcb_test_key_cnt(fcb, key, true),
+			      fcb_test_key_cnt(fcb, key, false),
+			      "lookup of key %d", key);
+	}
+	zassert_equal(fcb_test_key_cnt(fcb, 200, true), 1, "lookup of unique key");
+}
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_sector_summary)
+{
+	struct fcb *fcb = &test_fcb;
+	struct fcb_entry active;
+
+	/* Fill more than two sectors, with a unique key in the second one */
+	for (int i = 0; fcb->f_active.fe_sector != &test_fcb_sector[2]; i++) {
+		fcb_test_summary_append(fcb, i % 5, 100);
+		if (i == 200) {
+			fcb_test_summary_append(fcb, 200, 64);
+		}
+	}
+	fcb_test_summary_append(fcb, 0, 0);
+	fcb_test_summary_check(fcb);
+
+	/* The summaries built by fcb_init are the same */
+	active = fcb->f_active;
+	(void)memset(fcb->f_summary, 0, 4 * sizeof(fcb->f_summary[0]));
+	zassert_ok(fcb_init(TEST_FCB_FLASH_AREA_ID, fcb), "fcb_init call failure");
+	zassert_equal(fcb->f_active.fe_sector, active.fe_sector);
+	zassert_equal(fcb->f_active.fe_elem_off, active.fe_elem_off);
+	fcb_test_summary_check(fcb);
+
+	/* Rotated out sectors are skipped */
+	zassert_ok(fcb_rotate(fcb), "fcb_rotate call failure");
+	zassert_equal(fcb->f_summary[0].fs_count, 0);
+	fcb_test_summary_check(fcb);
+}
+
+#endif /* CONFIG_FCB_SECTOR_SUMMARY */
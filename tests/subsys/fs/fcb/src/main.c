@@ -13,7 +13,16 @@
 #include <zephyr/drivers/flash.h>
 #include <zephyr/device.h>
 
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+static struct fcb_sector_summary test_fcb_summary[4];
+
+struct fcb test_fcb = {
+	.f_summary = test_fcb_summary,
+	.f_key_hash = fcb_test_key_hash,
+};
+#else
 struct fcb test_fcb = {0};
+#endif
 struct fcb test_fcb_crc_disabled = { .f_flags = FCB_FLAGS_CRC_DISABLED };
 
 uint8_t fcb_test_erase_value;
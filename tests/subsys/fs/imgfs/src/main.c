@@ -0,0 +1,162 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+
+#define MNT "/rom"
+
+static const uint8_t __aligned(16) image[] = {
+#include "image.imgfs.inc"
+};
+
+static const uint8_t lorem[] = {
+#include "lorem.txt.inc"
+};
+
+static struct fs_mount_t mnt = {
+	.type = FS_IMGFS,
+	.mnt_point = MNT,
+	.storage_dev = (void *)image,
+	.flags = FS_MOUNT_FLAG_READ_ONLY,
+};
+
+static uint8_t buf[sizeof(lorem)];
+
+static void *imgfs_setup(void)
+{
+	zassert_ok(fs_mount(&mnt));
+
+	return NULL;
+}
+
+static void imgfs_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(fs_unmount(&mnt));
+}
+
+ZTEST(imgfs, test_stat)
+{
+	struct fs_dirent entry;
+
+	zassert_ok(fs_stat(MNT "/docs/lorem.txt", &entry));
+	zassert_equal(entry.type, FS_DIR_ENTRY_FILE);
+	zassert_equal(entry.size, sizeof(lorem));
+	zassert_equal(strcmp(entry.name, "lorem.txt"), 0);
+
+	zassert_ok(fs_stat(MNT "/docs", &entry));
+	zassert_equal(entry.type, FS_DIR_ENTRY_DIR);
+
+	zassert_equal(fs_stat(MNT "/docs/missing.txt", &entry), -ENOENT);
+	zassert_equal(fs_stat(MNT "/hello.txt/docs", &entry), -ENOENT);
+}
+
+ZTEST(imgfs, test_read)
+{
+	struct fs_file_t file;
+	size_t offs[] = { 0, 1, 511, 512, 513, 1500, sizeof(lorem) - 7 };
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, MNT "/docs/lorem.txt", FS_O_READ));
+
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), sizeof(lorem));
+	zassert_mem_equal(buf, lorem, sizeof(lorem));
+	zassert_equal(fs_read(&file, buf, sizeof(buf)), 0);
+
+	/* Reads that start and end within blocks */
+	for (size_t i = 0; i < ARRAY_SIZE(offs); i++) {
+		size_t len = MIN(100, sizeof(lorem) - offs[i]);
+
+		zassert_ok(fs_seek(&file, offs[i], FS_SEEK_SET));
+		zassert_equal(fs_read(&file, buf, 100), len);
+		zassert_mem_equal(buf, lorem + offs[i], len);
+		zassert_equal(fs_tell(&file), offs[i] + len);
+	}
+
+	zassert_ok(fs_seek(&file, -10, FS_SEEK_END));
+	zassert_equal(fs_read(&file, buf, 100), 10);
+	zassert_equal(fs_seek(&file, 1, FS_SEEK_END), -EINVAL);
+
+	zassert_ok(fs_close(&file));
+}
+
+ZTEST(imgfs, test_read_direct)
+{
+	struct fs_file_t file;
+	const void *ptr;
+	size_t size = 0;
+	ssize_t rc;
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, MNT "/raw/table.txt", FS_O_READ));
+
+	/* Uncompressed files are read in place, from the image */
+	zassert_equal(fs_read_direct(&file, &ptr, NULL, 16), 16);
+	zassert_true((const uint8_t *)ptr >= image &&
+		     (const uint8_t *)ptr < image + sizeof(image));
+	zassert_mem_equal(ptr, "0000 00000000 lo", 16);
+
+	zassert_ok(fs_close(&file));
+
+	/* Whatever the compression, the data is the same */
+	zassert_ok(fs_open(&file, MNT "/docs/lorem.txt", FS_O_READ));
+	while ((rc = fs_read_direct(&file, &ptr, buf, 300)) > 0) {
+		zassert_mem_equal(ptr, lorem + size, rc);
+		size += rc;
+	}
+	zassert_equal(rc, 0);
+	zassert_equal(size, sizeof(lorem));
+
+	zassert_ok(fs_close(&file));
+}
+
+ZTEST(imgfs, test_dir)
+{
+	const char *names[] = { "docs", "raw", "hello.txt" };
+	struct fs_dir_t dir;
+	struct fs_dirent entry;
+	int count = 0;
+
+	fs_dir_t_init(&dir);
+	zassert_ok(fs_opendir(&dir, MNT));
+
+	while (fs_readdir(&dir, &entry) == 0 && entry.name[0] != '\0') {
+		bool found = false;
+
+		for (size_t i = 0; i < ARRAY_SIZE(names); i++) {
+			found |= (strcmp(entry.name, names[i]) == 0);
+		}
+		zassert_true(found, "unexpected entry %s", entry.name);
+		count++;
+	}
+	zassert_equal(count, ARRAY_SIZE(names));
+
+	zassert_ok(fs_closedir(&dir));
+
+	zassert_ok(fs_opendir(&dir, MNT "/docs"));
+	zassert_ok(fs_readdir(&dir, &entry));
+	zassert_equal(strcmp(entry.name, "lorem.txt"), 0);
+	zassert_ok(fs_readdir(&dir, &entry));
+	zassert_equal(entry.name[0], '\0');
+	zassert_ok(fs_closedir(&dir));
+
+	zassert_equal(fs_opendir(&dir, MNT "/hello.txt"), -ENOTDIR);
+}
+
+ZTEST(imgfs, test_read_only)
+{
+	struct fs_file_t file;
+
+	fs_file_t_init(&file);
+	zassert_equal(fs_open(&file, MNT "/hello.txt", FS_O_RDWR), -EROFS);
+	zassert_equal(fs_open(&file, MNT "/new.txt", FS_O_CREATE | FS_O_WRITE), -EROFS);
+	zassert_equal(fs_unlink(MNT "/hello.txt"), -EROFS);
+}
+
+ZTEST_SUITE(imgfs, NULL, imgfs_setup, NULL, NULL, imgfs_teardown);
@@ -934,3 +934,163 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 
 #endif
 }
+
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg,
+				     const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **) arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+/*
+ * Test that with the lookup index, reads of ids written over several sectors
+ * and of missing ids do not walk the allocation tables, also after a gc and
+ * a new mount.
+ */
+ZTEST_F(nvs, test_nvs_index_lookup)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	uint16_t data;
+	uint32_t *flash_read_stat;
+
+	const uint16_t max_id = CONFIG_NVS_LOOKUP_INDEX_SIZE / 2;
+
+	stats_walk(fixture->sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Write all ids in turn, until the 1st gc */
+	for (uint16_t i = 0; (fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2; i++) {
+		data = i;
+		err = nvs_write(&fixture->fs, i % max_id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	for (int round = 0; round < 2; round++) {
+		for (uint16_t id = 0; id < max_id; id++) {
+			*flash_read_stat = 0;
+			err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+			zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+			zassert_equal(data % max_id, id, "incorrect data read");
+			/* The allocation table entry and the data, plus the
+			 * close ate of the previous sector for the first entry
+			 * of a sector.
+			 */
+			zassert_true(*flash_read_stat <= 3, "id %u: %u flash reads", id,
+				     *flash_read_stat);
+		}
+
+		*flash_read_stat = 0;
+		err = nvs_read(&fixture->fs, max_id, &data, sizeof(data));
+		zassert_equal(err, -ENOENT, "nvs_read unexpected failure: %d", err);
+		zassert_equal(*flash_read_stat, 0, "flash read for a missing id");
+
+		err = nvs_mount(&fixture->fs);
+		zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	}
+
+	err = nvs_delete(&fixture->fs, 0);
+	zassert_true(err == 0, "nvs_delete call failure: %d", err);
+	err = nvs_read(&fixture->fs, 0, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "nvs_read unexpected failure: %d", err);
+#endif
+}
+
+/*
+ * Test that the incremental gc moves the live entries out of the oldest
+ * sector and erases it, so that closing the write sector erases nothing.
+ */
+ZTEST_F(nvs, test_nvs_gc_incremental)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	uint16_t i = 0;
+	uint16_t data = 0xaa55;
+	uint32_t *flash_erase_stat;
+
+	const uint16_t max_id = 10;
+	/* Only written once, so it has to be moved out of sector 0 */
+	const uint16_t single_id = max_id;
+
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	err = nvs_gc_step(&fixture->fs, 1);
+	zassert_equal(err, 0, "nothing to collect on an empty file system: %d", err);
+
+	err = nvs_write(&fixture->fs, single_id, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+	/* sector sequence: closed, closed, closed, write, empty */
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 3) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+
+	do {
+		err = nvs_gc_step(&fixture->fs, 1);
+		zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	} while (err);
+
+	/* Sector 0 has to be erased and to stay erased over a new mount */
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 3,
+		      "unexpected write sector");
+
+	do {
+		err = nvs_gc_step(&fixture->fs, 4);
+		zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	} while (err);
+
+	*flash_erase_stat = 0;
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 4) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+	zassert_equal(*flash_erase_stat, 0, "sector close erased a sector");
+
+	check_content(max_id, &fixture->fs);
+	data = 0;
+	err = nvs_read(&fixture->fs, single_id, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, 0xaa55, "incorrect data read");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 4,
+		      "unexpected write sector");
+
+	check_content(max_id, &fixture->fs);
+	data = 0;
+	err = nvs_read(&fixture->fs, single_id, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, 0xaa55, "incorrect data read");
+#endif
+}
+
+/*
+ * Test that the incremental gc is refused with 2 sectors.
+ */
+ZTEST_F(nvs, test_nvs_gc_incremental_2sectors)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+
+	fixture->fs.sector_count = 2;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	err = nvs_gc_step(&fixture->fs, 1);
+	zassert_equal(err, -ENOTSUP, "nvs_gc_step unexpected result: %d", err);
+#endif
+}
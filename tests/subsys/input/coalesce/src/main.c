@@ -0,0 +1,125 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/input/input.h>
+#include <zephyr/ztest.h>
+#include <zephyr/device.h>
+
+#define MAX_EVENTS (CONFIG_INPUT_COALESCE_MAX_EVENTS + 1)
+
+static const struct device fake_dev;
+
+static struct input_event events[MAX_EVENTS];
+static int event_count;
+static K_SEM_DEFINE(sync_sem, 0, 1);
+
+static void input_cb(struct input_event *evt)
+{
+	if (event_count < MAX_EVENTS) {
+		events[event_count] = *evt;
+	}
+	event_count++;
+
+	if (evt->sync) {
+		k_sem_give(&sync_sem);
+	}
+}
+INPUT_CALLBACK_DEFINE(&fake_dev, input_cb);
+
+static void check_event(int idx, uint8_t type, uint16_t code, int32_t value, bool sync)
+{
+	zassert_equal(events[idx].dev, &fake_dev);
+	zassert_equal(events[idx].type, type, "event %d type %d", idx, events[idx].type);
+	zassert_equal(events[idx].code, code, "event %d code %d", idx, events[idx].code);
+	zassert_equal(events[idx].value, value, "event %d value %d", idx, events[idx].value);
+	zassert_equal(events[idx].sync, sync, "event %d sync %d", idx, events[idx].sync);
+}
+
+static void wait_sync(void)
+{
+	zassert_ok(k_sem_take(&sync_sem, K_SECONDS(1)), "no sync event");
+}
+
+ZTEST(input_coalesce, test_rel)
+{
+	input_report_rel(&fake_dev, INPUT_REL_X, 1, false, K_FOREVER);
+	input_report_rel(&fake_dev, INPUT_REL_Y, 2, false, K_FOREVER);
+	input_report_rel(&fake_dev, INPUT_REL_X, 3, false, K_FOREVER);
+	input_report_rel(&fake_dev, INPUT_REL_Y, -4, true, K_FOREVER);
+	wait_sync();
+
+	zassert_equal(event_count, 2);
+	check_event(0, INPUT_EV_REL, INPUT_REL_X, 4, false);
+	check_event(1, INPUT_EV_REL, INPUT_REL_Y, -2, true);
+}
+
+ZTEST(input_coalesce, test_abs)
+{
+	input_report_abs(&fake_dev, INPUT_ABS_X, 10, false, K_FOREVER);
+	input_report_abs(&fake_dev, INPUT_ABS_Y, 5, false, K_FOREVER);
+	input_report_abs(&fake_dev, INPUT_ABS_X, 20, true, K_FOREVER);
+	wait_sync();
+
+	zassert_equal(event_count, 2);
+	check_event(0, INPUT_EV_ABS, INPUT_ABS_X, 20, true);
+	check_event(1, INPUT_EV_ABS, INPUT_ABS_Y, 5, false);
+}
+
+ZTEST(input_coalesce, test_key_barrier)
+{
+	/* Motion is not merged across a key event */
+	input_report_rel(&fake_dev, INPUT_REL_X, 1, false, K_FOREVER);
+	input_report_key(&fake_dev, INPUT_BTN_LEFT, 1, false, K_FOREVER);
+	input_report_rel(&fake_dev, INPUT_REL_X, 2, false, K_FOREVER);
+	input_report_key(&fake_dev, INPUT_BTN_LEFT, 0, true, K_FOREVER);
+	wait_sync();
+
+	zassert_equal(event_count, 4);
+	check_event(0, INPUT_EV_REL, INPUT_REL_X, 1, false);
+	check_event(1, INPUT_EV_KEY, INPUT_BTN_LEFT, 1, false);
+	check_event(2, INPUT_EV_REL, INPUT_REL_X, 2, false);
+	check_event(3, INPUT_EV_KEY, INPUT_BTN_LEFT, 0, true);
+}
+
+ZTEST(input_coalesce, test_held_until_sync)
+{
+	input_report_rel(&fake_dev, INPUT_REL_X, 1, false, K_FOREVER);
+	k_sleep(K_MSEC(10));
+	zassert_equal(event_count, 0, "event delivered before sync");
+
+	input_report_rel(&fake_dev, INPUT_REL_X, 1, true, K_FOREVER);
+	wait_sync();
+
+	zassert_equal(event_count, 1);
+	check_event(0, INPUT_EV_REL, INPUT_REL_X, 2, true);
+}
+
+ZTEST(input_coalesce, test_full_frame)
+{
+	int i;
+
+	for (i = 0; i < MAX_EVENTS; i++) {
+		input_report_key(&fake_dev, i, 1, i == MAX_EVENTS - 1, K_FOREVER);
+	}
+	wait_sync();
+
+	/* The full frame is queued without sync, the last event on its own */
+	zassert_equal(event_count, MAX_EVENTS);
+	for (i = 0; i < MAX_EVENTS; i++) {
+		check_event(i, INPUT_EV_KEY, i, 1, i == MAX_EVENTS - 1);
+	}
+}
+
+static void reset(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	event_count = 0;
+	memset(events, 0, sizeof(events));
+	k_sem_reset(&sync_sem);
+}
+
+ZTEST_SUITE(input_coalesce, NULL, NULL, reset, NULL, NULL);
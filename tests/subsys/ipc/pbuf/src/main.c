@@ -106,6 +106,100 @@ ZTEST(test_pbuf, test_rw)
 	zassert_mem_equal(write_buf, read_buf, MPS);
 }
 
+/* In place write and read tests. */
+ZTEST(test_pbuf, test_nocopy)
+{
+	uint8_t read_buf[MEM_AREA_SZ] = {0};
+	uint8_t write_buf[MEM_AREA_SZ];
+	const char *rx_data;
+	char *tx_data;
+	uint16_t len;
+	int ret;
+
+	static const struct pbuf_cfg cfg = PBUF_CFG_INIT(memory_area, MEM_AREA_SZ, 0);
+
+	static struct pbuf pb = {
+		.cfg = &cfg,
+	};
+
+	for (size_t i = 0; i < MEM_AREA_SZ; i++) {
+		write_buf[i] = i+1;
+	}
+
+	zassert_equal(pbuf_init(&pb), 0);
+
+	/* Write a packet in place. */
+	len = MSGA_SZ;
+	ret = pbuf_write_alloc(&pb, &tx_data, &len);
+	zassert_equal(ret, 0);
+	zassert_equal(len, cfg.len - PBUF_PACKET_LEN_SZ - sizeof(uint32_t));
+	memcpy(tx_data, write_buf, MSGA_SZ);
+	ret = pbuf_write_commit(&pb, MSGA_SZ);
+	zassert_equal(ret, MSGA_SZ);
+
+	/* The packet is seen by a copying reader too. */
+	ret = pbuf_read(&pb, NULL, 0);
+	zassert_equal(ret, MSGA_SZ);
+
+	/* Peek the packet, it stays in the buffer. */
+	ret = pbuf_read_peek(&pb, &rx_data);
+	zassert_equal(ret, MSGA_SZ);
+	zassert_equal_ptr(rx_data, tx_data);
+	zassert_mem_equal(rx_data, write_buf, MSGA_SZ);
+	ret = pbuf_read_peek(&pb, &rx_data);
+	zassert_equal(ret, MSGA_SZ);
+
+	ret = pbuf_read_release(&pb);
+	zassert_equal(ret, MSGA_SZ);
+	ret = pbuf_read_peek(&pb, &rx_data);
+	zassert_equal(ret, 0);
+	zassert_is_null(rx_data);
+	ret = pbuf_read_release(&pb);
+	zassert_equal(ret, -ENODATA);
+
+	/* Bring the write index close to the end of the buffer. */
+	len = cfg.len - ROUND_UP(MSGA_SZ, sizeof(uint32_t)) - 4 * PBUF_PACKET_LEN_SZ;
+	ret = pbuf_write(&pb, write_buf, len);
+	zassert_equal(ret, len);
+	ret = pbuf_read(&pb, read_buf, len);
+	zassert_equal(ret, len);
+
+	/* The room does not wrap. */
+	len = MSGB_SZ;
+	ret = pbuf_write_alloc(&pb, &tx_data, &len);
+	zassert_equal(ret, -ENOMEM);
+	zassert_equal(len, PBUF_PACKET_LEN_SZ);
+
+	/* A wrapped packet can only be read with a copy. */
+	ret = pbuf_write(&pb, write_buf, MSGB_SZ);
+	zassert_equal(ret, MSGB_SZ);
+	ret = pbuf_read_peek(&pb, &rx_data);
+	zassert_equal(ret, MSGB_SZ);
+	zassert_is_null(rx_data);
+	ret = pbuf_read(&pb, read_buf, MSGB_SZ);
+	zassert_equal(ret, MSGB_SZ);
+	zassert_mem_equal(read_buf, write_buf, MSGB_SZ);
+
+	/* The writer tells whether it wrote to an empty buffer. */
+	uint32_t wr_idx = pb.data.wr_idx;
+
+	zassert_true(pbuf_reader_at(&pb, wr_idx));
+	ret = pbuf_write(&pb, write_buf, MSGA_SZ);
+	zassert_equal(ret, MSGA_SZ);
+	zassert_true(pbuf_reader_at(&pb, wr_idx));
+
+	wr_idx = pb.data.wr_idx;
+	ret = pbuf_write(&pb, write_buf, MSGA_SZ);
+	zassert_equal(ret, MSGA_SZ);
+	zassert_false(pbuf_reader_at(&pb, wr_idx));
+
+	/* Ret codes. */
+	zassert_equal(pbuf_write_alloc(NULL, &tx_data, &len), -EINVAL);
+	zassert_equal(pbuf_write_commit(&pb, 0), -EINVAL);
+	zassert_equal(pbuf_read_peek(&pb, NULL), -EINVAL);
+	zassert_equal(pbuf_read_release(NULL), -EINVAL);
+}
+
 /* API ret codes tests. */
 ZTEST(test_pbuf, test_retcodes)
 {
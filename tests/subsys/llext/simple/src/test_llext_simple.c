@@ -242,6 +242,19 @@ ZTEST(llext, test_printk_exported)
 	zassert_equal(printk_fn, printk, "printk should be an exported symbol");
 }
 
+/*
+ * Ensure every exported symbol is found by name, whatever the table search.
+ */
+ZTEST(llext, test_find_all_exported)
+{
+	STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
+		zassert_equal_ptr(llext_find_sym(NULL, sym->name), sym->addr,
+				  "%s not found", sym->name);
+	}
+
+	zassert_is_null(llext_find_sym(NULL, "not_an_exported_symbol"));
+}
+
 /*
  * Ensure ext_syscall_fail is exported - as it is picked up by the syscall
  * build machinery - but points to NULL as it is not implemented.
@@ -535,6 +535,41 @@ ZTEST(log_msg, test_mode_size_str_with_2strings)
 	get_msg_validate_length(exp_len);
 }
 
+ZTEST(log_msg, test_runtime_package_sizes)
+{
+#undef TEST_STR
+#define TEST_STR "%s %d"
+	static const uint8_t domain = 3;
+	static const uint8_t level = 2;
+	const void *source = (const void *)123;
+	char str[MIN(CONFIG_LOG_RUNTIME_PACKAGE_BUF_SIZE + 16, 200)];
+	char exp_str[sizeof(str) + 16];
+	union log_msg_generic *msg;
+
+	test_init();
+
+	/* Strings are copied into the package, so a short one fits in the
+	 * stack buffer and a long one does not.
+	 */
+	for (size_t len = 1; len < sizeof(str); len += 8) {
+		memset(str, 'a', len);
+		str[len] = '\0';
+
+		z_log_msg_runtime_create(domain, source, level, NULL, 0, 0,
+					 TEST_STR, str, (int)len);
+		snprintfcb(exp_str, sizeof(exp_str), TEST_STR, str, (int)len);
+
+		/* The source string is overwritten to check that it was copied */
+		memset(str, 'b', len);
+
+		msg = z_log_msg_claim(NULL);
+		zassert_not_null(msg, "Unexpected null message");
+		basic_validate(&msg->log, source, domain, level,
+			       TEST_TIMESTAMP_INIT_VALUE, NULL, 0, exp_str);
+		z_log_msg_free(msg);
+	}
+}
+
 static log_timestamp_t timestamp_get_inc(void)
 {
 	return timestamp++;
@@ -0,0 +1,156 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+
+#define MODULE_NAME test
+
+LOG_MODULE_REGISTER(MODULE_NAME);
+
+#define CNT_BITS	24
+#define MSG_CNT		2000
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct mock_log_backend {
+	uint32_t last_id[CONFIG_MP_MAX_NUM_CPUS];
+	uint32_t cnt[CONFIG_MP_MAX_NUM_CPUS];
+	uint32_t dropped;
+	uint32_t missing;
+	uint32_t reordered;
+};
+
+static struct mock_log_backend mock_backend;
+static uint32_t log_process_delay;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	size_t len;
+	uint8_t *package = log_msg_get_package(&msg->log, &len);
+	uint32_t arg0 = *(uint32_t *)(package + 2 * sizeof(void *));
+	uint32_t ctx_id = arg0 >> CNT_BITS;
+	uint32_t id = arg0 & BIT_MASK(CNT_BITS);
+
+	k_busy_wait(log_process_delay);
+
+	/* Buffers are merged by timestamp, so the messages of a thread stay in
+	 * order even when it moves between CPUs.
+	 */
+	if (id <= mock_backend.last_id[ctx_id]) {
+		mock_backend.reordered++;
+	} else {
+		mock_backend.missing += id - mock_backend.last_id[ctx_id] - 1;
+		mock_backend.last_id[ctx_id] = id;
+	}
+
+	mock_backend.cnt[ctx_id]++;
+}
+
+static void mock_init(struct log_backend const *const backend)
+{
+
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	zassert_true(false);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	mock_backend.dropped += cnt;
+}
+
+static const struct log_backend_api log_backend_api = {
+	.process = process,
+	.panic = panic,
+	.init = mock_init,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(test, log_backend_api, true, NULL);
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uint32_t ctx_id = POINTER_TO_UINT(p1);
+
+	for (uint32_t id = 1; id <= MSG_CNT; id++) {
+		LOG_INF("%u", (ctx_id << CNT_BITS) | id);
+		k_busy_wait(1);
+	}
+}
+
+static void wait_processed(void)
+{
+	while (log_data_pending()) {
+		k_msleep(10);
+	}
+
+	k_msleep(10);
+}
+
+static void test_per_cpu(uint32_t delay)
+{
+	unsigned int ctx_cnt = arch_num_cpus();
+	uint32_t out_cnt = 0;
+
+	memset(&mock_backend, 0, sizeof(mock_backend));
+	log_process_delay = delay;
+
+	for (unsigned int i = 0; i < ctx_cnt; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, producer,
+				UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < ctx_cnt; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	wait_processed();
+
+	/* One last message for each thread, so that messages dropped at the
+	 * end of a sequence are seen as missing.
+	 */
+	for (unsigned int i = 0; i < ctx_cnt; i++) {
+		LOG_INF("%u", (i << CNT_BITS) | (MSG_CNT + 1));
+	}
+
+	wait_processed();
+
+	for (unsigned int i = 0; i < ctx_cnt; i++) {
+		zassert_equal(mock_backend.last_id[i], MSG_CNT + 1,
+			      "thread %u: last message %u", i, mock_backend.last_id[i]);
+		out_cnt += mock_backend.cnt[i];
+	}
+
+	zassert_equal(mock_backend.reordered, 0, "%u messages out of order",
+		      mock_backend.reordered);
+	zassert_equal(mock_backend.dropped, mock_backend.missing,
+		      "dropped:%u missing:%u",
+		      mock_backend.dropped, mock_backend.missing);
+	zassert_equal(out_cnt + mock_backend.dropped, ctx_cnt * (MSG_CNT + 1));
+}
+
+ZTEST(log_per_cpu, test_per_cpu_fast_processing)
+{
+	test_per_cpu(0);
+}
+
+ZTEST(log_per_cpu, test_per_cpu_slow_processing)
+{
+	test_per_cpu(50);
+}
+
+ZTEST_SUITE(log_per_cpu, NULL, NULL, NULL, NULL, NULL);
@@ -38,6 +38,11 @@ void img_upload_stub_init(void)
 	test_offset = 0;
 }
 
+void img_upload_stub_offset_set(size_t offset)
+{
+	test_offset = offset;
+}
+
 void img_upload_response(size_t offset, int status)
 {
 	struct net_buf *nb;
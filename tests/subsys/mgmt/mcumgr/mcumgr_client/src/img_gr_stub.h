@@ -19,6 +19,7 @@ extern "C" {
 #define TEST_SLOT_NUMBER 2
 
 void img_upload_stub_init(void);
+void img_upload_stub_offset_set(size_t offset);
 void img_upload_response(size_t offset, int status);
 void img_fail_response(int status);
 void img_read_response(int count);
@@ -20,7 +20,7 @@
 /* IMG group data */
 static uint8_t image_hash[32];
 static struct mcumgr_image_data image_info[2];
-static uint8_t image_dummy[1024];
+static uint8_t image_dummy[TEST_IMAGE_SIZE];
 
 static const char os_echo_test[] = "TestString";
 static struct smp_client_object smp_client;
@@ -108,6 +108,43 @@ ZTEST(mcumgr_client, test_img_upload)
 		      response.image_upload_offset);
 }
 
+ZTEST(mcumgr_client, test_img_upload_rewind)
+{
+	int rc;
+	struct mcumgr_image_upload response;
+
+	smp_client_send_status_stub(MGMT_ERR_EOK);
+	rc = img_mgmt_client_upload_init(&img_client, TEST_IMAGE_SIZE, TEST_IMAGE_NUM, image_hash);
+	zassert_equal(MGMT_ERR_EOK, rc, "Expected to receive %d response %d", MGMT_ERR_EOK, rc);
+
+	smp_stub_set_rx_data_verify(img_upload_init_verify);
+	img_upload_stub_init();
+	rc = img_mgmt_client_upload(&img_client, image_dummy, 1024, &response);
+	zassert_equal(MGMT_ERR_EOK, rc, "Expected to receive %d response %d", MGMT_ERR_EOK, rc);
+	zassert_equal(1024, response.image_upload_offset,
+		      "Expected to receive offset %d response %d", 1024,
+		      response.image_upload_offset);
+
+	/* The server goes back before the data given, the upload goes back with it */
+	smp_stub_set_rx_data_verify(NULL);
+	img_upload_response(512, MGMT_ERR_EOK);
+	rc = img_mgmt_client_upload(&img_client, image_dummy, 1024, &response);
+	zassert_equal(MGMT_ERR_EOK, rc, "Expected to receive %d response %d", MGMT_ERR_EOK, rc);
+	zassert_equal(512, response.image_upload_offset,
+		      "Expected to receive offset %d response %d", 512,
+		      response.image_upload_offset);
+	smp_client_response_buf_clean();
+
+	/* The data from there is sent again */
+	smp_stub_set_rx_data_verify(img_upload_init_verify);
+	img_upload_stub_offset_set(512);
+	rc = img_mgmt_client_upload(&img_client, image_dummy, TEST_IMAGE_SIZE - 512, &response);
+	zassert_equal(MGMT_ERR_EOK, rc, "Expected to receive %d response %d", MGMT_ERR_EOK, rc);
+	zassert_equal(TEST_IMAGE_SIZE, response.image_upload_offset,
+		      "Expected to receive offset %d response %d", TEST_IMAGE_SIZE,
+		      response.image_upload_offset);
+}
+
 ZTEST(mcumgr_client, test_img_erase)
 {
 	int rc;
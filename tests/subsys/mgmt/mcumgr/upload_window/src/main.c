@@ -0,0 +1,109 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include "mgmt/mcumgr/util/upload_window.h"
+
+static uint8_t window_buf[64];
+static struct upload_window window = UPLOAD_WINDOW_INITIALIZER(window_buf);
+static uint8_t image[256];
+
+static void *upload_window_setup(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(image); i++) {
+		image[i] = (uint8_t)(i * 3 + 1);
+	}
+
+	return NULL;
+}
+
+static void upload_window_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	upload_window_reset(&window);
+}
+
+ZTEST(upload_window, test_put_get)
+{
+	const uint8_t *data;
+
+	zassert_equal(upload_window_get(&window, 0, &data), 0, "Data in empty window");
+
+	zassert_true(upload_window_put(&window, 0, 16, &image[16], 16), "Data not kept");
+
+	/* Nothing at the offset until the gap is filled */
+	zassert_equal(upload_window_get(&window, 0, &data), 0, "Data before the gap");
+	zassert_equal(upload_window_get(&window, 16, &data), 16, "Data not returned");
+	zassert_mem_equal(data, &image[16], 16, "Wrong data");
+
+	/* The upload went past it */
+	zassert_equal(upload_window_get(&window, 32, &data), 0, "Data kept past the offset");
+}
+
+ZTEST(upload_window, test_reject)
+{
+	/* At or before the offset, beyond the window, or empty */
+	zassert_false(upload_window_put(&window, 16, 16, &image[16], 16), "Data at offset kept");
+	zassert_false(upload_window_put(&window, 16, 8, &image[8], 16), "Data before kept");
+	zassert_false(upload_window_put(&window, 0, 32, &image[32], 48), "Data beyond kept");
+	zassert_false(upload_window_put(&window, 0, 32, &image[32], 0), "Empty data kept");
+
+	/* Up to the size of the window ahead */
+	zassert_true(upload_window_put(&window, 0, 32, &image[32], 32), "Data in window dropped");
+}
+
+ZTEST(upload_window, test_merge)
+{
+	const uint8_t *data;
+
+	/* Out of order, touching and overlapping ranges make a single one */
+	zassert_true(upload_window_put(&window, 0, 40, &image[40], 8), "Data not kept");
+	zassert_true(upload_window_put(&window, 0, 8, &image[8], 8), "Data not kept");
+	zassert_true(upload_window_put(&window, 0, 16, &image[16], 16), "Data not kept");
+	zassert_true(upload_window_put(&window, 0, 28, &image[28], 14), "Data not kept");
+
+	zassert_equal(upload_window_get(&window, 8, &data), 40, "Ranges not merged");
+	zassert_mem_equal(data, &image[8], 40, "Wrong data");
+
+	/* The part of a range the upload went past is dropped */
+	zassert_equal(upload_window_get(&window, 20, &data), 28, "Range not trimmed");
+	zassert_mem_equal(data, &image[20], 28, "Wrong data");
+}
+
+ZTEST(upload_window, test_ranges_full)
+{
+	/* Separate ranges until they are all used */
+	for (int i = 0; i < UPLOAD_WINDOW_RANGES; i++) {
+		zassert_true(upload_window_put(&window, 0, 4 + i * 8, &image[4 + i * 8], 2),
+			     "Range %d not kept", i);
+	}
+
+	zassert_false(upload_window_put(&window, 0, 60, &image[60], 2), "Range kept with no room");
+
+	/* A range joining one kept still fits */
+	zassert_true(upload_window_put(&window, 0, 6, &image[6], 2), "Joined range not kept");
+}
+
+ZTEST(upload_window, test_wrap)
+{
+	const uint8_t *data;
+	size_t len;
+
+	/* The data wraps around the end of the buffer, and is returned in two parts */
+	zassert_true(upload_window_put(&window, 40, 56, &image[56], 32), "Data not kept");
+
+	len = upload_window_get(&window, 56, &data);
+	zassert_equal(len, 8, "Wrong first part %zu", len);
+	zassert_mem_equal(data, &image[56], len, "Wrong data");
+
+	len = upload_window_get(&window, 64, &data);
+	zassert_equal(len, 24, "Wrong second part %zu", len);
+	zassert_mem_equal(data, &image[64], len, "Wrong data");
+}
+
+ZTEST_SUITE(upload_window, NULL, upload_window_setup, upload_window_before, NULL, NULL);
@@ -44,6 +44,7 @@ void test_coil_wr_rd(void);
 void test_di_rd(void);
 void test_input_reg(void);
 void test_holding_reg(void);
+void test_regs_batch(void);
 void test_diagnostic(void);
 void test_client_disable(void);
 
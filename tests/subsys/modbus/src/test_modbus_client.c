@@ -188,6 +188,42 @@ void test_holding_reg(void)
 		      "FC16FP verify failed");
 }
 
+void test_regs_batch(void)
+{
+	uint16_t hr_wr[8] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17};
+	uint16_t hr_rd[8] = {0};
+	uint16_t ir_rd[2] = {0};
+	uint16_t oor_rd[1] = {0};
+	struct modbus_reg_read reqs[] = {
+		/* Merged into a single FC03 request */
+		{ .unit_id = node, .start_addr = 0, .num_regs = 3, .reg_buf = &hr_rd[0] },
+		{ .unit_id = node, .start_addr = 3, .num_regs = 5, .reg_buf = &hr_rd[3] },
+		{ .unit_id = node, .input = true, .start_addr = 6, .num_regs = 2, .reg_buf = ir_rd },
+		{ .unit_id = node, .start_addr = offset_oor, .num_regs = 1, .reg_buf = oor_rd },
+		{ .unit_id = node, .start_addr = 0, .num_regs = 0, .reg_buf = hr_rd },
+	};
+	int err;
+
+	for (uint16_t idx = 0; idx < ARRAY_SIZE(hr_wr); idx++) {
+		err = modbus_write_holding_reg(client_iface, node, idx, hr_wr[idx]);
+		zassert_equal(err, 0, "FC06 write request failed");
+	}
+
+	err = modbus_read_regs_batch(client_iface, reqs, ARRAY_SIZE(reqs));
+	zassert_equal(err, reqs[3].err, "Batch did not return the first error");
+
+	zassert_equal(reqs[0].err, 0, "FC03 batch read failed");
+	zassert_equal(reqs[1].err, 0, "FC03 merged batch read failed");
+	zassert_equal(reqs[2].err, 0, "FC04 batch read failed");
+	zassert_not_equal(reqs[3].err, 0, "Out of range batch read not failed");
+	zassert_equal(reqs[4].err, -EINVAL, "Empty batch read not rejected");
+
+	zassert_equal(memcmp(hr_wr, hr_rd, sizeof(hr_wr)), 0,
+		      "FC03 batch verify failed");
+	zassert_equal(memcmp(&hr_wr[6], ir_rd, sizeof(ir_rd)), 0,
+		      "FC04 batch verify failed");
+}
+
 void test_diagnostic(void)
 {
 	uint16_t data = 0xcafe;
@@ -346,6 +382,11 @@ void test_holding_reg(void)
 	ztest_test_skip();
 }
 
+void test_regs_batch(void)
+{
+	ztest_test_skip();
+}
+
 void test_diagnostic(void)
 {
 	ztest_test_skip();
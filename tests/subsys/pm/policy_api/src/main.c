@@ -368,4 +368,63 @@ ZTEST(policy_api, test_pm_policy_events)
 }
 #endif /* CONFIG_PM_POLICY_CUSTOM */
 
+#ifdef CONFIG_PM_POLICY_PREDICTIVE
+/**
+ * @brief Test the behavior of pm_policy_next_state() when
+ * CONFIG_PM_POLICY_PREDICTIVE=y.
+ */
+ZTEST(policy_api, test_pm_policy_next_state_predictive)
+{
+	const struct pm_state_info *next;
+	int i;
+
+	/* timer wakeups: the deepest state allowed by the timer is used */
+	for (i = 0; i < 32; i++) {
+		next = pm_policy_next_state(0U, k_us_to_ticks_floor32(1100000));
+		pm_policy_residency_update(0U, k_us_to_cyc_ceil32(1100000));
+	}
+	zassert_equal(next->state, PM_STATE_SUSPEND_TO_RAM);
+
+	/* wakeups after 200ms (> runtime idle, < suspend to ram residencies):
+	 * runtime idle is used, although the timer allows suspend to ram
+	 */
+	for (i = 0; i < 32; i++) {
+		next = pm_policy_next_state(0U, k_us_to_ticks_floor32(1100000));
+		if (next->state == PM_STATE_RUNTIME_IDLE) {
+			break;
+		}
+		pm_policy_residency_update(0U, k_us_to_cyc_ceil32(200000));
+	}
+	zassert_equal(next->state, PM_STATE_RUNTIME_IDLE);
+
+	/* wakeups after 10ms (< all residencies): the shallowest state is kept
+	 * so that the history keeps learning
+	 */
+	for (i = 0; i < 32; i++) {
+		next = pm_policy_next_state(0U, k_us_to_ticks_floor32(1100000));
+		pm_policy_residency_update(0U, k_us_to_cyc_ceil32(10000));
+	}
+	zassert_equal(next->state, PM_STATE_RUNTIME_IDLE);
+
+	/* a timeout too short for any state still keeps the system active */
+	next = pm_policy_next_state(0U, k_us_to_ticks_floor32(10999));
+	zassert_is_null(next);
+
+	/* timer wakeups again: back to suspend to ram */
+	for (i = 0; i < 32; i++) {
+		next = pm_policy_next_state(0U, k_us_to_ticks_floor32(1100000));
+		if (next->state == PM_STATE_SUSPEND_TO_RAM) {
+			break;
+		}
+		pm_policy_residency_update(0U, k_us_to_cyc_ceil32(1100000));
+	}
+	zassert_equal(next->state, PM_STATE_SUSPEND_TO_RAM);
+}
+#else
+ZTEST(policy_api, test_pm_policy_next_state_predictive)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_PM_POLICY_PREDICTIVE */
+
 ZTEST_SUITE(policy_api, NULL, NULL, NULL, NULL, NULL);
@@ -15,6 +15,7 @@
 #include <zephyr/sys/time_units.h>
 #include <zephyr/timing/timing.h>
 #include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/work.h>
 
 #include "rtio_iodev_test.h"
 
@@ -633,6 +634,82 @@ ZTEST(rtio_api, test_rtio_throughput)
 }
 
 
+#ifdef CONFIG_RTIO_WORKQ
+#define WORKQ_DELAY_MS 50
+
+RTIO_DEFINE(r_workq, SQE_POOL_SIZE, CQE_POOL_SIZE);
+
+static void rtio_iodev_blocking_handler(struct rtio_iodev_sqe *iodev_sqe)
+{
+	k_msleep(WORKQ_DELAY_MS);
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+
+static void rtio_iodev_blocking_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	if (req == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, rtio_iodev_blocking_handler);
+}
+
+static const struct rtio_iodev_api rtio_iodev_blocking_api = {
+	.submit = rtio_iodev_blocking_submit,
+};
+
+RTIO_IODEV_DEFINE(iodev_blocking0, &rtio_iodev_blocking_api, NULL);
+RTIO_IODEV_DEFINE(iodev_blocking1, &rtio_iodev_blocking_api, NULL);
+
+/**
+ * @brief Test the execution of blocking iodevs by the work pool
+ *
+ * Ensures that the submissions to two blocking iodevs do not block the
+ * submitter and are executed in parallel.
+ */
+ZTEST(rtio_api, test_rtio_workq)
+{
+	struct rtio_iodev *iodevs[] = {&iodev_blocking0, &iodev_blocking1};
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int64_t start;
+	int64_t elapsed;
+	int completed = 0;
+
+	if (CONFIG_RTIO_WORKQ_THREADS_POOL < 2) {
+		ztest_test_skip();
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(iodevs); i++) {
+		sqe = rtio_sqe_acquire(&r_workq);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, iodevs[i], NULL);
+	}
+
+	start = k_uptime_get();
+	zassert_ok(rtio_submit(&r_workq, 0));
+	zassert_true(k_uptime_get() - start < WORKQ_DELAY_MS, "Submitter was blocked");
+
+	while (completed < ARRAY_SIZE(iodevs)) {
+		cqe = rtio_cqe_consume(&r_workq);
+		if (cqe == NULL) {
+			k_msleep(1);
+			continue;
+		}
+		zassert_ok(cqe->result, "Result should be ok");
+		rtio_cqe_release(&r_workq, cqe);
+		completed++;
+	}
+
+	elapsed = k_uptime_get() - start;
+	zassert_true(elapsed < 2 * WORKQ_DELAY_MS, "Submissions took %lld ms", elapsed);
+	zassert_equal(rtio_work_req_used_count_get(), 0);
+}
+#endif /* CONFIG_RTIO_WORKQ */
+
 static void *rtio_api_setup(void)
 {
 #ifdef CONFIG_USERSPACE
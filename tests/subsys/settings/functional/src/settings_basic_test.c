@@ -619,3 +619,91 @@ ZTEST(settings_functional, test_direct_loading_filter)
 	}
 	settings_deregister(&filtered_loader_settings);
 }
+
+/* Store failing to start a save, counting what settings_save() passes to it */
+static struct {
+	int starts;
+	int saves;
+	int ends;
+} failing_store_calls;
+
+static int failing_store_save_start(struct settings_store *cs)
+{
+	failing_store_calls.starts++;
+	return -EIO;
+}
+
+static int failing_store_save(struct settings_store *cs, const char *name,
+			      const char *value, size_t val_len)
+{
+	failing_store_calls.saves++;
+	return 0;
+}
+
+static int failing_store_save_end(struct settings_store *cs)
+{
+	failing_store_calls.ends++;
+	return -EIO;
+}
+
+static const struct settings_store_itf failing_store_itf = {
+	.csi_save_start = failing_store_save_start,
+	.csi_save = failing_store_save,
+	.csi_save_end = failing_store_save_end,
+};
+
+static struct settings_store failing_store = {
+	.cs_itf = &failing_store_itf,
+};
+
+static int export_locked;
+
+int save_export(int (*cb)(const char *name, const void *value, size_t val_len))
+{
+	extern struct k_mutex settings_lock;
+	uint8_t val = 1;
+
+	export_locked = (settings_lock.owner == k_current_get());
+
+	return cb("save/val", &val, sizeof(val));
+}
+static struct settings_handler save_settings = {
+	.name = "save",
+	.h_export = save_export,
+};
+
+ZTEST(settings_functional, test_save_start_error)
+{
+	extern struct settings_store *settings_save_dst;
+	struct settings_store *dst = settings_save_dst;
+	int rc;
+
+	settings_subsys_init();
+
+	rc = settings_register(&save_settings);
+	zassert_true(rc == 0, "register of save settings failed");
+
+	memset(&failing_store_calls, 0, sizeof(failing_store_calls));
+	export_locked = -1;
+	settings_dst_register(&failing_store);
+
+	rc = settings_save();
+
+	settings_dst_register(dst);
+	settings_deregister(&save_settings);
+
+	zassert_equal(1, failing_store_calls.starts, "save start not called");
+#if defined(CONFIG_SETTINGS_SAVE_TRANSACTION)
+	/* The transaction fails, nothing is exported */
+	zassert_equal(-EIO, rc, "start error not returned (err=%d)", rc);
+	zassert_equal(0, failing_store_calls.saves, "save done");
+	zassert_equal(0, failing_store_calls.ends, "save end called");
+	zassert_equal(-1, export_locked, "export called");
+#else
+	/* The errors of the back-end starting and ending are ignored */
+	zassert_equal(0, rc, "settings_save failed (err=%d)", rc);
+	zassert_true(failing_store_calls.saves > 0, "export not saved");
+	zassert_equal(1, failing_store_calls.ends, "save end not called");
+	zassert_equal(0, export_locked, "lock held over the export");
+#endif
+}
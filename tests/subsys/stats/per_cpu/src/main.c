@@ -0,0 +1,128 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/stats/stats.h>
+
+#define INCREMENTS 10000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+STATS_SECT_START(test_small)
+STATS_SECT_ENTRY32(counted)
+STATS_SECT_ENTRY32(set)
+STATS_SECT_END;
+
+/* Larger than the pool for all the CPUs, it gets no per-CPU copies */
+STATS_SECT_START(test_large)
+STATS_SECT_ENTRY32(counted)
+STATS_SECT_ENTRY32(unused[CONFIG_STATS_PER_CPU_POOL_SIZE / sizeof(uint32_t)])
+STATS_SECT_END;
+
+static STATS_SECT_DECL(test_small) small;
+static STATS_SECT_DECL(test_large) large;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static void count_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < INCREMENTS; i++) {
+		STATS_INC(small, counted);
+	}
+}
+
+ZTEST(stats_per_cpu, test_sum)
+{
+	unsigned int cpus = arch_num_cpus();
+
+	zassert_not_null(small.s_hdr.s_cpu, "No per-CPU copies");
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, count_fn,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&threads[i], i), "Pinning failed");
+	}
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		zassert_ok(k_thread_join(&threads[i], K_SECONDS(10)),
+			   "Thread %u did not finish", i);
+	}
+
+	/* No increase is lost, and they all went to the copies */
+	zassert_equal(STATS_GET(small, counted), cpus * INCREMENTS,
+		      "Sum %u", STATS_GET(small, counted));
+	zassert_equal(small.counted, 0, "Increased in place");
+}
+
+ZTEST(stats_per_cpu, test_set_reset)
+{
+	STATS_INCN(small, set, 3);
+	zassert_equal(STATS_GET(small, set), 3);
+
+	/* The copies are zeroed, the group keeps the value */
+	STATS_SET(small, set, 5);
+	zassert_equal(small.set, 5);
+	zassert_equal(STATS_GET(small, set), 5);
+
+	STATS_INC(small, set);
+	zassert_equal(STATS_GET(small, set), 6);
+
+	STATS_CLEAR(small, set);
+	zassert_equal(STATS_GET(small, set), 0);
+
+	STATS_INCN(small, counted, 2);
+	STATS_INC(small, set);
+	stats_reset(&small.s_hdr);
+	zassert_equal(STATS_GET(small, counted), 0);
+	zassert_equal(STATS_GET(small, set), 0);
+}
+
+ZTEST(stats_per_cpu, test_pool_exhausted)
+{
+	zassert_is_null(large.s_hdr.s_cpu, "Per-CPU copies beyond the pool");
+
+	STATS_INCN(large, counted, 2);
+	STATS_INC(large, counted);
+	zassert_equal(large.counted, 3, "Not increased in place");
+	zassert_equal(STATS_GET(large, counted), 3);
+
+	STATS_SET(large, counted, 7);
+	zassert_equal(STATS_GET(large, counted), 7);
+
+	stats_reset(&large.s_hdr);
+	zassert_equal(STATS_GET(large, counted), 0);
+}
+
+static void *stats_setup(void)
+{
+	stats_init(&small.s_hdr, STATS_SIZE_32,
+		   (sizeof(small) - sizeof(struct stats_hdr)) / STATS_SIZE_32,
+		   NULL, 0);
+	stats_init(&large.s_hdr, STATS_SIZE_32,
+		   (sizeof(large) - sizeof(struct stats_hdr)) / STATS_SIZE_32,
+		   NULL, 0);
+
+	return NULL;
+}
+
+static void stats_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	stats_reset(&small.s_hdr);
+	stats_reset(&large.s_hdr);
+}
+
+ZTEST_SUITE(stats_per_cpu, NULL, stats_setup, stats_before, NULL, NULL);
@@ -643,6 +643,62 @@ ZTEST(lib_stream_flash, test_stream_flash_progress_clear)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+static uint8_t second_buf[BUF_LEN];
+
+ZTEST(lib_stream_flash, test_stream_flash_double_buffer)
+{
+	int rc;
+	size_t size = page_size * (MAX_NUM_PAGES - 1) + 100;
+	size_t done = 0;
+
+	init_target();
+
+	zassert_equal(stream_flash_double_buffer_enable(NULL, second_buf), -EFAULT);
+	zassert_equal(stream_flash_double_buffer_enable(&ctx, NULL), -EFAULT);
+	rc = stream_flash_double_buffer_enable(&ctx, second_buf);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Chunks that do not line up with the buffers */
+	while (done < size) {
+		size_t len = MIN(size - done, 300);
+
+		rc = stream_flash_buffered_write(&ctx, write_buf + done, len, false);
+		zassert_equal(rc, 0, "expected success");
+		done += len;
+	}
+
+	/* All the bytes but those buffered or being written */
+	zassert_true(stream_flash_bytes_written(&ctx) <= size - (size % BUF_LEN));
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), size);
+
+	VERIFY_WRITTEN(0, size);
+	/* Nothing was written past the data */
+	VERIFY_ERASED(size, page_size * MAX_NUM_PAGES - size);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_double_buffer_callback)
+{
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_double_buffer_enable(&ctx, second_buf);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Failures of background writes are returned by the next write */
+	cb_ret = -EFAULT;
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, -EFAULT, "expected failure from callback");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0);
+}
+#endif /* CONFIG_STREAM_FLASH_DOUBLE_BUFFER */
+
 void lib_stream_flash_before(void *data)
 {
 	zassume_true(device_is_ready(fdev), "Device is not ready");
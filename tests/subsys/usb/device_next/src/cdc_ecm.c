@@ -0,0 +1,120 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/usb/class/usb_cdc.h>
+
+#include "usbh_ch9.h"
+#include "usb_test.h"
+
+/* More frames than transfers queued, sent back to back */
+#define TEST_FRAME_COUNT	8
+/* Frame lengths are not a multiple of the bulk MPS, there is no ZLP */
+#define TEST_FRAME_STEP		181U
+#define TEST_TIMEOUT		1000
+/* The second round needs the buffers released by the network stack */
+#define TEST_RX_ROUNDS		2
+
+/* Frames sent by the host are received by the network stack, in order */
+static void ecm_rx(struct usb_device *udev, const struct usb_test_iface *tif,
+			const int sock)
+{
+	static uint8_t frame[NET_ETH_MAX_FRAME_SIZE];
+	struct net_buf *buf;
+	size_t len;
+	int err;
+
+	for (unsigned int n = 0; n < TEST_FRAME_COUNT; n++) {
+		len = usb_test_eth_frame(frame, n, TEST_FRAME_STEP);
+
+		buf = usbh_xfer_buf_alloc(udev, len);
+		zassert_not_null(buf, "Failed to allocate host buffer");
+		net_buf_add_mem(buf, frame, len);
+
+		err = usb_test_bulk(udev, tif->ep_out, tif->mps_out, buf, TEST_TIMEOUT);
+		usbh_xfer_buf_free(udev, buf);
+		zassert_equal(err, 0, "Frame %u OUT transfer failed (%d)", n, err);
+	}
+
+	usb_test_eth_recv(sock, TEST_FRAME_COUNT, TEST_FRAME_STEP);
+}
+
+static void test_ecm_rx(struct usb_device *udev, const struct usb_test_iface *tif,
+			const int sock)
+{
+	for (int i = 0; i < TEST_RX_ROUNDS; i++) {
+		ecm_rx(udev, tif, sock);
+	}
+}
+
+/* Frames sent by the network stack are received by the host, in order */
+static void test_ecm_tx(struct usb_device *udev, const struct usb_test_iface *tif,
+			const int sock, struct net_if *iface)
+{
+	static uint8_t frame[NET_ETH_MAX_FRAME_SIZE];
+	struct net_buf *buf;
+	size_t len;
+	int err;
+
+	usb_test_eth_send(sock, iface, TEST_FRAME_COUNT, TEST_FRAME_STEP);
+
+	for (unsigned int n = 0; n < TEST_FRAME_COUNT;) {
+		buf = usbh_xfer_buf_alloc(udev, NET_ETH_MAX_FRAME_SIZE);
+		zassert_not_null(buf, "Failed to allocate host buffer");
+
+		err = usb_test_bulk(udev, tif->ep_in, tif->mps_in, buf, TEST_TIMEOUT);
+		zassert_equal(err, 0, "Frame %u IN transfer failed (%d)", n, err);
+
+		/* Skip what the network stack may send on its own */
+		if (!usb_test_eth_is_test_frame(buf->data, buf->len)) {
+			usbh_xfer_buf_free(udev, buf);
+			continue;
+		}
+
+		len = usb_test_eth_frame(frame, n, TEST_FRAME_STEP);
+		zassert_equal(buf->len, len, "Frame %u sent with %u bytes", n, buf->len);
+		zassert_mem_equal(buf->data, frame, len, "Frame %u corrupted", n);
+		usbh_xfer_buf_free(udev, buf);
+		n++;
+	}
+}
+
+ZTEST(device_next, test_cdc_ecm_frames)
+{
+	const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(cdc_ecm_eth0));
+	struct usb_test_iface tif;
+	struct usb_device *udev;
+	struct net_if *iface;
+	int sock;
+	int err;
+
+	iface = net_if_lookup_by_dev(dev);
+	zassert_not_null(iface, "No CDC ECM network interface");
+
+	udev = usb_test_configure();
+
+	err = usb_test_find_iface(udev, USB_BCC_CDC_DATA, ECM_SUBCLASS, 1, &tif);
+	zassert_equal(err, 0, "CDC ECM data interface not found (%d)", err);
+	zassert_true(tif.ep_in != 0 && tif.ep_out != 0, "Bulk endpoints not found");
+
+	err = usbh_req_set_alt(udev, tif.iface, 1);
+	zassert_equal(err, 0, "Failed to enable the data interface (%d)", err);
+	usb_test_eth_carrier(iface, true);
+
+	sock = usb_test_eth_socket(iface);
+
+	test_ecm_rx(udev, &tif, sock);
+	test_ecm_tx(udev, &tif, sock, iface);
+
+	zsock_close(sock);
+
+	err = usbh_req_set_alt(udev, tif.iface, 0);
+	zassert_equal(err, 0, "Failed to disable the data interface (%d)", err);
+	usb_test_eth_carrier(iface, false);
+}
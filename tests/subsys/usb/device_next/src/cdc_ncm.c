@@ -0,0 +1,340 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/usb/class/usb_cdc.h>
+
+#include "usbh_ch9.h"
+#include "usb_test.h"
+
+/* Frames of one OUT NTB, and frames aggregated into the IN NTBs */
+#define TEST_FRAME_COUNT	8
+#define TEST_FRAME_STEP		37U
+#define TEST_TIMEOUT		1000
+/* The second round needs the buffers released by the network stack */
+#define TEST_RX_ROUNDS		2
+
+/* NTB input size set by the host, smaller than the default */
+#define TEST_NTB_IN_SIZE	2048U
+
+/*
+ * OUT NTB of the test, frames 0 to 3 and an invalid entry in the first NDP,
+ * frames 4 to 7 in the second one.
+ */
+#define TEST_NDP0_OFFSET	ROUND_UP(sizeof(struct cdc_ncm_nth16), 4)
+#define TEST_NDP0_ENTRIES	(TEST_FRAME_COUNT / 2 + 2)
+#define TEST_NDP1_OFFSET	ROUND_UP(TEST_NDP0_OFFSET + sizeof(struct cdc_ncm_ndp16) + \
+					 TEST_NDP0_ENTRIES *			\
+					 sizeof(struct cdc_ncm_ndp16_datagram), 4)
+#define TEST_NDP1_ENTRIES	(TEST_FRAME_COUNT / 2 + 1)
+#define TEST_PAYLOAD_OFFSET	ROUND_UP(TEST_NDP1_OFFSET + sizeof(struct cdc_ncm_ndp16) + \
+					 TEST_NDP1_ENTRIES *			\
+					 sizeof(struct cdc_ncm_ndp16_datagram), 4)
+
+static uint8_t ntb[CONFIG_USBD_CDC_NCM_NTB_SIZE];
+static uint8_t frame[NET_ETH_MAX_FRAME_SIZE];
+
+#define TEST_REQTYPE_TO_HOST	((USB_REQTYPE_DIR_TO_HOST << 7) |		\
+				 (USB_REQTYPE_TYPE_CLASS << 5) |		\
+				 USB_REQTYPE_RECIPIENT_INTERFACE)
+#define TEST_REQTYPE_TO_DEVICE	((USB_REQTYPE_DIR_TO_DEVICE << 7) |		\
+				 (USB_REQTYPE_TYPE_CLASS << 5) |		\
+				 USB_REQTYPE_RECIPIENT_INTERFACE)
+
+static int ncm_req_in(struct usb_device *udev, const uint8_t ctrl_iface,
+		      const uint8_t bRequest, void *const data, const uint16_t len)
+{
+	struct net_buf *buf;
+	int err;
+
+	buf = usbh_xfer_buf_alloc(udev, len);
+	zassert_not_null(buf, "Failed to allocate host buffer");
+
+	err = usbh_req_setup(udev, TEST_REQTYPE_TO_HOST, bRequest, 0, ctrl_iface,
+			     len, buf);
+	if (err == 0) {
+		zassert_equal(buf->len, len, "Request 0x%02x returned %u bytes",
+			      bRequest, buf->len);
+		memcpy(data, buf->data, len);
+	}
+
+	usbh_xfer_buf_free(udev, buf);
+
+	return err;
+}
+
+static int ncm_set_ntb_input_size(struct usb_device *udev, const uint8_t ctrl_iface,
+				  const uint32_t size)
+{
+	struct net_buf *buf;
+	int err;
+
+	buf = usbh_xfer_buf_alloc(udev, sizeof(uint32_t));
+	zassert_not_null(buf, "Failed to allocate host buffer");
+	net_buf_add_le32(buf, size);
+
+	err = usbh_req_setup(udev, TEST_REQTYPE_TO_DEVICE, SET_NTB_INPUT_SIZE, 0,
+			     ctrl_iface, sizeof(uint32_t), buf);
+	usbh_xfer_buf_free(udev, buf);
+
+	return err;
+}
+
+/* NTB parameters announced, and the NTB input size negotiated by the host */
+static void test_ncm_parameters(struct usb_device *udev, const uint8_t ctrl_iface)
+{
+	struct cdc_ncm_ntb_parameters params;
+	uint32_t size;
+	int err;
+
+	err = ncm_req_in(udev, ctrl_iface, GET_NTB_PARAMETERS, &params, sizeof(params));
+	zassert_equal(err, 0, "GetNtbParameters failed (%d)", err);
+	zassert_equal(sys_le16_to_cpu(params.wLength), sizeof(params));
+	zassert_equal(sys_le16_to_cpu(params.bmNtbFormatsSupported), NCM_NTB_FORMAT_16);
+	zassert_equal(sys_le32_to_cpu(params.dwNtbInMaxSize), CONFIG_USBD_CDC_NCM_NTB_SIZE);
+	zassert_equal(sys_le32_to_cpu(params.dwNtbOutMaxSize), CONFIG_USBD_CDC_NCM_NTB_SIZE);
+	zassert_equal(sys_le16_to_cpu(params.wNtbOutMaxDatagrams),
+		      CONFIG_USBD_CDC_NCM_MAX_DATAGRAMS);
+
+	err = ncm_set_ntb_input_size(udev, ctrl_iface, CONFIG_USBD_CDC_NCM_NTB_SIZE + 1U);
+	zassert_not_equal(err, 0, "NTB input size above the maximum accepted");
+
+	err = ncm_set_ntb_input_size(udev, ctrl_iface, TEST_NTB_IN_SIZE);
+	zassert_equal(err, 0, "SetNtbInputSize failed (%d)", err);
+
+	err = ncm_req_in(udev, ctrl_iface, GET_NTB_INPUT_SIZE, &size, sizeof(size));
+	zassert_equal(err, 0, "GetNtbInputSize failed (%d)", err);
+	zassert_equal(sys_le32_to_cpu(size), TEST_NTB_IN_SIZE, "NTB input size not set");
+}
+
+static void ncm_ndp_entry(struct cdc_ncm_ndp16 *const ndp, const unsigned int i,
+			  const uint16_t idx, const uint16_t len)
+{
+	ndp->datagram[i].wDatagramIndex = sys_cpu_to_le16(idx);
+	ndp->datagram[i].wDatagramLength = sys_cpu_to_le16(len);
+}
+
+static void ncm_ndp_header(struct cdc_ncm_ndp16 *const ndp, const unsigned int entries,
+			   const uint16_t next)
+{
+	ndp->dwSignature = sys_cpu_to_le32(NCM_NDP16_SIGNATURE_NOCRC);
+	ndp->wLength = sys_cpu_to_le16(sizeof(struct cdc_ncm_ndp16) +
+				       entries * sizeof(struct cdc_ncm_ndp16_datagram));
+	ndp->wNextNdpIndex = sys_cpu_to_le16(next);
+}
+
+/* Build the OUT NTB of the test, returns its length */
+static size_t ncm_out_ntb(const uint16_t mps)
+{
+	struct cdc_ncm_nth16 *nth = (void *)ntb;
+	struct cdc_ncm_ndp16 *ndp0 = (void *)(ntb + TEST_NDP0_OFFSET);
+	struct cdc_ncm_ndp16 *ndp1 = (void *)(ntb + TEST_NDP1_OFFSET);
+	size_t offset = TEST_PAYLOAD_OFFSET;
+	unsigned int i0 = 0;
+	unsigned int i1 = 0;
+
+	memset(ntb, 0, sizeof(ntb));
+
+	for (unsigned int n = 0; n < TEST_FRAME_COUNT; n++) {
+		size_t len = usb_test_eth_frame(ntb + offset, n, TEST_FRAME_STEP);
+
+		zassert_true(offset + len <= sizeof(ntb), "Test NTB too small");
+
+		if (n < TEST_FRAME_COUNT / 2) {
+			ncm_ndp_entry(ndp0, i0++, offset, len);
+		} else {
+			ncm_ndp_entry(ndp1, i1++, offset, len);
+		}
+
+		if (n == 1) {
+			/* Shorter than an Ethernet header, skipped by the device */
+			ncm_ndp_entry(ndp0, i0++, offset, 4);
+		}
+
+		offset = ROUND_UP(offset + len, 4);
+	}
+
+	/* Null entries terminate the tables */
+	ncm_ndp_entry(ndp0, i0++, 0, 0);
+	ncm_ndp_entry(ndp1, i1++, 0, 0);
+	zassert_equal(i0, TEST_NDP0_ENTRIES);
+	zassert_equal(i1, TEST_NDP1_ENTRIES);
+
+	ncm_ndp_header(ndp0, i0, TEST_NDP1_OFFSET);
+	ncm_ndp_header(ndp1, i1, 0);
+
+	/* There is no ZLP, the transfer must end with a short packet */
+	if (!(offset % mps)) {
+		offset++;
+	}
+
+	nth->dwSignature = sys_cpu_to_le32(NCM_NTH16_SIGNATURE);
+	nth->wHeaderLength = sys_cpu_to_le16(sizeof(struct cdc_ncm_nth16));
+	nth->wSequence = 0;
+	nth->wBlockLength = sys_cpu_to_le16(offset);
+	nth->wNdpIndex = sys_cpu_to_le16(TEST_NDP0_OFFSET);
+
+	return offset;
+}
+
+static void ncm_out(struct usb_device *udev, const struct usb_test_iface *tif,
+		    const size_t len)
+{
+	struct net_buf *buf;
+	int err;
+
+	buf = usbh_xfer_buf_alloc(udev, len);
+	zassert_not_null(buf, "Failed to allocate host buffer");
+	net_buf_add_mem(buf, ntb, len);
+
+	err = usb_test_bulk(udev, tif->ep_out, tif->mps_out, buf, TEST_TIMEOUT);
+	usbh_xfer_buf_free(udev, buf);
+	zassert_equal(err, 0, "OUT NTB transfer failed (%d)", err);
+}
+
+/* Datagrams of several NDPs of one NTB reach the network stack, in order */
+static void test_ncm_rx(struct usb_device *udev, const struct usb_test_iface *tif,
+			const int sock)
+{
+	struct cdc_ncm_nth16 *nth = (void *)ntb;
+	size_t len;
+
+	/* An NTB with an invalid header is dropped as a whole */
+	len = ncm_out_ntb(tif->mps_out);
+	nth->dwSignature = sys_cpu_to_le32(NCM_NDP16_SIGNATURE_NOCRC);
+	ncm_out(udev, tif, len);
+
+	for (int i = 0; i < TEST_RX_ROUNDS; i++) {
+		len = ncm_out_ntb(tif->mps_out);
+		ncm_out(udev, tif, len);
+
+		usb_test_eth_recv(sock, TEST_FRAME_COUNT, TEST_FRAME_STEP);
+	}
+}
+
+/* Check an IN NTB and compare its test datagrams, starting with frame *n */
+static void ncm_in_ntb(struct net_buf *const buf, const uint16_t seq,
+		       unsigned int *const n)
+{
+	const struct cdc_ncm_nth16 *nth = (const void *)buf->data;
+	const struct cdc_ncm_ndp16 *ndp;
+	uint16_t ndp_idx;
+	uint16_t count;
+
+	zassert_true(buf->len >= sizeof(*nth), "IN NTB too short");
+	zassert_true(buf->len <= TEST_NTB_IN_SIZE, "IN NTB larger than the input size");
+	zassert_equal(sys_le32_to_cpu(nth->dwSignature), NCM_NTH16_SIGNATURE);
+	zassert_equal(sys_le16_to_cpu(nth->wHeaderLength), sizeof(*nth));
+	zassert_equal(sys_le16_to_cpu(nth->wSequence), seq, "NTB sequence gap");
+	zassert_equal(sys_le16_to_cpu(nth->wBlockLength), buf->len);
+
+	ndp_idx = sys_le16_to_cpu(nth->wNdpIndex);
+	zassert_true(ndp_idx >= sizeof(*nth) && !(ndp_idx % 4), "Invalid NDP index");
+	zassert_true(ndp_idx + sizeof(*ndp) <= buf->len, "NDP beyond the NTB");
+
+	ndp = (const void *)(buf->data + ndp_idx);
+	zassert_equal(sys_le32_to_cpu(ndp->dwSignature), NCM_NDP16_SIGNATURE_NOCRC);
+	zassert_equal(ndp->wNextNdpIndex, 0, "Unexpected second NDP");
+	zassert_true(ndp_idx + sys_le16_to_cpu(ndp->wLength) <= buf->len,
+		     "NDP beyond the NTB");
+
+	count = (sys_le16_to_cpu(ndp->wLength) - sizeof(*ndp)) /
+		sizeof(struct cdc_ncm_ndp16_datagram);
+	zassert_true(count >= 2 && count <= CONFIG_USBD_CDC_NCM_MAX_DATAGRAMS + 1,
+		     "Invalid number of NDP entries %u", count);
+	zassert_equal(ndp->datagram[count - 1].wDatagramIndex, 0, "No null entry");
+
+	for (uint16_t i = 0; i < count - 1; i++) {
+		uint16_t idx = sys_le16_to_cpu(ndp->datagram[i].wDatagramIndex);
+		uint16_t len = sys_le16_to_cpu(ndp->datagram[i].wDatagramLength);
+		size_t expected;
+
+		zassert_true(idx != 0 && idx + len <= buf->len, "Datagram beyond the NTB");
+		zassert_equal(idx % 4, 0, "Datagram not aligned to the divisor");
+
+		/* Skip what the network stack may send on its own */
+		if (!usb_test_eth_is_test_frame(buf->data + idx, len) ||
+		    *n >= TEST_FRAME_COUNT) {
+			continue;
+		}
+
+		expected = usb_test_eth_frame(frame, *n, TEST_FRAME_STEP);
+		zassert_equal(len, expected, "Frame %u sent with %u bytes", *n, len);
+		zassert_mem_equal(buf->data + idx, frame, len, "Frame %u corrupted", *n);
+		(*n)++;
+	}
+}
+
+/* Frames sent while an NTB is in flight are aggregated into the next one */
+static void test_ncm_tx(struct usb_device *udev, const struct usb_test_iface *tif,
+			const int sock, struct net_if *iface)
+{
+	struct net_buf *buf;
+	unsigned int ntbs = 0;
+	unsigned int n = 0;
+	int err;
+
+	usb_test_eth_send(sock, iface, TEST_FRAME_COUNT, TEST_FRAME_STEP);
+
+	while (n < TEST_FRAME_COUNT) {
+		buf = usbh_xfer_buf_alloc(udev, CONFIG_USBD_CDC_NCM_NTB_SIZE);
+		zassert_not_null(buf, "Failed to allocate host buffer");
+
+		err = usb_test_bulk(udev, tif->ep_in, tif->mps_in, buf, TEST_TIMEOUT);
+		zassert_equal(err, 0, "IN NTB %u transfer failed (%d)", ntbs, err);
+
+		ncm_in_ntb(buf, ntbs, &n);
+		usbh_xfer_buf_free(udev, buf);
+		ntbs++;
+	}
+
+	zassert_true(ntbs < TEST_FRAME_COUNT, "%u frames sent in %u NTBs",
+		     TEST_FRAME_COUNT, ntbs);
+}
+
+ZTEST(device_next, test_cdc_ncm_ntb)
+{
+	const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(cdc_ncm_eth0));
+	struct usb_test_iface ctrl;
+	struct usb_test_iface tif;
+	struct usb_device *udev;
+	struct net_if *iface;
+	int sock;
+	int err;
+
+	iface = net_if_lookup_by_dev(dev);
+	zassert_not_null(iface, "No CDC NCM network interface");
+
+	udev = usb_test_configure();
+
+	err = usb_test_find_iface(udev, USB_BCC_CDC_CONTROL, NCM_SUBCLASS, 0, &ctrl);
+	zassert_equal(err, 0, "CDC NCM control interface not found (%d)", err);
+
+	err = usb_test_find_iface(udev, USB_BCC_CDC_DATA, 0, 1, &tif);
+	zassert_equal(err, 0, "CDC NCM data interface not found (%d)", err);
+	zassert_true(tif.ep_in != 0 && tif.ep_out != 0, "Bulk endpoints not found");
+
+	test_ncm_parameters(udev, ctrl.iface);
+
+	err = usbh_req_set_alt(udev, tif.iface, 1);
+	zassert_equal(err, 0, "Failed to enable the data interface (%d)", err);
+	usb_test_eth_carrier(iface, true);
+
+	sock = usb_test_eth_socket(iface);
+
+	test_ncm_rx(udev, &tif, sock);
+	test_ncm_tx(udev, &tif, sock, iface);
+
+	zsock_close(sock);
+
+	err = usbh_req_set_alt(udev, tif.iface, 0);
+	zassert_equal(err, 0, "Failed to disable the data interface (%d)", err);
+	usb_test_eth_carrier(iface, false);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/socket.h>
+
+#include "usb_test.h"
+
+size_t usb_test_eth_frame(uint8_t *const frame, const unsigned int n,
+			  const size_t step)
+{
+	struct net_eth_hdr *hdr = (void *)frame;
+	size_t len = USB_TEST_ETH_MIN_LEN + n * step;
+
+	memset(hdr->dst.addr, 0xff, sizeof(hdr->dst.addr));
+	memset(hdr->src.addr, 0x02, sizeof(hdr->src.addr));
+	hdr->type = htons(USB_TEST_ETH_TYPE);
+
+	/* No trailing zero, that could be taken for padding */
+	for (size_t i = sizeof(*hdr); i < len; i++) {
+		frame[i] = (uint8_t)(n + i) | 0x01U;
+	}
+
+	return len;
+}
+
+bool usb_test_eth_is_test_frame(const uint8_t *const frame, const size_t len)
+{
+	const struct net_eth_hdr *hdr = (const void *)frame;
+
+	return len >= sizeof(*hdr) && hdr->type == htons(USB_TEST_ETH_TYPE);
+}
+
+int usb_test_eth_socket(struct net_if *const iface)
+{
+	struct timeval tv = {
+		.tv_sec = 1,
+	};
+	struct sockaddr_ll addr = {
+		.sll_family = AF_PACKET,
+		.sll_ifindex = net_if_get_by_iface(iface),
+	};
+	int sock;
+	int err;
+
+	sock = zsock_socket(AF_PACKET, SOCK_RAW, ETH_P_ALL);
+	zassert_true(sock >= 0, "Cannot create packet socket (%d)", -errno);
+
+	err = zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(err, 0, "Cannot bind packet socket (%d)", -errno);
+
+	err = zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	zassert_equal(err, 0, "Cannot set receive timeout (%d)", -errno);
+
+	return sock;
+}
+
+void usb_test_eth_send(const int sock, struct net_if *const iface,
+		       const unsigned int count, const size_t step)
+{
+	static uint8_t frame[NET_ETH_MAX_FRAME_SIZE];
+	struct sockaddr_ll dst = {
+		.sll_family = AF_PACKET,
+		.sll_ifindex = net_if_get_by_iface(iface),
+	};
+
+	for (unsigned int n = 0; n < count; n++) {
+		size_t len = usb_test_eth_frame(frame, n, step);
+		ssize_t ret;
+
+		ret = zsock_sendto(sock, frame, len, 0, (struct sockaddr *)&dst, sizeof(dst));
+		zassert_equal(ret, len, "Frame %u not sent (%d)", n, -errno);
+	}
+}
+
+void usb_test_eth_recv(const int sock, const unsigned int count, const size_t step)
+{
+	static uint8_t rx_frame[NET_ETH_MAX_FRAME_SIZE];
+	static uint8_t frame[NET_ETH_MAX_FRAME_SIZE];
+
+	for (unsigned int n = 0; n < count; n++) {
+		size_t len = usb_test_eth_frame(frame, n, step);
+		ssize_t ret;
+
+		ret = zsock_recv(sock, rx_frame, sizeof(rx_frame), 0);
+		zassert_equal(ret, len, "Frame %u received with %d bytes (%d)", n,
+			      (int)ret, -errno);
+		zassert_mem_equal(rx_frame, frame, len, "Frame %u corrupted", n);
+	}
+}
+
+void usb_test_eth_carrier(struct net_if *const iface, const bool on)
+{
+	for (int i = 0; i < 100 && net_if_is_carrier_ok(iface) != on; i++) {
+		k_msleep(10);
+	}
+
+	zassert_equal(net_if_is_carrier_ok(iface), on, "Carrier is not %s",
+		      on ? "on" : "off");
+}
@@ -7,9 +7,11 @@
 #include <zephyr/ztest.h>
 #include <zephyr/usb/usbd.h>
 #include <zephyr/usb/usbh.h>
+#include <zephyr/sys/byteorder.h>
 
 #include "usbh_ch9.h"
 #include "usbh_device.h"
+#include "usb_test.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(usb_test, LOG_LEVEL_INF);
@@ -32,6 +34,149 @@ USBD_DEVICE_DEFINE(test_usbd,
 
 USBH_CONTROLLER_DEFINE(uhs_ctx, DEVICE_DT_GET(DT_NODELABEL(zephyr_uhc0)));
 
+#define TEST_DEVICE_ADDRESS		1
+#define TEST_CONFIGURATION		1
+
+static K_SEM_DEFINE(bulk_sync, 0, 1);
+
+struct usb_device *usb_test_configure(void)
+{
+	struct usb_device *udev;
+	int err;
+
+	udev = usbh_device_get_any(&uhs_ctx);
+	if (udev->state == USB_STATE_CONFIGURED) {
+		return udev;
+	}
+
+	if (udev->state != USB_STATE_ADDRESSED) {
+		err = usbh_req_set_address(udev, TEST_DEVICE_ADDRESS);
+		zassert_equal(err, 0, "Failed to set address (%d)", err);
+	}
+
+	err = usbh_req_set_cfg(udev, TEST_CONFIGURATION);
+	zassert_equal(err, 0, "Failed to set configuration (%d)", err);
+	zassert_equal(udev->state, USB_STATE_CONFIGURED, "Device not configured");
+
+	return udev;
+}
+
+int usb_test_find_iface(struct usb_device *const udev,
+			const uint8_t class, const uint8_t subclass,
+			const uint8_t alt, struct usb_test_iface *const tif)
+{
+	struct usb_cfg_descriptor cfg_desc;
+	struct usb_desc_header *head;
+	bool match = false;
+	struct net_buf *buf;
+	int err;
+
+	err = usbh_req_desc_cfg(udev, 0, sizeof(cfg_desc), &cfg_desc);
+	if (err) {
+		return err;
+	}
+
+	buf = usbh_xfer_buf_alloc(udev, cfg_desc.wTotalLength);
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	err = usbh_req_desc(udev, USB_DESC_CONFIGURATION, 0, 0,
+			    cfg_desc.wTotalLength, buf);
+	if (err) {
+		goto find_iface_exit;
+	}
+
+	err = -ENOENT;
+	memset(tif, 0, sizeof(*tif));
+
+	while (buf->len >= sizeof(struct usb_desc_header)) {
+		head = (void *)buf->data;
+		if (head->bLength < sizeof(struct usb_desc_header) ||
+		    head->bLength > buf->len) {
+			break;
+		}
+
+		if (head->bDescriptorType == USB_DESC_INTERFACE) {
+			struct usb_if_descriptor *if_desc = (void *)head;
+
+			if (match) {
+				/* Endpoints of the alternate are done */
+				break;
+			}
+
+			match = if_desc->bInterfaceClass == class &&
+				if_desc->bInterfaceSubClass == subclass &&
+				if_desc->bAlternateSetting == alt;
+			if (match) {
+				tif->iface = if_desc->bInterfaceNumber;
+				err = 0;
+			}
+		}
+
+		if (match && head->bDescriptorType == USB_DESC_ENDPOINT) {
+			struct usb_ep_descriptor *ep_desc = (void *)head;
+
+			if ((ep_desc->bmAttributes & USB_EP_TRANSFER_TYPE_MASK) ==
+			    USB_EP_TYPE_BULK) {
+				if (USB_EP_DIR_IS_IN(ep_desc->bEndpointAddress)) {
+					tif->ep_in = ep_desc->bEndpointAddress;
+					tif->mps_in = sys_le16_to_cpu(ep_desc->wMaxPacketSize);
+				} else {
+					tif->ep_out = ep_desc->bEndpointAddress;
+					tif->mps_out = sys_le16_to_cpu(ep_desc->wMaxPacketSize);
+				}
+			}
+		}
+
+		net_buf_pull(buf, head->bLength);
+	}
+
+find_iface_exit:
+	usbh_xfer_buf_free(udev, buf);
+
+	return err;
+}
+
+static int bulk_cb(struct usb_device *const udev, struct uhc_transfer *const xfer)
+{
+	k_sem_give(&bulk_sync);
+
+	return 0;
+}
+
+int usb_test_bulk(struct usb_device *const udev, const uint8_t ep,
+		  const uint16_t mps, struct net_buf *const buf,
+		  const uint16_t timeout)
+{
+	struct uhc_transfer *xfer;
+	int err;
+
+	xfer = usbh_xfer_alloc(udev, ep, USB_EP_TYPE_BULK, mps, timeout,
+			       (void *)bulk_cb);
+	if (xfer == NULL) {
+		return -ENOMEM;
+	}
+
+	err = usbh_xfer_buf_add(udev, xfer, buf);
+	if (err) {
+		goto bulk_exit;
+	}
+
+	err = usbh_xfer_enqueue(udev, xfer);
+	if (err) {
+		goto bulk_exit;
+	}
+
+	k_sem_take(&bulk_sync, K_FOREVER);
+	err = xfer->err;
+
+bulk_exit:
+	usbh_xfer_free(udev, xfer);
+
+	return err;
+}
+
 /* Get Configuration request test */
 ZTEST(device_next, test_get_configuration)
 {
@@ -126,6 +271,21 @@ static void *usb_test_enable(void)
 	err = usbd_register_class(&test_usbd, "loopback_0", 1);
 	zassert_equal(err, 0, "Failed to register loopback_0 class (%d)");
 
+	if (IS_ENABLED(CONFIG_USBD_CDC_ECM_CLASS)) {
+		err = usbd_register_class(&test_usbd, "cdc_ecm_0", 1);
+		zassert_equal(err, 0, "Failed to register cdc_ecm_0 class (%d)", err);
+	}
+
+	if (IS_ENABLED(CONFIG_USBD_CDC_NCM_CLASS)) {
+		err = usbd_register_class(&test_usbd, "cdc_ncm_0", 1);
+		zassert_equal(err, 0, "Failed to register cdc_ncm_0 class (%d)", err);
+	}
+
+	if (IS_ENABLED(CONFIG_USBD_MSC_CLASS)) {
+		err = usbd_register_class(&test_usbd, "msc_0", 1);
+		zassert_equal(err, 0, "Failed to register msc_0 class (%d)", err);
+	}
+
 	err = usbd_init(&test_usbd);
 	zassert_equal(err, 0, "Failed to initialize device support");
 
@@ -0,0 +1,166 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/usb/class/usbd_msc.h>
+
+#include "usbh_ch9.h"
+#include "usb_test.h"
+
+USBD_DEFINE_MSC_LUN(RAM, "Zephyr", "RAMDisk", "0.00");
+
+#define TEST_DISK		"RAM"
+#define TEST_SECTOR_SIZE	512U
+/* More data than the SCSI buffer, moved in several transfers */
+#define TEST_SECTOR_COUNT	8U
+#define TEST_LBA		16U
+#define TEST_DATA_LEN		(TEST_SECTOR_COUNT * TEST_SECTOR_SIZE)
+#define TEST_TIMEOUT		1000
+
+#define MSC_SUBCLASS_SCSI	0x06
+
+#define CBW_SIGNATURE		0x43425355
+#define CBW_FLAGS_DIRECTION_IN	0x80
+#define CSW_SIGNATURE		0x53425355
+#define CSW_STATUS_PASSED	0x00
+
+#define SCSI_READ_10		0x28
+#define SCSI_WRITE_10		0x2A
+
+struct test_cbw {
+	uint32_t dCBWSignature;
+	uint32_t dCBWTag;
+	uint32_t dCBWDataTransferLength;
+	uint8_t bmCBWFlags;
+	uint8_t bCBWLUN;
+	uint8_t bCBWCBLength;
+	uint8_t CBWCB[16];
+} __packed;
+
+struct test_csw {
+	uint32_t dCSWSignature;
+	uint32_t dCSWTag;
+	uint32_t dCSWDataResidue;
+	uint8_t bCSWStatus;
+} __packed;
+
+static uint8_t test_data[TEST_DATA_LEN];
+static uint8_t disk_data[TEST_DATA_LEN];
+static uint32_t test_tag;
+
+static void msc_out(struct usb_device *udev, const struct usb_test_iface *tif,
+		    const void *const data, const size_t len)
+{
+	struct net_buf *buf;
+	int err;
+
+	buf = usbh_xfer_buf_alloc(udev, len);
+	zassert_not_null(buf, "Failed to allocate host buffer");
+	net_buf_add_mem(buf, data, len);
+
+	err = usb_test_bulk(udev, tif->ep_out, tif->mps_out, buf, TEST_TIMEOUT);
+	usbh_xfer_buf_free(udev, buf);
+	zassert_equal(err, 0, "OUT transfer failed (%d)", err);
+}
+
+static void msc_in(struct usb_device *udev, const struct usb_test_iface *tif,
+		   void *const data, const size_t len)
+{
+	struct net_buf *buf;
+	int err;
+
+	buf = usbh_xfer_buf_alloc(udev, len);
+	zassert_not_null(buf, "Failed to allocate host buffer");
+
+	err = usb_test_bulk(udev, tif->ep_in, tif->mps_in, buf, TEST_TIMEOUT);
+	zassert_equal(err, 0, "IN transfer failed (%d)", err);
+	zassert_equal(buf->len, len, "IN transfer of %u bytes, expected %u",
+		      buf->len, (unsigned int)len);
+	memcpy(data, buf->data, len);
+	usbh_xfer_buf_free(udev, buf);
+}
+
+/* Bulk-Only Transport command READ(10) or WRITE(10) of the test sectors */
+static void msc_rw10(struct usb_device *udev, const struct usb_test_iface *tif,
+		     const uint8_t opcode, uint8_t *const data)
+{
+	struct test_cbw cbw = {
+		.dCBWSignature = sys_cpu_to_le32(CBW_SIGNATURE),
+		.dCBWTag = sys_cpu_to_le32(++test_tag),
+		.dCBWDataTransferLength = sys_cpu_to_le32(TEST_DATA_LEN),
+		.bmCBWFlags = opcode == SCSI_READ_10 ? CBW_FLAGS_DIRECTION_IN : 0,
+		.bCBWLUN = 0,
+		.bCBWCBLength = 10,
+		.CBWCB = {opcode},
+	};
+	struct test_csw csw;
+
+	sys_put_be32(TEST_LBA, &cbw.CBWCB[2]);
+	sys_put_be16(TEST_SECTOR_COUNT, &cbw.CBWCB[7]);
+
+	msc_out(udev, tif, &cbw, sizeof(cbw));
+
+	if (opcode == SCSI_READ_10) {
+		msc_in(udev, tif, data, TEST_DATA_LEN);
+	} else {
+		msc_out(udev, tif, data, TEST_DATA_LEN);
+	}
+
+	msc_in(udev, tif, &csw, sizeof(csw));
+	zassert_equal(sys_le32_to_cpu(csw.dCSWSignature), CSW_SIGNATURE, "Invalid CSW");
+	zassert_equal(sys_le32_to_cpu(csw.dCSWTag), test_tag, "CSW tag mismatch");
+	zassert_equal(sys_le32_to_cpu(csw.dCSWDataResidue), 0, "Data residue %u",
+		      sys_le32_to_cpu(csw.dCSWDataResidue));
+	zassert_equal(csw.bCSWStatus, CSW_STATUS_PASSED, "Command 0x%02x failed",
+		      opcode);
+}
+
+static void test_pattern(uint8_t *const data, const uint8_t seed)
+{
+	for (size_t i = 0; i < TEST_DATA_LEN; i++) {
+		data[i] = (uint8_t)(seed + i + i / TEST_SECTOR_SIZE);
+	}
+}
+
+ZTEST(device_next, test_msc_read_write_10)
+{
+	struct usb_test_iface tif;
+	struct usb_device *udev;
+	int err;
+
+	udev = usb_test_configure();
+
+	err = usb_test_find_iface(udev, USB_BCC_MASS_STORAGE, MSC_SUBCLASS_SCSI, 0, &tif);
+	zassert_equal(err, 0, "MSC interface not found (%d)", err);
+	zassert_true(tif.ep_in != 0 && tif.ep_out != 0, "Bulk endpoints not found");
+
+	err = disk_access_init(TEST_DISK);
+	zassert_equal(err, 0, "Failed to initialize the disk (%d)", err);
+
+	/* Sectors written directly to the disk are read by the host */
+	test_pattern(disk_data, 0x11);
+	err = disk_access_write(TEST_DISK, disk_data, TEST_LBA, TEST_SECTOR_COUNT);
+	zassert_equal(err, 0, "Failed to write the disk (%d)", err);
+
+	memset(test_data, 0, sizeof(test_data));
+	msc_rw10(udev, &tif, SCSI_READ_10, test_data);
+	zassert_mem_equal(test_data, disk_data, TEST_DATA_LEN, "READ(10) data corrupted");
+
+	/* Sectors written by the host are on the disk once the CSW is sent */
+	test_pattern(test_data, 0x5a);
+	msc_rw10(udev, &tif, SCSI_WRITE_10, test_data);
+
+	err = disk_access_read(TEST_DISK, disk_data, TEST_LBA, TEST_SECTOR_COUNT);
+	zassert_equal(err, 0, "Failed to read the disk (%d)", err);
+	zassert_mem_equal(disk_data, test_data, TEST_DATA_LEN, "WRITE(10) data corrupted");
+
+	/* And read back by the host */
+	memset(test_data, 0, sizeof(test_data));
+	msc_rw10(udev, &tif, SCSI_READ_10, test_data);
+	zassert_mem_equal(test_data, disk_data, TEST_DATA_LEN, "READ(10) data corrupted");
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TEST_USB_DEVICE_NEXT_USB_TEST_H
+#define ZEPHYR_TEST_USB_DEVICE_NEXT_USB_TEST_H
+
+#include <zephyr/usb/usbh.h>
+
+#include "usbh_device.h"
+
+/* Interface alternate of the test device and its bulk endpoints */
+struct usb_test_iface {
+	uint8_t iface;
+	uint8_t ep_in;
+	uint8_t ep_out;
+	uint16_t mps_in;
+	uint16_t mps_out;
+};
+
+/* Address and configure the test device, if not done yet */
+struct usb_device *usb_test_configure(void);
+
+/* Find the first interface of class and subclass with the given alternate */
+int usb_test_find_iface(struct usb_device *const udev,
+			const uint8_t class, const uint8_t subclass,
+			const uint8_t alt, struct usb_test_iface *const tif);
+
+/*
+ * Bulk transfer of buf, IN transfers fill its tailroom. Returns the
+ * transfer status, -ETIMEDOUT when the device did not answer within
+ * timeout frames.
+ */
+int usb_test_bulk(struct usb_device *const udev, const uint8_t ep,
+		  const uint16_t mps, struct net_buf *const buf,
+		  const uint16_t timeout);
+
+/* Ethernet frames of the network class tests, with a local EtherType */
+#define USB_TEST_ETH_TYPE		0x88b5
+#define USB_TEST_ETH_MIN_LEN		60
+
+struct net_if;
+
+/* Write test frame n into frame, n * step bytes longer than the first one */
+size_t usb_test_eth_frame(uint8_t *const frame, const unsigned int n,
+			  const size_t step);
+
+/* Whether frame has the EtherType of the test frames */
+bool usb_test_eth_is_test_frame(const uint8_t *const frame, const size_t len);
+
+/* Packet socket bound to iface, receive calls time out after a second */
+int usb_test_eth_socket(struct net_if *const iface);
+
+/* Send test frames 0 to count - 1 on iface */
+void usb_test_eth_send(const int sock, struct net_if *const iface,
+		       const unsigned int count, const size_t step);
+
+/* Receive test frames 0 to count - 1, in order and intact */
+void usb_test_eth_recv(const int sock, const unsigned int count, const size_t step);
+
+/* Wait up to a second for the carrier of iface to be on or off */
+void usb_test_eth_carrier(struct net_if *const iface, const bool on);
+
+#endif /* ZEPHYR_TEST_USB_DEVICE_NEXT_USB_TEST_H */
@@ -0,0 +1,178 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/usb/usbd.h>
+#include <zephyr/usb/usbh.h>
+#include <zephyr/usb/class/usbd_msc.h>
+
+#include "usbh_ch9.h"
+#include "usbh_device.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(usb_test, LOG_LEVEL_INF);
+
+#define SECTOR_SIZE	512
+#define SECTOR_COUNT	192
+/* Enough sectors to need several commands of CONFIG_USBH_MSC_CMD_BLOCKS */
+#define TEST_SECTORS	40
+
+USBD_CONFIGURATION_DEFINE(test_config, USB_SCD_SELF_POWERED, 200);
+
+USBD_DESC_LANG_DEFINE(test_lang);
+USBD_DESC_STRING_DEFINE(test_mfg, "ZEPHYR", 1);
+USBD_DESC_STRING_DEFINE(test_product, "Zephyr USB Test", 2);
+USBD_DESC_STRING_DEFINE(test_sn, "0123456789ABCDEF", 3);
+
+USBD_DEVICE_DEFINE(test_usbd,
+		   DEVICE_DT_GET(DT_NODELABEL(zephyr_udc0)),
+		   0x2fe3, 0xffff);
+
+USBD_DEFINE_MSC_LUN(RAM, "Zephyr", "RAMDisk", "0.00");
+
+USBH_CONTROLLER_DEFINE(uhs_ctx, DEVICE_DT_GET(DT_NODELABEL(zephyr_uhc0)));
+
+static uint8_t wr_buf[TEST_SECTORS * SECTOR_SIZE];
+static uint8_t rd_buf[TEST_SECTORS * SECTOR_SIZE];
+
+static void fill_pattern(uint8_t seed)
+{
+	for (size_t i = 0; i < sizeof(wr_buf); i++) {
+		wr_buf[i] = (uint8_t)(i * 7U + seed);
+	}
+
+	memset(rd_buf, 0, sizeof(rd_buf));
+}
+
+ZTEST(usbh_msc, test_capacity)
+{
+	uint32_t count = 0;
+	uint32_t size = 0;
+	int err;
+
+	zassert_equal(disk_access_status(CONFIG_USBH_MSC_DISK_NAME), DISK_STATUS_OK,
+		      "Disk not ready");
+
+	err = disk_access_ioctl(CONFIG_USBH_MSC_DISK_NAME, DISK_IOCTL_GET_SECTOR_COUNT, &count);
+	zassert_equal(err, 0, "Failed to get sector count (%d)", err);
+	zassert_equal(count, SECTOR_COUNT, "Wrong sector count %u", count);
+
+	err = disk_access_ioctl(CONFIG_USBH_MSC_DISK_NAME, DISK_IOCTL_GET_SECTOR_SIZE, &size);
+	zassert_equal(err, 0, "Failed to get sector size (%d)", err);
+	zassert_equal(size, SECTOR_SIZE, "Wrong sector size %u", size);
+}
+
+/* Write through the host class, read back from the device side disk */
+ZTEST(usbh_msc, test_write)
+{
+	int err;
+
+	fill_pattern(0x11);
+
+	err = disk_access_write(CONFIG_USBH_MSC_DISK_NAME, wr_buf, 3, TEST_SECTORS);
+	zassert_equal(err, 0, "Failed to write (%d)", err);
+
+	err = disk_access_read("RAM", rd_buf, 3, TEST_SECTORS);
+	zassert_equal(err, 0, "Failed to read RAM disk (%d)", err);
+	zassert_mem_equal(rd_buf, wr_buf, sizeof(wr_buf), "Data mismatch");
+}
+
+/* Write to the device side disk, read back through the host class */
+ZTEST(usbh_msc, test_read)
+{
+	int err;
+
+	fill_pattern(0x5a);
+
+	err = disk_access_write("RAM", wr_buf, SECTOR_COUNT - TEST_SECTORS, TEST_SECTORS);
+	zassert_equal(err, 0, "Failed to write RAM disk (%d)", err);
+
+	err = disk_access_read(CONFIG_USBH_MSC_DISK_NAME, rd_buf,
+			       SECTOR_COUNT - TEST_SECTORS, TEST_SECTORS);
+	zassert_equal(err, 0, "Failed to read (%d)", err);
+	zassert_mem_equal(rd_buf, wr_buf, sizeof(wr_buf), "Data mismatch");
+
+	/* Past the end of the disk */
+	err = disk_access_read(CONFIG_USBH_MSC_DISK_NAME, rd_buf, SECTOR_COUNT - 1, 2);
+	zassert_not_equal(err, 0, "Read past the end of the disk");
+}
+
+static void *usb_test_enable(void)
+{
+	struct usb_device *udev;
+	int err;
+
+	err = usbh_init(&uhs_ctx);
+	zassert_equal(err, 0, "Failed to initialize USB host");
+
+	err = usbh_enable(&uhs_ctx);
+	zassert_equal(err, 0, "Failed to enable USB host");
+
+	err = uhc_bus_reset(uhs_ctx.dev);
+	zassert_equal(err, 0, "Failed to signal bus reset");
+
+	err = uhc_bus_resume(uhs_ctx.dev);
+	zassert_equal(err, 0, "Failed to signal bus resume");
+
+	err = uhc_sof_enable(uhs_ctx.dev);
+	zassert_equal(err, 0, "Failed to enable SoF generator");
+
+	err = usbd_add_descriptor(&test_usbd, &test_lang);
+	zassert_equal(err, 0, "Failed to initialize descriptor (%d)", err);
+
+	err = usbd_add_descriptor(&test_usbd, &test_mfg);
+	zassert_equal(err, 0, "Failed to initialize descriptor (%d)", err);
+
+	err = usbd_add_descriptor(&test_usbd, &test_product);
+	zassert_equal(err, 0, "Failed to initialize descriptor (%d)", err);
+
+	err = usbd_add_descriptor(&test_usbd, &test_sn);
+	zassert_equal(err, 0, "Failed to initialize descriptor (%d)", err);
+
+	err = usbd_add_configuration(&test_usbd, &test_config);
+	zassert_equal(err, 0, "Failed to add configuration (%d)", err);
+
+	err = usbd_register_class(&test_usbd, "msc_0", 1);
+	zassert_equal(err, 0, "Failed to register msc_0 class (%d)", err);
+
+	err = usbd_init(&test_usbd);
+	zassert_equal(err, 0, "Failed to initialize device support");
+
+	err = usbd_enable(&test_usbd);
+	zassert_equal(err, 0, "Failed to enable device support");
+
+	udev = usbh_device_get_any(&uhs_ctx);
+	udev->state = USB_STATE_DEFAULT;
+
+	err = usbh_req_set_address(udev, 2);
+	zassert_equal(err, 0, "Failed to set address (%d)", err);
+
+	/* The class binds once the device is configured */
+	err = usbh_req_set_cfg(udev, 1);
+	zassert_equal(err, 0, "Failed to set configuration (%d)", err);
+
+	err = disk_access_init(CONFIG_USBH_MSC_DISK_NAME);
+	zassert_equal(err, 0, "Failed to initialize disk (%d)", err);
+
+	return NULL;
+}
+
+static void usb_test_shutdown(void *f)
+{
+	int err;
+
+	err = usbd_disable(&test_usbd);
+	zassert_equal(err, 0, "Failed to disable device support");
+
+	err = usbd_shutdown(&test_usbd);
+	zassert_equal(err, 0, "Failed to shutdown device support");
+
+	err = usbh_disable(&uhs_ctx);
+	zassert_equal(err, 0, "Failed to disable USB host");
+}
+
+ZTEST_SUITE(usbh_msc, NULL, usb_test_enable, NULL, NULL, usb_test_shutdown);
@@ -177,4 +177,51 @@ ZTEST(hlp_priority_boost, test_priority_elevation)
 	zassert_true(prio == 8, "The priority must be 8, but it is %d", prio);
 }
 
+ZBUS_SUBSCRIBER_DEFINE(sub2, 1);
+
+static uint32_t sub2_pending;
+
+static void listener2_callback(const struct zbus_channel *chan)
+{
+	sub2_pending = k_msgq_num_used_get(sub2.queue);
+}
+
+ZBUS_LISTENER_DEFINE(lis2, listener2_callback);
+
+ZBUS_CHAN_DEFINE(chan_testing_02,            /* Name */
+		 int,                        /* Message type */
+
+		 NULL,                       /* Validator */
+		 NULL,                       /* User data */
+		 ZBUS_OBSERVERS(lis2, sub2), /* observers */
+		 ZBUS_MSG_INIT(0)            /* Initial value */
+);
+
+ZTEST(hlp_priority_boost, test_notification_order)
+{
+	int value = 1;
+
+	zassert_ok(zbus_chan_pub(&chan_testing_02, &value, K_MSEC(100)));
+
+	/* The listener is first in the static sequence, but follows the subscribers when they are
+	 * notified by priority
+	 */
+	zassert_equal(sub2_pending, IS_ENABLED(CONFIG_ZBUS_OBSERVER_PRIORITY_ORDER) ? 1 : 0,
+		      "Unexpected notification order");
+	k_msgq_purge(sub2.queue);
+
+#if defined(CONFIG_ZBUS_OBSERVER_STATS)
+	struct zbus_observer_stats stats;
+
+	zassert_ok(zbus_obs_get_stats(&lis2, &stats));
+	zassert_equal(stats.notifications, 1, NULL);
+	zassert_true(stats.latency_avg_ns <= stats.latency_max_ns, NULL);
+
+	zassert_ok(zbus_obs_reset_stats(&lis2));
+	zassert_ok(zbus_obs_get_stats(&lis2, &stats));
+	zassert_equal(stats.notifications, 0, NULL);
+	zassert_equal(stats.latency_max_ns, 0, NULL);
+#endif /* CONFIG_ZBUS_OBSERVER_STATS */
+}
+
 ZTEST_SUITE(hlp_priority_boost, NULL, NULL, NULL, NULL, NULL);
@@ -784,6 +784,19 @@ ZTEST(basic, test_specification_based__zbus_sub_wait_msg)
 	irq_offload(isr_sub_wait_msg, NULL);
 }
 
+ZTEST(basic, test_specification_based__zbus_sub_wait_msg_buf)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *buf;
+
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_buf(NULL, NULL, NULL, K_NO_WAIT), NULL);
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_buf(&foo_sub, NULL, NULL, K_NO_WAIT), NULL);
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_buf(&foo_msg_sub, NULL, NULL, K_NO_WAIT), NULL);
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_buf(&foo_msg_sub, &chan, NULL, K_NO_WAIT), NULL);
+	zassert_equal(-ENOMSG, zbus_sub_wait_msg_buf(&foo_msg_sub, &chan, &buf, K_NO_WAIT), NULL);
+	zassert_is_null(buf, NULL);
+}
+
 #if defined(CONFIG_ZBUS_PRIORITY_BOOST)
 static void isr_obs_attach_detach(const void *operation)
 {
@@ -129,4 +129,53 @@ ZTEST(lib_base64, test_base64_codec)
 	zassert_equal(rc, -ENOMEM, "Error: dst NULL: decode test return value");
 }
 
+ZTEST(lib_base64, test_base64_lengths)
+{
+	uint8_t data[100];
+	uint8_t enc[140];
+	uint8_t dec[100];
+	size_t enc_len, dec_len;
+	int rc;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 37U + 11U);
+	}
+
+	/* Every tail length after the blocks, and a destination that is
+	 * exactly as long as the decoded data
+	 */
+	for (size_t slen = 0; slen <= sizeof(data); slen++) {
+		rc = base64_encode(enc, sizeof(enc), &enc_len, data, slen);
+		zassert_equal(rc, 0, "Encode %zu return value", slen);
+		zassert_equal(enc_len, (slen + 2) / 3 * 4, "Encode %zu length", slen);
+
+		rc = base64_decode(dec, slen, &dec_len, enc, enc_len);
+		zassert_equal(rc, 0, "Decode %zu return value", slen);
+		zassert_equal(dec_len, slen, "Decode %zu length", slen);
+		zassert_mem_equal(dec, data, slen, "Decode %zu comparison", slen);
+	}
+
+	/* Invalid characters anywhere in a long line */
+	rc = base64_encode(enc, sizeof(enc), &enc_len, data, sizeof(data));
+	zassert_equal(rc, 0, "Encode return value");
+
+	for (size_t i = 0; i < enc_len - 2; i++) {
+		uint8_t c = enc[i];
+
+		enc[i] = '*';
+		rc = base64_decode(dec, sizeof(dec), &dec_len, enc, enc_len);
+		zassert_equal(rc, -EINVAL, "Invalid at %zu return value", i);
+		enc[i] = c;
+	}
+
+	/* Line breaks in the middle of a block */
+	memmove(&enc[21], &enc[19], enc_len - 19);
+	enc[19] = '\r';
+	enc[20] = '\n';
+	rc = base64_decode(dec, sizeof(dec), &dec_len, enc, enc_len + 2);
+	zassert_equal(rc, 0, "Line break return value");
+	zassert_equal(dec_len, sizeof(data), "Line break length");
+	zassert_mem_equal(dec, data, sizeof(data), "Line break comparison");
+}
+
 ZTEST_SUITE(lib_base64, NULL, NULL, NULL, NULL, NULL);
@@ -9,7 +9,11 @@
 #include "../../../lib/crc/crc8_sw.c"
 #include "../../../lib/crc/crc16_sw.c"
 #include "../../../lib/crc/crc32_sw.c"
+#ifdef CONFIG_CRC32_SLICE_BY_8
+#include "../../../lib/crc/crc32_sb8.c"
+#else
 #include "../../../lib/crc/crc32c_sw.c"
+#endif
 #include "../../../lib/crc/crc7_sw.c"
 
 ZTEST(crc, test_crc32c)
@@ -50,6 +54,28 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+ZTEST(crc, test_crc32_long)
+{
+	static const char text[] = "xThe quick brown fox jumps over the lazy dog";
+	const uint8_t *test = (const uint8_t *)&text[1];
+	size_t len = sizeof(text) - 2;
+	uint32_t crc;
+
+	/* Unaligned and longer than the 8 byte steps */
+	zassert_equal(crc32_ieee(test, len), 0x414FA339);
+	zassert_equal(crc32_c(0, test, len, true, true), 0x22620404);
+
+	/* Split at every offset */
+	for (size_t i = 0; i <= len; i++) {
+		crc = crc32_ieee_update(crc32_ieee(test, i), test + i, len - i);
+		zassert_equal(crc, 0x414FA339, "split at %zu", i);
+
+		crc = crc32_c(crc32_c(0, test, i, true, false), test + i,
+			      len - i, false, true);
+		zassert_equal(crc, 0x22620404, "split at %zu", i);
+	}
+}
+
 ZTEST(crc, test_crc16)
 {
 	uint8_t test[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
@@ -64,6 +64,55 @@ ZTEST(util, test_u8_to_dec) {
 		      "Length of converted value using 0 byte buffer isn't 0");
 }
 
+ZTEST(util, test_bin2hex_hex2bin) {
+	static const char hex_mixed[] = "0123456789abcdefABCDEF0011223344556677";
+	uint8_t bin[20];
+	uint8_t out[20];
+	char hex[41];
+	size_t len;
+
+	for (size_t i = 0; i < sizeof(bin); i++) {
+		bin[i] = (uint8_t)(i * 29U + 3U);
+	}
+
+	/* Every length around the 8 byte blocks */
+	for (size_t n = 0; n <= sizeof(bin); n++) {
+		len = bin2hex(bin, n, hex, 2U * n + 1U);
+		zassert_equal(len, 2U * n, "Length of %zu bytes is not %zu", n, 2U * n);
+		zassert_equal(strlen(hex), 2U * n, "Hex of %zu bytes is not terminated", n);
+
+		for (size_t i = 0; i < n; i++) {
+			zassert_equal(hex[2U * i], "0123456789abcdef"[bin[i] >> 4]);
+			zassert_equal(hex[2U * i + 1U], "0123456789abcdef"[bin[i] & 0xf]);
+		}
+
+		len = hex2bin(hex, 2U * n, out, n);
+		zassert_equal(len, n, "Length of %zu hex characters is not %zu", 2U * n, n);
+		zassert_mem_equal(out, bin, n, "Round trip of %zu bytes", n);
+	}
+
+	zassert_equal(bin2hex(bin, 8, hex, 16), 0, "Hex without room for NUL");
+
+	len = hex2bin(hex_mixed, strlen(hex_mixed), out, sizeof(out));
+	zassert_equal(len, 19, "Length of mixed case hex is not 19");
+	zassert_mem_equal(out, "\x01\x23\x45\x67\x89\xab\xcd\xef\xab\xcd\xef"
+			  "\x00\x11\x22\x33\x44\x55\x66\x77", len);
+
+	/* A character that is not a hex digit, in a block and in the tail */
+	memcpy(hex, hex_mixed, sizeof(hex_mixed));
+	hex[5] = 'g';
+	zassert_equal(hex2bin(hex, 38, out, sizeof(out)), 0, "'g' at 5 is accepted");
+	hex[5] = '5';
+	hex[35] = ':';
+	zassert_equal(hex2bin(hex, 38, out, sizeof(out)), 0, "':' at 35 is accepted");
+	zassert_equal(hex2bin(hex, 38, out, 18), 0, "Short buffer is accepted");
+
+	/* Odd lengths get a leading zero nibble */
+	len = hex2bin("abc0123456789ABCD", 17, out, 9);
+	zassert_equal(len, 9, "Length of 17 hex characters is not 9");
+	zassert_mem_equal(out, "\x0a\xbc\x01\x23\x45\x67\x89\xab\xcd", len);
+}
+
 ZTEST(util, test_sign_extend) {
 	uint8_t u8;
 	uint16_t u16;